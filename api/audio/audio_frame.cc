@@ -12,15 +12,15 @@
 
 #include <string.h>
 
+#include <algorithm>
+#include <utility>
+
 #include "rtc_base/checks.h"
 #include "rtc_base/time_utils.h"
 
 namespace webrtc {
 
-AudioFrame::AudioFrame() {
-  // Visual Studio doesn't like this in the class definition.
-  static_assert(sizeof(data_) == kMaxDataSizeBytes, "kMaxDataSizeBytes");
-}
+AudioFrame::AudioFrame() = default;
 
 void AudioFrame::Reset() {
   ResetWithoutMuting();
@@ -65,7 +65,8 @@ void AudioFrame::UpdateFrame(uint32_t timestamp,
   const size_t length = samples_per_channel * num_channels;
   RTC_CHECK_LE(length, kMaxDataSizeSamples);
   if (data != nullptr) {
-    memcpy(data_, data, sizeof(int16_t) * length);
+    Reserve(length, /*keep_data=*/false);
+    memcpy(data_.get(), data, sizeof(int16_t) * length);
     muted_ = false;
   } else {
     muted_ = true;
@@ -92,7 +93,8 @@ void AudioFrame::CopyFrom(const AudioFrame& src) {
   const size_t length = samples_per_channel_ * num_channels_;
   RTC_CHECK_LE(length, kMaxDataSizeSamples);
   if (!src.muted()) {
-    memcpy(data_, src.data(), sizeof(int16_t) * length);
+    Reserve(length, /*keep_data=*/false);
+    memcpy(data_.get(), src.data(), sizeof(int16_t) * length);
     muted_ = false;
   }
 }
@@ -110,17 +112,32 @@ int64_t AudioFrame::ElapsedProfileTimeMs() const {
 }
 
 const int16_t* AudioFrame::data() const {
-  return muted_ ? empty_data() : data_;
+  return muted_ ? empty_data() : data_.get();
 }
 
 // TODO(henrik.lundin) Can we skip zeroing the buffer?
 // See https://bugs.chromium.org/p/webrtc/issues/detail?id=5647.
 int16_t* AudioFrame::mutable_data() {
+  Reserve(kMaxDataSizeSamples, /*keep_data=*/true);
+  if (muted_) {
+    memset(data_.get(), 0, kMaxDataSizeBytes);
+    muted_ = false;
+  }
+  return data_.get();
+}
+
+int16_t* AudioFrame::mutable_data(size_t samples_per_channel,
+                                  size_t num_channels) {
+  const size_t length = samples_per_channel * num_channels;
+  RTC_CHECK_LE(length, kMaxDataSizeSamples);
+  Reserve(length, /*keep_data=*/true);
+  samples_per_channel_ = samples_per_channel;
+  num_channels_ = num_channels;
   if (muted_) {
-    memset(data_, 0, kMaxDataSizeBytes);
+    memset(data_.get(), 0, sizeof(int16_t) * length);
     muted_ = false;
   }
-  return data_;
+  return data_.get();
 }
 
 void AudioFrame::Mute() {
@@ -131,6 +148,20 @@ bool AudioFrame::muted() const {
   return muted_;
 }
 
+void AudioFrame::Reserve(size_t samples, bool keep_data) {
+  if (data_ && samples <= capacity_) {
+    return;
+  }
+  std::unique_ptr<int16_t[]> data(new int16_t[samples]);
+  if (keep_data && !muted_) {
+    const size_t length =
+        std::min(samples_per_channel_ * num_channels_, capacity_);
+    memcpy(data.get(), data_.get(), sizeof(int16_t) * length);
+  }
+  data_ = std::move(data);
+  capacity_ = samples;
+}
+
 // static
 const int16_t* AudioFrame::empty_data() {
   static int16_t* null_data = new int16_t[kMaxDataSizeSamples]();
@@ -14,6 +14,8 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <memory>
+
 #include "api/audio/channel_layout.h"
 #include "api/rtp_packet_infos.h"
 #include "rtc_base/constructor_magic.h"
@@ -24,6 +26,11 @@ namespace webrtc {
  * allows for adding and subtracting frames while keeping track of the resulting
  * states.
  *
+ * The sample buffer is allocated on first write. Frames that are only written
+ * through mutable_data(samples_per_channel, num_channels), UpdateFrame() and
+ * CopyFrom() keep a buffer sized for the audio they hold, so a 10 ms mono frame
+ * uses a few hundred bytes rather than kMaxDataSizeBytes.
+ *
  * Notes
  * - This is a de-facto api, not designed for external use. The AudioFrame class
  *   is in need of overhaul or even replacement, and anyone depending on it
@@ -88,10 +95,17 @@ class AudioFrame {
   int64_t ElapsedProfileTimeMs() const;
 
   // data() returns a zeroed static buffer if the frame is muted.
-  // mutable_frame() always returns a non-static buffer; the first call to
-  // mutable_frame() zeros the non-static buffer and marks the frame unmuted.
+  // mutable_frame() always returns a non-static buffer with room for
+  // kMaxDataSizeSamples; the first call to mutable_frame() zeros the non-static
+  // buffer and marks the frame unmuted. Growing the buffer moves it, so
+  // pointers returned earlier by data() must not be used afterwards.
   const int16_t* data() const;
   int16_t* mutable_data();
+  // Like mutable_data(), but sets `samples_per_channel_` and `num_channels_`
+  // and only makes room for that many samples. The samples already in an
+  // unmuted frame are kept; a muted frame has its first
+  // `samples_per_channel * num_channels` samples zeroed.
+  int16_t* mutable_data(size_t samples_per_channel, size_t num_channels);
 
   // Prefer to mute frames using AudioFrameOperations::Mute.
   void Mute();
@@ -156,7 +170,12 @@ class AudioFrame {
   // buffer per translation unit is to wrap a static in an inline function.
   static const int16_t* empty_data();
 
-  int16_t data_[kMaxDataSizeSamples];
+  // Makes room for at least `samples` samples, copying the current samples of
+  // an unmuted frame if `keep_data` is true.
+  void Reserve(size_t samples, bool keep_data);
+
+  std::unique_ptr<int16_t[]> data_;
+  size_t capacity_ = 0;
   bool muted_ = true;
 
   // Absolute capture timestamp when this audio frame was originally captured.
@@ -13,6 +13,7 @@
 
 #include <memory>
 
+#include "absl/types/optional.h"
 #include "api/audio/audio_frame.h"
 #include "rtc_base/ref_count.h"
 
@@ -48,6 +49,13 @@ class AudioMixer : public rtc::RefCountInterface {
     // with this sample rate or higher will not cause quality loss.
     virtual int PreferredSampleRate() const = 0;
 
+    // A cheap estimate of how loud the next audio of this source is, in -dBov
+    // as in the audio level header extension (RFC 6464), where 0 is the
+    // loudest and 127 is silence, e.g., from the received packets before they
+    // are decoded. Lets a mixer that only mixes a few of many sources skip
+    // asking the quiet ones for audio. Unset if there is no estimate.
+    virtual absl::optional<int> AudioLevelDbov() const { return absl::nullopt; }
+
     virtual ~Source() {}
   };
 
@@ -30,6 +30,10 @@ struct RTC_EXPORT EchoCanceller3Config {
   struct Buffering {
     size_t excess_render_detection_interval_blocks = 250;
     size_t max_allowed_excess_render_blocks = 8;
+    // Reduces the delay that the echo canceller adds to the capture signal
+    // from 64 to 48 samples per band by processing a block ahead of time
+    // whenever the output framing would otherwise need an extra block.
+    bool low_latency_framing = false;
   } buffering;
 
   struct Delay {
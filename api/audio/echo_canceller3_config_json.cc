@@ -183,6 +183,8 @@ void Aec3ConfigFromJsonString(absl::string_view json_string,
               &cfg.buffering.excess_render_detection_interval_blocks);
     ReadParam(section, "max_allowed_excess_render_blocks",
               &cfg.buffering.max_allowed_excess_render_blocks);
+    ReadParam(section, "low_latency_framing",
+              &cfg.buffering.low_latency_framing);
   }
 
   if (rtc::GetValueFromJsonObject(aec3_root, "delay", &section)) {
@@ -432,7 +434,9 @@ std::string Aec3ConfigToJsonString(const EchoCanceller3Config& config) {
   ost << "\"excess_render_detection_interval_blocks\": "
       << config.buffering.excess_render_detection_interval_blocks << ",";
   ost << "\"max_allowed_excess_render_blocks\": "
-      << config.buffering.max_allowed_excess_render_blocks;
+      << config.buffering.max_allowed_excess_render_blocks << ",";
+  ost << "\"low_latency_framing\": "
+      << (config.buffering.low_latency_framing ? "true" : "false");
   ost << "},";
 
   ost << "\"delay\": {";
@@ -63,6 +63,37 @@ TEST(AudioFrameTest, MutedFrameBufferIsZeroed) {
   EXPECT_TRUE(AllSamplesAre(0, frame));
 }
 
+TEST(AudioFrameTest, MutableDataWithSizeSetsSizeAndZeroesMutedFrame) {
+  AudioFrame frame;
+  const int16_t* frame_data =
+      frame.mutable_data(kSamplesPerChannel, kNumChannelsStereo);
+  EXPECT_FALSE(frame.muted());
+  EXPECT_EQ(kSamplesPerChannel, frame.samples_per_channel());
+  EXPECT_EQ(kNumChannelsStereo, frame.num_channels());
+  for (size_t i = 0; i < kSamplesPerChannel * kNumChannelsStereo; ++i) {
+    EXPECT_EQ(0, frame_data[i]);
+  }
+}
+
+TEST(AudioFrameTest, MutableDataWithSizeKeepsSamplesWhenGrowing) {
+  AudioFrame frame;
+  int16_t samples[kNumChannelsMono * kSamplesPerChannel];
+  for (size_t i = 0; i < kSamplesPerChannel; ++i) {
+    samples[i] = static_cast<int16_t>(i);
+  }
+  frame.UpdateFrame(kTimestamp, samples, kSamplesPerChannel, kSampleRateHz,
+                    AudioFrame::kNormalSpeech, AudioFrame::kVadActive,
+                    kNumChannelsMono);
+
+  frame.mutable_data(kSamplesPerChannel, kNumChannels5_1);
+  EXPECT_EQ(0, memcmp(samples, frame.data(), sizeof(samples)));
+
+  // Growing to the full size keeps them too.
+  int16_t* frame_data = frame.mutable_data();
+  EXPECT_EQ(0, memcmp(samples, frame_data, sizeof(samples)));
+  frame_data[frame.max_16bit_samples() - 1] = 17;
+}
+
 TEST(AudioFrameTest, UpdateFrameMono) {
   AudioFrame frame;
   int16_t samples[kNumChannelsMono * kSamplesPerChannel] = {17};
@@ -59,6 +59,15 @@ struct ANAStats {
   // The uplink packet loss fractions as set by the ANA FEC controller. If this
   // value is not set, it indicates that the ANA FEC controller is not active.
   absl::optional<float> uplink_packet_loss_fraction;
+  // Number of times the encode time controller changed the complexity or the
+  // bandwidth since the start of the call. If this value is not set, it
+  // indicates that the encode time controller is disabled.
+  absl::optional<uint32_t> complexity_action_counter;
+  // The complexity used by the encoder, as set while the encode time
+  // controller is enabled.
+  absl::optional<int> encoder_complexity;
+  // True if the encode time controller limits the encoded bandwidth.
+  absl::optional<bool> encoder_bandwidth_limited;
 };
 
 // This is the interface class for encoders in AudioCoding module. Each codec
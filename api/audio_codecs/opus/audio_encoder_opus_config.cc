@@ -72,6 +72,8 @@ bool AudioEncoderOpusConfig::IsOk() const {
     return false;
   if (low_rate_complexity < 0 || low_rate_complexity > 10)
     return false;
+  if (encode_time_budget_us && *encode_time_budget_us <= 0)
+    return false;
   return true;
 }
 }  // namespace webrtc
@@ -60,6 +60,11 @@ struct RTC_EXPORT AudioEncoderOpusConfig {
   int complexity_threshold_bps;
   int complexity_threshold_window_bps;
 
+  // If set, the average time to encode 10 ms of audio is kept below this many
+  // microseconds by lowering the complexity and then the bandwidth, which are
+  // raised again when there is headroom.
+  absl::optional<int> encode_time_budget_us;
+
   bool dtx_enabled;
   std::vector<int> supported_frame_lengths_ms;
   int uplink_bandwidth_update_interval_ms;
@@ -36,6 +36,11 @@ struct PacketOptions {
   bool is_retransmit = false;
   bool included_in_feedback = false;
   bool included_in_allocation = false;
+  // Whether OnBatchComplete() will be called after this packet, e.g. at the
+  // end of the burst of packets sent by the pacer. A transport that supports
+  // it may hold the packet and send the whole batch at once, for example
+  // with sendmmsg().
+  bool batchable = false;
 };
 
 class Transport {
@@ -44,6 +49,9 @@ class Transport {
                        size_t length,
                        const PacketOptions& options) = 0;
   virtual bool SendRtcp(const uint8_t* packet, size_t length) = 0;
+  // Called after the last batchable packet of a batch has been passed to
+  // SendRtp().
+  virtual void OnBatchComplete() {}
 
  protected:
   virtual ~Transport() {}
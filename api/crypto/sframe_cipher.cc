@@ -0,0 +1,273 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/crypto/sframe_cipher.h"
+
+#include <openssl/evp.h>
+#include <string.h>
+
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/message_digest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kSha256Size = 32;
+constexpr size_t kNonceSize = 12;
+constexpr char kExtractSalt[] = "SFrame10";
+
+// Returns the number of bytes needed to store `value`, at least one.
+size_t ByteLength(uint64_t value) {
+  size_t length = 1;
+  while (length < 8 && (value >> (8 * length)) != 0) {
+    ++length;
+  }
+  return length;
+}
+
+void WriteBigEndian(uint64_t value, size_t length, uint8_t* data) {
+  for (size_t i = 0; i < length; ++i) {
+    data[length - 1 - i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+}
+
+uint64_t ReadBigEndian(const uint8_t* data, size_t length) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < length; ++i) {
+    value = (value << 8) | data[i];
+  }
+  return value;
+}
+
+// HKDF-Extract and HKDF-Expand from RFC 5869 with SHA-256. Expand() only
+// produces up to one block of output, which is all SFrame needs.
+void HkdfExtract(rtc::ArrayView<const uint8_t> salt,
+                 rtc::ArrayView<const uint8_t> key,
+                 uint8_t prk[kSha256Size]) {
+  size_t written =
+      rtc::ComputeHmac(rtc::DIGEST_SHA_256, salt.data(), salt.size(),
+                       key.data(), key.size(), prk, kSha256Size);
+  RTC_CHECK_EQ(written, kSha256Size);
+}
+
+void HkdfExpand(const uint8_t prk[kSha256Size],
+                const char* info,
+                rtc::ArrayView<uint8_t> output) {
+  RTC_DCHECK_LE(output.size(), kSha256Size);
+  uint8_t input[32];
+  size_t info_size = strlen(info);
+  RTC_DCHECK_LT(info_size, sizeof(input));
+  memcpy(input, info, info_size);
+  input[info_size] = 0x01;
+  uint8_t block[kSha256Size];
+  size_t written = rtc::ComputeHmac(rtc::DIGEST_SHA_256, prk, kSha256Size,
+                                    input, info_size + 1, block, sizeof(block));
+  RTC_CHECK_EQ(written, kSha256Size);
+  memcpy(output.data(), block, output.size());
+}
+
+EVP_CIPHER_CTX* CreateContext(const EVP_CIPHER* cipher,
+                              const uint8_t* key,
+                              bool encrypt) {
+  EVP_CIPHER_CTX* context = EVP_CIPHER_CTX_new();
+  RTC_CHECK(context);
+  int result =
+      encrypt ? EVP_EncryptInit_ex(context, cipher, nullptr, key, nullptr)
+              : EVP_DecryptInit_ex(context, cipher, nullptr, key, nullptr);
+  RTC_CHECK_EQ(result, 1);
+  return context;
+}
+
+// Feeds `input` to `context`. Additional data is fed with a null `output`.
+bool Update(EVP_CIPHER_CTX* context,
+            bool encrypt,
+            rtc::ArrayView<const uint8_t> input,
+            uint8_t* output) {
+  if (input.empty()) {
+    return true;
+  }
+  int length = 0;
+  return encrypt ? EVP_EncryptUpdate(context, output, &length, input.data(),
+                                     input.size()) == 1
+                 : EVP_DecryptUpdate(context, output, &length, input.data(),
+                                     input.size()) == 1;
+}
+
+}  // namespace
+
+absl::optional<SframeHeader> SframeHeader::Parse(
+    rtc::ArrayView<const uint8_t> data,
+    size_t* size) {
+  if (data.empty() || (data[0] & 0x80) != 0) {
+    return absl::nullopt;
+  }
+  const size_t counter_length = ((data[0] >> 4) & 0x07) + 1;
+  const bool extended_key_id = (data[0] & 0x08) != 0;
+  const size_t key_id_length = extended_key_id ? (data[0] & 0x07) + 1 : 0;
+  const size_t header_size = 1 + key_id_length + counter_length;
+  if (data.size() < header_size) {
+    return absl::nullopt;
+  }
+  SframeHeader header;
+  header.key_id = extended_key_id ? ReadBigEndian(&data[1], key_id_length)
+                                  : (data[0] & 0x07);
+  header.counter = ReadBigEndian(&data[1 + key_id_length], counter_length);
+  *size = header_size;
+  return header;
+}
+
+size_t SframeHeader::Size() const {
+  return 1 + (key_id > 7 ? ByteLength(key_id) : 0) + ByteLength(counter);
+}
+
+size_t SframeHeader::Write(rtc::ArrayView<uint8_t> data) const {
+  const size_t size = Size();
+  RTC_DCHECK_GE(data.size(), size);
+  const size_t counter_length = ByteLength(counter);
+  uint8_t config = static_cast<uint8_t>((counter_length - 1) << 4);
+  size_t key_id_length = 0;
+  if (key_id > 7) {
+    key_id_length = ByteLength(key_id);
+    config |= 0x08 | static_cast<uint8_t>(key_id_length - 1);
+    WriteBigEndian(key_id, key_id_length, &data[1]);
+  } else {
+    config |= static_cast<uint8_t>(key_id);
+  }
+  data[0] = config;
+  WriteBigEndian(counter, counter_length, &data[1 + key_id_length]);
+  return size;
+}
+
+// static
+std::unique_ptr<SframeCipher> SframeCipher::Create(
+    rtc::ArrayView<const uint8_t> base_key) {
+  const EVP_CIPHER* cipher;
+  switch (base_key.size()) {
+    case 16:
+      cipher = EVP_aes_128_gcm();
+      break;
+    case 32:
+      cipher = EVP_aes_256_gcm();
+      break;
+    default:
+      return nullptr;
+  }
+  uint8_t secret[kSha256Size];
+  HkdfExtract(rtc::MakeArrayView(reinterpret_cast<const uint8_t*>(kExtractSalt),
+                                 strlen(kExtractSalt)),
+              base_key, secret);
+  uint8_t key[32];
+  HkdfExpand(secret, "key", rtc::MakeArrayView(key, base_key.size()));
+  uint8_t salt[kNonceSize];
+  HkdfExpand(secret, "salt", salt);
+
+  auto sframe_cipher = absl::WrapUnique(new SframeCipher(
+      std::vector<uint8_t>(base_key.begin(), base_key.end()),
+      CreateContext(cipher, key, /*encrypt=*/true),
+      CreateContext(cipher, key, /*encrypt=*/false), salt));
+  memset(key, 0, sizeof(key));
+  memset(secret, 0, sizeof(secret));
+  return sframe_cipher;
+}
+
+SframeCipher::SframeCipher(std::vector<uint8_t> base_key,
+                           EVP_CIPHER_CTX* encrypt_context,
+                           EVP_CIPHER_CTX* decrypt_context,
+                           const uint8_t* salt)
+    : base_key_(std::move(base_key)),
+      encrypt_context_(encrypt_context),
+      decrypt_context_(decrypt_context) {
+  memcpy(salt_, salt, sizeof(salt_));
+}
+
+SframeCipher::~SframeCipher() {
+  EVP_CIPHER_CTX_free(encrypt_context_);
+  EVP_CIPHER_CTX_free(decrypt_context_);
+}
+
+std::unique_ptr<SframeCipher> SframeCipher::Ratchet() const {
+  uint8_t secret[kSha256Size];
+  HkdfExtract(rtc::MakeArrayView(reinterpret_cast<const uint8_t*>(kExtractSalt),
+                                 strlen(kExtractSalt)),
+              base_key_, secret);
+  std::vector<uint8_t> next_base_key(base_key_.size());
+  HkdfExpand(secret, "ratchet", next_base_key);
+  memset(secret, 0, sizeof(secret));
+  return Create(next_base_key);
+}
+
+bool SframeCipher::Seal(uint64_t counter,
+                        rtc::ArrayView<const uint8_t> header,
+                        rtc::ArrayView<const uint8_t> additional_data,
+                        rtc::ArrayView<const uint8_t> plaintext,
+                        rtc::ArrayView<uint8_t> output) {
+  RTC_DCHECK_GE(output.size(), plaintext.size() + kTagSize);
+  uint8_t nonce[kNonceSize];
+  ComputeNonce(counter, nonce);
+  int length = 0;
+  return EVP_EncryptInit_ex(encrypt_context_, nullptr, nullptr, nullptr,
+                            nonce) == 1 &&
+         Update(encrypt_context_, /*encrypt=*/true, header, nullptr) &&
+         Update(encrypt_context_, /*encrypt=*/true, additional_data,
+                nullptr) &&
+         Update(encrypt_context_, /*encrypt=*/true, plaintext,
+                output.data()) &&
+         EVP_EncryptFinal_ex(encrypt_context_,
+                             output.data() + plaintext.size(), &length) == 1 &&
+         EVP_CIPHER_CTX_ctrl(encrypt_context_, EVP_CTRL_GCM_GET_TAG, kTagSize,
+                             output.data() + plaintext.size()) == 1;
+}
+
+bool SframeCipher::Open(uint64_t counter,
+                        rtc::ArrayView<const uint8_t> header,
+                        rtc::ArrayView<const uint8_t> additional_data,
+                        rtc::ArrayView<const uint8_t> ciphertext,
+                        rtc::ArrayView<const uint8_t, kTagSize> tag,
+                        rtc::ArrayView<uint8_t> output) {
+  RTC_DCHECK_GE(output.size(), ciphertext.size());
+  uint8_t nonce[kNonceSize];
+  ComputeNonce(counter, nonce);
+  uint8_t expected_tag[kTagSize];
+  memcpy(expected_tag, tag.data(), kTagSize);
+  int length = 0;
+  if (EVP_DecryptInit_ex(decrypt_context_, nullptr, nullptr, nullptr, nonce) ==
+          1 &&
+      Update(decrypt_context_, /*encrypt=*/false, header, nullptr) &&
+      Update(decrypt_context_, /*encrypt=*/false, additional_data, nullptr) &&
+      Update(decrypt_context_, /*encrypt=*/false, ciphertext, output.data()) &&
+      EVP_CIPHER_CTX_ctrl(decrypt_context_, EVP_CTRL_GCM_SET_TAG, kTagSize,
+                          expected_tag) == 1 &&
+      EVP_DecryptFinal_ex(decrypt_context_, output.data() + ciphertext.size(),
+                          &length) == 1) {
+    return true;
+  }
+  if (output.data() == ciphertext.data()) {
+    // AES-GCM encrypts with a key stream, so encrypting the failed output
+    // with the same nonce gives back the ciphertext.
+    rtc::ArrayView<const uint8_t> decrypted(output.data(), ciphertext.size());
+    RTC_CHECK(EVP_EncryptInit_ex(encrypt_context_, nullptr, nullptr, nullptr,
+                                 nonce) == 1 &&
+              Update(encrypt_context_, /*encrypt=*/true, decrypted,
+                     output.data()));
+  }
+  return false;
+}
+
+void SframeCipher::ComputeNonce(uint64_t counter, uint8_t* nonce) const {
+  memcpy(nonce, salt_, kNonceSize);
+  for (size_t i = 0; i < 8; ++i) {
+    nonce[kNonceSize - 1 - i] ^= static_cast<uint8_t>(counter >> (8 * i));
+  }
+}
+
+}  // namespace webrtc
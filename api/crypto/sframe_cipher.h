@@ -0,0 +1,107 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef API_CRYPTO_SFRAME_CIPHER_H_
+#define API_CRYPTO_SFRAME_CIPHER_H_
+
+#include <openssl/ossl_typ.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+
+namespace webrtc {
+
+// The SFrame header, see draft-ietf-sframe-enc. It starts with a config byte
+// |R|LEN|X|K|, where LEN + 1 is the length of the frame counter. Key ids up to
+// 7 are stored in K. Larger key ids follow the config byte in K + 1 bytes, and
+// X is set. The big endian frame counter comes last.
+struct SframeHeader {
+  static constexpr size_t kMaxSize = 1 + 8 + 8;
+
+  // Returns the parsed header and its size in `size`, or nullopt if `data`
+  // doesn't start with a valid header.
+  static absl::optional<SframeHeader> Parse(rtc::ArrayView<const uint8_t> data,
+                                            size_t* size);
+
+  // Returns the size of the header in its shortest encoding.
+  size_t Size() const;
+  // Writes the header to `data`, which must hold at least Size() bytes, and
+  // returns Size().
+  size_t Write(rtc::ArrayView<uint8_t> data) const;
+
+  uint64_t key_id = 0;
+  uint64_t counter = 0;
+};
+
+// AES-GCM with the key and salt that SFrame derives from a base key, using
+// HKDF-SHA256. Base keys of 16 and 32 bytes select AES-128-GCM and
+// AES-256-GCM. The key schedule is set up once, so sealing and opening a
+// frame only sets the nonce and doesn't allocate. Not thread safe.
+class SframeCipher {
+ public:
+  static constexpr size_t kTagSize = 16;
+
+  // Returns nullptr if `base_key` has an unsupported size.
+  static std::unique_ptr<SframeCipher> Create(
+      rtc::ArrayView<const uint8_t> base_key);
+
+  ~SframeCipher();
+  SframeCipher(const SframeCipher&) = delete;
+  SframeCipher& operator=(const SframeCipher&) = delete;
+
+  // Returns the cipher for the next base key of the ratchet, which is derived
+  // from this base key with HKDF. Senders and receivers that ratchet in step
+  // keep communicating without exchanging new keys.
+  std::unique_ptr<SframeCipher> Ratchet() const;
+
+  // Encrypts `plaintext` with the nonce for `counter` and authenticates it
+  // together with `header` and `additional_data`. Writes the ciphertext
+  // followed by the tag to `output`, which must hold plaintext.size() +
+  // kTagSize bytes and must not partially overlap `plaintext`.
+  bool Seal(uint64_t counter,
+            rtc::ArrayView<const uint8_t> header,
+            rtc::ArrayView<const uint8_t> additional_data,
+            rtc::ArrayView<const uint8_t> plaintext,
+            rtc::ArrayView<uint8_t> output);
+
+  // Reverses Seal(), given the ciphertext and its tag separately. `output`
+  // must hold ciphertext.size() bytes and either start at `ciphertext`, to
+  // decrypt in place, or not overlap it. Returns false if the ciphertext
+  // fails authentication, in which case a frame decrypted in place is
+  // restored so that it can be opened with another key.
+  bool Open(uint64_t counter,
+            rtc::ArrayView<const uint8_t> header,
+            rtc::ArrayView<const uint8_t> additional_data,
+            rtc::ArrayView<const uint8_t> ciphertext,
+            rtc::ArrayView<const uint8_t, kTagSize> tag,
+            rtc::ArrayView<uint8_t> output);
+
+ private:
+  SframeCipher(std::vector<uint8_t> base_key,
+               EVP_CIPHER_CTX* encrypt_context,
+               EVP_CIPHER_CTX* decrypt_context,
+               const uint8_t* salt);
+
+  void ComputeNonce(uint64_t counter, uint8_t* nonce) const;
+
+  const std::vector<uint8_t> base_key_;
+  EVP_CIPHER_CTX* const encrypt_context_;
+  EVP_CIPHER_CTX* const decrypt_context_;
+  uint8_t salt_[12];
+};
+
+}  // namespace webrtc
+
+#endif  // API_CRYPTO_SFRAME_CIPHER_H_
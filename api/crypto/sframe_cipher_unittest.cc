@@ -0,0 +1,118 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/crypto/sframe_cipher.h"
+
+#include <memory>
+#include <vector>
+
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAreArray;
+using ::testing::Not;
+
+const uint8_t kBaseKey[16] = {1, 2,  3,  4,  5,  6,  7,  8,
+                              9, 10, 11, 12, 13, 14, 15, 16};
+
+TEST(SframeHeaderTest, WritesShortestHeader) {
+  uint8_t data[SframeHeader::kMaxSize];
+  SframeHeader header;
+  header.key_id = 5;
+  header.counter = 3;
+  EXPECT_EQ(header.Write(data), 2u);
+  EXPECT_EQ(data[0], 0x05);
+  EXPECT_EQ(data[1], 0x03);
+
+  header.key_id = 0x1234;
+  header.counter = 0x010203;
+  EXPECT_EQ(header.Write(data), 6u);
+  EXPECT_EQ(data[0], 0x29);
+  EXPECT_THAT(rtc::MakeArrayView(data + 1, 5),
+              ElementsAreArray({0x12, 0x34, 0x01, 0x02, 0x03}));
+}
+
+TEST(SframeHeaderTest, ParsesWrittenHeader) {
+  for (uint64_t value : {uint64_t{0}, uint64_t{7}, uint64_t{8}, uint64_t{255},
+                         uint64_t{0x123456789}, ~uint64_t{0}}) {
+    SframeHeader header;
+    header.key_id = value;
+    header.counter = ~value;
+    uint8_t data[SframeHeader::kMaxSize];
+    const size_t written = header.Write(data);
+    EXPECT_EQ(written, header.Size());
+
+    size_t size = 0;
+    absl::optional<SframeHeader> parsed = SframeHeader::Parse(data, &size);
+    ASSERT_TRUE(parsed);
+    EXPECT_EQ(size, written);
+    EXPECT_EQ(parsed->key_id, value);
+    EXPECT_EQ(parsed->counter, ~value);
+    EXPECT_FALSE(SframeHeader::Parse(rtc::MakeArrayView(data, written - 1),
+                                     &size));
+  }
+}
+
+TEST(SframeCipherTest, RejectsUnsupportedKeySize) {
+  EXPECT_TRUE(SframeCipher::Create(rtc::MakeArrayView(kBaseKey, 16)));
+  EXPECT_FALSE(SframeCipher::Create(rtc::MakeArrayView(kBaseKey, 15)));
+  std::vector<uint8_t> key(32, 7);
+  EXPECT_TRUE(SframeCipher::Create(key));
+}
+
+TEST(SframeCipherTest, OpensSealedData) {
+  std::unique_ptr<SframeCipher> cipher = SframeCipher::Create(kBaseKey);
+  const uint8_t header[] = {0x00, 0x01};
+  const uint8_t additional_data[] = {9, 9};
+  const std::vector<uint8_t> plaintext(100, 42);
+  std::vector<uint8_t> sealed(plaintext.size() + SframeCipher::kTagSize);
+  ASSERT_TRUE(cipher->Seal(1, header, additional_data, plaintext, sealed));
+  EXPECT_THAT(rtc::MakeArrayView(sealed.data(), plaintext.size()),
+              Not(ElementsAreArray(plaintext)));
+
+  rtc::ArrayView<const uint8_t> ciphertext(sealed.data(), plaintext.size());
+  rtc::ArrayView<const uint8_t, SframeCipher::kTagSize> tag(
+      sealed.data() + plaintext.size(), SframeCipher::kTagSize);
+  std::vector<uint8_t> opened(plaintext.size());
+  EXPECT_TRUE(
+      cipher->Open(1, header, additional_data, ciphertext, tag, opened));
+  EXPECT_EQ(opened, plaintext);
+
+  // Another counter, header or additional data fails authentication.
+  EXPECT_FALSE(
+      cipher->Open(2, header, additional_data, ciphertext, tag, opened));
+  const uint8_t other_header[] = {0x00, 0x02};
+  EXPECT_FALSE(
+      cipher->Open(1, other_header, additional_data, ciphertext, tag, opened));
+  EXPECT_FALSE(cipher->Open(1, header, {}, ciphertext, tag, opened));
+}
+
+TEST(SframeCipherTest, RestoresDataThatFailsToOpenInPlace) {
+  std::unique_ptr<SframeCipher> cipher = SframeCipher::Create(kBaseKey);
+  std::unique_ptr<SframeCipher> ratcheted = cipher->Ratchet();
+  const std::vector<uint8_t> plaintext(100, 42);
+  std::vector<uint8_t> sealed(plaintext.size() + SframeCipher::kTagSize);
+  ASSERT_TRUE(ratcheted->Seal(1, {}, {}, plaintext, sealed));
+  const std::vector<uint8_t> original = sealed;
+
+  rtc::ArrayView<uint8_t> data(sealed.data(), plaintext.size());
+  rtc::ArrayView<const uint8_t, SframeCipher::kTagSize> tag(
+      original.data() + plaintext.size(), SframeCipher::kTagSize);
+  EXPECT_FALSE(cipher->Open(1, {}, {}, data, tag, data));
+  EXPECT_EQ(sealed, original);
+  EXPECT_TRUE(ratcheted->Open(1, {}, {}, data, tag, data));
+  EXPECT_THAT(data, ElementsAreArray(plaintext));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,134 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/crypto/sframe_frame_decryptor.h"
+
+#include <string.h>
+
+#include <utility>
+
+#include "absl/types/optional.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+// The shortest header has a config byte and a one byte counter.
+constexpr size_t kMinHeaderSize = 2;
+
+}  // namespace
+
+SframeFrameDecryptor::SframeFrameDecryptor(int max_ratchet_steps)
+    : max_ratchet_steps_(max_ratchet_steps) {
+  RTC_DCHECK_GE(max_ratchet_steps_, 0);
+}
+
+SframeFrameDecryptor::~SframeFrameDecryptor() = default;
+
+bool SframeFrameDecryptor::SetKey(uint64_t key_id,
+                                  rtc::ArrayView<const uint8_t> base_key) {
+  std::unique_ptr<SframeCipher> cipher = SframeCipher::Create(base_key);
+  if (!cipher) {
+    return false;
+  }
+  MutexLock lock(&mutex_);
+  Key& key = keys_[key_id];
+  key.cipher = std::move(cipher);
+  key.ratchet.clear();
+  return true;
+}
+
+void SframeFrameDecryptor::RemoveKey(uint64_t key_id) {
+  MutexLock lock(&mutex_);
+  keys_.erase(key_id);
+}
+
+SframeFrameDecryptor::Result SframeFrameDecryptor::Decrypt(
+    cricket::MediaType media_type,
+    const std::vector<uint32_t>& csrcs,
+    rtc::ArrayView<const uint8_t> additional_data,
+    rtc::ArrayView<const uint8_t> encrypted_frame,
+    rtc::ArrayView<uint8_t> frame) {
+  size_t header_size = 0;
+  absl::optional<SframeHeader> header =
+      SframeHeader::Parse(encrypted_frame, &header_size);
+  if (!header ||
+      encrypted_frame.size() < header_size + SframeCipher::kTagSize) {
+    return Result(Status::kFailedToDecrypt, 0);
+  }
+  const size_t plaintext_size =
+      encrypted_frame.size() - header_size - SframeCipher::kTagSize;
+  if (frame.size() < plaintext_size) {
+    return Result(Status::kFailedToDecrypt, 0);
+  }
+
+  MutexLock lock(&mutex_);
+  auto it = keys_.find(header->key_id);
+  if (it == keys_.end()) {
+    return Result(Status::kRecoverable, 0);
+  }
+  Key& key = it->second;
+
+  // The header and tag are copied, since decrypting in place moves the
+  // ciphertext to the start of the frame, over the header.
+  uint8_t header_data[SframeHeader::kMaxSize];
+  memcpy(header_data, encrypted_frame.data(), header_size);
+  rtc::ArrayView<const uint8_t> header_view(header_data, header_size);
+  uint8_t tag[SframeCipher::kTagSize];
+  memcpy(tag, encrypted_frame.data() + header_size + plaintext_size,
+         SframeCipher::kTagSize);
+  rtc::ArrayView<const uint8_t> ciphertext =
+      encrypted_frame.subview(header_size, plaintext_size);
+  rtc::ArrayView<uint8_t> plaintext = frame.subview(0, plaintext_size);
+  const bool in_place =
+      plaintext.data() < ciphertext.data() + ciphertext.size() &&
+      ciphertext.data() < plaintext.data() + plaintext.size();
+  if (in_place) {
+    memmove(plaintext.data(), ciphertext.data(), plaintext_size);
+  }
+  rtc::ArrayView<const uint8_t> input = in_place ? plaintext : ciphertext;
+
+  if (key.cipher->Open(header->counter, header_view, additional_data, input,
+                       tag, plaintext)) {
+    return Result(Status::kOk, plaintext_size);
+  }
+  for (int step = 0; step < max_ratchet_steps_; ++step) {
+    if (key.ratchet.size() <= static_cast<size_t>(step)) {
+      const SframeCipher& previous =
+          step == 0 ? *key.cipher : *key.ratchet.back();
+      key.ratchet.push_back(previous.Ratchet());
+    }
+    if (key.ratchet[step]->Open(header->counter, header_view, additional_data,
+                                input, tag, plaintext)) {
+      key.cipher = std::move(key.ratchet[step]);
+      key.ratchet.erase(key.ratchet.begin(), key.ratchet.begin() + step + 1);
+      return Result(Status::kOk, plaintext_size);
+    }
+  }
+  if (in_place) {
+    // Open() restored the ciphertext. Put the frame back the way it came, in
+    // case it's retried once another key is set. The caller passed the same
+    // writable buffer as `frame`.
+    uint8_t* encrypted_data = const_cast<uint8_t*>(encrypted_frame.data());
+    memmove(encrypted_data + header_size, plaintext.data(), plaintext_size);
+    memcpy(encrypted_data, header_data, header_size);
+  }
+  return Result(Status::kFailedToDecrypt, 0);
+}
+
+size_t SframeFrameDecryptor::GetMaxPlaintextByteSize(
+    cricket::MediaType media_type,
+    size_t encrypted_frame_size) {
+  return encrypted_frame_size > kMinHeaderSize + SframeCipher::kTagSize
+             ? encrypted_frame_size - kMinHeaderSize - SframeCipher::kTagSize
+             : 0;
+}
+
+}  // namespace webrtc
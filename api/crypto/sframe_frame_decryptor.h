@@ -0,0 +1,75 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef API_CRYPTO_SFRAME_FRAME_DECRYPTOR_H_
+#define API_CRYPTO_SFRAME_FRAME_DECRYPTOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/crypto/frame_decryptor_interface.h"
+#include "api/crypto/sframe_cipher.h"
+#include "api/media_types.h"
+#include "rtc_base/containers/flat_map.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Decrypts frames encrypted by SframeFrameEncryptor. Frames may be decrypted
+// in place, as BufferedFrameDecryptor does, by passing a `frame` that starts
+// at `encrypted_frame`.
+//
+// A frame that fails authentication is retried with the next keys of the
+// ratchet of its key id, up to `max_ratchet_steps` ahead, so that the sender
+// may ratchet its key without signaling it. The ratcheted keys are derived
+// once and cached, and the key of a frame that succeeds replaces the current
+// one.
+//
+// Thread safe, so that keys can be set while frames are being decrypted.
+class SframeFrameDecryptor : public FrameDecryptorInterface {
+ public:
+  explicit SframeFrameDecryptor(int max_ratchet_steps = 0);
+  ~SframeFrameDecryptor() override;
+
+  // Decrypts frames with key id `key_id` with the key derived from
+  // `base_key`, which must be 16 or 32 bytes long. Returns false if it isn't.
+  bool SetKey(uint64_t key_id, rtc::ArrayView<const uint8_t> base_key);
+  void RemoveKey(uint64_t key_id);
+
+  // FrameDecryptorInterface implementation. Frames with an unknown key id are
+  // reported as kRecoverable, since the key may still be set.
+  Result Decrypt(cricket::MediaType media_type,
+                 const std::vector<uint32_t>& csrcs,
+                 rtc::ArrayView<const uint8_t> additional_data,
+                 rtc::ArrayView<const uint8_t> encrypted_frame,
+                 rtc::ArrayView<uint8_t> frame) override;
+  size_t GetMaxPlaintextByteSize(cricket::MediaType media_type,
+                                 size_t encrypted_frame_size) override;
+
+ private:
+  struct Key {
+    std::unique_ptr<SframeCipher> cipher;
+    // The next keys of the ratchet, derived when a frame first fails.
+    std::vector<std::unique_ptr<SframeCipher>> ratchet;
+  };
+
+  const int max_ratchet_steps_;
+  Mutex mutex_;
+  flat_map<uint64_t, Key> keys_ RTC_GUARDED_BY(mutex_);
+};
+
+}  // namespace webrtc
+
+#endif  // API_CRYPTO_SFRAME_FRAME_DECRYPTOR_H_
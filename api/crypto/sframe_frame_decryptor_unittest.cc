@@ -0,0 +1,164 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/crypto/sframe_frame_decryptor.h"
+
+#include <vector>
+
+#include "api/crypto/sframe_frame_encryptor.h"
+#include "api/scoped_refptr.h"
+#include "rtc_base/ref_counted_object.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAreArray;
+
+using Status = FrameDecryptorInterface::Status;
+
+const uint8_t kBaseKey[16] = {1, 2,  3,  4,  5,  6,  7,  8,
+                              9, 10, 11, 12, 13, 14, 15, 16};
+const uint8_t kOtherBaseKey[16] = {16, 15, 14, 13, 12, 11, 10, 9,
+                                   8,  7,  6,  5,  4,  3,  2,  1};
+const uint8_t kAdditionalData[] = {0xad, 0xda};
+
+class SframeFrameDecryptorTest : public ::testing::Test {
+ protected:
+  SframeFrameDecryptorTest()
+      : encryptor_(rtc::make_ref_counted<SframeFrameEncryptor>()),
+        frame_(1000) {
+    for (size_t i = 0; i < frame_.size(); ++i) {
+      frame_[i] = static_cast<uint8_t>(i);
+    }
+  }
+
+  std::vector<uint8_t> Encrypt() {
+    std::vector<uint8_t> encrypted(encryptor_->GetMaxCiphertextByteSize(
+        cricket::MEDIA_TYPE_VIDEO, frame_.size()));
+    size_t bytes_written = 0;
+    EXPECT_EQ(encryptor_->Encrypt(cricket::MEDIA_TYPE_VIDEO, /*ssrc=*/1,
+                                  kAdditionalData, frame_, encrypted,
+                                  &bytes_written),
+              0);
+    encrypted.resize(bytes_written);
+    return encrypted;
+  }
+
+  // Decrypts `encrypted` in place, like BufferedFrameDecryptor.
+  FrameDecryptorInterface::Result DecryptInPlace(
+      SframeFrameDecryptor& decryptor,
+      std::vector<uint8_t>& encrypted) {
+    rtc::ArrayView<uint8_t> frame(
+        encrypted.data(), decryptor.GetMaxPlaintextByteSize(
+                              cricket::MEDIA_TYPE_VIDEO, encrypted.size()));
+    return decryptor.Decrypt(cricket::MEDIA_TYPE_VIDEO, /*csrcs=*/{},
+                             kAdditionalData, encrypted, frame);
+  }
+
+  const rtc::scoped_refptr<SframeFrameEncryptor> encryptor_;
+  std::vector<uint8_t> frame_;
+};
+
+TEST_F(SframeFrameDecryptorTest, FailsToEncryptWithoutKey) {
+  std::vector<uint8_t> encrypted(encryptor_->GetMaxCiphertextByteSize(
+      cricket::MEDIA_TYPE_VIDEO, frame_.size()));
+  size_t bytes_written = 0;
+  EXPECT_EQ(encryptor_->Encrypt(cricket::MEDIA_TYPE_VIDEO, /*ssrc=*/1, {},
+                                frame_, encrypted, &bytes_written),
+            static_cast<int>(SframeFrameEncryptor::Status::kNoKey));
+  EXPECT_FALSE(encryptor_->RatchetKey());
+}
+
+TEST_F(SframeFrameDecryptorTest, DecryptsIntoSeparateBuffer) {
+  ASSERT_TRUE(encryptor_->SetKey(3, kBaseKey));
+  std::vector<uint8_t> encrypted = Encrypt();
+  EXPECT_EQ(encrypted.size(), 2 + frame_.size() + SframeCipher::kTagSize);
+
+  auto decryptor = rtc::make_ref_counted<SframeFrameDecryptor>();
+  ASSERT_TRUE(decryptor->SetKey(3, kBaseKey));
+  std::vector<uint8_t> decrypted(decryptor->GetMaxPlaintextByteSize(
+      cricket::MEDIA_TYPE_VIDEO, encrypted.size()));
+  FrameDecryptorInterface::Result result =
+      decryptor->Decrypt(cricket::MEDIA_TYPE_VIDEO, /*csrcs=*/{},
+                         kAdditionalData, encrypted, decrypted);
+  ASSERT_TRUE(result.IsOk());
+  decrypted.resize(result.bytes_written);
+  EXPECT_EQ(decrypted, frame_);
+}
+
+TEST_F(SframeFrameDecryptorTest, DecryptsInPlace) {
+  ASSERT_TRUE(encryptor_->SetKey(1000, kBaseKey));
+  auto decryptor = rtc::make_ref_counted<SframeFrameDecryptor>();
+  ASSERT_TRUE(decryptor->SetKey(1000, kBaseKey));
+  for (int i = 0; i < 3; ++i) {
+    std::vector<uint8_t> encrypted = Encrypt();
+    FrameDecryptorInterface::Result result =
+        DecryptInPlace(*decryptor, encrypted);
+    ASSERT_TRUE(result.IsOk());
+    EXPECT_THAT(rtc::MakeArrayView(encrypted.data(), result.bytes_written),
+                ElementsAreArray(frame_));
+  }
+}
+
+TEST_F(SframeFrameDecryptorTest, KeepsFrameWithUnknownKeyForRetry) {
+  ASSERT_TRUE(encryptor_->SetKey(1, kBaseKey));
+  std::vector<uint8_t> encrypted = Encrypt();
+  const std::vector<uint8_t> original = encrypted;
+
+  auto decryptor = rtc::make_ref_counted<SframeFrameDecryptor>();
+  EXPECT_EQ(DecryptInPlace(*decryptor, encrypted).status,
+            Status::kRecoverable);
+  ASSERT_TRUE(decryptor->SetKey(1, kOtherBaseKey));
+  EXPECT_EQ(DecryptInPlace(*decryptor, encrypted).status,
+            Status::kFailedToDecrypt);
+  EXPECT_EQ(encrypted, original);
+
+  ASSERT_TRUE(decryptor->SetKey(1, kBaseKey));
+  EXPECT_TRUE(DecryptInPlace(*decryptor, encrypted).IsOk());
+}
+
+TEST_F(SframeFrameDecryptorTest, FailsToDecryptTamperedFrame) {
+  ASSERT_TRUE(encryptor_->SetKey(1, kBaseKey));
+  std::vector<uint8_t> encrypted = Encrypt();
+  encrypted[10] ^= 1;
+  auto decryptor = rtc::make_ref_counted<SframeFrameDecryptor>();
+  ASSERT_TRUE(decryptor->SetKey(1, kBaseKey));
+  EXPECT_EQ(DecryptInPlace(*decryptor, encrypted).status,
+            Status::kFailedToDecrypt);
+}
+
+TEST_F(SframeFrameDecryptorTest, FollowsRatchetedKey) {
+  ASSERT_TRUE(encryptor_->SetKey(1, kBaseKey));
+  auto decryptor =
+      rtc::make_ref_counted<SframeFrameDecryptor>(/*max_ratchet_steps=*/2);
+  ASSERT_TRUE(decryptor->SetKey(1, kBaseKey));
+
+  ASSERT_TRUE(encryptor_->RatchetKey());
+  ASSERT_TRUE(encryptor_->RatchetKey());
+  std::vector<uint8_t> encrypted = Encrypt();
+  EXPECT_TRUE(DecryptInPlace(*decryptor, encrypted).IsOk());
+
+  // The ratcheted key is now the current one.
+  encrypted = Encrypt();
+  EXPECT_TRUE(DecryptInPlace(*decryptor, encrypted).IsOk());
+
+  // Too many steps ahead.
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(encryptor_->RatchetKey());
+  }
+  encrypted = Encrypt();
+  EXPECT_EQ(DecryptInPlace(*decryptor, encrypted).status,
+            Status::kFailedToDecrypt);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,78 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/crypto/sframe_frame_encryptor.h"
+
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+SframeFrameEncryptor::SframeFrameEncryptor() = default;
+
+SframeFrameEncryptor::~SframeFrameEncryptor() = default;
+
+bool SframeFrameEncryptor::SetKey(uint64_t key_id,
+                                  rtc::ArrayView<const uint8_t> base_key) {
+  // The key schedule is set up outside the lock, so that frames being
+  // encrypted don't wait for it.
+  std::unique_ptr<SframeCipher> cipher = SframeCipher::Create(base_key);
+  if (!cipher) {
+    return false;
+  }
+  MutexLock lock(&mutex_);
+  key_id_ = key_id;
+  cipher_ = std::move(cipher);
+  return true;
+}
+
+bool SframeFrameEncryptor::RatchetKey() {
+  MutexLock lock(&mutex_);
+  if (!cipher_) {
+    return false;
+  }
+  cipher_ = cipher_->Ratchet();
+  return true;
+}
+
+int SframeFrameEncryptor::Encrypt(cricket::MediaType media_type,
+                                  uint32_t ssrc,
+                                  rtc::ArrayView<const uint8_t> additional_data,
+                                  rtc::ArrayView<const uint8_t> frame,
+                                  rtc::ArrayView<uint8_t> encrypted_frame,
+                                  size_t* bytes_written) {
+  MutexLock lock(&mutex_);
+  if (!cipher_) {
+    return static_cast<int>(Status::kNoKey);
+  }
+  SframeHeader header;
+  header.key_id = key_id_;
+  header.counter = counter_++;
+  const size_t header_size = header.Size();
+  RTC_CHECK_GE(encrypted_frame.size(),
+               header_size + frame.size() + SframeCipher::kTagSize);
+  header.Write(encrypted_frame);
+  if (!cipher_->Seal(header.counter, encrypted_frame.subview(0, header_size),
+                     additional_data, frame,
+                     encrypted_frame.subview(header_size))) {
+    return static_cast<int>(Status::kFailedToEncrypt);
+  }
+  *bytes_written = header_size + frame.size() + SframeCipher::kTagSize;
+  return static_cast<int>(Status::kOk);
+}
+
+size_t SframeFrameEncryptor::GetMaxCiphertextByteSize(
+    cricket::MediaType media_type,
+    size_t frame_size) {
+  return SframeHeader::kMaxSize + frame_size + SframeCipher::kTagSize;
+}
+
+}  // namespace webrtc
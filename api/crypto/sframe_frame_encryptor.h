@@ -0,0 +1,74 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef API_CRYPTO_SFRAME_FRAME_ENCRYPTOR_H_
+#define API_CRYPTO_SFRAME_FRAME_ENCRYPTOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+
+#include "api/array_view.h"
+#include "api/crypto/frame_encryptor_interface.h"
+#include "api/crypto/sframe_cipher.h"
+#include "api/media_types.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Encrypts frames with AES-GCM in the SFrame format: a header with the key id
+// and a frame counter, followed by the ciphertext and its tag. The header is
+// authenticated together with the additional data. Decrypt the frames with
+// SframeFrameDecryptor.
+//
+// Thread safe, so that keys can be set while frames are being encrypted.
+class SframeFrameEncryptor : public FrameEncryptorInterface {
+ public:
+  enum class Status : int {
+    kOk = 0,
+    kNoKey = 1,
+    kFailedToEncrypt = 2,
+  };
+
+  SframeFrameEncryptor();
+  ~SframeFrameEncryptor() override;
+
+  // Encrypts the following frames with the key derived from `base_key`, which
+  // must be 16 or 32 bytes long. Returns false, and keeps the previous key, if
+  // it isn't.
+  bool SetKey(uint64_t key_id, rtc::ArrayView<const uint8_t> base_key);
+
+  // Moves the current key one step along its ratchet, see
+  // SframeCipher::Ratchet(). Returns false if no key is set.
+  bool RatchetKey();
+
+  // FrameEncryptorInterface implementation.
+  int Encrypt(cricket::MediaType media_type,
+              uint32_t ssrc,
+              rtc::ArrayView<const uint8_t> additional_data,
+              rtc::ArrayView<const uint8_t> frame,
+              rtc::ArrayView<uint8_t> encrypted_frame,
+              size_t* bytes_written) override;
+  size_t GetMaxCiphertextByteSize(cricket::MediaType media_type,
+                                  size_t frame_size) override;
+
+ private:
+  Mutex mutex_;
+  uint64_t key_id_ RTC_GUARDED_BY(mutex_) = 0;
+  std::unique_ptr<SframeCipher> cipher_ RTC_GUARDED_BY(mutex_);
+  // Never reset, so that nonces aren't reused when a key is set again.
+  uint64_t counter_ RTC_GUARDED_BY(mutex_) = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // API_CRYPTO_SFRAME_FRAME_ENCRYPTOR_H_
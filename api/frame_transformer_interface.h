@@ -33,6 +33,13 @@ class TransformableFrameInterface {
   // Copies `data` into the owned frame payload data.
   virtual void SetData(rtc::ArrayView<const uint8_t> data) = 0;
 
+  // Returns the frame payload data for transforming it in place, which saves
+  // the copy made by SetData() when the transform doesn't change the size.
+  // Frames that share their payload with others copy it once on the first
+  // call. The data is valid until the next non-const method call. Returns an
+  // empty view if the frame can't be written in place; use SetData() then.
+  virtual rtc::ArrayView<uint8_t> GetMutableData() { return {}; }
+
   virtual uint8_t GetPayloadType() const = 0;
   virtual uint32_t GetSsrc() const = 0;
   virtual uint32_t GetTimestamp() const = 0;
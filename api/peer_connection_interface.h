@@ -694,6 +694,18 @@ class RTC_EXPORT PeerConnectionInterface : public rtc::RefCountInterface {
 
     PortAllocatorConfig port_allocator_config;
 
+    // PeerConnections created by the same factory with the same `call_group`
+    // share a single webrtc::Call. This gives them one bitrate allocator,
+    // send-side congestion controller and pacer, and one set of Call timers.
+    // The bandwidth to a peer is then allocated jointly over all of its
+    // PeerConnections. The PeerConnections of a group all run on the
+    // factory's default network thread, and their local SSRCs are unique
+    // within the group. A remote SSRC that is used by two PeerConnections of
+    // a group is only demultiplexed to the first of them. Events of the shared
+    // Call are not written to the event logs of the PeerConnections. Cannot be
+    // changed by SetConfiguration.
+    absl::optional<std::string> call_group;
+
     //
     // Don't forget to update operator== if adding something.
     //
@@ -1166,6 +1178,9 @@ class RTC_EXPORT PeerConnectionInterface : public rtc::RefCountInterface {
       const = 0;
 
   // Returns the current SignalingState.
+  // This and the other state getters below can be called on any thread without
+  // blocking on the signaling thread. Off the signaling thread, they return the
+  // state as of the last operation that completed there.
   virtual SignalingState signaling_state() = 0;
 
   // Returns an aggregate state of all ICE *and* DTLS transports.
@@ -1417,6 +1432,32 @@ struct RTC_EXPORT PeerConnectionFactoryDependencies final {
   rtc::Thread* network_thread = nullptr;
   rtc::Thread* worker_thread = nullptr;
   rtc::Thread* signaling_thread = nullptr;
+  // When `network_thread` is not set, the factory starts this many network
+  // threads and pins each PeerConnection to the one currently serving the
+  // fewest PeerConnections. PeerConnections created with an injected
+  // `allocator` or `packet_socket_factory` always use the first network
+  // thread. Ignored if `sctp_factory` is set.
+  int network_thread_pool_size = 1;
+  // When positive, the factory starts this many threads and moves the SRTP
+  // encryption and decryption of each PeerConnection's transports to one of
+  // them, instead of running it on the network thread. Packets keep their
+  // order. Useful when forwarding many high-bitrate streams.
+  int srtp_crypto_pool_size = 0;
+  // When positive, the factory starts this many threads and runs the DTLS
+  // handshakes of PeerConnections on them, so that many connections starting
+  // at once don't hold up the packets of established ones on the network
+  // thread. Ignored for DTLS transports made by an injected factory.
+  int dtls_handshake_pool_size = 0;
+  // When true, PeerConnections created without a `cert_generator` share
+  // their DTLS certificates: the factory generates one per key type and hands
+  // it out until it nears expiry. This saves generating a key per connection,
+  // but the shared fingerprint makes the connections linkable.
+  bool share_dtls_certificates = false;
+  // When true, the media engine is initialized on the worker thread in the
+  // background, and factory creation doesn't wait for it. This covers the
+  // audio device module, audio processing and codec enumeration. The first
+  // call that needs the media engine waits for the initialization to finish.
+  bool async_media_engine_init = false;
   std::unique_ptr<TaskQueueFactory> task_queue_factory;
   std::unique_ptr<cricket::MediaEngineInterface> media_engine;
   std::unique_ptr<CallFactoryInterface> call_factory;
@@ -0,0 +1,146 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef API_STATS_RTC_STATS_BINARY_FORMAT_H_
+#define API_STATS_RTC_STATS_BINARY_FORMAT_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "absl/types/variant.h"
+#include "api/scoped_refptr.h"
+#include "api/stats/rtc_stats.h"
+#include "api/stats/rtc_stats_report.h"
+#include "rtc_base/byte_buffer.h"
+#include "rtc_base/system/rtc_export.h"
+
+namespace webrtc {
+
+// Compact binary encoding of a sequence of `RTCStatsReport`s, meant for
+// exporting stats at a high rate, where `RTCStatsReport::ToJson` is too large
+// and too slow to parse.
+//
+// The encoding is stateful: stat IDs, stat types and member names are sent
+// once and then referred to by their index in a string table, and each report
+// only carries the stats objects and members that changed since the previous
+// report. Hence the messages of a writer must be read in order by
+// a single reader. The first message, and the first message after
+// `RTCStatsBinaryWriter::Reset`, is a key frame that restarts the stream.
+//
+// Each message is laid out as follows, where integers are unsigned base 128
+// varints unless noted otherwise:
+//   uint8 flags (bit 0: key frame)
+//   report timestamp
+//   number of new strings, then for each: length, bytes
+//   number of removed stats, then for each: ID index
+//   number of changed stats, then for each:
+//     ID index, type index, zigzag (timestamp - report timestamp),
+//     number of members, then for each:
+//       name index, uint8 (type | 0x80 if undefined), value if defined
+// Signed integers are zigzag encoded, doubles are 8 bytes in network order,
+// strings are a length followed by the bytes, and sequences and maps are a
+// count followed by their elements.
+
+// Value of a decoded stats member. The alternatives are in the order of
+// `RTCStatsMemberInterface::Type`, so that `value.index()` is its type.
+using RTCStatsBinaryValue = absl::variant<bool,
+                                          int32_t,
+                                          uint32_t,
+                                          int64_t,
+                                          uint64_t,
+                                          double,
+                                          std::string,
+                                          std::vector<bool>,
+                                          std::vector<int32_t>,
+                                          std::vector<uint32_t>,
+                                          std::vector<int64_t>,
+                                          std::vector<uint64_t>,
+                                          std::vector<double>,
+                                          std::vector<std::string>,
+                                          std::map<std::string, uint64_t>,
+                                          std::map<std::string, double>>;
+
+class RTC_EXPORT RTCStatsBinaryWriter {
+ public:
+  RTCStatsBinaryWriter();
+  ~RTCStatsBinaryWriter();
+
+  RTCStatsBinaryWriter(const RTCStatsBinaryWriter&) = delete;
+  RTCStatsBinaryWriter& operator=(const RTCStatsBinaryWriter&) = delete;
+
+  // Appends the encoding of `report`, relative to the report of the previous
+  // call, to `buffer`.
+  void Write(rtc::scoped_refptr<const RTCStatsReport> report,
+             rtc::ByteBufferWriter* buffer);
+
+  // Makes the next message a key frame, which does not depend on the previous
+  // messages. Used when a reader joins, or to bound the string table if stat
+  // IDs come and go.
+  void Reset();
+
+ private:
+  uint64_t InternString(const std::string& str);
+  uint64_t InternName(const char* name);
+  // Writes the members of `stats` that differ from `previous` to `body_`.
+  // Returns false, and writes nothing, if there are none.
+  bool WriteStats(const RTCStats& stats,
+                  const RTCStats* previous,
+                  int64_t report_timestamp_us);
+
+  rtc::scoped_refptr<const RTCStatsReport> previous_report_;
+  std::map<std::string, uint64_t> string_indices_;
+  // Member names are static strings, so they are looked up by address first.
+  std::map<const char*, uint64_t> name_indices_;
+  std::vector<const std::string*> new_strings_;
+  rtc::ByteBufferWriter body_;
+};
+
+class RTC_EXPORT RTCStatsBinaryReader {
+ public:
+  struct Stats {
+    std::string type;
+    int64_t timestamp_us = 0;
+    // The defined members, by name.
+    std::map<std::string, RTCStatsBinaryValue> members;
+  };
+
+  RTCStatsBinaryReader();
+  ~RTCStatsBinaryReader();
+
+  RTCStatsBinaryReader(const RTCStatsBinaryReader&) = delete;
+  RTCStatsBinaryReader& operator=(const RTCStatsBinaryReader&) = delete;
+
+  // Reads one message from `buffer` and applies it to the current report.
+  // Returns false if the message is malformed, or if it is not a key frame
+  // while the reader waits for one; the current report is then cleared and
+  // messages are ignored until the next key frame.
+  bool Read(rtc::ByteBufferReader* buffer);
+
+  // The report as of the last message read, by stat ID.
+  int64_t timestamp_us() const { return timestamp_us_; }
+  const std::map<std::string, Stats>& stats() const { return stats_; }
+
+ private:
+  bool ReadMessage(rtc::ByteBufferReader* buffer);
+  // Reads a string table index and returns the string in `str`.
+  bool ReadStringIndex(rtc::ByteBufferReader* buffer, const std::string** str);
+
+  bool needs_key_frame_ = true;
+  std::vector<std::string> strings_;
+  int64_t timestamp_us_ = 0;
+  std::map<std::string, Stats> stats_;
+};
+
+}  // namespace webrtc
+
+#endif  // API_STATS_RTC_STATS_BINARY_FORMAT_H_
@@ -90,6 +90,15 @@ class RTC_EXPORT RTCStatsReport final
   // Takes ownership of all the stats in `other`, leaving it empty.
   void TakeMembersFrom(rtc::scoped_refptr<RTCStatsReport> other);
 
+  // Creates a report with copies of the stats objects that are new or have
+  // changed since `previous`, as compared by `RTCStats::operator==`, such that
+  // a report that is polled periodically can be forwarded as compact updates.
+  // If `removed_ids` is not null, it is set to the IDs of the stats objects of
+  // `previous` that are not in this report.
+  rtc::scoped_refptr<RTCStatsReport> CreateDelta(
+      const RTCStatsReport& previous,
+      std::vector<std::string>* removed_ids = nullptr) const;
+
   // Stats iterators. Stats are ordered lexicographically on `RTCStats::id`.
   ConstIterator begin() const;
   ConstIterator end() const;
@@ -10,9 +10,14 @@
 #ifndef API_TASK_QUEUE_TASK_QUEUE_BASE_H_
 #define API_TASK_QUEUE_TASK_QUEUE_BASE_H_
 
+#include <stdint.h>
+
+#include <algorithm>
 #include <memory>
+#include <utility>
 
 #include "api/task_queue/queued_task.h"
+#include "api/units/time_delta.h"
 #include "rtc_base/system/rtc_export.h"
 #include "rtc_base/thread_annotations.h"
 
@@ -56,6 +61,21 @@ class RTC_LOCKABLE RTC_EXPORT TaskQueueBase {
   virtual void PostDelayedTask(std::unique_ptr<QueuedTask> task,
                                uint32_t milliseconds) = 0;
 
+  // Like PostDelayedTask(), but with microsecond resolution, for tasks that
+  // run too late if their wakeup is rounded up to whole milliseconds or to
+  // the next tick of the system timer, such as pacing. Implementations
+  // should use the most precise timer of the platform, which can be more
+  // expensive than the one used for PostDelayedTask(). The task still never
+  // runs before `delay` has passed.
+  // The default implementation rounds `delay` up to milliseconds.
+  // May be called on any thread or task queue, including this task queue.
+  virtual void PostDelayedHighPrecisionTask(std::unique_ptr<QueuedTask> task,
+                                            TimeDelta delay) {
+    const int64_t delay_us = std::max<int64_t>(delay.us(), 0);
+    PostDelayedTask(std::move(task),
+                    static_cast<uint32_t>((delay_us + 999) / 1000));
+  }
+
   // Returns the task queue that is running the current thread.
   // Returns nullptr if this thread is not associated with any task queue.
   // May be called on any thread or task queue, including this task queue.
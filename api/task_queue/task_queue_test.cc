@@ -9,8 +9,11 @@
  */
 #include "api/task_queue/task_queue_test.h"
 
+#include <vector>
+
 #include "absl/memory/memory.h"
 #include "absl/strings/string_view.h"
+#include "api/units/time_delta.h"
 #include "rtc_base/event.h"
 #include "rtc_base/ref_counter.h"
 #include "rtc_base/task_utils/to_queued_task.h"
@@ -131,6 +134,31 @@ TEST_P(TaskQueueTest, PostMultipleDelayed) {
     EXPECT_TRUE(e.Wait(1000));
 }
 
+TEST_P(TaskQueueTest, PostDelayedHighPrecision) {
+  std::unique_ptr<webrtc::TaskQueueFactory> factory = GetParam()();
+  auto queue = CreateTaskQueue(factory, "PostDelayedHighPrecision");
+
+  std::vector<int> order;
+  rtc::Event done;
+  auto post = [&](int id, TimeDelta delay) {
+    queue->PostDelayedHighPrecisionTask(ToQueuedTask([&, id] {
+                                          EXPECT_TRUE(queue->IsCurrent());
+                                          order.push_back(id);
+                                          if (order.size() == 4)
+                                            done.Set();
+                                        }),
+                                        delay);
+  };
+  post(3, TimeDelta::Millis(20));
+  queue->PostTask(ToQueuedTask([&] {
+    post(2, TimeDelta::Micros(5500));
+    post(1, TimeDelta::Micros(500));
+    post(4, TimeDelta::Millis(40));
+  }));
+  EXPECT_TRUE(done.Wait(1000));
+  EXPECT_EQ(order, (std::vector<int>{1, 2, 3, 4}));
+}
+
 TEST_P(TaskQueueTest, PostDelayedAfterDestruct) {
   std::unique_ptr<webrtc::TaskQueueFactory> factory = GetParam()();
   rtc::Event run;
@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <memory>
+
+#include "api/task_queue/default_task_queue_factory.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "api/units/time_delta.h"
+#include "benchmark/benchmark.h"
+#include "rtc_base/event.h"
+#include "rtc_base/system/unused.h"
+#include "rtc_base/task_utils/to_queued_task.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+namespace {
+
+// Measures how late delayed tasks of the default task queue run, with a delay
+// of `state.range(0)` microseconds. Reports the average and the largest
+// lateness; the wall time per iteration is the delay plus the lateness.
+void RunDelayedTasks(benchmark::State& state, bool high_precision) {
+  const TimeDelta delay = TimeDelta::Micros(state.range(0));
+  std::unique_ptr<TaskQueueFactory> factory = CreateDefaultTaskQueueFactory();
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> queue =
+      factory->CreateTaskQueue("Timer", TaskQueueFactory::Priority::HIGH);
+  rtc::Event ran;
+  int64_t total_late_us = 0;
+  int64_t max_late_us = 0;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    const int64_t posted_us = rtc::TimeMicros();
+    int64_t run_us = 0;
+    auto task = ToQueuedTask([&] {
+      run_us = rtc::TimeMicros();
+      ran.Set();
+    });
+    if (high_precision) {
+      queue->PostDelayedHighPrecisionTask(std::move(task), delay);
+    } else {
+      queue->PostDelayedTask(std::move(task), delay.ms<uint32_t>());
+    }
+    ran.Wait(rtc::Event::kForever);
+    const int64_t late_us = run_us - posted_us - delay.us();
+    total_late_us += late_us;
+    max_late_us = std::max(max_late_us, late_us);
+  }
+  state.counters["late_us"] = benchmark::Counter(
+      static_cast<double>(total_late_us), benchmark::Counter::kAvgIterations);
+  state.counters["max_late_us"] = static_cast<double>(max_late_us);
+}
+
+void BM_PostDelayedTask(benchmark::State& state) {
+  RunDelayedTasks(state, /*high_precision=*/false);
+}
+
+void BM_PostDelayedHighPrecisionTask(benchmark::State& state) {
+  RunDelayedTasks(state, /*high_precision=*/true);
+}
+
+// Whole milliseconds, so that both post the same delay.
+BENCHMARK(BM_PostDelayedTask)->Arg(1000)->Arg(5000)->UseRealTime();
+BENCHMARK(BM_PostDelayedHighPrecisionTask)
+    ->Arg(1000)
+    ->Arg(5000)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace webrtc
@@ -18,8 +18,10 @@
 namespace webrtc {
 
 std::unique_ptr<NetworkEmulationManager> CreateNetworkEmulationManager(
-    TimeMode mode) {
-  return std::make_unique<test::NetworkEmulationManagerImpl>(mode);
+    TimeMode mode,
+    int num_node_task_queues) {
+  return std::make_unique<test::NetworkEmulationManagerImpl>(
+      mode, num_node_task_queues);
 }
 
 }  // namespace webrtc
@@ -17,9 +17,12 @@
 
 namespace webrtc {
 
-// Returns a non-null NetworkEmulationManager instance.
+// Returns a non-null NetworkEmulationManager instance. The emulated network
+// nodes are spread over `num_node_task_queues` task queues, which lets large
+// networks, e.g. with hundreds of peers, be emulated on several threads.
 std::unique_ptr<NetworkEmulationManager> CreateNetworkEmulationManager(
-    TimeMode mode = TimeMode::kRealTime);
+    TimeMode mode = TimeMode::kRealTime,
+    int num_node_task_queues = 1);
 
 }  // namespace webrtc
 
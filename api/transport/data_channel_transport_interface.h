@@ -13,6 +13,7 @@
 #define API_TRANSPORT_DATA_CHANNEL_TRANSPORT_INTERFACE_H_
 
 #include "absl/types/optional.h"
+#include "api/priority.h"
 #include "api/rtc_error.h"
 #include "rtc_base/copy_on_write_buffer.h"
 
@@ -97,6 +98,11 @@ class DataChannelTransportInterface {
   // specified `channel_id` is unusable.  Must be called before `SendData`.
   virtual RTCError OpenChannel(int channel_id) = 0;
 
+  // Sets the priority of an open `channel_id`, which decides its share of the
+  // bandwidth when several channels have data to send. Not all transports
+  // support priorities.
+  virtual void SetChannelPriority(int channel_id, Priority priority) {}
+
   // Sends a data buffer to the remote endpoint using the given send parameters.
   // `buffer` may not be larger than 256 KiB. Returns an error if the send
   // fails.
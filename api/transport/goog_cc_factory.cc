@@ -36,6 +36,7 @@ GoogCcNetworkControllerFactory::Create(NetworkControllerConfig config) {
     config.event_log = event_log_;
   GoogCcConfig goog_cc_config;
   goog_cc_config.feedback_only = factory_config_.feedback_only;
+  goog_cc_config.bwe_trace_recorder = factory_config_.bwe_trace_recorder;
   if (factory_config_.network_state_estimator_factory) {
     RTC_DCHECK(config.key_value_config);
     goog_cc_config.network_state_estimator =
@@ -17,6 +17,7 @@
 #include "api/transport/network_control.h"
 
 namespace webrtc {
+class BweTraceRecorder;
 class RtcEventLog;
 
 struct GoogCcFactoryConfig {
@@ -25,6 +26,9 @@ struct GoogCcFactoryConfig {
   NetworkStatePredictorFactoryInterface* network_state_predictor_factory =
       nullptr;
   bool feedback_only = false;
+  // If set, the state of the created controllers is recorded after each
+  // transport feedback. Must outlive the controllers.
+  BweTraceRecorder* bwe_trace_recorder = nullptr;
 };
 
 class GoogCcNetworkControllerFactory
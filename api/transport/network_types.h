@@ -19,6 +19,7 @@
 #include "api/units/data_size.h"
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
+#include "rtc_base/network/ecn_marking.h"
 
 namespace webrtc {
 
@@ -162,6 +163,9 @@ struct PacketResult {
 
   SentPacket sent_packet;
   Timestamp receive_time = Timestamp::PlusInfinity();
+  // The ECN codepoint the packet was received with, if the feedback reports
+  // it. Not meaningful for packets that were not received.
+  rtc::EcnMarking ecn = rtc::EcnMarking::kNotEct;
 };
 
 struct TransportPacketsFeedback {
@@ -173,7 +173,10 @@ class RTC_EXPORT EncodedImage {
   VideoFrameType _frameType = VideoFrameType::kVideoFrameDelta;
   VideoRotation rotation_ = kVideoRotation_0;
   VideoContentType content_type_ = VideoContentType::UNSPECIFIED;
-  int qp_ = -1;  // Quantizer value.
+  // Quantizer value. Encoders that know it should set it, which saves
+  // VideoStreamEncoder from parsing it out of the bitstream for quality
+  // scaling and stats.
+  int qp_ = -1;
 
   // When an application indicates non-zero values here, it is taken as an
   // indication that all future frames will be constrained with those limits
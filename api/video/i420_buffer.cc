@@ -13,8 +13,10 @@
 
 #include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "rtc_base/checks.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/ref_counted_object.h"
 #include "third_party/libyuv/include/libyuv/convert.h"
 #include "third_party/libyuv/include/libyuv/planar_functions.h"
@@ -27,10 +29,70 @@ namespace webrtc {
 
 namespace {
 
+// A stripe is only worth its own thread for sources of about this many pixels,
+// so 4K frames are scaled on up to four threads and 1080p frames on one.
+constexpr int kMinSourcePixelsPerStripe = 1920 * 1080;
+
 int I420DataSize(int height, int stride_y, int stride_u, int stride_v) {
   return stride_y * height + (stride_u + stride_v) * ((height + 1) / 2);
 }
 
+int GreatestCommonDivisor(int a, int b) {
+  while (b != 0) {
+    const int c = a % b;
+    a = b;
+    b = c;
+  }
+  return a;
+}
+
+struct Stripe {
+  int src_y;
+  int src_height;
+  int dst_y;
+  int dst_height;
+};
+
+// Splits the rows of a `src_height` to `dst_height` scaling into up to
+// `max_stripes` stripes. Stripes start at even source rows, for the chroma
+// planes, that map exactly to a destination row, so that scaling them
+// separately gives the same result as scaling the whole plane. That is only
+// the case for downscales whose 16.16 fixed point step, as used by libyuv, is
+// exact, e.g. by 2 or 1.5. Others aren't split.
+std::vector<Stripe> SplitIntoStripes(int src_height,
+                                     int dst_height,
+                                     int max_stripes) {
+  if (dst_height > src_height ||
+      (int64_t{src_height} << 16) % dst_height != 0) {
+    max_stripes = 1;
+  }
+  const int gcd = GreatestCommonDivisor(src_height, dst_height);
+  int src_step = src_height / gcd;
+  int dst_step = dst_height / gcd;
+  while (src_step % 2 != 0 || dst_step % 2 != 0) {
+    src_step *= 2;
+    dst_step *= 2;
+  }
+  const int num_steps = dst_height / dst_step;
+  const int num_stripes = std::max(1, std::min(max_stripes, num_steps));
+
+  std::vector<Stripe> stripes;
+  for (int i = 0; i < num_stripes; ++i) {
+    const int first_step = num_steps * i / num_stripes;
+    const int last_step = num_steps * (i + 1) / num_stripes;
+    const bool is_last = i == num_stripes - 1;
+    Stripe stripe;
+    stripe.src_y = first_step * src_step;
+    stripe.dst_y = first_step * dst_step;
+    stripe.src_height =
+        (is_last ? src_height : last_step * src_step) - stripe.src_y;
+    stripe.dst_height =
+        (is_last ? dst_height : last_step * dst_step) - stripe.dst_y;
+    stripes.push_back(stripe);
+  }
+  return stripes;
+}
+
 }  // namespace
 
 I420Buffer::I420Buffer(int width, int height)
@@ -186,6 +248,17 @@ void I420Buffer::CropAndScaleFrom(const I420BufferInterface& src,
                                   int offset_y,
                                   int crop_width,
                                   int crop_height) {
+  CropAndScaleFrom(src, offset_x, offset_y, crop_width, crop_height,
+                   /*num_threads=*/1);
+}
+
+void I420Buffer::CropAndScaleFrom(const I420BufferInterface& src,
+                                  int offset_x,
+                                  int offset_y,
+                                  int crop_width,
+                                  int crop_height,
+                                  int num_threads) {
+  RTC_DCHECK_GE(num_threads, 1);
   RTC_CHECK_LE(crop_width, src.width());
   RTC_CHECK_LE(crop_height, src.height());
   RTC_CHECK_LE(crop_width + offset_x, src.width());
@@ -204,13 +277,44 @@ void I420Buffer::CropAndScaleFrom(const I420BufferInterface& src,
       src.DataU() + src.StrideU() * uv_offset_y + uv_offset_x;
   const uint8_t* v_plane =
       src.DataV() + src.StrideV() * uv_offset_y + uv_offset_x;
-  int res =
-      libyuv::I420Scale(y_plane, src.StrideY(), u_plane, src.StrideU(), v_plane,
-                        src.StrideV(), crop_width, crop_height, MutableDataY(),
-                        StrideY(), MutableDataU(), StrideU(), MutableDataV(),
-                        StrideV(), width(), height(), libyuv::kFilterBox);
 
-  RTC_DCHECK_EQ(res, 0);
+  const int max_stripes = std::min(
+      num_threads,
+      std::max(1, crop_width * crop_height / kMinSourcePixelsPerStripe));
+  if (max_stripes == 1 || height() < 2) {
+    int res = libyuv::I420Scale(
+        y_plane, src.StrideY(), u_plane, src.StrideU(), v_plane, src.StrideV(),
+        crop_width, crop_height, MutableDataY(), StrideY(), MutableDataU(),
+        StrideU(), MutableDataV(), StrideV(), width(), height(),
+        libyuv::kFilterBox);
+    RTC_DCHECK_EQ(res, 0);
+    return;
+  }
+
+  auto scale_stripe = [&](const Stripe& stripe) {
+    const int src_uv_y = stripe.src_y / 2;
+    const int dst_uv_y = stripe.dst_y / 2;
+    int res = libyuv::I420Scale(
+        y_plane + src.StrideY() * stripe.src_y, src.StrideY(),
+        u_plane + src.StrideU() * src_uv_y, src.StrideU(),
+        v_plane + src.StrideV() * src_uv_y, src.StrideV(), crop_width,
+        stripe.src_height, MutableDataY() + StrideY() * stripe.dst_y,
+        StrideY(), MutableDataU() + StrideU() * dst_uv_y, StrideU(),
+        MutableDataV() + StrideV() * dst_uv_y, StrideV(), width(),
+        stripe.dst_height, libyuv::kFilterBox);
+    RTC_DCHECK_EQ(res, 0);
+  };
+  const std::vector<Stripe> stripes =
+      SplitIntoStripes(crop_height, height(), max_stripes);
+  std::vector<rtc::PlatformThread> threads;
+  for (size_t i = 1; i < stripes.size(); ++i) {
+    threads.push_back(rtc::PlatformThread::SpawnJoinable(
+        [&scale_stripe, &stripes, i] { scale_stripe(stripes[i]); },
+        "I420Scale"));
+  }
+  scale_stripe(stripes[0]);
+  // Joins the threads.
+  threads.clear();
 }
 
 void I420Buffer::CropAndScaleFrom(const I420BufferInterface& src) {
@@ -91,6 +91,17 @@ class RTC_EXPORT I420Buffer : public I420BufferInterface {
                         int crop_width,
                         int crop_height);
 
+  // Like above, but scales horizontal stripes of the frame on up to
+  // `num_threads` threads, including the calling one. Threads are only used
+  // for large frames, e.g. 4K, where they make up for their start up, and
+  // when the stripes can be split at rows that scale exactly.
+  void CropAndScaleFrom(const I420BufferInterface& src,
+                        int offset_x,
+                        int offset_y,
+                        int crop_width,
+                        int crop_height,
+                        int num_threads);
+
   // The common case of a center crop, when needed to adjust the
   // aspect ratio without distorting the image.
   void CropAndScaleFrom(const I420BufferInterface& src);
@@ -19,6 +19,7 @@
 
 #include "absl/container/inlined_vector.h"
 #include "absl/types/optional.h"
+#include "common_video/include/encoded_image_buffer_pool.h"
 #include "modules/rtp_rtcp/source/rtp_dependency_descriptor_extension.h"
 #include "modules/rtp_rtcp/source/rtp_generic_frame_descriptor_extension.h"
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
@@ -80,6 +81,7 @@ class RtpVideoFrameAssembler::Impl {
   std::unique_ptr<FrameDependencyStructure> video_structure_;
   SeqNumUnwrapper<uint16_t> frame_id_unwrapper_;
   absl::optional<int64_t> video_structure_frame_id_;
+  EncodedImageBufferPool frame_buffer_pool_;
   std::unique_ptr<VideoRtpDepacketizer> depacketizer_;
   video_coding::PacketBuffer packet_buffer_;
   RtpFrameReferenceFinder reference_finder_;
@@ -88,7 +90,9 @@ class RtpVideoFrameAssembler::Impl {
 RtpVideoFrameAssembler::Impl::Impl(
     std::unique_ptr<VideoRtpDepacketizer> depacketizer)
     : depacketizer_(std::move(depacketizer)),
-      packet_buffer_(/*start_buffer_size=*/2048, /*max_buffer_size=*/2048) {}
+      packet_buffer_(/*start_buffer_size=*/2048, /*max_buffer_size=*/2048) {
+  depacketizer_->SetFrameBufferPool(&frame_buffer_pool_);
+}
 
 RtpVideoFrameAssembler::FrameVector RtpVideoFrameAssembler::Impl::InsertPacket(
     const RtpPacketReceived& rtp_packet) {
@@ -118,9 +122,9 @@ RtpVideoFrameAssembler::FrameVector RtpVideoFrameAssembler::Impl::InsertPacket(
 
   parsed_payload->video_header.is_last_packet_in_frame |= rtp_packet.Marker();
 
-  auto packet = std::make_unique<video_coding::PacketBuffer::Packet>(
-      rtp_packet, parsed_payload->video_header);
-  packet->video_payload = std::move(parsed_payload->video_payload);
+  video_coding::PacketBuffer::Packet packet(rtp_packet,
+                                            parsed_payload->video_header);
+  packet.video_payload = std::move(parsed_payload->video_payload);
 
   ClearOldData(rtp_packet.SequenceNumber());
   return FindReferences(
@@ -141,9 +145,9 @@ RtpVideoFrameAssembler::Impl::AssembleFrames(
   std::vector<rtc::ArrayView<const uint8_t>> payloads;
   RtpFrameVector result;
 
-  for (auto& packet : insert_result.packets) {
+  for (video_coding::PacketBuffer::Packet* packet : insert_result.packets) {
     if (packet->is_first_packet_in_frame()) {
-      first_packet = packet.get();
+      first_packet = packet;
       payloads.clear();
     }
     payloads.emplace_back(packet->video_payload);
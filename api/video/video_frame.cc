@@ -81,6 +81,11 @@ VideoFrame::UpdateRect VideoFrame::UpdateRect::ScaleWithFrame(
   RTC_DCHECK_GT(scaled_width, 0);
   RTC_DCHECK_GT(scaled_height, 0);
 
+  // An empty update stays empty, rather than growing by the scaling margin.
+  if (IsEmpty()) {
+    return {0, 0, 0, 0};
+  }
+
   // Check if update rect is out of the cropped area.
   if (offset_x + width < crop_x || offset_x > crop_x + crop_width ||
       offset_y + height < crop_y || offset_y > crop_y + crop_width) {
@@ -268,9 +273,9 @@ VideoFrame::VideoFrame(uint16_t id,
       ntp_time_ms_(ntp_time_ms),
       timestamp_us_(timestamp_us),
       rotation_(rotation),
-      color_space_(color_space),
       update_rect_(update_rect),
       packet_infos_(std::move(packet_infos)) {
+  set_color_space(color_space);
   if (update_rect_) {
     RTC_DCHECK_GE(update_rect_->offset_x, 0);
     RTC_DCHECK_GE(update_rect_->offset_y, 0);
@@ -281,6 +286,22 @@ VideoFrame::VideoFrame(uint16_t id,
 
 VideoFrame::~VideoFrame() = default;
 
+const absl::optional<ColorSpace>& VideoFrame::color_space() const {
+  static const absl::optional<ColorSpace>* const kNoColorSpace =
+      new absl::optional<ColorSpace>();
+  return color_space_ ? *color_space_ : *kNoColorSpace;
+}
+
+void VideoFrame::set_color_space(
+    const absl::optional<ColorSpace>& color_space) {
+  if (!color_space) {
+    color_space_ = nullptr;
+  } else if (!color_space_ || *color_space_ != color_space) {
+    color_space_ =
+        rtc::make_ref_counted<absl::optional<ColorSpace>>(color_space);
+  }
+}
+
 VideoFrame::VideoFrame(const VideoFrame&) = default;
 VideoFrame::VideoFrame(VideoFrame&&) = default;
 VideoFrame& VideoFrame::operator=(const VideoFrame&) = default;
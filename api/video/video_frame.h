@@ -23,6 +23,7 @@
 #include "api/video/video_frame_buffer.h"
 #include "api/video/video_rotation.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/ref_counted_object.h"
 #include "rtc_base/system/rtc_export.h"
 
 namespace webrtc {
@@ -180,11 +181,10 @@ class RTC_EXPORT VideoFrame {
   VideoRotation rotation() const { return rotation_; }
   void set_rotation(VideoRotation rotation) { rotation_ = rotation; }
 
-  // Get color space when available.
-  const absl::optional<ColorSpace>& color_space() const { return color_space_; }
-  void set_color_space(const absl::optional<ColorSpace>& color_space) {
-    color_space_ = color_space;
-  }
+  // Get color space when available. Copies of a frame share its color space
+  // until one of them sets a new one.
+  const absl::optional<ColorSpace>& color_space() const;
+  void set_color_space(const absl::optional<ColorSpace>& color_space);
 
   // max_composition_delay_in_frames() is used in an experiment of a low-latency
   // renderer algorithm see crbug.com/1138888.
@@ -247,6 +247,9 @@ class RTC_EXPORT VideoFrame {
   }
 
  private:
+  using SharedColorSpace =
+      rtc::FinalRefCountedObject<absl::optional<ColorSpace>>;
+
   VideoFrame(uint16_t id,
              const rtc::scoped_refptr<VideoFrameBuffer>& buffer,
              int64_t timestamp_us,
@@ -264,7 +267,9 @@ class RTC_EXPORT VideoFrame {
   int64_t ntp_time_ms_;
   int64_t timestamp_us_;
   VideoRotation rotation_;
-  absl::optional<ColorSpace> color_space_;
+  // Immutable and null when the frame has no color space, so that copying a
+  // frame doesn't copy the HDR metadata.
+  rtc::scoped_refptr<const SharedColorSpace> color_space_;
   absl::optional<int32_t> max_composition_delay_in_frames_;
   // Updated since the last frame area. If present it means that the bounding
   // box of all the changes is within the rectangular area and is close to it.
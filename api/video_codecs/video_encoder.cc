@@ -188,6 +188,9 @@ std::string VideoEncoder::EncoderInfo::ToString() const {
   if (is_qp_trusted.has_value()) {
     oss << ", is_qp_trusted = " << is_qp_trusted.value();
   }
+  if (max_frames_in_flight.has_value()) {
+    oss << ", max_frames_in_flight = " << max_frames_in_flight.value();
+  }
   oss << "}";
   return oss.str();
 }
@@ -223,7 +226,8 @@ bool VideoEncoder::EncoderInfo::operator==(const EncoderInfo& rhs) const {
   }
 
   if (resolution_bitrate_limits != rhs.resolution_bitrate_limits ||
-      supports_simulcast != rhs.supports_simulcast) {
+      supports_simulcast != rhs.supports_simulcast ||
+      max_frames_in_flight != rhs.max_frames_in_flight) {
     return false;
   }
 
@@ -257,6 +257,16 @@ class RTC_EXPORT VideoEncoder {
     // Indicates whether or not QP value encoder writes into frame/slice/tile
     // header can be interpreted as average frame/slice/tile QP.
     absl::optional<bool> is_qp_trusted;
+
+    // If set, the encoder is asynchronous: Encode() returns without waiting
+    // for the frame to be encoded, and up to `max_frames_in_flight` frames may
+    // be in flight, i.e. passed to Encode() but neither delivered to the
+    // EncodedImageCallback nor dropped. The encoded images of the frames in
+    // flight may be delivered in any order. The caller drops input frames
+    // rather than exceeding the limit, so that the encoder needs no queue of
+    // its own. If unset, encoded images are expected to be delivered in the
+    // order the frames were passed to Encode().
+    absl::optional<int> max_frames_in_flight;
   };
 
   struct RTC_EXPORT RateControlParameters {
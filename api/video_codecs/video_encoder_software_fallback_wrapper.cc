@@ -359,9 +359,21 @@ int32_t VideoEncoderSoftwareFallbackWrapper::EncodeWithMainEncoder(
       return fallback_encoder_->Encode(frame, frame_types);
     } else {
       RTC_LOG(LS_INFO) << "Fallback encoder does not support native handle - "
-                          "converting frame to I420";
-      rtc::scoped_refptr<I420BufferInterface> src_buffer =
-          frame.video_frame_buffer()->ToI420();
+                          "mapping or converting frame";
+      rtc::scoped_refptr<VideoFrameBuffer> src_buffer =
+          frame.video_frame_buffer();
+      if (src_buffer->type() == VideoFrameBuffer::Type::kNative) {
+        // Prefer a format the fallback encoder takes as is, such as NV12, to
+        // a conversion to I420.
+        VideoEncoder::EncoderInfo fallback_info =
+            fallback_encoder_->GetEncoderInfo();
+        rtc::scoped_refptr<VideoFrameBuffer> mapped_buffer =
+            src_buffer->GetMappedFrameBuffer(
+                fallback_info.preferred_pixel_formats);
+        src_buffer = mapped_buffer ? mapped_buffer
+                                   : rtc::scoped_refptr<VideoFrameBuffer>(
+                                         src_buffer->ToI420());
+      }
       if (!src_buffer) {
         RTC_LOG(LS_ERROR) << "Failed to convert from to I420";
         return WEBRTC_VIDEO_CODEC_ENCODER_FAILURE;
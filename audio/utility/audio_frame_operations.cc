@@ -109,8 +109,9 @@ int AudioFrameOperations::QuadToStereo(AudioFrame* frame) {
                 AudioFrame::kMaxDataSizeSamples);
 
   if (!frame->muted()) {
-    QuadToStereo(frame->data(), frame->samples_per_channel_,
-                 frame->mutable_data());
+    int16_t* frame_data =
+        frame->mutable_data(frame->samples_per_channel_, frame->num_channels_);
+    QuadToStereo(frame_data, frame->samples_per_channel_, frame_data);
   }
   frame->num_channels_ = 2;
 
@@ -141,8 +142,10 @@ void AudioFrameOperations::DownmixChannels(size_t dst_channels,
                 AudioFrame::kMaxDataSizeSamples);
   if (frame->num_channels_ > 1 && dst_channels == 1) {
     if (!frame->muted()) {
-      DownmixInterleavedToMono(frame->data(), frame->samples_per_channel_,
-                               frame->num_channels_, frame->mutable_data());
+      int16_t* frame_data = frame->mutable_data(frame->samples_per_channel_,
+                                                frame->num_channels_);
+      DownmixInterleavedToMono(frame_data, frame->samples_per_channel_,
+                               frame->num_channels_, frame_data);
     }
     frame->num_channels_ = 1;
   } else if (frame->num_channels_ == 4 && dst_channels == 2) {
@@ -169,7 +172,8 @@ void AudioFrameOperations::UpmixChannels(size_t target_number_of_channels,
   if (!frame->muted()) {
     // Up-mixing done in place. Going backwards through the frame ensure nothing
     // is irrevocably overwritten.
-    int16_t* frame_data = frame->mutable_data();
+    int16_t* frame_data = frame->mutable_data(frame->samples_per_channel_,
+                                              target_number_of_channels);
     for (int i = frame->samples_per_channel_ - 1; i >= 0; i--) {
       for (size_t j = 0; j < target_number_of_channels; ++j) {
         frame_data[target_number_of_channels * i + j] = frame_data[i];
@@ -185,7 +189,8 @@ void AudioFrameOperations::SwapStereoChannels(AudioFrame* frame) {
     return;
   }
 
-  int16_t* frame_data = frame->mutable_data();
+  int16_t* frame_data =
+      frame->mutable_data(frame->samples_per_channel_, frame->num_channels_);
   for (size_t i = 0; i < frame->samples_per_channel_ * 2; i += 2) {
     std::swap(frame_data[i], frame_data[i + 1]);
   }
@@ -234,7 +239,8 @@ void AudioFrameOperations::Mute(AudioFrame* frame,
     }
 
     // Perform fade.
-    int16_t* frame_data = frame->mutable_data();
+    int16_t* frame_data =
+        frame->mutable_data(frame->samples_per_channel_, frame->num_channels_);
     size_t channels = frame->num_channels_;
     for (size_t j = 0; j < channels; ++j) {
       float g = start_g;
@@ -257,7 +263,8 @@ void AudioFrameOperations::ApplyHalfGain(AudioFrame* frame) {
     return;
   }
 
-  int16_t* frame_data = frame->mutable_data();
+  int16_t* frame_data =
+      frame->mutable_data(frame->samples_per_channel_, frame->num_channels_);
   for (size_t i = 0; i < frame->samples_per_channel_ * frame->num_channels_;
        i++) {
     frame_data[i] = frame_data[i] >> 1;
@@ -271,7 +278,8 @@ int AudioFrameOperations::Scale(float left, float right, AudioFrame* frame) {
     return 0;
   }
 
-  int16_t* frame_data = frame->mutable_data();
+  int16_t* frame_data =
+      frame->mutable_data(frame->samples_per_channel_, frame->num_channels_);
   for (size_t i = 0; i < frame->samples_per_channel_; i++) {
     frame_data[2 * i] = static_cast<int16_t>(left * frame_data[2 * i]);
     frame_data[2 * i + 1] = static_cast<int16_t>(right * frame_data[2 * i + 1]);
@@ -284,7 +292,8 @@ int AudioFrameOperations::ScaleWithSat(float scale, AudioFrame* frame) {
     return 0;
   }
 
-  int16_t* frame_data = frame->mutable_data();
+  int16_t* frame_data =
+      frame->mutable_data(frame->samples_per_channel_, frame->num_channels_);
   for (size_t i = 0; i < frame->samples_per_channel_ * frame->num_channels_;
        i++) {
     frame_data[i] = rtc::saturated_cast<int16_t>(scale * frame_data[i]);
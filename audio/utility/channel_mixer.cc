@@ -86,14 +86,11 @@ void ChannelMixer::Transform(AudioFrame* frame) {
     }
   }
 
-  // Update channel information.
-  frame->num_channels_ = output_channels_;
+  // Update channel information and copy the output result to the audio frame
+  // in `frame`.
   frame->channel_layout_ = output_layout_;
-
-  // Copy the output result to the audio frame in `frame`.
-  memcpy(
-      frame->mutable_data(), out_audio,
-      sizeof(int16_t) * frame->samples_per_channel() * frame->num_channels());
+  memcpy(frame->mutable_data(frame->samples_per_channel(), output_channels_),
+         out_audio, sizeof(int16_t) * num_elements);
 }
 
 }  // namespace webrtc
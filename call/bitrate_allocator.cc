@@ -70,43 +70,47 @@ bool EnoughBitrateForAllObservers(
   return true;
 }
 
-// Splits `bitrate` evenly to observers already in `allocation`.
-// `include_zero_allocations` decides if zero allocations should be part of
-// the distribution or not. The allowed max bitrate is `max_multiplier` x
-// observer max bitrate.
+// Splits `bitrate` evenly to observers already in `allocation`, which is
+// indexed like `allocatable_tracks`. `include_zero_allocations` decides if
+// zero allocations should be part of the distribution or not. The allowed max
+// bitrate is `max_multiplier` x observer max bitrate.
 void DistributeBitrateEvenly(
     const std::vector<AllocatableTrack>& allocatable_tracks,
     uint32_t bitrate,
     bool include_zero_allocations,
     int max_multiplier,
-    std::map<BitrateAllocatorObserver*, int>* allocation) {
+    std::vector<int>* allocation) {
   RTC_DCHECK_EQ(allocation->size(), allocatable_tracks.size());
 
-  std::multimap<uint32_t, const AllocatableTrack*> list_max_bitrates;
-  for (const auto& observer_config : allocatable_tracks) {
-    if (include_zero_allocations ||
-        allocation->at(observer_config.observer) != 0) {
-      list_max_bitrates.insert(
-          {observer_config.config.max_bitrate_bps, &observer_config});
-    }
+  std::vector<size_t> indices;
+  indices.reserve(allocatable_tracks.size());
+  for (size_t i = 0; i < allocatable_tracks.size(); ++i) {
+    if (include_zero_allocations || (*allocation)[i] != 0)
+      indices.push_back(i);
   }
-  auto it = list_max_bitrates.begin();
-  while (it != list_max_bitrates.end()) {
+  // Fill the observers with the lowest max bitrate first, so that what they
+  // can't fit is carried over to the observers that can.
+  absl::c_stable_sort(indices, [&allocatable_tracks](size_t a, size_t b) {
+    return allocatable_tracks[a].config.max_bitrate_bps <
+           allocatable_tracks[b].config.max_bitrate_bps;
+  });
+  for (size_t i = 0; i < indices.size(); ++i) {
     RTC_DCHECK_GT(bitrate, 0);
+    const size_t index = indices[i];
+    const uint32_t max_bitrate =
+        allocatable_tracks[index].config.max_bitrate_bps;
     uint32_t extra_allocation =
-        bitrate / static_cast<uint32_t>(list_max_bitrates.size());
-    uint32_t total_allocation =
-        extra_allocation + allocation->at(it->second->observer);
+        bitrate / static_cast<uint32_t>(indices.size() - i);
+    uint32_t total_allocation = extra_allocation + (*allocation)[index];
     bitrate -= extra_allocation;
-    if (total_allocation > max_multiplier * it->first) {
+    if (total_allocation > max_multiplier * max_bitrate) {
       // There is more than we can fit for this observer, carry over to the
       // remaining observers.
-      bitrate += total_allocation - max_multiplier * it->first;
-      total_allocation = max_multiplier * it->first;
+      bitrate += total_allocation - max_multiplier * max_bitrate;
+      total_allocation = max_multiplier * max_bitrate;
     }
     // Finally, update the allocation for this observer.
-    allocation->at(it->second->observer) = total_allocation;
-    it = list_max_bitrates.erase(it);
+    (*allocation)[index] = total_allocation;
   }
 }
 
@@ -119,13 +123,13 @@ void DistributeBitrateEvenly(
 void DistributeBitrateRelatively(
     const std::vector<AllocatableTrack>& allocatable_tracks,
     uint32_t remaining_bitrate,
-    const std::map<BitrateAllocatorObserver*, int>& observers_capacities,
-    std::map<BitrateAllocatorObserver*, int>* allocation) {
+    const std::vector<int>& observers_capacities,
+    std::vector<int>* allocation) {
   RTC_DCHECK_EQ(allocation->size(), allocatable_tracks.size());
   RTC_DCHECK_EQ(observers_capacities.size(), allocatable_tracks.size());
 
   struct PriorityRateObserverConfig {
-    BitrateAllocatorObserver* allocation_key;
+    size_t allocation_index;
     // The amount of bitrate bps that can be allocated to this observer.
     int capacity_bps;
     double bitrate_priority;
@@ -133,12 +137,13 @@ void DistributeBitrateRelatively(
 
   double bitrate_priority_sum = 0;
   std::vector<PriorityRateObserverConfig> priority_rate_observers;
-  for (const auto& observer_config : allocatable_tracks) {
+  priority_rate_observers.reserve(allocatable_tracks.size());
+  for (size_t i = 0; i < allocatable_tracks.size(); ++i) {
+    const double bitrate_priority =
+        allocatable_tracks[i].config.bitrate_priority;
     priority_rate_observers.push_back(PriorityRateObserverConfig{
-        observer_config.observer,
-        observers_capacities.at(observer_config.observer),
-        observer_config.config.bitrate_priority});
-    bitrate_priority_sum += observer_config.config.bitrate_priority;
+        i, observers_capacities[i], bitrate_priority});
+    bitrate_priority_sum += bitrate_priority;
   }
 
   // Iterate in the order observers can be allocated their full capacity.
@@ -167,7 +172,7 @@ void DistributeBitrateRelatively(
     bool enough_bitrate = allocation_bps >= priority_rate_observer.capacity_bps;
     if (!enough_bitrate)
       break;
-    allocation->at(priority_rate_observer.allocation_key) +=
+    (*allocation)[priority_rate_observer.allocation_index] +=
         priority_rate_observer.capacity_bps;
     remaining_bitrate -= priority_rate_observer.capacity_bps;
     bitrate_priority_sum -= priority_rate_observer.bitrate_priority;
@@ -179,39 +184,40 @@ void DistributeBitrateRelatively(
     const auto& priority_rate_observer = priority_rate_observers[i];
     double fraction_allocated =
         priority_rate_observer.bitrate_priority / bitrate_priority_sum;
-    allocation->at(priority_rate_observer.allocation_key) +=
+    (*allocation)[priority_rate_observer.allocation_index] +=
         fraction_allocated * remaining_bitrate;
   }
 }
 
 // Allocates bitrate to observers when there isn't enough to allocate the
 // minimum to all observers.
-std::map<BitrateAllocatorObserver*, int> LowRateAllocation(
-    const std::vector<AllocatableTrack>& allocatable_tracks,
-    uint32_t bitrate) {
-  std::map<BitrateAllocatorObserver*, int> allocation;
+void LowRateAllocation(const std::vector<AllocatableTrack>& allocatable_tracks,
+                       uint32_t bitrate,
+                       std::vector<int>* allocation) {
+  allocation->resize(allocatable_tracks.size());
   // Start by allocating bitrate to observers enforcing a min bitrate, hence
   // remaining_bitrate might turn negative.
   int64_t remaining_bitrate = bitrate;
-  for (const auto& observer_config : allocatable_tracks) {
+  for (size_t i = 0; i < allocatable_tracks.size(); ++i) {
     int32_t allocated_bitrate = 0;
-    if (observer_config.config.enforce_min_bitrate)
-      allocated_bitrate = observer_config.config.min_bitrate_bps;
+    if (allocatable_tracks[i].config.enforce_min_bitrate)
+      allocated_bitrate = allocatable_tracks[i].config.min_bitrate_bps;
 
-    allocation[observer_config.observer] = allocated_bitrate;
+    (*allocation)[i] = allocated_bitrate;
     remaining_bitrate -= allocated_bitrate;
   }
 
   // Allocate bitrate to all previously active streams.
   if (remaining_bitrate > 0) {
-    for (const auto& observer_config : allocatable_tracks) {
+    for (size_t i = 0; i < allocatable_tracks.size(); ++i) {
+      const AllocatableTrack& observer_config = allocatable_tracks[i];
       if (observer_config.config.enforce_min_bitrate ||
           observer_config.LastAllocatedBitrate() == 0)
         continue;
 
       uint32_t required_bitrate = observer_config.MinBitrateWithHysteresis();
       if (remaining_bitrate >= required_bitrate) {
-        allocation[observer_config.observer] = required_bitrate;
+        (*allocation)[i] = required_bitrate;
         remaining_bitrate -= required_bitrate;
       }
     }
@@ -219,14 +225,15 @@ std::map<BitrateAllocatorObserver*, int> LowRateAllocation(
 
   // Allocate bitrate to previously paused streams.
   if (remaining_bitrate > 0) {
-    for (const auto& observer_config : allocatable_tracks) {
+    for (size_t i = 0; i < allocatable_tracks.size(); ++i) {
+      const AllocatableTrack& observer_config = allocatable_tracks[i];
       if (observer_config.LastAllocatedBitrate() != 0)
         continue;
 
       // Add a hysteresis to avoid toggling.
       uint32_t required_bitrate = observer_config.MinBitrateWithHysteresis();
       if (remaining_bitrate >= required_bitrate) {
-        allocation[observer_config.observer] = required_bitrate;
+        (*allocation)[i] = required_bitrate;
         remaining_bitrate -= required_bitrate;
       }
     }
@@ -235,10 +242,7 @@ std::map<BitrateAllocatorObserver*, int> LowRateAllocation(
   // Split a possible remainder evenly on all streams with an allocation.
   if (remaining_bitrate > 0)
     DistributeBitrateEvenly(allocatable_tracks, remaining_bitrate, false, 1,
-                            &allocation);
-
-  RTC_DCHECK_EQ(allocation.size(), allocatable_tracks.size());
-  return allocation;
+                            allocation);
 }
 
 // Allocates bitrate to all observers when the available bandwidth is enough
@@ -252,32 +256,30 @@ std::map<BitrateAllocatorObserver*, int> LowRateAllocation(
 // bitrate_priority = 2.0, the expected behavior is that observer 2 will be
 // allocated twice the bitrate as observer 1 above the each observer's
 // min_bitrate_bps values, until one of the observers hits its max_bitrate_bps.
-std::map<BitrateAllocatorObserver*, int> NormalRateAllocation(
+void NormalRateAllocation(
     const std::vector<AllocatableTrack>& allocatable_tracks,
     uint32_t bitrate,
-    uint32_t sum_min_bitrates) {
-  std::map<BitrateAllocatorObserver*, int> allocation;
-  std::map<BitrateAllocatorObserver*, int> observers_capacities;
-  for (const auto& observer_config : allocatable_tracks) {
-    allocation[observer_config.observer] =
-        observer_config.config.min_bitrate_bps;
-    observers_capacities[observer_config.observer] =
-        observer_config.config.max_bitrate_bps -
-        observer_config.config.min_bitrate_bps;
+    uint32_t sum_min_bitrates,
+    std::vector<int>* allocation) {
+  allocation->resize(allocatable_tracks.size());
+  std::vector<int> observers_capacities(allocatable_tracks.size());
+  for (size_t i = 0; i < allocatable_tracks.size(); ++i) {
+    (*allocation)[i] = allocatable_tracks[i].config.min_bitrate_bps;
+    observers_capacities[i] = allocatable_tracks[i].config.max_bitrate_bps -
+                              allocatable_tracks[i].config.min_bitrate_bps;
   }
 
   bitrate -= sum_min_bitrates;
 
   // TODO(srte): Implement fair sharing between prioritized streams, currently
   // they are treated on a first come first serve basis.
-  for (const auto& observer_config : allocatable_tracks) {
-    int64_t priority_margin = observer_config.config.priority_bitrate_bps -
-                              allocation[observer_config.observer];
+  for (size_t i = 0; i < allocatable_tracks.size(); ++i) {
+    int64_t priority_margin =
+        allocatable_tracks[i].config.priority_bitrate_bps - (*allocation)[i];
     if (priority_margin > 0 && bitrate > 0) {
       int64_t extra_bitrate = std::min<int64_t>(priority_margin, bitrate);
-      allocation[observer_config.observer] +=
-          rtc::dchecked_cast<int>(extra_bitrate);
-      observers_capacities[observer_config.observer] -= extra_bitrate;
+      (*allocation)[i] += rtc::dchecked_cast<int>(extra_bitrate);
+      observers_capacities[i] -= extra_bitrate;
       bitrate -= extra_bitrate;
     }
   }
@@ -286,46 +288,44 @@ std::map<BitrateAllocatorObserver*, int> NormalRateAllocation(
   // above the min bitrate already allocated.
   if (bitrate > 0)
     DistributeBitrateRelatively(allocatable_tracks, bitrate,
-                                observers_capacities, &allocation);
-
-  return allocation;
+                                observers_capacities, allocation);
 }
 
 // Allocates bitrate to observers when there is enough available bandwidth
 // for all observers to be allocated their max bitrate.
-std::map<BitrateAllocatorObserver*, int> MaxRateAllocation(
-    const std::vector<AllocatableTrack>& allocatable_tracks,
-    uint32_t bitrate,
-    uint32_t sum_max_bitrates) {
-  std::map<BitrateAllocatorObserver*, int> allocation;
-
-  for (const auto& observer_config : allocatable_tracks) {
-    allocation[observer_config.observer] =
-        observer_config.config.max_bitrate_bps;
-    bitrate -= observer_config.config.max_bitrate_bps;
+void MaxRateAllocation(const std::vector<AllocatableTrack>& allocatable_tracks,
+                       uint32_t bitrate,
+                       uint32_t sum_max_bitrates,
+                       std::vector<int>* allocation) {
+  allocation->resize(allocatable_tracks.size());
+  for (size_t i = 0; i < allocatable_tracks.size(); ++i) {
+    (*allocation)[i] = allocatable_tracks[i].config.max_bitrate_bps;
+    bitrate -= allocatable_tracks[i].config.max_bitrate_bps;
   }
   DistributeBitrateEvenly(allocatable_tracks, bitrate, true,
-                          kTransmissionMaxBitrateMultiplier, &allocation);
-  return allocation;
+                          kTransmissionMaxBitrateMultiplier, allocation);
 }
 
 // Allocates zero bitrate to all observers.
-std::map<BitrateAllocatorObserver*, int> ZeroRateAllocation(
-    const std::vector<AllocatableTrack>& allocatable_tracks) {
-  std::map<BitrateAllocatorObserver*, int> allocation;
-  for (const auto& observer_config : allocatable_tracks)
-    allocation[observer_config.observer] = 0;
-  return allocation;
+void ZeroRateAllocation(const std::vector<AllocatableTrack>& allocatable_tracks,
+                        std::vector<int>* allocation) {
+  allocation->assign(allocatable_tracks.size(), 0);
 }
 
-std::map<BitrateAllocatorObserver*, int> AllocateBitrates(
-    const std::vector<AllocatableTrack>& allocatable_tracks,
-    uint32_t bitrate) {
-  if (allocatable_tracks.empty())
-    return std::map<BitrateAllocatorObserver*, int>();
+// Sets `allocation` to the bitrate of each of `allocatable_tracks`, in the
+// same order. Reuses the storage of `allocation`.
+void AllocateBitrates(const std::vector<AllocatableTrack>& allocatable_tracks,
+                      uint32_t bitrate,
+                      std::vector<int>* allocation) {
+  if (allocatable_tracks.empty()) {
+    allocation->clear();
+    return;
+  }
 
-  if (bitrate == 0)
-    return ZeroRateAllocation(allocatable_tracks);
+  if (bitrate == 0) {
+    ZeroRateAllocation(allocatable_tracks, allocation);
+    return;
+  }
 
   uint32_t sum_min_bitrates = 0;
   uint32_t sum_max_bitrates = 0;
@@ -338,16 +338,21 @@ std::map<BitrateAllocatorObserver*, int> AllocateBitrates(
   // enforced min bitrate -> allocated bitrate previous round -> restart paused
   // streams.
   if (!EnoughBitrateForAllObservers(allocatable_tracks, bitrate,
-                                    sum_min_bitrates))
-    return LowRateAllocation(allocatable_tracks, bitrate);
+                                    sum_min_bitrates)) {
+    LowRateAllocation(allocatable_tracks, bitrate, allocation);
+    return;
+  }
 
   // All observers will get their min bitrate plus a share of the rest. This
   // share is allocated to each observer based on its bitrate_priority.
-  if (bitrate <= sum_max_bitrates)
-    return NormalRateAllocation(allocatable_tracks, bitrate, sum_min_bitrates);
+  if (bitrate <= sum_max_bitrates) {
+    NormalRateAllocation(allocatable_tracks, bitrate, sum_min_bitrates,
+                         allocation);
+    return;
+  }
 
   // All observers will get up to transmission_max_bitrate_multiplier_ x max.
-  return MaxRateAllocation(allocatable_tracks, bitrate, sum_max_bitrates);
+  MaxRateAllocation(allocatable_tracks, bitrate, sum_max_bitrates, allocation);
 }
 
 }  // namespace
@@ -395,14 +400,11 @@ void BitrateAllocator::OnNetworkEstimateChanged(TargetTransferRate msg) {
     last_bwe_log_time_ = now;
   }
 
-  auto allocation = AllocateBitrates(allocatable_tracks_, last_target_bps_);
-  auto stable_bitrate_allocation =
-      AllocateBitrates(allocatable_tracks_, last_stable_target_bps_);
-
-  for (auto& config : allocatable_tracks_) {
-    uint32_t allocated_bitrate = allocation[config.observer];
-    uint32_t allocated_stable_target_rate =
-        stable_bitrate_allocation[config.observer];
+  UpdateAllocations();
+  for (size_t i = 0; i < allocatable_tracks_.size(); ++i) {
+    AllocatableTrack& config = allocatable_tracks_[i];
+    uint32_t allocated_bitrate = allocation_[i];
+    uint32_t allocated_stable_target_rate = stable_allocation_[i];
     BitrateAllocationUpdate update;
     update.target_bitrate = DataRate::BitsPerSec(allocated_bitrate);
     update.stable_target_bitrate =
@@ -462,13 +464,11 @@ void BitrateAllocator::AddObserver(BitrateAllocatorObserver* observer,
   if (last_target_bps_ > 0) {
     // Calculate a new allocation and update all observers.
 
-    auto allocation = AllocateBitrates(allocatable_tracks_, last_target_bps_);
-    auto stable_bitrate_allocation =
-        AllocateBitrates(allocatable_tracks_, last_stable_target_bps_);
-    for (auto& config : allocatable_tracks_) {
-      uint32_t allocated_bitrate = allocation[config.observer];
-      uint32_t allocated_stable_bitrate =
-          stable_bitrate_allocation[config.observer];
+    UpdateAllocations();
+    for (size_t i = 0; i < allocatable_tracks_.size(); ++i) {
+      AllocatableTrack& config = allocatable_tracks_[i];
+      uint32_t allocated_bitrate = allocation_[i];
+      uint32_t allocated_stable_bitrate = stable_allocation_[i];
       BitrateAllocationUpdate update;
       update.target_bitrate = DataRate::BitsPerSec(allocated_bitrate);
       update.stable_target_bitrate =
@@ -497,6 +497,17 @@ void BitrateAllocator::AddObserver(BitrateAllocatorObserver* observer,
   UpdateAllocationLimits();
 }
 
+void BitrateAllocator::UpdateAllocations() {
+  AllocateBitrates(allocatable_tracks_, last_target_bps_, &allocation_);
+  // The allocation only depends on the rate and the tracks.
+  if (last_stable_target_bps_ == last_target_bps_) {
+    stable_allocation_ = allocation_;
+  } else {
+    AllocateBitrates(allocatable_tracks_, last_stable_target_bps_,
+                     &stable_allocation_);
+  }
+}
+
 void BitrateAllocator::UpdateAllocationLimits() {
   BitrateAllocationLimits limits;
   for (const auto& config : allocatable_tracks_) {
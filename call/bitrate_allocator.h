@@ -139,6 +139,10 @@ class BitrateAllocator : public BitrateAllocatorInterface {
  private:
   using AllocatableTrack = bitrate_allocator_impl::AllocatableTrack;
 
+  // Allocates the last target and stable target rates to the tracks, into
+  // `allocation_` and `stable_allocation_`.
+  void UpdateAllocations() RTC_RUN_ON(&sequenced_checker_);
+
   // Calculates the minimum requested send bitrate and max padding bitrate and
   // calls LimitObserver::OnAllocationLimitsChanged.
   void UpdateAllocationLimits() RTC_RUN_ON(&sequenced_checker_);
@@ -154,6 +158,10 @@ class BitrateAllocator : public BitrateAllocatorInterface {
   // Stored in a list to keep track of the insertion order.
   std::vector<AllocatableTrack> allocatable_tracks_
       RTC_GUARDED_BY(&sequenced_checker_);
+  // The bitrates allocated to `allocatable_tracks_`, by index. Kept to reuse
+  // their storage between allocations.
+  std::vector<int> allocation_ RTC_GUARDED_BY(&sequenced_checker_);
+  std::vector<int> stable_allocation_ RTC_GUARDED_BY(&sequenced_checker_);
   uint32_t last_target_bps_ RTC_GUARDED_BY(&sequenced_checker_);
   uint32_t last_stable_target_bps_ RTC_GUARDED_BY(&sequenced_checker_);
   uint32_t last_non_zero_bitrate_bps_ RTC_GUARDED_BY(&sequenced_checker_);
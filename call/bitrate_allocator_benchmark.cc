@@ -0,0 +1,91 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include "api/transport/network_types.h"
+#include "api/units/data_rate.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "benchmark/benchmark.h"
+#include "call/bitrate_allocator.h"
+#include "rtc_base/random.h"
+#include "rtc_base/system/unused.h"
+
+namespace webrtc {
+namespace {
+
+class NullLimitObserver : public BitrateAllocator::LimitObserver {
+ public:
+  void OnAllocationLimitsChanged(BitrateAllocationLimits limits) override {}
+};
+
+class ProtectingObserver : public BitrateAllocatorObserver {
+ public:
+  uint32_t OnBitrateUpdated(BitrateAllocationUpdate update) override {
+    // Use a tenth of the allocation for protection.
+    return update.target_bitrate.bps() / 10;
+  }
+};
+
+// Updates the target rate of an allocator with `state.range(0)` observers of
+// mixed configurations. The rate takes small random steps between the sum of
+// the minimum bitrates of the observers and more than the sum of their maximum
+// bitrates.
+void BM_OnNetworkEstimateChanged(benchmark::State& state) {
+  const int num_observers = state.range(0);
+  NullLimitObserver limit_observer;
+  BitrateAllocator allocator(&limit_observer);
+  std::vector<ProtectingObserver> observers(num_observers);
+  Random random(/*seed=*/42);
+  int64_t sum_min_bitrates_bps = 0;
+  int64_t sum_max_bitrates_bps = 0;
+  for (ProtectingObserver& observer : observers) {
+    MediaStreamAllocationConfig config;
+    config.min_bitrate_bps = random.Rand(30000, 100000);
+    config.max_bitrate_bps = config.min_bitrate_bps + random.Rand(0, 1000000);
+    config.pad_up_bitrate_bps = 0;
+    config.priority_bitrate_bps = random.Rand(0, 4) == 0 ? 200000 : 0;
+    config.enforce_min_bitrate = random.Rand(0, 2) == 0;
+    config.bitrate_priority = random.Rand(1, 4);
+    allocator.AddObserver(&observer, config);
+    sum_min_bitrates_bps += config.min_bitrate_bps;
+    sum_max_bitrates_bps += config.max_bitrate_bps;
+  }
+  const int64_t min_target_bps = sum_min_bitrates_bps;
+  const int64_t max_target_bps = sum_max_bitrates_bps * 5 / 4;
+  int64_t target_bps = (min_target_bps + max_target_bps) / 2;
+
+  TargetTransferRate msg;
+  msg.at_time = Timestamp::Seconds(1);
+  msg.network_estimate.round_trip_time = TimeDelta::Millis(50);
+  msg.network_estimate.bwe_period = TimeDelta::Seconds(3);
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    const double step = 0.95 + 0.1 * random.Rand<double>();
+    target_bps = std::clamp(static_cast<int64_t>(target_bps * step),
+                            min_target_bps, max_target_bps);
+    msg.target_rate = DataRate::BitsPerSec(target_bps);
+    msg.stable_target_rate = DataRate::BitsPerSec(target_bps * 9 / 10);
+    allocator.OnNetworkEstimateChanged(msg);
+    msg.at_time += TimeDelta::Millis(25);
+  }
+  state.SetItemsProcessed(state.iterations() * num_observers);
+}
+
+BENCHMARK(BM_OnNetworkEstimateChanged)
+    ->ArgName("observers")
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1000);
+
+}  // namespace
+}  // namespace webrtc
@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "absl/functional/bind_front.h"
+#include "absl/strings/match.h"
 #include "absl/types/optional.h"
 #include "api/rtc_event_log/rtc_event_log.h"
 #include "api/sequence_checker.h"
@@ -56,6 +57,7 @@
 #include "rtc_base/logging.h"
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/system/no_unique_address.h"
+#include "rtc_base/task_queue_thread_pool.h"
 #include "rtc_base/task_utils/pending_task_safety_flag.h"
 #include "rtc_base/thread_annotations.h"
 #include "rtc_base/time_utils.h"
@@ -369,6 +371,10 @@ class Call final : public webrtc::Call,
   const Call::Config config_ RTC_GUARDED_BY(worker_thread_);
   // Maps to config_.trials, can be used from any thread via `trials()`.
   const WebRtcKeyValueConfig& trials_;
+  // Set by the field trial WebRTC-Video-DecodeThreadPool. If set, the video
+  // receive streams decode on a pool of one thread per core, shared by all
+  // streams, rather than on a thread each.
+  const std::unique_ptr<TaskQueueFactory> decode_queue_factory_;
 
   NetworkState audio_network_state_ RTC_GUARDED_BY(worker_thread_);
   NetworkState video_network_state_ RTC_GUARDED_BY(worker_thread_);
@@ -795,6 +801,13 @@ Call::Call(Clock* clock,
       bitrate_allocator_(new BitrateAllocator(this)),
       config_(config),
       trials_(*config.trials),
+      decode_queue_factory_(
+          absl::StartsWith(trials_.Lookup("WebRTC-Video-DecodeThreadPool"),
+                           "Enabled")
+              ? CreateTaskQueueThreadPoolFactory(
+                    "DecodingPool", num_cpu_cores_,
+                    TaskQueueFactory::Priority::HIGH)
+              : nullptr),
       audio_network_state_(kNetworkDown),
       video_network_state_(kNetworkDown),
       aggregate_network_up_(false),
@@ -1133,7 +1146,9 @@ webrtc::VideoReceiveStream* Call::CreateVideoReceiveStream(
   // and set it up asynchronously on the network thread (the registration and
   // `video_receiver_controller_` need to live on the network thread).
   VideoReceiveStream2* receive_stream = new VideoReceiveStream2(
-      task_queue_factory_, this, num_cpu_cores_,
+      task_queue_factory_,
+      decode_queue_factory_ ? decode_queue_factory_.get() : task_queue_factory_,
+      this, num_cpu_cores_,
       transport_send_->packet_router(), std::move(configuration),
       call_stats_.get(), clock_, new VCMTiming(clock_),
       &nack_periodic_processor_);
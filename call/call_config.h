@@ -26,6 +26,7 @@ namespace webrtc {
 
 class AudioProcessing;
 class RtcEventLog;
+class TaskQueuePacerPool;
 
 struct CallConfig {
   // If `network_task_queue` is set to nullptr, Call will assume that network
@@ -71,6 +72,10 @@ struct CallConfig {
   // e.g. field trials.
   const WebRtcKeyValueConfig* trials = nullptr;
 
+  // Pool to run the pacer of this call on, shared with other calls, instead
+  // of a task queue of its own. Optional, must outlive the call.
+  TaskQueuePacerPool* pacer_pool = nullptr;
+
   TaskQueueBase* const network_task_queue_ = nullptr;
   // RtpTransportControllerSend to use for this call.
   RtpTransportControllerSendFactoryInterface*
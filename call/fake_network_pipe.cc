@@ -221,12 +221,14 @@ bool FakeNetworkPipe::EnqueuePacket(NetworkPacket&& net_packet) {
   size_t packet_size = net_packet.data_length();
 
   packets_in_flight_.emplace_back(StoredPacket(std::move(net_packet)));
-  int64_t packet_id = reinterpret_cast<uint64_t>(&packets_in_flight_.back());
+  uint64_t packet_id = next_packet_id_++;
   bool sent = network_behavior_->EnqueuePacket(
       PacketInFlightInfo(packet_size, send_time_us, packet_id));
 
   if (!sent) {
+    // The network behavior didn't keep the id, so it can be reused.
     packets_in_flight_.pop_back();
+    --next_packet_id_;
     ++dropped_packets_;
   }
   return sent;
@@ -280,16 +282,13 @@ void FakeNetworkPipe::Process() {
     std::vector<PacketDeliveryInfo> delivery_infos =
         network_behavior_->DequeueDeliverablePackets(time_now_us);
     for (auto& delivery_info : delivery_infos) {
-      // In the common case where no reordering happens, find will return early
-      // as the first packet will be a match.
-      auto packet_it =
-          std::find_if(packets_in_flight_.begin(), packets_in_flight_.end(),
-                       [&delivery_info](StoredPacket& packet_ref) {
-                         return reinterpret_cast<uint64_t>(&packet_ref) ==
-                                delivery_info.packet_id;
-                       });
       // Check that the packet is in the deque of packets in flight.
-      RTC_CHECK(packet_it != packets_in_flight_.end());
+      const uint64_t front_packet_id =
+          next_packet_id_ - packets_in_flight_.size();
+      RTC_CHECK_GE(delivery_info.packet_id, front_packet_id);
+      RTC_CHECK_LT(delivery_info.packet_id, next_packet_id_);
+      auto packet_it = packets_in_flight_.begin() +
+                       (delivery_info.packet_id - front_packet_id);
       // Check that the packet is not already removed.
       RTC_DCHECK(!packet_it->removed);
 
@@ -213,11 +213,11 @@ class FakeNetworkPipe : public SimulatedPacketReceiverInterface {
   // processes, such as the packet queues.
   Mutex process_lock_;
   // Packets  are added at the back of the deque, this makes the deque ordered
-  // by increasing send time. The common case when removing packets from the
-  // deque is removing early packets, which will be close to the front of the
-  // deque. This makes finding the packets in the deque efficient in the common
-  // case.
+  // by increasing send time. Packets are given consecutive ids, so a packet is
+  // found from its id by indexing relative to the id of the back packet.
   std::deque<StoredPacket> packets_in_flight_ RTC_GUARDED_BY(process_lock_);
+  // The id given to the next packet added to `packets_in_flight_`.
+  uint64_t next_packet_id_ RTC_GUARDED_BY(process_lock_) = 0;
 
   int64_t clock_offset_ms_ RTC_GUARDED_BY(config_lock_);
 
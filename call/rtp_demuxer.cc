@@ -10,6 +10,12 @@
 
 #include "call/rtp_demuxer.h"
 
+#include <string.h>
+
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "api/array_view.h"
 #include "call/rtp_packet_sink_interface.h"
 #include "modules/rtp_rtcp/source/rtp_header_extensions.h"
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
@@ -20,6 +26,16 @@
 namespace webrtc {
 namespace {
 
+// Returns the value of a string header extension as
+// BaseRtpStringExtension::Parse would, without copying it. Empty if the
+// extension is missing or malformed.
+absl::string_view StringExtensionValue(rtc::ArrayView<const uint8_t> data) {
+  if (data.empty() || data[0] == 0)
+    return absl::string_view();
+  const char* cstr = reinterpret_cast<const char*>(data.data());
+  return absl::string_view(cstr, strnlen(cstr, data.size()));
+}
+
 template <typename Container, typename Value>
 size_t RemoveFromMultimapByValue(Container* multimap, const Value& value) {
   size_t count = 0;
@@ -141,6 +157,7 @@ bool RtpDemuxer::AddSink(const RtpDemuxerCriteria& criteria,
   }
 
   RefreshKnownMids();
+  resolved_sink_by_ssrc_.clear();
 
   RTC_LOG(LS_INFO) << "Added sink = " << sink << " for criteria "
                    << criteria.ToString();
@@ -236,6 +253,7 @@ bool RtpDemuxer::RemoveSink(const RtpPacketSinkInterface* sink) {
                        RemoveFromMapByValue(&sink_by_mid_and_rsid_, sink) +
                        RemoveFromMapByValue(&sink_by_rsid_, sink);
   RefreshKnownMids();
+  resolved_sink_by_ssrc_.clear();
   bool removed = num_removed > 0;
   if (removed) {
     RTC_LOG(LS_INFO) << "Removed sink = " << sink << " bindings";
@@ -244,7 +262,15 @@ bool RtpDemuxer::RemoveSink(const RtpPacketSinkInterface* sink) {
 }
 
 bool RtpDemuxer::OnRtpPacket(const RtpPacketReceived& packet) {
-  RtpPacketSinkInterface* sink = ResolveSink(packet);
+  RtpPacketSinkInterface* sink;
+  const auto resolved_it = resolved_sink_by_ssrc_.find(packet.Ssrc());
+  if (resolved_it != resolved_sink_by_ssrc_.end() &&
+      MatchesResolvedSink(packet, resolved_it->second)) {
+    sink = resolved_it->second.sink;
+  } else {
+    sink = ResolveSink(packet);
+    CacheResolvedSink(packet.Ssrc(), sink);
+  }
   if (sink != nullptr) {
     sink->OnRtpPacket(packet);
     return true;
@@ -351,6 +377,48 @@ RtpPacketSinkInterface* RtpDemuxer::ResolveSink(
   return ResolveSinkByPayloadType(packet.PayloadType(), ssrc);
 }
 
+void RtpDemuxer::CacheResolvedSink(uint32_t ssrc,
+                                   RtpPacketSinkInterface* sink) {
+  // Only cache results that the next packet would reproduce: a packet may be
+  // dropped for its MID or RSID alone, and a sink found by payload type but
+  // not bound to the SSRC depends on the payload type.
+  const auto ssrc_sink_it = sink_by_ssrc_.find(ssrc);
+  if (sink == nullptr || ssrc_sink_it == sink_by_ssrc_.end() ||
+      ssrc_sink_it->second != sink) {
+    resolved_sink_by_ssrc_.erase(ssrc);
+    return;
+  }
+  ResolvedSink resolved{sink, "", ""};
+  const auto mid_it = mid_by_ssrc_.find(ssrc);
+  if (mid_it != mid_by_ssrc_.end()) {
+    // A packet with a latched MID is only routed by that MID, so the MID is
+    // known.
+    RTC_DCHECK(known_mids_.find(mid_it->second) != known_mids_.end());
+    resolved.mid = mid_it->second;
+  }
+  const auto rsid_it = rsid_by_ssrc_.find(ssrc);
+  if (rsid_it != rsid_by_ssrc_.end())
+    resolved.rsid = rsid_it->second;
+  resolved_sink_by_ssrc_[ssrc] = std::move(resolved);
+}
+
+bool RtpDemuxer::MatchesResolvedSink(const RtpPacketReceived& packet,
+                                     const ResolvedSink& resolved) const {
+  // A packet without a MID or RSID uses the one latched for its SSRC, which is
+  // the one `resolved` is based on.
+  if (use_mid_) {
+    absl::string_view mid =
+        StringExtensionValue(packet.GetRawExtension<RtpMid>());
+    if (!mid.empty() && mid != resolved.mid)
+      return false;
+  }
+  absl::string_view rsid =
+      StringExtensionValue(packet.GetRawExtension<RepairedRtpStreamId>());
+  if (rsid.empty())
+    rsid = StringExtensionValue(packet.GetRawExtension<RtpStreamId>());
+  return rsid.empty() || rsid == resolved.rsid;
+}
+
 RtpPacketSinkInterface* RtpDemuxer::ResolveSinkByMid(const std::string& mid,
                                                      uint32_t ssrc) {
   const auto it = sink_by_mid_.find(mid);
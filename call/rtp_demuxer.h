@@ -163,6 +163,19 @@ class RtpDemuxer {
   // sink_by_mid_and_rsid_ maps.
   void RefreshKnownMids();
 
+  // The result of running ResolveSink on a packet with the given SSRC, along
+  // with the MID and RSID it was based on (empty if none). A later packet with
+  // the same SSRC resolves to the same sink unless it carries a different MID
+  // or RSID, so it skips the full algorithm.
+  struct ResolvedSink {
+    RtpPacketSinkInterface* sink;
+    std::string mid;
+    std::string rsid;
+  };
+  void CacheResolvedSink(uint32_t ssrc, RtpPacketSinkInterface* sink);
+  bool MatchesResolvedSink(const RtpPacketReceived& packet,
+                           const ResolvedSink& resolved) const;
+
   // Map each sink by its component attributes to facilitate quick lookups.
   // Payload Type mapping is a multimap because if two sinks register for the
   // same payload type, both AddSinks succeed but we must know not to demux on
@@ -189,6 +202,10 @@ class RtpDemuxer {
   flat_map<uint32_t, std::string> mid_by_ssrc_;
   flat_map<uint32_t, std::string> rsid_by_ssrc_;
 
+  // Cleared whenever a sink is added or removed. Only holds SSRCs that are
+  // also in `sink_by_ssrc_`, so it has at most kMaxSsrcBindings entries.
+  flat_map<uint32_t, ResolvedSink> resolved_sink_by_ssrc_;
+
   // Adds a binding from the SSRC to the given sink.
   void AddSsrcSinkBinding(uint32_t ssrc, RtpPacketSinkInterface* sink);
 
@@ -1100,6 +1100,30 @@ TEST_F(RtpDemuxerTest, SignaledMidShouldOverwriteSignalledSsrcPersistent) {
   EXPECT_TRUE(demuxer_.OnRtpPacket(*packet_without_mid));
 }
 
+TEST_F(RtpDemuxerTest, SsrcMovedToAnotherMidIsRoutedToItsSink) {
+  constexpr uint32_t ssrc = 10;
+  const std::string mid1 = "mid1";
+  const std::string mid2 = "mid2";
+
+  MockRtpPacketSink mid1_sink;
+  AddSinkOnlyMid(mid1, &mid1_sink);
+  MockRtpPacketSink mid2_sink;
+  AddSinkOnlyMid(mid2, &mid2_sink);
+
+  auto packet_mid1 = CreatePacketWithSsrcMid(ssrc, mid1);
+  auto packet_mid2 = CreatePacketWithSsrcMid(ssrc, mid2);
+  auto packet_without_mid = CreatePacketWithSsrc(ssrc);
+  InSequence sequence;
+  EXPECT_CALL(mid1_sink, OnRtpPacket(SamePacketAs(*packet_mid1))).Times(2);
+  EXPECT_CALL(mid2_sink, OnRtpPacket(SamePacketAs(*packet_mid2))).Times(1);
+  EXPECT_CALL(mid2_sink, OnRtpPacket(SamePacketAs(*packet_without_mid)))
+      .Times(1);
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*packet_mid1));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*packet_mid1));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*packet_mid2));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*packet_without_mid));
+}
+
 TEST_F(RtpDemuxerTest, RouteByPayloadTypeMultipleMatch) {
   constexpr uint32_t ssrc = 10;
   constexpr uint8_t pt1 = 30;
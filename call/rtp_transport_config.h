@@ -23,6 +23,9 @@
 
 namespace webrtc {
 
+class TaskQueuePacerPool;
+
+
 struct RtpTransportConfig {
   // Bitrate config used until valid bitrate estimates are calculated. Also
   // used to cap total bitrate used. This comes from the remote connection.
@@ -45,6 +48,10 @@ struct RtpTransportConfig {
   // Key-value mapping of internal configurations to apply,
   // e.g. field trials.
   const WebRtcKeyValueConfig* trials = nullptr;
+
+  // Pool to run the pacer on, shared with other transports, instead of a
+  // task queue of its own. Optional, must outlive the transport.
+  TaskQueuePacerPool* pacer_pool = nullptr;
 };
 }  // namespace webrtc
 
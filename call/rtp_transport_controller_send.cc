@@ -73,6 +73,25 @@ bool IsRelayed(const rtc::NetworkRoute& route) {
   return route.local.uses_turn() || route.remote.uses_turn();
 }
 
+std::unique_ptr<TaskQueuePacedSender> CreateTaskQueuePacer(
+    Clock* clock,
+    PacingController::PacketSender* packet_sender,
+    RtcEventLog* event_log,
+    const WebRtcKeyValueConfig* trials,
+    TaskQueueFactory* task_queue_factory,
+    TaskQueuePacerPool* pacer_pool,
+    TimeDelta max_hold_back_window,
+    int max_hold_back_window_in_packets) {
+  if (pacer_pool) {
+    return std::make_unique<TaskQueuePacedSender>(
+        clock, packet_sender, event_log, trials, pacer_pool,
+        max_hold_back_window, max_hold_back_window_in_packets);
+  }
+  return std::make_unique<TaskQueuePacedSender>(
+      clock, packet_sender, event_log, trials, task_queue_factory,
+      max_hold_back_window, max_hold_back_window_in_packets);
+}
+
 }  // namespace
 
 RtpTransportControllerSend::PacerSettings::PacerSettings(
@@ -92,7 +111,8 @@ RtpTransportControllerSend::RtpTransportControllerSend(
     const BitrateConstraints& bitrate_config,
     std::unique_ptr<ProcessThread> process_thread,
     TaskQueueFactory* task_queue_factory,
-    const WebRtcKeyValueConfig* trials)
+    const WebRtcKeyValueConfig* trials,
+    TaskQueuePacerPool* pacer_pool)
     : clock_(clock),
       event_log_(event_log),
       bitrate_configurator_(bitrate_config),
@@ -108,13 +128,14 @@ RtpTransportControllerSend::RtpTransportControllerSend(
                                                   process_thread_.get())),
       task_queue_pacer_(
           pacer_settings_.use_task_queue_pacer()
-              ? new TaskQueuePacedSender(clock,
-                                         &packet_router_,
-                                         event_log,
-                                         trials,
-                                         task_queue_factory,
-                                         pacer_settings_.holdback_window.Get(),
-                                         pacer_settings_.holdback_packets.Get())
+              ? CreateTaskQueuePacer(clock,
+                                     &packet_router_,
+                                     event_log,
+                                     trials,
+                                     task_queue_factory,
+                                     pacer_pool,
+                                     pacer_settings_.holdback_window.Get(),
+                                     pacer_settings_.holdback_packets.Get())
               : nullptr),
       observer_(nullptr),
       controller_factory_override_(controller_factory),
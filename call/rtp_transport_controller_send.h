@@ -33,6 +33,7 @@
 #include "modules/pacing/task_queue_paced_sender.h"
 #include "modules/utility/include/process_thread.h"
 #include "rtc_base/constructor_magic.h"
+#include "rtc_base/containers/flat_map.h"
 #include "rtc_base/network_route.h"
 #include "rtc_base/race_checker.h"
 #include "rtc_base/task_queue.h"
@@ -60,7 +61,8 @@ class RtpTransportControllerSend final
       const BitrateConstraints& bitrate_config,
       std::unique_ptr<ProcessThread> process_thread,
       TaskQueueFactory* task_queue_factory,
-      const WebRtcKeyValueConfig* trials);
+      const WebRtcKeyValueConfig* trials,
+      TaskQueuePacerPool* pacer_pool = nullptr);
   ~RtpTransportControllerSend() override;
 
   // TODO(tommi): Change to std::unique_ptr<>.
@@ -191,7 +193,7 @@ class RtpTransportControllerSend final
 
   TimeDelta process_interval_ RTC_GUARDED_BY(task_queue_);
 
-  std::map<uint32_t, RTCPReportBlock> last_report_blocks_
+  flat_map<uint32_t, RTCPReportBlock> last_report_blocks_
       RTC_GUARDED_BY(task_queue_);
   Timestamp last_report_block_time_ RTC_GUARDED_BY(task_queue_);
 
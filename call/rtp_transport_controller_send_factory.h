@@ -28,7 +28,8 @@ class RtpTransportControllerSendFactory
     return std::make_unique<RtpTransportControllerSend>(
         clock, config.event_log, config.network_state_predictor_factory,
         config.network_controller_factory, config.bitrate_config,
-        std::move(process_thread), config.task_queue_factory, config.trials);
+        std::move(process_thread), config.task_queue_factory, config.trials,
+        config.pacer_pool);
   }
 
   virtual ~RtpTransportControllerSendFactory() {}
@@ -36,6 +36,7 @@
 #include "modules/rtp_rtcp/source/rtp_sequence_number_map.h"
 #include "modules/rtp_rtcp/source/rtp_video_header.h"
 #include "rtc_base/constructor_magic.h"
+#include "rtc_base/containers/flat_map.h"
 #include "rtc_base/rate_limiter.h"
 #include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/thread_annotations.h"
@@ -204,7 +205,7 @@ class RtpVideoSender : public RtpVideoSenderInterface,
   // Effectively const map from SSRC to RtpRtcp, for all media SSRCs.
   // This map is set at construction time and never changed, but it's
   // non-trivial to make it properly const.
-  std::map<uint32_t, RtpRtcpInterface*> ssrc_to_rtp_module_;
+  flat_map<uint32_t, RtpRtcpInterface*> ssrc_to_rtp_module_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(RtpVideoSender);
 };
@@ -110,22 +110,25 @@ void SimulatedNetwork::SetConfig(const Config& config) {
     config_state_.prob_start_bursting =
         prob_loss / (1 - prob_loss) / avg_burst_loss_length;
   }
+  config_version_.fetch_add(1, std::memory_order_release);
 }
 
 void SimulatedNetwork::UpdateConfig(
     std::function<void(BuiltInNetworkBehaviorConfig*)> config_modifier) {
   MutexLock lock(&config_lock_);
   config_modifier(&config_state_.config);
+  config_version_.fetch_add(1, std::memory_order_release);
 }
 
 void SimulatedNetwork::PauseTransmissionUntil(int64_t until_us) {
   MutexLock lock(&config_lock_);
   config_state_.pause_transmission_until_us = until_us;
+  config_version_.fetch_add(1, std::memory_order_release);
 }
 
 bool SimulatedNetwork::EnqueuePacket(PacketInFlightInfo packet) {
   RTC_DCHECK_RUNS_SERIALIZED(&process_checker_);
-  ConfigState state = GetConfigState();
+  const ConfigState& state = GetConfigState();
 
   UpdateCapacityQueue(state, packet.send_time_us);
 
@@ -153,9 +156,10 @@ absl::optional<int64_t> SimulatedNetwork::NextDeliveryTimeUs() const {
   return next_process_time_us_;
 }
 
-void SimulatedNetwork::UpdateCapacityQueue(ConfigState state,
+void SimulatedNetwork::UpdateCapacityQueue(const ConfigState& state,
                                            int64_t time_now_us) {
   bool needs_sort = false;
+  const size_t num_delayed_packets = delay_link_.size();
 
   // Catch for thread races.
   if (time_now_us < last_capacity_link_visit_us_.value_or(time_now_us))
@@ -252,17 +256,31 @@ void SimulatedNetwork::UpdateCapacityQueue(ConfigState state,
   pending_drain_bits_ = std::min(pending_drain_bits_, queue_size_bytes_ * 8);
 
   if (needs_sort) {
-    // Packet(s) arrived out of order, make sure list is sorted.
-    std::sort(delay_link_.begin(), delay_link_.end(),
-              [](const PacketInfo& p1, const PacketInfo& p2) {
-                return p1.arrival_time_us < p2.arrival_time_us;
-              });
+    // Packet(s) arrived out of order, make sure list is sorted. Usually the
+    // packets already in the delay link are sorted, and only the packets
+    // added above need sorting and merging in.
+    auto by_arrival_time = [](const PacketInfo& p1, const PacketInfo& p2) {
+      return p1.arrival_time_us < p2.arrival_time_us;
+    };
+    auto first_new = delay_link_.begin() + num_delayed_packets;
+    if (std::is_sorted(delay_link_.begin(), first_new, by_arrival_time)) {
+      std::sort(first_new, delay_link_.end(), by_arrival_time);
+      std::inplace_merge(delay_link_.begin(), first_new, delay_link_.end(),
+                         by_arrival_time);
+    } else {
+      std::sort(delay_link_.begin(), delay_link_.end(), by_arrival_time);
+    }
   }
 }
 
-SimulatedNetwork::ConfigState SimulatedNetwork::GetConfigState() const {
-  MutexLock lock(&config_lock_);
-  return config_state_;
+const SimulatedNetwork::ConfigState& SimulatedNetwork::GetConfigState() {
+  if (config_version_.load(std::memory_order_acquire) !=
+      process_config_version_) {
+    MutexLock lock(&config_lock_);
+    process_config_state_ = config_state_;
+    process_config_version_ = config_version_.load(std::memory_order_relaxed);
+  }
+  return process_config_state_;
 }
 
 std::vector<PacketDeliveryInfo> SimulatedNetwork::DequeueDeliverablePackets(
@@ -12,6 +12,7 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <deque>
 #include <queue>
 #include <vector>
@@ -92,9 +93,12 @@ class SimulatedNetwork : public SimulatedNetworkInterface {
   };
 
   // Moves packets from capacity- to delay link.
-  void UpdateCapacityQueue(ConfigState state, int64_t time_now_us)
+  void UpdateCapacityQueue(const ConfigState& state, int64_t time_now_us)
       RTC_RUN_ON(&process_checker_);
-  ConfigState GetConfigState() const;
+  // Returns the configuration to process packets with. It is only copied from
+  // `config_state_` when it has changed, so the packet path doesn't take
+  // `config_lock_` for every packet.
+  const ConfigState& GetConfigState() RTC_RUN_ON(&process_checker_);
 
   mutable Mutex config_lock_;
 
@@ -108,6 +112,10 @@ class SimulatedNetwork : public SimulatedNetworkInterface {
   std::deque<PacketInfo> delay_link_ RTC_GUARDED_BY(process_checker_);
 
   ConfigState config_state_ RTC_GUARDED_BY(config_lock_);
+  // Incremented whenever `config_state_` changes.
+  std::atomic<int> config_version_{0};
+  ConfigState process_config_state_ RTC_GUARDED_BY(process_checker_);
+  int process_config_version_ RTC_GUARDED_BY(process_checker_) = -1;
 
   // Are we currently dropping a burst of packets?
   bool bursting_;
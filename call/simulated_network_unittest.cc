@@ -146,4 +146,57 @@ TEST(SimulatedNetworkTest, CodelLimitsDelayAndDropsPacketsOnOverload) {
   }
   EXPECT_EQ(send_times_us.size(), 0u);
 }
+
+TEST(SimulatedNetworkTest, AppliesUpdatedConfigToLaterPackets) {
+  SimulatedNetwork::Config config;
+  config.queue_delay_ms = 10;
+  SimulatedNetwork network(config);
+
+  ASSERT_TRUE(network.EnqueuePacket(PacketInFlightInfo(1000, 0, 1)));
+  // Moves the first packet onto the delay link.
+  EXPECT_TRUE(network.DequeueDeliverablePackets(0).empty());
+  network.UpdateConfig([](SimulatedNetwork::Config* config) {
+    config->queue_delay_ms = 50;
+  });
+  ASSERT_TRUE(network.EnqueuePacket(PacketInFlightInfo(1000, 0, 2)));
+
+  std::vector<PacketDeliveryInfo> delivered =
+      network.DequeueDeliverablePackets(100000);
+  ASSERT_EQ(delivered.size(), 2u);
+  EXPECT_EQ(delivered[0].packet_id, 1u);
+  EXPECT_EQ(delivered[0].receive_time_us, 10000);
+  EXPECT_EQ(delivered[1].packet_id, 2u);
+  EXPECT_EQ(delivered[1].receive_time_us, 50000);
+}
+
+TEST(SimulatedNetworkTest, DeliversReorderedPacketsInArrivalOrder) {
+  SimulatedNetwork::Config config;
+  config.queue_delay_ms = 20;
+  config.delay_standard_deviation_ms = 10;
+  config.allow_reordering = true;
+  SimulatedNetwork network(config);
+
+  int64_t time_us = 0;
+  int64_t last_receive_time_us = 0;
+  size_t num_delivered = 0;
+  for (uint64_t id = 0; id < 1000; ++id) {
+    ASSERT_TRUE(network.EnqueuePacket(PacketInFlightInfo(1000, time_us, id)));
+    time_us += 1000;
+    for (const PacketDeliveryInfo& packet :
+         network.DequeueDeliverablePackets(time_us)) {
+      EXPECT_GE(packet.receive_time_us, last_receive_time_us);
+      last_receive_time_us = packet.receive_time_us;
+      ++num_delivered;
+    }
+  }
+  while (network.NextDeliveryTimeUs()) {
+    for (const PacketDeliveryInfo& packet :
+         network.DequeueDeliverablePackets(*network.NextDeliveryTimeUs())) {
+      EXPECT_GE(packet.receive_time_us, last_receive_time_us);
+      last_receive_time_us = packet.receive_time_us;
+      ++num_delivered;
+    }
+  }
+  EXPECT_EQ(num_delivered, 1000u);
+}
 }  // namespace webrtc
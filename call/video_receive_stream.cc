@@ -65,6 +65,11 @@ std::string VideoReceiveStream::Stats::ToString(int64_t time_ms) const {
   ss << "max_decode_ms: " << max_decode_ms << ", ";
   ss << "first_frame_received_to_decoded_ms: "
      << first_frame_received_to_decoded_ms << ", ";
+  ss << "packet_buffer_insert_us: " << total_packet_buffer_insert_time.us()
+     << ", ";
+  ss << "reference_finding_us: " << total_reference_finding_time.us() << ", ";
+  ss << "jitter_estimation_us: " << total_jitter_estimation_time.us() << ", ";
+  ss << "timing_update_us: " << total_timing_update_time.us() << ", ";
   ss << "cur_delay_ms: " << current_delay_ms << ", ";
   ss << "targ_delay_ms: " << target_delay_ms << ", ";
   ss << "jb_delay_ms: " << jitter_buffer_ms << ", ";
@@ -22,6 +22,7 @@
 #include "api/crypto/crypto_options.h"
 #include "api/rtp_headers.h"
 #include "api/rtp_parameters.h"
+#include "api/units/time_delta.h"
 #include "api/video/recordable_encoded_frame.h"
 #include "api/video/video_content_type.h"
 #include "api/video/video_frame.h"
@@ -115,6 +116,14 @@ class VideoReceiveStream : public MediaReceiveStream {
     int64_t first_frame_received_to_decoded_ms = -1;
     absl::optional<uint64_t> qp_sum;
 
+    // Wall time spent by the stages of the receive pipeline before decoding,
+    // summed over all packets and frames, to find where the receive side CPU
+    // time of a stream goes. Decoding is covered by `total_decode_time_ms`.
+    TimeDelta total_packet_buffer_insert_time = TimeDelta::Zero();
+    TimeDelta total_reference_finding_time = TimeDelta::Zero();
+    TimeDelta total_jitter_estimation_time = TimeDelta::Zero();
+    TimeDelta total_timing_update_time = TimeDelta::Zero();
+
     int current_payload_type = -1;
 
     int total_bitrate_bps = 0;
@@ -13,6 +13,7 @@
 
 #include <stdint.h>
 
+#include <functional>
 #include <map>
 #include <string>
 #include <vector>
@@ -24,6 +25,8 @@
 #include "api/frame_transformer_interface.h"
 #include "api/rtp_parameters.h"
 #include "api/scoped_refptr.h"
+#include "api/video/encoded_image.h"
+#include "api/video/video_codec_type.h"
 #include "api/video/video_content_type.h"
 #include "api/video/video_frame.h"
 #include "api/video/video_sink_interface.h"
@@ -195,6 +198,12 @@ class VideoSendStream {
 
     rtc::scoped_refptr<webrtc::FrameTransformerInterface> frame_transformer;
 
+    // If set, called with every encoded image before it's packetized, on the
+    // encoder's thread, e.g. to record the stream with an
+    // EncodedFrameRecorder. The encoded data is reference counted, so a sink
+    // that keeps the image doesn't need to copy it.
+    std::function<void(const EncodedImage&, VideoCodecType)> encoded_frame_sink;
+
    private:
     // Access to the copy constructor is private to force use of the Copy()
     // method for those exceptional cases where we do use it.
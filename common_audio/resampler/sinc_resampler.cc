@@ -91,9 +91,12 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <array>
 #include <limits>
+#include <map>
 
 #include "rtc_base/checks.h"
+#include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/system/arch.h"
 #include "system_wrappers/include/cpu_features_wrapper.h"  // kSSE2, WebRtc_G...
 
@@ -117,6 +120,81 @@ double SincScaleFactor(double io_ratio) {
   return sinc_scale_factor;
 }
 
+// The parts of the kernels that do not depend on the sample rate ratio.
+struct KernelTables {
+  KernelTables() {
+    // Blackman window parameters.
+    static const double kAlpha = 0.16;
+    static const double kA0 = 0.5 * (1.0 - kAlpha);
+    static const double kA1 = 0.5;
+    static const double kA2 = 0.5 * kAlpha;
+
+    // We generate a range of sub-sample offsets from 0.0 to 1.0.
+    for (size_t offset_idx = 0; offset_idx <= SincResampler::kKernelOffsetCount;
+         ++offset_idx) {
+      const float subsample_offset =
+          static_cast<float>(offset_idx) / SincResampler::kKernelOffsetCount;
+
+      for (size_t i = 0; i < SincResampler::kKernelSize; ++i) {
+        const size_t idx = i + offset_idx * SincResampler::kKernelSize;
+        pre_sinc[idx] = static_cast<float>(
+            M_PI * (static_cast<int>(i) -
+                    static_cast<int>(SincResampler::kKernelSize / 2) -
+                    subsample_offset));
+
+        // Compute Blackman window, matching the offset of the sinc().
+        const float x = (i - subsample_offset) / SincResampler::kKernelSize;
+        window[idx] = static_cast<float>(kA0 - kA1 * cos(2.0 * M_PI * x) +
+                                         kA2 * cos(4.0 * M_PI * x));
+      }
+    }
+  }
+
+  std::array<float, SincResampler::kKernelStorageSize> pre_sinc;
+  std::array<float, SincResampler::kKernelStorageSize> window;
+};
+
+// Returns the set of windowed sinc() kernels for `io_ratio`. The kernels are
+// cached while in use, since the channels of a stream and the streams
+// converted between the same rates all use the same ones.
+std::shared_ptr<const float> GetKernels(double io_ratio) {
+  static const KernelTables* const tables = new KernelTables();
+  static Mutex* const mutex = new Mutex();
+  static auto* const cache =
+      new std::map<double, std::weak_ptr<const float>>();
+
+  MutexLock lock(mutex);
+  auto it = cache->find(io_ratio);
+  if (it != cache->end()) {
+    std::shared_ptr<const float> kernels = it->second.lock();
+    if (kernels) {
+      return kernels;
+    }
+  }
+  // Drop the kernels that are not used anymore.
+  for (it = cache->begin(); it != cache->end();) {
+    it = it->second.expired() ? cache->erase(it) : std::next(it);
+  }
+
+  // Create with a 32-byte alignment for SIMD optimizations.
+  std::shared_ptr<float> kernels(
+      static_cast<float*>(AlignedMalloc(
+          sizeof(float) * SincResampler::kKernelStorageSize, 32)),
+      AlignedFreeDeleter());
+  const double sinc_scale_factor = SincScaleFactor(io_ratio);
+  for (size_t idx = 0; idx < SincResampler::kKernelStorageSize; ++idx) {
+    const float window = tables->window[idx];
+    const float pre_sinc = tables->pre_sinc[idx];
+    // Compute the sinc with offset, then window the sinc() function.
+    kernels.get()[idx] = static_cast<float>(
+        window * ((pre_sinc == 0)
+                      ? sinc_scale_factor
+                      : (sin(sinc_scale_factor * pre_sinc) / pre_sinc)));
+  }
+  (*cache)[io_ratio] = kernels;
+  return kernels;
+}
+
 }  // namespace
 
 const size_t SincResampler::kKernelSize;
@@ -146,13 +224,8 @@ SincResampler::SincResampler(double io_sample_rate_ratio,
       read_cb_(read_cb),
       request_frames_(request_frames),
       input_buffer_size_(request_frames_ + kKernelSize),
+      kernel_storage_(GetKernels(io_sample_rate_ratio_)),
       // Create input buffers with a 32-byte alignment for SIMD optimizations.
-      kernel_storage_(static_cast<float*>(
-          AlignedMalloc(sizeof(float) * kKernelStorageSize, 32))),
-      kernel_pre_sinc_storage_(static_cast<float*>(
-          AlignedMalloc(sizeof(float) * kKernelStorageSize, 32))),
-      kernel_window_storage_(static_cast<float*>(
-          AlignedMalloc(sizeof(float) * kKernelStorageSize, 32))),
       input_buffer_(static_cast<float*>(
           AlignedMalloc(sizeof(float) * input_buffer_size_, 32))),
       convolve_proc_(nullptr),
@@ -163,15 +236,6 @@ SincResampler::SincResampler(double io_sample_rate_ratio,
   RTC_DCHECK_GT(request_frames_, 0);
   Flush();
   RTC_DCHECK_GT(block_size_, kKernelSize);
-
-  memset(kernel_storage_.get(), 0,
-         sizeof(*kernel_storage_.get()) * kKernelStorageSize);
-  memset(kernel_pre_sinc_storage_.get(), 0,
-         sizeof(*kernel_pre_sinc_storage_.get()) * kKernelStorageSize);
-  memset(kernel_window_storage_.get(), 0,
-         sizeof(*kernel_window_storage_.get()) * kKernelStorageSize);
-
-  InitializeKernel();
 }
 
 SincResampler::~SincResampler() {}
@@ -192,43 +256,6 @@ void SincResampler::UpdateRegions(bool second_load) {
   RTC_DCHECK_LT(r2_, r3_);
 }
 
-void SincResampler::InitializeKernel() {
-  // Blackman window parameters.
-  static const double kAlpha = 0.16;
-  static const double kA0 = 0.5 * (1.0 - kAlpha);
-  static const double kA1 = 0.5;
-  static const double kA2 = 0.5 * kAlpha;
-
-  // Generates a set of windowed sinc() kernels.
-  // We generate a range of sub-sample offsets from 0.0 to 1.0.
-  const double sinc_scale_factor = SincScaleFactor(io_sample_rate_ratio_);
-  for (size_t offset_idx = 0; offset_idx <= kKernelOffsetCount; ++offset_idx) {
-    const float subsample_offset =
-        static_cast<float>(offset_idx) / kKernelOffsetCount;
-
-    for (size_t i = 0; i < kKernelSize; ++i) {
-      const size_t idx = i + offset_idx * kKernelSize;
-      const float pre_sinc = static_cast<float>(
-          M_PI * (static_cast<int>(i) - static_cast<int>(kKernelSize / 2) -
-                  subsample_offset));
-      kernel_pre_sinc_storage_[idx] = pre_sinc;
-
-      // Compute Blackman window, matching the offset of the sinc().
-      const float x = (i - subsample_offset) / kKernelSize;
-      const float window = static_cast<float>(kA0 - kA1 * cos(2.0 * M_PI * x) +
-                                              kA2 * cos(4.0 * M_PI * x));
-      kernel_window_storage_[idx] = window;
-
-      // Compute the sinc with offset, then window the sinc() function and store
-      // at the correct offset.
-      kernel_storage_[idx] = static_cast<float>(
-          window * ((pre_sinc == 0)
-                        ? sinc_scale_factor
-                        : (sin(sinc_scale_factor * pre_sinc) / pre_sinc)));
-    }
-  }
-}
-
 void SincResampler::SetRatio(double io_sample_rate_ratio) {
   if (fabs(io_sample_rate_ratio_ - io_sample_rate_ratio) <
       std::numeric_limits<double>::epsilon()) {
@@ -236,22 +263,7 @@ void SincResampler::SetRatio(double io_sample_rate_ratio) {
   }
 
   io_sample_rate_ratio_ = io_sample_rate_ratio;
-
-  // Optimize reinitialization by reusing values which are independent of
-  // `sinc_scale_factor`.  Provides a 3x speedup.
-  const double sinc_scale_factor = SincScaleFactor(io_sample_rate_ratio_);
-  for (size_t offset_idx = 0; offset_idx <= kKernelOffsetCount; ++offset_idx) {
-    for (size_t i = 0; i < kKernelSize; ++i) {
-      const size_t idx = i + offset_idx * kKernelSize;
-      const float window = kernel_window_storage_[idx];
-      const float pre_sinc = kernel_pre_sinc_storage_[idx];
-
-      kernel_storage_[idx] = static_cast<float>(
-          window * ((pre_sinc == 0)
-                        ? sinc_scale_factor
-                        : (sin(sinc_scale_factor * pre_sinc) / pre_sinc)));
-    }
-  }
+  kernel_storage_ = GetKernels(io_sample_rate_ratio_);
 }
 
 void SincResampler::Resample(size_t frames, float* destination) {
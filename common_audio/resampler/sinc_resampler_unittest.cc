@@ -101,6 +101,23 @@ TEST(SincResamplerTest, Flush) {
     ASSERT_FLOAT_EQ(resampled_destination[i], 0);
 }
 
+TEST(SincResamplerTest, SharesKernelsOfSameRatio) {
+  MockSource mock_source;
+  SincResampler resampler1(kSampleRateRatio, SincResampler::kDefaultRequestSize,
+                           &mock_source);
+  SincResampler resampler2(kSampleRateRatio, SincResampler::kDefaultRequestSize,
+                           &mock_source);
+  EXPECT_EQ(resampler1.get_kernel_for_testing(),
+            resampler2.get_kernel_for_testing());
+
+  resampler2.SetRatio(M_PI);
+  EXPECT_NE(resampler1.get_kernel_for_testing(),
+            resampler2.get_kernel_for_testing());
+  resampler2.SetRatio(kSampleRateRatio);
+  EXPECT_EQ(resampler1.get_kernel_for_testing(),
+            resampler2.get_kernel_for_testing());
+}
+
 // Test flush resets the internal state properly.
 TEST(SincResamplerTest, DISABLED_SetRatioBench) {
   MockSource mock_source;
@@ -0,0 +1,70 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+
+#include <emmintrin.h>
+
+// Unlike the NEON version, every product is shifted before it is added, as in
+// WebRtcSpl_CrossCorrelationC(), so that both versions are bit-exact.
+static inline int32_t DotProductWithScaleSse2(const int16_t* vector1,
+                                              const int16_t* vector2,
+                                              size_t length,
+                                              int scaling) {
+  const __m128i shift = _mm_cvtsi32_si128(scaling);
+  __m128i sum = _mm_setzero_si128();
+  size_t i = 0;
+  int32_t result = 0;
+
+  if (scaling == 0) {
+    // No shift, hence the products may be summed pairwise.
+    for (; i + 8 <= length; i += 8) {
+      const __m128i seq1 = _mm_loadu_si128((const __m128i*)&vector1[i]);
+      const __m128i seq2 = _mm_loadu_si128((const __m128i*)&vector2[i]);
+      sum = _mm_add_epi32(sum, _mm_madd_epi16(seq1, seq2));
+    }
+  } else {
+    for (; i + 8 <= length; i += 8) {
+      const __m128i seq1 = _mm_loadu_si128((const __m128i*)&vector1[i]);
+      const __m128i seq2 = _mm_loadu_si128((const __m128i*)&vector2[i]);
+      const __m128i low = _mm_mullo_epi16(seq1, seq2);
+      const __m128i high = _mm_mulhi_epi16(seq1, seq2);
+      sum = _mm_add_epi32(
+          sum, _mm_sra_epi32(_mm_unpacklo_epi16(low, high), shift));
+      sum = _mm_add_epi32(
+          sum, _mm_sra_epi32(_mm_unpackhi_epi16(low, high), shift));
+    }
+  }
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+  result = _mm_cvtsi128_si32(sum);
+
+  for (; i < length; i++) {
+    result += (vector1[i] * vector2[i]) >> scaling;
+  }
+  return result;
+}
+
+/* SSE2 version of WebRtcSpl_CrossCorrelation() for x86 platforms. */
+void WebRtcSpl_CrossCorrelationSse2(int32_t* cross_correlation,
+                                    const int16_t* seq1,
+                                    const int16_t* seq2,
+                                    size_t dim_seq,
+                                    size_t dim_cross_correlation,
+                                    int right_shifts,
+                                    int step_seq2) {
+  size_t i = 0;
+
+  for (i = 0; i < dim_cross_correlation; i++) {
+    *cross_correlation++ =
+        DotProductWithScaleSse2(seq1, seq2, dim_seq, right_shifts);
+    seq2 += step_seq2;
+  }
+}
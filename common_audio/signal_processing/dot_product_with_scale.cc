@@ -10,8 +10,27 @@
 
 #include "common_audio/signal_processing/dot_product_with_scale.h"
 
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include "rtc_base/numerics/safe_conversions.h"
 
+namespace {
+
+#if defined(__SSE2__) && !defined(WEBRTC_HAS_NEON)
+// Adds the sign-extended 32 bit lanes of `terms` to the 64 bit lanes of `sum`.
+inline __m128i AddTerms(__m128i sum, __m128i terms) {
+  const __m128i sign = _mm_srai_epi32(terms, 31);
+  sum = _mm_add_epi64(sum, _mm_unpacklo_epi32(terms, sign));
+  return _mm_add_epi64(sum, _mm_unpackhi_epi32(terms, sign));
+}
+#endif
+
+}  // namespace
+
 int32_t WebRtcSpl_DotProductWithScale(const int16_t* vector1,
                                       const int16_t* vector2,
                                       size_t length,
@@ -19,8 +38,42 @@ int32_t WebRtcSpl_DotProductWithScale(const int16_t* vector1,
   int64_t sum = 0;
   size_t i = 0;
 
+  // Every term is shifted before it is accumulated, also by the vectorized
+  // loops, which therefore are bit-exact with the scalar one.
+#if defined(WEBRTC_HAS_NEON)
+  const int32x4_t shift = vdupq_n_s32(-scaling);
+  int64x2_t sum_64x2 = vdupq_n_s64(0);
+  for (; i + 7 < length; i += 8) {
+    const int16x8_t seq1 = vld1q_s16(&vector1[i]);
+    const int16x8_t seq2 = vld1q_s16(&vector2[i]);
+    const int32x4_t low = vmull_s16(vget_low_s16(seq1), vget_low_s16(seq2));
+    const int32x4_t high = vmull_s16(vget_high_s16(seq1), vget_high_s16(seq2));
+    sum_64x2 = vpadalq_s32(sum_64x2, vshlq_s32(low, shift));
+    sum_64x2 = vpadalq_s32(sum_64x2, vshlq_s32(high, shift));
+  }
+  sum = vgetq_lane_s64(sum_64x2, 0) + vgetq_lane_s64(sum_64x2, 1);
+#elif defined(__SSE2__)
+  const __m128i shift = _mm_cvtsi32_si128(scaling);
+  __m128i sum_64x2 = _mm_setzero_si128();
+  for (; i + 7 < length; i += 8) {
+    const __m128i seq1 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&vector1[i]));
+    const __m128i seq2 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&vector2[i]));
+    const __m128i low = _mm_mullo_epi16(seq1, seq2);
+    const __m128i high = _mm_mulhi_epi16(seq1, seq2);
+    sum_64x2 = AddTerms(
+        sum_64x2, _mm_sra_epi32(_mm_unpacklo_epi16(low, high), shift));
+    sum_64x2 = AddTerms(
+        sum_64x2, _mm_sra_epi32(_mm_unpackhi_epi16(low, high), shift));
+  }
+  int64_t lanes[2];
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), sum_64x2);
+  sum = lanes[0] + lanes[1];
+#endif
+
   /* Unroll the loop to improve performance. */
-  for (i = 0; i + 3 < length; i += 4) {
+  for (; i + 3 < length; i += 4) {
     sum += (vector1[i + 0] * vector2[i + 0]) >> scaling;
     sum += (vector1[i + 1] * vector2[i + 1]) >> scaling;
     sum += (vector1[i + 2] * vector2[i + 2]) >> scaling;
@@ -11,6 +11,7 @@
 #include <algorithm>
 
 #include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/strings/string_builder.h"
 #include "test/gtest.h"
 
@@ -539,18 +540,70 @@ TEST(SplTest, CrossCorrelationTest) {
   const int32_t kExpected[kCrossCorrelationDimension] = {-266947903, -15579555,
                                                          -171282001};
   const int32_t* expected = kExpected;
-#if !defined(MIPS32_LE)
+#if defined(WEBRTC_HAS_NEON)
   const int32_t kExpectedNeon[kCrossCorrelationDimension] = {
       -266947901, -15579553, -171281999};
-  if (WebRtcSpl_CrossCorrelation != WebRtcSpl_CrossCorrelationC) {
-    expected = kExpectedNeon;
-  }
+  expected = kExpectedNeon;
 #endif
   for (size_t i = 0; i < kCrossCorrelationDimension; ++i) {
     EXPECT_EQ(expected[i], vector32[i]);
   }
 }
 
+// The optimized versions must be bit-exact with the C versions below, which
+// shift every term before accumulating it.
+TEST(SplTest, OptimizedDotProductsAreBitExact) {
+  const size_t kLength = 1000;
+  int16_t seq1[kLength];
+  int16_t seq2[kLength];
+  uint32_t state = 1;
+  for (size_t i = 0; i < kLength; ++i) {
+    state = state * 1664525 + 1013904223;
+    // Small enough for the cross-correlation not to overflow.
+    seq1[i] = static_cast<int16_t>(state >> 16) >> 6;
+    seq2[i] = static_cast<int16_t>(state) >> 6;
+  }
+  // The extreme products need both halves from the 16 bit multiplications.
+  seq1[0] = WEBRTC_SPL_WORD16_MIN;
+  seq2[0] = WEBRTC_SPL_WORD16_MIN;
+  seq1[1] = WEBRTC_SPL_WORD16_MAX;
+  seq2[1] = WEBRTC_SPL_WORD16_MIN;
+
+  const size_t kCrossCorrelationDimension = 5;
+  const size_t kMaxSeqDimension = kLength - 2 * kCrossCorrelationDimension;
+  for (size_t dim_seq : {size_t{0}, size_t{5}, size_t{8}, size_t{37},
+                         size_t{240}, kMaxSeqDimension}) {
+    for (int shift : {0, 1, 6, 15}) {
+      for (int step : {-1, 1}) {
+        rtc::StringBuilder ss;
+        ss << "dim_seq " << dim_seq << " shift " << shift << " step " << step;
+        SCOPED_TRACE(ss.str());
+        int64_t expected_dot_product = 0;
+        for (size_t i = 0; i < dim_seq; ++i) {
+          expected_dot_product += (seq1[i] * seq2[i]) >> shift;
+        }
+        EXPECT_EQ(rtc::saturated_cast<int32_t>(expected_dot_product),
+                  WebRtcSpl_DotProductWithScale(seq1, seq2, dim_seq, shift));
+
+#if !defined(WEBRTC_HAS_NEON)
+        const int16_t* seq2_start =
+            step > 0 ? seq2 : seq2 + kCrossCorrelationDimension;
+        int32_t expected[kCrossCorrelationDimension];
+        int32_t cross_correlation[kCrossCorrelationDimension];
+        WebRtcSpl_CrossCorrelationC(expected, seq1, seq2_start, dim_seq,
+                                    kCrossCorrelationDimension, shift, step);
+        WebRtcSpl_CrossCorrelation(cross_correlation, seq1, seq2_start,
+                                   dim_seq, kCrossCorrelationDimension, shift,
+                                   step);
+        for (size_t i = 0; i < kCrossCorrelationDimension; ++i) {
+          EXPECT_EQ(expected[i], cross_correlation[i]);
+        }
+#endif
+      }
+    }
+  }
+}
+
 TEST(SplTest, AutoCorrelationTest) {
   int scale = 0;
   int32_t vector32[kVector16Size];
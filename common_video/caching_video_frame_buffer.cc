@@ -0,0 +1,113 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/include/caching_video_frame_buffer.h"
+
+#include <utility>
+
+#include "absl/algorithm/container.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/ref_counted_object.h"
+
+namespace webrtc {
+namespace {
+
+// Sinks scale to a handful of sizes at most, such as the layers of a
+// simulcast stream. Sizes beyond these are scaled on every call.
+constexpr size_t kMaxScaledBuffers = 4;
+
+}  // namespace
+
+// static
+rtc::scoped_refptr<CachingVideoFrameBuffer> CachingVideoFrameBuffer::Create(
+    rtc::scoped_refptr<VideoFrameBuffer> buffer) {
+  return rtc::make_ref_counted<CachingVideoFrameBuffer>(std::move(buffer));
+}
+
+CachingVideoFrameBuffer::CachingVideoFrameBuffer(
+    rtc::scoped_refptr<VideoFrameBuffer> buffer)
+    : buffer_(std::move(buffer)) {
+  RTC_DCHECK(buffer_);
+}
+
+CachingVideoFrameBuffer::~CachingVideoFrameBuffer() = default;
+
+VideoFrameBuffer::Type CachingVideoFrameBuffer::type() const {
+  return Type::kNative;
+}
+
+int CachingVideoFrameBuffer::width() const {
+  return buffer_->width();
+}
+
+int CachingVideoFrameBuffer::height() const {
+  return buffer_->height();
+}
+
+rtc::scoped_refptr<I420BufferInterface> CachingVideoFrameBuffer::ToI420() {
+  MutexLock lock(&mutex_);
+  if (!i420_) {
+    // A failed conversion is retried by the next call.
+    i420_ = buffer_->ToI420();
+  }
+  return i420_;
+}
+
+const I420BufferInterface* CachingVideoFrameBuffer::GetI420() const {
+  MutexLock lock(&mutex_);
+  return i420_.get();
+}
+
+rtc::scoped_refptr<VideoFrameBuffer> CachingVideoFrameBuffer::CropAndScale(
+    int offset_x,
+    int offset_y,
+    int crop_width,
+    int crop_height,
+    int scaled_width,
+    int scaled_height) {
+  if (offset_x != 0 || offset_y != 0 || crop_width != width() ||
+      crop_height != height()) {
+    return buffer_->CropAndScale(offset_x, offset_y, crop_width, crop_height,
+                                 scaled_width, scaled_height);
+  }
+
+  MutexLock lock(&mutex_);
+  auto it = absl::c_find_if(scaled_, [&](const ScaledBuffer& scaled) {
+    return scaled.width == scaled_width && scaled.height == scaled_height;
+  });
+  if (it != scaled_.end()) {
+    return it->buffer;
+  }
+  rtc::scoped_refptr<VideoFrameBuffer> scaled =
+      buffer_->Scale(scaled_width, scaled_height);
+  if (scaled && scaled_.size() < kMaxScaledBuffers) {
+    scaled_.push_back({scaled_width, scaled_height, scaled});
+  }
+  return scaled;
+}
+
+rtc::scoped_refptr<VideoFrameBuffer>
+CachingVideoFrameBuffer::GetMappedFrameBuffer(rtc::ArrayView<Type> types) {
+  if (absl::c_linear_search(types, buffer_->type())) {
+    return buffer_;
+  }
+  if (absl::c_linear_search(types, Type::kI420)) {
+    MutexLock lock(&mutex_);
+    if (i420_) {
+      return i420_;
+    }
+  }
+  if (buffer_->type() == Type::kNative) {
+    return buffer_->GetMappedFrameBuffer(types);
+  }
+  return nullptr;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,125 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/include/caching_video_frame_buffer.h"
+
+#include <atomic>
+#include <vector>
+
+#include "api/scoped_refptr.h"
+#include "api/video/i420_buffer.h"
+#include "api/video/nv12_buffer.h"
+#include "api/video/video_frame_buffer.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/ref_counted_object.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+// Counts conversions and scalings.
+class CountingBuffer : public VideoFrameBuffer {
+ public:
+  CountingBuffer(int width, int height) : width_(width), height_(height) {}
+
+  Type type() const override { return Type::kNative; }
+  int width() const override { return width_; }
+  int height() const override { return height_; }
+  rtc::scoped_refptr<I420BufferInterface> ToI420() override {
+    ++conversions_;
+    return I420Buffer::Create(width_, height_);
+  }
+  rtc::scoped_refptr<VideoFrameBuffer> CropAndScale(
+      int offset_x,
+      int offset_y,
+      int crop_width,
+      int crop_height,
+      int scaled_width,
+      int scaled_height) override {
+    ++scalings_;
+    return I420Buffer::Create(scaled_width, scaled_height);
+  }
+
+  int conversions() const { return conversions_; }
+  int scalings() const { return scalings_; }
+
+ private:
+  const int width_;
+  const int height_;
+  std::atomic<int> conversions_{0};
+  std::atomic<int> scalings_{0};
+};
+
+TEST(CachingVideoFrameBufferTest, ConvertsOnce) {
+  auto source = rtc::make_ref_counted<CountingBuffer>(64, 48);
+  rtc::scoped_refptr<CachingVideoFrameBuffer> buffer =
+      CachingVideoFrameBuffer::Create(source);
+  EXPECT_EQ(buffer->type(), VideoFrameBuffer::Type::kNative);
+  EXPECT_EQ(buffer->width(), 64);
+  EXPECT_EQ(buffer->height(), 48);
+  EXPECT_EQ(buffer->GetI420(), nullptr);
+
+  rtc::scoped_refptr<I420BufferInterface> i420 = buffer->ToI420();
+  EXPECT_EQ(buffer->ToI420(), i420);
+  EXPECT_EQ(buffer->GetI420(), i420.get());
+  EXPECT_EQ(source->conversions(), 1);
+}
+
+TEST(CachingVideoFrameBufferTest, ConvertsOnceFromSeveralThreads) {
+  auto source = rtc::make_ref_counted<CountingBuffer>(64, 48);
+  rtc::scoped_refptr<CachingVideoFrameBuffer> buffer =
+      CachingVideoFrameBuffer::Create(source);
+  std::vector<rtc::PlatformThread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.push_back(rtc::PlatformThread::SpawnJoinable(
+        [buffer] { EXPECT_TRUE(buffer->ToI420()); }, "sink"));
+  }
+  threads.clear();
+  EXPECT_EQ(source->conversions(), 1);
+}
+
+TEST(CachingVideoFrameBufferTest, ScalesOncePerSize) {
+  auto source = rtc::make_ref_counted<CountingBuffer>(64, 48);
+  rtc::scoped_refptr<CachingVideoFrameBuffer> buffer =
+      CachingVideoFrameBuffer::Create(source);
+
+  rtc::scoped_refptr<VideoFrameBuffer> half = buffer->Scale(32, 24);
+  EXPECT_EQ(half->width(), 32);
+  EXPECT_EQ(buffer->Scale(32, 24), half);
+  EXPECT_EQ(source->scalings(), 1);
+
+  EXPECT_NE(buffer->Scale(16, 12), half);
+  EXPECT_EQ(source->scalings(), 2);
+
+  // Crops aren't cached.
+  buffer->CropAndScale(8, 8, 32, 24, 32, 24);
+  buffer->CropAndScale(8, 8, 32, 24, 32, 24);
+  EXPECT_EQ(source->scalings(), 4);
+}
+
+TEST(CachingVideoFrameBufferTest, MapsToWrappedOrConvertedBuffer) {
+  rtc::scoped_refptr<NV12Buffer> nv12 = NV12Buffer::Create(64, 48);
+  rtc::scoped_refptr<CachingVideoFrameBuffer> buffer =
+      CachingVideoFrameBuffer::Create(nv12);
+
+  VideoFrameBuffer::Type nv12_type = VideoFrameBuffer::Type::kNV12;
+  EXPECT_EQ(buffer->GetMappedFrameBuffer(rtc::MakeArrayView(&nv12_type, 1)),
+            nv12);
+
+  VideoFrameBuffer::Type i420_type = VideoFrameBuffer::Type::kI420;
+  EXPECT_EQ(buffer->GetMappedFrameBuffer(rtc::MakeArrayView(&i420_type, 1)),
+            nullptr);
+  rtc::scoped_refptr<I420BufferInterface> i420 = buffer->ToI420();
+  EXPECT_EQ(buffer->GetMappedFrameBuffer(rtc::MakeArrayView(&i420_type, 1)),
+            i420);
+}
+
+}  // namespace
+}  // namespace webrtc
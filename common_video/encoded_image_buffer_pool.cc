@@ -0,0 +1,86 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/include/encoded_image_buffer_pool.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/ref_counted_object.h"
+
+namespace webrtc {
+
+// EncodedImageBuffer that keeps its allocation when it shrinks. The size of
+// the allocation is tracked in `capacity_`, and the base class `size_` holds
+// the size of the current frame.
+class EncodedImageBufferPool::PooledBuffer : public EncodedImageBuffer {
+ public:
+  explicit PooledBuffer(size_t size)
+      : EncodedImageBuffer(size), capacity_(size) {}
+
+  size_t capacity() const { return capacity_; }
+
+  void SetSize(size_t size) {
+    if (size > capacity_) {
+      Realloc(size);
+      capacity_ = size;
+    }
+    size_ = size;
+  }
+
+ private:
+  size_t capacity_;
+};
+
+EncodedImageBufferPool::EncodedImageBufferPool()
+    : EncodedImageBufferPool(std::numeric_limits<size_t>::max()) {}
+
+EncodedImageBufferPool::EncodedImageBufferPool(size_t max_number_of_buffers)
+    : max_number_of_buffers_(max_number_of_buffers) {}
+
+EncodedImageBufferPool::~EncodedImageBufferPool() = default;
+
+rtc::scoped_refptr<EncodedImageBuffer> EncodedImageBufferPool::Create(
+    size_t size) {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  // Prefer a free buffer that is large enough, and otherwise grow the
+  // largest free buffer.
+  rtc::RefCountedObject<PooledBuffer>* free_buffer = nullptr;
+  for (const rtc::scoped_refptr<PooledBuffer>& buffer : buffers_) {
+    // Cast is safe because the pool only holds buffers created below.
+    auto* ref_counted =
+        static_cast<rtc::RefCountedObject<PooledBuffer>*>(buffer.get());
+    // If the ref count is 1, the pool holds the only reference and the
+    // buffer can be reused.
+    if (!ref_counted->HasOneRef())
+      continue;
+    if (!free_buffer || ref_counted->capacity() > free_buffer->capacity()) {
+      free_buffer = ref_counted;
+    }
+    if (free_buffer->capacity() >= size)
+      break;
+  }
+  if (free_buffer) {
+    free_buffer->SetSize(size);
+    return rtc::scoped_refptr<EncodedImageBuffer>(free_buffer);
+  }
+
+  if (buffers_.size() >= max_number_of_buffers_)
+    return EncodedImageBuffer::Create(size);
+
+  // Calling Realloc with size 0 isn't allowed, so allocate at least a byte.
+  rtc::scoped_refptr<PooledBuffer> buffer =
+      rtc::make_ref_counted<PooledBuffer>(std::max<size_t>(size, 1));
+  buffer->SetSize(size);
+  buffers_.push_back(buffer);
+  return buffer;
+}
+
+}  // namespace webrtc
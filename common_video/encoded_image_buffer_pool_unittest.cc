@@ -0,0 +1,84 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/include/encoded_image_buffer_pool.h"
+
+#include <string.h>
+
+#include "api/scoped_refptr.h"
+#include "api/video/encoded_image.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+TEST(EncodedImageBufferPoolTest, ReusesReleasedBuffer) {
+  EncodedImageBufferPool pool;
+  rtc::scoped_refptr<EncodedImageBuffer> buffer = pool.Create(1000);
+  EXPECT_EQ(buffer->size(), 1000u);
+  const uint8_t* data = buffer->data();
+  buffer = nullptr;
+
+  // A smaller frame reuses the allocation.
+  buffer = pool.Create(500);
+  EXPECT_EQ(buffer->size(), 500u);
+  EXPECT_EQ(buffer->data(), data);
+  buffer = nullptr;
+
+  // Using the buffer for a smaller frame didn't give back the allocation.
+  buffer = pool.Create(1000);
+  EXPECT_EQ(buffer->size(), 1000u);
+  EXPECT_EQ(buffer->data(), data);
+  EXPECT_EQ(pool.size(), 1u);
+}
+
+TEST(EncodedImageBufferPoolTest, DoesNotReuseBufferInUse) {
+  EncodedImageBufferPool pool;
+  rtc::scoped_refptr<EncodedImageBuffer> buffer1 = pool.Create(100);
+  rtc::scoped_refptr<EncodedImageBuffer> buffer2 = pool.Create(100);
+  EXPECT_NE(buffer1->data(), buffer2->data());
+  EXPECT_EQ(pool.size(), 2u);
+}
+
+TEST(EncodedImageBufferPoolTest, PrefersLargeEnoughBuffer) {
+  EncodedImageBufferPool pool;
+  rtc::scoped_refptr<EncodedImageBuffer> small = pool.Create(100);
+  rtc::scoped_refptr<EncodedImageBuffer> large = pool.Create(10000);
+  const uint8_t* large_data = large->data();
+  small = nullptr;
+  large = nullptr;
+
+  rtc::scoped_refptr<EncodedImageBuffer> buffer = pool.Create(5000);
+  EXPECT_EQ(buffer->data(), large_data);
+  // If no free buffer is large enough, a free buffer is grown.
+  rtc::scoped_refptr<EncodedImageBuffer> grown = pool.Create(20000);
+  EXPECT_EQ(grown->size(), 20000u);
+  memset(grown->data(), 0xA5, grown->size());
+}
+
+TEST(EncodedImageBufferPoolTest, AllocatesOutsidePoolWhenFull) {
+  EncodedImageBufferPool pool(/*max_number_of_buffers=*/1);
+  rtc::scoped_refptr<EncodedImageBuffer> buffer1 = pool.Create(100);
+  rtc::scoped_refptr<EncodedImageBuffer> buffer2 = pool.Create(100);
+  ASSERT_TRUE(buffer2);
+  EXPECT_EQ(buffer2->size(), 100u);
+  EXPECT_EQ(pool.size(), 1u);
+}
+
+TEST(EncodedImageBufferPoolTest, BufferValidAfterPoolDestruction) {
+  rtc::scoped_refptr<EncodedImageBuffer> buffer;
+  {
+    EncodedImageBufferPool pool;
+    buffer = pool.Create(100);
+  }
+  // Let ASAN find any issues if the buffer doesn't outlive the pool.
+  memset(buffer->data(), 0xA5, buffer->size());
+}
+
+}  // namespace webrtc
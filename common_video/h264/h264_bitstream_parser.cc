@@ -11,6 +11,7 @@
 
 #include <stdlib.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 
@@ -25,6 +26,32 @@ constexpr int kMaxAbsQpDeltaValue = 51;
 constexpr int kMinQpValue = 0;
 constexpr int kMaxQpValue = 51;
 
+// Slice headers are a few bytes long in practice. This leaves room for the
+// longest reference list modifications and weight tables, and saves
+// unescaping the whole slice data, which is most of a key frame, just to read
+// the QP.
+constexpr size_t kMaxSliceHeaderSize = 2048;
+
+bool EqualsNalu(const std::vector<uint8_t>& nalu,
+                const uint8_t* data,
+                size_t length) {
+  return nalu.size() == length && std::equal(nalu.begin(), nalu.end(), data);
+}
+
+// Whether ParseSlice() parses a NALU of this type as a slice.
+bool IsSlice(uint8_t nalu_header) {
+  switch (H264::ParseNaluType(nalu_header)) {
+    case H264::NaluType::kSps:
+    case H264::NaluType::kPps:
+    case H264::NaluType::kAud:
+    case H264::NaluType::kSei:
+    case H264::NaluType::kPrefix:
+      return false;
+    default:
+      return true;
+  }
+}
+
 }  // namespace
 
 H264BitstreamParser::H264BitstreamParser() = default;
@@ -39,7 +66,7 @@ H264BitstreamParser::Result H264BitstreamParser::ParseNonParameterSetNalu(
 
   last_slice_qp_delta_ = absl::nullopt;
   const std::vector<uint8_t> slice_rbsp =
-      H264::ParseRbsp(source, source_length);
+      H264::ParseRbsp(source, std::min(source_length, kMaxSliceHeaderSize));
   if (slice_rbsp.size() < H264::kNaluTypeSize)
     return kInvalidStream;
 
@@ -251,17 +278,28 @@ void H264BitstreamParser::ParseSlice(const uint8_t* slice, size_t length) {
   H264::NaluType nalu_type = H264::ParseNaluType(slice[0]);
   switch (nalu_type) {
     case H264::NaluType::kSps: {
+      // Encoders repeat the same SPS and PPS with every key frame.
+      if (sps_ && EqualsNalu(sps_nalu_, slice, length))
+        break;
       sps_ = SpsParser::ParseSps(slice + H264::kNaluTypeSize,
                                  length - H264::kNaluTypeSize);
-      if (!sps_)
+      if (sps_) {
+        sps_nalu_.assign(slice, slice + length);
+      } else {
         RTC_DLOG(LS_WARNING) << "Unable to parse SPS from H264 bitstream.";
+      }
       break;
     }
     case H264::NaluType::kPps: {
+      if (pps_ && EqualsNalu(pps_nalu_, slice, length))
+        break;
       pps_ = PpsParser::ParsePps(slice + H264::kNaluTypeSize,
                                  length - H264::kNaluTypeSize);
-      if (!pps_)
+      if (pps_) {
+        pps_nalu_.assign(slice, slice + length);
+      } else {
         RTC_DLOG(LS_WARNING) << "Unable to parse PPS from H264 bitstream.";
+      }
       break;
     }
     case H264::NaluType::kAud:
@@ -280,9 +318,20 @@ void H264BitstreamParser::ParseBitstream(
     rtc::ArrayView<const uint8_t> bitstream) {
   std::vector<H264::NaluIndex> nalu_indices =
       H264::FindNaluIndices(bitstream.data(), bitstream.size());
-  for (const H264::NaluIndex& index : nalu_indices)
-    ParseSlice(bitstream.data() + index.payload_start_offset,
-               index.payload_size);
+  // Every slice overwrites the QP of the one before, so only the header of
+  // the last slice needs parsing. Parameter sets are still parsed in order.
+  size_t last_slice = nalu_indices.size();
+  for (size_t i = 0; i < nalu_indices.size(); ++i) {
+    if (IsSlice(bitstream[nalu_indices[i].payload_start_offset]))
+      last_slice = i;
+  }
+  for (size_t i = 0; i < nalu_indices.size(); ++i) {
+    const uint8_t* nalu =
+        bitstream.data() + nalu_indices[i].payload_start_offset;
+    if (i != last_slice && IsSlice(nalu[0]))
+      continue;
+    ParseSlice(nalu, nalu_indices[i].payload_size);
+  }
 }
 
 absl::optional<int> H264BitstreamParser::GetLastSliceQp() const {
@@ -13,6 +13,8 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <vector>
+
 #include "absl/types/optional.h"
 #include "api/video_codecs/bitstream_parser.h"
 #include "common_video/h264/pps_parser.h"
@@ -48,6 +50,10 @@ class H264BitstreamParser : public BitstreamParser {
   // SPS/PPS state, updated when parsing new SPS/PPS, used to parse slices.
   absl::optional<SpsParser::SpsState> sps_;
   absl::optional<PpsParser::PpsState> pps_;
+  // The NALUs that `sps_` and `pps_` were parsed from, to skip parsing them
+  // again when they repeat.
+  std::vector<uint8_t> sps_nalu_;
+  std::vector<uint8_t> pps_nalu_;
 
   // Last parsed slice QP.
   absl::optional<int32_t> last_slice_qp_delta_;
@@ -10,6 +10,9 @@
 
 #include "common_video/h264/h264_bitstream_parser.h"
 
+#include <iterator>
+#include <vector>
+
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -81,4 +84,17 @@ TEST(H264BitstreamParserTest, ReportsLastSliceQpForCABACImageSlices) {
   EXPECT_EQ(24, *qp);
 }
 
+TEST(H264BitstreamParserTest, ReportsLastSliceQpForMultipleSlices) {
+  std::vector<uint8_t> bitstream(std::begin(kH264BitstreamChunk),
+                                 std::end(kH264BitstreamChunk));
+  bitstream.insert(bitstream.end(),
+                   std::begin(kH264BitstreamNextImageSliceChunk),
+                   std::end(kH264BitstreamNextImageSliceChunk));
+  H264BitstreamParser h264_parser;
+  h264_parser.ParseBitstream(bitstream);
+  absl::optional<int> qp = h264_parser.GetLastSliceQp();
+  ASSERT_TRUE(qp.has_value());
+  EXPECT_EQ(37, *qp);
+}
+
 }  // namespace webrtc
@@ -0,0 +1,123 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/h264/h264_common.h"
+
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+
+// Byte by byte reference implementations.
+std::vector<size_t> FindStartSequences(const std::vector<uint8_t>& buffer) {
+  std::vector<size_t> payload_offsets;
+  for (size_t i = 0; i + H264::kNaluShortStartSequenceSize < buffer.size();) {
+    if (buffer[i] == 0 && buffer[i + 1] == 0 && buffer[i + 2] == 1) {
+      payload_offsets.push_back(i + 3);
+      i += 3;
+    } else {
+      ++i;
+    }
+  }
+  return payload_offsets;
+}
+
+std::vector<uint8_t> RemoveEmulationBytes(const std::vector<uint8_t>& data) {
+  std::vector<uint8_t> out;
+  for (size_t i = 0; i < data.size();) {
+    if (data.size() - i >= 3 && data[i] == 0 && data[i + 1] == 0 &&
+        data[i + 2] == 3) {
+      out.push_back(0);
+      out.push_back(0);
+      i += 3;
+    } else {
+      out.push_back(data[i++]);
+    }
+  }
+  return out;
+}
+
+// Returns random data with many zeros, ones and threes.
+std::vector<uint8_t> CreateData(Random& random, size_t size) {
+  std::vector<uint8_t> data(size);
+  for (uint8_t& byte : data) {
+    switch (random.Rand(0, 7)) {
+      case 0:
+        byte = 1;
+        break;
+      case 1:
+        byte = 3;
+        break;
+      case 2:
+      case 3:
+      case 4:
+        byte = 0;
+        break;
+      default:
+        byte = random.Rand(0, 255);
+    }
+  }
+  return data;
+}
+
+TEST(H264CommonTest, FindsNaluIndices) {
+  const uint8_t kBuffer[] = {0, 0, 0, 1, 0x67, 0xaa, 0, 0, 1, 0x68,
+                             0, 0, 0, 1, 0x65, 0xbb, 0xcc};
+  std::vector<H264::NaluIndex> indices =
+      H264::FindNaluIndices(kBuffer, sizeof(kBuffer));
+  ASSERT_EQ(indices.size(), 3u);
+  EXPECT_EQ(indices[0].start_offset, 0u);
+  EXPECT_EQ(indices[0].payload_start_offset, 4u);
+  EXPECT_EQ(indices[0].payload_size, 2u);
+  EXPECT_EQ(indices[1].start_offset, 6u);
+  EXPECT_EQ(indices[1].payload_start_offset, 9u);
+  EXPECT_EQ(indices[1].payload_size, 1u);
+  EXPECT_EQ(indices[2].start_offset, 10u);
+  EXPECT_EQ(indices[2].payload_start_offset, 14u);
+  EXPECT_EQ(indices[2].payload_size, 3u);
+}
+
+TEST(H264CommonTest, FindsSameNaluIndicesAsByteByByteScan) {
+  Random random(123);
+  for (int i = 0; i < 1000; ++i) {
+    std::vector<uint8_t> buffer = CreateData(random, random.Rand(0, 100));
+    std::vector<size_t> payload_offsets;
+    for (const H264::NaluIndex& index :
+         H264::FindNaluIndices(buffer.data(), buffer.size())) {
+      payload_offsets.push_back(index.payload_start_offset);
+    }
+    EXPECT_THAT(payload_offsets, ElementsAreArray(FindStartSequences(buffer)));
+  }
+}
+
+TEST(H264CommonTest, RemovesEmulationBytes) {
+  const uint8_t kData[] = {0, 0, 3, 0, 0, 0, 3, 1, 0, 0, 3};
+  EXPECT_THAT(H264::ParseRbsp(kData, sizeof(kData)),
+              ElementsAre(0, 0, 0, 0, 0, 1, 0, 0));
+}
+
+TEST(H264CommonTest, RemovesSameEmulationBytesAsByteByByteScan) {
+  Random random(123);
+  for (int i = 0; i < 1000; ++i) {
+    std::vector<uint8_t> data = CreateData(random, random.Rand(0, 100));
+    EXPECT_EQ(H264::ParseRbsp(data.data(), data.size()),
+              RemoveEmulationBytes(data));
+  }
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,81 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_VIDEO_INCLUDE_CACHING_VIDEO_FRAME_BUFFER_H_
+#define COMMON_VIDEO_INCLUDE_CACHING_VIDEO_FRAME_BUFFER_H_
+
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/scoped_refptr.h"
+#include "api/video/video_frame_buffer.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Wraps a buffer whose conversion to I420 is costly, such as a native or NV12
+// buffer, so that a frame delivered to several sinks is converted only once.
+// The first ToI420() converts the wrapped buffer and later calls return the
+// same result. Likewise, scaling the whole frame to a size that was scaled to
+// before returns the earlier result.
+//
+// Thread safe. A sink that asks for a conversion that is in progress on
+// another thread waits for it instead of converting again.
+class CachingVideoFrameBuffer : public VideoFrameBuffer {
+ public:
+  static rtc::scoped_refptr<CachingVideoFrameBuffer> Create(
+      rtc::scoped_refptr<VideoFrameBuffer> buffer);
+
+  // The wrapped buffer is only reachable through GetMappedFrameBuffer(), so
+  // sinks that want it without a conversion must map it.
+  Type type() const override;
+  int width() const override;
+  int height() const override;
+  rtc::scoped_refptr<I420BufferInterface> ToI420() override;
+  // Returns the converted buffer once ToI420() has been called.
+  const I420BufferInterface* GetI420() const override;
+  rtc::scoped_refptr<VideoFrameBuffer> CropAndScale(int offset_x,
+                                                    int offset_y,
+                                                    int crop_width,
+                                                    int crop_height,
+                                                    int scaled_width,
+                                                    int scaled_height) override;
+  // Returns the wrapped buffer if it has one of `types`, the converted buffer
+  // if I420 is requested and ToI420() has been called, or else whatever the
+  // wrapped buffer maps to.
+  rtc::scoped_refptr<VideoFrameBuffer> GetMappedFrameBuffer(
+      rtc::ArrayView<Type> types) override;
+
+  const rtc::scoped_refptr<VideoFrameBuffer>& buffer() const {
+    return buffer_;
+  }
+
+ protected:
+  explicit CachingVideoFrameBuffer(rtc::scoped_refptr<VideoFrameBuffer> buffer);
+  ~CachingVideoFrameBuffer() override;
+
+ private:
+  struct ScaledBuffer {
+    int width;
+    int height;
+    rtc::scoped_refptr<VideoFrameBuffer> buffer;
+  };
+
+  const rtc::scoped_refptr<VideoFrameBuffer> buffer_;
+  // Held while converting, so that concurrent conversions wait for each other.
+  mutable Mutex mutex_;
+  rtc::scoped_refptr<I420BufferInterface> i420_ RTC_GUARDED_BY(mutex_);
+  std::vector<ScaledBuffer> scaled_ RTC_GUARDED_BY(mutex_);
+};
+
+}  // namespace webrtc
+
+#endif  // COMMON_VIDEO_INCLUDE_CACHING_VIDEO_FRAME_BUFFER_H_
@@ -0,0 +1,57 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_VIDEO_INCLUDE_ENCODED_IMAGE_BUFFER_POOL_H_
+#define COMMON_VIDEO_INCLUDE_ENCODED_IMAGE_BUFFER_POOL_H_
+
+#include <stddef.h>
+
+#include <limits>
+#include <vector>
+
+#include "api/scoped_refptr.h"
+#include "api/video/encoded_image.h"
+#include "rtc_base/race_checker.h"
+
+namespace webrtc {
+
+// Pool of EncodedImageBuffers, for assembling received frames without a
+// heap allocation per frame. A buffer returns to the pool when the last
+// reference outside of the pool is released, which may happen on any thread.
+// Released buffers keep their allocation, so a buffer that was used for a
+// large frame is reused for smaller ones without reallocating.
+class EncodedImageBufferPool {
+ public:
+  EncodedImageBufferPool();
+  explicit EncodedImageBufferPool(size_t max_number_of_buffers);
+  ~EncodedImageBufferPool();
+
+  // Returns a buffer of `size` bytes with undefined content. If all buffers
+  // of the pool are in use and the pool already holds
+  // `max_number_of_buffers`, a buffer that is not part of the pool is
+  // returned.
+  //
+  // Calling Realloc() on the returned buffer is not allowed.
+  rtc::scoped_refptr<EncodedImageBuffer> Create(size_t size);
+
+  // Returns the number of buffers held by the pool, in use or not.
+  size_t size() const { return buffers_.size(); }
+
+ private:
+  class PooledBuffer;
+
+  rtc::RaceChecker race_checker_;
+  std::vector<rtc::scoped_refptr<PooledBuffer>> buffers_;
+  const size_t max_number_of_buffers_;
+};
+
+}  // namespace webrtc
+
+#endif  // COMMON_VIDEO_INCLUDE_ENCODED_IMAGE_BUFFER_POOL_H_
@@ -29,8 +29,17 @@ class IncomingVideoStream : public rtc::VideoSinkInterface<VideoFrame> {
   IncomingVideoStream(TaskQueueFactory* task_queue_factory,
                       int32_t delay_ms,
                       rtc::VideoSinkInterface<VideoFrame>* callback);
+  // See VideoRenderFrames for `adaptive_scheduling`.
+  IncomingVideoStream(TaskQueueFactory* task_queue_factory,
+                      int32_t delay_ms,
+                      bool adaptive_scheduling,
+                      rtc::VideoSinkInterface<VideoFrame>* callback);
   ~IncomingVideoStream() override;
 
+  // Passes display refresh hints to the render queue, see
+  // VideoRenderFrames::SetVsync().
+  void SetVsync(int64_t vsync_time_ms, int64_t vsync_interval_ms);
+
  private:
   void OnFrame(const VideoFrame& video_frame) override;
   void Dequeue();
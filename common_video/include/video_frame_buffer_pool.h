@@ -14,15 +14,84 @@
 #include <stddef.h>
 
 #include <list>
+#include <map>
+#include <tuple>
+#include <vector>
 
 #include "api/scoped_refptr.h"
 #include "api/video/i420_buffer.h"
 #include "api/video/nv12_buffer.h"
 #include "rtc_base/race_checker.h"
 #include "rtc_base/ref_counted_object.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
 
+// Buffer pool shared by the VideoFrameBufferPools of many decoders, so that a
+// buffer returned by one stream can be reused by any other stream decoding at
+// the same resolution, instead of each decoder keeping its own idle buffers.
+// Buffers are kept in buckets by pixel format and resolution. The memory of
+// all buffers of the pool, in use or idle, is limited to `max_bytes`: when a
+// new buffer doesn't fit, idle buffers of the other buckets are freed, and if
+// that is not enough no buffer is returned. Thread safe.
+class SharedVideoFrameBufferPool {
+ public:
+  // Returns the pool of the process, or null unless enabled by the
+  // "WebRTC-SharedVideoFrameBufferPool" field trial, e.g.
+  // "WebRTC-SharedVideoFrameBufferPool/Enabled,max_mb:64/".
+  static SharedVideoFrameBufferPool* GetInstance();
+
+  explicit SharedVideoFrameBufferPool(size_t max_bytes);
+  ~SharedVideoFrameBufferPool();
+
+  SharedVideoFrameBufferPool(const SharedVideoFrameBufferPool&) = delete;
+  SharedVideoFrameBufferPool& operator=(const SharedVideoFrameBufferPool&) =
+      delete;
+
+  // Returns an idle buffer of the bucket, or a new one if there is none and
+  // the budget allows it. Returns null otherwise. See VideoFrameBufferPool for
+  // `zero_initialize`.
+  rtc::scoped_refptr<I420Buffer> CreateI420Buffer(int width,
+                                                  int height,
+                                                  bool zero_initialize);
+  rtc::scoped_refptr<NV12Buffer> CreateNV12Buffer(int width,
+                                                  int height,
+                                                  bool zero_initialize);
+
+  // Frees all idle buffers. Should be called when the system is low on
+  // memory.
+  void Trim();
+
+  // Memory of the buffers of the pool, in use or idle.
+  size_t allocated_bytes() const;
+
+ private:
+  struct BucketKey {
+    bool operator<(const BucketKey& other) const {
+      return std::tie(type, width, height, zero_initialize) <
+             std::tie(other.type, other.width, other.height,
+                      other.zero_initialize);
+    }
+    VideoFrameBuffer::Type type;
+    int width;
+    int height;
+    bool zero_initialize;
+  };
+  using Bucket = std::vector<rtc::scoped_refptr<VideoFrameBuffer>>;
+
+  template <typename BufferType>
+  rtc::scoped_refptr<BufferType> CreateBuffer(const BucketKey& key);
+  // Frees idle buffers until `buffer_bytes` more fit in the budget. Returns
+  // false if they don't.
+  bool MakeRoom(size_t buffer_bytes) RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  const size_t max_bytes_;
+  mutable Mutex mutex_;
+  std::map<BucketKey, Bucket> buckets_ RTC_GUARDED_BY(mutex_);
+  size_t allocated_bytes_ RTC_GUARDED_BY(mutex_) = 0;
+};
+
 // Simple buffer pool to avoid unnecessary allocations of video frame buffers.
 // The pool manages the memory of the I420Buffer/NV12Buffer returned from
 // Create(I420|NV12)Buffer. When the buffer is destructed, the memory is
@@ -32,11 +101,16 @@ namespace webrtc {
 // Note that Create(I420|NV12)Buffer will crash if more than
 // kMaxNumberOfFramesBeforeCrash are created. This is to prevent memory leaks
 // where frames are not returned.
+// If a `shared_pool` is given, the buffers are taken from it instead, and its
+// memory budget replaces `max_number_of_buffers`.
 class VideoFrameBufferPool {
  public:
   VideoFrameBufferPool();
   explicit VideoFrameBufferPool(bool zero_initialize);
   VideoFrameBufferPool(bool zero_initialize, size_t max_number_of_buffers);
+  VideoFrameBufferPool(bool zero_initialize,
+                       size_t max_number_of_buffers,
+                       SharedVideoFrameBufferPool* shared_pool);
   ~VideoFrameBufferPool();
 
   // Returns a buffer from the pool. If no suitable buffer exist in the pool
@@ -68,6 +142,7 @@ class VideoFrameBufferPool {
   const bool zero_initialize_;
   // Max number of buffers this pool can have pending.
   size_t max_number_of_buffers_;
+  SharedVideoFrameBufferPool* const shared_pool_;
 };
 
 }  // namespace webrtc
@@ -0,0 +1,80 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_VIDEO_INCLUDE_VIDEO_FRAME_BUFFER_PYRAMID_H_
+#define COMMON_VIDEO_INCLUDE_VIDEO_FRAME_BUFFER_PYRAMID_H_
+
+#include <memory>
+#include <vector>
+
+#include "api/scoped_refptr.h"
+#include "api/video/video_frame_buffer.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Downscaled versions of a frame buffer at a set of resolutions, such as the
+// resolutions of the layers of a simulcast stream. Each resolution is scaled
+// on first use, from the nearest larger resolution of the set rather than from
+// the source, which is scaled first when needed. So scaling a 1080p frame to
+// 540p and 270p reads the 1080p frame only once.
+//
+// Thread safe. Resolutions can be requested from several threads at once, in
+// which case a request waits for the larger resolution it is scaled from.
+class VideoFrameBufferPyramid {
+ public:
+  struct Resolution {
+    int width;
+    int height;
+  };
+
+  // Large I420 levels are scaled on up to `num_scaling_threads` threads.
+  VideoFrameBufferPyramid(rtc::scoped_refptr<VideoFrameBuffer> source,
+                          const std::vector<Resolution>& resolutions,
+                          int num_scaling_threads = 1);
+  ~VideoFrameBufferPyramid();
+
+  VideoFrameBufferPyramid(const VideoFrameBufferPyramid&) = delete;
+  VideoFrameBufferPyramid& operator=(const VideoFrameBufferPyramid&) = delete;
+
+  // Returns the source scaled to `width`x`height`, or the source itself if it
+  // has that resolution. Resolutions that are not in the set, or not smaller
+  // than the source, are scaled on every call. Returns null if scaling fails.
+  rtc::scoped_refptr<VideoFrameBuffer> GetScaled(int width, int height);
+
+ private:
+  struct Level {
+    Level(int width, int height) : width(width), height(height) {}
+
+    const int width;
+    const int height;
+    // Held while `buffer` is scaled. A level only takes the lock of a larger
+    // level while holding its own, so the locks can't deadlock.
+    Mutex mutex;
+    rtc::scoped_refptr<VideoFrameBuffer> buffer RTC_GUARDED_BY(mutex);
+  };
+
+  // Returns the smallest level larger than `width`x`height` in both
+  // dimensions, or null if there is none and the source should be scaled.
+  Level* FindLargerLevel(int width, int height) const;
+  rtc::scoped_refptr<VideoFrameBuffer> GetLevel(Level& level);
+  rtc::scoped_refptr<VideoFrameBuffer> ScaleFromLargerLevel(int width,
+                                                            int height);
+
+  const rtc::scoped_refptr<VideoFrameBuffer> source_;
+  const int num_scaling_threads_;
+  // Largest first.
+  std::vector<std::unique_ptr<Level>> levels_;
+};
+
+}  // namespace webrtc
+
+#endif  // COMMON_VIDEO_INCLUDE_VIDEO_FRAME_BUFFER_PYRAMID_H_
@@ -24,7 +24,17 @@ IncomingVideoStream::IncomingVideoStream(
     TaskQueueFactory* task_queue_factory,
     int32_t delay_ms,
     rtc::VideoSinkInterface<VideoFrame>* callback)
-    : render_buffers_(delay_ms),
+    : IncomingVideoStream(task_queue_factory,
+                          delay_ms,
+                          /*adaptive_scheduling=*/false,
+                          callback) {}
+
+IncomingVideoStream::IncomingVideoStream(
+    TaskQueueFactory* task_queue_factory,
+    int32_t delay_ms,
+    bool adaptive_scheduling,
+    rtc::VideoSinkInterface<VideoFrame>* callback)
+    : render_buffers_(delay_ms, adaptive_scheduling),
       callback_(callback),
       incoming_render_queue_(task_queue_factory->CreateTaskQueue(
           "IncomingVideoStream",
@@ -48,6 +58,14 @@ void IncomingVideoStream::OnFrame(const VideoFrame& video_frame) {
   });
 }
 
+void IncomingVideoStream::SetVsync(int64_t vsync_time_ms,
+                                   int64_t vsync_interval_ms) {
+  incoming_render_queue_.PostTask([this, vsync_time_ms, vsync_interval_ms]() {
+    RTC_DCHECK_RUN_ON(&incoming_render_queue_);
+    render_buffers_.SetVsync(vsync_time_ms, vsync_interval_ms);
+  });
+}
+
 void IncomingVideoStream::Dequeue() {
   TRACE_EVENT0("webrtc", "IncomingVideoStream::Dequeue");
   RTC_DCHECK_RUN_ON(&incoming_render_queue_);
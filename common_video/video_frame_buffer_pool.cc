@@ -13,10 +13,16 @@
 #include <limits>
 
 #include "rtc_base/checks.h"
+#include "rtc_base/experiments/field_trial_parser.h"
+#include "rtc_base/logging.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 
 namespace {
+
+constexpr char kSharedPoolFieldTrial[] = "WebRTC-SharedVideoFrameBufferPool";
+
 bool HasOneRef(const rtc::scoped_refptr<VideoFrameBuffer>& buffer) {
   // Cast to rtc::RefCountedObject is safe because this function is only called
   // on locally created VideoFrameBuffers, which are either
@@ -36,8 +42,141 @@ bool HasOneRef(const rtc::scoped_refptr<VideoFrameBuffer>& buffer) {
   return false;
 }
 
+// Size of the buffers allocated by I420Buffer and NV12Buffer, which have the
+// same default strides.
+size_t BufferBytes(int width, int height) {
+  const size_t chroma_width = (width + 1) / 2;
+  const size_t chroma_height = (height + 1) / 2;
+  return static_cast<size_t>(width) * height +
+         2 * chroma_width * chroma_height;
+}
+
+SharedVideoFrameBufferPool* CreateSharedPoolFromFieldTrial() {
+  FieldTrialFlag enabled("Enabled");
+  FieldTrialParameter<int> max_mb("max_mb", 64);
+  ParseFieldTrial({&enabled, &max_mb},
+                  field_trial::FindFullName(kSharedPoolFieldTrial));
+  if (!enabled)
+    return nullptr;
+  if (max_mb.Get() <= 0) {
+    RTC_LOG(LS_WARNING) << "Invalid shared video frame buffer pool size "
+                        << max_mb.Get() << " MB.";
+    return nullptr;
+  }
+  return new SharedVideoFrameBufferPool(static_cast<size_t>(max_mb.Get())
+                                        << 20);
+}
+
 }  // namespace
 
+// static
+SharedVideoFrameBufferPool* SharedVideoFrameBufferPool::GetInstance() {
+  static SharedVideoFrameBufferPool* const pool =
+      CreateSharedPoolFromFieldTrial();
+  return pool;
+}
+
+SharedVideoFrameBufferPool::SharedVideoFrameBufferPool(size_t max_bytes)
+    : max_bytes_(max_bytes) {}
+
+SharedVideoFrameBufferPool::~SharedVideoFrameBufferPool() = default;
+
+rtc::scoped_refptr<I420Buffer> SharedVideoFrameBufferPool::CreateI420Buffer(
+    int width,
+    int height,
+    bool zero_initialize) {
+  return CreateBuffer<I420Buffer>(
+      {VideoFrameBuffer::Type::kI420, width, height, zero_initialize});
+}
+
+rtc::scoped_refptr<NV12Buffer> SharedVideoFrameBufferPool::CreateNV12Buffer(
+    int width,
+    int height,
+    bool zero_initialize) {
+  return CreateBuffer<NV12Buffer>(
+      {VideoFrameBuffer::Type::kNV12, width, height, zero_initialize});
+}
+
+void SharedVideoFrameBufferPool::Trim() {
+  MutexLock lock(&mutex_);
+  for (auto bucket_it = buckets_.begin(); bucket_it != buckets_.end();) {
+    const BucketKey& key = bucket_it->first;
+    Bucket& bucket = bucket_it->second;
+    const size_t buffer_bytes = BufferBytes(key.width, key.height);
+    for (auto it = bucket.begin(); it != bucket.end();) {
+      if (HasOneRef(*it)) {
+        it = bucket.erase(it);
+        allocated_bytes_ -= buffer_bytes;
+      } else {
+        ++it;
+      }
+    }
+    if (bucket.empty()) {
+      bucket_it = buckets_.erase(bucket_it);
+    } else {
+      ++bucket_it;
+    }
+  }
+}
+
+size_t SharedVideoFrameBufferPool::allocated_bytes() const {
+  MutexLock lock(&mutex_);
+  return allocated_bytes_;
+}
+
+template <typename BufferType>
+rtc::scoped_refptr<BufferType> SharedVideoFrameBufferPool::CreateBuffer(
+    const BucketKey& key) {
+  MutexLock lock(&mutex_);
+  Bucket& bucket = buckets_[key];
+  for (const rtc::scoped_refptr<VideoFrameBuffer>& buffer : bucket) {
+    // The buffer is idle if the bucket holds the only reference. Once idle, no
+    // one else can take a reference but the pool, so it is safe to reuse.
+    if (HasOneRef(buffer)) {
+      // Cast is safe because the buckets only hold buffers created below,
+      // and the type is part of the key.
+      return rtc::scoped_refptr<BufferType>(
+          static_cast<rtc::RefCountedObject<BufferType>*>(buffer.get()));
+    }
+  }
+
+  // The bucket has no idle buffers, so MakeRoom() only frees buffers of the
+  // other buckets.
+  const size_t buffer_bytes = BufferBytes(key.width, key.height);
+  if (!MakeRoom(buffer_bytes)) {
+    RTC_LOG(LS_WARNING) << "Shared video frame buffer pool is out of memory, "
+                        << allocated_bytes_ << " bytes in use.";
+    return nullptr;
+  }
+  rtc::scoped_refptr<BufferType> buffer =
+      rtc::make_ref_counted<BufferType>(key.width, key.height);
+  if (key.zero_initialize)
+    buffer->InitializeData();
+  bucket.push_back(buffer);
+  allocated_bytes_ += buffer_bytes;
+  return buffer;
+}
+
+bool SharedVideoFrameBufferPool::MakeRoom(size_t buffer_bytes) {
+  for (auto& key_and_bucket : buckets_) {
+    if (allocated_bytes_ + buffer_bytes <= max_bytes_)
+      return true;
+    const BucketKey& key = key_and_bucket.first;
+    Bucket& bucket = key_and_bucket.second;
+    const size_t bytes = BufferBytes(key.width, key.height);
+    for (auto it = bucket.begin();
+         it != bucket.end() && allocated_bytes_ + buffer_bytes > max_bytes_;) {
+      if (HasOneRef(*it)) {
+        it = bucket.erase(it);
+        allocated_bytes_ -= bytes;
+      } else {
+        ++it;
+      }
+    }
+  }
+  return allocated_bytes_ + buffer_bytes <= max_bytes_;
+}
+
 VideoFrameBufferPool::VideoFrameBufferPool() : VideoFrameBufferPool(false) {}
 
 VideoFrameBufferPool::VideoFrameBufferPool(bool zero_initialize)
@@ -46,8 +185,17 @@ VideoFrameBufferPool::VideoFrameBufferPool(bool zero_initialize)
 
 VideoFrameBufferPool::VideoFrameBufferPool(bool zero_initialize,
                                            size_t max_number_of_buffers)
+    : VideoFrameBufferPool(zero_initialize,
+                           max_number_of_buffers,
+                           /*shared_pool=*/nullptr) {}
+
+VideoFrameBufferPool::VideoFrameBufferPool(
+    bool zero_initialize,
+    size_t max_number_of_buffers,
+    SharedVideoFrameBufferPool* shared_pool)
     : zero_initialize_(zero_initialize),
-      max_number_of_buffers_(max_number_of_buffers) {}
+      max_number_of_buffers_(max_number_of_buffers),
+      shared_pool_(shared_pool) {}
 
 VideoFrameBufferPool::~VideoFrameBufferPool() = default;
 
@@ -57,6 +205,11 @@ void VideoFrameBufferPool::Release() {
 
 bool VideoFrameBufferPool::Resize(size_t max_number_of_buffers) {
   RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  if (shared_pool_) {
+    // The memory budget of the shared pool limits the buffers instead.
+    max_number_of_buffers_ = max_number_of_buffers;
+    return true;
+  }
   size_t used_buffers_count = 0;
   for (const rtc::scoped_refptr<VideoFrameBuffer>& buffer : buffers_) {
     // If the buffer is in use, the ref count will be >= 2, one from the list we
@@ -89,6 +242,8 @@ rtc::scoped_refptr<I420Buffer> VideoFrameBufferPool::CreateI420Buffer(
     int width,
     int height) {
   RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  if (shared_pool_)
+    return shared_pool_->CreateI420Buffer(width, height, zero_initialize_);
 
   rtc::scoped_refptr<VideoFrameBuffer> existing_buffer =
       GetExistingBuffer(width, height, VideoFrameBuffer::Type::kI420);
@@ -120,6 +275,8 @@ rtc::scoped_refptr<NV12Buffer> VideoFrameBufferPool::CreateNV12Buffer(
     int width,
     int height) {
   RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  if (shared_pool_)
+    return shared_pool_->CreateNV12Buffer(width, height, zero_initialize_);
 
   rtc::scoped_refptr<VideoFrameBuffer> existing_buffer =
       GetExistingBuffer(width, height, VideoFrameBuffer::Type::kNV12);
@@ -88,4 +88,67 @@ TEST(TestVideoFrameBufferPool, SwitchingPixelFormat) {
   EXPECT_EQ(nullptr, pool.CreateI420Buffer(16, 16).get());
 }
 
+// Memory of a 16x16 buffer, I420 or NV12.
+constexpr size_t kBufferBytes16x16 = 16 * 16 + 2 * 8 * 8;
+
+TEST(TestSharedVideoFrameBufferPool, ReusesBuffersAcrossPools) {
+  SharedVideoFrameBufferPool shared_pool(/*max_bytes=*/1 << 20);
+  VideoFrameBufferPool pool1(false, 1, &shared_pool);
+  VideoFrameBufferPool pool2(false, 1, &shared_pool);
+  auto buffer = pool1.CreateI420Buffer(16, 16);
+  const uint8_t* y_ptr = buffer->DataY();
+  buffer = nullptr;
+  buffer = pool2.CreateI420Buffer(16, 16);
+  EXPECT_EQ(y_ptr, buffer->DataY());
+  EXPECT_EQ(kBufferBytes16x16, shared_pool.allocated_bytes());
+}
+
+TEST(TestSharedVideoFrameBufferPool, KeepsBucketsByFormatAndResolution) {
+  SharedVideoFrameBufferPool shared_pool(/*max_bytes=*/1 << 20);
+  VideoFrameBufferPool pool(false, 1, &shared_pool);
+  auto i420_buffer = pool.CreateI420Buffer(16, 16);
+  const uint8_t* y_ptr = i420_buffer->DataY();
+  i420_buffer = nullptr;
+  auto nv12_buffer = pool.CreateNV12Buffer(16, 16);
+  auto wide_buffer = pool.CreateI420Buffer(32, 16);
+  // The idle buffer is not freed by the other resolutions.
+  i420_buffer = pool.CreateI420Buffer(16, 16);
+  EXPECT_EQ(y_ptr, i420_buffer->DataY());
+}
+
+TEST(TestSharedVideoFrameBufferPool, LimitsMemoryOfBuffersInUse) {
+  SharedVideoFrameBufferPool shared_pool(2 * kBufferBytes16x16);
+  VideoFrameBufferPool pool(false, 1, &shared_pool);
+  auto buffer1 = pool.CreateI420Buffer(16, 16);
+  auto buffer2 = pool.CreateI420Buffer(16, 16);
+  EXPECT_NE(nullptr, buffer1.get());
+  EXPECT_NE(nullptr, buffer2.get());
+  EXPECT_EQ(nullptr, pool.CreateI420Buffer(16, 16).get());
+  buffer1 = nullptr;
+  EXPECT_NE(nullptr, pool.CreateI420Buffer(16, 16).get());
+}
+
+TEST(TestSharedVideoFrameBufferPool, FreesIdleBuffersToMakeRoom) {
+  SharedVideoFrameBufferPool shared_pool(kBufferBytes16x16);
+  VideoFrameBufferPool pool(false, 1, &shared_pool);
+  EXPECT_NE(nullptr, pool.CreateI420Buffer(16, 16).get());
+  auto buffer = pool.CreateNV12Buffer(16, 16);
+  EXPECT_NE(nullptr, buffer.get());
+  EXPECT_EQ(kBufferBytes16x16, shared_pool.allocated_bytes());
+}
+
+TEST(TestSharedVideoFrameBufferPool, TrimFreesOnlyIdleBuffers) {
+  SharedVideoFrameBufferPool shared_pool(/*max_bytes=*/1 << 20);
+  VideoFrameBufferPool pool(false, 1, &shared_pool);
+  auto buffer = pool.CreateI420Buffer(16, 16);
+  pool.CreateI420Buffer(16, 16);
+  pool.CreateNV12Buffer(16, 16);
+  EXPECT_EQ(3 * kBufferBytes16x16, shared_pool.allocated_bytes());
+  shared_pool.Trim();
+  EXPECT_EQ(kBufferBytes16x16, shared_pool.allocated_bytes());
+  buffer = nullptr;
+  shared_pool.Trim();
+  EXPECT_EQ(0u, shared_pool.allocated_bytes());
+}
+
 }  // namespace webrtc
@@ -0,0 +1,108 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/include/video_frame_buffer_pyramid.h"
+
+#include <utility>
+
+#include "absl/algorithm/container.h"
+#include "api/video/i420_buffer.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+VideoFrameBufferPyramid::VideoFrameBufferPyramid(
+    rtc::scoped_refptr<VideoFrameBuffer> source,
+    const std::vector<Resolution>& resolutions,
+    int num_scaling_threads)
+    : source_(std::move(source)), num_scaling_threads_(num_scaling_threads) {
+  RTC_DCHECK(source_);
+  RTC_DCHECK_GE(num_scaling_threads_, 1);
+  for (const Resolution& resolution : resolutions) {
+    // Only downscaled levels are cascaded. Others are scaled from the source.
+    if (resolution.width > source_->width() ||
+        resolution.height > source_->height() ||
+        (resolution.width == source_->width() &&
+         resolution.height == source_->height())) {
+      continue;
+    }
+    if (absl::c_any_of(levels_, [&](const std::unique_ptr<Level>& level) {
+          return level->width == resolution.width &&
+                 level->height == resolution.height;
+        })) {
+      continue;
+    }
+    levels_.push_back(
+        std::make_unique<Level>(resolution.width, resolution.height));
+  }
+  absl::c_sort(levels_, [](const std::unique_ptr<Level>& a,
+                           const std::unique_ptr<Level>& b) {
+    return a->width * a->height > b->width * b->height;
+  });
+}
+
+VideoFrameBufferPyramid::~VideoFrameBufferPyramid() = default;
+
+rtc::scoped_refptr<VideoFrameBuffer> VideoFrameBufferPyramid::GetScaled(
+    int width,
+    int height) {
+  if (width == source_->width() && height == source_->height()) {
+    return source_;
+  }
+  for (const std::unique_ptr<Level>& level : levels_) {
+    if (level->width == width && level->height == height) {
+      return GetLevel(*level);
+    }
+  }
+  return ScaleFromLargerLevel(width, height);
+}
+
+VideoFrameBufferPyramid::Level* VideoFrameBufferPyramid::FindLargerLevel(
+    int width,
+    int height) const {
+  // A larger level has a larger area, so it comes earlier in `levels_`.
+  for (auto it = levels_.rbegin(); it != levels_.rend(); ++it) {
+    Level& level = **it;
+    if (level.width >= width && level.height >= height &&
+        (level.width > width || level.height > height)) {
+      return &level;
+    }
+  }
+  return nullptr;
+}
+
+rtc::scoped_refptr<VideoFrameBuffer> VideoFrameBufferPyramid::GetLevel(
+    Level& level) {
+  MutexLock lock(&level.mutex);
+  if (!level.buffer) {
+    level.buffer = ScaleFromLargerLevel(level.width, level.height);
+  }
+  return level.buffer;
+}
+
+rtc::scoped_refptr<VideoFrameBuffer>
+VideoFrameBufferPyramid::ScaleFromLargerLevel(int width, int height) {
+  Level* larger_level = FindLargerLevel(width, height);
+  rtc::scoped_refptr<VideoFrameBuffer> larger =
+      larger_level ? GetLevel(*larger_level) : source_;
+  if (!larger) {
+    return nullptr;
+  }
+  if (larger->type() == VideoFrameBuffer::Type::kI420 &&
+      num_scaling_threads_ > 1) {
+    rtc::scoped_refptr<I420Buffer> scaled = I420Buffer::Create(width, height);
+    scaled->CropAndScaleFrom(*larger->GetI420(), 0, 0, larger->width(),
+                             larger->height(), num_scaling_threads_);
+    return scaled;
+  }
+  return larger->Scale(width, height);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,106 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/include/video_frame_buffer_pyramid.h"
+
+#include <string>
+#include <vector>
+
+#include "api/scoped_refptr.h"
+#include "api/video/i420_buffer.h"
+#include "api/video/video_frame_buffer.h"
+#include "rtc_base/ref_counted_object.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+using Resolution = VideoFrameBufferPyramid::Resolution;
+
+// Records every scaling as "<from width>-><to width>".
+class FakeBuffer : public VideoFrameBuffer {
+ public:
+  FakeBuffer(int width, int height, std::vector<std::string>* scalings)
+      : width_(width), height_(height), scalings_(scalings) {}
+
+  Type type() const override { return Type::kNative; }
+  int width() const override { return width_; }
+  int height() const override { return height_; }
+  rtc::scoped_refptr<I420BufferInterface> ToI420() override {
+    return I420Buffer::Create(width_, height_);
+  }
+  rtc::scoped_refptr<VideoFrameBuffer> CropAndScale(
+      int offset_x,
+      int offset_y,
+      int crop_width,
+      int crop_height,
+      int scaled_width,
+      int scaled_height) override {
+    scalings_->push_back(std::to_string(width_) + "->" +
+                         std::to_string(scaled_width));
+    return rtc::make_ref_counted<FakeBuffer>(scaled_width, scaled_height,
+                                             scalings_);
+  }
+
+ private:
+  const int width_;
+  const int height_;
+  std::vector<std::string>* const scalings_;
+};
+
+TEST(VideoFrameBufferPyramidTest, ReturnsSourceAtItsResolution) {
+  std::vector<std::string> scalings;
+  auto source = rtc::make_ref_counted<FakeBuffer>(1280, 720, &scalings);
+  VideoFrameBufferPyramid pyramid(source, {{1280, 720}, {640, 360}});
+  EXPECT_EQ(pyramid.GetScaled(1280, 720), source);
+  EXPECT_TRUE(scalings.empty());
+}
+
+TEST(VideoFrameBufferPyramidTest, ScalesEachLevelOnce) {
+  std::vector<std::string> scalings;
+  auto source = rtc::make_ref_counted<FakeBuffer>(1280, 720, &scalings);
+  VideoFrameBufferPyramid pyramid(source, {{640, 360}});
+  rtc::scoped_refptr<VideoFrameBuffer> scaled = pyramid.GetScaled(640, 360);
+  ASSERT_TRUE(scaled);
+  EXPECT_EQ(scaled->width(), 640);
+  EXPECT_EQ(scaled->height(), 360);
+  EXPECT_EQ(pyramid.GetScaled(640, 360), scaled);
+  EXPECT_THAT(scalings, ElementsAre("1280->640"));
+}
+
+TEST(VideoFrameBufferPyramidTest, CascadesFromNearestLargerLevel) {
+  std::vector<std::string> scalings;
+  auto source = rtc::make_ref_counted<FakeBuffer>(1280, 720, &scalings);
+  VideoFrameBufferPyramid pyramid(source, {{320, 180}, {640, 360}});
+  // The smallest level is requested first, and scales the larger level it
+  // cascades from on the way.
+  EXPECT_EQ(pyramid.GetScaled(320, 180)->width(), 320);
+  EXPECT_EQ(pyramid.GetScaled(640, 360)->width(), 640);
+  EXPECT_THAT(scalings, ElementsAre("1280->640", "640->320"));
+}
+
+TEST(VideoFrameBufferPyramidTest, ScalesOtherResolutionsFromSource) {
+  std::vector<std::string> scalings;
+  auto source = rtc::make_ref_counted<FakeBuffer>(640, 360, &scalings);
+  VideoFrameBufferPyramid pyramid(source, {{1280, 720}, {320, 180}});
+  // Not cascaded from the upscaled level.
+  EXPECT_EQ(pyramid.GetScaled(320, 180)->width(), 320);
+  EXPECT_EQ(pyramid.GetScaled(1280, 720)->width(), 1280);
+  EXPECT_EQ(pyramid.GetScaled(1280, 720)->width(), 1280);
+  // Not in the set, so scaled from the nearest larger level.
+  EXPECT_EQ(pyramid.GetScaled(160, 90)->width(), 160);
+  EXPECT_THAT(scalings,
+              ElementsAre("640->320", "640->1280", "640->1280", "320->160"));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -327,6 +327,33 @@ TEST(TestVideoFrame, ShallowCopy) {
   EXPECT_NE(frame2.rotation(), frame1.rotation());
 }
 
+TEST(TestVideoFrame, CopiesShareColorSpaceUntilSet) {
+  const ColorSpace kColorSpace(
+      ColorSpace::PrimaryID::kBT709, ColorSpace::TransferID::kBT709,
+      ColorSpace::MatrixID::kBT709, ColorSpace::RangeID::kLimited);
+  VideoFrame frame1 = VideoFrame::Builder()
+                          .set_video_frame_buffer(I420Buffer::Create(16, 16))
+                          .set_color_space(kColorSpace)
+                          .set_timestamp_us(0)
+                          .build();
+  VideoFrame frame2(frame1);
+  ASSERT_TRUE(frame2.color_space());
+  EXPECT_EQ(*frame2.color_space(), kColorSpace);
+  EXPECT_EQ(&frame2.color_space(), &frame1.color_space());
+
+  frame2.set_color_space(absl::nullopt);
+  EXPECT_FALSE(frame2.color_space());
+  ASSERT_TRUE(frame1.color_space());
+  EXPECT_EQ(*frame1.color_space(), kColorSpace);
+
+  const ColorSpace full_range(
+      ColorSpace::PrimaryID::kBT709, ColorSpace::TransferID::kBT709,
+      ColorSpace::MatrixID::kBT709, ColorSpace::RangeID::kFull);
+  frame2.set_color_space(full_range);
+  EXPECT_EQ(*frame2.color_space(), full_range);
+  EXPECT_EQ(*frame1.color_space(), kColorSpace);
+}
+
 TEST(TestVideoFrame, TextureInitialValues) {
   VideoFrame frame = test::FakeNativeBuffer::CreateFrame(
       640, 480, 100, 10, webrtc::kVideoRotation_0);
@@ -469,6 +496,49 @@ TEST(TestNV12Buffer, CropAndScale) {
             kRelativeHeight);
 }
 
+// Scales `src` cropped to `crop_width`x`crop_height` at (`offset_x`, `offset_y`)
+// to `width`x`height`, on one thread and on four, and expects the same result.
+void CheckCropAndScaleOnThreads(const I420BufferInterface& src,
+                                int offset_x,
+                                int offset_y,
+                                int crop_width,
+                                int crop_height,
+                                int width,
+                                int height) {
+  rtc::scoped_refptr<I420Buffer> expected = I420Buffer::Create(width, height);
+  expected->CropAndScaleFrom(src, offset_x, offset_y, crop_width, crop_height);
+  rtc::scoped_refptr<I420Buffer> scaled = I420Buffer::Create(width, height);
+  scaled->CropAndScaleFrom(src, offset_x, offset_y, crop_width, crop_height,
+                           /*num_threads=*/4);
+  EXPECT_TRUE(test::FrameBufsEqual(expected, scaled));
+}
+
+TEST(TestI420Buffer, CropAndScaleOnThreadsMatchesOneThread) {
+  rtc::scoped_refptr<I420Buffer> src = I420Buffer::Create(3840, 2160);
+  // Noise, so that differences at the edges of the stripes show.
+  uint32_t random = 1;
+  for (uint8_t* plane : {src->MutableDataY(), src->MutableDataU(),
+                         src->MutableDataV()}) {
+    const int size = plane == src->MutableDataY()
+                         ? src->StrideY() * src->height()
+                         : src->StrideU() * src->ChromaHeight();
+    for (int i = 0; i < size; ++i) {
+      random = random * 1103515245 + 12345;
+      plane[i] = random >> 24;
+    }
+  }
+
+  CheckCropAndScaleOnThreads(*src, 0, 0, 3840, 2160, 1920, 1080);
+  CheckCropAndScaleOnThreads(*src, 0, 0, 3840, 2160, 2560, 1440);
+  CheckCropAndScaleOnThreads(*src, 0, 0, 3840, 2160, 1280, 720);
+  CheckCropAndScaleOnThreads(*src, 40, 30, 3760, 2100, 1880, 1050);
+  // Not split, since the scaling steps aren't exact.
+  CheckCropAndScaleOnThreads(*src, 0, 0, 3840, 2160, 1600, 900);
+  CheckCropAndScaleOnThreads(*src, 0, 0, 1920, 1080, 3840, 2160);
+  // Too small to be split.
+  CheckCropAndScaleOnThreads(*src, 0, 0, 1280, 720, 640, 360);
+}
+
 class TestPlanarYuvBufferRotate
     : public ::testing::TestWithParam<
           std::tuple<webrtc::VideoRotation, VideoFrameBuffer::Type>> {};
@@ -622,6 +692,15 @@ TEST(TestUpdateRectScale, CropInsideUpdate) {
   EXPECT_EQ(scaled, VideoFrame::UpdateRect({0, 0, 10, 10}));
 }
 
+TEST(TestUpdateRectScale, EmptyUpdateStaysEmptyWhenScaled) {
+  const int width = 640;
+  const int height = 480;
+  VideoFrame::UpdateRect a = {0, 0, 0, 0};
+  VideoFrame::UpdateRect scaled = a.ScaleWithFrame(
+      width, height, 0, 0, width, height, width / 2, height / 2);
+  EXPECT_TRUE(scaled.IsEmpty());
+}
+
 TEST(TestUpdateRectScale, CropAndScaleByHalf) {
   const int width = 640;
   const int height = 480;
@@ -10,6 +10,8 @@
 
 #include "common_video/video_render_frames.h"
 
+#include <algorithm>
+#include <cstdlib>
 #include <type_traits>
 #include <utility>
 
@@ -30,15 +32,43 @@ const uint32_t kMinRenderDelayMs = 10;
 const uint32_t kMaxRenderDelayMs = 500;
 const size_t kMaxIncomingFramesBeforeLogged = 100;
 
+// Adaptive scheduling.
+constexpr int64_t kRtpTicksPerMs = 90;
+// Frames whose RTP time is within this of the newest frame's are used to
+// measure the arrival jitter.
+constexpr int64_t kJitterWindowMs = 2000;
+// Most delay added to absorb jitter.
+constexpr int64_t kMaxJitterDelayMs = 200;
+// Arrival offsets changing more than this are a discontinuity, e.g. a paused
+// stream, rather than jitter.
+constexpr int64_t kMaxOffsetChangeMs = 1000;
+// When the jitter goes down, the delay is reduced by at most this per frame,
+// so that frames aren't released in a burst.
+constexpr int64_t kMaxDelayReductionPerFrameMs = 1;
+
 uint32_t EnsureValidRenderDelay(uint32_t render_delay) {
   return (render_delay < kMinRenderDelayMs || render_delay > kMaxRenderDelayMs)
              ? kMinRenderDelayMs
              : render_delay;
 }
+
+// Rounds `value` up to a multiple of `interval`.
+int64_t RoundUpToMultiple(int64_t value, int64_t interval) {
+  int64_t remainder = value % interval;
+  if (remainder < 0) {
+    remainder += interval;
+  }
+  return remainder == 0 ? value : value - remainder + interval;
+}
 }  // namespace
 
 VideoRenderFrames::VideoRenderFrames(uint32_t render_delay_ms)
-    : render_delay_ms_(EnsureValidRenderDelay(render_delay_ms)) {}
+    : VideoRenderFrames(render_delay_ms, /*adaptive_scheduling=*/false) {}
+
+VideoRenderFrames::VideoRenderFrames(uint32_t render_delay_ms,
+                                     bool adaptive_scheduling)
+    : render_delay_ms_(EnsureValidRenderDelay(render_delay_ms)),
+      adaptive_scheduling_(adaptive_scheduling) {}
 
 VideoRenderFrames::~VideoRenderFrames() {
   frames_dropped_ += incoming_frames_.size();
@@ -51,6 +81,13 @@ VideoRenderFrames::~VideoRenderFrames() {
 int32_t VideoRenderFrames::AddFrame(VideoFrame&& new_frame) {
   const int64_t time_now = rtc::TimeMillis();
 
+  if (adaptive_scheduling_) {
+    // The render time isn't used, so it doesn't need checking.
+    const int64_t release_time_ms = AdaptiveReleaseTime(new_frame, time_now);
+    incoming_frames_.push_back({std::move(new_frame), release_time_ms});
+    return static_cast<int32_t>(incoming_frames_.size());
+  }
+
   // Drop old frames only when there are other frames in the queue, otherwise, a
   // really slow system never renders any frames.
   if (!incoming_frames_.empty() &&
@@ -78,7 +115,8 @@ int32_t VideoRenderFrames::AddFrame(VideoFrame&& new_frame) {
   }
 
   last_render_time_ms_ = new_frame.render_time_ms();
-  incoming_frames_.emplace_back(std::move(new_frame));
+  incoming_frames_.push_back(
+      {std::move(new_frame), last_render_time_ms_ - render_delay_ms_});
 
   if (incoming_frames_.size() > kMaxIncomingFramesBeforeLogged) {
     RTC_LOG(LS_WARNING) << "Stored incoming frames: "
@@ -94,7 +132,7 @@ absl::optional<VideoFrame> VideoRenderFrames::FrameToRender() {
     if (render_frame) {
       ++frames_dropped_;
     }
-    render_frame = std::move(incoming_frames_.front());
+    render_frame = std::move(incoming_frames_.front().frame);
     incoming_frames_.pop_front();
   }
   return render_frame;
@@ -104,8 +142,8 @@ uint32_t VideoRenderFrames::TimeToNextFrameRelease() {
   if (incoming_frames_.empty()) {
     return kEventMaxWaitTimeMs;
   }
-  const int64_t time_to_release = incoming_frames_.front().render_time_ms() -
-                                  render_delay_ms_ - rtc::TimeMillis();
+  const int64_t time_to_release =
+      incoming_frames_.front().release_time_ms - rtc::TimeMillis();
   return time_to_release < 0 ? 0u : static_cast<uint32_t>(time_to_release);
 }
 
@@ -113,4 +151,66 @@ bool VideoRenderFrames::HasPendingFrames() const {
   return !incoming_frames_.empty();
 }
 
+void VideoRenderFrames::SetVsync(int64_t vsync_time_ms,
+                                 int64_t vsync_interval_ms) {
+  RTC_DCHECK_GE(vsync_interval_ms, 0);
+  vsync_time_ms_ = vsync_time_ms;
+  vsync_interval_ms_ = vsync_interval_ms;
+}
+
+int64_t VideoRenderFrames::AdaptiveReleaseTime(const VideoFrame& frame,
+                                               int64_t now_ms) {
+  if (last_rtp_timestamp_) {
+    unwrapped_rtp_timestamp_ +=
+        static_cast<int32_t>(frame.timestamp() - *last_rtp_timestamp_);
+  }
+  last_rtp_timestamp_ = frame.timestamp();
+  const int64_t rtp_time_ms = unwrapped_rtp_timestamp_ / kRtpTicksPerMs;
+  const int64_t offset_ms = now_ms - rtp_time_ms;
+
+  if (!arrival_offsets_.empty() &&
+      std::abs(offset_ms - arrival_offsets_.back().offset_ms) >
+          kMaxOffsetChangeMs) {
+    arrival_offsets_.clear();
+    target_offset_ms_ = absl::nullopt;
+  }
+  arrival_offsets_.push_back({rtp_time_ms, offset_ms});
+  while (arrival_offsets_.front().rtp_time_ms <
+         rtp_time_ms - kJitterWindowMs) {
+    arrival_offsets_.pop_front();
+  }
+
+  // Releasing every frame at its RTP time plus the largest offset in the
+  // window keeps their pace as long as none arrives later than that.
+  int64_t min_offset_ms = offset_ms;
+  int64_t max_offset_ms = offset_ms;
+  for (const ArrivalOffset& arrival : arrival_offsets_) {
+    min_offset_ms = std::min(min_offset_ms, arrival.offset_ms);
+    max_offset_ms = std::max(max_offset_ms, arrival.offset_ms);
+  }
+  int64_t target_offset_ms =
+      std::min(max_offset_ms, min_offset_ms + kMaxJitterDelayMs);
+  if (target_offset_ms_ && target_offset_ms < *target_offset_ms_) {
+    target_offset_ms = std::max(
+        target_offset_ms, *target_offset_ms_ - kMaxDelayReductionPerFrameMs);
+  }
+  target_offset_ms_ = target_offset_ms;
+
+  int64_t release_time_ms = rtp_time_ms + target_offset_ms;
+  if (vsync_interval_ms_ > 0) {
+    // Release the frame to be rendered at the next refresh. Rounding down
+    // could release it before it arrives.
+    release_time_ms =
+        vsync_time_ms_ +
+        RoundUpToMultiple(release_time_ms + render_delay_ms_ - vsync_time_ms_,
+                          vsync_interval_ms_) -
+        render_delay_ms_;
+  }
+  // Frames are released in order. If several are due at once, the newest is
+  // rendered.
+  release_time_ms = std::max(release_time_ms, last_release_time_ms_);
+  last_release_time_ms_ = release_time_ms;
+  return release_time_ms;
+}
+
 }  // namespace webrtc
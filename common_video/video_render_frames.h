@@ -14,6 +14,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <deque>
 #include <list>
 
 #include "absl/types/optional.h"
@@ -25,6 +26,10 @@ namespace webrtc {
 class VideoRenderFrames {
  public:
   explicit VideoRenderFrames(uint32_t render_delay_ms);
+  // With `adaptive_scheduling`, frames are released at the pace of their RTP
+  // timestamps instead of at their render time, delayed only as much as the
+  // jitter measured in their arrival requires.
+  VideoRenderFrames(uint32_t render_delay_ms, bool adaptive_scheduling);
   VideoRenderFrames(const VideoRenderFrames&) = delete;
   ~VideoRenderFrames();
 
@@ -39,15 +44,46 @@ class VideoRenderFrames {
 
   bool HasPendingFrames() const;
 
+  // Hints that the display refreshes at `vsync_time_ms` plus multiples of
+  // `vsync_interval_ms`. With adaptive scheduling, frames added later are
+  // released to be rendered at the next refresh. An interval of 0 removes the
+  // hint.
+  void SetVsync(int64_t vsync_time_ms, int64_t vsync_interval_ms);
+
  private:
+  struct PendingFrame {
+    VideoFrame frame;
+    int64_t release_time_ms;
+  };
+  struct ArrivalOffset {
+    int64_t rtp_time_ms;
+    // Arrival time minus `rtp_time_ms`.
+    int64_t offset_ms;
+  };
+
+  // Returns when a frame arriving at `now_ms` is released with adaptive
+  // scheduling.
+  int64_t AdaptiveReleaseTime(const VideoFrame& frame, int64_t now_ms);
+
   // Sorted list with framed to be rendered, oldest first.
-  std::list<VideoFrame> incoming_frames_;
+  std::list<PendingFrame> incoming_frames_;
 
   // Estimated delay from a frame is released until it's rendered.
   const uint32_t render_delay_ms_;
+  const bool adaptive_scheduling_;
 
   int64_t last_render_time_ms_ = 0;
   size_t frames_dropped_ = 0;
+
+  // Adaptive scheduling state.
+  absl::optional<uint32_t> last_rtp_timestamp_;
+  int64_t unwrapped_rtp_timestamp_ = 0;
+  // The frames of the jitter window, oldest first.
+  std::deque<ArrivalOffset> arrival_offsets_;
+  absl::optional<int64_t> target_offset_ms_;
+  int64_t last_release_time_ms_ = 0;
+  int64_t vsync_time_ms_ = 0;
+  int64_t vsync_interval_ms_ = 0;
 };
 
 }  // namespace webrtc
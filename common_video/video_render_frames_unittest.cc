@@ -0,0 +1,145 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/video_render_frames.h"
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "api/video/i420_buffer.h"
+#include "api/video/video_frame.h"
+#include "rtc_base/fake_clock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint32_t kRenderDelayMs = 10;
+constexpr uint32_t kRtpTicksPerFrame = 3000;  // 30 fps.
+constexpr int kFrameIntervalMs = 33;
+
+VideoFrame CreateFrame(uint32_t rtp_timestamp, int64_t render_time_ms) {
+  return VideoFrame::Builder()
+      .set_video_frame_buffer(I420Buffer::Create(2, 2))
+      .set_timestamp_rtp(rtp_timestamp)
+      .set_timestamp_ms(render_time_ms)
+      .build();
+}
+
+class VideoRenderFramesTest : public ::testing::Test {
+ protected:
+  VideoRenderFramesTest() { clock_.SetTime(Timestamp::Seconds(1000)); }
+
+  int64_t NowMs() const { return clock_.TimeNanos() / 1000000; }
+
+  // Adds frame i when `arrival_ms[i]` is reached and renders frames when they
+  // are released, for `duration_ms`. Returns the time each frame was
+  // released, by RTP timestamp.
+  std::map<uint32_t, int64_t> Run(VideoRenderFrames& frames,
+                                  const std::vector<int64_t>& arrival_ms,
+                                  int64_t duration_ms) {
+    std::map<uint32_t, int64_t> release_ms;
+    const int64_t start_ms = NowMs();
+    size_t next_frame = 0;
+    for (int64_t t = 0; t < duration_ms; ++t) {
+      while (next_frame < arrival_ms.size() &&
+             arrival_ms[next_frame] <= t) {
+        frames.AddFrame(CreateFrame(next_frame * kRtpTicksPerFrame,
+                                    /*render_time_ms=*/0));
+        ++next_frame;
+      }
+      absl::optional<VideoFrame> frame = frames.FrameToRender();
+      if (frame) {
+        release_ms[frame->timestamp()] = NowMs() - start_ms;
+      }
+      clock_.AdvanceTime(TimeDelta::Millis(1));
+    }
+    return release_ms;
+  }
+
+  rtc::ScopedFakeClock clock_;
+};
+
+TEST_F(VideoRenderFramesTest, ReleasesFramesAtRenderTime) {
+  VideoRenderFrames frames(kRenderDelayMs);
+  EXPECT_EQ(frames.AddFrame(CreateFrame(0, NowMs() + 50)), 1);
+  EXPECT_EQ(frames.TimeToNextFrameRelease(), 50 - kRenderDelayMs);
+  EXPECT_FALSE(frames.FrameToRender());
+
+  clock_.AdvanceTime(TimeDelta::Millis(50 - kRenderDelayMs));
+  absl::optional<VideoFrame> frame = frames.FrameToRender();
+  ASSERT_TRUE(frame);
+  EXPECT_EQ(frame->timestamp(), 0u);
+  EXPECT_FALSE(frames.HasPendingFrames());
+}
+
+TEST_F(VideoRenderFramesTest, AdaptiveSchedulingSmoothsJitteryArrivals) {
+  VideoRenderFrames frames(kRenderDelayMs, /*adaptive_scheduling=*/true);
+  // The second frame is the latest, 30 ms after its RTP time.
+  const std::vector<int64_t> kJitterMs = {0, 30, 5, 20, 0, 15, 25, 10, 0, 5};
+  std::vector<int64_t> arrival_ms;
+  for (size_t i = 0; i < kJitterMs.size(); ++i) {
+    arrival_ms.push_back(i * kFrameIntervalMs + kJitterMs[i]);
+  }
+  std::map<uint32_t, int64_t> release_ms =
+      Run(frames, arrival_ms, /*duration_ms=*/500);
+
+  // All frames are rendered, and from the second one on, at the pace of their
+  // RTP timestamps, delayed by the largest jitter.
+  ASSERT_EQ(release_ms.size(), kJitterMs.size());
+  for (size_t i = 1; i < kJitterMs.size(); ++i) {
+    const int64_t rtp_time_ms = i * kRtpTicksPerFrame / 90;
+    EXPECT_EQ(release_ms[i * kRtpTicksPerFrame], rtp_time_ms + 30)
+        << "Frame " << i;
+  }
+}
+
+TEST_F(VideoRenderFramesTest, AdaptiveSchedulingAddsNoDelayWithoutJitter) {
+  VideoRenderFrames frames(kRenderDelayMs, /*adaptive_scheduling=*/true);
+  std::vector<int64_t> arrival_ms;
+  for (int i = 0; i < 10; ++i) {
+    arrival_ms.push_back(i * 100 / 3);
+  }
+  std::map<uint32_t, int64_t> release_ms =
+      Run(frames, arrival_ms, /*duration_ms=*/500);
+
+  ASSERT_EQ(release_ms.size(), arrival_ms.size());
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(release_ms[i * kRtpTicksPerFrame], arrival_ms[i])
+        << "Frame " << i;
+  }
+}
+
+TEST_F(VideoRenderFramesTest, AdaptiveSchedulingRendersFramesAtVsync) {
+  VideoRenderFrames frames(kRenderDelayMs, /*adaptive_scheduling=*/true);
+  constexpr int64_t kVsyncIntervalMs = 16;
+  const int64_t vsync_time_ms = NowMs() + 3;
+  frames.SetVsync(vsync_time_ms, kVsyncIntervalMs);
+  std::vector<int64_t> arrival_ms;
+  for (int i = 0; i < 10; ++i) {
+    arrival_ms.push_back(i * kFrameIntervalMs);
+  }
+  const int64_t start_ms = NowMs();
+  std::map<uint32_t, int64_t> release_ms =
+      Run(frames, arrival_ms, /*duration_ms=*/500);
+
+  ASSERT_EQ(release_ms.size(), arrival_ms.size());
+  for (const auto& [rtp_timestamp, release_time_ms] : release_ms) {
+    const int64_t render_time_ms = start_ms + release_time_ms + kRenderDelayMs;
+    EXPECT_EQ((render_time_ms - vsync_time_ms) % kVsyncIntervalMs, 0)
+        << "Frame " << rtp_timestamp / kRtpTicksPerFrame;
+  }
+}
+
+}  // namespace
+}  // namespace webrtc
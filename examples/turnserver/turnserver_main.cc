@@ -11,17 +11,20 @@
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
 
 #include "examples/turnserver/read_auth_file.h"
 #include "p2p/base/basic_packet_socket_factory.h"
 #include "p2p/base/port_interface.h"
+#include "p2p/base/sharded_turn_server.h"
 #include "p2p/base/turn_server.h"
 #include "rtc_base/async_udp_socket.h"
 #include "rtc_base/ip_address.h"
 #include "rtc_base/physical_socket_server.h"
 #include "rtc_base/socket_address.h"
+#include "rtc_base/string_to_number.h"
 #include "rtc_base/thread.h"
 
 namespace {
@@ -51,8 +54,8 @@ class TurnFileAuth : public cricket::TurnAuthInterface {
 }  // namespace
 
 int main(int argc, char* argv[]) {
-  if (argc != 5) {
-    std::cerr << "usage: turnserver int-addr ext-ip realm auth-file"
+  if (argc != 5 && argc != 6) {
+    std::cerr << "usage: turnserver int-addr ext-ip realm auth-file [threads]"
               << std::endl;
     return 1;
   }
@@ -69,8 +72,44 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
+  int threads = 1;
+  if (argc == 6) {
+    absl::optional<int> parsed = rtc::StringToNumber<int>(argv[5]);
+    if (!parsed || *parsed < 1) {
+      std::cerr << "Invalid number of threads: " << argv[5] << std::endl;
+      return 1;
+    }
+    threads = *parsed;
+  }
+
+  std::fstream auth_file(argv[4], std::fstream::in);
+  TurnFileAuth auth(auth_file.is_open()
+                        ? webrtc_examples::ReadAuthFile(&auth_file)
+                        : std::map<std::string, std::string>());
+
   rtc::PhysicalSocketServer socket_server;
   rtc::AutoSocketServerThread main(&socket_server);
+
+  if (threads > 1) {
+    // TurnFileAuth only reads its map, so the shards can share it.
+    std::unique_ptr<cricket::ShardedTurnServer> server =
+        cricket::ShardedTurnServer::Create(
+            threads, int_addr, ext_addr, [&](cricket::TurnServer* shard) {
+              shard->set_realm(argv[3]);
+              shard->set_software(kSoftware);
+              shard->set_auth_hook(&auth);
+            });
+    if (!server) {
+      std::cerr << "Failed to bind UDP sockets at " << int_addr.ToString()
+                << std::endl;
+      return 1;
+    }
+    std::cout << "Listening internally at " << int_addr.ToString() << " on "
+              << threads << " threads" << std::endl;
+    main.Run();
+    return 0;
+  }
+
   rtc::AsyncUDPSocket* int_socket =
       rtc::AsyncUDPSocket::Create(&socket_server, int_addr);
   if (!int_socket) {
@@ -80,11 +119,6 @@ int main(int argc, char* argv[]) {
   }
 
   cricket::TurnServer server(&main);
-  std::fstream auth_file(argv[4], std::fstream::in);
-
-  TurnFileAuth auth(auth_file.is_open()
-                        ? webrtc_examples::ReadAuthFile(&auth_file)
-                        : std::map<std::string, std::string>());
   server.set_realm(argv[3]);
   server.set_software(kSoftware);
   server.set_auth_hook(&auth);
@@ -0,0 +1,241 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "logging/rtc_event_log/encoder/frame_compression.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+#include "logging/rtc_event_log/encoder/var_int.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+const char kCompressedFrameMagic[4] = {0, 'R', 'L', 'Z'};
+const size_t kMaxCompressedFrameHeaderSize =
+    sizeof(kCompressedFrameMagic) + 2 * kMaxVarIntLengthBytes;
+
+namespace {
+
+// The compressed data is a sequence of sequences, each of which is
+//   token: the number of literals in the high nibble, and the length of the
+//     match minus kMinMatchLength in the low nibble
+//   the number of literals minus 15, if the high nibble is 15
+//   the literals
+//   2 bytes: the offset of the match, least significant byte first
+//   the length of the match minus kMinMatchLength + 15, if the low nibble
+//     is 15
+// A number that doesn't fit in a nibble continues in bytes of 255, up to a
+// byte that is less than 255. The last sequence has only literals, and ends
+// where the data ends.
+constexpr size_t kMinMatchLength = 4;
+constexpr size_t kMaxMatchOffset = 0xffff;
+constexpr int kHashBits = 14;
+
+uint32_t Load32(const char* p) {
+  uint32_t value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+uint32_t Hash(uint32_t sequence) {
+  return (sequence * 2654435761u) >> (32 - kHashBits);
+}
+
+void WriteLength(size_t length, std::string* output) {
+  for (; length >= 255; length -= 255)
+    output->push_back(static_cast<char>(255));
+  output->push_back(static_cast<char>(length));
+}
+
+void WriteSequence(absl::string_view literals,
+                   size_t match_offset,
+                   size_t match_length,
+                   std::string* output) {
+  const size_t match_code = match_length > 0 ? match_length - kMinMatchLength
+                                             : 0;
+  const uint8_t token = (std::min<size_t>(literals.size(), 15) << 4) |
+                        std::min<size_t>(match_code, 15);
+  output->push_back(static_cast<char>(token));
+  if (literals.size() >= 15)
+    WriteLength(literals.size() - 15, output);
+  output->append(literals.data(), literals.size());
+  if (match_length == 0)
+    return;
+  output->push_back(static_cast<char>(match_offset & 0xff));
+  output->push_back(static_cast<char>(match_offset >> 8));
+  if (match_code >= 15)
+    WriteLength(match_code - 15, output);
+}
+
+bool ReadLength(absl::string_view& input, size_t* length) {
+  uint8_t byte;
+  do {
+    if (input.empty())
+      return false;
+    byte = static_cast<uint8_t>(input[0]);
+    input.remove_prefix(1);
+    *length += byte;
+  } while (byte == 255);
+  return true;
+}
+
+void Compress(absl::string_view input, std::string* output) {
+  // Positions of the last occurrences of hashed 4 byte sequences, plus 1 so
+  // that 0 means none.
+  std::vector<uint32_t> last_positions(1 << kHashBits, 0);
+  size_t literals_start = 0;
+  size_t pos = 0;
+  while (pos + kMinMatchLength <= input.size()) {
+    const uint32_t sequence = Load32(input.data() + pos);
+    uint32_t& last_position = last_positions[Hash(sequence)];
+    const size_t candidate = last_position;
+    last_position = static_cast<uint32_t>(pos + 1);
+    if (candidate == 0 || pos - (candidate - 1) > kMaxMatchOffset ||
+        Load32(input.data() + candidate - 1) != sequence) {
+      ++pos;
+      continue;
+    }
+    const size_t match = candidate - 1;
+    size_t length = kMinMatchLength;
+    while (pos + length < input.size() &&
+           input[match + length] == input[pos + length]) {
+      ++length;
+    }
+    WriteSequence(input.substr(literals_start, pos - literals_start),
+                  pos - match, length, output);
+    pos += length;
+    literals_start = pos;
+  }
+  WriteSequence(input.substr(literals_start), 0, 0, output);
+}
+
+bool Decompress(absl::string_view input,
+                size_t uncompressed_size,
+                std::string* output) {
+  const size_t start = output->size();
+  output->reserve(start + uncompressed_size);
+  while (true) {
+    if (input.empty())
+      return false;
+    const uint8_t token = static_cast<uint8_t>(input[0]);
+    input.remove_prefix(1);
+
+    size_t num_literals = token >> 4;
+    if (num_literals == 15 && !ReadLength(input, &num_literals))
+      return false;
+    if (num_literals > input.size() ||
+        num_literals > uncompressed_size - (output->size() - start)) {
+      return false;
+    }
+    output->append(input.data(), num_literals);
+    input.remove_prefix(num_literals);
+    if (input.empty())
+      break;
+
+    if (input.size() < 2)
+      return false;
+    const size_t offset = static_cast<uint8_t>(input[0]) |
+                          static_cast<uint8_t>(input[1]) << 8;
+    input.remove_prefix(2);
+    size_t length = token & 0x0f;
+    if (length == 15 && !ReadLength(input, &length))
+      return false;
+    length += kMinMatchLength;
+    const size_t decompressed = output->size() - start;
+    if (offset == 0 || offset > decompressed ||
+        length > uncompressed_size - decompressed) {
+      return false;
+    }
+    // The match may overlap the bytes it produces, so copy byte by byte.
+    const size_t from = output->size() - offset;
+    output->resize(output->size() + length);
+    char* data = &(*output)[0];
+    for (size_t i = 0; i < length; ++i)
+      data[from + offset + i] = data[from + i];
+  }
+  return output->size() - start == uncompressed_size;
+}
+
+}  // namespace
+
+std::string CompressFrame(absl::string_view data) {
+  RTC_DCHECK_LE(data.size(), kMaxUncompressedFrameSize);
+  std::string compressed;
+  Compress(data, &compressed);
+  std::string frame(kCompressedFrameMagic, sizeof(kCompressedFrameMagic));
+  frame += EncodeVarInt(data.size());
+  frame += EncodeVarInt(compressed.size());
+  frame += compressed;
+  return frame;
+}
+
+bool IsCompressedLog(absl::string_view log) {
+  return log.size() >= sizeof(kCompressedFrameMagic) &&
+         memcmp(log.data(), kCompressedFrameMagic,
+                sizeof(kCompressedFrameMagic)) == 0;
+}
+
+absl::optional<CompressedFrameHeader> ReadCompressedFrameHeader(
+    absl::string_view data) {
+  if (!IsCompressedLog(data))
+    return absl::nullopt;
+  absl::string_view rest = data.substr(sizeof(kCompressedFrameMagic));
+  uint64_t uncompressed_size = 0;
+  uint64_t compressed_size = 0;
+  bool success = false;
+  std::tie(success, rest) = DecodeVarInt(rest, &uncompressed_size);
+  if (success)
+    std::tie(success, rest) = DecodeVarInt(rest, &compressed_size);
+  if (!success || uncompressed_size > kMaxUncompressedFrameSize ||
+      compressed_size > 2 * kMaxUncompressedFrameSize) {
+    return absl::nullopt;
+  }
+  CompressedFrameHeader header;
+  header.header_size = data.size() - rest.size();
+  header.uncompressed_size = uncompressed_size;
+  header.compressed_size = compressed_size;
+  return header;
+}
+
+bool DecompressFrameData(absl::string_view compressed,
+                         size_t uncompressed_size,
+                         std::string* output) {
+  const size_t size = output->size();
+  if (!Decompress(compressed, uncompressed_size, output)) {
+    output->resize(size);
+    return false;
+  }
+  return true;
+}
+
+size_t DecompressFrames(absl::string_view log, std::string* output) {
+  size_t pos = 0;
+  while (pos < log.size()) {
+    absl::string_view rest = log.substr(pos);
+    absl::optional<CompressedFrameHeader> header =
+        ReadCompressedFrameHeader(rest);
+    if (!header ||
+        header->compressed_size > rest.size() - header->header_size ||
+        !DecompressFrameData(
+            rest.substr(header->header_size, header->compressed_size),
+            header->uncompressed_size, output)) {
+      break;
+    }
+    pos += header->header_size + header->compressed_size;
+  }
+  return pos;
+}
+
+}  // namespace webrtc
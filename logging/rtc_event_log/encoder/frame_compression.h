@@ -0,0 +1,75 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef LOGGING_RTC_EVENT_LOG_ENCODER_FRAME_COMPRESSION_H_
+#define LOGGING_RTC_EVENT_LOG_ENCODER_FRAME_COMPRESSION_H_
+
+#include <stddef.h>
+
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+namespace webrtc {
+
+// A compressed event log is a sequence of frames, each of which decompresses
+// on its own. A log that is cut short, e.g. by a crash, can be read up to its
+// last complete frame, and a reader can start at any frame. A frame is
+//   kCompressedFrameMagic
+//   varint: size of the uncompressed data
+//   varint: size of the compressed data
+//   the compressed data
+// The magic starts with a zero byte, which can't start a protobuf message, so
+// a compressed log can be told apart from an uncompressed one by its first
+// byte. The data is compressed with a byte oriented LZ77, in the style of LZ4,
+// which is fast enough to compress while logging.
+extern const char kCompressedFrameMagic[4];
+
+// Sanity check of the uncompressed size of a frame, which is allocated before
+// the frame is decompressed.
+constexpr size_t kMaxUncompressedFrameSize = 1 << 28;
+
+// Compresses `data` into a frame.
+std::string CompressFrame(absl::string_view data);
+
+// Whether `log` starts with a compressed frame.
+bool IsCompressedLog(absl::string_view log);
+
+struct CompressedFrameHeader {
+  size_t header_size = 0;
+  size_t uncompressed_size = 0;
+  size_t compressed_size = 0;
+};
+
+// The largest size of the header of a frame.
+extern const size_t kMaxCompressedFrameHeaderSize;
+
+// Reads the header of the frame at the start of `data`. Returns nullopt if the
+// header is invalid, or if `data` ends before it and is shorter than
+// kMaxCompressedFrameHeaderSize.
+absl::optional<CompressedFrameHeader> ReadCompressedFrameHeader(
+    absl::string_view data);
+
+// Decompresses the data of a frame, `compressed`, which decompresses to
+// `uncompressed_size` bytes, and appends it to `output`. Returns false, and
+// leaves `output` as it was, if the data is corrupt.
+bool DecompressFrameData(absl::string_view compressed,
+                         size_t uncompressed_size,
+                         std::string* output);
+
+// Decompresses the frames of `log` and appends them to `output`. Returns the
+// number of bytes of `log` that are in complete and valid frames, which is
+// less than the size of `log` if it ends in an incomplete or corrupt frame.
+size_t DecompressFrames(absl::string_view log, std::string* output);
+
+}  // namespace webrtc
+
+#endif  // LOGGING_RTC_EVENT_LOG_ENCODER_FRAME_COMPRESSION_H_
@@ -0,0 +1,141 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "logging/rtc_event_log/encoder/frame_compression.h"
+
+#include <algorithm>
+#include <string>
+
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+std::string Decompress(absl::string_view log) {
+  std::string output;
+  EXPECT_EQ(DecompressFrames(log, &output), log.size());
+  return output;
+}
+
+// Random bytes from a small alphabet, with repeated runs, like an event log.
+std::string LogLikeData(size_t size) {
+  Random random(size);
+  std::string data;
+  while (data.size() < size) {
+    if (data.size() > 16 && random.Rand(0, 1) == 0) {
+      const size_t offset =
+          random.Rand(1, std::min(static_cast<int>(data.size()), 1000));
+      const size_t length = random.Rand(4, 40);
+      for (size_t i = 0; i < length; ++i)
+        data.push_back(data[data.size() - offset]);
+    } else {
+      data.push_back(static_cast<char>(random.Rand(0, 15)));
+    }
+  }
+  data.resize(size);
+  return data;
+}
+
+TEST(FrameCompressionTest, RoundTripsEmptyData) {
+  const std::string frame = CompressFrame("");
+  EXPECT_TRUE(IsCompressedLog(frame));
+  EXPECT_EQ(Decompress(frame), "");
+}
+
+TEST(FrameCompressionTest, RoundTripsShortData) {
+  for (const char* data : {"a", "abc", "abcd", "aaaaaaaaaaaaaaaaaaaa"})
+    EXPECT_EQ(Decompress(CompressFrame(data)), data);
+}
+
+TEST(FrameCompressionTest, RoundTripsRandomData) {
+  Random random(1);
+  std::string data;
+  for (int i = 0; i < 100000; ++i)
+    data.push_back(static_cast<char>(random.Rand(0, 255)));
+  EXPECT_EQ(Decompress(CompressFrame(data)), data);
+}
+
+TEST(FrameCompressionTest, CompressesRepetitiveData) {
+  const std::string data = LogLikeData(100000);
+  const std::string frame = CompressFrame(data);
+  EXPECT_LT(frame.size(), data.size() / 2);
+  EXPECT_EQ(Decompress(frame), data);
+}
+
+TEST(FrameCompressionTest, RoundTripsLongMatches) {
+  const std::string data =
+      std::string(10000, 'x') + "y" + std::string(300, 'x');
+  const std::string frame = CompressFrame(data);
+  EXPECT_LT(frame.size(), 100u);
+  EXPECT_EQ(Decompress(frame), data);
+}
+
+TEST(FrameCompressionTest, DecompressesConcatenatedFrames) {
+  const std::string first = LogLikeData(5000);
+  const std::string second = LogLikeData(7000);
+  EXPECT_EQ(Decompress(CompressFrame(first) + CompressFrame(second)),
+            first + second);
+}
+
+TEST(FrameCompressionTest, StopsAtIncompleteFrame) {
+  const std::string first = LogLikeData(5000);
+  const std::string first_frame = CompressFrame(first);
+  const std::string second_frame = CompressFrame(LogLikeData(7000));
+  for (size_t cut : {size_t{1}, size_t{5}, second_frame.size() / 2,
+                     second_frame.size() - 1}) {
+    const std::string log = first_frame + second_frame.substr(0, cut);
+    std::string output;
+    EXPECT_EQ(DecompressFrames(log, &output), first_frame.size());
+    EXPECT_EQ(output, first);
+  }
+}
+
+TEST(FrameCompressionTest, RejectsCorruptFrames) {
+  const std::string data = LogLikeData(5000);
+  const std::string frame = CompressFrame(data);
+  absl::optional<CompressedFrameHeader> header =
+      ReadCompressedFrameHeader(frame);
+  ASSERT_TRUE(header);
+  EXPECT_EQ(header->uncompressed_size, data.size());
+  EXPECT_EQ(header->header_size + header->compressed_size, frame.size());
+  const absl::string_view compressed =
+      absl::string_view(frame).substr(header->header_size);
+
+  std::string output = "unchanged";
+  EXPECT_FALSE(DecompressFrameData(compressed, data.size() + 1, &output));
+  EXPECT_FALSE(DecompressFrameData(compressed, data.size() - 1, &output));
+  EXPECT_FALSE(DecompressFrameData(compressed.substr(0, compressed.size() / 2),
+                                   data.size(), &output));
+  EXPECT_EQ(output, "unchanged");
+
+  // Whatever the corruption, decompression stays within bounds.
+  Random random(2);
+  for (int i = 0; i < 1000; ++i) {
+    std::string corrupt(compressed);
+    corrupt[random.Rand(0, static_cast<int>(corrupt.size()) - 1)] =
+        static_cast<char>(random.Rand(0, 255));
+    std::string corrupt_output;
+    if (DecompressFrameData(corrupt, data.size(), &corrupt_output))
+      EXPECT_EQ(corrupt_output.size(), data.size());
+    else
+      EXPECT_TRUE(corrupt_output.empty());
+  }
+}
+
+TEST(FrameCompressionTest, UncompressedLogIsNotCompressed) {
+  // Event logs start with a protobuf tag, which is never zero.
+  EXPECT_FALSE(IsCompressedLog("\x0a\x05"));
+  EXPECT_FALSE(IsCompressedLog(""));
+  EXPECT_FALSE(ReadCompressedFrameHeader("\x12\x05" "abcde"));
+}
+
+}  // namespace
+}  // namespace webrtc
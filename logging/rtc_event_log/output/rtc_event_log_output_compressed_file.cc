@@ -0,0 +1,34 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "logging/rtc_event_log/output/rtc_event_log_output_compressed_file.h"
+
+#include "logging/rtc_event_log/encoder/frame_compression.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+RtcEventLogOutputCompressedFile::RtcEventLogOutputCompressedFile(
+    const std::string& file_name,
+    size_t max_size_bytes)
+    : file_(file_name, max_size_bytes) {}
+
+bool RtcEventLogOutputCompressedFile::IsActive() const {
+  return file_.IsActive();
+}
+
+bool RtcEventLogOutputCompressedFile::Write(const std::string& output) {
+  RTC_DCHECK(file_.IsActive());
+  if (output.empty())
+    return true;
+  return file_.Write(CompressFrame(output));
+}
+
+}  // namespace webrtc
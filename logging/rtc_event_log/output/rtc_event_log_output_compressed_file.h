@@ -0,0 +1,46 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef LOGGING_RTC_EVENT_LOG_OUTPUT_RTC_EVENT_LOG_OUTPUT_COMPRESSED_FILE_H_
+#define LOGGING_RTC_EVENT_LOG_OUTPUT_RTC_EVENT_LOG_OUTPUT_COMPRESSED_FILE_H_
+
+#include <stddef.h>
+
+#include <string>
+
+#include "api/rtc_event_log_output.h"
+#include "api/rtc_event_log_output_file.h"
+
+namespace webrtc {
+
+// Writes an event log to a file, compressed. Every Write() is compressed into
+// a frame of its own (see frame_compression.h), so the file can be read up to
+// the last write if logging ends abruptly, like an uncompressed file.
+// RtcEventLog calls Write() on its own task queue, off the threads that log
+// events, once per output period. ParsedRtcEventLog reads the files.
+class RtcEventLogOutputCompressedFile final : public RtcEventLogOutput {
+ public:
+  // `max_size_bytes` limits the compressed size of the file, or is
+  // RtcEventLog::kUnlimitedOutput.
+  RtcEventLogOutputCompressedFile(const std::string& file_name,
+                                  size_t max_size_bytes);
+  ~RtcEventLogOutputCompressedFile() override = default;
+
+  bool IsActive() const override;
+
+  bool Write(const std::string& output) override;
+
+ private:
+  RtcEventLogOutputFile file_;
+};
+
+}  // namespace webrtc
+
+#endif  // LOGGING_RTC_EVENT_LOG_OUTPUT_RTC_EVENT_LOG_OUTPUT_COMPRESSED_FILE_H_
@@ -142,13 +142,34 @@ void RtcEventLogImpl::StopLogging(std::function<void()> callback) {
 void RtcEventLogImpl::Log(std::unique_ptr<RtcEvent> event) {
   RTC_CHECK(event);
 
+  {
+    MutexLock lock(&pending_events_lock_);
+    pending_events_.push_back(std::move(event));
+    if (pending_events_.size() > 1) {
+      // A posted task will log this event too.
+      return;
+    }
+  }
+
   // Binding to `this` is safe because `this` outlives the `task_queue_`.
-  task_queue_->PostTask([this, event = std::move(event)]() mutable {
+  task_queue_->PostTask([this] {
     RTC_DCHECK_RUN_ON(task_queue_.get());
+    LogPendingEventsToMemory();
+  });
+}
+
+void RtcEventLogImpl::LogPendingEventsToMemory() {
+  RTC_DCHECK(events_to_log_.empty());
+  {
+    MutexLock lock(&pending_events_lock_);
+    events_to_log_.swap(pending_events_);
+  }
+  for (std::unique_ptr<RtcEvent>& event : events_to_log_) {
     LogToMemory(std::move(event));
     if (event_output_)
       ScheduleOutput();
-  });
+  }
+  events_to_log_.clear();
 }
 
 void RtcEventLogImpl::ScheduleOutput() {
@@ -16,6 +16,7 @@
 #include <algorithm>
 #include <limits>
 #include <map>
+#include <memory>
 #include <utility>
 
 #include "absl/memory/memory.h"
@@ -26,6 +27,7 @@
 #include "api/rtp_parameters.h"
 #include "logging/rtc_event_log/encoder/blob_encoding.h"
 #include "logging/rtc_event_log/encoder/delta_encoding.h"
+#include "logging/rtc_event_log/encoder/frame_compression.h"
 #include "logging/rtc_event_log/encoder/rtc_event_log_encoder_common.h"
 #include "logging/rtc_event_log/encoder/var_int.h"
 #include "logging/rtc_event_log/rtc_event_processor.h"
@@ -40,6 +42,7 @@
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/numerics/sequence_number_util.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/protobuf_utils.h"
 #include "rtc_base/system/file_wrapper.h"
 
@@ -76,10 +79,12 @@
 #define RTC_PARSE_CHECK_OR_RETURN_GE(X, Y) \
   RTC_PARSE_CHECK_OR_RETURN_OP(>=, X, Y)
 
+// Only for use in ParsedRtcEventLog member functions.
 #define RTC_PARSE_WARN_AND_RETURN_SUCCESS_IF(X, M)      \
   do {                                                  \
     if (X) {                                            \
       RTC_LOG(LS_WARNING) << (M);                       \
+      stopped_at_incomplete_event_ = true;              \
       return ParsedRtcEventLog::ParseStatus::Success(); \
     }                                                   \
   } while (0)
@@ -99,6 +104,16 @@ namespace webrtc {
 
 namespace {
 constexpr int64_t kMaxLogSize = 250000000;
+constexpr uint64_t kMaxEventSize = 10000000;  // Sanity check.
+// How much of a log ParseFileInBatches() reads at a time.
+constexpr size_t kReadChunkSize = 1 << 16;
+// The smallest part of a log that is worth decoding on a thread of its own.
+constexpr size_t kMinDecodeShardSize = 1 << 16;
+// Protobuf defines the message tag as (field_number << 3) | wire_type. In the
+// legacy encoding, the field number is supposed to be 1 and the wire type for
+// a length-delimited field is 2. In the new encoding we still expect the wire
+// type to be 2, but the field number will be greater than 1.
+constexpr uint64_t kExpectedV1Tag = (1 << 3) | 2;
 
 constexpr size_t kIpv4Overhead = 20;
 constexpr size_t kIpv6Overhead = 40;
@@ -753,6 +768,73 @@ ParsedRtcEventLog::ParseStatus StoreRtcpBlocks(
   return ParsedRtcEventLog::ParseStatus::Success();
 }
 
+// Reads a log file a chunk at a time, decompressing it if it is compressed.
+class LogFileReader {
+ public:
+  explicit LogFileReader(FileWrapper file) : file_(std::move(file)) {}
+
+  // Appends the next chunk of the log, or the next frame of a compressed log,
+  // to `buffer`. Returns false at the end of the log, and at an incomplete or
+  // corrupt frame.
+  bool ReadChunk(std::string* buffer);
+
+  bool incomplete_frame() const { return incomplete_frame_; }
+
+ private:
+  // Appends at most `size` bytes of the file to `unread_`.
+  void ReadFile(size_t size);
+
+  FileWrapper file_;
+  absl::optional<bool> compressed_;
+  // Read from the file, but not yet appended to a buffer.
+  std::string unread_;
+  bool incomplete_frame_ = false;
+};
+
+bool LogFileReader::ReadChunk(std::string* buffer) {
+  if (unread_.empty())
+    ReadFile(kReadChunkSize);
+  if (unread_.empty())
+    return false;
+  if (!compressed_)
+    compressed_ = IsCompressedLog(unread_);
+  if (!*compressed_) {
+    buffer->append(unread_);
+    unread_.clear();
+    return true;
+  }
+
+  absl::optional<CompressedFrameHeader> header =
+      ReadCompressedFrameHeader(unread_);
+  if (!header && unread_.size() < kMaxCompressedFrameHeaderSize) {
+    ReadFile(kMaxCompressedFrameHeaderSize);
+    header = ReadCompressedFrameHeader(unread_);
+  }
+  if (!header) {
+    incomplete_frame_ = true;
+    return false;
+  }
+  const size_t frame_size = header->header_size + header->compressed_size;
+  if (unread_.size() < frame_size)
+    ReadFile(frame_size - unread_.size());
+  if (unread_.size() < frame_size ||
+      !DecompressFrameData(absl::string_view(unread_).substr(
+                               header->header_size, header->compressed_size),
+                           header->uncompressed_size, buffer)) {
+    incomplete_frame_ = true;
+    return false;
+  }
+  unread_.erase(0, frame_size);
+  return true;
+}
+
+void LogFileReader::ReadFile(size_t size) {
+  const size_t old_size = unread_.size();
+  unread_.resize(old_size + size);
+  const size_t bytes_read = file_.Read(&unread_[old_size], size);
+  unread_.resize(old_size + bytes_read);
+}
+
 }  // namespace
 
 // Conversion functions for version 2 of the wire format.
@@ -1012,14 +1094,19 @@ ParsedRtcEventLog::GetDefaultHeaderExtensionMap() {
 
 ParsedRtcEventLog::ParsedRtcEventLog(
     UnconfiguredHeaderExtensions parse_unconfigured_header_extensions,
-    bool allow_incomplete_logs)
+    bool allow_incomplete_logs,
+    int num_decode_threads)
     : parse_unconfigured_header_extensions_(
           parse_unconfigured_header_extensions),
-      allow_incomplete_logs_(allow_incomplete_logs) {
+      allow_incomplete_logs_(allow_incomplete_logs),
+      num_decode_threads_(num_decode_threads) {
   Clear();
 }
 
 void ParsedRtcEventLog::Clear() {
+  ClearEvents();
+  stopped_at_incomplete_event_ = false;
+
   default_extension_map_ = GetDefaultHeaderExtensionMap();
 
   incoming_rtx_ssrcs_.clear();
@@ -1029,6 +1116,22 @@ void ParsedRtcEventLog::Clear() {
   outgoing_video_ssrcs_.clear();
   outgoing_audio_ssrcs_.clear();
 
+  start_log_events_.clear();
+  stop_log_events_.clear();
+  audio_recv_configs_.clear();
+  audio_send_configs_.clear();
+  video_recv_configs_.clear();
+  video_send_configs_.clear();
+
+  last_incoming_rtcp_packet_.clear();
+
+  first_log_segment_ = LogSegment(0, std::numeric_limits<int64_t>::max());
+
+  incoming_rtp_extensions_maps_.clear();
+  outgoing_rtp_extensions_maps_.clear();
+}
+
+void ParsedRtcEventLog::ClearEvents() {
   incoming_rtp_packets_map_.clear();
   outgoing_rtp_packets_map_.clear();
   incoming_rtp_packets_by_ssrc_.clear();
@@ -1043,17 +1146,23 @@ void ParsedRtcEventLog::Clear() {
   outgoing_rr_.clear();
   incoming_sr_.clear();
   outgoing_sr_.clear();
+  incoming_xr_.clear();
+  outgoing_xr_.clear();
   incoming_nack_.clear();
   outgoing_nack_.clear();
   incoming_remb_.clear();
   outgoing_remb_.clear();
+  incoming_fir_.clear();
+  outgoing_fir_.clear();
+  incoming_pli_.clear();
+  outgoing_pli_.clear();
+  incoming_bye_.clear();
+  outgoing_bye_.clear();
   incoming_transport_feedback_.clear();
   outgoing_transport_feedback_.clear();
   incoming_loss_notification_.clear();
   outgoing_loss_notification_.clear();
 
-  start_log_events_.clear();
-  stop_log_events_.clear();
   audio_playout_events_.clear();
   audio_network_adaptation_events_.clear();
   bwe_probe_cluster_created_events_.clear();
@@ -1067,19 +1176,14 @@ void ParsedRtcEventLog::Clear() {
   alr_state_events_.clear();
   ice_candidate_pair_configs_.clear();
   ice_candidate_pair_events_.clear();
-  audio_recv_configs_.clear();
-  audio_send_configs_.clear();
-  video_recv_configs_.clear();
-  video_send_configs_.clear();
-
-  last_incoming_rtcp_packet_.clear();
+  generic_packets_received_.clear();
+  generic_packets_sent_.clear();
+  generic_acks_received_.clear();
+  route_change_events_.clear();
+  remote_estimate_events_.clear();
 
   first_timestamp_ = std::numeric_limits<int64_t>::max();
   last_timestamp_ = std::numeric_limits<int64_t>::min();
-  first_log_segment_ = LogSegment(0, std::numeric_limits<int64_t>::max());
-
-  incoming_rtp_extensions_maps_.clear();
-  outgoing_rtp_extensions_maps_.clear();
 }
 
 ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseFile(
@@ -1116,8 +1220,114 @@ ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseString(
 ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseStream(
     const std::string& s) {
   Clear();
-  ParseStatus status = ParseStreamInternal(s);
+  absl::string_view log = s;
+  std::string decompressed;
+  bool incomplete_frame = false;
+  if (IsCompressedLog(s)) {
+    incomplete_frame = DecompressFrames(s, &decompressed) < s.size();
+    log = decompressed;
+  }
+  ParseStatus status = num_decode_threads_ > 1 ? ParseStreamInParallel(log)
+                                               : ParseStreamInternal(log);
+  if (status.ok() && incomplete_frame)
+    status = IncompleteFrameStatus();
+  RTC_RETURN_IF_ERROR(OrganizeParsedEvents());
+  return status;
+}
+
+ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseFileInBatches(
+    const std::string& filename,
+    const BatchOptions& options,
+    rtc::FunctionView<void(const ParsedRtcEventLog&)> on_batch) {
+  Clear();
+  FileWrapper file = FileWrapper::OpenReadOnly(filename);
+  if (!file.is_open()) {
+    RTC_LOG(LS_WARNING) << "Could not open file " << filename
+                        << " for reading.";
+    RTC_PARSE_CHECK_OR_RETURN(file.is_open());
+  }
+  LogFileReader reader(std::move(file));
+
+  batch_options_ = &options;
+  ParseStatus status = ParseStatus::Success();
+  // Holds the part of the log that has been read, of which the part from
+  // `pos` is yet to be parsed. That is at most a message more than a chunk.
+  std::string buffer;
+  size_t pos = 0;
+  size_t batch_bytes = 0;
+  bool eof = false;
+  while (status.ok()) {
+    // Read until the buffer holds the next message, so that it is parsed
+    // whole. At the end of the file, an incomplete message is left to
+    // ParseStreamInternal() to report.
+    absl::string_view unparsed;
+    size_t message_size = 0;
+    while (true) {
+      unparsed = absl::string_view(buffer).substr(pos);
+      absl::string_view rest = unparsed;
+      uint64_t tag = 0;
+      uint64_t length = 0;
+      bool success = false;
+      std::tie(success, rest) = DecodeVarInt(rest, &tag);
+      if (success)
+        std::tie(success, rest) = DecodeVarInt(rest, &length);
+      if (success && length <= rest.size() && length <= kMaxEventSize) {
+        message_size = unparsed.size() - rest.size() + length;
+        break;
+      }
+      // A message that is malformed or too large for the sanity check is
+      // parsed as is, to report the error.
+      if (eof || (success && length > kMaxEventSize) ||
+          (!success && rest.size() >= kMaxVarIntLengthBytes)) {
+        message_size = unparsed.size();
+        break;
+      }
+      buffer.erase(0, pos);
+      pos = 0;
+      eof = !reader.ReadChunk(&buffer);
+    }
+    if (message_size == 0)
+      break;
+
+    status = ParseStreamInternal(unparsed.substr(0, message_size));
+    pos += message_size;
+    batch_bytes += message_size;
+    if (batch_bytes >= options.max_batch_bytes) {
+      ParseStatus batch_status = FinishBatch(on_batch);
+      if (!batch_status.ok()) {
+        batch_options_ = nullptr;
+        return batch_status;
+      }
+      batch_bytes = 0;
+    }
+  }
+
+  if (status.ok() && reader.incomplete_frame())
+    status = IncompleteFrameStatus();
+  ParseStatus batch_status = FinishBatch(on_batch);
+  batch_options_ = nullptr;
+  RTC_RETURN_IF_ERROR(batch_status);
+  return status;
+}
+
+ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::IncompleteFrameStatus() {
+  RTC_LOG(LS_WARNING) << "The log ends in an incomplete or corrupt compressed "
+                         "frame.";
+  RTC_PARSE_WARN_AND_RETURN_SUCCESS_IF(allow_incomplete_logs_,
+                                       kIncompleteLogError);
+  return ParseStatus::Error("Incomplete compressed frame", __FILE__, __LINE__);
+}
+
+ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::FinishBatch(
+    rtc::FunctionView<void(const ParsedRtcEventLog&)> on_batch) {
+  DropFilteredSsrcs();
+  RTC_RETURN_IF_ERROR(OrganizeParsedEvents());
+  on_batch(*this);
+  ClearEvents();
+  return ParseStatus::Success();
+}
 
+ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::OrganizeParsedEvents() {
   // Cache the configured SSRCs.
   for (const auto& video_recv_config : video_recv_configs()) {
     incoming_video_ssrcs_.insert(video_recv_config.config.remote_ssrc);
@@ -1261,23 +1471,16 @@ ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseStream(
     first_timestamp_ = last_timestamp_ = 0;
   }
 
-  return status;
+  return ParseStatus::Success();
 }
 
 ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseStreamInternal(
     absl::string_view s) {
-  constexpr uint64_t kMaxEventSize = 10000000;  // Sanity check.
-
   while (!s.empty()) {
     absl::string_view event_start = s;
     bool success = false;
 
-    // Read the next message tag. Protobuf defines the message tag as
-    // (field_number << 3) | wire_type. In the legacy encoding, the field number
-    // is supposed to be 1 and the wire type for a length-delimited field is 2.
-    // In the new encoding we still expect the wire type to be 2, but the field
-    // number will be greater than 1.
-    constexpr uint64_t kExpectedV1Tag = (1 << 3) | 2;
+    // Read the next message tag.
     uint64_t tag = 0;
     std::tie(success, s) = DecodeVarInt(s, &tag);
     if (!success) {
@@ -1339,9 +1542,15 @@ ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseStreamInternal(
       }
 
       RTC_PARSE_CHECK_OR_RETURN_EQ(event_stream.stream_size(), 1);
+      if (batch_options_ && IsFilteredOut(event_stream.stream(0)))
+        continue;
       auto status = StoreParsedLegacyEvent(event_stream.stream(0));
       RTC_RETURN_IF_ERROR(status);
     } else {
+      // A new format message holds the events of a single type, which is
+      // given by the field number of the tag.
+      if (batch_options_ && IsFilteredOut(static_cast<int>(tag >> 3)))
+        continue;
       // Parse the protobuf event from the buffer.
       rtclog2::EventStream event_stream;
       if (!event_stream.ParseFromArray(event_start.data(), total_event_size)) {
@@ -1350,6 +1559,8 @@ ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseStreamInternal(
                                              kIncompleteLogError);
         RTC_PARSE_CHECK_OR_RETURN(false);
       }
+      if (batch_options_ && IsFilteredOut(event_stream))
+        continue;
       auto status = StoreParsedNewFormatEvent(event_stream);
       RTC_RETURN_IF_ERROR(status);
     }
@@ -1357,6 +1568,260 @@ ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseStreamInternal(
   return ParseStatus::Success();
 }
 
+ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseStreamInParallel(
+    absl::string_view s) {
+  // The messages of the new format are independent of each other, so a log
+  // can be split into shards of about equal size that are decoded separately.
+  // Legacy messages depend on the stream configs before them.
+  const size_t num_shards = std::min<size_t>(
+      num_decode_threads_, s.size() / kMinDecodeShardSize + 1);
+  std::vector<absl::string_view> shards;
+  size_t shard_start = 0;
+  absl::string_view rest = s;
+  while (!rest.empty()) {
+    uint64_t tag = 0;
+    uint64_t message_length = 0;
+    bool success = false;
+    std::tie(success, rest) = DecodeVarInt(rest, &tag);
+    if (success)
+      std::tie(success, rest) = DecodeVarInt(rest, &message_length);
+    // A malformed message ends the last shard, whose decoder reports it.
+    if (!success || message_length > rest.size())
+      break;
+    if (tag == kExpectedV1Tag)
+      return ParseStreamInternal(s);
+    rest = rest.substr(message_length);
+    const size_t shard_end = s.size() - rest.size();
+    if (shards.size() + 1 < num_shards &&
+        shard_end - shard_start >= s.size() / num_shards) {
+      shards.push_back(s.substr(shard_start, shard_end - shard_start));
+      shard_start = shard_end;
+    }
+  }
+  shards.push_back(s.substr(shard_start));
+
+  // This thread decodes the first shard, and other threads the rest.
+  std::vector<std::unique_ptr<ParsedRtcEventLog>> shard_logs;
+  std::vector<ParseStatus> shard_statuses(shards.size(),
+                                          ParseStatus::Success());
+  std::vector<rtc::PlatformThread> threads;
+  for (size_t i = 1; i < shards.size(); ++i) {
+    shard_logs.push_back(std::make_unique<ParsedRtcEventLog>(
+        parse_unconfigured_header_extensions_, allow_incomplete_logs_));
+    ParsedRtcEventLog* shard_log = shard_logs.back().get();
+    ParseStatus* shard_status = &shard_statuses[i];
+    absl::string_view shard = shards[i];
+    threads.push_back(rtc::PlatformThread::SpawnJoinable(
+        [shard_log, shard_status, shard] {
+          *shard_status = shard_log->ParseStreamInternal(shard);
+        },
+        "RtcEventLogDecoder"));
+  }
+  ParseStatus status = ParseStreamInternal(shards[0]);
+  // Joins the threads.
+  threads.clear();
+
+  // Like a sequential parse, stop at the first error or incomplete event.
+  for (size_t i = 1; i < shards.size(); ++i) {
+    if (!status.ok() || stopped_at_incomplete_event_)
+      break;
+    ParsedRtcEventLog& shard_log = *shard_logs[i - 1];
+    AppendEvents(shard_log);
+    stopped_at_incomplete_event_ = shard_log.stopped_at_incomplete_event_;
+    status = shard_statuses[i];
+  }
+  return status;
+}
+
+namespace {
+
+template <typename T>
+void AppendVector(std::vector<T>& from, std::vector<T>& to) {
+  // Not all events are assignable, as insert() needs.
+  to.reserve(to.size() + from.size());
+  for (T& event : from)
+    to.push_back(std::move(event));
+  from.clear();
+}
+
+template <typename T>
+void AppendMap(std::map<uint32_t, std::vector<T>>& from,
+               std::map<uint32_t, std::vector<T>>& to) {
+  for (auto& kv : from)
+    AppendVector(kv.second, to[kv.first]);
+  from.clear();
+}
+
+}  // namespace
+
+void ParsedRtcEventLog::AppendEvents(ParsedRtcEventLog& shard) {
+  AppendMap(shard.incoming_rtp_packets_map_, incoming_rtp_packets_map_);
+  AppendMap(shard.outgoing_rtp_packets_map_, outgoing_rtp_packets_map_);
+
+  AppendVector(shard.incoming_rtcp_packets_, incoming_rtcp_packets_);
+  AppendVector(shard.outgoing_rtcp_packets_, outgoing_rtcp_packets_);
+
+  AppendVector(shard.incoming_rr_, incoming_rr_);
+  AppendVector(shard.outgoing_rr_, outgoing_rr_);
+  AppendVector(shard.incoming_sr_, incoming_sr_);
+  AppendVector(shard.outgoing_sr_, outgoing_sr_);
+  AppendVector(shard.incoming_xr_, incoming_xr_);
+  AppendVector(shard.outgoing_xr_, outgoing_xr_);
+  AppendVector(shard.incoming_nack_, incoming_nack_);
+  AppendVector(shard.outgoing_nack_, outgoing_nack_);
+  AppendVector(shard.incoming_remb_, incoming_remb_);
+  AppendVector(shard.outgoing_remb_, outgoing_remb_);
+  AppendVector(shard.incoming_fir_, incoming_fir_);
+  AppendVector(shard.outgoing_fir_, outgoing_fir_);
+  AppendVector(shard.incoming_pli_, incoming_pli_);
+  AppendVector(shard.outgoing_pli_, outgoing_pli_);
+  AppendVector(shard.incoming_bye_, incoming_bye_);
+  AppendVector(shard.outgoing_bye_, outgoing_bye_);
+  AppendVector(shard.incoming_transport_feedback_,
+               incoming_transport_feedback_);
+  AppendVector(shard.outgoing_transport_feedback_,
+               outgoing_transport_feedback_);
+  AppendVector(shard.incoming_loss_notification_, incoming_loss_notification_);
+  AppendVector(shard.outgoing_loss_notification_, outgoing_loss_notification_);
+
+  AppendVector(shard.start_log_events_, start_log_events_);
+  AppendVector(shard.stop_log_events_, stop_log_events_);
+  AppendVector(shard.audio_recv_configs_, audio_recv_configs_);
+  AppendVector(shard.audio_send_configs_, audio_send_configs_);
+  AppendVector(shard.video_recv_configs_, video_recv_configs_);
+  AppendVector(shard.video_send_configs_, video_send_configs_);
+
+  AppendMap(shard.audio_playout_events_, audio_playout_events_);
+  AppendVector(shard.audio_network_adaptation_events_,
+               audio_network_adaptation_events_);
+  AppendVector(shard.bwe_probe_cluster_created_events_,
+               bwe_probe_cluster_created_events_);
+  AppendVector(shard.bwe_probe_failure_events_, bwe_probe_failure_events_);
+  AppendVector(shard.bwe_probe_success_events_, bwe_probe_success_events_);
+  AppendVector(shard.bwe_delay_updates_, bwe_delay_updates_);
+  AppendVector(shard.bwe_loss_updates_, bwe_loss_updates_);
+  AppendVector(shard.dtls_transport_states_, dtls_transport_states_);
+  AppendVector(shard.dtls_writable_states_, dtls_writable_states_);
+  AppendMap(shard.decoded_frames_, decoded_frames_);
+  AppendVector(shard.alr_state_events_, alr_state_events_);
+  AppendVector(shard.ice_candidate_pair_configs_, ice_candidate_pair_configs_);
+  AppendVector(shard.ice_candidate_pair_events_, ice_candidate_pair_events_);
+  AppendVector(shard.generic_packets_received_, generic_packets_received_);
+  AppendVector(shard.generic_packets_sent_, generic_packets_sent_);
+  AppendVector(shard.generic_acks_received_, generic_acks_received_);
+  AppendVector(shard.route_change_events_, route_change_events_);
+  AppendVector(shard.remote_estimate_events_, remote_estimate_events_);
+}
+
+bool ParsedRtcEventLog::IsFilteredOut(int field_number) const {
+  const BatchOptions& options = *batch_options_;
+  switch (field_number) {
+    case rtclog2::EventStream::kIncomingRtpPacketsFieldNumber:
+    case rtclog2::EventStream::kOutgoingRtpPacketsFieldNumber:
+      return !options.rtp_packets;
+    case rtclog2::EventStream::kIncomingRtcpPacketsFieldNumber:
+    case rtclog2::EventStream::kOutgoingRtcpPacketsFieldNumber:
+      return !options.rtcp_packets;
+    case rtclog2::EventStream::kAudioPlayoutEventsFieldNumber:
+      return !options.audio_playout_events;
+    case rtclog2::EventStream::kFrameDecodedEventsFieldNumber:
+      return !options.frame_decoded_events;
+    case rtclog2::EventStream::kLossBasedBweUpdatesFieldNumber:
+    case rtclog2::EventStream::kDelayBasedBweUpdatesFieldNumber:
+    case rtclog2::EventStream::kProbeClustersFieldNumber:
+    case rtclog2::EventStream::kProbeSuccessFieldNumber:
+    case rtclog2::EventStream::kProbeFailureFieldNumber:
+    case rtclog2::EventStream::kAlrStatesFieldNumber:
+    case rtclog2::EventStream::kRemoteEstimatesFieldNumber:
+      return !options.bwe_events;
+    case rtclog2::EventStream::kAudioNetworkAdaptationsFieldNumber:
+      return !options.audio_network_adaptation_events;
+    case rtclog2::EventStream::kIceCandidateConfigsFieldNumber:
+    case rtclog2::EventStream::kIceCandidateEventsFieldNumber:
+    case rtclog2::EventStream::kDtlsTransportStateEventsFieldNumber:
+    case rtclog2::EventStream::kDtlsWritableStatesFieldNumber:
+    case rtclog2::EventStream::kRouteChangesFieldNumber:
+      return !options.transport_events;
+    case rtclog2::EventStream::kGenericPacketsSentFieldNumber:
+    case rtclog2::EventStream::kGenericPacketsReceivedFieldNumber:
+    case rtclog2::EventStream::kGenericAcksReceivedFieldNumber:
+      return !options.generic_packet_events;
+    default:
+      return false;
+  }
+}
+
+bool ParsedRtcEventLog::IsFilteredOut(
+    const rtclog2::EventStream& stream) const {
+  const std::set<uint32_t>& ssrcs = batch_options_->ssrcs;
+  if (ssrcs.empty())
+    return false;
+  // RTP packets are logged in batches per SSRC, so a whole batch can be
+  // skipped. Other batches are filtered by DropFilteredSsrcs().
+  if (stream.incoming_rtp_packets_size() == 1) {
+    const rtclog2::IncomingRtpPackets& proto = stream.incoming_rtp_packets(0);
+    return proto.has_ssrc() && !proto.has_ssrc_deltas() &&
+           ssrcs.count(proto.ssrc()) == 0;
+  }
+  if (stream.outgoing_rtp_packets_size() == 1) {
+    const rtclog2::OutgoingRtpPackets& proto = stream.outgoing_rtp_packets(0);
+    return proto.has_ssrc() && !proto.has_ssrc_deltas() &&
+           ssrcs.count(proto.ssrc()) == 0;
+  }
+  return false;
+}
+
+bool ParsedRtcEventLog::IsFilteredOut(const rtclog::Event& event) const {
+  const BatchOptions& options = *batch_options_;
+  switch (event.type()) {
+    case rtclog::Event::RTP_EVENT: {
+      if (!options.rtp_packets)
+        return true;
+      // The SSRC is at offset 8 of the RTP header.
+      const std::string& header = event.rtp_packet().header();
+      return !options.ssrcs.empty() && header.size() >= 12 &&
+             options.ssrcs.count(ByteReader<uint32_t>::ReadBigEndian(
+                 reinterpret_cast<const uint8_t*>(header.data()) + 8)) == 0;
+    }
+    case rtclog::Event::RTCP_EVENT:
+      return !options.rtcp_packets;
+    case rtclog::Event::AUDIO_PLAYOUT_EVENT:
+      return !options.audio_playout_events;
+    case rtclog::Event::LOSS_BASED_BWE_UPDATE:
+    case rtclog::Event::DELAY_BASED_BWE_UPDATE:
+    case rtclog::Event::BWE_PROBE_CLUSTER_CREATED_EVENT:
+    case rtclog::Event::BWE_PROBE_RESULT_EVENT:
+    case rtclog::Event::ALR_STATE_EVENT:
+      return !options.bwe_events;
+    case rtclog::Event::AUDIO_NETWORK_ADAPTATION_EVENT:
+      return !options.audio_network_adaptation_events;
+    case rtclog::Event::ICE_CANDIDATE_PAIR_CONFIG:
+    case rtclog::Event::ICE_CANDIDATE_PAIR_EVENT:
+      return !options.transport_events;
+    default:
+      return false;
+  }
+}
+
+void ParsedRtcEventLog::DropFilteredSsrcs() {
+  const std::set<uint32_t>& ssrcs = batch_options_->ssrcs;
+  if (ssrcs.empty())
+    return;
+  auto drop_filtered = [&ssrcs](auto& events_by_ssrc) {
+    for (auto it = events_by_ssrc.begin(); it != events_by_ssrc.end();) {
+      if (ssrcs.count(it->first) == 0) {
+        it = events_by_ssrc.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  };
+  drop_filtered(incoming_rtp_packets_map_);
+  drop_filtered(outgoing_rtp_packets_map_);
+  drop_filtered(audio_playout_events_);
+  drop_filtered(decoded_frames_);
+}
+
 template <typename T>
 void ParsedRtcEventLog::StoreFirstAndLastTimestamp(const std::vector<T>& v) {
   if (v.empty())
@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "absl/base/attributes.h"
+#include "api/function_view.h"
 #include "api/rtc_event_log/rtc_event_log.h"
 #include "call/video_receive_stream.h"
 #include "call/video_send_stream.h"
@@ -325,10 +326,13 @@ class ParsedRtcEventLog {
 
   static webrtc::RtpHeaderExtensionMap GetDefaultHeaderExtensionMap();
 
+  // With `num_decode_threads` > 1, ParseFile(), ParseString() and
+  // ParseStream() decode large new format logs on that many threads.
   explicit ParsedRtcEventLog(
       UnconfiguredHeaderExtensions parse_unconfigured_header_extensions =
           UnconfiguredHeaderExtensions::kDontParse,
-      bool allow_incomplete_log = false);
+      bool allow_incomplete_log = false,
+      int num_decode_threads = 1);
 
   ~ParsedRtcEventLog();
 
@@ -337,6 +341,7 @@ class ParsedRtcEventLog {
   void Clear();
 
   // Reads an RtcEventLog file and returns success if parsing was successful.
+  // Logs compressed by RtcEventLogOutputCompressedFile are decompressed.
   ParseStatus ParseFile(const std::string& file_name);
 
   // Reads an RtcEventLog from a string and returns success if successful.
@@ -345,6 +350,42 @@ class ParsedRtcEventLog {
   // Reads an RtcEventLog from an string and returns success if successful.
   ParseStatus ParseStream(const std::string& s);
 
+  // Selects the events that ParseFileInBatches() decodes, and how often it
+  // hands them over.
+  struct BatchOptions {
+    // Size of the part of the log, in bytes, whose events make up a batch.
+    // The memory used is about proportional to it.
+    size_t max_batch_bytes = 1 << 20;
+    // If not empty, only the RTP packets, audio playout events and decoded
+    // frames of these SSRCs are kept.
+    std::set<uint32_t> ssrcs;
+    // The event types to decode. Stream configurations and the start and stop
+    // of the log are always decoded, as the other events depend on them.
+    bool rtp_packets = true;
+    bool rtcp_packets = true;
+    bool audio_playout_events = true;
+    bool frame_decoded_events = true;
+    // Delay and loss based updates, probes, ALR and remote estimates.
+    bool bwe_events = true;
+    bool audio_network_adaptation_events = true;
+    // ICE, DTLS and route change events.
+    bool transport_events = true;
+    bool generic_packet_events = true;
+  };
+
+  // Reads an RtcEventLog file of any length a batch at a time, with memory
+  // bounded by the size of a batch, or of a frame of a compressed log, rather
+  // than of the log. After each batch
+  // `on_batch` is called with this parser, whose accessors then return the
+  // events of the batch, along with all stream configurations and start and
+  // stop events so far. The events of the batch are cleared when `on_batch`
+  // returns. Events that `options` filter out are skipped before they are
+  // decoded where the log format allows it.
+  ParseStatus ParseFileInBatches(
+      const std::string& file_name,
+      const BatchOptions& options,
+      rtc::FunctionView<void(const ParsedRtcEventLog&)> on_batch);
+
   MediaType GetMediaType(uint32_t ssrc, PacketDirection direction) const;
 
   // Configured SSRCs.
@@ -620,6 +661,34 @@ class ParsedRtcEventLog {
 
  private:
   ABSL_MUST_USE_RESULT ParseStatus ParseStreamInternal(absl::string_view s);
+  // Splits a new format log into shards at message boundaries, decodes them
+  // on `num_decode_threads_` threads, and appends the events of the shards in
+  // log order. Falls back to ParseStreamInternal() for legacy logs.
+  ABSL_MUST_USE_RESULT ParseStatus ParseStreamInParallel(absl::string_view s);
+  // Moves the events parsed by `shard` to the end of the events of this log.
+  void AppendEvents(ParsedRtcEventLog& shard);
+
+  // Clears the events, but not the stream configurations and the start and
+  // stop events, which the events that follow depend on.
+  void ClearEvents();
+  // Groups the events parsed by ParseStreamInternal() the way the accessors
+  // return them, and finds the first and last timestamps.
+  ABSL_MUST_USE_RESULT ParseStatus OrganizeParsedEvents();
+  // Whether `batch_options_` filters out the new format events with the
+  // EventStream field number `field_number`, before they are parsed.
+  bool IsFilteredOut(int field_number) const;
+  // Whether `batch_options_` filters out the parsed events, before they are
+  // decoded.
+  bool IsFilteredOut(const rtclog2::EventStream& stream) const;
+  bool IsFilteredOut(const rtclog::Event& event) const;
+  // Drops the events of the SSRCs that `batch_options_` filters out.
+  void DropFilteredSsrcs();
+  // Returns the status of a log that ends in an incomplete or corrupt
+  // compressed frame.
+  ABSL_MUST_USE_RESULT ParseStatus IncompleteFrameStatus();
+  // Hands over the events parsed since the last batch, and clears them.
+  ABSL_MUST_USE_RESULT ParseStatus
+  FinishBatch(rtc::FunctionView<void(const ParsedRtcEventLog&)> on_batch);
 
   ABSL_MUST_USE_RESULT ParseStatus
   StoreParsedLegacyEvent(const rtclog::Event& event);
@@ -745,6 +814,12 @@ class ParsedRtcEventLog {
 
   const UnconfiguredHeaderExtensions parse_unconfigured_header_extensions_;
   const bool allow_incomplete_logs_;
+  const int num_decode_threads_;
+  // Set when parsing stopped at an incomplete event, as allowed by
+  // `allow_incomplete_logs_`.
+  bool stopped_at_incomplete_event_ = false;
+  // Set while parsing in batches.
+  const BatchOptions* batch_options_ = nullptr;
 
   // Make a default extension map for streams without configuration information.
   // TODO(ivoc): Once configuration of audio streams is stored in the event log,
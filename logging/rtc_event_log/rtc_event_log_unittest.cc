@@ -9,6 +9,8 @@
  */
 
 #include <algorithm>
+#include <fstream>
+#include <iterator>
 #include <limits>
 #include <map>
 #include <memory>
@@ -41,6 +43,7 @@
 #include "logging/rtc_event_log/events/rtc_event_rtp_packet_outgoing.h"
 #include "logging/rtc_event_log/events/rtc_event_video_receive_stream_config.h"
 #include "logging/rtc_event_log/events/rtc_event_video_send_stream_config.h"
+#include "logging/rtc_event_log/output/rtc_event_log_output_compressed_file.h"
 #include "logging/rtc_event_log/rtc_event_log_parser.h"
 #include "logging/rtc_event_log/rtc_event_log_unittest_helper.h"
 #include "logging/rtc_event_log/rtc_stream_config.h"
@@ -129,7 +132,16 @@ class RtcEventLogSession
   // randomized non-config events. Then call StartLogging and finally create and
   // write the remaining non-config events.
   void WriteLog(EventCounts count, size_t num_events_before_log_start);
-  void ReadAndVerifyLog();
+  void ReadAndVerifyLog(int num_decode_threads = 1);
+  // Reads the log in small batches, and verifies that all events are read,
+  // and that filtered out events aren't.
+  void ReadInBatchesAndVerifyLog();
+  // Rewrites the log compressed, with `frame_size` bytes of the log in each
+  // frame, and the last frame cut short by `truncate_bytes`.
+  void CompressLog(size_t frame_size, size_t truncate_bytes = 0);
+  // Verifies that a log that ends in an incomplete frame is only parsed if
+  // incomplete logs are allowed.
+  void ReadTruncatedLog();
 
   bool IsNewFormat() {
     return encoding_type_ == RtcEventLog::EncodingType::NewFormat;
@@ -557,9 +569,11 @@ void RtcEventLogSession::WriteLog(EventCounts count,
 
 // Read the file and verify that what we read back from the event log is the
 // same as what we wrote down.
-void RtcEventLogSession::ReadAndVerifyLog() {
+void RtcEventLogSession::ReadAndVerifyLog(int num_decode_threads) {
   // Read the generated file from disk.
-  ParsedRtcEventLog parsed_log;
+  ParsedRtcEventLog parsed_log(
+      ParsedRtcEventLog::UnconfiguredHeaderExtensions::kDontParse,
+      /*allow_incomplete_log=*/false, num_decode_threads);
   ASSERT_TRUE(parsed_log.ParseFile(temp_filename_).ok());
 
   // Start and stop events.
@@ -792,6 +806,114 @@ void RtcEventLogSession::ReadAndVerifyLog() {
   remove(temp_filename_.c_str());
 }
 
+void RtcEventLogSession::ReadInBatchesAndVerifyLog() {
+  ParsedRtcEventLog::BatchOptions options;
+  options.max_batch_bytes = 1000;
+  size_t num_batches = 0;
+  std::map<uint32_t, size_t> incoming_rtp_counts;
+  size_t num_alr_states = 0;
+  size_t num_incoming_rtcp = 0;
+  ParsedRtcEventLog parsed_log;
+  ASSERT_TRUE(parsed_log
+                  .ParseFileInBatches(
+                      temp_filename_, options,
+                      [&](const ParsedRtcEventLog& batch) {
+                        ++num_batches;
+                        EXPECT_EQ(batch.start_log_events().size(), 1u);
+                        for (const auto& stream :
+                             batch.incoming_rtp_packets_by_ssrc()) {
+                          incoming_rtp_counts[stream.ssrc] +=
+                              stream.incoming_packets.size();
+                        }
+                        num_alr_states += batch.alr_state_events().size();
+                        num_incoming_rtcp +=
+                            batch.incoming_rtcp_packets().size();
+                      })
+                  .ok());
+  EXPECT_GT(num_batches, 1u);
+  ASSERT_EQ(incoming_rtp_counts.size(), incoming_rtp_map_.size());
+  for (const auto& kv : incoming_rtp_map_) {
+    EXPECT_EQ(incoming_rtp_counts[kv.first], kv.second.size());
+  }
+  EXPECT_EQ(num_alr_states, alr_state_list_.size());
+  EXPECT_EQ(num_incoming_rtcp, incoming_rtcp_list_.size());
+
+  // Keep only the incoming RTP packets of one SSRC.
+  ASSERT_FALSE(incoming_rtp_map_.empty());
+  const uint32_t ssrc = incoming_rtp_map_.begin()->first;
+  options.ssrcs = {ssrc};
+  options.rtcp_packets = false;
+  options.bwe_events = false;
+  incoming_rtp_counts.clear();
+  num_alr_states = 0;
+  num_incoming_rtcp = 0;
+  ASSERT_TRUE(parsed_log
+                  .ParseFileInBatches(
+                      temp_filename_, options,
+                      [&](const ParsedRtcEventLog& batch) {
+                        for (const auto& stream :
+                             batch.incoming_rtp_packets_by_ssrc()) {
+                          incoming_rtp_counts[stream.ssrc] +=
+                              stream.incoming_packets.size();
+                        }
+                        num_alr_states += batch.alr_state_events().size();
+                        num_incoming_rtcp +=
+                            batch.incoming_rtcp_packets().size();
+                      })
+                  .ok());
+  ASSERT_EQ(incoming_rtp_counts.size(), 1u);
+  EXPECT_EQ(incoming_rtp_counts[ssrc], incoming_rtp_map_[ssrc].size());
+  EXPECT_EQ(num_alr_states, 0u);
+  EXPECT_EQ(num_incoming_rtcp, 0u);
+
+  // Clean up temporary file - can be pretty slow.
+  remove(temp_filename_.c_str());
+}
+
+void RtcEventLogSession::CompressLog(size_t frame_size,
+                                     size_t truncate_bytes) {
+  std::string log;
+  {
+    std::ifstream file(temp_filename_,
+                       std::ios_base::in | std::ios_base::binary);
+    log.assign(std::istreambuf_iterator<char>(file),
+               std::istreambuf_iterator<char>());
+  }
+  {
+    RtcEventLogOutputCompressedFile output(temp_filename_,
+                                           RtcEventLog::kUnlimitedOutput);
+    for (size_t pos = 0; pos < log.size(); pos += frame_size)
+      ASSERT_TRUE(output.Write(log.substr(pos, frame_size)));
+  }
+  if (truncate_bytes > 0) {
+    std::ifstream file(temp_filename_,
+                       std::ios_base::in | std::ios_base::binary);
+    std::string compressed((std::istreambuf_iterator<char>(file)),
+                           std::istreambuf_iterator<char>());
+    ASSERT_LT(truncate_bytes, compressed.size());
+    compressed.resize(compressed.size() - truncate_bytes);
+    std::ofstream(temp_filename_, std::ios_base::out | std::ios_base::binary |
+                                      std::ios_base::trunc)
+        << compressed;
+  }
+}
+
+void RtcEventLogSession::ReadTruncatedLog() {
+  ParsedRtcEventLog strict_parser;
+  EXPECT_FALSE(strict_parser.ParseFile(temp_filename_).ok());
+
+  ParsedRtcEventLog parsed_log(
+      ParsedRtcEventLog::UnconfiguredHeaderExtensions::kDontParse,
+      /*allow_incomplete_log=*/true);
+  ASSERT_TRUE(parsed_log.ParseFile(temp_filename_).ok());
+  EXPECT_EQ(parsed_log.start_log_events().size(), 1u);
+  EXPECT_EQ(parsed_log.video_recv_configs().size(),
+            video_recv_config_list_.size());
+
+  // Clean up temporary file - can be pretty slow.
+  remove(temp_filename_.c_str());
+}
+
 }  // namespace
 
 TEST_P(RtcEventLogSession, StartLoggingFromBeginning) {
@@ -862,6 +984,99 @@ TEST_P(RtcEventLogSession, StartLoggingInTheMiddle) {
   ReadAndVerifyLog();
 }
 
+TEST_P(RtcEventLogSession, ParsesInBatches) {
+  EventCounts count;
+  count.audio_send_streams = 1;
+  count.audio_recv_streams = 1;
+  count.video_send_streams = 2;
+  count.video_recv_streams = 2;
+  count.alr_states = 10;
+  count.bwe_delay_events = 20;
+  count.incoming_rtp_packets = 200;
+  count.outgoing_rtp_packets = 200;
+  count.incoming_rtcp_packets = 20;
+  count.outgoing_rtcp_packets = 20;
+
+  WriteLog(count, 0);
+  ReadInBatchesAndVerifyLog();
+}
+
+TEST_P(RtcEventLogSession, ParsesCompressedLog) {
+  EventCounts count;
+  count.audio_send_streams = 2;
+  count.audio_recv_streams = 2;
+  count.video_send_streams = 3;
+  count.video_recv_streams = 4;
+  count.alr_states = 4;
+  count.audio_playouts = 100;
+  count.bwe_loss_events = 20;
+  count.bwe_delay_events = 20;
+  count.ice_events = 10;
+  count.incoming_rtp_packets = 100;
+  count.outgoing_rtp_packets = 100;
+  count.incoming_rtcp_packets = 20;
+  count.outgoing_rtcp_packets = 20;
+
+  WriteLog(count, 0);
+  CompressLog(/*frame_size=*/5000);
+  ReadAndVerifyLog();
+}
+
+TEST_P(RtcEventLogSession, ParsesCompressedLogInBatches) {
+  EventCounts count;
+  count.audio_send_streams = 1;
+  count.audio_recv_streams = 1;
+  count.video_send_streams = 2;
+  count.video_recv_streams = 2;
+  count.alr_states = 10;
+  count.bwe_delay_events = 20;
+  count.incoming_rtp_packets = 200;
+  count.outgoing_rtp_packets = 200;
+  count.incoming_rtcp_packets = 20;
+  count.outgoing_rtcp_packets = 20;
+
+  WriteLog(count, 0);
+  CompressLog(/*frame_size=*/3000);
+  ReadInBatchesAndVerifyLog();
+}
+
+TEST_P(RtcEventLogSession, ParsesTruncatedCompressedLog) {
+  EventCounts count;
+  count.video_send_streams = 1;
+  count.video_recv_streams = 2;
+  count.incoming_rtp_packets = 200;
+
+  WriteLog(count, 0);
+  CompressLog(/*frame_size=*/2000, /*truncate_bytes=*/10);
+  ReadTruncatedLog();
+}
+
+TEST_P(RtcEventLogSession, ParsesInParallel) {
+  EventCounts count;
+  count.audio_send_streams = 2;
+  count.audio_recv_streams = 2;
+  count.video_send_streams = 3;
+  count.video_recv_streams = 4;
+  count.alr_states = 10;
+  count.audio_playouts = 1000;
+  count.bwe_loss_events = 100;
+  count.bwe_delay_events = 100;
+  count.ice_events = 20;
+  count.incoming_rtp_packets = 2000;
+  count.outgoing_rtp_packets = 2000;
+  count.incoming_rtcp_packets = 200;
+  count.outgoing_rtcp_packets = 200;
+  if (IsNewFormat()) {
+    count.frame_decoded_events = 500;
+    count.generic_packets_sent = 500;
+    count.generic_packets_received = 500;
+    count.generic_acks_received = 100;
+  }
+
+  WriteLog(count, 0);
+  ReadAndVerifyLog(/*num_decode_threads=*/4);
+}
+
 INSTANTIATE_TEST_SUITE_P(
     RtcEventLogTest,
     RtcEventLogSession,
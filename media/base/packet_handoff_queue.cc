@@ -0,0 +1,88 @@
+/*
+ *  Copyright 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "media/base/packet_handoff_queue.h"
+
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/task_utils/to_queued_task.h"
+
+namespace cricket {
+
+namespace {
+
+// Upper bound on the packets delivered by one drain task, so that a steady
+// stream of packets doesn't starve other tasks on the worker thread.
+constexpr size_t kMaxPacketsPerDrain = 64;
+
+}  // namespace
+
+PacketHandoffQueue::PacketHandoffQueue(
+    webrtc::TaskQueueBase* worker_thread,
+    rtc::scoped_refptr<webrtc::PendingTaskSafetyFlag> safety_flag,
+    DeliverCallback deliver,
+    size_t capacity)
+    : worker_thread_(worker_thread),
+      safety_flag_(std::move(safety_flag)),
+      deliver_(std::move(deliver)),
+      queue_(capacity) {
+  RTC_DCHECK(worker_thread_);
+  RTC_DCHECK(deliver_);
+  RTC_DCHECK_GT(capacity, 0);
+}
+
+PacketHandoffQueue::~PacketHandoffQueue() = default;
+
+void PacketHandoffQueue::Push(rtc::CopyOnWriteBuffer packet,
+                              int64_t packet_time_us) {
+  Packet item{std::move(packet), packet_time_us};
+  if (!queue_.Insert(&item)) {
+    int64_t dropped =
+        dropped_packets_.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (dropped == 1 || dropped % 1000 == 0) {
+      RTC_LOG(LS_WARNING) << "Packet handoff queue full, " << dropped
+                          << " packets dropped so far.";
+    }
+    return;
+  }
+  if (!drain_scheduled_.exchange(true)) {
+    PostDrainTask();
+  }
+}
+
+void PacketHandoffQueue::PostDrainTask() {
+  worker_thread_->PostTask(
+      webrtc::ToQueuedTask(safety_flag_, [this] { Drain(); }));
+}
+
+void PacketHandoffQueue::Drain() {
+  RTC_DCHECK(worker_thread_->IsCurrent());
+  Packet item;
+  for (size_t i = 0; i < kMaxPacketsPerDrain; ++i) {
+    if (!queue_.Remove(&item)) {
+      // Let the producer schedule the next drain, then check for a packet
+      // that was inserted before it could see the flag cleared. The fence
+      // keeps the load below from moving ahead of the store.
+      drain_scheduled_.store(false);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (queue_.SizeAtLeast() == 0 || drain_scheduled_.exchange(true)) {
+        return;
+      }
+      continue;
+    }
+    deliver_(std::move(item.buffer), item.packet_time_us);
+  }
+  // More packets are waiting; yield to other tasks before delivering them.
+  PostDrainTask();
+}
+
+}  // namespace cricket
@@ -0,0 +1,86 @@
+/*
+ *  Copyright 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MEDIA_BASE_PACKET_HANDOFF_QUEUE_H_
+#define MEDIA_BASE_PACKET_HANDOFF_QUEUE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <functional>
+
+#include "api/scoped_refptr.h"
+#include "api/task_queue/task_queue_base.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/swap_queue.h"
+#include "rtc_base/task_utils/pending_task_safety_flag.h"
+
+namespace cricket {
+
+// Hands received packets from the network thread to the worker thread
+// without posting a task per packet. Packets go through a lock-free
+// single-producer/single-consumer SwapQueue, and a drain task is only posted
+// when the queue goes from idle to busy; it then delivers everything queued
+// up, in order, until the queue runs dry. Packets arriving while the queue is
+// full are dropped.
+//
+// Push() must be called on a single producer thread. The queue must be
+// destroyed on the worker thread, after which pending drain tasks are
+// cancelled through `safety_flag`.
+class PacketHandoffQueue {
+ public:
+  using DeliverCallback =
+      std::function<void(rtc::CopyOnWriteBuffer packet,
+                         int64_t packet_time_us)>;
+
+  static constexpr size_t kDefaultCapacity = 512;
+
+  // `deliver` is called on `worker_thread` for every packet, as long as
+  // `safety_flag` is alive.
+  PacketHandoffQueue(
+      webrtc::TaskQueueBase* worker_thread,
+      rtc::scoped_refptr<webrtc::PendingTaskSafetyFlag> safety_flag,
+      DeliverCallback deliver,
+      size_t capacity = kDefaultCapacity);
+  ~PacketHandoffQueue();
+
+  PacketHandoffQueue(const PacketHandoffQueue&) = delete;
+  PacketHandoffQueue& operator=(const PacketHandoffQueue&) = delete;
+
+  void Push(rtc::CopyOnWriteBuffer packet, int64_t packet_time_us);
+
+  // Number of packets dropped because the queue was full.
+  int64_t dropped_packets() const {
+    return dropped_packets_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct Packet {
+    rtc::CopyOnWriteBuffer buffer;
+    int64_t packet_time_us = -1;
+  };
+
+  void PostDrainTask();
+  void Drain();
+
+  webrtc::TaskQueueBase* const worker_thread_;
+  const rtc::scoped_refptr<webrtc::PendingTaskSafetyFlag> safety_flag_;
+  const DeliverCallback deliver_;
+  webrtc::SwapQueue<Packet> queue_;
+  // Set while a drain task is posted or running, so that the producer only
+  // wakes up the worker once per burst.
+  std::atomic<bool> drain_scheduled_{false};
+  std::atomic<int64_t> dropped_packets_{0};
+};
+
+}  // namespace cricket
+
+#endif  // MEDIA_BASE_PACKET_HANDOFF_QUEUE_H_
@@ -0,0 +1,129 @@
+/*
+ *  Copyright 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "media/base/packet_handoff_queue.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rtc_base/checks.h"
+#include "test/gtest.h"
+
+namespace cricket {
+namespace {
+
+// Collects posted tasks so the test controls when the "worker" runs.
+class FakeTaskQueue : public webrtc::TaskQueueBase {
+ public:
+  ~FakeTaskQueue() override = default;
+
+  void Delete() override {}
+  void PostTask(std::unique_ptr<webrtc::QueuedTask> task) override {
+    tasks_.push_back(std::move(task));
+  }
+  void PostDelayedTask(std::unique_ptr<webrtc::QueuedTask> task,
+                       uint32_t milliseconds) override {
+    RTC_DCHECK_NOTREACHED();
+  }
+
+  size_t pending_tasks() const { return tasks_.size(); }
+
+  void RunPendingTasks() {
+    CurrentTaskQueueSetter set_current(this);
+    std::vector<std::unique_ptr<webrtc::QueuedTask>> tasks;
+    tasks.swap(tasks_);
+    for (auto& task : tasks) {
+      if (!task->Run()) {
+        task.release();
+      }
+    }
+  }
+
+ private:
+  std::vector<std::unique_ptr<webrtc::QueuedTask>> tasks_;
+};
+
+class PacketHandoffQueueTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<PacketHandoffQueue> CreateQueue(size_t capacity) {
+    return std::make_unique<PacketHandoffQueue>(
+        &worker_, safety_flag_,
+        [this](rtc::CopyOnWriteBuffer packet, int64_t packet_time_us) {
+          delivered_.emplace_back(packet.cdata<char>(), packet.size());
+          packet_times_.push_back(packet_time_us);
+        },
+        capacity);
+  }
+
+  FakeTaskQueue worker_;
+  rtc::scoped_refptr<webrtc::PendingTaskSafetyFlag> safety_flag_ =
+      webrtc::PendingTaskSafetyFlag::CreateDetached();
+  std::vector<std::string> delivered_;
+  std::vector<int64_t> packet_times_;
+};
+
+TEST_F(PacketHandoffQueueTest, PostsOneTaskPerBurst) {
+  auto queue = CreateQueue(16);
+  queue->Push(rtc::CopyOnWriteBuffer(std::string("a")), 1);
+  queue->Push(rtc::CopyOnWriteBuffer(std::string("b")), 2);
+  queue->Push(rtc::CopyOnWriteBuffer(std::string("c")), 3);
+  EXPECT_EQ(1u, worker_.pending_tasks());
+
+  worker_.RunPendingTasks();
+  EXPECT_EQ(std::vector<std::string>({"a", "b", "c"}), delivered_);
+  EXPECT_EQ(std::vector<int64_t>({1, 2, 3}), packet_times_);
+  EXPECT_EQ(0u, worker_.pending_tasks());
+
+  // Once drained, the next packet wakes up the worker again.
+  queue->Push(rtc::CopyOnWriteBuffer(std::string("d")), 4);
+  EXPECT_EQ(1u, worker_.pending_tasks());
+  worker_.RunPendingTasks();
+  EXPECT_EQ(4u, delivered_.size());
+}
+
+TEST_F(PacketHandoffQueueTest, DropsPacketsWhenFull) {
+  auto queue = CreateQueue(2);
+  queue->Push(rtc::CopyOnWriteBuffer(std::string("a")), 1);
+  queue->Push(rtc::CopyOnWriteBuffer(std::string("b")), 2);
+  queue->Push(rtc::CopyOnWriteBuffer(std::string("c")), 3);
+  EXPECT_EQ(1, queue->dropped_packets());
+
+  worker_.RunPendingTasks();
+  EXPECT_EQ(std::vector<std::string>({"a", "b"}), delivered_);
+}
+
+TEST_F(PacketHandoffQueueTest, YieldsBetweenLargeBatches) {
+  auto queue = CreateQueue(256);
+  for (int i = 0; i < 100; ++i) {
+    queue->Push(rtc::CopyOnWriteBuffer(std::to_string(i)), i);
+  }
+  worker_.RunPendingTasks();
+  EXPECT_LT(delivered_.size(), 100u);
+  EXPECT_EQ(1u, worker_.pending_tasks());
+
+  worker_.RunPendingTasks();
+  ASSERT_EQ(100u, delivered_.size());
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(std::to_string(i), delivered_[i]);
+  }
+}
+
+TEST_F(PacketHandoffQueueTest, DoesNotDeliverAfterSafetyFlagIsCleared) {
+  auto queue = CreateQueue(16);
+  queue->Push(rtc::CopyOnWriteBuffer(std::string("a")), 1);
+  safety_flag_->SetNotAlive();
+  worker_.RunPendingTasks();
+  EXPECT_TRUE(delivered_.empty());
+}
+
+}  // namespace
+}  // namespace cricket
@@ -65,6 +65,10 @@ VideoSinkWants VideoBroadcaster::wants() const {
 void VideoBroadcaster::OnFrame(const webrtc::VideoFrame& frame) {
   webrtc::MutexLock lock(&sinks_and_wants_lock_);
   bool current_frame_was_discarded = false;
+  // Frames derived from `frame` are built once and handed to every sink that
+  // needs them, rather than once per sink.
+  absl::optional<webrtc::VideoFrame> black_frame;
+  absl::optional<webrtc::VideoFrame> frame_without_update_rect;
   for (auto& sink_pair : sink_pairs()) {
     if (sink_pair.wants.rotation_applied &&
         frame.rotation() != webrtc::kVideoRotation_0) {
@@ -78,21 +82,24 @@ void VideoBroadcaster::OnFrame(const webrtc::VideoFrame& frame) {
       continue;
     }
     if (sink_pair.wants.black_frames) {
-      webrtc::VideoFrame black_frame =
-          webrtc::VideoFrame::Builder()
-              .set_video_frame_buffer(
-                  GetBlackFrameBuffer(frame.width(), frame.height()))
-              .set_rotation(frame.rotation())
-              .set_timestamp_us(frame.timestamp_us())
-              .set_id(frame.id())
-              .build();
-      sink_pair.sink->OnFrame(black_frame);
+      if (!black_frame) {
+        black_frame = webrtc::VideoFrame::Builder()
+                          .set_video_frame_buffer(GetBlackFrameBuffer(
+                              frame.width(), frame.height()))
+                          .set_rotation(frame.rotation())
+                          .set_timestamp_us(frame.timestamp_us())
+                          .set_id(frame.id())
+                          .build();
+      }
+      sink_pair.sink->OnFrame(*black_frame);
     } else if (!previous_frame_sent_to_all_sinks_ && frame.has_update_rect()) {
       // Since last frame was not sent to some sinks, no reliable update
       // information is available, so we need to clear the update rect.
-      webrtc::VideoFrame copy = frame;
-      copy.clear_update_rect();
-      sink_pair.sink->OnFrame(copy);
+      if (!frame_without_update_rect) {
+        frame_without_update_rect = frame;
+        frame_without_update_rect->clear_update_rect();
+      }
+      sink_pair.sink->OnFrame(*frame_without_update_rect);
     } else {
       sink_pair.sink->OnFrame(frame);
     }
@@ -0,0 +1,435 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "media/engine/shared_video_encoder_factory.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "absl/algorithm/container.h"
+#include "api/ref_counted_base.h"
+#include "modules/video_coding/include/video_error_codes.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+namespace {
+
+// Compares the layers apart from their bitrates.
+bool HasSameLayers(const SpatialLayer* a, const SpatialLayer* b, int count) {
+  for (int i = 0; i < count; ++i) {
+    if (a[i].active != b[i].active || a[i].width != b[i].width ||
+        a[i].height != b[i].height || a[i].maxFramerate != b[i].maxFramerate ||
+        a[i].numberOfTemporalLayers != b[i].numberOfTemporalLayers ||
+        a[i].qpMax != b[i].qpMax) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Whether encoded images produced with the settings `a` can be sent as is by a
+// stream configured with the settings `b`. Bitrates are not compared, since
+// each stream sets the rates it wants separately.
+bool HasSameSettings(const VideoCodec& a, const VideoCodec& b) {
+  if (a.codecType != b.codecType || a.width != b.width ||
+      a.height != b.height || a.maxFramerate != b.maxFramerate ||
+      a.qpMax != b.qpMax || a.mode != b.mode ||
+      a.numberOfSimulcastStreams != b.numberOfSimulcastStreams ||
+      a.ScalabilityMode() != b.ScalabilityMode()) {
+    return false;
+  }
+  switch (a.codecType) {
+    case kVideoCodecVP8:
+      if (a.VP8() != b.VP8())
+        return false;
+      break;
+    case kVideoCodecVP9:
+      if (a.VP9() != b.VP9() ||
+          !HasSameLayers(a.spatialLayers, b.spatialLayers,
+                         a.VP9().numberOfSpatialLayers)) {
+        return false;
+      }
+      break;
+    case kVideoCodecH264:
+      if (a.H264() != b.H264())
+        return false;
+      break;
+    default:
+      break;
+  }
+  return HasSameLayers(a.simulcastStream, b.simulcastStream,
+                       a.numberOfSimulcastStreams);
+}
+
+}  // namespace
+
+// The encoders created by the factory, grouped by their settings.
+class SharedVideoEncoderFactory::SharedEncoders : public rtc::RefCountedBase {
+ public:
+  class Encoder;
+
+  explicit SharedEncoders(std::unique_ptr<VideoEncoderFactory> factory)
+      : factory_(std::move(factory)) {}
+
+  VideoEncoderFactory* factory() const { return factory_.get(); }
+
+ private:
+  class Group;
+
+  const std::unique_ptr<VideoEncoderFactory> factory_;
+  // Serializes the calls to the shared encoders.
+  Mutex mutex_;
+  std::vector<std::unique_ptr<Group>> groups_ RTC_GUARDED_BY(mutex_);
+};
+
+// An encoder shared by the Encoders with the same settings. Each Encoder
+// passes every input frame on, but only the first of them to pass a frame
+// has it encoded, and the encoded images are delivered to all of them.
+// Guarded by the mutex of the SharedEncoders, except for the callbacks, which
+// an encoder may call on a thread of its own.
+class SharedVideoEncoderFactory::SharedEncoders::Group
+    : public EncodedImageCallback {
+ public:
+  Group(const SdpVideoFormat& format,
+        const VideoCodec& codec,
+        const VideoEncoder::Settings& settings,
+        std::unique_ptr<VideoEncoder> encoder)
+      : format_(format),
+        codec_(codec),
+        settings_(settings),
+        encoder_(std::move(encoder)) {}
+  ~Group() override {
+    if (encoder_)
+      encoder_->Release();
+  }
+
+  int InitEncode() {
+    encoder_->RegisterEncodeCompleteCallback(this);
+    return encoder_->InitEncode(&codec_, settings_);
+  }
+
+  // Takes back the encoder of a group that failed to initialize.
+  std::unique_ptr<VideoEncoder> TakeEncoder() { return std::move(encoder_); }
+
+  VideoEncoder* encoder() { return encoder_.get(); }
+
+  bool Matches(const SdpVideoFormat& format,
+               const VideoCodec& codec,
+               const VideoEncoder::Settings& settings) const {
+    return format == format_ && HasSameSettings(codec, codec_) &&
+           settings.number_of_cores == settings_.number_of_cores &&
+           settings.max_payload_size == settings_.max_payload_size &&
+           settings.capabilities.loss_notification ==
+               settings_.capabilities.loss_notification;
+  }
+
+  void AddMember(Encoder* member, EncodedImageCallback* callback) {
+    members_.push_back(member);
+    SetCallback(member, callback);
+  }
+
+  // Returns false when the last member is removed.
+  bool RemoveMember(Encoder* member) {
+    auto it = absl::c_find(members_, member);
+    RTC_DCHECK(it != members_.end());
+    members_.erase(it);
+    MutexLock lock(&callback_mutex_);
+    callbacks_.erase(
+        std::remove_if(callbacks_.begin(), callbacks_.end(),
+                       [member](const auto& it) { return it.first == member; }),
+        callbacks_.end());
+    return !members_.empty();
+  }
+
+  void SetCallback(Encoder* member, EncodedImageCallback* callback) {
+    MutexLock lock(&callback_mutex_);
+    auto it = absl::c_find_if(
+        callbacks_, [member](const auto& it) { return it.first == member; });
+    if (it != callbacks_.end()) {
+      it->second = callback;
+    } else {
+      callbacks_.emplace_back(member, callback);
+    }
+  }
+
+  int Encode(const VideoFrame& frame,
+             const std::vector<VideoFrameType>* frame_types) {
+    const bool key_frame_requested =
+        frame_types &&
+        absl::c_linear_search(*frame_types, VideoFrameType::kVideoFrameKey);
+    // The streams of one source see a frame with the same capture time, but
+    // their RTP timestamps may differ slightly.
+    if (last_capture_time_us_ &&
+        frame.timestamp_us() <= *last_capture_time_us_) {
+      // Encoded for another member already, and delivered to this one too.
+      // A key frame requested for it is the next frame, unless it was one.
+      key_frame_requested_ |= key_frame_requested && !last_was_key_frame_;
+      return WEBRTC_VIDEO_CODEC_OK;
+    }
+
+    int result;
+    if (key_frame_requested_ && !key_frame_requested) {
+      std::vector<VideoFrameType> key_frame_types(
+          std::max(static_cast<int>(codec_.numberOfSimulcastStreams), 1),
+          VideoFrameType::kVideoFrameKey);
+      result = encoder_->Encode(frame, &key_frame_types);
+    } else {
+      result = encoder_->Encode(frame, frame_types);
+    }
+    if (result >= 0) {
+      last_capture_time_us_ = frame.timestamp_us();
+      last_was_key_frame_ = key_frame_requested_ || key_frame_requested;
+      key_frame_requested_ = false;
+    }
+    return result;
+  }
+
+  // Runs the encoder at the lowest rate requested by any member.
+  void UpdateRates();
+
+  // Implements EncodedImageCallback.
+  Result OnEncodedImage(const EncodedImage& encoded_image,
+                        const CodecSpecificInfo* codec_specific_info) override {
+    MutexLock lock(&callback_mutex_);
+    // Fails, or asks for the next frame to be dropped, only if all members do.
+    Result result(Result::ERROR_SEND_FAILED);
+    bool drop_next_frame = !callbacks_.empty();
+    for (const auto& it : callbacks_) {
+      if (!it.second)
+        continue;
+      Result member_result =
+          it.second->OnEncodedImage(encoded_image, codec_specific_info);
+      if (member_result.error == Result::OK) {
+        result.error = Result::OK;
+        result.frame_id = member_result.frame_id;
+      }
+      drop_next_frame &= member_result.drop_next_frame;
+    }
+    result.drop_next_frame = drop_next_frame;
+    return result;
+  }
+  void OnDroppedFrame(DropReason reason) override {
+    MutexLock lock(&callback_mutex_);
+    for (const auto& it : callbacks_) {
+      if (it.second)
+        it.second->OnDroppedFrame(reason);
+    }
+  }
+
+ private:
+  const SdpVideoFormat format_;
+  const VideoCodec codec_;
+  const VideoEncoder::Settings settings_;
+  std::unique_ptr<VideoEncoder> encoder_;
+  std::vector<Encoder*> members_;
+  absl::optional<int64_t> last_capture_time_us_;
+  // Whether the last frame was encoded as a key frame.
+  bool last_was_key_frame_ = false;
+  bool key_frame_requested_ = false;
+  absl::optional<VideoEncoder::RateControlParameters> rates_;
+
+  Mutex callback_mutex_;
+  std::vector<std::pair<Encoder*, EncodedImageCallback*>> callbacks_
+      RTC_GUARDED_BY(callback_mutex_);
+};
+
+// The encoder created by the factory. Joins the group with its settings on
+// initialization, or starts a new one with an encoder of its own.
+class SharedVideoEncoderFactory::SharedEncoders::Encoder : public VideoEncoder {
+ public:
+  Encoder(rtc::scoped_refptr<SharedEncoders> shared_encoders,
+          const SdpVideoFormat& format,
+          std::unique_ptr<VideoEncoder> encoder)
+      : shared_encoders_(std::move(shared_encoders)),
+        format_(format),
+        own_encoder_(std::move(encoder)) {}
+  ~Encoder() override { Release(); }
+
+  const absl::optional<RateControlParameters>& rates() const {
+    return rates_;
+  }
+
+  // Implements VideoEncoder.
+  void SetFecControllerOverride(
+      FecControllerOverride* fec_controller_override) override {
+    // Not forwarded, since the encoder may be shared by streams of different
+    // FEC controllers.
+  }
+
+  int InitEncode(const VideoCodec* codec_settings,
+                 const VideoEncoder::Settings& settings) override {
+    MutexLock lock(&shared_encoders_->mutex_);
+    LeaveGroup();
+    for (auto& group : shared_encoders_->groups_) {
+      if (group->Matches(format_, *codec_settings, settings)) {
+        RTC_LOG(LS_INFO) << "Sharing encoder for " << format_.ToString();
+        JoinGroup(group.get());
+        return WEBRTC_VIDEO_CODEC_OK;
+      }
+    }
+    if (!own_encoder_)
+      return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
+
+    auto group = std::make_unique<Group>(format_, *codec_settings, settings,
+                                         std::move(own_encoder_));
+    int result = group->InitEncode();
+    if (result != WEBRTC_VIDEO_CODEC_OK) {
+      own_encoder_ = group->TakeEncoder();
+      return result;
+    }
+    JoinGroup(group.get());
+    shared_encoders_->groups_.push_back(std::move(group));
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+
+  int32_t RegisterEncodeCompleteCallback(
+      EncodedImageCallback* callback) override {
+    MutexLock lock(&shared_encoders_->mutex_);
+    callback_ = callback;
+    if (group_)
+      group_->SetCallback(this, callback);
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+
+  int32_t Release() override {
+    MutexLock lock(&shared_encoders_->mutex_);
+    LeaveGroup();
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+
+  int32_t Encode(const VideoFrame& frame,
+                 const std::vector<VideoFrameType>* frame_types) override {
+    MutexLock lock(&shared_encoders_->mutex_);
+    if (!group_)
+      return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
+    return group_->Encode(frame, frame_types);
+  }
+
+  void SetRates(const RateControlParameters& parameters) override {
+    MutexLock lock(&shared_encoders_->mutex_);
+    rates_ = parameters;
+    if (group_)
+      group_->UpdateRates();
+  }
+
+  void OnPacketLossRateUpdate(float packet_loss_rate) override {
+    MutexLock lock(&shared_encoders_->mutex_);
+    if (group_)
+      group_->encoder()->OnPacketLossRateUpdate(packet_loss_rate);
+  }
+
+  void OnRttUpdate(int64_t rtt_ms) override {
+    MutexLock lock(&shared_encoders_->mutex_);
+    if (group_)
+      group_->encoder()->OnRttUpdate(rtt_ms);
+  }
+
+  void OnLossNotification(const LossNotification& loss_notification) override {
+    MutexLock lock(&shared_encoders_->mutex_);
+    if (group_)
+      group_->encoder()->OnLossNotification(loss_notification);
+  }
+
+  EncoderInfo GetEncoderInfo() const override {
+    MutexLock lock(&shared_encoders_->mutex_);
+    if (group_)
+      return group_->encoder()->GetEncoderInfo();
+    return own_encoder_ ? own_encoder_->GetEncoderInfo() : EncoderInfo();
+  }
+
+ private:
+  void JoinGroup(Group* group)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(shared_encoders_->mutex_) {
+    group_ = group;
+    group_->AddMember(this, callback_);
+    if (rates_)
+      group_->UpdateRates();
+  }
+
+  void LeaveGroup() RTC_EXCLUSIVE_LOCKS_REQUIRED(shared_encoders_->mutex_) {
+    if (!group_)
+      return;
+    if (!group_->RemoveMember(this)) {
+      auto& groups = shared_encoders_->groups_;
+      groups.erase(absl::c_find_if(
+          groups, [this](const auto& group) { return group.get() == group_; }));
+    } else {
+      group_->UpdateRates();
+    }
+    group_ = nullptr;
+    // Needed for the encoder info until the next initialization, and to
+    // start a new group then.
+    if (!own_encoder_)
+      own_encoder_ = shared_encoders_->factory()->CreateVideoEncoder(format_);
+  }
+
+  const rtc::scoped_refptr<SharedEncoders> shared_encoders_;
+  const SdpVideoFormat format_;
+  std::unique_ptr<VideoEncoder> own_encoder_
+      RTC_GUARDED_BY(shared_encoders_->mutex_);
+  Group* group_ RTC_GUARDED_BY(shared_encoders_->mutex_) = nullptr;
+  EncodedImageCallback* callback_ RTC_GUARDED_BY(shared_encoders_->mutex_) =
+      nullptr;
+  absl::optional<RateControlParameters> rates_
+      RTC_GUARDED_BY(shared_encoders_->mutex_);
+};
+
+void SharedVideoEncoderFactory::SharedEncoders::Group::UpdateRates() {
+  const VideoEncoder::RateControlParameters* lowest = nullptr;
+  for (const Encoder* member : members_) {
+    if (member->rates() &&
+        (!lowest || member->rates()->bitrate.get_sum_bps() <
+                        lowest->bitrate.get_sum_bps())) {
+      lowest = &*member->rates();
+    }
+  }
+  if (lowest && (!rates_ || *rates_ != *lowest)) {
+    rates_ = *lowest;
+    encoder_->SetRates(*rates_);
+  }
+}
+
+SharedVideoEncoderFactory::SharedVideoEncoderFactory(
+    std::unique_ptr<VideoEncoderFactory> factory)
+    : shared_encoders_(new SharedEncoders(std::move(factory))) {}
+
+SharedVideoEncoderFactory::~SharedVideoEncoderFactory() = default;
+
+std::vector<SdpVideoFormat> SharedVideoEncoderFactory::GetSupportedFormats()
+    const {
+  return shared_encoders_->factory()->GetSupportedFormats();
+}
+
+std::vector<SdpVideoFormat> SharedVideoEncoderFactory::GetImplementations()
+    const {
+  return shared_encoders_->factory()->GetImplementations();
+}
+
+VideoEncoderFactory::CodecSupport SharedVideoEncoderFactory::QueryCodecSupport(
+    const SdpVideoFormat& format,
+    absl::optional<std::string> scalability_mode) const {
+  return shared_encoders_->factory()->QueryCodecSupport(
+      format, std::move(scalability_mode));
+}
+
+std::unique_ptr<VideoEncoder> SharedVideoEncoderFactory::CreateVideoEncoder(
+    const SdpVideoFormat& format) {
+  std::unique_ptr<VideoEncoder> encoder =
+      shared_encoders_->factory()->CreateVideoEncoder(format);
+  if (!encoder)
+    return nullptr;
+  return std::make_unique<SharedEncoders::Encoder>(shared_encoders_, format,
+                                                   std::move(encoder));
+}
+
+}  // namespace webrtc
@@ -0,0 +1,67 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MEDIA_ENGINE_SHARED_VIDEO_ENCODER_FACTORY_H_
+#define MEDIA_ENGINE_SHARED_VIDEO_ENCODER_FACTORY_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/scoped_refptr.h"
+#include "api/video_codecs/sdp_video_format.h"
+#include "api/video_codecs/video_encoder.h"
+#include "api/video_codecs/video_encoder_factory.h"
+#include "rtc_base/system/rtc_export.h"
+
+namespace webrtc {
+
+// Lets the send streams of one video source share an encoder, e.g. when a
+// camera is sent to many viewers over separate PeerConnections. The encoders
+// created by this factory that are initialized with identical settings encode
+// each input frame once, and deliver the same encoded images to all their
+// streams, which still packetize them with their own RTP state.
+//
+// How to use it:
+// - Wrap the VideoEncoderFactory of the source's streams with a single
+//   SharedVideoEncoderFactory, e.g. by passing it to the
+//   CreatePeerConnectionFactory() call of each PeerConnection that sends the
+//   source. Encoders of different sources must not be created by the same
+//   instance, since input frames are told apart by capture time alone.
+//
+// While shared, the encoder runs at the lowest rate requested by its streams,
+// and a key frame requested by any stream is sent to all of them. A frame is
+// delivered to all streams even if some of them would have dropped it, since
+// the encoder references it when encoding the following frames.
+class RTC_EXPORT SharedVideoEncoderFactory : public VideoEncoderFactory {
+ public:
+  explicit SharedVideoEncoderFactory(
+      std::unique_ptr<VideoEncoderFactory> factory);
+  ~SharedVideoEncoderFactory() override;
+
+  std::vector<SdpVideoFormat> GetSupportedFormats() const override;
+  std::vector<SdpVideoFormat> GetImplementations() const override;
+  CodecSupport QueryCodecSupport(
+      const SdpVideoFormat& format,
+      absl::optional<std::string> scalability_mode) const override;
+  std::unique_ptr<VideoEncoder> CreateVideoEncoder(
+      const SdpVideoFormat& format) override;
+
+ private:
+  class SharedEncoders;
+
+  // Shared with the encoders created, which may outlive the factory.
+  const rtc::scoped_refptr<SharedEncoders> shared_encoders_;
+};
+
+}  // namespace webrtc
+
+#endif  // MEDIA_ENGINE_SHARED_VIDEO_ENCODER_FACTORY_H_
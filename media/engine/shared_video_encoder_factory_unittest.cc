@@ -0,0 +1,239 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "media/engine/shared_video_encoder_factory.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/video/i420_buffer.h"
+#include "api/video_codecs/sdp_video_format.h"
+#include "modules/video_coding/include/video_codec_interface.h"
+#include "modules/video_coding/include/video_error_codes.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+#include "test/video_codec_settings.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::SizeIs;
+
+const VideoEncoder::Capabilities kCapabilities(false);
+const VideoEncoder::Settings kSettings(kCapabilities, 1, 1200);
+
+// Encodes each frame into an image with its RTP timestamp.
+class FakeEncoder : public VideoEncoder {
+ public:
+  explicit FakeEncoder(FakeEncoder** created) { *created = this; }
+
+  int32_t InitEncode(const VideoCodec* codec_settings,
+                     const Settings& settings) override {
+    ++num_init_encode_calls;
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+  int32_t RegisterEncodeCompleteCallback(
+      EncodedImageCallback* callback) override {
+    callback_ = callback;
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+  int32_t Release() override { return WEBRTC_VIDEO_CODEC_OK; }
+  int32_t Encode(const VideoFrame& frame,
+                 const std::vector<VideoFrameType>* frame_types) override {
+    this->frame_types.push_back(frame_types->front());
+    EncodedImage image;
+    image.SetTimestamp(frame.timestamp());
+    image._frameType = frame_types->front();
+    callback_->OnEncodedImage(image, nullptr);
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+  void SetRates(const RateControlParameters& parameters) override {
+    rates.push_back(parameters);
+  }
+  EncoderInfo GetEncoderInfo() const override { return EncoderInfo(); }
+
+  int num_init_encode_calls = 0;
+  std::vector<VideoFrameType> frame_types;
+  std::vector<RateControlParameters> rates;
+
+ private:
+  EncodedImageCallback* callback_ = nullptr;
+};
+
+class CountingCallback : public EncodedImageCallback {
+ public:
+  Result OnEncodedImage(const EncodedImage& encoded_image,
+                        const CodecSpecificInfo* codec_specific_info) override {
+    ++num_encoded_images;
+    return Result(Result::OK);
+  }
+
+  int num_encoded_images = 0;
+};
+
+class FakeEncoderFactory : public VideoEncoderFactory {
+ public:
+  std::vector<SdpVideoFormat> GetSupportedFormats() const override {
+    return {SdpVideoFormat("VP8")};
+  }
+  std::unique_ptr<VideoEncoder> CreateVideoEncoder(
+      const SdpVideoFormat& format) override {
+    FakeEncoder* encoder;
+    auto result = std::make_unique<FakeEncoder>(&encoder);
+    encoders.push_back(encoder);
+    return result;
+  }
+
+  // The encoders created, which may have been destroyed since.
+  std::vector<FakeEncoder*> encoders;
+};
+
+VideoFrame CreateFrame(int64_t capture_time_ms) {
+  return VideoFrame::Builder()
+      .set_video_frame_buffer(I420Buffer::Create(16, 16))
+      .set_timestamp_rtp(capture_time_ms * 90)
+      .set_timestamp_ms(capture_time_ms)
+      .build();
+}
+
+VideoCodec CreateCodec() {
+  VideoCodec codec;
+  test::CodecSettings(kVideoCodecVP8, &codec);
+  return codec;
+}
+
+VideoEncoder::RateControlParameters CreateRates(uint32_t bitrate_bps) {
+  VideoBitrateAllocation bitrate;
+  bitrate.SetBitrate(0, 0, bitrate_bps);
+  return VideoEncoder::RateControlParameters(bitrate, 30.0);
+}
+
+class SharedVideoEncoderFactoryTest : public ::testing::Test {
+ protected:
+  SharedVideoEncoderFactoryTest() {
+    auto factory = std::make_unique<FakeEncoderFactory>();
+    fake_factory_ = factory.get();
+    factory_ = std::make_unique<SharedVideoEncoderFactory>(std::move(factory));
+  }
+
+  std::unique_ptr<VideoEncoder> CreateEncoder(
+      const VideoCodec& codec,
+      EncodedImageCallback* callback) {
+    std::unique_ptr<VideoEncoder> encoder =
+        factory_->CreateVideoEncoder(SdpVideoFormat("VP8"));
+    encoder->RegisterEncodeCompleteCallback(callback);
+    EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, encoder->InitEncode(&codec, kSettings));
+    return encoder;
+  }
+
+  FakeEncoderFactory* fake_factory_;
+  std::unique_ptr<SharedVideoEncoderFactory> factory_;
+  const std::vector<VideoFrameType> delta_frame_types_ = {
+      VideoFrameType::kVideoFrameDelta};
+  const std::vector<VideoFrameType> key_frame_types_ = {
+      VideoFrameType::kVideoFrameKey};
+};
+
+TEST_F(SharedVideoEncoderFactoryTest, EncodesOnceForStreamsWithSameSettings) {
+  CountingCallback callback1;
+  CountingCallback callback2;
+  auto encoder1 = CreateEncoder(CreateCodec(), &callback1);
+  auto encoder2 = CreateEncoder(CreateCodec(), &callback2);
+  ASSERT_THAT(fake_factory_->encoders, SizeIs(2));
+  FakeEncoder* shared_encoder = fake_factory_->encoders[0];
+  EXPECT_EQ(1, shared_encoder->num_init_encode_calls);
+  EXPECT_EQ(0, fake_factory_->encoders[1]->num_init_encode_calls);
+
+  VideoFrame frame = CreateFrame(100);
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, encoder1->Encode(frame, &key_frame_types_));
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, encoder2->Encode(frame, &key_frame_types_));
+  EXPECT_EQ(1, callback1.num_encoded_images);
+  EXPECT_EQ(1, callback2.num_encoded_images);
+  EXPECT_THAT(shared_encoder->frame_types,
+              ElementsAre(VideoFrameType::kVideoFrameKey));
+}
+
+TEST_F(SharedVideoEncoderFactoryTest, DoesNotShareWithDifferentSettings) {
+  CountingCallback callback1;
+  CountingCallback callback2;
+  VideoCodec codec = CreateCodec();
+  auto encoder1 = CreateEncoder(codec, &callback1);
+  codec.width /= 2;
+  codec.height /= 2;
+  auto encoder2 = CreateEncoder(codec, &callback2);
+  ASSERT_THAT(fake_factory_->encoders, SizeIs(2));
+  EXPECT_EQ(1, fake_factory_->encoders[0]->num_init_encode_calls);
+  EXPECT_EQ(1, fake_factory_->encoders[1]->num_init_encode_calls);
+
+  VideoFrame frame = CreateFrame(100);
+  encoder1->Encode(frame, &key_frame_types_);
+  encoder2->Encode(frame, &key_frame_types_);
+  EXPECT_EQ(1, callback1.num_encoded_images);
+  EXPECT_EQ(1, callback2.num_encoded_images);
+}
+
+TEST_F(SharedVideoEncoderFactoryTest, MergesKeyFrameRequests) {
+  CountingCallback callback;
+  auto encoder1 = CreateEncoder(CreateCodec(), &callback);
+  auto encoder2 = CreateEncoder(CreateCodec(), &callback);
+  FakeEncoder* shared_encoder = fake_factory_->encoders[0];
+
+  encoder1->Encode(CreateFrame(100), &key_frame_types_);
+  encoder2->Encode(CreateFrame(100), &key_frame_types_);
+  // The second stream asks for a key frame after the first one had this
+  // frame encoded as a delta frame.
+  encoder1->Encode(CreateFrame(200), &delta_frame_types_);
+  encoder2->Encode(CreateFrame(200), &key_frame_types_);
+  encoder1->Encode(CreateFrame(300), &delta_frame_types_);
+  encoder2->Encode(CreateFrame(300), &delta_frame_types_);
+  EXPECT_THAT(shared_encoder->frame_types,
+              ElementsAre(VideoFrameType::kVideoFrameKey,
+                          VideoFrameType::kVideoFrameDelta,
+                          VideoFrameType::kVideoFrameKey));
+}
+
+TEST_F(SharedVideoEncoderFactoryTest, UsesLowestRateOfStreams) {
+  CountingCallback callback;
+  auto encoder1 = CreateEncoder(CreateCodec(), &callback);
+  auto encoder2 = CreateEncoder(CreateCodec(), &callback);
+  FakeEncoder* shared_encoder = fake_factory_->encoders[0];
+
+  encoder1->SetRates(CreateRates(500000));
+  encoder2->SetRates(CreateRates(300000));
+  encoder1->SetRates(CreateRates(400000));
+  ASSERT_THAT(shared_encoder->rates, SizeIs(2));
+  EXPECT_EQ(500000u, shared_encoder->rates[0].bitrate.get_sum_bps());
+  EXPECT_EQ(300000u, shared_encoder->rates[1].bitrate.get_sum_bps());
+
+  // The rate of the remaining stream applies once the other one leaves.
+  encoder2.reset();
+  ASSERT_THAT(shared_encoder->rates, SizeIs(3));
+  EXPECT_EQ(400000u, shared_encoder->rates[2].bitrate.get_sum_bps());
+}
+
+TEST_F(SharedVideoEncoderFactoryTest, KeepsEncoderWhileAnyStreamUsesIt) {
+  CountingCallback callback1;
+  CountingCallback callback2;
+  auto encoder1 = CreateEncoder(CreateCodec(), &callback1);
+  auto encoder2 = CreateEncoder(CreateCodec(), &callback2);
+  FakeEncoder* shared_encoder = fake_factory_->encoders[0];
+
+  // The stream that created the encoder leaves first.
+  encoder1.reset();
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder2->Encode(CreateFrame(100), &key_frame_types_));
+  EXPECT_EQ(0, callback1.num_encoded_images);
+  EXPECT_EQ(1, callback2.num_encoded_images);
+  EXPECT_THAT(shared_encoder->frame_types, SizeIs(1));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -19,7 +19,9 @@
 #include <utility>
 
 #include "absl/algorithm/container.h"
+#include "absl/container/inlined_vector.h"
 #include "api/scoped_refptr.h"
+#include "api/video/encoded_image.h"
 #include "api/video/i420_buffer.h"
 #include "api/video/video_codec_constants.h"
 #include "api/video/video_frame_buffer.h"
@@ -27,13 +29,17 @@
 #include "api/video_codecs/video_encoder.h"
 #include "api/video_codecs/video_encoder_factory.h"
 #include "api/video_codecs/video_encoder_software_fallback_wrapper.h"
+#include "common_video/include/video_frame_buffer_pyramid.h"
 #include "media/base/video_common.h"
 #include "modules/video_coding/include/video_error_codes.h"
 #include "modules/video_coding/utility/simulcast_rate_allocator.h"
 #include "rtc_base/atomic_ops.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/experiments/rate_control_settings.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/task_queue_thread_pool.h"
 #include "system_wrappers/include/field_trial.h"
 
 namespace {
@@ -43,6 +49,11 @@ const unsigned int kDefaultMaxQp = 56;
 // Max qp for lowest spatial resolution when doing simulcast.
 const unsigned int kLowestResMaxQp = 45;
 
+// Encodes the layers of a frame in parallel when enabled, e.g.
+// "WebRTC-SimulcastEncoderAdapter-ParallelEncode/Enabled,threads:2/".
+constexpr char kParallelEncodeFieldTrial[] =
+    "WebRTC-SimulcastEncoderAdapter-ParallelEncode";
+
 absl::optional<unsigned int> GetScreenshareBoostedQpValue() {
   std::string experiment_group =
       webrtc::field_trial::FindFullName("WebRTC-BoostedScreenshareQp");
@@ -143,6 +154,51 @@ std::vector<uint32_t> GetStreamStartBitratesKbps(
   return start_bitrates;
 }
 
+// Returns the factory of the encode queues if encoding in parallel is enabled,
+// or null. The threads are shared by all adapters of the process, so their
+// number is set by the first adapter created with the field trial enabled.
+webrtc::TaskQueueFactory* GetParallelEncodeTaskQueueFactory() {
+  webrtc::FieldTrialFlag enabled("Enabled");
+  webrtc::FieldTrialParameter<int> threads("threads", 2);
+  webrtc::ParseFieldTrial(
+      {&enabled, &threads},
+      webrtc::field_trial::FindFullName(kParallelEncodeFieldTrial));
+  if (!enabled || threads.Get() < 1) {
+    return nullptr;
+  }
+  static webrtc::TaskQueueFactory* const factory =
+      webrtc::CreateTaskQueueThreadPoolFactory(
+          "SimulcastEncode", threads.Get(),
+          webrtc::TaskQueueFactory::Priority::NORMAL)
+          .release();
+  return factory;
+}
+
+// Returns the pixel formats preferred by `info`, where an empty list means
+// I420 as documented by EncoderInfo.
+absl::InlinedVector<webrtc::VideoFrameBuffer::Type,
+                    webrtc::kMaxPreferredPixelFormats>
+PreferredPixelFormats(const webrtc::VideoEncoder::EncoderInfo& info) {
+  if (info.preferred_pixel_formats.empty()) {
+    return {webrtc::VideoFrameBuffer::Type::kI420};
+  }
+  return info.preferred_pixel_formats;
+}
+
+// Removes the formats from `formats` that are not preferred by `info`.
+void IntersectPreferredPixelFormats(
+    const webrtc::VideoEncoder::EncoderInfo& info,
+    absl::InlinedVector<webrtc::VideoFrameBuffer::Type,
+                        webrtc::kMaxPreferredPixelFormats>* formats) {
+  const auto preferred = PreferredPixelFormats(info);
+  formats->erase(std::remove_if(formats->begin(), formats->end(),
+                                [&](webrtc::VideoFrameBuffer::Type type) {
+                                  return !absl::c_linear_search(preferred,
+                                                                type);
+                                }),
+                 formats->end());
+}
+
 }  // namespace
 
 namespace webrtc {
@@ -260,7 +316,8 @@ SimulcastEncoderAdapter::SimulcastEncoderAdapter(
       boost_base_layer_quality_(RateControlSettings::ParseFromFieldTrials()
                                     .Vp8BoostBaseLayerQuality()),
       prefer_temporal_support_on_base_layer_(field_trial::IsEnabled(
-          "WebRTC-Video-PreferTemporalSupportOnBaseLayer")) {
+          "WebRTC-Video-PreferTemporalSupportOnBaseLayer")),
+      parallel_encode_factory_(GetParallelEncodeTaskQueueFactory()) {
   RTC_DCHECK(primary_factory);
 
   // The adapter is typically created on the worker thread, but operated on
@@ -281,6 +338,8 @@ void SimulcastEncoderAdapter::SetFecControllerOverride(
 int SimulcastEncoderAdapter::Release() {
   RTC_DCHECK_RUN_ON(&encoder_queue_);
 
+  // No layer is being encoded, since Encode() waits for all of them.
+  encode_queues_.clear();
   while (!stream_contexts_.empty()) {
     // Move the encoder instances and put it on the `cached_encoder_contexts_`
     // where it may possibly be reused from (ordering does not matter).
@@ -307,6 +366,7 @@ int SimulcastEncoderAdapter::InitEncode(
   if (settings.number_of_cores < 1) {
     return WEBRTC_VIDEO_CODEC_ERR_PARAMETER;
   }
+  number_of_cores_ = settings.number_of_cores;
 
   int ret = VerifyCodec(inst);
   if (ret < 0) {
@@ -382,6 +442,8 @@ int SimulcastEncoderAdapter::InitEncode(
   // Multi-encoder simulcast or singlecast (deactivated layers).
   std::vector<uint32_t> stream_start_bitrate_kbps =
       GetStreamStartBitratesKbps(codec_);
+  const bool encode_in_parallel =
+      parallel_encode_factory_ != nullptr && active_streams_count > 1;
 
   for (int stream_idx = 0; stream_idx < total_streams_count_; ++stream_idx) {
     if (!is_legacy_singlecast && !codec_.simulcastStream[stream_idx].active) {
@@ -411,8 +473,10 @@ int SimulcastEncoderAdapter::InitEncode(
 
     // Intercept frame encode complete callback only for upper streams, where
     // we need to set a correct stream index. Set `parent` to nullptr for the
-    // lowest stream to bypass the callback.
-    SimulcastEncoderAdapter* parent = stream_idx > 0 ? this : nullptr;
+    // lowest stream to bypass the callback, unless the images of all streams
+    // are held until the frame is encoded in all layers.
+    SimulcastEncoderAdapter* parent =
+        stream_idx > 0 || encode_in_parallel ? this : nullptr;
 
     bool is_paused = stream_start_bitrate_kbps[stream_idx] == 0;
     stream_contexts_.emplace_back(
@@ -421,6 +485,15 @@ int SimulcastEncoderAdapter::InitEncode(
         stream_idx, stream_codec.width, stream_codec.height, is_paused);
   }
 
+  if (encode_in_parallel) {
+    for (size_t i = 0; i < stream_contexts_.size(); ++i) {
+      encode_queues_.push_back(
+          std::make_unique<rtc::TaskQueue>(
+              parallel_encode_factory_->CreateTaskQueue(
+                  "SimulcastEncode", TaskQueueFactory::Priority::NORMAL)));
+    }
+  }
+
   // To save memory, don't store encoders that we don't use.
   DestroyStoredEncoders();
 
@@ -483,12 +556,53 @@ int SimulcastEncoderAdapter::Encode(
     }
   }
 
-  // Temporary thay may hold the result of texture to i420 buffer conversion.
-  rtc::scoped_refptr<VideoFrameBuffer> src_buffer;
-  int src_width = input_image.width();
-  int src_height = input_image.height();
+  // Native buffers are encoded one layer at a time, since they may not
+  // support being scaled from several threads at once.
+  const bool encode_in_parallel =
+      !encode_queues_.empty() && input_image.video_frame_buffer()->type() !=
+                                     VideoFrameBuffer::Type::kNative;
+  // The layers are scaled from each other rather than all from the input.
+  std::vector<VideoFrameBufferPyramid::Resolution> resolutions;
+  // The formats that all layers scaled by the adapter take, if the input is a
+  // native buffer that some of them can't encode.
+  const bool is_native_input = input_image.video_frame_buffer()->type() ==
+                               VideoFrameBuffer::Type::kNative;
+  bool maps_native_input = false;
+  absl::InlinedVector<VideoFrameBuffer::Type, kMaxPreferredPixelFormats>
+      mapped_formats = {VideoFrameBuffer::Type::kI420,
+                        VideoFrameBuffer::Type::kNV12};
+  for (const auto& layer : stream_contexts_) {
+    if (layer.is_paused()) {
+      continue;
+    }
+    resolutions.push_back({layer.width(), layer.height()});
+    if (is_native_input && (layer.width() != input_image.width() ||
+                            layer.height() != input_image.height())) {
+      VideoEncoder::EncoderInfo info = layer.encoder().GetEncoderInfo();
+      if (!info.supports_native_handle) {
+        maps_native_input = true;
+        IntersectPreferredPixelFormats(info, &mapped_formats);
+      }
+    }
+  }
+  // Scaling a native buffer usually converts it to I420 first. Mapping it
+  // once to a format the encoders take, e.g. NV12, keeps the layers in that
+  // format and avoids a conversion per layer.
+  rtc::scoped_refptr<VideoFrameBuffer> pyramid_source =
+      input_image.video_frame_buffer();
+  if (maps_native_input && !mapped_formats.empty()) {
+    rtc::scoped_refptr<VideoFrameBuffer> mapped_buffer =
+        pyramid_source->GetMappedFrameBuffer(mapped_formats);
+    if (mapped_buffer) {
+      pyramid_source = mapped_buffer;
+    }
+  }
+  VideoFrameBufferPyramid pyramid(pyramid_source, resolutions,
+                                  number_of_cores_);
 
-  for (auto& layer : stream_contexts_) {
+  std::vector<LayerEncode> layer_encodes;
+  for (size_t i = 0; i < stream_contexts_.size(); ++i) {
+    StreamContext& layer = stream_contexts_[i];
     // Don't encode frames in resolutions that we don't intend to send.
     if (layer.is_paused()) {
       continue;
@@ -515,49 +629,115 @@ int SimulcastEncoderAdapter::Encode(
                 VideoFrameType::kVideoFrameDelta);
     }
 
-    // If scaling isn't required, because the input resolution
-    // matches the destination or the input image is empty (e.g.
-    // a keyframe request for encoders with internal camera
-    // sources) or the source image has a native handle, pass the image on
-    // directly. Otherwise, we'll scale it to match what the encoder expects
-    // (below).
-    // For texture frames, the underlying encoder is expected to be able to
-    // correctly sample/scale the source texture.
-    // TODO(perkj): ensure that works going forward, and figure out how this
-    // affects webrtc:5683.
-    if ((layer.width() == src_width && layer.height() == src_height) ||
-        (input_image.video_frame_buffer()->type() ==
-             VideoFrameBuffer::Type::kNative &&
-         layer.encoder().GetEncoderInfo().supports_native_handle)) {
-      int ret = layer.encoder().Encode(input_image, &stream_frame_types);
-      if (ret != WEBRTC_VIDEO_CODEC_OK) {
-        return ret;
-      }
-    } else {
-      if (src_buffer == nullptr) {
-        src_buffer = input_image.video_frame_buffer();
-      }
-      rtc::scoped_refptr<VideoFrameBuffer> dst_buffer =
-          src_buffer->Scale(layer.width(), layer.height());
-      if (!dst_buffer) {
-        RTC_LOG(LS_ERROR) << "Failed to scale video frame";
-        return WEBRTC_VIDEO_CODEC_ENCODER_FAILURE;
-      }
-
-      // UpdateRect is not propagated to lower simulcast layers currently.
-      // TODO(ilnik): Consider scaling UpdateRect together with the buffer.
-      VideoFrame frame(input_image);
-      frame.set_video_frame_buffer(dst_buffer);
-      frame.set_rotation(webrtc::kVideoRotation_0);
-      frame.set_update_rect(
-          VideoFrame::UpdateRect{0, 0, frame.width(), frame.height()});
-      int ret = layer.encoder().Encode(frame, &stream_frame_types);
-      if (ret != WEBRTC_VIDEO_CODEC_OK) {
-        return ret;
-      }
+    if (encode_in_parallel) {
+      layer_encodes.push_back({i, std::move(stream_frame_types)});
+      continue;
     }
+    int ret = EncodeLayer(layer, input_image, pyramid, &stream_frame_types);
+    if (ret != WEBRTC_VIDEO_CODEC_OK) {
+      return ret;
+    }
+  }
+
+  if (layer_encodes.size() == 1) {
+    return EncodeLayer(stream_contexts_[layer_encodes[0].layer_index],
+                       input_image, pyramid, &layer_encodes[0].frame_types);
+  }
+  if (layer_encodes.size() > 1) {
+    return EncodeLayersInParallel(input_image, pyramid, layer_encodes);
+  }
+  return WEBRTC_VIDEO_CODEC_OK;
+}
+
+int SimulcastEncoderAdapter::EncodeLayer(
+    StreamContext& layer,
+    const VideoFrame& input_image,
+    VideoFrameBufferPyramid& pyramid,
+    std::vector<VideoFrameType>* frame_types) {
+  // If scaling isn't required, because the input resolution
+  // matches the destination or the input image is empty (e.g.
+  // a keyframe request for encoders with internal camera
+  // sources) or the source image has a native handle, pass the image on
+  // directly. Otherwise, we'll scale it to match what the encoder expects
+  // (below).
+  // For texture frames, the underlying encoder is expected to be able to
+  // correctly sample/scale the source texture.
+  // TODO(perkj): ensure that works going forward, and figure out how this
+  // affects webrtc:5683.
+  if ((layer.width() == input_image.width() &&
+       layer.height() == input_image.height()) ||
+      (input_image.video_frame_buffer()->type() ==
+           VideoFrameBuffer::Type::kNative &&
+       layer.encoder().GetEncoderInfo().supports_native_handle)) {
+    return layer.encoder().Encode(input_image, frame_types);
+  }
+
+  rtc::scoped_refptr<VideoFrameBuffer> dst_buffer =
+      pyramid.GetScaled(layer.width(), layer.height());
+  if (!dst_buffer) {
+    RTC_LOG(LS_ERROR) << "Failed to scale video frame";
+    return WEBRTC_VIDEO_CODEC_ENCODER_FAILURE;
+  }
+
+  // The update rect is scaled together with the buffer, so that encoders of
+  // lower layers can skip the unchanged regions too.
+  VideoFrame frame(input_image);
+  frame.set_video_frame_buffer(dst_buffer);
+  frame.set_rotation(webrtc::kVideoRotation_0);
+  frame.set_update_rect(input_image.update_rect().ScaleWithFrame(
+      input_image.width(), input_image.height(), 0, 0, input_image.width(),
+      input_image.height(), frame.width(), frame.height()));
+  return layer.encoder().Encode(frame, frame_types);
+}
+
+int SimulcastEncoderAdapter::EncodeLayersInParallel(
+    const VideoFrame& input_image,
+    VideoFrameBufferPyramid& pyramid,
+    std::vector<LayerEncode>& layer_encodes) {
+  {
+    MutexLock lock(&deferred_images_mutex_);
+    defer_encoded_images_ = true;
   }
 
+  // The last layer, which has the highest resolution, is encoded on this
+  // thread while the other layers are encoded on their queues.
+  std::vector<int> results(layer_encodes.size(), WEBRTC_VIDEO_CODEC_OK);
+  std::vector<rtc::Event> done(layer_encodes.size() - 1);
+  for (size_t i = 0; i < done.size(); ++i) {
+    encode_queues_[layer_encodes[i].layer_index]->PostTask([&, i] {
+      results[i] =
+          EncodeLayer(stream_contexts_[layer_encodes[i].layer_index],
+                      input_image, pyramid, &layer_encodes[i].frame_types);
+      done[i].Set();
+    });
+  }
+  results.back() =
+      EncodeLayer(stream_contexts_[layer_encodes.back().layer_index],
+                  input_image, pyramid, &layer_encodes.back().frame_types);
+  for (rtc::Event& layer_done : done) {
+    layer_done.Wait(rtc::Event::kForever);
+  }
+
+  std::vector<DeferredImage> deferred_images;
+  {
+    MutexLock lock(&deferred_images_mutex_);
+    defer_encoded_images_ = false;
+    deferred_images.swap(deferred_images_);
+  }
+  absl::c_stable_sort(deferred_images,
+                      [](const DeferredImage& a, const DeferredImage& b) {
+                        return a.stream_idx < b.stream_idx;
+                      });
+  for (const DeferredImage& image : deferred_images) {
+    encoded_complete_callback_->OnEncodedImage(image.encoded_image,
+                                               &image.codec_specific_info);
+  }
+
+  for (int result : results) {
+    if (result != WEBRTC_VIDEO_CODEC_OK) {
+      return result;
+    }
+  }
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
@@ -565,7 +745,8 @@ int SimulcastEncoderAdapter::RegisterEncodeCompleteCallback(
     EncodedImageCallback* callback) {
   RTC_DCHECK_RUN_ON(&encoder_queue_);
   encoded_complete_callback_ = callback;
-  if (!stream_contexts_.empty() && stream_contexts_.front().stream_idx() == 0) {
+  if (!stream_contexts_.empty() && stream_contexts_.front().stream_idx() == 0 &&
+      encode_queues_.empty()) {
     // Bypass frame encode complete callback for the lowest layer since there is
     // no need to override frame's spatial index.
     stream_contexts_.front().encoder().RegisterEncodeCompleteCallback(callback);
@@ -669,6 +850,21 @@ EncodedImageCallback::Result SimulcastEncoderAdapter::OnEncodedImage(
 
   stream_image.SetSpatialIndex(stream_idx);
 
+  {
+    MutexLock lock(&deferred_images_mutex_);
+    if (defer_encoded_images_) {
+      // The encoder may reuse its buffer once this returns.
+      if (encodedImage.data()) {
+        stream_image.SetEncodedData(EncodedImageBuffer::Create(
+            encodedImage.data(), encodedImage.size()));
+      }
+      deferred_images_.push_back(
+          {stream_idx, std::move(stream_image), stream_codec_specific});
+      return EncodedImageCallback::Result(EncodedImageCallback::Result::OK,
+                                          encodedImage.Timestamp());
+    }
+  }
+
   return encoded_complete_callback_->OnEncodedImage(stream_image,
                                                     &stream_codec_specific);
 }
@@ -874,6 +1070,13 @@ VideoEncoder::EncoderInfo SimulcastEncoderAdapter::GetEncoderInfo() const {
       encoder_info.apply_alignment_to_all_simulcast_layers = true;
     }
 
+    encoder_info.preferred_pixel_formats = PreferredPixelFormats(primary_info);
+    IntersectPreferredPixelFormats(fallback_info,
+                                   &encoder_info.preferred_pixel_formats);
+    if (encoder_info.preferred_pixel_formats.empty()) {
+      encoder_info.preferred_pixel_formats = {VideoFrameBuffer::Type::kI420};
+    }
+
     cached_encoder_contexts_.emplace_back(std::move(encoder_context));
 
     OverrideFromFieldTrial(&encoder_info);
@@ -897,6 +1100,10 @@ VideoEncoder::EncoderInfo SimulcastEncoderAdapter::GetEncoderInfo() const {
       encoder_info.is_hardware_accelerated =
           encoder_impl_info.is_hardware_accelerated;
       encoder_info.is_qp_trusted = encoder_impl_info.is_qp_trusted;
+      encoder_info.preferred_pixel_formats =
+          PreferredPixelFormats(encoder_impl_info);
+      encoder_info.max_frames_in_flight =
+          encoder_impl_info.max_frames_in_flight;
     } else {
       encoder_info.implementation_name += ", ";
       encoder_info.implementation_name += encoder_impl_info.implementation_name;
@@ -921,6 +1128,20 @@ VideoEncoder::EncoderInfo SimulcastEncoderAdapter::GetEncoderInfo() const {
       encoder_info.is_qp_trusted =
           encoder_info.is_qp_trusted.value_or(true) &&
           encoder_impl_info.is_qp_trusted.value_or(true);
+
+      // Only formats that all encoders prefer, so that a frame mapped to one
+      // of them can be scaled for any layer without conversion.
+      IntersectPreferredPixelFormats(encoder_impl_info,
+                                     &encoder_info.preferred_pixel_formats);
+
+      // All layers are encoded from the same input frame, so the encoder
+      // with the fewest frames in flight limits them for all.
+      if (encoder_impl_info.max_frames_in_flight.has_value()) {
+        encoder_info.max_frames_in_flight =
+            std::min(encoder_info.max_frames_in_flight.value_or(
+                         *encoder_impl_info.max_frames_in_flight),
+                     *encoder_impl_info.max_frames_in_flight);
+      }
     }
     encoder_info.fps_allocation[i] = encoder_impl_info.fps_allocation[0];
     encoder_info.requested_resolution_alignment = cricket::LeastCommonMultiple(
@@ -936,6 +1157,9 @@ VideoEncoder::EncoderInfo SimulcastEncoderAdapter::GetEncoderInfo() const {
     }
   }
   encoder_info.implementation_name += ")";
+  if (encoder_info.preferred_pixel_formats.empty()) {
+    encoder_info.preferred_pixel_formats = {VideoFrameBuffer::Type::kI420};
+  }
 
   OverrideFromFieldTrial(&encoder_info);
 
@@ -22,15 +22,20 @@
 #include "absl/types/optional.h"
 #include "api/fec_controller_override.h"
 #include "api/sequence_checker.h"
+#include "api/task_queue/task_queue_factory.h"
 #include "api/video_codecs/sdp_video_format.h"
 #include "api/video_codecs/video_encoder.h"
 #include "api/video_codecs/video_encoder_factory.h"
 #include "common_video/framerate_controller.h"
+#include "common_video/include/video_frame_buffer_pyramid.h"
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "rtc_base/atomic_ops.h"
 #include "rtc_base/experiments/encoder_info_settings.h"
+#include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/system/no_unique_address.h"
 #include "rtc_base/system/rtc_export.h"
+#include "rtc_base/task_queue.h"
+#include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
 
@@ -142,6 +147,21 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
     bool is_paused_;
   };
 
+  // A layer to encode the current frame in, with the frame types to pass to
+  // its encoder.
+  struct LayerEncode {
+    size_t layer_index;
+    std::vector<VideoFrameType> frame_types;
+  };
+
+  // An encoded image of a frame encoded in parallel, held until all layers of
+  // the frame are encoded so that the images are delivered in layer order.
+  struct DeferredImage {
+    size_t stream_idx;
+    EncodedImage encoded_image;
+    CodecSpecificInfo codec_specific_info;
+  };
+
   bool Initialized() const;
 
   void DestroyStoredEncoders();
@@ -165,6 +185,19 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
 
   void OnDroppedFrame(size_t stream_idx);
 
+  // Scales `input_image` to the resolution of `layer` through `pyramid` if
+  // needed, and encodes it.
+  int EncodeLayer(StreamContext& layer,
+                  const VideoFrame& input_image,
+                  VideoFrameBufferPyramid& pyramid,
+                  std::vector<VideoFrameType>* frame_types);
+  // Encodes the layers on `encode_queues_`, except the last one which is
+  // encoded on the calling thread, and delivers the encoded images once all
+  // layers are done. Returns the error of the first layer that failed.
+  int EncodeLayersInParallel(const VideoFrame& input_image,
+                             VideoFrameBufferPyramid& pyramid,
+                             std::vector<LayerEncode>& layer_encodes);
+
   void OverrideFromFieldTrial(VideoEncoder::EncoderInfo* info) const;
 
   volatile int inited_;  // Accessed atomically.
@@ -191,6 +224,22 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
   const bool prefer_temporal_support_on_base_layer_;
 
   const SimulcastEncoderAdapterEncoderInfoSettings encoder_info_override_;
+
+  // From the settings of InitEncode(). Large frames are scaled to the
+  // resolutions of the layers on up to this many threads.
+  int number_of_cores_ = 1;
+
+  // Threads shared by the adapters of the process to encode the layers of a
+  // frame in parallel, or null if the layers are encoded one after the other.
+  TaskQueueFactory* const parallel_encode_factory_;
+  // Queues encoding the layers of `stream_contexts_`, by index, when the
+  // layers are encoded in parallel. Empty otherwise.
+  std::vector<std::unique_ptr<rtc::TaskQueue>> encode_queues_;
+
+  Mutex deferred_images_mutex_;
+  bool defer_encoded_images_ RTC_GUARDED_BY(deferred_images_mutex_) = false;
+  std::vector<DeferredImage> deferred_images_
+      RTC_GUARDED_BY(deferred_images_mutex_);
 };
 
 }  // namespace webrtc
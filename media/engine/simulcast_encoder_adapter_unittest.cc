@@ -14,10 +14,12 @@
 #include <memory>
 #include <vector>
 
+#include "absl/algorithm/container.h"
 #include "api/test/create_simulcast_test_fixture.h"
 #include "api/test/simulcast_test_fixture.h"
 #include "api/test/video/function_video_decoder_factory.h"
 #include "api/test/video/function_video_encoder_factory.h"
+#include "api/video/nv12_buffer.h"
 #include "api/video/video_codec_constants.h"
 #include "api/video_codecs/sdp_video_format.h"
 #include "api/video_codecs/video_encoder.h"
@@ -29,11 +31,13 @@
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "modules/video_coding/utility/simulcast_test_fixture_impl.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/event.h"
 #include "test/field_trial.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
 using ::testing::_;
+using ::testing::ElementsAre;
 using ::testing::Return;
 using EncoderInfo = webrtc::VideoEncoder::EncoderInfo;
 using FramerateFractions =
@@ -245,6 +249,7 @@ class MockVideoEncoder : public VideoEncoder {
     info.fps_allocation[0] = fps_allocation_;
     info.supports_simulcast = supports_simulcast_;
     info.is_qp_trusted = is_qp_trusted_;
+    info.preferred_pixel_formats = preferred_pixel_formats_;
     return info;
   }
 
@@ -312,6 +317,12 @@ class MockVideoEncoder : public VideoEncoder {
     is_qp_trusted_ = is_qp_trusted;
   }
 
+  void set_preferred_pixel_formats(
+      absl::InlinedVector<VideoFrameBuffer::Type, kMaxPreferredPixelFormats>
+          formats) {
+    preferred_pixel_formats_ = formats;
+  }
+
   bool supports_simulcast() const { return supports_simulcast_; }
 
   SdpVideoFormat video_format() const { return video_format_; }
@@ -330,6 +341,8 @@ class MockVideoEncoder : public VideoEncoder {
   FramerateFractions fps_allocation_;
   bool supports_simulcast_ = false;
   absl::optional<bool> is_qp_trusted_;
+  absl::InlinedVector<VideoFrameBuffer::Type, kMaxPreferredPixelFormats>
+      preferred_pixel_formats_;
   SdpVideoFormat video_format_;
 
   VideoCodec codec_;
@@ -1030,6 +1043,34 @@ TEST_F(TestSimulcastEncoderAdapterFake,
   EXPECT_EQ(0, adapter_->Encode(input_frame, &frame_types));
 }
 
+// A native buffer that can be mapped to NV12, but not converted to I420.
+class FakeNativeBufferNV12 : public VideoFrameBuffer {
+ public:
+  FakeNativeBufferNV12(int width, int height)
+      : width_(width), height_(height) {}
+
+  Type type() const override { return Type::kNative; }
+  int width() const override { return width_; }
+  int height() const override { return height_; }
+
+  rtc::scoped_refptr<I420BufferInterface> ToI420() override {
+    RTC_DCHECK_NOTREACHED();
+    return nullptr;
+  }
+
+  rtc::scoped_refptr<VideoFrameBuffer> GetMappedFrameBuffer(
+      rtc::ArrayView<Type> types) override {
+    if (absl::c_linear_search(types, Type::kNV12)) {
+      return NV12Buffer::Create(width_, height_);
+    }
+    return nullptr;
+  }
+
+ private:
+  const int width_;
+  const int height_;
+};
+
 TEST_F(TestSimulcastEncoderAdapterFake, NativeHandleForwardingOnlyIfSupported) {
   SimulcastTestFixtureImpl::DefaultSettings(
       &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
@@ -1076,6 +1117,115 @@ TEST_F(TestSimulcastEncoderAdapterFake, NativeHandleForwardingOnlyIfSupported) {
   EXPECT_EQ(0, adapter_->Encode(input_frame, &frame_types));
 }
 
+TEST_F(TestSimulcastEncoderAdapterFake,
+       MapsNativeHandleToPreferredFormatForScaledLayers) {
+  SimulcastTestFixtureImpl::DefaultSettings(
+      &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
+      kVideoCodecVP8);
+  codec_.numberOfSimulcastStreams = 3;
+  // High start bitrate, so all streams are enabled.
+  codec_.startBitrate = 3000;
+  EXPECT_EQ(0, adapter_->InitEncode(&codec_, kSettings));
+  adapter_->RegisterEncodeCompleteCallback(this);
+  ASSERT_EQ(3u, helper_->factory()->encoders().size());
+
+  auto& encoders = helper_->factory()->encoders();
+  for (MockVideoEncoder* encoder : encoders) {
+    encoder->set_preferred_pixel_formats(
+        {VideoFrameBuffer::Type::kI420, VideoFrameBuffer::Type::kNV12});
+  }
+  EXPECT_EQ(0, adapter_->InitEncode(&codec_, kSettings));
+
+  rtc::scoped_refptr<VideoFrameBuffer> buffer(
+      rtc::make_ref_counted<FakeNativeBufferNV12>(1280, 720));
+  VideoFrame input_frame = VideoFrame::Builder()
+                               .set_video_frame_buffer(buffer)
+                               .set_timestamp_rtp(100)
+                               .set_timestamp_ms(1000)
+                               .build();
+  // The full resolution layer gets the input frame verbatim, and maps it
+  // itself...
+  EXPECT_CALL(*encoders[2], Encode(::testing::Ref(input_frame), _)).Times(1);
+  // ...while the scaled layers are scaled from the mapped NV12 buffer.
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_CALL(*encoders[i], Encode)
+        .WillOnce([](const VideoFrame& frame,
+                     const std::vector<VideoFrameType>* frame_types) {
+          EXPECT_EQ(frame.video_frame_buffer()->type(),
+                    VideoFrameBuffer::Type::kNV12);
+          return 0;
+        });
+  }
+  std::vector<VideoFrameType> frame_types(3, VideoFrameType::kVideoFrameKey);
+  EXPECT_EQ(0, adapter_->Encode(input_frame, &frame_types));
+}
+
+TEST_F(TestSimulcastEncoderAdapterFake, ScalesUpdateRectForScaledLayers) {
+  SimulcastTestFixtureImpl::DefaultSettings(
+      &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
+      kVideoCodecVP8);
+  codec_.numberOfSimulcastStreams = 3;
+  // High start bitrate, so all streams are enabled.
+  codec_.startBitrate = 3000;
+  EXPECT_EQ(0, adapter_->InitEncode(&codec_, kSettings));
+  adapter_->RegisterEncodeCompleteCallback(this);
+  ASSERT_EQ(3u, helper_->factory()->encoders().size());
+  auto& encoders = helper_->factory()->encoders();
+
+  rtc::scoped_refptr<I420Buffer> buffer(I420Buffer::Create(1280, 720));
+  VideoFrame input_frame =
+      VideoFrame::Builder()
+          .set_video_frame_buffer(buffer)
+          .set_timestamp_rtp(100)
+          .set_timestamp_ms(1000)
+          .set_update_rect(VideoFrame::UpdateRect{640, 360, 64, 64})
+          .build();
+  std::vector<VideoFrame::UpdateRect> update_rects(2);
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_CALL(*encoders[i], Encode)
+        .WillOnce([&update_rects, i](
+                      const VideoFrame& frame,
+                      const std::vector<VideoFrameType>* frame_types) {
+          update_rects[i] = frame.update_rect();
+          return 0;
+        });
+  }
+  EXPECT_CALL(*encoders[2], Encode(::testing::Ref(input_frame), _)).Times(1);
+  std::vector<VideoFrameType> frame_types(3, VideoFrameType::kVideoFrameDelta);
+  EXPECT_EQ(0, adapter_->Encode(input_frame, &frame_types));
+
+  // Scaled with the frame, plus a margin of 2 pixels for the scaling filter.
+  EXPECT_EQ(update_rects[0], (VideoFrame::UpdateRect{158, 88, 20, 20}));
+  EXPECT_EQ(update_rects[1], (VideoFrame::UpdateRect{318, 178, 36, 36}));
+}
+
+TEST_F(TestSimulcastEncoderAdapterFake,
+       ReportsPixelFormatsPreferredByAllEncoders) {
+  SimulcastTestFixtureImpl::DefaultSettings(
+      &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
+      kVideoCodecVP8);
+  codec_.numberOfSimulcastStreams = 3;
+  EXPECT_EQ(0, adapter_->InitEncode(&codec_, kSettings));
+  ASSERT_EQ(3u, helper_->factory()->encoders().size());
+  auto& encoders = helper_->factory()->encoders();
+  for (MockVideoEncoder* encoder : encoders) {
+    encoder->set_preferred_pixel_formats(
+        {VideoFrameBuffer::Type::kI420, VideoFrameBuffer::Type::kNV12});
+  }
+  EXPECT_THAT(adapter_->GetEncoderInfo().preferred_pixel_formats,
+              ElementsAre(VideoFrameBuffer::Type::kI420,
+                          VideoFrameBuffer::Type::kNV12));
+
+  encoders[1]->set_preferred_pixel_formats({VideoFrameBuffer::Type::kNV12});
+  EXPECT_THAT(adapter_->GetEncoderInfo().preferred_pixel_formats,
+              ElementsAre(VideoFrameBuffer::Type::kNV12));
+
+  // Without a common format, the encoders get I420.
+  encoders[2]->set_preferred_pixel_formats({VideoFrameBuffer::Type::kI420});
+  EXPECT_THAT(adapter_->GetEncoderInfo().preferred_pixel_formats,
+              ElementsAre(VideoFrameBuffer::Type::kI420));
+}
+
 TEST_F(TestSimulcastEncoderAdapterFake, TestFailureReturnCodesFromEncodeCalls) {
   SimulcastTestFixtureImpl::DefaultSettings(
       &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
@@ -1732,5 +1882,65 @@ TEST_F(TestSimulcastEncoderAdapterFake,
             adapter_->InitEncode(&codec_, kSettings));
 }
 
+TEST_F(TestSimulcastEncoderAdapterFake, EncodesLayersInParallelWhenEnabled) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-SimulcastEncoderAdapter-ParallelEncode/Enabled/");
+  ReSetUp();
+  SetupCodec();
+  adapter_->SetRates(VideoEncoder::RateControlParameters(
+      rate_allocator_->Allocate(VideoBitrateAllocationParameters(3000000, 30)),
+      30.0));
+  std::vector<MockVideoEncoder*> encoders = helper_->factory()->encoders();
+  ASSERT_EQ(3u, encoders.size());
+
+  class SimulcastIndexRecorder : public EncodedImageCallback {
+   public:
+    Result OnEncodedImage(const EncodedImage& encoded_image,
+                          const CodecSpecificInfo* /*codec_specific_info*/)
+        override {
+      simulcast_indices.push_back(encoded_image.SpatialIndex().value_or(-1));
+      return Result(Result::OK);
+    }
+    std::vector<int> simulcast_indices;
+  } recorder;
+  adapter_->RegisterEncodeCompleteCallback(&recorder);
+
+  // The lower layers only finish encoding once the top layer has started,
+  // which requires the layers to be encoded at the same time. The images are
+  // still delivered in layer order.
+  rtc::Event top_layer_started(/*manual_reset=*/true,
+                               /*initially_signaled=*/false);
+  for (int i = 0; i < 2; ++i) {
+    MockVideoEncoder* encoder = encoders[i];
+    EXPECT_CALL(*encoder, Encode)
+        .WillOnce([&, encoder](const VideoFrame& frame,
+                               const std::vector<VideoFrameType>*) {
+          EXPECT_TRUE(top_layer_started.Wait(5000));
+          encoder->SendEncodedImage(frame.width(), frame.height());
+          return WEBRTC_VIDEO_CODEC_OK;
+        });
+  }
+  EXPECT_CALL(*encoders[2], Encode)
+      .WillOnce([&](const VideoFrame& frame,
+                    const std::vector<VideoFrameType>*) {
+        top_layer_started.Set();
+        encoders[2]->SendEncodedImage(frame.width(), frame.height());
+        return WEBRTC_VIDEO_CODEC_OK;
+      });
+
+  rtc::scoped_refptr<I420Buffer> input_buffer =
+      I420Buffer::Create(kDefaultWidth, kDefaultHeight);
+  input_buffer->InitializeData();
+  VideoFrame input_frame = VideoFrame::Builder()
+                               .set_video_frame_buffer(input_buffer)
+                               .set_timestamp_rtp(0)
+                               .set_timestamp_us(0)
+                               .set_rotation(kVideoRotation_0)
+                               .build();
+  std::vector<VideoFrameType> frame_types(3, VideoFrameType::kVideoFrameKey);
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, adapter_->Encode(input_frame, &frame_types));
+  EXPECT_THAT(recorder.simulcast_indices, ElementsAre(0, 1, 2));
+}
+
 }  // namespace test
 }  // namespace webrtc
@@ -689,6 +689,12 @@ WebRtcVideoChannel::WebRtcVideoChannel(
     webrtc::VideoBitrateAllocatorFactory* bitrate_allocator_factory)
     : VideoMediaChannel(config, call->network_thread()),
       worker_thread_(call->worker_thread()),
+      received_packets_(
+          worker_thread_,
+          task_safety_.flag(),
+          [this](rtc::CopyOnWriteBuffer packet, int64_t packet_time_us) {
+            ProcessReceivedPacket(std::move(packet), packet_time_us);
+          }),
       call_(call),
       unsignalled_ssrc_handler_(&default_unsignalled_ssrc_handler_),
       video_config_(config.video),
@@ -1719,88 +1725,90 @@ void WebRtcVideoChannel::OnPacketReceived(rtc::CopyOnWriteBuffer packet,
   // consistency it would be good to move the interaction with call_->Receiver()
   // to a common implementation and provide a callback on the worker thread
   // for the exception case (DELIVERY_UNKNOWN_SSRC) and how retry is attempted.
-  worker_thread_->PostTask(
-      ToQueuedTask(task_safety_, [this, packet, packet_time_us] {
-        RTC_DCHECK_RUN_ON(&thread_checker_);
-        const webrtc::PacketReceiver::DeliveryStatus delivery_result =
-            call_->Receiver()->DeliverPacket(webrtc::MediaType::VIDEO, packet,
-                                             packet_time_us);
-        switch (delivery_result) {
-          case webrtc::PacketReceiver::DELIVERY_OK:
-            return;
-          case webrtc::PacketReceiver::DELIVERY_PACKET_ERROR:
-            return;
-          case webrtc::PacketReceiver::DELIVERY_UNKNOWN_SSRC:
-            break;
-        }
+  received_packets_.Push(std::move(packet), packet_time_us);
+}
 
-        uint32_t ssrc = ParseRtpSsrc(packet);
+void WebRtcVideoChannel::ProcessReceivedPacket(rtc::CopyOnWriteBuffer packet,
+                                               int64_t packet_time_us) {
+  RTC_DCHECK_RUN_ON(&thread_checker_);
+  const webrtc::PacketReceiver::DeliveryStatus delivery_result =
+      call_->Receiver()->DeliverPacket(webrtc::MediaType::VIDEO, packet,
+                                       packet_time_us);
+  switch (delivery_result) {
+    case webrtc::PacketReceiver::DELIVERY_OK:
+      return;
+    case webrtc::PacketReceiver::DELIVERY_PACKET_ERROR:
+      return;
+    case webrtc::PacketReceiver::DELIVERY_UNKNOWN_SSRC:
+      break;
+  }
 
-        if (unknown_ssrc_packet_buffer_) {
-          unknown_ssrc_packet_buffer_->AddPacket(ssrc, packet_time_us, packet);
-          return;
-        }
+  uint32_t ssrc = ParseRtpSsrc(packet);
 
-        if (discard_unknown_ssrc_packets_) {
-          return;
-        }
+  if (unknown_ssrc_packet_buffer_) {
+    unknown_ssrc_packet_buffer_->AddPacket(ssrc, packet_time_us, packet);
+    return;
+  }
 
-        int payload_type = ParseRtpPayloadType(packet);
-
-        // See if this payload_type is registered as one that usually gets its
-        // own SSRC (RTX) or at least is safe to drop either way (FEC). If it
-        // is, and it wasn't handled above by DeliverPacket, that means we don't
-        // know what stream it associates with, and we shouldn't ever create an
-        // implicit channel for these.
-        for (auto& codec : recv_codecs_) {
-          if (payload_type == codec.rtx_payload_type ||
-              payload_type == codec.ulpfec.red_rtx_payload_type ||
-              payload_type == codec.ulpfec.ulpfec_payload_type) {
-            return;
-          }
-        }
-        if (payload_type == recv_flexfec_payload_type_) {
-          return;
-        }
+  if (discard_unknown_ssrc_packets_) {
+    return;
+  }
 
-        // Ignore unknown ssrcs if there is a demuxer criteria update pending.
-        // During a demuxer update we may receive ssrcs that were recently
-        // removed or we may receve ssrcs that were recently configured for a
-        // different video channel.
-        if (demuxer_criteria_id_ != demuxer_criteria_completed_id_) {
-          return;
-        }
-        // Ignore unknown ssrcs if we recently created an unsignalled receive
-        // stream since this shouldn't happen frequently. Getting into a state
-        // of creating decoders on every packet eats up processing time (e.g.
-        // https://crbug.com/1069603) and this cooldown prevents that.
-        if (last_unsignalled_ssrc_creation_time_ms_.has_value()) {
-          int64_t now_ms = rtc::TimeMillis();
-          if (now_ms - last_unsignalled_ssrc_creation_time_ms_.value() <
-              kUnsignaledSsrcCooldownMs) {
-            // We've already created an unsignalled ssrc stream within the last
-            // 0.5 s, ignore with a warning.
-            RTC_LOG(LS_WARNING)
-                << "Another unsignalled ssrc packet arrived shortly after the "
-                << "creation of an unsignalled ssrc stream. Dropping packet.";
-            return;
-          }
-        }
-        // Let the unsignalled ssrc handler decide whether to drop or deliver.
-        switch (unsignalled_ssrc_handler_->OnUnsignalledSsrc(this, ssrc)) {
-          case UnsignalledSsrcHandler::kDropPacket:
-            return;
-          case UnsignalledSsrcHandler::kDeliverPacket:
-            break;
-        }
+  int payload_type = ParseRtpPayloadType(packet);
 
-        if (call_->Receiver()->DeliverPacket(webrtc::MediaType::VIDEO, packet,
-                                             packet_time_us) !=
-            webrtc::PacketReceiver::DELIVERY_OK) {
-          RTC_LOG(LS_WARNING) << "Failed to deliver RTP packet on re-delivery.";
-        }
-        last_unsignalled_ssrc_creation_time_ms_ = rtc::TimeMillis();
-      }));
+  // See if this payload_type is registered as one that usually gets its
+  // own SSRC (RTX) or at least is safe to drop either way (FEC). If it
+  // is, and it wasn't handled above by DeliverPacket, that means we don't
+  // know what stream it associates with, and we shouldn't ever create an
+  // implicit channel for these.
+  for (auto& codec : recv_codecs_) {
+    if (payload_type == codec.rtx_payload_type ||
+        payload_type == codec.ulpfec.red_rtx_payload_type ||
+        payload_type == codec.ulpfec.ulpfec_payload_type) {
+      return;
+    }
+  }
+  if (payload_type == recv_flexfec_payload_type_) {
+    return;
+  }
+
+  // Ignore unknown ssrcs if there is a demuxer criteria update pending.
+  // During a demuxer update we may receive ssrcs that were recently
+  // removed or we may receve ssrcs that were recently configured for a
+  // different video channel.
+  if (demuxer_criteria_id_ != demuxer_criteria_completed_id_) {
+    return;
+  }
+  // Ignore unknown ssrcs if we recently created an unsignalled receive
+  // stream since this shouldn't happen frequently. Getting into a state
+  // of creating decoders on every packet eats up processing time (e.g.
+  // https://crbug.com/1069603) and this cooldown prevents that.
+  if (last_unsignalled_ssrc_creation_time_ms_.has_value()) {
+    int64_t now_ms = rtc::TimeMillis();
+    if (now_ms - last_unsignalled_ssrc_creation_time_ms_.value() <
+        kUnsignaledSsrcCooldownMs) {
+      // We've already created an unsignalled ssrc stream within the last
+      // 0.5 s, ignore with a warning.
+      RTC_LOG(LS_WARNING)
+          << "Another unsignalled ssrc packet arrived shortly after the "
+          << "creation of an unsignalled ssrc stream. Dropping packet.";
+      return;
+    }
+  }
+  // Let the unsignalled ssrc handler decide whether to drop or deliver.
+  switch (unsignalled_ssrc_handler_->OnUnsignalledSsrc(this, ssrc)) {
+    case UnsignalledSsrcHandler::kDropPacket:
+      return;
+    case UnsignalledSsrcHandler::kDeliverPacket:
+      break;
+  }
+
+  if (call_->Receiver()->DeliverPacket(webrtc::MediaType::VIDEO, packet,
+                                       packet_time_us) !=
+      webrtc::PacketReceiver::DELIVERY_OK) {
+    RTC_LOG(LS_WARNING) << "Failed to deliver RTP packet on re-delivery.";
+  }
+  last_unsignalled_ssrc_creation_time_ms_ = rtc::TimeMillis();
 }
 
 void WebRtcVideoChannel::OnPacketSent(const rtc::SentPacket& sent_packet) {
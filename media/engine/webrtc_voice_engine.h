@@ -25,6 +25,7 @@
 #include "call/audio_state.h"
 #include "call/call.h"
 #include "media/base/media_engine.h"
+#include "media/base/packet_handoff_queue.h"
 #include "media/base/rtp_utils.h"
 #include "modules/async_audio_processing/async_audio_processing.h"
 #include "rtc_base/buffer.h"
@@ -258,10 +259,14 @@ class WebRtcVoiceMediaChannel final : public VoiceMediaChannel,
   // Check if 'ssrc' is an unsignaled stream, and if so mark it as not being
   // unsignaled anymore (i.e. it is now removed, or signaled), and return true.
   bool MaybeDeregisterUnsignaledRecvStream(uint32_t ssrc);
+  // Delivers a packet handed over by OnPacketReceived on the worker thread.
+  void ProcessReceivedPacket(rtc::CopyOnWriteBuffer packet,
+                             int64_t packet_time_us);
 
   webrtc::TaskQueueBase* const worker_thread_;
   webrtc::ScopedTaskSafety task_safety_;
   webrtc::SequenceChecker network_thread_checker_;
+  PacketHandoffQueue received_packets_;
 
   WebRtcVoiceEngine* const engine_ = nullptr;
   std::vector<AudioCodec> send_codecs_;
@@ -18,6 +18,7 @@
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
 #include "api/array_view.h"
+#include "api/priority.h"
 #include "media/base/media_channel.h"
 #include "net/dcsctp/public/dcsctp_socket_factory.h"
 #include "net/dcsctp/public/packet_observer.h"
@@ -83,6 +84,21 @@ absl::optional<DataMessageType> ToDataMessageType(dcsctp::PPID ppid) {
   return absl::nullopt;
 }
 
+// The priorities of https://www.rfc-editor.org/rfc/rfc8832.html#section-5.1,
+// which are relative to each other.
+dcsctp::StreamPriority ToStreamPriority(Priority priority) {
+  switch (priority) {
+    case Priority::kVeryLow:
+      return dcsctp::StreamPriority(128);
+    case Priority::kLow:
+      return dcsctp::StreamPriority(256);
+    case Priority::kMedium:
+      return dcsctp::StreamPriority(512);
+    case Priority::kHigh:
+      return dcsctp::StreamPriority(1024);
+  }
+}
+
 absl::optional<cricket::SctpErrorCauseCode> ToErrorCauseCode(
     dcsctp::ErrorKind error) {
   switch (error) {
@@ -204,6 +220,17 @@ bool DcSctpTransport::OpenStream(int sid) {
   return true;
 }
 
+void DcSctpTransport::SetStreamPriority(int sid, Priority priority) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  if (!socket_) {
+    RTC_LOG(LS_ERROR) << debug_name_ << "->SetStreamPriority(sid=" << sid
+                      << "): Transport is not started.";
+    return;
+  }
+  socket_->SetStreamPriority(dcsctp::StreamID(static_cast<uint16_t>(sid)),
+                             ToStreamPriority(priority));
+}
+
 bool DcSctpTransport::ResetStream(int sid) {
   RTC_LOG(LS_INFO) << debug_name_ << "->ResetStream(" << sid << ").";
   if (!socket_) {
@@ -396,12 +423,14 @@ void DcSctpTransport::OnMessageReceived(dcsctp::DcSctpMessage message) {
   receive_data_params.type = *type;
   // No seq_num available from dcSCTP
   receive_data_params.seq_num = 0;
-  receive_buffer_.Clear();
+  // The buffer is handed over to the data channel, which keeps a reference
+  // to it, so a buffer reused across messages would have to be reallocated
+  // anyway. Allocate it with the size of the payload instead.
+  rtc::CopyOnWriteBuffer receive_buffer;
   if (!IsEmptyPPID(message.ppid()))
-    receive_buffer_.AppendData(message.payload().data(),
-                               message.payload().size());
+    receive_buffer.SetData(message.payload().data(), message.payload().size());
 
-  SignalDataReceived(receive_data_params, receive_buffer_);
+  SignalDataReceived(receive_data_params, receive_buffer);
 }
 
 void DcSctpTransport::OnError(dcsctp::ErrorKind error,
@@ -46,6 +46,7 @@ class DcSctpTransport : public cricket::SctpTransportInternal,
              int remote_sctp_port,
              int max_message_size) override;
   bool OpenStream(int sid) override;
+  void SetStreamPriority(int sid, Priority priority) override;
   bool ResetStream(int sid) override;
   bool SendData(int sid,
                 const SendDataParams& params,
@@ -100,7 +101,6 @@ class DcSctpTransport : public cricket::SctpTransportInternal,
   dcsctp::TaskQueueTimeoutFactory task_queue_timeout_factory_;
   std::unique_ptr<dcsctp::DcSctpSocketInterface> socket_;
   std::string debug_name_ = "DcSctpTransport";
-  rtc::CopyOnWriteBuffer receive_buffer_;
 
   bool ready_to_send_data_ = false;
 };
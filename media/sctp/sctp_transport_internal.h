@@ -18,6 +18,7 @@
 #include <string>
 #include <vector>
 
+#include "api/priority.h"
 #include "api/transport/data_channel_transport_interface.h"
 #include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/thread.h"
@@ -111,6 +112,10 @@ class SctpTransportInternal {
   // used" part. See:
   // https://bugs.chromium.org/p/chromium/issues/detail?id=619849
   virtual bool OpenStream(int sid) = 0;
+  // Sets the priority of an open `sid` relative to the other streams, which
+  // decides its share of the bandwidth when several streams have data to send.
+  // Ignored by implementations that don't support stream priorities.
+  virtual void SetStreamPriority(int sid, webrtc::Priority priority) {}
   // The inverse of OpenStream. Begins the closing procedure, which will
   // eventually result in SignalClosingProcedureComplete on the side that
   // initiates it, and both SignalClosingProcedureStartedRemotely and
@@ -13,6 +13,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 
@@ -180,10 +181,15 @@ int AcmReceiver::GetAudio(int desired_freq_hz,
   // rate from NetEq changes.
   if (need_resampling) {
     // TODO(yujo): handle this more efficiently for muted frames.
+    // Resampling is done in place, so the frame is first given room for both
+    // the input and the resampled audio.
+    int16_t* const data = audio_frame->mutable_data(
+        std::max(current_sample_rate_hz, desired_freq_hz) / 100,
+        audio_frame->num_channels_);
     int samples_per_channel_int = resampler_.Resample10Msec(
-        audio_frame->data(), current_sample_rate_hz, desired_freq_hz,
-        audio_frame->num_channels_, AudioFrame::kMaxDataSizeSamples,
-        audio_frame->mutable_data());
+        data, current_sample_rate_hz, desired_freq_hz,
+        audio_frame->num_channels_,
+        audio_frame->samples_per_channel_ * audio_frame->num_channels_, data);
     if (samples_per_channel_int < 0) {
       RTC_LOG(LS_ERROR)
           << "AcmReceiver::GetAudio - Resampling audio_buffer_ failed.";
@@ -10,7 +10,8 @@
 
 #include "modules/audio_coding/audio_network_adaptor/controller_manager.h"
 
-#include <cmath>
+#include <algorithm>
+#include <limits>
 #include <memory>
 #include <string>
 #include <utility>
@@ -339,22 +340,26 @@ ControllerManagerImpl::ControllerManagerImpl(
     : config_(config),
       controllers_(std::move(controllers)),
       last_reordering_time_ms_(absl::nullopt),
-      last_scoring_point_(0, 0.0) {
-  for (auto& controller : controllers_)
+      last_scoring_point_(0, 0.0),
+      has_scoring_points_(!scoring_points.empty()),
+      sorting_buffer_(controllers_.size()) {
+  for (auto& controller : controllers_) {
     default_sorted_controllers_.push_back(controller.get());
-  sorted_controllers_ = default_sorted_controllers_;
-  for (auto& controller_point : scoring_points) {
-    controller_scoring_points_.insert(std::make_pair(
-        controller_point.first, ScoringPoint(controller_point.second.first,
-                                             controller_point.second.second)));
+    auto it = scoring_points.find(controller.get());
+    controller_scoring_points_.push_back(
+        it == scoring_points.end()
+            ? absl::nullopt
+            : absl::make_optional<ScoringPoint>(it->second.first,
+                                                it->second.second));
   }
+  sorted_controllers_ = default_sorted_controllers_;
 }
 
 ControllerManagerImpl::~ControllerManagerImpl() = default;
 
-std::vector<Controller*> ControllerManagerImpl::GetSortedControllers(
+rtc::ArrayView<Controller* const> ControllerManagerImpl::GetSortedControllers(
     const Controller::NetworkMetrics& metrics) {
-  if (controller_scoring_points_.size() == 0)
+  if (!has_scoring_points_)
     return default_sorted_controllers_;
 
   if (!metrics.uplink_bandwidth_bps || !metrics.uplink_packet_loss_fraction)
@@ -381,41 +386,37 @@ std::vector<Controller*> ControllerManagerImpl::GetSortedControllers(
   // 1) they are less important than any controller that has a scoring point,
   // 2) they are equally important to any controller that has no scoring point,
   //    and their relative order will follow `default_sorted_controllers_`.
-  std::vector<Controller*> sorted_controllers(default_sorted_controllers_);
-  std::stable_sort(
-      sorted_controllers.begin(), sorted_controllers.end(),
-      [this, &scoring_point](const Controller* lhs, const Controller* rhs) {
-        auto lhs_scoring_point = controller_scoring_points_.find(lhs);
-        auto rhs_scoring_point = controller_scoring_points_.find(rhs);
-
-        if (lhs_scoring_point == controller_scoring_points_.end())
-          return false;
-
-        if (rhs_scoring_point == controller_scoring_points_.end())
-          return true;
-
-        return lhs_scoring_point->second.SquaredDistanceTo(scoring_point) <
-               rhs_scoring_point->second.SquaredDistanceTo(scoring_point);
-      });
+  // There are only a few controllers, so a stable insertion sort is used,
+  // which computes each distance once and needs no extra memory.
+  for (size_t i = 0; i < default_sorted_controllers_.size(); ++i) {
+    const float distance =
+        controller_scoring_points_[i]
+            ? controller_scoring_points_[i]->SquaredDistanceTo(scoring_point)
+            : std::numeric_limits<float>::infinity();
+    size_t j = i;
+    for (; j > 0 && sorting_buffer_[j - 1].first > distance; --j) {
+      sorting_buffer_[j] = sorting_buffer_[j - 1];
+    }
+    sorting_buffer_[j] = {distance, default_sorted_controllers_[i]};
+  }
 
-  if (sorted_controllers_ != sorted_controllers) {
-    sorted_controllers_ = sorted_controllers;
+  bool reordered = false;
+  for (size_t i = 0; i < sorted_controllers_.size(); ++i) {
+    reordered |= sorted_controllers_[i] != sorting_buffer_[i].second;
+    sorted_controllers_[i] = sorting_buffer_[i].second;
+  }
+  if (reordered) {
     last_reordering_time_ms_ = now_ms;
     last_scoring_point_ = scoring_point;
   }
   return sorted_controllers_;
 }
 
-std::vector<Controller*> ControllerManagerImpl::GetControllers() const {
+rtc::ArrayView<Controller* const> ControllerManagerImpl::GetControllers()
+    const {
   return default_sorted_controllers_;
 }
 
-ControllerManagerImpl::ScoringPoint::ScoringPoint(
-    int uplink_bandwidth_bps,
-    float uplink_packet_loss_fraction)
-    : uplink_bandwidth_bps(uplink_bandwidth_bps),
-      uplink_packet_loss_fraction(uplink_packet_loss_fraction) {}
-
 namespace {
 
 constexpr int kMinUplinkBandwidthBps = 0;
@@ -437,16 +438,23 @@ float NormalizePacketLossFraction(float uplink_packet_loss_fraction) {
 
 }  // namespace
 
+ControllerManagerImpl::ScoringPoint::ScoringPoint(
+    int uplink_bandwidth_bps,
+    float uplink_packet_loss_fraction)
+    : normalized_uplink_bandwidth(
+          NormalizeUplinkBandwidth(uplink_bandwidth_bps)),
+      normalized_uplink_packet_loss_fraction(
+          NormalizePacketLossFraction(uplink_packet_loss_fraction)) {}
+
 float ControllerManagerImpl::ScoringPoint::SquaredDistanceTo(
     const ScoringPoint& scoring_point) const {
-  float diff_normalized_bitrate_bps =
-      NormalizeUplinkBandwidth(scoring_point.uplink_bandwidth_bps) -
-      NormalizeUplinkBandwidth(uplink_bandwidth_bps);
-  float diff_normalized_packet_loss =
-      NormalizePacketLossFraction(scoring_point.uplink_packet_loss_fraction) -
-      NormalizePacketLossFraction(uplink_packet_loss_fraction);
-  return std::pow(diff_normalized_bitrate_bps, 2) +
-         std::pow(diff_normalized_packet_loss, 2);
+  const float diff_normalized_bitrate_bps =
+      scoring_point.normalized_uplink_bandwidth - normalized_uplink_bandwidth;
+  const float diff_normalized_packet_loss =
+      scoring_point.normalized_uplink_packet_loss_fraction -
+      normalized_uplink_packet_loss_fraction;
+  return diff_normalized_bitrate_bps * diff_normalized_bitrate_bps +
+         diff_normalized_packet_loss * diff_normalized_packet_loss;
 }
 
 }  // namespace webrtc
@@ -14,8 +14,11 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "absl/types/optional.h"
+#include "api/array_view.h"
 #include "modules/audio_coding/audio_network_adaptor/controller.h"
 #include "rtc_base/constructor_magic.h"
 
@@ -27,11 +30,12 @@ class ControllerManager {
  public:
   virtual ~ControllerManager() = default;
 
-  // Sort controllers based on their significance.
-  virtual std::vector<Controller*> GetSortedControllers(
+  // Sort controllers based on their significance. The returned view is valid
+  // until the next call.
+  virtual rtc::ArrayView<Controller* const> GetSortedControllers(
       const Controller::NetworkMetrics& metrics) = 0;
 
-  virtual std::vector<Controller*> GetControllers() const = 0;
+  virtual rtc::ArrayView<Controller* const> GetControllers() const = 0;
 };
 
 class ControllerManagerImpl final : public ControllerManager {
@@ -80,11 +84,12 @@ class ControllerManagerImpl final : public ControllerManager {
 
   ~ControllerManagerImpl() override;
 
-  // Sort controllers based on their significance.
-  std::vector<Controller*> GetSortedControllers(
+  // Sort controllers based on their significance. Does not allocate, so that
+  // it may be called at a fine time granularity.
+  rtc::ArrayView<Controller* const> GetSortedControllers(
       const Controller::NetworkMetrics& metrics) override;
 
-  std::vector<Controller*> GetControllers() const override;
+  rtc::ArrayView<Controller* const> GetControllers() const override;
 
  private:
   // Scoring point is a subset of NetworkMetrics that is used for comparing the
@@ -96,8 +101,9 @@ class ControllerManagerImpl final : public ControllerManager {
     // Calculate the normalized [0,1] distance between two scoring points.
     float SquaredDistanceTo(const ScoringPoint& scoring_point) const;
 
-    int uplink_bandwidth_bps;
-    float uplink_packet_loss_fraction;
+    // Normalized to [0,1] at construction.
+    float normalized_uplink_bandwidth;
+    float normalized_uplink_packet_loss_fraction;
   };
 
   const Config config_;
@@ -111,9 +117,14 @@ class ControllerManagerImpl final : public ControllerManager {
 
   std::vector<Controller*> sorted_controllers_;
 
-  // `scoring_points_` saves the scoring points of various
-  // controllers.
-  std::map<const Controller*, ScoringPoint> controller_scoring_points_;
+  // `controller_scoring_points_` saves the scoring points of the controllers
+  // in `default_sorted_controllers_`, if they have one.
+  std::vector<absl::optional<ScoringPoint>> controller_scoring_points_;
+  bool has_scoring_points_;
+
+  // Distances to the current scoring point of the controllers being sorted.
+  // Allocated at construction.
+  std::vector<std::pair<float, Controller*>> sorting_buffer_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(ControllerManagerImpl);
 };
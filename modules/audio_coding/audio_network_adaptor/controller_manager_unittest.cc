@@ -295,7 +295,7 @@ enum class ControllerType : int8_t {
   BIT_RATE
 };
 
-void CheckControllersOrder(const std::vector<Controller*>& controllers,
+void CheckControllersOrder(rtc::ArrayView<Controller* const> controllers,
                            const std::vector<ControllerType>& expected_types) {
   ASSERT_EQ(expected_types.size(), controllers.size());
 
@@ -22,11 +22,14 @@ class MockControllerManager : public ControllerManager {
  public:
   ~MockControllerManager() override { Die(); }
   MOCK_METHOD(void, Die, ());
-  MOCK_METHOD(std::vector<Controller*>,
+  MOCK_METHOD(rtc::ArrayView<Controller* const>,
               GetSortedControllers,
               (const Controller::NetworkMetrics& metrics),
               (override));
-  MOCK_METHOD(std::vector<Controller*>, GetControllers, (), (const, override));
+  MOCK_METHOD(rtc::ArrayView<Controller* const>,
+              GetControllers,
+              (),
+              (const, override));
 };
 
 }  // namespace webrtc
@@ -374,7 +374,15 @@ AudioEncoderOpusImpl::AudioEncoderOpusImpl(
       packet_loss_fraction_smoother_(new PacketLossFractionSmoother()),
       audio_network_adaptor_creator_(audio_network_adaptor_creator),
       bitrate_smoother_(std::move(bitrate_smoother)),
-      consecutive_dtx_frames_(0) {
+      consecutive_dtx_frames_(0),
+      encode_time_controller_(
+          config.encode_time_budget_us
+              ? std::make_unique<OpusEncodeTimeController>(
+                    OpusEncodeTimeController::Config{
+                        *config.encode_time_budget_us,
+                        std::max(config.complexity,
+                                 config.low_rate_complexity)})
+              : nullptr) {
   RTC_DCHECK(0 <= payload_type && payload_type <= 127);
 
   // Sanity check of the redundant payload type field that we want to get rid
@@ -596,6 +604,8 @@ AudioEncoder::EncodedInfo AudioEncoderOpusImpl::EncodeImpl(
                Num10msFramesPerPacket() * SamplesPer10msFrame());
 
   const size_t max_encoded_bytes = SufficientOutputBufferSize();
+  const int64_t encode_start_us =
+      encode_time_controller_ ? rtc::TimeMicros() : 0;
   EncodedInfo info;
   info.encoded_bytes = encoded->AppendData(
       max_encoded_bytes, [&](rtc::ArrayView<uint8_t> encoded) {
@@ -610,6 +620,13 @@ AudioEncoder::EncodedInfo AudioEncoderOpusImpl::EncodeImpl(
       });
   input_buffer_.clear();
 
+  if (encode_time_controller_) {
+    encode_time_controller_->OnEncodedFrame(rtc::TimeMicros() - encode_start_us,
+                                            Num10msFramesPerPacket(),
+                                            complexity_);
+    ApplyEncodeTimeLimits();
+  }
+
   bool dtx_frame = (info.encoded_bytes <= 2);
 
   // Will use new packet size for next encoding.
@@ -684,11 +701,13 @@ bool AudioEncoderOpusImpl::RecreateEncoderInstance(
   } else {
     RTC_CHECK_EQ(0, WebRtcOpus_DisableFec(inst_));
   }
-  RTC_CHECK_EQ(
-      0, WebRtcOpus_SetMaxPlaybackRate(inst_, config.max_playback_rate_hz));
+  bandwidth_limited_ =
+      encode_time_controller_ && encode_time_controller_->limit_bandwidth();
+  RTC_CHECK_EQ(0, WebRtcOpus_SetMaxPlaybackRate(inst_, MaxPlaybackRateHz()));
   // Use the default complexity if the start bitrate is within the hysteresis
   // window.
-  complexity_ = GetNewComplexity(config).value_or(config.complexity);
+  bitrate_complexity_ = GetNewComplexity(config).value_or(config.complexity);
+  complexity_ = LimitedComplexity();
   RTC_CHECK_EQ(0, WebRtcOpus_SetComplexity(inst_, complexity_));
   bitrate_changed_ = true;
   if (config.dtx_enabled) {
@@ -756,10 +775,40 @@ void AudioEncoderOpusImpl::SetTargetBitrate(int bits_per_second) {
   }
 
   const auto new_complexity = GetNewComplexity(config_);
-  if (new_complexity && complexity_ != *new_complexity) {
-    complexity_ = *new_complexity;
+  if (new_complexity) {
+    bitrate_complexity_ = *new_complexity;
+  }
+  ApplyEncodeTimeLimits();
+}
+
+void AudioEncoderOpusImpl::ApplyEncodeTimeLimits() {
+  const int complexity = LimitedComplexity();
+  if (complexity_ != complexity) {
+    complexity_ = complexity;
     RTC_CHECK_EQ(0, WebRtcOpus_SetComplexity(inst_, complexity_));
   }
+  const bool bandwidth_limited =
+      encode_time_controller_ && encode_time_controller_->limit_bandwidth();
+  if (bandwidth_limited_ != bandwidth_limited) {
+    bandwidth_limited_ = bandwidth_limited;
+    RTC_CHECK_EQ(0,
+                 WebRtcOpus_SetMaxPlaybackRate(inst_, MaxPlaybackRateHz()));
+  }
+}
+
+int AudioEncoderOpusImpl::LimitedComplexity() const {
+  return encode_time_controller_
+             ? std::min(bitrate_complexity_,
+                        encode_time_controller_->max_complexity())
+             : bitrate_complexity_;
+}
+
+int AudioEncoderOpusImpl::MaxPlaybackRateHz() const {
+  // Limits the encoded audio to wideband.
+  constexpr int kLimitedPlaybackRateHz = 16000;
+  return bandwidth_limited_
+             ? std::min(config_.max_playback_rate_hz, kLimitedPlaybackRateHz)
+             : config_.max_playback_rate_hz;
 }
 
 void AudioEncoderOpusImpl::ApplyAudioNetworkAdaptor() {
@@ -804,10 +853,16 @@ void AudioEncoderOpusImpl::MaybeUpdateUplinkBandwidth() {
 }
 
 ANAStats AudioEncoderOpusImpl::GetANAStats() const {
+  ANAStats stats;
   if (audio_network_adaptor_) {
-    return audio_network_adaptor_->GetStats();
+    stats = audio_network_adaptor_->GetStats();
+  }
+  if (encode_time_controller_) {
+    stats.complexity_action_counter = encode_time_controller_->action_counter();
+    stats.encoder_complexity = complexity_;
+    stats.encoder_bandwidth_limited = bandwidth_limited_;
   }
-  return ANAStats();
+  return stats;
 }
 
 absl::optional<std::pair<TimeDelta, TimeDelta> >
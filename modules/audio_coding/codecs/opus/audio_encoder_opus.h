@@ -22,6 +22,7 @@
 #include "api/audio_codecs/opus/audio_encoder_opus_config.h"
 #include "common_audio/smoothing_filter.h"
 #include "modules/audio_coding/audio_network_adaptor/include/audio_network_adaptor.h"
+#include "modules/audio_coding/codecs/opus/opus_encode_time_controller.h"
 #include "modules/audio_coding/codecs/opus/opus_interface.h"
 #include "rtc_base/constructor_magic.h"
 
@@ -132,6 +133,10 @@ class AudioEncoderOpusImpl final : public AudioEncoder {
   void SetFrameLength(int frame_length_ms);
   void SetNumChannelsToEncode(size_t num_channels_to_encode);
   void SetProjectedPacketLossRate(float fraction);
+  // Applies the complexity and bandwidth limits of `encode_time_controller_`.
+  void ApplyEncodeTimeLimits();
+  int LimitedComplexity() const;
+  int MaxPlaybackRateHz() const;
 
   void OnReceivedUplinkBandwidth(
       int target_audio_bitrate_bps,
@@ -165,7 +170,11 @@ class AudioEncoderOpusImpl final : public AudioEncoder {
   uint32_t first_timestamp_in_buffer_;
   size_t num_channels_to_encode_;
   int next_frame_length_ms_;
+  // Complexity chosen from the bitrate, and the one used after the limit of
+  // `encode_time_controller_`.
+  int bitrate_complexity_;
   int complexity_;
+  bool bandwidth_limited_;
   std::unique_ptr<PacketLossFractionSmoother> packet_loss_fraction_smoother_;
   const AudioNetworkAdaptorCreator audio_network_adaptor_creator_;
   std::unique_ptr<AudioNetworkAdaptor> audio_network_adaptor_;
@@ -173,6 +182,7 @@ class AudioEncoderOpusImpl final : public AudioEncoder {
   const std::unique_ptr<SmoothingFilter> bitrate_smoother_;
   absl::optional<int64_t> bitrate_smoother_last_update_time_;
   int consecutive_dtx_frames_;
+  const std::unique_ptr<OpusEncodeTimeController> encode_time_controller_;
 
   friend struct AudioEncoderOpus;
   RTC_DISALLOW_COPY_AND_ASSIGN(AudioEncoderOpusImpl);
@@ -408,6 +408,33 @@ TEST(AudioEncoderOpusTest, ConfigComplexityAdaptation) {
   EXPECT_EQ(6, AudioEncoderOpusImpl::GetNewComplexity(config));
 }
 
+// Verifies that the encode time controller reports its choices in the stats.
+TEST(AudioEncoderOpusTest, EncodeTimeControllerStats) {
+  AudioEncoderOpusConfig config;
+  config.complexity = 6;
+  config.low_rate_complexity = 6;
+  AudioEncoderOpusImpl encoder(config, kDefaultOpusPayloadType);
+  EXPECT_FALSE(encoder.GetANAStats().complexity_action_counter);
+  EXPECT_FALSE(encoder.GetANAStats().encoder_complexity);
+
+  config.encode_time_budget_us = 1000;
+  AudioEncoderOpusImpl limited_encoder(config, kDefaultOpusPayloadType);
+  // A fake clock makes encoding take no time, which leaves the settings at
+  // their highest.
+  rtc::ScopedFakeClock fake_clock;
+  std::vector<int16_t> audio(limited_encoder.SampleRateHz() / 100, 0);
+  rtc::Buffer encoded;
+  for (int i = 0; i < 100; ++i) {
+    limited_encoder.Encode(
+        0, rtc::ArrayView<const int16_t>(audio.data(), audio.size()),
+        &encoded);
+  }
+  const ANAStats stats = limited_encoder.GetANAStats();
+  EXPECT_EQ(stats.complexity_action_counter, 0u);
+  EXPECT_EQ(stats.encoder_complexity, 6);
+  EXPECT_EQ(stats.encoder_bandwidth_limited, false);
+}
+
 // Verifies that the bandwidth adaptation in the config works as intended.
 TEST_P(AudioEncoderOpusTest, ConfigBandwidthAdaptation) {
   AudioEncoderOpusConfig config;
@@ -0,0 +1,84 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/codecs/opus/opus_encode_time_controller.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kEvaluationPeriod10msFrames = 50;
+// The complexity is lowered faster than it is raised, so that overload is
+// resolved quickly while the headroom is probed carefully.
+constexpr int kComplexityDecreaseStep = 2;
+constexpr int kComplexityIncreaseStep = 1;
+// Fraction of the budget below which the settings are raised.
+constexpr int64_t kHeadroomPercent = 70;
+
+}  // namespace
+
+OpusEncodeTimeController::OpusEncodeTimeController(const Config& config)
+    : config_(config), max_complexity_(config.max_complexity) {
+  RTC_DCHECK_GT(config_.budget_us_per_10ms, 0);
+  RTC_DCHECK_GE(config_.max_complexity, 0);
+  RTC_DCHECK_LE(config_.max_complexity, 10);
+}
+
+OpusEncodeTimeController::~OpusEncodeTimeController() = default;
+
+void OpusEncodeTimeController::OnEncodedFrame(int64_t encode_time_us,
+                                              size_t num_10ms_frames,
+                                              int complexity) {
+  total_encode_time_us_ += encode_time_us;
+  num_10ms_frames_ += num_10ms_frames;
+  if (num_10ms_frames_ < kEvaluationPeriod10msFrames) {
+    return;
+  }
+  const int64_t average_us = total_encode_time_us_ / num_10ms_frames_;
+  total_encode_time_us_ = 0;
+  num_10ms_frames_ = 0;
+
+  const int64_t budget_us = config_.budget_us_per_10ms;
+  if (average_us > budget_us) {
+    // The encoder may use less than the highest complexity allowed.
+    const int current_complexity = std::min(max_complexity_, complexity);
+    if (current_complexity > 0) {
+      max_complexity_ =
+          std::max(0, current_complexity - kComplexityDecreaseStep);
+    } else if (!limit_bandwidth_) {
+      max_complexity_ = 0;
+      limit_bandwidth_ = true;
+    } else {
+      return;
+    }
+  } else if (average_us * 100 < budget_us * kHeadroomPercent) {
+    if (limit_bandwidth_) {
+      limit_bandwidth_ = false;
+    } else if (max_complexity_ < config_.max_complexity) {
+      max_complexity_ = std::min(config_.max_complexity,
+                                 max_complexity_ + kComplexityIncreaseStep);
+    } else {
+      return;
+    }
+  } else {
+    return;
+  }
+  ++action_counter_;
+  RTC_LOG(LS_VERBOSE) << "Opus encode time " << average_us
+                      << " us per 10 ms, budget " << budget_us
+                      << " us: max complexity " << max_complexity_
+                      << ", bandwidth limited " << limit_bandwidth_ << ".";
+}
+
+}  // namespace webrtc
@@ -0,0 +1,66 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_CODECS_OPUS_OPUS_ENCODE_TIME_CONTROLLER_H_
+#define MODULES_AUDIO_CODING_CODECS_OPUS_OPUS_ENCODE_TIME_CONTROLLER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace webrtc {
+
+// Keeps the time spent by the Opus encoder within a budget, e.g., on servers
+// transcoding many streams or on slow devices. The encode time is averaged
+// over periods of 500 ms of audio. When above the budget, the complexity is
+// lowered, and once at the lowest complexity, the encoded bandwidth is limited
+// to wideband. When well below the budget, the settings are raised again one
+// step at a time.
+class OpusEncodeTimeController {
+ public:
+  struct Config {
+    // Average time to encode 10 ms of audio above which the encoder settings
+    // are lowered.
+    int budget_us_per_10ms = 0;
+    // Highest complexity that the encoder may use.
+    int max_complexity = 10;
+  };
+
+  explicit OpusEncodeTimeController(const Config& config);
+  ~OpusEncodeTimeController();
+
+  OpusEncodeTimeController(const OpusEncodeTimeController&) = delete;
+  OpusEncodeTimeController& operator=(const OpusEncodeTimeController&) =
+      delete;
+
+  // Reports that encoding `num_10ms_frames` of audio with `complexity` took
+  // `encode_time_us`.
+  void OnEncodedFrame(int64_t encode_time_us,
+                      size_t num_10ms_frames,
+                      int complexity);
+
+  // Highest complexity that fits in the budget.
+  int max_complexity() const { return max_complexity_; }
+  // True if the encoded bandwidth should be limited to wideband.
+  bool limit_bandwidth() const { return limit_bandwidth_; }
+  // Number of times the settings were changed.
+  uint32_t action_counter() const { return action_counter_; }
+
+ private:
+  const Config config_;
+  int max_complexity_;
+  bool limit_bandwidth_ = false;
+  uint32_t action_counter_ = 0;
+  int64_t total_encode_time_us_ = 0;
+  size_t num_10ms_frames_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_CODING_CODECS_OPUS_OPUS_ENCODE_TIME_CONTROLLER_H_
@@ -0,0 +1,109 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/codecs/opus/opus_encode_time_controller.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kBudgetUs = 1000;
+constexpr int kMaxComplexity = 9;
+// 500 ms of 20 ms packets.
+constexpr int kPacketsPerPeriod = 25;
+
+OpusEncodeTimeController::Config CreateConfig() {
+  OpusEncodeTimeController::Config config;
+  config.budget_us_per_10ms = kBudgetUs;
+  config.max_complexity = kMaxComplexity;
+  return config;
+}
+
+// Encodes 500 ms of audio with `complexity`, taking `us_per_10ms` per 10 ms.
+void EncodePeriod(OpusEncodeTimeController* controller,
+                  int us_per_10ms,
+                  int complexity) {
+  for (int i = 0; i < kPacketsPerPeriod; ++i) {
+    controller->OnEncodedFrame(2 * us_per_10ms, 2, complexity);
+  }
+}
+
+TEST(OpusEncodeTimeControllerTest, KeepsSettingsWithinBudget) {
+  OpusEncodeTimeController controller(CreateConfig());
+  EncodePeriod(&controller, kBudgetUs, kMaxComplexity);
+  EncodePeriod(&controller, kBudgetUs * 8 / 10, kMaxComplexity);
+  EXPECT_EQ(controller.max_complexity(), kMaxComplexity);
+  EXPECT_FALSE(controller.limit_bandwidth());
+  EXPECT_EQ(controller.action_counter(), 0u);
+}
+
+TEST(OpusEncodeTimeControllerTest, WaitsForFullPeriod) {
+  OpusEncodeTimeController controller(CreateConfig());
+  for (int i = 0; i < kPacketsPerPeriod - 1; ++i) {
+    controller.OnEncodedFrame(10 * kBudgetUs, 2, kMaxComplexity);
+  }
+  EXPECT_EQ(controller.max_complexity(), kMaxComplexity);
+  controller.OnEncodedFrame(10 * kBudgetUs, 2, kMaxComplexity);
+  EXPECT_LT(controller.max_complexity(), kMaxComplexity);
+}
+
+TEST(OpusEncodeTimeControllerTest, LowersComplexityThenBandwidth) {
+  OpusEncodeTimeController controller(CreateConfig());
+  // Start below the highest complexity, as set by the bitrate.
+  int complexity = 5;
+  uint32_t actions = 0;
+  while (complexity > 0) {
+    EncodePeriod(&controller, 2 * kBudgetUs, complexity);
+    EXPECT_LT(controller.max_complexity(), complexity);
+    EXPECT_EQ(controller.action_counter(), ++actions);
+    complexity = controller.max_complexity();
+  }
+  EXPECT_FALSE(controller.limit_bandwidth());
+  EncodePeriod(&controller, 2 * kBudgetUs, complexity);
+  EXPECT_TRUE(controller.limit_bandwidth());
+  EXPECT_EQ(controller.action_counter(), ++actions);
+
+  // Nothing left to lower.
+  EncodePeriod(&controller, 2 * kBudgetUs, complexity);
+  EXPECT_EQ(controller.max_complexity(), 0);
+  EXPECT_TRUE(controller.limit_bandwidth());
+  EXPECT_EQ(controller.action_counter(), actions);
+}
+
+TEST(OpusEncodeTimeControllerTest, RaisesSettingsWithHeadroom) {
+  OpusEncodeTimeController controller(CreateConfig());
+  EncodePeriod(&controller, 2 * kBudgetUs, kMaxComplexity);
+  const int lowered_complexity = controller.max_complexity();
+  EXPECT_LT(lowered_complexity, kMaxComplexity);
+
+  for (int expected = lowered_complexity + 1; expected <= kMaxComplexity;
+       ++expected) {
+    EncodePeriod(&controller, kBudgetUs / 2, controller.max_complexity());
+    EXPECT_EQ(controller.max_complexity(), expected);
+  }
+  EncodePeriod(&controller, kBudgetUs / 2, kMaxComplexity);
+  EXPECT_EQ(controller.max_complexity(), kMaxComplexity);
+}
+
+TEST(OpusEncodeTimeControllerTest, RestoresBandwidthBeforeComplexity) {
+  OpusEncodeTimeController controller(CreateConfig());
+  EncodePeriod(&controller, 2 * kBudgetUs, 0);
+  ASSERT_TRUE(controller.limit_bandwidth());
+
+  EncodePeriod(&controller, kBudgetUs / 2, 0);
+  EXPECT_FALSE(controller.limit_bandwidth());
+  EXPECT_EQ(controller.max_complexity(), 0);
+  EncodePeriod(&controller, kBudgetUs / 2, 0);
+  EXPECT_EQ(controller.max_complexity(), 1);
+}
+
+}  // namespace
+}  // namespace webrtc
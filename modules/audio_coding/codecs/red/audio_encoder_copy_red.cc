@@ -12,6 +12,7 @@
 
 #include <string.h>
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
@@ -36,6 +37,11 @@ static constexpr size_t kRedLastHeaderLength =
 static constexpr size_t kRedNumberOfRedundantEncodings =
     1;  // The level of redundancy we support.
 
+// Packet loss below which no redundancy is sent when adapting to the loss, and
+// the increase in loss for each additional redundant encoding.
+static constexpr float kMinPacketLossForRedundancy = 0.01f;
+static constexpr float kPacketLossPerRedundantEncoding = 0.1f;
+
 AudioEncoderCopyRed::Config::Config() = default;
 AudioEncoderCopyRed::Config::Config(Config&&) = default;
 AudioEncoderCopyRed::Config::~Config() = default;
@@ -55,7 +61,9 @@ AudioEncoderCopyRed::AudioEncoderCopyRed(Config&& config)
     : speech_encoder_(std::move(config.speech_encoder)),
       primary_encoded_(0, kAudioMaxRtpPacketLen),
       max_packet_length_(kAudioMaxRtpPacketLen),
-      red_payload_type_(config.payload_type) {
+      red_payload_type_(config.payload_type),
+      adapt_redundancy_to_packet_loss_(config.adapt_redundancy_to_packet_loss),
+      skip_non_speech_redundancy_(config.skip_non_speech_redundancy) {
   RTC_CHECK(speech_encoder_) << "Speech encoder not provided.";
 
   auto number_of_redundant_encodings = GetMaxRedundancyFromFieldTrial();
@@ -64,6 +72,9 @@ AudioEncoderCopyRed::AudioEncoderCopyRed(Config&& config)
     redundant.second.EnsureCapacity(kAudioMaxRtpPacketLen);
     redundant_encodings_.push_front(std::move(redundant));
   }
+  // Without loss reports, no redundancy is sent in the adaptive mode.
+  max_redundant_encodings_ =
+      adapt_redundancy_to_packet_loss_ ? 0 : number_of_redundant_encodings;
 }
 
 AudioEncoderCopyRed::~AudioEncoderCopyRed() = default;
@@ -109,6 +120,7 @@ AudioEncoder::EncodedInfo AudioEncoderCopyRed::EncodeImpl(
 
   size_t header_length_bytes = kRedLastHeaderLength;
   size_t bytes_available = max_packet_length_ - info.encoded_bytes;
+  size_t num_redundant_encodings = 0;
   auto it = redundant_encodings_.begin();
 
   // Determine how much redundancy we can fit into our packet by
@@ -116,6 +128,12 @@ AudioEncoder::EncodedInfo AudioEncoderCopyRed::EncodeImpl(
   // as the timestamp difference. The latter can occur with opus DTX which
   // has timestamp gaps of 400ms which exceeds REDs timestamp delta field size.
   for (; it != redundant_encodings_.end(); it++) {
+    if (num_redundant_encodings == max_redundant_encodings_) {
+      break;
+    }
+    if (skip_non_speech_redundancy_ && !it->first.speech) {
+      break;
+    }
     if (bytes_available < kRedHeaderLength + it->first.encoded_bytes) {
       break;
     }
@@ -127,6 +145,7 @@ AudioEncoder::EncodedInfo AudioEncoderCopyRed::EncodeImpl(
     }
     bytes_available -= kRedHeaderLength + it->first.encoded_bytes;
     header_length_bytes += kRedHeaderLength;
+    ++num_redundant_encodings;
   }
 
   // Allocate room for RFC 2198 header.
@@ -222,6 +241,15 @@ void AudioEncoderCopyRed::DisableAudioNetworkAdaptor() {
 
 void AudioEncoderCopyRed::OnReceivedUplinkPacketLossFraction(
     float uplink_packet_loss_fraction) {
+  if (adapt_redundancy_to_packet_loss_) {
+    size_t redundancy = 0;
+    if (uplink_packet_loss_fraction >= kMinPacketLossForRedundancy) {
+      redundancy = 1 + static_cast<size_t>(uplink_packet_loss_fraction /
+                                           kPacketLossPerRedundantEncoding);
+    }
+    max_redundant_encodings_ =
+        std::min(redundancy, redundant_encodings_.size());
+  }
   speech_encoder_->OnReceivedUplinkPacketLossFraction(
       uplink_packet_loss_fraction);
 }
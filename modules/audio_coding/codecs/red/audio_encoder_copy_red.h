@@ -41,6 +41,13 @@ class AudioEncoderCopyRed final : public AudioEncoder {
     ~Config();
     int payload_type;
     std::unique_ptr<AudioEncoder> speech_encoder;
+    // If true, the number of redundant encodings in a packet follows the
+    // uplink packet loss, up to the level set by the field trial: none below
+    // 1% loss and one more for every 10% of loss.
+    bool adapt_redundancy_to_packet_loss = false;
+    // If true, frames that are not speech, e.g., the comfort noise updates of
+    // Opus DTX, are not sent again as redundant encodings.
+    bool skip_non_speech_redundancy = false;
   };
 
   explicit AudioEncoderCopyRed(Config&& config);
@@ -91,6 +98,10 @@ class AudioEncoderCopyRed final : public AudioEncoder {
   rtc::Buffer primary_encoded_;
   size_t max_packet_length_;
   int red_payload_type_;
+  const bool adapt_redundancy_to_packet_loss_;
+  const bool skip_non_speech_redundancy_;
+  // Number of the redundant encodings kept to add at most to a packet.
+  size_t max_redundant_encodings_;
   std::list<std::pair<EncodedInfo, rtc::Buffer>> redundant_encodings_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(AudioEncoderCopyRed);
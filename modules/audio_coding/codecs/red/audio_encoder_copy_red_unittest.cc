@@ -606,6 +606,73 @@ TEST_F(AudioEncoderCopyRedTest, LargeTimestampGap) {
   EXPECT_EQ(encoded_.size(), 1u + 200u);
 }
 
+TEST_F(AudioEncoderCopyRedTest, AdaptsRedundancyToPacketLoss) {
+  webrtc::test::ScopedFieldTrials field_trials(
+      "WebRTC-Audio-Red-For-Opus/Enabled-2/");
+  AudioEncoderCopyRed::Config config;
+  config.payload_type = red_payload_type_;
+  config.speech_encoder = std::move(red_->ReclaimContainedEncoders()[0]);
+  config.adapt_redundancy_to_packet_loss = true;
+  red_.reset(new AudioEncoderCopyRed(std::move(config)));
+  EXPECT_CALL(*mock_encoder_, EncodeImpl(_, _, _))
+      .WillRepeatedly(Invoke(MockAudioEncoder::FakeEncoding(10)));
+
+  // No redundancy until there is loss.
+  Encode();
+  Encode();
+  Encode();
+  EXPECT_EQ(0u, encoded_info_.redundant.size());
+  EXPECT_EQ(kRedLastHeaderLength + 10u, encoded_info_.encoded_bytes);
+
+  red_->OnReceivedUplinkPacketLossFraction(0.05f);
+  Encode();
+  EXPECT_EQ(2u, encoded_info_.redundant.size());
+  EXPECT_EQ(5u + 2 * 10u, encoded_info_.encoded_bytes);
+
+  // Capped by the field trial.
+  red_->OnReceivedUplinkPacketLossFraction(0.3f);
+  Encode();
+  EXPECT_EQ(3u, encoded_info_.redundant.size());
+  EXPECT_EQ(9u + 3 * 10u, encoded_info_.encoded_bytes);
+
+  red_->OnReceivedUplinkPacketLossFraction(0.f);
+  Encode();
+  EXPECT_EQ(0u, encoded_info_.redundant.size());
+}
+
+TEST_F(AudioEncoderCopyRedTest, SkipsNonSpeechRedundancy) {
+  AudioEncoderCopyRed::Config config;
+  config.payload_type = red_payload_type_;
+  config.speech_encoder = std::move(red_->ReclaimContainedEncoders()[0]);
+  config.skip_non_speech_redundancy = true;
+  red_.reset(new AudioEncoderCopyRed(std::move(config)));
+
+  AudioEncoder::EncodedInfo info;
+  info.encoded_bytes = 10;
+  info.encoded_timestamp = timestamp_;
+  EXPECT_CALL(*mock_encoder_, EncodeImpl(_, _, _))
+      .WillOnce(Invoke(MockAudioEncoder::FakeEncoding(info)));
+  Encode();
+
+  // The last speech frame is still sent again with the first DTX frame.
+  info.encoded_bytes = 1;
+  info.encoded_timestamp = timestamp_;
+  info.speech = false;
+  EXPECT_CALL(*mock_encoder_, EncodeImpl(_, _, _))
+      .WillOnce(Invoke(MockAudioEncoder::FakeEncoding(info)));
+  Encode();
+  ASSERT_EQ(2u, encoded_info_.redundant.size());
+  EXPECT_EQ(5u + 10u + 1u, encoded_info_.encoded_bytes);
+
+  // But not the DTX frame.
+  info.encoded_timestamp = timestamp_;
+  EXPECT_CALL(*mock_encoder_, EncodeImpl(_, _, _))
+      .WillOnce(Invoke(MockAudioEncoder::FakeEncoding(info)));
+  Encode();
+  EXPECT_EQ(0u, encoded_info_.redundant.size());
+  EXPECT_EQ(kRedLastHeaderLength + 1u, encoded_info_.encoded_bytes);
+}
+
 #if GTEST_HAS_DEATH_TEST && !defined(WEBRTC_ANDROID)
 
 // This test fixture tests various error conditions that makes the
@@ -971,8 +971,10 @@ int NetEqImpl::GetAudioInternal(AudioFrame* audio_frame,
 
   // TODO(yujo): For muted frames, this can be a copy rather than an addition.
   if (play_dtmf) {
-    return_value = DtmfOverdub(dtmf_event, sync_buffer_->Channels(),
-                               audio_frame->mutable_data());
+    return_value = DtmfOverdub(
+        dtmf_event, sync_buffer_->Channels(),
+        audio_frame->mutable_data(audio_frame->samples_per_channel_,
+                                  audio_frame->num_channels_));
   }
 
   // Update the background noise parameters if last operation wrote data
@@ -8,14 +8,13 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
-// This is the implementation of the PacketBuffer class. It is mostly based on
-// an STL list. The list is kept sorted at all times so that the next packet to
-// decode is at the beginning of the list.
+// This is the implementation of the PacketBuffer class. It is based on a ring
+// buffer of packets, which is kept sorted at all times so that the next packet
+// to decode is at the beginning of the buffer.
 
 #include "modules/audio_coding/neteq/packet_buffer.h"
 
 #include <algorithm>
-#include <list>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -32,17 +31,9 @@
 
 namespace webrtc {
 namespace {
-// Predicate used when inserting packets in the buffer list.
-// Operator() returns true when `packet` goes before `new_packet`.
-class NewTimestampIsLarger {
- public:
-  explicit NewTimestampIsLarger(const Packet& new_packet)
-      : new_packet_(new_packet) {}
-  bool operator()(const Packet& packet) { return (new_packet_ >= packet); }
-
- private:
-  const Packet& new_packet_;
-};
+
+// Capacity of the ring buffer when the first packet is inserted.
+constexpr size_t kMinCapacity = 8;
 
 // Returns true if both payload types are known to the decoder database, and
 // have the same sample rate.
@@ -93,16 +84,14 @@ PacketBuffer::PacketBuffer(size_t max_number_of_packets,
       tick_timer_(tick_timer) {}
 
 // Destructor. All packets in the buffer will be destroyed.
-PacketBuffer::~PacketBuffer() {
-  buffer_.clear();
-}
+PacketBuffer::~PacketBuffer() = default;
 
 // Flush the buffer. All packets in the buffer will be destroyed.
 void PacketBuffer::Flush(StatisticsCalculator* stats) {
-  for (auto& p : buffer_) {
-    LogPacketDiscarded(p.priority.codec_level, stats);
+  for (size_t i = 0; i < size_; ++i) {
+    LogPacketDiscarded(At(i).priority.codec_level, stats);
   }
-  buffer_.clear();
+  Clear();
   stats->FlushedPacketBuffer();
 }
 
@@ -121,14 +110,15 @@ void PacketBuffer::PartialFlush(int target_level_ms,
       target_level_samples, smart_flushing_config_->target_level_threshold_ms);
   while (GetSpanSamples(last_decoded_length, sample_rate, true) >
              static_cast<size_t>(target_level_samples) ||
-         buffer_.size() > max_number_of_packets_ / 2) {
+         size_ > max_number_of_packets_ / 2) {
     LogPacketDiscarded(PeekNextPacket()->priority.codec_level, stats);
-    buffer_.pop_front();
+    At(0) = Packet();
+    PopFront();
   }
 }
 
 bool PacketBuffer::Empty() const {
-  return buffer_.empty();
+  return size_ == 0;
 }
 
 int PacketBuffer::InsertPacket(Packet&& packet,
@@ -161,8 +151,8 @@ int PacketBuffer::InsertPacket(Packet&& packet,
   const bool smart_flush =
       smart_flushing_config_.has_value() &&
       GetSpanSamples(last_decoded_length, sample_rate, true) >= span_threshold;
-  if (buffer_.size() >= max_number_of_packets_ || smart_flush) {
-    size_t buffer_size_before_flush = buffer_.size();
+  if (size_ >= max_number_of_packets_ || smart_flush) {
+    size_t buffer_size_before_flush = size_;
     if (smart_flushing_config_.has_value()) {
       // Flush down to the target level.
       PartialFlush(target_level_ms, sample_rate, last_decoded_length, stats);
@@ -173,33 +163,35 @@ int PacketBuffer::InsertPacket(Packet&& packet,
       return_val = kFlushed;
     }
     RTC_LOG(LS_WARNING) << "Packet buffer flushed, "
-                        << (buffer_size_before_flush - buffer_.size())
+                        << (buffer_size_before_flush - size_)
                         << " packets discarded.";
   }
 
-  // Get an iterator pointing to the place in the buffer where the new packet
-  // should be inserted. The list is searched from the back, since the most
-  // likely case is that the new packet should be near the end of the list.
-  PacketList::reverse_iterator rit = std::find_if(
-      buffer_.rbegin(), buffer_.rend(), NewTimestampIsLarger(packet));
+  // Find the index in the buffer where the new packet should be inserted. The
+  // buffer is searched from the back, since the most likely case is that the
+  // new packet should be near the end of the buffer.
+  size_t index = size_;
+  while (index > 0 && !(packet >= At(index - 1))) {
+    --index;
+  }
 
-  // The new packet is to be inserted to the right of `rit`. If it has the same
-  // timestamp as `rit`, which has a higher priority, do not insert the new
-  // packet to list.
-  if (rit != buffer_.rend() && packet.timestamp == rit->timestamp) {
+  // The new packet is to be inserted after the packet at `index - 1`. If it has
+  // the same timestamp as that packet, which has a higher priority, do not
+  // insert the new packet to the buffer.
+  if (index > 0 && packet.timestamp == At(index - 1).timestamp) {
     LogPacketDiscarded(packet.priority.codec_level, stats);
     return return_val;
   }
 
-  // The new packet is to be inserted to the left of `it`. If it has the same
-  // timestamp as `it`, which has a lower priority, replace `it` with the new
-  // packet.
-  PacketList::iterator it = rit.base();
-  if (it != buffer_.end() && packet.timestamp == it->timestamp) {
-    LogPacketDiscarded(it->priority.codec_level, stats);
-    it = buffer_.erase(it);
+  // The new packet is to be inserted before the packet at `index`. If it has
+  // the same timestamp as that packet, which has a lower priority, replace that
+  // packet with the new packet.
+  if (index < size_ && packet.timestamp == At(index).timestamp) {
+    LogPacketDiscarded(At(index).priority.codec_level, stats);
+    At(index) = std::move(packet);
+    return return_val;
   }
-  buffer_.insert(it, std::move(packet));  // Insert the packet at that position.
+  InsertAt(index, std::move(packet));
 
   return return_val;
 }
@@ -262,7 +254,7 @@ int PacketBuffer::NextTimestamp(uint32_t* next_timestamp) const {
   if (!next_timestamp) {
     return kInvalidPointer;
   }
-  *next_timestamp = buffer_.front().timestamp;
+  *next_timestamp = At(0).timestamp;
   return kOK;
 }
 
@@ -274,11 +266,10 @@ int PacketBuffer::NextHigherTimestamp(uint32_t timestamp,
   if (!next_timestamp) {
     return kInvalidPointer;
   }
-  PacketList::const_iterator it;
-  for (it = buffer_.begin(); it != buffer_.end(); ++it) {
-    if (it->timestamp >= timestamp) {
+  for (size_t i = 0; i < size_; ++i) {
+    if (At(i).timestamp >= timestamp) {
       // Found a packet matching the search.
-      *next_timestamp = it->timestamp;
+      *next_timestamp = At(i).timestamp;
       return kOK;
     }
   }
@@ -286,7 +277,7 @@ int PacketBuffer::NextHigherTimestamp(uint32_t timestamp,
 }
 
 const Packet* PacketBuffer::PeekNextPacket() const {
-  return buffer_.empty() ? nullptr : &buffer_.front();
+  return Empty() ? nullptr : &At(0);
 }
 
 absl::optional<Packet> PacketBuffer::GetNextPacket() {
@@ -295,10 +286,10 @@ absl::optional<Packet> PacketBuffer::GetNextPacket() {
     return absl::nullopt;
   }
 
-  absl::optional<Packet> packet(std::move(buffer_.front()));
+  absl::optional<Packet> packet(std::move(At(0)));
   // Assert that the packet sanity checks in InsertPacket method works.
   RTC_DCHECK(!packet->empty());
-  buffer_.pop_front();
+  PopFront();
 
   return packet;
 }
@@ -308,17 +299,18 @@ int PacketBuffer::DiscardNextPacket(StatisticsCalculator* stats) {
     return kBufferEmpty;
   }
   // Assert that the packet sanity checks in InsertPacket method works.
-  const Packet& packet = buffer_.front();
+  const Packet& packet = At(0);
   RTC_DCHECK(!packet.empty());
   LogPacketDiscarded(packet.priority.codec_level, stats);
-  buffer_.pop_front();
+  At(0) = Packet();
+  PopFront();
   return kOK;
 }
 
 void PacketBuffer::DiscardOldPackets(uint32_t timestamp_limit,
                                      uint32_t horizon_samples,
                                      StatisticsCalculator* stats) {
-  buffer_.remove_if([timestamp_limit, horizon_samples, stats](const Packet& p) {
+  RemoveIf([timestamp_limit, horizon_samples, stats](const Packet& p) {
     if (timestamp_limit == p.timestamp ||
         !IsObsoleteTimestamp(p.timestamp, timestamp_limit, horizon_samples)) {
       return false;
@@ -335,7 +327,7 @@ void PacketBuffer::DiscardAllOldPackets(uint32_t timestamp_limit,
 
 void PacketBuffer::DiscardPacketsWithPayloadType(uint8_t payload_type,
                                                  StatisticsCalculator* stats) {
-  buffer_.remove_if([payload_type, stats](const Packet& p) {
+  RemoveIf([payload_type, stats](const Packet& p) {
     if (p.payload_type != payload_type) {
       return false;
     }
@@ -345,13 +337,14 @@ void PacketBuffer::DiscardPacketsWithPayloadType(uint8_t payload_type,
 }
 
 size_t PacketBuffer::NumPacketsInBuffer() const {
-  return buffer_.size();
+  return size_;
 }
 
 size_t PacketBuffer::NumSamplesInBuffer(size_t last_decoded_length) const {
   size_t num_samples = 0;
   size_t last_duration = last_decoded_length;
-  for (const Packet& packet : buffer_) {
+  for (size_t i = 0; i < size_; ++i) {
+    const Packet& packet = At(i);
     if (packet.frame) {
       // TODO(hlundin): Verify that it's fine to count all packets and remove
       // this check.
@@ -371,16 +364,17 @@ size_t PacketBuffer::NumSamplesInBuffer(size_t last_decoded_length) const {
 size_t PacketBuffer::GetSpanSamples(size_t last_decoded_length,
                                     size_t sample_rate,
                                     bool count_dtx_waiting_time) const {
-  if (buffer_.size() == 0) {
+  if (size_ == 0) {
     return 0;
   }
 
-  size_t span = buffer_.back().timestamp - buffer_.front().timestamp;
-  if (buffer_.back().frame && buffer_.back().frame->Duration() > 0) {
-    size_t duration = buffer_.back().frame->Duration();
-    if (count_dtx_waiting_time && buffer_.back().frame->IsDtxPacket()) {
+  const Packet& back = At(size_ - 1);
+  size_t span = back.timestamp - At(0).timestamp;
+  if (back.frame && back.frame->Duration() > 0) {
+    size_t duration = back.frame->Duration();
+    if (count_dtx_waiting_time && back.frame->IsDtxPacket()) {
       size_t waiting_time_samples = rtc::dchecked_cast<size_t>(
-          buffer_.back().waiting_time->ElapsedMs() * (sample_rate / 1000));
+          back.waiting_time->ElapsedMs() * (sample_rate / 1000));
       duration = std::max(duration, waiting_time_samples);
     }
     span += duration;
@@ -393,7 +387,8 @@ size_t PacketBuffer::GetSpanSamples(size_t last_decoded_length,
 bool PacketBuffer::ContainsDtxOrCngPacket(
     const DecoderDatabase* decoder_database) const {
   RTC_DCHECK(decoder_database);
-  for (const Packet& packet : buffer_) {
+  for (size_t i = 0; i < size_; ++i) {
+    const Packet& packet = At(i);
     if ((packet.frame && packet.frame->IsDtxPacket()) ||
         decoder_database->IsComfortNoise(packet.payload_type)) {
       return true;
@@ -402,4 +397,77 @@ bool PacketBuffer::ContainsDtxOrCngPacket(
   return false;
 }
 
+Packet& PacketBuffer::At(size_t index) {
+  RTC_DCHECK_LT(index, buffer_.size());
+  index += begin_;
+  return buffer_[index < buffer_.size() ? index : index - buffer_.size()];
+}
+
+const Packet& PacketBuffer::At(size_t index) const {
+  RTC_DCHECK_LT(index, buffer_.size());
+  index += begin_;
+  return buffer_[index < buffer_.size() ? index : index - buffer_.size()];
+}
+
+void PacketBuffer::InsertAt(size_t index, Packet&& packet) {
+  RTC_DCHECK_LE(index, size_);
+  if (size_ == buffer_.size()) {
+    // Grow the ring buffer, rarely beyond the number of packets allowed.
+    const size_t capacity = std::max(
+        size_ + 1, std::min(std::max(kMinCapacity, 2 * buffer_.size()),
+                            max_number_of_packets_));
+    std::vector<Packet> buffer(capacity);
+    for (size_t i = 0; i < size_; ++i) {
+      buffer[i] = std::move(At(i));
+    }
+    buffer_.swap(buffer);
+    begin_ = 0;
+  }
+  // Make room for the new packet on the side with the fewest packets to move.
+  if (index < size_ / 2) {
+    begin_ = begin_ > 0 ? begin_ - 1 : buffer_.size() - 1;
+    for (size_t i = 0; i < index; ++i) {
+      At(i) = std::move(At(i + 1));
+    }
+  } else {
+    for (size_t i = size_; i > index; --i) {
+      At(i) = std::move(At(i - 1));
+    }
+  }
+  At(index) = std::move(packet);
+  ++size_;
+}
+
+void PacketBuffer::PopFront() {
+  RTC_DCHECK_GT(size_, 0);
+  begin_ = begin_ + 1 < buffer_.size() ? begin_ + 1 : 0;
+  --size_;
+}
+
+void PacketBuffer::Clear() {
+  for (size_t i = 0; i < size_; ++i) {
+    At(i) = Packet();
+  }
+  begin_ = 0;
+  size_ = 0;
+}
+
+template <typename Predicate>
+void PacketBuffer::RemoveIf(Predicate remove) {
+  size_t num_kept = 0;
+  for (size_t i = 0; i < size_; ++i) {
+    if (remove(At(i))) {
+      continue;
+    }
+    if (num_kept != i) {
+      At(num_kept) = std::move(At(i));
+    }
+    ++num_kept;
+  }
+  for (size_t i = num_kept; i < size_; ++i) {
+    At(i) = Packet();
+  }
+  size_ = num_kept;
+}
+
 }  // namespace webrtc
@@ -11,6 +11,8 @@
 #ifndef MODULES_AUDIO_CODING_NETEQ_PACKET_BUFFER_H_
 #define MODULES_AUDIO_CODING_NETEQ_PACKET_BUFFER_H_
 
+#include <vector>
+
 #include "absl/types/optional.h"
 #include "modules/audio_coding/neteq/decoder_database.h"
 #include "modules/audio_coding/neteq/packet.h"
@@ -169,9 +171,29 @@ class PacketBuffer {
   }
 
  private:
+  // Returns the packet at `index`, counted from the first packet.
+  Packet& At(size_t index);
+  const Packet& At(size_t index) const;
+  // Inserts `packet` before the packet at `index`.
+  void InsertAt(size_t index, Packet&& packet);
+  // Removes the first packet, which must have been moved from or reset.
+  void PopFront();
+  // Removes all packets.
+  void Clear();
+  // Removes all packets for which `remove` returns true, keeping the order of
+  // the others.
+  template <typename Predicate>
+  void RemoveIf(Predicate remove);
+
   absl::optional<SmartFlushingConfig> smart_flushing_config_;
   size_t max_number_of_packets_;
-  PacketList buffer_;
+  // Sorted packets, stored as a ring buffer starting at `begin_`. Slots are
+  // only allocated when the buffer grows beyond its capacity and are reused
+  // afterwards, which avoids allocations when packets are inserted and
+  // discarded.
+  std::vector<Packet> buffer_;
+  size_t begin_ = 0;
+  size_t size_ = 0;
   const TickTimer* tick_timer_;
   RTC_DISALLOW_COPY_AND_ASSIGN(PacketBuffer);
 };
@@ -13,6 +13,7 @@
 #include "modules/audio_coding/neteq/packet_buffer.h"
 
 #include <memory>
+#include <vector>
 
 #include "api/audio_codecs/builtin_audio_decoder_factory.h"
 #include "api/neteq/tick_timer.h"
@@ -595,6 +596,46 @@ TEST(PacketBuffer, Reordering) {
   EXPECT_CALL(decoder_database, Die());  // Called when object is deleted.
 }
 
+// Inserts packets in reverse order while the first packet in the buffer moves
+// around the ring buffer, so that both halves of the buffer are shifted to make
+// room for the new packets.
+TEST(PacketBuffer, ReorderingWithWrapAround) {
+  TickTimer tick_timer;
+  PacketBuffer buffer(100, &tick_timer);  // 100 packets.
+  const uint32_t start_ts = 4711;
+  const uint32_t ts_increment = 10;
+  PacketGenerator gen(17u, start_ts, 0, ts_increment);
+  const int payload_len = 10;
+  StrictMock<MockStatisticsCalculator> mock_stats;
+  MockDecoderDatabase decoder_database;
+
+  uint32_t current_ts = start_ts;
+  for (int i = 0; i < 20; ++i) {
+    std::vector<Packet> packets;
+    for (int j = 0; j < 4; ++j) {
+      packets.push_back(gen.NextPacket(payload_len, nullptr));
+    }
+    for (int j = 3; j >= 0; --j) {
+      EXPECT_EQ(PacketBuffer::kOK,
+                buffer.InsertPacket(/*packet=*/std::move(packets[j]),
+                                    /*stats=*/&mock_stats,
+                                    /*last_decoded_length=*/payload_len,
+                                    /*sample_rate=*/10000,
+                                    /*target_level_ms=*/60,
+                                    /*decoder_database=*/decoder_database));
+    }
+    // Leave the last packet in the buffer.
+    while (buffer.NumPacketsInBuffer() > 1) {
+      const absl::optional<Packet> packet = buffer.GetNextPacket();
+      ASSERT_TRUE(packet);
+      EXPECT_EQ(current_ts, packet->timestamp);
+      current_ts += ts_increment;
+    }
+  }
+
+  EXPECT_CALL(decoder_database, Die());  // Called when object is deleted.
+}
+
 // The test first inserts a packet with narrow-band CNG, then a packet with
 // wide-band speech. The expected behavior of the packet buffer is to detect a
 // change in sample rate, even though no speech packet has been inserted before,
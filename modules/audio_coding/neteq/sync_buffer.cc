@@ -87,10 +87,10 @@ void SyncBuffer::GetNextAudioInterleaved(size_t requested_len,
   const size_t samples_to_read = std::min(FutureLength(), requested_len);
   output->ResetWithoutMuting();
   const size_t tot_samples_read = ReadInterleavedFromIndex(
-      next_index_, samples_to_read, output->mutable_data());
+      next_index_, samples_to_read,
+      output->mutable_data(samples_to_read, Channels()));
   const size_t samples_read_per_channel = tot_samples_read / Channels();
   next_index_ += samples_read_per_channel;
-  output->num_channels_ = Channels();
   output->samples_per_channel_ = samples_read_per_channel;
 }
 
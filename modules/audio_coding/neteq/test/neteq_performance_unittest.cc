@@ -47,3 +47,25 @@ TEST(NetEqPerformanceTest, 0_Pl_0_Drift) {
   webrtc::test::PrintResult("neteq_performance", "", "0_pl_0_drift", runtime,
                             "ms", true);
 }
+
+// Runs many instances side by side with 10% packet losses and 10% clock drift,
+// to measure the cost of NetEq on a server that handles many streams at once.
+// The total simulation time is the same as in the tests above.
+TEST(NetEqPerformanceTest, 1000_Instances_10_Pl_10_Drift) {
+  const int kNumInstances = 1000;
+  const int kSimulationTimeMs = 10000;
+  const int kQuickSimulationTimeMs = 100;
+  const int kLossPeriod = 10;  // Drop every 10th packet.
+  const double kDriftFactor = 0.1;
+  int64_t runtime =
+      webrtc::test::NetEqPerformanceTest::RunConcurrentInstances(
+          kNumInstances,
+          webrtc::field_trial::IsEnabled("WebRTC-QuickPerfTest")
+              ? kQuickSimulationTimeMs
+              : kSimulationTimeMs,
+          kLossPeriod, kDriftFactor);
+  ASSERT_GT(runtime, 0);
+  webrtc::test::PrintResult("neteq_performance", "",
+                            "1000_instances_10_pl_10_drift", runtime, "ms",
+                            true);
+}
@@ -10,6 +10,10 @@
 
 #include "modules/audio_coding/neteq/tools/neteq_performance_test.h"
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "api/audio/audio_frame.h"
 #include "api/audio_codecs/builtin_audio_decoder_factory.h"
 #include "api/neteq/neteq.h"
@@ -31,92 +35,107 @@ namespace test {
 int64_t NetEqPerformanceTest::Run(int runtime_ms,
                                   int lossrate,
                                   double drift_factor) {
+  return RunConcurrentInstances(1, runtime_ms, lossrate, drift_factor);
+}
+
+int64_t NetEqPerformanceTest::RunConcurrentInstances(int num_instances,
+                                                     int runtime_ms,
+                                                     int lossrate,
+                                                     double drift_factor) {
   const std::string kInputFileName =
       webrtc::test::ResourcePath("audio_coding/testfile32kHz", "pcm");
   const int kSampRateHz = 32000;
-  const std::string kDecoderName = "pcm16-swb32";
   const int kPayloadType = 95;
+  const size_t kInputBlockSizeSamples = 60 * kSampRateHz / 1000;  // 60 ms.
+
+  // A NetEq instance together with the packet stream it receives.
+  struct Instance {
+    std::unique_ptr<NetEq> neteq;
+    std::unique_ptr<RtpGenerator> rtp_gen;
+    RTPHeader rtp_header;
+    int32_t packet_input_time_ms;
+  };
 
-  // Initialize NetEq instance.
+  // Initialize NetEq instances.
   NetEq::Config config;
   config.sample_rate_hz = kSampRateHz;
   webrtc::Clock* clock = webrtc::Clock::GetRealTimeClock();
   auto audio_decoder_factory = CreateBuiltinAudioDecoderFactory();
-  auto neteq =
-      DefaultNetEqFactory().CreateNetEq(config, audio_decoder_factory, clock);
-  // Register decoder in `neteq`.
-  if (!neteq->RegisterPayloadType(kPayloadType,
-                                  SdpAudioFormat("l16", kSampRateHz, 1)))
-    return -1;
+  std::vector<Instance> instances(num_instances);
+  for (Instance& instance : instances) {
+    instance.neteq =
+        DefaultNetEqFactory().CreateNetEq(config, audio_decoder_factory, clock);
+    // Register decoder in `neteq`.
+    if (!instance.neteq->RegisterPayloadType(
+            kPayloadType, SdpAudioFormat("l16", kSampRateHz, 1)))
+      return -1;
+    instance.rtp_gen = std::make_unique<RtpGenerator>(kSampRateHz / 1000);
+    // Start with positive drift first half of simulation.
+    instance.rtp_gen->set_drift_factor(drift_factor);
+    // Get first input packet.
+    instance.packet_input_time_ms = instance.rtp_gen->GetRtpHeader(
+        kPayloadType, kInputBlockSizeSamples, &instance.rtp_header);
+  }
 
-  // Set up AudioLoop object.
+  // Set up AudioLoop object. The instances take turns to encode the next
+  // block of the loop.
   AudioLoop audio_loop;
   const size_t kMaxLoopLengthSamples = kSampRateHz * 10;  // 10 second loop.
-  const size_t kInputBlockSizeSamples = 60 * kSampRateHz / 1000;  // 60 ms.
   if (!audio_loop.Init(kInputFileName, kMaxLoopLengthSamples,
                        kInputBlockSizeSamples))
     return -1;
 
   int32_t time_now_ms = 0;
-
-  // Get first input packet.
-  RTPHeader rtp_header;
-  RtpGenerator rtp_gen(kSampRateHz / 1000);
-  // Start with positive drift first half of simulation.
-  rtp_gen.set_drift_factor(drift_factor);
   bool drift_flipped = false;
-  int32_t packet_input_time_ms =
-      rtp_gen.GetRtpHeader(kPayloadType, kInputBlockSizeSamples, &rtp_header);
-  auto input_samples = audio_loop.GetNextBlock();
-  if (input_samples.empty())
-    exit(1);
   uint8_t input_payload[kInputBlockSizeSamples * sizeof(int16_t)];
-  size_t payload_len = WebRtcPcm16b_Encode(input_samples.data(),
-                                           input_samples.size(), input_payload);
-  RTC_CHECK_EQ(sizeof(input_payload), payload_len);
 
   // Main loop.
   int64_t start_time_ms = clock->TimeInMilliseconds();
   AudioFrame out_frame;
   while (time_now_ms < runtime_ms) {
-    while (packet_input_time_ms <= time_now_ms) {
-      // Drop every N packets, where N = FLAG_lossrate.
-      bool lost = false;
-      if (lossrate > 0) {
-        lost = ((rtp_header.sequenceNumber - 1) % lossrate) == 0;
-      }
-      if (!lost) {
-        // Insert packet.
-        int error = neteq->InsertPacket(rtp_header, input_payload);
-        if (error != NetEq::kOK)
-          return -1;
+    for (Instance& instance : instances) {
+      while (instance.packet_input_time_ms <= time_now_ms) {
+        // Drop every N packets, where N = FLAG_lossrate.
+        bool lost = false;
+        if (lossrate > 0) {
+          lost = ((instance.rtp_header.sequenceNumber - 1) % lossrate) == 0;
+        }
+        if (!lost) {
+          auto input_samples = audio_loop.GetNextBlock();
+          if (input_samples.empty())
+            return -1;
+          size_t payload_len = WebRtcPcm16b_Encode(
+              input_samples.data(), input_samples.size(), input_payload);
+          RTC_CHECK_EQ(sizeof(input_payload), payload_len);
+          // Insert packet.
+          int error =
+              instance.neteq->InsertPacket(instance.rtp_header, input_payload);
+          if (error != NetEq::kOK)
+            return -1;
+        }
+
+        // Get next packet.
+        instance.packet_input_time_ms = instance.rtp_gen->GetRtpHeader(
+            kPayloadType, kInputBlockSizeSamples, &instance.rtp_header);
       }
 
-      // Get next packet.
-      packet_input_time_ms = rtp_gen.GetRtpHeader(
-          kPayloadType, kInputBlockSizeSamples, &rtp_header);
-      input_samples = audio_loop.GetNextBlock();
-      if (input_samples.empty())
+      // Get output audio, but don't do anything with it.
+      bool muted;
+      int error = instance.neteq->GetAudio(&out_frame, &muted);
+      RTC_CHECK(!muted);
+      if (error != NetEq::kOK)
         return -1;
-      payload_len = WebRtcPcm16b_Encode(input_samples.data(),
-                                        input_samples.size(), input_payload);
-      RTC_DCHECK_EQ(payload_len, kInputBlockSizeSamples * sizeof(int16_t));
-    }
 
-    // Get output audio, but don't do anything with it.
-    bool muted;
-    int error = neteq->GetAudio(&out_frame, &muted);
-    RTC_CHECK(!muted);
-    if (error != NetEq::kOK)
-      return -1;
-
-    RTC_DCHECK_EQ(out_frame.samples_per_channel_, (kSampRateHz * 10) / 1000);
+      RTC_DCHECK_EQ(out_frame.samples_per_channel_, (kSampRateHz * 10) / 1000);
+    }
 
     static const int kOutputBlockSizeMs = 10;
     time_now_ms += kOutputBlockSizeMs;
     if (time_now_ms >= runtime_ms / 2 && !drift_flipped) {
       // Apply negative drift second half of simulation.
-      rtp_gen.set_drift_factor(-drift_factor);
+      for (Instance& instance : instances) {
+        instance.rtp_gen->set_drift_factor(-drift_factor);
+      }
       drift_flipped = true;
     }
   }
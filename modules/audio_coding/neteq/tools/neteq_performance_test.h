@@ -24,6 +24,16 @@ class NetEqPerformanceTest {
   //   `drift_factor`: clock drift in [0, 1].
   // Returns the runtime in ms.
   static int64_t Run(int runtime_ms, int lossrate, double drift_factor);
+
+  // Runs `num_instances` NetEq instances side by side, with the same
+  // parameters as Run(). Each instance receives its own packet stream and all
+  // instances are asked for 10 ms of audio before the simulation time
+  // advances, as on a server that handles many streams at once.
+  // Returns the runtime in ms.
+  static int64_t RunConcurrentInstances(int num_instances,
+                                        int runtime_ms,
+                                        int lossrate,
+                                        double drift_factor);
 };
 
 }  // namespace test
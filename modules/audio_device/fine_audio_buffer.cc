@@ -19,25 +19,46 @@
 #include "rtc_base/numerics/safe_conversions.h"
 
 namespace webrtc {
+namespace {
+
+size_t SamplesPerChunk(int sample_rate_hz, int chunk_duration_us) {
+  const int64_t scaled_samples =
+      static_cast<int64_t>(sample_rate_hz) * chunk_duration_us;
+  RTC_DCHECK_EQ(scaled_samples % 1000000, 0)
+      << "Chunk of " << chunk_duration_us << " us at " << sample_rate_hz
+      << " Hz";
+  return rtc::dchecked_cast<size_t>(scaled_samples / 1000000);
+}
+
+}  // namespace
+
+constexpr int FineAudioBuffer::kDefaultChunkDurationUs;
 
 FineAudioBuffer::FineAudioBuffer(AudioDeviceBuffer* audio_device_buffer)
+    : FineAudioBuffer(audio_device_buffer, kDefaultChunkDurationUs) {}
+
+FineAudioBuffer::FineAudioBuffer(AudioDeviceBuffer* audio_device_buffer,
+                                 int chunk_duration_us)
     : audio_device_buffer_(audio_device_buffer),
-      playout_samples_per_channel_10ms_(rtc::dchecked_cast<size_t>(
-          audio_device_buffer->PlayoutSampleRate() * 10 / 1000)),
-      record_samples_per_channel_10ms_(rtc::dchecked_cast<size_t>(
-          audio_device_buffer->RecordingSampleRate() * 10 / 1000)),
+      playout_samples_per_channel_chunk_(SamplesPerChunk(
+          audio_device_buffer->PlayoutSampleRate(), chunk_duration_us)),
+      record_samples_per_channel_chunk_(SamplesPerChunk(
+          audio_device_buffer->RecordingSampleRate(), chunk_duration_us)),
       playout_channels_(audio_device_buffer->PlayoutChannels()),
       record_channels_(audio_device_buffer->RecordingChannels()) {
   RTC_DCHECK(audio_device_buffer_);
+  RTC_DCHECK_GT(chunk_duration_us, 0);
+  RTC_DCHECK_LE(chunk_duration_us, kDefaultChunkDurationUs);
   RTC_DLOG(LS_INFO) << __FUNCTION__;
+  RTC_DLOG(LS_INFO) << "chunk_duration_us: " << chunk_duration_us;
   if (IsReadyForPlayout()) {
-    RTC_DLOG(LS_INFO) << "playout_samples_per_channel_10ms: "
-                      << playout_samples_per_channel_10ms_;
+    RTC_DLOG(LS_INFO) << "playout_samples_per_channel_chunk: "
+                      << playout_samples_per_channel_chunk_;
     RTC_DLOG(LS_INFO) << "playout_channels: " << playout_channels_;
   }
   if (IsReadyForRecord()) {
-    RTC_DLOG(LS_INFO) << "record_samples_per_channel_10ms: "
-                      << record_samples_per_channel_10ms_;
+    RTC_DLOG(LS_INFO) << "record_samples_per_channel_chunk: "
+                      << record_samples_per_channel_chunk_;
     RTC_DLOG(LS_INFO) << "record_channels: " << record_channels_;
   }
 }
@@ -55,36 +76,36 @@ void FineAudioBuffer::ResetRecord() {
 }
 
 bool FineAudioBuffer::IsReadyForPlayout() const {
-  return playout_samples_per_channel_10ms_ > 0 && playout_channels_ > 0;
+  return playout_samples_per_channel_chunk_ > 0 && playout_channels_ > 0;
 }
 
 bool FineAudioBuffer::IsReadyForRecord() const {
-  return record_samples_per_channel_10ms_ > 0 && record_channels_ > 0;
+  return record_samples_per_channel_chunk_ > 0 && record_channels_ > 0;
 }
 
 void FineAudioBuffer::GetPlayoutData(rtc::ArrayView<int16_t> audio_buffer,
                                      int playout_delay_ms) {
   RTC_DCHECK(IsReadyForPlayout());
-  // Ask WebRTC for new data in chunks of 10ms until we have enough to
-  // fulfill the request. It is possible that the buffer already contains
+  // Ask WebRTC for new data in chunks until we have enough to fulfill the
+  // request. It is possible that the buffer already contains
   // enough samples from the last round.
   while (playout_buffer_.size() < audio_buffer.size()) {
-    // Get 10ms decoded audio from WebRTC. The ADB knows about number of
+    // Get a chunk of decoded audio from WebRTC. The ADB knows about number of
     // channels; hence we can ask for number of samples per channel here.
     if (audio_device_buffer_->RequestPlayoutData(
-            playout_samples_per_channel_10ms_) ==
-        static_cast<int32_t>(playout_samples_per_channel_10ms_)) {
-      // Append 10ms to the end of the local buffer taking number of channels
-      // into account.
-      const size_t num_elements_10ms =
-          playout_channels_ * playout_samples_per_channel_10ms_;
+            playout_samples_per_channel_chunk_) ==
+        static_cast<int32_t>(playout_samples_per_channel_chunk_)) {
+      // Append the chunk to the end of the local buffer taking number of
+      // channels into account.
+      const size_t num_elements_chunk =
+          playout_channels_ * playout_samples_per_channel_chunk_;
       const size_t written_elements = playout_buffer_.AppendData(
-          num_elements_10ms, [&](rtc::ArrayView<int16_t> buf) {
-            const size_t samples_per_channel_10ms =
+          num_elements_chunk, [&](rtc::ArrayView<int16_t> buf) {
+            const size_t samples_per_channel_chunk =
                 audio_device_buffer_->GetPlayoutData(buf.data());
-            return playout_channels_ * samples_per_channel_10ms;
+            return playout_channels_ * samples_per_channel_chunk;
           });
-      RTC_DCHECK_EQ(num_elements_10ms, written_elements);
+      RTC_DCHECK_EQ(num_elements_chunk, written_elements);
     } else {
       // Provide silence if AudioDeviceBuffer::RequestPlayoutData() fails.
       // Can e.g. happen when an AudioTransport has not been registered.
@@ -111,19 +132,19 @@ void FineAudioBuffer::DeliverRecordedData(
   RTC_DCHECK(IsReadyForRecord());
   // Always append new data and grow the buffer when needed.
   record_buffer_.AppendData(audio_buffer.data(), audio_buffer.size());
-  // Consume samples from buffer in chunks of 10ms until there is not
-  // enough data left. The number of remaining samples in the cache is given by
-  // the new size of the internal `record_buffer_`.
-  const size_t num_elements_10ms =
-      record_channels_ * record_samples_per_channel_10ms_;
-  while (record_buffer_.size() >= num_elements_10ms) {
+  // Consume samples from buffer in chunks until there is not enough data
+  // left. The number of remaining samples in the cache is given by the new
+  // size of the internal `record_buffer_`.
+  const size_t num_elements_chunk =
+      record_channels_ * record_samples_per_channel_chunk_;
+  while (record_buffer_.size() >= num_elements_chunk) {
     audio_device_buffer_->SetRecordedBuffer(record_buffer_.data(),
-                                            record_samples_per_channel_10ms_);
+                                            record_samples_per_channel_chunk_);
     audio_device_buffer_->SetVQEData(playout_delay_ms_, record_delay_ms);
     audio_device_buffer_->DeliverRecordedData();
-    memmove(record_buffer_.data(), record_buffer_.data() + num_elements_10ms,
-            (record_buffer_.size() - num_elements_10ms) * sizeof(int16_t));
-    record_buffer_.SetSize(record_buffer_.size() - num_elements_10ms);
+    memmove(record_buffer_.data(), record_buffer_.data() + num_elements_chunk,
+            (record_buffer_.size() - num_elements_chunk) * sizeof(int16_t));
+    record_buffer_.SetSize(record_buffer_.size() - num_elements_chunk);
   }
 }
 
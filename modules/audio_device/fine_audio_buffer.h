@@ -27,10 +27,20 @@ class AudioDeviceBuffer;
 // buffers differs from 10ms.
 // As an example: calling DeliverRecordedData() with 5ms buffers will deliver
 // accumulated 10ms worth of data to the ADB every second call.
+// If the AudioTransport behind the ADB handles chunks shorter than 10ms, e.g.,
+// 2.5ms or 5ms, their duration can be set at construction; devices with such
+// short periods then exchange audio with the ADB without extra buffering.
 class FineAudioBuffer {
  public:
+  static constexpr int kDefaultChunkDurationUs = 10000;
+
   // `device_buffer` is a buffer that provides 10ms of audio data.
-  FineAudioBuffer(AudioDeviceBuffer* audio_device_buffer);
+  explicit FineAudioBuffer(AudioDeviceBuffer* audio_device_buffer);
+  // `chunk_duration_us` is the duration of the audio exchanged with
+  // `audio_device_buffer`. It must correspond to a whole number of samples at
+  // the playout and recording sample rates.
+  FineAudioBuffer(AudioDeviceBuffer* audio_device_buffer,
+                  int chunk_duration_us);
   ~FineAudioBuffer();
 
   // Clears buffers and counters dealing with playout and/or recording.
@@ -52,9 +62,10 @@ class FineAudioBuffer {
                       int playout_delay_ms);
 
   // Consumes the audio data in `audio_buffer` and sends it to the WebRTC layer
-  // in chunks of 10ms. The sum of the provided delay estimate in
-  // `record_delay_ms` and the latest `playout_delay_ms` in GetPlayoutData()
-  // are given to the AEC in the audio processing module.
+  // in chunks of 10ms, or of the chunk duration given at construction. The sum
+  // of the provided delay estimate in `record_delay_ms` and the latest
+  // `playout_delay_ms` in GetPlayoutData() are given to the AEC in the audio
+  // processing module.
   // They can be fixed values on most platforms and they are ignored if an
   // external (hardware/built-in) AEC is used.
   // Example: buffer size is 5ms => call #1 stores 5ms of data, call #2 stores
@@ -71,10 +82,10 @@ class FineAudioBuffer {
   // class and the owner must ensure that the pointer is valid during the life-
   // time of this object.
   AudioDeviceBuffer* const audio_device_buffer_;
-  // Number of audio samples per channel per 10ms. Set once at construction
+  // Number of audio samples per channel per chunk. Set once at construction
   // based on parameters in `audio_device_buffer`.
-  const size_t playout_samples_per_channel_10ms_;
-  const size_t record_samples_per_channel_10ms_;
+  const size_t playout_samples_per_channel_chunk_;
+  const size_t record_samples_per_channel_chunk_;
   // Number of audio channels. Set once at construction based on parameters in
   // `audio_device_buffer`.
   const size_t playout_channels_;
@@ -83,7 +94,7 @@ class FineAudioBuffer {
   // in any size using GetPlayoutData().
   rtc::BufferT<int16_t> playout_buffer_;
   // Storage for input samples that are about to be delivered to the WebRTC
-  // ADB or remains from the last successful delivery of a 10ms audio buffer.
+  // ADB or remains from the last successful delivery of an audio chunk.
   rtc::BufferT<int16_t> record_buffer_;
   // Contains latest delay estimate given to GetPlayoutData().
   int playout_delay_ms_ = 0;
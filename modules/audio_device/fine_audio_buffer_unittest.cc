@@ -86,45 +86,54 @@ ACTION_P2(VerifyInputBuffer, iteration, samples_per_10_ms) {
   return 0;
 }
 
-void RunFineBufferTest(int frame_size_in_samples) {
+// Runs the test with chunks of `chunk_duration_us` exchanged with the ADB at
+// `sample_rate`.
+void RunFineBufferTest(int frame_size_in_samples,
+                       int sample_rate = kSampleRate,
+                       int chunk_duration_us =
+                           FineAudioBuffer::kDefaultChunkDurationUs) {
   const int kFrameSizeSamples = frame_size_in_samples;
   const int kNumberOfFrames = 5;
+  const int kSamplesPerChunk =
+      static_cast<int64_t>(sample_rate) * chunk_duration_us / 1000000;
   // Ceiling of integer division: 1 + ((x - 1) / y)
   const int kNumberOfUpdateBufferCalls =
-      1 + ((kNumberOfFrames * frame_size_in_samples - 1) / kSamplesPer10Ms);
+      1 + ((kNumberOfFrames * frame_size_in_samples - 1) / kSamplesPerChunk);
+  const int kNumberOfDeliverCalls =
+      kNumberOfFrames * frame_size_in_samples / kSamplesPerChunk;
 
   auto task_queue_factory = CreateDefaultTaskQueueFactory();
   MockAudioDeviceBuffer audio_device_buffer(task_queue_factory.get());
-  audio_device_buffer.SetPlayoutSampleRate(kSampleRate);
+  audio_device_buffer.SetPlayoutSampleRate(sample_rate);
   audio_device_buffer.SetPlayoutChannels(kChannels);
-  audio_device_buffer.SetRecordingSampleRate(kSampleRate);
+  audio_device_buffer.SetRecordingSampleRate(sample_rate);
   audio_device_buffer.SetRecordingChannels(kChannels);
 
-  EXPECT_CALL(audio_device_buffer, RequestPlayoutData(_))
-      .WillRepeatedly(Return(kSamplesPer10Ms));
+  EXPECT_CALL(audio_device_buffer, RequestPlayoutData(kSamplesPerChunk))
+      .WillRepeatedly(Return(kSamplesPerChunk));
   {
     InSequence s;
     for (int i = 0; i < kNumberOfUpdateBufferCalls; ++i) {
       EXPECT_CALL(audio_device_buffer, GetPlayoutData(_))
-          .WillOnce(UpdateBuffer(i, kChannels * kSamplesPer10Ms))
+          .WillOnce(UpdateBuffer(i, kChannels * kSamplesPerChunk))
           .RetiresOnSaturation();
     }
   }
   {
     InSequence s;
-    for (int j = 0; j < kNumberOfUpdateBufferCalls - 1; ++j) {
-      EXPECT_CALL(audio_device_buffer, SetRecordedBuffer(_, kSamplesPer10Ms))
-          .WillOnce(VerifyInputBuffer(j, kChannels * kSamplesPer10Ms))
+    for (int j = 0; j < kNumberOfDeliverCalls; ++j) {
+      EXPECT_CALL(audio_device_buffer, SetRecordedBuffer(_, kSamplesPerChunk))
+          .WillOnce(VerifyInputBuffer(j, kChannels * kSamplesPerChunk))
           .RetiresOnSaturation();
     }
   }
   EXPECT_CALL(audio_device_buffer, SetVQEData(_, _))
-      .Times(kNumberOfUpdateBufferCalls - 1);
+      .Times(kNumberOfDeliverCalls);
   EXPECT_CALL(audio_device_buffer, DeliverRecordedData())
-      .Times(kNumberOfUpdateBufferCalls - 1)
+      .Times(kNumberOfDeliverCalls)
       .WillRepeatedly(Return(0));
 
-  FineAudioBuffer fine_buffer(&audio_device_buffer);
+  FineAudioBuffer fine_buffer(&audio_device_buffer, chunk_duration_us);
   std::unique_ptr<int16_t[]> out_buffer(
       new int16_t[kChannels * kFrameSizeSamples]);
   std::unique_ptr<int16_t[]> in_buffer(
@@ -155,4 +164,15 @@ TEST(FineBufferTest, GreaterThan10ms) {
   RunFineBufferTest(kFrameSizeSamples);
 }
 
+TEST(FineBufferTest, ShortChunksMatchingDevicePeriod) {
+  // 5ms device periods with 5ms and 2.5ms chunks at 48kHz.
+  RunFineBufferTest(240, 48000, 5000);
+  RunFineBufferTest(240, 48000, 2500);
+}
+
+TEST(FineBufferTest, ShortChunksWithOtherDevicePeriod) {
+  RunFineBufferTest(100, 48000, 2500);
+  RunFineBufferTest(300, 48000, 5000);
+}
+
 }  // namespace webrtc
@@ -11,9 +11,13 @@
 #include "modules/audio_device/linux/audio_device_alsa_linux.h"
 
 
+#include "api/units/time_delta.h"
 #include "modules/audio_device/audio_device_config.h"
+#include "rtc_base/experiments/field_trial_parser.h"
+#include "rtc_base/experiments/field_trial_units.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/system/arch.h"
+#include "system_wrappers/include/field_trial.h"
 #include "system_wrappers/include/sleep.h"
 
 WebRTCAlsaSymbolTable* GetAlsaSymbolTable() {
@@ -61,6 +65,18 @@ static const unsigned int ALSA_CAPTURE_CH = 2;
 static const unsigned int ALSA_CAPTURE_LATENCY = 40 * 1000;  // in us
 static const unsigned int ALSA_CAPTURE_WAIT_TIMEOUT = 5;     // in ms
 
+// Returns the overall latency to request from the device, in us. The
+// WebRTC-Audio-LinuxLowLatency field trial lowers it from `default_latency_us`,
+// which also shortens the period ALSA picks, at a higher risk of xruns.
+static unsigned int GetLatencyUs(unsigned int default_latency_us) {
+  FieldTrialFlag low_latency("Enabled");
+  FieldTrialParameter<TimeDelta> latency("alsa_latency", TimeDelta::Millis(20));
+  ParseFieldTrial({&low_latency, &latency},
+                  field_trial::FindFullName("WebRTC-Audio-LinuxLowLatency"));
+  return low_latency ? static_cast<unsigned int>(latency->us())
+                     : default_latency_us;
+}
+
 #define FUNC_GET_NUM_OF_DEVICE 0
 #define FUNC_GET_DEVICE_NAME 1
 #define FUNC_GET_DEVICE_NAME_FOR_AN_ENUM 2
@@ -810,9 +826,8 @@ int32_t AudioDeviceLinuxALSA::InitPlayoutLocked() {
            _playChannels,                  // channels
            _playoutFreq,                   // rate
            1,                              // soft_resample
-           ALSA_PLAYOUT_LATENCY  // 40*1000 //latency required overall latency
-                                 // in us
-           )) < 0) {             /* 0.5sec */
+           GetLatencyUs(ALSA_PLAYOUT_LATENCY)  // overall latency in us
+           )) < 0) {
     _playoutFramesIn10MS = 0;
     RTC_LOG(LS_ERROR) << "unable to set playback device: "
                       << LATE(snd_strerror)(errVal) << " (" << errVal << ")";
@@ -923,6 +938,7 @@ int32_t AudioDeviceLinuxALSA::InitRecordingLocked() {
   }
 
   _recordingFramesIn10MS = _recordingFreq / 100;
+  const unsigned int capture_latency_us = GetLatencyUs(ALSA_CAPTURE_LATENCY);
   if ((errVal =
            LATE(snd_pcm_set_params)(_handleRecord,
 #if defined(WEBRTC_ARCH_BIG_ENDIAN)
@@ -934,7 +950,7 @@ int32_t AudioDeviceLinuxALSA::InitRecordingLocked() {
                                     _recChannels,                   // channels
                                     _recordingFreq,                 // rate
                                     1,                    // soft_resample
-                                    ALSA_CAPTURE_LATENCY  // latency in us
+                                    capture_latency_us  // latency in us
                                     )) < 0) {
     // Fall back to another mode then.
     if (_recChannels == 1)
@@ -953,7 +969,7 @@ int32_t AudioDeviceLinuxALSA::InitRecordingLocked() {
                                       _recChannels,         // channels
                                       _recordingFreq,       // rate
                                       1,                    // soft_resample
-                                      ALSA_CAPTURE_LATENCY  // latency in us
+                                      capture_latency_us  // latency in us
                                       )) < 0) {
       _recordingFramesIn10MS = 0;
       RTC_LOG(LS_ERROR) << "unable to set record settings: "
@@ -12,10 +12,16 @@
 
 #include <string.h>
 
+#include <algorithm>
+
+#include "api/units/time_delta.h"
 #include "modules/audio_device/linux/latebindingsymboltable_linux.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/experiments/field_trial_parser.h"
+#include "rtc_base/experiments/field_trial_units.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/platform_thread.h"
+#include "system_wrappers/include/field_trial.h"
 
 WebRTCPulseSymbolTable* GetPulseSymbolTable() {
   static WebRTCPulseSymbolTable* pulse_symbol_table =
@@ -70,6 +76,9 @@ AudioDeviceLinuxPulse::AudioDeviceLinuxPulse()
       _tempSampleDataSize(0),
       _configuredLatencyPlay(0),
       _configuredLatencyRec(0),
+      _playbackLatencyMsecs(WEBRTC_PA_PLAYBACK_LATENCY_MINIMUM_MSECS),
+      _maxPlaybackLatencyMsecs(0),
+      _captureLatencyMsecs(WEBRTC_PA_LOW_CAPTURE_LATENCY_MSECS),
       _paDeviceIndex(-1),
       _paStateChanged(false),
       _paMainloop(NULL),
@@ -85,6 +94,23 @@ AudioDeviceLinuxPulse::AudioDeviceLinuxPulse()
   memset(&_playBufferAttr, 0, sizeof(_playBufferAttr));
   memset(&_recBufferAttr, 0, sizeof(_recBufferAttr));
   memset(_oldKeyState, 0, sizeof(_oldKeyState));
+
+  FieldTrialFlag low_latency("Enabled");
+  FieldTrialParameter<TimeDelta> playout_latency("pulse_playout_latency",
+                                                 TimeDelta::Millis(10));
+  FieldTrialParameter<TimeDelta> max_playout_latency(
+      "pulse_max_playout_latency", TimeDelta::Millis(40));
+  FieldTrialParameter<TimeDelta> capture_latency("pulse_capture_latency",
+                                                 TimeDelta::Millis(5));
+  ParseFieldTrial(
+      {&low_latency, &playout_latency, &max_playout_latency, &capture_latency},
+      field_trial::FindFullName("WebRTC-Audio-LinuxLowLatency"));
+  if (low_latency) {
+    _playbackLatencyMsecs = static_cast<uint32_t>(playout_latency->ms());
+    _maxPlaybackLatencyMsecs = static_cast<uint32_t>(
+        std::max(max_playout_latency->ms(), playout_latency->ms()));
+    _captureLatencyMsecs = static_cast<uint32_t>(capture_latency->ms());
+  }
 }
 
 AudioDeviceLinuxPulse::~AudioDeviceLinuxPulse() {
@@ -912,8 +938,8 @@ int32_t AudioDeviceLinuxPulse::InitPlayout() {
     }
 
     size_t bytesPerSec = LATE(pa_bytes_per_second)(spec);
-    uint32_t latency = bytesPerSec * WEBRTC_PA_PLAYBACK_LATENCY_MINIMUM_MSECS /
-                       WEBRTC_PA_MSECS_PER_SEC;
+    uint32_t latency =
+        bytesPerSec * _playbackLatencyMsecs / WEBRTC_PA_MSECS_PER_SEC;
 
     // Set the play buffer attributes
     _playBufferAttr.maxlength = latency;  // num bytes stored in the buffer
@@ -1013,8 +1039,8 @@ int32_t AudioDeviceLinuxPulse::InitRecording() {
     }
 
     size_t bytesPerSec = LATE(pa_bytes_per_second)(spec);
-    uint32_t latency = bytesPerSec * WEBRTC_PA_LOW_CAPTURE_LATENCY_MSECS /
-                       WEBRTC_PA_MSECS_PER_SEC;
+    uint32_t latency =
+        bytesPerSec * _captureLatencyMsecs / WEBRTC_PA_MSECS_PER_SEC;
 
     // Set the rec buffer attributes
     // Note: fragsize specifies a maximum transfer size, not a minimum, so
@@ -1781,6 +1807,15 @@ void AudioDeviceLinuxPulse::PaStreamUnderflowCallbackHandler() {
       _configuredLatencyPlay + bytesPerSec *
                                    WEBRTC_PA_PLAYBACK_LATENCY_INCREMENT_MSECS /
                                    WEBRTC_PA_MSECS_PER_SEC;
+  if (_maxPlaybackLatencyMsecs > 0) {
+    const uint32_t maxLatency =
+        bytesPerSec * _maxPlaybackLatencyMsecs / WEBRTC_PA_MSECS_PER_SEC;
+    if (static_cast<uint32_t>(_configuredLatencyPlay) >= maxLatency) {
+      // Already at the highest latency allowed in low latency mode.
+      return;
+    }
+    newLatency = std::min(newLatency, maxLatency);
+  }
 
   // Set the play buffer attributes
   _playBufferAttr.maxlength = newLatency;
@@ -323,6 +323,12 @@ class AudioDeviceLinuxPulse : public AudioDeviceGeneric {
   int32_t _configuredLatencyPlay;
   int32_t _configuredLatencyRec;
 
+  // Latency targets. The WebRTC-Audio-LinuxLowLatency field trial lowers them
+  // and caps how far underflows can raise the playout latency.
+  uint32_t _playbackLatencyMsecs;
+  uint32_t _maxPlaybackLatencyMsecs;  // 0 means no limit.
+  uint32_t _captureLatencyMsecs;
+
   // PulseAudio
   uint16_t _paDeviceIndex;
   bool _paStateChanged;
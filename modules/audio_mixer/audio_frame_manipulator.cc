@@ -44,7 +44,8 @@ void Ramp(float start_gain, float target_gain, AudioFrame* audio_frame) {
   RTC_DCHECK_LT(0, samples);
   float increment = (target_gain - start_gain) / samples;
   float gain = start_gain;
-  int16_t* frame_data = audio_frame->mutable_data();
+  int16_t* frame_data =
+      audio_frame->mutable_data(samples, audio_frame->num_channels_);
   for (size_t i = 0; i < samples; ++i) {
     // If the audio is interleaved of several channels, we want to
     // apply the same gain change to the ith sample of every channel.
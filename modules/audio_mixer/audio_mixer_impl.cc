@@ -14,14 +14,17 @@
 
 #include <algorithm>
 #include <iterator>
+#include <string>
 #include <type_traits>
 #include <utility>
 
+#include "absl/types/optional.h"
 #include "modules/audio_mixer/audio_frame_manipulator.h"
 #include "modules/audio_mixer/default_output_rate_calculator.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/ref_counted_object.h"
+#include "rtc_base/time_utils.h"
 
 namespace webrtc {
 
@@ -34,6 +37,12 @@ struct AudioMixerImpl::SourceStatus {
 
   // A frame that will be passed to audio_source->GetAudioFrameWithInfo.
   AudioFrame audio_frame;
+  // Result of the last call to GetAudioFrameWithInfo.
+  Source::AudioFrameInfo audio_frame_info = Source::AudioFrameInfo::kMuted;
+  uint32_t energy = 0;
+  TimeDelta get_audio_duration = TimeDelta::Zero();
+  // Mixes the audio for the participant of this source in MixMinus().
+  std::unique_ptr<FrameCombiner> mix_minus_combiner;
 };
 
 namespace {
@@ -97,6 +106,26 @@ void RampAndUpdateGain(
   }
 }
 
+// Gets the next frame of a source and computes its energy.
+void FetchAudio(AudioMixerImpl::SourceStatus* status, int output_frequency) {
+  const int64_t start_us = rtc::TimeMicros();
+  status->audio_frame_info = status->audio_source->GetAudioFrameWithInfo(
+      output_frequency, &status->audio_frame);
+  status->energy =
+      status->audio_frame_info == AudioMixer::Source::AudioFrameInfo::kNormal
+          ? AudioMixerCalculateEnergy(status->audio_frame)
+          : 0;
+  status->get_audio_duration =
+      TimeDelta::Micros(rtc::TimeMicros() - start_us);
+}
+
+// Marks a source that is not asked for audio as muted.
+void SkipAudio(AudioMixerImpl::SourceStatus* status) {
+  status->audio_frame_info = AudioMixer::Source::AudioFrameInfo::kMuted;
+  status->energy = 0;
+  status->get_audio_duration = TimeDelta::Zero();
+}
+
 std::vector<std::unique_ptr<AudioMixerImpl::SourceStatus>>::const_iterator
 FindSourceInList(
     AudioMixerImpl::Source const* audio_source,
@@ -122,23 +151,48 @@ struct AudioMixerImpl::HelperContainers {
   std::vector<SourceFrame> audio_source_mixing_data_list;
   std::vector<SourceFrame> ramp_list;
   std::vector<int> preferred_rates;
+  // Sources with an audio level estimate and the estimate.
+  std::vector<std::pair<int, SourceStatus*>> leveled_sources;
+  std::vector<AudioFrame*> mix_minus_list;
 };
 
 AudioMixerImpl::AudioMixerImpl(
     std::unique_ptr<OutputRateCalculator> output_rate_calculator,
     bool use_limiter,
-    int max_sources_to_mix)
+    int max_sources_to_mix,
+    int num_worker_threads,
+    int max_sources_to_fetch)
     : max_sources_to_mix_(max_sources_to_mix),
+      max_sources_to_fetch_(max_sources_to_fetch),
+      use_limiter_(use_limiter),
       output_rate_calculator_(std::move(output_rate_calculator)),
       audio_source_list_(),
       helper_containers_(std::make_unique<HelperContainers>()),
       frame_combiner_(use_limiter) {
   RTC_CHECK_GE(max_sources_to_mix, 1) << "At least one source must be mixed";
+  RTC_DCHECK_GE(num_worker_threads, 0);
+  RTC_DCHECK(max_sources_to_fetch == 0 ||
+             max_sources_to_fetch >= max_sources_to_mix);
   audio_source_list_.reserve(max_sources_to_mix);
   helper_containers_->resize(max_sources_to_mix);
+  for (int i = 0; i < num_worker_threads; ++i) {
+    start_events_.push_back(std::make_unique<rtc::Event>());
+    rtc::Event* start = start_events_.back().get();
+    threads_.push_back(rtc::PlatformThread::SpawnJoinable(
+        [this, start] { RunWorker(start); }, "AudioMixer" + std::to_string(i),
+        rtc::ThreadAttributes().SetPriority(rtc::ThreadPriority::kRealtime)));
+  }
 }
 
-AudioMixerImpl::~AudioMixerImpl() {}
+AudioMixerImpl::~AudioMixerImpl() {
+  quit_.store(true);
+  for (auto& start : start_events_) {
+    start->Set();
+  }
+  for (rtc::PlatformThread& thread : threads_) {
+    thread.Finalize();
+  }
+}
 
 rtc::scoped_refptr<AudioMixerImpl> AudioMixerImpl::Create(
     int max_sources_to_mix) {
@@ -150,9 +204,12 @@ rtc::scoped_refptr<AudioMixerImpl> AudioMixerImpl::Create(
 rtc::scoped_refptr<AudioMixerImpl> AudioMixerImpl::Create(
     std::unique_ptr<OutputRateCalculator> output_rate_calculator,
     bool use_limiter,
-    int max_sources_to_mix) {
+    int max_sources_to_mix,
+    int num_worker_threads,
+    int max_sources_to_fetch) {
   return rtc::make_ref_counted<AudioMixerImpl>(
-      std::move(output_rate_calculator), use_limiter, max_sources_to_mix);
+      std::move(output_rate_calculator), use_limiter, max_sources_to_mix,
+      num_worker_threads, max_sources_to_fetch);
 }
 
 void AudioMixerImpl::Mix(size_t number_of_channels,
@@ -172,11 +229,45 @@ void AudioMixerImpl::Mix(size_t number_of_channels,
       rtc::ArrayView<const int>(helper_containers_->preferred_rates.data(),
                                 number_of_streams));
 
-  frame_combiner_.Combine(GetAudioFromSources(output_frequency),
-                          number_of_channels, output_frequency,
+  rtc::ArrayView<AudioFrame* const> audio_to_mix =
+      GetAudioFromSources(output_frequency);
+  last_output_frequency_ = output_frequency;
+  last_number_of_channels_ = number_of_channels;
+  last_number_of_streams_ = number_of_streams;
+  last_mix_size_ = audio_to_mix.size();
+  frame_combiner_.Combine(audio_to_mix, number_of_channels, output_frequency,
                           number_of_streams, audio_frame_for_mixing);
 }
 
+bool AudioMixerImpl::MixMinus(Source* audio_source,
+                              AudioFrame* audio_frame_for_mixing) {
+  RTC_DCHECK(audio_source);
+  MutexLock lock(&mutex_);
+  const auto iter = FindSourceInList(audio_source, &audio_source_list_);
+  RTC_DCHECK(iter != audio_source_list_.end()) << "Source not present in mixer";
+  if (iter == audio_source_list_.end() || !(*iter)->is_mixed) {
+    return false;
+  }
+  SourceStatus* const status = iter->get();
+  std::vector<AudioFrame*>& mix_minus_list =
+      helper_containers_->mix_minus_list;
+  mix_minus_list.clear();
+  for (size_t i = 0; i < last_mix_size_; ++i) {
+    AudioFrame* const frame = helper_containers_->audio_to_mix[i];
+    if (frame != &status->audio_frame) {
+      mix_minus_list.push_back(frame);
+    }
+  }
+  // The limiter has a state, so each participant needs its own combiner.
+  if (!status->mix_minus_combiner) {
+    status->mix_minus_combiner = std::make_unique<FrameCombiner>(use_limiter_);
+  }
+  status->mix_minus_combiner->Combine(
+      mix_minus_list, last_number_of_channels_, last_output_frequency_,
+      last_number_of_streams_ - 1, audio_frame_for_mixing);
+  return true;
+}
+
 bool AudioMixerImpl::AddSource(Source* audio_source) {
   RTC_DCHECK(audio_source);
   MutexLock lock(&mutex_);
@@ -193,18 +284,23 @@ void AudioMixerImpl::RemoveSource(Source* audio_source) {
   MutexLock lock(&mutex_);
   const auto iter = FindSourceInList(audio_source, &audio_source_list_);
   RTC_DCHECK(iter != audio_source_list_.end()) << "Source not present in mixer";
+  // The frame of the source must not be mixed by MixMinus() anymore.
+  std::vector<AudioFrame*>& audio_to_mix = helper_containers_->audio_to_mix;
+  const auto mixed_end =
+      std::remove(audio_to_mix.begin(), audio_to_mix.begin() + last_mix_size_,
+                  &(*iter)->audio_frame);
+  last_mix_size_ = std::distance(audio_to_mix.begin(), mixed_end);
   audio_source_list_.erase(iter);
 }
 
 rtc::ArrayView<AudioFrame* const> AudioMixerImpl::GetAudioFromSources(
     int output_frequency) {
-  // Get audio from the audio sources and put it in the SourceFrame vector.
+  FetchAudioFromSources(output_frequency);
+
+  // Put the audio of the sources in the SourceFrame vector.
   int audio_source_mixing_data_count = 0;
   for (auto& source_and_status : audio_source_list_) {
-    const auto audio_frame_info =
-        source_and_status->audio_source->GetAudioFrameWithInfo(
-            output_frequency, &source_and_status->audio_frame);
-
+    const auto audio_frame_info = source_and_status->audio_frame_info;
     if (audio_frame_info == Source::AudioFrameInfo::kError) {
       RTC_LOG_F(LS_WARNING) << "failed to GetAudioFrameWithInfo() from source";
       continue;
@@ -212,7 +308,8 @@ rtc::ArrayView<AudioFrame* const> AudioMixerImpl::GetAudioFromSources(
     helper_containers_
         ->audio_source_mixing_data_list[audio_source_mixing_data_count++] =
         SourceFrame(source_and_status.get(), &source_and_status->audio_frame,
-                    audio_frame_info == Source::AudioFrameInfo::kMuted);
+                    audio_frame_info == Source::AudioFrameInfo::kMuted,
+                    source_and_status->energy);
   }
   rtc::ArrayView<SourceFrame> audio_source_mixing_data_view(
       helper_containers_->audio_source_mixing_data_list.data(),
@@ -250,6 +347,99 @@ rtc::ArrayView<AudioFrame* const> AudioMixerImpl::GetAudioFromSources(
       helper_containers_->audio_to_mix.data(), audio_to_mix_count);
 }
 
+void AudioMixerImpl::FetchAudioFromSources(int output_frequency) {
+  SelectSourcesToFetch();
+  if (threads_.empty()) {
+    for (SourceStatus* status : sources_to_fetch_) {
+      FetchAudio(status, output_frequency);
+    }
+    return;
+  }
+
+  fetch_frequency_ = output_frequency;
+  next_source_.store(0);
+  // Only wake as many workers as there are sources for besides the one
+  // fetched by the calling thread.
+  const size_t num_workers =
+      std::min(threads_.size(),
+               sources_to_fetch_.empty() ? 0 : sources_to_fetch_.size() - 1);
+  running_workers_.store(static_cast<int>(num_workers));
+  for (size_t i = 0; i < num_workers; ++i) {
+    start_events_[i]->Set();
+  }
+  // The sources are ranked by their energy before mixing, so all of them are
+  // needed before mixing can start.
+  FetchPendingSources();
+  if (num_workers > 0) {
+    fetch_done_.Wait(rtc::Event::kForever);
+  }
+}
+
+void AudioMixerImpl::SelectSourcesToFetch() {
+  sources_to_fetch_.clear();
+  if (max_sources_to_fetch_ == 0 ||
+      audio_source_list_.size() <= static_cast<size_t>(max_sources_to_fetch_)) {
+    for (auto& source_and_status : audio_source_list_) {
+      sources_to_fetch_.push_back(source_and_status.get());
+    }
+    return;
+  }
+
+  std::vector<std::pair<int, SourceStatus*>>& leveled_sources =
+      helper_containers_->leveled_sources;
+  leveled_sources.clear();
+  for (auto& source_and_status : audio_source_list_) {
+    const absl::optional<int> level =
+        source_and_status->audio_source->AudioLevelDbov();
+    if (level) {
+      leveled_sources.emplace_back(*level, source_and_status.get());
+    } else {
+      sources_to_fetch_.push_back(source_and_status.get());
+    }
+  }
+  if (leveled_sources.size() > static_cast<size_t>(max_sources_to_fetch_)) {
+    // The loudest sources have the lowest level in -dBov. On ties, the sources
+    // already mixed are kept to not switch back and forth between them.
+    const auto fetched_end = leveled_sources.begin() + max_sources_to_fetch_;
+    std::nth_element(leveled_sources.begin(), fetched_end,
+                     leveled_sources.end(),
+                     [](const std::pair<int, SourceStatus*>& a,
+                        const std::pair<int, SourceStatus*>& b) {
+                       if (a.first != b.first) {
+                         return a.first < b.first;
+                       }
+                       return a.second->is_mixed && !b.second->is_mixed;
+                     });
+    for (auto it = fetched_end; it != leveled_sources.end(); ++it) {
+      SkipAudio(it->second);
+    }
+    leveled_sources.erase(fetched_end, leveled_sources.end());
+  }
+  for (const auto& level_and_source : leveled_sources) {
+    sources_to_fetch_.push_back(level_and_source.second);
+  }
+}
+
+void AudioMixerImpl::RunWorker(rtc::Event* start) {
+  while (true) {
+    start->Wait(rtc::Event::kForever);
+    if (quit_.load()) {
+      return;
+    }
+    FetchPendingSources();
+    if (running_workers_.fetch_sub(1) == 1) {
+      fetch_done_.Set();
+    }
+  }
+}
+
+void AudioMixerImpl::FetchPendingSources() {
+  for (size_t i = next_source_.fetch_add(1); i < sources_to_fetch_.size();
+       i = next_source_.fetch_add(1)) {
+    FetchAudio(sources_to_fetch_[i], fetch_frequency_);
+  }
+}
+
 bool AudioMixerImpl::GetAudioSourceMixabilityStatusForTest(
     AudioMixerImpl::Source* audio_source) const {
   MutexLock lock(&mutex_);
@@ -262,4 +452,16 @@ bool AudioMixerImpl::GetAudioSourceMixabilityStatusForTest(
   RTC_LOG(LS_ERROR) << "Audio source unknown";
   return false;
 }
+
+std::vector<AudioMixerImpl::SourceTiming> AudioMixerImpl::GetSourceTimings()
+    const {
+  MutexLock lock(&mutex_);
+  std::vector<SourceTiming> timings;
+  timings.reserve(audio_source_list_.size());
+  for (const auto& source_and_status : audio_source_list_) {
+    timings.push_back({source_and_status->audio_source,
+                       source_and_status->get_audio_duration});
+  }
+  return timings;
+}
 }  // namespace webrtc
@@ -13,6 +13,7 @@
 
 #include <stddef.h>
 
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -20,9 +21,12 @@
 #include "api/audio/audio_frame.h"
 #include "api/audio/audio_mixer.h"
 #include "api/scoped_refptr.h"
+#include "api/units/time_delta.h"
 #include "modules/audio_mixer/frame_combiner.h"
 #include "modules/audio_mixer/output_rate_calculator.h"
 #include "rtc_base/constructor_magic.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/race_checker.h"
 #include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/thread_annotations.h"
@@ -38,13 +42,31 @@ class AudioMixerImpl : public AudioMixer {
 
   static const int kDefaultNumberOfMixedAudioSources = 3;
 
+  // Time taken by a source to produce its audio frame in the last call to
+  // Mix(), e.g., to decode the audio of a received stream.
+  struct SourceTiming {
+    Source* source;
+    TimeDelta get_audio_duration;
+  };
+
   static rtc::scoped_refptr<AudioMixerImpl> Create(
       int max_sources_to_mix = kDefaultNumberOfMixedAudioSources);
 
+  // If `num_worker_threads` is positive, the audio of the sources is fetched
+  // in parallel on that many threads besides the one calling Mix(). This
+  // requires that the sources can be asked for audio on any thread, which is
+  // the case for received audio streams, since each has its own NetEq.
+  //
+  // If `max_sources_to_fetch` is positive, only that many of the sources that
+  // have a `Source::AudioLevelDbov()` estimate, the loudest ones, are asked
+  // for audio, e.g., to only decode a few streams of a large conference. The
+  // sources without an estimate are always asked for audio.
   static rtc::scoped_refptr<AudioMixerImpl> Create(
       std::unique_ptr<OutputRateCalculator> output_rate_calculator,
       bool use_limiter,
-      int max_sources_to_mix = kDefaultNumberOfMixedAudioSources);
+      int max_sources_to_mix = kDefaultNumberOfMixedAudioSources,
+      int num_worker_threads = 0,
+      int max_sources_to_fetch = 0);
 
   ~AudioMixerImpl() override;
 
@@ -56,19 +78,43 @@ class AudioMixerImpl : public AudioMixer {
            AudioFrame* audio_frame_for_mixing) override
       RTC_LOCKS_EXCLUDED(mutex_);
 
+  // Mixes the sources mixed by the last call to Mix() except `audio_source`,
+  // e.g., for the participant of `audio_source` in a conference not to hear
+  // itself. Returns false without touching `audio_frame_for_mixing` if
+  // `audio_source` was not mixed, since the output of Mix() then is the same
+  // and can be shared instead. Must be called on the thread calling Mix().
+  bool MixMinus(Source* audio_source, AudioFrame* audio_frame_for_mixing)
+      RTC_LOCKS_EXCLUDED(mutex_);
+
   // Returns true if the source was mixed last round. Returns
   // false and logs an error if the source was never added to the
   // mixer.
   bool GetAudioSourceMixabilityStatusForTest(Source* audio_source) const;
 
+  // Returns the time taken by each source in the last call to Mix().
+  std::vector<SourceTiming> GetSourceTimings() const;
+
  protected:
   AudioMixerImpl(std::unique_ptr<OutputRateCalculator> output_rate_calculator,
                  bool use_limiter,
-                 int max_sources_to_mix);
+                 int max_sources_to_mix,
+                 int num_worker_threads,
+                 int max_sources_to_fetch);
 
  private:
   struct HelperContainers;
 
+  // Asks the sources in `audio_source_list_` for a frame, on the worker
+  // threads if there are any.
+  void FetchAudioFromSources(int output_frequency)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  // Puts the sources to ask for audio in `sources_to_fetch_` and marks the
+  // other ones as muted.
+  void SelectSourcesToFetch() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void RunWorker(rtc::Event* start);
+  // Fetches the audio of sources in `sources_to_fetch_` until none are left.
+  void FetchPendingSources();
+
   // Compute what audio sources to mix from audio_source_list_. Ramp
   // in and out. Update mixed status. Mixes up to
   // kMaximumAmountOfMixedAudioSources audio sources.
@@ -81,6 +127,8 @@ class AudioMixerImpl : public AudioMixer {
   mutable Mutex mutex_;
 
   const int max_sources_to_mix_;
+  const int max_sources_to_fetch_;
+  const bool use_limiter_;
 
   std::unique_ptr<OutputRateCalculator> output_rate_calculator_;
 
@@ -93,6 +141,24 @@ class AudioMixerImpl : public AudioMixer {
   // Component that handles actual adding of audio frames.
   FrameCombiner frame_combiner_;
 
+  // Parameters of the last call to Mix(), for MixMinus(). The frames mixed are
+  // the first `last_mix_size_` ones of `helper_containers_->audio_to_mix`.
+  int last_output_frequency_ RTC_GUARDED_BY(mutex_) = 0;
+  size_t last_number_of_channels_ RTC_GUARDED_BY(mutex_) = 0;
+  size_t last_number_of_streams_ RTC_GUARDED_BY(mutex_) = 0;
+  size_t last_mix_size_ RTC_GUARDED_BY(mutex_) = 0;
+
+  // Worker threads and the state of the current call to Mix(), which is only
+  // written by Mix() while the workers are idle.
+  std::vector<std::unique_ptr<rtc::Event>> start_events_;
+  std::vector<rtc::PlatformThread> threads_;
+  rtc::Event fetch_done_;
+  std::atomic<bool> quit_{false};
+  std::vector<SourceStatus*> sources_to_fetch_;
+  int fetch_frequency_ = 0;
+  std::atomic<size_t> next_source_{0};
+  std::atomic<int> running_workers_{0};
+
   RTC_DISALLOW_COPY_AND_ASSIGN(AudioMixerImpl);
 };
 }  // namespace webrtc
@@ -87,6 +87,7 @@ class MockMixerAudioSource : public ::testing::NiceMock<AudioMixer::Source> {
 
   MOCK_METHOD(int, PreferredSampleRate, (), (const, override));
   MOCK_METHOD(int, Ssrc, (), (const, override));
+  MOCK_METHOD(absl::optional<int>, AudioLevelDbov, (), (const, override));
 
   AudioFrame* fake_frame() { return &fake_frame_; }
   AudioFrameInfo fake_info() { return fake_audio_frame_info_; }
@@ -510,6 +511,112 @@ TEST(AudioMixer, ShouldMixUpToSpecifiedNumberOfSourcesToMix) {
   }
 }
 
+TEST(AudioMixer, FetchingAudioOnWorkerThreadsGivesSameMix) {
+  constexpr int kAudioSources = 20;
+  std::vector<MockMixerAudioSource> participants(kAudioSources);
+  for (int i = 0; i < kAudioSources; ++i) {
+    ResetFrame(participants[i].fake_frame());
+    participants[i].fake_frame()->mutable_data()[0] = 100 * ((i * 7) % 20);
+  }
+  participants[3].set_fake_info(AudioMixer::Source::AudioFrameInfo::kMuted);
+
+  const auto mixer = AudioMixerImpl::Create();
+  const auto parallel_mixer = AudioMixerImpl::Create(
+      std::make_unique<DefaultOutputRateCalculator>(), /*use_limiter=*/true,
+      AudioMixerImpl::kDefaultNumberOfMixedAudioSources,
+      /*num_worker_threads=*/3);
+  for (auto& participant : participants) {
+    EXPECT_TRUE(mixer->AddSource(&participant));
+    EXPECT_TRUE(parallel_mixer->AddSource(&participant));
+    EXPECT_CALL(participant, GetAudioFrameWithInfo(kDefaultSampleRateHz, _))
+        .Times(Exactly(4));
+  }
+
+  AudioFrame parallel_frame_for_mixing;
+  for (int i = 0; i < 2; ++i) {
+    mixer->Mix(1, &frame_for_mixing);
+    parallel_mixer->Mix(1, &parallel_frame_for_mixing);
+    const size_t num_bytes =
+        sizeof(int16_t) * frame_for_mixing.samples_per_channel_;
+    EXPECT_EQ(0, memcmp(frame_for_mixing.data(),
+                        parallel_frame_for_mixing.data(), num_bytes));
+    for (auto& participant : participants) {
+      EXPECT_EQ(mixer->GetAudioSourceMixabilityStatusForTest(&participant),
+                parallel_mixer->GetAudioSourceMixabilityStatusForTest(
+                    &participant));
+    }
+  }
+
+  const std::vector<AudioMixerImpl::SourceTiming> timings =
+      parallel_mixer->GetSourceTimings();
+  ASSERT_EQ(timings.size(), participants.size());
+  for (int i = 0; i < kAudioSources; ++i) {
+    EXPECT_EQ(timings[i].source, &participants[i]);
+    EXPECT_GE(timings[i].get_audio_duration, TimeDelta::Zero());
+  }
+}
+
+TEST(AudioMixer, FetchesOnlyLoudestSourcesWithAudioLevel) {
+  const auto mixer = AudioMixerImpl::Create(
+      std::make_unique<DefaultOutputRateCalculator>(), /*use_limiter=*/true,
+      /*max_sources_to_mix=*/1, /*num_worker_threads=*/0,
+      /*max_sources_to_fetch=*/2);
+  const std::vector<absl::optional<int>> levels = {40, 10, 127, 20,
+                                                   absl::nullopt};
+  const std::vector<int> expected_calls = {0, 1, 0, 1, 1};
+  std::vector<MockMixerAudioSource> participants(levels.size());
+  for (size_t i = 0; i < levels.size(); ++i) {
+    ResetFrame(participants[i].fake_frame());
+    ON_CALL(participants[i], AudioLevelDbov()).WillByDefault(Return(levels[i]));
+    EXPECT_CALL(participants[i], GetAudioFrameWithInfo(_, _))
+        .Times(Exactly(expected_calls[i]));
+    mixer->AddSource(&participants[i]);
+  }
+  mixer->Mix(1, &frame_for_mixing);
+  for (size_t i = 0; i < levels.size(); ++i) {
+    if (expected_calls[i] == 0) {
+      EXPECT_FALSE(mixer->GetAudioSourceMixabilityStatusForTest(
+          &participants[i]));
+    }
+  }
+}
+
+TEST(AudioMixer, MixMinusExcludesOwnAudio) {
+  constexpr int kNumSources = 4;
+  const auto mixer = AudioMixerImpl::Create(
+      std::make_unique<DefaultOutputRateCalculator>(), /*use_limiter=*/false,
+      /*max_sources_to_mix=*/kNumSources - 1);
+  std::vector<MockMixerAudioSource> participants(kNumSources);
+  for (int i = 0; i < kNumSources; ++i) {
+    AudioFrame* frame = participants[i].fake_frame();
+    ResetFrame(frame);
+    // The last source is the quietest one and is not mixed.
+    std::fill(frame->mutable_data(),
+              frame->mutable_data() + frame->samples_per_channel_,
+              1000 << (kNumSources - 1 - i));
+    mixer->AddSource(&participants[i]);
+  }
+  // Sources ramp in when first mixed.
+  mixer->Mix(1, &frame_for_mixing);
+  mixer->Mix(1, &frame_for_mixing);
+  EXPECT_EQ(frame_for_mixing.data()[0], 8000 + 4000 + 2000);
+
+  AudioFrame mix_minus;
+  ASSERT_TRUE(mixer->MixMinus(&participants[0], &mix_minus));
+  EXPECT_EQ(mix_minus.samples_per_channel_,
+            frame_for_mixing.samples_per_channel_);
+  EXPECT_EQ(mix_minus.data()[0], 4000 + 2000);
+  ASSERT_TRUE(mixer->MixMinus(&participants[2], &mix_minus));
+  EXPECT_EQ(mix_minus.data()[0], 8000 + 4000);
+  // The unmixed source gets the output of Mix().
+  EXPECT_FALSE(mixer->MixMinus(&participants[3], &mix_minus));
+
+  // A removed source is not mixed anymore.
+  mixer->RemoveSource(&participants[1]);
+  ASSERT_TRUE(mixer->MixMinus(&participants[0], &mix_minus));
+  EXPECT_EQ(mix_minus.data()[0], 2000);
+}
+
 TEST(AudioMixer, UnmutedShouldMixBeforeLoud) {
   constexpr int kAudioSources =
       AudioMixerImpl::kDefaultNumberOfMixedAudioSources + 1;
@@ -97,27 +97,75 @@ void MixToFloatFrame(rtc::ArrayView<const AudioFrame* const> mix_list,
                      MixingBuffer* mixing_buffer) {
   RTC_DCHECK_LE(samples_per_channel, FrameCombiner::kMaximumChannelSize);
   RTC_DCHECK_LE(number_of_channels, FrameCombiner::kMaximumNumberOfChannels);
-  // Clear the mixing buffer.
-  for (auto& one_channel_buffer : *mixing_buffer) {
-    std::fill(one_channel_buffer.begin(), one_channel_buffer.end(), 0.f);
+  const size_t output_number_of_channels =
+      std::min(number_of_channels, FrameCombiner::kMaximumNumberOfChannels);
+  const size_t output_samples_per_channel =
+      std::min(samples_per_channel, FrameCombiner::kMaximumChannelSize);
+  // Clear the part of the mixing buffer that is used.
+  for (size_t j = 0; j < output_number_of_channels; ++j) {
+    std::fill((*mixing_buffer)[j].begin(),
+              (*mixing_buffer)[j].begin() + output_samples_per_channel, 0.f);
   }
 
-  // Convert to FloatS16 and mix.
+  // Convert to FloatS16 and mix. Muted frames do not contribute.
   for (size_t i = 0; i < mix_list.size(); ++i) {
     const AudioFrame* const frame = mix_list[i];
+    if (frame->muted()) {
+      continue;
+    }
     const int16_t* const frame_data = frame->data();
-    for (size_t j = 0; j < std::min(number_of_channels,
-                                    FrameCombiner::kMaximumNumberOfChannels);
-         ++j) {
-      for (size_t k = 0; k < std::min(samples_per_channel,
-                                      FrameCombiner::kMaximumChannelSize);
-           ++k) {
+    for (size_t j = 0; j < output_number_of_channels; ++j) {
+      for (size_t k = 0; k < output_samples_per_channel; ++k) {
         (*mixing_buffer)[j][k] += frame_data[number_of_channels * k + j];
       }
     }
   }
 }
 
+// Without a limiter, the float mix would only be rounded and saturated back to
+// 16 bits. Since the sum of 16 bit samples is exact in both domains, the frames
+// are directly summed as integers instead, which gives the same output without
+// converting every sample to float and back.
+void MixToInt16Frame(rtc::ArrayView<const AudioFrame* const> mix_list,
+                     size_t samples_per_channel,
+                     size_t number_of_channels,
+                     AudioFrame* audio_frame_for_mixing) {
+  RTC_DCHECK_LE(samples_per_channel, FrameCombiner::kMaximumChannelSize);
+  RTC_DCHECK_LE(number_of_channels, FrameCombiner::kMaximumNumberOfChannels);
+  const size_t output_number_of_channels =
+      std::min(number_of_channels, FrameCombiner::kMaximumNumberOfChannels);
+  const size_t output_samples_per_channel =
+      std::min(samples_per_channel, FrameCombiner::kMaximumChannelSize);
+  std::array<int32_t, FrameCombiner::kMaximumNumberOfChannels *
+                          FrameCombiner::kMaximumChannelSize>
+      sum;
+  const size_t num_samples =
+      output_number_of_channels * output_samples_per_channel;
+  std::fill(sum.begin(), sum.begin() + num_samples, 0);
+  for (const AudioFrame* frame : mix_list) {
+    if (frame->muted()) {
+      continue;
+    }
+    const int16_t* const frame_data = frame->data();
+    if (output_number_of_channels == number_of_channels) {
+      for (size_t i = 0; i < num_samples; ++i) {
+        sum[i] += frame_data[i];
+      }
+      continue;
+    }
+    for (size_t k = 0; k < output_samples_per_channel; ++k) {
+      for (size_t j = 0; j < output_number_of_channels; ++j) {
+        sum[output_number_of_channels * k + j] +=
+            frame_data[number_of_channels * k + j];
+      }
+    }
+  }
+  int16_t* const mixing_data = audio_frame_for_mixing->mutable_data();
+  for (size_t i = 0; i < num_samples; ++i) {
+    mixing_data[i] = rtc::saturated_cast<int16_t>(sum[i]);
+  }
+}
+
 void RunLimiter(AudioFrameView<float> mixing_buffer_view, Limiter* limiter) {
   const size_t sample_rate = mixing_buffer_view.samples_per_channel() * 1000 /
                              AudioMixerImpl::kFrameDurationInMs;
@@ -190,6 +238,12 @@ void FrameCombiner::Combine(rtc::ArrayView<AudioFrame* const> mix_list,
     return;
   }
 
+  if (!use_limiter_) {
+    MixToInt16Frame(mix_list, samples_per_channel, number_of_channels,
+                    audio_frame_for_mixing);
+    return;
+  }
+
   MixToFloatFrame(mix_list, samples_per_channel, number_of_channels,
                   mixing_buffer_.get());
 
@@ -207,9 +261,7 @@ void FrameCombiner::Combine(rtc::ArrayView<AudioFrame* const> mix_list,
                                            output_number_of_channels,
                                            output_samples_per_channel);
 
-  if (use_limiter_) {
-    RunLimiter(mixing_buffer_view, &limiter_);
-  }
+  RunLimiter(mixing_buffer_view, &limiter_);
 
   InterleaveToAudioFrame(mixing_buffer_view, audio_frame_for_mixing);
 }
@@ -25,6 +25,7 @@
 #include "modules/audio_mixer/gain_change_calculator.h"
 #include "modules/audio_mixer/sine_wave_generator.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/strings/string_builder.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
@@ -280,6 +281,41 @@ TEST(FrameCombiner, CombiningOneFrameShouldNotChangeFrame) {
   }
 }
 
+TEST(FrameCombiner, CombiningWithoutLimiterGivesSaturatedSum) {
+  FrameCombiner combiner(false);
+  for (const int rate : {8000, 32000, 48000}) {
+    for (const int number_of_channels : {1, 2, 8}) {
+      SCOPED_TRACE(ProduceDebugText(rate, number_of_channels, 2));
+      const size_t num_samples = number_of_channels * rate / 100;
+      SetUpFrames(rate, number_of_channels);
+      int16_t* frame1_data = frame1.mutable_data();
+      int16_t* frame2_data = frame2.mutable_data();
+      std::vector<int16_t> expected(num_samples);
+      for (size_t i = 0; i < num_samples; ++i) {
+        frame1_data[i] = static_cast<int16_t>(i * 97);
+        frame2_data[i] = static_cast<int16_t>(i * 211);
+        expected[i] =
+            rtc::saturated_cast<int16_t>(frame1_data[i] + frame2_data[i]);
+      }
+      const std::vector<AudioFrame*> frames_to_combine = {&frame1, &frame2};
+      AudioFrame audio_frame_for_mixing;
+      combiner.Combine(frames_to_combine, number_of_channels, rate,
+                       frames_to_combine.size(), &audio_frame_for_mixing);
+      EXPECT_THAT(rtc::ArrayView<const int16_t>(audio_frame_for_mixing.data(),
+                                                num_samples),
+                  ElementsAreArray(expected));
+
+      // A muted frame does not contribute to the mix.
+      AudioFrameOperations::Mute(&frame2);
+      combiner.Combine(frames_to_combine, number_of_channels, rate,
+                       frames_to_combine.size(), &audio_frame_for_mixing);
+      EXPECT_THAT(rtc::ArrayView<const int16_t>(audio_frame_for_mixing.data(),
+                                                num_samples),
+                  ElementsAreArray(frame1_data, num_samples));
+    }
+  }
+}
+
 // Send a sine wave through the FrameCombiner, and check that the
 // difference between input and output varies smoothly. Also check
 // that it is inside reasonable bounds. This is to catch issues like
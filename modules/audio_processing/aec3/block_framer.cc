@@ -17,13 +17,28 @@
 
 namespace webrtc {
 
+namespace {
+
+// Output delay in low latency mode, for which the buffer is empty after three
+// calls to InsertBlockAndExtractSubFrame.
+constexpr size_t kLowLatencyDelay = 3 * (kSubFrameLength - kBlockSize);
+
+}  // namespace
+
 BlockFramer::BlockFramer(size_t num_bands, size_t num_channels)
+    : BlockFramer(num_bands, num_channels, /*low_latency=*/false) {}
+
+BlockFramer::BlockFramer(size_t num_bands,
+                         size_t num_channels,
+                         bool low_latency)
     : num_bands_(num_bands),
       num_channels_(num_channels),
       buffer_(num_bands_,
               std::vector<std::vector<float>>(
                   num_channels,
-                  std::vector<float>(kBlockSize, 0.f))) {
+                  std::vector<float>(
+                      low_latency ? kLowLatencyDelay : kBlockSize,
+                      0.f))) {
   RTC_DCHECK_LT(0, num_bands);
   RTC_DCHECK_LT(0, num_channels);
 }
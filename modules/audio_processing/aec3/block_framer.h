@@ -24,9 +24,16 @@ namespace webrtc {
 // that, this class produces output frames are the same rate as frames are
 // received by the FrameBlocker class. Note that the internal buffers will
 // overrun if any other rate of packets insertion is used.
+//
+// The output is delayed by `kBlockSize` samples. In low latency mode, the
+// delay is instead 48 samples, which is the lowest delay for which 80 sample
+// subframes can be produced. The buffer then runs empty before every fourth
+// subframe, and the caller must use InsertBlock to add the block that precedes
+// the one passed to InsertBlockAndExtractSubFrame.
 class BlockFramer {
  public:
   BlockFramer(size_t num_bands, size_t num_channels);
+  BlockFramer(size_t num_bands, size_t num_channels, bool low_latency);
   ~BlockFramer();
   BlockFramer(const BlockFramer&) = delete;
   BlockFramer& operator=(const BlockFramer&) = delete;
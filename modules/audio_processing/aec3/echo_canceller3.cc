@@ -116,6 +116,7 @@ void ProcessCaptureFrameContent(
     AudioBuffer* capture,
     bool level_change,
     bool saturated_microphone_signal,
+    bool low_latency_framing,
     size_t sub_frame_index,
     FrameBlocker* capture_blocker,
     BlockFramer* linear_output_framer,
@@ -140,6 +141,20 @@ void ProcessCaptureFrameContent(
                                                  capture_block);
   block_processor->ProcessCapture(level_change, saturated_microphone_signal,
                                   linear_output_block, capture_block);
+
+  // With low latency framing, the output framer runs empty once every two
+  // frames. The following block is then already available and is processed
+  // ahead of time to complete the subframe.
+  if (low_latency_framing && capture_blocker->IsBlockAvailable()) {
+    output_framer->InsertBlock(*capture_block);
+    if (linear_output) {
+      linear_output_framer->InsertBlock(*linear_output_block);
+    }
+    capture_blocker->ExtractBlock(capture_block);
+    block_processor->ProcessCapture(level_change, saturated_microphone_signal,
+                                    linear_output_block, capture_block);
+  }
+
   output_framer->InsertBlockAndExtractSubFrame(*capture_block,
                                                capture_sub_frame_view);
 
@@ -688,7 +703,9 @@ EchoCanceller3::EchoCanceller3(const EchoCanceller3Config& config,
       num_bands_(NumBandsForRate(sample_rate_hz_)),
       num_render_channels_(num_render_channels),
       num_capture_channels_(num_capture_channels),
-      output_framer_(num_bands_, num_capture_channels_),
+      output_framer_(num_bands_,
+                     num_capture_channels_,
+                     config_.buffering.low_latency_framing),
       capture_blocker_(num_bands_, num_capture_channels_),
       render_blocker_(num_bands_, num_render_channels_),
       render_transfer_queue_(
@@ -737,7 +754,9 @@ EchoCanceller3::EchoCanceller3(const EchoCanceller3Config& config,
   RTC_DCHECK_GE(kMaxNumBands, num_bands_);
 
   if (config_.filter.export_linear_aec_output) {
-    linear_output_framer_.reset(new BlockFramer(1, num_capture_channels_));
+    linear_output_framer_.reset(
+        new BlockFramer(1, num_capture_channels_,
+                        config_.buffering.low_latency_framing));
     linear_output_block_ =
         std::make_unique<std::vector<std::vector<std::vector<float>>>>(
             1, std::vector<std::vector<float>>(
@@ -818,14 +837,18 @@ void EchoCanceller3::ProcessCapture(AudioBuffer* capture,
   EmptyRenderQueue();
 
   ProcessCaptureFrameContent(linear_output, capture, level_change,
-                             saturated_microphone_signal_, 0, &capture_blocker_,
+                             saturated_microphone_signal_,
+                             config_.buffering.low_latency_framing, 0,
+                             &capture_blocker_,
                              linear_output_framer_.get(), &output_framer_,
                              block_processor_.get(), linear_output_block_.get(),
                              &linear_output_sub_frame_view_, &capture_block_,
                              &capture_sub_frame_view_);
 
   ProcessCaptureFrameContent(linear_output, capture, level_change,
-                             saturated_microphone_signal_, 1, &capture_blocker_,
+                             saturated_microphone_signal_,
+                             config_.buffering.low_latency_framing, 1,
+                             &capture_blocker_,
                              linear_output_framer_.get(), &output_framer_,
                              block_processor_.get(), linear_output_block_.get(),
                              &linear_output_sub_frame_view_, &capture_block_,
@@ -880,6 +903,18 @@ EchoCanceller3Config EchoCanceller3::CreateDefaultConfig(
   return cfg;
 }
 
+EchoCanceller3Config EchoCanceller3::CreateLowLatencyConfig(
+    size_t num_render_channels,
+    size_t num_capture_channels) {
+  EchoCanceller3Config cfg =
+      CreateDefaultConfig(num_render_channels, num_capture_channels);
+  cfg.buffering.low_latency_framing = true;
+  cfg.buffering.excess_render_detection_interval_blocks = 125;
+  cfg.buffering.max_allowed_excess_render_blocks = 4;
+  cfg.delay.delay_selection_thresholds = {3, 10};
+  return cfg;
+}
+
 void EchoCanceller3::EmptyRenderQueue() {
   RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
   bool frame_to_buffer =
@@ -140,6 +140,15 @@ class EchoCanceller3 : public EchoControl {
   static EchoCanceller3Config CreateDefaultConfig(size_t num_render_channels,
                                                   size_t num_capture_channels);
 
+  // Produces a configuration that trades robustness for latency. The delay
+  // added to the capture signal is reduced from 4 to 3 ms, the render delay is
+  // estimated with less evidence and excess render buffering is corrected
+  // sooner. Note that the render buffering does not add to the capture delay;
+  // it only determines how fast the echo canceller adapts to delay changes.
+  static EchoCanceller3Config CreateLowLatencyConfig(
+      size_t num_render_channels,
+      size_t num_capture_channels);
+
  private:
   class RenderWriter;
 
@@ -205,9 +205,12 @@ class EchoCanceller3Tester {
   // Verifies that the capture data is properly received by the block processor
   // and that the processor data is properly passed to the EchoCanceller3
   // output.
-  void RunCaptureTransportVerificationTest() {
+  void RunCaptureTransportVerificationTest(bool low_latency_framing) {
+    EchoCanceller3Config config;
+    config.buffering.low_latency_framing = low_latency_framing;
+    const int expected_delay = low_latency_framing ? -48 : -64;
     EchoCanceller3 aec3(
-        EchoCanceller3Config(), sample_rate_hz_, 1, 1,
+        config, sample_rate_hz_, 1, 1,
         std::unique_ptr<BlockProcessor>(
             new CaptureTransportVerificationProcessor(num_bands_)));
 
@@ -224,7 +227,7 @@ class EchoCanceller3Tester {
       aec3.ProcessCapture(&capture_buffer_, false);
       EXPECT_TRUE(VerifyOutputFrameBitexactness(
           frame_length_, num_bands_, frame_index,
-          &capture_buffer_.split_bands(0)[0], -64));
+          &capture_buffer_.split_bands(0)[0], expected_delay));
     }
   }
 
@@ -635,7 +638,16 @@ std::string ProduceDebugText(int sample_rate_hz, int variant) {
 TEST(EchoCanceller3Buffering, CaptureBitexactness) {
   for (auto rate : {16000, 32000, 48000}) {
     SCOPED_TRACE(ProduceDebugText(rate));
-    EchoCanceller3Tester(rate).RunCaptureTransportVerificationTest();
+    EchoCanceller3Tester(rate).RunCaptureTransportVerificationTest(
+        /*low_latency_framing=*/false);
+  }
+}
+
+TEST(EchoCanceller3Buffering, LowLatencyCaptureBitexactness) {
+  for (auto rate : {16000, 32000, 48000}) {
+    SCOPED_TRACE(ProduceDebugText(rate));
+    EchoCanceller3Tester(rate).RunCaptureTransportVerificationTest(
+        /*low_latency_framing=*/true);
   }
 }
 
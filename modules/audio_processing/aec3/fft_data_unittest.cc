@@ -64,6 +64,29 @@ TEST(FftData, TestAvx2Optimizations) {
 }
 #endif
 
+#if defined(WEBRTC_HAS_NEON)
+// Verifies that the optimized methods are bitexact to their reference
+// counterparts.
+TEST(FftData, TestNeonOptimizations) {
+  FftData x;
+
+  for (size_t k = 0; k < x.re.size(); ++k) {
+    x.re[k] = k + 1;
+  }
+
+  x.im[0] = x.im[x.im.size() - 1] = 0.f;
+  for (size_t k = 1; k < x.im.size() - 1; ++k) {
+    x.im[k] = 2.f * (k + 1);
+  }
+
+  std::array<float, kFftLengthBy2Plus1> spectrum;
+  std::array<float, kFftLengthBy2Plus1> spectrum_neon;
+  x.Spectrum(Aec3Optimization::kNone, spectrum);
+  x.Spectrum(Aec3Optimization::kNeon, spectrum_neon);
+  EXPECT_EQ(spectrum, spectrum_neon);
+}
+#endif
+
 #if RTC_DCHECK_IS_ON && GTEST_HAS_DEATH_TEST && !defined(WEBRTC_ANDROID)
 
 // Verifies the check for null output in CopyToPackedArray.
@@ -60,6 +60,7 @@ class VectorMath {
         }
       } break;
       case Aec3Optimization::kAvx2:
+      case Aec3Optimization::kAvx512:
         SqrtAVX2(x);
         break;
 #endif
@@ -141,6 +142,7 @@ class VectorMath {
         }
       } break;
       case Aec3Optimization::kAvx2:
+      case Aec3Optimization::kAvx512:
         MultiplyAVX2(x, y, z);
         break;
 #endif
@@ -191,6 +193,7 @@ class VectorMath {
         }
       } break;
       case Aec3Optimization::kAvx2:
+      case Aec3Optimization::kAvx512:
         AccumulateAVX2(x, z);
         break;
 #endif
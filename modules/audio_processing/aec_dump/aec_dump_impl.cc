@@ -13,13 +13,20 @@
 #include <memory>
 #include <utility>
 
+#include "api/units/time_delta.h"
 #include "modules/audio_processing/aec_dump/aec_dump_factory.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/event.h"
+#include "rtc_base/logging.h"
 
 namespace webrtc {
 
 namespace {
+
+// About a second of 10 ms render and capture events.
+constexpr size_t kEventQueueSize = 200;
+constexpr TimeDelta kWriteInterval = TimeDelta::Millis(50);
+
 void CopyFromConfigToEvent(const webrtc::InternalAPMConfig& config,
                            webrtc::audioproc::Config* pb_cfg) {
   pb_cfg->set_aec_enabled(config.aec_enabled);
@@ -61,23 +68,29 @@ AecDumpImpl::AecDumpImpl(FileWrapper debug_file,
     : debug_file_(std::move(debug_file)),
       num_bytes_left_for_log_(max_log_size_bytes),
       worker_queue_(worker_queue),
-      capture_stream_info_(CreateWriteToFileTask()) {}
+      event_queue_(kEventQueueSize) {
+  write_task_ = RepeatingTaskHandle::Start(worker_queue_->Get(), [this] {
+    WriteQueuedEvents();
+    return kWriteInterval;
+  });
+}
 
 AecDumpImpl::~AecDumpImpl() {
-  // Block until all tasks have finished running.
+  // Stop the writer and write the remaining events, blocking until done.
   rtc::Event thread_sync_event;
-  worker_queue_->PostTask([&thread_sync_event] { thread_sync_event.Set(); });
-  // Wait until the event has been signaled with .Set(). By then all
-  // pending tasks will have finished.
+  worker_queue_->PostTask([this, &thread_sync_event] {
+    write_task_.Stop();
+    WriteQueuedEvents();
+    thread_sync_event.Set();
+  });
   thread_sync_event.Wait(rtc::Event::kForever);
 }
 
 void AecDumpImpl::WriteInitMessage(const ProcessingConfig& api_format,
                                    int64_t time_now_ms) {
-  auto task = CreateWriteToFileTask();
-  auto* event = task->GetEvent();
-  event->set_type(audioproc::Event::INIT);
-  audioproc::Init* msg = event->mutable_init();
+  MutexLock lock(&push_mutex_);
+  event_.set_type(audioproc::Event::INIT);
+  audioproc::Init* msg = event_.mutable_init();
 
   msg->set_sample_rate(api_format.input_stream().sample_rate_hz());
   msg->set_output_sample_rate(api_format.output_stream().sample_rate_hz());
@@ -96,7 +109,7 @@ void AecDumpImpl::WriteInitMessage(const ProcessingConfig& api_format,
       api_format.reverse_output_stream().num_channels());
   msg->set_timestamp_ms(time_now_ms);
 
-  worker_queue_->PostTask(std::move(task));
+  PushEvent(&event_);
 }
 
 void AecDumpImpl::AddCaptureStreamInput(
@@ -126,59 +139,53 @@ void AecDumpImpl::AddAudioProcessingState(const AudioProcessingState& state) {
 }
 
 void AecDumpImpl::WriteCaptureStreamMessage() {
-  auto task = capture_stream_info_.GetTask();
-  RTC_DCHECK(task);
-  worker_queue_->PostTask(std::move(task));
-  capture_stream_info_.SetTask(CreateWriteToFileTask());
+  audioproc::Event* event = capture_stream_info_.event();
+  event->set_type(audioproc::Event::STREAM);
+  MutexLock lock(&push_mutex_);
+  PushEvent(event);
 }
 
 void AecDumpImpl::WriteRenderStreamMessage(const int16_t* const data,
                                            int num_channels,
                                            int samples_per_channel) {
-  auto task = CreateWriteToFileTask();
-  auto* event = task->GetEvent();
-
-  event->set_type(audioproc::Event::REVERSE_STREAM);
-  audioproc::ReverseStream* msg = event->mutable_reverse_stream();
+  MutexLock lock(&push_mutex_);
+  event_.set_type(audioproc::Event::REVERSE_STREAM);
+  audioproc::ReverseStream* msg = event_.mutable_reverse_stream();
   const size_t data_size = sizeof(int16_t) * samples_per_channel * num_channels;
   msg->set_data(data, data_size);
 
-  worker_queue_->PostTask(std::move(task));
+  PushEvent(&event_);
 }
 
 void AecDumpImpl::WriteRenderStreamMessage(
     const AudioFrameView<const float>& src) {
-  auto task = CreateWriteToFileTask();
-  auto* event = task->GetEvent();
-
-  event->set_type(audioproc::Event::REVERSE_STREAM);
+  MutexLock lock(&push_mutex_);
+  event_.set_type(audioproc::Event::REVERSE_STREAM);
 
-  audioproc::ReverseStream* msg = event->mutable_reverse_stream();
+  audioproc::ReverseStream* msg = event_.mutable_reverse_stream();
 
   for (int i = 0; i < src.num_channels(); ++i) {
     const auto& channel_view = src.channel(i);
     msg->add_channel(channel_view.begin(), sizeof(float) * channel_view.size());
   }
 
-  worker_queue_->PostTask(std::move(task));
+  PushEvent(&event_);
 }
 
 void AecDumpImpl::WriteConfig(const InternalAPMConfig& config) {
   RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
-  auto task = CreateWriteToFileTask();
-  auto* event = task->GetEvent();
-  event->set_type(audioproc::Event::CONFIG);
-  CopyFromConfigToEvent(config, event->mutable_config());
-  worker_queue_->PostTask(std::move(task));
+  MutexLock lock(&push_mutex_);
+  event_.set_type(audioproc::Event::CONFIG);
+  CopyFromConfigToEvent(config, event_.mutable_config());
+  PushEvent(&event_);
 }
 
 void AecDumpImpl::WriteRuntimeSetting(
     const AudioProcessing::RuntimeSetting& runtime_setting) {
   RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
-  auto task = CreateWriteToFileTask();
-  auto* event = task->GetEvent();
-  event->set_type(audioproc::Event::RUNTIME_SETTING);
-  audioproc::RuntimeSetting* setting = event->mutable_runtime_setting();
+  MutexLock lock(&push_mutex_);
+  event_.set_type(audioproc::Event::RUNTIME_SETTING);
+  audioproc::RuntimeSetting* setting = event_.mutable_runtime_setting();
   switch (runtime_setting.type()) {
     case AudioProcessing::RuntimeSetting::Type::kCapturePreGain: {
       float x;
@@ -233,12 +240,59 @@ void AecDumpImpl::WriteRuntimeSetting(
       RTC_DCHECK_NOTREACHED();
       break;
   }
-  worker_queue_->PostTask(std::move(task));
+  PushEvent(&event_);
+}
+
+int AecDumpImpl::num_dropped_events() const {
+  MutexLock lock(&push_mutex_);
+  return num_dropped_events_;
+}
+
+void AecDumpImpl::PushEvent(audioproc::Event* event) {
+  if (!event_queue_.Insert(event)) {
+    ++num_dropped_events_;
+  }
+  // Keeps the allocated fields for the next event.
+  event->Clear();
 }
 
-std::unique_ptr<WriteToFileTask> AecDumpImpl::CreateWriteToFileTask() {
-  return std::make_unique<WriteToFileTask>(&debug_file_,
-                                           &num_bytes_left_for_log_);
+void AecDumpImpl::WriteQueuedEvents() {
+  RTC_DCHECK(worker_queue_->IsCurrent());
+  while (event_queue_.Remove(&event_to_write_)) {
+    WriteEvent(event_to_write_);
+    event_to_write_.Clear();
+  }
+  const int num_dropped_events = this->num_dropped_events();
+  if (num_dropped_events != num_reported_dropped_events_) {
+    RTC_LOG(LS_WARNING) << "AEC dump writer fell behind, "
+                        << num_dropped_events - num_reported_dropped_events_
+                        << " events dropped.";
+    num_reported_dropped_events_ = num_dropped_events;
+  }
+}
+
+void AecDumpImpl::WriteEvent(const audioproc::Event& event) {
+  const size_t event_byte_size = event.ByteSizeLong();
+  const int64_t next_message_size = event_byte_size + sizeof(int32_t);
+  if (num_bytes_left_for_log_ >= 0) {
+    if (num_bytes_left_for_log_ < next_message_size) {
+      // Ensure that no further events are written, even if they're smaller
+      // than the current event.
+      num_bytes_left_for_log_ = 0;
+      return;
+    }
+    num_bytes_left_for_log_ -= next_message_size;
+  }
+
+  event.SerializeToString(&serialized_event_);
+  // Write message preceded by its size.
+  if (!debug_file_.Write(&event_byte_size, sizeof(int32_t))) {
+    RTC_DCHECK_NOTREACHED();
+  }
+  if (!debug_file_.Write(serialized_event_.data(),
+                         serialized_event_.length())) {
+    RTC_DCHECK_NOTREACHED();
+  }
 }
 
 std::unique_ptr<AecDump> AecDumpFactory::Create(webrtc::FileWrapper file,
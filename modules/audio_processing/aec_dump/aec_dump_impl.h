@@ -16,12 +16,14 @@
 #include <vector>
 
 #include "modules/audio_processing/aec_dump/capture_stream_info.h"
-#include "modules/audio_processing/aec_dump/write_to_file_task.h"
 #include "modules/audio_processing/include/aec_dump.h"
 #include "rtc_base/ignore_wundef.h"
 #include "rtc_base/race_checker.h"
+#include "rtc_base/swap_queue.h"
+#include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/system/file_wrapper.h"
 #include "rtc_base/task_queue.h"
+#include "rtc_base/task_utils/repeating_task.h"
 #include "rtc_base/thread_annotations.h"
 
 // Files generated at build-time by the protobuf compiler.
@@ -39,8 +41,12 @@ class TaskQueue;
 
 namespace webrtc {
 
-// Task-queue based implementation of AecDump. It is thread safe by
-// relying on locks in TaskQueue.
+// Task-queue based implementation of AecDump. Events are filled in on the
+// calling thread and handed over through a fixed-size SwapQueue, whose
+// protobuf messages are reused so that steady state dumping doesn't allocate.
+// A repeating task on `worker_queue` serializes the events and writes them to
+// the file. If the writer falls behind, for instance on slow storage, events
+// are dropped rather than queued without bound.
 class AecDumpImpl : public AecDump {
  public:
   // Does member variables initialization shared across all c-tors.
@@ -74,14 +80,35 @@ class AecDumpImpl : public AecDump {
   void WriteRuntimeSetting(
       const AudioProcessing::RuntimeSetting& runtime_setting) override;
 
+  // Number of events dropped so far because the queue was full.
+  int num_dropped_events() const;
+
  private:
-  std::unique_ptr<WriteToFileTask> CreateWriteToFileTask();
+  // Hands `event` over to the writer, leaving an empty event in its place.
+  void PushEvent(audioproc::Event* event)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(push_mutex_);
+  // Writes all queued events to the file. Runs on `worker_queue_`.
+  void WriteQueuedEvents();
+  void WriteEvent(const audioproc::Event& event);
 
   FileWrapper debug_file_;
   int64_t num_bytes_left_for_log_ = 0;
   rtc::RaceChecker race_checker_;
   rtc::TaskQueue* worker_queue_;
   CaptureStreamInfo capture_stream_info_;
+
+  // Render and capture events are pushed from different threads, but must
+  // reach the file in the order they were produced.
+  mutable Mutex push_mutex_;
+  audioproc::Event event_ RTC_GUARDED_BY(push_mutex_);
+  int num_dropped_events_ RTC_GUARDED_BY(push_mutex_) = 0;
+  SwapQueue<audioproc::Event> event_queue_;
+
+  // Only accessed on `worker_queue_`.
+  audioproc::Event event_to_write_;
+  std::string serialized_event_;
+  int num_reported_dropped_events_ = 0;
+  RepeatingTaskHandle write_task_;
 };
 }  // namespace webrtc
 
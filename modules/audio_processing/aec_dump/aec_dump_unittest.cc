@@ -12,6 +12,8 @@
 #include <utility>
 
 #include "modules/audio_processing/aec_dump/aec_dump_factory.h"
+#include "modules/audio_processing/aec_dump/aec_dump_impl.h"
+#include "rtc_base/event.h"
 #include "rtc_base/task_queue_for_test.h"
 #include "test/gtest.h"
 #include "test/testsupport/file_utils.h"
@@ -84,4 +86,38 @@ TEST(AecDumper, WriteToFile) {
   ASSERT_EQ(0, remove(filename.c_str()));
 }
 
+TEST(AecDumper, DropsEventsWhenWriterFallsBehind) {
+  webrtc::TaskQueueForTest file_writer_queue("file_writer_queue");
+
+  const std::string filename =
+      webrtc::test::TempFilename(webrtc::test::OutputPath(), "aec_dump");
+
+  {
+    webrtc::AecDumpImpl aec_dump(webrtc::FileWrapper::OpenWriteOnly(filename),
+                                 -1, &file_writer_queue);
+
+    // Stall the writer, as slow storage would.
+    rtc::Event writer_stalled;
+    rtc::Event resume_writer;
+    file_writer_queue.PostTask([&] {
+      writer_stalled.Set();
+      resume_writer.Wait(rtc::Event::kForever);
+    });
+    ASSERT_TRUE(writer_stalled.Wait(rtc::Event::kForever));
+
+    constexpr int kNumChannels = 1;
+    constexpr int kNumSamplesPerChannel = 160;
+    std::array<int16_t, kNumSamplesPerChannel * kNumChannels> frame;
+    frame.fill(0.f);
+    for (int i = 0; i < 1000; ++i) {
+      aec_dump.WriteRenderStreamMessage(frame.data(), kNumChannels,
+                                        kNumSamplesPerChannel);
+    }
+    EXPECT_GT(aec_dump.num_dropped_events(), 0);
+    EXPECT_LT(aec_dump.num_dropped_events(), 1000);
+    resume_writer.Set();
+  }
+  ASSERT_EQ(0, remove(filename.c_str()));
+}
+
 }  // namespace webrtc
@@ -11,17 +11,12 @@
 #include "modules/audio_processing/aec_dump/capture_stream_info.h"
 
 namespace webrtc {
-CaptureStreamInfo::CaptureStreamInfo(std::unique_ptr<WriteToFileTask> task)
-    : task_(std::move(task)) {
-  RTC_DCHECK(task_);
-  task_->GetEvent()->set_type(audioproc::Event::STREAM);
-}
+CaptureStreamInfo::CaptureStreamInfo() = default;
 
 CaptureStreamInfo::~CaptureStreamInfo() = default;
 
 void CaptureStreamInfo::AddInput(const AudioFrameView<const float>& src) {
-  RTC_DCHECK(task_);
-  auto* stream = task_->GetEvent()->mutable_stream();
+  auto* stream = event_.mutable_stream();
 
   for (int i = 0; i < src.num_channels(); ++i) {
     const auto& channel_view = src.channel(i);
@@ -31,8 +26,7 @@ void CaptureStreamInfo::AddInput(const AudioFrameView<const float>& src) {
 }
 
 void CaptureStreamInfo::AddOutput(const AudioFrameView<const float>& src) {
-  RTC_DCHECK(task_);
-  auto* stream = task_->GetEvent()->mutable_stream();
+  auto* stream = event_.mutable_stream();
 
   for (int i = 0; i < src.num_channels(); ++i) {
     const auto& channel_view = src.channel(i);
@@ -44,8 +38,7 @@ void CaptureStreamInfo::AddOutput(const AudioFrameView<const float>& src) {
 void CaptureStreamInfo::AddInput(const int16_t* const data,
                                  int num_channels,
                                  int samples_per_channel) {
-  RTC_DCHECK(task_);
-  auto* stream = task_->GetEvent()->mutable_stream();
+  auto* stream = event_.mutable_stream();
   const size_t data_size = sizeof(int16_t) * samples_per_channel * num_channels;
   stream->set_input_data(data, data_size);
 }
@@ -53,16 +46,14 @@ void CaptureStreamInfo::AddInput(const int16_t* const data,
 void CaptureStreamInfo::AddOutput(const int16_t* const data,
                                   int num_channels,
                                   int samples_per_channel) {
-  RTC_DCHECK(task_);
-  auto* stream = task_->GetEvent()->mutable_stream();
+  auto* stream = event_.mutable_stream();
   const size_t data_size = sizeof(int16_t) * samples_per_channel * num_channels;
   stream->set_output_data(data, data_size);
 }
 
 void CaptureStreamInfo::AddAudioProcessingState(
     const AecDump::AudioProcessingState& state) {
-  RTC_DCHECK(task_);
-  auto* stream = task_->GetEvent()->mutable_stream();
+  auto* stream = event_.mutable_stream();
   stream->set_delay(state.delay);
   stream->set_drift(state.drift);
   stream->set_level(state.level);
@@ -11,11 +11,8 @@
 #ifndef MODULES_AUDIO_PROCESSING_AEC_DUMP_CAPTURE_STREAM_INFO_H_
 #define MODULES_AUDIO_PROCESSING_AEC_DUMP_CAPTURE_STREAM_INFO_H_
 
-#include <memory>
-#include <utility>
 #include <vector>
 
-#include "modules/audio_processing/aec_dump/write_to_file_task.h"
 #include "modules/audio_processing/include/aec_dump.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/ignore_wundef.h"
@@ -32,9 +29,10 @@ RTC_POP_IGNORING_WUNDEF()
 
 namespace webrtc {
 
+// Collects the parts of a capture stream event.
 class CaptureStreamInfo {
  public:
-  explicit CaptureStreamInfo(std::unique_ptr<WriteToFileTask> task);
+  CaptureStreamInfo();
   ~CaptureStreamInfo();
   void AddInput(const AudioFrameView<const float>& src);
   void AddOutput(const AudioFrameView<const float>& src);
@@ -48,20 +46,11 @@ class CaptureStreamInfo {
 
   void AddAudioProcessingState(const AecDump::AudioProcessingState& state);
 
-  std::unique_ptr<WriteToFileTask> GetTask() {
-    RTC_DCHECK(task_);
-    return std::move(task_);
-  }
-
-  void SetTask(std::unique_ptr<WriteToFileTask> task) {
-    RTC_DCHECK(!task_);
-    RTC_DCHECK(task);
-    task_ = std::move(task);
-    task_->GetEvent()->set_type(audioproc::Event::STREAM);
-  }
+  // The event collected so far. It is swapped for an empty one when written.
+  audioproc::Event* event() { return &event_; }
 
  private:
-  std::unique_ptr<WriteToFileTask> task_;
+  audioproc::Event event_;
 };
 
 }  // namespace webrtc
@@ -37,13 +37,14 @@ static_assert(kOutputLayerOutputSize <= kFullyConnectedLayerMaxUnits, "");
 
 }  // namespace
 
-RnnVad::RnnVad(const AvailableCpuFeatures& cpu_features)
+RnnVad::RnnVad(const AvailableCpuFeatures& cpu_features, bool quantized)
     : input_(kInputLayerInputSize,
              kInputLayerOutputSize,
              kInputDenseBias,
              kInputDenseWeights,
              ActivationFunction::kTansigApproximated,
              cpu_features,
+             quantized,
              /*layer_name=*/"FC1"),
       hidden_(kInputLayerOutputSize,
               kHiddenLayerOutputSize,
@@ -51,6 +52,7 @@ RnnVad::RnnVad(const AvailableCpuFeatures& cpu_features)
               kHiddenGruWeights,
               kHiddenGruRecurrentWeights,
               cpu_features,
+              quantized,
               /*layer_name=*/"GRU1"),
       output_(kHiddenLayerOutputSize,
               kOutputLayerOutputSize,
@@ -59,6 +61,7 @@ RnnVad::RnnVad(const AvailableCpuFeatures& cpu_features)
               ActivationFunction::kSigmoidApproximated,
               // The output layer is just 24x1. The unoptimized code is faster.
               NoAvailableCpuFeatures(),
+              quantized,
               /*layer_name=*/"FC2") {
   // Input-output chaining size checks.
   RTC_DCHECK_EQ(input_.size(), hidden_.input_size())
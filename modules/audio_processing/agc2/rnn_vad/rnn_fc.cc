@@ -51,6 +51,23 @@ std::vector<float> PreprocessWeights(rtc::ArrayView<const int8_t> weights,
   return w;
 }
 
+// Transposes `weights` and pads each row with zeros to `stride` elements.
+std::vector<int8_t> PreprocessQuantizedWeights(
+    rtc::ArrayView<const int8_t> weights,
+    int output_size,
+    int stride) {
+  const int input_size = rtc::CheckedDivExact(
+      rtc::dchecked_cast<int>(weights.size()), output_size);
+  RTC_DCHECK_GE(stride, input_size);
+  std::vector<int8_t> w(output_size * stride, 0);
+  for (int o = 0; o < output_size; ++o) {
+    for (int i = 0; i < input_size; ++i) {
+      w[o * stride + i] = weights[i * output_size + o];
+    }
+  }
+  return w;
+}
+
 rtc::FunctionView<float(float)> GetActivationFunction(
     ActivationFunction activation_function) {
   switch (activation_function) {
@@ -70,11 +87,18 @@ FullyConnectedLayer::FullyConnectedLayer(
     const rtc::ArrayView<const int8_t> weights,
     ActivationFunction activation_function,
     const AvailableCpuFeatures& cpu_features,
+    bool quantized,
     absl::string_view layer_name)
     : input_size_(input_size),
       output_size_(output_size),
       bias_(GetScaledParams(bias)),
-      weights_(PreprocessWeights(weights, output_size)),
+      weights_(quantized ? std::vector<float>()
+                         : PreprocessWeights(weights, output_size)),
+      quantized_weights_(quantized ? PreprocessQuantizedWeights(
+                                         weights, output_size,
+                                         GetPaddedQuantizedSize(input_size))
+                                   : std::vector<int8_t>()),
+      quantized_input_(quantized ? GetPaddedQuantizedSize(input_size) : 0, 0),
       vector_math_(cpu_features),
       activation_function_(GetActivationFunction(activation_function)) {
   RTC_DCHECK_LE(output_size_, kFullyConnectedLayerMaxUnits)
@@ -82,7 +106,7 @@ FullyConnectedLayer::FullyConnectedLayer(
   RTC_DCHECK_EQ(output_size_, bias_.size())
       << "Mismatching output size and bias terms array size (" << layer_name
       << ").";
-  RTC_DCHECK_EQ(input_size_ * output_size_, weights_.size())
+  RTC_DCHECK_EQ(input_size_ * output_size_, weights.size())
       << "Mismatching input-output size and weight coefficients array size ("
       << layer_name << ").";
 }
@@ -91,6 +115,20 @@ FullyConnectedLayer::~FullyConnectedLayer() = default;
 
 void FullyConnectedLayer::ComputeOutput(rtc::ArrayView<const float> input) {
   RTC_DCHECK_EQ(input.size(), input_size_);
+  if (!quantized_weights_.empty()) {
+    const float input_scale =
+        ::rnnoise::kWeightsScale *
+        QuantizeInt16(input, rtc::ArrayView<int16_t>(quantized_input_));
+    rtc::ArrayView<const int16_t> quantized_input(quantized_input_);
+    rtc::ArrayView<const int8_t> weights(quantized_weights_);
+    const int stride = rtc::dchecked_cast<int>(quantized_input.size());
+    for (int o = 0; o < output_size_; ++o) {
+      const int32_t dot_product = vector_math_.QuantizedDotProduct(
+          quantized_input, weights.subview(o * stride, stride));
+      output_[o] = activation_function_(bias_[o] + input_scale * dot_product);
+    }
+    return;
+  }
   rtc::ArrayView<const float> weights(weights_);
   for (int o = 0; o < output_size_; ++o) {
     output_[o] = activation_function_(
@@ -34,12 +34,15 @@ constexpr int kFullyConnectedLayerMaxUnits = 24;
 class FullyConnectedLayer {
  public:
   // Ctor. `output_size` cannot be greater than `kFullyConnectedLayerMaxUnits`.
+  // If `quantized` is true, the weights are kept as 8 bit integers and the
+  // input is quantized with 16 bit precision before being multiplied with them.
   FullyConnectedLayer(int input_size,
                       int output_size,
                       rtc::ArrayView<const int8_t> bias,
                       rtc::ArrayView<const int8_t> weights,
                       ActivationFunction activation_function,
                       const AvailableCpuFeatures& cpu_features,
+                      bool quantized,
                       absl::string_view layer_name);
   FullyConnectedLayer(const FullyConnectedLayer&) = delete;
   FullyConnectedLayer& operator=(const FullyConnectedLayer&) = delete;
@@ -59,7 +62,13 @@ class FullyConnectedLayer {
   const int input_size_;
   const int output_size_;
   const std::vector<float> bias_;
+  // Empty if the layer is quantized.
   const std::vector<float> weights_;
+  // Transposed weights with rows padded to `quantized_input_.size()`. Empty if
+  // the layer is not quantized.
+  const std::vector<int8_t> quantized_weights_;
+  // Quantized input, zero-padded to a multiple of the dot product block size.
+  std::vector<int16_t> quantized_input_;
   const VectorMath vector_math_;
   rtc::FunctionView<float(float)> activation_function_;
   // Over-allocated array with size equal to `output_size_`.
@@ -56,29 +56,47 @@ TEST_P(RnnFcParametrization, CheckFullyConnectedLayerOutput) {
                          kInputDenseBias, kInputDenseWeights,
                          ActivationFunction::kTansigApproximated,
                          /*cpu_features=*/GetParam(),
+                         /*quantized=*/false,
                          /*layer_name=*/"FC");
   fc.ComputeOutput(kFullyConnectedInputVector);
   ExpectNearAbsolute(kFullyConnectedExpectedOutput, fc, 1e-5f);
 }
 
-TEST_P(RnnFcParametrization, DISABLED_BenchmarkFullyConnectedLayer) {
-  const AvailableCpuFeatures cpu_features = GetParam();
+// Checks that the output of a quantized fully connected layer is within
+// tolerance given test input data.
+TEST_P(RnnFcParametrization, CheckQuantizedFullyConnectedLayerOutput) {
   FullyConnectedLayer fc(kInputLayerInputSize, kInputLayerOutputSize,
                          kInputDenseBias, kInputDenseWeights,
-                         ActivationFunction::kTansigApproximated, cpu_features,
+                         ActivationFunction::kTansigApproximated,
+                         /*cpu_features=*/GetParam(),
+                         /*quantized=*/true,
                          /*layer_name=*/"FC");
+  fc.ComputeOutput(kFullyConnectedInputVector);
+  ExpectNearAbsolute(kFullyConnectedExpectedOutput, fc, 1e-3f);
+}
+
+TEST_P(RnnFcParametrization, DISABLED_BenchmarkFullyConnectedLayer) {
+  const AvailableCpuFeatures cpu_features = GetParam();
+  for (bool quantized : {false, true}) {
+    FullyConnectedLayer fc(kInputLayerInputSize, kInputLayerOutputSize,
+                           kInputDenseBias, kInputDenseWeights,
+                           ActivationFunction::kTansigApproximated,
+                           cpu_features, quantized,
+                           /*layer_name=*/"FC");
 
-  constexpr int kNumTests = 10000;
-  ::webrtc::test::PerformanceTimer perf_timer(kNumTests);
-  for (int k = 0; k < kNumTests; ++k) {
-    perf_timer.StartTimer();
-    fc.ComputeOutput(kFullyConnectedInputVector);
-    perf_timer.StopTimer();
+    constexpr int kNumTests = 10000;
+    ::webrtc::test::PerformanceTimer perf_timer(kNumTests);
+    for (int k = 0; k < kNumTests; ++k) {
+      perf_timer.StartTimer();
+      fc.ComputeOutput(kFullyConnectedInputVector);
+      perf_timer.StopTimer();
+    }
+    RTC_LOG(LS_INFO) << "CPU features: " << cpu_features.ToString()
+                     << " | quantized: " << (quantized ? "yes" : "no") << " | "
+                     << (perf_timer.GetDurationAverage() / 1000) << " +/- "
+                     << (perf_timer.GetDurationStandardDeviation() / 1000)
+                     << " ms";
   }
-  RTC_LOG(LS_INFO) << "CPU features: " << cpu_features.ToString() << " | "
-                   << (perf_timer.GetDurationAverage() / 1000) << " +/- "
-                   << (perf_timer.GetDurationStandardDeviation() / 1000)
-                   << " ms";
 }
 
 // Finds the relevant CPU features combinations to test.
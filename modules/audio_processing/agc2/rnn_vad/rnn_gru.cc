@@ -21,6 +21,10 @@ namespace {
 
 constexpr int kNumGruGates = 3;  // Update, reset, output.
 
+// Size of the buffers for the quantized GRU state.
+constexpr int kQuantizedStateMaxSize =
+    GetPaddedQuantizedSize(kGruLayerMaxUnits);
+
 std::vector<float> PreprocessGruTensor(rtc::ArrayView<const int8_t> tensor_src,
                                        int output_size) {
   // Transpose, cast and scale.
@@ -43,6 +47,28 @@ std::vector<float> PreprocessGruTensor(rtc::ArrayView<const int8_t> tensor_src,
   return tensor_dst;
 }
 
+// Like `PreprocessGruTensor()`, but does not cast and scale the weights. Each
+// row of input weights is zero-padded to `GetPaddedQuantizedSize()` elements.
+std::vector<int8_t> PreprocessQuantizedGruTensor(
+    rtc::ArrayView<const int8_t> tensor_src,
+    int output_size) {
+  const int n = rtc::CheckedDivExact(rtc::dchecked_cast<int>(tensor_src.size()),
+                                     output_size * kNumGruGates);
+  const int padded_n = GetPaddedQuantizedSize(n);
+  const int stride_src = kNumGruGates * output_size;
+  const int stride_dst = padded_n * output_size;
+  std::vector<int8_t> tensor_dst(kNumGruGates * stride_dst, 0);
+  for (int g = 0; g < kNumGruGates; ++g) {
+    for (int o = 0; o < output_size; ++o) {
+      for (int i = 0; i < n; ++i) {
+        tensor_dst[g * stride_dst + o * padded_n + i] =
+            tensor_src[i * stride_src + g * output_size + o];
+      }
+    }
+  }
+  return tensor_dst;
+}
+
 // Computes the output for the update or the reset gate.
 // Operation: `g = sigmoid(W^T∙i + R^T∙s + b)` where
 // - `g`: output gate vector
@@ -119,6 +145,82 @@ void ComputeStateGate(int input_size,
   }
 }
 
+// Quantized version of `ComputeUpdateResetGate()`. The padded `input` and
+// `state` vectors are converted back to float by `input_scale` and
+// `state_scale` respectively.
+void ComputeUpdateResetGateQuantized(
+    int output_size,
+    const VectorMath& vector_math,
+    rtc::ArrayView<const int16_t> input,
+    float input_scale,
+    rtc::ArrayView<const int16_t> state,
+    float state_scale,
+    rtc::ArrayView<const float> bias,
+    rtc::ArrayView<const int8_t> weights,
+    rtc::ArrayView<const int8_t> recurrent_weights,
+    rtc::ArrayView<float> gate) {
+  const int input_stride = rtc::dchecked_cast<int>(input.size());
+  const int state_stride = rtc::dchecked_cast<int>(state.size());
+  RTC_DCHECK_EQ(bias.size(), output_size);
+  RTC_DCHECK_EQ(weights.size(), input_stride * output_size);
+  RTC_DCHECK_EQ(recurrent_weights.size(), state_stride * output_size);
+  RTC_DCHECK_GE(gate.size(), output_size);  // `gate` is over-allocated.
+  for (int o = 0; o < output_size; ++o) {
+    float x = bias[o];
+    x += input_scale * vector_math.QuantizedDotProduct(
+                           input, weights.subview(o * input_stride,
+                                                  input_stride));
+    x += state_scale * vector_math.QuantizedDotProduct(
+                           state, recurrent_weights.subview(
+                                      o * state_stride, state_stride));
+    gate[o] = ::rnnoise::SigmoidApproximated(x);
+  }
+}
+
+// Quantized version of `ComputeStateGate()`. The padded `input` vector is
+// converted back to float by `input_scale`.
+void ComputeStateGateQuantized(int output_size,
+                               const VectorMath& vector_math,
+                               rtc::ArrayView<const int16_t> input,
+                               float input_scale,
+                               rtc::ArrayView<const float> update,
+                               rtc::ArrayView<const float> reset,
+                               rtc::ArrayView<const float> bias,
+                               rtc::ArrayView<const int8_t> weights,
+                               rtc::ArrayView<const int8_t> recurrent_weights,
+                               rtc::ArrayView<float> state) {
+  const int input_stride = rtc::dchecked_cast<int>(input.size());
+  const int state_stride = GetPaddedQuantizedSize(output_size);
+  RTC_DCHECK_GE(update.size(), output_size);  // `update` is over-allocated.
+  RTC_DCHECK_GE(reset.size(), output_size);   // `reset` is over-allocated.
+  RTC_DCHECK_EQ(bias.size(), output_size);
+  RTC_DCHECK_EQ(weights.size(), input_stride * output_size);
+  RTC_DCHECK_EQ(recurrent_weights.size(), state_stride * output_size);
+  RTC_DCHECK_EQ(state.size(), output_size);
+  std::array<float, kGruLayerMaxUnits> reset_x_state;
+  for (int o = 0; o < output_size; ++o) {
+    reset_x_state[o] = state[o] * reset[o];
+  }
+  std::array<int16_t, kQuantizedStateMaxSize> quantized_reset_x_state = {};
+  const float reset_x_state_scale =
+      ::rnnoise::kWeightsScale *
+      QuantizeInt16({reset_x_state.data(), static_cast<size_t>(output_size)},
+                    quantized_reset_x_state);
+  rtc::ArrayView<const int16_t> quantized_reset_x_state_view(
+      quantized_reset_x_state.data(), state_stride);
+  for (int o = 0; o < output_size; ++o) {
+    float x = bias[o];
+    x += input_scale * vector_math.QuantizedDotProduct(
+                           input, weights.subview(o * input_stride,
+                                                  input_stride));
+    x += reset_x_state_scale *
+         vector_math.QuantizedDotProduct(
+             quantized_reset_x_state_view,
+             recurrent_weights.subview(o * state_stride, state_stride));
+    state[o] = update[o] * state[o] + (1.f - update[o]) * std::max(0.f, x);
+  }
+}
+
 }  // namespace
 
 GatedRecurrentLayer::GatedRecurrentLayer(
@@ -128,23 +230,35 @@ GatedRecurrentLayer::GatedRecurrentLayer(
     const rtc::ArrayView<const int8_t> weights,
     const rtc::ArrayView<const int8_t> recurrent_weights,
     const AvailableCpuFeatures& cpu_features,
+    bool quantized,
     absl::string_view layer_name)
     : input_size_(input_size),
       output_size_(output_size),
       bias_(PreprocessGruTensor(bias, output_size)),
-      weights_(PreprocessGruTensor(weights, output_size)),
-      recurrent_weights_(PreprocessGruTensor(recurrent_weights, output_size)),
+      weights_(quantized ? std::vector<float>()
+                         : PreprocessGruTensor(weights, output_size)),
+      recurrent_weights_(quantized ? std::vector<float>()
+                                   : PreprocessGruTensor(recurrent_weights,
+                                                         output_size)),
+      quantized_weights_(
+          quantized ? PreprocessQuantizedGruTensor(weights, output_size)
+                    : std::vector<int8_t>()),
+      quantized_recurrent_weights_(
+          quantized
+              ? PreprocessQuantizedGruTensor(recurrent_weights, output_size)
+              : std::vector<int8_t>()),
+      quantized_input_(quantized ? GetPaddedQuantizedSize(input_size) : 0, 0),
       vector_math_(cpu_features) {
   RTC_DCHECK_LE(output_size_, kGruLayerMaxUnits)
       << "Insufficient GRU layer over-allocation (" << layer_name << ").";
   RTC_DCHECK_EQ(kNumGruGates * output_size_, bias_.size())
       << "Mismatching output size and bias terms array size (" << layer_name
       << ").";
-  RTC_DCHECK_EQ(kNumGruGates * input_size_ * output_size_, weights_.size())
+  RTC_DCHECK_EQ(kNumGruGates * input_size_ * output_size_, weights.size())
       << "Mismatching input-output size and weight coefficients array size ("
       << layer_name << ").";
   RTC_DCHECK_EQ(kNumGruGates * output_size_ * output_size_,
-                recurrent_weights_.size())
+                recurrent_weights.size())
       << "Mismatching input-output size and recurrent weight coefficients array"
          " size ("
       << layer_name << ").";
@@ -159,6 +273,10 @@ void GatedRecurrentLayer::Reset() {
 
 void GatedRecurrentLayer::ComputeOutput(rtc::ArrayView<const float> input) {
   RTC_DCHECK_EQ(input.size(), input_size_);
+  if (!quantized_weights_.empty()) {
+    ComputeOutputQuantized(input);
+    return;
+  }
 
   // The tensors below are organized as a sequence of flattened tensors for the
   // `update`, `reset` and `state` gates.
@@ -194,5 +312,55 @@ void GatedRecurrentLayer::ComputeOutput(rtc::ArrayView<const float> input) {
                    state);
 }
 
+void GatedRecurrentLayer::ComputeOutputQuantized(
+    rtc::ArrayView<const float> input) {
+  // The input and the state are quantized once and shared by all the gates.
+  const float input_scale =
+      ::rnnoise::kWeightsScale *
+      QuantizeInt16(input, rtc::ArrayView<int16_t>(quantized_input_));
+  rtc::ArrayView<const int16_t> quantized_input(quantized_input_);
+  rtc::ArrayView<float> state(state_.data(), output_size_);
+  std::array<int16_t, kQuantizedStateMaxSize> quantized_state = {};
+  const float state_scale =
+      ::rnnoise::kWeightsScale * QuantizeInt16(state, quantized_state);
+  rtc::ArrayView<const int16_t> quantized_state_view(
+      quantized_state.data(), GetPaddedQuantizedSize(output_size_));
+
+  rtc::ArrayView<const float> bias(bias_);
+  rtc::ArrayView<const int8_t> weights(quantized_weights_);
+  rtc::ArrayView<const int8_t> recurrent_weights(quantized_recurrent_weights_);
+  // Strides to access to the flattened tensors for a specific gate.
+  const int stride_weights =
+      rtc::dchecked_cast<int>(quantized_input.size()) * output_size_;
+  const int stride_recurrent_weights =
+      rtc::dchecked_cast<int>(quantized_state_view.size()) * output_size_;
+
+  // Update gate.
+  std::array<float, kGruLayerMaxUnits> update;
+  ComputeUpdateResetGateQuantized(
+      output_size_, vector_math_, quantized_input, input_scale,
+      quantized_state_view, state_scale, bias.subview(0, output_size_),
+      weights.subview(0, stride_weights),
+      recurrent_weights.subview(0, stride_recurrent_weights), update);
+  // Reset gate.
+  std::array<float, kGruLayerMaxUnits> reset;
+  ComputeUpdateResetGateQuantized(
+      output_size_, vector_math_, quantized_input, input_scale,
+      quantized_state_view, state_scale,
+      bias.subview(output_size_, output_size_),
+      weights.subview(stride_weights, stride_weights),
+      recurrent_weights.subview(stride_recurrent_weights,
+                                stride_recurrent_weights),
+      reset);
+  // State gate.
+  ComputeStateGateQuantized(
+      output_size_, vector_math_, quantized_input, input_scale, update, reset,
+      bias.subview(2 * output_size_, output_size_),
+      weights.subview(2 * stride_weights, stride_weights),
+      recurrent_weights.subview(2 * stride_recurrent_weights,
+                                stride_recurrent_weights),
+      state);
+}
+
 }  // namespace rnn_vad
 }  // namespace webrtc
@@ -30,12 +30,16 @@ constexpr int kGruLayerMaxUnits = 24;
 class GatedRecurrentLayer {
  public:
   // Ctor. `output_size` cannot be greater than `kGruLayerMaxUnits`.
+  // If `quantized` is true, the weights are kept as 8 bit integers and the
+  // input and the state are quantized with 16 bit precision before being
+  // multiplied with them.
   GatedRecurrentLayer(int input_size,
                       int output_size,
                       rtc::ArrayView<const int8_t> bias,
                       rtc::ArrayView<const int8_t> weights,
                       rtc::ArrayView<const int8_t> recurrent_weights,
                       const AvailableCpuFeatures& cpu_features,
+                      bool quantized,
                       absl::string_view layer_name);
   GatedRecurrentLayer(const GatedRecurrentLayer&) = delete;
   GatedRecurrentLayer& operator=(const GatedRecurrentLayer&) = delete;
@@ -54,11 +58,20 @@ class GatedRecurrentLayer {
   void ComputeOutput(rtc::ArrayView<const float> input);
 
  private:
+  void ComputeOutputQuantized(rtc::ArrayView<const float> input);
+
   const int input_size_;
   const int output_size_;
   const std::vector<float> bias_;
+  // Empty if the layer is quantized.
   const std::vector<float> weights_;
   const std::vector<float> recurrent_weights_;
+  // Weights with rows padded to `GetPaddedQuantizedSize()`. Empty if the layer
+  // is not quantized.
+  const std::vector<int8_t> quantized_weights_;
+  const std::vector<int8_t> quantized_recurrent_weights_;
+  // Quantized input, zero-padded to `GetPaddedQuantizedSize()` elements.
+  std::vector<int16_t> quantized_input_;
   const VectorMath vector_math_;
   // Over-allocated array with size equal to `output_size_`.
   std::array<float, kGruLayerMaxUnits> state_;
@@ -29,7 +29,8 @@ namespace {
 void TestGatedRecurrentLayer(
     GatedRecurrentLayer& gru,
     rtc::ArrayView<const float> input_sequence,
-    rtc::ArrayView<const float> expected_output_sequence) {
+    rtc::ArrayView<const float> expected_output_sequence,
+    float tolerance) {
   const int input_sequence_length = rtc::CheckedDivExact(
       rtc::dchecked_cast<int>(input_sequence.size()), gru.input_size());
   const int output_sequence_length = rtc::CheckedDivExact(
@@ -44,7 +45,7 @@ void TestGatedRecurrentLayer(
         input_sequence.subview(i * gru.input_size(), gru.input_size()));
     const auto expected_output =
         expected_output_sequence.subview(i * gru.size(), gru.size());
-    ExpectNearAbsolute(expected_output, gru, 3e-6f);
+    ExpectNearAbsolute(expected_output, gru, tolerance);
   }
 }
 
@@ -113,8 +114,22 @@ TEST_P(RnnGruParametrization, CheckGatedRecurrentLayer) {
   GatedRecurrentLayer gru(kGruInputSize, kGruOutputSize, kGruBias, kGruWeights,
                           kGruRecurrentWeights,
                           /*cpu_features=*/GetParam(),
+                          /*quantized=*/false,
                           /*layer_name=*/"GRU");
-  TestGatedRecurrentLayer(gru, kGruInputSequence, kGruExpectedOutputSequence);
+  TestGatedRecurrentLayer(gru, kGruInputSequence, kGruExpectedOutputSequence,
+                          /*tolerance=*/3e-6f);
+}
+
+// Checks that the output of a quantized GRU layer is within tolerance given test
+// input data.
+TEST_P(RnnGruParametrization, CheckQuantizedGatedRecurrentLayer) {
+  GatedRecurrentLayer gru(kGruInputSize, kGruOutputSize, kGruBias, kGruWeights,
+                          kGruRecurrentWeights,
+                          /*cpu_features=*/GetParam(),
+                          /*quantized=*/true,
+                          /*layer_name=*/"GRU");
+  TestGatedRecurrentLayer(gru, kGruInputSequence, kGruExpectedOutputSequence,
+                          /*tolerance=*/1e-4f);
 }
 
 TEST_P(RnnGruParametrization, DISABLED_BenchmarkGatedRecurrentLayer) {
@@ -129,31 +144,33 @@ TEST_P(RnnGruParametrization, DISABLED_BenchmarkGatedRecurrentLayer) {
   using ::rnnoise::kHiddenLayerOutputSize;
   using ::rnnoise::kInputLayerOutputSize;
 
-  GatedRecurrentLayer gru(kInputLayerOutputSize, kHiddenLayerOutputSize,
-                          kHiddenGruBias, kHiddenGruWeights,
-                          kHiddenGruRecurrentWeights,
-                          /*cpu_features=*/GetParam(),
-                          /*layer_name=*/"GRU");
-
   rtc::ArrayView<const float> input_sequence(gru_input_sequence);
   ASSERT_EQ(input_sequence.size() % kInputLayerOutputSize,
             static_cast<size_t>(0));
   const int input_sequence_length =
       input_sequence.size() / kInputLayerOutputSize;
 
-  constexpr int kNumTests = 100;
-  ::webrtc::test::PerformanceTimer perf_timer(kNumTests);
-  for (int k = 0; k < kNumTests; ++k) {
-    perf_timer.StartTimer();
-    for (int i = 0; i < input_sequence_length; ++i) {
-      gru.ComputeOutput(
-          input_sequence.subview(i * gru.input_size(), gru.input_size()));
+  for (bool quantized : {false, true}) {
+    GatedRecurrentLayer gru(kInputLayerOutputSize, kHiddenLayerOutputSize,
+                            kHiddenGruBias, kHiddenGruWeights,
+                            kHiddenGruRecurrentWeights,
+                            /*cpu_features=*/GetParam(), quantized,
+                            /*layer_name=*/"GRU");
+    constexpr int kNumTests = 100;
+    ::webrtc::test::PerformanceTimer perf_timer(kNumTests);
+    for (int k = 0; k < kNumTests; ++k) {
+      perf_timer.StartTimer();
+      for (int i = 0; i < input_sequence_length; ++i) {
+        gru.ComputeOutput(
+            input_sequence.subview(i * gru.input_size(), gru.input_size()));
+      }
+      perf_timer.StopTimer();
     }
-    perf_timer.StopTimer();
+    RTC_LOG(LS_INFO) << "Quantized: " << (quantized ? "yes" : "no") << " | "
+                     << (perf_timer.GetDurationAverage() / 1000) << " +/- "
+                     << (perf_timer.GetDurationStandardDeviation() / 1000)
+                     << " ms";
   }
-  RTC_LOG(LS_INFO) << (perf_timer.GetDurationAverage() / 1000) << " +/- "
-                   << (perf_timer.GetDurationStandardDeviation() / 1000)
-                   << " ms";
 }
 
 // Finds the relevant CPU features combinations to test.
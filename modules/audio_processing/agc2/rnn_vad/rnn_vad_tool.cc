@@ -8,7 +8,10 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -26,6 +29,11 @@
 ABSL_FLAG(std::string, i, "", "Path to the input wav file");
 ABSL_FLAG(std::string, f, "", "Path to the output features file");
 ABSL_FLAG(std::string, o, "", "Path to the output VAD probabilities file");
+ABSL_FLAG(bool,
+          quantized,
+          false,
+          "Computes the VAD probabilities with 8 bit weights and logs how much "
+          "they differ from those computed with float weights");
 
 namespace webrtc {
 namespace rnn_vad {
@@ -67,7 +75,17 @@ int main(int argc, char* argv[]) {
   const AvailableCpuFeatures cpu_features = GetAvailableCpuFeatures();
   FeaturesExtractor features_extractor(cpu_features);
   std::array<float, kFeatureVectorSize> feature_vector;
-  RnnVad rnn_vad(cpu_features);
+  const bool quantized = absl::GetFlag(FLAGS_quantized);
+  RnnVad rnn_vad(cpu_features, quantized);
+  // Reference used to measure the accuracy of the quantized RNN.
+  std::unique_ptr<RnnVad> reference_rnn_vad;
+  if (quantized) {
+    reference_rnn_vad =
+        std::make_unique<RnnVad>(cpu_features, /*quantized=*/false);
+  }
+  float max_abs_error = 0.f;
+  double sum_abs_error = 0.0;
+  int num_frames = 0;
 
   // Compute VAD probabilities.
   while (true) {
@@ -86,6 +104,14 @@ int main(int argc, char* argv[]) {
         samples_10ms_24kHz, feature_vector);
     float vad_probability =
         rnn_vad.ComputeVadProbability(feature_vector, is_silence);
+    if (reference_rnn_vad) {
+      const float abs_error =
+          std::fabs(vad_probability - reference_rnn_vad->ComputeVadProbability(
+                                          feature_vector, is_silence));
+      max_abs_error = std::max(max_abs_error, abs_error);
+      sum_abs_error += abs_error;
+    }
+    ++num_frames;
     // Write voice probability.
     RTC_DCHECK_GE(vad_probability, 0.f);
     RTC_DCHECK_GE(1.f, vad_probability);
@@ -103,6 +129,12 @@ int main(int argc, char* argv[]) {
     }
   }
 
+  if (reference_rnn_vad && num_frames > 0) {
+    RTC_LOG(LS_INFO) << "Quantized VAD probability error | max: "
+                     << max_abs_error
+                     << " | average: " << sum_abs_error / num_frames;
+  }
+
   // Close output file(s).
   fclose(vad_probs_file);
   RTC_LOG(LS_INFO) << "VAD probabilities written to " << output_vad_probs_file;
@@ -11,6 +11,7 @@
 #include <array>
 #include <memory>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "common_audio/resampler/push_sinc_resampler.h"
@@ -56,17 +57,24 @@ TEST(RnnVadTest, CheckWriteComputedOutputIsFalse) {
       << "Cannot land if kWriteComputedOutput is true.";
 }
 
+// Parametrized by the CPU features and by whether the RNN is quantized.
 class RnnVadProbabilityParametrization
-    : public ::testing::TestWithParam<AvailableCpuFeatures> {};
+    : public ::testing::TestWithParam<std::tuple<AvailableCpuFeatures, bool>> {
+ protected:
+  AvailableCpuFeatures cpu_features() const { return std::get<0>(GetParam()); }
+  bool quantized() const { return std::get<1>(GetParam()); }
+};
 
 // Checks that the computed VAD probability for a test input sequence sampled at
 // 48 kHz is within tolerance.
 TEST_P(RnnVadProbabilityParametrization, RnnVadProbabilityWithinTolerance) {
   // Init resampler, feature extractor and RNN.
   PushSincResampler decimator(kFrameSize10ms48kHz, kFrameSize10ms24kHz);
-  const AvailableCpuFeatures cpu_features = GetParam();
-  FeaturesExtractor features_extractor(cpu_features);
-  RnnVad rnn_vad(cpu_features);
+  FeaturesExtractor features_extractor(cpu_features());
+  RnnVad rnn_vad(cpu_features(), quantized());
+  // The quantized RNN is less accurate.
+  const float max_error = quantized() ? 1e-2f : 1e-3f;
+  const float max_average_error = quantized() ? 1e-3f : 1e-4f;
 
   // Init input samples and expected output readers.
   std::unique_ptr<FileReader> samples_reader = CreatePcmSamplesReader();
@@ -96,13 +104,13 @@ TEST_P(RnnVadProbabilityParametrization, RnnVadProbabilityWithinTolerance) {
         {feature_vector.data(), kFeatureVectorSize});
     computed_vad_prob[i] = rnn_vad.ComputeVadProbability(
         {feature_vector.data(), kFeatureVectorSize}, is_silence);
-    EXPECT_NEAR(computed_vad_prob[i], expected_vad_prob[i], 1e-3f);
+    EXPECT_NEAR(computed_vad_prob[i], expected_vad_prob[i], max_error);
     cumulative_error += std::abs(computed_vad_prob[i] - expected_vad_prob[i]);
   }
   // Check average error.
-  EXPECT_LT(cumulative_error / num_frames, 1e-4f);
+  EXPECT_LT(cumulative_error / num_frames, max_average_error);
 
-  if (kWriteComputedOutputToFile) {
+  if (kWriteComputedOutputToFile && !quantized()) {
     FileWriter vad_prob_writer("new_vad_prob.dat");
     vad_prob_writer.WriteChunk(computed_vad_prob);
   }
@@ -130,10 +138,9 @@ TEST_P(RnnVadProbabilityParametrization, DISABLED_RnnVadPerformance) {
                        kFrameSize10ms24kHz);
   }
   // Initialize.
-  const AvailableCpuFeatures cpu_features = GetParam();
-  FeaturesExtractor features_extractor(cpu_features);
+  FeaturesExtractor features_extractor(cpu_features());
   std::array<float, kFeatureVectorSize> feature_vector;
-  RnnVad rnn_vad(cpu_features);
+  RnnVad rnn_vad(cpu_features(), quantized());
   constexpr int number_of_tests = 100;
   ::webrtc::test::PerformanceTimer perf_timer(number_of_tests);
   for (int k = 0; k < number_of_tests; ++k) {
@@ -175,9 +182,12 @@ std::vector<AvailableCpuFeatures> GetCpuFeaturesToTest() {
 INSTANTIATE_TEST_SUITE_P(
     RnnVadTest,
     RnnVadProbabilityParametrization,
-    ::testing::ValuesIn(GetCpuFeaturesToTest()),
-    [](const ::testing::TestParamInfo<AvailableCpuFeatures>& info) {
-      return info.param.ToString();
+    ::testing::Combine(::testing::ValuesIn(GetCpuFeaturesToTest()),
+                       ::testing::Bool()),
+    [](const ::testing::TestParamInfo<std::tuple<AvailableCpuFeatures, bool>>&
+           info) {
+      return std::get<0>(info.param).ToString() +
+             (std::get<1>(info.param) ? "_Quantized" : "");
     });
 
 }  // namespace
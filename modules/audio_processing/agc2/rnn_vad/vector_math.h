@@ -21,6 +21,9 @@
 #include <emmintrin.h>
 #endif
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <numeric>
 
 #include "api/array_view.h"
@@ -32,6 +35,39 @@
 namespace webrtc {
 namespace rnn_vad {
 
+// Vectors with a size multiple of this value are processed by
+// `VectorMath::QuantizedDotProduct()` without a scalar loop for the last
+// elements.
+constexpr int kQuantizedDotProductBlockSize = 16;
+
+// Returns `size` rounded up to a multiple of `kQuantizedDotProductBlockSize`.
+constexpr int GetPaddedQuantizedSize(int size) {
+  return (size + kQuantizedDotProductBlockSize - 1) /
+         kQuantizedDotProductBlockSize * kQuantizedDotProductBlockSize;
+}
+
+// Quantizes `x` into `y` with 16 bit precision by mapping the largest
+// magnitude in `x` to the largest int16_t value. Returns the factor that
+// converts `y` back to the original scale. `y` must be as large as `x`.
+inline float QuantizeInt16(rtc::ArrayView<const float> x,
+                           rtc::ArrayView<int16_t> y) {
+  RTC_DCHECK_GE(y.size(), x.size());
+  float max_abs = 0.f;
+  for (float x_i : x) {
+    max_abs = std::max(max_abs, std::fabs(x_i));
+  }
+  if (max_abs == 0.f) {
+    std::fill(y.begin(), y.begin() + x.size(), 0);
+    return 0.f;
+  }
+  constexpr float kMaxInt16 = 32767.f;
+  const float scale = kMaxInt16 / max_abs;
+  for (size_t i = 0; i < x.size(); ++i) {
+    y[i] = static_cast<int16_t>(std::lrintf(x[i] * scale));
+  }
+  return max_abs / kMaxInt16;
+}
+
 // Provides optimizations for mathematical operations having vectors as
 // operand(s).
 class VectorMath {
@@ -101,9 +137,82 @@ class VectorMath {
     return std::inner_product(x.begin(), x.end(), y.begin(), 0.f);
   }
 
+  // Computes the dot product between two equally sized vectors of 16 bit
+  // activations and 8 bit weights. The result is exact since the products are
+  // accumulated with 32 bit precision.
+  int32_t QuantizedDotProduct(rtc::ArrayView<const int16_t> x,
+                              rtc::ArrayView<const int8_t> y) const {
+    RTC_DCHECK_EQ(x.size(), y.size());
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    if (cpu_features_.avx2) {
+      return QuantizedDotProductAvx2(x, y);
+    } else if (cpu_features_.sse2) {
+      __m128i accumulator = _mm_setzero_si128();
+      constexpr int kBlockSizeLog2 = 3;
+      constexpr int kBlockSize = 1 << kBlockSizeLog2;
+      const int incomplete_block_index = (x.size() >> kBlockSizeLog2)
+                                         << kBlockSizeLog2;
+      for (int i = 0; i < incomplete_block_index; i += kBlockSize) {
+        RTC_DCHECK_LE(i + kBlockSize, x.size());
+        const __m128i x_i =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(&x[i]));
+        // Sign-extend the weights to 16 bits.
+        __m128i y_i = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&y[i]));
+        y_i = _mm_srai_epi16(_mm_unpacklo_epi8(y_i, y_i), 8);
+        // Multiply-add.
+        accumulator = _mm_add_epi32(accumulator, _mm_madd_epi16(x_i, y_i));
+      }
+      // Reduce `accumulator` by addition.
+      accumulator = _mm_add_epi32(
+          accumulator, _mm_shuffle_epi32(accumulator, _MM_SHUFFLE(1, 0, 3, 2)));
+      accumulator = _mm_add_epi32(
+          accumulator, _mm_shuffle_epi32(accumulator, _MM_SHUFFLE(2, 3, 0, 1)));
+      int32_t dot_product = _mm_cvtsi128_si32(accumulator);
+      // Add the result for the last block if incomplete.
+      for (int i = incomplete_block_index;
+           i < rtc::dchecked_cast<int>(x.size()); ++i) {
+        dot_product += x[i] * y[i];
+      }
+      return dot_product;
+    }
+#elif defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_ARM64)
+    if (cpu_features_.neon) {
+      int32x4_t accumulator = vdupq_n_s32(0);
+      constexpr int kBlockSizeLog2 = 3;
+      constexpr int kBlockSize = 1 << kBlockSizeLog2;
+      const int incomplete_block_index = (x.size() >> kBlockSizeLog2)
+                                         << kBlockSizeLog2;
+      for (int i = 0; i < incomplete_block_index; i += kBlockSize) {
+        RTC_DCHECK_LE(i + kBlockSize, x.size());
+        const int16x8_t x_i = vld1q_s16(&x[i]);
+        const int16x8_t y_i = vmovl_s8(vld1_s8(&y[i]));
+        accumulator =
+            vmlal_s16(accumulator, vget_low_s16(x_i), vget_low_s16(y_i));
+        accumulator =
+            vmlal_s16(accumulator, vget_high_s16(x_i), vget_high_s16(y_i));
+      }
+      // Reduce `accumulator` by addition.
+      int32_t dot_product = vaddvq_s32(accumulator);
+      // Add the result for the last block if incomplete.
+      for (int i = incomplete_block_index;
+           i < rtc::dchecked_cast<int>(x.size()); ++i) {
+        dot_product += x[i] * y[i];
+      }
+      return dot_product;
+    }
+#endif
+    int32_t dot_product = 0;
+    for (size_t i = 0; i < x.size(); ++i) {
+      dot_product += x[i] * y[i];
+    }
+    return dot_product;
+  }
+
  private:
   float DotProductAvx2(rtc::ArrayView<const float> x,
                        rtc::ArrayView<const float> y) const;
+  int32_t QuantizedDotProductAvx2(rtc::ArrayView<const int16_t> x,
+                                  rtc::ArrayView<const int8_t> y) const;
 
   const AvailableCpuFeatures cpu_features_;
 };
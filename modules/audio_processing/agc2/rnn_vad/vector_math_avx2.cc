@@ -51,5 +51,40 @@ float VectorMath::DotProductAvx2(rtc::ArrayView<const float> x,
   return dot_product;
 }
 
+int32_t VectorMath::QuantizedDotProductAvx2(
+    rtc::ArrayView<const int16_t> x,
+    rtc::ArrayView<const int8_t> y) const {
+  RTC_DCHECK(cpu_features_.avx2);
+  RTC_DCHECK_EQ(x.size(), y.size());
+  __m256i accumulator = _mm256_setzero_si256();
+  constexpr int kBlockSizeLog2 = 4;
+  constexpr int kBlockSize = 1 << kBlockSizeLog2;
+  static_assert(kBlockSize == kQuantizedDotProductBlockSize, "");
+  const int incomplete_block_index = (x.size() >> kBlockSizeLog2)
+                                     << kBlockSizeLog2;
+  for (int i = 0; i < incomplete_block_index; i += kBlockSize) {
+    RTC_DCHECK_LE(i + kBlockSize, x.size());
+    const __m256i x_i =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&x[i]));
+    // Sign-extend the weights to 16 bits.
+    const __m256i y_i = _mm256_cvtepi8_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&y[i])));
+    // Multiply-add.
+    accumulator = _mm256_add_epi32(accumulator, _mm256_madd_epi16(x_i, y_i));
+  }
+  // Reduce `accumulator` by addition.
+  __m128i low = _mm_add_epi32(_mm256_castsi256_si128(accumulator),
+                              _mm256_extracti128_si256(accumulator, 1));
+  low = _mm_add_epi32(low, _mm_shuffle_epi32(low, _MM_SHUFFLE(1, 0, 3, 2)));
+  low = _mm_add_epi32(low, _mm_shuffle_epi32(low, _MM_SHUFFLE(2, 3, 0, 1)));
+  int32_t dot_product = _mm_cvtsi128_si32(low);
+  // Add the result for the last block if incomplete.
+  for (int i = incomplete_block_index; i < rtc::dchecked_cast<int>(x.size());
+       ++i) {
+    dot_product += x[i] * y[i];
+  }
+  return dot_product;
+}
+
 }  // namespace rnn_vad
 }  // namespace webrtc
@@ -10,9 +10,11 @@
 
 #include "modules/audio_processing/agc2/rnn_vad/vector_math.h"
 
+#include <array>
 #include <vector>
 
 #include "modules/audio_processing/agc2/cpu_features.h"
+#include "test/gmock.h"
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -30,6 +32,9 @@ static_assert(kSizeOfXSubSpan < kSizeOfX, "");
 constexpr float kEnergyOfX = 7.315563958160327f;
 constexpr float kEnergyOfXSubspan = 6.333327669592963f;
 
+constexpr int kSizeOfQuantized = 37;
+static_assert(kSizeOfQuantized % kQuantizedDotProductBlockSize != 0, "");
+
 class VectorMathParametrization
     : public ::testing::TestWithParam<AvailableCpuFeatures> {};
 
@@ -41,6 +46,45 @@ TEST_P(VectorMathParametrization, TestDotProduct) {
       kEnergyOfXSubspan);
 }
 
+// Checks that the quantized dot product is exact also with the extreme values
+// and with vectors whose size is not a multiple of the block size.
+TEST_P(VectorMathParametrization, TestQuantizedDotProduct) {
+  VectorMath vector_math(/*cpu_features=*/GetParam());
+  std::vector<int16_t> x(kSizeOfQuantized);
+  std::vector<int8_t> y(kSizeOfQuantized);
+  int32_t expected_dot_product = 0;
+  for (int i = 0; i < kSizeOfQuantized; ++i) {
+    x[i] = i % 3 == 0 ? -32768 : 32767 - 1000 * i;
+    y[i] = i % 2 == 0 ? -128 : 127 - 7 * i;
+    expected_dot_product += x[i] * y[i];
+  }
+  EXPECT_EQ(vector_math.QuantizedDotProduct(x, y), expected_dot_product);
+  constexpr int kSubSpanSize = 2 * kQuantizedDotProductBlockSize;
+  int32_t expected_sub_span_dot_product = 0;
+  for (int i = 0; i < kSubSpanSize; ++i) {
+    expected_sub_span_dot_product += x[i] * y[i];
+  }
+  EXPECT_EQ(vector_math.QuantizedDotProduct({x.data(), kSubSpanSize},
+                                            {y.data(), kSubSpanSize}),
+            expected_sub_span_dot_product);
+}
+
+TEST(RnnVadTest, QuantizeInt16MapsLargestMagnitudeToInt16Range) {
+  std::array<int16_t, kSizeOfX> quantized;
+  const float scale = QuantizeInt16(kX, quantized);
+  EXPECT_EQ(quantized[4], -32767);  // `kX[4]` has the largest magnitude.
+  for (int i = 0; i < kSizeOfX; ++i) {
+    EXPECT_NEAR(scale * quantized[i], kX[i], scale / 2);
+  }
+}
+
+TEST(RnnVadTest, QuantizeInt16WithZeros) {
+  constexpr std::array<float, 3> kZeros = {0.f, 0.f, 0.f};
+  std::array<int16_t, 3> quantized = {1, 2, 3};
+  EXPECT_EQ(QuantizeInt16(kZeros, quantized), 0.f);
+  EXPECT_THAT(quantized, ::testing::Each(0));
+}
+
 // Finds the relevant CPU features combinations to test.
 std::vector<AvailableCpuFeatures> GetCpuFeaturesToTest() {
   std::vector<AvailableCpuFeatures> v;
@@ -28,8 +28,8 @@ constexpr int kNumFramesPerSecond = 100;
 
 class MonoVadImpl : public VoiceActivityDetectorWrapper::MonoVad {
  public:
-  explicit MonoVadImpl(const AvailableCpuFeatures& cpu_features)
-      : features_extractor_(cpu_features), rnn_vad_(cpu_features) {}
+  MonoVadImpl(const AvailableCpuFeatures& cpu_features, bool quantized)
+      : features_extractor_(cpu_features), rnn_vad_(cpu_features, quantized) {}
   MonoVadImpl(const MonoVadImpl&) = delete;
   MonoVadImpl& operator=(const MonoVadImpl&) = delete;
   ~MonoVadImpl() = default;
@@ -55,10 +55,12 @@ class MonoVadImpl : public VoiceActivityDetectorWrapper::MonoVad {
 VoiceActivityDetectorWrapper::VoiceActivityDetectorWrapper(
     int vad_reset_period_ms,
     const AvailableCpuFeatures& cpu_features,
+    bool quantized_vad,
     int sample_rate_hz)
-    : VoiceActivityDetectorWrapper(vad_reset_period_ms,
-                                   std::make_unique<MonoVadImpl>(cpu_features),
-                                   sample_rate_hz) {}
+    : VoiceActivityDetectorWrapper(
+          vad_reset_period_ms,
+          std::make_unique<MonoVadImpl>(cpu_features, quantized_vad),
+          sample_rate_hz) {}
 
 VoiceActivityDetectorWrapper::VoiceActivityDetectorWrapper(
     int vad_reset_period_ms,
@@ -42,9 +42,11 @@ class VoiceActivityDetectorWrapper {
 
   // Ctor. `vad_reset_period_ms` indicates the period in milliseconds to call
   // `MonoVad::Reset()`; it must be equal to or greater than the duration of two
-  // frames. Uses `cpu_features` to instantiate the default VAD.
+  // frames. Uses `cpu_features` to instantiate the default VAD, which runs with
+  // 8 bit weights if `quantized_vad` is true.
   VoiceActivityDetectorWrapper(int vad_reset_period_ms,
                                const AvailableCpuFeatures& cpu_features,
+                               bool quantized_vad,
                                int sample_rate_hz);
   // Ctor. Uses a custom `vad`.
   VoiceActivityDetectorWrapper(int vad_reset_period_ms,
@@ -151,6 +151,7 @@ AudioProcessingImpl::SubmoduleStates::SubmoduleStates(
 
 bool AudioProcessingImpl::SubmoduleStates::Update(
     bool high_pass_filter_enabled,
+    bool high_pass_filter_in_full_band,
     bool mobile_echo_controller_enabled,
     bool noise_suppressor_enabled,
     bool adaptive_gain_controller_enabled,
@@ -158,9 +159,11 @@ bool AudioProcessingImpl::SubmoduleStates::Update(
     bool gain_adjustment_enabled,
     bool echo_controller_enabled,
     bool voice_detector_enabled,
-    bool transient_suppressor_enabled) {
+    bool transient_suppressor_enabled,
+    bool full_band_processing) {
   bool changed = false;
   changed |= (high_pass_filter_enabled != high_pass_filter_enabled_);
+  changed |= (high_pass_filter_in_full_band != high_pass_filter_in_full_band_);
   changed |=
       (mobile_echo_controller_enabled != mobile_echo_controller_enabled_);
   changed |= (noise_suppressor_enabled != noise_suppressor_enabled_);
@@ -171,8 +174,10 @@ bool AudioProcessingImpl::SubmoduleStates::Update(
   changed |= (echo_controller_enabled != echo_controller_enabled_);
   changed |= (voice_detector_enabled != voice_detector_enabled_);
   changed |= (transient_suppressor_enabled != transient_suppressor_enabled_);
+  changed |= (full_band_processing != full_band_processing_);
   if (changed) {
     high_pass_filter_enabled_ = high_pass_filter_enabled;
+    high_pass_filter_in_full_band_ = high_pass_filter_in_full_band;
     mobile_echo_controller_enabled_ = mobile_echo_controller_enabled;
     noise_suppressor_enabled_ = noise_suppressor_enabled;
     adaptive_gain_controller_enabled_ = adaptive_gain_controller_enabled;
@@ -181,6 +186,7 @@ bool AudioProcessingImpl::SubmoduleStates::Update(
     echo_controller_enabled_ = echo_controller_enabled;
     voice_detector_enabled_ = voice_detector_enabled;
     transient_suppressor_enabled_ = transient_suppressor_enabled;
+    full_band_processing_ = full_band_processing;
   }
 
   changed |= first_update_;
@@ -193,6 +199,18 @@ bool AudioProcessingImpl::SubmoduleStates::CaptureMultiBandSubModulesActive()
   return CaptureMultiBandProcessingPresent() || voice_detector_enabled_;
 }
 
+bool AudioProcessingImpl::SubmoduleStates::CaptureBandSplittingRequired()
+    const {
+  if (!full_band_processing_) {
+    return CaptureMultiBandSubModulesActive();
+  }
+  // All but the high-pass filter only operate on the split bands.
+  return (high_pass_filter_enabled_ && !high_pass_filter_in_full_band_) ||
+         mobile_echo_controller_enabled_ || noise_suppressor_enabled_ ||
+         adaptive_gain_controller_enabled_ || echo_controller_enabled_ ||
+         voice_detector_enabled_;
+}
+
 bool AudioProcessingImpl::SubmoduleStates::CaptureMultiBandProcessingPresent()
     const {
   // If echo controller is present, assume it performs active processing.
@@ -455,7 +473,7 @@ int AudioProcessingImpl::InitializeLocked(const ProcessingConfig& config) {
       std::min(formats_.api_format.input_stream().sample_rate_hz(),
                formats_.api_format.output_stream().sample_rate_hz()),
       max_splitting_rate,
-      submodule_states_.CaptureMultiBandSubModulesActive() ||
+      submodule_states_.CaptureBandSplittingRequired() ||
           submodule_states_.RenderMultiBandSubModulesActive());
   RTC_DCHECK_NE(8000, capture_processing_rate);
 
@@ -468,7 +486,7 @@ int AudioProcessingImpl::InitializeLocked(const ProcessingConfig& config) {
         std::min(formats_.api_format.reverse_input_stream().sample_rate_hz(),
                  formats_.api_format.reverse_output_stream().sample_rate_hz()),
         max_splitting_rate,
-        submodule_states_.CaptureMultiBandSubModulesActive() ||
+        submodule_states_.CaptureBandSplittingRequired() ||
             submodule_states_.RenderMultiBandSubModulesActive());
   } else {
     render_processing_rate = capture_processing_rate;
@@ -530,7 +548,9 @@ void AudioProcessingImpl::ApplyConfig(const AudioProcessing::Config& config) {
       config_.pipeline.multi_channel_capture !=
           config.pipeline.multi_channel_capture ||
       config_.pipeline.maximum_internal_processing_rate !=
-          config.pipeline.maximum_internal_processing_rate;
+          config.pipeline.maximum_internal_processing_rate ||
+      config_.pipeline.full_band_processing !=
+          config.pipeline.full_band_processing;
 
   const bool aec_config_changed =
       config_.echo_canceller.enabled != config.echo_canceller.enabled ||
@@ -942,13 +962,14 @@ void AudioProcessingImpl::QueueBandedRenderAudio(AudioBuffer* audio) {
     RTC_DCHECK(aecm_render_signal_queue_);
     // Insert the samples into the queue.
     if (!aecm_render_signal_queue_->Insert(&aecm_render_queue_buffer_)) {
-      // The data queue is full and needs to be emptied.
-      EmptyQueuedRenderAudio();
-
-      // Retry the insert (should always work).
-      bool result =
-          aecm_render_signal_queue_->Insert(&aecm_render_queue_buffer_);
-      RTC_DCHECK(result);
+      // The data queue is full and needs to be emptied. The frame is dropped
+      // if the capture side is busy, to never block on it.
+      if (TryEmptyQueuedRenderAudio()) {
+        // Retry the insert (should always work).
+        bool result =
+            aecm_render_signal_queue_->Insert(&aecm_render_queue_buffer_);
+        RTC_DCHECK(result);
+      }
     }
   }
 
@@ -956,12 +977,14 @@ void AudioProcessingImpl::QueueBandedRenderAudio(AudioBuffer* audio) {
     GainControlImpl::PackRenderAudioBuffer(*audio, &agc_render_queue_buffer_);
     // Insert the samples into the queue.
     if (!agc_render_signal_queue_->Insert(&agc_render_queue_buffer_)) {
-      // The data queue is full and needs to be emptied.
-      EmptyQueuedRenderAudio();
-
-      // Retry the insert (should always work).
-      bool result = agc_render_signal_queue_->Insert(&agc_render_queue_buffer_);
-      RTC_DCHECK(result);
+      // The data queue is full and needs to be emptied. The frame is dropped
+      // if the capture side is busy, to never block on it.
+      if (TryEmptyQueuedRenderAudio()) {
+        // Retry the insert (should always work).
+        bool result =
+            agc_render_signal_queue_->Insert(&agc_render_queue_buffer_);
+        RTC_DCHECK(result);
+      }
     }
   }
 }
@@ -972,12 +995,14 @@ void AudioProcessingImpl::QueueNonbandedRenderAudio(AudioBuffer* audio) {
     RTC_DCHECK(red_render_signal_queue_);
     // Insert the samples into the queue.
     if (!red_render_signal_queue_->Insert(&red_render_queue_buffer_)) {
-      // The data queue is full and needs to be emptied.
-      EmptyQueuedRenderAudio();
-
-      // Retry the insert (should always work).
-      bool result = red_render_signal_queue_->Insert(&red_render_queue_buffer_);
-      RTC_DCHECK(result);
+      // The data queue is full and needs to be emptied. The frame is dropped
+      // if the capture side is busy, to never block on it.
+      if (TryEmptyQueuedRenderAudio()) {
+        // Retry the insert (should always work).
+        bool result =
+            red_render_signal_queue_->Insert(&red_render_queue_buffer_);
+        RTC_DCHECK(result);
+      }
     }
   }
 }
@@ -1034,9 +1059,13 @@ void AudioProcessingImpl::AllocateRenderQueue() {
   }
 }
 
-void AudioProcessingImpl::EmptyQueuedRenderAudio() {
-  MutexLock lock_capture(&mutex_capture_);
+bool AudioProcessingImpl::TryEmptyQueuedRenderAudio() {
+  if (!mutex_capture_.TryLock()) {
+    return false;
+  }
   EmptyQueuedRenderAudioLocked();
+  mutex_capture_.Unlock();
+  return true;
 }
 
 void AudioProcessingImpl::EmptyQueuedRenderAudioLocked() {
@@ -1183,7 +1212,7 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
     submodules_.agc_manager->AnalyzePreProcess(capture_buffer);
   }
 
-  if (submodule_states_.CaptureMultiBandSubModulesActive() &&
+  if (submodule_states_.CaptureBandSplittingRequired() &&
       SampleRateSupportsMultiBand(
           capture_nonlocked_.capture_processing_format.sample_rate_hz())) {
     capture_buffer->SplitIntoFrequencyBands();
@@ -1276,6 +1305,7 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
   }
 
   if (submodule_states_.CaptureMultiBandProcessingPresent() &&
+      submodule_states_.CaptureBandSplittingRequired() &&
       SampleRateSupportsMultiBand(
           capture_nonlocked_.capture_processing_format.sample_rate_hz())) {
     capture_buffer->MergeFrequencyBands();
@@ -1715,12 +1745,15 @@ AudioProcessing::Config AudioProcessingImpl::GetConfig() const {
 
 bool AudioProcessingImpl::UpdateActiveSubmoduleStates() {
   return submodule_states_.Update(
-      config_.high_pass_filter.enabled, !!submodules_.echo_control_mobile,
-      !!submodules_.noise_suppressor, !!submodules_.gain_control,
-      !!submodules_.gain_controller2,
+      config_.high_pass_filter.enabled,
+      config_.high_pass_filter.apply_in_full_band &&
+          !constants_.enforce_split_band_hpf,
+      !!submodules_.echo_control_mobile, !!submodules_.noise_suppressor,
+      !!submodules_.gain_control, !!submodules_.gain_controller2,
       config_.pre_amplifier.enabled || config_.capture_level_adjustment.enabled,
       capture_nonlocked_.echo_controller_enabled,
-      config_.voice_detection.enabled, !!submodules_.transient_suppressor);
+      config_.voice_detection.enabled, !!submodules_.transient_suppressor,
+      config_.pipeline.full_band_processing);
 }
 
 void AudioProcessingImpl::InitializeTransientSuppressor() {
@@ -203,6 +203,7 @@ class AudioProcessingImpl : public AudioProcessing {
                     bool capture_analyzer_enabled);
     // Updates the submodule state and returns true if it has changed.
     bool Update(bool high_pass_filter_enabled,
+                bool high_pass_filter_in_full_band,
                 bool mobile_echo_controller_enabled,
                 bool noise_suppressor_enabled,
                 bool adaptive_gain_controller_enabled,
@@ -210,8 +211,12 @@ class AudioProcessingImpl : public AudioProcessing {
                 bool gain_adjustment_enabled,
                 bool echo_controller_enabled,
                 bool voice_detector_enabled,
-                bool transient_suppressor_enabled);
+                bool transient_suppressor_enabled,
+                bool full_band_processing);
     bool CaptureMultiBandSubModulesActive() const;
+    // Returns whether the capture audio must be split into bands for the
+    // active submodules.
+    bool CaptureBandSplittingRequired() const;
     bool CaptureMultiBandProcessingPresent() const;
     bool CaptureMultiBandProcessingActive(bool ec_processing_active) const;
     bool CaptureFullBandProcessingActive() const;
@@ -226,6 +231,7 @@ class AudioProcessingImpl : public AudioProcessing {
     const bool render_pre_processor_enabled_ = false;
     const bool capture_analyzer_enabled_ = false;
     bool high_pass_filter_enabled_ = false;
+    bool high_pass_filter_in_full_band_ = false;
     bool mobile_echo_controller_enabled_ = false;
     bool noise_suppressor_enabled_ = false;
     bool adaptive_gain_controller_enabled_ = false;
@@ -234,6 +240,7 @@ class AudioProcessingImpl : public AudioProcessing {
     bool echo_controller_enabled_ = false;
     bool voice_detector_enabled_ = false;
     bool transient_suppressor_enabled_ = false;
+    bool full_band_processing_ = false;
     bool first_update_ = true;
   };
 
@@ -296,7 +303,10 @@ class AudioProcessingImpl : public AudioProcessing {
   void HandleRenderRuntimeSettings()
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_);
 
-  void EmptyQueuedRenderAudio() RTC_LOCKS_EXCLUDED(mutex_capture_);
+  // Empties the render queues unless the capture lock is held, as the render
+  // thread must not wait for the capture processing. Returns whether the
+  // queues were emptied.
+  bool TryEmptyQueuedRenderAudio() RTC_LOCKS_EXCLUDED(mutex_capture_);
   void EmptyQueuedRenderAudioLocked()
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
   void AllocateRenderQueue()
@@ -9,7 +9,9 @@
  */
 
 #include <algorithm>
+#include <array>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "api/array_view.h"
@@ -998,6 +1000,26 @@ void RenderProcessor::ApplyRuntimeSettingScheme() {
                frame_data_.input_number_of_channels);
 }
 
+// Blocks the capture processing, while it holds the capture lock, until
+// released.
+class BlockingCaptureProcessing : public CustomProcessing {
+ public:
+  BlockingCaptureProcessing(rtc::Event* entered, rtc::Event* release)
+      : entered_(entered), release_(release) {}
+
+  void Initialize(int sample_rate_hz, int num_channels) override {}
+  void Process(AudioBuffer* audio) override {
+    entered_->Set();
+    release_->Wait(rtc::Event::kForever);
+  }
+  std::string ToString() const override { return "BlockingCapture"; }
+  void SetRuntimeSetting(AudioProcessing::RuntimeSetting setting) override {}
+
+ private:
+  rtc::Event* const entered_;
+  rtc::Event* const release_;
+};
+
 }  // namespace
 
 TEST_P(AudioProcessingImplLockTest, LockTest) {
@@ -1005,6 +1027,61 @@ TEST_P(AudioProcessingImplLockTest, LockTest) {
   ASSERT_TRUE(RunTest());
 }
 
+// Verifies that the render processing does not wait for the capture
+// processing when the queues of render data for the capture side are full.
+TEST(AudioProcessingImplLockTest, RenderDoesNotWaitForBusyCapture) {
+  rtc::Event capture_entered;
+  rtc::Event release_capture;
+  rtc::scoped_refptr<AudioProcessing> apm =
+      AudioProcessingBuilderForTesting()
+          .SetCapturePostProcessing(std::make_unique<BlockingCaptureProcessing>(
+              &capture_entered, &release_capture))
+          .Create();
+  AudioProcessing::Config config;
+  config.gain_controller1.enabled = true;
+  config.gain_controller1.mode =
+      AudioProcessing::Config::GainController1::kAdaptiveDigital;
+  config.gain_controller1.analog_gain_controller.enabled = false;
+  apm->ApplyConfig(config);
+
+  const StreamConfig stream_config(16000, 1);
+  std::array<float, 160> render_samples = {};
+  std::array<float, 160> capture_samples = {};
+  float* render_channels[] = {render_samples.data()};
+  float* capture_channels[] = {capture_samples.data()};
+
+  // Set up the render format, which requires the capture lock.
+  ASSERT_EQ(AudioProcessing::kNoError,
+            apm->ProcessReverseStream(render_channels, stream_config,
+                                      stream_config, render_channels));
+
+  rtc::PlatformThread capture_thread = rtc::PlatformThread::SpawnJoinable(
+      [&] {
+        apm->ProcessStream(capture_channels, stream_config, stream_config,
+                           capture_channels);
+      },
+      "capture");
+  ASSERT_TRUE(capture_entered.Wait(kTestTimeOutLimit));
+
+  // Process more render frames than the queues to the capture side can hold.
+  rtc::Event render_done;
+  rtc::PlatformThread render_thread = rtc::PlatformThread::SpawnJoinable(
+      [&] {
+        for (int i = 0; i < 300; ++i) {
+          EXPECT_EQ(AudioProcessing::kNoError,
+                    apm->ProcessReverseStream(render_channels, stream_config,
+                                              stream_config, render_channels));
+        }
+        render_done.Set();
+      },
+      "render");
+  EXPECT_TRUE(render_done.Wait(/*give_up_after_ms=*/10000));
+
+  release_capture.Set();
+  capture_thread.Finalize();
+  render_thread.Finalize();
+}
+
 // Instantiate tests from the extreme test configuration set.
 INSTANTIATE_TEST_SUITE_P(
     DISABLED_AudioProcessingImplLockExtensive,
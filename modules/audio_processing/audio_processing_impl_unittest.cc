@@ -11,6 +11,7 @@
 #include "modules/audio_processing/audio_processing_impl.h"
 
 #include <array>
+#include <cmath>
 #include <memory>
 
 #include "api/scoped_refptr.h"
@@ -170,6 +171,58 @@ TEST(AudioProcessingImplTest, AudioParameterChangeTriggersInit) {
       mock.ProcessReverseStream(frame.data(), config, config, frame.data()));
 }
 
+// With full-band processing, the high-pass filter alone does not make APM split
+// the capture audio into bands. Hence, the audio is processed at its native
+// rate even if the internal processing rate for band splitting is limited.
+TEST(AudioProcessingImplTest, FullBandProcessingAvoidsBandSplitting) {
+  constexpr int kSampleRateHz = 48000;
+  constexpr int kNumFramesPerChunk = kSampleRateHz / 100;
+  constexpr double kPi = 3.14159265358979323846;
+  constexpr double kToneFrequencyHz = 20000.0;
+  constexpr int kNumChunks = 20;
+  constexpr int kNumWarmupChunks = 10;
+  for (bool full_band_processing : {false, true}) {
+    SCOPED_TRACE(full_band_processing);
+    rtc::scoped_refptr<AudioProcessing> apm =
+        AudioProcessingBuilderForTesting().Create();
+    AudioProcessing::Config apm_config;
+    apm_config.pipeline.maximum_internal_processing_rate = 32000;
+    apm_config.pipeline.full_band_processing = full_band_processing;
+    apm_config.high_pass_filter.enabled = true;
+    apm->ApplyConfig(apm_config);
+
+    std::array<float, kNumFramesPerChunk> frame;
+    float* channels[] = {frame.data()};
+    StreamConfig stream_config(kSampleRateHz, 1, /*has_keyboard=*/false);
+    float input_energy = 0.f;
+    float output_energy = 0.f;
+    for (int i = 0; i < kNumChunks; ++i) {
+      for (int k = 0; k < kNumFramesPerChunk; ++k) {
+        frame[k] = 0.5 * std::sin(2.0 * kPi * kToneFrequencyHz *
+                                  (i * kNumFramesPerChunk + k) / kSampleRateHz);
+        if (i >= kNumWarmupChunks) {
+          input_energy += frame[k] * frame[k];
+        }
+      }
+      ASSERT_EQ(AudioProcessing::kNoError,
+                apm->ProcessStream(channels, stream_config, stream_config,
+                                   channels));
+      if (i >= kNumWarmupChunks) {
+        for (float sample : frame) {
+          output_energy += sample * sample;
+        }
+      }
+    }
+    if (full_band_processing) {
+      EXPECT_GT(output_energy, 0.8f * input_energy);
+    } else {
+      // Band splitting limits the processing to 32 kHz, which removes the
+      // tone.
+      EXPECT_LT(output_energy, 0.01f * input_energy);
+    }
+  }
+}
+
 TEST(AudioProcessingImplTest, UpdateCapturePreGainRuntimeSetting) {
   rtc::scoped_refptr<AudioProcessing> apm =
       AudioProcessingBuilderForTesting().Create();
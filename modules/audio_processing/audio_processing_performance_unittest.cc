@@ -31,6 +31,7 @@ namespace webrtc {
 namespace {
 
 static const bool kPrintAllDurations = false;
+static const int kMaxNumChannels = 8;
 
 class CallSimulator;
 
@@ -50,15 +51,14 @@ enum class SettingsType {
 struct AudioFrameData {
   explicit AudioFrameData(size_t max_frame_size) {
     // Set up the two-dimensional arrays needed for the APM API calls.
-    input_framechannels.resize(2 * max_frame_size);
-    input_frame.resize(2);
-    input_frame[0] = &input_framechannels[0];
-    input_frame[1] = &input_framechannels[max_frame_size];
-
-    output_frame_channels.resize(2 * max_frame_size);
-    output_frame.resize(2);
-    output_frame[0] = &output_frame_channels[0];
-    output_frame[1] = &output_frame_channels[max_frame_size];
+    input_framechannels.resize(kMaxNumChannels * max_frame_size);
+    input_frame.resize(kMaxNumChannels);
+    output_frame_channels.resize(kMaxNumChannels * max_frame_size);
+    output_frame.resize(kMaxNumChannels);
+    for (int ch = 0; ch < kMaxNumChannels; ++ch) {
+      input_frame[ch] = &input_framechannels[ch * max_frame_size];
+      output_frame[ch] = &output_frame_channels[ch * max_frame_size];
+    }
   }
 
   std::vector<float> output_frame_channels;
@@ -71,9 +71,12 @@ struct AudioFrameData {
 
 // The configuration for the test.
 struct SimulationConfig {
-  SimulationConfig(int sample_rate_hz, SettingsType simulation_settings)
+  SimulationConfig(int sample_rate_hz,
+                   SettingsType simulation_settings,
+                   int num_capture_channels = 1)
       : sample_rate_hz(sample_rate_hz),
-        simulation_settings(simulation_settings) {}
+        simulation_settings(simulation_settings),
+        num_capture_channels(num_capture_channels) {}
 
   static std::vector<SimulationConfig> GenerateSimulationConfigs() {
     std::vector<SimulationConfig> simulation_configs;
@@ -90,6 +93,14 @@ struct SimulationConfig {
         simulation_configs.push_back(SimulationConfig(sample_rate, settings));
       }
     }
+
+    // Shows how the cost of the capture processing scales with the number of
+    // microphones, e.g., of a conference room array.
+    for (int num_capture_channels : {2, 4, kMaxNumChannels}) {
+      simulation_configs.push_back(
+          SimulationConfig(48000, SettingsType::kDefaultApmDesktop,
+                           num_capture_channels));
+    }
 #endif
 
     const SettingsType mobile_settings[] = {SettingsType::kDefaultApmMobile};
@@ -124,11 +135,15 @@ struct SimulationConfig {
         description = "DefaultApmDesktopWithoutExtendedFilter";
         break;
     }
+    if (num_capture_channels > 1) {
+      description += "_" + std::to_string(num_capture_channels) + "Channels";
+    }
     return description;
   }
 
   int sample_rate_hz = 16000;
   SettingsType simulation_settings = SettingsType::kDefaultApmDesktop;
+  int num_capture_channels = 1;
 };
 
 // Handler for the frame counters.
@@ -352,7 +367,8 @@ class TimedThreadApiProcessor {
     // Prepare the float audio output data and metadata.
     frame_data_.output_stream_config.set_sample_rate_hz(
         simulation_config_->sample_rate_hz);
-    frame_data_.output_stream_config.set_num_channels(1);
+    frame_data_.output_stream_config.set_num_channels(
+        processor_type_ == ProcessorType::kCapture ? num_channels_ : 1);
     frame_data_.output_stream_config.set_has_keyboard(false);
   }
 
@@ -470,7 +486,7 @@ class CallSimulator : public ::testing::TestWithParam<SimulationConfig> {
       apm->ApplyConfig(apm_config);
     };
 
-    int num_capture_channels = 1;
+    const int num_capture_channels = simulation_config_.num_capture_channels;
     switch (simulation_config_.simulation_settings) {
       case SettingsType::kDefaultApmMobile: {
         apm_ = AudioProcessingBuilderForTesting().Create();
@@ -482,6 +498,12 @@ class CallSimulator : public ::testing::TestWithParam<SimulationConfig> {
         apm_ = AudioProcessingBuilderForTesting().Create();
         ASSERT_TRUE(!!apm_);
         set_default_desktop_apm_runtime_settings(apm_.get());
+        if (num_capture_channels > 1) {
+          // Process all capture channels instead of a downmix of them.
+          AudioProcessing::Config apm_config = apm_->GetConfig();
+          apm_config.pipeline.multi_channel_capture = true;
+          apm_->ApplyConfig(apm_config);
+        }
         break;
       }
       case SettingsType::kAllSubmodulesTurnedOff: {
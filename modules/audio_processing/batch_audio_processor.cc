@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/batch_audio_processor.h"
+
+#include <algorithm>
+#include <string>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+BatchAudioProcessor::BatchAudioProcessor(int num_threads) {
+  RTC_DCHECK_GE(num_threads, 0);
+  for (int i = 0; i < num_threads; ++i) {
+    start_events_.push_back(std::make_unique<rtc::Event>());
+    rtc::Event* start = start_events_.back().get();
+    threads_.push_back(rtc::PlatformThread::SpawnJoinable(
+        [this, start] { RunWorker(start); },
+        "BatchApm" + std::to_string(i),
+        rtc::ThreadAttributes().SetPriority(rtc::ThreadPriority::kRealtime)));
+  }
+}
+
+BatchAudioProcessor::~BatchAudioProcessor() {
+  quit_.store(true);
+  for (auto& start : start_events_) {
+    start->Set();
+  }
+  for (rtc::PlatformThread& thread : threads_) {
+    thread.Finalize();
+  }
+}
+
+void BatchAudioProcessor::ProcessCaptureFrames(rtc::ArrayView<Frame> frames) {
+  ProcessFrames(frames, /*render=*/false);
+}
+
+void BatchAudioProcessor::ProcessRenderFrames(rtc::ArrayView<Frame> frames) {
+  ProcessFrames(frames, /*render=*/true);
+}
+
+void BatchAudioProcessor::ProcessFrames(rtc::ArrayView<Frame> frames,
+                                        bool render) {
+  frames_ = frames;
+  render_ = render;
+  next_frame_.store(0);
+
+  // Only wake as many workers as there are frames for besides the one
+  // processed by the calling thread.
+  const size_t num_workers =
+      std::min(threads_.size(), frames.empty() ? 0 : frames.size() - 1);
+  running_workers_.store(static_cast<int>(num_workers));
+  for (size_t i = 0; i < num_workers; ++i) {
+    start_events_[i]->Set();
+  }
+  ProcessPendingFrames();
+  if (num_workers > 0) {
+    batch_done_.Wait(rtc::Event::kForever);
+  }
+  frames_ = rtc::ArrayView<Frame>();
+}
+
+void BatchAudioProcessor::RunWorker(rtc::Event* start) {
+  while (true) {
+    start->Wait(rtc::Event::kForever);
+    if (quit_.load()) {
+      return;
+    }
+    ProcessPendingFrames();
+    if (running_workers_.fetch_sub(1) == 1) {
+      batch_done_.Set();
+    }
+  }
+}
+
+void BatchAudioProcessor::ProcessPendingFrames() {
+  for (size_t i = next_frame_.fetch_add(1); i < frames_.size();
+       i = next_frame_.fetch_add(1)) {
+    Frame& frame = frames_[i];
+    RTC_DCHECK(frame.apm);
+    frame.error =
+        render_ ? frame.apm->ProcessReverseStream(frame.src, frame.input_config,
+                                                  frame.output_config,
+                                                  frame.dest)
+                : frame.apm->ProcessStream(frame.src, frame.input_config,
+                                           frame.output_config, frame.dest);
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,85 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_BATCH_AUDIO_PROCESSOR_H_
+#define MODULES_AUDIO_PROCESSING_BATCH_AUDIO_PROCESSOR_H_
+
+#include <stddef.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/include/audio_processing.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+
+namespace webrtc {
+
+// Processes the 10 ms frames of many independent AudioProcessing instances in
+// one call, e.g., on a server that runs one instance per participant. The
+// frames of a batch are spread over a pool of worker threads and the calling
+// thread, so that a single call per 10 ms replaces one task per stream.
+//
+// The instances in a batch must be distinct, since the frames are processed
+// in no particular order. The class is not thread-safe: batches must be
+// processed one at a time.
+class BatchAudioProcessor {
+ public:
+  // The frame to process for one stream, and the result of doing so.
+  struct Frame {
+    AudioProcessing* apm = nullptr;
+    const float* const* src = nullptr;
+    StreamConfig input_config;
+    StreamConfig output_config;
+    float* const* dest = nullptr;
+    // Set by the processing to the error code returned by `apm`.
+    int error = AudioProcessing::kNoError;
+  };
+
+  // Creates `num_threads` worker threads; with none, the frames are processed
+  // on the calling thread.
+  explicit BatchAudioProcessor(int num_threads);
+  ~BatchAudioProcessor();
+
+  BatchAudioProcessor(const BatchAudioProcessor&) = delete;
+  BatchAudioProcessor& operator=(const BatchAudioProcessor&) = delete;
+
+  // Calls ProcessStream() for each of the frames and returns once all of them
+  // have been processed.
+  void ProcessCaptureFrames(rtc::ArrayView<Frame> frames);
+
+  // Calls ProcessReverseStream() for each of the frames and returns once all
+  // of them have been processed.
+  void ProcessRenderFrames(rtc::ArrayView<Frame> frames);
+
+ private:
+  void ProcessFrames(rtc::ArrayView<Frame> frames, bool render);
+  void RunWorker(rtc::Event* start);
+  // Processes frames of the current batch until none are left.
+  void ProcessPendingFrames();
+
+  std::vector<std::unique_ptr<rtc::Event>> start_events_;
+  std::vector<rtc::PlatformThread> threads_;
+  rtc::Event batch_done_;
+  std::atomic<bool> quit_{false};
+
+  // The current batch. Written before the workers are started and read-only
+  // while they run, except for the atomics.
+  rtc::ArrayView<Frame> frames_;
+  bool render_ = false;
+  std::atomic<size_t> next_frame_{0};
+  std::atomic<int> running_workers_{0};
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_BATCH_AUDIO_PROCESSOR_H_
@@ -0,0 +1,101 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/batch_audio_processor.h"
+
+#include <vector>
+
+#include "api/scoped_refptr.h"
+#include "rtc_base/ref_counted_object.h"
+#include "modules/audio_processing/include/mock_audio_processing.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::_;
+using ::testing::Return;
+using test::MockAudioProcessing;
+
+constexpr int kNumStreams = 10;
+constexpr int kNumBatches = 5;
+constexpr int kSamplesPerChannel = 160;
+
+class BatchAudioProcessorTest : public ::testing::TestWithParam<int> {
+ protected:
+  BatchAudioProcessorTest() : processor_(/*num_threads=*/GetParam()) {
+    for (int i = 0; i < kNumStreams; ++i) {
+      apms_.push_back(
+          rtc::make_ref_counted<::testing::StrictMock<MockAudioProcessing>>());
+      channels_[i] = samples_[i];
+      BatchAudioProcessor::Frame frame;
+      frame.apm = apms_.back().get();
+      frame.src = &channels_[i];
+      frame.dest = &channels_[i];
+      frames_.push_back(frame);
+    }
+  }
+
+  // The error code returned for the frames of the i:th stream.
+  static int ErrorForStream(int i) {
+    return i % 2 == 0 ? AudioProcessing::kNoError
+                      : AudioProcessing::kBadParameterError;
+  }
+
+  float samples_[kNumStreams][kSamplesPerChannel] = {};
+  float* channels_[kNumStreams];
+  std::vector<rtc::scoped_refptr<::testing::StrictMock<MockAudioProcessing>>>
+      apms_;
+  std::vector<BatchAudioProcessor::Frame> frames_;
+  BatchAudioProcessor processor_;
+};
+
+INSTANTIATE_TEST_SUITE_P(NumThreads,
+                         BatchAudioProcessorTest,
+                         ::testing::Values(0, 1, 4, kNumStreams + 1));
+
+TEST_P(BatchAudioProcessorTest, ProcessesEachCaptureFrameOnce) {
+  for (int i = 0; i < kNumStreams; ++i) {
+    EXPECT_CALL(*apms_[i], ProcessStream(frames_[i].src, _, _, frames_[i].dest))
+        .Times(kNumBatches)
+        .WillRepeatedly(Return(ErrorForStream(i)));
+  }
+  for (int batch = 0; batch < kNumBatches; ++batch) {
+    processor_.ProcessCaptureFrames(frames_);
+    for (int i = 0; i < kNumStreams; ++i) {
+      EXPECT_EQ(frames_[i].error, ErrorForStream(i));
+      frames_[i].error = AudioProcessing::kUnspecifiedError;
+    }
+  }
+}
+
+TEST_P(BatchAudioProcessorTest, ProcessesEachRenderFrameOnce) {
+  for (int i = 0; i < kNumStreams; ++i) {
+    EXPECT_CALL(*apms_[i],
+                ProcessReverseStream(frames_[i].src, _, _, frames_[i].dest))
+        .Times(kNumBatches)
+        .WillRepeatedly(Return(ErrorForStream(i)));
+  }
+  for (int batch = 0; batch < kNumBatches; ++batch) {
+    processor_.ProcessRenderFrames(frames_);
+    for (int i = 0; i < kNumStreams; ++i) {
+      EXPECT_EQ(frames_[i].error, ErrorForStream(i));
+      frames_[i].error = AudioProcessing::kUnspecifiedError;
+    }
+  }
+}
+
+TEST_P(BatchAudioProcessorTest, ProcessesEmptyBatch) {
+  processor_.ProcessCaptureFrames({});
+}
+
+}  // namespace
+}  // namespace webrtc
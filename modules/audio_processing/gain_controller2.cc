@@ -91,6 +91,7 @@ GainController2::GainController2(const Agc2Config& config,
     // digital to gain controller 2 config.
     vad_ = std::make_unique<VoiceActivityDetectorWrapper>(
         config.adaptive_digital.vad_reset_period_ms, cpu_features_,
+        /*quantized_vad=*/field_trial::IsEnabled("WebRTC-Agc2QuantizedRnnVad"),
         sample_rate_hz);
   }
 }
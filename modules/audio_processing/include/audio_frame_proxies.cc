@@ -26,8 +26,9 @@ int ProcessAudioFrame(AudioProcessing* ap, AudioFrame* frame) {
                              /*has_keyboard=*/false);
   RTC_DCHECK_EQ(frame->samples_per_channel(), input_config.num_frames());
 
-  int result = ap->ProcessStream(frame->data(), input_config, output_config,
-                                 frame->mutable_data());
+  int16_t* const data =
+      frame->mutable_data(frame->samples_per_channel_, frame->num_channels_);
+  int result = ap->ProcessStream(data, input_config, output_config, data);
 
   AudioProcessingStats stats = ap->GetStatistics();
 
@@ -62,8 +63,10 @@ int ProcessReverseAudioFrame(AudioProcessing* ap, AudioFrame* frame) {
   StreamConfig output_config(frame->sample_rate_hz_, frame->num_channels_,
                              /*has_keyboard=*/false);
 
-  int result = ap->ProcessReverseStream(frame->data(), input_config,
-                                        output_config, frame->mutable_data());
+  int16_t* const data =
+      frame->mutable_data(frame->samples_per_channel_, frame->num_channels_);
+  int result =
+      ap->ProcessReverseStream(data, input_config, output_config, data);
   return result;
 }
 
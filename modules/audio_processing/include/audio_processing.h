@@ -171,6 +171,14 @@ class RTC_EXPORT AudioProcessing : public rtc::RefCountInterface {
       // Allow multi-channel processing of capture audio when AEC3 is active
       // or a custom AEC is injected..
       bool multi_channel_capture = false;
+      // Process the capture audio without splitting it into frequency bands
+      // whenever the enabled submodules allow it. This avoids the cost, the
+      // delay and the distortion of the splitting filter, e.g., for music or
+      // high fidelity sessions. It only takes effect while the echo
+      // canceller, the noise suppressor, AGC1 and the voice detector are
+      // disabled and the high-pass filter, if enabled, is applied in the full
+      // band. AGC2 always processes the full band.
+      bool full_band_processing = false;
     } pipeline;
 
     // Enabled the pre-amplifier. It amplifies the capture signal
@@ -15,6 +15,12 @@
 
 #include "rtc_base/checks.h"
 
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace webrtc {
 
 namespace {
@@ -58,7 +64,31 @@ float LogApproximation(float x) {
 }
 
 void LogApproximation(rtc::ArrayView<const float> x, rtc::ArrayView<float> y) {
-  for (size_t k = 0; k < x.size(); ++k) {
+  RTC_DCHECK_EQ(x.size(), y.size());
+  // Same operations as FastLog2f() on four values at a time. Since x > 0, its
+  // bits read as a signed integer are the same as read as unsigned.
+  constexpr float kLogOf2 = 0.69314718056f;
+  size_t k = 0;
+#if defined(WEBRTC_HAS_NEON)
+  const float32x4_t kScale = vdupq_n_f32(1.1920929e-7f);
+  const float32x4_t kBias = vdupq_n_f32(126.942695f);
+  const float32x4_t kLog2 = vdupq_n_f32(kLogOf2);
+  for (; k + 4 <= x.size(); k += 4) {
+    float32x4_t out = vcvtq_f32_s32(vreinterpretq_s32_f32(vld1q_f32(&x[k])));
+    out = vsubq_f32(vmulq_f32(out, kScale), kBias);
+    vst1q_f32(&y[k], vmulq_f32(out, kLog2));
+  }
+#elif defined(__SSE2__)
+  const __m128 kScale = _mm_set1_ps(1.1920929e-7f);
+  const __m128 kBias = _mm_set1_ps(126.942695f);
+  const __m128 kLog2 = _mm_set1_ps(kLogOf2);
+  for (; k + 4 <= x.size(); k += 4) {
+    __m128 out = _mm_cvtepi32_ps(_mm_castps_si128(_mm_loadu_ps(&x[k])));
+    out = _mm_sub_ps(_mm_mul_ps(out, kScale), kBias);
+    _mm_storeu_ps(&y[k], _mm_mul_ps(out, kLog2));
+  }
+#endif
+  for (; k < x.size(); ++k) {
     y[k] = LogApproximation(x[k]);
   }
 }
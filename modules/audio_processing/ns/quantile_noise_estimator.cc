@@ -14,6 +14,12 @@
 
 #include "modules/audio_processing/ns/fast_math.h"
 
+#if defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_ARM64)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace webrtc {
 
 QuantileNoiseEstimator::QuantileNoiseEstimator() {
@@ -38,7 +44,94 @@ void QuantileNoiseEstimator::Estimate(
   for (int s = 0, k = 0; s < kSimult;
        ++s, k += static_cast<int>(kFftSizeBy2Plus1)) {
     const float one_by_counter_plus_1 = 1.f / (counter_[s] + 1.f);
-    for (int i = 0, j = k; i < static_cast<int>(kFftSizeBy2Plus1); ++i, ++j) {
+    constexpr float kWidth = 0.01f;
+    constexpr float kOneByWidthPlus2 = 1.f / (2.f * kWidth);
+    // The vectorized loops do the same operations as the scalar one below,
+    // which handles the remaining bins. Vector division is only available on
+    // ARM64.
+    int i = 0;
+#if defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_ARM64)
+    const float32x4_t kOne = vdupq_n_f32(1.f);
+    const float32x4_t k40 = vdupq_n_f32(40.f);
+    const float32x4_t kUpStep = vdupq_n_f32(0.25f);
+    const float32x4_t kDownStep = vdupq_n_f32(0.75f);
+    const float32x4_t kWidthV = vdupq_n_f32(kWidth);
+    const float32x4_t kOneByWidthPlus2V = vdupq_n_f32(kOneByWidthPlus2);
+    const float32x4_t counter = vdupq_n_f32(static_cast<float>(counter_[s]));
+    const float32x4_t one_by_counter_plus_1_v =
+        vdupq_n_f32(one_by_counter_plus_1);
+    for (; i + 4 <= static_cast<int>(kFftSizeBy2Plus1); i += 4) {
+      float* density = &density_[k + i];
+      float* log_quantile = &log_quantile_[k + i];
+      const float32x4_t log_spectrum_v = vld1q_f32(&log_spectrum[i]);
+      float32x4_t density_v = vld1q_f32(density);
+      float32x4_t log_quantile_v = vld1q_f32(log_quantile);
+
+      const float32x4_t delta = vbslq_f32(vcgtq_f32(density_v, kOne),
+                                          vdivq_f32(k40, density_v), k40);
+      const float32x4_t multiplier =
+          vmulq_f32(delta, one_by_counter_plus_1_v);
+      const float32x4_t quantile_up =
+          vaddq_f32(log_quantile_v, vmulq_f32(kUpStep, multiplier));
+      const float32x4_t quantile_down =
+          vsubq_f32(log_quantile_v, vmulq_f32(kDownStep, multiplier));
+      log_quantile_v = vbslq_f32(vcgtq_f32(log_spectrum_v, log_quantile_v),
+                                 quantile_up, quantile_down);
+      vst1q_f32(log_quantile, log_quantile_v);
+
+      const float32x4_t distance =
+          vabsq_f32(vsubq_f32(log_spectrum_v, log_quantile_v));
+      const float32x4_t density_update = vmulq_f32(
+          vaddq_f32(vmulq_f32(counter, density_v), kOneByWidthPlus2V),
+          one_by_counter_plus_1_v);
+      density_v = vbslq_f32(vcltq_f32(distance, kWidthV), density_update,
+                            density_v);
+      vst1q_f32(density, density_v);
+    }
+#elif defined(__SSE2__)
+    const __m128 kOne = _mm_set1_ps(1.f);
+    const __m128 k40 = _mm_set1_ps(40.f);
+    const __m128 kUpStep = _mm_set1_ps(0.25f);
+    const __m128 kDownStep = _mm_set1_ps(0.75f);
+    const __m128 kWidthV = _mm_set1_ps(kWidth);
+    const __m128 kOneByWidthPlus2V = _mm_set1_ps(kOneByWidthPlus2);
+    const __m128 kAbsMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 counter = _mm_set1_ps(static_cast<float>(counter_[s]));
+    const __m128 one_by_counter_plus_1_v = _mm_set1_ps(one_by_counter_plus_1);
+    for (; i + 4 <= static_cast<int>(kFftSizeBy2Plus1); i += 4) {
+      float* density = &density_[k + i];
+      float* log_quantile = &log_quantile_[k + i];
+      const __m128 log_spectrum_v = _mm_loadu_ps(&log_spectrum[i]);
+      __m128 density_v = _mm_loadu_ps(density);
+      __m128 log_quantile_v = _mm_loadu_ps(log_quantile);
+
+      const __m128 above_one = _mm_cmpgt_ps(density_v, kOne);
+      const __m128 delta =
+          _mm_or_ps(_mm_and_ps(above_one, _mm_div_ps(k40, density_v)),
+                    _mm_andnot_ps(above_one, k40));
+      const __m128 multiplier = _mm_mul_ps(delta, one_by_counter_plus_1_v);
+      const __m128 above_quantile =
+          _mm_cmpgt_ps(log_spectrum_v, log_quantile_v);
+      const __m128 quantile_up =
+          _mm_add_ps(log_quantile_v, _mm_mul_ps(kUpStep, multiplier));
+      const __m128 quantile_down =
+          _mm_sub_ps(log_quantile_v, _mm_mul_ps(kDownStep, multiplier));
+      log_quantile_v = _mm_or_ps(_mm_and_ps(above_quantile, quantile_up),
+                                 _mm_andnot_ps(above_quantile, quantile_down));
+      _mm_storeu_ps(log_quantile, log_quantile_v);
+
+      const __m128 distance =
+          _mm_and_ps(_mm_sub_ps(log_spectrum_v, log_quantile_v), kAbsMask);
+      const __m128 in_width = _mm_cmplt_ps(distance, kWidthV);
+      const __m128 density_update = _mm_mul_ps(
+          _mm_add_ps(_mm_mul_ps(counter, density_v), kOneByWidthPlus2V),
+          one_by_counter_plus_1_v);
+      density_v = _mm_or_ps(_mm_and_ps(in_width, density_update),
+                            _mm_andnot_ps(in_width, density_v));
+      _mm_storeu_ps(density, density_v);
+    }
+#endif
+    for (int j = k + i; i < static_cast<int>(kFftSizeBy2Plus1); ++i, ++j) {
       // Update log quantile estimate.
       const float delta = density_[j] > 1.f ? 40.f / density_[j] : 40.f;
 
@@ -50,8 +143,6 @@ void QuantileNoiseEstimator::Estimate(
       }
 
       // Update density estimate.
-      constexpr float kWidth = 0.01f;
-      constexpr float kOneByWidthPlus2 = 1.f / (2.f * kWidth);
       if (fabs(log_spectrum[i] - log_quantile_[j]) < kWidth) {
         density_[j] = (counter_[s] * density_[j] + kOneByWidthPlus2) *
                       one_by_counter_plus_1;
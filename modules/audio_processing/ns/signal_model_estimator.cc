@@ -10,8 +10,16 @@
 
 #include "modules/audio_processing/ns/signal_model_estimator.h"
 
+#include <array>
+
 #include "modules/audio_processing/ns/fast_math.h"
 
+#if defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_ARM64)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace webrtc {
 
 namespace {
@@ -77,8 +85,10 @@ void UpdateSpectralFlatness(
     }
   }
 
-  for (size_t i = 1; i < kFftSizeBy2Plus1; ++i) {
-    avg_spect_flatness_num += LogApproximation(signal_spectrum[i]);
+  std::array<float, kFftSizeBy2Plus1 - 1> log_spectrum;
+  LogApproximation(signal_spectrum.subview(1), log_spectrum);
+  for (float log_value : log_spectrum) {
+    avg_spect_flatness_num += log_value;
   }
 
   float avg_spect_flatness_denom = signal_spectral_sum - signal_spectrum[0];
@@ -100,12 +110,54 @@ void UpdateSpectralLrt(rtc::ArrayView<const float, kFftSizeBy2Plus1> prior_snr,
                        float* lrt) {
   RTC_DCHECK(lrt);
 
+  std::array<float, kFftSizeBy2Plus1> tmp1;
   for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
-    float tmp1 = 1.f + 2.f * prior_snr[i];
-    float tmp2 = 2.f * prior_snr[i] / (tmp1 + 0.0001f);
+    tmp1[i] = 1.f + 2.f * prior_snr[i];
+  }
+  std::array<float, kFftSizeBy2Plus1> log_tmp1;
+  LogApproximation(tmp1, log_tmp1);
+
+  // The vectorized loops do the same operations as the scalar one below, which
+  // handles the remaining bins. Vector division is only available on ARM64.
+  size_t i = 0;
+#if defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_ARM64)
+  const float32x4_t kOne = vdupq_n_f32(1.f);
+  const float32x4_t kTwo = vdupq_n_f32(2.f);
+  const float32x4_t kHalf = vdupq_n_f32(.5f);
+  const float32x4_t kEpsilon = vdupq_n_f32(0.0001f);
+  for (; i + 4 <= kFftSizeBy2Plus1; i += 4) {
+    const float32x4_t tmp2 =
+        vdivq_f32(vmulq_f32(kTwo, vld1q_f32(&prior_snr[i])),
+                  vaddq_f32(vld1q_f32(&tmp1[i]), kEpsilon));
+    const float32x4_t bessel_tmp =
+        vmulq_f32(vaddq_f32(vld1q_f32(&post_snr[i]), kOne), tmp2);
+    const float32x4_t avg = vld1q_f32(&avg_log_lrt[i]);
+    const float32x4_t update = vmulq_f32(
+        kHalf, vsubq_f32(vsubq_f32(bessel_tmp, vld1q_f32(&log_tmp1[i])), avg));
+    vst1q_f32(&avg_log_lrt[i], vaddq_f32(avg, update));
+  }
+#elif defined(__SSE2__)
+  const __m128 kOne = _mm_set1_ps(1.f);
+  const __m128 kTwo = _mm_set1_ps(2.f);
+  const __m128 kHalf = _mm_set1_ps(.5f);
+  const __m128 kEpsilon = _mm_set1_ps(0.0001f);
+  for (; i + 4 <= kFftSizeBy2Plus1; i += 4) {
+    const __m128 tmp2 =
+        _mm_div_ps(_mm_mul_ps(kTwo, _mm_loadu_ps(&prior_snr[i])),
+                   _mm_add_ps(_mm_loadu_ps(&tmp1[i]), kEpsilon));
+    const __m128 bessel_tmp =
+        _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(&post_snr[i]), kOne), tmp2);
+    const __m128 avg = _mm_loadu_ps(&avg_log_lrt[i]);
+    const __m128 update = _mm_mul_ps(
+        kHalf,
+        _mm_sub_ps(_mm_sub_ps(bessel_tmp, _mm_loadu_ps(&log_tmp1[i])), avg));
+    _mm_storeu_ps(&avg_log_lrt[i], _mm_add_ps(avg, update));
+  }
+#endif
+  for (; i < kFftSizeBy2Plus1; ++i) {
+    float tmp2 = 2.f * prior_snr[i] / (tmp1[i] + 0.0001f);
     float bessel_tmp = (post_snr[i] + 1.f) * tmp2;
-    avg_log_lrt[i] +=
-        .5f * (bessel_tmp - LogApproximation(tmp1) - avg_log_lrt[i]);
+    avg_log_lrt[i] += .5f * (bessel_tmp - log_tmp1[i] - avg_log_lrt[i]);
   }
 
   float log_lrt_time_avg_k_sum = 0.f;
@@ -18,6 +18,12 @@
 #include "modules/audio_processing/ns/fast_math.h"
 #include "rtc_base/checks.h"
 
+#if defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_ARM64)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace webrtc {
 
 WienerFilter::WienerFilter(const SuppressionParams& suppression_params)
@@ -33,7 +39,65 @@ void WienerFilter::Update(
     rtc::ArrayView<const float, kFftSizeBy2Plus1> prev_noise_spectrum,
     rtc::ArrayView<const float, kFftSizeBy2Plus1> parametric_noise_spectrum,
     rtc::ArrayView<const float, kFftSizeBy2Plus1> signal_spectrum) {
-  for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
+  // The vectorized loops do the same operations as the scalar one below, which
+  // handles the remaining bins. Vector division is only available on ARM64.
+  size_t i = 0;
+#if defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_ARM64)
+  const float32x4_t kOne = vdupq_n_f32(1.f);
+  const float32x4_t kEpsilon = vdupq_n_f32(0.0001f);
+  const float32x4_t kPrevWeight = vdupq_n_f32(0.98f);
+  const float32x4_t kCurrentWeight = vdupq_n_f32(1.f - 0.98f);
+  const float32x4_t kOverSubtraction =
+      vdupq_n_f32(suppression_params_.over_subtraction_factor);
+  const float32x4_t kMinGain =
+      vdupq_n_f32(suppression_params_.minimum_attenuating_gain);
+  for (; i + 4 <= kFftSizeBy2Plus1; i += 4) {
+    const float32x4_t noise = vld1q_f32(&noise_spectrum[i]);
+    const float32x4_t signal = vld1q_f32(&signal_spectrum[i]);
+    const float32x4_t prev_tsa = vmulq_f32(
+        vdivq_f32(vld1q_f32(&spectrum_prev_process_[i]),
+                  vaddq_f32(vld1q_f32(&prev_noise_spectrum[i]), kEpsilon)),
+        vld1q_f32(&filter_[i]));
+    const float32x4_t current_tsa = vreinterpretq_f32_u32(vandq_u32(
+        vcgtq_f32(signal, noise),
+        vreinterpretq_u32_f32(vsubq_f32(
+            vdivq_f32(signal, vaddq_f32(noise, kEpsilon)), kOne))));
+    const float32x4_t snr_prior =
+        vaddq_f32(vmulq_f32(kPrevWeight, prev_tsa),
+                  vmulq_f32(kCurrentWeight, current_tsa));
+    const float32x4_t filter =
+        vdivq_f32(snr_prior, vaddq_f32(kOverSubtraction, snr_prior));
+    vst1q_f32(&filter_[i], vmaxq_f32(vminq_f32(filter, kOne), kMinGain));
+  }
+#elif defined(__SSE2__)
+  const __m128 kOne = _mm_set1_ps(1.f);
+  const __m128 kEpsilon = _mm_set1_ps(0.0001f);
+  const __m128 kPrevWeight = _mm_set1_ps(0.98f);
+  const __m128 kCurrentWeight = _mm_set1_ps(1.f - 0.98f);
+  const __m128 kOverSubtraction =
+      _mm_set1_ps(suppression_params_.over_subtraction_factor);
+  const __m128 kMinGain =
+      _mm_set1_ps(suppression_params_.minimum_attenuating_gain);
+  for (; i + 4 <= kFftSizeBy2Plus1; i += 4) {
+    const __m128 noise = _mm_loadu_ps(&noise_spectrum[i]);
+    const __m128 signal = _mm_loadu_ps(&signal_spectrum[i]);
+    const __m128 prev_tsa = _mm_mul_ps(
+        _mm_div_ps(_mm_loadu_ps(&spectrum_prev_process_[i]),
+                   _mm_add_ps(_mm_loadu_ps(&prev_noise_spectrum[i]), kEpsilon)),
+        _mm_loadu_ps(&filter_[i]));
+    const __m128 current_tsa = _mm_and_ps(
+        _mm_cmpgt_ps(signal, noise),
+        _mm_sub_ps(_mm_div_ps(signal, _mm_add_ps(noise, kEpsilon)), kOne));
+    const __m128 snr_prior =
+        _mm_add_ps(_mm_mul_ps(kPrevWeight, prev_tsa),
+                   _mm_mul_ps(kCurrentWeight, current_tsa));
+    const __m128 filter =
+        _mm_div_ps(snr_prior, _mm_add_ps(kOverSubtraction, snr_prior));
+    _mm_storeu_ps(&filter_[i],
+                  _mm_max_ps(_mm_min_ps(filter, kOne), kMinGain));
+  }
+#endif
+  for (; i < kFftSizeBy2Plus1; ++i) {
     // Previous estimate based on previous frame with gain filter.
     float prev_tsa = spectrum_prev_process_[i] /
                      (prev_noise_spectrum[i] + 0.0001f) * filter_[i];
@@ -16,6 +16,7 @@
 #include <cmath>
 
 #include "common_audio/channel_buffer.h"
+#include "modules/audio_processing/test/bitexactness_tools.h"
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -24,6 +25,16 @@ namespace {
 const size_t kSamplesPer16kHzChannel = 160;
 const size_t kSamplesPer48kHzChannel = 480;
 
+// Fills `data` with deterministic pseudo-random samples in the S16 range.
+void FillWithPseudoRandomSamples(uint32_t* seed, ChannelBuffer<float>* data) {
+  for (size_t ch = 0; ch < data->num_channels(); ++ch) {
+    for (size_t k = 0; k < data->num_frames(); ++k) {
+      *seed = *seed * 1103515245u + 12345u;
+      data->channels()[ch][k] = static_cast<int16_t>(*seed >> 16);
+    }
+  }
+}
+
 }  // namespace
 
 // Generates a signal from presence or absence of sine waves of different
@@ -100,4 +111,62 @@ TEST(SplittingFilterTest, SplitsIntoThreeBandsAndReconstructs) {
   }
 }
 
+// Verifies the three-band analysis and synthesis against reference values
+// computed with the scalar implementation, so that the vectorized versions
+// stay bit-exact with it.
+TEST(SplittingFilterTest, ThreeBandsBitExactness) {
+  constexpr int kChannels = 2;
+  constexpr size_t kNumBands = 3;
+  constexpr size_t kChunks = 4;
+  // Offsets past the start of the frame, where the filters only use the
+  // samples of the current frame.
+  constexpr size_t kBandOffset = 60;
+  constexpr size_t kFullBandOffset = 3 * kBandOffset;
+  constexpr size_t kNumSamplesToVerify = 8;
+  constexpr float kElementErrorBound = 1e-3f;
+  SplittingFilter splitting_filter(kChannels, kNumBands,
+                                   kSamplesPer48kHzChannel);
+  ChannelBuffer<float> data(kSamplesPer48kHzChannel, kChannels, kNumBands);
+  ChannelBuffer<float> bands(kSamplesPer48kHzChannel, kChannels, kNumBands);
+  uint32_t seed = 42;
+  for (size_t i = 0; i < kChunks; ++i) {
+    FillWithPseudoRandomSamples(&seed, &data);
+    splitting_filter.Analysis(&data, &bands);
+    splitting_filter.Synthesis(&bands, &data);
+  }
+
+  const float kBandReference[kChannels][kNumBands][kNumSamplesToVerify] = {
+      {{3300.809082f, 20294.132812f, 7646.948242f, 18730.792969f, 8089.942383f,
+        -22367.835938f, -486.769531f, -10119.498047f},
+       {1016.548340f, 2482.656738f, 7450.573242f, -2029.928955f, 8470.929688f,
+        6223.226562f, 9499.607422f, 20018.652344f},
+       {21331.781250f, -12631.420898f, 5244.891602f, 13568.242188f,
+        3681.811523f, 449.231934f, 19776.746094f, 8651.503906f}},
+      {{-14152.242188f, -10942.808594f, 6314.559570f, -15684.704102f,
+        -4526.363770f, 1806.503174f, 6294.137207f, -8080.113770f},
+       {-4560.372559f, 2749.701660f, 8703.398438f, -3514.027344f,
+        -10420.095703f, -11635.781250f, 14379.597656f, -5734.143066f},
+       {5511.141113f, -8582.024414f, 8582.510742f, 3673.871094f, 3294.589844f,
+        -137.402832f, -2248.887695f, -7900.842285f}}};
+  const float kFullBandReference[kChannels][kNumSamplesToVerify] = {
+      {-16340.259766f, 9481.386719f, -6829.789551f, -25617.673828f,
+       11539.526367f, 10432.710938f, -22677.199219f, 35002.406250f},
+      {-14743.747070f, -11560.583984f, -30896.921875f, -11758.080078f,
+       -13376.456055f, 954.818970f, -27083.576172f, 3411.651367f}};
+  for (int ch = 0; ch < kChannels; ++ch) {
+    for (size_t band = 0; band < kNumBands; ++band) {
+      EXPECT_TRUE(test::VerifyArray(
+          kBandReference[ch][band],
+          rtc::ArrayView<const float>(&bands.channels(band)[ch][kBandOffset],
+                                      kNumSamplesToVerify),
+          kElementErrorBound));
+    }
+    EXPECT_TRUE(test::VerifyArray(
+        kFullBandReference[ch],
+        rtc::ArrayView<const float>(&data.channels()[ch][kFullBandOffset],
+                                    kNumSamplesToVerify),
+        kElementErrorBound));
+  }
+}
+
 }  // namespace webrtc
@@ -483,6 +483,10 @@ void AudioProcessingSimulator::ConfigureAudioProcessor() {
         *settings_.multi_channel_capture;
   }
 
+  if (settings_.full_band_processing) {
+    apm_config.pipeline.full_band_processing = *settings_.full_band_processing;
+  }
+
   if (settings_.use_agc2) {
     apm_config.gain_controller2.enabled = *settings_.use_agc2;
     if (settings_.agc2_fixed_gain_db) {
@@ -125,6 +125,7 @@ struct SimulationSettings {
   bool simulate_mic_gain = false;
   absl::optional<bool> multi_channel_render;
   absl::optional<bool> multi_channel_capture;
+  absl::optional<bool> full_band_processing;
   absl::optional<int> simulated_mic_kind;
   absl::optional<int> frame_for_sending_capture_output_used_false;
   absl::optional<int> frame_for_sending_capture_output_used_true;
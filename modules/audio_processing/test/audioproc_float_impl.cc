@@ -218,6 +218,11 @@ ABSL_FLAG(int,
           kParameterNotSpecifiedValue,
           "Activate (1) or deactivate (0) multi-channel capture processing in "
           "APM pipeline");
+ABSL_FLAG(int,
+          full_band_processing,
+          kParameterNotSpecifiedValue,
+          "Activate (1) or deactivate (0) processing the capture audio without "
+          "band splitting when the enabled submodules allow it");
 ABSL_FLAG(int,
           simulated_mic_kind,
           kParameterNotSpecifiedValue,
@@ -461,6 +466,8 @@ SimulationSettings CreateSettings() {
                       &settings.multi_channel_render);
   SetSettingIfFlagSet(absl::GetFlag(FLAGS_multi_channel_capture),
                       &settings.multi_channel_capture);
+  SetSettingIfFlagSet(absl::GetFlag(FLAGS_full_band_processing),
+                      &settings.full_band_processing);
   settings.simulate_mic_gain = absl::GetFlag(FLAGS_simulate_mic_gain);
   SetSettingIfSpecified(absl::GetFlag(FLAGS_simulated_mic_kind),
                         &settings.simulated_mic_kind);
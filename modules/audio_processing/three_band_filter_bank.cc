@@ -36,6 +36,12 @@
 
 #include "rtc_base/checks.h"
 
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace webrtc {
 namespace {
 
@@ -132,8 +138,41 @@ void FilterCore(
     }
   }
 
-  for (int k = kFilterSize * kStride, shift = kFilterSize * kStride - in_shift;
-       k < ThreeBandFilterBank::kSplitBandSize; ++k, ++shift) {
+  // From here on only the input is used. The vectorized loops compute four
+  // outputs at a time with the same operations as the scalar loop below.
+  int k = kFilterSize * kStride;
+  int shift = kFilterSize * kStride - in_shift;
+  static_assert(kFilterSize == 4, "The vectorized loops assume four taps");
+#if defined(WEBRTC_HAS_NEON)
+  const float32x4_t f0 = vdupq_n_f32(filter[0]);
+  const float32x4_t f1 = vdupq_n_f32(filter[1]);
+  const float32x4_t f2 = vdupq_n_f32(filter[2]);
+  const float32x4_t f3 = vdupq_n_f32(filter[3]);
+  for (; k + 4 <= ThreeBandFilterBank::kSplitBandSize; k += 4, shift += 4) {
+    const float* x = &in[shift];
+    float32x4_t acc = vdupq_n_f32(0.f);
+    acc = vaddq_f32(acc, vmulq_f32(vld1q_f32(x), f0));
+    acc = vaddq_f32(acc, vmulq_f32(vld1q_f32(x - kStride), f1));
+    acc = vaddq_f32(acc, vmulq_f32(vld1q_f32(x - 2 * kStride), f2));
+    acc = vaddq_f32(acc, vmulq_f32(vld1q_f32(x - 3 * kStride), f3));
+    vst1q_f32(&out[k], acc);
+  }
+#elif defined(__SSE2__)
+  const __m128 f0 = _mm_set1_ps(filter[0]);
+  const __m128 f1 = _mm_set1_ps(filter[1]);
+  const __m128 f2 = _mm_set1_ps(filter[2]);
+  const __m128 f3 = _mm_set1_ps(filter[3]);
+  for (; k + 4 <= ThreeBandFilterBank::kSplitBandSize; k += 4, shift += 4) {
+    const float* x = &in[shift];
+    __m128 acc = _mm_setzero_ps();
+    acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(x), f0));
+    acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(x - kStride), f1));
+    acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(x - 2 * kStride), f2));
+    acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(x - 3 * kStride), f3));
+    _mm_storeu_ps(&out[k], acc);
+  }
+#endif
+  for (; k < ThreeBandFilterBank::kSplitBandSize; ++k, ++shift) {
     for (int i = 0, j = shift; i < kFilterSize; ++i, j -= kStride) {
       out[k] += in[j] * filter[i];
     }
@@ -144,6 +183,30 @@ void FilterCore(
             in.end(), state.begin());
 }
 
+// Adds `gain` * `x` to `y`.
+void ScaleAndAccumulate(
+    float gain,
+    rtc::ArrayView<const float, ThreeBandFilterBank::kSplitBandSize> x,
+    rtc::ArrayView<float, ThreeBandFilterBank::kSplitBandSize> y) {
+  int n = 0;
+#if defined(WEBRTC_HAS_NEON)
+  const float32x4_t g = vdupq_n_f32(gain);
+  for (; n + 4 <= ThreeBandFilterBank::kSplitBandSize; n += 4) {
+    vst1q_f32(&y[n],
+              vaddq_f32(vld1q_f32(&y[n]), vmulq_f32(g, vld1q_f32(&x[n]))));
+  }
+#elif defined(__SSE2__)
+  const __m128 g = _mm_set1_ps(gain);
+  for (; n + 4 <= ThreeBandFilterBank::kSplitBandSize; n += 4) {
+    _mm_storeu_ps(&y[n], _mm_add_ps(_mm_loadu_ps(&y[n]),
+                                    _mm_mul_ps(g, _mm_loadu_ps(&x[n]))));
+  }
+#endif
+  for (; n < ThreeBandFilterBank::kSplitBandSize; ++n) {
+    y[n] += gain * x[n];
+  }
+}
+
 }  // namespace
 
 // Because the low-pass filter prototype has half bandwidth it is possible to
@@ -211,10 +274,10 @@ void ThreeBandFilterBank::Analysis(
 
       // Band and modulate the output.
       for (int band = 0; band < ThreeBandFilterBank::kNumBands; ++band) {
-        float* out_band = out[band].data();
-        for (int n = 0; n < kSplitBandSize; ++n) {
-          out_band[n] += dct_modulation[band] * out_subsampled[n];
-        }
+        ScaleAndAccumulate(
+            dct_modulation[band], out_subsampled,
+            rtc::ArrayView<float, kSplitBandSize>(out[band].data(),
+                                                  kSplitBandSize));
       }
     }
   }
@@ -255,10 +318,11 @@ void ThreeBandFilterBank::Synthesis(
       std::fill(in_subsampled.begin(), in_subsampled.end(), 0.f);
       for (int band = 0; band < ThreeBandFilterBank::kNumBands; ++band) {
         RTC_DCHECK_EQ(in[band].size(), kSplitBandSize);
-        const float* in_band = in[band].data();
-        for (int n = 0; n < kSplitBandSize; ++n) {
-          in_subsampled[n] += dct_modulation[band] * in_band[n];
-        }
+        ScaleAndAccumulate(
+            dct_modulation[band],
+            rtc::ArrayView<const float, kSplitBandSize>(in[band].data(),
+                                                        kSplitBandSize),
+            in_subsampled);
       }
 
       // Filter.
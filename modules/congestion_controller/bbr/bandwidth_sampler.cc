@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/bbr/bandwidth_sampler.h"
+
+#include <algorithm>
+
+namespace webrtc {
+namespace bbr {
+
+BandwidthSampler::BandwidthSampler() = default;
+
+BandwidthSampler::~BandwidthSampler() = default;
+
+void BandwidthSampler::OnPacketSent(const SentPacket& packet,
+                                    bool is_app_limited) {
+  SendState& state = in_flight_[packet.sequence_number];
+  state.send_time = packet.send_time;
+  state.size = packet.size;
+  state.is_app_limited = is_app_limited;
+  state.delivered = delivered_;
+  state.delivered_time = delivered_time_;
+  state.delivered_send_time = delivered_send_time_;
+}
+
+absl::optional<BandwidthSample> BandwidthSampler::OnPacketReceived(
+    const PacketResult& packet) {
+  auto it = in_flight_.find(packet.sent_packet.sequence_number);
+  if (it == in_flight_.end())
+    return absl::nullopt;
+  const SendState state = it->second;
+  in_flight_.erase(it);
+
+  delivered_ += state.size;
+  // Feedback may reorder packets that were reordered by the network; the
+  // last delivered packet is the one received last.
+  if (packet.receive_time >= delivered_time_) {
+    delivered_time_ = packet.receive_time;
+    delivered_send_time_ = state.send_time;
+  }
+  if (state.delivered_time.IsInfinite())
+    return absl::nullopt;
+
+  TimeDelta send_interval = state.send_time - state.delivered_send_time;
+  TimeDelta receive_interval = packet.receive_time - state.delivered_time;
+  TimeDelta interval = std::max(send_interval, receive_interval);
+  if (interval <= TimeDelta::Zero())
+    return absl::nullopt;
+
+  BandwidthSample sample;
+  sample.delivery_rate = (delivered_ - state.delivered) / interval;
+  sample.is_app_limited = state.is_app_limited;
+  sample.prior_delivered = state.delivered;
+  return sample;
+}
+
+void BandwidthSampler::OnPacketLost(const PacketResult& packet) {
+  auto it = in_flight_.find(packet.sent_packet.sequence_number);
+  if (it == in_flight_.end())
+    return;
+  lost_ += it->second.size;
+  in_flight_.erase(it);
+}
+
+void BandwidthSampler::RemovePacketsSentBefore(Timestamp send_time) {
+  while (!in_flight_.empty() &&
+         in_flight_.begin()->second.send_time < send_time) {
+    in_flight_.erase(in_flight_.begin());
+  }
+}
+
+void BandwidthSampler::Reset() {
+  in_flight_.clear();
+  delivered_ = DataSize::Zero();
+  lost_ = DataSize::Zero();
+  delivered_time_ = Timestamp::MinusInfinity();
+  delivered_send_time_ = Timestamp::MinusInfinity();
+}
+
+}  // namespace bbr
+}  // namespace webrtc
@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_CONGESTION_CONTROLLER_BBR_BANDWIDTH_SAMPLER_H_
+#define MODULES_CONGESTION_CONTROLLER_BBR_BANDWIDTH_SAMPLER_H_
+
+#include <stdint.h>
+
+#include <map>
+
+#include "absl/types/optional.h"
+#include "api/transport/network_types.h"
+#include "api/units/data_rate.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+
+namespace webrtc {
+namespace bbr {
+
+struct BandwidthSample {
+  // The rate at which data was delivered while the packet was in flight.
+  DataRate delivery_rate = DataRate::Zero();
+  // True if the sender was application limited when the packet was sent, in
+  // which case `delivery_rate` may underestimate the bandwidth.
+  bool is_app_limited = false;
+  // The data delivered before the packet was sent, used to count round trips.
+  DataSize prior_delivered = DataSize::Zero();
+};
+
+// Estimates the delivery rate of the path from transport feedback, as in
+// "Delivery Rate Estimation" (draft-cheng-iccrg-delivery-rate-estimation).
+// The state of delivery is recorded when each packet is sent, and the rate
+// is the data delivered between the send and the acknowledgement of the
+// packet, over the longest of the send and the receive intervals. The receive
+// interval is measured with the receive times of the feedback rather than
+// with the feedback time, since transport feedback acknowledges packets in
+// batches.
+class BandwidthSampler {
+ public:
+  BandwidthSampler();
+  ~BandwidthSampler();
+
+  void OnPacketSent(const SentPacket& packet, bool is_app_limited);
+  // Returns the sample for a received packet. Returns nullopt if the packet
+  // was not sent since the last reset, or if it was sent before any packet
+  // was delivered, as the receive interval is not known then.
+  absl::optional<BandwidthSample> OnPacketReceived(const PacketResult& packet);
+  void OnPacketLost(const PacketResult& packet);
+  // Forgets packets sent before `send_time` that will not get feedback.
+  void RemovePacketsSentBefore(Timestamp send_time);
+  void Reset();
+
+  DataSize total_delivered() const { return delivered_; }
+  DataSize total_lost() const { return lost_; }
+
+ private:
+  struct SendState {
+    Timestamp send_time = Timestamp::MinusInfinity();
+    DataSize size = DataSize::Zero();
+    bool is_app_limited = false;
+    // The delivery state when the packet was sent.
+    DataSize delivered = DataSize::Zero();
+    Timestamp delivered_time = Timestamp::MinusInfinity();
+    Timestamp delivered_send_time = Timestamp::MinusInfinity();
+  };
+
+  // Packets sent and not acknowledged, by sequence number.
+  std::map<int64_t, SendState> in_flight_;
+  DataSize delivered_ = DataSize::Zero();
+  DataSize lost_ = DataSize::Zero();
+  // The receive time and the send time of the last packet delivered. The
+  // receive time is in the clock of the receiver.
+  Timestamp delivered_time_ = Timestamp::MinusInfinity();
+  Timestamp delivered_send_time_ = Timestamp::MinusInfinity();
+};
+
+}  // namespace bbr
+}  // namespace webrtc
+
+#endif  // MODULES_CONGESTION_CONTROLLER_BBR_BANDWIDTH_SAMPLER_H_
@@ -0,0 +1,117 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/bbr/bandwidth_sampler.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace bbr {
+namespace {
+
+constexpr DataSize kPacketSize = DataSize::Bytes(1000);
+constexpr TimeDelta kOneWayDelay = TimeDelta::Millis(50);
+
+SentPacket CreateSentPacket(int64_t sequence_number, Timestamp send_time) {
+  SentPacket packet;
+  packet.sequence_number = sequence_number;
+  packet.send_time = send_time;
+  packet.size = kPacketSize;
+  return packet;
+}
+
+PacketResult CreatePacketResult(const SentPacket& sent_packet,
+                                Timestamp receive_time) {
+  PacketResult packet;
+  packet.sent_packet = sent_packet;
+  packet.receive_time = receive_time;
+  return packet;
+}
+
+}  // namespace
+
+TEST(BandwidthSamplerTest, MeasuresRateOfSteadyFlow) {
+  BandwidthSampler sampler;
+  // 1000 bytes every 10 ms is 800 kbps.
+  constexpr TimeDelta kInterval = TimeDelta::Millis(10);
+  Timestamp now = Timestamp::Seconds(1);
+  absl::optional<BandwidthSample> sample;
+  for (int64_t i = 0; i < 100; ++i) {
+    SentPacket sent = CreateSentPacket(i, now);
+    sampler.OnPacketSent(sent, /*is_app_limited=*/false);
+    if (i >= 5) {
+      SentPacket received = CreateSentPacket(i - 5, now - 5 * kInterval);
+      sample = sampler.OnPacketReceived(
+          CreatePacketResult(received, received.send_time + kOneWayDelay));
+    }
+    now += kInterval;
+  }
+  ASSERT_TRUE(sample);
+  EXPECT_EQ(sample->delivery_rate, DataRate::KilobitsPerSec(800));
+  EXPECT_FALSE(sample->is_app_limited);
+  EXPECT_EQ(sampler.total_delivered(), 95 * kPacketSize);
+}
+
+TEST(BandwidthSamplerTest, UsesReceiveIntervalOfBottleneck) {
+  BandwidthSampler sampler;
+  Timestamp now = Timestamp::Seconds(1);
+  // A burst received at 1000 bytes per 20 ms, that is 400 kbps.
+  SentPacket first = CreateSentPacket(0, now);
+  sampler.OnPacketSent(first, false);
+  EXPECT_FALSE(
+      sampler.OnPacketReceived(CreatePacketResult(first, now + kOneWayDelay)));
+  Timestamp receive_time = now + kOneWayDelay;
+  now += kOneWayDelay * 2;
+  for (int64_t i = 1; i <= 10; ++i)
+    sampler.OnPacketSent(CreateSentPacket(i, now), false);
+  absl::optional<BandwidthSample> sample;
+  for (int64_t i = 1; i <= 10; ++i) {
+    receive_time += TimeDelta::Millis(20);
+    sample = sampler.OnPacketReceived(
+        CreatePacketResult(CreateSentPacket(i, now), receive_time));
+  }
+  ASSERT_TRUE(sample);
+  EXPECT_EQ(sample->delivery_rate,
+            10 * kPacketSize / (receive_time - (now - kOneWayDelay)));
+}
+
+TEST(BandwidthSamplerTest, ForgetsLostAndOldPackets) {
+  BandwidthSampler sampler;
+  Timestamp now = Timestamp::Seconds(1);
+  SentPacket lost = CreateSentPacket(0, now);
+  SentPacket old = CreateSentPacket(1, now);
+  sampler.OnPacketSent(lost, false);
+  sampler.OnPacketSent(old, false);
+  sampler.OnPacketLost(CreatePacketResult(lost, Timestamp::PlusInfinity()));
+  EXPECT_EQ(sampler.total_lost(), kPacketSize);
+  sampler.RemovePacketsSentBefore(now + TimeDelta::Millis(1));
+  EXPECT_FALSE(
+      sampler.OnPacketReceived(CreatePacketResult(old, now + kOneWayDelay)));
+  EXPECT_EQ(sampler.total_delivered(), DataSize::Zero());
+}
+
+TEST(BandwidthSamplerTest, MarksAppLimitedSamples) {
+  BandwidthSampler sampler;
+  Timestamp now = Timestamp::Seconds(1);
+  SentPacket first = CreateSentPacket(0, now);
+  sampler.OnPacketSent(first, false);
+  sampler.OnPacketReceived(CreatePacketResult(first, now + kOneWayDelay));
+  now += TimeDelta::Millis(100);
+  SentPacket second = CreateSentPacket(1, now);
+  sampler.OnPacketSent(second, /*is_app_limited=*/true);
+  absl::optional<BandwidthSample> sample =
+      sampler.OnPacketReceived(CreatePacketResult(second, now + kOneWayDelay));
+  ASSERT_TRUE(sample);
+  EXPECT_TRUE(sample->is_app_limited);
+  EXPECT_EQ(sample->prior_delivered, kPacketSize);
+}
+
+}  // namespace bbr
+}  // namespace webrtc
@@ -0,0 +1,433 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/bbr/bbr_network_controller.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace bbr {
+namespace {
+
+constexpr DataRate kDefaultStartRate = DataRate::KilobitsPerSec(300);
+// Used for the bandwidth delay product until the RTT is measured.
+constexpr TimeDelta kInitialRtt = TimeDelta::Millis(100);
+constexpr DataSize kMinCongestionWindow = DataSize::Bytes(4 * 1500);
+// Startup ends when the bandwidth grows less than this factor in
+// kStartupRoundsWithoutGrowth consecutive round trips.
+constexpr double kStartupGrowthTarget = 1.25;
+constexpr int kStartupRoundsWithoutGrowth = 3;
+// Phases of the bandwidth probing cycle, each lasting one min RTT, the first
+// probes up, the second drains and the rest cruise at the bandwidth.
+constexpr int kCycleLength = 8;
+// Data that was received by the remote but is not yet acknowledged is still
+// counted as in flight, so the congestion window must make room for the
+// data of the longest feedback interval seen recently.
+constexpr TimeDelta kMaxFeedbackInterval = TimeDelta::Millis(250);
+constexpr double kFeedbackIntervalDecay = 0.95;
+
+BbrControllerConfig ParseConfig(const WebRtcKeyValueConfig* key_value_config) {
+  BbrControllerConfig config;
+  config.Parser()->Parse(key_value_config->Lookup("WebRTC-Bwe-BbrSettings"));
+  return config;
+}
+
+}  // namespace
+
+std::unique_ptr<StructParametersParser> BbrControllerConfig::Parser() {
+  return StructParametersParser::Create(
+      "startup_gain", &startup_gain,                        //
+      "probe_up_gain", &probe_up_gain,                      //
+      "probe_down_gain", &probe_down_gain,                  //
+      "cwnd_gain", &cwnd_gain,                              //
+      "bandwidth_window_rounds", &bandwidth_window_rounds,  //
+      "min_rtt_window", &min_rtt_window,                    //
+      "probe_rtt_duration", &probe_rtt_duration,            //
+      "probe_rtt_gain", &probe_rtt_gain,                    //
+      "loss_threshold", &loss_threshold,                    //
+      "loss_beta", &loss_beta,                              //
+      "probe_with_padding", &probe_with_padding);
+}
+
+BbrNetworkController::BbrNetworkController(NetworkControllerConfig config)
+    : key_value_config_(config.key_value_config ? config.key_value_config
+                                                : &trial_based_config_),
+      config_(ParseConfig(key_value_config_)),
+      alr_detector_(key_value_config_, config.event_log),
+      max_bandwidth_filter_(config_.bandwidth_window_rounds),
+      random_(/*seed=*/0x8bb2),
+      initial_rate_(kDefaultStartRate) {
+  RTC_DCHECK_GT(config_.startup_gain, 1.0);
+  UpdateConstraints(config.constraints);
+  alr_detector_.SetEstimatedBitrate(bandwidth_estimate().bps());
+}
+
+BbrNetworkController::~BbrNetworkController() = default;
+
+DataRate BbrNetworkController::bandwidth_estimate() const {
+  DataRate bandwidth = max_bandwidth_filter_.Get().value_or(initial_rate_);
+  // The first samples are limited by the rate of the encoders ramping up.
+  if (!full_bandwidth_reached_)
+    bandwidth = std::max(bandwidth, initial_rate_);
+  bandwidth = std::min(bandwidth, bandwidth_lo_);
+  return std::max(std::min(bandwidth, max_rate_), min_rate_);
+}
+
+TimeDelta BbrNetworkController::min_rtt() const {
+  return min_rtt_.IsFinite() ? min_rtt_ : kInitialRtt;
+}
+
+NetworkControlUpdate BbrNetworkController::OnNetworkAvailability(
+    NetworkAvailability msg) {
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate BbrNetworkController::OnNetworkRouteChange(
+    NetworkRouteChange msg) {
+  Reset(msg.constraints);
+  return CreateRateUpdate(msg.at_time);
+}
+
+NetworkControlUpdate BbrNetworkController::OnProcessInterval(
+    ProcessInterval msg) {
+  if (!first_update_sent_) {
+    first_update_sent_ = true;
+    return CreateRateUpdate(msg.at_time);
+  }
+  // ProbeRTT must end on time even if feedback stops as the data in flight
+  // is reduced.
+  if (mode_ == Mode::kProbeRtt && msg.at_time >= probe_rtt_done_time_) {
+    UpdateMode(msg.at_time);
+    return CreateRateUpdate(msg.at_time);
+  }
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate BbrNetworkController::OnRemoteBitrateReport(
+    RemoteBitrateReport msg) {
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate BbrNetworkController::OnRoundTripTimeUpdate(
+    RoundTripTimeUpdate msg) {
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate BbrNetworkController::OnSentPacket(SentPacket msg) {
+  alr_detector_.OnBytesSent(msg.size.bytes(), msg.send_time.ms());
+  sampler_.OnPacketSent(msg, IsAppLimited());
+  data_in_flight_ = msg.data_in_flight;
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate BbrNetworkController::OnReceivedPacket(
+    ReceivedPacket msg) {
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate BbrNetworkController::OnStreamsConfig(StreamsConfig msg) {
+  if (msg.max_total_allocated_bitrate)
+    max_allocated_rate_ = *msg.max_total_allocated_bitrate;
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate BbrNetworkController::OnTargetRateConstraints(
+    TargetRateConstraints msg) {
+  UpdateConstraints(msg);
+  return CreateRateUpdate(msg.at_time);
+}
+
+NetworkControlUpdate BbrNetworkController::OnTransportLossReport(
+    TransportLossReport msg) {
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate BbrNetworkController::OnTransportPacketsFeedback(
+    TransportPacketsFeedback msg) {
+  if (msg.packet_feedbacks.empty())
+    return NetworkControlUpdate();
+  const Timestamp at_time = msg.feedback_time;
+  if (last_feedback_time_.IsFinite()) {
+    TimeDelta interval =
+        std::min(at_time - last_feedback_time_, kMaxFeedbackInterval);
+    feedback_interval_ =
+        std::max(interval, feedback_interval_ * kFeedbackIntervalDecay);
+  }
+  last_feedback_time_ = at_time;
+  data_in_flight_ = msg.data_in_flight;
+
+  for (const PacketResult& packet : msg.LostWithSendInfo())
+    sampler_.OnPacketLost(packet);
+
+  TimeDelta min_feedback_rtt = TimeDelta::PlusInfinity();
+  for (const PacketResult& packet : msg.SortedByReceiveTime()) {
+    min_feedback_rtt =
+        std::min(min_feedback_rtt, at_time - packet.sent_packet.send_time);
+    absl::optional<BandwidthSample> sample = sampler_.OnPacketReceived(packet);
+    if (!sample)
+      continue;
+    UpdateRound(*sample);
+    round_max_rate_ = std::max(round_max_rate_, sample->delivery_rate);
+    // Application limited samples only tell that there is at least that much
+    // bandwidth.
+    absl::optional<DataRate> max_bandwidth = max_bandwidth_filter_.Get();
+    if (!sample->is_app_limited || !max_bandwidth ||
+        sample->delivery_rate >= *max_bandwidth) {
+      max_bandwidth_filter_.Update(sample->delivery_rate, round_count_);
+    }
+  }
+  // Packets sent before the first unacknowledged one won't get feedback.
+  if (msg.first_unacked_send_time.IsFinite())
+    sampler_.RemovePacketsSentBefore(msg.first_unacked_send_time);
+
+  if (min_feedback_rtt.IsFinite())
+    UpdateMinRtt(min_feedback_rtt, at_time);
+  UpdateMode(at_time);
+  return CreateRateUpdate(at_time);
+}
+
+NetworkControlUpdate BbrNetworkController::OnNetworkStateEstimate(
+    NetworkStateEstimate msg) {
+  return NetworkControlUpdate();
+}
+
+void BbrNetworkController::Reset(const TargetRateConstraints& constraints) {
+  sampler_.Reset();
+  max_bandwidth_filter_.Reset();
+  bandwidth_lo_ = DataRate::PlusInfinity();
+  mode_ = Mode::kStartup;
+  full_bandwidth_reached_ = false;
+  full_bandwidth_ = DataRate::Zero();
+  rounds_without_growth_ = 0;
+  round_count_ = 0;
+  next_round_delivered_ = DataSize::Zero();
+  round_max_rate_ = DataRate::Zero();
+  round_start_lost_ = DataSize::Zero();
+  round_start_delivered_ = DataSize::Zero();
+  round_loss_ratio_ = 0;
+  min_rtt_ = TimeDelta::PlusInfinity();
+  min_rtt_time_ = Timestamp::MinusInfinity();
+  min_rtt_expired_ = false;
+  probe_rtt_done_time_ = Timestamp::PlusInfinity();
+  cycle_index_ = 0;
+  cycle_start_ = Timestamp::MinusInfinity();
+  data_in_flight_ = DataSize::Zero();
+  last_feedback_time_ = Timestamp::MinusInfinity();
+  feedback_interval_ = TimeDelta::Zero();
+  UpdateConstraints(constraints);
+}
+
+void BbrNetworkController::UpdateConstraints(
+    const TargetRateConstraints& constraints) {
+  min_rate_ = constraints.min_data_rate.value_or(DataRate::Zero());
+  max_rate_ = constraints.max_data_rate.value_or(DataRate::PlusInfinity());
+  if (constraints.starting_rate && round_count_ == 0)
+    initial_rate_ = *constraints.starting_rate;
+}
+
+void BbrNetworkController::UpdateMinRtt(TimeDelta rtt, Timestamp at_time) {
+  min_rtt_expired_ = min_rtt_time_.IsFinite() &&
+                     at_time > min_rtt_time_ + config_.min_rtt_window;
+  if (rtt <= min_rtt_ || min_rtt_expired_) {
+    min_rtt_ = rtt;
+    min_rtt_time_ = at_time;
+  }
+}
+
+void BbrNetworkController::UpdateRound(const BandwidthSample& sample) {
+  if (sample.prior_delivered < next_round_delivered_)
+    return;
+  if (round_count_ > 0)
+    OnRoundEnd(sample.is_app_limited);
+  ++round_count_;
+  next_round_delivered_ = sampler_.total_delivered();
+  round_max_rate_ = DataRate::Zero();
+  round_start_lost_ = sampler_.total_lost();
+  round_start_delivered_ = sampler_.total_delivered();
+}
+
+void BbrNetworkController::OnRoundEnd(bool is_app_limited) {
+  DataSize lost = sampler_.total_lost() - round_start_lost_;
+  DataSize sent = lost + sampler_.total_delivered() - round_start_delivered_;
+  round_loss_ratio_ = sent.IsZero() ? 0 : lost / sent;
+  if (round_loss_ratio_ > config_.loss_threshold) {
+    // As in BBRv2, the bandwidth is bounded by the delivery rate of the lossy
+    // round, backing off at most by the loss beta per round.
+    DataRate bound = bandwidth_lo_.IsFinite() ? bandwidth_lo_
+                                              : bandwidth_estimate();
+    bandwidth_lo_ = std::max(round_max_rate_, bound * config_.loss_beta);
+    full_bandwidth_reached_ = true;
+  }
+  if (!full_bandwidth_reached_ && !is_app_limited)
+    CheckFullBandwidthReached();
+}
+
+void BbrNetworkController::CheckFullBandwidthReached() {
+  DataRate bandwidth = max_bandwidth_filter_.Get().value_or(DataRate::Zero());
+  if (bandwidth >= full_bandwidth_ * kStartupGrowthTarget) {
+    full_bandwidth_ = bandwidth;
+    rounds_without_growth_ = 0;
+    return;
+  }
+  if (++rounds_without_growth_ >= kStartupRoundsWithoutGrowth)
+    full_bandwidth_reached_ = true;
+}
+
+void BbrNetworkController::UpdateMode(Timestamp at_time) {
+  switch (mode_) {
+    case Mode::kStartup:
+      if (full_bandwidth_reached_)
+        mode_ = Mode::kDrain;
+      break;
+    case Mode::kDrain:
+      if (data_in_flight_ <= InflightTarget(1.0))
+        EnterProbeBw(at_time);
+      break;
+    case Mode::kProbeBw:
+      AdvanceCycle(at_time);
+      break;
+    case Mode::kProbeRtt:
+      if (at_time >= probe_rtt_done_time_) {
+        min_rtt_time_ = at_time;
+        probe_rtt_done_time_ = Timestamp::PlusInfinity();
+        if (full_bandwidth_reached_) {
+          EnterProbeBw(at_time);
+        } else {
+          mode_ = Mode::kStartup;
+        }
+      }
+      break;
+  }
+  if (min_rtt_expired_ && mode_ != Mode::kProbeRtt)
+    EnterProbeRtt(at_time);
+  min_rtt_expired_ = false;
+}
+
+void BbrNetworkController::EnterProbeBw(Timestamp at_time) {
+  mode_ = Mode::kProbeBw;
+  // Start in one of the cruise phases, so that flows sharing a bottleneck
+  // don't probe in lockstep.
+  cycle_index_ = random_.Rand(2, kCycleLength - 1);
+  cycle_start_ = at_time;
+}
+
+void BbrNetworkController::EnterProbeRtt(Timestamp at_time) {
+  mode_ = Mode::kProbeRtt;
+  probe_rtt_done_time_ = at_time + config_.probe_rtt_duration;
+}
+
+void BbrNetworkController::AdvanceCycle(Timestamp at_time) {
+  bool phase_done = at_time - cycle_start_ > min_rtt();
+  double pacing_gain = PacingGain();
+  // Probing stops when it causes losses, draining when the queue is empty.
+  if (pacing_gain > 1.0 && round_loss_ratio_ > config_.loss_threshold)
+    phase_done = true;
+  if (pacing_gain < 1.0 && data_in_flight_ <= InflightTarget(1.0))
+    phase_done = true;
+  if (!phase_done)
+    return;
+  cycle_index_ = (cycle_index_ + 1) % kCycleLength;
+  cycle_start_ = at_time;
+  // The loss bound is forgotten to probe above it.
+  if (cycle_index_ == 0)
+    bandwidth_lo_ = DataRate::PlusInfinity();
+}
+
+double BbrNetworkController::PacingGain() const {
+  switch (mode_) {
+    case Mode::kStartup:
+      return config_.startup_gain;
+    case Mode::kDrain:
+      return 1.0 / config_.startup_gain;
+    case Mode::kProbeBw:
+      if (cycle_index_ == 0)
+        return config_.probe_up_gain;
+      if (cycle_index_ == 1)
+        return config_.probe_down_gain;
+      return 1.0;
+    case Mode::kProbeRtt:
+      return 1.0;
+  }
+  RTC_CHECK_NOTREACHED();
+}
+
+bool BbrNetworkController::IsProbing() const {
+  return mode_ == Mode::kStartup ||
+         (mode_ == Mode::kProbeBw && cycle_index_ == 0);
+}
+
+bool BbrNetworkController::IsAppLimited() const {
+  // The pacer pads up to the pacing rate.
+  if (IsProbing() && config_.probe_with_padding)
+    return false;
+  return max_allocated_rate_ < bandwidth_estimate() ||
+         alr_detector_.GetApplicationLimitedRegionStartTime().has_value();
+}
+
+DataSize BbrNetworkController::InflightTarget(double gain) const {
+  const DataRate bandwidth = bandwidth_estimate();
+  return bandwidth * min_rtt() * gain + bandwidth * feedback_interval_;
+}
+
+DataSize BbrNetworkController::CongestionWindow() const {
+  double gain = config_.cwnd_gain;
+  if (mode_ == Mode::kStartup || mode_ == Mode::kDrain)
+    gain = config_.startup_gain;
+  if (mode_ == Mode::kProbeRtt)
+    gain = config_.probe_rtt_gain;
+  return std::max(InflightTarget(gain), kMinCongestionWindow);
+}
+
+NetworkControlUpdate BbrNetworkController::CreateRateUpdate(
+    Timestamp at_time) {
+  const DataRate bandwidth = bandwidth_estimate();
+  const double pacing_gain = PacingGain();
+  const bool pad = IsProbing() && config_.probe_with_padding;
+
+  double target_gain = std::min(pacing_gain, 1.0);
+  if (mode_ == Mode::kProbeRtt)
+    target_gain = config_.probe_rtt_gain;
+  if (IsProbing() && !config_.probe_with_padding)
+    target_gain = pacing_gain;
+  DataRate target_rate =
+      std::max(std::min(bandwidth * target_gain, max_rate_), min_rate_);
+  DataRate pacing_rate =
+      std::max(std::min(bandwidth * pacing_gain, max_rate_), target_rate);
+  alr_detector_.SetEstimatedBitrate(bandwidth.bps());
+
+  NetworkControlUpdate update;
+  TargetTransferRate target_rate_msg;
+  target_rate_msg.at_time = at_time;
+  target_rate_msg.target_rate = target_rate;
+  target_rate_msg.stable_target_rate = std::min(target_rate, bandwidth);
+  target_rate_msg.network_estimate.at_time = at_time;
+  target_rate_msg.network_estimate.bandwidth = bandwidth;
+  target_rate_msg.network_estimate.round_trip_time = min_rtt();
+  target_rate_msg.network_estimate.loss_rate_ratio = round_loss_ratio_;
+  target_rate_msg.network_estimate.bwe_period = min_rtt() * kCycleLength;
+  update.target_rate = target_rate_msg;
+
+  PacerConfig pacer_config;
+  pacer_config.at_time = at_time;
+  pacer_config.time_window = TimeDelta::Seconds(1);
+  pacer_config.data_window = pacing_rate * pacer_config.time_window;
+  if (pad)
+    pacer_config.pad_window = pacer_config.data_window;
+  update.pacer_config = pacer_config;
+
+  if (last_feedback_time_.IsFinite())
+    update.congestion_window = CongestionWindow();
+  return update;
+}
+
+}  // namespace bbr
+}  // namespace webrtc
@@ -0,0 +1,186 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_CONGESTION_CONTROLLER_BBR_BBR_NETWORK_CONTROLLER_H_
+#define MODULES_CONGESTION_CONTROLLER_BBR_BBR_NETWORK_CONTROLLER_H_
+
+#include <stdint.h>
+
+#include <memory>
+
+#include "api/transport/field_trial_based_config.h"
+#include "api/transport/network_control.h"
+#include "api/transport/network_types.h"
+#include "api/transport/webrtc_key_value_config.h"
+#include "api/units/data_rate.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/congestion_controller/bbr/bandwidth_sampler.h"
+#include "modules/congestion_controller/bbr/max_bandwidth_filter.h"
+#include "modules/congestion_controller/goog_cc/alr_detector.h"
+#include "rtc_base/experiments/struct_parameters_parser.h"
+#include "rtc_base/random.h"
+
+namespace webrtc {
+namespace bbr {
+
+// Can be changed with the field trial WebRTC-Bwe-BbrSettings.
+struct BbrControllerConfig {
+  // Pacing and congestion window gain while searching for the bandwidth.
+  double startup_gain = 2.885;
+  // Pacing gains of the bandwidth probing cycle, the first phase probes for
+  // more bandwidth and the second drains the queue it built.
+  double probe_up_gain = 1.25;
+  double probe_down_gain = 0.75;
+  double cwnd_gain = 2.0;
+  // The bandwidth filter window, in round trips.
+  int bandwidth_window_rounds = 10;
+  // How long a min RTT sample is valid before the RTT is probed again, and
+  // for how long in flight data is reduced to probe it.
+  TimeDelta min_rtt_window = TimeDelta::Seconds(10);
+  TimeDelta probe_rtt_duration = TimeDelta::Millis(200);
+  double probe_rtt_gain = 0.5;
+  // Ratio of lost packets in a round trip above which the bandwidth is
+  // bounded, and by how much the bound is reduced for each such round.
+  double loss_threshold = 0.02;
+  double loss_beta = 0.7;
+  // If true, the pacer pads up to the pacing rate while probing, so that the
+  // bandwidth is probed even if the encoders don't use the target rate.
+  // Otherwise the target rate is raised to the pacing rate while probing.
+  bool probe_with_padding = true;
+
+  std::unique_ptr<StructParametersParser> Parser();
+};
+
+// A congestion controller modelled after BBR ("BBR: Congestion-Based
+// Congestion Control", Cardwell et al.) with the loss response of BBRv2. It
+// models the path with the maximum delivery rate of the last round trips and
+// the minimum RTT of the last seconds, and paces at a gain of the bandwidth
+// that cycles to probe for more of it.
+//
+// Differences from TCP BBR follow from sending media: the target rate given
+// to the encoders isn't raised above the bandwidth estimate while probing,
+// instead the pacer pads up to the pacing rate. Delivery rate samples from
+// packets sent while application limited, when the allocated rate of the
+// streams is below the bandwidth or in the application limited region
+// detected by an AlrDetector, only raise the estimate. The congestion window
+// allows for the data that is received but not yet acknowledged by transport
+// feedback.
+class BbrNetworkController : public NetworkControllerInterface {
+ public:
+  enum class Mode {
+    // Grows the pacing rate by the startup gain each round trip until the
+    // bandwidth stops growing, or until losses are seen.
+    kStartup,
+    // Drains the queue built in startup.
+    kDrain,
+    // Cycles the pacing gain to probe for more bandwidth.
+    kProbeBw,
+    // Reduces the data in flight to let the queue drain and measure the
+    // minimum RTT.
+    kProbeRtt,
+  };
+
+  explicit BbrNetworkController(NetworkControllerConfig config);
+  ~BbrNetworkController() override;
+
+  // NetworkControllerInterface
+  NetworkControlUpdate OnNetworkAvailability(NetworkAvailability msg) override;
+  NetworkControlUpdate OnNetworkRouteChange(NetworkRouteChange msg) override;
+  NetworkControlUpdate OnProcessInterval(ProcessInterval msg) override;
+  NetworkControlUpdate OnRemoteBitrateReport(RemoteBitrateReport msg) override;
+  NetworkControlUpdate OnRoundTripTimeUpdate(RoundTripTimeUpdate msg) override;
+  NetworkControlUpdate OnSentPacket(SentPacket msg) override;
+  NetworkControlUpdate OnReceivedPacket(ReceivedPacket msg) override;
+  NetworkControlUpdate OnStreamsConfig(StreamsConfig msg) override;
+  NetworkControlUpdate OnTargetRateConstraints(
+      TargetRateConstraints msg) override;
+  NetworkControlUpdate OnTransportLossReport(TransportLossReport msg) override;
+  NetworkControlUpdate OnTransportPacketsFeedback(
+      TransportPacketsFeedback msg) override;
+  NetworkControlUpdate OnNetworkStateEstimate(
+      NetworkStateEstimate msg) override;
+
+  Mode mode() const { return mode_; }
+  DataRate bandwidth_estimate() const;
+  TimeDelta min_rtt() const;
+
+ private:
+  void Reset(const TargetRateConstraints& constraints);
+  void UpdateConstraints(const TargetRateConstraints& constraints);
+  void UpdateMinRtt(TimeDelta rtt, Timestamp at_time);
+  void UpdateRound(const BandwidthSample& sample);
+  void OnRoundEnd(bool is_app_limited);
+  void CheckFullBandwidthReached();
+  void UpdateMode(Timestamp at_time);
+  void EnterProbeBw(Timestamp at_time);
+  void EnterProbeRtt(Timestamp at_time);
+  void AdvanceCycle(Timestamp at_time);
+  double PacingGain() const;
+  bool IsProbing() const;
+  // True if the encoders don't produce enough data to use the bandwidth,
+  // either because their maximum rate is lower or as detected by the
+  // AlrDetector.
+  bool IsAppLimited() const;
+  // The bandwidth delay product times `gain`, plus the data received during
+  // a feedback interval.
+  DataSize InflightTarget(double gain) const;
+  DataSize CongestionWindow() const;
+  NetworkControlUpdate CreateRateUpdate(Timestamp at_time);
+
+  FieldTrialBasedConfig trial_based_config_;
+  const WebRtcKeyValueConfig* const key_value_config_;
+  const BbrControllerConfig config_;
+  AlrDetector alr_detector_;
+  BandwidthSampler sampler_;
+  MaxBandwidthFilter max_bandwidth_filter_;
+  Random random_;
+
+  DataRate min_rate_ = DataRate::Zero();
+  DataRate max_rate_ = DataRate::PlusInfinity();
+  DataRate initial_rate_;
+  DataRate max_allocated_rate_ = DataRate::PlusInfinity();
+  // Lower bound of the bandwidth from recent losses, infinite if there were
+  // no losses since the last probe.
+  DataRate bandwidth_lo_ = DataRate::PlusInfinity();
+
+  Mode mode_ = Mode::kStartup;
+  bool full_bandwidth_reached_ = false;
+  DataRate full_bandwidth_ = DataRate::Zero();
+  int rounds_without_growth_ = 0;
+
+  // Round trips are counted with the delivered data: a round ends when a
+  // packet sent after the start of the round is delivered.
+  int64_t round_count_ = 0;
+  DataSize next_round_delivered_ = DataSize::Zero();
+  DataRate round_max_rate_ = DataRate::Zero();
+  DataSize round_start_lost_ = DataSize::Zero();
+  DataSize round_start_delivered_ = DataSize::Zero();
+  double round_loss_ratio_ = 0;
+
+  TimeDelta min_rtt_ = TimeDelta::PlusInfinity();
+  Timestamp min_rtt_time_ = Timestamp::MinusInfinity();
+  bool min_rtt_expired_ = false;
+  Timestamp probe_rtt_done_time_ = Timestamp::PlusInfinity();
+
+  int cycle_index_ = 0;
+  Timestamp cycle_start_ = Timestamp::MinusInfinity();
+
+  DataSize data_in_flight_ = DataSize::Zero();
+  Timestamp last_feedback_time_ = Timestamp::MinusInfinity();
+  TimeDelta feedback_interval_ = TimeDelta::Zero();
+  bool first_update_sent_ = false;
+};
+
+}  // namespace bbr
+}  // namespace webrtc
+
+#endif  // MODULES_CONGESTION_CONTROLLER_BBR_BBR_NETWORK_CONTROLLER_H_
@@ -0,0 +1,316 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/bbr/bbr_network_controller.h"
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "modules/congestion_controller/bbr/bbr_factory.h"
+#include "test/explicit_key_value_config.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+#include "test/scenario/scenario.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+using bbr::BbrNetworkController;
+
+constexpr DataRate kStartRate = DataRate::KilobitsPerSec(300);
+constexpr DataSize kPacketSize = DataSize::Bytes(1200);
+constexpr TimeDelta kFeedbackInterval = TimeDelta::Millis(50);
+constexpr TimeDelta kTimeStep = TimeDelta::Millis(1);
+
+NetworkControllerConfig InitialConfig(
+    const WebRtcKeyValueConfig* key_value_config = nullptr) {
+  NetworkControllerConfig config;
+  config.constraints.at_time = Timestamp::Seconds(1);
+  config.constraints.min_data_rate = DataRate::KilobitsPerSec(30);
+  config.constraints.max_data_rate = DataRate::KilobitsPerSec(50000);
+  config.constraints.starting_rate = kStartRate;
+  config.key_value_config = key_value_config;
+  return config;
+}
+
+// Sends media at the target rate of the controller and padding up to its
+// padding rate, paced and within its congestion window, over a link of
+// limited capacity with a drop tail queue, and feeds back transport feedback
+// every kFeedbackInterval.
+class SimulatedLink {
+ public:
+  explicit SimulatedLink(NetworkControllerInterface* controller)
+      : controller_(controller) {
+    ProcessInterval msg;
+    msg.at_time = now_;
+    Apply(controller_->OnProcessInterval(msg));
+  }
+
+  void set_capacity(DataRate capacity) { capacity_ = capacity; }
+  void set_one_way_delay(TimeDelta delay) { one_way_delay_ = delay; }
+  // Limits the rate of the media to the maximum allocated rate of the
+  // streams.
+  void set_app_limit(DataRate app_limit) {
+    app_limit_ = app_limit;
+    StreamsConfig msg;
+    msg.at_time = now_;
+    msg.max_total_allocated_bitrate = app_limit;
+    Apply(controller_->OnStreamsConfig(msg));
+  }
+
+  void RunFor(TimeDelta duration) {
+    const Timestamp end = now_ + duration;
+    while (now_ < end) {
+      now_ += kTimeStep;
+      SendPackets();
+      if (now_ >= next_feedback_time_) {
+        SendFeedback();
+        next_feedback_time_ = now_ + kFeedbackInterval;
+      }
+      if (now_ >= next_process_time_) {
+        ProcessInterval msg;
+        msg.at_time = now_;
+        Apply(controller_->OnProcessInterval(msg));
+        next_process_time_ = now_ + TimeDelta::Millis(25);
+      }
+      DeliverFeedback();
+    }
+  }
+
+  DataRate target_rate() const { return target_rate_; }
+  const std::vector<BbrNetworkController::Mode>& modes() const {
+    return modes_;
+  }
+
+ private:
+  struct Packet {
+    SentPacket sent;
+    Timestamp receive_time = Timestamp::PlusInfinity();
+  };
+
+  void Apply(const NetworkControlUpdate& update) {
+    if (update.target_rate)
+      target_rate_ = update.target_rate->target_rate;
+    if (update.pacer_config) {
+      pacing_rate_ = update.pacer_config->data_rate();
+      padding_rate_ = update.pacer_config->pad_rate();
+    }
+    if (update.congestion_window)
+      congestion_window_ = *update.congestion_window;
+  }
+
+  void SendPackets() {
+    DataRate media_rate = std::min(target_rate_, app_limit_);
+    DataRate send_rate =
+        std::min(std::max(media_rate, padding_rate_), pacing_rate_);
+    budget_ = std::min(budget_ + send_rate * kTimeStep, kPacketSize * 4);
+    while (budget_ >= kPacketSize &&
+           data_in_flight_ + kPacketSize <= congestion_window_) {
+      budget_ -= kPacketSize;
+      Packet packet;
+      packet.sent.send_time = now_;
+      packet.sent.size = kPacketSize;
+      packet.sent.sequence_number = next_sequence_number_++;
+      data_in_flight_ += kPacketSize;
+      packet.sent.data_in_flight = data_in_flight_;
+      // The queue of the link holds at most 200 ms of data.
+      Timestamp link_free = std::max(link_free_time_, now_);
+      if (link_free - now_ > TimeDelta::Millis(200)) {
+        packet.receive_time = Timestamp::PlusInfinity();
+      } else {
+        link_free_time_ = link_free + kPacketSize / capacity_;
+        packet.receive_time = link_free_time_ + one_way_delay_;
+      }
+      unacked_.push_back(packet);
+      Apply(controller_->OnSentPacket(packet.sent));
+    }
+  }
+
+  void SendFeedback() {
+    TransportPacketsFeedback feedback;
+    feedback.feedback_time = now_ + one_way_delay_;
+    while (!unacked_.empty()) {
+      const Packet& packet = unacked_.front();
+      if (packet.receive_time.IsFinite() && packet.receive_time > now_)
+        break;
+      // Losses are reported with later packets.
+      bool later_received =
+          std::any_of(unacked_.begin(), unacked_.end(), [&](const Packet& p) {
+            return p.receive_time <= now_;
+          });
+      if (packet.receive_time.IsInfinite() && !later_received)
+        break;
+      PacketResult result;
+      result.sent_packet = packet.sent;
+      result.receive_time = packet.receive_time;
+      feedback.packet_feedbacks.push_back(result);
+      unacked_.pop_front();
+    }
+    if (!feedback.packet_feedbacks.empty())
+      pending_feedback_.push_back(feedback);
+  }
+
+  void DeliverFeedback() {
+    while (!pending_feedback_.empty() &&
+           pending_feedback_.front().feedback_time <= now_) {
+      TransportPacketsFeedback& feedback = pending_feedback_.front();
+      for (const PacketResult& packet : feedback.packet_feedbacks)
+        data_in_flight_ -= packet.sent_packet.size;
+      feedback.data_in_flight = data_in_flight_;
+      Apply(controller_->OnTransportPacketsFeedback(feedback));
+      pending_feedback_.pop_front();
+      modes_.push_back(static_cast<BbrNetworkController*>(controller_)->mode());
+    }
+  }
+
+  NetworkControllerInterface* const controller_;
+  Timestamp now_ = Timestamp::Seconds(1);
+  DataRate capacity_ = DataRate::KilobitsPerSec(1000);
+  TimeDelta one_way_delay_ = TimeDelta::Millis(25);
+  DataRate app_limit_ = DataRate::PlusInfinity();
+
+  DataRate target_rate_ = DataRate::Zero();
+  DataRate pacing_rate_ = DataRate::Zero();
+  DataRate padding_rate_ = DataRate::Zero();
+  DataSize congestion_window_ = DataSize::Infinity();
+  DataSize budget_ = DataSize::Zero();
+  DataSize data_in_flight_ = DataSize::Zero();
+  int64_t next_sequence_number_ = 0;
+  Timestamp link_free_time_ = Timestamp::MinusInfinity();
+  Timestamp next_feedback_time_ = Timestamp::MinusInfinity();
+  Timestamp next_process_time_ = Timestamp::MinusInfinity();
+  std::deque<Packet> unacked_;
+  std::deque<TransportPacketsFeedback> pending_feedback_;
+  std::vector<BbrNetworkController::Mode> modes_;
+};
+
+}  // namespace
+
+TEST(BbrNetworkControllerTest, SendsConfigurationOnFirstProcess) {
+  BbrNetworkController controller(InitialConfig());
+  ProcessInterval msg;
+  msg.at_time = Timestamp::Seconds(1);
+  NetworkControlUpdate update = controller.OnProcessInterval(msg);
+  ASSERT_TRUE(update.target_rate);
+  ASSERT_TRUE(update.pacer_config);
+  EXPECT_EQ(update.target_rate->target_rate, kStartRate);
+  EXPECT_GT(update.pacer_config->data_rate(), kStartRate * 2);
+  // Startup probes with padding.
+  EXPECT_EQ(update.pacer_config->pad_rate(),
+            update.pacer_config->data_rate());
+  EXPECT_EQ(controller.mode(), BbrNetworkController::Mode::kStartup);
+}
+
+TEST(BbrNetworkControllerTest, ProbesWithTargetRateWithoutPadding) {
+  ExplicitKeyValueConfig field_trials(
+      "WebRTC-Bwe-BbrSettings/probe_with_padding:false/");
+  BbrNetworkController controller(InitialConfig(&field_trials));
+  ProcessInterval msg;
+  msg.at_time = Timestamp::Seconds(1);
+  NetworkControlUpdate update = controller.OnProcessInterval(msg);
+  EXPECT_GT(update.target_rate->target_rate, kStartRate * 2);
+  EXPECT_EQ(update.pacer_config->pad_rate(), DataRate::Zero());
+}
+
+TEST(BbrNetworkControllerTest, ConvergesToLinkCapacity) {
+  BbrNetworkController controller(InitialConfig());
+  SimulatedLink link(&controller);
+  link.set_capacity(DataRate::KilobitsPerSec(2000));
+  link.RunFor(TimeDelta::Seconds(20));
+  EXPECT_NEAR(link.target_rate().kbps(), 2000, 300);
+  EXPECT_NEAR(controller.bandwidth_estimate().kbps(), 2000, 200);
+  EXPECT_GE(controller.min_rtt(), TimeDelta::Millis(50));
+  EXPECT_LE(controller.min_rtt(), TimeDelta::Millis(50) + kFeedbackInterval);
+}
+
+TEST(BbrNetworkControllerTest, FillsHighBandwidthDelayProductLink) {
+  BbrNetworkController controller(InitialConfig());
+  SimulatedLink link(&controller);
+  link.set_capacity(DataRate::KilobitsPerSec(20000));
+  link.set_one_way_delay(TimeDelta::Millis(50));
+  link.RunFor(TimeDelta::Seconds(5));
+  EXPECT_GT(link.target_rate().kbps(), 15000);
+  EXPECT_LE(controller.bandwidth_estimate().kbps(), 22000);
+}
+
+TEST(BbrNetworkControllerTest, FollowsCapacityDrop) {
+  BbrNetworkController controller(InitialConfig());
+  SimulatedLink link(&controller);
+  link.set_capacity(DataRate::KilobitsPerSec(4000));
+  link.RunFor(TimeDelta::Seconds(10));
+  EXPECT_NEAR(link.target_rate().kbps(), 4000, 600);
+  link.set_capacity(DataRate::KilobitsPerSec(1000));
+  link.RunFor(TimeDelta::Seconds(10));
+  EXPECT_NEAR(link.target_rate().kbps(), 1000, 250);
+}
+
+TEST(BbrNetworkControllerTest, CyclesThroughModes) {
+  BbrNetworkController controller(InitialConfig());
+  SimulatedLink link(&controller);
+  link.RunFor(TimeDelta::Seconds(15));
+  const std::vector<BbrNetworkController::Mode>& modes = link.modes();
+  auto seen = [&](BbrNetworkController::Mode mode) {
+    return std::find(modes.begin(), modes.end(), mode) != modes.end();
+  };
+  EXPECT_TRUE(seen(BbrNetworkController::Mode::kDrain));
+  EXPECT_TRUE(seen(BbrNetworkController::Mode::kProbeBw));
+  // The min RTT is probed after its 10 s window.
+  EXPECT_TRUE(seen(BbrNetworkController::Mode::kProbeRtt));
+  EXPECT_EQ(controller.mode(), BbrNetworkController::Mode::kProbeBw);
+}
+
+TEST(BbrNetworkControllerTest, KeepsEstimateWhenApplicationLimited) {
+  BbrNetworkController controller(InitialConfig());
+  SimulatedLink link(&controller);
+  link.set_capacity(DataRate::KilobitsPerSec(2000));
+  link.RunFor(TimeDelta::Seconds(10));
+  ASSERT_NEAR(controller.bandwidth_estimate().kbps(), 2000, 200);
+  link.set_app_limit(DataRate::KilobitsPerSec(500));
+  link.RunFor(TimeDelta::Seconds(10));
+  EXPECT_NEAR(controller.bandwidth_estimate().kbps(), 2000, 300);
+}
+
+TEST(BbrNetworkControllerTest, UpdatesTargetRateInScenario) {
+  BbrNetworkControllerFactory factory;
+  Scenario s("bbr_unit/updates_rate", false);
+  CallClientConfig config;
+  config.transport.cc_factory = &factory;
+  config.transport.rates.min_rate = DataRate::KilobitsPerSec(10);
+  config.transport.rates.max_rate = DataRate::KilobitsPerSec(1500);
+  config.transport.rates.start_rate = DataRate::KilobitsPerSec(300);
+  auto send_net = s.CreateMutableSimulationNode([](NetworkSimulationConfig* c) {
+    c->bandwidth = DataRate::KilobitsPerSec(500);
+    c->delay = TimeDelta::Millis(100);
+  });
+  auto ret_net = s.CreateMutableSimulationNode(
+      [](NetworkSimulationConfig* c) { c->delay = TimeDelta::Millis(100); });
+
+  auto* client = s.CreateClient("send", config);
+  auto* route = s.CreateRoutes(client, {send_net->node()},
+                               s.CreateClient("return", CallClientConfig()),
+                               {ret_net->node()});
+  VideoStreamConfig video;
+  video.stream.use_rtx = false;
+  s.CreateVideoStream(route->forward(), video);
+  s.RunFor(TimeDelta::Seconds(30));
+  EXPECT_NEAR(client->target_rate().kbps(), 450, 100);
+  send_net->UpdateConfig([](NetworkSimulationConfig* c) {
+    c->bandwidth = DataRate::KilobitsPerSec(1000);
+    c->delay = TimeDelta::Millis(100);
+  });
+  s.RunFor(TimeDelta::Seconds(20));
+  EXPECT_NEAR(client->target_rate().kbps(), 900, 200);
+}
+
+}  // namespace test
+}  // namespace webrtc
@@ -0,0 +1,48 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/bbr/max_bandwidth_filter.h"
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace bbr {
+
+MaxBandwidthFilter::MaxBandwidthFilter(int64_t window_length)
+    : window_length_(window_length) {
+  RTC_DCHECK_GT(window_length, 0);
+}
+
+MaxBandwidthFilter::~MaxBandwidthFilter() = default;
+
+void MaxBandwidthFilter::Update(DataRate sample, int64_t round) {
+  RTC_DCHECK(samples_.empty() || round >= samples_.back().first);
+  while (!samples_.empty() &&
+         samples_.front().first <= round - window_length_) {
+    samples_.pop_front();
+  }
+  while (!samples_.empty() && samples_.back().second <= sample) {
+    samples_.pop_back();
+  }
+  samples_.emplace_back(round, sample);
+}
+
+absl::optional<DataRate> MaxBandwidthFilter::Get() const {
+  if (samples_.empty())
+    return absl::nullopt;
+  return samples_.front().second;
+}
+
+void MaxBandwidthFilter::Reset() {
+  samples_.clear();
+}
+
+}  // namespace bbr
+}  // namespace webrtc
@@ -0,0 +1,49 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_CONGESTION_CONTROLLER_BBR_MAX_BANDWIDTH_FILTER_H_
+#define MODULES_CONGESTION_CONTROLLER_BBR_MAX_BANDWIDTH_FILTER_H_
+
+#include <stdint.h>
+
+#include <deque>
+#include <utility>
+
+#include "absl/types/optional.h"
+#include "api/units/data_rate.h"
+
+namespace webrtc {
+namespace bbr {
+
+// Keeps the maximum of the bandwidth samples of the last `window_length`
+// round trips. Unlike rtc::MovingMaxCounter, samples only expire when a new
+// sample is added, so that the maximum is kept while the sender is
+// application limited and not all samples are added.
+class MaxBandwidthFilter {
+ public:
+  explicit MaxBandwidthFilter(int64_t window_length);
+  ~MaxBandwidthFilter();
+
+  // Adds a sample taken in round trip `round`, which must be at least the
+  // round of the previous sample.
+  void Update(DataRate sample, int64_t round);
+  absl::optional<DataRate> Get() const;
+  void Reset();
+
+ private:
+  const int64_t window_length_;
+  // Pairs of round and sample, with increasing rounds and decreasing samples.
+  std::deque<std::pair<int64_t, DataRate>> samples_;
+};
+
+}  // namespace bbr
+}  // namespace webrtc
+
+#endif  // MODULES_CONGESTION_CONTROLLER_BBR_MAX_BANDWIDTH_FILTER_H_
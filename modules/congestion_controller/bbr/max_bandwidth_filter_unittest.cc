@@ -0,0 +1,56 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/bbr/max_bandwidth_filter.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace bbr {
+namespace {
+
+constexpr DataRate kLow = DataRate::KilobitsPerSec(100);
+constexpr DataRate kMedium = DataRate::KilobitsPerSec(200);
+constexpr DataRate kHigh = DataRate::KilobitsPerSec(300);
+
+}  // namespace
+
+TEST(MaxBandwidthFilterTest, IsEmptyWithoutSamples) {
+  MaxBandwidthFilter filter(/*window_length=*/10);
+  EXPECT_FALSE(filter.Get());
+  filter.Update(kLow, 1);
+  filter.Reset();
+  EXPECT_FALSE(filter.Get());
+}
+
+TEST(MaxBandwidthFilterTest, KeepsMaxOfWindow) {
+  MaxBandwidthFilter filter(/*window_length=*/3);
+  filter.Update(kHigh, 1);
+  filter.Update(kLow, 2);
+  filter.Update(kMedium, 3);
+  EXPECT_EQ(filter.Get(), kHigh);
+  // Round 1 leaves the window.
+  filter.Update(kLow, 4);
+  EXPECT_EQ(filter.Get(), kMedium);
+  filter.Update(kLow, 6);
+  EXPECT_EQ(filter.Get(), kLow);
+}
+
+TEST(MaxBandwidthFilterTest, KeepsMaxWithoutNewSamples) {
+  MaxBandwidthFilter filter(/*window_length=*/3);
+  filter.Update(kHigh, 1);
+  filter.Update(kLow, 2);
+  EXPECT_EQ(filter.Get(), kHigh);
+  filter.Update(kLow, 100);
+  EXPECT_EQ(filter.Get(), kLow);
+}
+
+}  // namespace bbr
+}  // namespace webrtc
@@ -0,0 +1,204 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/goog_cc/bwe_trace_record.h"
+
+#include <string.h>
+
+#include <limits>
+
+#include "absl/base/casts.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kMagicSize = sizeof(kBweTraceMagic) - 1;
+constexpr int64_t kPlusInfinity = std::numeric_limits<int64_t>::max();
+constexpr int64_t kMinusInfinity = std::numeric_limits<int64_t>::min();
+
+void WriteInt64(int64_t value, rtc::ByteBufferWriter* writer) {
+  writer->WriteUInt64(static_cast<uint64_t>(value));
+}
+
+void WriteTimestamp(Timestamp value, rtc::ByteBufferWriter* writer) {
+  if (value.IsPlusInfinity()) {
+    WriteInt64(kPlusInfinity, writer);
+  } else if (value.IsMinusInfinity()) {
+    WriteInt64(kMinusInfinity, writer);
+  } else {
+    WriteInt64(value.us(), writer);
+  }
+}
+
+void WriteDataRate(DataRate value, rtc::ByteBufferWriter* writer) {
+  if (value.IsPlusInfinity()) {
+    WriteInt64(kPlusInfinity, writer);
+  } else if (value.IsMinusInfinity()) {
+    WriteInt64(kMinusInfinity, writer);
+  } else {
+    WriteInt64(value.bps(), writer);
+  }
+}
+
+void WriteDouble(double value, rtc::ByteBufferWriter* writer) {
+  writer->WriteUInt64(absl::bit_cast<uint64_t>(value));
+}
+
+bool ReadInt64(rtc::ByteBufferReader* reader, int64_t* value) {
+  uint64_t unsigned_value;
+  if (!reader->ReadUInt64(&unsigned_value))
+    return false;
+  *value = static_cast<int64_t>(unsigned_value);
+  return true;
+}
+
+bool ReadTimestamp(rtc::ByteBufferReader* reader, Timestamp* value) {
+  int64_t us;
+  if (!ReadInt64(reader, &us))
+    return false;
+  if (us == kPlusInfinity) {
+    *value = Timestamp::PlusInfinity();
+  } else if (us == kMinusInfinity) {
+    *value = Timestamp::MinusInfinity();
+  } else {
+    *value = Timestamp::Micros(us);
+  }
+  return true;
+}
+
+bool ReadDataRate(rtc::ByteBufferReader* reader, DataRate* value) {
+  int64_t bps;
+  if (!ReadInt64(reader, &bps))
+    return false;
+  if (bps == kPlusInfinity) {
+    *value = DataRate::PlusInfinity();
+  } else if (bps == kMinusInfinity) {
+    *value = DataRate::MinusInfinity();
+  } else {
+    *value = DataRate::BitsPerSec(bps);
+  }
+  return true;
+}
+
+bool ReadDouble(rtc::ByteBufferReader* reader, double* value) {
+  uint64_t bits;
+  if (!reader->ReadUInt64(&bits))
+    return false;
+  *value = absl::bit_cast<double>(bits);
+  return true;
+}
+
+bool ReadInt32(rtc::ByteBufferReader* reader, int* value) {
+  uint32_t unsigned_value;
+  if (!reader->ReadUInt32(&unsigned_value))
+    return false;
+  *value = static_cast<int32_t>(unsigned_value);
+  return true;
+}
+
+bool ReadInt8(rtc::ByteBufferReader* reader, int* value) {
+  uint8_t unsigned_value;
+  if (!reader->ReadUInt8(&unsigned_value))
+    return false;
+  *value = static_cast<int8_t>(unsigned_value);
+  return true;
+}
+
+}  // namespace
+
+void EncodeBweTraceHeader(rtc::ByteBufferWriter* writer) {
+  writer->WriteBytes(kBweTraceMagic, kMagicSize);
+  writer->WriteUInt32(kBweTraceVersion);
+  writer->WriteUInt32(kBweTraceRecordSize);
+}
+
+void EncodeBweTraceRecord(const BweTraceRecord& record,
+                          rtc::ByteBufferWriter* writer) {
+  const size_t start = writer->Length();
+  WriteTimestamp(record.at_time, writer);
+
+  WriteDataRate(record.target_rate, writer);
+  WriteDataRate(record.loss_based_target_rate, writer);
+  WriteDataRate(record.acknowledged_rate, writer);
+
+  WriteDataRate(record.delay_based_estimate, writer);
+  writer->WriteUInt8(static_cast<uint8_t>(record.delay_detector_state));
+
+  WriteDouble(record.trendline_slope, writer);
+  WriteDouble(record.trendline_modified_offset, writer);
+  WriteDouble(record.trendline_threshold, writer);
+  writer->WriteUInt32(static_cast<uint32_t>(record.trendline_num_deltas));
+
+  writer->WriteUInt8(static_cast<uint8_t>(record.rate_control_state));
+  WriteDataRate(record.rate_control_target, writer);
+  WriteDataRate(record.link_capacity_estimate, writer);
+
+  writer->WriteUInt8(static_cast<uint8_t>(record.probe_state));
+  WriteDataRate(record.probe_estimated_bitrate, writer);
+  WriteDataRate(record.min_bitrate_to_probe_further, writer);
+  writer->WriteUInt8(record.probe_in_alr ? 1 : 0);
+  RTC_DCHECK_EQ(writer->Length() - start, kBweTraceRecordSize);
+}
+
+bool DecodeBweTraceHeader(rtc::ByteBufferReader* reader, size_t* record_size) {
+  char magic[kMagicSize];
+  uint32_t version;
+  uint32_t size;
+  if (!reader->ReadBytes(magic, kMagicSize) ||
+      memcmp(magic, kBweTraceMagic, kMagicSize) != 0 ||
+      !reader->ReadUInt32(&version) || version != kBweTraceVersion ||
+      !reader->ReadUInt32(&size) || size < kBweTraceRecordSize) {
+    return false;
+  }
+  *record_size = size;
+  return true;
+}
+
+bool DecodeBweTraceRecord(rtc::ByteBufferReader* reader,
+                          size_t record_size,
+                          BweTraceRecord* record) {
+  RTC_DCHECK_GE(record_size, kBweTraceRecordSize);
+  if (reader->Length() < record_size)
+    return false;
+
+  int delay_detector_state;
+  int probe_in_alr;
+  // Cannot fail, as enough data was checked for above.
+  RTC_CHECK(ReadTimestamp(reader, &record->at_time) &&
+            ReadDataRate(reader, &record->target_rate) &&
+            ReadDataRate(reader, &record->loss_based_target_rate) &&
+            ReadDataRate(reader, &record->acknowledged_rate) &&
+            ReadDataRate(reader, &record->delay_based_estimate) &&
+            ReadInt8(reader, &delay_detector_state) &&
+            ReadDouble(reader, &record->trendline_slope) &&
+            ReadDouble(reader, &record->trendline_modified_offset) &&
+            ReadDouble(reader, &record->trendline_threshold) &&
+            ReadInt32(reader, &record->trendline_num_deltas) &&
+            ReadInt8(reader, &record->rate_control_state) &&
+            ReadDataRate(reader, &record->rate_control_target) &&
+            ReadDataRate(reader, &record->link_capacity_estimate) &&
+            ReadInt8(reader, &record->probe_state) &&
+            ReadDataRate(reader, &record->probe_estimated_bitrate) &&
+            ReadDataRate(reader, &record->min_bitrate_to_probe_further) &&
+            ReadInt8(reader, &probe_in_alr));
+  if (delay_detector_state < 0 ||
+      delay_detector_state >= static_cast<int>(BandwidthUsage::kLast)) {
+    return false;
+  }
+  record->delay_detector_state =
+      static_cast<BandwidthUsage>(delay_detector_state);
+  record->probe_in_alr = probe_in_alr != 0;
+  // Skip the fields appended by later writers.
+  reader->Consume(record_size - kBweTraceRecordSize);
+  return true;
+}
+
+}  // namespace webrtc
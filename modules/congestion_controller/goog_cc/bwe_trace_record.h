@@ -0,0 +1,80 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_CONGESTION_CONTROLLER_GOOG_CC_BWE_TRACE_RECORD_H_
+#define MODULES_CONGESTION_CONTROLLER_GOOG_CC_BWE_TRACE_RECORD_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "api/network_state_predictor.h"
+#include "api/units/data_rate.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/byte_buffer.h"
+
+namespace webrtc {
+
+// The internal state of GoogCcNetworkController after a transport feedback
+// update, as recorded by BweTraceRecorder. Rates that are not known are
+// MinusInfinity.
+struct BweTraceRecord {
+  Timestamp at_time = Timestamp::MinusInfinity();
+
+  // GoogCcNetworkController.
+  DataRate target_rate = DataRate::MinusInfinity();
+  DataRate loss_based_target_rate = DataRate::MinusInfinity();
+  DataRate acknowledged_rate = DataRate::MinusInfinity();
+
+  // DelayBasedBwe.
+  DataRate delay_based_estimate = DataRate::MinusInfinity();
+  BandwidthUsage delay_detector_state = BandwidthUsage::kBwNormal;
+
+  // TrendlineEstimator.
+  double trendline_slope = 0.0;
+  double trendline_modified_offset = 0.0;
+  double trendline_threshold = 0.0;
+  int trendline_num_deltas = 0;
+
+  // AimdRateControl. The state is the value of
+  // AimdRateControl::RateControlState.
+  int rate_control_state = 0;
+  DataRate rate_control_target = DataRate::MinusInfinity();
+  DataRate link_capacity_estimate = DataRate::MinusInfinity();
+
+  // ProbeController. The state is the value of ProbeController::State.
+  int probe_state = 0;
+  DataRate probe_estimated_bitrate = DataRate::MinusInfinity();
+  DataRate min_bitrate_to_probe_further = DataRate::MinusInfinity();
+  bool probe_in_alr = false;
+};
+
+// A trace is a header followed by fixed size records, with all values in
+// network byte order. The header holds the record size, so that fields can
+// be appended to the records without breaking older readers.
+constexpr char kBweTraceMagic[] = "BWETRACE";
+constexpr uint32_t kBweTraceVersion = 1;
+constexpr size_t kBweTraceHeaderSize = 16;
+constexpr size_t kBweTraceRecordSize = 104;
+
+void EncodeBweTraceHeader(rtc::ByteBufferWriter* writer);
+void EncodeBweTraceRecord(const BweTraceRecord& record,
+                          rtc::ByteBufferWriter* writer);
+
+// Returns false if `reader` doesn't start with a trace header. Otherwise
+// sets `record_size` to the size of the records that follow.
+bool DecodeBweTraceHeader(rtc::ByteBufferReader* reader, size_t* record_size);
+// Returns false if `reader` doesn't hold another record of `record_size`.
+bool DecodeBweTraceRecord(rtc::ByteBufferReader* reader,
+                          size_t record_size,
+                          BweTraceRecord* record);
+
+}  // namespace webrtc
+
+#endif  // MODULES_CONGESTION_CONTROLLER_GOOG_CC_BWE_TRACE_RECORD_H_
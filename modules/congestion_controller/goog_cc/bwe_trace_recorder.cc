@@ -0,0 +1,118 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/goog_cc/bwe_trace_recorder.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include "modules/congestion_controller/goog_cc/delay_based_bwe.h"
+#include "modules/congestion_controller/goog_cc/goog_cc_network_control.h"
+#include "modules/congestion_controller/goog_cc/probe_controller.h"
+#include "modules/congestion_controller/goog_cc/trendline_estimator.h"
+#include "modules/remote_bitrate_estimator/aimd_rate_control.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+constexpr size_t BweTraceRecorder::kDefaultCapacity;
+
+BweTraceRecorder::BweTraceRecorder(std::unique_ptr<RtcEventLogOutput> output,
+                                   size_t capacity)
+    : output_(std::move(output)), records_(capacity) {
+  RTC_DCHECK_GE(capacity, 2);
+}
+
+BweTraceRecorder::~BweTraceRecorder() {
+  Flush();
+}
+
+void BweTraceRecorder::Record(const GoogCcNetworkController& controller,
+                              Timestamp at_time) {
+  BweTraceRecord& record = records_[next_index_];
+  record.at_time = at_time;
+
+  record.target_rate = controller.last_pushback_target_rate_;
+  record.loss_based_target_rate = controller.last_loss_based_target_rate_;
+  record.acknowledged_rate =
+      controller.acknowledged_bitrate_estimator_->bitrate().value_or(
+          DataRate::MinusInfinity());
+
+  const DelayBasedBwe& delay_based_bwe = *controller.delay_based_bwe_;
+  record.delay_based_estimate = delay_based_bwe.prev_bitrate_;
+  record.delay_detector_state = delay_based_bwe.prev_state_;
+
+  // DelayBasedBwe only creates TrendlineEstimators.
+  const TrendlineEstimator& trendline =
+      *static_cast<const TrendlineEstimator*>(
+          delay_based_bwe.active_delay_detector_);
+  record.trendline_slope = trendline.prev_trend_;
+  record.trendline_modified_offset = trendline.prev_modified_trend_;
+  record.trendline_threshold = trendline.threshold_;
+  record.trendline_num_deltas = trendline.num_of_deltas_;
+
+  const AimdRateControl& rate_control = delay_based_bwe.rate_control_;
+  record.rate_control_state =
+      static_cast<int>(rate_control.rate_control_state_);
+  record.rate_control_target = rate_control.current_bitrate_;
+  record.link_capacity_estimate = rate_control.link_capacity_.has_estimate()
+                                      ? rate_control.link_capacity_.estimate()
+                                      : DataRate::MinusInfinity();
+
+  const ProbeController& probe_controller = *controller.probe_controller_;
+  record.probe_state = static_cast<int>(probe_controller.state_);
+  record.probe_estimated_bitrate =
+      DataRate::BitsPerSec(probe_controller.estimated_bitrate_bps_);
+  record.min_bitrate_to_probe_further = DataRate::BitsPerSec(
+      probe_controller.min_bitrate_to_probe_further_bps_);
+  record.probe_in_alr = probe_controller.alr_start_time_ms_.has_value();
+
+  next_index_ = (next_index_ + 1) % records_.size();
+  num_records_ = std::min(num_records_ + 1, records_.size());
+  if (output_ && ++num_unwritten_records_ >= records_.size() / 2) {
+    Flush();
+  }
+}
+
+void BweTraceRecorder::Flush() {
+  if (!output_ || num_unwritten_records_ == 0 || !output_->IsActive()) {
+    num_unwritten_records_ = 0;
+    return;
+  }
+  RTC_DCHECK_LE(num_unwritten_records_, records_.size());
+  buffer_.Clear();
+  if (!header_written_) {
+    EncodeBweTraceHeader(&buffer_);
+    header_written_ = true;
+  }
+  size_t index = (next_index_ + records_.size() - num_unwritten_records_) %
+                 records_.size();
+  for (size_t i = 0; i < num_unwritten_records_; ++i) {
+    EncodeBweTraceRecord(records_[index], &buffer_);
+    index = (index + 1) % records_.size();
+  }
+  num_unwritten_records_ = 0;
+  output_->Write(std::string(buffer_.Data(), buffer_.Length()));
+}
+
+std::vector<BweTraceRecord> BweTraceRecorder::GetRecords() const {
+  std::vector<BweTraceRecord> records;
+  records.reserve(num_records_);
+  size_t index =
+      (next_index_ + records_.size() - num_records_) % records_.size();
+  for (size_t i = 0; i < num_records_; ++i) {
+    records.push_back(records_[index]);
+    index = (index + 1) % records_.size();
+  }
+  return records;
+}
+
+}  // namespace webrtc
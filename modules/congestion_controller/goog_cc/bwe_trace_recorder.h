@@ -0,0 +1,69 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_CONGESTION_CONTROLLER_GOOG_CC_BWE_TRACE_RECORDER_H_
+#define MODULES_CONGESTION_CONTROLLER_GOOG_CC_BWE_TRACE_RECORDER_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include "api/rtc_event_log_output.h"
+#include "api/units/timestamp.h"
+#include "modules/congestion_controller/goog_cc/bwe_trace_record.h"
+#include "rtc_base/byte_buffer.h"
+
+namespace webrtc {
+
+class GoogCcNetworkController;
+
+// Records the internal state of a GoogCcNetworkController after each
+// transport feedback update, for offline tuning of its parameters. The last
+// `capacity` records are kept in a ring buffer. If an output is given, the
+// records are also streamed to it, in batches of half the capacity, so that
+// recording a feedback update only copies its state. Use
+// rtc_tools/bwe_trace to read the output.
+//
+// Must be used on the sequence of the controller.
+class BweTraceRecorder {
+ public:
+  static constexpr size_t kDefaultCapacity = 512;
+
+  explicit BweTraceRecorder(std::unique_ptr<RtcEventLogOutput> output,
+                            size_t capacity = kDefaultCapacity);
+  // Writes the records that were not written yet.
+  ~BweTraceRecorder();
+
+  BweTraceRecorder(const BweTraceRecorder&) = delete;
+  BweTraceRecorder& operator=(const BweTraceRecorder&) = delete;
+
+  void Record(const GoogCcNetworkController& controller, Timestamp at_time);
+
+  // Writes the records that were not written yet to the output, if any.
+  void Flush();
+
+  // Returns the records in the ring buffer, oldest first.
+  std::vector<BweTraceRecord> GetRecords() const;
+
+ private:
+  const std::unique_ptr<RtcEventLogOutput> output_;
+  std::vector<BweTraceRecord> records_;
+  // The index in `records_` of the next record.
+  size_t next_index_ = 0;
+  size_t num_records_ = 0;
+  size_t num_unwritten_records_ = 0;
+  bool header_written_ = false;
+  rtc::ByteBufferWriter buffer_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_CONGESTION_CONTROLLER_GOOG_CC_BWE_TRACE_RECORDER_H_
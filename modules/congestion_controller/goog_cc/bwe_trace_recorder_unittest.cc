@@ -0,0 +1,203 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/goog_cc/bwe_trace_recorder.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "api/rtc_event_log/rtc_event_log.h"
+#include "api/transport/goog_cc_factory.h"
+#include "api/transport/network_types.h"
+#include "api/units/data_rate.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/congestion_controller/goog_cc/bwe_trace_record.h"
+#include "rtc_base/byte_buffer.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr DataSize kPacketSize = DataSize::Bytes(1000);
+
+class StringOutput : public RtcEventLogOutput {
+ public:
+  explicit StringOutput(std::string* output) : output_(output) {}
+  bool IsActive() const override { return true; }
+  bool Write(const std::string& output) override {
+    output_->append(output);
+    ++num_writes_;
+    return true;
+  }
+  int num_writes() const { return num_writes_; }
+
+ private:
+  std::string* const output_;
+  int num_writes_ = 0;
+};
+
+// Sends a packet every 50 ms and reports it in a feedback 20 ms later.
+// Returns the feedback times.
+std::vector<Timestamp> SendPacketsWithFeedback(BweTraceRecorder* recorder,
+                                               int num_packets) {
+  RtcEventLogNull event_log;
+  GoogCcFactoryConfig factory_config;
+  factory_config.bwe_trace_recorder = recorder;
+  GoogCcNetworkControllerFactory factory(std::move(factory_config));
+  Timestamp now = Timestamp::Seconds(100);
+  NetworkControllerConfig config;
+  config.constraints.at_time = now;
+  config.constraints.starting_rate = DataRate::KilobitsPerSec(300);
+  config.event_log = &event_log;
+  std::unique_ptr<NetworkControllerInterface> controller =
+      factory.Create(config);
+
+  std::vector<Timestamp> feedback_times;
+  for (int i = 0; i < num_packets; ++i) {
+    PacketResult packet;
+    packet.sent_packet.send_time = now;
+    packet.sent_packet.size = kPacketSize;
+    packet.sent_packet.sequence_number = i;
+    packet.receive_time = now + TimeDelta::Millis(20);
+    controller->OnSentPacket(packet.sent_packet);
+    TransportPacketsFeedback feedback;
+    feedback.feedback_time = packet.receive_time;
+    feedback.packet_feedbacks.push_back(packet);
+    controller->OnTransportPacketsFeedback(feedback);
+    feedback_times.push_back(feedback.feedback_time);
+    now += TimeDelta::Millis(50);
+  }
+  return feedback_times;
+}
+
+std::vector<BweTraceRecord> DecodeTrace(const std::string& trace) {
+  rtc::ByteBufferReader reader(trace.data(), trace.size());
+  size_t record_size;
+  EXPECT_TRUE(DecodeBweTraceHeader(&reader, &record_size));
+  std::vector<BweTraceRecord> records;
+  BweTraceRecord record;
+  while (DecodeBweTraceRecord(&reader, record_size, &record)) {
+    records.push_back(record);
+  }
+  EXPECT_EQ(reader.Length(), 0u);
+  return records;
+}
+
+TEST(BweTraceRecordTest, DecodesEncodedRecord) {
+  BweTraceRecord record;
+  record.at_time = Timestamp::Millis(123456);
+  record.target_rate = DataRate::KilobitsPerSec(300);
+  record.loss_based_target_rate = DataRate::PlusInfinity();
+  record.delay_based_estimate = DataRate::KilobitsPerSec(350);
+  record.delay_detector_state = BandwidthUsage::kBwOverusing;
+  record.trendline_slope = -0.25;
+  record.trendline_modified_offset = 13.5;
+  record.trendline_threshold = 12.5;
+  record.trendline_num_deltas = 60;
+  record.rate_control_state = 2;
+  record.link_capacity_estimate = DataRate::KilobitsPerSec(400);
+  record.probe_state = 1;
+  record.probe_in_alr = true;
+
+  rtc::ByteBufferWriter writer;
+  EncodeBweTraceHeader(&writer);
+  EXPECT_EQ(writer.Length(), kBweTraceHeaderSize);
+  EncodeBweTraceRecord(record, &writer);
+  EXPECT_EQ(writer.Length(), kBweTraceHeaderSize + kBweTraceRecordSize);
+
+  std::vector<BweTraceRecord> decoded =
+      DecodeTrace(std::string(writer.Data(), writer.Length()));
+  ASSERT_EQ(decoded.size(), 1u);
+  EXPECT_EQ(decoded[0].at_time, record.at_time);
+  EXPECT_EQ(decoded[0].target_rate, record.target_rate);
+  EXPECT_TRUE(decoded[0].loss_based_target_rate.IsPlusInfinity());
+  EXPECT_TRUE(decoded[0].acknowledged_rate.IsMinusInfinity());
+  EXPECT_EQ(decoded[0].delay_based_estimate, record.delay_based_estimate);
+  EXPECT_EQ(decoded[0].delay_detector_state, record.delay_detector_state);
+  EXPECT_EQ(decoded[0].trendline_slope, record.trendline_slope);
+  EXPECT_EQ(decoded[0].trendline_modified_offset,
+            record.trendline_modified_offset);
+  EXPECT_EQ(decoded[0].trendline_threshold, record.trendline_threshold);
+  EXPECT_EQ(decoded[0].trendline_num_deltas, record.trendline_num_deltas);
+  EXPECT_EQ(decoded[0].rate_control_state, record.rate_control_state);
+  EXPECT_EQ(decoded[0].link_capacity_estimate, record.link_capacity_estimate);
+  EXPECT_EQ(decoded[0].probe_state, record.probe_state);
+  EXPECT_TRUE(decoded[0].probe_in_alr);
+}
+
+TEST(BweTraceRecordTest, SkipsUnknownFieldsOfLargerRecords) {
+  rtc::ByteBufferWriter writer;
+  BweTraceRecord record;
+  record.at_time = Timestamp::Millis(1);
+  EncodeBweTraceRecord(record, &writer);
+  writer.WriteUInt32(0xdeadbeef);
+  record.at_time = Timestamp::Millis(2);
+  EncodeBweTraceRecord(record, &writer);
+  writer.WriteUInt32(0xdeadbeef);
+
+  rtc::ByteBufferReader reader(writer.Data(), writer.Length());
+  BweTraceRecord decoded;
+  ASSERT_TRUE(DecodeBweTraceRecord(&reader, kBweTraceRecordSize + 4, &decoded));
+  EXPECT_EQ(decoded.at_time, Timestamp::Millis(1));
+  ASSERT_TRUE(DecodeBweTraceRecord(&reader, kBweTraceRecordSize + 4, &decoded));
+  EXPECT_EQ(decoded.at_time, Timestamp::Millis(2));
+  EXPECT_FALSE(DecodeBweTraceRecord(&reader, kBweTraceRecordSize, &decoded));
+}
+
+TEST(BweTraceRecordTest, RejectsInvalidHeader) {
+  rtc::ByteBufferWriter writer;
+  writer.WriteString("NOTATRACE0123456");
+  rtc::ByteBufferReader reader(writer.Data(), writer.Length());
+  size_t record_size;
+  EXPECT_FALSE(DecodeBweTraceHeader(&reader, &record_size));
+}
+
+TEST(BweTraceRecorderTest, KeepsLastRecordsInRingBuffer) {
+  BweTraceRecorder recorder(/*output=*/nullptr, /*capacity=*/4);
+  std::vector<Timestamp> feedback_times =
+      SendPacketsWithFeedback(&recorder, /*num_packets=*/10);
+
+  std::vector<BweTraceRecord> records = recorder.GetRecords();
+  ASSERT_EQ(records.size(), 4u);
+  for (size_t i = 0; i < records.size(); ++i) {
+    EXPECT_EQ(records[i].at_time, feedback_times[6 + i]);
+    EXPECT_TRUE(records[i].target_rate.IsFinite());
+    EXPECT_TRUE(records[i].delay_based_estimate.IsFinite());
+  }
+  EXPECT_GT(records.back().trendline_num_deltas, 0);
+}
+
+TEST(BweTraceRecorderTest, StreamsAllRecordsToOutputInBatches) {
+  std::string trace;
+  auto output = std::make_unique<StringOutput>(&trace);
+  StringOutput* output_ptr = output.get();
+  std::vector<Timestamp> feedback_times;
+  {
+    BweTraceRecorder recorder(std::move(output), /*capacity=*/8);
+    feedback_times = SendPacketsWithFeedback(&recorder, /*num_packets=*/21);
+    // Five batches of half the capacity have been written.
+    EXPECT_EQ(output_ptr->num_writes(), 5);
+    EXPECT_EQ(trace.size(), kBweTraceHeaderSize + 20 * kBweTraceRecordSize);
+    // The last record is written when the recorder is destroyed.
+  }
+
+  std::vector<BweTraceRecord> records = DecodeTrace(trace);
+  ASSERT_EQ(records.size(), feedback_times.size());
+  for (size_t i = 0; i < records.size(); ++i) {
+    EXPECT_EQ(records[i].at_time, feedback_times[i]);
+  }
+}
+
+}  // namespace
+}  // namespace webrtc
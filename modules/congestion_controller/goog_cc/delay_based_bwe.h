@@ -85,6 +85,7 @@ class DelayBasedBwe {
   DataRate last_estimate() const { return prev_bitrate_; }
 
  private:
+  friend class BweTraceRecorder;
   friend class GoogCcStatePrinter;
   void IncomingPacketFeedback(const PacketResult& packet_feedback,
                               Timestamp at_time);
@@ -0,0 +1,112 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/goog_cc/ecn_based_bwe.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/network/ecn_marking.h"
+
+namespace webrtc {
+namespace {
+
+constexpr char kEcnBasedBweFieldTrial[] = "WebRTC-Bwe-EcnBasedBwe";
+
+EcnBasedBweConfig GetConfigFromTrials(
+    const WebRtcKeyValueConfig* key_value_config) {
+  EcnBasedBweConfig config;
+  config.Parser()->Parse(key_value_config->Lookup(kEcnBasedBweFieldTrial));
+  return config;
+}
+
+}  // namespace
+
+std::unique_ptr<StructParametersParser> EcnBasedBweConfig::Parser() {
+  return StructParametersParser::Create(                  //
+      "Enabled", &enabled,                                //
+      "Gain", &gain,                                      //
+      "AdditiveIncrease", &additive_increase,             //
+      "UnmarkedRoundsToReset", &unmarked_rounds_to_reset,  //
+      "MinRoundDuration", &min_round_duration);
+}
+
+EcnBasedBwe::EcnBasedBwe(EcnBasedBweConfig config) : config_(config) {
+  RTC_DCHECK_GT(config_.gain, 0.0);
+  RTC_DCHECK_LE(config_.gain, 1.0);
+  RTC_DCHECK_GT(config_.min_round_duration, TimeDelta::Zero());
+}
+
+EcnBasedBwe::EcnBasedBwe(const WebRtcKeyValueConfig* key_value_config)
+    : EcnBasedBwe(GetConfigFromTrials(key_value_config)) {}
+
+EcnBasedBwe::~EcnBasedBwe() = default;
+
+bool EcnBasedBwe::IsEnabled(const WebRtcKeyValueConfig* key_value_config) {
+  return GetConfigFromTrials(key_value_config).enabled;
+}
+
+void EcnBasedBwe::OnTransportPacketsFeedback(
+    const TransportPacketsFeedback& report,
+    absl::optional<DataRate> acknowledged_bitrate,
+    TimeDelta round_trip_time) {
+  // The first feedback only starts the first round.
+  if (round_start_.IsInfinite()) {
+    round_start_ = report.feedback_time;
+    return;
+  }
+  for (const PacketResult& packet : report.packet_feedbacks) {
+    if (!packet.IsReceived() || packet.ecn == rtc::EcnMarking::kNotEct)
+      continue;
+    ++ect_packets_in_round_;
+    if (packet.ecn == rtc::EcnMarking::kCe)
+      ++ce_packets_in_round_;
+  }
+  const TimeDelta round_duration =
+      std::max(round_trip_time, config_.min_round_duration);
+  if (report.feedback_time - round_start_ >= round_duration) {
+    EndRound(report.feedback_time, acknowledged_bitrate, round_duration);
+  }
+}
+
+void EcnBasedBwe::EndRound(Timestamp at_time,
+                           absl::optional<DataRate> acknowledged_bitrate,
+                           TimeDelta round_duration) {
+  round_start_ = at_time;
+  if (ect_packets_in_round_ == 0)
+    return;
+  const double ce_fraction =
+      static_cast<double>(ce_packets_in_round_) / ect_packets_in_round_;
+  alpha_ = (1 - config_.gain) * alpha_ + config_.gain * ce_fraction;
+
+  if (ce_packets_in_round_ > 0) {
+    unmarked_rounds_ = 0;
+    DataRate rate = limit_;
+    if (acknowledged_bitrate)
+      rate = std::min(rate, *acknowledged_bitrate);
+    if (rate.IsFinite()) {
+      limit_ = rate * (1 - alpha_ / 2);
+    }
+  } else if (limit_.IsFinite()) {
+    if (++unmarked_rounds_ >= config_.unmarked_rounds_to_reset) {
+      RTC_LOG(LS_INFO) << "Removing ECN based limit after " << unmarked_rounds_
+                       << " unmarked round trips.";
+      limit_ = DataRate::PlusInfinity();
+      unmarked_rounds_ = 0;
+    } else {
+      limit_ += config_.additive_increase / round_duration;
+    }
+  }
+  ect_packets_in_round_ = 0;
+  ce_packets_in_round_ = 0;
+}
+
+}  // namespace webrtc
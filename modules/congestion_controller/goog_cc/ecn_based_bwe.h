@@ -0,0 +1,83 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_CONGESTION_CONTROLLER_GOOG_CC_ECN_BASED_BWE_H_
+#define MODULES_CONGESTION_CONTROLLER_GOOG_CC_ECN_BASED_BWE_H_
+
+#include <memory>
+
+#include "absl/types/optional.h"
+#include "api/transport/network_types.h"
+#include "api/transport/webrtc_key_value_config.h"
+#include "api/units/data_rate.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/experiments/struct_parameters_parser.h"
+
+namespace webrtc {
+
+struct EcnBasedBweConfig {
+  bool enabled = false;
+  // Gain of the moving average of the fraction of CE marked packets.
+  double gain = 1.0 / 16;
+  // The limit is increased by this much per round trip without CE marks.
+  DataSize additive_increase = DataSize::Bytes(1200);
+  // The limit is removed after this many round trips without CE marks.
+  int unmarked_rounds_to_reset = 10;
+  // Lower bound of the round trip time, that sets how often the limit is
+  // updated.
+  TimeDelta min_round_duration = TimeDelta::Millis(10);
+  std::unique_ptr<StructParametersParser> Parser();
+};
+
+// Scalable congestion response to ECN CE marks, as used by L4S senders,
+// RFC 9331. Once per round trip, the fraction of ECN capable packets that
+// were CE marked is averaged into `alpha`, and if any packet was marked the
+// rate is reduced by `alpha / 2`, like DCTCP, RFC 8257. Since L4S queues mark
+// shallowly, this backs off before delay builds up. The limit is raised
+// additively while there are no marks, and removed after a while, so that
+// the other estimators take over again on paths that stop marking.
+//
+// Packets that were not sent or not received as ECN capable are ignored.
+class EcnBasedBwe {
+ public:
+  explicit EcnBasedBwe(EcnBasedBweConfig config);
+  explicit EcnBasedBwe(const WebRtcKeyValueConfig* key_value_config);
+  ~EcnBasedBwe();
+
+  static bool IsEnabled(const WebRtcKeyValueConfig* key_value_config);
+
+  void OnTransportPacketsFeedback(
+      const TransportPacketsFeedback& report,
+      absl::optional<DataRate> acknowledged_bitrate,
+      TimeDelta round_trip_time);
+
+  // Returns PlusInfinity if there is no limit.
+  DataRate GetLimit() const { return limit_; }
+  double alpha() const { return alpha_; }
+
+ private:
+  void EndRound(Timestamp at_time,
+                absl::optional<DataRate> acknowledged_bitrate,
+                TimeDelta round_duration);
+
+  const EcnBasedBweConfig config_;
+  Timestamp round_start_ = Timestamp::MinusInfinity();
+  int ect_packets_in_round_ = 0;
+  int ce_packets_in_round_ = 0;
+  int unmarked_rounds_ = 0;
+  double alpha_ = 1.0;
+  DataRate limit_ = DataRate::PlusInfinity();
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_CONGESTION_CONTROLLER_GOOG_CC_ECN_BASED_BWE_H_
@@ -0,0 +1,115 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/goog_cc/ecn_based_bwe.h"
+
+#include "rtc_base/network/ecn_marking.h"
+#include "test/explicit_key_value_config.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr TimeDelta kRtt = TimeDelta::Millis(50);
+constexpr DataRate kAckedRate = DataRate::KilobitsPerSec(1000);
+
+// Returns one round trip of feedback for `num_packets` packets, of which
+// the first `num_ce` are CE marked and the rest marked `ecn`.
+TransportPacketsFeedback CreateFeedback(Timestamp feedback_time,
+                                        int num_packets,
+                                        int num_ce,
+                                        rtc::EcnMarking ecn) {
+  TransportPacketsFeedback report;
+  report.feedback_time = feedback_time;
+  for (int i = 0; i < num_packets; ++i) {
+    PacketResult packet;
+    packet.sent_packet.send_time = feedback_time - kRtt;
+    packet.sent_packet.size = DataSize::Bytes(1200);
+    packet.receive_time = feedback_time - kRtt / 2;
+    packet.ecn = i < num_ce ? rtc::EcnMarking::kCe : ecn;
+    report.packet_feedbacks.push_back(packet);
+  }
+  return report;
+}
+
+class EcnBasedBweTest : public ::testing::Test {
+ protected:
+  // Feeds one round trip of feedback and returns the limit after it.
+  DataRate FeedRound(int num_packets,
+                     int num_ce,
+                     rtc::EcnMarking ecn = rtc::EcnMarking::kEct1) {
+    now_ += kRtt;
+    bwe_.OnTransportPacketsFeedback(
+        CreateFeedback(now_, num_packets, num_ce, ecn), kAckedRate, kRtt);
+    return bwe_.GetLimit();
+  }
+
+  Timestamp now_ = Timestamp::Seconds(100);
+  EcnBasedBwe bwe_{EcnBasedBweConfig()};
+};
+
+TEST(EcnBasedBweConfigTest, DisabledByDefault) {
+  test::ExplicitKeyValueConfig field_trials("");
+  EXPECT_FALSE(EcnBasedBwe::IsEnabled(&field_trials));
+  test::ExplicitKeyValueConfig enabled(
+      "WebRTC-Bwe-EcnBasedBwe/Enabled:true/");
+  EXPECT_TRUE(EcnBasedBwe::IsEnabled(&enabled));
+}
+
+TEST_F(EcnBasedBweTest, NoLimitWithoutCeMarks) {
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_TRUE(FeedRound(/*num_packets=*/20, /*num_ce=*/0).IsPlusInfinity());
+  }
+  EXPECT_LT(bwe_.alpha(), 1.0);
+}
+
+TEST_F(EcnBasedBweTest, IgnoresPacketsThatAreNotEcnCapable) {
+  FeedRound(/*num_packets=*/20, /*num_ce=*/0, rtc::EcnMarking::kNotEct);
+  FeedRound(/*num_packets=*/20, /*num_ce=*/0, rtc::EcnMarking::kNotEct);
+  EXPECT_EQ(bwe_.alpha(), 1.0);
+  EXPECT_TRUE(bwe_.GetLimit().IsPlusInfinity());
+}
+
+TEST_F(EcnBasedBweTest, ReducesOncePerRoundInProportionToMarking) {
+  FeedRound(/*num_packets=*/20, /*num_ce=*/0);
+  // With the initial alpha of 1, the first marks halve the rate.
+  const DataRate first_limit = FeedRound(/*num_packets=*/20, /*num_ce=*/20);
+  EXPECT_NEAR(first_limit.kbps(), kAckedRate.kbps() / 2, 1);
+
+  // Feedback within the same round doesn't reduce the limit again.
+  now_ += kRtt / 5;
+  bwe_.OnTransportPacketsFeedback(
+      CreateFeedback(now_, 20, 20, rtc::EcnMarking::kEct1), kAckedRate, kRtt);
+  EXPECT_EQ(bwe_.GetLimit(), first_limit);
+
+  // Sparse marking, as from a shallow L4S queue, only backs off slightly
+  // once alpha has adapted.
+  for (int i = 0; i < 100; ++i) {
+    FeedRound(/*num_packets=*/20, /*num_ce=*/1);
+  }
+  EXPECT_NEAR(bwe_.alpha(), 0.05, 0.01);
+  const DataRate limit = bwe_.GetLimit();
+  EXPECT_GT(FeedRound(/*num_packets=*/20, /*num_ce=*/1), limit * 0.95);
+}
+
+TEST_F(EcnBasedBweTest, IncreasesAdditivelyAndResetsWithoutMarks) {
+  FeedRound(/*num_packets=*/20, /*num_ce=*/0);
+  const DataRate limit = FeedRound(/*num_packets=*/20, /*num_ce=*/20);
+  ASSERT_TRUE(limit.IsFinite());
+  const DataRate increase = DataSize::Bytes(1200) / kRtt;
+  EXPECT_EQ(FeedRound(/*num_packets=*/20, /*num_ce=*/0), limit + increase);
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_TRUE(FeedRound(/*num_packets=*/20, /*num_ce=*/0).IsFinite());
+  }
+  EXPECT_TRUE(FeedRound(/*num_packets=*/20, /*num_ce=*/0).IsPlusInfinity());
+}
+
+}  // namespace
+}  // namespace webrtc
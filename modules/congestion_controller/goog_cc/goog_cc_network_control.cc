@@ -25,6 +25,7 @@
 #include "api/units/time_delta.h"
 #include "logging/rtc_event_log/events/rtc_event_remote_estimate.h"
 #include "modules/congestion_controller/goog_cc/alr_detector.h"
+#include "modules/congestion_controller/goog_cc/bwe_trace_recorder.h"
 #include "modules/congestion_controller/goog_cc/probe_controller.h"
 #include "modules/remote_bitrate_estimator/include/bwe_defines.h"
 #include "modules/remote_bitrate_estimator/test/bwe_test_logging.h"
@@ -73,6 +74,7 @@ GoogCcNetworkController::GoogCcNetworkController(NetworkControllerConfig config,
     : key_value_config_(config.key_value_config ? config.key_value_config
                                                 : &trial_based_config_),
       event_log_(config.event_log),
+      bwe_trace_recorder_(goog_cc_config.bwe_trace_recorder),
       packet_feedback_only_(goog_cc_config.feedback_only),
       safe_reset_on_route_change_("Enabled"),
       safe_reset_acknowledged_rate_("ack"),
@@ -109,6 +111,9 @@ GoogCcNetworkController::GoogCcNetworkController(NetworkControllerConfig config,
                                          network_state_predictor_.get())),
       acknowledged_bitrate_estimator_(
           AcknowledgedBitrateEstimatorInterface::Create(key_value_config_)),
+      ecn_based_bwe_(EcnBasedBwe::IsEnabled(key_value_config_)
+                         ? std::make_unique<EcnBasedBwe>(key_value_config_)
+                         : nullptr),
       initial_config_(config),
       last_loss_based_target_rate_(*config.constraints.starting_rate),
       last_pushback_target_rate_(last_loss_based_target_rate_),
@@ -166,6 +171,8 @@ NetworkControlUpdate GoogCcNetworkController::OnNetworkRouteChange(
     network_estimator_->OnRouteChange(msg);
   delay_based_bwe_.reset(new DelayBasedBwe(key_value_config_, event_log_,
                                            network_state_predictor_.get()));
+  if (ecn_based_bwe_)
+    ecn_based_bwe_ = std::make_unique<EcnBasedBwe>(key_value_config_);
   bandwidth_estimation_->OnRouteChange();
   probe_controller_->Reset(msg.at_time.ms());
   NetworkControlUpdate update;
@@ -554,6 +561,16 @@ NetworkControlUpdate GoogCcNetworkController::OnTransportPacketsFeedback(
     // Update the estimate in the ProbeController, in case we want to probe.
     MaybeTriggerOnNetworkChanged(&update, report.feedback_time);
   }
+  if (ecn_based_bwe_) {
+    const DataRate prev_limit = ecn_based_bwe_->GetLimit();
+    ecn_based_bwe_->OnTransportPacketsFeedback(
+        report, acknowledged_bitrate, bandwidth_estimation_->round_trip_time());
+    if (ecn_based_bwe_->GetLimit() != prev_limit) {
+      bandwidth_estimation_->UpdateEcnBasedEstimate(
+          report.feedback_time, ecn_based_bwe_->GetLimit());
+      MaybeTriggerOnNetworkChanged(&update, report.feedback_time);
+    }
+  }
   recovered_from_overuse = result.recovered_from_overuse;
   backoff_in_alr = result.backoff_in_alr;
 
@@ -582,6 +599,10 @@ NetworkControlUpdate GoogCcNetworkController::OnTransportPacketsFeedback(
     update.congestion_window = current_data_window_;
   }
 
+  if (bwe_trace_recorder_) {
+    bwe_trace_recorder_->Record(*this, report.feedback_time);
+  }
+
   return update;
 }
 
@@ -31,16 +31,21 @@
 #include "modules/congestion_controller/goog_cc/alr_detector.h"
 #include "modules/congestion_controller/goog_cc/congestion_window_pushback_controller.h"
 #include "modules/congestion_controller/goog_cc/delay_based_bwe.h"
+#include "modules/congestion_controller/goog_cc/ecn_based_bwe.h"
 #include "modules/congestion_controller/goog_cc/probe_controller.h"
 #include "modules/congestion_controller/goog_cc/send_side_bandwidth_estimation.h"
 #include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/experiments/rate_control_settings.h"
 
 namespace webrtc {
+class BweTraceRecorder;
+
 struct GoogCcConfig {
   std::unique_ptr<NetworkStateEstimator> network_state_estimator = nullptr;
   std::unique_ptr<NetworkStatePredictor> network_state_predictor = nullptr;
   bool feedback_only = false;
+  // Records the state after each transport feedback, if set.
+  BweTraceRecorder* bwe_trace_recorder = nullptr;
 };
 
 class GoogCcNetworkController : public NetworkControllerInterface {
@@ -74,6 +79,7 @@ class GoogCcNetworkController : public NetworkControllerInterface {
   NetworkControlUpdate GetNetworkState(Timestamp at_time) const;
 
  private:
+  friend class BweTraceRecorder;
   friend class GoogCcStatePrinter;
   std::vector<ProbeClusterConfig> ResetConstraints(
       TargetRateConstraints new_constraints);
@@ -86,6 +92,7 @@ class GoogCcNetworkController : public NetworkControllerInterface {
 
   const WebRtcKeyValueConfig* const key_value_config_;
   RtcEventLog* const event_log_;
+  BweTraceRecorder* const bwe_trace_recorder_;
   const bool packet_feedback_only_;
   FieldTrialFlag safe_reset_on_route_change_;
   FieldTrialFlag safe_reset_acknowledged_rate_;
@@ -107,6 +114,8 @@ class GoogCcNetworkController : public NetworkControllerInterface {
   std::unique_ptr<DelayBasedBwe> delay_based_bwe_;
   std::unique_ptr<AcknowledgedBitrateEstimatorInterface>
       acknowledged_bitrate_estimator_;
+  // Only set if enabled by field trial.
+  std::unique_ptr<EcnBasedBwe> ecn_based_bwe_;
 
   absl::optional<NetworkControllerConfig> initial_config_;
 
@@ -556,27 +556,37 @@ LossBasedBweV2::Derivatives LossBasedBweV2::GetDerivatives(
     const ChannelParameters& channel_parameters) const {
   Derivatives derivatives;
 
-  for (const Observation& observation : observations_) {
-    if (!observation.IsInitialized()) {
-      continue;
-    }
-
+  auto add_observations = [&](double num_lost_packets,
+                              double num_received_packets,
+                              DataRate sending_rate) {
     double loss_probability = GetLossProbability(
         channel_parameters.inherent_loss,
-        channel_parameters.loss_limited_bandwidth, observation.sending_rate);
+        channel_parameters.loss_limited_bandwidth, sending_rate);
 
-    double temporal_weight =
-        temporal_weights_[(num_observations_ - 1) - observation.id];
-
-    derivatives.first +=
-        temporal_weight *
-        ((observation.num_lost_packets / loss_probability) -
-         (observation.num_received_packets / (1.0 - loss_probability)));
+    derivatives.first += (num_lost_packets / loss_probability) -
+                         (num_received_packets / (1.0 - loss_probability));
     derivatives.second -=
-        temporal_weight *
-        ((observation.num_lost_packets / std::pow(loss_probability, 2)) +
-         (observation.num_received_packets /
-          std::pow(1.0 - loss_probability, 2)));
+        (num_lost_packets / (loss_probability * loss_probability)) +
+        (num_received_packets /
+         ((1.0 - loss_probability) * (1.0 - loss_probability)));
+  };
+
+  // The loss probability of the observations sent no faster than the
+  // bandwidth is the inherent loss, so they are added together.
+  const size_t num_within_bandwidth = GetNumObservationsWithinBandwidth(
+      channel_parameters.loss_limited_bandwidth);
+  if (num_within_bandwidth > 0) {
+    const WeightedObservation& weighted =
+        weighted_observations_[num_within_bandwidth - 1];
+    add_observations(weighted.cumulative_num_lost_packets,
+                     weighted.cumulative_num_received_packets,
+                     weighted.observation.sending_rate);
+  }
+  for (size_t i = num_within_bandwidth; i < weighted_observations_.size();
+       ++i) {
+    const WeightedObservation& weighted = weighted_observations_[i];
+    add_observations(weighted.num_lost_packets, weighted.num_received_packets,
+                     weighted.observation.sending_rate);
   }
 
   if (derivatives.second >= 0.0) {
@@ -621,28 +631,37 @@ double LossBasedBweV2::GetObjective(
     const ChannelParameters& channel_parameters) const {
   double objective = 0.0;
 
-  const double high_bandwidth_bias =
-      GetHighBandwidthBias(channel_parameters.loss_limited_bandwidth);
-
-  for (const Observation& observation : observations_) {
-    if (!observation.IsInitialized()) {
-      continue;
-    }
-
+  auto add_observations = [&](double num_lost_packets,
+                              double num_received_packets,
+                              DataRate sending_rate) {
     double loss_probability = GetLossProbability(
         channel_parameters.inherent_loss,
-        channel_parameters.loss_limited_bandwidth, observation.sending_rate);
+        channel_parameters.loss_limited_bandwidth, sending_rate);
 
-    double temporal_weight =
-        temporal_weights_[(num_observations_ - 1) - observation.id];
+    objective += (num_lost_packets * std::log(loss_probability)) +
+                 (num_received_packets * std::log(1.0 - loss_probability));
+  };
 
-    objective +=
-        temporal_weight *
-        ((observation.num_lost_packets * std::log(loss_probability)) +
-         (observation.num_received_packets * std::log(1.0 - loss_probability)));
-    objective +=
-        temporal_weight * high_bandwidth_bias * observation.num_packets;
+  // See GetDerivatives().
+  const size_t num_within_bandwidth = GetNumObservationsWithinBandwidth(
+      channel_parameters.loss_limited_bandwidth);
+  if (num_within_bandwidth > 0) {
+    const WeightedObservation& weighted =
+        weighted_observations_[num_within_bandwidth - 1];
+    add_observations(weighted.cumulative_num_lost_packets,
+                     weighted.cumulative_num_received_packets,
+                     weighted.observation.sending_rate);
   }
+  for (size_t i = num_within_bandwidth; i < weighted_observations_.size();
+       ++i) {
+    const WeightedObservation& weighted = weighted_observations_[i];
+    add_observations(weighted.num_lost_packets, weighted.num_received_packets,
+                     weighted.observation.sending_rate);
+  }
+
+  objective +=
+      GetHighBandwidthBias(channel_parameters.loss_limited_bandwidth) *
+      weighted_num_packets_;
 
   return objective;
 }
@@ -689,6 +708,62 @@ void LossBasedBweV2::CalculateTemporalWeights() {
   }
 }
 
+void LossBasedBweV2::UpdateWeightedObservations(
+    const Observation& new_observation) {
+  // Replace the observation that dropped out of the window, keeping the
+  // observations sorted.
+  const int oldest_id =
+      new_observation.id - config_->observation_window_size + 1;
+  weighted_observations_.erase(
+      std::remove_if(weighted_observations_.begin(),
+                     weighted_observations_.end(),
+                     [&](const WeightedObservation& weighted) {
+                       return weighted.observation.id < oldest_id;
+                     }),
+      weighted_observations_.end());
+  auto position = absl::c_upper_bound(
+      weighted_observations_, new_observation.sending_rate,
+      [](DataRate sending_rate, const WeightedObservation& weighted) {
+        return sending_rate < weighted.observation.sending_rate;
+      });
+  weighted_observations_.insert(position, WeightedObservation())->observation =
+      new_observation;
+
+  // All temporal weights change with a new observation.
+  weighted_num_packets_ = 0.0;
+  double cumulative_num_lost_packets = 0.0;
+  double cumulative_num_received_packets = 0.0;
+  for (WeightedObservation& weighted : weighted_observations_) {
+    const Observation& observation = weighted.observation;
+    const double temporal_weight =
+        temporal_weights_[(num_observations_ - 1) - observation.id];
+    weighted.num_lost_packets = temporal_weight * observation.num_lost_packets;
+    weighted.num_received_packets =
+        temporal_weight * observation.num_received_packets;
+    weighted_num_packets_ += temporal_weight * observation.num_packets;
+    cumulative_num_lost_packets += weighted.num_lost_packets;
+    cumulative_num_received_packets += weighted.num_received_packets;
+    weighted.cumulative_num_lost_packets = cumulative_num_lost_packets;
+    weighted.cumulative_num_received_packets =
+        cumulative_num_received_packets;
+  }
+}
+
+size_t LossBasedBweV2::GetNumObservationsWithinBandwidth(
+    DataRate bandwidth) const {
+  if (!IsValid(bandwidth)) {
+    // The loss probability is the inherent loss for all observations.
+    return weighted_observations_.size();
+  }
+  return absl::c_upper_bound(weighted_observations_, bandwidth,
+                             [](DataRate bandwidth,
+                                const WeightedObservation& weighted) {
+                               return bandwidth <
+                                      weighted.observation.sending_rate;
+                             }) -
+         weighted_observations_.begin();
+}
+
 void LossBasedBweV2::NewtonsMethodUpdate(
     ChannelParameters& channel_parameters) const {
   if (num_observations_ <= 0) {
@@ -748,6 +823,7 @@ bool LossBasedBweV2::PushBackObservation(
 
   partial_observation_ = PartialObservation();
 
+  UpdateWeightedObservations(observation);
   CalculateInstantUpperBound();
   return true;
 }
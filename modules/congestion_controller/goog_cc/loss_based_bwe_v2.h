@@ -97,6 +97,17 @@ class LossBasedBweV2 {
     int id = -1;
   };
 
+  // An observation with its packet counts scaled by its temporal weight.
+  // The cumulative counts are those of the observations in
+  // `weighted_observations_` up to and including this one.
+  struct WeightedObservation {
+    Observation observation;
+    double num_lost_packets = 0.0;
+    double num_received_packets = 0.0;
+    double cumulative_num_lost_packets = 0.0;
+    double cumulative_num_received_packets = 0.0;
+  };
+
   struct PartialObservation {
     int num_packets = 0;
     int num_lost_packets = 0;
@@ -123,6 +134,10 @@ class LossBasedBweV2 {
   void CalculateInstantUpperBound();
 
   void CalculateTemporalWeights();
+  void UpdateWeightedObservations(const Observation& new_observation);
+  // Returns the number of `weighted_observations_` with a sending rate of at
+  // most `bandwidth`.
+  size_t GetNumObservationsWithinBandwidth(DataRate bandwidth) const;
   void NewtonsMethodUpdate(ChannelParameters& channel_parameters) const;
 
   // Returns false if no observation was created.
@@ -139,6 +154,11 @@ class LossBasedBweV2 {
   absl::optional<DataRate> cached_instant_upper_bound_;
   std::vector<double> instant_upper_bound_temporal_weights_;
   std::vector<double> temporal_weights_;
+  // The observations in the window, sorted by sending rate. Updated when an
+  // observation is added, so that evaluating a candidate only needs the loss
+  // model for the observations sent faster than its bandwidth.
+  std::vector<WeightedObservation> weighted_observations_;
+  double weighted_num_packets_ = 0.0;
 };
 
 }  // namespace webrtc
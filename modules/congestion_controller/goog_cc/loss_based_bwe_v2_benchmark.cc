@@ -0,0 +1,87 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "api/transport/network_types.h"
+#include "api/units/data_rate.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "benchmark/benchmark.h"
+#include "modules/congestion_controller/goog_cc/loss_based_bwe_v2.h"
+#include "rtc_base/random.h"
+#include "rtc_base/system/unused.h"
+#include "test/explicit_key_value_config.h"
+
+namespace webrtc {
+namespace {
+
+constexpr DataSize kPacketSize = DataSize::Bytes(1200);
+constexpr TimeDelta kFeedbackInterval = TimeDelta::Millis(50);
+constexpr DataRate kStartRate = DataRate::KilobitsPerSec(2000);
+constexpr DataRate kLinkCapacity = DataRate::KilobitsPerSec(2500);
+constexpr double kInherentLoss = 0.01;
+
+// Feeds the estimator with feedback as sent by a receiver every
+// `kFeedbackInterval`, for a sender that follows the estimate over a link
+// with random loss, that drops what is sent beyond its capacity. Every
+// feedback completes an observation.
+void BM_UpdateBandwidthEstimate(benchmark::State& state) {
+  const int observation_window_size = state.range(0);
+  const test::ExplicitKeyValueConfig field_trials(
+      "WebRTC-Bwe-LossBasedBweV2/Enabled:true,NewtonIterations:2,"
+      "ObservationDurationLowerBound:50ms,ObservationWindowSize:" +
+      std::to_string(observation_window_size) + "/");
+  LossBasedBweV2 estimator(&field_trials);
+  estimator.SetBandwidthEstimate(kStartRate);
+  Random random(/*seed=*/42);
+  Timestamp send_time = Timestamp::Seconds(1);
+  std::vector<PacketResult> feedback;
+
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    DataRate estimate = estimator.GetBandwidthEstimate();
+    if (!estimate.IsFinite()) {
+      estimate = kStartRate;
+    }
+    const DataRate sending_rate =
+        estimate * (0.9 + 0.2 * random.Rand<double>());
+    const int num_packets = std::max<int>(
+        sending_rate * kFeedbackInterval / kPacketSize, 2);
+    const TimeDelta packet_interval = kFeedbackInterval / num_packets;
+    double loss_probability = kInherentLoss;
+    if (sending_rate > kLinkCapacity) {
+      loss_probability += (sending_rate - kLinkCapacity) / sending_rate;
+    }
+    feedback.resize(num_packets);
+    for (PacketResult& packet : feedback) {
+      send_time += packet_interval;
+      packet.sent_packet.send_time = send_time;
+      packet.sent_packet.size = kPacketSize;
+      packet.receive_time = random.Rand<double>() < loss_probability
+                                ? Timestamp::PlusInfinity()
+                                : send_time + TimeDelta::Millis(20);
+    }
+    estimator.SetAcknowledgedBitrate(std::min(sending_rate, kLinkCapacity));
+    estimator.UpdateBandwidthEstimate(feedback, DataRate::PlusInfinity());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_UpdateBandwidthEstimate)
+    ->ArgName("window")
+    ->Arg(20)
+    ->Arg(100);
+
+}  // namespace
+}  // namespace webrtc
@@ -101,6 +101,8 @@ class ProbeController {
       int64_t at_time_ms);
 
  private:
+  friend class BweTraceRecorder;
+
   enum class State {
     // Initial state where no probing has been triggered yet.
     kInit,
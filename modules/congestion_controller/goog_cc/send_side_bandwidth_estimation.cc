@@ -215,6 +215,7 @@ SendSideBandwidthEstimation::SendSideBandwidthEstimation(
       last_round_trip_time_(TimeDelta::Zero()),
       receiver_limit_(DataRate::PlusInfinity()),
       delay_based_limit_(DataRate::PlusInfinity()),
+      ecn_based_limit_(DataRate::PlusInfinity()),
       time_last_decrease_(Timestamp::MinusInfinity()),
       first_report_time_(Timestamp::MinusInfinity()),
       initially_lost_packets_(0),
@@ -264,6 +265,7 @@ void SendSideBandwidthEstimation::OnRouteChange() {
   last_round_trip_time_ = TimeDelta::Zero();
   receiver_limit_ = DataRate::PlusInfinity();
   delay_based_limit_ = DataRate::PlusInfinity();
+  ecn_based_limit_ = DataRate::PlusInfinity();
   time_last_decrease_ = Timestamp::MinusInfinity();
   first_report_time_ = Timestamp::MinusInfinity();
   initially_lost_packets_ = 0;
@@ -339,6 +341,12 @@ void SendSideBandwidthEstimation::UpdateDelayBasedEstimate(Timestamp at_time,
   ApplyTargetLimits(at_time);
 }
 
+void SendSideBandwidthEstimation::UpdateEcnBasedEstimate(Timestamp at_time,
+                                                         DataRate bitrate) {
+  ecn_based_limit_ = bitrate;
+  ApplyTargetLimits(at_time);
+}
+
 void SendSideBandwidthEstimation::SetAcknowledgedRate(
     absl::optional<DataRate> acknowledged_rate,
     Timestamp at_time) {
@@ -608,7 +616,7 @@ void SendSideBandwidthEstimation::UpdateMinHistory(Timestamp at_time) {
 }
 
 DataRate SendSideBandwidthEstimation::GetUpperLimit() const {
-  DataRate upper_limit = delay_based_limit_;
+  DataRate upper_limit = std::min(delay_based_limit_, ecn_based_limit_);
   if (disable_receiver_limit_caps_only_)
     upper_limit = std::min(upper_limit, receiver_limit_);
   return std::min(upper_limit, max_bitrate_configured_);
@@ -167,6 +167,25 @@ TEST(SendSideBweTest, SettingSendBitrateOverridesDelayBasedEstimate) {
   EXPECT_EQ(bwe.target_rate().bps(), kForcedHighBitrate);
 }
 
+TEST(SendSideBweTest, EcnBasedEstimateCapsTargetUntilRemoved) {
+  ::testing::NiceMock<MockRtcEventLog> event_log;
+  test::ExplicitKeyValueConfig key_value_config("");
+  SendSideBandwidthEstimation bwe(&key_value_config, &event_log);
+  const Timestamp now = Timestamp::Seconds(1);
+  const DataRate kInitialBitrate = DataRate::KilobitsPerSec(300);
+  const DataRate kEcnBasedBitrate = DataRate::KilobitsPerSec(200);
+
+  bwe.SetMinMaxBitrate(DataRate::KilobitsPerSec(10),
+                       DataRate::KilobitsPerSec(10000));
+  bwe.SetSendBitrate(kInitialBitrate, now);
+  bwe.UpdateEcnBasedEstimate(now, kEcnBasedBitrate);
+  EXPECT_EQ(bwe.target_rate(), kEcnBasedBitrate);
+
+  bwe.UpdateEcnBasedEstimate(now, DataRate::PlusInfinity());
+  bwe.SetSendBitrate(kInitialBitrate, now);
+  EXPECT_EQ(bwe.target_rate(), kInitialBitrate);
+}
+
 TEST(RttBasedBackoff, DefaultEnabled) {
   test::ExplicitKeyValueConfig key_value_config("");
   RttBasedBackoff rtt_backoff(&key_value_config);
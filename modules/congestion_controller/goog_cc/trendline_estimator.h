@@ -87,6 +87,7 @@ class TrendlineEstimator : public DelayIncreaseDetectorInterface {
   };
 
  private:
+  friend class BweTraceRecorder;
   friend class GoogCcStatePrinter;
   void Detect(double trend, double ts_delta, int64_t now_ms);
 
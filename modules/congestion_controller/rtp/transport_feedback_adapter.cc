@@ -214,8 +214,8 @@ TransportFeedbackAdapter::ProcessTransportFeedbackInner(
   size_t failed_lookups = 0;
   size_t ignored = 0;
   TimeDelta packet_offset = TimeDelta::Zero();
-  for (const auto& packet : feedback.GetAllPackets()) {
-    int64_t seq_num = seq_num_unwrapper_.Unwrap(packet.sequence_number());
+  feedback.ForAllPackets([&](uint16_t sequence_number, TimeDelta delta) {
+    int64_t seq_num = seq_num_unwrapper_.Unwrap(sequence_number);
 
     if (seq_num > last_ack_seq_num_) {
       // Starts at history_.begin() if last_ack_seq_num_ < 0, since any valid
@@ -230,7 +230,7 @@ TransportFeedbackAdapter::ProcessTransportFeedbackInner(
     auto it = history_.find(seq_num);
     if (it == history_.end()) {
       ++failed_lookups;
-      continue;
+      return;
     }
 
     if (it->second.sent.send_time.IsInfinite()) {
@@ -238,12 +238,12 @@ TransportFeedbackAdapter::ProcessTransportFeedbackInner(
       // DCHECK.
       RTC_DLOG(LS_ERROR)
           << "Received feedback before packet was indicated as sent";
-      continue;
+      return;
     }
 
     PacketFeedback packet_feedback = it->second;
-    if (packet.received()) {
-      packet_offset += packet.delta();
+    if (delta.IsFinite()) {
+      packet_offset += delta;
       packet_feedback.receive_time =
           current_offset_ + packet_offset.RoundDownTo(TimeDelta::Millis(1));
       // Note: Lost packets are not removed from history because they might be
@@ -258,7 +258,7 @@ TransportFeedbackAdapter::ProcessTransportFeedbackInner(
     } else {
       ++ignored;
     }
-  }
+  });
 
   if (failed_lookups > 0) {
     RTC_LOG(LS_WARNING) << "Failed to lookup send time for " << failed_lookups
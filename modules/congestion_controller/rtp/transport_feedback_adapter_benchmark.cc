@@ -0,0 +1,128 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "benchmark/benchmark.h"
+#include "modules/congestion_controller/rtp/transport_feedback_adapter.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/common_header.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/network/sent_packet.h"
+#include "rtc_base/system/unused.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint32_t kSsrc = 1234;
+constexpr size_t kPacketSize = 1200;
+// Feedback is sent every 50 ms. At 20 Mbps that is about 100 packets of
+// 1200 bytes per feedback.
+constexpr TimeDelta kFeedbackInterval = TimeDelta::Millis(50);
+
+// Builds the feedback for `num_packets` packets from `base_sequence_number`
+// on, received `kFeedbackInterval / num_packets` apart from `base_time`.
+// Every `loss_interval`th packet is lost, none if it is 0.
+rtc::Buffer BuildFeedback(uint16_t base_sequence_number,
+                          int num_packets,
+                          int loss_interval,
+                          Timestamp base_time) {
+  const TimeDelta packet_interval = kFeedbackInterval / num_packets;
+  rtcp::TransportFeedback feedback;
+  feedback.SetBase(base_sequence_number, base_time.us());
+  for (int i = 0; i < num_packets; ++i) {
+    // The last packet is always received, as trailing losses are not
+    // reported.
+    if (loss_interval > 0 && i % loss_interval == loss_interval - 1 &&
+        i != num_packets - 1) {
+      continue;
+    }
+    feedback.AddReceivedPacket(base_sequence_number + i,
+                               (base_time + packet_interval * i).us());
+  }
+  return feedback.Build();
+}
+
+void BM_ParseTransportFeedback(benchmark::State& state) {
+  const rtc::Buffer packet = BuildFeedback(
+      /*base_sequence_number=*/0xff00, state.range(0), state.range(1),
+      Timestamp::Seconds(1));
+  rtcp::TransportFeedback feedback(/*include_timestamps=*/true,
+                                   /*include_lost=*/state.range(2));
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    rtcp::CommonHeader header;
+    header.Parse(packet.data(), packet.size());
+    benchmark::DoNotOptimize(feedback.Parse(header));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// {packets per feedback, loss interval, include lost packets}.
+BENCHMARK(BM_ParseTransportFeedback)
+    ->ArgNames({"packets", "loss", "lost"})
+    ->Args({100, 0, 1})
+    ->Args({100, 0, 0})
+    ->Args({100, 10, 1})
+    ->Args({100, 10, 0})
+    ->Args({1000, 10, 1})
+    ->Args({1000, 10, 0});
+
+// Parses feedback as RTCPReceiver does and turns it into the
+// TransportPacketsFeedback that goes to the network controller.
+void BM_ProcessTransportFeedback(benchmark::State& state) {
+  const int num_packets = state.range(0);
+  const TimeDelta packet_interval = kFeedbackInterval / num_packets;
+  TransportFeedbackAdapter adapter;
+  rtcp::TransportFeedback feedback(/*include_timestamps=*/true,
+                                   /*include_lost=*/false);
+  uint16_t sequence_number = 0;
+  Timestamp now = Timestamp::Seconds(1);
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    state.PauseTiming();
+    const uint16_t base_sequence_number = sequence_number;
+    for (int i = 0; i < num_packets; ++i) {
+      RtpPacketSendInfo packet_info;
+      packet_info.media_ssrc = kSsrc;
+      packet_info.transport_sequence_number = sequence_number;
+      packet_info.length = kPacketSize;
+      packet_info.packet_type = RtpPacketMediaType::kVideo;
+      adapter.AddPacket(packet_info, /*overhead_bytes=*/0, now);
+      adapter.ProcessSentPacket(
+          rtc::SentPacket(sequence_number, now.ms(), rtc::PacketInfo()));
+      ++sequence_number;
+      now += packet_interval;
+    }
+    const rtc::Buffer packet = BuildFeedback(
+        base_sequence_number, num_packets, state.range(1), now);
+    now += kFeedbackInterval - packet_interval * num_packets;
+    state.ResumeTiming();
+
+    rtcp::CommonHeader header;
+    header.Parse(packet.data(), packet.size());
+    feedback.Parse(header);
+    benchmark::DoNotOptimize(adapter.ProcessTransportFeedback(feedback, now));
+  }
+  state.SetItemsProcessed(state.iterations() * num_packets);
+}
+
+// {packets per feedback, loss interval}.
+BENCHMARK(BM_ProcessTransportFeedback)
+    ->ArgNames({"packets", "loss"})
+    ->Args({100, 0})
+    ->Args({100, 10})
+    ->Args({1000, 10});
+
+}  // namespace
+}  // namespace webrtc
@@ -9,6 +9,7 @@
  */
 #include "modules/congestion_controller/rtp/transport_feedback_demuxer.h"
 #include "absl/algorithm/container.h"
+#include "api/units/time_delta.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
 
 namespace webrtc {
@@ -58,18 +59,18 @@ void TransportFeedbackDemuxer::OnTransportFeedback(
   std::vector<StreamFeedbackObserver::StreamPacketInfo> stream_feedbacks;
   {
     MutexLock lock(&lock_);
-    for (const auto& packet : feedback.GetAllPackets()) {
+    feedback.ForAllPackets([&](uint16_t sequence_number, TimeDelta delta) {
       int64_t seq_num =
-          seq_num_unwrapper_.UnwrapWithoutUpdate(packet.sequence_number());
+          seq_num_unwrapper_.UnwrapWithoutUpdate(sequence_number);
       auto it = history_.find(seq_num);
       if (it != history_.end()) {
         auto packet_info = it->second;
-        packet_info.received = packet.received();
+        packet_info.received = delta.IsFinite();
         stream_feedbacks.push_back(packet_info);
-        if (packet.received())
+        if (delta.IsFinite())
           history_.erase(it);
       }
-    }
+    });
   }
 
   MutexLock lock(&observers_lock_);
@@ -101,6 +101,13 @@ class RTC_EXPORT DesktopCaptureOptions {
     detect_updated_region_ = detect_updated_region;
   }
 
+  // Number of threads that compare the frames when detect_updated_region() is
+  // set. Worth raising for large screens, e.g. 4K and above.
+  int differ_threads() const { return differ_threads_; }
+  void set_differ_threads(int differ_threads) {
+    differ_threads_ = differ_threads;
+  }
+
 #if defined(WEBRTC_WIN)
   // Enumerating windows owned by the current process on Windows has some
   // complications due to |GetWindowText*()| APIs potentially causing a
@@ -195,6 +202,7 @@ class RTC_EXPORT DesktopCaptureOptions {
 #endif
   bool disable_effects_ = true;
   bool detect_updated_region_ = false;
+  int differ_threads_ = 1;
 #if defined(WEBRTC_USE_PIPEWIRE)
   bool allow_pipewire_ = false;
 #endif
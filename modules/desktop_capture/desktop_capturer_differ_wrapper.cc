@@ -13,18 +13,24 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "modules/desktop_capture/desktop_geometry.h"
 #include "modules/desktop_capture/desktop_region.h"
 #include "modules/desktop_capture/differ_block.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/time_utils.h"
 
 namespace webrtc {
 
 namespace {
 
+// Threads are only worth their start up for large areas.
+constexpr int kMinBlockRowsPerStripe = 4;
+
 // Returns true if (0, 0) - (`width`, `height`) vector in `old_buffer` and
 // `new_buffer` are equal. `width` should be less than 32
 // (defined by kBlockSize), otherwise BlockDifference() should be used.
@@ -45,6 +51,26 @@ bool PartialBlockDifference(const uint8_t* old_buffer,
   return false;
 }
 
+// Returns true if the `width` x `height` areas starting at `old_buffer` and
+// `new_buffer` differ. Unlike BlockDifference(), this compares whole lines, so
+// it's cheap to rule out unchanged block-rows, which most of a screen usually
+// is.
+bool LinesDifference(const uint8_t* old_buffer,
+                     const uint8_t* new_buffer,
+                     int width,
+                     int height,
+                     int stride) {
+  const int width_bytes = width * DesktopFrame::kBytesPerPixel;
+  for (int i = 0; i < height; i++) {
+    if (memcmp(old_buffer, new_buffer, width_bytes) != 0) {
+      return true;
+    }
+    old_buffer += stride;
+    new_buffer += stride;
+  }
+  return false;
+}
+
 // Compares columns in the range of [`left`, `right`), in a row in the
 // range of [`top`, `top` + `height`), starts from `old_buffer` and
 // `new_buffer`, and outputs updated regions into `output`. `stride` is the
@@ -60,6 +86,9 @@ void CompareRow(const uint8_t* old_buffer,
   const int block_x_offset = kBlockSize * DesktopFrame::kBytesPerPixel;
   const int width = right - left;
   const int height = bottom - top;
+  if (!LinesDifference(old_buffer, new_buffer, width, height, stride)) {
+    return;
+  }
   const int block_count = (width - 1) / kBlockSize;
   const int last_block_width = width - block_count * kBlockSize;
   RTC_DCHECK_GT(last_block_width, 0);
@@ -142,12 +171,60 @@ void CompareFrames(const DesktopFrame& old_frame,
              output);
 }
 
+// Splits `rect` into up to `num_threads` horizontal stripes, aligned to
+// kBlockSize so that the blocks are the same as in a single CompareFrames()
+// call, and compares them in parallel.
+void CompareFramesInStripes(const DesktopFrame& old_frame,
+                            const DesktopFrame& new_frame,
+                            DesktopRect rect,
+                            int num_threads,
+                            DesktopRegion* const output) {
+  rect.IntersectWith(DesktopRect::MakeSize(old_frame.size()));
+  const int block_rows = (rect.height() + kBlockSize - 1) / kBlockSize;
+  const int num_stripes =
+      std::min(num_threads, block_rows / kMinBlockRowsPerStripe);
+  if (num_stripes <= 1) {
+    CompareFrames(old_frame, new_frame, rect, output);
+    return;
+  }
+
+  std::vector<DesktopRect> stripes;
+  int top = rect.top();
+  for (int i = 0; i < num_stripes; i++) {
+    const int stripe_block_rows =
+        block_rows / num_stripes + (i < block_rows % num_stripes ? 1 : 0);
+    const int bottom =
+        std::min(top + stripe_block_rows * kBlockSize, rect.bottom());
+    stripes.push_back(
+        DesktopRect::MakeLTRB(rect.left(), top, rect.right(), bottom));
+    top = bottom;
+  }
+
+  std::vector<DesktopRegion> stripe_outputs(num_stripes);
+  std::vector<rtc::PlatformThread> threads;
+  for (int i = 1; i < num_stripes; i++) {
+    threads.push_back(rtc::PlatformThread::SpawnJoinable(
+        [&old_frame, &new_frame, &stripes, &stripe_outputs, i] {
+          CompareFrames(old_frame, new_frame, stripes[i], &stripe_outputs[i]);
+        },
+        "DifferStripe"));
+  }
+  CompareFrames(old_frame, new_frame, stripes[0], &stripe_outputs[0]);
+  // Joins the threads.
+  threads.clear();
+  for (const DesktopRegion& stripe_output : stripe_outputs) {
+    output->AddRegion(stripe_output);
+  }
+}
+
 }  // namespace
 
 DesktopCapturerDifferWrapper::DesktopCapturerDifferWrapper(
-    std::unique_ptr<DesktopCapturer> base_capturer)
-    : base_capturer_(std::move(base_capturer)) {
+    std::unique_ptr<DesktopCapturer> base_capturer,
+    int num_threads)
+    : base_capturer_(std::move(base_capturer)), num_threads_(num_threads) {
   RTC_DCHECK(base_capturer_);
+  RTC_DCHECK_GE(num_threads_, 1);
 }
 
 DesktopCapturerDifferWrapper::~DesktopCapturerDifferWrapper() {}
@@ -208,8 +285,8 @@ void DesktopCapturerDifferWrapper::OnCaptureResult(
     DesktopRegion hints;
     hints.Swap(frame->mutable_updated_region());
     for (DesktopRegion::Iterator it(hints); !it.IsAtEnd(); it.Advance()) {
-      CompareFrames(*last_frame_, *frame, it.rect(),
-                    frame->mutable_updated_region());
+      CompareFramesInStripes(*last_frame_, *frame, it.rect(), num_threads_,
+                             frame->mutable_updated_region());
     }
   } else {
     frame->mutable_updated_region()->SetRect(
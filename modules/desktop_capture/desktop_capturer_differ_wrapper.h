@@ -36,9 +36,11 @@ class RTC_EXPORT DesktopCapturerDifferWrapper
       public DesktopCapturer::Callback {
  public:
   // Creates a DesktopCapturerDifferWrapper with a DesktopCapturer
-  // implementation, and takes its ownership.
+  // implementation, and takes its ownership. Large updated regions are split
+  // into stripes that are compared on up to `num_threads` threads.
   explicit DesktopCapturerDifferWrapper(
-      std::unique_ptr<DesktopCapturer> base_capturer);
+      std::unique_ptr<DesktopCapturer> base_capturer,
+      int num_threads = 1);
 
   ~DesktopCapturerDifferWrapper() override;
 
@@ -59,6 +61,7 @@ class RTC_EXPORT DesktopCapturerDifferWrapper
                        std::unique_ptr<DesktopFrame> frame) override;
 
   const std::unique_ptr<DesktopCapturer> base_capturer_;
+  const int num_threads_;
   DesktopCapturer::Callback* callback_;
   std::unique_ptr<SharedDesktopFrame> last_frame_;
 };
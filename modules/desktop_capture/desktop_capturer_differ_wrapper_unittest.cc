@@ -153,7 +153,8 @@ void ExecuteCapturer(DesktopCapturerDifferWrapper* capturer,
 void ExecuteDifferWrapperTest(bool with_hints,
                               bool enlarge_updated_region,
                               bool random_updated_region,
-                              bool check_result) {
+                              bool check_result,
+                              int num_threads = 1) {
   const bool updated_region_should_exactly_match =
       with_hints && !enlarge_updated_region && !random_updated_region;
   BlackWhiteDesktopFramePainter frame_painter;
@@ -161,7 +162,7 @@ void ExecuteDifferWrapperTest(bool with_hints,
   frame_generator.set_desktop_frame_painter(&frame_painter);
   std::unique_ptr<FakeDesktopCapturer> fake(new FakeDesktopCapturer());
   fake->set_frame_generator(&frame_generator);
-  DesktopCapturerDifferWrapper capturer(std::move(fake));
+  DesktopCapturerDifferWrapper capturer(std::move(fake), num_threads);
   MockDesktopCapturerCallback callback;
   frame_generator.set_provide_updated_region_hints(with_hints);
   frame_generator.set_enlarge_updated_region(enlarge_updated_region);
@@ -232,6 +233,14 @@ TEST(DesktopCapturerDifferWrapperTest, CaptureWithHints) {
   ExecuteDifferWrapperTest(true, false, false, true);
 }
 
+TEST(DesktopCapturerDifferWrapperTest, CaptureWithoutHintsOnThreeThreads) {
+  ExecuteDifferWrapperTest(false, false, false, true, 3);
+}
+
+TEST(DesktopCapturerDifferWrapperTest, CaptureWithHintsOnThreeThreads) {
+  ExecuteDifferWrapperTest(true, false, false, true, 3);
+}
+
 TEST(DesktopCapturerDifferWrapperTest, CaptureWithEnlargedHints) {
   ExecuteDifferWrapperTest(true, true, false, true);
 }
@@ -0,0 +1,146 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include <memory>
+#include <utility>
+
+#include "benchmark/benchmark.h"
+#include "modules/desktop_capture/desktop_capturer.h"
+#include "modules/desktop_capture/desktop_capturer_differ_wrapper.h"
+#include "modules/desktop_capture/desktop_frame.h"
+#include "modules/desktop_capture/desktop_geometry.h"
+#include "modules/desktop_capture/differ_block.h"
+#include "modules/desktop_capture/shared_desktop_frame.h"
+#include "rtc_base/system/unused.h"
+
+namespace webrtc {
+namespace {
+
+// Size of the area that changes between frames, e.g. a typing user.
+constexpr int kChangedSize = 256;
+
+std::unique_ptr<SharedDesktopFrame> CreateFrame(int width,
+                                                int height,
+                                                bool changed) {
+  auto frame = std::make_unique<BasicDesktopFrame>(DesktopSize(width, height));
+  memset(frame->data(), 0, frame->stride() * height);
+  if (changed) {
+    for (int y = 0; y < kChangedSize; ++y) {
+      memset(frame->GetFrameDataAtPos(DesktopVector(width / 3, height / 3 + y)),
+             0xff, kChangedSize * DesktopFrame::kBytesPerPixel);
+    }
+  }
+  return SharedDesktopFrame::Wrap(std::move(frame));
+}
+
+// Alternates between two prebuilt frames, and reports the whole frame as
+// updated, so that the differ has to find the changed area.
+class AlternatingCapturer : public DesktopCapturer {
+ public:
+  AlternatingCapturer(int width, int height)
+      : frames_{CreateFrame(width, height, false),
+                CreateFrame(width, height, true)} {}
+
+  void Start(Callback* callback) override { callback_ = callback; }
+  void CaptureFrame() override {
+    std::unique_ptr<DesktopFrame> frame = frames_[next_frame_]->Share();
+    frame->mutable_updated_region()->SetRect(
+        DesktopRect::MakeSize(frame->size()));
+    next_frame_ = 1 - next_frame_;
+    callback_->OnCaptureResult(Result::SUCCESS, std::move(frame));
+  }
+  bool GetSourceList(SourceList* sources) override { return true; }
+  bool SelectSource(SourceId id) override { return true; }
+
+ private:
+  const std::unique_ptr<SharedDesktopFrame> frames_[2];
+  int next_frame_ = 0;
+  Callback* callback_ = nullptr;
+};
+
+class CountingCallback : public DesktopCapturer::Callback {
+ public:
+  void OnCaptureResult(DesktopCapturer::Result result,
+                       std::unique_ptr<DesktopFrame> frame) override {
+    for (DesktopRegion::Iterator it(frame->updated_region()); !it.IsAtEnd();
+         it.Advance()) {
+      ++updated_rects_;
+    }
+  }
+
+  int64_t updated_rects() const { return updated_rects_; }
+
+ private:
+  int64_t updated_rects_ = 0;
+};
+
+// Compares all blocks of two equal `state.range(0)` x `state.range(1)` frames,
+// which is the worst case for BlockDifference().
+void BM_BlockDifference(benchmark::State& state) {
+  const int width = state.range(0);
+  const int height = state.range(1);
+  std::unique_ptr<SharedDesktopFrame> frame1 =
+      CreateFrame(width, height, false);
+  std::unique_ptr<SharedDesktopFrame> frame2 =
+      CreateFrame(width, height, false);
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    bool differ = false;
+    for (int y = 0; y + kBlockSize <= height; y += kBlockSize) {
+      for (int x = 0; x + kBlockSize <= width; x += kBlockSize) {
+        differ |= BlockDifference(
+            frame1->GetFrameDataAtPos(DesktopVector(x, y)),
+            frame2->GetFrameDataAtPos(DesktopVector(x, y)), frame1->stride());
+      }
+    }
+    benchmark::DoNotOptimize(differ);
+  }
+  state.SetBytesProcessed(state.iterations() * width * height *
+                          DesktopFrame::kBytesPerPixel);
+}
+
+// {width, height}.
+BENCHMARK(BM_BlockDifference)
+    ->Args({1920, 1080})
+    ->Args({3840, 2160})
+    ->Args({5120, 2880});
+
+// Diffs `state.range(0)` x `state.range(1)` frames in which a small area
+// changes, on `state.range(2)` threads. An iteration is one frame.
+void BM_DifferWrapper(benchmark::State& state) {
+  DesktopCapturerDifferWrapper capturer(
+      std::make_unique<AlternatingCapturer>(state.range(0), state.range(1)),
+      state.range(2));
+  CountingCallback callback;
+  capturer.Start(&callback);
+  // The first frame is marked as updated without diffing.
+  capturer.CaptureFrame();
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    capturer.CaptureFrame();
+  }
+  state.counters["updated_rects_per_frame"] = benchmark::Counter(
+      callback.updated_rects(), benchmark::Counter::kAvgIterations);
+}
+
+// {width, height, threads}.
+BENCHMARK(BM_DifferWrapper)
+    ->Args({1920, 1080, 1})
+    ->Args({3840, 2160, 1})
+    ->Args({3840, 2160, 2})
+    ->Args({3840, 2160, 4})
+    ->Args({5120, 2880, 1})
+    ->Args({5120, 2880, 4})
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace webrtc
@@ -12,48 +12,58 @@
 
 #include <string.h>
 
-#include "modules/desktop_capture/differ_vector_sse2.h"
 #include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include "modules/desktop_capture/differ_vector_neon.h"
+#elif defined(WEBRTC_ARCH_X86_FAMILY)
+#include "modules/desktop_capture/differ_vector_avx2.h"
+#include "modules/desktop_capture/differ_vector_sse2.h"
 #include "system_wrappers/include/cpu_features_wrapper.h"
+#endif
 
 namespace webrtc {
 
 namespace {
 
+using VectorDifferenceFunction = bool (*)(const uint8_t*, const uint8_t*);
+using BlockDifferenceFunction = bool (*)(const uint8_t*,
+                                         const uint8_t*,
+                                         int,
+                                         int);
+
 bool VectorDifference_C(const uint8_t* image1, const uint8_t* image2) {
   return memcmp(image1, image2, kBlockSize * kBytesPerPixel) != 0;
 }
 
-}  // namespace
-
-bool VectorDifference(const uint8_t* image1, const uint8_t* image2) {
-  static bool (*diff_proc)(const uint8_t*, const uint8_t*) = nullptr;
-
-  if (!diff_proc) {
-#if defined(WEBRTC_ARCH_ARM_FAMILY) || defined(WEBRTC_ARCH_MIPS_FAMILY)
-    // For ARM and MIPS processors, always use C version.
-    // TODO(hclam): Implement a NEON version.
-    diff_proc = &VectorDifference_C;
+VectorDifferenceFunction SelectVectorDifference() {
+#if defined(WEBRTC_HAS_NEON)
+  if (kBlockSize == 32) {
+    return &VectorDifference_NEON_W32;
+  }
+  return &VectorDifference_C;
+#elif defined(WEBRTC_ARCH_X86_FAMILY)
+  if (GetCPUInfo(kAVX2) && kBlockSize == 32) {
+    return &VectorDifference_AVX2_W32;
+  }
+  const bool have_sse2 = GetCPUInfo(kSSE2) != 0;
+  if (have_sse2 && kBlockSize == 32) {
+    return &VectorDifference_SSE2_W32;
+  }
+  if (have_sse2 && kBlockSize == 16) {
+    return &VectorDifference_SSE2_W16;
+  }
+  return &VectorDifference_C;
 #else
-    bool have_sse2 = GetCPUInfo(kSSE2) != 0;
-    // For x86 processors, check if SSE2 is supported.
-    if (have_sse2 && kBlockSize == 32) {
-      diff_proc = &VectorDifference_SSE2_W32;
-    } else if (have_sse2 && kBlockSize == 16) {
-      diff_proc = &VectorDifference_SSE2_W16;
-    } else {
-      diff_proc = &VectorDifference_C;
-    }
+  // MIPS and ARM without NEON use the C version.
+  return &VectorDifference_C;
 #endif
-  }
-
-  return diff_proc(image1, image2);
 }
 
-bool BlockDifference(const uint8_t* image1,
-                     const uint8_t* image2,
-                     int height,
-                     int stride) {
+bool BlockDifference_Vector(const uint8_t* image1,
+                            const uint8_t* image2,
+                            int height,
+                            int stride) {
   for (int i = 0; i < height; i++) {
     if (VectorDifference(image1, image2)) {
       return true;
@@ -64,6 +74,37 @@ bool BlockDifference(const uint8_t* image1,
   return false;
 }
 
+// The vectorized block functions save an indirect call per row.
+BlockDifferenceFunction SelectBlockDifference() {
+#if defined(WEBRTC_HAS_NEON)
+  if (kBlockSize == 32) {
+    return &BlockDifference_NEON_W32;
+  }
+#elif defined(WEBRTC_ARCH_X86_FAMILY)
+  if (GetCPUInfo(kAVX2) && kBlockSize == 32) {
+    return &BlockDifference_AVX2_W32;
+  }
+#endif
+  return &BlockDifference_Vector;
+}
+
+}  // namespace
+
+bool VectorDifference(const uint8_t* image1, const uint8_t* image2) {
+  // Function-local statics are initialized thread-safely, which matters since
+  // frames may be diffed on several threads.
+  static const VectorDifferenceFunction diff_proc = SelectVectorDifference();
+  return diff_proc(image1, image2);
+}
+
+bool BlockDifference(const uint8_t* image1,
+                     const uint8_t* image2,
+                     int height,
+                     int stride) {
+  static const BlockDifferenceFunction diff_proc = SelectBlockDifference();
+  return diff_proc(image1, image2, height, stride);
+}
+
 bool BlockDifference(const uint8_t* image1, const uint8_t* image2, int stride) {
   return BlockDifference(image1, image2, kBlockSize, stride);
 }
@@ -86,4 +86,20 @@ TEST(BlockDifferenceTestFirst, BlockDifference) {
   }
 }
 
+TEST(BlockDifferenceTestEachByte, BlockDifference) {
+  uint8_t* block1;
+  uint8_t* block2;
+  PrepareBuffers(block1, block2);
+
+  // Every byte of the block must be compared, whichever implementation is
+  // selected for this CPU.
+  for (int i = 0; i < kSizeOfBlock; ++i) {
+    block2[i] += 1;
+    EXPECT_EQ(1, BlockDifference(block1, block2, kBlockSize * kBytesPerPixel))
+        << "byte " << i;
+    block2[i] -= 1;
+  }
+  EXPECT_EQ(0, BlockDifference(block1, block2, kBlockSize * kBytesPerPixel));
+}
+
 }  // namespace webrtc
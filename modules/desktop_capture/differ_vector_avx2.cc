@@ -0,0 +1,56 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/desktop_capture/differ_vector_avx2.h"
+
+#include <immintrin.h>
+
+namespace webrtc {
+
+namespace {
+
+// Returns the bitwise difference of 32 BGRA pixels, i.e. 128 bytes.
+inline __m256i XorW32(const uint8_t* image1, const uint8_t* image2) {
+  const __m256i* i1 = reinterpret_cast<const __m256i*>(image1);
+  const __m256i* i2 = reinterpret_cast<const __m256i*>(image2);
+  const __m256i x0 =
+      _mm256_xor_si256(_mm256_loadu_si256(i1), _mm256_loadu_si256(i2));
+  const __m256i x1 = _mm256_xor_si256(_mm256_loadu_si256(i1 + 1),
+                                      _mm256_loadu_si256(i2 + 1));
+  const __m256i x2 = _mm256_xor_si256(_mm256_loadu_si256(i1 + 2),
+                                      _mm256_loadu_si256(i2 + 2));
+  const __m256i x3 = _mm256_xor_si256(_mm256_loadu_si256(i1 + 3),
+                                      _mm256_loadu_si256(i2 + 3));
+  return _mm256_or_si256(_mm256_or_si256(x0, x1), _mm256_or_si256(x2, x3));
+}
+
+}  // namespace
+
+bool VectorDifference_AVX2_W32(const uint8_t* image1, const uint8_t* image2) {
+  const __m256i diff = XorW32(image1, image2);
+  return !_mm256_testz_si256(diff, diff);
+}
+
+bool BlockDifference_AVX2_W32(const uint8_t* image1,
+                              const uint8_t* image2,
+                              int height,
+                              int stride) {
+  for (int i = 0; i < height; i++) {
+    const __m256i diff = XorW32(image1, image2);
+    if (!_mm256_testz_si256(diff, diff)) {
+      return true;
+    }
+    image1 += stride;
+    image2 += stride;
+  }
+  return false;
+}
+
+}  // namespace webrtc
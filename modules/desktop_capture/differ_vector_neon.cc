@@ -0,0 +1,50 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/desktop_capture/differ_vector_neon.h"
+
+#include <arm_neon.h>
+
+namespace webrtc {
+
+namespace {
+
+// Returns whether 32 BGRA pixels, i.e. 128 bytes, differ.
+inline bool DifferW32(const uint8_t* image1, const uint8_t* image2) {
+  uint8x16_t acc = veorq_u8(vld1q_u8(image1), vld1q_u8(image2));
+  for (int i = 16; i < 128; i += 16) {
+    acc = vorrq_u8(acc, veorq_u8(vld1q_u8(image1 + i), vld1q_u8(image2 + i)));
+  }
+  // vmaxvq_u8() is only available on arm64.
+  const uint64x2_t acc64 = vreinterpretq_u64_u8(acc);
+  return (vgetq_lane_u64(acc64, 0) | vgetq_lane_u64(acc64, 1)) != 0;
+}
+
+}  // namespace
+
+bool VectorDifference_NEON_W32(const uint8_t* image1, const uint8_t* image2) {
+  return DifferW32(image1, image2);
+}
+
+bool BlockDifference_NEON_W32(const uint8_t* image1,
+                              const uint8_t* image2,
+                              int height,
+                              int stride) {
+  for (int i = 0; i < height; i++) {
+    if (DifferW32(image1, image2)) {
+      return true;
+    }
+    image1 += stride;
+    image2 += stride;
+  }
+  return false;
+}
+
+}  // namespace webrtc
@@ -26,6 +26,7 @@
 #include "absl/memory/memory.h"
 #include "modules/desktop_capture/desktop_capture_options.h"
 #include "modules/desktop_capture/desktop_capturer.h"
+#include "modules/desktop_capture/shared_desktop_frame.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/string_encode.h"
@@ -529,7 +530,6 @@ pw_stream* BaseCapturerPipeWire::CreateReceivingStream() {
 void BaseCapturerPipeWire::HandleBuffer(pw_buffer* buffer) {
   spa_buffer* spa_buffer = buffer->buffer;
   ScopedBuf map;
-  std::unique_ptr<uint8_t[]> src_unique_ptr;
   uint8_t* src = nullptr;
 
   if (spa_buffer->datas[0].chunk->size == 0) {
@@ -537,49 +537,6 @@ void BaseCapturerPipeWire::HandleBuffer(pw_buffer* buffer) {
     return;
   }
 
-  if (spa_buffer->datas[0].type == SPA_DATA_MemFd) {
-    map.initialize(
-        static_cast<uint8_t*>(
-            mmap(nullptr,
-                 spa_buffer->datas[0].maxsize + spa_buffer->datas[0].mapoffset,
-                 PROT_READ, MAP_PRIVATE, spa_buffer->datas[0].fd, 0)),
-        spa_buffer->datas[0].maxsize + spa_buffer->datas[0].mapoffset,
-        spa_buffer->datas[0].fd);
-
-    if (!map) {
-      RTC_LOG(LS_ERROR) << "Failed to mmap the memory: "
-                        << std::strerror(errno);
-      return;
-    }
-
-    src = SPA_MEMBER(map.get(), spa_buffer->datas[0].mapoffset, uint8_t);
-  } else if (spa_buffer->datas[0].type == SPA_DATA_DmaBuf) {
-    const uint n_planes = spa_buffer->n_datas;
-
-    if (!n_planes) {
-      return;
-    }
-
-    std::vector<EglDmaBuf::PlaneData> plane_datas;
-    for (uint32_t i = 0; i < n_planes; ++i) {
-      EglDmaBuf::PlaneData data = {
-          static_cast<int32_t>(spa_buffer->datas[i].fd),
-          static_cast<uint32_t>(spa_buffer->datas[i].chunk->stride),
-          static_cast<uint32_t>(spa_buffer->datas[i].chunk->offset)};
-      plane_datas.push_back(data);
-    }
-
-    src_unique_ptr = egl_dmabuf_->ImageFromDmaBuf(
-        desktop_size_, spa_video_format_.format, plane_datas, modifier_);
-    src = src_unique_ptr.get();
-  } else if (spa_buffer->datas[0].type == SPA_DATA_MemPtr) {
-    src = static_cast<uint8_t*>(spa_buffer->datas[0].data);
-  }
-
-  if (!src) {
-    return;
-  }
-
   struct spa_meta_region* video_metadata =
       static_cast<struct spa_meta_region*>(spa_buffer_find_meta_data(
           spa_buffer, SPA_META_VideoCrop, sizeof(*video_metadata)));
@@ -627,27 +584,88 @@ void BaseCapturerPipeWire::HandleBuffer(pw_buffer* buffer) {
                           ? video_metadata->region.position.x
                           : 0;
 
+  if (spa_buffer->datas[0].type == SPA_DATA_MemFd) {
+    map.initialize(
+        static_cast<uint8_t*>(
+            mmap(nullptr,
+                 spa_buffer->datas[0].maxsize + spa_buffer->datas[0].mapoffset,
+                 PROT_READ, MAP_PRIVATE, spa_buffer->datas[0].fd, 0)),
+        spa_buffer->datas[0].maxsize + spa_buffer->datas[0].mapoffset,
+        spa_buffer->datas[0].fd);
+
+    if (!map) {
+      RTC_LOG(LS_ERROR) << "Failed to mmap the memory: "
+                        << std::strerror(errno);
+      return;
+    }
+
+    src = SPA_MEMBER(map.get(), spa_buffer->datas[0].mapoffset, uint8_t);
+  } else if (spa_buffer->datas[0].type == SPA_DATA_MemPtr) {
+    src = static_cast<uint8_t*>(spa_buffer->datas[0].data);
+  } else if (spa_buffer->datas[0].type != SPA_DATA_DmaBuf) {
+    return;
+  }
+
   webrtc::MutexLock lock(&current_frame_lock_);
 
+  // Frames are recycled, unless the consumer still holds the one we're about
+  // to write to. Allocating and faulting in a new frame per buffer is costly
+  // for large screens.
+  queue_.MoveToNextFrame();
+  if (queue_.current_frame() &&
+      (queue_.current_frame()->IsShared() ||
+       !queue_.current_frame()->size().equals(video_size_))) {
+    queue_.ReplaceCurrentFrame(nullptr);
+  }
+  if (!queue_.current_frame()) {
+    queue_.ReplaceCurrentFrame(SharedDesktopFrame::Wrap(
+        std::make_unique<BasicDesktopFrame>(video_size_)));
+  }
+  DesktopFrame* frame = queue_.current_frame();
+  has_new_frame_ = false;
+
+  if (spa_buffer->datas[0].type == SPA_DATA_DmaBuf) {
+    const uint n_planes = spa_buffer->n_datas;
+
+    if (!n_planes) {
+      return;
+    }
+
+    std::vector<EglDmaBuf::PlaneData> plane_datas;
+    for (uint32_t i = 0; i < n_planes; ++i) {
+      EglDmaBuf::PlaneData data = {
+          static_cast<int32_t>(spa_buffer->datas[i].fd),
+          static_cast<uint32_t>(spa_buffer->datas[i].chunk->stride),
+          static_cast<uint32_t>(spa_buffer->datas[i].chunk->offset)};
+      plane_datas.push_back(data);
+    }
+
+    // The buffer stays on the GPU until it's read back into `frame`, already
+    // cropped and in BGRx order.
+    has_new_frame_ = egl_dmabuf_->ImageFromDmaBuf(
+        desktop_size_, plane_datas, modifier_,
+        DesktopVector(x_offset, y_offset), frame);
+    return;
+  }
+
   uint8_t* updated_src = src + (spa_buffer->datas[0].chunk->stride * y_offset) +
                          (kBytesPerPixel * x_offset);
-  current_frame_ = std::make_unique<BasicDesktopFrame>(
-      DesktopSize(video_size_.width(), video_size_.height()));
-  current_frame_->CopyPixelsFrom(
+  frame->CopyPixelsFrom(
       updated_src,
       (spa_buffer->datas[0].chunk->stride - (kBytesPerPixel * x_offset)),
       DesktopRect::MakeWH(video_size_.width(), video_size_.height()));
 
   if (spa_video_format_.format == SPA_VIDEO_FORMAT_RGBx ||
       spa_video_format_.format == SPA_VIDEO_FORMAT_RGBA) {
-    uint8_t* tmp_src = current_frame_->data();
+    uint8_t* tmp_src = frame->data();
     for (int i = 0; i < video_size_.height(); ++i) {
       // If both sides decided to go with the RGBx format we need to convert it
       // to BGRx to match color format expected by WebRTC.
-      ConvertRGBxToBGRx(tmp_src, current_frame_->stride());
-      tmp_src += current_frame_->stride();
+      ConvertRGBxToBGRx(tmp_src, frame->stride());
+      tmp_src += frame->stride();
     }
   }
+  has_new_frame_ = true;
 }
 
 void BaseCapturerPipeWire::ConvertRGBxToBGRx(uint8_t* frame, uint32_t size) {
@@ -1088,15 +1106,16 @@ void BaseCapturerPipeWire::CaptureFrame() {
   }
 
   webrtc::MutexLock lock(&current_frame_lock_);
-  if (!current_frame_ || !current_frame_->data()) {
+  if (!has_new_frame_) {
     callback_->OnCaptureResult(Result::ERROR_TEMPORARY, nullptr);
     return;
   }
+  has_new_frame_ = false;
 
   // TODO(julien.isorce): http://crbug.com/945468. Set the icc profile on the
   // frame, see ScreenCapturerX11::CaptureFrame.
 
-  callback_->OnCaptureResult(Result::SUCCESS, std::move(current_frame_));
+  callback_->OnCaptureResult(Result::SUCCESS, queue_.current_frame()->Share());
 }
 
 bool BaseCapturerPipeWire::GetSourceList(SourceList* sources) {
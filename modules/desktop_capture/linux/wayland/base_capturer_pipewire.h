@@ -22,8 +22,11 @@
 #include "modules/desktop_capture/desktop_capture_options.h"
 #include "modules/desktop_capture/desktop_capturer.h"
 #include "modules/desktop_capture/linux/wayland/egl_dmabuf.h"
+#include "modules/desktop_capture/screen_capture_frame_queue.h"
+#include "modules/desktop_capture/shared_desktop_frame.h"
 #include "rtc_base/constructor_magic.h"
 #include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
 
@@ -97,7 +100,10 @@ class BaseCapturerPipeWire : public DesktopCapturer {
   DesktopCaptureOptions options_ = {};
 
   webrtc::Mutex current_frame_lock_;
-  std::unique_ptr<BasicDesktopFrame> current_frame_;
+  ScreenCaptureFrameQueue<SharedDesktopFrame> queue_
+      RTC_GUARDED_BY(current_frame_lock_);
+  // Whether the current frame of `queue_` hasn't been captured yet.
+  bool has_new_frame_ RTC_GUARDED_BY(current_frame_lock_) = false;
   Callback* callback_ = nullptr;
 
   bool portal_init_failed_ = false;
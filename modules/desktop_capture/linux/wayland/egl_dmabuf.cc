@@ -86,16 +86,29 @@ eglQueryString_func EglQueryString = nullptr;
 glEGLImageTargetTexture2DOES_func GlEGLImageTargetTexture2DOES = nullptr;
 
 // GL
+typedef void (*glBindFramebuffer_func)(GLenum target, GLuint framebuffer);
 typedef void (*glBindTexture_func)(GLenum target, GLuint texture);
+typedef GLenum (*glCheckFramebufferStatus_func)(GLenum target);
+typedef void (*glDeleteFramebuffers_func)(GLsizei n,
+                                          const GLuint* framebuffers);
 typedef void (*glDeleteTextures_func)(GLsizei n, const GLuint* textures);
+typedef void (*glFramebufferTexture2D_func)(GLenum target,
+                                            GLenum attachment,
+                                            GLenum textarget,
+                                            GLuint texture,
+                                            GLint level);
+typedef void (*glGenFramebuffers_func)(GLsizei n, GLuint* framebuffers);
 typedef void (*glGenTextures_func)(GLsizei n, GLuint* textures);
 typedef GLenum (*glGetError_func)(void);
 typedef const GLubyte* (*glGetString_func)(GLenum name);
-typedef void (*glGetTexImage_func)(GLenum target,
-                                   GLint level,
-                                   GLenum format,
-                                   GLenum type,
-                                   void* pixels);
+typedef void (*glPixelStorei_func)(GLenum pname, GLint param);
+typedef void (*glReadPixels_func)(GLint x,
+                                  GLint y,
+                                  GLsizei width,
+                                  GLsizei height,
+                                  GLenum format,
+                                  GLenum type,
+                                  void* pixels);
 typedef void (*glTexParameteri_func)(GLenum target, GLenum pname, GLint param);
 typedef void* (*glXGetProcAddressARB_func)(const char*);
 
@@ -103,12 +116,18 @@ typedef void* (*glXGetProcAddressARB_func)(const char*);
 // should look like e.g. egl_bind_api instead of EglBindAPI, however
 // we named them according to the exported functions they map to for
 // consistency.
+glBindFramebuffer_func GlBindFramebuffer = nullptr;
 glBindTexture_func GlBindTexture = nullptr;
+glCheckFramebufferStatus_func GlCheckFramebufferStatus = nullptr;
+glDeleteFramebuffers_func GlDeleteFramebuffers = nullptr;
 glDeleteTextures_func GlDeleteTextures = nullptr;
+glFramebufferTexture2D_func GlFramebufferTexture2D = nullptr;
+glGenFramebuffers_func GlGenFramebuffers = nullptr;
 glGenTextures_func GlGenTextures = nullptr;
 glGetError_func GlGetError = nullptr;
 glGetString_func GlGetString = nullptr;
-glGetTexImage_func GlGetTexImage = nullptr;
+glPixelStorei_func GlPixelStorei = nullptr;
+glReadPixels_func GlReadPixels = nullptr;
 glTexParameteri_func GlTexParameteri = nullptr;
 glXGetProcAddressARB_func GlXGetProcAddressARB = nullptr;
 
@@ -223,17 +242,31 @@ static bool LoadGL() {
       return false;
     }
 
+    GlBindFramebuffer =
+        (glBindFramebuffer_func)GlXGetProcAddressARB("glBindFramebuffer");
     GlBindTexture = (glBindTexture_func)GlXGetProcAddressARB("glBindTexture");
+    GlCheckFramebufferStatus =
+        (glCheckFramebufferStatus_func)GlXGetProcAddressARB(
+            "glCheckFramebufferStatus");
+    GlDeleteFramebuffers =
+        (glDeleteFramebuffers_func)GlXGetProcAddressARB("glDeleteFramebuffers");
     GlDeleteTextures =
         (glDeleteTextures_func)GlXGetProcAddressARB("glDeleteTextures");
+    GlFramebufferTexture2D = (glFramebufferTexture2D_func)GlXGetProcAddressARB(
+        "glFramebufferTexture2D");
+    GlGenFramebuffers =
+        (glGenFramebuffers_func)GlXGetProcAddressARB("glGenFramebuffers");
     GlGenTextures = (glGenTextures_func)GlXGetProcAddressARB("glGenTextures");
     GlGetError = (glGetError_func)GlXGetProcAddressARB("glGetError");
-    GlGetTexImage = (glGetTexImage_func)GlXGetProcAddressARB("glGetTexImage");
+    GlPixelStorei = (glPixelStorei_func)GlXGetProcAddressARB("glPixelStorei");
+    GlReadPixels = (glReadPixels_func)GlXGetProcAddressARB("glReadPixels");
     GlTexParameteri =
         (glTexParameteri_func)GlXGetProcAddressARB("glTexParameteri");
 
-    return GlBindTexture && GlDeleteTextures && GlGenTextures && GlGetError &&
-           GlGetTexImage && GlTexParameteri;
+    return GlBindFramebuffer && GlBindTexture && GlCheckFramebufferStatus &&
+           GlDeleteFramebuffers && GlDeleteTextures && GlFramebufferTexture2D &&
+           GlGenFramebuffers && GlGenTextures && GlGetError && GlPixelStorei &&
+           GlReadPixels && GlTexParameteri;
   }
 
   return false;
@@ -384,20 +417,25 @@ EglDmaBuf::~EglDmaBuf() {
 }
 
 RTC_NO_SANITIZE("cfi-icall")
-std::unique_ptr<uint8_t[]> EglDmaBuf::ImageFromDmaBuf(
-    const DesktopSize& size,
-    uint32_t format,
-    const std::vector<PlaneData>& plane_datas,
-    uint64_t modifier) {
-  std::unique_ptr<uint8_t[]> src;
-
+bool EglDmaBuf::ImageFromDmaBuf(const DesktopSize& size,
+                                const std::vector<PlaneData>& plane_datas,
+                                uint64_t modifier,
+                                const DesktopVector& offset,
+                                DesktopFrame* frame) {
   if (!egl_initialized_) {
-    return src;
+    return false;
   }
 
   if (plane_datas.size() <= 0) {
     RTC_LOG(LS_ERROR) << "Failed to process buffer: invalid number of planes";
-    return src;
+    return false;
+  }
+
+  if (offset.x() < 0 || offset.y() < 0 ||
+      offset.x() + frame->size().width() > size.width() ||
+      offset.y() + frame->size().height() > size.height()) {
+    RTC_LOG(LS_ERROR) << "Failed to process buffer: frame is out of bounds";
+    return false;
   }
 
   gbm_bo* imported;
@@ -429,7 +467,7 @@ std::unique_ptr<uint8_t[]> EglDmaBuf::ImageFromDmaBuf(
     RTC_LOG(LS_ERROR)
         << "Failed to process buffer: Cannot import passed GBM fd - "
         << strerror(errno);
-    return src;
+    return false;
   }
 
   // bind context to render thread
@@ -443,7 +481,7 @@ std::unique_ptr<uint8_t[]> EglDmaBuf::ImageFromDmaBuf(
     RTC_LOG(LS_ERROR) << "Failed to record frame: Error creating EGLImageKHR - "
                       << FormatGLError(GlGetError());
     gbm_bo_destroy(imported);
-    return src;
+    return false;
   }
 
   // create GL 2D texture for framebuffer
@@ -456,43 +494,43 @@ std::unique_ptr<uint8_t[]> EglDmaBuf::ImageFromDmaBuf(
   GlBindTexture(GL_TEXTURE_2D, texture);
   GlEGLImageTargetTexture2DOES(GL_TEXTURE_2D, image);
 
-  src = std::make_unique<uint8_t[]>(plane_datas[0].stride * size.height());
-
-  GLenum gl_format = GL_BGRA;
-  switch (format) {
-    case SPA_VIDEO_FORMAT_RGBx:
-      gl_format = GL_RGBA;
-      break;
-    case SPA_VIDEO_FORMAT_RGBA:
-      gl_format = GL_RGBA;
-      break;
-    case SPA_VIDEO_FORMAT_BGRx:
-      gl_format = GL_BGRA;
-      break;
-    case SPA_VIDEO_FORMAT_RGB:
-      gl_format = GL_RGB;
-      break;
-    case SPA_VIDEO_FORMAT_BGR:
-      gl_format = GL_BGR;
-      break;
-    default:
-      gl_format = GL_BGRA;
-      break;
-  }
-  GlGetTexImage(GL_TEXTURE_2D, 0, gl_format, GL_UNSIGNED_BYTE, src.get());
-
-  if (GlGetError()) {
-    RTC_LOG(LS_ERROR) << "Failed to get image from DMA buffer.";
-    gbm_bo_destroy(imported);
-    return src;
+  // Attach the texture to a framebuffer, so that only the cropped area is read
+  // back, straight into the rows of `frame`. Reading it as BGRA makes the GPU
+  // swap the channels of RGB buffers, which WebRTC would otherwise do in
+  // software.
+  GLuint framebuffer;
+  GlGenFramebuffers(1, &framebuffer);
+  GlBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+  GlFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                         texture, 0);
+
+  bool success = true;
+  if (GlCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+    RTC_LOG(LS_ERROR) << "Failed to attach the DMA buffer to a framebuffer.";
+    success = false;
+  } else {
+    GlPixelStorei(GL_PACK_ALIGNMENT, 4);
+    GlPixelStorei(GL_PACK_ROW_LENGTH,
+                  frame->stride() / DesktopFrame::kBytesPerPixel);
+    GlReadPixels(offset.x(), offset.y(), frame->size().width(),
+                 frame->size().height(), GL_BGRA, GL_UNSIGNED_BYTE,
+                 frame->data());
+    GlPixelStorei(GL_PACK_ROW_LENGTH, 0);
+
+    if (GlGetError()) {
+      RTC_LOG(LS_ERROR) << "Failed to get image from DMA buffer.";
+      success = false;
+    }
   }
 
+  GlBindFramebuffer(GL_FRAMEBUFFER, 0);
+  GlDeleteFramebuffers(1, &framebuffer);
   GlDeleteTextures(1, &texture);
   EglDestroyImageKHR(egl_.display, image);
 
   gbm_bo_destroy(imported);
 
-  return src;
+  return success;
 }
 
 RTC_NO_SANITIZE("cfi-icall")
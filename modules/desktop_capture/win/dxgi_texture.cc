@@ -42,7 +42,8 @@ DxgiTexture::DxgiTexture() = default;
 DxgiTexture::~DxgiTexture() = default;
 
 bool DxgiTexture::CopyFrom(const DXGI_OUTDUPL_FRAME_INFO& frame_info,
-                           IDXGIResource* resource) {
+                           IDXGIResource* resource,
+                           const DesktopRegion& updated_region) {
   RTC_DCHECK_GT(frame_info.AccumulatedFrames, 0);
   RTC_DCHECK(resource);
   ComPtr<ID3D11Texture2D> texture;
@@ -59,7 +60,7 @@ bool DxgiTexture::CopyFrom(const DXGI_OUTDUPL_FRAME_INFO& frame_info,
   texture->GetDesc(&desc);
   desktop_size_.set(desc.Width, desc.Height);
 
-  return CopyFromTexture(frame_info, texture.Get());
+  return CopyFromTexture(frame_info, texture.Get(), updated_region);
 }
 
 const DesktopFrame& DxgiTexture::AsDesktopFrame() {
@@ -15,6 +15,7 @@
 #include <dxgi1_2.h>
 #include <unknwn.h>
 
+#include "modules/desktop_capture/desktop_region.h"
 #include "modules/desktop_capture/win/desktop_capture_utils.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
@@ -92,7 +93,8 @@ void DxgiTextureStaging::AssertStageAndSurfaceAreSameObject() {
 
 bool DxgiTextureStaging::CopyFromTexture(
     const DXGI_OUTDUPL_FRAME_INFO& frame_info,
-    ID3D11Texture2D* texture) {
+    ID3D11Texture2D* texture,
+    const DesktopRegion& updated_region) {
   RTC_DCHECK_GT(frame_info.AccumulatedFrames, 0);
   RTC_DCHECK(texture);
 
@@ -102,8 +104,29 @@ bool DxgiTextureStaging::CopyFromTexture(
     return false;
   }
 
-  device_.context()->CopyResource(static_cast<ID3D11Resource*>(stage_.Get()),
-                                  static_cast<ID3D11Resource*>(texture));
+  // Only the updated region is read from the stage afterwards, so the rest of
+  // it doesn't need to be copied. This saves most of the GPU to CPU bandwidth
+  // when little of a large screen changes.
+  if (updated_region.Equals(
+          DesktopRegion(DesktopRect::MakeSize(desktop_size())))) {
+    device_.context()->CopyResource(static_cast<ID3D11Resource*>(stage_.Get()),
+                                    static_cast<ID3D11Resource*>(texture));
+  } else {
+    for (DesktopRegion::Iterator it(updated_region); !it.IsAtEnd();
+         it.Advance()) {
+      const DesktopRect& rect = it.rect();
+      D3D11_BOX box;
+      box.left = rect.left();
+      box.top = rect.top();
+      box.front = 0;
+      box.right = rect.right();
+      box.bottom = rect.bottom();
+      box.back = 1;
+      device_.context()->CopySubresourceRegion(
+          static_cast<ID3D11Resource*>(stage_.Get()), 0, rect.left(),
+          rect.top(), 0, static_cast<ID3D11Resource*>(texture), 0, &box);
+    }
+  }
 
   *rect() = {0};
   _com_error error = surface_->Map(rect(), DXGI_MAP_READ);
@@ -41,7 +41,8 @@ class DxgiTextureStaging : public DxgiTexture {
   // Copies selected regions of a frame represented by frame_info and texture.
   // Returns false if anything wrong.
   bool CopyFromTexture(const DXGI_OUTDUPL_FRAME_INFO& frame_info,
-                       ID3D11Texture2D* texture) override;
+                       ID3D11Texture2D* texture,
+                       const DesktopRegion& updated_region) override;
 
   bool DoRelease() override;
 
@@ -23,6 +23,7 @@
 #include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/time_utils.h"
+#include "rtc_base/trace_event.h"
 #include "system_wrappers/include/clock.h"
 
 namespace webrtc {
@@ -114,8 +115,11 @@ PacingController::PacingController(Clock* clock,
       pace_audio_(IsEnabled(*field_trials_, "WebRTC-Pacer-BlockAudio")),
       ignore_transport_overhead_(
           IsEnabled(*field_trials_, "WebRTC-Pacer-IgnoreTransportOverhead")),
+      probe_with_queued_media_(
+          IsEnabled(*field_trials_, "WebRTC-Pacer-ProbeWithQueuedMedia")),
       padding_target_duration_(GetDynamicPaddingTarget(*field_trials_)),
       min_packet_limit_(kDefaultMinPacketLimit),
+      send_burst_interval_(TimeDelta::Zero()),
       transport_overhead_per_packet_(DataSize::Zero()),
       last_timestamp_(clock_->CurrentTime()),
       paused_(false),
@@ -146,6 +150,10 @@ PacingController::PacingController(Clock* clock,
                   field_trials_->Lookup("WebRTC-Pacer-MinPacketLimitMs"));
   min_packet_limit_ = TimeDelta::Millis(min_packet_limit_ms.Get());
   UpdateBudgetWithElapsedTime(min_packet_limit_);
+  FieldTrialParameter<TimeDelta> send_burst_interval("", TimeDelta::Zero());
+  ParseFieldTrial({&send_burst_interval},
+                  field_trials_->Lookup("WebRTC-Pacer-BurstInterval"));
+  SetSendBurstInterval(send_burst_interval.Get());
 }
 
 PacingController::~PacingController() = default;
@@ -383,8 +391,14 @@ Timestamp PacingController::NextSendTime() const {
 
   // Check how long until we can send the next media packet.
   if (media_rate_ > DataRate::Zero() && !packet_queue_.Empty()) {
+    // Within a burst packets can be sent right away. Once a burst has been
+    // sent, wait until all of its debt is drained.
+    TimeDelta drain_time = media_debt_ / media_rate_;
+    if (drain_time <= send_burst_interval_) {
+      drain_time = TimeDelta::Zero();
+    }
     return std::min(last_send_time_ + kPausedProcessInterval,
-                    last_process_time_ + media_debt_ / media_rate_);
+                    last_process_time_ + drain_time);
   }
 
   // If we _don't_ have pending packets, check how long until we have
@@ -404,6 +418,7 @@ Timestamp PacingController::NextSendTime() const {
 }
 
 void PacingController::ProcessPackets() {
+  TRACE_EVENT0("webrtc", "PacingController::ProcessPackets");
   Timestamp now = CurrentTime();
   Timestamp target_send_time = now;
   if (mode_ == ProcessMode::kDynamic) {
@@ -438,6 +453,8 @@ void PacingController::ProcessPackets() {
 
   Timestamp previous_process_time = last_process_time_;
   TimeDelta elapsed_time = UpdateTimeAndGetElapsed(now);
+  // Whether OnBatchComplete() has to be called before returning.
+  bool batch_has_packets = false;
 
   if (ShouldSendKeepalive(now)) {
     // We can not send padding unless a normal packet has first been sent. If
@@ -448,6 +465,7 @@ void PacingController::ProcessPackets() {
       DataSize keepalive_data_sent = DataSize::Zero();
       std::vector<std::unique_ptr<RtpPacketToSend>> keepalive_packets =
           packet_sender_->GeneratePadding(DataSize::Bytes(1));
+      batch_has_packets = !keepalive_packets.empty();
       for (auto& packet : keepalive_packets) {
         keepalive_data_sent +=
             DataSize::Bytes(packet->payload_size() + packet->padding_size());
@@ -461,6 +479,9 @@ void PacingController::ProcessPackets() {
   }
 
   if (paused_) {
+    if (batch_has_packets) {
+      packet_sender_->OnBatchComplete();
+    }
     return;
   }
 
@@ -519,7 +540,8 @@ void PacingController::ProcessPackets() {
   // The paused state is checked in the loop since it leaves the critical
   // section allowing the paused state to be changed from other code.
   while (!paused_) {
-    if (first_packet_in_probe) {
+    if (first_packet_in_probe &&
+        (!probe_with_queued_media_ || packet_queue_.Empty())) {
       // If first packet in probe, insert a small padding packet so we have a
       // more reliable start window for the rate estimation.
       auto padding = packet_sender_->GeneratePadding(DataSize::Bytes(1));
@@ -532,8 +554,8 @@ void PacingController::ProcessPackets() {
         // size of 1 byte.
         RTC_DCHECK_EQ(padding.size(), 1u);
       }
-      first_packet_in_probe = false;
     }
+    first_packet_in_probe = false;
 
     if (mode_ == ProcessMode::kDynamic &&
         previous_process_time < target_send_time) {
@@ -583,6 +605,7 @@ void PacingController::ProcessPackets() {
     }
 
     packet_sender_->SendPacket(std::move(rtp_packet), pacing_info);
+    batch_has_packets = true;
     for (auto& packet : packet_sender_->FetchFec()) {
       EnqueuePacket(std::move(packet));
     }
@@ -611,6 +634,10 @@ void PacingController::ProcessPackets() {
 
   last_process_time_ = std::max(last_process_time_, previous_process_time);
 
+  if (batch_has_packets) {
+    packet_sender_->OnBatchComplete();
+  }
+
   if (is_probing) {
     probing_send_failure_ = data_sent == DataSize::Zero();
     if (!probing_send_failure_) {
@@ -684,8 +711,9 @@ std::unique_ptr<RtpPacketToSend> PacingController::GetPendingPacket(
         // We allow sending slightly early if we think that we would actually
         // had been able to, had we been right on time - i.e. the current debt
         // is not more than would be reduced to zero at the target sent time.
+        // In a burst, the debt may be up to `send_burst_interval_` more.
         TimeDelta flush_time = media_debt_ / media_rate_;
-        if (now + flush_time > target_send_time) {
+        if (now + flush_time > target_send_time + send_burst_interval_) {
           return nullptr;
         }
       }
@@ -743,6 +771,12 @@ void PacingController::UpdateBudgetWithSentData(DataSize size) {
   }
 }
 
+void PacingController::SetSendBurstInterval(TimeDelta burst_interval) {
+  RTC_DCHECK_GE(burst_interval, TimeDelta::Zero());
+  // The debt can't grow beyond `kMaxDebtInTime`.
+  send_burst_interval_ = std::min(burst_interval, kMaxDebtInTime / 2);
+}
+
 void PacingController::SetQueueTimeLimit(TimeDelta limit) {
   queue_time_limit = limit;
 }
@@ -59,6 +59,9 @@ class PacingController {
     virtual std::vector<std::unique_ptr<RtpPacketToSend>> FetchFec() = 0;
     virtual std::vector<std::unique_ptr<RtpPacketToSend>> GeneratePadding(
         DataSize size) = 0;
+    // Called after the packets sent by one ProcessPackets() call, so that
+    // they can be handed to the transport as one batch.
+    virtual void OnBatchComplete() {}
   };
 
   // Expected max pacer delay. If ExpectedQueueTime() is higher than
@@ -133,6 +136,13 @@ class PacingController {
 
   void SetQueueTimeLimit(TimeDelta limit);
 
+  // In dynamic mode, allows the media debt to grow to `burst_interval` worth
+  // of data before the pacer waits, so that each wake-up sends a burst of
+  // packets instead of one. The pacer then waits until the debt is drained.
+  // Zero, the default, sends packets one by one. Can also be set with the
+  // field trial "WebRTC-Pacer-BurstInterval/<interval>/".
+  void SetSendBurstInterval(TimeDelta burst_interval);
+
   // Enable bitrate probing. Enabled by default, mostly here to simplify
   // testing. Must be called before any packets are being sent to have an
   // effect.
@@ -183,11 +193,15 @@ class PacingController {
   const bool send_padding_if_silent_;
   const bool pace_audio_;
   const bool ignore_transport_overhead_;
+  // If set, probes start with queued media rather than a small padding
+  // packet, so that only a shortfall of queued media is probed with padding.
+  const bool probe_with_queued_media_;
   // In dynamic mode, indicates the target size when requesting padding,
   // expressed as a duration in order to adjust for varying padding rate.
   const TimeDelta padding_target_duration_;
 
   TimeDelta min_packet_limit_;
+  TimeDelta send_burst_interval_;
 
   DataSize transport_overhead_per_packet_;
 
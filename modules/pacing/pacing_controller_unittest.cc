@@ -122,6 +122,7 @@ class MockPacketSender : public PacingController::PacketSender {
               GeneratePadding,
               (DataSize target_size),
               (override));
+  MOCK_METHOD(void, OnBatchComplete, (), (override));
 };
 
 class PacingControllerPadding : public PacingController::PacketSender {
@@ -1444,6 +1445,66 @@ TEST_P(PacingControllerTest, ProbingWithInsertedPackets) {
               kSecondClusterRate.bps(), kProbingErrorMargin.bps());
 }
 
+TEST_P(PacingControllerTest, ProbesWithQueuedMediaWithoutPadding) {
+  const size_t kPacketSize = 1200;
+  const int kInitialBitrateBps = 300000;
+  uint32_t ssrc = 12346;
+  uint16_t sequence_number = 1234;
+
+  const test::ExplicitKeyValueConfig trials(
+      "WebRTC-Pacer-ProbeWithQueuedMedia/Enabled/");
+  PacingControllerProbing packet_sender;
+  pacer_ = std::make_unique<PacingController>(&clock_, &packet_sender, nullptr,
+                                              &trials, GetParam());
+  pacer_->CreateProbeCluster(kFirstClusterRate,
+                             /*cluster_id=*/0);
+  pacer_->SetPacingRates(
+      DataRate::BitsPerSec(kInitialBitrateBps * kPaceMultiplier),
+      DataRate::Zero());
+
+  for (int i = 0; i < 10; ++i) {
+    Send(RtpPacketMediaType::kVideo, ssrc, sequence_number++,
+         clock_.TimeInMilliseconds(), kPacketSize);
+  }
+
+  int64_t start = clock_.TimeInMilliseconds();
+  while (packet_sender.packets_sent() < 5) {
+    clock_.AdvanceTime(TimeUntilNextProcess());
+    pacer_->ProcessPackets();
+  }
+  EXPECT_NEAR((packet_sender.packets_sent() - 1) * kPacketSize * 8000 /
+                  (clock_.TimeInMilliseconds() - start),
+              kFirstClusterRate.bps(), kProbingErrorMargin.bps());
+  EXPECT_EQ(0, packet_sender.padding_sent());
+}
+
+TEST_P(PacingControllerTest, ProbesWithPaddingWhenQueuedMediaRunsOut) {
+  const test::ExplicitKeyValueConfig trials(
+      "WebRTC-Pacer-ProbeWithQueuedMedia/Enabled/");
+  PacingControllerProbing packet_sender;
+  pacer_ = std::make_unique<PacingController>(&clock_, &packet_sender, nullptr,
+                                              &trials, GetParam());
+  pacer_->SetPacingRates(kTargetRate * kPaceMultiplier, DataRate::Zero());
+  // Padding is only sent once media has been.
+  Send(RtpPacketMediaType::kVideo, kVideoSsrc, 1, clock_.TimeInMilliseconds(),
+       1200);
+  clock_.AdvanceTime(TimeUntilNextProcess());
+  pacer_->ProcessPackets();
+
+  pacer_->CreateProbeCluster(kFirstClusterRate, /*cluster_id=*/0);
+  Send(RtpPacketMediaType::kVideo, kVideoSsrc, 2, clock_.TimeInMilliseconds(),
+       1200);
+  for (int i = 0; i < 5; ++i) {
+    clock_.AdvanceTime(TimeUntilNextProcess());
+    pacer_->ProcessPackets();
+  }
+  EXPECT_EQ(2, packet_sender.packets_sent());
+  // The probe started with the queued packet, and made up for the rest with
+  // padding.
+  EXPECT_GT(packet_sender.padding_sent(), 0);
+  EXPECT_EQ(packet_sender.last_pacing_info().probe_cluster_id, 0);
+}
+
 TEST_P(PacingControllerTest, SkipsProbesWhenProcessIntervalTooLarge) {
   const size_t kPacketSize = 1200;
   const int kInitialBitrateBps = 300000;
@@ -2167,6 +2228,50 @@ TEST_P(PacingControllerTest, GapInPacingDoesntAccumulateBudget) {
   pacer_->ProcessPackets();
 }
 
+TEST_P(PacingControllerTest, SendsBurstOfPacketsWithBurstInterval) {
+  if (PeriodicProcess()) {
+    // Bursts are only supported in dynamic mode.
+    return;
+  }
+
+  ::testing::NiceMock<MockPacketSender> callback;
+  PacingController pacer(&clock_, &callback, nullptr, nullptr, GetParam());
+  pacer.SetProbingEnabled(false);
+  // One packet per millisecond.
+  const DataSize kPacketSize = DataSize::Bytes(1000);
+  pacer.SetPacingRates(kPacketSize / TimeDelta::Millis(1), DataRate::Zero());
+  pacer.SetSendBurstInterval(TimeDelta::Millis(20));
+
+  for (int i = 0; i < 100; ++i) {
+    pacer.EnqueuePacket(BuildPacket(RtpPacketMediaType::kVideo, kVideoSsrc,
+                                    i, clock_.TimeInMilliseconds(),
+                                    kPacketSize.bytes()));
+  }
+
+  // Packets are sent until the debt exceeds the burst interval, and handed
+  // to the transport as one batch.
+  EXPECT_CALL(callback, SendPacket).Times(21);
+  EXPECT_CALL(callback, OnBatchComplete).Times(1);
+  pacer.ProcessPackets();
+  ::testing::Mock::VerifyAndClearExpectations(&callback);
+
+  // The next burst waits until the debt is drained.
+  EXPECT_EQ(pacer.NextSendTime() - clock_.CurrentTime(),
+            TimeDelta::Millis(21));
+  clock_.AdvanceTime(TimeDelta::Millis(21));
+  EXPECT_CALL(callback, SendPacket).Times(21);
+  EXPECT_CALL(callback, OnBatchComplete).Times(1);
+  pacer.ProcessPackets();
+}
+
+TEST_P(PacingControllerTest, NoBatchCompleteWithoutPacketsSent) {
+  ::testing::NiceMock<MockPacketSender> callback;
+  PacingController pacer(&clock_, &callback, nullptr, nullptr, GetParam());
+  pacer.SetPacingRates(kTargetRate, DataRate::Zero());
+  EXPECT_CALL(callback, OnBatchComplete).Times(0);
+  pacer.ProcessPackets();
+}
+
 INSTANTIATE_TEST_SUITE_P(
     WithAndWithoutIntervalBudget,
     PacingControllerTest,
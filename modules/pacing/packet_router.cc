@@ -106,6 +106,10 @@ void PacketRouter::RemoveSendRtpModule(RtpRtcpInterface* rtp_module) {
   if (last_send_module_ == rtp_module) {
     last_send_module_ = nullptr;
   }
+  send_modules_in_batch_.erase(
+      std::remove(send_modules_in_batch_.begin(), send_modules_in_batch_.end(),
+                  rtp_module),
+      send_modules_in_batch_.end());
   rtp_module->OnPacketSendingThreadSwitched();
 }
 
@@ -168,11 +172,24 @@ void PacketRouter::SendPacket(std::unique_ptr<RtpPacketToSend> packet,
     last_send_module_ = rtp_module;
   }
 
+  if (std::find(send_modules_in_batch_.begin(), send_modules_in_batch_.end(),
+                rtp_module) == send_modules_in_batch_.end()) {
+    send_modules_in_batch_.push_back(rtp_module);
+  }
+
   for (auto& packet : rtp_module->FetchFecPackets()) {
     pending_fec_packets_.push_back(std::move(packet));
   }
 }
 
+void PacketRouter::OnBatchComplete() {
+  MutexLock lock(&modules_mutex_);
+  for (RtpRtcpInterface* rtp_module : send_modules_in_batch_) {
+    rtp_module->OnBatchComplete();
+  }
+  send_modules_in_batch_.clear();
+}
+
 std::vector<std::unique_ptr<RtpPacketToSend>> PacketRouter::FetchFec() {
   MutexLock lock(&modules_mutex_);
   std::vector<std::unique_ptr<RtpPacketToSend>> fec_packets =
@@ -16,7 +16,6 @@
 
 #include <list>
 #include <memory>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -26,6 +25,7 @@
 #include "modules/rtp_rtcp/source/rtcp_packet.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
 #include "rtc_base/constructor_magic.h"
+#include "rtc_base/containers/flat_map.h"
 #include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/thread_annotations.h"
 
@@ -56,6 +56,7 @@ class PacketRouter : public PacingController::PacketSender {
   std::vector<std::unique_ptr<RtpPacketToSend>> FetchFec() override;
   std::vector<std::unique_ptr<RtpPacketToSend>> GeneratePadding(
       DataSize size) override;
+  void OnBatchComplete() override;
 
   uint16_t CurrentTransportSequenceNumber() const;
 
@@ -81,13 +82,17 @@ class PacketRouter : public PacingController::PacketSender {
       RTC_EXCLUSIVE_LOCKS_REQUIRED(modules_mutex_);
 
   mutable Mutex modules_mutex_;
-  // Ssrc to RtpRtcpInterface module;
-  std::unordered_map<uint32_t, RtpRtcpInterface*> send_modules_map_
+  // Ssrc to RtpRtcpInterface module, looked up for every packet sent. There
+  // are a few SSRCs per module, so a sorted vector is the fastest map.
+  flat_map<uint32_t, RtpRtcpInterface*> send_modules_map_
       RTC_GUARDED_BY(modules_mutex_);
   std::list<RtpRtcpInterface*> send_modules_list_
       RTC_GUARDED_BY(modules_mutex_);
   // The last module used to send media.
   RtpRtcpInterface* last_send_module_ RTC_GUARDED_BY(modules_mutex_);
+  // The modules that have sent packets since the last OnBatchComplete().
+  std::vector<RtpRtcpInterface*> send_modules_in_batch_
+      RTC_GUARDED_BY(modules_mutex_);
   // Rtcp modules of the rtp receivers.
   std::vector<RtcpFeedbackSenderInterface*> rtcp_feedback_senders_
       RTC_GUARDED_BY(modules_mutex_);
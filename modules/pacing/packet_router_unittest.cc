@@ -399,6 +399,48 @@ TEST_F(PacketRouterTest, SendPacketAssignsTransportSequenceNumbers) {
   packet_router_.RemoveSendRtpModule(&rtp_2);
 }
 
+TEST_F(PacketRouterTest, CompletesBatchOnModulesThatSentPackets) {
+  NiceMock<MockRtpRtcpInterface> rtp_1;
+  NiceMock<MockRtpRtcpInterface> rtp_2;
+  NiceMock<MockRtpRtcpInterface> rtp_3;
+
+  const uint16_t kSsrc1 = 1234;
+  const uint16_t kSsrc2 = 2345;
+  const uint16_t kSsrc3 = 3456;
+
+  ON_CALL(rtp_1, SSRC).WillByDefault(Return(kSsrc1));
+  ON_CALL(rtp_2, SSRC).WillByDefault(Return(kSsrc2));
+  ON_CALL(rtp_3, SSRC).WillByDefault(Return(kSsrc3));
+  ON_CALL(rtp_1, TrySendPacket).WillByDefault(Return(true));
+  ON_CALL(rtp_2, TrySendPacket).WillByDefault(Return(false));
+  ON_CALL(rtp_3, TrySendPacket).WillByDefault(Return(true));
+
+  packet_router_.AddSendRtpModule(&rtp_1, false);
+  packet_router_.AddSendRtpModule(&rtp_2, false);
+  packet_router_.AddSendRtpModule(&rtp_3, false);
+
+  packet_router_.SendPacket(BuildRtpPacket(kSsrc1), PacedPacketInfo());
+  packet_router_.SendPacket(BuildRtpPacket(kSsrc1), PacedPacketInfo());
+  packet_router_.SendPacket(BuildRtpPacket(kSsrc2), PacedPacketInfo());
+
+  // Only the module that sent packets completes the batch, once.
+  EXPECT_CALL(rtp_1, OnBatchComplete).Times(1);
+  EXPECT_CALL(rtp_2, OnBatchComplete).Times(0);
+  EXPECT_CALL(rtp_3, OnBatchComplete).Times(0);
+  packet_router_.OnBatchComplete();
+  ::testing::Mock::VerifyAndClearExpectations(&rtp_1);
+
+  // A module removed before the batch completes isn't called.
+  packet_router_.SendPacket(BuildRtpPacket(kSsrc3), PacedPacketInfo());
+  packet_router_.RemoveSendRtpModule(&rtp_3);
+  EXPECT_CALL(rtp_1, OnBatchComplete).Times(0);
+  EXPECT_CALL(rtp_3, OnBatchComplete).Times(0);
+  packet_router_.OnBatchComplete();
+
+  packet_router_.RemoveSendRtpModule(&rtp_1);
+  packet_router_.RemoveSendRtpModule(&rtp_2);
+}
+
 #if RTC_DCHECK_IS_ON && GTEST_HAS_DEATH_TEST && !defined(WEBRTC_ANDROID)
 using PacketRouterDeathTest = PacketRouterTest;
 TEST_F(PacketRouterDeathTest, DoubleRegistrationOfSendModuleDisallowed) {
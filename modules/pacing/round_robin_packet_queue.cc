@@ -30,14 +30,13 @@ RoundRobinPacketQueue::QueuedPacket::QueuedPacket(
     int priority,
     Timestamp enqueue_time,
     uint64_t enqueue_order,
-    std::multiset<Timestamp>::iterator enqueue_time_it,
     std::unique_ptr<RtpPacketToSend> packet)
     : priority_(priority),
       enqueue_time_(enqueue_time),
+      original_enqueue_time_(enqueue_time),
       enqueue_order_(enqueue_order),
       is_retransmission_(packet->packet_type() ==
                          RtpPacketMediaType::kRetransmission),
-      enqueue_time_it_(enqueue_time_it),
       owned_packet_(packet.release()) {}
 
 bool RoundRobinPacketQueue::QueuedPacket::operator<(
@@ -66,6 +65,10 @@ Timestamp RoundRobinPacketQueue::QueuedPacket::EnqueueTime() const {
   return enqueue_time_;
 }
 
+Timestamp RoundRobinPacketQueue::QueuedPacket::OriginalEnqueueTime() const {
+  return original_enqueue_time_;
+}
+
 bool RoundRobinPacketQueue::QueuedPacket::IsRetransmission() const {
   return Type() == RtpPacketMediaType::kRetransmission;
 }
@@ -78,16 +81,6 @@ RtpPacketToSend* RoundRobinPacketQueue::QueuedPacket::RtpPacket() const {
   return owned_packet_;
 }
 
-void RoundRobinPacketQueue::QueuedPacket::UpdateEnqueueTimeIterator(
-    std::multiset<Timestamp>::iterator it) {
-  enqueue_time_it_ = it;
-}
-
-std::multiset<Timestamp>::iterator
-RoundRobinPacketQueue::QueuedPacket::EnqueueTimeIterator() const {
-  return enqueue_time_it_;
-}
-
 void RoundRobinPacketQueue::QueuedPacket::SubtractPauseTime(
     TimeDelta pause_time_sum) {
   enqueue_time_ -= pause_time_sum;
@@ -103,7 +96,11 @@ RoundRobinPacketQueue::PriorityPacketQueue::end() const {
   return c.end();
 }
 
-RoundRobinPacketQueue::Stream::Stream() : size(DataSize::Zero()), ssrc(0) {}
+RoundRobinPacketQueue::Stream::Stream()
+    : size(DataSize::Zero()),
+      ssrc(0),
+      heap_index(kNotScheduled),
+      priority_key(0, DataSize::Zero(), 0) {}
 RoundRobinPacketQueue::Stream::Stream(const Stream& stream) = default;
 RoundRobinPacketQueue::Stream::~Stream() = default;
 
@@ -125,6 +122,7 @@ RoundRobinPacketQueue::RoundRobinPacketQueue(
       max_size_(kMaxLeadingSize),
       queue_time_sum_(TimeDelta::Zero()),
       pause_time_sum_(TimeDelta::Zero()),
+      schedule_order_(0),
       include_overhead_(false) {}
 
 RoundRobinPacketQueue::~RoundRobinPacketQueue() {
@@ -140,24 +138,34 @@ void RoundRobinPacketQueue::Push(int priority,
                                  std::unique_ptr<RtpPacketToSend> packet) {
   RTC_DCHECK(packet->packet_type().has_value());
   if (size_packets_ == 0) {
-    // Single packet fast-path.
-    single_packet_queue_.emplace(
-        QueuedPacket(priority, enqueue_time, enqueue_order,
-                     enqueue_times_.end(), std::move(packet)));
+    // Single packet fast-path. The packet is tracked with the pause time
+    // subtracted, also once it is promoted to the normal queue.
     UpdateQueueTime(enqueue_time);
-    single_packet_queue_->SubtractPauseTime(pause_time_sum_);
+    single_packet_queue_.emplace(priority, enqueue_time - pause_time_sum_,
+                                 enqueue_order, std::move(packet));
     size_packets_ = 1;
     size_ += PacketSize(*single_packet_queue_);
   } else {
     MaybePromoteSinglePacketToNormalQueue();
-    Push(QueuedPacket(priority, enqueue_time, enqueue_order,
-                      enqueue_times_.insert(enqueue_time), std::move(packet)));
+    QueuedPacket queued_packet(priority, enqueue_time, enqueue_order,
+                               std::move(packet));
+    // In order to figure out how much time a packet has spent in the queue
+    // while not in a paused state, we subtract the total amount of time the
+    // queue has been paused so far, and when the packet is popped we subtract
+    // the total amount of time the queue has been paused at that moment. This
+    // way we subtract the total amount of time the packet has spent in the
+    // queue while in a paused state.
+    UpdateQueueTime(enqueue_time);
+    queued_packet.SubtractPauseTime(pause_time_sum_);
+    size_packets_ += 1;
+    size_ += PacketSize(queued_packet);
+    Push(queued_packet);
   }
 }
 
 std::unique_ptr<RtpPacketToSend> RoundRobinPacketQueue::Pop() {
   if (single_packet_queue_.has_value()) {
-    RTC_DCHECK(stream_priorities_.empty());
+    RTC_DCHECK(stream_heap_.empty());
     std::unique_ptr<RtpPacketToSend> rtp_packet(
         single_packet_queue_->RtpPacket());
     single_packet_queue_.reset();
@@ -171,7 +179,7 @@ std::unique_ptr<RtpPacketToSend> RoundRobinPacketQueue::Pop() {
   Stream* stream = GetHighestPriorityStream();
   const QueuedPacket& queued_packet = stream->packet_queue.top();
 
-  stream_priorities_.erase(stream->priority_it);
+  UnscheduleHighestPriorityStream();
 
   // Calculate the total amount of time spent by this packet in the queue
   // while in a non-paused state. Note that the `pause_time_sum_ms_` was
@@ -182,8 +190,7 @@ std::unique_ptr<RtpPacketToSend> RoundRobinPacketQueue::Pop() {
       time_last_updated_ - queued_packet.EnqueueTime() - pause_time_sum_;
   queue_time_sum_ -= time_in_non_paused_state;
 
-  RTC_CHECK(queued_packet.EnqueueTimeIterator() != enqueue_times_.end());
-  enqueue_times_.erase(queued_packet.EnqueueTimeIterator());
+  RemoveEnqueueTime(queued_packet);
 
   // Update `bytes` of this stream. The general idea is that the stream that
   // has sent the least amount of bytes should have the highest priority.
@@ -204,13 +211,9 @@ std::unique_ptr<RtpPacketToSend> RoundRobinPacketQueue::Pop() {
   stream->packet_queue.pop();
 
   // If there are packets left to be sent, schedule the stream again.
-  RTC_CHECK(!IsSsrcScheduled(stream->ssrc));
-  if (stream->packet_queue.empty()) {
-    stream->priority_it = stream_priorities_.end();
-  } else {
-    int priority = stream->packet_queue.top().Priority();
-    stream->priority_it = stream_priorities_.emplace(
-        StreamPrioKey(priority, stream->size), stream->ssrc);
+  RTC_DCHECK_EQ(stream->heap_index, Stream::kNotScheduled);
+  if (!stream->packet_queue.empty()) {
+    ScheduleStream(stream, stream->packet_queue.top().Priority());
   }
 
   return rtp_packet;
@@ -218,10 +221,10 @@ std::unique_ptr<RtpPacketToSend> RoundRobinPacketQueue::Pop() {
 
 bool RoundRobinPacketQueue::Empty() const {
   if (size_packets_ == 0) {
-    RTC_DCHECK(!single_packet_queue_.has_value() && stream_priorities_.empty());
+    RTC_DCHECK(!single_packet_queue_.has_value() && stream_heap_.empty());
     return true;
   }
-  RTC_DCHECK(single_packet_queue_.has_value() || !stream_priorities_.empty());
+  RTC_DCHECK(single_packet_queue_.has_value() || !stream_heap_.empty());
   return false;
 }
 
@@ -242,12 +245,11 @@ absl::optional<Timestamp> RoundRobinPacketQueue::LeadingAudioPacketEnqueueTime()
     return absl::nullopt;
   }
 
-  if (stream_priorities_.empty()) {
+  if (stream_heap_.empty()) {
     return absl::nullopt;
   }
-  uint32_t ssrc = stream_priorities_.begin()->second;
 
-  const auto& top_packet = streams_.find(ssrc)->second.packet_queue.top();
+  const auto& top_packet = stream_heap_.front()->packet_queue.top();
   if (top_packet.Type() == RtpPacketMediaType::kAudio) {
     return top_packet.EnqueueTime();
   }
@@ -262,7 +264,7 @@ Timestamp RoundRobinPacketQueue::OldestEnqueueTime() const {
   if (Empty())
     return Timestamp::MinusInfinity();
   RTC_CHECK(!enqueue_times_.empty());
-  return *enqueue_times_.begin();
+  return enqueue_times_.front().first;
 }
 
 void RoundRobinPacketQueue::UpdateQueueTime(Timestamp now) {
@@ -324,45 +326,22 @@ void RoundRobinPacketQueue::Push(QueuedPacket packet) {
   auto stream_info_it = streams_.find(packet.Ssrc());
   if (stream_info_it == streams_.end()) {
     stream_info_it = streams_.emplace(packet.Ssrc(), Stream()).first;
-    stream_info_it->second.priority_it = stream_priorities_.end();
     stream_info_it->second.ssrc = packet.Ssrc();
   }
 
   Stream* stream = &stream_info_it->second;
 
-  if (stream->priority_it == stream_priorities_.end()) {
-    // If the SSRC is not currently scheduled, add it to `stream_priorities_`.
-    RTC_CHECK(!IsSsrcScheduled(stream->ssrc));
-    stream->priority_it = stream_priorities_.emplace(
-        StreamPrioKey(packet.Priority(), stream->size), packet.Ssrc());
-  } else if (packet.Priority() < stream->priority_it->first.priority) {
-    // If the priority of this SSRC increased, remove the outdated StreamPrioKey
-    // and insert a new one with the new priority. Note that `priority_` uses
-    // lower ordinal for higher priority.
-    stream_priorities_.erase(stream->priority_it);
-    stream->priority_it = stream_priorities_.emplace(
-        StreamPrioKey(packet.Priority(), stream->size), packet.Ssrc());
-  }
-  RTC_CHECK(stream->priority_it != stream_priorities_.end());
-
-  if (packet.EnqueueTimeIterator() == enqueue_times_.end()) {
-    // Promotion from single-packet queue. Just add to enqueue times.
-    packet.UpdateEnqueueTimeIterator(
-        enqueue_times_.insert(packet.EnqueueTime()));
-  } else {
-    // In order to figure out how much time a packet has spent in the queue
-    // while not in a paused state, we subtract the total amount of time the
-    // queue has been paused so far, and when the packet is popped we subtract
-    // the total amount of time the queue has been paused at that moment. This
-    // way we subtract the total amount of time the packet has spent in the
-    // queue while in a paused state.
-    UpdateQueueTime(packet.EnqueueTime());
-    packet.SubtractPauseTime(pause_time_sum_);
-
-    size_packets_ += 1;
-    size_ += PacketSize(packet);
+  if (stream->heap_index == Stream::kNotScheduled) {
+    // If the SSRC is not currently scheduled, add it to `stream_heap_`.
+    ScheduleStream(stream, packet.Priority());
+  } else if (packet.Priority() < stream->priority_key.priority) {
+    // If the priority of this SSRC increased, reschedule it with the new
+    // priority. Note that `priority_` uses lower ordinal for higher priority.
+    ScheduleStream(stream, packet.Priority());
   }
+  RTC_DCHECK_NE(stream->heap_index, Stream::kNotScheduled);
 
+  AddEnqueueTime(packet);
   stream->packet_queue.push(packet);
 }
 
@@ -385,22 +364,97 @@ void RoundRobinPacketQueue::MaybePromoteSinglePacketToNormalQueue() {
 
 RoundRobinPacketQueue::Stream*
 RoundRobinPacketQueue::GetHighestPriorityStream() {
-  RTC_CHECK(!stream_priorities_.empty());
-  uint32_t ssrc = stream_priorities_.begin()->second;
+  RTC_CHECK(!stream_heap_.empty());
+  Stream* stream = stream_heap_.front();
+  RTC_DCHECK_EQ(stream->heap_index, 0);
+  RTC_CHECK(!stream->packet_queue.empty());
+  return stream;
+}
+
+void RoundRobinPacketQueue::ScheduleStream(Stream* stream, int priority) {
+  // A rescheduled stream goes after the streams with the same priority and
+  // size, as if it had been removed and scheduled again.
+  stream->priority_key =
+      StreamPrioKey(priority, stream->size, schedule_order_++);
+  if (stream->heap_index == Stream::kNotScheduled) {
+    stream_heap_.push_back(stream);
+    stream->heap_index = stream_heap_.size() - 1;
+  }
+  // The size of a scheduled stream doesn't change, and it is only
+  // rescheduled when its priority increases, so it can only move up.
+  SiftUp(stream->heap_index);
+}
+
+void RoundRobinPacketQueue::UnscheduleHighestPriorityStream() {
+  RTC_DCHECK(!stream_heap_.empty());
+  stream_heap_.front()->heap_index = Stream::kNotScheduled;
+  Stream* last = stream_heap_.back();
+  stream_heap_.pop_back();
+  if (!stream_heap_.empty()) {
+    PlaceInHeap(last, 0);
+    SiftDown(0);
+  }
+}
 
-  auto stream_info_it = streams_.find(ssrc);
-  RTC_CHECK(stream_info_it != streams_.end());
-  RTC_CHECK(stream_info_it->second.priority_it == stream_priorities_.begin());
-  RTC_CHECK(!stream_info_it->second.packet_queue.empty());
-  return &stream_info_it->second;
+void RoundRobinPacketQueue::SiftUp(size_t index) {
+  Stream* stream = stream_heap_[index];
+  while (index > 0) {
+    size_t parent = (index - 1) / 2;
+    if (!(stream->priority_key < stream_heap_[parent]->priority_key))
+      break;
+    PlaceInHeap(stream_heap_[parent], index);
+    index = parent;
+  }
+  PlaceInHeap(stream, index);
+}
+
+void RoundRobinPacketQueue::SiftDown(size_t index) {
+  Stream* stream = stream_heap_[index];
+  const size_t size = stream_heap_.size();
+  while (true) {
+    size_t child = 2 * index + 1;
+    if (child >= size)
+      break;
+    if (child + 1 < size && stream_heap_[child + 1]->priority_key <
+                                stream_heap_[child]->priority_key) {
+      ++child;
+    }
+    if (!(stream_heap_[child]->priority_key < stream->priority_key))
+      break;
+    PlaceInHeap(stream_heap_[child], index);
+    index = child;
+  }
+  PlaceInHeap(stream, index);
 }
 
-bool RoundRobinPacketQueue::IsSsrcScheduled(uint32_t ssrc) const {
-  for (const auto& scheduled_stream : stream_priorities_) {
-    if (scheduled_stream.second == ssrc)
-      return true;
+void RoundRobinPacketQueue::PlaceInHeap(Stream* stream, size_t index) {
+  stream_heap_[index] = stream;
+  stream->heap_index = index;
+}
+
+void RoundRobinPacketQueue::AddEnqueueTime(const QueuedPacket& packet) {
+  const Timestamp enqueue_time = packet.OriginalEnqueueTime();
+  // UpdateQueueTime() makes sure that packets are pushed in order of time.
+  RTC_DCHECK(enqueue_times_.empty() ||
+             enqueue_times_.back().first <= enqueue_time);
+  if (!enqueue_times_.empty() && enqueue_times_.back().first == enqueue_time) {
+    ++enqueue_times_.back().second;
+  } else {
+    enqueue_times_.emplace_back(enqueue_time, 1);
+  }
+}
+
+void RoundRobinPacketQueue::RemoveEnqueueTime(const QueuedPacket& packet) {
+  const Timestamp enqueue_time = packet.OriginalEnqueueTime();
+  auto it = std::lower_bound(
+      enqueue_times_.begin(), enqueue_times_.end(), enqueue_time,
+      [](const std::pair<Timestamp, size_t>& entry, Timestamp time) {
+        return entry.first < time;
+      });
+  RTC_CHECK(it != enqueue_times_.end() && it->first == enqueue_time);
+  if (--it->second == 0) {
+    enqueue_times_.erase(it);
   }
-  return false;
 }
 
 }  // namespace webrtc
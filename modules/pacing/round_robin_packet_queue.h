@@ -14,12 +14,12 @@
 #include <stddef.h>
 #include <stdint.h>
 
-#include <list>
-#include <map>
+#include <deque>
 #include <memory>
 #include <queue>
-#include <set>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "absl/types/optional.h"
 #include "api/transport/webrtc_key_value_config.h"
@@ -66,7 +66,6 @@ class RoundRobinPacketQueue {
     QueuedPacket(int priority,
                  Timestamp enqueue_time,
                  uint64_t enqueue_order,
-                 std::multiset<Timestamp>::iterator enqueue_time_it,
                  std::unique_ptr<RtpPacketToSend> packet);
     QueuedPacket(const QueuedPacket& rhs);
     ~QueuedPacket();
@@ -77,20 +76,20 @@ class RoundRobinPacketQueue {
     RtpPacketMediaType Type() const;
     uint32_t Ssrc() const;
     Timestamp EnqueueTime() const;
+    // The enqueue time before pause time was subtracted.
+    Timestamp OriginalEnqueueTime() const;
     bool IsRetransmission() const;
     uint64_t EnqueueOrder() const;
     RtpPacketToSend* RtpPacket() const;
 
-    std::multiset<Timestamp>::iterator EnqueueTimeIterator() const;
-    void UpdateEnqueueTimeIterator(std::multiset<Timestamp>::iterator it);
     void SubtractPauseTime(TimeDelta pause_time_sum);
 
    private:
     int priority_;
     Timestamp enqueue_time_;  // Absolute time of pacer queue entry.
+    Timestamp original_enqueue_time_;
     uint64_t enqueue_order_;
     bool is_retransmission_;  // Cached for performance.
-    std::multiset<Timestamp>::iterator enqueue_time_it_;
     // Raw pointer since priority_queue doesn't allow for moving
     // out of the container.
     RtpPacketToSend* owned_packet_;
@@ -104,20 +103,27 @@ class RoundRobinPacketQueue {
   };
 
   struct StreamPrioKey {
-    StreamPrioKey(int priority, DataSize size)
-        : priority(priority), size(size) {}
+    StreamPrioKey(int priority, DataSize size, uint64_t order)
+        : priority(priority), size(size), order(order) {}
 
     bool operator<(const StreamPrioKey& other) const {
       if (priority != other.priority)
         return priority < other.priority;
-      return size < other.size;
+      if (size != other.size)
+        return size < other.size;
+      return order < other.order;
     }
 
-    const int priority;
-    const DataSize size;
+    int priority;
+    DataSize size;
+    // Streams with the same priority and size are sent in the order they
+    // were scheduled.
+    uint64_t order;
   };
 
   struct Stream {
+    static constexpr size_t kNotScheduled = static_cast<size_t>(-1);
+
     Stream();
     Stream(const Stream&);
 
@@ -128,12 +134,13 @@ class RoundRobinPacketQueue {
 
     PriorityPacketQueue packet_queue;
 
-    // Whenever a packet is inserted for this stream we check if `priority_it`
-    // points to an element in `stream_priorities_`, and if it does it means
-    // this stream has already been scheduled, and if the scheduled priority is
+    // Whenever a packet is inserted for this stream we check if `heap_index`
+    // is the index of the stream in `stream_heap_`, and if it is it means this
+    // stream has already been scheduled, and if the scheduled priority is
     // lower than the priority of the incoming packet we reschedule this stream
     // with the higher priority.
-    std::multimap<StreamPrioKey, uint32_t>::iterator priority_it;
+    size_t heap_index;
+    StreamPrioKey priority_key;
   };
 
   void Push(QueuedPacket packet);
@@ -143,8 +150,19 @@ class RoundRobinPacketQueue {
 
   Stream* GetHighestPriorityStream();
 
-  // Just used to verify correctness.
-  bool IsSsrcScheduled(uint32_t ssrc) const;
+  // Adds `stream` to `stream_heap_`, or moves it to its new place there if
+  // it is already scheduled.
+  void ScheduleStream(Stream* stream, int priority);
+  void UnscheduleHighestPriorityStream();
+  // Moves the stream at `index` of `stream_heap_` towards the top or bottom
+  // until the heap is ordered again.
+  void SiftUp(size_t index);
+  void SiftDown(size_t index);
+  void PlaceInHeap(Stream* stream, size_t index);
+
+  // Tracks the enqueue time of `packet` in `enqueue_times_`.
+  void AddEnqueueTime(const QueuedPacket& packet);
+  void RemoveEnqueueTime(const QueuedPacket& packet);
 
   DataSize transport_overhead_per_packet_;
 
@@ -157,18 +175,22 @@ class RoundRobinPacketQueue {
   TimeDelta queue_time_sum_;
   TimeDelta pause_time_sum_;
 
-  // A map of streams used to prioritize from which stream to send next. We use
-  // a multimap instead of a priority_queue since the priority of a stream can
-  // change as a new packet is inserted, and a multimap allows us to remove and
-  // then reinsert a StreamPrioKey if the priority has increased.
-  std::multimap<StreamPrioKey, uint32_t> stream_priorities_;
+  // A binary min-heap of the streams that have packets, ordered by their
+  // `priority_key`, used to prioritize from which stream to send next. We use
+  // a heap of our own instead of a priority_queue since the priority of a
+  // stream can change as a new packet is inserted. Each stream knows its
+  // index in the heap, which lets it move up when its priority increases.
+  std::vector<Stream*> stream_heap_;
+  uint64_t schedule_order_;
 
-  // A map of SSRCs to Streams.
+  // A map of SSRCs to Streams. The Streams don't move once inserted.
   std::unordered_map<uint32_t, Stream> streams_;
 
-  // The enqueue time of every packet currently in the queue. Used to figure out
-  // the age of the oldest packet in the queue.
-  std::multiset<Timestamp> enqueue_times_;
+  // The number of packets enqueued at each time, for every packet currently
+  // in the queue, in order of time. Used to figure out the age of the oldest
+  // packet in the queue. Packets are enqueued in order of time, so new times
+  // are appended at the back, and most packets leave at the front.
+  std::deque<std::pair<Timestamp, size_t>> enqueue_times_;
 
   absl::optional<QueuedPacket> single_packet_queue_;
 
@@ -0,0 +1,99 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+
+#include <memory>
+#include <utility>
+
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "benchmark/benchmark.h"
+#include "modules/pacing/round_robin_packet_queue.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/system/unused.h"
+#include "test/explicit_key_value_config.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint32_t kBaseSsrc = 1000;
+constexpr size_t kPayloadSize = 1000;
+// 100k packets per second.
+constexpr TimeDelta kPacketInterval = TimeDelta::Micros(10);
+
+// Every 10th stream is audio, the others video with every 10th packet a
+// retransmission, prioritized in the same order as in PacingController.
+void SetStreamPacket(int stream, int sequence, RtpPacketToSend* packet) {
+  packet->SetSsrc(kBaseSsrc + stream);
+  if (stream % 10 == 0) {
+    packet->set_packet_type(RtpPacketMediaType::kAudio);
+  } else if (sequence % 10 == 0) {
+    packet->set_packet_type(RtpPacketMediaType::kRetransmission);
+  } else {
+    packet->set_packet_type(RtpPacketMediaType::kVideo);
+  }
+}
+
+int Priority(const RtpPacketToSend& packet) {
+  switch (*packet.packet_type()) {
+    case RtpPacketMediaType::kAudio:
+      return 0;
+    case RtpPacketMediaType::kRetransmission:
+      return 1;
+    default:
+      return 2;
+  }
+}
+
+// Keeps `backlog` packets of `streams` streams in the queue while a packet is
+// pushed and another popped every `kPacketInterval`. The popped packets are
+// pushed again, so that the allocations measured are those of the queue.
+void BM_PushPop(benchmark::State& state) {
+  const int num_streams = state.range(0);
+  const int backlog = state.range(1);
+  const test::ExplicitKeyValueConfig field_trials("");
+  Timestamp now = Timestamp::Seconds(1);
+  RoundRobinPacketQueue queue(now, &field_trials);
+  uint64_t enqueue_order = 0;
+  int sequence = 0;
+  auto push = [&](std::unique_ptr<RtpPacketToSend> packet) {
+    SetStreamPacket(sequence % num_streams, sequence / num_streams,
+                    packet.get());
+    ++sequence;
+    const int priority = Priority(*packet);
+    queue.Push(priority, now, enqueue_order++, std::move(packet));
+  };
+  for (int i = 0; i < backlog; ++i) {
+    auto packet = std::make_unique<RtpPacketToSend>(/*extensions=*/nullptr);
+    packet->SetPayloadSize(kPayloadSize);
+    push(std::move(packet));
+  }
+
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    now += kPacketInterval;
+    queue.UpdateQueueTime(now);
+    push(queue.Pop());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// {streams, packets in the queue}.
+BENCHMARK(BM_PushPop)
+    ->ArgNames({"streams", "backlog"})
+    ->Args({1, 10})
+    ->Args({50, 100})
+    ->Args({50, 1000})
+    ->Args({50, 10000});
+
+}  // namespace
+}  // namespace webrtc
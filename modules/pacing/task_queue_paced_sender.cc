@@ -29,7 +29,50 @@ TaskQueuePacedSender::TaskQueuePacedSender(
     TaskQueueFactory* task_queue_factory,
     TimeDelta max_hold_back_window,
     int max_hold_back_window_in_packets)
+    : TaskQueuePacedSender(
+          clock,
+          packet_sender,
+          event_log,
+          field_trials,
+          task_queue_factory->CreateTaskQueue(
+              "TaskQueuePacedSender",
+              TaskQueueFactory::Priority::NORMAL),
+          /*pacer_pool=*/nullptr,
+          max_hold_back_window,
+          max_hold_back_window_in_packets) {}
+
+TaskQueuePacedSender::TaskQueuePacedSender(
+    Clock* clock,
+    PacingController::PacketSender* packet_sender,
+    RtcEventLog* event_log,
+    const WebRtcKeyValueConfig* field_trials,
+    TaskQueuePacerPool* pacer_pool,
+    TimeDelta max_hold_back_window,
+    int max_hold_back_window_in_packets)
+    : TaskQueuePacedSender(clock,
+                           packet_sender,
+                           event_log,
+                           field_trials,
+                           /*owned_task_queue=*/nullptr,
+                           pacer_pool,
+                           max_hold_back_window,
+                           max_hold_back_window_in_packets) {
+  RTC_DCHECK(pacer_pool);
+}
+
+TaskQueuePacedSender::TaskQueuePacedSender(
+    Clock* clock,
+    PacingController::PacketSender* packet_sender,
+    RtcEventLog* event_log,
+    const WebRtcKeyValueConfig* field_trials,
+    std::unique_ptr<TaskQueueBase, TaskQueueDeleter> owned_task_queue,
+    TaskQueuePacerPool* pacer_pool,
+    TimeDelta max_hold_back_window,
+    int max_hold_back_window_in_packets)
     : clock_(clock),
+      pacer_pool_(pacer_pool),
+      task_queue_(pacer_pool ? pacer_pool->AddMember(this)
+                             : owned_task_queue.get()),
       max_hold_back_window_(max_hold_back_window),
       max_hold_back_window_in_packets_(max_hold_back_window_in_packets),
       pacing_controller_(clock,
@@ -41,66 +84,81 @@ TaskQueuePacedSender::TaskQueuePacedSender(
       is_started_(false),
       is_shutdown_(false),
       packet_size_(/*alpha=*/0.95),
-      task_queue_(task_queue_factory->CreateTaskQueue(
-          "TaskQueuePacedSender",
-          TaskQueueFactory::Priority::NORMAL)) {
+      safety_(PendingTaskSafetyFlag::CreateDetached()),
+      owned_task_queue_(std::move(owned_task_queue)) {
   packet_size_.Apply(1, 0);
 }
 
 TaskQueuePacedSender::~TaskQueuePacedSender() {
+  if (pacer_pool_) {
+    // The shared task queue keeps running, so wait until the pacer has left
+    // the pool and none of its tasks will run anymore.
+    RTC_DCHECK(!task_queue_->IsCurrent());
+    rtc::Event done;
+    task_queue_->PostTask(ToQueuedTask([this, &done]() {
+      RTC_DCHECK_RUN_ON(task_queue_);
+      is_shutdown_ = true;
+      safety_->SetNotAlive();
+      pacer_pool_->RemoveMember(this);
+      done.Set();
+    }));
+    done.Wait(rtc::Event::kForever);
+    return;
+  }
   // Post an immediate task to mark the queue as shutting down.
-  // The rtc::TaskQueue destructor will wait for pending tasks to
+  // The task queue destructor will wait for pending tasks to
   // complete before continuing.
-  task_queue_.PostTask([&]() {
-    RTC_DCHECK_RUN_ON(&task_queue_);
+  task_queue_->PostTask(ToQueuedTask([&]() {
+    RTC_DCHECK_RUN_ON(task_queue_);
     is_shutdown_ = true;
-  });
+  }));
 }
 
 void TaskQueuePacedSender::EnsureStarted() {
-  task_queue_.PostTask([this]() {
-    RTC_DCHECK_RUN_ON(&task_queue_);
+  task_queue_->PostTask(ToQueuedTask(safety_, [this]() {
+    RTC_DCHECK_RUN_ON(task_queue_);
     is_started_ = true;
     MaybeProcessPackets(Timestamp::MinusInfinity());
-  });
+  }));
 }
 
 void TaskQueuePacedSender::CreateProbeCluster(DataRate bitrate,
                                               int cluster_id) {
-  task_queue_.PostTask([this, bitrate, cluster_id]() {
-    RTC_DCHECK_RUN_ON(&task_queue_);
+  task_queue_->PostTask(ToQueuedTask(safety_, [this, bitrate, cluster_id]() {
+    RTC_DCHECK_RUN_ON(task_queue_);
     pacing_controller_.CreateProbeCluster(bitrate, cluster_id);
     MaybeProcessPackets(Timestamp::MinusInfinity());
-  });
+  }));
 }
 
 void TaskQueuePacedSender::Pause() {
-  task_queue_.PostTask([this]() {
-    RTC_DCHECK_RUN_ON(&task_queue_);
+  task_queue_->PostTask(ToQueuedTask(safety_, [this]() {
+    RTC_DCHECK_RUN_ON(task_queue_);
     pacing_controller_.Pause();
-  });
+  }));
 }
 
 void TaskQueuePacedSender::Resume() {
-  task_queue_.PostTask([this]() {
-    RTC_DCHECK_RUN_ON(&task_queue_);
+  task_queue_->PostTask(ToQueuedTask(safety_, [this]() {
+    RTC_DCHECK_RUN_ON(task_queue_);
     pacing_controller_.Resume();
     MaybeProcessPackets(Timestamp::MinusInfinity());
-  });
+  }));
 }
 
 void TaskQueuePacedSender::SetCongestionWindow(
     DataSize congestion_window_size) {
-  task_queue_.PostTask([this, congestion_window_size]() {
-    RTC_DCHECK_RUN_ON(&task_queue_);
-    pacing_controller_.SetCongestionWindow(congestion_window_size);
-    MaybeProcessPackets(Timestamp::MinusInfinity());
-  });
+  task_queue_->PostTask(
+      ToQueuedTask(safety_, [this, congestion_window_size]() {
+        RTC_DCHECK_RUN_ON(task_queue_);
+        pacing_controller_.SetCongestionWindow(congestion_window_size);
+        MaybeProcessPackets(Timestamp::MinusInfinity());
+      }));
 }
 
 void TaskQueuePacedSender::UpdateOutstandingData(DataSize outstanding_data) {
-  if (task_queue_.IsCurrent()) {
-    RTC_DCHECK_RUN_ON(&task_queue_);
+  if (task_queue_->IsCurrent()) {
+    RTC_DCHECK_RUN_ON(task_queue_);
     // Fast path since this can be called once per sent packet while on the
     // task queue.
     pacing_controller_.UpdateOutstandingData(outstanding_data);
@@ -108,20 +166,21 @@ void TaskQueuePacedSender::UpdateOutstandingData(DataSize outstanding_data) {
     return;
   }
 
-  task_queue_.PostTask([this, outstanding_data]() {
-    RTC_DCHECK_RUN_ON(&task_queue_);
+  task_queue_->PostTask(ToQueuedTask(safety_, [this, outstanding_data]() {
+    RTC_DCHECK_RUN_ON(task_queue_);
     pacing_controller_.UpdateOutstandingData(outstanding_data);
     MaybeProcessPackets(Timestamp::MinusInfinity());
-  });
+  }));
 }
 
 void TaskQueuePacedSender::SetPacingRates(DataRate pacing_rate,
                                           DataRate padding_rate) {
-  task_queue_.PostTask([this, pacing_rate, padding_rate]() {
-    RTC_DCHECK_RUN_ON(&task_queue_);
-    pacing_controller_.SetPacingRates(pacing_rate, padding_rate);
-    MaybeProcessPackets(Timestamp::MinusInfinity());
-  });
+  task_queue_->PostTask(
+      ToQueuedTask(safety_, [this, pacing_rate, padding_rate]() {
+        RTC_DCHECK_RUN_ON(task_queue_);
+        pacing_controller_.SetPacingRates(pacing_rate, padding_rate);
+        MaybeProcessPackets(Timestamp::MinusInfinity());
+      }));
 }
 
 void TaskQueuePacedSender::EnqueuePackets(
@@ -137,47 +196,56 @@ void TaskQueuePacedSender::EnqueuePackets(
   }
 #endif
 
-  task_queue_.PostTask([this, packets_ = std::move(packets)]() mutable {
-    RTC_DCHECK_RUN_ON(&task_queue_);
-    for (auto& packet : packets_) {
-      packet_size_.Apply(1, packet->size());
-      RTC_DCHECK_GE(packet->capture_time_ms(), 0);
-      pacing_controller_.EnqueuePacket(std::move(packet));
-    }
-    MaybeProcessPackets(Timestamp::MinusInfinity());
-  });
+  task_queue_->PostTask(
+      ToQueuedTask(safety_, [this, packets_ = std::move(packets)]() mutable {
+        RTC_DCHECK_RUN_ON(task_queue_);
+        for (auto& packet : packets_) {
+          packet_size_.Apply(1, packet->size());
+          RTC_DCHECK_GE(packet->capture_time_ms(), 0);
+          pacing_controller_.EnqueuePacket(std::move(packet));
+        }
+        MaybeProcessPackets(Timestamp::MinusInfinity());
+      }));
 }
 
 void TaskQueuePacedSender::SetAccountForAudioPackets(bool account_for_audio) {
-  task_queue_.PostTask([this, account_for_audio]() {
-    RTC_DCHECK_RUN_ON(&task_queue_);
+  task_queue_->PostTask(ToQueuedTask(safety_, [this, account_for_audio]() {
+    RTC_DCHECK_RUN_ON(task_queue_);
     pacing_controller_.SetAccountForAudioPackets(account_for_audio);
     MaybeProcessPackets(Timestamp::MinusInfinity());
-  });
+  }));
 }
 
 void TaskQueuePacedSender::SetIncludeOverhead() {
-  task_queue_.PostTask([this]() {
-    RTC_DCHECK_RUN_ON(&task_queue_);
+  task_queue_->PostTask(ToQueuedTask(safety_, [this]() {
+    RTC_DCHECK_RUN_ON(task_queue_);
     pacing_controller_.SetIncludeOverhead();
     MaybeProcessPackets(Timestamp::MinusInfinity());
-  });
+  }));
 }
 
 void TaskQueuePacedSender::SetTransportOverhead(DataSize overhead_per_packet) {
-  task_queue_.PostTask([this, overhead_per_packet]() {
-    RTC_DCHECK_RUN_ON(&task_queue_);
+  task_queue_->PostTask(ToQueuedTask(safety_, [this, overhead_per_packet]() {
+    RTC_DCHECK_RUN_ON(task_queue_);
     pacing_controller_.SetTransportOverhead(overhead_per_packet);
     MaybeProcessPackets(Timestamp::MinusInfinity());
-  });
+  }));
 }
 
 void TaskQueuePacedSender::SetQueueTimeLimit(TimeDelta limit) {
-  task_queue_.PostTask([this, limit]() {
-    RTC_DCHECK_RUN_ON(&task_queue_);
+  task_queue_->PostTask(ToQueuedTask(safety_, [this, limit]() {
+    RTC_DCHECK_RUN_ON(task_queue_);
     pacing_controller_.SetQueueTimeLimit(limit);
     MaybeProcessPackets(Timestamp::MinusInfinity());
-  });
+  }));
+}
+
+void TaskQueuePacedSender::SetSendBurstInterval(TimeDelta burst_interval) {
+  task_queue_->PostTask(ToQueuedTask(safety_, [this, burst_interval]() {
+    RTC_DCHECK_RUN_ON(task_queue_);
+    pacing_controller_.SetSendBurstInterval(burst_interval);
+    MaybeProcessPackets(Timestamp::MinusInfinity());
+  }));
 }
 
 TimeDelta TaskQueuePacedSender::ExpectedQueueTime() const {
@@ -209,9 +277,16 @@ void TaskQueuePacedSender::OnStatsUpdated(const Stats& stats) {
   current_stats_ = stats;
 }
 
+void TaskQueuePacedSender::OnProcessTimer() {
+  RTC_DCHECK_RUN_ON(task_queue_);
+  // The pool keeps only the last scheduled time, so this is always the
+  // scheduled call.
+  MaybeProcessPackets(next_process_time_);
+}
+
 void TaskQueuePacedSender::MaybeProcessPackets(
     Timestamp scheduled_process_time) {
-  RTC_DCHECK_RUN_ON(&task_queue_);
+  RTC_DCHECK_RUN_ON(task_queue_);
 
   if (is_shutdown_ || !is_started_) {
     return;
@@ -271,9 +346,18 @@ void TaskQueuePacedSender::MaybeProcessPackets(
     // Set a new scheduled process time and post a delayed task.
     next_process_time_ = next_process_time;
 
-    task_queue_.PostDelayedTask(
-        [this, next_process_time]() { MaybeProcessPackets(next_process_time); },
-        time_to_next_process->ms<uint32_t>());
+    if (pacer_pool_) {
+      pacer_pool_->ScheduleProcess(this, now + *time_to_next_process);
+    } else {
+      // High precision, since waking up late makes the pacer send a larger
+      // burst to catch up.
+      task_queue_->PostDelayedHighPrecisionTask(
+          ToQueuedTask(safety_,
+                       [this, next_process_time]() {
+                         MaybeProcessPackets(next_process_time);
+                       }),
+          *time_to_next_process);
+    }
   }
 
   UpdateStats();
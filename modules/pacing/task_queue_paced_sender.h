@@ -21,6 +21,7 @@
 
 #include "absl/types/optional.h"
 #include "api/sequence_checker.h"
+#include "api/task_queue/task_queue_base.h"
 #include "api/task_queue/task_queue_factory.h"
 #include "api/units/data_size.h"
 #include "api/units/time_delta.h"
@@ -28,17 +29,20 @@
 #include "modules/include/module.h"
 #include "modules/pacing/pacing_controller.h"
 #include "modules/pacing/rtp_packet_pacer.h"
+#include "modules/pacing/task_queue_pacer_pool.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
 #include "rtc_base/numerics/exp_filter.h"
 #include "rtc_base/synchronization/mutex.h"
-#include "rtc_base/task_queue.h"
+#include "rtc_base/task_utils/pending_task_safety_flag.h"
 #include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
 class Clock;
 class RtcEventLog;
 
-class TaskQueuePacedSender : public RtpPacketPacer, public RtpPacketSender {
+class TaskQueuePacedSender : public RtpPacketPacer,
+                             public RtpPacketSender,
+                             private TaskQueuePacerPool::Member {
  public:
   // The `hold_back_window` parameter sets a lower bound on time to sleep if
   // there is currently a pacer queue and packets can't immediately be
@@ -54,6 +58,17 @@ class TaskQueuePacedSender : public RtpPacketPacer, public RtpPacketSender {
       TimeDelta max_hold_back_window = PacingController::kMinSleepTime,
       int max_hold_back_window_in_packets = -1);
 
+  // Runs on a task queue of `pacer_pool` instead of a task queue of its own.
+  // The pool must outlive the pacer.
+  TaskQueuePacedSender(
+      Clock* clock,
+      PacingController::PacketSender* packet_sender,
+      RtcEventLog* event_log,
+      const WebRtcKeyValueConfig* field_trials,
+      TaskQueuePacerPool* pacer_pool,
+      TimeDelta max_hold_back_window = PacingController::kMinSleepTime,
+      int max_hold_back_window_in_packets = -1);
+
   ~TaskQueuePacedSender() override;
 
   // Ensure that necessary delayed tasks are scheduled.
@@ -108,6 +123,9 @@ class TaskQueuePacedSender : public RtpPacketPacer, public RtpPacketSender {
   // specified by SetPacingRates() if needed to achieve this goal.
   void SetQueueTimeLimit(TimeDelta limit) override;
 
+  // See PacingController::SetSendBurstInterval().
+  void SetSendBurstInterval(TimeDelta burst_interval);
+
  protected:
   // Exposed as protected for test.
   struct Stats {
@@ -123,6 +141,19 @@ class TaskQueuePacedSender : public RtpPacketPacer, public RtpPacketSender {
   void OnStatsUpdated(const Stats& stats);
 
  private:
+  TaskQueuePacedSender(
+      Clock* clock,
+      PacingController::PacketSender* packet_sender,
+      RtcEventLog* event_log,
+      const WebRtcKeyValueConfig* field_trials,
+      std::unique_ptr<TaskQueueBase, TaskQueueDeleter> owned_task_queue,
+      TaskQueuePacerPool* pacer_pool,
+      TimeDelta max_hold_back_window,
+      int max_hold_back_window_in_packets);
+
+  // Implements TaskQueuePacerPool::Member.
+  void OnProcessTimer() override;
+
   // Check if it is time to send packets, or schedule a delayed task if not.
   // Use Timestamp::MinusInfinity() to indicate that this call has _not_
   // been scheduled by the pacing controller. If this is the case, check if
@@ -134,6 +165,9 @@ class TaskQueuePacedSender : public RtpPacketPacer, public RtpPacketSender {
   Stats GetStats() const;
 
   Clock* const clock_;
+  TaskQueuePacerPool* const pacer_pool_;
+  // Either `owned_task_queue_` or a task queue of `pacer_pool_`.
+  TaskQueueBase* const task_queue_;
   const TimeDelta max_hold_back_window_;
   const int max_hold_back_window_in_packets_;
 
@@ -142,7 +176,8 @@ class TaskQueuePacedSender : public RtpPacketPacer, public RtpPacketSender {
   // We want only one (valid) delayed process task in flight at a time.
   // If the value of `next_process_time_` is finite, it is an id for a
   // delayed task that will call MaybeProcessPackets() with that time
-  // as parameter.
+  // as parameter. With a pacer pool, it is the time of the process timer
+  // scheduled in the pool.
   // Timestamp::MinusInfinity() indicates no valid pending task.
   Timestamp next_process_time_ RTC_GUARDED_BY(task_queue_);
 
@@ -161,7 +196,12 @@ class TaskQueuePacedSender : public RtpPacketPacer, public RtpPacketSender {
   mutable Mutex stats_mutex_;
   Stats current_stats_ RTC_GUARDED_BY(stats_mutex_);
 
-  rtc::TaskQueue task_queue_;
+  // Tasks posted to a shared task queue may outlive the pacer.
+  const rtc::scoped_refptr<PendingTaskSafetyFlag> safety_;
+
+  // Declared last, so that it is destroyed, and its pending tasks with it,
+  // before the state they use.
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> owned_task_queue_;
 };
 }  // namespace webrtc
 #endif  // MODULES_PACING_TASK_QUEUE_PACED_SENDER_H_
@@ -0,0 +1,137 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/task_queue_pacer_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/task_utils/to_queued_task.h"
+
+namespace webrtc {
+
+constexpr TimeDelta TaskQueuePacerPool::kDefaultResolution;
+
+TaskQueuePacerPool::TaskQueuePacerPool(Clock* clock,
+                                       TaskQueueFactory* task_queue_factory,
+                                       int num_task_queues,
+                                       TimeDelta resolution)
+    : clock_(clock), resolution_(resolution) {
+  RTC_DCHECK_GT(num_task_queues, 0);
+  RTC_DCHECK_GT(resolution_, TimeDelta::Zero());
+  for (int i = 0; i < num_task_queues; ++i) {
+    auto worker = std::make_unique<Worker>();
+    worker->task_queue = task_queue_factory->CreateTaskQueue(
+        "TaskQueuePacerPool", TaskQueueFactory::Priority::NORMAL);
+    workers_.push_back(std::move(worker));
+  }
+}
+
+TaskQueuePacerPool::~TaskQueuePacerPool() {
+  RTC_DCHECK_EQ(num_members(), 0);
+  // Deleting a task queue waits for its running task, and drops the pending
+  // ones, which may refer to the worker.
+  for (auto& worker : workers_) {
+    worker->task_queue = nullptr;
+  }
+}
+
+TaskQueueBase* TaskQueuePacerPool::AddMember(Member* member) {
+  RTC_DCHECK(member);
+  MutexLock lock(&mutex_);
+  Worker* worker = std::min_element(workers_.begin(), workers_.end(),
+                                    [](const std::unique_ptr<Worker>& a,
+                                       const std::unique_ptr<Worker>& b) {
+                                      return a->num_members < b->num_members;
+                                    })
+                       ->get();
+  ++worker->num_members;
+  return worker->task_queue.get();
+}
+
+void TaskQueuePacerPool::RemoveMember(Member* member) {
+  Worker* worker = CurrentWorker();
+  worker->process_times.erase(member);
+  MutexLock lock(&mutex_);
+  RTC_DCHECK_GT(worker->num_members, 0);
+  --worker->num_members;
+}
+
+void TaskQueuePacerPool::ScheduleProcess(Member* member, Timestamp at_time) {
+  Worker* worker = CurrentWorker();
+  worker->process_times.insert_or_assign(member, at_time);
+  MaybeStartTimer(worker, at_time);
+}
+
+size_t TaskQueuePacerPool::num_members() const {
+  MutexLock lock(&mutex_);
+  size_t num_members = 0;
+  for (const auto& worker : workers_) {
+    num_members += worker->num_members;
+  }
+  return num_members;
+}
+
+TaskQueuePacerPool::Worker* TaskQueuePacerPool::CurrentWorker() {
+  TaskQueueBase* current = TaskQueueBase::Current();
+  for (const auto& worker : workers_) {
+    if (worker->task_queue.get() == current)
+      return worker.get();
+  }
+  RTC_CHECK_NOTREACHED();
+}
+
+Timestamp TaskQueuePacerPool::RoundDownToGrid(Timestamp time) const {
+  const int64_t resolution_us = resolution_.us();
+  return Timestamp::Micros(time.us() / resolution_us * resolution_us);
+}
+
+void TaskQueuePacerPool::MaybeStartTimer(Worker* worker, Timestamp at_time) {
+  const Timestamp wakeup_time = RoundDownToGrid(at_time);
+  if (wakeup_time >= worker->next_wakeup)
+    return;
+  worker->next_wakeup = wakeup_time;
+  // High precision, since a late wakeup delays the packets of every member
+  // that is due.
+  const TimeDelta delay =
+      std::max(wakeup_time - clock_->CurrentTime(), TimeDelta::Zero());
+  worker->task_queue->PostDelayedHighPrecisionTask(
+      ToQueuedTask(
+          [this, worker, wakeup_time] { OnTimer(worker, wakeup_time); }),
+      delay);
+}
+
+void TaskQueuePacerPool::OnTimer(Worker* worker, Timestamp wakeup_time) {
+  if (wakeup_time != worker->next_wakeup)
+    return;
+  worker->next_wakeup = Timestamp::PlusInfinity();
+  const Timestamp now = clock_->CurrentTime();
+  std::vector<Member*> due;
+  Timestamp next_time = Timestamp::PlusInfinity();
+  EraseIf(worker->process_times,
+          [&](const std::pair<Member*, Timestamp>& entry) {
+            if (RoundDownToGrid(entry.second) <= now) {
+              due.push_back(entry.first);
+              return true;
+            }
+            next_time = std::min(next_time, entry.second);
+            return false;
+          });
+  if (next_time.IsFinite())
+    MaybeStartTimer(worker, next_time);
+  // Members are only removed by their own tasks, so all of `due` are still
+  // members. Processing schedules the next process time of the member.
+  for (Member* member : due) {
+    member->OnProcessTimer();
+  }
+}
+
+}  // namespace webrtc
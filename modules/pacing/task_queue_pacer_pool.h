@@ -0,0 +1,107 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_PACING_TASK_QUEUE_PACER_POOL_H_
+#define MODULES_PACING_TASK_QUEUE_PACER_POOL_H_
+
+#include <memory>
+#include <vector>
+
+#include "api/task_queue/task_queue_base.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/containers/flat_map.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+// Runs the TaskQueuePacedSenders of many transports, as on a server with
+// thousands of outgoing transports, on a few task queues. A
+// TaskQueuePacedSender otherwise creates a task queue of its own and posts a
+// delayed task for each wake-up. The members of a pool are spread over its
+// task queues. The wake-ups of all members on a queue are served by one
+// delayed task, with the wake-up times rounded down to a grid of
+// `resolution`, so that members due at about the same time are processed
+// one after the other from a single wake-up. Each member keeps its own
+// PacingController, with its own budgets and packet queue.
+//
+// The pool must outlive its members.
+class TaskQueuePacerPool {
+ public:
+  static constexpr TimeDelta kDefaultResolution = TimeDelta::Millis(1);
+
+  class Member {
+   public:
+    // Called on the task queue of the member at or, by less than the
+    // resolution of the pool, before the time passed to the last
+    // ScheduleProcess() of the member.
+    virtual void OnProcessTimer() = 0;
+
+   protected:
+    virtual ~Member() = default;
+  };
+
+  TaskQueuePacerPool(Clock* clock,
+                     TaskQueueFactory* task_queue_factory,
+                     int num_task_queues,
+                     TimeDelta resolution = kDefaultResolution);
+  ~TaskQueuePacerPool();
+
+  TaskQueuePacerPool(const TaskQueuePacerPool&) = delete;
+  TaskQueuePacerPool& operator=(const TaskQueuePacerPool&) = delete;
+
+  // Adds `member` to the task queue with the fewest members and returns that
+  // queue. May be called on any thread.
+  TaskQueueBase* AddMember(Member* member);
+  // Must be called on the task queue of `member`. The member gets no more
+  // calls, including for a process time it had scheduled.
+  void RemoveMember(Member* member);
+
+  // Schedules OnProcessTimer() of `member` at `at_time`, replacing the time
+  // of an earlier call. Must be called on the task queue of `member`.
+  void ScheduleProcess(Member* member, Timestamp at_time);
+
+  size_t num_members() const;
+
+ private:
+  struct Worker {
+    // The scheduled process times of the members on the queue.
+    flat_map<Member*, Timestamp> process_times;
+    // The time of the pending timer task, if any. Earlier tasks whose time
+    // no longer matches do nothing when they run.
+    Timestamp next_wakeup = Timestamp::PlusInfinity();
+    int num_members = 0;
+    std::unique_ptr<TaskQueueBase, TaskQueueDeleter> task_queue;
+  };
+
+  // Returns the worker of the current task queue.
+  Worker* CurrentWorker();
+  Timestamp RoundDownToGrid(Timestamp time) const;
+  // Makes sure that the timer of `worker` runs no later than the grid point
+  // at or before `at_time`.
+  void MaybeStartTimer(Worker* worker, Timestamp at_time);
+  void OnTimer(Worker* worker, Timestamp wakeup_time);
+
+  Clock* const clock_;
+  const TimeDelta resolution_;
+
+  mutable Mutex mutex_;
+  // The workers are created in the constructor and live as long as the
+  // pool. `num_members` is guarded by `mutex_`, the other fields are used on
+  // the task queue of the worker.
+  std::vector<std::unique_ptr<Worker>> workers_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_PACING_TASK_QUEUE_PACER_POOL_H_
@@ -0,0 +1,208 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/task_queue_pacer_pool.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/pacing/packet_router.h"
+#include "modules/pacing/task_queue_paced_sender.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/task_utils/to_queued_task.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+#include "test/time_controller/simulated_time_controller.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+// A multiple of the default resolution.
+constexpr Timestamp kStartTime = Timestamp::Seconds(1000);
+constexpr size_t kPacketSize = 1000;
+
+class FakeMember : public TaskQueuePacerPool::Member {
+ public:
+  explicit FakeMember(Clock* clock) : clock_(clock) {}
+
+  void OnProcessTimer() override {
+    process_times_.push_back(clock_->CurrentTime());
+  }
+
+  const std::vector<Timestamp>& process_times() const {
+    return process_times_;
+  }
+
+ private:
+  Clock* const clock_;
+  std::vector<Timestamp> process_times_;
+};
+
+class TaskQueuePacerPoolTest : public ::testing::Test {
+ protected:
+  TaskQueuePacerPoolTest()
+      : time_controller_(kStartTime),
+        pool_(time_controller_.GetClock(),
+              time_controller_.GetTaskQueueFactory(),
+              /*num_task_queues=*/2) {}
+
+  // Runs `task` on `task_queue` and then the tasks it posted without delay.
+  template <typename Closure>
+  void RunOn(TaskQueueBase* task_queue, Closure&& task) {
+    task_queue->PostTask(ToQueuedTask(std::forward<Closure>(task)));
+    time_controller_.AdvanceTime(TimeDelta::Zero());
+  }
+
+  GlobalSimulatedTimeController time_controller_;
+  TaskQueuePacerPool pool_;
+};
+
+TEST_F(TaskQueuePacerPoolTest, AddsMembersToTheQueueWithFewestMembers) {
+  FakeMember member1(time_controller_.GetClock());
+  FakeMember member2(time_controller_.GetClock());
+  FakeMember member3(time_controller_.GetClock());
+  TaskQueueBase* queue1 = pool_.AddMember(&member1);
+  TaskQueueBase* queue2 = pool_.AddMember(&member2);
+  EXPECT_NE(queue1, queue2);
+  EXPECT_EQ(pool_.AddMember(&member3), queue1);
+  EXPECT_EQ(pool_.num_members(), 3u);
+
+  RunOn(queue1, [&] {
+    pool_.RemoveMember(&member1);
+    pool_.RemoveMember(&member3);
+  });
+  RunOn(queue2, [&] { pool_.RemoveMember(&member2); });
+  EXPECT_EQ(pool_.num_members(), 0u);
+}
+
+TEST_F(TaskQueuePacerPoolTest, ProcessesMembersDueInOneGridIntervalTogether) {
+  FakeMember member1(time_controller_.GetClock());
+  FakeMember member2(time_controller_.GetClock());
+  FakeMember other(time_controller_.GetClock());
+  TaskQueueBase* queue = pool_.AddMember(&member1);
+  TaskQueueBase* other_queue = pool_.AddMember(&other);
+  ASSERT_EQ(pool_.AddMember(&member2), queue);
+  RunOn(queue, [&] {
+    pool_.ScheduleProcess(&member1, kStartTime + TimeDelta::Micros(1300));
+    pool_.ScheduleProcess(&member2, kStartTime + TimeDelta::Micros(1700));
+  });
+  time_controller_.AdvanceTime(TimeDelta::Millis(10));
+  // Both run on the grid point before their process times.
+  EXPECT_THAT(member1.process_times(),
+              ElementsAre(kStartTime + TimeDelta::Millis(1)));
+  EXPECT_THAT(member2.process_times(),
+              ElementsAre(kStartTime + TimeDelta::Millis(1)));
+  RunOn(queue, [&] {
+    pool_.RemoveMember(&member1);
+    pool_.RemoveMember(&member2);
+  });
+  RunOn(other_queue, [&] { pool_.RemoveMember(&other); });
+}
+
+TEST_F(TaskQueuePacerPoolTest, LaterScheduleReplacesEarlierOne) {
+  FakeMember member(time_controller_.GetClock());
+  TaskQueueBase* queue = pool_.AddMember(&member);
+  RunOn(queue, [&] {
+    pool_.ScheduleProcess(&member, kStartTime + TimeDelta::Millis(2));
+    pool_.ScheduleProcess(&member, kStartTime + TimeDelta::Millis(5));
+  });
+  time_controller_.AdvanceTime(TimeDelta::Millis(10));
+  EXPECT_THAT(member.process_times(),
+              ElementsAre(kStartTime + TimeDelta::Millis(5)));
+  RunOn(queue, [&] { pool_.RemoveMember(&member); });
+}
+
+TEST_F(TaskQueuePacerPoolTest, RemovedMemberIsNotProcessed) {
+  FakeMember member(time_controller_.GetClock());
+  TaskQueueBase* queue = pool_.AddMember(&member);
+  RunOn(queue, [&] {
+    pool_.ScheduleProcess(&member, kStartTime + TimeDelta::Millis(2));
+    pool_.RemoveMember(&member);
+  });
+  time_controller_.AdvanceTime(TimeDelta::Millis(10));
+  EXPECT_THAT(member.process_times(), IsEmpty());
+}
+
+class CountingPacketRouter : public PacketRouter {
+ public:
+  explicit CountingPacketRouter(Clock* clock) : clock_(clock) {}
+
+  void SendPacket(std::unique_ptr<RtpPacketToSend> packet,
+                  const PacedPacketInfo& cluster_info) override {
+    ++packets_sent_;
+    last_send_time_ = clock_->CurrentTime();
+  }
+  std::vector<std::unique_ptr<RtpPacketToSend>> FetchFec() override {
+    return {};
+  }
+  std::vector<std::unique_ptr<RtpPacketToSend>> GeneratePadding(
+      DataSize size) override {
+    return {};
+  }
+
+  int packets_sent() const { return packets_sent_; }
+  Timestamp last_send_time() const { return last_send_time_; }
+
+ private:
+  Clock* const clock_;
+  int packets_sent_ = 0;
+  Timestamp last_send_time_ = Timestamp::MinusInfinity();
+};
+
+TEST_F(TaskQueuePacerPoolTest, PacersInPoolKeepTheirOwnPacingRates) {
+  constexpr int kNumPacers = 5;
+  std::vector<std::unique_ptr<CountingPacketRouter>> routers;
+  std::vector<std::unique_ptr<TaskQueuePacedSender>> pacers;
+  for (int i = 0; i < kNumPacers; ++i) {
+    routers.push_back(
+        std::make_unique<CountingPacketRouter>(time_controller_.GetClock()));
+    pacers.push_back(std::make_unique<TaskQueuePacedSender>(
+        time_controller_.GetClock(), routers[i].get(), /*event_log=*/nullptr,
+        /*field_trials=*/nullptr, &pool_));
+    // Pacer `i` gets (i + 1) * 10 packets, at a rate that sends them in a
+    // second.
+    const int num_packets = (i + 1) * 10;
+    pacers[i]->SetPacingRates(
+        DataRate::BitsPerSec(kPacketSize * 8 * num_packets), DataRate::Zero());
+    pacers[i]->EnsureStarted();
+    std::vector<std::unique_ptr<RtpPacketToSend>> packets;
+    for (int j = 0; j < num_packets; ++j) {
+      auto packet = std::make_unique<RtpPacketToSend>(/*extensions=*/nullptr);
+      packet->set_packet_type(RtpPacketMediaType::kVideo);
+      packet->SetSsrc(1000 + i);
+      packet->SetPayloadSize(kPacketSize);
+      packets.push_back(std::move(packet));
+    }
+    pacers[i]->EnqueuePackets(std::move(packets));
+  }
+  EXPECT_EQ(pool_.num_members(), size_t{kNumPacers});
+
+  time_controller_.AdvanceTime(TimeDelta::Seconds(2));
+  for (int i = 0; i < kNumPacers; ++i) {
+    const int num_packets = (i + 1) * 10;
+    EXPECT_EQ(routers[i]->packets_sent(), num_packets);
+    // The first packet is sent at once, and the others one packet interval
+    // apart.
+    EXPECT_NEAR((routers[i]->last_send_time() - kStartTime).ms<double>(),
+                1000.0 * (num_packets - 1) / num_packets, 10.0);
+  }
+
+  pacers.clear();
+  EXPECT_EQ(pool_.num_members(), 0u);
+}
+
+}  // namespace
+}  // namespace webrtc
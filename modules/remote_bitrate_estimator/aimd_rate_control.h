@@ -67,6 +67,7 @@ class AimdRateControl {
  private:
   enum class RateControlState { kRcHold, kRcIncrease, kRcDecrease };
 
+  friend class BweTraceRecorder;
   friend class GoogCcStatePrinter;
   // Update the target bitrate based on, among other things, the current rate
   // control state, the current target bitrate and the estimated throughput.
@@ -28,6 +28,19 @@ namespace webrtc {
 static constexpr int64_t kMaxTimeMs =
     std::numeric_limits<int64_t>::max() / 1000;
 
+std::unique_ptr<SwapQueue<RemoteEstimatorProxy::PacketArrival>>
+RemoteEstimatorProxy::MaybeCreateArrivalQueue(
+    const WebRtcKeyValueConfig* key_value_config) {
+  FieldTrialFlag enabled("Enabled");
+  FieldTrialParameter<int> size("size", 1024);
+  ParseFieldTrial({&enabled, &size},
+                  key_value_config->Lookup("WebRTC-Bwe-QueuedPacketArrivals"));
+  if (!enabled || size <= 0) {
+    return nullptr;
+  }
+  return std::make_unique<SwapQueue<PacketArrival>>(size.Get());
+}
+
 RemoteEstimatorProxy::RemoteEstimatorProxy(
     Clock* clock,
     TransportFeedbackSender feedback_sender,
@@ -37,6 +50,7 @@ RemoteEstimatorProxy::RemoteEstimatorProxy(
       feedback_sender_(std::move(feedback_sender)),
       send_config_(key_value_config),
       last_process_time_ms_(-1),
+      arrival_queue_(MaybeCreateArrivalQueue(key_value_config)),
       network_state_estimator_(network_state_estimator),
       media_ssrc_(0),
       feedback_packet_count_(0),
@@ -70,15 +84,48 @@ void RemoteEstimatorProxy::IncomingPacket(int64_t arrival_time_ms,
     RTC_LOG(LS_WARNING) << "Arrival time out of bounds: " << arrival_time_ms;
     return;
   }
+  PacketArrival packet;
+  packet.arrival_time_ms = arrival_time_ms;
+  packet.ssrc = header.ssrc;
+  if (header.extension.hasTransportSequenceNumber) {
+    packet.transport_sequence_number = header.extension.transportSequenceNumber;
+  }
+  if (header.extension.hasAbsoluteSendTime) {
+    packet.absolute_send_time = header.extension.absoluteSendTime;
+  }
+  packet.size = header.headerLength + payload_size;
+
+  // Requested feedback is sent right away, and so can't be queued.
+  if (arrival_queue_ && !header.extension.feedback_request &&
+      arrival_queue_->Insert(&packet)) {
+    return;
+  }
   MutexLock lock(&lock_);
-  media_ssrc_ = header.ssrc;
+  DrainArrivalQueue();
+  OnPacketArrival(packet, header.extension.feedback_request);
+}
+
+void RemoteEstimatorProxy::DrainArrivalQueue() {
+  if (!arrival_queue_) {
+    return;
+  }
+  PacketArrival packet;
+  while (arrival_queue_->Remove(&packet)) {
+    OnPacketArrival(packet, /*feedback_request=*/absl::nullopt);
+  }
+}
+
+void RemoteEstimatorProxy::OnPacketArrival(
+    const PacketArrival& packet,
+    const absl::optional<FeedbackRequest>& feedback_request) {
+  media_ssrc_ = packet.ssrc;
   int64_t seq = 0;
 
-  if (header.extension.hasTransportSequenceNumber) {
-    seq = unwrapper_.Unwrap(header.extension.transportSequenceNumber);
+  if (packet.transport_sequence_number) {
+    seq = unwrapper_.Unwrap(*packet.transport_sequence_number);
 
     if (send_periodic_feedback_) {
-      MaybeCullOldPackets(seq, arrival_time_ms);
+      MaybeCullOldPackets(seq, packet.arrival_time_ms);
 
       if (!periodic_window_start_seq_ || seq < *periodic_window_start_seq_) {
         periodic_window_start_seq_ = seq;
@@ -90,7 +137,7 @@ void RemoteEstimatorProxy::IncomingPacket(int64_t arrival_time_ms,
       return;
     }
 
-    packet_arrival_times_.AddPacket(seq, arrival_time_ms);
+    packet_arrival_times_.AddPacket(seq, packet.arrival_time_ms);
 
     // Limit the range of sequence numbers to send feedback for.
     if (!periodic_window_start_seq_.has_value() ||
@@ -100,25 +147,27 @@ void RemoteEstimatorProxy::IncomingPacket(int64_t arrival_time_ms,
           packet_arrival_times_.begin_sequence_number();
     }
 
-    if (header.extension.feedback_request) {
+    if (feedback_request) {
       // Send feedback packet immediately.
-      SendFeedbackOnRequest(seq, header.extension.feedback_request.value());
+      SendFeedbackOnRequest(seq, *feedback_request);
     }
   }
 
-  if (network_state_estimator_ && header.extension.hasAbsoluteSendTime) {
+  if (network_state_estimator_ && packet.absolute_send_time) {
     PacketResult packet_result;
-    packet_result.receive_time = Timestamp::Millis(arrival_time_ms);
+    packet_result.receive_time = Timestamp::Millis(packet.arrival_time_ms);
     // Ignore reordering of packets and assume they have approximately the
     // same send time.
-    abs_send_timestamp_ += std::max(
-        header.extension.GetAbsoluteSendTimeDelta(previous_abs_send_time_),
-        TimeDelta::Millis(0));
-    previous_abs_send_time_ = header.extension.absoluteSendTime;
+    RTPHeaderExtension extension;
+    extension.hasAbsoluteSendTime = true;
+    extension.absoluteSendTime = *packet.absolute_send_time;
+    abs_send_timestamp_ +=
+        std::max(extension.GetAbsoluteSendTimeDelta(previous_abs_send_time_),
+                 TimeDelta::Millis(0));
+    previous_abs_send_time_ = *packet.absolute_send_time;
     packet_result.sent_packet.send_time = abs_send_timestamp_;
     // TODO(webrtc:10742): Take IP header and transport overhead into account.
-    packet_result.sent_packet.size =
-        DataSize::Bytes(header.headerLength + payload_size);
+    packet_result.sent_packet.size = DataSize::Bytes(packet.size);
     packet_result.sent_packet.sequence_number = seq;
     network_state_estimator_->OnReceivedPacket(packet_result);
   }
@@ -144,6 +193,7 @@ int64_t RemoteEstimatorProxy::TimeUntilNextProcess() {
 
 void RemoteEstimatorProxy::Process() {
   MutexLock lock(&lock_);
+  DrainArrivalQueue();
   if (!send_periodic_feedback_) {
     return;
   }
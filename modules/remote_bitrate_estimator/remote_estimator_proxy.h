@@ -22,6 +22,7 @@
 #include "modules/remote_bitrate_estimator/packet_arrival_map.h"
 #include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/numerics/sequence_number_util.h"
+#include "rtc_base/swap_queue.h"
 #include "rtc_base/synchronization/mutex.h"
 
 namespace webrtc {
@@ -34,6 +35,11 @@ class TransportFeedback;
 // Class used when send-side BWE is enabled: This proxy is instantiated on the
 // receive side. It buffers a number of receive timestamps and then sends
 // transport feedback messages back too the send side.
+//
+// With the field trial WebRTC-Bwe-QueuedPacketArrivals, IncomingPacket()
+// doesn't take the lock but hands the arrivals to Process() through a
+// lock-free queue, which is drained before each feedback is built. In that
+// mode IncomingPacket() must always be called on the same thread.
 class RemoteEstimatorProxy : public RemoteBitrateEstimator {
  public:
   // Used for sending transport feedback messages when send side
@@ -76,6 +82,22 @@ class RemoteEstimatorProxy : public RemoteBitrateEstimator {
     }
   };
 
+  // The parts of a received packet that are needed to send feedback.
+  struct PacketArrival {
+    int64_t arrival_time_ms = 0;
+    uint32_t ssrc = 0;
+    absl::optional<uint16_t> transport_sequence_number;
+    absl::optional<uint32_t> absolute_send_time;
+    size_t size = 0;
+  };
+
+  // Returns null if arrivals are to be handled when they are received.
+  static std::unique_ptr<SwapQueue<PacketArrival>> MaybeCreateArrivalQueue(
+      const WebRtcKeyValueConfig* key_value_config);
+  void OnPacketArrival(const PacketArrival& packet,
+                       const absl::optional<FeedbackRequest>& feedback_request)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
+  void DrainArrivalQueue() RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
   void MaybeCullOldPackets(int64_t sequence_number, int64_t arrival_time_ms)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
   void SendPeriodicFeedbacks() RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
@@ -105,6 +127,9 @@ class RemoteEstimatorProxy : public RemoteBitrateEstimator {
   const TransportFeedbackSender feedback_sender_;
   const TransportWideFeedbackConfig send_config_;
   int64_t last_process_time_ms_;
+  // Arrivals that are not handled yet, if queueing is enabled. Only drained
+  // with `lock_` held.
+  const std::unique_ptr<SwapQueue<PacketArrival>> arrival_queue_;
 
   Mutex lock_;
   //  `network_state_estimator_` may be null.
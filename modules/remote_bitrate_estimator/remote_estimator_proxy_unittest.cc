@@ -19,6 +19,7 @@
 #include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
 #include "modules/rtp_rtcp/source/rtp_header_extensions.h"
 #include "system_wrappers/include/clock.h"
+#include "test/explicit_key_value_config.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
@@ -640,5 +641,91 @@ TEST_F(RemoteEstimatorProxyTest, SendTransportFeedbackAndNetworkStateUpdate) {
   Process();
 }
 
+//////////////////////////////////////////////////////////////////////////////
+// Tests for arrivals that are queued until feedback is built.
+//////////////////////////////////////////////////////////////////////////////
+class RemoteEstimatorProxyQueuedArrivalsTest : public ::testing::Test {
+ public:
+  RemoteEstimatorProxyQueuedArrivalsTest()
+      : field_trials_("WebRTC-Bwe-QueuedPacketArrivals/Enabled,size:4/"),
+        clock_(0),
+        proxy_(&clock_,
+               feedback_sender_.AsStdFunction(),
+               &field_trials_,
+               /*network_state_estimator=*/nullptr) {}
+
+ protected:
+  void IncomingPacket(
+      uint16_t seq,
+      int64_t time_ms,
+      absl::optional<FeedbackRequest> feedback_request = absl::nullopt) {
+    RTPHeader header;
+    header.extension.hasTransportSequenceNumber = true;
+    header.extension.transportSequenceNumber = seq;
+    header.extension.feedback_request = feedback_request;
+    header.ssrc = kMediaSsrc;
+    proxy_.IncomingPacket(time_ms, kDefaultPacketSize, header);
+  }
+
+  void ExpectFeedback(std::vector<uint16_t> sequence_numbers) {
+    EXPECT_CALL(feedback_sender_, Call)
+        .WillOnce(Invoke(
+            [sequence_numbers](
+                std::vector<std::unique_ptr<rtcp::RtcpPacket>> packets) {
+              ASSERT_THAT(packets, SizeIs(1));
+              rtcp::TransportFeedback* feedback_packet =
+                  static_cast<rtcp::TransportFeedback*>(packets[0].get());
+              EXPECT_EQ(kMediaSsrc, feedback_packet->media_ssrc());
+              EXPECT_EQ(SequenceNumbers(*feedback_packet), sequence_numbers);
+            }));
+  }
+
+  void Process() {
+    clock_.AdvanceTimeMilliseconds(kDefaultSendIntervalMs);
+    proxy_.Process();
+  }
+
+  test::ExplicitKeyValueConfig field_trials_;
+  SimulatedClock clock_;
+  MockFunction<void(std::vector<std::unique_ptr<rtcp::RtcpPacket>>)>
+      feedback_sender_;
+  RemoteEstimatorProxy proxy_;
+};
+
+TEST_F(RemoteEstimatorProxyQueuedArrivalsTest, ReportsQueuedArrivals) {
+  IncomingPacket(kBaseSeq, kBaseTimeMs);
+  IncomingPacket(kBaseSeq + 2, kBaseTimeMs + 2);
+  IncomingPacket(kBaseSeq + 1, kBaseTimeMs + 1);
+
+  ExpectFeedback({kBaseSeq, kBaseSeq + 1, kBaseSeq + 2});
+  Process();
+}
+
+TEST_F(RemoteEstimatorProxyQueuedArrivalsTest,
+       ReportsArrivalsInOrderWhenQueueOverflows) {
+  std::vector<uint16_t> sequence_numbers;
+  for (int i = 0; i < 10; ++i) {
+    IncomingPacket(kBaseSeq + i, kBaseTimeMs + i);
+    sequence_numbers.push_back(kBaseSeq + i);
+  }
+
+  ExpectFeedback(sequence_numbers);
+  Process();
+}
+
+TEST_F(RemoteEstimatorProxyQueuedArrivalsTest,
+       RequestedFeedbackIncludesQueuedArrivals) {
+  proxy_.SetSendPeriodicFeedback(false);
+  for (int i = 0; i < 2; ++i) {
+    IncomingPacket(kBaseSeq + i, kBaseTimeMs + i * kMaxSmallDeltaMs);
+  }
+
+  ExpectFeedback({kBaseSeq, kBaseSeq + 1, kBaseSeq + 2});
+  constexpr FeedbackRequest kThreePacketsFeedbackRequest = {
+      /*include_timestamps=*/true, /*sequence_count=*/3};
+  IncomingPacket(kBaseSeq + 2, kBaseTimeMs + 2 * kMaxSmallDeltaMs,
+                 kThreePacketsFeedbackRequest);
+}
+
 }  // namespace
 }  // namespace webrtc
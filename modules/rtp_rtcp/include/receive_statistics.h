@@ -61,6 +61,12 @@ class ReceiveStatistics : public ReceiveStatisticsProvider,
   // Returns a thread-compatible instance of ReceiveStatistics.
   static std::unique_ptr<ReceiveStatistics> CreateThreadCompatible(
       Clock* clock);
+  // Returns a thread-safe instance of ReceiveStatistics for receivers that
+  // deliver all packets on one sequence. OnRtpPacket(),
+  // SetMaxReorderingThreshold() and EnableRetransmitDetection() must be called
+  // on that sequence, and don't wait for RTCP generation or stats queries on
+  // other threads.
+  static std::unique_ptr<ReceiveStatistics> CreateSingleWriter(Clock* clock);
 
   // Returns a pointer to the statistician of an ssrc.
   virtual StreamStatistician* GetStatistician(uint32_t ssrc) const = 0;
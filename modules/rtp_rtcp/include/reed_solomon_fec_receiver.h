@@ -0,0 +1,96 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_INCLUDE_REED_SOLOMON_FEC_RECEIVER_H_
+#define MODULES_RTP_RTCP_INCLUDE_REED_SOLOMON_FEC_RECEIVER_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/sequence_checker.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/include/ulpfec_receiver.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/numerics/sequence_number_util.h"
+#include "rtc_base/system/no_unique_address.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+class Clock;
+
+// Recovers media packets from the FEC packets of ReedSolomonFecSender.
+class ReedSolomonFecReceiver {
+ public:
+  ReedSolomonFecReceiver(Clock* clock,
+                         uint32_t ssrc,
+                         uint32_t protected_media_ssrc,
+                         RecoveredPacketReceiver* recovered_packet_receiver);
+  ~ReedSolomonFecReceiver();
+
+  // Inserts a received packet, which can be either media or FEC. All newly
+  // recovered packets are sent back through the callback.
+  void OnRtpPacket(const RtpPacketReceived& packet);
+
+  // Returns a counter describing the added and recovered packets.
+  FecPacketCounter GetPacketCounter() const;
+
+ private:
+  struct FecBlock {
+    size_t num_media_packets = 0;
+    // Parity blocks by index.
+    std::map<uint8_t, rtc::Buffer> parity;
+    bool complete = false;
+  };
+
+  void AddMediaPacket(const RtpPacketReceived& packet,
+                      std::vector<rtc::CopyOnWriteBuffer>* recovered)
+      RTC_RUN_ON(sequence_checker_);
+  void AddFecPacket(const RtpPacketReceived& packet,
+                    std::vector<rtc::CopyOnWriteBuffer>* recovered)
+      RTC_RUN_ON(sequence_checker_);
+  // Recovers the missing media packets of the block at `base_seq_num`, if
+  // enough of its parity has been received.
+  void MaybeRecover(int64_t base_seq_num,
+                    FecBlock* block,
+                    std::vector<rtc::CopyOnWriteBuffer>* recovered)
+      RTC_RUN_ON(sequence_checker_);
+  bool IsTooOld(int64_t seq_num) const RTC_RUN_ON(sequence_checker_);
+  // Forgets packets too old to help recover newer ones.
+  void Prune(int64_t newest_seq_num) RTC_RUN_ON(sequence_checker_);
+
+  // Config.
+  const uint32_t ssrc_;
+  const uint32_t protected_media_ssrc_;
+  RecoveredPacketReceiver* const recovered_packet_receiver_;
+  Clock* const clock_;
+
+  SeqNumUnwrapper<uint16_t> seq_num_unwrapper_
+      RTC_GUARDED_BY(sequence_checker_);
+  absl::optional<int64_t> newest_seq_num_ RTC_GUARDED_BY(sequence_checker_);
+  // Recovery blocks of received and recovered media packets, by unwrapped
+  // sequence number.
+  std::map<int64_t, rtc::Buffer> media_blocks_
+      RTC_GUARDED_BY(sequence_checker_);
+  // FEC blocks by unwrapped base sequence number.
+  std::map<int64_t, FecBlock> fec_blocks_ RTC_GUARDED_BY(sequence_checker_);
+  FecPacketCounter packet_counter_ RTC_GUARDED_BY(sequence_checker_);
+
+  RTC_NO_UNIQUE_ADDRESS SequenceChecker sequence_checker_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_INCLUDE_REED_SOLOMON_FEC_RECEIVER_H_
@@ -0,0 +1,115 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_INCLUDE_REED_SOLOMON_FEC_SENDER_H_
+#define MODULES_RTP_RTCP_INCLUDE_REED_SOLOMON_FEC_SENDER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "api/rtp_parameters.h"
+#include "modules/include/module_fec_types.h"
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtp_header_extension_size.h"
+#include "modules/rtp_rtcp/source/video_fec_generator.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/race_checker.h"
+#include "rtc_base/random.h"
+#include "rtc_base/rate_statistics.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+class Clock;
+class RtpPacketToSend;
+
+// Generates Reed-Solomon FEC packets, see reed_solomon_fec_format.h, on their
+// own SSRC like FlexfecSender. Each block of up to
+// reed_solomon_fec::kMaxMediaPackets consecutive media packets gets
+// ForwardErrorCorrection::NumFecPackets() parity packets, and any burst of
+// up to that many lost packets in the block can be recovered.
+//
+// Like FlexfecSender, this class requires external synchronization, except
+// for SetProtectionParameters() and CurrentFecRate().
+class ReedSolomonFecSender : public VideoFecGenerator {
+ public:
+  ReedSolomonFecSender(int payload_type,
+                       uint32_t ssrc,
+                       uint32_t protected_media_ssrc,
+                       const std::string& mid,
+                       const std::vector<RtpExtension>& rtp_header_extensions,
+                       rtc::ArrayView<const RtpExtensionSize> extension_sizes,
+                       const RtpState* rtp_state,
+                       Clock* clock);
+  ~ReedSolomonFecSender() override;
+
+  FecType GetFecType() const override {
+    return VideoFecGenerator::FecType::kReedSolomon;
+  }
+  absl::optional<uint32_t> FecSsrc() override { return ssrc_; }
+
+  void SetProtectionParameters(const FecProtectionParams& delta_params,
+                               const FecProtectionParams& key_params) override;
+
+  // Adds a media packet to the current block. The FEC packets of the block
+  // are generated when it ends, after `max_fec_frames` complete frames, when
+  // the block is full, or when the sequence numbers jump.
+  void AddPacketAndGenerateFec(const RtpPacketToSend& packet) override;
+
+  std::vector<std::unique_ptr<RtpPacketToSend>> GetFecPackets() override;
+
+  // The overhead is BWE RTP header extensions and the FEC headers.
+  size_t MaxPacketOverhead() const override;
+
+  DataRate CurrentFecRate() const override;
+
+  absl::optional<RtpState> GetRtpState() override;
+
+ private:
+  void GenerateFec();
+  void ResetBlock();
+
+  Clock* const clock_;
+  Random random_;
+
+  // Config.
+  const int payload_type_;
+  const uint32_t timestamp_offset_;
+  const uint32_t ssrc_;
+  const uint32_t protected_media_ssrc_;
+  const std::string mid_;
+  const RtpHeaderExtensionMap rtp_header_extension_map_;
+  const size_t header_extensions_size_;
+
+  rtc::RaceChecker race_checker_;
+  // Sequence number of next packet to generate.
+  uint16_t seq_num_ RTC_GUARDED_BY(race_checker_);
+  // Recovery blocks of the media packets of the current block.
+  std::vector<rtc::Buffer> media_blocks_ RTC_GUARDED_BY(race_checker_);
+  uint16_t base_seq_num_ RTC_GUARDED_BY(race_checker_) = 0;
+  bool block_contains_keyframe_ RTC_GUARDED_BY(race_checker_) = false;
+  int num_protected_frames_ RTC_GUARDED_BY(race_checker_) = 0;
+  std::vector<std::unique_ptr<RtpPacketToSend>> generated_fec_packets_
+      RTC_GUARDED_BY(race_checker_);
+
+  mutable Mutex mutex_;
+  FecProtectionParams delta_params_ RTC_GUARDED_BY(mutex_);
+  FecProtectionParams key_params_ RTC_GUARDED_BY(mutex_);
+  RateStatistics fec_bitrate_ RTC_GUARDED_BY(mutex_);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_INCLUDE_REED_SOLOMON_FEC_SENDER_H_
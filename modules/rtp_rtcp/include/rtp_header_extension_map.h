@@ -70,6 +70,30 @@ class RtpHeaderExtensionMap {
   bool extmap_allow_mixed_;
 };
 
+// Translation of header extension ids from one RtpHeaderExtensionMap to
+// another, for forwarding packets between streams that negotiated different
+// ids. Build it once per pair of maps and reuse it for every packet, see
+// RtpPacket::RemapExtensions().
+class RtpHeaderExtensionMapTranslation {
+ public:
+  RtpHeaderExtensionMapTranslation(const RtpHeaderExtensionMap& from,
+                                   const RtpHeaderExtensionMap& to);
+
+  // Returns the id in `to` of the extension with `id` in `from`, or kInvalidId
+  // if either map doesn't have that extension.
+  uint8_t Translate(int id) const {
+    RTC_DCHECK_GE(id, RtpExtension::kMinId);
+    RTC_DCHECK_LE(id, RtpExtension::kMaxId);
+    return ids_[id];
+  }
+
+  const RtpHeaderExtensionMap& to() const { return to_; }
+
+ private:
+  RtpHeaderExtensionMap to_;
+  uint8_t ids_[RtpExtension::kMaxId + 1];
+};
+
 }  // namespace webrtc
 
 #endif  // MODULES_RTP_RTCP_INCLUDE_RTP_HEADER_EXTENSION_MAP_H_
@@ -0,0 +1,73 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/fec_xor.h"
+
+#include <string.h>
+
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include "modules/rtp_rtcp/source/fec_xor_neon.h"
+#elif defined(WEBRTC_ARCH_X86_FAMILY)
+#include "modules/rtp_rtcp/source/fec_xor_avx2.h"
+#include "modules/rtp_rtcp/source/fec_xor_sse2.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#endif
+
+namespace webrtc {
+namespace internal {
+
+namespace {
+
+using XorBytesFunction = void (*)(const uint8_t*, size_t, uint8_t*);
+
+XorBytesFunction SelectXorBytes() {
+#if defined(WEBRTC_HAS_NEON)
+  return &XorBytes_NEON;
+#elif defined(WEBRTC_ARCH_X86_FAMILY)
+  if (GetCPUInfo(kAVX2)) {
+    return &XorBytes_AVX2;
+  }
+  if (GetCPUInfo(kSSE2)) {
+    return &XorBytes_SSE2;
+  }
+  return &XorBytes_C;
+#else
+  return &XorBytes_C;
+#endif
+}
+
+}  // namespace
+
+void XorBytes(const uint8_t* src, size_t length, uint8_t* dst) {
+  static const XorBytesFunction xor_bytes = SelectXorBytes();
+  xor_bytes(src, length, dst);
+}
+
+void XorBytes_C(const uint8_t* src, size_t length, uint8_t* dst) {
+  // Eight bytes at a time; memcpy() keeps the unaligned accesses defined and
+  // compiles to plain loads and stores.
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+    uint64_t s;
+    uint64_t d;
+    memcpy(&s, src + i, sizeof(s));
+    memcpy(&d, dst + i, sizeof(d));
+    d ^= s;
+    memcpy(dst + i, &d, sizeof(d));
+  }
+  for (; i < length; ++i) {
+    dst[i] ^= src[i];
+  }
+}
+
+}  // namespace internal
+}  // namespace webrtc
@@ -0,0 +1,42 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/fec_xor_neon.h"
+
+#include <arm_neon.h>
+
+namespace webrtc {
+namespace internal {
+
+void XorBytes_NEON(const uint8_t* src, size_t length, uint8_t* dst) {
+  size_t i = 0;
+  for (; i + 64 <= length; i += 64) {
+    const uint8x16_t x0 = veorq_u8(vld1q_u8(dst + i), vld1q_u8(src + i));
+    const uint8x16_t x1 =
+        veorq_u8(vld1q_u8(dst + i + 16), vld1q_u8(src + i + 16));
+    const uint8x16_t x2 =
+        veorq_u8(vld1q_u8(dst + i + 32), vld1q_u8(src + i + 32));
+    const uint8x16_t x3 =
+        veorq_u8(vld1q_u8(dst + i + 48), vld1q_u8(src + i + 48));
+    vst1q_u8(dst + i, x0);
+    vst1q_u8(dst + i + 16, x1);
+    vst1q_u8(dst + i + 32, x2);
+    vst1q_u8(dst + i + 48, x3);
+  }
+  for (; i + 16 <= length; i += 16) {
+    vst1q_u8(dst + i, veorq_u8(vld1q_u8(dst + i), vld1q_u8(src + i)));
+  }
+  for (; i < length; ++i) {
+    dst[i] ^= src[i];
+  }
+}
+
+}  // namespace internal
+}  // namespace webrtc
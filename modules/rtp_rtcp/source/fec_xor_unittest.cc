@@ -0,0 +1,96 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/fec_xor.h"
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "rtc_base/system/arch.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include "modules/rtp_rtcp/source/fec_xor_neon.h"
+#elif defined(WEBRTC_ARCH_X86_FAMILY)
+#include "modules/rtp_rtcp/source/fec_xor_avx2.h"
+#include "modules/rtp_rtcp/source/fec_xor_sse2.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#endif
+
+namespace webrtc {
+namespace internal {
+namespace {
+
+using ::testing::ElementsAreArray;
+
+using XorBytesFunction = void (*)(const uint8_t*, size_t, uint8_t*);
+
+// Checks `xor_bytes` against a plain loop for every length up to a few
+// vectors, at every alignment of the source and the destination.
+void TestXorBytes(XorBytesFunction xor_bytes) {
+  constexpr size_t kMaxLength = 200;
+  constexpr size_t kMaxOffset = 32;
+  Random random(0x1234);
+  std::vector<uint8_t> src(kMaxLength + kMaxOffset);
+  std::vector<uint8_t> dst(kMaxLength + kMaxOffset);
+  for (uint8_t& byte : src) {
+    byte = random.Rand<uint8_t>();
+  }
+  for (size_t length = 0; length <= kMaxLength; ++length) {
+    for (size_t offset = 0; offset < kMaxOffset; offset += 3) {
+      for (uint8_t& byte : dst) {
+        byte = random.Rand<uint8_t>();
+      }
+      const size_t src_offset = kMaxOffset - 1 - offset;
+      std::vector<uint8_t> expected = dst;
+      for (size_t i = 0; i < length; ++i) {
+        expected[offset + i] ^= src[src_offset + i];
+      }
+      xor_bytes(src.data() + src_offset, length, dst.data() + offset);
+      ASSERT_THAT(dst, ElementsAreArray(expected))
+          << "length " << length << ", offset " << offset;
+    }
+  }
+}
+
+TEST(FecXorTest, XorBytes) {
+  TestXorBytes(&XorBytes);
+}
+
+TEST(FecXorTest, XorBytesC) {
+  TestXorBytes(&XorBytes_C);
+}
+
+#if defined(WEBRTC_HAS_NEON)
+TEST(FecXorTest, XorBytesNeon) {
+  TestXorBytes(&XorBytes_NEON);
+}
+#elif defined(WEBRTC_ARCH_X86_FAMILY)
+TEST(FecXorTest, XorBytesSse2) {
+  if (!GetCPUInfo(kSSE2)) {
+    GTEST_SKIP() << "SSE2 not supported.";
+  }
+  TestXorBytes(&XorBytes_SSE2);
+}
+
+TEST(FecXorTest, XorBytesAvx2) {
+  if (!GetCPUInfo(kAVX2)) {
+    GTEST_SKIP() << "AVX2 not supported.";
+  }
+  TestXorBytes(&XorBytes_AVX2);
+}
+#endif
+
+}  // namespace
+}  // namespace internal
+}  // namespace webrtc
@@ -13,12 +13,14 @@
 #include <string.h>
 
 #include <algorithm>
+#include <iterator>
 #include <utility>
 
 #include "absl/algorithm/container.h"
 #include "modules/include/module_common_types_public.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/fec_xor.h"
 #include "modules/rtp_rtcp/source/flexfec_header_reader_writer.h"
 #include "modules/rtp_rtcp/source/forward_error_correction_internal.h"
 #include "modules/rtp_rtcp/source/ulpfec_header_reader_writer.h"
@@ -62,6 +64,34 @@ bool ForwardErrorCorrection::SortablePacket::LessThan::operator()(
   return IsNewerSequenceNumber(second->seq_num, first->seq_num);
 }
 
+namespace {
+
+// Returns the position in the sorted `packets` before which `packet` belongs.
+// Packets mostly arrive in order, so the search starts from the back.
+template <typename S, typename T>
+typename std::list<std::unique_ptr<S>>::iterator FindSortedPosition(
+    std::list<std::unique_ptr<S>>* packets,
+    const T& packet) {
+  ForwardErrorCorrection::SortablePacket::LessThan less_than;
+  auto it = packets->end();
+  while (it != packets->begin() && less_than(packet, *std::prev(it))) {
+    --it;
+  }
+  return it;
+}
+
+// Returns true if the packet just before `position` in `packets` has the
+// sequence number `seq_num`.
+template <typename S>
+bool IsDuplicate(const std::list<std::unique_ptr<S>>& packets,
+                 typename std::list<std::unique_ptr<S>>::iterator position,
+                 uint16_t seq_num) {
+  return position != packets.begin() &&
+         (*std::prev(position))->seq_num == seq_num;
+}
+
+}  // namespace
+
 ForwardErrorCorrection::ReceivedPacket::ReceivedPacket() = default;
 ForwardErrorCorrection::ReceivedPacket::~ReceivedPacket() = default;
 
@@ -204,66 +234,71 @@ void ForwardErrorCorrection::GenerateFecPayloads(
     const PacketList& media_packets,
     size_t num_fec_packets) {
   RTC_DCHECK(!media_packets.empty());
+  RTC_DCHECK_LE(num_fec_packets, kUlpfecMaxMediaPackets);
+  size_t fec_header_sizes[kUlpfecMaxMediaPackets];
   for (size_t i = 0; i < num_fec_packets; ++i) {
-    Packet* const fec_packet = &generated_fec_packets_[i];
-    size_t pkt_mask_idx = i * packet_mask_size_;
     const size_t min_packet_mask_size = fec_header_writer_->MinPacketMaskSize(
-        &packet_masks_[pkt_mask_idx], packet_mask_size_);
-    const size_t fec_header_size =
+        &packet_masks_[i * packet_mask_size_], packet_mask_size_);
+    fec_header_sizes[i] =
         fec_header_writer_->FecHeaderSize(min_packet_mask_size);
+  }
 
-    size_t media_pkt_idx = 0;
-    auto media_packets_it = media_packets.cbegin();
-    uint16_t prev_seq_num =
-        ParseSequenceNumber((*media_packets_it)->data.data());
-    while (media_packets_it != media_packets.end()) {
-      Packet* const media_packet = media_packets_it->get();
-      const uint8_t* media_packet_data = media_packet->data.cdata();
+  // Visit every media packet once, and add it to all the FEC packets that
+  // protect it while it is in the cache.
+  const uint16_t first_seq_num =
+      ParseSequenceNumber(media_packets.front()->data.data());
+  for (const auto& media_packet : media_packets) {
+    const uint8_t* media_packet_data = media_packet->data.cdata();
+    // Index of the packet in the masks, which have zeros for missing
+    // sequence numbers.
+    const size_t media_pkt_idx = static_cast<uint16_t>(
+        ParseSequenceNumber(media_packet_data) - first_seq_num);
+    const size_t mask_byte_idx = media_pkt_idx / 8;
+    const uint8_t mask_bit = 1 << (7 - media_pkt_idx % 8);
+    RTC_DCHECK_LT(mask_byte_idx, packet_mask_size_);
+    const size_t media_payload_length =
+        media_packet->data.size() - kRtpHeaderSize;
+
+    for (size_t i = 0; i < num_fec_packets; ++i) {
       // Should `media_packet` be protected by `fec_packet`?
-      if (packet_masks_[pkt_mask_idx] & (1 << (7 - media_pkt_idx))) {
-        size_t media_payload_length =
-            media_packet->data.size() - kRtpHeaderSize;
-
-        bool first_protected_packet = (fec_packet->data.size() == 0);
-        size_t fec_packet_length = fec_header_size + media_payload_length;
-        if (fec_packet_length > fec_packet->data.size()) {
-          // Recall that XORing with zero (which the FEC packets are prefilled
-          // with) is the identity operator, thus all prior XORs are
-          // still correct even though we expand the packet length here.
-          fec_packet->data.SetSize(fec_packet_length);
-        }
-        if (first_protected_packet) {
-          uint8_t* data = fec_packet->data.MutableData();
-          // Write P, X, CC, M, and PT recovery fields.
-          // Note that bits 0, 1, and 16 are overwritten in FinalizeFecHeaders.
-          memcpy(&data[0], &media_packet_data[0], 2);
-          // Write length recovery field. (This is a temporary location for
-          // ULPFEC.)
-          ByteWriter<uint16_t>::WriteBigEndian(&data[2], media_payload_length);
-          // Write timestamp recovery field.
-          memcpy(&data[4], &media_packet_data[4], 4);
-          // Write payload.
-          if (media_payload_length > 0) {
-            memcpy(&data[fec_header_size], &media_packet_data[kRtpHeaderSize],
-                   media_payload_length);
-          }
-        } else {
-          XorHeaders(*media_packet, fec_packet);
-          XorPayloads(*media_packet, media_payload_length, fec_header_size,
-                      fec_packet);
-        }
+      if ((packet_masks_[i * packet_mask_size_ + mask_byte_idx] & mask_bit) ==
+          0) {
+        continue;
+      }
+      Packet* const fec_packet = &generated_fec_packets_[i];
+      const size_t fec_header_size = fec_header_sizes[i];
+      bool first_protected_packet = (fec_packet->data.size() == 0);
+      size_t fec_packet_length = fec_header_size + media_payload_length;
+      if (fec_packet_length > fec_packet->data.size()) {
+        // Recall that XORing with zero (which the FEC packets are prefilled
+        // with) is the identity operator, thus all prior XORs are
+        // still correct even though we expand the packet length here.
+        fec_packet->data.SetSize(fec_packet_length);
       }
-      media_packets_it++;
-      if (media_packets_it != media_packets.end()) {
-        uint16_t seq_num =
-            ParseSequenceNumber((*media_packets_it)->data.data());
-        media_pkt_idx += static_cast<uint16_t>(seq_num - prev_seq_num);
-        prev_seq_num = seq_num;
+      if (first_protected_packet) {
+        uint8_t* data = fec_packet->data.MutableData();
+        // Write P, X, CC, M, and PT recovery fields.
+        // Note that bits 0, 1, and 16 are overwritten in FinalizeFecHeaders.
+        memcpy(&data[0], &media_packet_data[0], 2);
+        // Write length recovery field. (This is a temporary location for
+        // ULPFEC.)
+        ByteWriter<uint16_t>::WriteBigEndian(&data[2], media_payload_length);
+        // Write timestamp recovery field.
+        memcpy(&data[4], &media_packet_data[4], 4);
+        // Write payload.
+        if (media_payload_length > 0) {
+          memcpy(&data[fec_header_size], &media_packet_data[kRtpHeaderSize],
+                 media_payload_length);
+        }
+      } else {
+        XorHeaders(*media_packet, fec_packet);
+        XorPayloads(*media_packet, media_payload_length, fec_header_size,
+                    fec_packet);
       }
-      pkt_mask_idx += media_pkt_idx / 8;
-      media_pkt_idx %= 8;
     }
-    RTC_DCHECK_GT(fec_packet->data.size(), 0)
+  }
+  for (size_t i = 0; i < num_fec_packets; ++i) {
+    RTC_DCHECK_GT(generated_fec_packets_[i].data.size(), 0)
         << "Packet mask is wrong or poorly designed.";
   }
 }
@@ -363,13 +398,10 @@ void ForwardErrorCorrection::InsertMediaPacket(
     const ReceivedPacket& received_packet) {
   RTC_DCHECK_EQ(received_packet.ssrc, protected_media_ssrc_);
 
-  // Search for duplicate packets.
-  for (const auto& recovered_packet : *recovered_packets) {
-    RTC_DCHECK_EQ(recovered_packet->ssrc, received_packet.ssrc);
-    if (recovered_packet->seq_num == received_packet.seq_num) {
-      // Duplicate packet, no need to add to list.
-      return;
-    }
+  auto position = FindSortedPosition(recovered_packets, &received_packet);
+  if (IsDuplicate(*recovered_packets, position, received_packet.seq_num)) {
+    // Duplicate packet, no need to add to list.
+    return;
   }
 
   std::unique_ptr<RecoveredPacket> recovered_packet(new RecoveredPacket());
@@ -380,11 +412,8 @@ void ForwardErrorCorrection::InsertMediaPacket(
   recovered_packet->ssrc = received_packet.ssrc;
   recovered_packet->seq_num = received_packet.seq_num;
   recovered_packet->pkt = received_packet.pkt;
-  // TODO(holmer): Consider replacing this with a binary search for the right
-  // position, and then just insert the new packet. Would get rid of the sort.
   RecoveredPacket* recovered_packet_ptr = recovered_packet.get();
-  recovered_packets->push_back(std::move(recovered_packet));
-  recovered_packets->sort(SortablePacket::LessThan());
+  recovered_packets->insert(position, std::move(recovered_packet));
   UpdateCoveringFecPackets(*recovered_packet_ptr);
 }
 
@@ -397,6 +426,10 @@ void ForwardErrorCorrection::UpdateCoveringFecPackets(
     if (protected_it != fec_packet->protected_packets.end() &&
         (*protected_it)->seq_num == packet.seq_num) {
       // Found an FEC packet which is protecting `packet`.
+      if ((*protected_it)->pkt == nullptr) {
+        RTC_DCHECK_GT(fec_packet->num_missing_packets, 0);
+        --fec_packet->num_missing_packets;
+      }
       (*protected_it)->pkt = packet.pkt;
     }
   }
@@ -407,13 +440,10 @@ void ForwardErrorCorrection::InsertFecPacket(
     const ReceivedPacket& received_packet) {
   RTC_DCHECK_EQ(received_packet.ssrc, ssrc_);
 
-  // Check for duplicate.
-  for (const auto& existing_fec_packet : received_fec_packets_) {
-    RTC_DCHECK_EQ(existing_fec_packet->ssrc, received_packet.ssrc);
-    if (existing_fec_packet->seq_num == received_packet.seq_num) {
-      // Drop duplicate FEC packet data.
-      return;
-    }
+  auto position = FindSortedPosition(&received_fec_packets_, &received_packet);
+  if (IsDuplicate(received_fec_packets_, position, received_packet.seq_num)) {
+    // Drop duplicate FEC packet data.
+    return;
   }
 
   std::unique_ptr<ReceivedFecPacket> fec_packet(new ReceivedFecPacket());
@@ -462,11 +492,9 @@ void ForwardErrorCorrection::InsertFecPacket(
     // All-zero packet mask; we can discard this FEC packet.
     RTC_LOG(LS_WARNING) << "Received FEC packet has an all-zero packet mask.";
   } else {
+    fec_packet->num_missing_packets = fec_packet->protected_packets.size();
     AssignRecoveredPackets(recovered_packets, fec_packet.get());
-    // TODO(holmer): Consider replacing this with a binary search for the right
-    // position, and then just insert the new packet. Would get rid of the sort.
-    received_fec_packets_.push_back(std::move(fec_packet));
-    received_fec_packets_.sort(SortablePacket::LessThan());
+    received_fec_packets_.insert(position, std::move(fec_packet));
     const size_t max_fec_packets = fec_header_reader_->MaxFecPackets();
     if (received_fec_packets_.size() > max_fec_packets) {
       received_fec_packets_.pop_front();
@@ -496,6 +524,7 @@ void ForwardErrorCorrection::AssignRecoveredPackets(
     } else {  // *it_p == *it_r.
       // This protected packet has already been recovered.
       (*it_p)->pkt = (*it_r)->pkt;
+      --fec_packet->num_missing_packets;
       ++it_p;
       ++it_r;
     }
@@ -634,11 +663,8 @@ void ForwardErrorCorrection::XorPayloads(const Packet& src,
   if (dst_offset + payload_length > dst->data.size()) {
     dst->data.SetSize(dst_offset + payload_length);
   }
-  uint8_t* dst_data = dst->data.MutableData();
-  const uint8_t* src_data = src.data.cdata();
-  for (size_t i = 0; i < payload_length; ++i) {
-    dst_data[dst_offset + i] ^= src_data[kRtpHeaderSize + i];
-  }
+  internal::XorBytes(src.data.cdata() + kRtpHeaderSize, payload_length,
+                     dst->data.MutableData() + dst_offset);
 }
 
 bool ForwardErrorCorrection::RecoverPacket(const ReceivedFecPacket& fec_packet,
@@ -684,11 +710,9 @@ void ForwardErrorCorrection::AttemptRecovery(
       auto* recovered_packet_ptr = recovered_packet.get();
       // Add recovered packet to the list of recovered packets and update any
       // FEC packets covering this packet with a pointer to the data.
-      // TODO(holmer): Consider replacing this with a binary search for the
-      // right position, and then just insert the new packet. Would get rid of
-      // the sort.
-      recovered_packets->push_back(std::move(recovered_packet));
-      recovered_packets->sort(SortablePacket::LessThan());
+      recovered_packets->insert(
+          FindSortedPosition(recovered_packets, recovered_packet_ptr),
+          std::move(recovered_packet));
       UpdateCoveringFecPackets(*recovered_packet_ptr);
       DiscardOldRecoveredPackets(recovered_packets);
       fec_packet_it = received_fec_packets_.erase(fec_packet_it);
@@ -710,16 +734,8 @@ void ForwardErrorCorrection::AttemptRecovery(
 
 int ForwardErrorCorrection::NumCoveredPacketsMissing(
     const ReceivedFecPacket& fec_packet) {
-  int packets_missing = 0;
-  for (const auto& protected_packet : fec_packet.protected_packets) {
-    if (protected_packet->pkt == nullptr) {
-      ++packets_missing;
-      if (packets_missing > 1) {
-        break;  // We can't recover more than one packet.
-      }
-    }
-  }
-  return packets_missing;
+  // We can't recover more than one packet, so anything above that is the same.
+  return std::min<size_t>(fec_packet.num_missing_packets, 2);
 }
 
 void ForwardErrorCorrection::DiscardOldRecoveredPackets(
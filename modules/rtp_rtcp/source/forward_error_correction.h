@@ -128,6 +128,10 @@ class ForwardErrorCorrection {
 
     // List of media packets that this FEC packet protects.
     ProtectedPacketList protected_packets;
+    // Number of `protected_packets` that have neither been received nor
+    // recovered yet. Kept up to date as packets arrive, so that finding the
+    // FEC packets that can recover a packet doesn't walk the protected lists.
+    size_t num_missing_packets = 0;
     // RTP header fields.
     uint32_t ssrc;
     // FEC header fields.
@@ -0,0 +1,85 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+
+#include <list>
+#include <memory>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "modules/include/module_fec_types.h"
+#include "modules/rtp_rtcp/source/fec_test_helper.h"
+#include "modules/rtp_rtcp/source/fec_xor.h"
+#include "modules/rtp_rtcp/source/forward_error_correction.h"
+#include "rtc_base/random.h"
+#include "rtc_base/system/unused.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint32_t kMediaSsrc = 1000;
+constexpr uint32_t kFecSsrc = 2000;
+// Packets of a 1080p key frame.
+constexpr uint32_t kMinPacketSize = 1000;
+constexpr uint32_t kMaxPacketSize = 1200;
+
+void BM_XorBytes(benchmark::State& state) {
+  std::vector<uint8_t> src(state.range(0), 0x55);
+  std::vector<uint8_t> dst(state.range(0), 0xaa);
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    if (state.range(1)) {
+      internal::XorBytes(src.data(), src.size(), dst.data());
+    } else {
+      internal::XorBytes_C(src.data(), src.size(), dst.data());
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+// {bytes, vectorized}.
+BENCHMARK(BM_XorBytes)
+    ->Args({1200, 0})
+    ->Args({1200, 1})
+    ->Args({16 * 1024, 0})
+    ->Args({16 * 1024, 1});
+
+void BM_EncodeFec(benchmark::State& state) {
+  Random random(0xfec);
+  test::fec::MediaPacketGenerator generator(kMinPacketSize, kMaxPacketSize,
+                                            kMediaSsrc, &random);
+  const ForwardErrorCorrection::PacketList media_packets =
+      generator.ConstructMediaPackets(state.range(0));
+  std::unique_ptr<ForwardErrorCorrection> fec =
+      state.range(2) ? ForwardErrorCorrection::CreateFlexfec(kFecSsrc,
+                                                             kMediaSsrc)
+                     : ForwardErrorCorrection::CreateUlpfec(kMediaSsrc);
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    std::list<ForwardErrorCorrection::Packet*> fec_packets;
+    fec->EncodeFec(media_packets, state.range(1), /*num_important_packets=*/0,
+                   /*use_unequal_protection=*/false, kFecMaskBursty,
+                   &fec_packets);
+    benchmark::DoNotOptimize(fec_packets);
+  }
+}
+
+// {media packets, protection factor in Q8, FlexFEC}.
+BENCHMARK(BM_EncodeFec)
+    ->Args({10, 50, 0})
+    ->Args({40, 50, 0})
+    ->Args({40, 255, 0})
+    ->Args({10, 50, 1})
+    ->Args({40, 255, 1});
+
+}  // namespace
+}  // namespace webrtc
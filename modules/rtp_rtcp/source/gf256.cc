@@ -0,0 +1,118 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/gf256.h"
+
+#include "modules/rtp_rtcp/source/fec_xor.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include "modules/rtp_rtcp/source/gf256_neon.h"
+#elif defined(WEBRTC_ARCH_X86_FAMILY)
+#include "modules/rtp_rtcp/source/gf256_avx2.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#endif
+
+namespace webrtc {
+namespace internal {
+
+namespace {
+
+struct Gf256Tables {
+  constexpr Gf256Tables() : exp(), log() {
+    int x = 1;
+    for (int i = 0; i < 255; ++i) {
+      exp[i] = x;
+      exp[i + 255] = x;
+      log[x] = i;
+      x <<= 1;
+      if (x & 0x100) {
+        x ^= 0x11d;
+      }
+    }
+  }
+
+  // exp[] is doubled so that the sum of two logarithms can index it.
+  uint8_t exp[2 * 255];
+  uint8_t log[256];
+};
+
+constexpr Gf256Tables kTables;
+
+using Gf256MulAddFunction = void (*)(uint8_t, const uint8_t*, size_t,
+                                     uint8_t*);
+
+Gf256MulAddFunction SelectGf256MulAdd() {
+#if defined(WEBRTC_HAS_NEON)
+  return &Gf256MulAdd_NEON;
+#elif defined(WEBRTC_ARCH_X86_FAMILY)
+  if (GetCPUInfo(kAVX2)) {
+    return &Gf256MulAdd_AVX2;
+  }
+  return &Gf256MulAdd_C;
+#else
+  return &Gf256MulAdd_C;
+#endif
+}
+
+}  // namespace
+
+uint8_t Gf256Mul(uint8_t a, uint8_t b) {
+  if (a == 0 || b == 0) {
+    return 0;
+  }
+  return kTables.exp[kTables.log[a] + kTables.log[b]];
+}
+
+uint8_t Gf256Inv(uint8_t a) {
+  RTC_DCHECK_NE(a, 0);
+  return kTables.exp[255 - kTables.log[a]];
+}
+
+void Gf256MulAdd(uint8_t coefficient,
+                 const uint8_t* src,
+                 size_t length,
+                 uint8_t* dst) {
+  if (coefficient == 0) {
+    return;
+  }
+  if (coefficient == 1) {
+    XorBytes(src, length, dst);
+    return;
+  }
+  static const Gf256MulAddFunction mul_add = SelectGf256MulAdd();
+  mul_add(coefficient, src, length, dst);
+}
+
+void Gf256MulAdd_C(uint8_t coefficient,
+                   const uint8_t* src,
+                   size_t length,
+                   uint8_t* dst) {
+  uint8_t products[256];
+  for (int i = 0; i < 256; ++i) {
+    products[i] = Gf256Mul(coefficient, i);
+  }
+  for (size_t i = 0; i < length; ++i) {
+    dst[i] ^= products[src[i]];
+  }
+}
+
+void Gf256NibbleTables(uint8_t coefficient,
+                       uint8_t low_products[16],
+                       uint8_t high_products[16]) {
+  for (int i = 0; i < 16; ++i) {
+    low_products[i] = Gf256Mul(coefficient, i);
+    high_products[i] = Gf256Mul(coefficient, i << 4);
+  }
+}
+
+}  // namespace internal
+}  // namespace webrtc
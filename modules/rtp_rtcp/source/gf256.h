@@ -0,0 +1,49 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_GF256_H_
+#define MODULES_RTP_RTCP_SOURCE_GF256_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace webrtc {
+namespace internal {
+
+// Arithmetic in GF(2^8) with the polynomial x^8 + x^4 + x^3 + x^2 + 1
+// (0x11d). Addition is XOR.
+uint8_t Gf256Mul(uint8_t a, uint8_t b);
+// `a` must not be 0.
+uint8_t Gf256Inv(uint8_t a);
+
+// Multiplies `length` bytes of `src` by `coefficient` and adds the products
+// to `dst`. The buffers may have any alignment but must not overlap. Uses
+// the widest vector instructions that the CPU supports.
+void Gf256MulAdd(uint8_t coefficient,
+                 const uint8_t* src,
+                 size_t length,
+                 uint8_t* dst);
+
+// Portable version of Gf256MulAdd(), exposed for tests.
+void Gf256MulAdd_C(uint8_t coefficient,
+                   const uint8_t* src,
+                   size_t length,
+                   uint8_t* dst);
+
+// The products of `coefficient` with all values of the low and the high
+// nibble of a byte, for the table lookup kernels.
+void Gf256NibbleTables(uint8_t coefficient,
+                       uint8_t low_products[16],
+                       uint8_t high_products[16]);
+
+}  // namespace internal
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_GF256_H_
@@ -0,0 +1,53 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/gf256_avx2.h"
+
+#include <immintrin.h>
+
+#include "modules/rtp_rtcp/source/gf256.h"
+
+namespace webrtc {
+namespace internal {
+
+// Splits every byte into its two nibbles and looks up their products in
+// 16-entry tables with vpshufb; the product of the byte is their sum.
+void Gf256MulAdd_AVX2(uint8_t coefficient,
+                      const uint8_t* src,
+                      size_t length,
+                      uint8_t* dst) {
+  uint8_t low_products[16];
+  uint8_t high_products[16];
+  Gf256NibbleTables(coefficient, low_products, high_products);
+  const __m256i low_table = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(low_products)));
+  const __m256i high_table = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(high_products)));
+  const __m256i nibble_mask = _mm256_set1_epi8(0x0f);
+
+  size_t i = 0;
+  for (; i + 32 <= length; i += 32) {
+    const __m256i s =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    const __m256i low = _mm256_and_si256(s, nibble_mask);
+    const __m256i high = _mm256_and_si256(_mm256_srli_epi64(s, 4), nibble_mask);
+    const __m256i product =
+        _mm256_xor_si256(_mm256_shuffle_epi8(low_table, low),
+                         _mm256_shuffle_epi8(high_table, high));
+    __m256i* d = reinterpret_cast<__m256i*>(dst + i);
+    _mm256_storeu_si256(d, _mm256_xor_si256(_mm256_loadu_si256(d), product));
+  }
+  for (; i < length; ++i) {
+    dst[i] ^= low_products[src[i] & 0x0f] ^ high_products[src[i] >> 4];
+  }
+}
+
+}  // namespace internal
+}  // namespace webrtc
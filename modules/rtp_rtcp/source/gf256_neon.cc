@@ -0,0 +1,75 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/gf256_neon.h"
+
+#include <arm_neon.h>
+
+#include "modules/rtp_rtcp/source/gf256.h"
+#include "rtc_base/system/arch.h"
+
+namespace webrtc {
+namespace internal {
+
+namespace {
+
+#if defined(WEBRTC_ARCH_ARM64)
+using NibbleTable = uint8x16_t;
+
+NibbleTable LoadTable(const uint8_t products[16]) {
+  return vld1q_u8(products);
+}
+
+uint8x16_t Lookup(NibbleTable table, uint8x16_t indices) {
+  return vqtbl1q_u8(table, indices);
+}
+#else
+using NibbleTable = uint8x8x2_t;
+
+NibbleTable LoadTable(const uint8_t products[16]) {
+  return {{vld1_u8(products), vld1_u8(products + 8)}};
+}
+
+uint8x16_t Lookup(NibbleTable table, uint8x16_t indices) {
+  return vcombine_u8(vtbl2_u8(table, vget_low_u8(indices)),
+                     vtbl2_u8(table, vget_high_u8(indices)));
+}
+#endif
+
+}  // namespace
+
+// Splits every byte into its two nibbles and looks up their products in
+// 16-entry tables; the product of the byte is their sum.
+void Gf256MulAdd_NEON(uint8_t coefficient,
+                      const uint8_t* src,
+                      size_t length,
+                      uint8_t* dst) {
+  uint8_t low_products[16];
+  uint8_t high_products[16];
+  Gf256NibbleTables(coefficient, low_products, high_products);
+  const NibbleTable low_table = LoadTable(low_products);
+  const NibbleTable high_table = LoadTable(high_products);
+  const uint8x16_t nibble_mask = vdupq_n_u8(0x0f);
+
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    const uint8x16_t s = vld1q_u8(src + i);
+    const uint8x16_t product =
+        veorq_u8(Lookup(low_table, vandq_u8(s, nibble_mask)),
+                 Lookup(high_table, vshrq_n_u8(s, 4)));
+    vst1q_u8(dst + i, veorq_u8(vld1q_u8(dst + i), product));
+  }
+  for (; i < length; ++i) {
+    dst[i] ^= low_products[src[i] & 0x0f] ^ high_products[src[i] >> 4];
+  }
+}
+
+}  // namespace internal
+}  // namespace webrtc
@@ -0,0 +1,114 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/gf256.h"
+
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "rtc_base/system/arch.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include "modules/rtp_rtcp/source/gf256_neon.h"
+#elif defined(WEBRTC_ARCH_X86_FAMILY)
+#include "modules/rtp_rtcp/source/gf256_avx2.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#endif
+
+namespace webrtc {
+namespace internal {
+namespace {
+
+using ::testing::ElementsAreArray;
+
+using Gf256MulAddFunction = void (*)(uint8_t, const uint8_t*, size_t,
+                                     uint8_t*);
+
+// Multiplication the long way: carry-less multiplication, reduced by the
+// field polynomial.
+uint8_t SlowMul(uint8_t a, uint8_t b) {
+  int product = 0;
+  for (int i = 0; i < 8; ++i) {
+    if (b & (1 << i)) {
+      product ^= a << i;
+    }
+  }
+  for (int i = 15; i >= 8; --i) {
+    if (product & (1 << i)) {
+      product ^= 0x11d << (i - 8);
+    }
+  }
+  return product;
+}
+
+void TestMulAdd(Gf256MulAddFunction mul_add) {
+  constexpr size_t kMaxLength = 100;
+  Random random(0x256);
+  std::vector<uint8_t> src(kMaxLength + 1);
+  for (uint8_t& byte : src) {
+    byte = random.Rand<uint8_t>();
+  }
+  for (int coefficient : {2, 3, 0x53, 0x8e, 0xff}) {
+    for (size_t length = 0; length <= kMaxLength; ++length) {
+      std::vector<uint8_t> dst(kMaxLength + 1);
+      for (uint8_t& byte : dst) {
+        byte = random.Rand<uint8_t>();
+      }
+      std::vector<uint8_t> expected = dst;
+      for (size_t i = 0; i < length; ++i) {
+        expected[i] ^= SlowMul(coefficient, src[i + 1]);
+      }
+      mul_add(coefficient, src.data() + 1, length, dst.data());
+      ASSERT_THAT(dst, ElementsAreArray(expected))
+          << "coefficient " << coefficient << ", length " << length;
+    }
+  }
+}
+
+TEST(Gf256Test, Mul) {
+  for (int a = 0; a < 256; ++a) {
+    for (int b = 0; b < 256; ++b) {
+      ASSERT_EQ(Gf256Mul(a, b), SlowMul(a, b)) << a << " * " << b;
+    }
+  }
+}
+
+TEST(Gf256Test, Inv) {
+  for (int a = 1; a < 256; ++a) {
+    EXPECT_EQ(Gf256Mul(a, Gf256Inv(a)), 1) << a;
+  }
+}
+
+TEST(Gf256Test, MulAdd) {
+  TestMulAdd(&Gf256MulAdd);
+}
+
+TEST(Gf256Test, MulAddC) {
+  TestMulAdd(&Gf256MulAdd_C);
+}
+
+#if defined(WEBRTC_HAS_NEON)
+TEST(Gf256Test, MulAddNeon) {
+  TestMulAdd(&Gf256MulAdd_NEON);
+}
+#elif defined(WEBRTC_ARCH_X86_FAMILY)
+TEST(Gf256Test, MulAddAvx2) {
+  if (!GetCPUInfo(kAVX2)) {
+    GTEST_SKIP() << "AVX2 not supported.";
+  }
+  TestMulAdd(&Gf256MulAdd_AVX2);
+}
+#endif
+
+}  // namespace
+}  // namespace internal
+}  // namespace webrtc
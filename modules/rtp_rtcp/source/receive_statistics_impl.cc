@@ -36,6 +36,83 @@ constexpr int64_t kNtpJan1970Millisecs = 2'208'988'800'000;
 
 StreamStatistician::~StreamStatistician() {}
 
+absl::optional<int> StreamReceiveState::FractionLostInPercent() const {
+  if (!ReceivedRtpPacket()) {
+    return absl::nullopt;
+  }
+  int64_t expected_packets = 1 + received_seq_max - received_seq_first;
+  if (expected_packets <= 0) {
+    return absl::nullopt;
+  }
+  if (cumulative_loss <= 0) {
+    return 0;
+  }
+  return 100 * static_cast<int64_t>(cumulative_loss) / expected_packets;
+}
+
+void StreamReportState::MaybeAppendReportBlockAndReset(
+    uint32_t ssrc,
+    const StreamReceiveState& state,
+    int64_t now_ms,
+    std::vector<rtcp::ReportBlock>& report_blocks) {
+  if (now_ms - state.last_receive_time_ms >= kStatisticsTimeoutMs) {
+    // Not active.
+    return;
+  }
+  if (!state.ReceivedRtpPacket()) {
+    return;
+  }
+  if (state.num_resets != num_resets_) {
+    num_resets_ = state.num_resets;
+    last_report_seq_max_ = state.reset_seq_max;
+  }
+
+  report_blocks.emplace_back();
+  rtcp::ReportBlock& stats = report_blocks.back();
+  stats.SetMediaSsrc(ssrc);
+  // Calculate fraction lost.
+  int64_t exp_since_last = state.received_seq_max - last_report_seq_max_;
+  RTC_DCHECK_GE(exp_since_last, 0);
+
+  int32_t lost_since_last =
+      state.cumulative_loss - last_report_cumulative_loss_;
+  if (exp_since_last > 0 && lost_since_last > 0) {
+    // Scale 0 to 255, where 255 is 100% loss.
+    stats.SetFractionLost(255 * lost_since_last / exp_since_last);
+  }
+
+  int packets_lost = state.cumulative_loss + cumulative_loss_rtcp_offset_;
+  if (packets_lost < 0) {
+    // Clamp to zero. Work around to accomodate for senders that misbehave with
+    // negative cumulative loss.
+    packets_lost = 0;
+    cumulative_loss_rtcp_offset_ = -state.cumulative_loss;
+  }
+  if (packets_lost > 0x7fffff) {
+    // Packets lost is a 24 bit signed field, and thus should be clamped, as
+    // described in https://datatracker.ietf.org/doc/html/rfc3550#appendix-A.3
+    if (!cumulative_loss_is_capped_) {
+      cumulative_loss_is_capped_ = true;
+      RTC_LOG(LS_WARNING) << "Cumulative loss reached maximum value for ssrc "
+                          << ssrc;
+    }
+    packets_lost = 0x7fffff;
+  }
+  stats.SetCumulativeLost(packets_lost);
+  stats.SetExtHighestSeqNum(state.received_seq_max);
+  // Note: internal jitter value is in Q4 and needs to be scaled by 1/16.
+  stats.SetJitter(state.jitter_q4 >> 4);
+
+  // Only for report blocks in RTCP SR and RR.
+  last_report_cumulative_loss_ = state.cumulative_loss;
+  last_report_seq_max_ = state.received_seq_max;
+  BWE_TEST_LOGGING_PLOT_WITH_SSRC(1, "cumulative_loss_pkts", now_ms,
+                                  state.cumulative_loss, ssrc);
+  BWE_TEST_LOGGING_PLOT_WITH_SSRC(
+      1, "received_seq_max_pkts", now_ms,
+      (state.received_seq_max - state.received_seq_first), ssrc);
+}
+
 StreamStatisticianImpl::StreamStatisticianImpl(uint32_t ssrc,
                                                Clock* clock,
                                                int max_reordering_threshold)
@@ -48,16 +125,7 @@ StreamStatisticianImpl::StreamStatisticianImpl(uint32_t ssrc,
                         RateStatistics::kBpsScale),
       max_reordering_threshold_(max_reordering_threshold),
       enable_retransmit_detection_(false),
-      cumulative_loss_is_capped_(false),
-      jitter_q4_(0),
-      cumulative_loss_(0),
-      cumulative_loss_rtcp_offset_(0),
-      last_receive_time_ms_(0),
-      last_received_timestamp_(0),
-      received_seq_first_(-1),
-      received_seq_max_(-1),
-      last_report_cumulative_loss_(0),
-      last_report_seq_max_(-1) {}
+      last_received_timestamp_(0) {}
 
 StreamStatisticianImpl::~StreamStatisticianImpl() = default;
 
@@ -67,41 +135,41 @@ bool StreamStatisticianImpl::UpdateOutOfOrder(const RtpPacketReceived& packet,
   // Check if `packet` is second packet of a stream restart.
   if (received_seq_out_of_order_) {
     // Count the previous packet as a received; it was postponed below.
-    --cumulative_loss_;
+    --receive_state_.cumulative_loss;
 
     uint16_t expected_sequence_number = *received_seq_out_of_order_ + 1;
     received_seq_out_of_order_ = absl::nullopt;
     if (packet.SequenceNumber() == expected_sequence_number) {
       // Ignore sequence number gap caused by stream restart for packet loss
-      // calculation, by setting received_seq_max_ to the sequence number just
+      // calculation, by setting received_seq_max to the sequence number just
       // before the out-of-order seqno. This gives a net zero change of
-      // `cumulative_loss_`, for the two packets interpreted as a stream reset.
+      // `cumulative_loss`, for the two packets interpreted as a stream reset.
       //
-      // Fraction loss for the next report may get a bit off, since we don't
-      // update last_report_seq_max_ and last_report_cumulative_loss_ in a
-      // consistent way.
-      last_report_seq_max_ = sequence_number - 2;
-      received_seq_max_ = sequence_number - 2;
+      // Fraction loss for the next report may get a bit off, since the report
+      // state only updates its last seq max, not its last cumulative loss.
+      ++receive_state_.num_resets;
+      receive_state_.reset_seq_max = sequence_number - 2;
+      receive_state_.received_seq_max = sequence_number - 2;
       return false;
     }
   }
 
-  if (std::abs(sequence_number - received_seq_max_) >
+  if (std::abs(sequence_number - receive_state_.received_seq_max) >
       max_reordering_threshold_) {
     // Sequence number gap looks too large, wait until next packet to check
     // for a stream restart.
     received_seq_out_of_order_ = packet.SequenceNumber();
     // Postpone counting this as a received packet until we know how to update
-    // `received_seq_max_`, otherwise we temporarily decrement
-    // `cumulative_loss_`. The
+    // `received_seq_max`, otherwise we temporarily decrement
+    // `cumulative_loss`. The
     // ReceiveStatisticsTest.StreamRestartDoesntCountAsLoss test expects
-    // `cumulative_loss_` to be unchanged by the reception of the first packet
+    // `cumulative_loss` to be unchanged by the reception of the first packet
     // after stream reset.
-    ++cumulative_loss_;
+    ++receive_state_.cumulative_loss;
     return true;
   }
 
-  if (sequence_number > received_seq_max_)
+  if (sequence_number > receive_state_.received_seq_max)
     return false;
 
   // Old out of order packet, may be retransmit.
@@ -117,22 +185,24 @@ void StreamStatisticianImpl::UpdateCounters(const RtpPacketReceived& packet) {
   incoming_bitrate_.Update(packet.size(), now_ms);
   receive_counters_.last_packet_received_timestamp_ms = now_ms;
   receive_counters_.transmitted.AddPacket(packet);
-  --cumulative_loss_;
+  --receive_state_.cumulative_loss;
 
   int64_t sequence_number =
       seq_unwrapper_.UnwrapWithoutUpdate(packet.SequenceNumber());
 
-  if (!ReceivedRtpPacket()) {
-    received_seq_first_ = sequence_number;
-    last_report_seq_max_ = sequence_number - 1;
-    received_seq_max_ = sequence_number - 1;
+  if (!receive_state_.ReceivedRtpPacket()) {
+    receive_state_.received_seq_first = sequence_number;
+    ++receive_state_.num_resets;
+    receive_state_.reset_seq_max = sequence_number - 1;
+    receive_state_.received_seq_max = sequence_number - 1;
     receive_counters_.first_packet_time_ms = now_ms;
   } else if (UpdateOutOfOrder(packet, sequence_number, now_ms)) {
     return;
   }
   // In order packet.
-  cumulative_loss_ += sequence_number - received_seq_max_;
-  received_seq_max_ = sequence_number;
+  receive_state_.cumulative_loss +=
+      sequence_number - receive_state_.received_seq_max;
+  receive_state_.received_seq_max = sequence_number;
   seq_unwrapper_.UpdateLast(sequence_number);
 
   // If new time stamp and more than one in-order packet received, calculate
@@ -143,12 +213,13 @@ void StreamStatisticianImpl::UpdateCounters(const RtpPacketReceived& packet) {
     UpdateJitter(packet, now_ms);
   }
   last_received_timestamp_ = packet.Timestamp();
-  last_receive_time_ms_ = now_ms;
+  receive_state_.last_receive_time_ms = now_ms;
 }
 
 void StreamStatisticianImpl::UpdateJitter(const RtpPacketReceived& packet,
                                           int64_t receive_time_ms) {
-  int64_t receive_diff_ms = receive_time_ms - last_receive_time_ms_;
+  int64_t receive_diff_ms =
+      receive_time_ms - receive_state_.last_receive_time_ms;
   RTC_DCHECK_GE(receive_diff_ms, 0);
   uint32_t receive_diff_rtp = static_cast<uint32_t>(
       (receive_diff_ms * packet.payload_type_frequency()) / 1000);
@@ -162,8 +233,9 @@ void StreamStatisticianImpl::UpdateJitter(const RtpPacketReceived& packet,
   // as the threshold.
   if (time_diff_samples < 450000) {
     // Note we calculate in Q4 to avoid using float.
-    int32_t jitter_diff_q4 = (time_diff_samples << 4) - jitter_q4_;
-    jitter_q4_ += ((jitter_diff_q4 + 8) >> 4);
+    int32_t jitter_diff_q4 =
+        (time_diff_samples << 4) - receive_state_.jitter_q4;
+    receive_state_.jitter_q4 += ((jitter_diff_q4 + 8) >> 4);
   }
 }
 
@@ -178,10 +250,10 @@ void StreamStatisticianImpl::EnableRetransmitDetection(bool enable) {
 
 RtpReceiveStats StreamStatisticianImpl::GetStats() const {
   RtpReceiveStats stats;
-  stats.packets_lost = cumulative_loss_;
+  stats.packets_lost = receive_state_.cumulative_loss;
   // TODO(nisse): Can we return a float instead?
   // Note: internal jitter value is in Q4 and needs to be scaled by 1/16.
-  stats.jitter = jitter_q4_ >> 4;
+  stats.jitter = receive_state_.jitter_q4 >> 4;
   if (receive_counters_.last_packet_received_timestamp_ms.has_value()) {
     stats.last_packet_received_timestamp_ms =
         *receive_counters_.last_packet_received_timestamp_ms +
@@ -193,72 +265,12 @@ RtpReceiveStats StreamStatisticianImpl::GetStats() const {
 
 void StreamStatisticianImpl::MaybeAppendReportBlockAndReset(
     std::vector<rtcp::ReportBlock>& report_blocks) {
-  int64_t now_ms = clock_->TimeInMilliseconds();
-  if (now_ms - last_receive_time_ms_ >= kStatisticsTimeoutMs) {
-    // Not active.
-    return;
-  }
-  if (!ReceivedRtpPacket()) {
-    return;
-  }
-
-  report_blocks.emplace_back();
-  rtcp::ReportBlock& stats = report_blocks.back();
-  stats.SetMediaSsrc(ssrc_);
-  // Calculate fraction lost.
-  int64_t exp_since_last = received_seq_max_ - last_report_seq_max_;
-  RTC_DCHECK_GE(exp_since_last, 0);
-
-  int32_t lost_since_last = cumulative_loss_ - last_report_cumulative_loss_;
-  if (exp_since_last > 0 && lost_since_last > 0) {
-    // Scale 0 to 255, where 255 is 100% loss.
-    stats.SetFractionLost(255 * lost_since_last / exp_since_last);
-  }
-
-  int packets_lost = cumulative_loss_ + cumulative_loss_rtcp_offset_;
-  if (packets_lost < 0) {
-    // Clamp to zero. Work around to accomodate for senders that misbehave with
-    // negative cumulative loss.
-    packets_lost = 0;
-    cumulative_loss_rtcp_offset_ = -cumulative_loss_;
-  }
-  if (packets_lost > 0x7fffff) {
-    // Packets lost is a 24 bit signed field, and thus should be clamped, as
-    // described in https://datatracker.ietf.org/doc/html/rfc3550#appendix-A.3
-    if (!cumulative_loss_is_capped_) {
-      cumulative_loss_is_capped_ = true;
-      RTC_LOG(LS_WARNING) << "Cumulative loss reached maximum value for ssrc "
-                          << ssrc_;
-    }
-    packets_lost = 0x7fffff;
-  }
-  stats.SetCumulativeLost(packets_lost);
-  stats.SetExtHighestSeqNum(received_seq_max_);
-  // Note: internal jitter value is in Q4 and needs to be scaled by 1/16.
-  stats.SetJitter(jitter_q4_ >> 4);
-
-  // Only for report blocks in RTCP SR and RR.
-  last_report_cumulative_loss_ = cumulative_loss_;
-  last_report_seq_max_ = received_seq_max_;
-  BWE_TEST_LOGGING_PLOT_WITH_SSRC(1, "cumulative_loss_pkts", now_ms,
-                                  cumulative_loss_, ssrc_);
-  BWE_TEST_LOGGING_PLOT_WITH_SSRC(1, "received_seq_max_pkts", now_ms,
-                                  (received_seq_max_ - received_seq_first_),
-                                  ssrc_);
+  report_state_.MaybeAppendReportBlockAndReset(
+      ssrc_, receive_state_, clock_->TimeInMilliseconds(), report_blocks);
 }
 
 absl::optional<int> StreamStatisticianImpl::GetFractionLostInPercent() const {
-  if (!ReceivedRtpPacket()) {
-    return absl::nullopt;
-  }
-  int64_t expected_packets = 1 + received_seq_max_ - received_seq_first_;
-  if (expected_packets <= 0) {
-    return absl::nullopt;
-  }
-  if (cumulative_loss_ <= 0) {
-    return 0;
-  }
-  return 100 * static_cast<int64_t>(cumulative_loss_) / expected_packets;
+  return receive_state_.FractionLostInPercent();
 }
 
 StreamDataCounters StreamStatisticianImpl::GetReceiveStreamDataCounters()
@@ -276,7 +288,7 @@ bool StreamStatisticianImpl::IsRetransmitOfOldPacket(
   uint32_t frequency_khz = packet.payload_type_frequency() / 1000;
   RTC_DCHECK_GT(frequency_khz, 0);
 
-  int64_t time_diff_ms = now_ms - last_receive_time_ms_;
+  int64_t time_diff_ms = now_ms - receive_state_.last_receive_time_ms;
 
   // Diff in time stamp since last received in order.
   uint32_t timestamp_diff = packet.Timestamp() - last_received_timestamp_;
@@ -285,7 +297,8 @@ bool StreamStatisticianImpl::IsRetransmitOfOldPacket(
   int64_t max_delay_ms = 0;
 
   // Jitter standard deviation in samples.
-  float jitter_std = std::sqrt(static_cast<float>(jitter_q4_ >> 4));
+  float jitter_std =
+      std::sqrt(static_cast<float>(receive_state_.jitter_q4 >> 4));
 
   // 2 times the standard deviation => 95% confidence.
   // And transform to milliseconds by dividing by the frequency in kHz.
@@ -315,6 +328,11 @@ std::unique_ptr<ReceiveStatistics> ReceiveStatistics::CreateThreadCompatible(
       });
 }
 
+std::unique_ptr<ReceiveStatistics> ReceiveStatistics::CreateSingleWriter(
+    Clock* clock) {
+  return std::make_unique<ReceiveStatisticsSingleWriter>(clock);
+}
+
 ReceiveStatisticsImpl::ReceiveStatisticsImpl(
     Clock* clock,
     std::function<std::unique_ptr<StreamStatisticianImplInterface>(
@@ -390,4 +408,176 @@ std::vector<rtcp::ReportBlock> ReceiveStatisticsImpl::RtcpReportBlocks(
   return result;
 }
 
+StreamStatisticianSeqLocked::StreamStatisticianSeqLocked(
+    uint32_t ssrc,
+    Clock* clock,
+    int max_reordering_threshold)
+    : ssrc_(ssrc),
+      clock_(clock),
+      impl_(ssrc, clock, max_reordering_threshold),
+      delta_internal_unix_epoch_ms_(impl_.delta_internal_unix_epoch_ms()) {
+  packet_sequence_.Detach();
+}
+
+void StreamStatisticianSeqLocked::UpdateCounters(
+    const RtpPacketReceived& packet) {
+  RTC_DCHECK_RUN_ON(&packet_sequence_);
+  impl_.UpdateCounters(packet);
+
+  const StreamDataCounters& counters = impl_.GetReceiveStreamDataCounters();
+  Snapshot snapshot;
+  snapshot.receive_state = impl_.receive_state();
+  snapshot.first_packet_time_ms = counters.first_packet_time_ms;
+  snapshot.last_packet_received_timestamp_ms =
+      counters.last_packet_received_timestamp_ms.value_or(-1);
+  snapshot.transmitted = counters.transmitted;
+  snapshot.retransmitted = counters.retransmitted;
+  snapshot.fec = counters.fec;
+  snapshot.bitrate_bps = impl_.BitrateReceived();
+  snapshot_.Store(snapshot);
+}
+
+void StreamStatisticianSeqLocked::SetMaxReorderingThreshold(
+    int max_reordering_threshold) {
+  RTC_DCHECK_RUN_ON(&packet_sequence_);
+  impl_.SetMaxReorderingThreshold(max_reordering_threshold);
+}
+
+void StreamStatisticianSeqLocked::EnableRetransmitDetection(bool enable) {
+  RTC_DCHECK_RUN_ON(&packet_sequence_);
+  impl_.EnableRetransmitDetection(enable);
+}
+
+RtpReceiveStats StreamStatisticianSeqLocked::GetStats() const {
+  const Snapshot snapshot = snapshot_.Load();
+  RtpReceiveStats stats;
+  stats.packets_lost = snapshot.receive_state.cumulative_loss;
+  // Note: internal jitter value is in Q4 and needs to be scaled by 1/16.
+  stats.jitter = snapshot.receive_state.jitter_q4 >> 4;
+  if (snapshot.last_packet_received_timestamp_ms >= 0) {
+    stats.last_packet_received_timestamp_ms =
+        snapshot.last_packet_received_timestamp_ms +
+        delta_internal_unix_epoch_ms_;
+  }
+  stats.packet_counter = snapshot.transmitted;
+  return stats;
+}
+
+absl::optional<int> StreamStatisticianSeqLocked::GetFractionLostInPercent()
+    const {
+  return snapshot_.Load().receive_state.FractionLostInPercent();
+}
+
+StreamDataCounters StreamStatisticianSeqLocked::GetReceiveStreamDataCounters()
+    const {
+  const Snapshot snapshot = snapshot_.Load();
+  StreamDataCounters counters;
+  counters.first_packet_time_ms = snapshot.first_packet_time_ms;
+  if (snapshot.last_packet_received_timestamp_ms >= 0) {
+    counters.last_packet_received_timestamp_ms =
+        snapshot.last_packet_received_timestamp_ms;
+  }
+  counters.transmitted = snapshot.transmitted;
+  counters.retransmitted = snapshot.retransmitted;
+  counters.fec = snapshot.fec;
+  return counters;
+}
+
+uint32_t StreamStatisticianSeqLocked::BitrateReceived() const {
+  const Snapshot snapshot = snapshot_.Load();
+  if (snapshot.last_packet_received_timestamp_ms < 0 ||
+      clock_->TimeInMilliseconds() -
+              snapshot.last_packet_received_timestamp_ms >=
+          kStatisticsProcessIntervalMs) {
+    return 0;
+  }
+  return snapshot.bitrate_bps;
+}
+
+void StreamStatisticianSeqLocked::MaybeAppendReportBlockAndReset(
+    std::vector<rtcp::ReportBlock>& report_blocks) {
+  const Snapshot snapshot = snapshot_.Load();
+  MutexLock lock(&report_lock_);
+  report_state_.MaybeAppendReportBlockAndReset(
+      ssrc_, snapshot.receive_state, clock_->TimeInMilliseconds(),
+      report_blocks);
+}
+
+ReceiveStatisticsSingleWriter::ReceiveStatisticsSingleWriter(Clock* clock)
+    : clock_(clock),
+      max_reordering_threshold_(kDefaultMaxReorderingThreshold),
+      last_returned_ssrc_idx_(0) {
+  packet_sequence_.Detach();
+}
+
+void ReceiveStatisticsSingleWriter::OnRtpPacket(
+    const RtpPacketReceived& packet) {
+  RTC_DCHECK_RUN_ON(&packet_sequence_);
+  GetOrCreateStatistician(packet.Ssrc())->UpdateCounters(packet);
+}
+
+StreamStatistician* ReceiveStatisticsSingleWriter::GetStatistician(
+    uint32_t ssrc) const {
+  MutexLock lock(&streams_lock_);
+  const auto& it = statisticians_.find(ssrc);
+  if (it == statisticians_.end())
+    return nullptr;
+  return it->second.get();
+}
+
+StreamStatisticianSeqLocked*
+ReceiveStatisticsSingleWriter::GetOrCreateStatistician(uint32_t ssrc) {
+  StreamStatisticianSeqLocked*& statistician = packet_statisticians_[ssrc];
+  if (statistician == nullptr) {  // new element
+    auto impl = std::make_unique<StreamStatisticianSeqLocked>(
+        ssrc, clock_, max_reordering_threshold_);
+    statistician = impl.get();
+    MutexLock lock(&streams_lock_);
+    statisticians_[ssrc] = std::move(impl);
+    all_ssrcs_.push_back(ssrc);
+  }
+  return statistician;
+}
+
+void ReceiveStatisticsSingleWriter::SetMaxReorderingThreshold(
+    int max_reordering_threshold) {
+  RTC_DCHECK_RUN_ON(&packet_sequence_);
+  max_reordering_threshold_ = max_reordering_threshold;
+  for (auto& statistician : packet_statisticians_) {
+    statistician.second->SetMaxReorderingThreshold(max_reordering_threshold);
+  }
+}
+
+void ReceiveStatisticsSingleWriter::SetMaxReorderingThreshold(
+    uint32_t ssrc,
+    int max_reordering_threshold) {
+  RTC_DCHECK_RUN_ON(&packet_sequence_);
+  GetOrCreateStatistician(ssrc)->SetMaxReorderingThreshold(
+      max_reordering_threshold);
+}
+
+void ReceiveStatisticsSingleWriter::EnableRetransmitDetection(uint32_t ssrc,
+                                                              bool enable) {
+  RTC_DCHECK_RUN_ON(&packet_sequence_);
+  GetOrCreateStatistician(ssrc)->EnableRetransmitDetection(enable);
+}
+
+std::vector<rtcp::ReportBlock> ReceiveStatisticsSingleWriter::RtcpReportBlocks(
+    size_t max_blocks) {
+  MutexLock lock(&streams_lock_);
+  std::vector<rtcp::ReportBlock> result;
+  result.reserve(std::min(max_blocks, all_ssrcs_.size()));
+
+  size_t ssrc_idx = 0;
+  for (size_t i = 0; i < all_ssrcs_.size() && result.size() < max_blocks; ++i) {
+    ssrc_idx = (last_returned_ssrc_idx_ + i + 1) % all_ssrcs_.size();
+    const uint32_t media_ssrc = all_ssrcs_[ssrc_idx];
+    auto statistician_it = statisticians_.find(media_ssrc);
+    RTC_DCHECK(statistician_it != statisticians_.end());
+    statistician_it->second->MaybeAppendReportBlockAndReset(result);
+  }
+  last_returned_ssrc_idx_ = ssrc_idx;
+  return result;
+}
+
 }  // namespace webrtc
@@ -11,23 +11,118 @@
 #ifndef MODULES_RTP_RTCP_SOURCE_RECEIVE_STATISTICS_IMPL_H_
 #define MODULES_RTP_RTCP_SOURCE_RECEIVE_STATISTICS_IMPL_H_
 
+#include <string.h>
+
 #include <algorithm>
+#include <atomic>
 #include <functional>
 #include <memory>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include "absl/types/optional.h"
+#include "api/sequence_checker.h"
 #include "modules/include/module_common_types_public.h"
 #include "modules/rtp_rtcp/include/receive_statistics.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/report_block.h"
 #include "rtc_base/containers/flat_map.h"
 #include "rtc_base/rate_statistics.h"
 #include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/system/no_unique_address.h"
 #include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
 
+// The receive state of a stream that report blocks are made from.
+struct StreamReceiveState {
+  // Checks if any rtp packets were received.
+  bool ReceivedRtpPacket() const { return received_seq_first >= 0; }
+  // Returns the average loss over the stream life time.
+  absl::optional<int> FractionLostInPercent() const;
+
+  int64_t received_seq_first = -1;
+  int64_t received_seq_max = -1;
+  // Cumulative loss according to RFC 3550, which may be negative (and often is,
+  // if packets are reordered and there are non-RTX retransmissions).
+  int32_t cumulative_loss = 0;
+  uint32_t jitter_q4 = 0;
+  int64_t last_receive_time_ms = 0;
+  // Incremented on the first packet and when the stream restarts. The next
+  // report then computes the fraction lost since `reset_seq_max`.
+  uint32_t num_resets = 0;
+  int64_t reset_seq_max = -1;
+};
+
+// What a stream statistician keeps between the RTCP reports it makes.
+class StreamReportState {
+ public:
+  // Appends the report block made from `state` to `report_blocks`, unless no
+  // packets were received recently, and starts the next report interval.
+  void MaybeAppendReportBlockAndReset(
+      uint32_t ssrc,
+      const StreamReceiveState& state,
+      int64_t now_ms,
+      std::vector<rtcp::ReportBlock>& report_blocks);
+
+ private:
+  bool cumulative_loss_is_capped_ = false;
+  // Offset added to outgoing rtcp reports, to make ensure that the reported
+  // cumulative loss is non-negative. Reports with negative values confuse some
+  // senders, in particular, our own loss-based bandwidth estimator.
+  int32_t cumulative_loss_rtcp_offset_ = 0;
+  // Counter values when we sent the last report.
+  int32_t last_report_cumulative_loss_ = 0;
+  int64_t last_report_seq_max_ = -1;
+  uint32_t num_resets_ = 0;
+};
+
+// Lets one writer publish a trivially copyable `T` to readers on other
+// threads, without either of them ever blocking the writer. Readers retry
+// while a write is in progress.
+template <typename T>
+class SeqLocked {
+ public:
+  SeqLocked() { Store(T()); }
+
+  // Must not be called concurrently with itself.
+  void Store(const T& value) {
+    uint64_t words[kWords] = {};
+    memcpy(words, &value, sizeof(T));
+    const uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < kWords; ++i) {
+      words_[i].store(words[i], std::memory_order_relaxed);
+    }
+    sequence_.store(sequence + 2, std::memory_order_release);
+  }
+
+  T Load() const {
+    uint64_t words[kWords];
+    uint32_t before;
+    uint32_t after;
+    do {
+      before = sequence_.load(std::memory_order_acquire);
+      for (size_t i = 0; i < kWords; ++i) {
+        words[i] = words_[i].load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      after = sequence_.load(std::memory_order_relaxed);
+    } while ((before & 1) != 0 || before != after);
+    T value;
+    memcpy(&value, words, sizeof(T));
+    return value;
+  }
+
+ private:
+  static_assert(std::is_trivially_copyable<T>::value, "");
+  static constexpr size_t kWords = (sizeof(T) + 7) / 8;
+
+  std::atomic<uint32_t> sequence_{0};
+  std::atomic<uint64_t> words_[kWords];
+};
+
 // Extends StreamStatistician with methods needed by the implementation.
 class StreamStatisticianImplInterface : public StreamStatistician {
  public:
@@ -61,6 +156,11 @@ class StreamStatisticianImpl : public StreamStatisticianImplInterface {
   // Updates StreamStatistician for incoming packets.
   void UpdateCounters(const RtpPacketReceived& packet) override;
 
+  const StreamReceiveState& receive_state() const { return receive_state_; }
+  int64_t delta_internal_unix_epoch_ms() const {
+    return delta_internal_unix_epoch_ms_;
+  }
+
  private:
   bool IsRetransmitOfOldPacket(const RtpPacketReceived& packet,
                                int64_t now_ms) const;
@@ -70,9 +170,6 @@ class StreamStatisticianImpl : public StreamStatisticianImplInterface {
   bool UpdateOutOfOrder(const RtpPacketReceived& packet,
                         int64_t sequence_number,
                         int64_t now_ms);
-  // Checks if this StreamStatistician received any rtp packets.
-  bool ReceivedRtpPacket() const { return received_seq_first_ >= 0; }
-
   const uint32_t ssrc_;
   Clock* const clock_;
   // Delta used to map internal timestamps to Unix epoch ones.
@@ -81,33 +178,19 @@ class StreamStatisticianImpl : public StreamStatisticianImplInterface {
   // In number of packets or sequence numbers.
   int max_reordering_threshold_;
   bool enable_retransmit_detection_;
-  bool cumulative_loss_is_capped_;
 
   // Stats on received RTP packets.
-  uint32_t jitter_q4_;
-  // Cumulative loss according to RFC 3550, which may be negative (and often is,
-  // if packets are reordered and there are non-RTX retransmissions).
-  int32_t cumulative_loss_;
-  // Offset added to outgoing rtcp reports, to make ensure that the reported
-  // cumulative loss is non-negative. Reports with negative values confuse some
-  // senders, in particular, our own loss-based bandwidth estimator.
-  int32_t cumulative_loss_rtcp_offset_;
-
-  int64_t last_receive_time_ms_;
+  StreamReceiveState receive_state_;
   uint32_t last_received_timestamp_;
   SequenceNumberUnwrapper seq_unwrapper_;
-  int64_t received_seq_first_;
-  int64_t received_seq_max_;
   // Assume that the other side restarted when there are two sequential packets
-  // with large jump from received_seq_max_.
+  // with large jump from received_seq_max.
   absl::optional<uint16_t> received_seq_out_of_order_;
 
   // Current counter values.
   StreamDataCounters receive_counters_;
 
-  // Counter values when we sent the last report.
-  int32_t last_report_cumulative_loss_;
-  int64_t last_report_seq_max_;
+  StreamReportState report_state_;
 };
 
 // Thread-safe implementation of StreamStatisticianImplInterface.
@@ -242,5 +325,98 @@ class ReceiveStatisticsLocked : public ReceiveStatistics {
   ReceiveStatisticsImpl impl_ RTC_GUARDED_BY(&receive_statistics_lock_);
 };
 
+// Implementation of StreamStatisticianImplInterface that is updated on one
+// packet sequence and read on any thread. UpdateCounters(),
+// SetMaxReorderingThreshold() and EnableRetransmitDetection() must be called
+// on the packet sequence. Each packet publishes a snapshot of the counters,
+// which the other methods read without ever blocking the packet sequence.
+class StreamStatisticianSeqLocked : public StreamStatisticianImplInterface {
+ public:
+  StreamStatisticianSeqLocked(uint32_t ssrc,
+                              Clock* clock,
+                              int max_reordering_threshold);
+  ~StreamStatisticianSeqLocked() override = default;
+
+  // Implements StreamStatistician
+  RtpReceiveStats GetStats() const override;
+  absl::optional<int> GetFractionLostInPercent() const override;
+  StreamDataCounters GetReceiveStreamDataCounters() const override;
+  // The rate as of the last received packet, 0 once no packet has been
+  // received for a second.
+  uint32_t BitrateReceived() const override;
+
+  // Implements StreamStatisticianImplInterface
+  void MaybeAppendReportBlockAndReset(
+      std::vector<rtcp::ReportBlock>& report_blocks) override;
+  void SetMaxReorderingThreshold(int max_reordering_threshold) override;
+  void EnableRetransmitDetection(bool enable) override;
+  void UpdateCounters(const RtpPacketReceived& packet) override;
+
+ private:
+  struct Snapshot {
+    StreamReceiveState receive_state;
+    int64_t first_packet_time_ms = -1;
+    // In the internal clock, -1 until a packet is received.
+    int64_t last_packet_received_timestamp_ms = -1;
+    RtpPacketCounter transmitted;
+    RtpPacketCounter retransmitted;
+    RtpPacketCounter fec;
+    uint32_t bitrate_bps = 0;
+  };
+
+  const uint32_t ssrc_;
+  Clock* const clock_;
+  RTC_NO_UNIQUE_ADDRESS SequenceChecker packet_sequence_;
+  StreamStatisticianImpl impl_ RTC_GUARDED_BY(&packet_sequence_);
+  const int64_t delta_internal_unix_epoch_ms_;
+  SeqLocked<Snapshot> snapshot_;
+  // Only taken by RTCP generation, never on the packet sequence.
+  Mutex report_lock_;
+  StreamReportState report_state_ RTC_GUARDED_BY(report_lock_);
+};
+
+// Thread-safe implementation for receivers that deliver all packets on one
+// sequence. OnRtpPacket(), SetMaxReorderingThreshold() and
+// EnableRetransmitDetection() must be called on that sequence. They only take
+// a lock when they see a new ssrc, so packets don't wait for
+// RtcpReportBlocks() and the statisticians, which may be used on any thread.
+class ReceiveStatisticsSingleWriter : public ReceiveStatistics {
+ public:
+  explicit ReceiveStatisticsSingleWriter(Clock* clock);
+  ~ReceiveStatisticsSingleWriter() override = default;
+
+  // Implements ReceiveStatisticsProvider.
+  std::vector<rtcp::ReportBlock> RtcpReportBlocks(size_t max_blocks) override;
+
+  // Implements RtpPacketSinkInterface
+  void OnRtpPacket(const RtpPacketReceived& packet) override;
+
+  // Implements ReceiveStatistics.
+  StreamStatistician* GetStatistician(uint32_t ssrc) const override;
+  void SetMaxReorderingThreshold(int max_reordering_threshold) override;
+  void SetMaxReorderingThreshold(uint32_t ssrc,
+                                 int max_reordering_threshold) override;
+  void EnableRetransmitDetection(uint32_t ssrc, bool enable) override;
+
+ private:
+  StreamStatisticianSeqLocked* GetOrCreateStatistician(uint32_t ssrc)
+      RTC_RUN_ON(&packet_sequence_);
+
+  Clock* const clock_;
+  RTC_NO_UNIQUE_ADDRESS SequenceChecker packet_sequence_;
+  int max_reordering_threshold_ RTC_GUARDED_BY(&packet_sequence_);
+  // The statisticians by ssrc, for the packet sequence to find them without
+  // taking `streams_lock_`.
+  flat_map<uint32_t, StreamStatisticianSeqLocked*> packet_statisticians_
+      RTC_GUARDED_BY(&packet_sequence_);
+
+  mutable Mutex streams_lock_;
+  flat_map<uint32_t /*ssrc*/, std::unique_ptr<StreamStatisticianSeqLocked>>
+      statisticians_ RTC_GUARDED_BY(streams_lock_);
+  // The index within `all_ssrcs_` that was last returned.
+  size_t last_returned_ssrc_idx_ RTC_GUARDED_BY(streams_lock_);
+  std::vector<uint32_t> all_ssrcs_ RTC_GUARDED_BY(streams_lock_);
+};
+
 }  // namespace webrtc
 #endif  // MODULES_RTP_RTCP_SOURCE_RECEIVE_STATISTICS_IMPL_H_
@@ -10,10 +10,13 @@
 
 #include "modules/rtp_rtcp/include/receive_statistics.h"
 
+#include <atomic>
 #include <memory>
 #include <vector>
 
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/random.h"
 #include "system_wrappers/include/clock.h"
 #include "test/gmock.h"
@@ -65,13 +68,26 @@ void IncrementSequenceNumber(RtpPacketReceived* packet) {
   IncrementSequenceNumber(packet, 1);
 }
 
-class ReceiveStatisticsTest : public ::testing::TestWithParam<bool> {
+enum class Variant { kWithMutex, kWithoutMutex, kSingleWriter };
+
+std::unique_ptr<ReceiveStatistics> CreateReceiveStatistics(Variant variant,
+                                                           Clock* clock) {
+  switch (variant) {
+    case Variant::kWithMutex:
+      return ReceiveStatistics::Create(clock);
+    case Variant::kWithoutMutex:
+      return ReceiveStatistics::CreateThreadCompatible(clock);
+    case Variant::kSingleWriter:
+      return ReceiveStatistics::CreateSingleWriter(clock);
+  }
+  RTC_CHECK_NOTREACHED();
+}
+
+class ReceiveStatisticsTest : public ::testing::TestWithParam<Variant> {
  public:
   ReceiveStatisticsTest()
       : clock_(0),
-        receive_statistics_(
-            GetParam() ? ReceiveStatistics::Create(&clock_)
-                       : ReceiveStatistics::CreateThreadCompatible(&clock_)) {
+        receive_statistics_(CreateReceiveStatistics(GetParam(), &clock_)) {
     packet1_ = CreateRtpPacket(kSsrc1, kPacketSize1);
     packet2_ = CreateRtpPacket(kSsrc2, kPacketSize2);
   }
@@ -85,9 +101,19 @@ class ReceiveStatisticsTest : public ::testing::TestWithParam<bool> {
 
 INSTANTIATE_TEST_SUITE_P(All,
                          ReceiveStatisticsTest,
-                         ::testing::Bool(),
-                         [](::testing::TestParamInfo<bool> info) {
-                           return info.param ? "WithMutex" : "WithoutMutex";
+                         ::testing::Values(Variant::kWithMutex,
+                                           Variant::kWithoutMutex,
+                                           Variant::kSingleWriter),
+                         [](::testing::TestParamInfo<Variant> info) {
+                           switch (info.param) {
+                             case Variant::kWithMutex:
+                               return "WithMutex";
+                             case Variant::kWithoutMutex:
+                               return "WithoutMutex";
+                             case Variant::kSingleWriter:
+                               return "SingleWriter";
+                           }
+                           RTC_CHECK_NOTREACHED();
                          });
 
 TEST_P(ReceiveStatisticsTest, TwoIncomingSsrcs) {
@@ -578,5 +604,56 @@ TEST_P(ReceiveStatisticsTest, LastPacketReceivedTimestamp) {
   EXPECT_EQ(45, counters.last_packet_received_timestamp_ms);
 }
 
+
+TEST(ReceiveStatisticsSingleWriterTest, ReportsWhilePacketsAreReceived) {
+  SimulatedClock clock(0);
+  std::unique_ptr<ReceiveStatistics> receive_statistics =
+      ReceiveStatistics::CreateSingleWriter(&clock);
+  RtpPacketReceived packet = CreateRtpPacket(kSsrc1, kPacketSize1);
+  const uint32_t first_seq_num = packet.SequenceNumber();
+  receive_statistics->OnRtpPacket(packet);
+  StreamStatistician* statistician =
+      receive_statistics->GetStatistician(kSsrc1);
+  ASSERT_TRUE(statistician);
+
+  // Reports and stats are read on another thread while the packets come in.
+  std::atomic<bool> done(false);
+  std::atomic<int> reports(0);
+  rtc::PlatformThread reporter = rtc::PlatformThread::SpawnJoinable(
+      [&] {
+        uint32_t last_seq_num = 0;
+        while (!done.load()) {
+          for (const rtcp::ReportBlock& block :
+               receive_statistics->RtcpReportBlocks(1)) {
+            EXPECT_GE(block.extended_high_seq_num(), last_seq_num);
+            EXPECT_EQ(block.cumulative_lost_signed(), 0);
+            last_seq_num = block.extended_high_seq_num();
+            ++reports;
+          }
+          RtpReceiveStats stats = statistician->GetStats();
+          EXPECT_EQ(stats.packets_lost, 0);
+        }
+      },
+      "reporter");
+
+  constexpr int kNumPackets = 20000;
+  for (int i = 1; i < kNumPackets; ++i) {
+    clock.AdvanceTimeMilliseconds(1);
+    IncrementSequenceNumber(&packet);
+    receive_statistics->OnRtpPacket(packet);
+  }
+  done = true;
+  reporter.Finalize();
+
+  EXPECT_GT(reports.load(), 0);
+  std::vector<rtcp::ReportBlock> report_blocks =
+      receive_statistics->RtcpReportBlocks(1);
+  ASSERT_THAT(report_blocks, SizeIs(1));
+  EXPECT_EQ(report_blocks[0].extended_high_seq_num(),
+            first_seq_num + kNumPackets - 1);
+  EXPECT_EQ(statistician->GetStats().packet_counter.packets,
+            size_t{kNumPackets});
+}
+
 }  // namespace
 }  // namespace webrtc
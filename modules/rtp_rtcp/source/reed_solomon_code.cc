@@ -0,0 +1,159 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/reed_solomon_code.h"
+
+#include <string.h>
+
+#include <utility>
+
+#include "modules/rtp_rtcp/source/gf256.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+using internal::Gf256Inv;
+using internal::Gf256Mul;
+using internal::Gf256MulAdd;
+
+// Inverts the `size` x `size` matrix `matrix`, stored by rows, in place by
+// Gauss-Jordan elimination. Returns false if it is singular.
+bool InvertMatrix(size_t size, std::vector<uint8_t>* matrix) {
+  std::vector<uint8_t> inverse(size * size, 0);
+  for (size_t i = 0; i < size; ++i) {
+    inverse[i * size + i] = 1;
+  }
+  uint8_t* m = matrix->data();
+  for (size_t column = 0; column < size; ++column) {
+    size_t pivot = column;
+    while (pivot < size && m[pivot * size + column] == 0) {
+      ++pivot;
+    }
+    if (pivot == size) {
+      return false;
+    }
+    if (pivot != column) {
+      for (size_t k = 0; k < size; ++k) {
+        std::swap(m[pivot * size + k], m[column * size + k]);
+        std::swap(inverse[pivot * size + k], inverse[column * size + k]);
+      }
+    }
+    const uint8_t scale = Gf256Inv(m[column * size + column]);
+    for (size_t k = 0; k < size; ++k) {
+      m[column * size + k] = Gf256Mul(m[column * size + k], scale);
+      inverse[column * size + k] = Gf256Mul(inverse[column * size + k], scale);
+    }
+    for (size_t row = 0; row < size; ++row) {
+      const uint8_t factor = m[row * size + column];
+      if (row == column || factor == 0) {
+        continue;
+      }
+      Gf256MulAdd(factor, &m[column * size], size, &m[row * size]);
+      Gf256MulAdd(factor, &inverse[column * size], size, &inverse[row * size]);
+    }
+  }
+  *matrix = std::move(inverse);
+  return true;
+}
+
+}  // namespace
+
+uint8_t ReedSolomonCode::Coefficient(size_t parity_index, size_t data_index) {
+  RTC_DCHECK_LT(parity_index, kMaxParityBlocks);
+  RTC_DCHECK_LT(data_index, kMaxDataBlocks);
+  // x_j = kMaxDataBlocks + j and y_i = i are all different, so their sum is
+  // never 0.
+  return Gf256Inv(static_cast<uint8_t>((kMaxDataBlocks + parity_index) ^
+                                       data_index));
+}
+
+void ReedSolomonCode::Encode(
+    rtc::ArrayView<const rtc::ArrayView<const uint8_t>> data,
+    size_t parity_index,
+    rtc::ArrayView<uint8_t> parity) {
+  RTC_DCHECK_LE(data.size(), kMaxDataBlocks);
+  memset(parity.data(), 0, parity.size());
+  for (size_t i = 0; i < data.size(); ++i) {
+    RTC_DCHECK_LE(data[i].size(), parity.size());
+    Gf256MulAdd(Coefficient(parity_index, i), data[i].data(), data[i].size(),
+                parity.data());
+  }
+}
+
+bool ReedSolomonCode::Recover(
+    rtc::ArrayView<const rtc::ArrayView<const uint8_t>> data,
+    rtc::ArrayView<const ParityBlock> parity,
+    std::vector<rtc::Buffer>* recovered) {
+  recovered->clear();
+  if (data.size() > kMaxDataBlocks) {
+    return false;
+  }
+  std::vector<size_t> missing;
+  for (size_t i = 0; i < data.size(); ++i) {
+    if (data[i].empty()) {
+      missing.push_back(i);
+    }
+  }
+  if (missing.empty()) {
+    return true;
+  }
+  if (parity.size() < missing.size()) {
+    return false;
+  }
+  const size_t num_missing = missing.size();
+  const size_t length = parity[0].data.size();
+  for (size_t r = 0; r < num_missing; ++r) {
+    if (parity[r].index >= kMaxParityBlocks ||
+        parity[r].data.size() != length) {
+      return false;
+    }
+  }
+  for (const auto& block : data) {
+    if (block.size() > length) {
+      return false;
+    }
+  }
+
+  // Subtract the received data blocks from the parity blocks, which leaves
+  // the contributions of the missing blocks, and solve for those.
+  std::vector<rtc::Buffer> syndromes;
+  syndromes.reserve(num_missing);
+  std::vector<uint8_t> matrix(num_missing * num_missing);
+  for (size_t r = 0; r < num_missing; ++r) {
+    syndromes.emplace_back(parity[r].data.data(), length);
+    for (size_t i = 0; i < data.size(); ++i) {
+      Gf256MulAdd(Coefficient(parity[r].index, i), data[i].data(),
+                  data[i].size(), syndromes[r].data());
+    }
+    for (size_t c = 0; c < num_missing; ++c) {
+      matrix[r * num_missing + c] = Coefficient(parity[r].index, missing[c]);
+    }
+  }
+  if (!InvertMatrix(num_missing, &matrix)) {
+    // Only if the same parity block was passed twice.
+    return false;
+  }
+
+  recovered->resize(num_missing);
+  for (size_t c = 0; c < num_missing; ++c) {
+    rtc::Buffer& block = (*recovered)[c];
+    block.SetSize(length);
+    memset(block.data(), 0, length);
+    for (size_t r = 0; r < num_missing; ++r) {
+      Gf256MulAdd(matrix[c * num_missing + r], syndromes[r].data(), length,
+                  block.data());
+    }
+  }
+  return true;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,66 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_CODE_H_
+#define MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_CODE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/array_view.h"
+#include "rtc_base/buffer.h"
+
+namespace webrtc {
+
+// Systematic Reed-Solomon erasure code over GF(2^8), built from a Cauchy
+// matrix: parity block j of the data blocks d_i is the sum of C(j, i) * d_i,
+// with C(j, i) = 1 / (x_j + y_i). Every square submatrix of a Cauchy matrix
+// is invertible, so the data blocks can be recovered from any combination of
+// data and parity blocks that is as large as the number of data blocks.
+// Unlike the XOR codes of ForwardErrorCorrection, this recovers any burst of
+// up to as many lost packets as there are parity packets.
+//
+// Blocks may have different lengths; shorter blocks are treated as if they
+// were padded with zeros to the length of the parity blocks.
+class ReedSolomonCode {
+ public:
+  static constexpr size_t kMaxDataBlocks = 128;
+  static constexpr size_t kMaxParityBlocks = 128;
+
+  struct ParityBlock {
+    size_t index;
+    rtc::ArrayView<const uint8_t> data;
+  };
+
+  // Returns C(`parity_index`, `data_index`).
+  static uint8_t Coefficient(size_t parity_index, size_t data_index);
+
+  // Computes parity block `parity_index` of `data` into `parity`, which must
+  // be at least as long as the longest data block.
+  static void Encode(rtc::ArrayView<const rtc::ArrayView<const uint8_t>> data,
+                     size_t parity_index,
+                     rtc::ArrayView<uint8_t> parity);
+
+  // `data` has an entry for every data block, that is empty for the missing
+  // blocks. `parity` holds received parity blocks, which all have the same
+  // length. Writes the missing data blocks, zero padded to that length, to
+  // `recovered` in the order of their indices. Returns false if there are
+  // fewer parity blocks than missing data blocks, or the blocks don't fit
+  // together.
+  static bool Recover(rtc::ArrayView<const rtc::ArrayView<const uint8_t>> data,
+                      rtc::ArrayView<const ParityBlock> parity,
+                      std::vector<rtc::Buffer>* recovered);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_CODE_H_
@@ -0,0 +1,132 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/reed_solomon_code.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAreArray;
+
+class ReedSolomonCodeTest : public ::testing::Test {
+ protected:
+  // Creates `num_data` blocks of random lengths, and `num_parity` parity
+  // blocks of them.
+  void Encode(size_t num_data, size_t num_parity) {
+    data_.clear();
+    parity_.clear();
+    size_t max_length = 0;
+    for (size_t i = 0; i < num_data; ++i) {
+      data_.emplace_back(random_.Rand(1, 300));
+      for (uint8_t& byte : data_.back()) {
+        byte = random_.Rand<uint8_t>();
+      }
+      max_length = std::max(max_length, data_.back().size());
+    }
+    std::vector<rtc::ArrayView<const uint8_t>> data(data_.begin(),
+                                                    data_.end());
+    for (size_t j = 0; j < num_parity; ++j) {
+      parity_.emplace_back(max_length);
+      ReedSolomonCode::Encode(data, j, parity_.back());
+    }
+  }
+
+  // Drops the data blocks in `lost`, and recovers them with the parity
+  // blocks in `parity_indices`.
+  bool Recover(const std::vector<size_t>& lost,
+               const std::vector<size_t>& parity_indices) {
+    std::vector<rtc::ArrayView<const uint8_t>> data(data_.begin(),
+                                                    data_.end());
+    for (size_t i : lost) {
+      data[i] = {};
+    }
+    std::vector<ReedSolomonCode::ParityBlock> parity;
+    for (size_t j : parity_indices) {
+      parity.push_back({j, parity_[j]});
+    }
+    std::vector<rtc::Buffer> recovered;
+    if (!ReedSolomonCode::Recover(data, parity, &recovered)) {
+      return false;
+    }
+    EXPECT_EQ(recovered.size(), lost.size());
+    for (size_t n = 0; n < lost.size(); ++n) {
+      const std::vector<uint8_t>& original = data_[lost[n]];
+      EXPECT_THAT(rtc::MakeArrayView(recovered[n].data(), original.size()),
+                  ElementsAreArray(original));
+      for (size_t k = original.size(); k < recovered[n].size(); ++k) {
+        EXPECT_EQ(recovered[n][k], 0);
+      }
+    }
+    return true;
+  }
+
+  Random random_{0x5eed};
+  std::vector<std::vector<uint8_t>> data_;
+  std::vector<std::vector<uint8_t>> parity_;
+};
+
+TEST_F(ReedSolomonCodeTest, RecoversNothingWithoutLosses) {
+  Encode(5, 2);
+  EXPECT_TRUE(Recover({}, {}));
+}
+
+TEST_F(ReedSolomonCodeTest, RecoversBurstWithAnyParityBlocks) {
+  Encode(20, 6);
+  EXPECT_TRUE(Recover({7, 8, 9, 10, 11, 12}, {0, 1, 2, 3, 4, 5}));
+  EXPECT_TRUE(Recover({0, 1, 2}, {5, 1, 3}));
+  EXPECT_TRUE(Recover({19}, {4}));
+  EXPECT_TRUE(Recover({2, 18}, {0, 1, 2, 3}));
+}
+
+TEST_F(ReedSolomonCodeTest, RecoversAllDataFromParity) {
+  Encode(4, 4);
+  EXPECT_TRUE(Recover({0, 1, 2, 3}, {0, 1, 2, 3}));
+}
+
+TEST_F(ReedSolomonCodeTest, RecoversEveryPairOfLosses) {
+  Encode(12, 2);
+  for (size_t a = 0; a < 12; ++a) {
+    for (size_t b = a + 1; b < 12; ++b) {
+      EXPECT_TRUE(Recover({a, b}, {0, 1}));
+    }
+  }
+}
+
+TEST_F(ReedSolomonCodeTest, RecoversLargestBlock) {
+  Encode(ReedSolomonCode::kMaxDataBlocks, 16);
+  std::vector<size_t> lost;
+  std::vector<size_t> parity;
+  for (size_t i = 0; i < 16; ++i) {
+    lost.push_back(ReedSolomonCode::kMaxDataBlocks - 1 - 3 * i);
+    parity.push_back(i);
+  }
+  std::reverse(lost.begin(), lost.end());
+  EXPECT_TRUE(Recover(lost, parity));
+}
+
+TEST_F(ReedSolomonCodeTest, FailsWithMoreLossesThanParity) {
+  Encode(10, 2);
+  EXPECT_FALSE(Recover({1, 2, 3}, {0, 1}));
+}
+
+TEST_F(ReedSolomonCodeTest, FailsWithDuplicateParity) {
+  Encode(10, 2);
+  EXPECT_FALSE(Recover({1, 2}, {1, 1}));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,81 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/reed_solomon_fec_format.h"
+
+#include <string.h>
+
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/reed_solomon_code.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace reed_solomon_fec {
+
+void WriteHeader(const Header& header, uint8_t* payload) {
+  ByteWriter<uint32_t>::WriteBigEndian(&payload[0], header.protected_ssrc);
+  ByteWriter<uint16_t>::WriteBigEndian(&payload[4], header.base_seq_num);
+  payload[6] = header.num_media_packets;
+  payload[7] = header.parity_index;
+}
+
+bool ParseHeader(rtc::ArrayView<const uint8_t> payload, Header* header) {
+  if (payload.size() < kHeaderSize + kRecoveryHeaderSize) {
+    return false;
+  }
+  header->protected_ssrc = ByteReader<uint32_t>::ReadBigEndian(&payload[0]);
+  header->base_seq_num = ByteReader<uint16_t>::ReadBigEndian(&payload[4]);
+  header->num_media_packets = payload[6];
+  header->parity_index = payload[7];
+  return header->num_media_packets > 0 &&
+         header->num_media_packets <= ReedSolomonCode::kMaxDataBlocks &&
+         header->parity_index < ReedSolomonCode::kMaxParityBlocks;
+}
+
+size_t RecoveryBlockSize(size_t rtp_packet_size) {
+  RTC_DCHECK_GE(rtp_packet_size, kRtpHeaderSize);
+  return kRecoveryHeaderSize + rtp_packet_size - kRtpHeaderSize;
+}
+
+void WriteRecoveryBlock(rtc::ArrayView<const uint8_t> rtp_packet,
+                        uint8_t* block) {
+  RTC_DCHECK_GE(rtp_packet.size(), kRtpHeaderSize);
+  const size_t payload_length = rtp_packet.size() - kRtpHeaderSize;
+  memcpy(&block[0], &rtp_packet[0], 2);
+  ByteWriter<uint16_t>::WriteBigEndian(&block[2], payload_length);
+  memcpy(&block[4], &rtp_packet[4], 4);
+  memcpy(&block[kRecoveryHeaderSize], &rtp_packet[kRtpHeaderSize],
+         payload_length);
+}
+
+bool RecoveryBlockToRtpPacket(rtc::ArrayView<const uint8_t> block,
+                              uint16_t seq_num,
+                              uint32_t ssrc,
+                              rtc::CopyOnWriteBuffer* rtp_packet) {
+  if (block.size() < kRecoveryHeaderSize || (block[0] >> 6) != 2) {
+    return false;
+  }
+  const size_t payload_length = ByteReader<uint16_t>::ReadBigEndian(&block[2]);
+  if (kRecoveryHeaderSize + payload_length > block.size()) {
+    return false;
+  }
+  rtp_packet->SetSize(kRtpHeaderSize + payload_length);
+  uint8_t* data = rtp_packet->MutableData();
+  memcpy(&data[0], &block[0], 2);
+  ByteWriter<uint16_t>::WriteBigEndian(&data[2], seq_num);
+  memcpy(&data[4], &block[4], 4);
+  ByteWriter<uint32_t>::WriteBigEndian(&data[8], ssrc);
+  memcpy(&data[kRtpHeaderSize], &block[kRecoveryHeaderSize], payload_length);
+  return true;
+}
+
+}  // namespace reed_solomon_fec
+}  // namespace webrtc
@@ -0,0 +1,76 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_FORMAT_H_
+#define MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_FORMAT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "api/array_view.h"
+#include "rtc_base/copy_on_write_buffer.h"
+
+namespace webrtc {
+namespace reed_solomon_fec {
+
+// Reed-Solomon FEC packets are sent on their own SSRC, like FlexFEC, and
+// protect a block of consecutive media packets of one SSRC. Their payload is
+//
+//   0                   1                   2                   3
+//   0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+//  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//  |                         protected SSRC                        |
+//  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//  |      base sequence number     | media packets | parity index  |
+//  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//  |                    parity of the recovery blocks              |
+//  :                                                               :
+//
+// followed by parity block `parity index` of ReedSolomonCode over the
+// recovery blocks of the media packets with sequence numbers `base sequence
+// number` and up. The recovery block of a media packet is the 8 bytes
+//
+//  |V=2|P|X|  CC   |M|     PT      |        payload length         |
+//  |                           timestamp                           |
+//
+// followed by everything after its fixed RTP header, so all of the packet
+// except the sequence number and the SSRC, which the receiver knows.
+constexpr size_t kHeaderSize = 8;
+constexpr size_t kRecoveryHeaderSize = 8;
+// Larger blocks recover longer bursts, but delay recovery.
+constexpr size_t kMaxMediaPackets = 48;
+
+struct Header {
+  uint32_t protected_ssrc = 0;
+  uint16_t base_seq_num = 0;
+  uint8_t num_media_packets = 0;
+  uint8_t parity_index = 0;
+};
+
+void WriteHeader(const Header& header, uint8_t* payload);
+// Returns false if `payload` is too short or the header is invalid.
+bool ParseHeader(rtc::ArrayView<const uint8_t> payload, Header* header);
+
+size_t RecoveryBlockSize(size_t rtp_packet_size);
+// Writes the RecoveryBlockSize() bytes of the recovery block of
+// `rtp_packet`, which must be at least one fixed RTP header long.
+void WriteRecoveryBlock(rtc::ArrayView<const uint8_t> rtp_packet,
+                        uint8_t* block);
+// Rebuilds the RTP packet from a recovered, possibly zero padded, block.
+// Returns false if the block is malformed.
+bool RecoveryBlockToRtpPacket(rtc::ArrayView<const uint8_t> block,
+                              uint16_t seq_num,
+                              uint32_t ssrc,
+                              rtc::CopyOnWriteBuffer* rtp_packet);
+
+}  // namespace reed_solomon_fec
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_FORMAT_H_
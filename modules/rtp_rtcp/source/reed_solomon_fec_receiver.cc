@@ -0,0 +1,211 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/include/reed_solomon_fec_receiver.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "modules/rtp_rtcp/source/reed_solomon_code.h"
+#include "modules/rtp_rtcp/source/reed_solomon_fec_format.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+namespace {
+
+// Media packets are kept for a few blocks, so that FEC packets that arrive
+// late or out of order can still use them.
+constexpr int64_t kMaxStoredPackets = 4 * reed_solomon_fec::kMaxMediaPackets;
+
+}  // namespace
+
+ReedSolomonFecReceiver::ReedSolomonFecReceiver(
+    Clock* clock,
+    uint32_t ssrc,
+    uint32_t protected_media_ssrc,
+    RecoveredPacketReceiver* recovered_packet_receiver)
+    : ssrc_(ssrc),
+      protected_media_ssrc_(protected_media_ssrc),
+      recovered_packet_receiver_(recovered_packet_receiver),
+      clock_(clock) {
+  RTC_DCHECK(recovered_packet_receiver_);
+}
+
+ReedSolomonFecReceiver::~ReedSolomonFecReceiver() = default;
+
+void ReedSolomonFecReceiver::OnRtpPacket(const RtpPacketReceived& packet) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  if (packet.Ssrc() != ssrc_ && packet.Ssrc() != protected_media_ssrc_) {
+    return;
+  }
+  if (packet.recovered()) {
+    // Already stored by MaybeRecover().
+    return;
+  }
+  if (packet_counter_.first_packet_time_ms == -1) {
+    packet_counter_.first_packet_time_ms = clock_->TimeInMilliseconds();
+  }
+  ++packet_counter_.num_packets;
+  packet_counter_.num_bytes += packet.size();
+
+  std::vector<rtc::CopyOnWriteBuffer> recovered;
+  if (packet.Ssrc() == ssrc_) {
+    ++packet_counter_.num_fec_packets;
+    AddFecPacket(packet, &recovered);
+  } else {
+    AddMediaPacket(packet, &recovered);
+  }
+  // The callback may come back with the packet, so deliver it last.
+  for (const rtc::CopyOnWriteBuffer& recovered_packet : recovered) {
+    ++packet_counter_.num_recovered_packets;
+    recovered_packet_receiver_->OnRecoveredPacket(recovered_packet.cdata(),
+                                                  recovered_packet.size());
+  }
+}
+
+FecPacketCounter ReedSolomonFecReceiver::GetPacketCounter() const {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  return packet_counter_;
+}
+
+void ReedSolomonFecReceiver::AddMediaPacket(
+    const RtpPacketReceived& packet,
+    std::vector<rtc::CopyOnWriteBuffer>* recovered) {
+  const int64_t seq_num = seq_num_unwrapper_.Unwrap(packet.SequenceNumber());
+  if (IsTooOld(seq_num) || media_blocks_.count(seq_num) > 0) {
+    return;
+  }
+  rtc::Buffer block(reed_solomon_fec::RecoveryBlockSize(packet.size()));
+  reed_solomon_fec::WriteRecoveryBlock(packet, block.data());
+  media_blocks_.emplace(seq_num, std::move(block));
+  Prune(seq_num);
+
+  // The packet may complete what a block needs for recovery.
+  auto it = fec_blocks_.upper_bound(seq_num);
+  if (it != fec_blocks_.begin()) {
+    --it;
+    if (seq_num < it->first + static_cast<int64_t>(
+                                  it->second.num_media_packets)) {
+      MaybeRecover(it->first, &it->second, recovered);
+    }
+  }
+}
+
+void ReedSolomonFecReceiver::AddFecPacket(
+    const RtpPacketReceived& packet,
+    std::vector<rtc::CopyOnWriteBuffer>* recovered) {
+  reed_solomon_fec::Header header;
+  rtc::ArrayView<const uint8_t> payload = packet.payload();
+  if (!reed_solomon_fec::ParseHeader(payload, &header) ||
+      header.protected_ssrc != protected_media_ssrc_) {
+    RTC_LOG(LS_WARNING) << "Dropping invalid Reed-Solomon FEC packet.";
+    return;
+  }
+  const int64_t base_seq_num = seq_num_unwrapper_.Unwrap(header.base_seq_num);
+  if (IsTooOld(base_seq_num)) {
+    return;
+  }
+  FecBlock& block = fec_blocks_[base_seq_num];
+  if (block.num_media_packets == 0) {
+    block.num_media_packets = header.num_media_packets;
+  } else if (block.num_media_packets != header.num_media_packets) {
+    return;
+  }
+  if (block.complete || block.parity.count(header.parity_index) > 0) {
+    return;
+  }
+  block.parity.emplace(
+      header.parity_index,
+      rtc::Buffer(payload.data() + reed_solomon_fec::kHeaderSize,
+                  payload.size() - reed_solomon_fec::kHeaderSize));
+  Prune(base_seq_num);
+  MaybeRecover(base_seq_num, &block, recovered);
+}
+
+void ReedSolomonFecReceiver::MaybeRecover(
+    int64_t base_seq_num,
+    FecBlock* block,
+    std::vector<rtc::CopyOnWriteBuffer>* recovered) {
+  if (block->complete) {
+    return;
+  }
+  std::vector<rtc::ArrayView<const uint8_t>> data(block->num_media_packets);
+  size_t num_missing = 0;
+  for (size_t i = 0; i < block->num_media_packets; ++i) {
+    auto it = media_blocks_.find(base_seq_num + i);
+    if (it == media_blocks_.end()) {
+      ++num_missing;
+    } else {
+      data[i] = it->second;
+    }
+  }
+  if (num_missing == 0) {
+    block->complete = true;
+    block->parity.clear();
+    return;
+  }
+  if (block->parity.size() < num_missing) {
+    return;
+  }
+
+  std::vector<ReedSolomonCode::ParityBlock> parity;
+  for (const auto& entry : block->parity) {
+    parity.push_back({entry.first, entry.second});
+  }
+  std::vector<rtc::Buffer> recovered_blocks;
+  const bool success =
+      ReedSolomonCode::Recover(data, parity, &recovered_blocks);
+  block->complete = true;
+  block->parity.clear();
+  if (!success) {
+    RTC_LOG(LS_WARNING) << "Failed to recover packets from Reed-Solomon FEC.";
+    return;
+  }
+  size_t next_recovered = 0;
+  for (size_t i = 0; i < block->num_media_packets; ++i) {
+    if (!data[i].empty()) {
+      continue;
+    }
+    rtc::Buffer& recovered_block = recovered_blocks[next_recovered++];
+    const int64_t seq_num = base_seq_num + i;
+    rtc::CopyOnWriteBuffer packet;
+    if (!reed_solomon_fec::RecoveryBlockToRtpPacket(
+            recovered_block, static_cast<uint16_t>(seq_num),
+            protected_media_ssrc_, &packet)) {
+      RTC_LOG(LS_WARNING) << "Recovered a malformed packet.";
+      continue;
+    }
+    recovered_block.SetSize(
+        reed_solomon_fec::RecoveryBlockSize(packet.size()));
+    media_blocks_.emplace(seq_num, std::move(recovered_block));
+    recovered->push_back(std::move(packet));
+  }
+}
+
+bool ReedSolomonFecReceiver::IsTooOld(int64_t seq_num) const {
+  return newest_seq_num_ && seq_num <= *newest_seq_num_ - kMaxStoredPackets;
+}
+
+void ReedSolomonFecReceiver::Prune(int64_t newest_seq_num) {
+  if (newest_seq_num_ && newest_seq_num <= *newest_seq_num_) {
+    return;
+  }
+  newest_seq_num_ = newest_seq_num;
+  const int64_t oldest_seq_num = newest_seq_num - kMaxStoredPackets;
+  media_blocks_.erase(media_blocks_.begin(),
+                      media_blocks_.lower_bound(oldest_seq_num + 1));
+  fec_blocks_.erase(fec_blocks_.begin(),
+                    fec_blocks_.lower_bound(oldest_seq_num + 1));
+}
+
+}  // namespace webrtc
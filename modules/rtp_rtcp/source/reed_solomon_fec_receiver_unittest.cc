@@ -0,0 +1,197 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/include/reed_solomon_fec_receiver.h"
+
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "api/rtp_parameters.h"
+#include "modules/rtp_rtcp/include/reed_solomon_fec_sender.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/random.h"
+#include "system_wrappers/include/clock.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::IsEmpty;
+
+constexpr int kFecPayloadType = 124;
+constexpr int kMediaPayloadType = 96;
+constexpr uint32_t kMediaSsrc = 8353;
+constexpr uint32_t kFecSsrc = 42984;
+constexpr uint16_t kFirstSeqNum = 65530;
+
+class RecoveredPackets : public RecoveredPacketReceiver {
+ public:
+  void OnRecoveredPacket(const uint8_t* packet, size_t length) override {
+    RtpPacketReceived parsed;
+    ASSERT_TRUE(parsed.Parse(packet, length));
+    packets.emplace(parsed.SequenceNumber(), parsed.Buffer());
+  }
+
+  std::map<uint16_t, rtc::CopyOnWriteBuffer> packets;
+};
+
+class ReedSolomonFecReceiverTest : public ::testing::Test {
+ protected:
+  ReedSolomonFecReceiverTest()
+      : clock_(1),
+        sender_(kFecPayloadType,
+                kFecSsrc,
+                kMediaSsrc,
+                /*mid=*/"",
+                /*rtp_header_extensions=*/{},
+                /*extension_sizes=*/{},
+                /*rtp_state=*/nullptr,
+                &clock_),
+        receiver_(&clock_, kFecSsrc, kMediaSsrc, &recovered_) {}
+
+  // Sends a frame of `num_packets` media packets of random sizes, and
+  // returns them followed by their FEC packets.
+  void SendFrame(size_t num_packets, int fec_rate) {
+    FecProtectionParams params;
+    params.fec_rate = fec_rate;
+    params.max_fec_frames = 1;
+    sender_.SetProtectionParameters(params, params);
+    for (size_t i = 0; i < num_packets; ++i) {
+      RtpPacketToSend packet(nullptr);
+      packet.SetPayloadType(kMediaPayloadType);
+      packet.SetSequenceNumber(seq_num_++);
+      packet.SetTimestamp(timestamp_);
+      packet.SetSsrc(kMediaSsrc);
+      packet.SetMarker(i == num_packets - 1);
+      uint8_t* payload = packet.AllocatePayload(random_.Rand(100, 1100));
+      for (size_t k = 0; k < packet.payload_size(); ++k) {
+        payload[k] = random_.Rand<uint8_t>();
+      }
+      sender_.AddPacketAndGenerateFec(packet);
+      media_packets_.push_back(packet.Buffer());
+    }
+    for (const auto& fec_packet : sender_.GetFecPackets()) {
+      fec_packets_.push_back(fec_packet->Buffer());
+    }
+    timestamp_ += 3000;
+  }
+
+  void Receive(const rtc::CopyOnWriteBuffer& buffer) {
+    RtpPacketReceived packet;
+    ASSERT_TRUE(packet.Parse(buffer));
+    receiver_.OnRtpPacket(packet);
+  }
+
+  // Receives all media packets, except those at the indices in `lost`.
+  void ReceiveMedia(const std::set<size_t>& lost) {
+    for (size_t i = 0; i < media_packets_.size(); ++i) {
+      if (lost.count(i) == 0) {
+        Receive(media_packets_[i]);
+      }
+    }
+  }
+
+  void ReceiveFec() {
+    for (const rtc::CopyOnWriteBuffer& fec_packet : fec_packets_) {
+      Receive(fec_packet);
+    }
+  }
+
+  void ExpectRecovered(const std::set<size_t>& lost) {
+    ASSERT_EQ(recovered_.packets.size(), lost.size());
+    for (size_t i : lost) {
+      const uint16_t seq_num = kFirstSeqNum + i;
+      ASSERT_EQ(recovered_.packets.count(seq_num), 1u) << seq_num;
+      EXPECT_EQ(recovered_.packets[seq_num], media_packets_[i]);
+    }
+  }
+
+  SimulatedClock clock_;
+  Random random_{0xfec};
+  ReedSolomonFecSender sender_;
+  RecoveredPackets recovered_;
+  ReedSolomonFecReceiver receiver_;
+  uint16_t seq_num_ = kFirstSeqNum;
+  uint32_t timestamp_ = 1000;
+  std::vector<rtc::CopyOnWriteBuffer> media_packets_;
+  std::vector<rtc::CopyOnWriteBuffer> fec_packets_;
+};
+
+TEST_F(ReedSolomonFecReceiverTest, RecoversNothingWithoutLosses) {
+  SendFrame(10, 102);
+  ReceiveMedia({});
+  ReceiveFec();
+  EXPECT_THAT(recovered_.packets, IsEmpty());
+  EXPECT_EQ(receiver_.GetPacketCounter().num_fec_packets, 4u);
+}
+
+TEST_F(ReedSolomonFecReceiverTest, RecoversBurstAsLongAsParity) {
+  // 4 FEC packets, across the sequence number wrap.
+  SendFrame(10, 102);
+  ASSERT_EQ(fec_packets_.size(), 4u);
+  const std::set<size_t> lost = {3, 4, 5, 6};
+  ReceiveMedia(lost);
+  ReceiveFec();
+  ExpectRecovered(lost);
+  EXPECT_EQ(receiver_.GetPacketCounter().num_recovered_packets, 4u);
+}
+
+TEST_F(ReedSolomonFecReceiverTest, RecoversWhenFecArrivesFirst) {
+  // With as many FEC packets as losses, recovery waits for the last media
+  // packet.
+  SendFrame(10, 51);
+  ASSERT_EQ(fec_packets_.size(), 2u);
+  const std::set<size_t> lost = {0, 9};
+  ReceiveFec();
+  ReceiveMedia(lost);
+  ExpectRecovered(lost);
+}
+
+TEST_F(ReedSolomonFecReceiverTest, RecoversWithLostFecPackets) {
+  SendFrame(10, 102);
+  const std::set<size_t> lost = {2, 7};
+  ReceiveMedia(lost);
+  Receive(fec_packets_[1]);
+  Receive(fec_packets_[3]);
+  ExpectRecovered(lost);
+}
+
+TEST_F(ReedSolomonFecReceiverTest, DoesNotRecoverLongerBursts) {
+  SendFrame(10, 102);
+  ReceiveMedia({1, 2, 3, 4, 5});
+  ReceiveFec();
+  EXPECT_THAT(recovered_.packets, IsEmpty());
+}
+
+TEST_F(ReedSolomonFecReceiverTest, RecoversEachFrame) {
+  SendFrame(8, 64);
+  SendFrame(12, 64);
+  ASSERT_EQ(fec_packets_.size(), 5u);
+  const std::set<size_t> lost = {1, 2, 8, 19};
+  ReceiveMedia(lost);
+  ReceiveFec();
+  ExpectRecovered(lost);
+}
+
+TEST_F(ReedSolomonFecReceiverTest, IgnoresUnknownSsrcs) {
+  RtpPacketToSend packet(nullptr);
+  packet.SetSsrc(kMediaSsrc + 1);
+  packet.AllocatePayload(100);
+  Receive(packet.Buffer());
+  EXPECT_EQ(receiver_.GetPacketCounter().num_packets, 0u);
+}
+
+}  // namespace
+}  // namespace webrtc
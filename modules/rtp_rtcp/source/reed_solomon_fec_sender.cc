@@ -0,0 +1,232 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/include/reed_solomon_fec_sender.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "modules/rtp_rtcp/source/forward_error_correction.h"
+#include "modules/rtp_rtcp/source/reed_solomon_code.h"
+#include "modules/rtp_rtcp/source/reed_solomon_fec_format.h"
+#include "modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+namespace {
+
+// Let first sequence number be in the first half of the interval.
+constexpr uint16_t kMaxInitRtpSeqNumber = 0x7fff;
+
+// 90 kHz RTP timestamps, as for the protected video.
+constexpr int kMsToRtpTimestamp = kVideoPayloadTypeFrequency / 1000;
+
+RtpHeaderExtensionMap RegisterSupportedExtensions(
+    const std::vector<RtpExtension>& rtp_header_extensions) {
+  RtpHeaderExtensionMap map;
+  for (const auto& extension : rtp_header_extensions) {
+    if (extension.uri == TransportSequenceNumber::Uri()) {
+      map.Register<TransportSequenceNumber>(extension.id);
+    } else if (extension.uri == AbsoluteSendTime::Uri()) {
+      map.Register<AbsoluteSendTime>(extension.id);
+    } else if (extension.uri == TransmissionOffset::Uri()) {
+      map.Register<TransmissionOffset>(extension.id);
+    } else if (extension.uri == RtpMid::Uri()) {
+      map.Register<RtpMid>(extension.id);
+    }
+  }
+  return map;
+}
+
+}  // namespace
+
+ReedSolomonFecSender::ReedSolomonFecSender(
+    int payload_type,
+    uint32_t ssrc,
+    uint32_t protected_media_ssrc,
+    const std::string& mid,
+    const std::vector<RtpExtension>& rtp_header_extensions,
+    rtc::ArrayView<const RtpExtensionSize> extension_sizes,
+    const RtpState* rtp_state,
+    Clock* clock)
+    : clock_(clock),
+      random_(clock_->TimeInMicroseconds()),
+      payload_type_(payload_type),
+      timestamp_offset_(rtp_state ? rtp_state->start_timestamp
+                                  : random_.Rand<uint32_t>()),
+      ssrc_(ssrc),
+      protected_media_ssrc_(protected_media_ssrc),
+      mid_(mid),
+      rtp_header_extension_map_(
+          RegisterSupportedExtensions(rtp_header_extensions)),
+      header_extensions_size_(
+          RtpHeaderExtensionSize(extension_sizes, rtp_header_extension_map_)),
+      seq_num_(rtp_state ? rtp_state->sequence_number
+                         : random_.Rand(1, kMaxInitRtpSeqNumber)),
+      fec_bitrate_(/*max_window_size_ms=*/1000, RateStatistics::kBpsScale) {
+  RTC_DCHECK_GE(payload_type, 0);
+  RTC_DCHECK_LE(payload_type, 127);
+  media_blocks_.reserve(reed_solomon_fec::kMaxMediaPackets);
+}
+
+ReedSolomonFecSender::~ReedSolomonFecSender() = default;
+
+void ReedSolomonFecSender::SetProtectionParameters(
+    const FecProtectionParams& delta_params,
+    const FecProtectionParams& key_params) {
+  RTC_DCHECK_GE(delta_params.fec_rate, 0);
+  RTC_DCHECK_LE(delta_params.fec_rate, 255);
+  RTC_DCHECK_GE(key_params.fec_rate, 0);
+  RTC_DCHECK_LE(key_params.fec_rate, 255);
+  MutexLock lock(&mutex_);
+  delta_params_ = delta_params;
+  key_params_ = key_params;
+}
+
+void ReedSolomonFecSender::AddPacketAndGenerateFec(
+    const RtpPacketToSend& packet) {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  RTC_DCHECK_EQ(packet.Ssrc(), protected_media_ssrc_);
+  if (!media_blocks_.empty() &&
+      packet.SequenceNumber() !=
+          static_cast<uint16_t>(base_seq_num_ + media_blocks_.size())) {
+    // The block must be consecutive packets.
+    GenerateFec();
+  }
+  if (media_blocks_.empty()) {
+    base_seq_num_ = packet.SequenceNumber();
+  }
+  rtc::Buffer block(reed_solomon_fec::RecoveryBlockSize(packet.size()));
+  reed_solomon_fec::WriteRecoveryBlock(packet, block.data());
+  media_blocks_.push_back(std::move(block));
+  if (packet.is_key_frame()) {
+    block_contains_keyframe_ = true;
+  }
+
+  int max_fec_frames;
+  {
+    MutexLock lock(&mutex_);
+    max_fec_frames = block_contains_keyframe_ ? key_params_.max_fec_frames
+                                              : delta_params_.max_fec_frames;
+  }
+  if (packet.Marker()) {
+    ++num_protected_frames_;
+  }
+  if ((packet.Marker() && num_protected_frames_ >= max_fec_frames) ||
+      media_blocks_.size() == reed_solomon_fec::kMaxMediaPackets) {
+    GenerateFec();
+  }
+}
+
+void ReedSolomonFecSender::GenerateFec() {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  int fec_rate;
+  {
+    MutexLock lock(&mutex_);
+    fec_rate = block_contains_keyframe_ ? key_params_.fec_rate
+                                        : delta_params_.fec_rate;
+  }
+  const size_t num_fec_packets =
+      ForwardErrorCorrection::NumFecPackets(media_blocks_.size(), fec_rate);
+  if (num_fec_packets == 0) {
+    ResetBlock();
+    return;
+  }
+
+  std::vector<rtc::ArrayView<const uint8_t>> data(media_blocks_.begin(),
+                                                  media_blocks_.end());
+  size_t parity_size = 0;
+  for (const rtc::Buffer& block : media_blocks_) {
+    parity_size = std::max(parity_size, block.size());
+  }
+  reed_solomon_fec::Header header;
+  header.protected_ssrc = protected_media_ssrc_;
+  header.base_seq_num = base_seq_num_;
+  header.num_media_packets = static_cast<uint8_t>(media_blocks_.size());
+  const int64_t now_ms = clock_->TimeInMilliseconds();
+  for (size_t i = 0; i < num_fec_packets; ++i) {
+    auto fec_packet =
+        std::make_unique<RtpPacketToSend>(&rtp_header_extension_map_);
+    fec_packet->set_packet_type(RtpPacketMediaType::kForwardErrorCorrection);
+    fec_packet->set_allow_retransmission(false);
+    fec_packet->SetMarker(false);
+    fec_packet->SetPayloadType(payload_type_);
+    fec_packet->SetSequenceNumber(seq_num_++);
+    fec_packet->SetTimestamp(timestamp_offset_ +
+                             static_cast<uint32_t>(kMsToRtpTimestamp * now_ms));
+    fec_packet->set_capture_time_ms(now_ms);
+    fec_packet->SetSsrc(ssrc_);
+    // Reserve extensions, if registered. These will be set by the RTPSender.
+    fec_packet->ReserveExtension<AbsoluteSendTime>();
+    fec_packet->ReserveExtension<TransmissionOffset>();
+    fec_packet->ReserveExtension<TransportSequenceNumber>();
+    if (!mid_.empty()) {
+      fec_packet->SetExtension<RtpMid>(mid_);
+    }
+
+    uint8_t* payload = fec_packet->AllocatePayload(
+        reed_solomon_fec::kHeaderSize + parity_size);
+    header.parity_index = static_cast<uint8_t>(i);
+    reed_solomon_fec::WriteHeader(header, payload);
+    ReedSolomonCode::Encode(
+        data, i,
+        rtc::MakeArrayView(payload + reed_solomon_fec::kHeaderSize,
+                           parity_size));
+    generated_fec_packets_.push_back(std::move(fec_packet));
+  }
+  ResetBlock();
+}
+
+void ReedSolomonFecSender::ResetBlock() {
+  media_blocks_.clear();
+  block_contains_keyframe_ = false;
+  num_protected_frames_ = 0;
+}
+
+std::vector<std::unique_ptr<RtpPacketToSend>>
+ReedSolomonFecSender::GetFecPackets() {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  size_t total_fec_data_bytes = 0;
+  for (const auto& fec_packet : generated_fec_packets_) {
+    total_fec_data_bytes += fec_packet->size();
+  }
+  {
+    MutexLock lock(&mutex_);
+    fec_bitrate_.Update(total_fec_data_bytes, clock_->TimeInMilliseconds());
+  }
+  std::vector<std::unique_ptr<RtpPacketToSend>> fec_packets;
+  fec_packets.swap(generated_fec_packets_);
+  return fec_packets;
+}
+
+size_t ReedSolomonFecSender::MaxPacketOverhead() const {
+  return header_extensions_size_ + reed_solomon_fec::kHeaderSize +
+         reed_solomon_fec::kRecoveryHeaderSize;
+}
+
+DataRate ReedSolomonFecSender::CurrentFecRate() const {
+  MutexLock lock(&mutex_);
+  return DataRate::BitsPerSec(
+      fec_bitrate_.Rate(clock_->TimeInMilliseconds()).value_or(0));
+}
+
+absl::optional<RtpState> ReedSolomonFecSender::GetRtpState() {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  RtpState rtp_state;
+  rtp_state.sequence_number = seq_num_;
+  rtp_state.start_timestamp = timestamp_offset_;
+  return rtp_state;
+}
+
+}  // namespace webrtc
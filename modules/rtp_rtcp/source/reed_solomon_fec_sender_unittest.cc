@@ -0,0 +1,161 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/include/reed_solomon_fec_sender.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/rtp_parameters.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/fec_test_helper.h"
+#include "modules/rtp_rtcp/source/forward_error_correction.h"
+#include "modules/rtp_rtcp/source/reed_solomon_fec_format.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "system_wrappers/include/clock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using test::fec::AugmentedPacket;
+using test::fec::AugmentedPacketGenerator;
+
+constexpr int kFecPayloadType = 124;
+constexpr uint32_t kMediaSsrc = 1234;
+constexpr uint32_t kFecSsrc = 5678;
+const char kNoMid[] = "";
+const std::vector<RtpExtension> kNoRtpHeaderExtensions;
+const std::vector<RtpExtensionSize> kNoRtpHeaderExtensionSizes;
+constexpr size_t kPayloadLength = 50;
+
+class ReedSolomonFecSenderTest : public ::testing::Test {
+ protected:
+  ReedSolomonFecSenderTest()
+      : clock_(1),
+        sender_(kFecPayloadType,
+                kFecSsrc,
+                kMediaSsrc,
+                kNoMid,
+                kNoRtpHeaderExtensions,
+                kNoRtpHeaderExtensionSizes,
+                /*rtp_state=*/nullptr,
+                &clock_),
+        packet_generator_(kMediaSsrc) {}
+
+  void SetFecRate(int fec_rate, int max_fec_frames) {
+    FecProtectionParams params;
+    params.fec_rate = fec_rate;
+    params.max_fec_frames = max_fec_frames;
+    sender_.SetProtectionParameters(params, params);
+  }
+
+  void AddFrame(size_t num_packets) {
+    packet_generator_.NewFrame(num_packets);
+    for (size_t i = 0; i < num_packets; ++i) {
+      std::unique_ptr<AugmentedPacket> packet =
+          packet_generator_.NextPacket(i, kPayloadLength + i);
+      RtpPacketToSend rtp_packet(nullptr);
+      ASSERT_TRUE(rtp_packet.Parse(packet->data));
+      sender_.AddPacketAndGenerateFec(rtp_packet);
+    }
+  }
+
+  SimulatedClock clock_;
+  ReedSolomonFecSender sender_;
+  AugmentedPacketGenerator packet_generator_;
+};
+
+TEST_F(ReedSolomonFecSenderTest, Ssrc) {
+  EXPECT_EQ(sender_.FecSsrc(), kFecSsrc);
+  EXPECT_EQ(sender_.GetFecType(), VideoFecGenerator::FecType::kReedSolomon);
+}
+
+TEST_F(ReedSolomonFecSenderTest, NoFecWithoutProtection) {
+  SetFecRate(0, 1);
+  AddFrame(10);
+  EXPECT_TRUE(sender_.GetFecPackets().empty());
+}
+
+TEST_F(ReedSolomonFecSenderTest, ProtectsFrameWithParityPackets) {
+  // (10 * 102 + 128) / 256 = 4 FEC packets.
+  SetFecRate(102, 1);
+  AddFrame(10);
+  std::vector<std::unique_ptr<RtpPacketToSend>> fec_packets =
+      sender_.GetFecPackets();
+  ASSERT_EQ(fec_packets.size(), 4u);
+  EXPECT_TRUE(sender_.GetFecPackets().empty());
+
+  for (size_t i = 0; i < fec_packets.size(); ++i) {
+    const RtpPacketToSend& fec_packet = *fec_packets[i];
+    EXPECT_FALSE(fec_packet.Marker());
+    EXPECT_EQ(fec_packet.PayloadType(), kFecPayloadType);
+    EXPECT_EQ(fec_packet.Ssrc(), kFecSsrc);
+    EXPECT_EQ(fec_packet.SequenceNumber(),
+              static_cast<uint16_t>(fec_packets[0]->SequenceNumber() + i));
+    reed_solomon_fec::Header header;
+    ASSERT_TRUE(reed_solomon_fec::ParseHeader(fec_packet.payload(), &header));
+    EXPECT_EQ(header.protected_ssrc, kMediaSsrc);
+    EXPECT_EQ(header.num_media_packets, 10);
+    EXPECT_EQ(header.parity_index, i);
+    // As long as the longest media packet, without sequence number and SSRC.
+    EXPECT_EQ(fec_packet.payload_size(),
+              reed_solomon_fec::kHeaderSize +
+                  reed_solomon_fec::kRecoveryHeaderSize + kPayloadLength + 9);
+  }
+}
+
+TEST_F(ReedSolomonFecSenderTest, ProtectsSeveralFramesTogether) {
+  SetFecRate(102, 2);
+  AddFrame(5);
+  EXPECT_TRUE(sender_.GetFecPackets().empty());
+  AddFrame(5);
+  std::vector<std::unique_ptr<RtpPacketToSend>> fec_packets =
+      sender_.GetFecPackets();
+  ASSERT_EQ(fec_packets.size(), 4u);
+  reed_solomon_fec::Header header;
+  ASSERT_TRUE(
+      reed_solomon_fec::ParseHeader(fec_packets[0]->payload(), &header));
+  EXPECT_EQ(header.num_media_packets, 10);
+}
+
+TEST_F(ReedSolomonFecSenderTest, LimitsBlockSize) {
+  constexpr int kFecRate = 50;
+  SetFecRate(kFecRate, 1);
+  AddFrame(reed_solomon_fec::kMaxMediaPackets + 10);
+  // One full block, and one block of the last 10 packets.
+  const int expected_fec_packets =
+      ForwardErrorCorrection::NumFecPackets(reed_solomon_fec::kMaxMediaPackets,
+                                            kFecRate) +
+      ForwardErrorCorrection::NumFecPackets(10, kFecRate);
+  EXPECT_EQ(sender_.GetFecPackets().size(),
+            static_cast<size_t>(expected_fec_packets));
+}
+
+TEST_F(ReedSolomonFecSenderTest, KeepsSequenceNumbersInRtpState) {
+  SetFecRate(102, 1);
+  AddFrame(10);
+  std::vector<std::unique_ptr<RtpPacketToSend>> fec_packets =
+      sender_.GetFecPackets();
+  ASSERT_FALSE(fec_packets.empty());
+  absl::optional<RtpState> rtp_state = sender_.GetRtpState();
+  ASSERT_TRUE(rtp_state);
+  EXPECT_EQ(rtp_state->sequence_number,
+            static_cast<uint16_t>(fec_packets.back()->SequenceNumber() + 1));
+
+  ReedSolomonFecSender resumed_sender(
+      kFecPayloadType, kFecSsrc, kMediaSsrc, kNoMid, kNoRtpHeaderExtensions,
+      kNoRtpHeaderExtensionSizes, &*rtp_state, &clock_);
+  EXPECT_EQ(resumed_sender.GetRtpState()->sequence_number,
+            rtp_state->sequence_number);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -370,6 +370,22 @@ TransportFeedback::GetAllPackets() const {
   return all_packets_;
 }
 
+void TransportFeedback::ForAllPackets(
+    rtc::FunctionView<void(uint16_t, TimeDelta)> handler) const {
+  uint16_t seq_no = base_seq_no_;
+  for (const ReceivedPacket& packet : received_packets_) {
+    for (; seq_no != packet.sequence_number(); ++seq_no) {
+      handler(seq_no, TimeDelta::PlusInfinity());
+    }
+    handler(seq_no, packet.delta());
+    ++seq_no;
+  }
+  const uint16_t end_seq_no = base_seq_no_ + num_seq_no_;
+  for (; seq_no != end_seq_no; ++seq_no) {
+    handler(seq_no, TimeDelta::PlusInfinity());
+  }
+}
+
 uint16_t TransportFeedback::GetBaseSequence() const {
   return base_seq_no_;
 }
@@ -453,6 +469,8 @@ bool TransportFeedback::Parse(const CommonHeader& packet) {
 
   // Determine if timestamps, that is, recv_delta are included in the packet.
   if (end_index >= index + recv_delta_size) {
+    // The feedback may be parsed into one that had no timestamps.
+    include_timestamps_ = true;
     for (size_t delta_size : delta_sizes) {
       RTC_DCHECK_LE(index + delta_size, end_index);
       switch (delta_size) {
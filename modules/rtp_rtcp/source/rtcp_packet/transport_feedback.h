@@ -14,6 +14,7 @@
 #include <memory>
 #include <vector>
 
+#include "api/function_view.h"
 #include "api/units/time_delta.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/rtpfb.h"
 
@@ -71,6 +72,15 @@ class TransportFeedback : public Rtpfb {
   const std::vector<ReceivedPacket>& GetReceivedPackets() const;
   const std::vector<ReceivedPacket>& GetAllPackets() const;
 
+  // Calls `handler` for every packet the feedback describes, received or not,
+  // in sequence number order. `delta` is the receive time of the packet
+  // relative to the previous received packet, or to the base time for the
+  // first one. It is `TimeDelta::PlusInfinity()` for packets that were not
+  // received. Unlike GetAllPackets(), works without `include_lost`.
+  void ForAllPackets(
+      rtc::FunctionView<void(uint16_t sequence_number, TimeDelta delta)>
+          handler) const;
+
   uint16_t GetBaseSequence() const;
 
   // Returns number of packets (including missing) this feedback describes.
@@ -13,6 +13,7 @@
 #include <limits>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "modules/rtp_rtcp/source/byte_io.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/common_header.h"
@@ -23,6 +24,7 @@ namespace webrtc {
 namespace {
 
 using rtcp::TransportFeedback;
+using ::testing::ElementsAre;
 using ::testing::ElementsAreArray;
 
 static const int kHeaderSize = 20;
@@ -611,5 +613,67 @@ TEST(TransportFeedbackTest, ReportsMissingPacketsWithoutTimestamps) {
   EXPECT_FALSE(packets[2].received());
   EXPECT_TRUE(packets[3].received());
 }
+
+TEST(TransportFeedbackTest, ForAllPacketsReportsReceivedAndLostPackets) {
+  const uint16_t kBaseSeqNo = 0xfffe;
+  // A multiple of the 64 ms resolution of the base time.
+  const int64_t kBaseTimestampUs = 64000;
+  TransportFeedback feedback_builder(/*include_timestamps*/ true);
+  feedback_builder.SetBase(kBaseSeqNo, kBaseTimestampUs);
+  feedback_builder.AddReceivedPacket(kBaseSeqNo + 0, kBaseTimestampUs);
+  feedback_builder.AddReceivedPacket(kBaseSeqNo + 3, kBaseTimestampUs + 2000);
+  feedback_builder.AddReceivedPacket(kBaseSeqNo + 4, kBaseTimestampUs + 2500);
+  rtc::Buffer coded = feedback_builder.Build();
+
+  rtcp::CommonHeader header;
+  ASSERT_TRUE(header.Parse(coded.data(), coded.size()));
+  TransportFeedback feedback(/*include_timestamps*/ true,
+                             /*include_lost*/ false);
+  ASSERT_TRUE(feedback.Parse(header));
+
+  std::vector<uint16_t> sequence_numbers;
+  std::vector<TimeDelta> deltas;
+  feedback.ForAllPackets([&](uint16_t sequence_number, TimeDelta delta) {
+    sequence_numbers.push_back(sequence_number);
+    deltas.push_back(delta);
+  });
+  EXPECT_THAT(sequence_numbers, ElementsAre(0xfffe, 0xffff, 0, 1, 2));
+  EXPECT_THAT(deltas,
+              ElementsAre(TimeDelta::Zero(), TimeDelta::PlusInfinity(),
+                          TimeDelta::PlusInfinity(), TimeDelta::Millis(2),
+                          TimeDelta::Micros(500)));
+}
+
+TEST(TransportFeedbackTest, ParsesIntoUsedFeedback) {
+  const int64_t kBaseTimestampUs = 10000;
+  TransportFeedback without_timestamps(/*include_timestamps*/ false);
+  without_timestamps.SetBase(100, kBaseTimestampUs);
+  without_timestamps.AddReceivedPacket(100, 0);
+  without_timestamps.AddReceivedPacket(110, 0);
+  rtc::Buffer coded1 = without_timestamps.Build();
+
+  TransportFeedback with_timestamps(/*include_timestamps*/ true);
+  with_timestamps.SetBase(200, kBaseTimestampUs);
+  with_timestamps.AddReceivedPacket(200, kBaseTimestampUs + 1000);
+  with_timestamps.AddReceivedPacket(202, kBaseTimestampUs + 2000);
+  rtc::Buffer coded2 = with_timestamps.Build();
+
+  TransportFeedback feedback;
+  rtcp::CommonHeader header;
+  ASSERT_TRUE(header.Parse(coded1.data(), coded1.size()));
+  ASSERT_TRUE(feedback.Parse(header));
+  EXPECT_FALSE(feedback.IncludeTimestamps());
+  EXPECT_EQ(feedback.GetPacketStatusCount(), 11u);
+
+  ASSERT_TRUE(header.Parse(coded2.data(), coded2.size()));
+  ASSERT_TRUE(feedback.Parse(header));
+  EXPECT_TRUE(feedback.IncludeTimestamps());
+  EXPECT_TRUE(feedback.IsConsistent());
+  EXPECT_EQ(feedback.GetBaseSequence(), 200);
+  EXPECT_EQ(feedback.GetPacketStatusCount(), 3u);
+  EXPECT_EQ(feedback.GetAllPackets().size(), 3u);
+  EXPECT_EQ(feedback.GetReceivedPackets().size(), 2u);
+  EXPECT_EQ(feedback.Build(), coded2);
+}
 }  // namespace
 }  // namespace webrtc
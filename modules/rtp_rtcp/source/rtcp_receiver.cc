@@ -122,7 +122,20 @@ void RTCPReceiver::RegisteredSsrcs::set_media_ssrc(uint32_t ssrc) {
   ssrcs_[kMediaSsrcIndex] = ssrc;
 }
 
+// Reused from one incoming packet to the next, so that once its containers
+// have grown, parsing a packet doesn't allocate.
 struct RTCPReceiver::PacketInformation {
+  // For each remote SSRC, whether a sender report or a DLRR block was
+  // received.
+  struct RtcpReceivedBlock {
+    bool sender_report = false;
+    bool dlrr = false;
+  };
+
+  // Resets the information for the next packet, keeping the capacity of the
+  // containers.
+  void Clear();
+
   uint32_t packet_type_flags = 0;  // RTCPPacketTypeFlags bit field.
 
   uint32_t remote_ssrc = 0;
@@ -132,12 +145,35 @@ struct RTCPReceiver::PacketInformation {
   std::vector<ReportBlockData> report_block_datas;
   int64_t rtt_ms = 0;
   uint32_t receiver_estimated_max_bitrate_bps = 0;
-  std::unique_ptr<rtcp::TransportFeedback> transport_feedback;
+  // Valid when `packet_type_flags` has kRtcpTransportFeedback. Observers
+  // iterate it with ForAllPackets(), so lost packets aren't stored.
+  rtcp::TransportFeedback transport_feedback{/*include_timestamps=*/true,
+                                             /*include_lost=*/false};
   absl::optional<VideoBitrateAllocation> target_bitrate_allocation;
   absl::optional<NetworkStateEstimate> network_state_estimate;
   std::unique_ptr<rtcp::LossNotification> loss_notification;
+
+  flat_map<uint32_t, RtcpReceivedBlock> received_blocks;
+  // The packets that the most common blocks are parsed into.
+  rtcp::SenderReport sender_report;
+  rtcp::ReceiverReport receiver_report;
+  rtcp::Nack nack;
 };
 
+void RTCPReceiver::PacketInformation::Clear() {
+  packet_type_flags = 0;
+  remote_ssrc = 0;
+  nack_sequence_numbers.clear();
+  report_blocks.clear();
+  report_block_datas.clear();
+  rtt_ms = 0;
+  receiver_estimated_max_bitrate_bps = 0;
+  target_bitrate_allocation.reset();
+  network_state_estimate.reset();
+  loss_notification.reset();
+  received_blocks.clear();
+}
+
 RTCPReceiver::RTCPReceiver(const RtpRtcpInterface::Configuration& config,
                            ModuleRtpRtcpImpl2* owner)
     : clock_(config.clock),
@@ -227,10 +263,22 @@ void RTCPReceiver::IncomingPacket(rtc::ArrayView<const uint8_t> packet) {
     return;
   }
 
-  PacketInformation packet_information;
-  if (!ParseCompoundPacket(packet, &packet_information))
-    return;
-  TriggerCallbacksFromRtcpPacket(packet_information);
+  // Normally reuses the spare packet information, but allocates another one
+  // if packets are received concurrently.
+  std::unique_ptr<PacketInformation> packet_information;
+  {
+    MutexLock lock(&rtcp_receiver_lock_);
+    packet_information = std::move(spare_packet_information_);
+  }
+  if (!packet_information)
+    packet_information = std::make_unique<PacketInformation>();
+
+  if (ParseCompoundPacket(packet, packet_information.get()))
+    TriggerCallbacksFromRtcpPacket(*packet_information);
+
+  packet_information->Clear();
+  MutexLock lock(&rtcp_receiver_lock_);
+  spare_packet_information_ = std::move(packet_information);
 }
 
 // This method is only used by test and legacy code, so we should be able to
@@ -447,13 +495,7 @@ bool RTCPReceiver::ParseCompoundPacket(rtc::ArrayView<const uint8_t> packet,
   // If a sender report is received but no DLRR, we need to reset the
   // roundTripTime stat according to the standard, see
   // https://www.w3.org/TR/webrtc-stats/#dom-rtcremoteoutboundrtpstreamstats-roundtriptime
-  struct RtcpReceivedBlock {
-    bool sender_report = false;
-    bool dlrr = false;
-  };
-  // For each remote SSRC we store if we've received a sender report or a DLRR
-  // block.
-  flat_map<uint32_t, RtcpReceivedBlock> received_blocks;
+  auto& received_blocks = packet_information->received_blocks;
   for (const uint8_t* next_block = packet.begin(); next_block != packet.end();
        next_block = rtcp_block.NextPacket()) {
     ptrdiff_t remaining_blocks_size = packet.end() - next_block;
@@ -572,7 +614,7 @@ bool RTCPReceiver::ParseCompoundPacket(rtc::ArrayView<const uint8_t> packet,
 
 void RTCPReceiver::HandleSenderReport(const CommonHeader& rtcp_block,
                                       PacketInformation* packet_information) {
-  rtcp::SenderReport sender_report;
+  rtcp::SenderReport& sender_report = packet_information->sender_report;
   if (!sender_report.Parse(rtcp_block)) {
     ++num_skipped_packets_;
     return;
@@ -607,7 +649,7 @@ void RTCPReceiver::HandleSenderReport(const CommonHeader& rtcp_block,
 
 void RTCPReceiver::HandleReceiverReport(const CommonHeader& rtcp_block,
                                         PacketInformation* packet_information) {
-  rtcp::ReceiverReport receiver_report;
+  rtcp::ReceiverReport& receiver_report = packet_information->receiver_report;
   if (!receiver_report.Parse(rtcp_block)) {
     ++num_skipped_packets_;
     return;
@@ -801,7 +843,7 @@ void RTCPReceiver::HandleSdes(const CommonHeader& rtcp_block,
 
 void RTCPReceiver::HandleNack(const CommonHeader& rtcp_block,
                               PacketInformation* packet_information) {
-  rtcp::Nack nack;
+  rtcp::Nack& nack = packet_information->nack;
   if (!nack.Parse(rtcp_block)) {
     ++num_skipped_packets_;
     return;
@@ -1107,15 +1149,15 @@ void RTCPReceiver::HandleFir(const CommonHeader& rtcp_block,
 void RTCPReceiver::HandleTransportFeedback(
     const CommonHeader& rtcp_block,
     PacketInformation* packet_information) {
-  std::unique_ptr<rtcp::TransportFeedback> transport_feedback(
-      new rtcp::TransportFeedback());
-  if (!transport_feedback->Parse(rtcp_block)) {
+  // Parsing reuses the memory of the previous feedback. If the packet is
+  // malformed, an earlier feedback in the same compound packet is dropped.
+  if (!packet_information->transport_feedback.Parse(rtcp_block)) {
+    packet_information->packet_type_flags &= ~kRtcpTransportFeedback;
     ++num_skipped_packets_;
     return;
   }
 
   packet_information->packet_type_flags |= kRtcpTransportFeedback;
-  packet_information->transport_feedback = std::move(transport_feedback);
 }
 
 void RTCPReceiver::NotifyTmmbrUpdated() {
@@ -1209,11 +1251,11 @@ void RTCPReceiver::TriggerCallbacksFromRtcpPacket(
   if (transport_feedback_observer_ &&
       (packet_information.packet_type_flags & kRtcpTransportFeedback)) {
     uint32_t media_source_ssrc =
-        packet_information.transport_feedback->media_ssrc();
+        packet_information.transport_feedback.media_ssrc();
     if (media_source_ssrc == main_ssrc_ ||
         registered_ssrcs_.contains(media_source_ssrc)) {
       transport_feedback_observer_->OnTransportFeedback(
-          *packet_information.transport_feedback);
+          packet_information.transport_feedback);
     }
   }
 
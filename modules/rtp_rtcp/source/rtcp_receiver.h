@@ -13,6 +13,7 @@
 
 #include <list>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -446,6 +447,10 @@ class RTCPReceiver final {
 
   size_t num_skipped_packets_;
   int64_t last_skipped_packets_warning_ms_;
+
+  // Kept between packets, null while a packet is handled.
+  std::unique_ptr<PacketInformation> spare_packet_information_
+      RTC_GUARDED_BY(rtcp_receiver_lock_);
 };
 }  // namespace webrtc
 #endif  // MODULES_RTP_RTCP_SOURCE_RTCP_RECEIVER_H_
@@ -1841,6 +1841,46 @@ TEST(RtcpReceiverTest, HandlesInvalidTransportFeedback) {
   receiver.IncomingPacket(built_packet);
 }
 
+TEST(RtcpReceiverTest, ReceivesTransportFeedbackInConsecutivePackets) {
+  ReceiverMocks mocks;
+  RTCPReceiver receiver(DefaultConfiguration(&mocks), &mocks.rtp_rtcp_impl);
+  receiver.SetRemoteSSRC(kSenderSsrc);
+
+  rtcp::TransportFeedback packet1;
+  packet1.SetMediaSsrc(kReceiverMainSsrc);
+  packet1.SetSenderSsrc(kSenderSsrc);
+  packet1.SetBase(1, 1000);
+  packet1.AddReceivedPacket(1, 1000);
+  packet1.AddReceivedPacket(2, 2000);
+
+  rtcp::TransportFeedback packet2;
+  packet2.SetMediaSsrc(kReceiverMainSsrc);
+  packet2.SetSenderSsrc(kSenderSsrc);
+  packet2.SetBase(3, 3000);
+  packet2.AddReceivedPacket(3, 3000);
+
+  rtcp::Remb remb;
+  remb.SetSenderSsrc(kSenderSsrc);
+  remb.SetBitrateBps(50000);
+
+  InSequence s;
+  EXPECT_CALL(mocks.transport_feedback_observer,
+              OnTransportFeedback(AllOf(
+                  Property(&rtcp::TransportFeedback::GetBaseSequence, 1),
+                  Property(&rtcp::TransportFeedback::GetReceivedPackets,
+                           SizeIs(2)))));
+  EXPECT_CALL(mocks.transport_feedback_observer,
+              OnTransportFeedback(AllOf(
+                  Property(&rtcp::TransportFeedback::GetBaseSequence, 3),
+                  Property(&rtcp::TransportFeedback::GetReceivedPackets,
+                           SizeIs(1)))));
+  EXPECT_CALL(mocks.bandwidth_observer, OnReceivedEstimatedBitrate(50000));
+  receiver.IncomingPacket(packet1.Build());
+  receiver.IncomingPacket(packet2.Build());
+  // Feedback of earlier packets is not delivered again.
+  receiver.IncomingPacket(remb.Build());
+}
+
 TEST(RtcpReceiverTest, Nack) {
   ReceiverMocks mocks;
   RTCPReceiver receiver(DefaultConfiguration(&mocks), &mocks.rtp_rtcp_impl);
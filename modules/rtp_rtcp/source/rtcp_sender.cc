@@ -17,6 +17,7 @@
 #include <utility>
 
 #include "absl/types/optional.h"
+#include "api/array_view.h"
 #include "api/rtc_event_log/rtc_event_log.h"
 #include "api/rtp_headers.h"
 #include "api/units/time_delta.h"
@@ -132,6 +133,9 @@ RTCPSender::Configuration RTCPSender::Configuration::FromRtpRtcpConfiguration(
     result.rtcp_report_interval =
         TimeDelta::Millis(configuration.rtcp_report_interval_ms);
   }
+  if (configuration.rtcp_max_report_blocks) {
+    result.max_report_blocks = configuration.rtcp_max_report_blocks;
+  }
   result.receive_statistics = configuration.receive_statistics;
   result.rtcp_packet_type_counter_observer =
       configuration.rtcp_packet_type_counter_observer;
@@ -156,6 +160,7 @@ RTCPSender::RTCPSender(Configuration config)
       last_rtp_timestamp_(0),
       remote_ssrc_(0),
       receive_statistics_(config.receive_statistics),
+      max_report_blocks_(config.max_report_blocks),
 
       sequence_number_fir_(0),
 
@@ -467,8 +472,20 @@ void RTCPSender::BuildSR(const RtcpContext& ctx, PacketSender& sender) {
   report.SetRtpTimestamp(rtp_timestamp);
   report.SetPacketCount(ctx.feedback_state_.packets_sent);
   report.SetOctetCount(ctx.feedback_state_.media_bytes_sent);
-  report.SetReportBlocks(CreateReportBlocks(ctx.feedback_state_));
+  std::vector<rtcp::ReportBlock> report_blocks =
+      CreateReportBlocks(ctx.feedback_state_);
+  size_t num_in_report = std::min(
+      report_blocks.size(), rtcp::SenderReport::kMaxNumberOfReportBlocks);
+  for (size_t i = 0; i < num_in_report; ++i) {
+    report.AddReportBlock(report_blocks[i]);
+  }
   sender.AppendPacket(report);
+  if (report_blocks.size() > num_in_report) {
+    AppendReceiverReports(
+        rtc::ArrayView<const rtcp::ReportBlock>(report_blocks)
+            .subview(num_in_report),
+        sender);
+  }
 }
 
 void RTCPSender::BuildSDES(const RtcpContext& ctx, PacketSender& sender) {
@@ -481,10 +498,27 @@ void RTCPSender::BuildSDES(const RtcpContext& ctx, PacketSender& sender) {
 }
 
 void RTCPSender::BuildRR(const RtcpContext& ctx, PacketSender& sender) {
-  rtcp::ReceiverReport report;
-  report.SetSenderSsrc(ssrc_);
-  report.SetReportBlocks(CreateReportBlocks(ctx.feedback_state_));
-  sender.AppendPacket(report);
+  AppendReceiverReports(CreateReportBlocks(ctx.feedback_state_), sender);
+}
+
+void RTCPSender::AppendReceiverReports(
+    rtc::ArrayView<const rtcp::ReportBlock> report_blocks,
+    PacketSender& sender) {
+  // A receiver report only has room for 31 report blocks, RFC 3550 section
+  // 6.4.2 says to send the rest in more receiver reports in the same compound
+  // packet. Always sends at least one report, even without blocks.
+  size_t offset = 0;
+  do {
+    rtcp::ReceiverReport report;
+    report.SetSenderSsrc(ssrc_);
+    size_t end =
+        std::min(report_blocks.size(),
+                 offset + rtcp::ReceiverReport::kMaxNumberOfReportBlocks);
+    for (; offset < end; ++offset) {
+      report.AddReportBlock(report_blocks[offset]);
+    }
+    sender.AppendPacket(report);
+  } while (offset < report_blocks.size());
 }
 
 void RTCPSender::BuildPLI(const RtcpContext& ctx, PacketSender& sender) {
@@ -821,10 +855,9 @@ std::vector<rtcp::ReportBlock> RTCPSender::CreateReportBlocks(
   if (!receive_statistics_)
     return result;
 
-  // TODO(danilchap): Support sending more than `RTCP_MAX_REPORT_BLOCKS` per
-  // compound rtcp packet when single rtcp module is used for multiple media
-  // streams.
-  result = receive_statistics_->RtcpReportBlocks(RTCP_MAX_REPORT_BLOCKS);
+  // Past `max_report_blocks_` incoming streams, ReceiveStatistics reports on
+  // them in turn.
+  result = receive_statistics_->RtcpReportBlocks(max_report_blocks_);
 
   if (!result.empty() && ((feedback_state.last_rr_ntp_secs != 0) ||
                           (feedback_state.last_rr_ntp_frac != 0))) {
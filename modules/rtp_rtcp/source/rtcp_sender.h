@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "absl/types/optional.h"
+#include "api/array_view.h"
 #include "api/call/transport.h"
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
@@ -32,6 +33,7 @@
 #include "modules/rtp_rtcp/source/rtcp_packet/loss_notification.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/report_block.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/tmmb_item.h"
+#include "modules/rtp_rtcp/source/rtp_rtcp_config.h"
 #include "modules/rtp_rtcp/source/rtp_rtcp_interface.h"
 #include "rtc_base/random.h"
 #include "rtc_base/synchronization/mutex.h"
@@ -79,6 +81,10 @@ class RTCPSender final {
     RtcEventLog* event_log = nullptr;
     absl::optional<TimeDelta> rtcp_report_interval;
     ReceiveStatisticsProvider* receive_statistics = nullptr;
+    // Maximum number of report blocks in each compound packet. Blocks that
+    // don't fit in the sender or receiver report are sent in additional
+    // receiver reports.
+    size_t max_report_blocks = RTCP_MAX_REPORT_BLOCKS;
     RtcpPacketTypeCounterObserver* rtcp_packet_type_counter_observer = nullptr;
   };
   struct FeedbackState {
@@ -197,6 +203,9 @@ class RTCPSender final {
   std::vector<rtcp::ReportBlock> CreateReportBlocks(
       const FeedbackState& feedback_state)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_rtcp_sender_);
+  void AppendReceiverReports(
+      rtc::ArrayView<const rtcp::ReportBlock> report_blocks,
+      PacketSender& sender) RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_rtcp_sender_);
 
   void BuildSR(const RtcpContext& context, PacketSender& sender)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_rtcp_sender_);
@@ -264,6 +273,7 @@ class RTCPSender final {
 
   ReceiveStatisticsProvider* receive_statistics_
       RTC_GUARDED_BY(mutex_rtcp_sender_);
+  const size_t max_report_blocks_;
 
   // send CSRCs
   std::vector<uint32_t> csrcs_ RTC_GUARDED_BY(mutex_rtcp_sender_);
@@ -291,12 +291,67 @@ TEST_F(RtcpSenderTest, SendRrWithTwoReportBlocks) {
           Property(&rtcp::ReportBlock::source_ssrc, Eq(kRemoteSsrc + 1))));
 }
 
+TEST_F(RtcpSenderTest, SendsAtMost31ReportBlocksByDefault) {
+  auto rtcp_sender = CreateRtcpSender(GetDefaultConfig());
+  for (uint32_t i = 0; i < 40; ++i) {
+    InsertIncomingPacket(kRemoteSsrc + i, 11111);
+  }
+  rtcp_sender->SetRTCPStatus(RtcpMode::kCompound);
+  EXPECT_EQ(0, rtcp_sender->SendRTCP(feedback_state(), kRtcpRr));
+  EXPECT_EQ(1, parser()->receiver_report()->num_packets());
+  EXPECT_EQ(31u, parser()->receiver_report()->report_blocks().size());
+}
+
+TEST_F(RtcpSenderTest, SplitsReportBlocksOverSeveralReceiverReports) {
+  RTCPSender::Configuration config = GetDefaultConfig();
+  config.max_report_blocks = 100;
+  auto rtcp_sender = CreateRtcpSender(config);
+  for (uint32_t i = 0; i < 40; ++i) {
+    InsertIncomingPacket(kRemoteSsrc + i, 11111);
+  }
+  rtcp_sender->SetRTCPStatus(RtcpMode::kCompound);
+  EXPECT_EQ(0, rtcp_sender->SendRTCP(feedback_state(), kRtcpRr));
+  EXPECT_EQ(2, parser()->receiver_report()->num_packets());
+  EXPECT_EQ(kSenderSsrc, parser()->receiver_report()->sender_ssrc());
+  // The parser keeps the last receiver report.
+  EXPECT_EQ(9u, parser()->receiver_report()->report_blocks().size());
+}
+
+TEST_F(RtcpSenderTest, SendsReportBlocksPastSenderReportInReceiverReports) {
+  RTCPSender::Configuration config = GetDefaultConfig();
+  config.max_report_blocks = 100;
+  auto rtcp_sender = CreateRtcpSender(config);
+  for (uint32_t i = 0; i < 70; ++i) {
+    InsertIncomingPacket(kRemoteSsrc + i, 11111);
+  }
+  rtcp_sender->SetRTCPStatus(RtcpMode::kCompound);
+  rtcp_sender->SetSendingStatus(feedback_state(), true);
+  EXPECT_EQ(0, rtcp_sender->SendRTCP(feedback_state(), kRtcpSr));
+  EXPECT_EQ(1, parser()->sender_report()->num_packets());
+  EXPECT_EQ(31u, parser()->sender_report()->report_blocks().size());
+  EXPECT_EQ(2, parser()->receiver_report()->num_packets());
+  EXPECT_EQ(kSenderSsrc, parser()->receiver_report()->sender_ssrc());
+  EXPECT_EQ(8u, parser()->receiver_report()->report_blocks().size());
+}
+
+TEST_F(RtcpSenderTest, ReportsOnAtMostMaxReportBlocksStreams) {
+  RTCPSender::Configuration config = GetDefaultConfig();
+  config.max_report_blocks = 35;
+  auto rtcp_sender = CreateRtcpSender(config);
+  for (uint32_t i = 0; i < 40; ++i) {
+    InsertIncomingPacket(kRemoteSsrc + i, 11111);
+  }
+  rtcp_sender->SetRTCPStatus(RtcpMode::kCompound);
+  EXPECT_EQ(0, rtcp_sender->SendRTCP(feedback_state(), kRtcpRr));
+  EXPECT_EQ(2, parser()->receiver_report()->num_packets());
+  EXPECT_EQ(4u, parser()->receiver_report()->report_blocks().size());
+}
+
 TEST_F(RtcpSenderTest, SendSdes) {
   auto rtcp_sender = CreateRtcpSender(GetDefaultConfig());
   rtcp_sender->SetRTCPStatus(RtcpMode::kReducedSize);
   EXPECT_EQ(0, rtcp_sender->SetCNAME("alice@host"));
   EXPECT_EQ(0, rtcp_sender->SendRTCP(feedback_state(), kRtcpSdes));
-  EXPECT_EQ(1, parser()->sdes()->num_packets());
   EXPECT_EQ(1U, parser()->sdes()->chunks().size());
   EXPECT_EQ(kSenderSsrc, parser()->sdes()->chunks()[0].ssrc);
   EXPECT_EQ("alice@host", parser()->sdes()->chunks()[0].cname);
@@ -308,7 +363,6 @@ TEST_F(RtcpSenderTest, SdesIncludedInCompoundPacket) {
   EXPECT_EQ(0, rtcp_sender->SetCNAME("alice@host"));
   EXPECT_EQ(0, rtcp_sender->SendRTCP(feedback_state(), kRtcpReport));
   EXPECT_EQ(1, parser()->receiver_report()->num_packets());
-  EXPECT_EQ(1, parser()->sdes()->num_packets());
   EXPECT_EQ(1U, parser()->sdes()->chunks().size());
 }
 
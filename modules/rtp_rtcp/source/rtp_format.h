@@ -22,6 +22,7 @@
 
 namespace webrtc {
 
+class RtpPacketizationPlan;
 class RtpPacketToSend;
 
 class RtpPacketizer {
@@ -52,6 +53,11 @@ class RtpPacketizer {
   // Returns true on success, false otherwise.
   virtual bool NextPacket(RtpPacketToSend* packet) = 0;
 
+  // Returns all the packets, if the packetizer computes them up front, so
+  // that the caller can write them itself, e.g. behind a RED header, rather
+  // than call NextPacket(). Returns null otherwise.
+  virtual const RtpPacketizationPlan* plan() const { return nullptr; }
+
   // Split payload_len into sum of integers with respect to `limits`.
   // Returns empty vector on failure.
   static std::vector<int> SplitAboutEqually(int payload_len,
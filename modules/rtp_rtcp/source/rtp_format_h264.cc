@@ -48,7 +48,7 @@ enum FuDefs : uint8_t { kSBit = 0x80, kEBit = 0x40, kRBit = 0x20 };
 RtpPacketizerH264::RtpPacketizerH264(rtc::ArrayView<const uint8_t> payload,
                                      PayloadSizeLimits limits,
                                      H264PacketizationMode packetization_mode)
-    : limits_(limits), num_packets_left_(0) {
+    : limits_(limits), plan_(payload) {
   // Guard against uninitialized memory in packetization_mode.
   RTC_CHECK(packetization_mode == H264PacketizationMode::NonInterleaved ||
             packetization_mode == H264PacketizationMode::SingleNalUnit);
@@ -63,17 +63,19 @@ RtpPacketizerH264::RtpPacketizerH264(rtc::ArrayView<const uint8_t> payload,
     // If failed to generate all the packets, discard already generated
     // packets in case the caller would ignore return value and still try to
     // call NextPacket().
-    num_packets_left_ = 0;
     while (!packets_.empty()) {
       packets_.pop();
     }
   }
+  while (!packets_.empty()) {
+    AddPacketToPlan();
+  }
 }
 
 RtpPacketizerH264::~RtpPacketizerH264() = default;
 
 size_t RtpPacketizerH264::NumPackets() const {
-  return num_packets_left_;
+  return plan_.num_remaining_packets();
 }
 
 bool RtpPacketizerH264::GeneratePackets(
@@ -151,7 +153,6 @@ bool RtpPacketizerH264::PacketizeFuA(size_t fragment_index) {
     offset += packet_length;
     payload_left -= packet_length;
   }
-  num_packets_left_ += payload_sizes.size();
   RTC_CHECK_EQ(0, payload_left);
   return true;
 }
@@ -167,7 +168,6 @@ size_t RtpPacketizerH264::PacketizeStapA(size_t fragment_index) {
   size_t fragment_headers_length = 0;
   rtc::ArrayView<const uint8_t> fragment = input_fragments_[fragment_index];
   RTC_CHECK_GE(payload_size_left, fragment.size());
-  ++num_packets_left_;
 
   auto payload_size_needed = [&] {
     size_t fragment_size = fragment.size() + fragment_headers_length;
@@ -230,55 +230,44 @@ bool RtpPacketizerH264::PacketizeSingleNalu(size_t fragment_index) {
   RTC_CHECK_GT(fragment.size(), 0u);
   packets_.push(PacketUnit(fragment, true /* first */, true /* last */,
                            false /* aggregated */, fragment[0]));
-  ++num_packets_left_;
   return true;
 }
 
 bool RtpPacketizerH264::NextPacket(RtpPacketToSend* rtp_packet) {
-  RTC_DCHECK(rtp_packet);
-  if (packets_.empty()) {
-    return false;
-  }
+  return plan_.NextPacket(rtp_packet);
+}
 
+void RtpPacketizerH264::AddPacketToPlan() {
   PacketUnit packet = packets_.front();
   if (packet.first_fragment && packet.last_fragment) {
     // Single NAL unit packet.
-    size_t bytes_to_send = packet.source_fragment.size();
-    uint8_t* buffer = rtp_packet->AllocatePayload(bytes_to_send);
-    memcpy(buffer, packet.source_fragment.data(), bytes_to_send);
+    plan_.AddPayload(packet.source_fragment);
     packets_.pop();
     input_fragments_.pop_front();
   } else if (packet.aggregated) {
-    NextAggregatePacket(rtp_packet);
+    AddAggregatePacketToPlan();
   } else {
-    NextFragmentPacket(rtp_packet);
+    AddFragmentPacketToPlan();
   }
-  rtp_packet->SetMarker(packets_.empty());
-  --num_packets_left_;
-  return true;
+  plan_.FinishPacket(/*marker=*/packets_.empty());
 }
 
-void RtpPacketizerH264::NextAggregatePacket(RtpPacketToSend* rtp_packet) {
-  // Reserve maximum available payload, set actual payload size later.
-  size_t payload_capacity = rtp_packet->FreeCapacity();
-  RTC_CHECK_GE(payload_capacity, kNalHeaderSize);
-  uint8_t* buffer = rtp_packet->AllocatePayload(payload_capacity);
-  RTC_DCHECK(buffer);
+void RtpPacketizerH264::AddAggregatePacketToPlan() {
   PacketUnit* packet = &packets_.front();
   RTC_CHECK(packet->first_fragment);
   // STAP-A NALU header.
-  buffer[0] = (packet->header & (kFBit | kNriMask)) | H264::NaluType::kStapA;
-  size_t index = kNalHeaderSize;
+  const uint8_t stap_a_header =
+      (packet->header & (kFBit | kNriMask)) | H264::NaluType::kStapA;
+  plan_.AddHeader(rtc::MakeArrayView(&stap_a_header, kNalHeaderSize));
   bool is_last_fragment = packet->last_fragment;
   while (packet->aggregated) {
     rtc::ArrayView<const uint8_t> fragment = packet->source_fragment;
-    RTC_CHECK_LE(index + kLengthFieldSize + fragment.size(), payload_capacity);
     // Add NAL unit length field.
-    ByteWriter<uint16_t>::WriteBigEndian(&buffer[index], fragment.size());
-    index += kLengthFieldSize;
+    uint8_t length_field[kLengthFieldSize];
+    ByteWriter<uint16_t>::WriteBigEndian(length_field, fragment.size());
+    plan_.AddHeader(length_field);
     // Add NAL unit.
-    memcpy(&buffer[index], fragment.data(), fragment.size());
-    index += fragment.size();
+    plan_.AddPayload(fragment);
     packets_.pop();
     input_fragments_.pop_front();
     if (is_last_fragment)
@@ -287,10 +276,9 @@ void RtpPacketizerH264::NextAggregatePacket(RtpPacketToSend* rtp_packet) {
     is_last_fragment = packet->last_fragment;
   }
   RTC_CHECK(is_last_fragment);
-  rtp_packet->SetPayloadSize(index);
 }
 
-void RtpPacketizerH264::NextFragmentPacket(RtpPacketToSend* rtp_packet) {
+void RtpPacketizerH264::AddFragmentPacketToPlan() {
   PacketUnit* packet = &packets_.front();
   // NAL unit fragmented over multiple packets (FU-A).
   // We do not send original NALU header, so it will be replaced by the
@@ -304,12 +292,9 @@ void RtpPacketizerH264::NextFragmentPacket(RtpPacketToSend* rtp_packet) {
   fu_header |= (packet->last_fragment ? kEBit : 0);
   uint8_t type = packet->header & kTypeMask;
   fu_header |= type;
-  rtc::ArrayView<const uint8_t> fragment = packet->source_fragment;
-  uint8_t* buffer =
-      rtp_packet->AllocatePayload(kFuAHeaderSize + fragment.size());
-  buffer[0] = fu_indicator;
-  buffer[1] = fu_header;
-  memcpy(buffer + kFuAHeaderSize, fragment.data(), fragment.size());
+  const uint8_t header[kFuAHeaderSize] = {fu_indicator, fu_header};
+  plan_.AddHeader(header);
+  plan_.AddPayload(packet->source_fragment);
   if (packet->last_fragment)
     input_fragments_.pop_front();
   packets_.pop();
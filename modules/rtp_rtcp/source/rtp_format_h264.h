@@ -21,6 +21,7 @@
 #include "api/array_view.h"
 #include "modules/rtp_rtcp/source/rtp_format.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "modules/rtp_rtcp/source/rtp_packetization_plan.h"
 #include "modules/video_coding/codecs/h264/include/h264_globals.h"
 #include "rtc_base/buffer.h"
 #include "rtc_base/constructor_magic.h"
@@ -44,6 +45,8 @@ class RtpPacketizerH264 : public RtpPacketizer {
   // Returns true on success, false otherwise.
   bool NextPacket(RtpPacketToSend* rtp_packet) override;
 
+  const RtpPacketizationPlan* plan() const override { return &plan_; }
+
  private:
   // A packet unit (H264 packet), to be put into an RTP packet:
   // If a NAL unit is too large for an RTP packet, this packet unit will
@@ -75,13 +78,15 @@ class RtpPacketizerH264 : public RtpPacketizer {
   size_t PacketizeStapA(size_t fragment_index);
   bool PacketizeSingleNalu(size_t fragment_index);
 
-  void NextAggregatePacket(RtpPacketToSend* rtp_packet);
-  void NextFragmentPacket(RtpPacketToSend* rtp_packet);
+  // Move the packet units of the next packet from `packets_` to `plan_`.
+  void AddPacketToPlan();
+  void AddAggregatePacketToPlan();
+  void AddFragmentPacketToPlan();
 
   const PayloadSizeLimits limits_;
-  size_t num_packets_left_;
   std::deque<rtc::ArrayView<const uint8_t>> input_fragments_;
   std::queue<PacketUnit> packets_;
+  RtpPacketizationPlan plan_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(RtpPacketizerH264);
 };
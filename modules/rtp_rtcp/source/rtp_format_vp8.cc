@@ -11,7 +11,6 @@
 #include "modules/rtp_rtcp/source/rtp_format_vp8.h"
 
 #include <stdint.h>
-#include <string.h>  // memcpy
 
 #include <vector>
 
@@ -61,37 +60,29 @@ bool ValidateHeader(const RTPVideoHeaderVP8& hdr_info) {
 RtpPacketizerVp8::RtpPacketizerVp8(rtc::ArrayView<const uint8_t> payload,
                                    PayloadSizeLimits limits,
                                    const RTPVideoHeaderVP8& hdr_info)
-    : hdr_(BuildHeader(hdr_info)), remaining_payload_(payload) {
-  limits.max_payload_len -= hdr_.size();
-  payload_sizes_ = SplitAboutEqually(payload.size(), limits);
-  current_packet_ = payload_sizes_.begin();
+    : plan_(payload) {
+  RawHeader hdr = BuildHeader(hdr_info);
+  limits.max_payload_len -= hdr.size();
+  const std::vector<int> payload_sizes =
+      SplitAboutEqually(payload.size(), limits);
+  plan_.Reserve(payload_sizes.size(), 2 * payload_sizes.size());
+  for (size_t i = 0; i < payload_sizes.size(); ++i) {
+    plan_.AddHeader(hdr);
+    plan_.AddPayload(payload.subview(0, payload_sizes[i]));
+    plan_.FinishPacket(/*marker=*/i == payload_sizes.size() - 1);
+    payload = payload.subview(payload_sizes[i]);
+    hdr[0] &= (~kSBit);  //  Clear 'Start of partition' bit.
+  }
 }
 
 RtpPacketizerVp8::~RtpPacketizerVp8() = default;
 
 size_t RtpPacketizerVp8::NumPackets() const {
-  return payload_sizes_.end() - current_packet_;
+  return plan_.num_remaining_packets();
 }
 
 bool RtpPacketizerVp8::NextPacket(RtpPacketToSend* packet) {
-  RTC_DCHECK(packet);
-  if (current_packet_ == payload_sizes_.end()) {
-    return false;
-  }
-
-  size_t packet_payload_len = *current_packet_;
-  ++current_packet_;
-
-  uint8_t* buffer = packet->AllocatePayload(hdr_.size() + packet_payload_len);
-  RTC_CHECK(buffer);
-
-  memcpy(buffer, hdr_.data(), hdr_.size());
-  memcpy(buffer + hdr_.size(), remaining_payload_.data(), packet_payload_len);
-
-  remaining_payload_ = remaining_payload_.subview(packet_payload_len);
-  hdr_[0] &= (~kSBit);  //  Clear 'Start of partition' bit.
-  packet->SetMarker(current_packet_ == payload_sizes_.end());
-  return true;
+  return plan_.NextPacket(packet);
 }
 
 RtpPacketizerVp8::RawHeader RtpPacketizerVp8::BuildHeader(
@@ -135,7 +126,7 @@ RtpPacketizerVp8::RawHeader RtpPacketizerVp8::BuildHeader(
     flags |= kXBit;
   if (header.nonReference)
     flags |= kNBit;
-  // Create header as first packet in the frame. NextPacket() will clear it
+  // Create header as first packet in the frame. The constructor clears it
   // after first use.
   flags |= kSBit;
   result.push_back(flags);
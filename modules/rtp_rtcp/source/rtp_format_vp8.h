@@ -34,6 +34,7 @@
 #include "api/array_view.h"
 #include "modules/rtp_rtcp/source/rtp_format.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "modules/rtp_rtcp/source/rtp_packetization_plan.h"
 #include "modules/video_coding/codecs/vp8/include/vp8_globals.h"
 #include "rtc_base/constructor_magic.h"
 
@@ -57,15 +58,14 @@ class RtpPacketizerVp8 : public RtpPacketizer {
   // Returns true on success, false otherwise.
   bool NextPacket(RtpPacketToSend* packet) override;
 
+  const RtpPacketizationPlan* plan() const override { return &plan_; }
+
  private:
   // VP8 header can use up to 6 bytes.
   using RawHeader = absl::InlinedVector<uint8_t, 6>;
   static RawHeader BuildHeader(const RTPVideoHeaderVP8& header);
 
-  RawHeader hdr_;
-  rtc::ArrayView<const uint8_t> remaining_payload_;
-  std::vector<int> payload_sizes_;
-  std::vector<int>::const_iterator current_packet_;
+  RtpPacketizationPlan plan_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(RtpPacketizerVp8);
 };
@@ -10,7 +10,7 @@
 
 #include "modules/rtp_rtcp/source/rtp_format_vp9.h"
 
-#include <string.h>
+#include <vector>
 
 #include "api/video/video_codec_constants.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
@@ -313,55 +313,48 @@ RtpPacketizerVp9::RtpPacketizerVp9(rtc::ArrayView<const uint8_t> payload,
     : hdr_(RemoveInactiveSpatialLayers(hdr)),
       header_size_(PayloadDescriptorLengthMinusSsData(hdr_)),
       first_packet_extra_header_size_(SsDataLength(hdr_)),
-      remaining_payload_(payload) {
+      plan_(payload) {
   RTC_DCHECK_EQ(hdr_.first_active_layer, 0);
 
   limits.max_payload_len -= header_size_;
   limits.first_packet_reduction_len += first_packet_extra_header_size_;
   limits.single_packet_reduction_len += first_packet_extra_header_size_;
 
-  payload_sizes_ = SplitAboutEqually(payload.size(), limits);
-  current_packet_ = payload_sizes_.begin();
+  const std::vector<int> payload_sizes =
+      SplitAboutEqually(payload.size(), limits);
+  // Ensure end_of_picture is always set on top spatial layer when it is not
+  // dropped.
+  RTC_DCHECK(hdr_.spatial_idx < hdr_.num_spatial_layers - 1 ||
+             hdr_.end_of_picture);
+
+  std::vector<uint8_t> header(header_size_ + first_packet_extra_header_size_);
+  plan_.Reserve(payload_sizes.size(), 2 * payload_sizes.size());
+  for (size_t i = 0; i < payload_sizes.size(); ++i) {
+    bool layer_begin = i == 0;
+    bool layer_end = i == payload_sizes.size() - 1;
+    int header_size = header_size_;
+    if (layer_begin)
+      header_size += first_packet_extra_header_size_;
+    rtc::ArrayView<uint8_t> packet_header(header.data(), header_size);
+    if (!WriteHeader(layer_begin, layer_end, packet_header)) {
+      plan_.Clear();
+      return;
+    }
+    plan_.AddHeader(packet_header);
+    plan_.AddPayload(payload.subview(0, payload_sizes[i]));
+    plan_.FinishPacket(/*marker=*/layer_end && hdr_.end_of_picture);
+    payload = payload.subview(payload_sizes[i]);
+  }
 }
 
 RtpPacketizerVp9::~RtpPacketizerVp9() = default;
 
 size_t RtpPacketizerVp9::NumPackets() const {
-  return payload_sizes_.end() - current_packet_;
+  return plan_.num_remaining_packets();
 }
 
 bool RtpPacketizerVp9::NextPacket(RtpPacketToSend* packet) {
-  RTC_DCHECK(packet);
-  if (current_packet_ == payload_sizes_.end()) {
-    return false;
-  }
-
-  bool layer_begin = current_packet_ == payload_sizes_.begin();
-  int packet_payload_len = *current_packet_;
-  ++current_packet_;
-  bool layer_end = current_packet_ == payload_sizes_.end();
-
-  int header_size = header_size_;
-  if (layer_begin)
-    header_size += first_packet_extra_header_size_;
-
-  uint8_t* buffer = packet->AllocatePayload(header_size + packet_payload_len);
-  RTC_CHECK(buffer);
-
-  if (!WriteHeader(layer_begin, layer_end,
-                   rtc::MakeArrayView(buffer, header_size)))
-    return false;
-
-  memcpy(buffer + header_size, remaining_payload_.data(), packet_payload_len);
-  remaining_payload_ = remaining_payload_.subview(packet_payload_len);
-
-  // Ensure end_of_picture is always set on top spatial layer when it is not
-  // dropped.
-  RTC_DCHECK(hdr_.spatial_idx < hdr_.num_spatial_layers - 1 ||
-             hdr_.end_of_picture);
-
-  packet->SetMarker(layer_end && hdr_.end_of_picture);
-  return true;
+  return plan_.NextPacket(packet);
 }
 
 // VP9 format:
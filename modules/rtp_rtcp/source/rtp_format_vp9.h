@@ -29,6 +29,7 @@
 #include "api/array_view.h"
 #include "modules/rtp_rtcp/source/rtp_format.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "modules/rtp_rtcp/source/rtp_packetization_plan.h"
 #include "modules/video_coding/codecs/vp9/include/vp9_globals.h"
 #include "rtc_base/constructor_magic.h"
 
@@ -50,6 +51,8 @@ class RtpPacketizerVp9 : public RtpPacketizer {
   // Returns true on success, false otherwise.
   bool NextPacket(RtpPacketToSend* packet) override;
 
+  const RtpPacketizationPlan* plan() const override { return &plan_; }
+
  private:
   // Writes the payload descriptor header.
   // `layer_begin` and `layer_end` indicates the postision of the packet in
@@ -61,9 +64,7 @@ class RtpPacketizerVp9 : public RtpPacketizer {
   const RTPVideoHeaderVP9 hdr_;
   const int header_size_;
   const int first_packet_extra_header_size_;
-  rtc::ArrayView<const uint8_t> remaining_payload_;
-  std::vector<int> payload_sizes_;
-  std::vector<int>::const_iterator current_packet_;
+  RtpPacketizationPlan plan_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(RtpPacketizerVp9);
 };
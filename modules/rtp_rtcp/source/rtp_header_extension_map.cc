@@ -166,4 +166,19 @@ bool RtpHeaderExtensionMap::Register(int id,
   return true;
 }
 
+RtpHeaderExtensionMapTranslation::RtpHeaderExtensionMapTranslation(
+    const RtpHeaderExtensionMap& from,
+    const RtpHeaderExtensionMap& to)
+    : to_(to) {
+  for (auto& id : ids_)
+    id = RtpHeaderExtensionMap::kInvalidId;
+  for (int type = kRtpExtensionNone + 1; type < kRtpExtensionNumberOfExtensions;
+       ++type) {
+    uint8_t from_id = from.GetId(static_cast<RTPExtensionType>(type));
+    if (from_id != RtpHeaderExtensionMap::kInvalidId) {
+      ids_[from_id] = to.GetId(static_cast<RTPExtensionType>(type));
+    }
+  }
+}
+
 }  // namespace webrtc
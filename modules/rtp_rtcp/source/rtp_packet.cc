@@ -683,6 +683,78 @@ bool RtpPacket::RemoveExtension(ExtensionType type) {
   return true;
 }
 
+bool RtpPacket::RemapExtensions(
+    const RtpHeaderExtensionMapTranslation& translation) {
+  const bool has_extension = (data()[0] & 0x10) != 0;
+  const size_t profile_offset = kFixedHeaderSize + (data()[0] & 0x0F) * 4;
+  const uint16_t profile =
+      has_extension
+          ? ByteReader<uint16_t>::ReadBigEndian(ReadAt(profile_offset))
+          : 0;
+  const bool one_byte_header = profile == kOneByteExtensionProfileId;
+  if (!one_byte_header && (profile & kTwobyteExtensionProfileIdAppBitsFilter) !=
+                              kTwoByteExtensionProfileId) {
+    // No extensions that could be remapped.
+    extensions_ = translation.to();
+    return true;
+  }
+  if (!one_byte_header && !translation.to().ExtmapAllowMixed()) {
+    RTC_LOG(LS_WARNING) << "Two-byte header extensions not supported by the "
+                           "target extension map.";
+    return false;
+  }
+
+  // Walk the extensions as parsed by ParseBuffer(), including any duplicates
+  // that `extension_entries_` doesn't track. Check that all the new ids fit
+  // before changing anything.
+  const size_t extension_header_length = one_byte_header
+                                             ? kOneByteExtensionHeaderLength
+                                             : kTwoByteExtensionHeaderLength;
+  const size_t extensions_end = profile_offset + 4 + extensions_size_;
+  for (bool rewrite : {false, true}) {
+    size_t offset = profile_offset + 4;
+    while (offset < extensions_end) {
+      const uint8_t first_byte = data()[offset];
+      if (first_byte == 0) {
+        // Padding.
+        ++offset;
+        continue;
+      }
+      const int id = one_byte_header ? first_byte >> 4 : first_byte;
+      const size_t length =
+          one_byte_header ? 1 + (first_byte & 0xf) : data()[offset + 1];
+      const uint8_t new_id = translation.Translate(id);
+      if (!rewrite) {
+        if (one_byte_header &&
+            new_id > RtpExtension::kOneByteHeaderExtensionMaxId) {
+          RTC_LOG(LS_WARNING) << "Extension id " << int{new_id}
+                              << " doesn't fit a one-byte header.";
+          return false;
+        }
+      } else if (new_id == ExtensionManager::kInvalidId) {
+        memset(WriteAt(offset), 0, extension_header_length + length);
+      } else if (one_byte_header) {
+        WriteAt(offset, (new_id << 4) | (first_byte & 0xf));
+      } else {
+        WriteAt(offset, new_id);
+      }
+      offset += extension_header_length + length;
+    }
+  }
+
+  for (auto it = extension_entries_.begin(); it != extension_entries_.end();) {
+    const uint8_t new_id = translation.Translate(it->id);
+    if (new_id == ExtensionManager::kInvalidId) {
+      it = extension_entries_.erase(it);
+    } else {
+      it->id = new_id;
+      ++it;
+    }
+  }
+  extensions_ = translation.to();
+  return true;
+}
+
 std::string RtpPacket::ToString() const {
   rtc::StringBuilder result;
   result << "{payload_type=" << payload_type_ << "marker=" << marker_
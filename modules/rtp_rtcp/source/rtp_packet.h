@@ -105,6 +105,16 @@ class RtpPacket {
   // not be registered and will be preserved as is.
   bool RemoveExtension(ExtensionType type);
 
+  // Changes the header extension ids of a parsed packet from the ids of the
+  // map it was parsed with to the ids of another map, in place, and identifies
+  // the extensions with that map from then on. Together with the setters for
+  // the SSRC, sequence number and timestamp, and SetExtension() on extensions
+  // the packet already has, this rewrites a received packet for forwarding
+  // without copying the payload. Extensions that `translation` has no id for
+  // are replaced with padding. Returns false, leaving the packet unchanged, if
+  // the new ids don't fit the packet's extension header format.
+  bool RemapExtensions(const RtpHeaderExtensionMapTranslation& translation);
+
   // Writes csrc list. Assumes:
   // a) There is enough room left in buffer.
   // b) Extension headers, payload or padding data has not already been added.
@@ -20,8 +20,15 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "system_wrappers/include/clock.h"
+#include "system_wrappers/include/memory_accounting.h"
 
 namespace webrtc {
+namespace {
+
+constexpr memory_accounting::Subsystem kMemorySubsystem =
+    memory_accounting::Subsystem::kRtpPacketHistory;
+
+}  // namespace
 
 constexpr size_t RtpPacketHistory::kMaxCapacity;
 constexpr size_t RtpPacketHistory::kMaxPaddingHistory;
@@ -86,9 +93,14 @@ RtpPacketHistory::RtpPacketHistory(Clock* clock, bool enable_padding_prio)
       number_to_store_(0),
       mode_(StorageMode::kDisabled),
       rtt_ms_(-1),
-      packets_inserted_(0) {}
+      first_sequence_number_(0),
+      packets_span_(0),
+      packets_inserted_(0),
+      packet_bytes_(0) {}
 
-RtpPacketHistory::~RtpPacketHistory() {}
+RtpPacketHistory::~RtpPacketHistory() {
+  memory_accounting::Add(kMemorySubsystem, -packet_bytes_);
+}
 
 void RtpPacketHistory::SetStorePacketsStatus(StorageMode mode,
                                              size_t number_to_store) {
@@ -98,6 +110,9 @@ void RtpPacketHistory::SetStorePacketsStatus(StorageMode mode,
     RTC_LOG(LS_WARNING) << "Purging packet history in order to re-set status.";
   }
   Reset();
+  // Release the ring; it is allocated again for the new capacity when the
+  // next packet is stored.
+  packet_history_ = std::vector<StoredPacket>();
   mode_ = mode;
   number_to_store_ = std::min(kMaxCapacity, number_to_store);
 }
@@ -134,36 +149,41 @@ void RtpPacketHistory::PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
   // Store packet.
   const uint16_t rtp_seq_no = packet->SequenceNumber();
   int packet_index = GetPacketIndex(rtp_seq_no);
-  if (packet_index >= 0 &&
-      static_cast<size_t>(packet_index) < packet_history_.size() &&
-      packet_history_[packet_index].packet_ != nullptr) {
+  if (packet_index >= 0 && static_cast<size_t>(packet_index) < packets_span_ &&
+      Slot(packet_index).packet_ != nullptr) {
     RTC_LOG(LS_WARNING) << "Duplicate packet inserted: " << rtp_seq_no;
     // Remove previous packet to avoid inconsistent state.
     RemovePacket(packet_index);
     packet_index = GetPacketIndex(rtp_seq_no);
   }
 
-  // Packet to be inserted ahead of first packet, expand front.
-  for (; packet_index < 0; ++packet_index) {
-    packet_history_.emplace_front(nullptr, absl::nullopt, 0);
+  if (packets_span_ == 0) {
+    first_sequence_number_ = rtp_seq_no;
   }
-  // Packet to be inserted behind last packet, expand back.
-  while (static_cast<int>(packet_history_.size()) <= packet_index) {
-    packet_history_.emplace_back(nullptr, absl::nullopt, 0);
+  if (packet_index < 0) {
+    // Packet to be inserted ahead of first packet, expand front.
+    EnsureCapacity(packets_span_ + static_cast<size_t>(-packet_index));
+    packets_span_ += static_cast<size_t>(-packet_index);
+    first_sequence_number_ = rtp_seq_no;
+    packet_index = 0;
+  } else if (static_cast<size_t>(packet_index) >= packets_span_) {
+    // Packet to be inserted behind last packet, expand back.
+    EnsureCapacity(packet_index + 1);
+    packets_span_ = packet_index + 1;
   }
 
-  RTC_DCHECK_GE(packet_index, 0);
-  RTC_DCHECK_LT(packet_index, packet_history_.size());
-  RTC_DCHECK(packet_history_[packet_index].packet_ == nullptr);
+  StoredPacket& stored_packet = Slot(packet_index);
+  RTC_DCHECK(stored_packet.packet_ == nullptr);
 
-  packet_history_[packet_index] =
+  stored_packet =
       StoredPacket(std::move(packet), send_time_ms, packets_inserted_++);
+  AddPacketBytes(stored_packet.packet_->size());
 
   if (enable_padding_prio_) {
     if (padding_priority_.size() >= kMaxPaddingHistory - 1) {
       padding_priority_.erase(std::prev(padding_priority_.end()));
     }
-    auto prio_it = padding_priority_.insert(&packet_history_[packet_index]);
+    auto prio_it = padding_priority_.insert(&stored_packet);
     RTC_DCHECK(prio_it.second) << "Failed to insert packet into prio set.";
   }
 }
@@ -269,11 +289,10 @@ absl::optional<RtpPacketHistory::PacketState> RtpPacketHistory::GetPacketState(
   }
 
   int packet_index = GetPacketIndex(sequence_number);
-  if (packet_index < 0 ||
-      static_cast<size_t>(packet_index) >= packet_history_.size()) {
+  if (packet_index < 0 || static_cast<size_t>(packet_index) >= packets_span_) {
     return absl::nullopt;
   }
-  const StoredPacket& packet = packet_history_[packet_index];
+  const StoredPacket& packet = Slot(packet_index);
   if (packet.packet_ == nullptr) {
     return absl::nullopt;
   }
@@ -320,12 +339,11 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPayloadPaddingPacket(
   if (enable_padding_prio_ && !padding_priority_.empty()) {
     auto best_packet_it = padding_priority_.begin();
     best_packet = *best_packet_it;
-  } else if (!enable_padding_prio_ && !packet_history_.empty()) {
+  } else if (!enable_padding_prio_) {
     // Prioritization not available, pick the last packet.
-    for (auto it = packet_history_.rbegin(); it != packet_history_.rend();
-         ++it) {
-      if (it->packet_ != nullptr) {
-        best_packet = &(*it);
+    for (size_t i = packets_span_; i > 0; --i) {
+      if (Slot(i - 1).packet_ != nullptr) {
+        best_packet = &Slot(i - 1);
         break;
       }
     }
@@ -361,7 +379,7 @@ void RtpPacketHistory::CullAcknowledgedPackets(
   for (uint16_t sequence_number : sequence_numbers) {
     int packet_index = GetPacketIndex(sequence_number);
     if (packet_index < 0 ||
-        static_cast<size_t>(packet_index) >= packet_history_.size()) {
+        static_cast<size_t>(packet_index) >= packets_span_) {
       continue;
     }
     RemovePacket(packet_index);
@@ -389,33 +407,50 @@ void RtpPacketHistory::Clear() {
 }
 
 void RtpPacketHistory::Reset() {
-  packet_history_.clear();
+  for (size_t i = 0; i < packets_span_; ++i) {
+    Slot(i).packet_ = nullptr;
+  }
+  packets_span_ = 0;
   padding_priority_.clear();
+  AddPacketBytes(-packet_bytes_);
+}
+
+void RtpPacketHistory::AddPacketBytes(int64_t bytes) {
+  packet_bytes_ += bytes;
+  RTC_DCHECK_GE(packet_bytes_, 0);
+  memory_accounting::Add(kMemorySubsystem, bytes);
 }
 
 void RtpPacketHistory::CullOldPackets(int64_t now_ms) {
   int64_t packet_duration_ms =
       std::max(kMinPacketDurationRtt * rtt_ms_, kMinPacketDurationMs);
-  while (!packet_history_.empty()) {
-    if (packet_history_.size() >= kMaxCapacity) {
+  while (packets_span_ > 0) {
+    if (packets_span_ >= kMaxCapacity) {
       // We have reached the absolute max capacity, remove one packet
       // unconditionally.
       RemovePacket(0);
       continue;
     }
 
-    const StoredPacket& stored_packet = packet_history_.front();
+    const StoredPacket& stored_packet = Slot(0);
     if (stored_packet.pending_transmission_) {
       // Don't remove packets in the pacer queue, pending tranmission.
       return;
     }
 
+    if (memory_accounting::IsOverBudget(kMemorySubsystem)) {
+      // Trim to the memory budget, even though retransmission of this packet
+      // may still be requested.
+      RemovePacket(0);
+      continue;
+    }
+
     if (*stored_packet.send_time_ms_ + packet_duration_ms > now_ms) {
       // Don't cull packets too early to avoid failed retransmission requests.
       return;
     }
 
-    if (packet_history_.size() >= number_to_store_ ||
+    if (packets_span_ >= number_to_store_ ||
         *stored_packet.send_time_ms_ +
                 (packet_duration_ms * kPacketCullingDelayFactor) <=
             now_ms) {
@@ -432,18 +467,22 @@ void RtpPacketHistory::CullOldPackets(int64_t now_ms) {
 std::unique_ptr<RtpPacketToSend> RtpPacketHistory::RemovePacket(
     int packet_index) {
   // Move the packet out from the StoredPacket container.
+  StoredPacket& stored_packet = Slot(packet_index);
   std::unique_ptr<RtpPacketToSend> rtp_packet =
-      std::move(packet_history_[packet_index].packet_);
+      std::move(stored_packet.packet_);
+  if (rtp_packet) {
+    AddPacketBytes(-static_cast<int64_t>(rtp_packet->size()));
+  }
 
   // Erase from padding priority set, if eligible.
   if (enable_padding_prio_) {
-    padding_priority_.erase(&packet_history_[packet_index]);
+    padding_priority_.erase(&stored_packet);
   }
 
   if (packet_index == 0) {
-    while (!packet_history_.empty() &&
-           packet_history_.front().packet_ == nullptr) {
-      packet_history_.pop_front();
+    while (packets_span_ > 0 && Slot(0).packet_ == nullptr) {
+      ++first_sequence_number_;
+      --packets_span_;
     }
   }
 
@@ -451,12 +490,12 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::RemovePacket(
 }
 
 int RtpPacketHistory::GetPacketIndex(uint16_t sequence_number) const {
-  if (packet_history_.empty()) {
+  if (packets_span_ == 0) {
     return 0;
   }
 
-  RTC_DCHECK(packet_history_.front().packet_ != nullptr);
-  int first_seq = packet_history_.front().packet_->SequenceNumber();
+  RTC_DCHECK(Slot(0).packet_ != nullptr);
+  int first_seq = first_sequence_number_;
   if (first_seq == sequence_number) {
     return 0;
   }
@@ -477,14 +516,65 @@ int RtpPacketHistory::GetPacketIndex(uint16_t sequence_number) const {
   return packet_index;
 }
 
+RtpPacketHistory::StoredPacket& RtpPacketHistory::Slot(size_t packet_index) {
+  RTC_DCHECK_LT(packet_index, packet_history_.size());
+  return packet_history_[(first_sequence_number_ + packet_index) &
+                         (packet_history_.size() - 1)];
+}
+
+const RtpPacketHistory::StoredPacket& RtpPacketHistory::Slot(
+    size_t packet_index) const {
+  RTC_DCHECK_LT(packet_index, packet_history_.size());
+  return packet_history_[(first_sequence_number_ + packet_index) &
+                         (packet_history_.size() - 1)];
+}
+
+void RtpPacketHistory::EnsureCapacity(size_t span) {
+  if (span <= packet_history_.size()) {
+    return;
+  }
+  // Sequence numbers wrap at a power of two, so a power-of-two ring keeps
+  // them in the same slots across the wrap.
+  size_t capacity = std::max<size_t>(packet_history_.size(), 1);
+  while (capacity < span || capacity < number_to_store_) {
+    capacity *= 2;
+  }
+  RTC_DCHECK_LE(capacity, std::numeric_limits<uint16_t>::max() + 1);
+
+  std::vector<StoredPacket> ring;
+  ring.reserve(capacity);
+  for (size_t i = 0; i < capacity; ++i) {
+    ring.emplace_back(nullptr, absl::nullopt, 0);
+  }
+  ring.swap(packet_history_);
+  // `ring` now holds the old slots; move the span over.
+  const size_t old_mask = ring.size() - 1;
+  for (size_t i = 0; i < packets_span_; ++i) {
+    Slot(i) = std::move(ring[(first_sequence_number_ + i) & old_mask]);
+  }
+
+  // The padding priority set points into the old slots.
+  if (enable_padding_prio_ && !padding_priority_.empty()) {
+    PacketPrioritySet padding_priority;
+    for (StoredPacket* old_packet : padding_priority_) {
+      size_t packet_index =
+          (static_cast<size_t>(old_packet - ring.data()) -
+           first_sequence_number_) &
+          old_mask;
+      padding_priority.insert(&Slot(packet_index));
+    }
+    padding_priority_.swap(padding_priority);
+  }
+}
+
 RtpPacketHistory::StoredPacket* RtpPacketHistory::GetStoredPacket(
     uint16_t sequence_number) {
   int index = GetPacketIndex(sequence_number);
-  if (index < 0 || static_cast<size_t>(index) >= packet_history_.size() ||
-      packet_history_[index].packet_ == nullptr) {
+  if (index < 0 || static_cast<size_t>(index) >= packets_span_ ||
+      Slot(index).packet_ == nullptr) {
     return nullptr;
   }
-  return &packet_history_[index];
+  return &Slot(index);
 }
 
 RtpPacketHistory::PacketState RtpPacketHistory::StoredPacketToPacketState(
@@ -16,6 +16,7 @@
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
 #include "system_wrappers/include/clock.h"
+#include "system_wrappers/include/memory_accounting.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
@@ -792,6 +793,39 @@ TEST_P(RtpPacketHistoryTest, OutOfOrderInsertRemoval) {
   }
 }
 
+TEST_P(RtpPacketHistoryTest, KeepsPacketsWhenGrowingBeyondHistorySize) {
+  hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, 10);
+
+  // Recently sent packets are kept beyond the history size, so the history
+  // has to grow. Insert at both ends, across the sequence number wrap.
+  const int kMaxOffset = 50;
+  for (int offset = 0; offset <= kMaxOffset; ++offset) {
+    hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum + offset)),
+                       fake_clock_.TimeInMilliseconds());
+    if (offset > 0) {
+      hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum - offset)),
+                         fake_clock_.TimeInMilliseconds());
+    }
+  }
+
+  for (int offset = -kMaxOffset; offset <= kMaxOffset; ++offset) {
+    absl::optional<RtpPacketHistory::PacketState> packet_state =
+        hist_.GetPacketState(To16u(kStartSeqNum + offset));
+    ASSERT_TRUE(packet_state.has_value());
+    EXPECT_EQ(packet_state->rtp_sequence_number, To16u(kStartSeqNum + offset));
+  }
+  EXPECT_FALSE(hist_.GetPacketState(To16u(kStartSeqNum + kMaxOffset + 1)));
+  EXPECT_FALSE(hist_.GetPacketState(To16u(kStartSeqNum - kMaxOffset - 1)));
+
+  // With prioritization the newest insert is the most useful padding,
+  // otherwise the last packet is used.
+  std::unique_ptr<RtpPacketToSend> padding = hist_.GetPayloadPaddingPacket();
+  ASSERT_TRUE(padding);
+  EXPECT_EQ(padding->SequenceNumber(),
+            To16u(GetParam() ? kStartSeqNum - kMaxOffset
+                             : kStartSeqNum + kMaxOffset));
+}
+
 TEST_P(RtpPacketHistoryTest, UsesLastPacketAsPaddingWithPrioOff) {
   if (GetParam()) {
     // Padding prioritization is enabled, ignore this test.
@@ -835,6 +869,38 @@ TEST_P(RtpPacketHistoryTest, UsesLastPacketAsPaddingWithPrioOff) {
   EXPECT_EQ(hist_.GetPayloadPaddingPacket(), nullptr);
 }
 
+TEST_P(RtpPacketHistoryTest, AccountsMemoryAndTrimsToBudget) {
+  const memory_accounting::Subsystem kSubsystem =
+      memory_accounting::Subsystem::kRtpPacketHistory;
+  const int64_t initial_bytes = memory_accounting::BytesInUse(kSubsystem);
+  hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, 100);
+
+  int64_t packet_size = 0;
+  for (int i = 0; i < 10; ++i) {
+    std::unique_ptr<RtpPacketToSend> packet =
+        CreateRtpPacket(To16u(kStartSeqNum + i));
+    packet_size = packet->size();
+    hist_.PutRtpPacket(std::move(packet), fake_clock_.TimeInMilliseconds());
+  }
+  EXPECT_EQ(memory_accounting::BytesInUse(kSubsystem),
+            initial_bytes + 10 * packet_size);
+
+  // With a budget, the oldest packets are dropped long before they would
+  // otherwise be culled.
+  memory_accounting::SetBudget(kSubsystem, initial_bytes + 5 * packet_size);
+  hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum + 10)),
+                     fake_clock_.TimeInMilliseconds());
+  memory_accounting::SetBudget(kSubsystem, absl::nullopt);
+  EXPECT_FALSE(hist_.GetPacketState(kStartSeqNum));
+  EXPECT_FALSE(hist_.GetPacketState(To16u(kStartSeqNum + 4)));
+  EXPECT_TRUE(hist_.GetPacketState(To16u(kStartSeqNum + 5)));
+  EXPECT_EQ(memory_accounting::BytesInUse(kSubsystem),
+            initial_bytes + 6 * packet_size);
+
+  hist_.Clear();
+  EXPECT_EQ(memory_accounting::BytesInUse(kSubsystem), initial_bytes);
+}
+
 INSTANTIATE_TEST_SUITE_P(WithAndWithoutPaddingPrio,
                          RtpPacketHistoryTest,
                          ::testing::Bool());
@@ -1239,5 +1239,82 @@ TEST(RtpPacketTest, RemoveExtensionFailure) {
   EXPECT_THAT(kPacketWithTO, ElementsAreArray(packet.data(), packet.size()));
 }
 
+TEST(RtpPacketTest, RemapsExtensionIdsInPlace) {
+  RtpPacketReceived::ExtensionManager from_extensions;
+  from_extensions.Register<TransmissionOffset>(kTransmissionOffsetExtensionId);
+  from_extensions.Register<AudioLevel>(kAudioLevelExtensionId);
+  RtpPacketReceived::ExtensionManager to_extensions;
+  to_extensions.Register<TransmissionOffset>(5);
+  const RtpHeaderExtensionMapTranslation translation(from_extensions,
+                                                     to_extensions);
+  EXPECT_EQ(translation.Translate(kTransmissionOffsetExtensionId), 5);
+  EXPECT_EQ(translation.Translate(kAudioLevelExtensionId),
+            RtpHeaderExtensionMap::kInvalidId);
+
+  RtpPacketReceived packet(&from_extensions);
+  ASSERT_TRUE(packet.Parse(kPacketWithTOAndAL, sizeof(kPacketWithTOAndAL)));
+  const uint8_t* const payload_data = packet.payload().data();
+  EXPECT_TRUE(packet.RemapExtensions(translation));
+  EXPECT_EQ(packet.GetExtension<TransmissionOffset>(), kTimeOffset);
+  EXPECT_FALSE(packet.HasExtension<AudioLevel>());
+
+  // Fields of the remapped packet are rewritten in place.
+  packet.SetSsrc(kSsrc + 1);
+  packet.SetSequenceNumber(kSeqNum + 1);
+  EXPECT_TRUE(packet.SetExtension<TransmissionOffset>(kTimeOffset + 1));
+  EXPECT_EQ(packet.size(), sizeof(kPacketWithTOAndAL));
+  EXPECT_EQ(packet.payload().data(), payload_data);
+
+  RtpPacketReceived forwarded(&to_extensions);
+  ASSERT_TRUE(forwarded.Parse(packet.Buffer()));
+  EXPECT_EQ(forwarded.Ssrc(), kSsrc + 1);
+  EXPECT_EQ(forwarded.SequenceNumber(), kSeqNum + 1);
+  EXPECT_EQ(forwarded.GetExtension<TransmissionOffset>(), kTimeOffset + 1);
+  // The audio level was replaced with padding.
+  EXPECT_THAT(rtc::MakeArrayView(forwarded.data() + 20, 4), Each(0));
+}
+
+TEST(RtpPacketTest, RemapsTwoByteHeaderExtensionIds) {
+  RtpPacketReceived::ExtensionManager from_extensions(
+      /*extmap_allow_mixed=*/true);
+  from_extensions.Register<TransmissionOffset>(kTransmissionOffsetExtensionId);
+  from_extensions.Register<AudioLevel>(kAudioLevelExtensionId);
+  from_extensions.Register<PlayoutDelayLimits>(kTwoByteExtensionId);
+  RtpPacketReceived::ExtensionManager to_extensions(
+      /*extmap_allow_mixed=*/true);
+  to_extensions.Register<TransmissionOffset>(kTwoByteExtensionId + 1);
+  to_extensions.Register<PlayoutDelayLimits>(2);
+
+  RtpPacketReceived packet(&from_extensions);
+  ASSERT_TRUE(packet.Parse(kPacketWithTwoByteExtensionIdLast,
+                           sizeof(kPacketWithTwoByteExtensionIdLast)));
+  EXPECT_TRUE(packet.RemapExtensions(
+      RtpHeaderExtensionMapTranslation(from_extensions, to_extensions)));
+
+  RtpPacketReceived forwarded(&to_extensions);
+  ASSERT_TRUE(forwarded.Parse(packet.Buffer()));
+  EXPECT_EQ(forwarded.GetExtension<TransmissionOffset>(), kTimeOffset);
+  EXPECT_EQ(forwarded.GetExtension<PlayoutDelayLimits>(),
+            VideoPlayoutDelay(30, 340));
+  // The audio level was replaced with padding.
+  EXPECT_THAT(rtc::MakeArrayView(forwarded.data() + 21, 3), Each(0));
+}
+
+TEST(RtpPacketTest, RemapExtensionsFailsIfIdsDontFitOneByteHeader) {
+  RtpPacketReceived::ExtensionManager from_extensions;
+  from_extensions.Register<TransmissionOffset>(kTransmissionOffsetExtensionId);
+  RtpPacketReceived::ExtensionManager to_extensions(
+      /*extmap_allow_mixed=*/true);
+  to_extensions.Register<TransmissionOffset>(kTwoByteExtensionId);
+
+  RtpPacketReceived packet(&from_extensions);
+  ASSERT_TRUE(packet.Parse(kPacketWithTO, sizeof(kPacketWithTO)));
+  EXPECT_FALSE(packet.RemapExtensions(
+      RtpHeaderExtensionMapTranslation(from_extensions, to_extensions)));
+
+  EXPECT_THAT(kPacketWithTO, ElementsAreArray(packet.data(), packet.size()));
+  EXPECT_EQ(packet.GetExtension<TransmissionOffset>(), kTimeOffset);
+}
+
 }  // namespace
 }  // namespace webrtc
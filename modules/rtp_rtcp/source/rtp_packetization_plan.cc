@@ -0,0 +1,134 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtp_packetization_plan.h"
+
+#include <string.h>
+
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+RtpPacketizationPlan::RtpPacketizationPlan(
+    rtc::ArrayView<const uint8_t> payload)
+    : payload_(payload) {}
+
+RtpPacketizationPlan::~RtpPacketizationPlan() = default;
+
+void RtpPacketizationPlan::Reserve(size_t num_packets, size_t num_fragments) {
+  packets_.reserve(num_packets);
+  fragments_.reserve(num_fragments);
+}
+
+void RtpPacketizationPlan::AddHeader(rtc::ArrayView<const uint8_t> header) {
+  if (header.empty()) {
+    return;
+  }
+  if (fragments_.size() > first_fragment_ && fragments_.back().header) {
+    // Headers are stored in order, so the header extends the last fragment.
+    fragments_.back().size += header.size();
+  } else {
+    fragments_.push_back({/*header=*/true, headers_.size(), header.size()});
+  }
+  headers_.insert(headers_.end(), header.begin(), header.end());
+  payload_size_ += header.size();
+}
+
+void RtpPacketizationPlan::AddPayload(rtc::ArrayView<const uint8_t> data) {
+  if (data.empty()) {
+    return;
+  }
+  RTC_DCHECK(data.data() >= payload_.data() &&
+             data.data() + data.size() <= payload_.data() + payload_.size());
+  const size_t offset = data.data() - payload_.data();
+  if (fragments_.size() > first_fragment_ && !fragments_.back().header &&
+      fragments_.back().offset + fragments_.back().size == offset) {
+    fragments_.back().size += data.size();
+  } else {
+    fragments_.push_back({/*header=*/false, offset, data.size()});
+  }
+  payload_size_ += data.size();
+}
+
+void RtpPacketizationPlan::FinishPacket(bool marker) {
+  packets_.push_back({first_fragment_, payload_size_, marker});
+  first_fragment_ = fragments_.size();
+  payload_size_ = 0;
+}
+
+void RtpPacketizationPlan::Clear() {
+  headers_.clear();
+  fragments_.clear();
+  packets_.clear();
+  first_fragment_ = 0;
+  payload_size_ = 0;
+  next_packet_ = 0;
+}
+
+size_t RtpPacketizationPlan::payload_size(size_t packet) const {
+  RTC_DCHECK_LT(packet, packets_.size());
+  return packets_[packet].payload_size;
+}
+
+bool RtpPacketizationPlan::marker(size_t packet) const {
+  RTC_DCHECK_LT(packet, packets_.size());
+  return packets_[packet].marker;
+}
+
+size_t RtpPacketizationPlan::num_fragments(size_t packet) const {
+  RTC_DCHECK_LT(packet, packets_.size());
+  return end_fragment(packet) - packets_[packet].first_fragment;
+}
+
+rtc::ArrayView<const uint8_t> RtpPacketizationPlan::fragment(
+    size_t packet,
+    size_t index) const {
+  RTC_DCHECK_LT(index, num_fragments(packet));
+  const Fragment& fragment =
+      fragments_[packets_[packet].first_fragment + index];
+  if (fragment.header) {
+    return rtc::MakeArrayView(&headers_[fragment.offset], fragment.size);
+  }
+  return payload_.subview(fragment.offset, fragment.size);
+}
+
+void RtpPacketizationPlan::WritePayload(size_t packet,
+                                        uint8_t* destination) const {
+  RTC_DCHECK_LT(packet, packets_.size());
+  for (size_t i = packets_[packet].first_fragment; i < end_fragment(packet);
+       ++i) {
+    const Fragment& fragment = fragments_[i];
+    const uint8_t* source = fragment.header ? &headers_[fragment.offset]
+                                            : &payload_[fragment.offset];
+    memcpy(destination, source, fragment.size);
+    destination += fragment.size;
+  }
+}
+
+bool RtpPacketizationPlan::NextPacket(RtpPacketToSend* packet) {
+  RTC_DCHECK(packet);
+  if (next_packet_ == packets_.size()) {
+    return false;
+  }
+  uint8_t* buffer = packet->AllocatePayload(payload_size(next_packet_));
+  RTC_CHECK(buffer);
+  WritePayload(next_packet_, buffer);
+  packet->SetMarker(marker(next_packet_));
+  ++next_packet_;
+  return true;
+}
+
+size_t RtpPacketizationPlan::end_fragment(size_t packet) const {
+  return packet + 1 < packets_.size() ? packets_[packet + 1].first_fragment
+                                      : first_fragment_;
+}
+
+}  // namespace webrtc
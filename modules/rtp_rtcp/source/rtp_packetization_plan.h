@@ -0,0 +1,93 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_RTP_PACKETIZATION_PLAN_H_
+#define MODULES_RTP_RTCP_SOURCE_RTP_PACKETIZATION_PLAN_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/array_view.h"
+
+namespace webrtc {
+
+class RtpPacketToSend;
+
+// The RTP payloads that a packetizer splits a frame into, computed once when
+// the packetizer is created. Each payload is a list of fragments, which are
+// either payload header bytes stored in the plan or views into the frame, so
+// that the frame is copied only when a payload is written into a packet.
+class RtpPacketizationPlan {
+ public:
+  // `payload` is the frame, which must outlive the plan.
+  explicit RtpPacketizationPlan(rtc::ArrayView<const uint8_t> payload);
+  RtpPacketizationPlan(const RtpPacketizationPlan&) = delete;
+  RtpPacketizationPlan& operator=(const RtpPacketizationPlan&) = delete;
+  ~RtpPacketizationPlan();
+
+  void Reserve(size_t num_packets, size_t num_fragments);
+
+  // Append to the payload of the next packet.
+  void AddHeader(rtc::ArrayView<const uint8_t> header);
+  // `data` must be a part of the frame.
+  void AddPayload(rtc::ArrayView<const uint8_t> data);
+  // Ends the payload of the next packet, which has the marker bit `marker`.
+  void FinishPacket(bool marker);
+  // Removes all packets, e.g. when it turns out that the frame doesn't fit.
+  void Clear();
+
+  size_t num_packets() const { return packets_.size(); }
+  size_t payload_size(size_t packet) const;
+  bool marker(size_t packet) const;
+
+  // Returns views of the payload of `packet`, which are valid as long as the
+  // plan isn't changed.
+  size_t num_fragments(size_t packet) const;
+  rtc::ArrayView<const uint8_t> fragment(size_t packet, size_t index) const;
+
+  // Writes the payload of `packet` to `destination`, which must have room
+  // for payload_size(packet) bytes.
+  void WritePayload(size_t packet, uint8_t* destination) const;
+
+  // Implements RtpPacketizer::NumPackets() and NextPacket().
+  size_t num_remaining_packets() const {
+    return packets_.size() - next_packet_;
+  }
+  bool NextPacket(RtpPacketToSend* packet);
+
+ private:
+  struct Fragment {
+    // Whether the bytes are in `headers_` rather than in `payload_`.
+    bool header;
+    size_t offset;
+    size_t size;
+  };
+  struct Packet {
+    size_t first_fragment;
+    size_t payload_size;
+    bool marker;
+  };
+
+  size_t end_fragment(size_t packet) const;
+
+  const rtc::ArrayView<const uint8_t> payload_;
+  std::vector<uint8_t> headers_;
+  std::vector<Fragment> fragments_;
+  std::vector<Packet> packets_;
+  // Of the packet being added.
+  size_t first_fragment_ = 0;
+  size_t payload_size_ = 0;
+  size_t next_packet_ = 0;
+};
+
+}  // namespace webrtc
+#endif  // MODULES_RTP_RTCP_SOURCE_RTP_PACKETIZATION_PLAN_H_
@@ -0,0 +1,119 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtp_packetization_plan.h"
+
+#include <vector>
+
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+
+constexpr uint8_t kFrame[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+constexpr uint8_t kHeader[] = {0xa0, 0xa1};
+
+std::vector<uint8_t> Payload(const RtpPacketizationPlan& plan, size_t packet) {
+  std::vector<uint8_t> payload(plan.payload_size(packet));
+  plan.WritePayload(packet, payload.data());
+  return payload;
+}
+
+TEST(RtpPacketizationPlanTest, WritesHeadersAndPayload) {
+  rtc::ArrayView<const uint8_t> frame(kFrame);
+  RtpPacketizationPlan plan(frame);
+  plan.AddHeader(kHeader);
+  plan.AddPayload(frame.subview(0, 6));
+  plan.FinishPacket(/*marker=*/false);
+  plan.AddHeader(rtc::MakeArrayView(kHeader, 1));
+  plan.AddPayload(frame.subview(6));
+  plan.FinishPacket(/*marker=*/true);
+
+  ASSERT_EQ(plan.num_packets(), 2u);
+  EXPECT_EQ(plan.payload_size(0), 8u);
+  EXPECT_FALSE(plan.marker(0));
+  EXPECT_THAT(Payload(plan, 0), ElementsAre(0xa0, 0xa1, 1, 2, 3, 4, 5, 6));
+  EXPECT_EQ(plan.payload_size(1), 5u);
+  EXPECT_TRUE(plan.marker(1));
+  EXPECT_THAT(Payload(plan, 1), ElementsAre(0xa0, 7, 8, 9, 10));
+}
+
+TEST(RtpPacketizationPlanTest, ViewsPointIntoFrame) {
+  rtc::ArrayView<const uint8_t> frame(kFrame);
+  RtpPacketizationPlan plan(frame);
+  plan.AddHeader(kHeader);
+  plan.AddPayload(frame.subview(2, 3));
+  plan.FinishPacket(/*marker=*/true);
+
+  ASSERT_EQ(plan.num_fragments(0), 2u);
+  EXPECT_THAT(plan.fragment(0, 0), ElementsAreArray(kHeader));
+  EXPECT_EQ(plan.fragment(0, 1).data(), &kFrame[2]);
+  EXPECT_EQ(plan.fragment(0, 1).size(), 3u);
+}
+
+TEST(RtpPacketizationPlanTest, MergesAdjacentFragments) {
+  rtc::ArrayView<const uint8_t> frame(kFrame);
+  RtpPacketizationPlan plan(frame);
+  plan.AddHeader(rtc::MakeArrayView(kHeader, 1));
+  plan.AddHeader(rtc::MakeArrayView(kHeader + 1, 1));
+  plan.AddPayload(frame.subview(0, 2));
+  plan.AddPayload(frame.subview(2, 2));
+  plan.AddPayload(frame.subview(5, 2));
+  plan.FinishPacket(/*marker=*/false);
+  // Fragments aren't merged across packets.
+  plan.AddPayload(frame.subview(7, 1));
+  plan.FinishPacket(/*marker=*/true);
+
+  EXPECT_EQ(plan.num_fragments(0), 3u);
+  EXPECT_THAT(Payload(plan, 0), ElementsAre(0xa0, 0xa1, 1, 2, 3, 4, 6, 7));
+  EXPECT_EQ(plan.num_fragments(1), 1u);
+  EXPECT_THAT(Payload(plan, 1), ElementsAre(8));
+}
+
+TEST(RtpPacketizationPlanTest, NextPacketWritesPacketsInOrder) {
+  rtc::ArrayView<const uint8_t> frame(kFrame);
+  RtpPacketizationPlan plan(frame);
+  plan.AddPayload(frame.subview(0, 5));
+  plan.FinishPacket(/*marker=*/false);
+  plan.AddPayload(frame.subview(5));
+  plan.FinishPacket(/*marker=*/true);
+
+  RtpPacketToSend packet(nullptr);
+  EXPECT_EQ(plan.num_remaining_packets(), 2u);
+  ASSERT_TRUE(plan.NextPacket(&packet));
+  EXPECT_THAT(packet.payload(), ElementsAre(1, 2, 3, 4, 5));
+  EXPECT_FALSE(packet.Marker());
+  ASSERT_TRUE(plan.NextPacket(&packet));
+  EXPECT_THAT(packet.payload(), ElementsAre(6, 7, 8, 9, 10));
+  EXPECT_TRUE(packet.Marker());
+  EXPECT_EQ(plan.num_remaining_packets(), 0u);
+  EXPECT_FALSE(plan.NextPacket(&packet));
+  // The plan is still there for callers that write the packets themselves.
+  EXPECT_EQ(plan.num_packets(), 2u);
+}
+
+TEST(RtpPacketizationPlanTest, Clear) {
+  rtc::ArrayView<const uint8_t> frame(kFrame);
+  RtpPacketizationPlan plan(frame);
+  plan.AddHeader(kHeader);
+  plan.AddPayload(frame);
+  plan.FinishPacket(/*marker=*/true);
+  plan.Clear();
+  EXPECT_EQ(plan.num_packets(), 0u);
+  EXPECT_EQ(plan.num_remaining_packets(), 0u);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -93,7 +93,13 @@ RtpPacketizerAv1::RtpPacketizerAv1(rtc::ArrayView<const uint8_t> payload,
     : frame_type_(frame_type),
       obus_(ParseObus(payload)),
       packets_(Packetize(obus_, limits)),
-      is_last_frame_in_picture_(is_last_frame_in_picture) {}
+      is_last_frame_in_picture_(is_last_frame_in_picture),
+      plan_(payload) {
+  plan_.Reserve(packets_.size(), 2 * (packets_.size() + obus_.size()));
+  for (size_t i = 0; i < packets_.size(); ++i) {
+    AddToPlan(i);
+  }
+}
 
 std::vector<RtpPacketizerAv1::Obu> RtpPacketizerAv1::ParseObus(
     rtc::ArrayView<const uint8_t> payload) {
@@ -316,8 +322,8 @@ std::vector<RtpPacketizerAv1::Packet> RtpPacketizerAv1::Packetize(
   return packets;
 }
 
-uint8_t RtpPacketizerAv1::AggregationHeader() const {
-  const Packet& packet = packets_[packet_index_];
+uint8_t RtpPacketizerAv1::AggregationHeader(size_t packet_index) const {
+  const Packet& packet = packets_[packet_index];
   uint8_t aggregation_header = 0;
 
   // Set Z flag: first obu element is continuation of the previous OBU.
@@ -342,7 +348,7 @@ uint8_t RtpPacketizerAv1::AggregationHeader() const {
   // Encoder may produce key frame without a sequence header, thus double check
   // incoming frame includes the sequence header. Since Temporal delimiter is
   // already filtered out, sequence header should be the first obu when present.
-  if (frame_type_ == VideoFrameType::kVideoFrameKey && packet_index_ == 0 &&
+  if (frame_type_ == VideoFrameType::kVideoFrameKey && packet_index == 0 &&
       ObuType(obus_.front().header) == kObuTypeSequenceHeader) {
     aggregation_header |= (1 << 3);
   }
@@ -350,10 +356,11 @@ uint8_t RtpPacketizerAv1::AggregationHeader() const {
 }
 
 bool RtpPacketizerAv1::NextPacket(RtpPacketToSend* packet) {
-  if (packet_index_ >= packets_.size()) {
-    return false;
-  }
-  const Packet& next_packet = packets_[packet_index_];
+  return plan_.NextPacket(packet);
+}
+
+void RtpPacketizerAv1::AddToPlan(size_t packet_index) {
+  const Packet& next_packet = packets_[packet_index];
 
   RTC_DCHECK_GT(next_packet.num_obu_elements, 0);
   RTC_DCHECK_LT(next_packet.first_obu_offset,
@@ -362,11 +369,10 @@ bool RtpPacketizerAv1::NextPacket(RtpPacketToSend* packet) {
       next_packet.last_obu_size,
       obus_[next_packet.first_obu + next_packet.num_obu_elements - 1].size);
 
-  uint8_t* const rtp_payload =
-      packet->AllocatePayload(kAggregationHeaderSize + next_packet.packet_size);
-  uint8_t* write_at = rtp_payload;
-
-  *write_at++ = AggregationHeader();
+  // Element size, OBU header and extension header.
+  uint8_t header[8];
+  uint8_t* write_at = header;
+  *write_at++ = AggregationHeader(packet_index);
 
   int obu_offset = next_packet.first_obu_offset;
   // Store all OBU elements except the last one.
@@ -380,11 +386,11 @@ bool RtpPacketizerAv1::NextPacket(RtpPacketToSend* packet) {
     if (obu_offset <= 1 && ObuHasExtension(obu.header)) {
       *write_at++ = obu.extension_header;
     }
+    plan_.AddHeader(rtc::MakeArrayView(header, write_at - header));
+    write_at = header;
     int payload_offset =
         std::max(0, obu_offset - (ObuHasExtension(obu.header) ? 2 : 1));
-    size_t payload_size = obu.payload.size() - payload_offset;
-    memcpy(write_at, obu.payload.data() + payload_offset, payload_size);
-    write_at += payload_size;
+    plan_.AddPayload(obu.payload.subview(payload_offset));
     // All obus are stored from the beginning, except, may be, the first one.
     obu_offset = 0;
   }
@@ -405,20 +411,16 @@ bool RtpPacketizerAv1::NextPacket(RtpPacketToSend* packet) {
     *write_at++ = last_obu.extension_header;
     --fragment_size;
   }
-  RTC_DCHECK_EQ(write_at - rtp_payload + fragment_size,
-                kAggregationHeaderSize + next_packet.packet_size);
+  plan_.AddHeader(rtc::MakeArrayView(header, write_at - header));
   int payload_offset =
       std::max(0, obu_offset - (ObuHasExtension(last_obu.header) ? 2 : 1));
-  memcpy(write_at, last_obu.payload.data() + payload_offset, fragment_size);
-  write_at += fragment_size;
+  plan_.AddPayload(last_obu.payload.subview(payload_offset, fragment_size));
 
-  RTC_DCHECK_EQ(write_at - rtp_payload,
+  bool is_last_packet_in_frame = packet_index == packets_.size() - 1;
+  plan_.FinishPacket(
+      /*marker=*/is_last_packet_in_frame && is_last_frame_in_picture_);
+  RTC_DCHECK_EQ(plan_.payload_size(packet_index),
                 kAggregationHeaderSize + next_packet.packet_size);
-
-  ++packet_index_;
-  bool is_last_packet_in_frame = packet_index_ == packets_.size();
-  packet->SetMarker(is_last_packet_in_frame && is_last_frame_in_picture_);
-  return true;
 }
 
 }  // namespace webrtc
@@ -19,6 +19,7 @@
 #include "api/array_view.h"
 #include "api/video/video_frame_type.h"
 #include "modules/rtp_rtcp/source/rtp_format.h"
+#include "modules/rtp_rtcp/source/rtp_packetization_plan.h"
 
 namespace webrtc {
 
@@ -30,8 +31,9 @@ class RtpPacketizerAv1 : public RtpPacketizer {
                    bool is_last_frame_in_picture);
   ~RtpPacketizerAv1() override = default;
 
-  size_t NumPackets() const override { return packets_.size() - packet_index_; }
+  size_t NumPackets() const override { return plan_.num_remaining_packets(); }
   bool NextPacket(RtpPacketToSend* packet) override;
+  const RtpPacketizationPlan* plan() const override { return &plan_; }
 
  private:
   struct Obu {
@@ -59,13 +61,15 @@ class RtpPacketizerAv1 : public RtpPacketizer {
   static int AdditionalBytesForPreviousObuElement(const Packet& packet);
   static std::vector<Packet> Packetize(rtc::ArrayView<const Obu> obus,
                                        PayloadSizeLimits limits);
-  uint8_t AggregationHeader() const;
+  uint8_t AggregationHeader(size_t packet_index) const;
+  // Adds the packet at `packet_index` in `packets_` to `plan_`.
+  void AddToPlan(size_t packet_index);
 
   const VideoFrameType frame_type_;
   const std::vector<Obu> obus_;
   const std::vector<Packet> packets_;
   const bool is_last_frame_in_picture_;
-  size_t packet_index_ = 0;
+  RtpPacketizationPlan plan_;
 };
 
 }  // namespace webrtc
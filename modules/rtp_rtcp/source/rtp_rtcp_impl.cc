@@ -439,6 +439,10 @@ bool ModuleRtpRtcpImpl::TrySendPacket(RtpPacketToSend* packet,
   return true;
 }
 
+void ModuleRtpRtcpImpl::OnBatchComplete() {
+  // Batched sending not supported in deprecated RTP module.
+}
+
 void ModuleRtpRtcpImpl::SetFecProtectionParams(const FecProtectionParams&,
                                                const FecProtectionParams&) {
   // Deferred FEC not supported in deprecated RTP module.
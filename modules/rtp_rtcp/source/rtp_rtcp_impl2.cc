@@ -88,6 +88,7 @@ ModuleRtpRtcpImpl2::ModuleRtpRtcpImpl2(const Configuration& configuration)
       nack_last_seq_number_sent_(0),
       remote_bitrate_(configuration.remote_bitrate_estimator),
       rtt_stats_(configuration.rtt_stats),
+      timer_group_(configuration.timer_group),
       rtt_ms_(0) {
   RTC_DCHECK(worker_queue_);
   rtcp_thread_checker_.Detach();
@@ -104,15 +105,21 @@ ModuleRtpRtcpImpl2::ModuleRtpRtcpImpl2(const Configuration& configuration)
   // webrtc::VideoSendStream::Config::Rtp::kDefaultMaxPacketSize.
   const size_t kTcpOverIpv4HeaderSize = 40;
   SetMaxRtpPacketSize(IP_PACKET_SIZE - kTcpOverIpv4HeaderSize);
-  rtt_update_task_ = RepeatingTaskHandle::DelayedStart(
-      worker_queue_, kRttUpdateInterval, [this]() {
-        PeriodicUpdate();
-        return kRttUpdateInterval;
-      });
+  if (timer_group_) {
+    timer_group_->AddMember(this);
+  } else {
+    rtt_update_task_ = RepeatingTaskHandle::DelayedStart(
+        worker_queue_, kRttUpdateInterval, [this]() {
+          PeriodicUpdate();
+          return kRttUpdateInterval;
+        });
+  }
 }
 
 ModuleRtpRtcpImpl2::~ModuleRtpRtcpImpl2() {
   RTC_DCHECK_RUN_ON(worker_queue_);
+  if (timer_group_)
+    timer_group_->RemoveMember(this);
   rtt_update_task_.Stop();
 }
 
@@ -377,6 +384,12 @@ bool ModuleRtpRtcpImpl2::TrySendPacket(RtpPacketToSend* packet,
   return true;
 }
 
+void ModuleRtpRtcpImpl2::OnBatchComplete() {
+  RTC_DCHECK(rtp_sender_);
+  RTC_DCHECK_RUN_ON(&rtp_sender_->sequencing_checker);
+  rtp_sender_->packet_sender.OnBatchComplete();
+}
+
 void ModuleRtpRtcpImpl2::SetFecProtectionParams(
     const FecProtectionParams& delta_params,
     const FecProtectionParams& key_params) {
@@ -787,6 +800,16 @@ void ModuleRtpRtcpImpl2::MaybeSendRtcp() {
     rtcp_sender_.SendRTCP(GetFeedbackState(), kRtcpReport);
 }
 
+void ModuleRtpRtcpImpl2::OnPeriodicUpdate() {
+  RTC_DCHECK_RUN_ON(worker_queue_);
+  PeriodicUpdate();
+}
+
+void ModuleRtpRtcpImpl2::OnRtcpTimer() {
+  RTC_DCHECK_RUN_ON(worker_queue_);
+  MaybeSendRtcp();
+}
+
 // TODO(bugs.webrtc.org/12889): Consider removing this function when the issue
 // is resolved.
 // RTC_RUN_ON(worker_queue_);
@@ -828,6 +851,10 @@ void ModuleRtpRtcpImpl2::ScheduleMaybeSendRtcpAtOrAfterTimestamp(
   // the RTCPSender lock is held.
   // See note in ScheduleRtcpSendEvaluation about why `worker_queue_` can be
   // accessed.
+  if (timer_group_) {
+    timer_group_->ScheduleRtcp(this, execution_time);
+    return;
+  }
   worker_queue_->PostDelayedTask(
       ToQueuedTask(task_safety_,
                    [this, execution_time] {
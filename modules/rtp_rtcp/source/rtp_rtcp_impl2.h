@@ -34,6 +34,7 @@
 #include "modules/rtp_rtcp/source/rtcp_sender.h"
 #include "modules/rtp_rtcp/source/rtp_packet_history.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "modules/rtp_rtcp/source/rtp_rtcp_timer_group.h"
 #include "modules/rtp_rtcp/source/rtp_sender.h"
 #include "modules/rtp_rtcp/source/rtp_sender_egress.h"
 #include "rtc_base/gtest_prod_util.h"
@@ -51,7 +52,8 @@ struct PacedPacketInfo;
 struct RTPVideoHeader;
 
 class ModuleRtpRtcpImpl2 final : public RtpRtcpInterface,
-                                 public RTCPReceiver::ModuleRtpRtcp {
+                                 public RTCPReceiver::ModuleRtpRtcp,
+                                 private RtpRtcpTimerGroup::Member {
  public:
   explicit ModuleRtpRtcpImpl2(
       const RtpRtcpInterface::Configuration& configuration);
@@ -152,6 +154,8 @@ class ModuleRtpRtcpImpl2 final : public RtpRtcpInterface,
   bool TrySendPacket(RtpPacketToSend* packet,
                      const PacedPacketInfo& pacing_info) override;
 
+  void OnBatchComplete() override;
+
   void SetFecProtectionParams(const FecProtectionParams& delta_params,
                               const FecProtectionParams& key_params) override;
 
@@ -288,6 +292,10 @@ class ModuleRtpRtcpImpl2 final : public RtpRtcpInterface,
   // check if we need to send RTCP report, send TMMBR updates and fire events.
   void PeriodicUpdate();
 
+  // RtpRtcpTimerGroup::Member, used when the module has a `timer_group_`.
+  void OnPeriodicUpdate() override;
+  void OnRtcpTimer() override;
+
   // Returns true if the module is configured to store packets.
   bool StorePackets() const;
 
@@ -326,6 +334,7 @@ class ModuleRtpRtcpImpl2 final : public RtpRtcpInterface,
   RemoteBitrateEstimator* const remote_bitrate_;
 
   RtcpRttStats* const rtt_stats_;
+  RtpRtcpTimerGroup* const timer_group_;
   RepeatingTaskHandle rtt_update_task_ RTC_GUARDED_BY(worker_queue_);
 
   // The processed RTT from RtcpRttStats.
@@ -38,6 +38,7 @@ class RateLimiter;
 class RemoteBitrateEstimator;
 class RtcEventLog;
 class RTPSender;
+class RtpRtcpTimerGroup;
 class Transport;
 class VideoBitrateAllocationObserver;
 
@@ -104,6 +105,18 @@ class RtpRtcpInterface : public RtcpFeedbackSenderInterface {
 
     int rtcp_report_interval_ms = 0;
 
+    // Maximum number of report blocks in each compound RTCP packet, for a
+    // module that reports on many incoming streams. Blocks past the first 31
+    // are sent in additional receiver reports. 0 means 31: with more incoming
+    // streams than that, each report covers 31 of them in turn.
+    size_t rtcp_max_report_blocks = 0;
+
+    // If set, the periodic updates and RTCP reports of the module run from
+    // the timers of this group, shared with the other modules on the same
+    // worker queue, rather than from tasks of its own. Must outlive the
+    // module. Only used by ModuleRtpRtcpImpl2.
+    RtpRtcpTimerGroup* timer_group = nullptr;
+
     // Update network2 instead of pacer_exit field of video timing extension.
     bool populate_network2_timestamp = false;
 
@@ -325,6 +338,10 @@ class RtpRtcpInterface : public RtcpFeedbackSenderInterface {
   virtual bool TrySendPacket(RtpPacketToSend* packet,
                              const PacedPacketInfo& pacing_info) = 0;
 
+  // Called by the pacer after the last packet of a burst sent via
+  // TrySendPacket(), so that the transport can send them as one batch.
+  virtual void OnBatchComplete() = 0;
+
   // Update the FEC protection parameters to use for delta- and key-frames.
   // Only used when deferred FEC is active.
   virtual void SetFecProtectionParams(
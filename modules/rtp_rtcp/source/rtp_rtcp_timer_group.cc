@@ -0,0 +1,134 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtp_rtcp_timer_group.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/task_utils/to_queued_task.h"
+
+namespace webrtc {
+
+constexpr TimeDelta RtpRtcpTimerGroup::kDefaultRtcpResolution;
+constexpr TimeDelta RtpRtcpTimerGroup::kPeriodicUpdateInterval;
+
+RtpRtcpTimerGroup::RtpRtcpTimerGroup(TaskQueueBase* worker_queue,
+                                     Clock* clock,
+                                     TimeDelta rtcp_resolution)
+    : worker_queue_(worker_queue),
+      clock_(clock),
+      rtcp_resolution_(rtcp_resolution) {
+  RTC_DCHECK(worker_queue_);
+  RTC_DCHECK_GT(rtcp_resolution_, TimeDelta::Zero());
+}
+
+RtpRtcpTimerGroup::~RtpRtcpTimerGroup() {
+  RTC_DCHECK_RUN_ON(worker_queue_);
+  RTC_DCHECK(members_.empty());
+  periodic_update_task_.Stop();
+}
+
+void RtpRtcpTimerGroup::AddMember(Member* member) {
+  RTC_DCHECK_RUN_ON(worker_queue_);
+  bool inserted = members_.insert(member).second;
+  RTC_DCHECK(inserted);
+  if (!periodic_update_task_.Running()) {
+    periodic_update_task_ = RepeatingTaskHandle::DelayedStart(
+        worker_queue_, kPeriodicUpdateInterval, [this] {
+          OnPeriodicUpdate();
+          return kPeriodicUpdateInterval;
+        });
+  }
+}
+
+void RtpRtcpTimerGroup::RemoveMember(Member* member) {
+  RTC_DCHECK_RUN_ON(worker_queue_);
+  size_t removed = members_.erase(member);
+  RTC_DCHECK_EQ(removed, 1);
+  if (members_.empty()) {
+    periodic_update_task_.Stop();
+  }
+  MutexLock lock(&mutex_);
+  rtcp_times_.erase(member);
+}
+
+void RtpRtcpTimerGroup::ScheduleRtcp(Member* member, Timestamp at_time) {
+  MutexLock lock(&mutex_);
+  rtcp_times_.insert_or_assign(member, at_time);
+  MaybeStartTimer(at_time);
+}
+
+size_t RtpRtcpTimerGroup::num_members() const {
+  RTC_DCHECK_RUN_ON(worker_queue_);
+  return members_.size();
+}
+
+void RtpRtcpTimerGroup::MaybeStartTimer(Timestamp at_time) {
+  const int64_t resolution_us = rtcp_resolution_.us();
+  const Timestamp wakeup_time = Timestamp::Micros(
+      (at_time.us() + resolution_us - 1) / resolution_us * resolution_us);
+  if (wakeup_time >= next_wakeup_)
+    return;
+  next_wakeup_ = wakeup_time;
+  // Round the delay up, so that the task doesn't run before `wakeup_time`.
+  const TimeDelta delay =
+      std::max(wakeup_time - clock_->CurrentTime(), TimeDelta::Zero());
+  worker_queue_->PostDelayedTask(
+      ToQueuedTask(task_safety_,
+                   [this, wakeup_time] { OnTimer(wakeup_time); }),
+      (delay.us() + 999) / 1000);
+}
+
+void RtpRtcpTimerGroup::OnTimer(Timestamp wakeup_time) {
+  RTC_DCHECK_RUN_ON(worker_queue_);
+  std::vector<Member*> due;
+  {
+    MutexLock lock(&mutex_);
+    if (wakeup_time != next_wakeup_)
+      return;
+    next_wakeup_ = Timestamp::PlusInfinity();
+    // The task may run early, then nothing is due and it is simply posted
+    // again.
+    const Timestamp now = clock_->CurrentTime();
+    Timestamp next_time = Timestamp::PlusInfinity();
+    EraseIf(rtcp_times_, [&](const std::pair<Member*, Timestamp>& entry) {
+      if (entry.second <= now) {
+        due.push_back(entry.first);
+        return true;
+      }
+      next_time = std::min(next_time, entry.second);
+      return false;
+    });
+    if (next_time.IsFinite())
+      MaybeStartTimer(next_time);
+  }
+  // The lock is not held while the members run: sending RTCP schedules the
+  // next report.
+  for (Member* member : due) {
+    // An earlier member may have removed another one.
+    if (members_.contains(member))
+      member->OnRtcpTimer();
+  }
+}
+
+void RtpRtcpTimerGroup::OnPeriodicUpdate() {
+  RTC_DCHECK_RUN_ON(worker_queue_);
+  // Members may be removed by the updates.
+  const std::vector<Member*> members(members_.begin(), members_.end());
+  for (Member* member : members) {
+    if (members_.contains(member))
+      member->OnPeriodicUpdate();
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,101 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_RTP_RTCP_TIMER_GROUP_H_
+#define MODULES_RTP_RTCP_SOURCE_RTP_RTCP_TIMER_GROUP_H_
+
+#include <stddef.h>
+
+#include "api/sequence_checker.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/containers/flat_map.h"
+#include "rtc_base/containers/flat_set.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/system/no_unique_address.h"
+#include "rtc_base/task_utils/pending_task_safety_flag.h"
+#include "rtc_base/task_utils/repeating_task.h"
+#include "rtc_base/thread_annotations.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+// Runs the timers of many RTP/RTCP modules on one worker queue, for a sender
+// such as an SFU that fans one source out over hundreds of streams. Each
+// ModuleRtpRtcpImpl2 otherwise posts its own once-a-second update task and a
+// delayed task for every RTCP report it schedules. In a group the periodic
+// updates of all members run from one repeating task, and RTCP send times are
+// rounded up to a grid of `rtcp_resolution`, so that the reports of many
+// members are sent from a single wake-up.
+//
+// The group must outlive its members.
+class RtpRtcpTimerGroup {
+ public:
+  static constexpr TimeDelta kDefaultRtcpResolution = TimeDelta::Millis(10);
+  static constexpr TimeDelta kPeriodicUpdateInterval = TimeDelta::Seconds(1);
+
+  class Member {
+   public:
+    // Called every `kPeriodicUpdateInterval` on the worker queue.
+    virtual void OnPeriodicUpdate() = 0;
+    // Called on the worker queue at or after the time passed to the last
+    // ScheduleRtcp() of the member.
+    virtual void OnRtcpTimer() = 0;
+
+   protected:
+    virtual ~Member() = default;
+  };
+
+  RtpRtcpTimerGroup(TaskQueueBase* worker_queue,
+                    Clock* clock,
+                    TimeDelta rtcp_resolution = kDefaultRtcpResolution);
+  ~RtpRtcpTimerGroup();
+
+  RtpRtcpTimerGroup(const RtpRtcpTimerGroup&) = delete;
+  RtpRtcpTimerGroup& operator=(const RtpRtcpTimerGroup&) = delete;
+
+  // Must be called on the worker queue. A removed member gets no more calls,
+  // including for RTCP it had scheduled.
+  void AddMember(Member* member);
+  void RemoveMember(Member* member);
+
+  // Schedules OnRtcpTimer() of `member` at or after `at_time`, replacing
+  // the time of an earlier call. May be called on any sequence.
+  void ScheduleRtcp(Member* member, Timestamp at_time);
+
+  size_t num_members() const;
+
+ private:
+  // Makes sure that the timer runs no later than the grid point at or after
+  // `at_time`.
+  void MaybeStartTimer(Timestamp at_time) RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void OnTimer(Timestamp wakeup_time);
+  void OnPeriodicUpdate();
+
+  TaskQueueBase* const worker_queue_;
+  Clock* const clock_;
+  const TimeDelta rtcp_resolution_;
+
+  flat_set<Member*> members_ RTC_GUARDED_BY(worker_queue_);
+  RepeatingTaskHandle periodic_update_task_ RTC_GUARDED_BY(worker_queue_);
+
+  mutable Mutex mutex_;
+  flat_map<Member*, Timestamp> rtcp_times_ RTC_GUARDED_BY(mutex_);
+  // The time of the pending timer task, if any. Earlier tasks whose time no
+  // longer matches do nothing when they run.
+  Timestamp next_wakeup_ RTC_GUARDED_BY(mutex_) = Timestamp::PlusInfinity();
+
+  RTC_NO_UNIQUE_ADDRESS ScopedTaskSafety task_safety_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_RTP_RTCP_TIMER_GROUP_H_
@@ -0,0 +1,189 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtp_rtcp_timer_group.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/call/transport.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtp_rtcp_impl2.h"
+#include "modules/rtp_rtcp/source/rtp_rtcp_interface.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+#include "test/time_controller/simulated_time_controller.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+// A multiple of the default resolution.
+constexpr Timestamp kStartTime = Timestamp::Seconds(10000);
+
+class FakeMember : public RtpRtcpTimerGroup::Member {
+ public:
+  explicit FakeMember(Clock* clock) : clock_(clock) {}
+
+  void OnPeriodicUpdate() override { ++periodic_updates_; }
+  void OnRtcpTimer() override {
+    rtcp_times_.push_back(clock_->CurrentTime());
+  }
+
+  int periodic_updates() const { return periodic_updates_; }
+  const std::vector<Timestamp>& rtcp_times() const { return rtcp_times_; }
+
+ private:
+  Clock* const clock_;
+  int periodic_updates_ = 0;
+  std::vector<Timestamp> rtcp_times_;
+};
+
+class RtpRtcpTimerGroupTest : public ::testing::Test {
+ protected:
+  RtpRtcpTimerGroupTest()
+      : time_controller_(kStartTime),
+        group_(time_controller_.GetMainThread(), time_controller_.GetClock()),
+        member1_(time_controller_.GetClock()),
+        member2_(time_controller_.GetClock()) {
+    group_.AddMember(&member1_);
+    group_.AddMember(&member2_);
+  }
+
+  ~RtpRtcpTimerGroupTest() override {
+    if (group_.num_members() > 0) {
+      group_.RemoveMember(&member1_);
+      group_.RemoveMember(&member2_);
+    }
+  }
+
+  GlobalSimulatedTimeController time_controller_;
+  RtpRtcpTimerGroup group_;
+  FakeMember member1_;
+  FakeMember member2_;
+};
+
+TEST_F(RtpRtcpTimerGroupTest, RunsPeriodicUpdateOfAllMembersEverySecond) {
+  time_controller_.AdvanceTime(TimeDelta::Millis(999));
+  EXPECT_EQ(member1_.periodic_updates(), 0);
+  time_controller_.AdvanceTime(TimeDelta::Millis(1));
+  EXPECT_EQ(member1_.periodic_updates(), 1);
+  EXPECT_EQ(member2_.periodic_updates(), 1);
+  time_controller_.AdvanceTime(TimeDelta::Seconds(2));
+  EXPECT_EQ(member1_.periodic_updates(), 3);
+  EXPECT_EQ(member2_.periodic_updates(), 3);
+}
+
+TEST_F(RtpRtcpTimerGroupTest, SendsRtcpOfMembersFromSharedWakeup) {
+  group_.ScheduleRtcp(&member1_, kStartTime + TimeDelta::Millis(3));
+  group_.ScheduleRtcp(&member2_, kStartTime + TimeDelta::Millis(7));
+  time_controller_.AdvanceTime(TimeDelta::Millis(9));
+  EXPECT_THAT(member1_.rtcp_times(), IsEmpty());
+  EXPECT_THAT(member2_.rtcp_times(), IsEmpty());
+  time_controller_.AdvanceTime(TimeDelta::Millis(1));
+  EXPECT_THAT(member1_.rtcp_times(),
+              ElementsAre(kStartTime + TimeDelta::Millis(10)));
+  EXPECT_THAT(member2_.rtcp_times(),
+              ElementsAre(kStartTime + TimeDelta::Millis(10)));
+}
+
+TEST_F(RtpRtcpTimerGroupTest, SendsRtcpAtTheNextGridPointOnly) {
+  group_.ScheduleRtcp(&member1_, kStartTime + TimeDelta::Millis(5));
+  group_.ScheduleRtcp(&member2_, kStartTime + TimeDelta::Millis(25));
+  time_controller_.AdvanceTime(TimeDelta::Millis(100));
+  EXPECT_THAT(member1_.rtcp_times(),
+              ElementsAre(kStartTime + TimeDelta::Millis(10)));
+  EXPECT_THAT(member2_.rtcp_times(),
+              ElementsAre(kStartTime + TimeDelta::Millis(30)));
+}
+
+TEST_F(RtpRtcpTimerGroupTest, LaterScheduleReplacesEarlierOne) {
+  group_.ScheduleRtcp(&member1_, kStartTime + TimeDelta::Millis(20));
+  group_.ScheduleRtcp(&member1_, kStartTime + TimeDelta::Millis(50));
+  time_controller_.AdvanceTime(TimeDelta::Millis(100));
+  EXPECT_THAT(member1_.rtcp_times(),
+              ElementsAre(kStartTime + TimeDelta::Millis(50)));
+}
+
+TEST_F(RtpRtcpTimerGroupTest, EarlierScheduleReplacesLaterOne) {
+  group_.ScheduleRtcp(&member1_, kStartTime + TimeDelta::Millis(50));
+  group_.ScheduleRtcp(&member1_, kStartTime + TimeDelta::Millis(20));
+  time_controller_.AdvanceTime(TimeDelta::Millis(100));
+  EXPECT_THAT(member1_.rtcp_times(),
+              ElementsAre(kStartTime + TimeDelta::Millis(20)));
+}
+
+TEST_F(RtpRtcpTimerGroupTest, RemovedMemberIsNotCalled) {
+  group_.ScheduleRtcp(&member1_, kStartTime + TimeDelta::Millis(10));
+  group_.ScheduleRtcp(&member2_, kStartTime + TimeDelta::Millis(10));
+  group_.RemoveMember(&member1_);
+  time_controller_.AdvanceTime(TimeDelta::Seconds(1));
+  EXPECT_THAT(member1_.rtcp_times(), IsEmpty());
+  EXPECT_EQ(member1_.periodic_updates(), 0);
+  EXPECT_THAT(member2_.rtcp_times(),
+              ElementsAre(kStartTime + TimeDelta::Millis(10)));
+  EXPECT_EQ(member2_.periodic_updates(), 1);
+  group_.RemoveMember(&member2_);
+}
+
+class CountingTransport : public Transport {
+ public:
+  bool SendRtp(const uint8_t* packet,
+               size_t length,
+               const PacketOptions& options) override {
+    return true;
+  }
+  bool SendRtcp(const uint8_t* packet, size_t length) override {
+    ++rtcp_packets_;
+    return true;
+  }
+
+  int rtcp_packets() const { return rtcp_packets_; }
+
+ private:
+  int rtcp_packets_ = 0;
+};
+
+TEST(RtpRtcpTimerGroupModuleTest, ModulesInGroupSendRtcpReports) {
+  GlobalSimulatedTimeController time_controller(kStartTime);
+  RtpRtcpTimerGroup group(time_controller.GetMainThread(),
+                          time_controller.GetClock());
+  constexpr int kNumModules = 10;
+  std::vector<CountingTransport> transports(kNumModules);
+  std::vector<std::unique_ptr<ModuleRtpRtcpImpl2>> modules;
+  for (int i = 0; i < kNumModules; ++i) {
+    RtpRtcpInterface::Configuration config;
+    config.clock = time_controller.GetClock();
+    config.outgoing_transport = &transports[i];
+    config.local_media_ssrc = 1000 + i;
+    config.rtcp_report_interval_ms = 1000;
+    config.timer_group = &group;
+    modules.push_back(ModuleRtpRtcpImpl2::Create(config));
+    modules.back()->SetRTCPStatus(RtcpMode::kCompound);
+  }
+  EXPECT_EQ(group.num_members(), size_t{kNumModules});
+
+  time_controller.AdvanceTime(TimeDelta::Seconds(10));
+  for (const CountingTransport& transport : transports) {
+    // About one report a second, with the interval randomized.
+    EXPECT_GE(transport.rtcp_packets(), 7);
+    EXPECT_LE(transport.rtcp_packets(), 15);
+  }
+
+  modules.clear();
+  EXPECT_EQ(group.num_members(), 0u);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -229,6 +229,7 @@ bool RTPSender::RegisterRtpHeaderExtension(absl::string_view uri, int id) {
   MutexLock lock(&send_mutex_);
   bool registered = rtp_header_extension_map_.RegisterByUri(id, uri);
   supports_bwe_extension_ = HasBweExtension(rtp_header_extension_map_);
+  UpdateRtxCopiedExtensions();
   UpdateHeaderSizes();
   return registered;
 }
@@ -242,6 +243,7 @@ void RTPSender::DeregisterRtpHeaderExtension(absl::string_view uri) {
   MutexLock lock(&send_mutex_);
   rtp_header_extension_map_.Deregister(uri);
   supports_bwe_extension_ = HasBweExtension(rtp_header_extension_map_);
+  UpdateRtxCopiedExtensions();
   UpdateHeaderSizes();
 }
 
@@ -280,6 +282,19 @@ void RTPSender::SetRtxPayloadType(int payload_type,
 }
 
 int32_t RTPSender::ReSendPacket(uint16_t packet_id) {
+  const bool rtx = (RtxStatus() & kRtxRetransmitted) > 0;
+  std::vector<std::unique_ptr<RtpPacketToSend>> packets;
+  const int32_t packet_size = PrepareRetransmission(packet_id, rtx, &packets);
+  if (!packets.empty()) {
+    paced_sender_->EnqueuePackets(std::move(packets));
+  }
+  return packet_size;
+}
+
+int32_t RTPSender::PrepareRetransmission(
+    uint16_t packet_id,
+    bool rtx,
+    std::vector<std::unique_ptr<RtpPacketToSend>>* packets) {
   // Try to find packet in RTP packet history. Also verify RTT here, so that we
   // don't retransmit too often.
   absl::optional<RtpPacketHistory::PacketState> stored_packet =
@@ -290,7 +305,6 @@ int32_t RTPSender::ReSendPacket(uint16_t packet_id) {
   }
 
   const int32_t packet_size = static_cast<int32_t>(stored_packet->packet_size);
-  const bool rtx = (RtxStatus() & kRtxRetransmitted) > 0;
 
   std::unique_ptr<RtpPacketToSend> packet =
       packet_history_->GetPacketAndMarkAsPending(
@@ -320,9 +334,7 @@ int32_t RTPSender::ReSendPacket(uint16_t packet_id) {
   }
   packet->set_packet_type(RtpPacketMediaType::kRetransmission);
   packet->set_fec_protect_packet(false);
-  std::vector<std::unique_ptr<RtpPacketToSend>> packets;
-  packets.emplace_back(std::move(packet));
-  paced_sender_->EnqueuePackets(std::move(packets));
+  packets->push_back(std::move(packet));
 
   return packet_size;
 }
@@ -350,8 +362,13 @@ void RTPSender::OnReceivedNack(
     const std::vector<uint16_t>& nack_sequence_numbers,
     int64_t avg_rtt) {
   packet_history_->SetRtt(5 + avg_rtt);
+  const bool rtx = (RtxStatus() & kRtxRetransmitted) > 0;
+  // The retransmissions are handed to the pacer in one batch, so a large NACK
+  // doesn't take the pacer's lock once per packet.
+  std::vector<std::unique_ptr<RtpPacketToSend>> packets;
+  packets.reserve(nack_sequence_numbers.size());
   for (uint16_t seq_no : nack_sequence_numbers) {
-    const int32_t bytes_sent = ReSendPacket(seq_no);
+    const int32_t bytes_sent = PrepareRetransmission(seq_no, rtx, &packets);
     if (bytes_sent < 0) {
       // Failed to send one Sequence number. Give up the rest in this nack.
       RTC_LOG(LS_WARNING) << "Failed resending RTP packet " << seq_no
@@ -359,6 +376,9 @@ void RTPSender::OnReceivedNack(
       break;
     }
   }
+  if (!packets.empty()) {
+    paced_sender_->EnqueuePackets(std::move(packets));
+  }
 }
 
 bool RTPSender::SupportsPadding() const {
@@ -608,8 +628,10 @@ void RTPSender::SetCsrcs(const std::vector<uint32_t>& csrcs) {
   UpdateHeaderSizes();
 }
 
-static void CopyHeaderAndExtensionsToRtxPacket(const RtpPacketToSend& packet,
-                                               RtpPacketToSend* rtx_packet) {
+static void CopyHeaderAndExtensionsToRtxPacket(
+    const RtpPacketToSend& packet,
+    rtc::ArrayView<const RTPExtensionType> extensions,
+    RtpPacketToSend* rtx_packet) {
   // Set the relevant fixed packet headers. The following are not set:
   // * Payload type - it is replaced in rtx packets.
   // * Sequence number - RTX has a separate sequence numbering.
@@ -622,18 +644,7 @@ static void CopyHeaderAndExtensionsToRtxPacket(const RtpPacketToSend& packet,
   // * Header extensions - replace Rid header with RepairedRid header.
   const std::vector<uint32_t> csrcs = packet.Csrcs();
   rtx_packet->SetCsrcs(csrcs);
-  for (int extension_num = kRtpExtensionNone + 1;
-       extension_num < kRtpExtensionNumberOfExtensions; ++extension_num) {
-    auto extension = static_cast<RTPExtensionType>(extension_num);
-
-    // Stream ID header extensions (MID, RSID) are sent per-SSRC. Since RTX
-    // operates on a different SSRC, the presence and values of these header
-    // extensions should be determined separately and not blindly copied.
-    if (extension == kRtpExtensionMid ||
-        extension == kRtpExtensionRtpStreamId) {
-      continue;
-    }
-
+  for (RTPExtensionType extension : extensions) {
     // Empty extensions should be supported, so not checking `source.empty()`.
     if (!packet.HasExtension(extension)) {
       continue;
@@ -681,7 +692,8 @@ std::unique_ptr<RtpPacketToSend> RTPSender::BuildRtxPacket(
     // Replace SSRC.
     rtx_packet->SetSsrc(*rtx_ssrc_);
 
-    CopyHeaderAndExtensionsToRtxPacket(packet, rtx_packet.get());
+    CopyHeaderAndExtensionsToRtxPacket(packet, rtx_copied_extensions_,
+                                       rtx_packet.get());
 
     // RTX packets are sent on an SSRC different from the main media, so the
     // decision to attach MID and/or RRID header extensions is completely
@@ -756,6 +768,26 @@ RtpState RTPSender::GetRtxRtpState() const {
   return state;
 }
 
+void RTPSender::UpdateRtxCopiedExtensions() {
+  rtx_copied_extensions_.clear();
+  for (int extension_num = kRtpExtensionNone + 1;
+       extension_num < kRtpExtensionNumberOfExtensions; ++extension_num) {
+    auto extension = static_cast<RTPExtensionType>(extension_num);
+
+    // Stream ID header extensions (MID, RSID) are sent per-SSRC. Since RTX
+    // operates on a different SSRC, the presence and values of these header
+    // extensions should be determined separately and not blindly copied.
+    if (extension == kRtpExtensionMid ||
+        extension == kRtpExtensionRtpStreamId) {
+      continue;
+    }
+    // Extensions that aren't registered can't be written to the RTX packet.
+    if (rtp_header_extension_map_.IsRegistered(extension)) {
+      rtx_copied_extensions_.push_back(extension);
+    }
+  }
+}
+
 void RTPSender::UpdateHeaderSizes() {
   const size_t rtp_header_length =
       kRtpHeaderLength + sizeof(uint32_t) * csrcs_.size();
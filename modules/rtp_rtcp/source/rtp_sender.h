@@ -171,8 +171,19 @@ class RTPSender {
   std::unique_ptr<RtpPacketToSend> BuildRtxPacket(
       const RtpPacketToSend& packet);
 
+  // Takes the packet with `packet_id` from the history for retransmission,
+  // as RTX if `rtx` is set, and appends it to `packets`. Returns the same as
+  // ReSendPacket().
+  int32_t PrepareRetransmission(
+      uint16_t packet_id,
+      bool rtx,
+      std::vector<std::unique_ptr<RtpPacketToSend>>* packets)
+      RTC_LOCKS_EXCLUDED(send_mutex_);
+
   bool IsFecPacket(const RtpPacketToSend& packet) const;
 
+  void UpdateRtxCopiedExtensions() RTC_EXCLUSIVE_LOCKS_REQUIRED(send_mutex_);
+
   void UpdateHeaderSizes() RTC_EXCLUSIVE_LOCKS_REQUIRED(send_mutex_);
 
   void UpdateLastPacketState(const RtpPacketToSend& packet)
@@ -201,6 +212,10 @@ class RTPSender {
   RtpHeaderExtensionMap rtp_header_extension_map_ RTC_GUARDED_BY(send_mutex_);
   size_t max_media_packet_header_ RTC_GUARDED_BY(send_mutex_);
   size_t max_padding_fec_packet_header_ RTC_GUARDED_BY(send_mutex_);
+  // Registered header extensions that are copied from a media packet to its
+  // RTX packet, so building one doesn't probe every extension type.
+  std::vector<RTPExtensionType> rtx_copied_extensions_
+      RTC_GUARDED_BY(send_mutex_);
 
   // RTP variables
   uint32_t timestamp_offset_ RTC_GUARDED_BY(send_mutex_);
@@ -56,6 +56,8 @@ void RtpSenderEgress::NonPacedPacketSender::EnqueuePackets(
   auto fec_packets = sender_->FetchFecPackets();
   if (!fec_packets.empty()) {
     EnqueuePackets(std::move(fec_packets));
+  } else {
+    sender_->OnBatchComplete();
   }
 }
 
@@ -262,6 +264,9 @@ void RtpSenderEgress::SendPacket(RtpPacketToSend* packet,
   }
 
   options.additional_data = packet->additional_data();
+  // Both the pacer and NonPacedPacketSender call OnBatchComplete() after
+  // the packets they send.
+  options.batchable = true;
 
   if (packet->packet_type() != RtpPacketMediaType::kPadding &&
       packet->packet_type() != RtpPacketMediaType::kRetransmission) {
@@ -329,6 +334,13 @@ void RtpSenderEgress::GetDataCounters(StreamDataCounters* rtp_stats,
   *rtx_stats = rtx_rtp_stats_;
 }
 
+void RtpSenderEgress::OnBatchComplete() {
+  RTC_DCHECK_RUN_ON(&pacer_checker_);
+  if (transport_) {
+    transport_->OnBatchComplete();
+  }
+}
+
 void RtpSenderEgress::ForceIncludeSendPacketsInAllocation(
     bool part_of_allocation) {
   MutexLock lock(&lock_);
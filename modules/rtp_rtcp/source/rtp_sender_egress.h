@@ -63,6 +63,9 @@ class RtpSenderEgress {
 
   void SendPacket(RtpPacketToSend* packet, const PacedPacketInfo& pacing_info)
       RTC_LOCKS_EXCLUDED(lock_);
+  // Tells the transport that the batch of packets passed to SendPacket()
+  // is complete.
+  void OnBatchComplete();
   uint32_t Ssrc() const { return ssrc_; }
   absl::optional<uint32_t> RtxSsrc() const { return rtx_ssrc_; }
   absl::optional<uint32_t> FlexFecSsrc() const { return flexfec_ssrc_; }
@@ -131,10 +131,14 @@ class TestTransport : public Transport {
 
   bool SendRtcp(const uint8_t*, size_t) override { RTC_CHECK_NOTREACHED(); }
 
+  void OnBatchComplete() override { ++num_batches_completed_; }
+
   absl::optional<TransmittedPacket> last_packet() { return last_packet_; }
+  int num_batches_completed() const { return num_batches_completed_; }
 
  private:
   DataSize total_data_sent_;
+  int num_batches_completed_ = 0;
   absl::optional<TransmittedPacket> last_packet_;
   RtpHeaderExtensionMap* const extensions_;
 };
@@ -252,6 +256,18 @@ TEST_P(RtpSenderEgressTest, PacketOptionsIsRetransmitSetByPacketType) {
   EXPECT_TRUE(transport_.last_packet()->options.is_retransmit);
 }
 
+TEST_P(RtpSenderEgressTest, PacedPacketsAreBatchable) {
+  std::unique_ptr<RtpSenderEgress> sender = CreateRtpSenderEgress();
+
+  sender->SendPacket(BuildRtpPacket().get(), PacedPacketInfo());
+  sender->SendPacket(BuildRtpPacket().get(), PacedPacketInfo());
+  EXPECT_TRUE(transport_.last_packet()->options.batchable);
+  EXPECT_EQ(transport_.num_batches_completed(), 0);
+
+  sender->OnBatchComplete();
+  EXPECT_EQ(transport_.num_batches_completed(), 1);
+}
+
 TEST_P(RtpSenderEgressTest, DoesnSetIncludedInAllocationByDefault) {
   std::unique_ptr<RtpSenderEgress> sender = CreateRtpSenderEgress();
 
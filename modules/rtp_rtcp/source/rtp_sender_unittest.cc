@@ -851,11 +851,13 @@ TEST_F(RtpSenderTest, RespectsNackBitrateLimit) {
   // Resending should work - brings the bandwidth up to the limit.
   // NACK bitrate is capped to the same bitrate as the encoder, since the max
   // protection overhead is 50% (see MediaOptimization::SetTargetRates).
-  EXPECT_CALL(mock_paced_sender_, EnqueuePackets(ElementsAre(Pointee(Property(
-                                      &RtpPacketToSend::packet_type,
-                                      RtpPacketMediaType::kRetransmission)))))
-      .Times(kNumPackets)
-      .WillRepeatedly(
+  // The retransmissions are enqueued in one batch.
+  EXPECT_CALL(mock_paced_sender_,
+              EnqueuePackets(AllOf(
+                  SizeIs(kNumPackets),
+                  Each(Pointee(Property(&RtpPacketToSend::packet_type,
+                                        RtpPacketMediaType::kRetransmission))))))
+      .WillOnce(
           [&](std::vector<std::unique_ptr<RtpPacketToSend>> packets) {
             for (const auto& packet : packets) {
               packet_history_->MarkPacketAsSent(
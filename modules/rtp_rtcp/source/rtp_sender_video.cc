@@ -34,6 +34,7 @@
 #include "modules/rtp_rtcp/source/rtp_generic_frame_descriptor_extension.h"
 #include "modules/rtp_rtcp/source/rtp_header_extensions.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "modules/rtp_rtcp/source/rtp_packetization_plan.h"
 #include "modules/rtp_rtcp/source/rtp_video_layers_allocation_extension.h"
 #include "modules/rtp_rtcp/source/time_util.h"
 #include "rtc_base/checks.h"
@@ -61,6 +62,22 @@ void BuildRedPayload(const RtpPacketToSend& media_packet,
          media_payload.size());
 }
 
+// Writes payload `index` of `plan` into `packet` behind a RED header, and
+// makes it a RED packet.
+void BuildRedPacket(const RtpPacketizationPlan& plan,
+                    size_t index,
+                    int red_payload_type,
+                    RtpPacketToSend* packet) {
+  uint8_t* red_payload = packet->AllocatePayload(kRedForFecHeaderLength +
+                                                 plan.payload_size(index));
+  RTC_DCHECK(red_payload);
+  red_payload[0] = packet->PayloadType();
+  plan.WritePayload(index, &red_payload[kRedForFecHeaderLength]);
+  packet->SetMarker(plan.marker(index));
+  packet->SetPayloadType(red_payload_type);
+  packet->set_is_red(true);
+}
+
 bool MinimizeDescriptor(RTPVideoHeader* video_header) {
   if (auto* vp8 =
           absl::get_if<RTPVideoHeaderVP8>(&video_header->video_type_header)) {
@@ -685,9 +702,18 @@ bool RTPSenderVideo::SendVideo(
 
     packet->set_first_packet_of_frame(i == 0);
 
-    if (!packetizer->NextPacket(packet.get()))
-      return false;
-    RTC_DCHECK_LE(packet->payload_size(), expected_payload_capacity);
+    if (red_enabled() && packetizer->plan() != nullptr) {
+      // Write the payload behind the RED header, rather than copying it
+      // there from a media packet.
+      RTC_DCHECK_EQ(packetizer->plan()->num_packets(), num_packets);
+      BuildRedPacket(*packetizer->plan(), i, *red_payload_type_, packet.get());
+      RTC_DCHECK_LE(packetizer->plan()->payload_size(i),
+                    expected_payload_capacity);
+    } else {
+      if (!packetizer->NextPacket(packet.get()))
+        return false;
+      RTC_DCHECK_LE(packet->payload_size(), expected_payload_capacity);
+    }
 
     packet->set_allow_retransmission(allow_retransmission);
     packet->set_is_key_frame(video_header.frame_type ==
@@ -700,9 +726,9 @@ bool RTPSenderVideo::SendVideo(
 
     packet->set_fec_protect_packet(use_fec);
 
-    if (red_enabled()) {
-      // TODO(sprang): Consider packetizing directly into packets with the RED
-      // header already in place, to avoid this copy.
+    if (red_enabled() && !packet->is_red()) {
+      // The packetizer has no plan(), so copy the media packet behind a RED
+      // header.
       std::unique_ptr<RtpPacketToSend> red_packet(new RtpPacketToSend(*packet));
       BuildRedPayload(*packet, red_packet.get());
       red_packet->SetPayloadType(*red_payload_type_);
@@ -54,6 +54,17 @@ class TransformableVideoSenderFrame : public TransformableVideoFrameInterface {
 
   void SetData(rtc::ArrayView<const uint8_t> data) override {
     encoded_data_ = EncodedImageBuffer::Create(data.data(), data.size());
+    owns_encoded_data_ = true;
+  }
+
+  rtc::ArrayView<uint8_t> GetMutableData() override {
+    // The payload is shared with the encoded image, which other sinks may
+    // still read.
+    if (!owns_encoded_data_) {
+      SetData(*encoded_data_);
+    }
+    return rtc::ArrayView<uint8_t>(encoded_data_->data(),
+                                   encoded_data_->size());
   }
 
   uint32_t GetTimestamp() const override { return timestamp_; }
@@ -82,6 +93,7 @@ class TransformableVideoSenderFrame : public TransformableVideoFrameInterface {
 
  private:
   rtc::scoped_refptr<EncodedImageBufferInterface> encoded_data_;
+  bool owns_encoded_data_ = false;
   const RTPVideoHeader header_;
   const VideoFrameMetadata metadata_;
   const VideoFrameType frame_type_;
@@ -132,18 +144,27 @@ bool RTPSenderVideoFrameTransformerDelegate::TransformFrame(
 
 void RTPSenderVideoFrameTransformerDelegate::OnTransformedFrame(
     std::unique_ptr<TransformableFrameInterface> frame) {
-  MutexLock lock(&sender_lock_);
+  {
+    MutexLock lock(&sender_lock_);
 
-  // The encoder queue normally gets destroyed after the sender;
-  // however, it might still be null by the time a previously queued frame
-  // arrives.
-  if (!sender_ || !encoder_queue_)
-    return;
-  rtc::scoped_refptr<RTPSenderVideoFrameTransformerDelegate> delegate = this;
-  encoder_queue_->PostTask(ToQueuedTask(
-      [delegate = std::move(delegate), frame = std::move(frame)]() mutable {
-        delegate->SendVideo(std::move(frame));
-      }));
+    // The encoder queue normally gets destroyed after the sender;
+    // however, it might still be null by the time a previously queued frame
+    // arrives.
+    if (!sender_ || !encoder_queue_)
+      return;
+    if (!encoder_queue_->IsCurrent()) {
+      rtc::scoped_refptr<RTPSenderVideoFrameTransformerDelegate> delegate =
+          this;
+      encoder_queue_->PostTask(ToQueuedTask(
+          [delegate = std::move(delegate), frame = std::move(frame)]() mutable {
+            delegate->SendVideo(std::move(frame));
+          }));
+      return;
+    }
+  }
+  // Transformers that return the frame synchronously, or on the encoder
+  // queue, don't need another hop.
+  SendVideo(std::move(frame));
 }
 
 void RTPSenderVideoFrameTransformerDelegate::SendVideo(
@@ -72,6 +72,7 @@ enum : int {  // The first valid value is 1.
 };
 
 constexpr int kPayload = 100;
+constexpr int kRedPayloadType = 101;
 constexpr VideoCodecType kType = VideoCodecType::kVideoCodecGeneric;
 constexpr uint32_t kTimestamp = 10;
 constexpr uint16_t kSeqNum = 33;
@@ -127,12 +128,14 @@ class TestRtpSenderVideo : public RTPSenderVideo {
  public:
   TestRtpSenderVideo(Clock* clock,
                      RTPSender* rtp_sender,
-                     const WebRtcKeyValueConfig& field_trials)
+                     const WebRtcKeyValueConfig& field_trials,
+                     absl::optional<int> red_payload_type = absl::nullopt)
       : RTPSenderVideo([&] {
           Config config;
           config.clock = clock;
           config.rtp_sender = rtp_sender;
           config.field_trials = &field_trials;
+          config.red_payload_type = red_payload_type;
           return config;
         }()) {}
   ~TestRtpSenderVideo() override {}
@@ -1384,6 +1387,54 @@ TEST_P(RtpSenderVideoTest, SendRawVideo) {
   EXPECT_THAT(sent_payload, ElementsAreArray(kPayload));
 }
 
+TEST_P(RtpSenderVideoTest, SendsVp8FrameInRedPackets) {
+  rtp_sender_video_ = std::make_unique<TestRtpSenderVideo>(
+      &fake_clock_, rtp_module_->RtpSender(), field_trials_, kRedPayloadType);
+  uint8_t frame[3000];
+  for (size_t i = 0; i < sizeof(frame); ++i) {
+    frame[i] = i;
+  }
+  RTPVideoHeader header;
+  header.frame_type = VideoFrameType::kVideoFrameKey;
+  header.video_type_header.emplace<RTPVideoHeaderVP8>().InitRTPVideoHeaderVP8();
+  ASSERT_TRUE(rtp_sender_video_->SendVideo(
+      kPayload, kVideoCodecVP8, kTimestamp, 0, frame, header,
+      kDefaultExpectedRetransmissionTimeMs));
+
+  const std::vector<RtpPacketReceived>& packets = transport_.sent_packets();
+  ASSERT_GT(packets.size(), 1u);
+  std::vector<uint8_t> received_frame;
+  for (size_t i = 0; i < packets.size(); ++i) {
+    EXPECT_EQ(packets[i].PayloadType(), kRedPayloadType);
+    EXPECT_EQ(packets[i].Marker(), i == packets.size() - 1);
+    rtc::ArrayView<const uint8_t> payload = packets[i].payload();
+    ASSERT_GT(payload.size(), 2u);
+    // RED header, then a VP8 payload descriptor of a single byte, which has
+    // the start of partition bit in the first packet only.
+    EXPECT_EQ(payload[0], kPayload);
+    EXPECT_EQ(payload[1], i == 0 ? 0x10 : 0);
+    received_frame.insert(received_frame.end(), payload.begin() + 2,
+                          payload.end());
+  }
+  EXPECT_THAT(received_frame, ElementsAreArray(frame));
+}
+
+TEST_P(RtpSenderVideoTest, SendsRawFrameInRedPackets) {
+  rtp_sender_video_ = std::make_unique<TestRtpSenderVideo>(
+      &fake_clock_, rtp_module_->RtpSender(), field_trials_, kRedPayloadType);
+  const uint8_t kFrame[] = {1, 2, 3, 4};
+  RTPVideoHeader header;
+  header.frame_type = VideoFrameType::kVideoFrameKey;
+  ASSERT_TRUE(rtp_sender_video_->SendVideo(
+      kPayload, absl::nullopt, kTimestamp, 0, kFrame, header,
+      kDefaultExpectedRetransmissionTimeMs));
+
+  const RtpPacketReceived& packet = transport_.last_sent_packet();
+  EXPECT_EQ(packet.PayloadType(), kRedPayloadType);
+  EXPECT_TRUE(packet.Marker());
+  EXPECT_THAT(packet.payload(), ElementsAre(kPayload, 1, 2, 3, 4));
+}
+
 INSTANTIATE_TEST_SUITE_P(WithAndWithoutOverhead,
                          RtpSenderVideoTest,
                          ::testing::Bool());
@@ -1524,6 +1575,44 @@ TEST_F(RtpSenderVideoWithFrameTransformerTest, OnTransformedFrameSendsVideo) {
   EXPECT_EQ(transport_.packets_sent(), 1);
 }
 
+TEST_F(RtpSenderVideoWithFrameTransformerTest,
+       TransformingInPlaceLeavesEncodedImageUnchanged) {
+  rtc::scoped_refptr<MockFrameTransformer> mock_frame_transformer =
+      new rtc::RefCountedObject<NiceMock<MockFrameTransformer>>();
+  rtc::scoped_refptr<TransformedFrameCallback> callback;
+  EXPECT_CALL(*mock_frame_transformer, RegisterTransformedFrameSinkCallback)
+      .WillOnce(SaveArg<0>(&callback));
+  std::unique_ptr<RTPSenderVideo> rtp_sender_video =
+      CreateSenderWithFrameTransformer(mock_frame_transformer);
+  ASSERT_TRUE(callback);
+
+  auto encoded_image = CreateDefaultEncodedImage();
+  RTPVideoHeader video_header;
+  video_header.frame_type = VideoFrameType::kVideoFrameKey;
+  ON_CALL(*mock_frame_transformer, Transform)
+      .WillByDefault(
+          [&callback](std::unique_ptr<TransformableFrameInterface> frame) {
+            for (uint8_t& byte : frame->GetMutableData()) {
+              byte ^= 0xff;
+            }
+            EXPECT_THAT(frame->GetData(), ElementsAre(0xfe, 0xfd, 0xfc, 0xfb));
+            callback->OnTransformedFrame(std::move(frame));
+          });
+  TaskQueueForTest encoder_queue;
+  encoder_queue.SendTask(
+      [&] {
+        rtp_sender_video->SendEncodedImage(
+            kPayload, kType, kTimestamp, *encoded_image, video_header,
+            kDefaultExpectedRetransmissionTimeMs);
+      },
+      RTC_FROM_HERE);
+  encoder_queue.WaitForPreviouslyPostedTasks();
+  EXPECT_EQ(transport_.packets_sent(), 1);
+  // Other sinks of the encoded image still see the encoder output.
+  EXPECT_THAT(rtc::MakeArrayView(encoded_image->data(), encoded_image->size()),
+              ElementsAre(1, 2, 3, 4));
+}
+
 TEST_F(RtpSenderVideoWithFrameTransformerTest,
        TransformableFrameMetadataHasCorrectValue) {
   rtc::scoped_refptr<MockFrameTransformer> mock_frame_transformer =
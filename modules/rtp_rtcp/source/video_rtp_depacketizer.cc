@@ -28,7 +28,7 @@ rtc::scoped_refptr<EncodedImageBuffer> VideoRtpDepacketizer::AssembleFrame(
   }
 
   rtc::scoped_refptr<EncodedImageBuffer> bitstream =
-      EncodedImageBuffer::Create(frame_size);
+      CreateFrameBuffer(frame_size);
 
   uint8_t* write_at = bitstream->data();
   for (rtc::ArrayView<const uint8_t> payload : rtp_payloads) {
@@ -39,4 +39,12 @@ rtc::scoped_refptr<EncodedImageBuffer> VideoRtpDepacketizer::AssembleFrame(
   return bitstream;
 }
 
+rtc::scoped_refptr<EncodedImageBuffer> VideoRtpDepacketizer::CreateFrameBuffer(
+    size_t size) {
+  if (pool_) {
+    return pool_->Create(size);
+  }
+  return EncodedImageBuffer::Create(size);
+}
+
 }  // namespace webrtc
@@ -0,0 +1,203 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/speech_activity/speech_activity_analyzer.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include "modules/audio_processing/agc2/cpu_features.h"
+#include "modules/audio_processing/include/audio_frame_view.h"
+#include "modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+// Longest audio that a single packet is expected to decode to.
+constexpr int kMaxPacketDurationMs = 120;
+// Bounds the payloads queued by a stream if Process() is not called.
+constexpr size_t kMaxPendingPayloads = 50;
+
+}  // namespace
+
+SpeechActivityAnalyzer::Stream::Stream(
+    std::unique_ptr<AudioDecoder> decoder,
+    std::unique_ptr<VoiceActivityDetectorWrapper> vad)
+    : decoder_(std::move(decoder)), vad_(std::move(vad)) {
+  if (decoder_) {
+    RTC_DCHECK(vad_);
+    const int sample_rate_hz = decoder_->SampleRateHz();
+    decoded_.resize(sample_rate_hz / 1000 * kMaxPacketDurationMs *
+                    decoder_->Channels());
+    frame_.resize(rtc::CheckedDivExact(sample_rate_hz, 100));
+  }
+}
+
+SpeechActivityAnalyzer::Stream::~Stream() = default;
+
+void SpeechActivityAnalyzer::Stream::OnRtpPacket(
+    const RtpPacketReceived& packet) {
+  bool voice_activity;
+  uint8_t audio_level;
+  const bool has_audio_level =
+      packet.GetExtension<AudioLevel>(&voice_activity, &audio_level);
+  const bool decode = decoder_ && !packet.payload().empty();
+  if (!has_audio_level && !decode) {
+    return;
+  }
+  MutexLock lock(&mutex_);
+  if (has_audio_level) {
+    pending_audio_level_dbov_ =
+        std::min<int>(audio_level, pending_audio_level_dbov_.value_or(127));
+    pending_voice_activity_ |= voice_activity;
+  }
+  if (decode && pending_payloads_.size() < kMaxPendingPayloads) {
+    pending_payloads_.emplace_back(packet.payload().data(),
+                                   packet.payload().size());
+  }
+}
+
+void SpeechActivityAnalyzer::Stream::Analyze() {
+  {
+    MutexLock lock(&mutex_);
+    activity_.audio_level_dbov = pending_audio_level_dbov_;
+    activity_.voice_activity = pending_voice_activity_;
+    pending_audio_level_dbov_ = absl::nullopt;
+    pending_voice_activity_ = false;
+    std::swap(payloads_, pending_payloads_);
+  }
+  activity_.speech_probability = absl::nullopt;
+  if (!decoder_) {
+    return;
+  }
+
+  const size_t num_channels = decoder_->Channels();
+  for (const rtc::Buffer& payload : payloads_) {
+    AudioDecoder::SpeechType speech_type;
+    const int num_samples = decoder_->Decode(
+        payload.data(), payload.size(), decoder_->SampleRateHz(),
+        decoded_.size() * sizeof(int16_t), decoded_.data(), &speech_type);
+    if (num_samples <= 0) {
+      continue;
+    }
+    // Analyze the first channel in 10 ms frames.
+    const size_t samples_per_channel = num_samples / num_channels;
+    for (size_t i = 0; i < samples_per_channel; ++i) {
+      frame_[frame_size_++] = decoded_[i * num_channels];
+      if (frame_size_ < frame_.size()) {
+        continue;
+      }
+      const float* channel = frame_.data();
+      const float speech_probability =
+          vad_->Analyze(AudioFrameView<const float>(
+              &channel, /*num_channels=*/1, frame_.size()));
+      activity_.speech_probability = std::max(
+          speech_probability, activity_.speech_probability.value_or(0.f));
+      frame_size_ = 0;
+    }
+  }
+  payloads_.clear();
+}
+
+SpeechActivityAnalyzer::SpeechActivityAnalyzer(const Config& config)
+    : SpeechActivityAnalyzer(
+          config,
+          [config](int sample_rate_hz) {
+            return std::make_unique<VoiceActivityDetectorWrapper>(
+                config.vad_reset_period_ms, GetAvailableCpuFeatures(),
+                config.quantized_vad, sample_rate_hz);
+          }) {}
+
+SpeechActivityAnalyzer::SpeechActivityAnalyzer(const Config& config,
+                                               VadFactory vad_factory)
+    : config_(config), vad_factory_(std::move(vad_factory)) {
+  RTC_DCHECK_GE(config_.num_worker_threads, 0);
+  for (int i = 0; i < config_.num_worker_threads; ++i) {
+    start_events_.push_back(std::make_unique<rtc::Event>());
+    rtc::Event* start = start_events_.back().get();
+    threads_.push_back(rtc::PlatformThread::SpawnJoinable(
+        [this, start] { RunWorker(start); },
+        "SpeechActivity" + std::to_string(i),
+        rtc::ThreadAttributes().SetPriority(rtc::ThreadPriority::kHigh)));
+  }
+}
+
+SpeechActivityAnalyzer::~SpeechActivityAnalyzer() {
+  quit_.store(true);
+  for (auto& start : start_events_) {
+    start->Set();
+  }
+  for (rtc::PlatformThread& thread : threads_) {
+    thread.Finalize();
+  }
+}
+
+SpeechActivityAnalyzer::Stream* SpeechActivityAnalyzer::AddStream(
+    std::unique_ptr<AudioDecoder> decoder) {
+  std::unique_ptr<VoiceActivityDetectorWrapper> vad;
+  if (decoder) {
+    vad = vad_factory_(decoder->SampleRateHz());
+  }
+  // `Stream` has a private ctor.
+  streams_.push_back(
+      std::unique_ptr<Stream>(new Stream(std::move(decoder), std::move(vad))));
+  return streams_.back().get();
+}
+
+void SpeechActivityAnalyzer::RemoveStream(Stream* stream) {
+  auto it = std::find_if(
+      streams_.begin(), streams_.end(),
+      [stream](const std::unique_ptr<Stream>& s) { return s.get() == stream; });
+  RTC_DCHECK(it != streams_.end());
+  if (it != streams_.end()) {
+    streams_.erase(it);
+  }
+}
+
+void SpeechActivityAnalyzer::Process() {
+  next_stream_.store(0);
+  // Only wake as many workers as there are streams for besides the one
+  // analyzed by the calling thread.
+  const size_t num_workers =
+      std::min(threads_.size(), streams_.empty() ? 0 : streams_.size() - 1);
+  running_workers_.store(static_cast<int>(num_workers));
+  for (size_t i = 0; i < num_workers; ++i) {
+    start_events_[i]->Set();
+  }
+  AnalyzePendingStreams();
+  if (num_workers > 0) {
+    tick_done_.Wait(rtc::Event::kForever);
+  }
+}
+
+void SpeechActivityAnalyzer::RunWorker(rtc::Event* start) {
+  while (true) {
+    start->Wait(rtc::Event::kForever);
+    if (quit_.load()) {
+      return;
+    }
+    AnalyzePendingStreams();
+    if (running_workers_.fetch_sub(1) == 1) {
+      tick_done_.Set();
+    }
+  }
+}
+
+void SpeechActivityAnalyzer::AnalyzePendingStreams() {
+  for (size_t i = next_stream_.fetch_add(1); i < streams_.size();
+       i = next_stream_.fetch_add(1)) {
+    streams_[i]->Analyze();
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,155 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_SPEECH_ACTIVITY_SPEECH_ACTIVITY_ANALYZER_H_
+#define MODULES_SPEECH_ACTIVITY_SPEECH_ACTIVITY_ANALYZER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/audio_codecs/audio_decoder.h"
+#include "modules/audio_processing/agc2/vad_wrapper.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+class RtpPacketReceived;
+
+// Estimates the speech activity of many received audio streams, e.g., for
+// active speaker detection on a server that forwards the streams without
+// mixing them. For each stream, the audio level header extension (RFC 6464) of
+// the received packets is collected and, if the stream has a decoder, the
+// payloads are decoded and analyzed by the AGC2 RNN VAD. This is much cheaper
+// than running NetEq and AudioProcessing per stream, since there is no jitter
+// buffer, no concealment of lost packets and no other audio processing.
+//
+// The streams are analyzed once per tick by Process(), which spreads them over
+// a pool of worker threads and the calling thread. Streams must be added,
+// removed and processed on the same sequence; the packets may be delivered on
+// any thread.
+class SpeechActivityAnalyzer {
+ public:
+  struct Config {
+    // Number of worker threads besides the one calling Process().
+    int num_worker_threads = 0;
+    // Period in milliseconds to reset the VAD; see
+    // `VoiceActivityDetectorWrapper`.
+    int vad_reset_period_ms = 1500;
+    // Runs the RNN VAD with 8 bit weights, which is faster and only slightly
+    // less accurate.
+    bool quantized_vad = true;
+  };
+
+  // Speech activity of a stream in the packets received between the last two
+  // calls to Process().
+  struct Activity {
+    // Highest audio level in the header extension, in -dBov (0 is the loudest
+    // and 127 is silence). Unset if no packet carried the extension.
+    absl::optional<int> audio_level_dbov;
+    // True if the voice activity flag of any header extension was set.
+    bool voice_activity = false;
+    // Highest speech probability of the 10 ms frames decoded. Unset if the
+    // stream has no decoder or if no complete frame was decoded.
+    absl::optional<float> speech_probability;
+  };
+
+  class Stream {
+   public:
+    Stream(const Stream&) = delete;
+    Stream& operator=(const Stream&) = delete;
+    ~Stream();
+
+    // Collects the audio level of `packet` and, if the stream has a decoder,
+    // queues its payload for decoding. The packets are expected in order; they
+    // are not reordered and lost packets are not concealed. May be called on
+    // any thread, also while the stream is processed.
+    void OnRtpPacket(const RtpPacketReceived& packet);
+
+    // Returns the activity computed by the last call to Process().
+    const Activity& activity() const { return activity_; }
+
+   private:
+    friend class SpeechActivityAnalyzer;
+
+    Stream(std::unique_ptr<AudioDecoder> decoder,
+           std::unique_ptr<VoiceActivityDetectorWrapper> vad);
+
+    // Computes `activity_` from the packets received since the last call.
+    void Analyze();
+
+    Mutex mutex_;
+    absl::optional<int> pending_audio_level_dbov_ RTC_GUARDED_BY(mutex_);
+    bool pending_voice_activity_ RTC_GUARDED_BY(mutex_) = false;
+    std::vector<rtc::Buffer> pending_payloads_ RTC_GUARDED_BY(mutex_);
+
+    // Only accessed by Analyze().
+    const std::unique_ptr<AudioDecoder> decoder_;
+    const std::unique_ptr<VoiceActivityDetectorWrapper> vad_;
+    std::vector<rtc::Buffer> payloads_;
+    std::vector<int16_t> decoded_;
+    // 10 ms frame of the first decoded channel, filled up to `frame_size_`.
+    std::vector<float> frame_;
+    size_t frame_size_ = 0;
+    Activity activity_;
+  };
+
+  // Creates the VAD of a stream given the sample rate of the decoded audio.
+  using VadFactory =
+      std::function<std::unique_ptr<VoiceActivityDetectorWrapper>(
+          int sample_rate_hz)>;
+
+  explicit SpeechActivityAnalyzer(const Config& config);
+  // Ctor. Uses `vad_factory` to create the VAD of the streams.
+  SpeechActivityAnalyzer(const Config& config, VadFactory vad_factory);
+  ~SpeechActivityAnalyzer();
+
+  SpeechActivityAnalyzer(const SpeechActivityAnalyzer&) = delete;
+  SpeechActivityAnalyzer& operator=(const SpeechActivityAnalyzer&) = delete;
+
+  // Adds a stream and returns it; it is owned by the analyzer. If `decoder` is
+  // null, the activity of the stream only depends on the header extension.
+  Stream* AddStream(std::unique_ptr<AudioDecoder> decoder);
+  // Removes and destroys `stream`. No packets may be delivered to it anymore.
+  void RemoveStream(Stream* stream);
+
+  // Analyzes the packets received by every stream since the last call and
+  // returns once their activity is updated. Meant to be called every 10 ms.
+  void Process();
+
+ private:
+  void RunWorker(rtc::Event* start);
+  // Analyzes streams of the current tick until none are left.
+  void AnalyzePendingStreams();
+
+  const Config config_;
+  const VadFactory vad_factory_;
+  std::vector<std::unique_ptr<Stream>> streams_;
+
+  std::vector<std::unique_ptr<rtc::Event>> start_events_;
+  std::vector<rtc::PlatformThread> threads_;
+  rtc::Event tick_done_;
+  std::atomic<bool> quit_{false};
+  std::atomic<size_t> next_stream_{0};
+  std::atomic<int> running_workers_{0};
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_SPEECH_ACTIVITY_SPEECH_ACTIVITY_ANALYZER_H_
@@ -0,0 +1,159 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/speech_activity/speech_activity_analyzer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "modules/audio_coding/codecs/pcm16b/audio_decoder_pcm16b.h"
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kSampleRateHz = 16000;
+constexpr int kSamplesPer10ms = kSampleRateHz / 100;
+constexpr int kNoVadPeriodicReset = 10000;
+
+// Returns the largest magnitude in the frame as speech probability.
+class PeakVad : public VoiceActivityDetectorWrapper::MonoVad {
+ public:
+  explicit PeakVad(int* num_frames) : num_frames_(num_frames) {}
+  int SampleRateHz() const override { return kSampleRateHz; }
+  void Reset() override {}
+  float Analyze(rtc::ArrayView<const float> frame) override {
+    ++*num_frames_;
+    float peak = 0.f;
+    for (float sample : frame) {
+      peak = std::max(peak, std::fabs(sample));
+    }
+    return peak / 32768.f;
+  }
+
+ private:
+  int* const num_frames_;
+};
+
+class SpeechActivityAnalyzerTest : public ::testing::Test {
+ protected:
+  SpeechActivityAnalyzerTest() { extensions_.Register<AudioLevel>(1); }
+
+  std::unique_ptr<SpeechActivityAnalyzer> CreateAnalyzer(int num_threads) {
+    SpeechActivityAnalyzer::Config config;
+    config.num_worker_threads = num_threads;
+    return std::make_unique<SpeechActivityAnalyzer>(
+        config, [this](int sample_rate_hz) {
+          return std::make_unique<VoiceActivityDetectorWrapper>(
+              kNoVadPeriodicReset, std::make_unique<PeakVad>(&num_vad_frames_),
+              sample_rate_hz);
+        });
+  }
+
+  RtpPacketReceived CreatePacket(absl::optional<uint8_t> audio_level,
+                                 bool voice_activity,
+                                 int num_samples,
+                                 int16_t sample) {
+    RtpPacketReceived packet(&extensions_);
+    if (audio_level) {
+      packet.SetExtension<AudioLevel>(voice_activity, *audio_level);
+    }
+    // PCM16B payloads are big-endian.
+    uint8_t* payload = packet.AllocatePayload(2 * num_samples);
+    for (int i = 0; i < num_samples; ++i) {
+      payload[2 * i] = static_cast<uint16_t>(sample) >> 8;
+      payload[2 * i + 1] = static_cast<uint16_t>(sample) & 0xFF;
+    }
+    return packet;
+  }
+
+  RtpHeaderExtensionMap extensions_;
+  int num_vad_frames_ = 0;
+};
+
+TEST_F(SpeechActivityAnalyzerTest, ReportsHighestAudioLevelSinceLastTick) {
+  auto analyzer = CreateAnalyzer(/*num_threads=*/0);
+  SpeechActivityAnalyzer::Stream* stream = analyzer->AddStream(nullptr);
+
+  stream->OnRtpPacket(CreatePacket(50, /*voice_activity=*/false, 0, 0));
+  stream->OnRtpPacket(CreatePacket(30, /*voice_activity=*/true, 0, 0));
+  stream->OnRtpPacket(CreatePacket(40, /*voice_activity=*/false, 0, 0));
+  analyzer->Process();
+  EXPECT_EQ(stream->activity().audio_level_dbov, 30);
+  EXPECT_TRUE(stream->activity().voice_activity);
+  EXPECT_FALSE(stream->activity().speech_probability);
+
+  analyzer->Process();
+  EXPECT_FALSE(stream->activity().audio_level_dbov);
+  EXPECT_FALSE(stream->activity().voice_activity);
+}
+
+TEST_F(SpeechActivityAnalyzerTest, AnalyzesDecodedAudioIn10msFrames) {
+  auto analyzer = CreateAnalyzer(/*num_threads=*/0);
+  SpeechActivityAnalyzer::Stream* stream = analyzer->AddStream(
+      std::make_unique<AudioDecoderPcm16B>(kSampleRateHz, 1));
+
+  // 15 ms, of which the last 5 ms are only analyzed with the next packet.
+  stream->OnRtpPacket(CreatePacket(absl::nullopt, /*voice_activity=*/false,
+                                   3 * kSamplesPer10ms / 2, 8192));
+  analyzer->Process();
+  EXPECT_EQ(num_vad_frames_, 1);
+  EXPECT_FALSE(stream->activity().audio_level_dbov);
+  ASSERT_TRUE(stream->activity().speech_probability);
+  EXPECT_FLOAT_EQ(*stream->activity().speech_probability, 0.25f);
+
+  analyzer->Process();
+  EXPECT_EQ(num_vad_frames_, 1);
+  EXPECT_FALSE(stream->activity().speech_probability);
+
+  stream->OnRtpPacket(CreatePacket(absl::nullopt, /*voice_activity=*/false,
+                                   kSamplesPer10ms / 2, -16384));
+  analyzer->Process();
+  EXPECT_EQ(num_vad_frames_, 2);
+  ASSERT_TRUE(stream->activity().speech_probability);
+  EXPECT_FLOAT_EQ(*stream->activity().speech_probability, 0.5f);
+}
+
+TEST_F(SpeechActivityAnalyzerTest, AnalyzesAllStreamsOnWorkerThreads) {
+  constexpr int kNumStreams = 100;
+  auto analyzer = CreateAnalyzer(/*num_threads=*/4);
+  std::vector<SpeechActivityAnalyzer::Stream*> streams;
+  for (int i = 0; i < kNumStreams; ++i) {
+    streams.push_back(analyzer->AddStream(nullptr));
+  }
+  for (int tick = 0; tick < 10; ++tick) {
+    for (int i = 0; i < kNumStreams; ++i) {
+      streams[i]->OnRtpPacket(
+          CreatePacket((i + tick) % 128, /*voice_activity=*/true, 0, 0));
+    }
+    analyzer->Process();
+    for (int i = 0; i < kNumStreams; ++i) {
+      EXPECT_EQ(streams[i]->activity().audio_level_dbov, (i + tick) % 128);
+    }
+  }
+}
+
+TEST_F(SpeechActivityAnalyzerTest, RemovesStreams) {
+  auto analyzer = CreateAnalyzer(/*num_threads=*/1);
+  SpeechActivityAnalyzer::Stream* stream1 = analyzer->AddStream(nullptr);
+  SpeechActivityAnalyzer::Stream* stream2 = analyzer->AddStream(nullptr);
+  analyzer->RemoveStream(stream1);
+  stream2->OnRtpPacket(CreatePacket(20, /*voice_activity=*/true, 0, 0));
+  analyzer->Process();
+  EXPECT_EQ(stream2->activity().audio_level_dbov, 20);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -21,17 +21,131 @@
 #include <time.h>
 #include <unistd.h>
 
+#include <atomic>
 #include <new>
 #include <string>
+#include <vector>
 
 #include "api/scoped_refptr.h"
+#include "common_video/include/video_frame_buffer.h"
+#include "common_video/libyuv/include/webrtc_libyuv.h"
 #include "media/base/video_common.h"
 #include "modules/video_capture/video_capture.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/ref_count.h"
 #include "rtc_base/ref_counted_object.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 namespace videocapturemodule {
+
+// Owns the mmap'ed capture buffers of a device. Frames that wrap a buffer keep
+// the pool alive, so that the mappings stay valid after capture stops, and
+// queue the buffer to the device again when they are released. Note that the
+// device can't allocate new buffers until the pool is gone.
+class V4L2BufferPool : public rtc::RefCountInterface {
+ public:
+  // `device_fd` is duplicated, so it may be closed before the pool is gone.
+  explicit V4L2BufferPool(int device_fd) : device_fd_(dup(device_fd)) {}
+
+  ~V4L2BufferPool() override {
+    for (const Buffer& buffer : buffers_)
+      munmap(buffer.start, buffer.length);
+    if (device_fd_ != -1)
+      close(device_fd_);
+  }
+
+  // Requests, maps and queues up to `count` buffers.
+  bool Allocate(unsigned int count) {
+    struct v4l2_requestbuffers rbuffer;
+    memset(&rbuffer, 0, sizeof(v4l2_requestbuffers));
+
+    rbuffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    rbuffer.memory = V4L2_MEMORY_MMAP;
+    rbuffer.count = count;
+
+    if (ioctl(device_fd_, VIDIOC_REQBUFS, &rbuffer) < 0) {
+      RTC_LOG(LS_INFO) << "Could not get buffers from device. errno = "
+                       << errno;
+      return false;
+    }
+
+    if (rbuffer.count > count)
+      rbuffer.count = count;
+
+    // Map the buffers
+    for (unsigned int i = 0; i < rbuffer.count; i++) {
+      struct v4l2_buffer buffer;
+      memset(&buffer, 0, sizeof(v4l2_buffer));
+      buffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+      buffer.memory = V4L2_MEMORY_MMAP;
+      buffer.index = i;
+
+      if (ioctl(device_fd_, VIDIOC_QUERYBUF, &buffer) < 0) {
+        return false;
+      }
+
+      void* start = mmap(NULL, buffer.length, PROT_READ | PROT_WRITE,
+                         MAP_SHARED, device_fd_, buffer.m.offset);
+      if (MAP_FAILED == start) {
+        return false;
+      }
+      buffers_.push_back({start, buffer.length});
+
+      if (ioctl(device_fd_, VIDIOC_QBUF, &buffer) < 0) {
+        return false;
+      }
+      ++num_queued_;
+    }
+    return true;
+  }
+
+  // Stops queueing released buffers, once streaming is turned off.
+  void Stop() {
+    MutexLock lock(&lock_);
+    stopped_ = true;
+  }
+
+  // Queues buffer `index` to the device again.
+  void Enqueue(int index) {
+    MutexLock lock(&lock_);
+    if (stopped_)
+      return;
+    struct v4l2_buffer buf;
+    memset(&buf, 0, sizeof(struct v4l2_buffer));
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = V4L2_MEMORY_MMAP;
+    buf.index = index;
+    if (ioctl(device_fd_, VIDIOC_QBUF, &buf) == -1) {
+      RTC_LOG(LS_INFO) << "Failed to enqueue capture buffer";
+      return;
+    }
+    ++num_queued_;
+  }
+
+  // Must be called for every buffer that is dequeued from the device.
+  void OnDequeued() { --num_queued_; }
+
+  int num_queued() const { return num_queued_; }
+  uint8_t* data(int index) const {
+    return static_cast<uint8_t*>(buffers_[index].start);
+  }
+
+ private:
+  struct Buffer {
+    void* start;
+    size_t length;
+  };
+
+  const int device_fd_;
+  std::vector<Buffer> buffers_;
+  std::atomic<int> num_queued_{0};
+  Mutex lock_;
+  bool stopped_ RTC_GUARDED_BY(lock_) = false;
+};
+
 rtc::scoped_refptr<VideoCaptureModule> VideoCaptureImpl::Create(
     const char* deviceUniqueId) {
   auto implementation = rtc::make_ref_counted<VideoCaptureModuleV4L2>();
@@ -46,13 +160,12 @@ VideoCaptureModuleV4L2::VideoCaptureModuleV4L2()
     : VideoCaptureImpl(),
       _deviceId(-1),
       _deviceFd(-1),
-      _buffersAllocatedByDevice(-1),
       _currentWidth(-1),
       _currentHeight(-1),
       _currentFrameRate(-1),
       _captureStarted(false),
       _captureVideoType(VideoType::kI420),
-      _pool(NULL) {}
+      zero_copy_(field_trial::IsEnabled("WebRTC-VideoCaptureV4L2ZeroCopy")) {}
 
 int32_t VideoCaptureModuleV4L2::Init(const char* deviceUniqueIdUTF8) {
   int len = strlen((const char*)deviceUniqueIdUTF8);
@@ -288,62 +401,12 @@ int32_t VideoCaptureModuleV4L2::StopCapture() {
 // critical section protected by the caller
 
 bool VideoCaptureModuleV4L2::AllocateVideoBuffers() {
-  struct v4l2_requestbuffers rbuffer;
-  memset(&rbuffer, 0, sizeof(v4l2_requestbuffers));
-
-  rbuffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-  rbuffer.memory = V4L2_MEMORY_MMAP;
-  rbuffer.count = kNoOfV4L2Bufffers;
-
-  if (ioctl(_deviceFd, VIDIOC_REQBUFS, &rbuffer) < 0) {
-    RTC_LOG(LS_INFO) << "Could not get buffers from device. errno = " << errno;
-    return false;
-  }
-
-  if (rbuffer.count > kNoOfV4L2Bufffers)
-    rbuffer.count = kNoOfV4L2Bufffers;
-
-  _buffersAllocatedByDevice = rbuffer.count;
-
-  // Map the buffers
-  _pool = new Buffer[rbuffer.count];
-
-  for (unsigned int i = 0; i < rbuffer.count; i++) {
-    struct v4l2_buffer buffer;
-    memset(&buffer, 0, sizeof(v4l2_buffer));
-    buffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-    buffer.memory = V4L2_MEMORY_MMAP;
-    buffer.index = i;
-
-    if (ioctl(_deviceFd, VIDIOC_QUERYBUF, &buffer) < 0) {
-      return false;
-    }
-
-    _pool[i].start = mmap(NULL, buffer.length, PROT_READ | PROT_WRITE,
-                          MAP_SHARED, _deviceFd, buffer.m.offset);
-
-    if (MAP_FAILED == _pool[i].start) {
-      for (unsigned int j = 0; j < i; j++)
-        munmap(_pool[j].start, _pool[j].length);
-      return false;
-    }
-
-    _pool[i].length = buffer.length;
-
-    if (ioctl(_deviceFd, VIDIOC_QBUF, &buffer) < 0) {
-      return false;
-    }
-  }
-  return true;
+  buffer_pool_ = rtc::make_ref_counted<V4L2BufferPool>(_deviceFd);
+  return buffer_pool_->Allocate(zero_copy_ ? kNoOfZeroCopyV4L2Buffers
+                                           : kNoOfV4L2Bufffers);
 }
 
 bool VideoCaptureModuleV4L2::DeAllocateVideoBuffers() {
-  // unmap buffers
-  for (int i = 0; i < _buffersAllocatedByDevice; i++)
-    munmap(_pool[i].start, _pool[i].length);
-
-  delete[] _pool;
-
   // turn off stream
   enum v4l2_buf_type type;
   type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
@@ -351,9 +414,24 @@ bool VideoCaptureModuleV4L2::DeAllocateVideoBuffers() {
     RTC_LOG(LS_INFO) << "VIDIOC_STREAMOFF error. errno: " << errno;
   }
 
+  // The buffers are unmapped once no frame uses them anymore.
+  buffer_pool_->Stop();
+  buffer_pool_ = nullptr;
+
   return true;
 }
 
+void VideoCaptureModuleV4L2::DeliverWrappedBuffer(int index) {
+  const int stride_uv = (_currentWidth + 1) / 2;
+  const uint8_t* data_y = buffer_pool_->data(index);
+  const uint8_t* data_u = data_y + _currentWidth * _currentHeight;
+  const uint8_t* data_v = data_u + stride_uv * ((_currentHeight + 1) / 2);
+  rtc::scoped_refptr<V4L2BufferPool> pool = buffer_pool_;
+  IncomingVideoFrameBuffer(WrapI420Buffer(
+      _currentWidth, _currentHeight, data_y, _currentWidth, data_u, stride_uv,
+      data_v, stride_uv, [pool, index] { pool->Enqueue(index); }));
+}
+
 bool VideoCaptureModuleV4L2::CaptureStarted() {
   return _captureStarted;
 }
@@ -402,17 +480,25 @@ bool VideoCaptureModuleV4L2::CaptureProcess() {
           return true;
         }
       }
-      VideoCaptureCapability frameInfo;
-      frameInfo.width = _currentWidth;
-      frameInfo.height = _currentHeight;
-      frameInfo.videoType = _captureVideoType;
-
-      // convert to to I420 if needed
-      IncomingFrame((unsigned char*)_pool[buf.index].start, buf.bytesused,
-                    frameInfo);
-      // enqueue the buffer again
-      if (ioctl(_deviceFd, VIDIOC_QBUF, &buf) == -1) {
-        RTC_LOG(LS_INFO) << "Failed to enqueue capture buffer";
+      buffer_pool_->OnDequeued();
+
+      // I420 frames can be delivered as they are, as long as the device keeps
+      // enough buffers to capture into.
+      if (zero_copy_ && _captureVideoType == VideoType::kI420 &&
+          buf.bytesused ==
+              CalcBufferSize(VideoType::kI420, _currentWidth, _currentHeight) &&
+          buffer_pool_->num_queued() >= kMinQueuedV4L2Buffers) {
+        DeliverWrappedBuffer(buf.index);
+      } else {
+        VideoCaptureCapability frameInfo;
+        frameInfo.width = _currentWidth;
+        frameInfo.height = _currentHeight;
+        frameInfo.videoType = _captureVideoType;
+
+        // convert to to I420 if needed
+        IncomingFrame(buffer_pool_->data(buf.index), buf.bytesused, frameInfo);
+        // enqueue the buffer again
+        buffer_pool_->Enqueue(buf.index);
       }
     }
   }
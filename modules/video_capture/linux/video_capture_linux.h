@@ -16,6 +16,7 @@
 
 #include <memory>
 
+#include "api/scoped_refptr.h"
 #include "modules/video_capture/video_capture_defines.h"
 #include "modules/video_capture/video_capture_impl.h"
 #include "rtc_base/platform_thread.h"
@@ -23,6 +24,8 @@
 
 namespace webrtc {
 namespace videocapturemodule {
+class V4L2BufferPool;
+
 class VideoCaptureModuleV4L2 : public VideoCaptureImpl {
  public:
   VideoCaptureModuleV4L2();
@@ -35,11 +38,20 @@ class VideoCaptureModuleV4L2 : public VideoCaptureImpl {
 
  private:
   enum { kNoOfV4L2Bufffers = 4 };
+  // Frames hold on to their buffer when they aren't copied, so more buffers
+  // are requested.
+  enum { kNoOfZeroCopyV4L2Buffers = 8 };
+  // A buffer is copied rather than wrapped if fewer buffers than this would
+  // be left queued, so that the device never runs out of buffers.
+  enum { kMinQueuedV4L2Buffers = 2 };
 
   static void CaptureThread(void*);
   bool CaptureProcess();
   bool AllocateVideoBuffers();
   bool DeAllocateVideoBuffers();
+  // Delivers buffer `index` without copying it, and queues it to the device
+  // again once the frame is released.
+  void DeliverWrappedBuffer(int index);
 
   rtc::PlatformThread _captureThread;
   Mutex capture_lock_;
@@ -47,17 +59,15 @@ class VideoCaptureModuleV4L2 : public VideoCaptureImpl {
   int32_t _deviceId;
   int32_t _deviceFd;
 
-  int32_t _buffersAllocatedByDevice;
   int32_t _currentWidth;
   int32_t _currentHeight;
   int32_t _currentFrameRate;
   bool _captureStarted;
   VideoType _captureVideoType;
-  struct Buffer {
-    void* start;
-    size_t length;
-  };
-  Buffer* _pool;
+  // Whether I420 frames are delivered without copying them, controlled by the
+  // WebRTC-VideoCaptureV4L2ZeroCopy field trial.
+  const bool zero_copy_;
+  rtc::scoped_refptr<V4L2BufferPool> buffer_pool_;
 };
 }  // namespace videocapturemodule
 }  // namespace webrtc
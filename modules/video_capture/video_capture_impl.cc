@@ -203,6 +203,35 @@ int32_t VideoCaptureImpl::IncomingFrame(uint8_t* videoFrame,
   return 0;
 }
 
+int32_t VideoCaptureImpl::IncomingVideoFrameBuffer(
+    rtc::scoped_refptr<VideoFrameBuffer> buffer,
+    int64_t captureTime /*=0*/) {
+  MutexLock lock(&api_lock_);
+
+  TRACE_EVENT1("webrtc", "VC::IncomingVideoFrameBuffer", "capture_time",
+               captureTime);
+
+  // SetApplyRotation doesn't take any lock. Make a local copy here.
+  bool apply_rotation = apply_rotation_;
+
+  if (apply_rotation && _rotateFrame != kVideoRotation_0) {
+    buffer = I420Buffer::Rotate(*buffer->ToI420(), _rotateFrame);
+  }
+
+  VideoFrame captureFrame =
+      VideoFrame::Builder()
+          .set_video_frame_buffer(buffer)
+          .set_timestamp_rtp(0)
+          .set_timestamp_ms(rtc::TimeMillis())
+          .set_rotation(!apply_rotation ? _rotateFrame : kVideoRotation_0)
+          .build();
+  captureFrame.set_ntp_time_ms(captureTime);
+
+  DeliverCapturedFrame(captureFrame);
+
+  return 0;
+}
+
 int32_t VideoCaptureImpl::StartCapture(
     const VideoCaptureCapability& capability) {
   _requestedCapability = capability;
@@ -20,6 +20,7 @@
 
 #include "api/scoped_refptr.h"
 #include "api/video/video_frame.h"
+#include "api/video/video_frame_buffer.h"
 #include "api/video/video_rotation.h"
 #include "api/video/video_sink_interface.h"
 #include "modules/video_capture/video_capture.h"
@@ -66,6 +67,10 @@ class VideoCaptureImpl : public VideoCaptureModule {
                         size_t videoFrameLength,
                         const VideoCaptureCapability& frameInfo,
                         int64_t captureTime = 0);
+  // Delivers a frame that doesn't need to be converted, without copying it
+  // unless a rotation has to be applied.
+  int32_t IncomingVideoFrameBuffer(rtc::scoped_refptr<VideoFrameBuffer> buffer,
+                                   int64_t captureTime = 0);
 
   // Platform dependent
   int32_t StartCapture(const VideoCaptureCapability& capability) override;
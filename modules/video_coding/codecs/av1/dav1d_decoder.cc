@@ -14,12 +14,14 @@
 
 #include "api/scoped_refptr.h"
 #include "api/video/encoded_image.h"
-#include "api/video/i420_buffer.h"
-#include "common_video/include/video_frame_buffer_pool.h"
+#include "api/video/video_frame_buffer.h"
+#include "common_video/include/video_frame_buffer.h"
 #include "modules/video_coding/include/video_error_codes.h"
+#include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/ref_counted_object.h"
+#include "system_wrappers/include/field_trial.h"
 #include "third_party/dav1d/libdav1d/include/dav1d/dav1d.h"
-#include "third_party/libyuv/include/libyuv/convert.h"
 
 namespace webrtc {
 namespace {
@@ -43,7 +45,6 @@ class Dav1dDecoder : public VideoDecoder {
   const char* ImplementationName() const override;
 
  private:
-  VideoFrameBufferPool buffer_pool_;
   Dav1dContext* context_ = nullptr;
   DecodedImageCallback* decode_complete_callback_ = nullptr;
 };
@@ -58,7 +59,10 @@ class ScopedDav1dData {
   Dav1dData data_ = {};
 };
 
-class ScopedDav1dPicture {
+// Reference counted so that the decoded picture can be kept alive by the
+// buffers wrapping it, see `Decode`.
+class ScopedDav1dPicture
+    : public rtc::RefCountedNonVirtual<ScopedDav1dPicture> {
  public:
   ~ScopedDav1dPicture() { dav1d_picture_unref(&picture_); }
 
@@ -70,11 +74,32 @@ class ScopedDav1dPicture {
 
 constexpr char kDav1dName[] = "dav1d";
 
+// Allows to tune the threading of dav1d, e.g.
+// "WebRTC-Dav1dDecoder-Threading/max_threads:8,max_frame_delay:2/".
+constexpr char kDav1dThreadingFieldTrial[] = "WebRTC-Dav1dDecoder-Threading";
+
+// Returns the number of threads dav1d shares among tile and frame decoding.
+int NumberOfThreads(const VideoDecoder::Settings& settings, int max_threads) {
+  const RenderResolution& resolution = settings.max_render_resolution();
+  int num_threads = 2;
+  if (resolution.Valid()) {
+    // Like for VP9, target 2 threads for 1280x720 and scale up linearly with
+    // the pixel count, e.g. 4 threads for 1080p and 18 for 4K. More threads
+    // than that mostly add overhead when many streams are decoded at once.
+    num_threads = std::max(
+        2, 2 * resolution.Width() * resolution.Height() / (1280 * 720));
+  }
+  num_threads = std::min(num_threads, settings.number_of_cores());
+  if (max_threads > 0) {
+    num_threads = std::min(num_threads, max_threads);
+  }
+  return std::max(num_threads, 1);
+}
+
 // Calling `dav1d_data_wrap` requires a `free_callback` to be registered.
 void NullFreeCallback(const uint8_t* buffer, void* opaque) {}
 
-Dav1dDecoder::Dav1dDecoder()
-    : buffer_pool_(/*zero_initialize=*/false, /*max_number_of_buffers=*/150) {}
+Dav1dDecoder::Dav1dDecoder() = default;
 
 Dav1dDecoder::~Dav1dDecoder() {
   Release();
@@ -84,8 +109,16 @@ bool Dav1dDecoder::Configure(const Settings& settings) {
   Dav1dSettings s;
   dav1d_default_settings(&s);
 
-  s.n_threads = std::max(2, settings.number_of_cores());
-  s.max_frame_delay = 1;   // For low latency decoding.
+  // A `max_threads` of 0 means no limit other than the number of cores.
+  FieldTrialParameter<int> max_threads("max_threads", 0);
+  // Frames decoded in parallel. Every frame beyond the first adds a frame of
+  // latency, so only the tile threads of dav1d are used by default.
+  FieldTrialParameter<int> max_frame_delay("max_frame_delay", 1);
+  ParseFieldTrial({&max_threads, &max_frame_delay},
+                  field_trial::FindFullName(kDav1dThreadingFieldTrial));
+
+  s.n_threads = NumberOfThreads(settings, max_threads.Get());
+  s.max_frame_delay = std::max(max_frame_delay.Get(), 1);
   s.all_layers = 0;        // Don't output a frame for every spatial layer.
   s.operating_point = 31;  // Decode all operating points.
 
@@ -103,7 +136,6 @@ int32_t Dav1dDecoder::Release() {
   if (context_ != nullptr) {
     return WEBRTC_VIDEO_CODEC_MEMORY;
   }
-  buffer_pool_.Release();
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
@@ -138,8 +170,9 @@ int32_t Dav1dDecoder::Decode(const EncodedImage& encoded_image,
     return WEBRTC_VIDEO_CODEC_ERROR;
   }
 
-  ScopedDav1dPicture scoped_dav1d_picture;
-  Dav1dPicture& dav1d_picture = scoped_dav1d_picture.Picture();
+  rtc::scoped_refptr<ScopedDav1dPicture> scoped_dav1d_picture(
+      new ScopedDav1dPicture{});
+  Dav1dPicture& dav1d_picture = scoped_dav1d_picture->Picture();
   if (int get_picture_res = dav1d_get_picture(context_, &dav1d_picture)) {
     RTC_LOG(LS_WARNING)
         << "Dav1dDecoder::Decode getting picture failed with error code "
@@ -153,27 +186,15 @@ int32_t Dav1dDecoder::Decode(const EncodedImage& encoded_image,
     return WEBRTC_VIDEO_CODEC_ERROR;
   }
 
-  rtc::scoped_refptr<I420Buffer> buffer =
-      buffer_pool_.CreateI420Buffer(dav1d_picture.p.w, dav1d_picture.p.h);
-  if (!buffer.get()) {
-    RTC_LOG(LS_WARNING)
-        << "Dav1dDecoder::Decode failed to get frame from the buffer pool.";
-    return WEBRTC_VIDEO_CODEC_ERROR;
-  }
-
-  uint8_t* y_data = static_cast<uint8_t*>(dav1d_picture.data[0]);
-  uint8_t* u_data = static_cast<uint8_t*>(dav1d_picture.data[1]);
-  uint8_t* v_data = static_cast<uint8_t*>(dav1d_picture.data[2]);
-  int y_stride = dav1d_picture.stride[0];
-  int uv_stride = dav1d_picture.stride[1];
-  libyuv::I420Copy(y_data, y_stride,                           //
-                   u_data, uv_stride,                          //
-                   v_data, uv_stride,                          //
-                   buffer->MutableDataY(), buffer->StrideY(),  //
-                   buffer->MutableDataU(), buffer->StrideU(),  //
-                   buffer->MutableDataV(), buffer->StrideV(),  //
-                   dav1d_picture.p.w,                          //
-                   dav1d_picture.p.h);                         //
+  // Wrap the picture without copying. dav1d allocates pictures from its own
+  // pool, and only reuses a picture when all buffers wrapping it are gone.
+  rtc::scoped_refptr<VideoFrameBuffer> buffer = WrapI420Buffer(
+      dav1d_picture.p.w, dav1d_picture.p.h,
+      static_cast<uint8_t*>(dav1d_picture.data[0]), dav1d_picture.stride[0],
+      static_cast<uint8_t*>(dav1d_picture.data[1]), dav1d_picture.stride[1],
+      static_cast<uint8_t*>(dav1d_picture.data[2]), dav1d_picture.stride[1],
+      // Keeps `scoped_dav1d_picture` alive.
+      [scoped_dav1d_picture] {});
 
   VideoFrame decoded_frame = VideoFrame::Builder()
                                  .set_video_frame_buffer(buffer)
@@ -12,6 +12,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -30,8 +31,12 @@
 #include "modules/video_coding/svc/create_scalability_structure.h"
 #include "modules/video_coding/svc/scalable_video_controller.h"
 #include "modules/video_coding/svc/scalable_video_controller_no_layering.h"
+#include "modules/video_coding/utility/active_map_tracker.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/field_trial.h"
 #include "third_party/libaom/source/libaom/aom/aom_codec.h"
 #include "third_party/libaom/source/libaom/aom/aom_encoder.h"
 #include "third_party/libaom/source/libaom/aom/aomcx.h"
@@ -49,6 +54,36 @@ constexpr int kLagInFrames = 0;  // No look ahead.
 constexpr int kRtpTicksPerSecond = 90000;
 constexpr float kMinimumFrameRate = 1.0;
 
+// Adjusts the speed preset to the measured encode time when enabled, e.g.
+// "WebRTC-Av1-AdaptiveSpeed/Enabled,max_speed:10,overuse:0.85,underuse:0.5/".
+constexpr char kAdaptiveSpeedFieldTrial[] = "WebRTC-Av1-AdaptiveSpeed";
+
+struct AdaptiveSpeedConfig {
+  bool enabled = false;
+  // The fastest preset to use. The slowest one is that of GetCpuSpeed().
+  int max_speed = 10;
+  // Fractions of the frame interval. Above `overuse_fraction` the encoder is
+  // made faster, below `underuse_fraction` it is made slower again.
+  double overuse_fraction = 0.85;
+  double underuse_fraction = 0.5;
+};
+
+AdaptiveSpeedConfig ParseAdaptiveSpeedConfig() {
+  FieldTrialFlag enabled("Enabled");
+  FieldTrialParameter<int> max_speed("max_speed", 10);
+  FieldTrialParameter<double> overuse_fraction("overuse", 0.85);
+  FieldTrialParameter<double> underuse_fraction("underuse", 0.5);
+  ParseFieldTrial({&enabled, &max_speed, &overuse_fraction, &underuse_fraction},
+                  field_trial::FindFullName(kAdaptiveSpeedFieldTrial));
+  AdaptiveSpeedConfig config;
+  config.enabled = enabled.Get();
+  config.max_speed = max_speed.Get();
+  config.overuse_fraction = overuse_fraction.Get();
+  config.underuse_fraction =
+      std::min(underuse_fraction.Get(), overuse_fraction.Get());
+  return config;
+}
+
 // Only positive speeds, range for real-time coding currently is: 6 - 8.
 // Lower means slower/better quality, higher means fastest/lower quality.
 int GetCpuSpeed(int width, int height, int number_of_cores) {
@@ -105,6 +140,24 @@ class LibaomAv1Encoder final : public VideoEncoder {
   // Configures the encoder which buffers next frame updates and can reference.
   void SetSvcRefFrameConfig(
       const ScalableVideoController::LayerFrameConfig& layer_frame);
+  // Adds the time spent encoding a picture, and once a second moves the speed
+  // preset one step if the average encode time is too close to the frame
+  // interval, or far below it.
+  void MaybeAdaptSpeed(int64_t encode_time_us);
+
+  const AdaptiveSpeedConfig adaptive_speed_config_;
+  // The speed preset set at init, the current one and the fastest one.
+  int base_speed_;
+  int speed_;
+  int max_speed_;
+  int64_t speed_window_start_us_;
+  int64_t speed_window_encode_time_us_;
+  int speed_window_pictures_;
+
+  // Skips the blocks of screenshare frames that are unchanged since the last
+  // frame was encoded, for streams without spatial or temporal layers.
+  ActiveMapTracker active_map_;
+  bool active_map_set_;
 
   std::unique_ptr<ScalableVideoController> svc_controller_;
   bool inited_;
@@ -143,7 +196,17 @@ int32_t VerifyCodecSettings(const VideoCodec& codec_settings) {
 }
 
 LibaomAv1Encoder::LibaomAv1Encoder()
-    : inited_(false),
+    : adaptive_speed_config_(ParseAdaptiveSpeedConfig()),
+      base_speed_(0),
+      speed_(0),
+      max_speed_(0),
+      speed_window_start_us_(-1),
+      speed_window_encode_time_us_(0),
+      speed_window_pictures_(0),
+      active_map_(
+          field_trial::FindFullName(ActiveMapTracker::kFieldTrialName)),
+      active_map_set_(false),
+      inited_(false),
       rates_configured_(false),
       frame_for_encode_(nullptr),
       encoded_image_callback_(nullptr) {}
@@ -245,11 +308,17 @@ int LibaomAv1Encoder::InitEncode(const VideoCodec* codec_settings,
     return WEBRTC_VIDEO_CODEC_ERROR;
   }
   inited_ = true;
+  active_map_.Reset(cfg_.g_w, cfg_.g_h);
+  active_map_set_ = false;
 
   // Set control parameters
-  ret = aom_codec_control(
-      &ctx_, AOME_SET_CPUUSED,
-      GetCpuSpeed(cfg_.g_w, cfg_.g_h, settings.number_of_cores));
+  base_speed_ = GetCpuSpeed(cfg_.g_w, cfg_.g_h, settings.number_of_cores);
+  speed_ = base_speed_;
+  max_speed_ = std::max(base_speed_, adaptive_speed_config_.max_speed);
+  speed_window_start_us_ = -1;
+  speed_window_encode_time_us_ = 0;
+  speed_window_pictures_ = 0;
+  ret = aom_codec_control(&ctx_, AOME_SET_CPUUSED, speed_);
   if (ret != AOM_CODEC_OK) {
     RTC_LOG(LS_WARNING) << "LibaomAv1Encoder::EncodeInit returned " << ret
                         << " on control AV1E_SET_CPUUSED.";
@@ -562,6 +631,13 @@ int32_t LibaomAv1Encoder::Encode(
     return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
   }
 
+  const bool use_active_map =
+      active_map_.enabled() && !SvcEnabled() &&
+      encoder_settings_.mode == VideoCodecMode::kScreensharing;
+  if (use_active_map) {
+    active_map_.OnInputFrame(frame.update_rect());
+  }
+
   bool keyframe_required =
       frame_types != nullptr &&
       absl::c_linear_search(*frame_types, VideoFrameType::kVideoFrameKey);
@@ -610,9 +686,32 @@ int32_t LibaomAv1Encoder::Encode(
   const uint32_t duration =
       kRtpTicksPerSecond / static_cast<float>(encoder_settings_.maxFramerate);
 
+  if (use_active_map) {
+    // Without layers, every encoded frame is stored in the buffer that the
+    // next frame references as LAST, which inactive blocks are copied from.
+    const bool skip_static_blocks =
+        !layer_frames.front().IsKeyframe() &&
+        active_map_.BuildMap(/*reference_buffer=*/0);
+    if (skip_static_blocks || active_map_set_) {
+      aom_active_map_t active_map;
+      active_map.active_map = skip_static_blocks ? active_map_.map() : nullptr;
+      active_map.rows = active_map_.rows();
+      active_map.cols = active_map_.cols();
+      aom_codec_err_t ret =
+          aom_codec_control(&ctx_, AOME_SET_ACTIVEMAP, &active_map);
+      if (ret == AOM_CODEC_OK) {
+        active_map_set_ = skip_static_blocks;
+      } else {
+        RTC_LOG(LS_WARNING) << "LibaomAv1Encoder::Encode returned " << ret
+                            << " on control AOME_SET_ACTIVEMAP.";
+      }
+    }
+  }
+
   const size_t num_spatial_layers =
       svc_params_ ? svc_params_->number_spatial_layers : 1;
   auto next_layer_frame = layer_frames.begin();
+  int64_t encode_time_us = 0;
   for (size_t i = 0; i < num_spatial_layers; ++i) {
     // The libaom AV1 encoder requires that `aom_codec_encode` is called for
     // every spatial layer, even if the configured bitrate for that layer is
@@ -649,8 +748,10 @@ int32_t LibaomAv1Encoder::Encode(
     }
 
     // Encode a frame.
+    const int64_t encode_start_us = rtc::TimeMicros();
     aom_codec_err_t ret = aom_codec_encode(&ctx_, frame_for_encode_,
                                            frame.timestamp(), duration, flags);
+    encode_time_us += rtc::TimeMicros() - encode_start_us;
     if (ret != AOM_CODEC_OK) {
       RTC_LOG(LS_WARNING) << "LibaomAv1Encoder::Encode returned " << ret
                           << " on aom_codec_encode.";
@@ -716,6 +817,9 @@ int32_t LibaomAv1Encoder::Encode(
 
     // Deliver encoded image data.
     if (encoded_image.size() > 0) {
+      if (use_active_map) {
+        active_map_.OnBufferUpdated(/*buffer=*/0);
+      }
       CodecSpecificInfo codec_specific_info;
       codec_specific_info.codecType = kVideoCodecAV1;
       codec_specific_info.end_of_picture = end_of_picture;
@@ -743,9 +847,62 @@ int32_t LibaomAv1Encoder::Encode(
     }
   }
 
+  if (adaptive_speed_config_.enabled) {
+    MaybeAdaptSpeed(encode_time_us);
+  }
+
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
+void LibaomAv1Encoder::MaybeAdaptSpeed(int64_t encode_time_us) {
+  const int64_t now_us = rtc::TimeMicros();
+  if (speed_window_start_us_ < 0) {
+    speed_window_start_us_ = now_us;
+  }
+  speed_window_encode_time_us_ += encode_time_us;
+  ++speed_window_pictures_;
+  if (now_us - speed_window_start_us_ < rtc::kNumMicrosecsPerSec) {
+    return;
+  }
+  const double average_encode_time_us =
+      static_cast<double>(speed_window_encode_time_us_) /
+      speed_window_pictures_;
+  const double frame_interval_us =
+      static_cast<double>(rtc::kNumMicrosecsPerSec) /
+      encoder_settings_.maxFramerate;
+  speed_window_start_us_ = now_us;
+  speed_window_encode_time_us_ = 0;
+  speed_window_pictures_ = 0;
+
+  int speed = speed_;
+  if (average_encode_time_us >
+          adaptive_speed_config_.overuse_fraction * frame_interval_us &&
+      speed < max_speed_) {
+    ++speed;
+  } else if (average_encode_time_us <
+                 adaptive_speed_config_.underuse_fraction * frame_interval_us &&
+             speed > base_speed_) {
+    --speed;
+  }
+  if (speed == speed_) {
+    return;
+  }
+  aom_codec_err_t ret = aom_codec_control(&ctx_, AOME_SET_CPUUSED, speed);
+  if (ret != AOM_CODEC_OK) {
+    // Presumably beyond the presets of this libaom version, so stay at the
+    // current speed from now on.
+    RTC_LOG(LS_WARNING) << "LibaomAv1Encoder::Encode returned " << ret
+                        << " on control AOME_SET_CPUUSED " << speed;
+    max_speed_ = speed_;
+    return;
+  }
+  RTC_LOG(LS_INFO) << "Average encode time " << average_encode_time_us
+                   << " us of " << frame_interval_us
+                   << " us frame interval, speed " << speed_ << " -> "
+                   << speed;
+  speed_ = speed;
+}
+
 void LibaomAv1Encoder::SetRates(const RateControlParameters& parameters) {
   if (!inited_) {
     RTC_LOG(LS_WARNING) << "SetRates() while encoder is not initialized";
@@ -18,6 +18,7 @@
 #include "api/video_codecs/video_encoder.h"
 #include "modules/video_coding/codecs/test/encoded_video_frame_producer.h"
 #include "modules/video_coding/include/video_error_codes.h"
+#include "test/field_trial.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
@@ -235,5 +236,22 @@ TEST(LibaomAv1EncoderTest, PopulatesEncodedFrameSize) {
                             codec_settings.height)))));
 }
 
+TEST(LibaomAv1EncoderTest, EncodesWithAdaptiveSpeed) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-Av1-AdaptiveSpeed/Enabled,max_speed:10/");
+  std::unique_ptr<VideoEncoder> encoder = CreateLibaomAv1Encoder();
+  VideoCodec codec_settings = DefaultCodecSettings();
+  ASSERT_EQ(encoder->InitEncode(&codec_settings, DefaultEncoderSettings()),
+            WEBRTC_VIDEO_CODEC_OK);
+  VideoBitrateAllocation allocation;
+  allocation.SetBitrate(0, 0, 300000);
+  encoder->SetRates(VideoEncoder::RateControlParameters(
+      allocation, codec_settings.maxFramerate));
+
+  std::vector<EncodedVideoFrameProducer::EncodedFrame> encoded_frames =
+      EncodedVideoFrameProducer(*encoder).SetNumInputFrames(8).Encode();
+  EXPECT_THAT(encoded_frames, SizeIs(8));
+}
+
 }  // namespace
 }  // namespace webrtc
@@ -23,6 +23,7 @@
 extern "C" {
 #include "third_party/ffmpeg/libavcodec/avcodec.h"
 #include "third_party/ffmpeg/libavformat/avformat.h"
+#include "third_party/ffmpeg/libavutil/hwcontext.h"
 #include "third_party/ffmpeg/libavutil/imgutils.h"
 }  // extern "C"
 
@@ -31,7 +32,9 @@ extern "C" {
 #include "api/video/i420_buffer.h"
 #include "common_video/include/video_frame_buffer.h"
 #include "modules/video_coding/codecs/h264/h264_color_space.h"
+#include "modules/video_coding/codecs/h264/h264_hardware_frame_buffer.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/logging.h"
 #include "system_wrappers/include/field_trial.h"
 #include "system_wrappers/include/metrics.h"
@@ -47,6 +50,11 @@ const size_t kYPlaneIndex = 0;
 const size_t kUPlaneIndex = 1;
 const size_t kVPlaneIndex = 2;
 
+// Decodes with an FFmpeg hardware device when enabled, e.g.
+// "WebRTC-Video-H264HardwareDecoding/Enabled,type:cuda,extra_frames:16/".
+constexpr char kHardwareDecodingFieldTrial[] =
+    "WebRTC-Video-H264HardwareDecoding";
+
 // Used by histograms. Values of entries should not be changed.
 enum H264DecoderImplEvent {
   kH264DecoderEventInit = 0,
@@ -66,9 +74,27 @@ ScopedAVPacket MakeScopedAVPacket() {
 
 }  // namespace
 
+// static
+absl::optional<H264DecoderImpl::HardwareDecodingConfig>
+H264DecoderImpl::ParseHardwareDecodingConfig() {
+  FieldTrialFlag enabled("Enabled");
+  FieldTrialParameter<std::string> device_type("type", "vaapi");
+  FieldTrialParameter<int> extra_frames("extra_frames", 8);
+  ParseFieldTrial({&enabled, &device_type, &extra_frames},
+                  field_trial::FindFullName(kHardwareDecodingFieldTrial));
+  if (!enabled)
+    return absl::nullopt;
+  return HardwareDecodingConfig{device_type.Get(),
+                                std::max(extra_frames.Get(), 0)};
+}
+
 int H264DecoderImpl::AVGetBuffer2(AVCodecContext* context,
                                   AVFrame* av_frame,
                                   int flags) {
+  // Hardware frames are allocated from the surfaces of the device.
+  if (context->hw_frames_ctx)
+    return avcodec_default_get_buffer2(context, av_frame, flags);
+
   // Set in `Configure`.
   H264DecoderImpl* decoder = static_cast<H264DecoderImpl*>(context->opaque);
   // DCHECK values set in `Configure`.
@@ -114,6 +140,12 @@ int H264DecoderImpl::AVGetBuffer2(AVCodecContext* context,
   // an explicit call to InitializeData here.
   rtc::scoped_refptr<I420Buffer> frame_buffer =
       decoder->ffmpeg_buffer_pool_.CreateI420Buffer(width, height);
+  if (!frame_buffer) {
+    // The shared buffer pool is out of memory.
+    RTC_LOG(LS_WARNING) << "Failed to allocate a " << width << "x" << height
+                        << " frame buffer.";
+    return AVERROR(ENOMEM);
+  }
 
   int y_size = width * height;
   int uv_size = frame_buffer->ChromaWidth() * frame_buffer->ChromaHeight();
@@ -159,14 +191,36 @@ void H264DecoderImpl::AVFreeBuffer2(void* opaque, uint8_t* data) {
   delete video_frame;
 }
 
+AVPixelFormat H264DecoderImpl::AVGetFormat(AVCodecContext* context,
+                                           const AVPixelFormat* formats) {
+  // Set in `Configure`.
+  H264DecoderImpl* decoder = static_cast<H264DecoderImpl*>(context->opaque);
+  RTC_DCHECK(decoder);
+  for (const AVPixelFormat* format = formats; *format != AV_PIX_FMT_NONE;
+       ++format) {
+    if (*format == decoder->hardware_pixel_format_)
+      return *format;
+  }
+  // E.g. a profile that the device can't decode.
+  RTC_LOG(LS_WARNING) << "Hardware decoding not supported for the stream, "
+                         "falling back to software decoding.";
+  return avcodec_default_get_format(context, formats);
+}
+
 H264DecoderImpl::H264DecoderImpl()
-    : ffmpeg_buffer_pool_(true),
+    : ffmpeg_buffer_pool_(/*zero_initialize=*/true,
+                          std::numeric_limits<size_t>::max(),
+                          SharedVideoFrameBufferPool::GetInstance()),
+      output_buffer_pool_(/*zero_initialize=*/false,
+                          std::numeric_limits<size_t>::max(),
+                          SharedVideoFrameBufferPool::GetInstance()),
       decoded_image_callback_(nullptr),
       has_reported_init_(false),
       has_reported_error_(false),
       preferred_output_format_(field_trial::IsEnabled("WebRTC-NV12Decode")
                                    ? VideoFrameBuffer::Type::kNV12
-                                   : VideoFrameBuffer::Type::kI420) {}
+                                   : VideoFrameBuffer::Type::kI420),
+      hardware_decoding_(ParseHardwareDecodingConfig()) {}
 
 H264DecoderImpl::~H264DecoderImpl() {
   Release();
@@ -221,6 +275,11 @@ bool H264DecoderImpl::Configure(const Settings& settings) {
     ReportError();
     return false;
   }
+  if (hardware_decoding_ && !InitHardwareDecoding(codec)) {
+    RTC_LOG(LS_WARNING) << "Hardware decoding with "
+                        << hardware_decoding_->device_type
+                        << " not available, decoding in software.";
+  }
   int res = avcodec_open2(av_context_.get(), codec, nullptr);
   if (res < 0) {
     RTC_LOG(LS_ERROR) << "avcodec_open2 error: " << res;
@@ -243,9 +302,45 @@ bool H264DecoderImpl::Configure(const Settings& settings) {
 int32_t H264DecoderImpl::Release() {
   av_context_.reset();
   av_frame_.reset();
+  hardware_pixel_format_ = AV_PIX_FMT_NONE;
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
+bool H264DecoderImpl::InitHardwareDecoding(const AVCodec* codec) {
+  AVHWDeviceType device_type =
+      av_hwdevice_find_type_by_name(hardware_decoding_->device_type.c_str());
+  if (device_type == AV_HWDEVICE_TYPE_NONE) {
+    RTC_LOG(LS_ERROR) << "Unknown hardware device type "
+                      << hardware_decoding_->device_type;
+    return false;
+  }
+  for (int i = 0;; ++i) {
+    const AVCodecHWConfig* config = avcodec_get_hw_config(codec, i);
+    if (!config)
+      return false;
+    if ((config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX) &&
+        config->device_type == device_type) {
+      hardware_pixel_format_ = config->pix_fmt;
+      break;
+    }
+  }
+
+  AVBufferRef* device_context = nullptr;
+  int result = av_hwdevice_ctx_create(&device_context, device_type,
+                                      /*device=*/nullptr,
+                                      /*opts=*/nullptr, /*flags=*/0);
+  if (result < 0) {
+    RTC_LOG(LS_ERROR) << "av_hwdevice_ctx_create error: " << result;
+    hardware_pixel_format_ = AV_PIX_FMT_NONE;
+    return false;
+  }
+  // Owned by `av_context_` from here.
+  av_context_->hw_device_ctx = device_context;
+  av_context_->get_format = AVGetFormat;
+  av_context_->extra_hw_frames = hardware_decoding_->extra_frames;
+  return true;
+}
+
 int32_t H264DecoderImpl::RegisterDecodeCompleteCallback(
     DecodedImageCallback* callback) {
   decoded_image_callback_ = callback;
@@ -311,6 +406,37 @@ int32_t H264DecoderImpl::Decode(const EncodedImage& input_image,
   h264_bitstream_parser_.ParseBitstream(input_image);
   absl::optional<int> qp = h264_bitstream_parser_.GetLastSliceQp();
 
+  rtc::scoped_refptr<VideoFrameBuffer> frame_buffer = CreateFrameBuffer();
+
+  // Pass on color space from input frame if explicitly specified.
+  const ColorSpace& color_space =
+      input_image.ColorSpace() ? *input_image.ColorSpace()
+                               : ExtractH264ColorSpace(av_context_.get());
+
+  VideoFrame decoded_frame = VideoFrame::Builder()
+                                 .set_video_frame_buffer(frame_buffer)
+                                 .set_timestamp_rtp(input_image.Timestamp())
+                                 .set_color_space(color_space)
+                                 .build();
+
+  // Return decoded frame.
+  // TODO(nisse): Timestamp and rotation are all zero here. Change decoder
+  // interface to pass a VideoFrameBuffer instead of a VideoFrame?
+  decoded_image_callback_->Decoded(decoded_frame, absl::nullopt, qp);
+
+  // Stop referencing the decoded image, possibly freeing it.
+  av_frame_unref(av_frame_.get());
+
+  return WEBRTC_VIDEO_CODEC_OK;
+}
+
+rtc::scoped_refptr<VideoFrameBuffer> H264DecoderImpl::CreateFrameBuffer() {
+  // Hardware frames stay on the device until they are used.
+  if (hardware_pixel_format_ != AV_PIX_FMT_NONE &&
+      av_frame_->format == hardware_pixel_format_) {
+    return H264HardwareFrameBuffer::Create(*av_frame_);
+  }
+
   // Obtain the `video_frame` containing the decoded image.
   VideoFrame* input_frame =
       static_cast<VideoFrame*>(av_buffer_get_opaque(av_frame_->buf[0]));
@@ -352,36 +478,20 @@ int32_t H264DecoderImpl::Decode(const EncodedImage& input_image,
     const I420BufferInterface* cropped_i420 = cropped_buffer->GetI420();
     auto nv12_buffer = output_buffer_pool_.CreateNV12Buffer(
         cropped_i420->width(), cropped_i420->height());
-    libyuv::I420ToNV12(cropped_i420->DataY(), cropped_i420->StrideY(),
-                       cropped_i420->DataU(), cropped_i420->StrideU(),
-                       cropped_i420->DataV(), cropped_i420->StrideV(),
-                       nv12_buffer->MutableDataY(), nv12_buffer->StrideY(),
-                       nv12_buffer->MutableDataUV(), nv12_buffer->StrideUV(),
-                       i420_buffer->width(), i420_buffer->height());
-    cropped_buffer = nv12_buffer;
+    // If the shared buffer pool is out of memory, the frame is output in
+    // I420 rather than dropped.
+    if (nv12_buffer) {
+      libyuv::I420ToNV12(cropped_i420->DataY(), cropped_i420->StrideY(),
+                         cropped_i420->DataU(), cropped_i420->StrideU(),
+                         cropped_i420->DataV(), cropped_i420->StrideV(),
+                         nv12_buffer->MutableDataY(), nv12_buffer->StrideY(),
+                         nv12_buffer->MutableDataUV(), nv12_buffer->StrideUV(),
+                         i420_buffer->width(), i420_buffer->height());
+      cropped_buffer = nv12_buffer;
+    }
   }
 
-  // Pass on color space from input frame if explicitly specified.
-  const ColorSpace& color_space =
-      input_image.ColorSpace() ? *input_image.ColorSpace()
-                               : ExtractH264ColorSpace(av_context_.get());
-
-  VideoFrame decoded_frame = VideoFrame::Builder()
-                                 .set_video_frame_buffer(cropped_buffer)
-                                 .set_timestamp_rtp(input_image.Timestamp())
-                                 .set_color_space(color_space)
-                                 .build();
-
-  // Return decoded frame.
-  // TODO(nisse): Timestamp and rotation are all zero here. Change decoder
-  // interface to pass a VideoFrameBuffer instead of a VideoFrame?
-  decoded_image_callback_->Decoded(decoded_frame, absl::nullopt, qp);
-
-  // Stop referencing it, possibly freeing `input_frame`.
-  av_frame_unref(av_frame_.get());
-  input_frame = nullptr;
-
-  return WEBRTC_VIDEO_CODEC_OK;
+  return cropped_buffer;
 }
 
 const char* H264DecoderImpl::ImplementationName() const {
@@ -22,6 +22,7 @@
 #endif
 
 #include <memory>
+#include <string>
 
 #include "modules/video_coding/codecs/h264/include/h264.h"
 
@@ -43,17 +44,16 @@ extern "C" {
 #include "third_party/ffmpeg/libavcodec/avcodec.h"
 }  // extern "C"
 
+#include "absl/types/optional.h"
 #include "common_video/h264/h264_bitstream_parser.h"
 #include "common_video/include/video_frame_buffer_pool.h"
+#include "modules/video_coding/codecs/h264/h264_hardware_frame_buffer.h"
 
 namespace webrtc {
 
 struct AVCodecContextDeleter {
   void operator()(AVCodecContext* ptr) const { avcodec_free_context(&ptr); }
 };
-struct AVFrameDeleter {
-  void operator()(AVFrame* ptr) const { av_frame_free(&ptr); }
-};
 
 class H264DecoderImpl : public H264Decoder {
  public:
@@ -74,6 +74,17 @@ class H264DecoderImpl : public H264Decoder {
   const char* ImplementationName() const override;
 
  private:
+  struct HardwareDecodingConfig {
+    // The FFmpeg device type to decode with, e.g. "vaapi" or "cuda".
+    std::string device_type;
+    // Surfaces allocated in addition to those the decoder needs itself, for
+    // the decoded frames that are held by the consumers of the decoder.
+    int extra_frames;
+  };
+
+  // Parses the "WebRTC-Video-H264HardwareDecoding" field trial.
+  static absl::optional<HardwareDecodingConfig> ParseHardwareDecodingConfig();
+
   // Called by FFmpeg when it needs a frame buffer to store decoded frames in.
   // The `VideoFrame` returned by FFmpeg at `Decode` originate from here. Their
   // buffers are reference counted and freed by FFmpeg using `AVFreeBuffer2`.
@@ -82,9 +93,19 @@ class H264DecoderImpl : public H264Decoder {
                           int flags);
   // Called by FFmpeg when it is done with a video frame, see `AVGetBuffer2`.
   static void AVFreeBuffer2(void* opaque, uint8_t* data);
+  // Called by FFmpeg to choose the output format, see `InitHardwareDecoding`.
+  static AVPixelFormat AVGetFormat(AVCodecContext* context,
+                                   const AVPixelFormat* formats);
 
   bool IsInitialized() const;
 
+  // Attaches a hardware device of `hardware_decoding_` to `av_context_`.
+  // Returns false if the device or `codec` doesn't support it, in which case
+  // frames are decoded in software.
+  bool InitHardwareDecoding(const AVCodec* codec);
+  // Returns the buffer of the decoded `av_frame_`.
+  rtc::scoped_refptr<VideoFrameBuffer> CreateFrameBuffer();
+
   // Reports statistics with histograms.
   void ReportInit();
   void ReportError();
@@ -105,6 +126,11 @@ class H264DecoderImpl : public H264Decoder {
 
   // Decoder should produce this format if possible.
   const VideoFrameBuffer::Type preferred_output_format_;
+
+  // Set if frames should be decoded by a hardware device.
+  const absl::optional<HardwareDecodingConfig> hardware_decoding_;
+  // The pixel format of hardware frames, if hardware decoding is used.
+  AVPixelFormat hardware_pixel_format_ = AV_PIX_FMT_NONE;
 };
 
 }  // namespace webrtc
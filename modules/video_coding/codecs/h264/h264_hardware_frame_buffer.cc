@@ -0,0 +1,134 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ *
+ */
+
+// Everything declared/defined in this header is only required when WebRTC is
+// build with H264 support, please do not move anything out of the
+// #ifdef unless needed and tested.
+#ifdef WEBRTC_USE_H264
+
+#include "modules/video_coding/codecs/h264/h264_hardware_frame_buffer.h"
+
+#include <algorithm>
+#include <utility>
+
+extern "C" {
+#include "third_party/ffmpeg/libavutil/hwcontext.h"
+#include "third_party/ffmpeg/libavutil/pixfmt.h"
+}  // extern "C"
+
+#include "api/video/i420_buffer.h"
+#include "api/video/nv12_buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/ref_counted_object.h"
+#include "third_party/libyuv/include/libyuv/convert.h"
+#include "third_party/libyuv/include/libyuv/planar_functions.h"
+
+namespace webrtc {
+
+// static
+rtc::scoped_refptr<H264HardwareFrameBuffer> H264HardwareFrameBuffer::Create(
+    const AVFrame& av_frame) {
+  RTC_DCHECK(av_frame.hw_frames_ctx);
+  std::unique_ptr<AVFrame, AVFrameDeleter> frame(av_frame_clone(&av_frame));
+  RTC_CHECK(frame);
+  return rtc::make_ref_counted<H264HardwareFrameBuffer>(std::move(frame));
+}
+
+H264HardwareFrameBuffer::H264HardwareFrameBuffer(
+    std::unique_ptr<AVFrame, AVFrameDeleter> av_frame)
+    : av_frame_(std::move(av_frame)) {}
+
+H264HardwareFrameBuffer::~H264HardwareFrameBuffer() = default;
+
+int H264HardwareFrameBuffer::width() const {
+  return av_frame_->width;
+}
+
+int H264HardwareFrameBuffer::height() const {
+  return av_frame_->height;
+}
+
+rtc::scoped_refptr<I420BufferInterface> H264HardwareFrameBuffer::ToI420() {
+  std::unique_ptr<AVFrame, AVFrameDeleter> frame = Download();
+  if (!frame)
+    return nullptr;
+
+  rtc::scoped_refptr<I420Buffer> i420_buffer =
+      I420Buffer::Create(width(), height());
+  switch (frame->format) {
+    case AV_PIX_FMT_NV12:
+      libyuv::NV12ToI420(frame->data[0], frame->linesize[0], frame->data[1],
+                         frame->linesize[1], i420_buffer->MutableDataY(),
+                         i420_buffer->StrideY(), i420_buffer->MutableDataU(),
+                         i420_buffer->StrideU(), i420_buffer->MutableDataV(),
+                         i420_buffer->StrideV(), width(), height());
+      return i420_buffer;
+    case AV_PIX_FMT_YUV420P:
+    case AV_PIX_FMT_YUVJ420P:
+      libyuv::I420Copy(frame->data[0], frame->linesize[0], frame->data[1],
+                       frame->linesize[1], frame->data[2], frame->linesize[2],
+                       i420_buffer->MutableDataY(), i420_buffer->StrideY(),
+                       i420_buffer->MutableDataU(), i420_buffer->StrideU(),
+                       i420_buffer->MutableDataV(), i420_buffer->StrideV(),
+                       width(), height());
+      return i420_buffer;
+    default:
+      RTC_LOG(LS_ERROR) << "Unsupported download format " << frame->format;
+      return nullptr;
+  }
+}
+
+rtc::scoped_refptr<VideoFrameBuffer>
+H264HardwareFrameBuffer::GetMappedFrameBuffer(rtc::ArrayView<Type> types) {
+  if (std::find(types.begin(), types.end(), Type::kNV12) != types.end()) {
+    std::unique_ptr<AVFrame, AVFrameDeleter> frame = Download();
+    if (frame && frame->format == AV_PIX_FMT_NV12) {
+      rtc::scoped_refptr<NV12Buffer> nv12_buffer =
+          NV12Buffer::Create(width(), height());
+      libyuv::CopyPlane(frame->data[0], frame->linesize[0],
+                        nv12_buffer->MutableDataY(), nv12_buffer->StrideY(),
+                        width(), height());
+      libyuv::CopyPlane(frame->data[1], frame->linesize[1],
+                        nv12_buffer->MutableDataUV(), nv12_buffer->StrideUV(),
+                        nv12_buffer->ChromaWidth() * 2,
+                        nv12_buffer->ChromaHeight());
+      return nv12_buffer;
+    }
+  }
+  if (std::find(types.begin(), types.end(), Type::kI420) != types.end()) {
+    return ToI420();
+  }
+  return nullptr;
+}
+
+std::unique_ptr<AVFrame, AVFrameDeleter> H264HardwareFrameBuffer::Download()
+    const {
+  std::unique_ptr<AVFrame, AVFrameDeleter> frame(av_frame_alloc());
+  if (!frame)
+    return nullptr;
+  // With the format left unset, the frame downloads in the first format that
+  // the device supports, which needs no conversion.
+  int result = av_hwframe_transfer_data(frame.get(), av_frame_.get(), 0);
+  if (result < 0) {
+    RTC_LOG(LS_ERROR) << "av_hwframe_transfer_data error: " << result;
+    return nullptr;
+  }
+  // The download may include the padding of the surface beyond the cropped
+  // frame size.
+  RTC_DCHECK_GE(frame->width, width());
+  RTC_DCHECK_GE(frame->height, height());
+  return frame;
+}
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_USE_H264
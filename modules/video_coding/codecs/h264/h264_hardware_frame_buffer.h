@@ -0,0 +1,83 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ *
+ */
+
+#ifndef MODULES_VIDEO_CODING_CODECS_H264_H264_HARDWARE_FRAME_BUFFER_H_
+#define MODULES_VIDEO_CODING_CODECS_H264_H264_HARDWARE_FRAME_BUFFER_H_
+
+// Everything declared in this header is only required when WebRTC is
+// build with H264 support, please do not move anything out of the
+// #ifdef unless needed and tested.
+#ifdef WEBRTC_USE_H264
+
+#include <memory>
+
+extern "C" {
+#include "third_party/ffmpeg/libavutil/frame.h"
+}  // extern "C"
+
+#include "api/array_view.h"
+#include "api/scoped_refptr.h"
+#include "api/video/video_frame_buffer.h"
+
+namespace webrtc {
+
+struct AVFrameDeleter {
+  void operator()(AVFrame* ptr) const { av_frame_free(&ptr); }
+};
+
+// A native buffer of a frame decoded by an FFmpeg hardware decoder, such as
+// VAAPI or NVDEC. The frame stays in the hardware surface it was decoded to,
+// and is only downloaded to main memory by ToI420() or
+// GetMappedFrameBuffer(). So frames that are dropped, or that are consumed by
+// a renderer or encoder using the same device, are never copied.
+//
+// The surface is returned to the decoder when the buffer is destroyed. The
+// decoder only has a limited number of surfaces, so the buffer should not be
+// held for longer than needed.
+class H264HardwareFrameBuffer : public VideoFrameBuffer {
+ public:
+  // Takes a new reference to `av_frame`, which must hold a hardware frame.
+  static rtc::scoped_refptr<H264HardwareFrameBuffer> Create(
+      const AVFrame& av_frame);
+
+  Type type() const override { return Type::kNative; }
+  int width() const override;
+  int height() const override;
+
+  // Downloads and converts the frame. Returns nullptr if the download fails
+  // or the frame downloads in an unsupported format.
+  rtc::scoped_refptr<I420BufferInterface> ToI420() override;
+  // Supports kNV12, which is the format that hardware decoders download
+  // without conversion, and kI420.
+  rtc::scoped_refptr<VideoFrameBuffer> GetMappedFrameBuffer(
+      rtc::ArrayView<Type> types) override;
+
+  // The hardware frame, for consumers that can use the surface directly.
+  const AVFrame& av_frame() const { return *av_frame_; }
+
+ protected:
+  explicit H264HardwareFrameBuffer(
+      std::unique_ptr<AVFrame, AVFrameDeleter> av_frame);
+  ~H264HardwareFrameBuffer() override;
+
+ private:
+  // Downloads the frame to main memory, in the format preferred by the
+  // device. Returns nullptr on failure.
+  std::unique_ptr<AVFrame, AVFrameDeleter> Download() const;
+
+  const std::unique_ptr<AVFrame, AVFrameDeleter> av_frame_;
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_USE_H264
+
+#endif  // MODULES_VIDEO_CODING_CODECS_H264_H264_HARDWARE_FRAME_BUFFER_H_
@@ -0,0 +1,193 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/codecs/test/videocodec_test_benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <memory>
+
+#include "api/test/create_videocodec_test_fixture.h"
+#include "api/test/videocodec_test_stats.h"
+#include "api/video/video_codec_type.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/strings/json.h"
+#include "rtc_base/strings/string_builder.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+constexpr char kEncSpeedKey[] = "enc_speed_fps";
+constexpr char kDecSpeedKey[] = "dec_speed_fps";
+
+// Critical values of the t-distribution for a one sided test at the 1% level,
+// indexed by degrees of freedom. Larger degrees of freedom use the last value,
+// which is slightly conservative.
+constexpr double kTCritical[] = {
+    31.821, 6.965, 4.541, 3.747, 3.365, 3.143, 2.998, 2.896, 2.821, 2.764,
+    2.718,  2.681, 2.650, 2.624, 2.602, 2.583, 2.567, 2.552, 2.539, 2.528,
+    2.518,  2.508, 2.500, 2.492, 2.485, 2.479, 2.473, 2.467, 2.462, 2.457};
+
+double Mean(rtc::ArrayView<const double> values) {
+  double sum = 0;
+  for (double value : values)
+    sum += value;
+  return sum / values.size();
+}
+
+double SampleVariance(rtc::ArrayView<const double> values, double mean) {
+  double sum = 0;
+  for (double value : values)
+    sum += (value - mean) * (value - mean);
+  return sum / (values.size() - 1);
+}
+
+}  // namespace
+
+std::string CodecBenchmarkCase::Name() const {
+  rtc::StringBuilder name;
+  name << codec_name << "_" << width << "x" << height << "_complexity"
+       << static_cast<int>(complexity) << "_cores" << num_cores;
+  return name.Release();
+}
+
+std::vector<CodecBenchmarkCase> CreateCodecBenchmarkMatrix(
+    const std::vector<std::string>& codec_names,
+    const std::vector<std::pair<size_t, size_t>>& resolutions,
+    const std::vector<VideoCodecComplexity>& complexities,
+    const std::vector<size_t>& num_cores) {
+  std::vector<CodecBenchmarkCase> cases;
+  for (const std::string& codec_name : codec_names) {
+    for (const auto& resolution : resolutions) {
+      for (VideoCodecComplexity complexity : complexities) {
+        for (size_t cores : num_cores) {
+          CodecBenchmarkCase benchmark_case;
+          benchmark_case.codec_name = codec_name;
+          benchmark_case.width = resolution.first;
+          benchmark_case.height = resolution.second;
+          benchmark_case.complexity = complexity;
+          benchmark_case.num_cores = cores;
+          cases.push_back(benchmark_case);
+        }
+      }
+    }
+  }
+  return cases;
+}
+
+CodecBenchmarkSamples RunCodecBenchmarkCase(
+    VideoCodecTestFixture::Config config,
+    const CodecBenchmarkCase& benchmark_case,
+    size_t target_kbps,
+    int num_runs) {
+  RTC_CHECK(config.clip_width && config.clip_height)
+      << "The clip is scaled, so its dimensions have to be set.";
+  config.SetCodecSettings(benchmark_case.codec_name, 1, 1, 1,
+                          /*denoising_on=*/false, /*frame_dropper_on=*/false,
+                          /*spatial_resize_on=*/false, benchmark_case.width,
+                          benchmark_case.height);
+  if (config.codec_settings.codecType == kVideoCodecVP8) {
+    config.codec_settings.VP8()->complexity = benchmark_case.complexity;
+  } else if (config.codec_settings.codecType == kVideoCodecVP9) {
+    config.codec_settings.VP9()->complexity = benchmark_case.complexity;
+  }
+  config.num_cores = benchmark_case.num_cores;
+  config.test_name = benchmark_case.Name();
+  std::unique_ptr<VideoCodecTestFixture> fixture =
+      CreateVideoCodecTestFixture(config);
+
+  const std::vector<RateProfile> rate_profiles = {
+      {target_kbps, static_cast<double>(config.clip_fps.value_or(30)), 0}};
+  CodecBenchmarkSamples samples;
+  for (int i = 0; i < num_runs; ++i) {
+    fixture->RunTest(rate_profiles, nullptr, nullptr, nullptr);
+    std::vector<VideoCodecTestStats::VideoStatistics> stats =
+        fixture->GetStats().SliceAndCalcLayerVideoStatistic(
+            0, config.num_frames - 1);
+    RTC_CHECK_EQ(stats.size(), 1);
+    samples.enc_speed_fps.push_back(stats[0].enc_speed_fps);
+    if (config.decode)
+      samples.dec_speed_fps.push_back(stats[0].dec_speed_fps);
+  }
+  return samples;
+}
+
+std::string CodecBenchmarkResultsToJson(const CodecBenchmarkResults& results) {
+  Json::Value json(Json::objectValue);
+  for (const auto& result : results) {
+    Json::Value samples(Json::objectValue);
+    samples[kEncSpeedKey] =
+        rtc::DoubleVectorToJsonArray(result.second.enc_speed_fps);
+    samples[kDecSpeedKey] =
+        rtc::DoubleVectorToJsonArray(result.second.dec_speed_fps);
+    json[result.first] = samples;
+  }
+  Json::StreamWriterBuilder builder;
+  return Json::writeString(builder, json);
+}
+
+absl::optional<CodecBenchmarkResults> ParseCodecBenchmarkResults(
+    absl::string_view json) {
+  Json::CharReaderBuilder builder;
+  std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+  Json::Value root;
+  std::string error_message;
+  if (!reader->parse(json.data(), json.data() + json.size(), &root,
+                     &error_message) ||
+      !root.isObject()) {
+    return absl::nullopt;
+  }
+  CodecBenchmarkResults results;
+  for (const std::string& name : root.getMemberNames()) {
+    Json::Value enc_speed;
+    Json::Value dec_speed;
+    CodecBenchmarkSamples& samples = results[name];
+    if (!rtc::GetValueFromJsonObject(root[name], kEncSpeedKey, &enc_speed) ||
+        !rtc::GetValueFromJsonObject(root[name], kDecSpeedKey, &dec_speed) ||
+        !rtc::JsonArrayToDoubleVector(enc_speed, &samples.enc_speed_fps) ||
+        !rtc::JsonArrayToDoubleVector(dec_speed, &samples.dec_speed_fps)) {
+      return absl::nullopt;
+    }
+  }
+  return results;
+}
+
+bool IsSignificantSlowdown(rtc::ArrayView<const double> baseline,
+                           rtc::ArrayView<const double> samples,
+                           double min_relative_slowdown) {
+  if (baseline.size() < 2 || samples.size() < 2)
+    return false;
+  const double baseline_mean = Mean(baseline);
+  const double samples_mean = Mean(samples);
+  if (samples_mean >= baseline_mean * (1 - min_relative_slowdown))
+    return false;
+
+  const double baseline_error =
+      SampleVariance(baseline, baseline_mean) / baseline.size();
+  const double samples_error =
+      SampleVariance(samples, samples_mean) / samples.size();
+  const double standard_error = std::sqrt(baseline_error + samples_error);
+  if (standard_error == 0)
+    return true;
+  const double t = (baseline_mean - samples_mean) / standard_error;
+  // Welch-Satterthwaite approximation of the degrees of freedom.
+  const double degrees_of_freedom =
+      std::pow(baseline_error + samples_error, 2) /
+      (baseline_error * baseline_error / (baseline.size() - 1) +
+       samples_error * samples_error / (samples.size() - 1));
+  const size_t index = std::min<size_t>(
+      std::max(1.0, std::floor(degrees_of_freedom)), std::size(kTCritical));
+  return t > kTCritical[index - 1];
+}
+
+}  // namespace test
+}  // namespace webrtc
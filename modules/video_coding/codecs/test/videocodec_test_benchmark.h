@@ -0,0 +1,86 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_CODECS_TEST_VIDEOCODEC_TEST_BENCHMARK_H_
+#define MODULES_VIDEO_CODING_CODECS_TEST_VIDEOCODEC_TEST_BENCHMARK_H_
+
+#include <stddef.h>
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "api/test/videocodec_test_fixture.h"
+#include "api/video_codecs/video_codec.h"
+
+namespace webrtc {
+namespace test {
+
+// One cell of a codec benchmark matrix.
+struct CodecBenchmarkCase {
+  // Name of the case, used as key in the results.
+  std::string Name() const;
+
+  std::string codec_name;
+  size_t width = 0;
+  size_t height = 0;
+  // Only used by VP8 and VP9.
+  VideoCodecComplexity complexity = VideoCodecComplexity::kComplexityNormal;
+  size_t num_cores = 1;
+};
+
+// Encode and decode speed of the runs of a case.
+struct CodecBenchmarkSamples {
+  std::vector<double> enc_speed_fps;
+  std::vector<double> dec_speed_fps;
+};
+
+// Samples by case name.
+using CodecBenchmarkResults = std::map<std::string, CodecBenchmarkSamples>;
+
+// Returns the cases for all combinations of the given settings.
+std::vector<CodecBenchmarkCase> CreateCodecBenchmarkMatrix(
+    const std::vector<std::string>& codec_names,
+    const std::vector<std::pair<size_t, size_t>>& resolutions,
+    const std::vector<VideoCodecComplexity>& complexities,
+    const std::vector<size_t>& num_cores);
+
+// Encodes, and decodes if `config.decode` is set, the clip in `config`
+// `num_runs` times with the settings of `benchmark_case`, at a constant
+// `target_kbps`. The clip is scaled to the resolution of the case, so `config`
+// has to set `clip_width` and `clip_height`.
+CodecBenchmarkSamples RunCodecBenchmarkCase(
+    VideoCodecTestFixture::Config config,
+    const CodecBenchmarkCase& benchmark_case,
+    size_t target_kbps,
+    int num_runs);
+
+// Results are stored as a JSON object, which maps case names to objects with
+// "enc_speed_fps" and "dec_speed_fps" arrays. The output of one revision is
+// the baseline of the next.
+std::string CodecBenchmarkResultsToJson(const CodecBenchmarkResults& results);
+absl::optional<CodecBenchmarkResults> ParseCodecBenchmarkResults(
+    absl::string_view json);
+
+// Returns true if `samples` are on average slower than `baseline` by more than
+// `min_relative_slowdown`, and a one sided Welch's t-test finds the slowdown
+// significant at the 1% level.
+bool IsSignificantSlowdown(rtc::ArrayView<const double> baseline,
+                           rtc::ArrayView<const double> samples,
+                           double min_relative_slowdown);
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_CODECS_TEST_VIDEOCODEC_TEST_BENCHMARK_H_
@@ -0,0 +1,97 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/codecs/test/videocodec_test_benchmark.h"
+
+#include <vector>
+
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+using ::testing::ElementsAre;
+
+TEST(VideoCodecTestBenchmark, CreatesAllCombinations) {
+  std::vector<CodecBenchmarkCase> cases = CreateCodecBenchmarkMatrix(
+      {"VP8", "VP9"}, {{320, 180}, {1280, 720}},
+      {VideoCodecComplexity::kComplexityNormal,
+       VideoCodecComplexity::kComplexityHigh},
+      {1, 2, 4});
+  ASSERT_EQ(cases.size(), 24u);
+  EXPECT_EQ(cases[0].Name(), "VP8_320x180_complexity0_cores1");
+  EXPECT_EQ(cases[23].Name(), "VP9_1280x720_complexity1_cores4");
+}
+
+TEST(VideoCodecTestBenchmark, ResultsRoundTripThroughJson) {
+  CodecBenchmarkResults results;
+  results["VP8_320x180_complexity0_cores1"] = {{500.5, 510}, {1000, 990.25}};
+  results["AV1_640x360_complexity0_cores2"] = {{40, 41}, {}};
+
+  absl::optional<CodecBenchmarkResults> parsed =
+      ParseCodecBenchmarkResults(CodecBenchmarkResultsToJson(results));
+  ASSERT_TRUE(parsed);
+  ASSERT_EQ(parsed->size(), 2u);
+  const CodecBenchmarkSamples& vp8 =
+      parsed->at("VP8_320x180_complexity0_cores1");
+  EXPECT_THAT(vp8.enc_speed_fps, ElementsAre(500.5, 510));
+  EXPECT_THAT(vp8.dec_speed_fps, ElementsAre(1000, 990.25));
+  const CodecBenchmarkSamples& av1 =
+      parsed->at("AV1_640x360_complexity0_cores2");
+  EXPECT_THAT(av1.enc_speed_fps, ElementsAre(40, 41));
+  EXPECT_TRUE(av1.dec_speed_fps.empty());
+}
+
+TEST(VideoCodecTestBenchmark, RejectsMalformedResults) {
+  EXPECT_FALSE(ParseCodecBenchmarkResults(""));
+  EXPECT_FALSE(ParseCodecBenchmarkResults("[1, 2]"));
+  EXPECT_FALSE(
+      ParseCodecBenchmarkResults(R"({"VP8": {"enc_speed_fps": []}})"));
+  EXPECT_FALSE(ParseCodecBenchmarkResults(
+      R"({"VP8": {"enc_speed_fps": ["fast"], "dec_speed_fps": []}})"));
+}
+
+TEST(VideoCodecTestBenchmark, DetectsSignificantSlowdown) {
+  const std::vector<double> baseline = {100, 102, 98, 101, 99};
+  const std::vector<double> samples = {90, 91, 89, 90, 92};
+  EXPECT_TRUE(IsSignificantSlowdown(baseline, samples, 0.05));
+}
+
+TEST(VideoCodecTestBenchmark, IgnoresSlowdownBelowMinimum) {
+  const std::vector<double> baseline = {100, 100.1, 99.9, 100, 100};
+  const std::vector<double> samples = {97, 97.1, 96.9, 97, 97};
+  EXPECT_FALSE(IsSignificantSlowdown(baseline, samples, 0.05));
+  EXPECT_TRUE(IsSignificantSlowdown(baseline, samples, 0.01));
+}
+
+TEST(VideoCodecTestBenchmark, IgnoresSlowdownWithinNoise) {
+  const std::vector<double> baseline = {100, 130, 70, 120, 80};
+  const std::vector<double> samples = {90, 120, 60, 110, 70};
+  EXPECT_FALSE(IsSignificantSlowdown(baseline, samples, 0.05));
+}
+
+TEST(VideoCodecTestBenchmark, IgnoresSpeedup) {
+  const std::vector<double> baseline = {100, 102, 98, 101, 99};
+  const std::vector<double> samples = {120, 121, 119, 120, 122};
+  EXPECT_FALSE(IsSignificantSlowdown(baseline, samples, 0));
+}
+
+TEST(VideoCodecTestBenchmark, NeedsTwoSamplesToDetectSlowdown) {
+  const std::vector<double> one = {100};
+  const std::vector<double> two = {50, 51};
+  EXPECT_FALSE(IsSignificantSlowdown(one, two, 0.05));
+  EXPECT_FALSE(IsSignificantSlowdown(two, one, 0.05));
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace webrtc
@@ -0,0 +1,132 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/types/optional.h"
+#include "api/test/videocodec_test_fixture.h"
+#include "media/base/media_constants.h"
+#include "modules/video_coding/codecs/test/videocodec_test_benchmark.h"
+#include "rtc_base/system/file_wrapper.h"
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+
+ABSL_FLAG(std::string,
+          codec_speed_baseline,
+          "",
+          "JSON file with the results of a previous run. If set, the test "
+          "fails on significant slowdowns compared to it.");
+ABSL_FLAG(std::string,
+          codec_speed_output,
+          "",
+          "JSON file to write the results to. It can be used as baseline of "
+          "later runs.");
+ABSL_FLAG(int, codec_speed_runs, 5, "Number of runs of each case.");
+ABSL_FLAG(double,
+          codec_speed_max_slowdown,
+          0.05,
+          "Relative slowdown, compared to the baseline, below which the test "
+          "doesn't fail even if the slowdown is significant.");
+
+namespace webrtc {
+namespace test {
+namespace {
+
+constexpr int kWidth = 1280;
+constexpr int kHeight = 720;
+constexpr int kNumFrames = 150;
+constexpr double kBitsPerPixel = 0.07;
+
+VideoCodecTestFixture::Config CreateConfig() {
+  VideoCodecTestFixture::Config config;
+  config.filename = "FourPeople_1280x720_30";
+  config.filepath = ResourcePath(config.filename, "yuv");
+  config.clip_width = kWidth;
+  config.clip_height = kHeight;
+  config.num_frames = kNumFrames;
+  return config;
+}
+
+std::vector<std::string> CodecNames() {
+  std::vector<std::string> codec_names = {cricket::kVp8CodecName};
+#if defined(RTC_ENABLE_VP9)
+  codec_names.push_back(cricket::kVp9CodecName);
+#endif
+  codec_names.push_back(cricket::kAv1CodecName);
+#if defined(WEBRTC_USE_H264)
+  codec_names.push_back(cricket::kH264CodecName);
+#endif
+  return codec_names;
+}
+
+absl::optional<CodecBenchmarkResults> ReadBaseline(const std::string& path) {
+  std::ifstream file(path);
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  return ParseCodecBenchmarkResults(buffer.str());
+}
+
+}  // namespace
+
+// Measures the encode and decode speed of the codecs over a matrix of
+// resolutions, complexities and core counts. Run with
+// --gtest_also_run_disabled_tests --codec_speed_output=<file> on a revision to
+// get a baseline, and with --codec_speed_baseline=<file> on a later revision to
+// gate on speed regressions. Both runs have to be done on the same machine.
+TEST(VideoCodecTestSpeed, DISABLED_SpeedMatrix) {
+  absl::optional<CodecBenchmarkResults> baseline;
+  const std::string baseline_path = absl::GetFlag(FLAGS_codec_speed_baseline);
+  if (!baseline_path.empty()) {
+    baseline = ReadBaseline(baseline_path);
+    ASSERT_TRUE(baseline) << "Failed to read " << baseline_path;
+  }
+
+  const std::vector<CodecBenchmarkCase> cases = CreateCodecBenchmarkMatrix(
+      CodecNames(), {{320, 180}, {640, 360}, {kWidth, kHeight}},
+      {VideoCodecComplexity::kComplexityNormal,
+       VideoCodecComplexity::kComplexityHigh},
+      {1, 2, 4});
+  const double max_slowdown = absl::GetFlag(FLAGS_codec_speed_max_slowdown);
+  CodecBenchmarkResults results;
+  for (const CodecBenchmarkCase& benchmark_case : cases) {
+    const size_t target_kbps = benchmark_case.width * benchmark_case.height *
+                               30 * kBitsPerPixel / 1000;
+    const CodecBenchmarkSamples& samples =
+        results[benchmark_case.Name()] =
+            RunCodecBenchmarkCase(CreateConfig(), benchmark_case, target_kbps,
+                                  absl::GetFlag(FLAGS_codec_speed_runs));
+    if (!baseline)
+      continue;
+    auto it = baseline->find(benchmark_case.Name());
+    if (it == baseline->end())
+      continue;
+    EXPECT_FALSE(IsSignificantSlowdown(it->second.enc_speed_fps,
+                                       samples.enc_speed_fps, max_slowdown))
+        << benchmark_case.Name() << " encodes slower than the baseline.";
+    EXPECT_FALSE(IsSignificantSlowdown(it->second.dec_speed_fps,
+                                       samples.dec_speed_fps, max_slowdown))
+        << benchmark_case.Name() << " decodes slower than the baseline.";
+  }
+
+  const std::string output_path = absl::GetFlag(FLAGS_codec_speed_output);
+  if (!output_path.empty()) {
+    const std::string json = CodecBenchmarkResultsToJson(results);
+    FileWrapper output = FileWrapper::OpenWriteOnly(output_path);
+    ASSERT_TRUE(output.is_open()) << "Failed to open " << output_path;
+    EXPECT_TRUE(output.Write(json.data(), json.size()));
+  }
+}
+
+}  // namespace test
+}  // namespace webrtc
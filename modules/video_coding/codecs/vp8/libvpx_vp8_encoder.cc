@@ -280,7 +280,9 @@ LibvpxVp8Encoder::LibvpxVp8Encoder(std::unique_ptr<LibvpxInterface> interface,
       key_frame_request_(kMaxSimulcastStreams, false),
       variable_framerate_experiment_(ParseVariableFramerateConfig(
           "WebRTC-VP8VariableFramerateScreenshare")),
-      framerate_controller_(variable_framerate_experiment_.framerate_limit) {
+      framerate_controller_(variable_framerate_experiment_.framerate_limit),
+      active_map_(
+          field_trial::FindFullName(ActiveMapTracker::kFieldTrialName)) {
   // TODO(eladalon/ilnik): These reservations might be wasting memory.
   // InitEncode() is resizing to the actual size, which might be smaller.
   raw_images_.reserve(kMaxSimulcastStreams);
@@ -693,6 +695,9 @@ int LibvpxVp8Encoder::InitEncode(const VideoCodec* inst,
     UpdateVpxConfiguration(stream_idx);
   }
 
+  active_map_.Reset(codec_.width, codec_.height);
+  active_map_set_ = false;
+
   return InitAndSetControlSettings();
 }
 
@@ -955,6 +960,13 @@ int LibvpxVp8Encoder::Encode(const VideoFrame& frame,
     }
   }
 
+  const bool use_active_map = active_map_.enabled() &&
+                              codec_.mode == VideoCodecMode::kScreensharing &&
+                              encoders_.size() == 1;
+  if (use_active_map) {
+    active_map_.OnInputFrame(frame.update_rect());
+  }
+
   if (frame.update_rect().IsEmpty() && num_steady_state_frames_ >= 3 &&
       !key_frame_requested) {
     if (variable_framerate_experiment_.enabled &&
@@ -1050,6 +1062,23 @@ int LibvpxVp8Encoder::Encode(const VideoFrame& frame,
   RTC_DCHECK_GT(codec_.maxFramerate, 0);
   uint32_t duration = kRtpTicksPerSecond / codec_.maxFramerate;
 
+  if (use_active_map) {
+    // Inactive macroblocks are copied from the last frame, so they can only
+    // be skipped if the frame references it.
+    const bool skip_static_blocks =
+        !send_key_frame &&
+        tl_configs[0].References(Vp8FrameConfig::Buffer::kLast) &&
+        active_map_.BuildMap(static_cast<int>(Vp8FrameConfig::Buffer::kLast));
+    if (skip_static_blocks || active_map_set_) {
+      vpx_active_map_t active_map;
+      active_map.active_map = skip_static_blocks ? active_map_.map() : nullptr;
+      active_map.rows = active_map_.rows();
+      active_map.cols = active_map_.cols();
+      libvpx_->codec_control(&encoders_[0], VP8E_SET_ACTIVEMAP, &active_map);
+      active_map_set_ = skip_static_blocks;
+    }
+  }
+
   int error = WEBRTC_VIDEO_CODEC_OK;
   int num_tries = 0;
   // If the first try returns WEBRTC_VIDEO_CODEC_TARGET_BITRATE_OVERSHOOT
@@ -1074,6 +1103,17 @@ int LibvpxVp8Encoder::Encode(const VideoFrame& frame,
     // Examines frame timestamps only.
     error = GetEncodedPartitions(frame, retransmission_allowed);
   }
+  if (use_active_map && encoded_images_[0].size() > 0) {
+    const bool is_key_frame =
+        encoded_images_[0]._frameType == VideoFrameType::kVideoFrameKey;
+    for (int i = 0; i < static_cast<int>(Vp8FrameConfig::Buffer::kCount);
+         ++i) {
+      if (is_key_frame ||
+          tl_configs[0].Updates(static_cast<Vp8FrameConfig::Buffer>(i))) {
+        active_map_.OnBufferUpdated(i);
+      }
+    }
+  }
   // TODO(sprang): Shouldn't we use the frame timestamp instead?
   timestamp_ += duration;
   return error;
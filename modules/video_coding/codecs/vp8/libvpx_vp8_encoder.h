@@ -24,6 +24,7 @@
 #include "modules/video_coding/codecs/interface/libvpx_interface.h"
 #include "modules/video_coding/codecs/vp8/include/vp8.h"
 #include "modules/video_coding/include/video_codec_interface.h"
+#include "modules/video_coding/utility/active_map_tracker.h"
 #include "modules/video_coding/utility/framerate_controller_deprecated.h"
 #include "rtc_base/experiments/cpu_speed_experiment.h"
 #include "rtc_base/experiments/encoder_info_settings.h"
@@ -148,6 +149,11 @@ class LibvpxVp8Encoder : public VideoEncoder {
   FramerateControllerDeprecated framerate_controller_;
   int num_steady_state_frames_ = 0;
 
+  // Skips the blocks of screenshare frames that are unchanged since the last
+  // frame was encoded, for streams of a single resolution.
+  ActiveMapTracker active_map_;
+  bool active_map_set_ = false;
+
   FecControllerOverride* fec_controller_override_ = nullptr;
 
   const LibvpxVp8EncoderInfoSettings encoder_info_override_;
@@ -14,6 +14,7 @@
 #include "modules/video_coding/codecs/vp9/libvpx_vp9_decoder.h"
 
 #include <algorithm>
+#include <limits>
 
 #include "absl/strings/match.h"
 #include "api/transport/field_trial_based_config.h"
@@ -97,7 +98,10 @@ ColorSpace ExtractVP9ColorSpace(vpx_color_space_t space_t,
 LibvpxVp9Decoder::LibvpxVp9Decoder()
     : LibvpxVp9Decoder(FieldTrialBasedConfig()) {}
 LibvpxVp9Decoder::LibvpxVp9Decoder(const WebRtcKeyValueConfig& trials)
-    : decode_complete_callback_(nullptr),
+    : output_buffer_pool_(/*zero_initialize=*/false,
+                          std::numeric_limits<size_t>::max(),
+                          SharedVideoFrameBufferPool::GetInstance()),
+      decode_complete_callback_(nullptr),
       inited_(false),
       decoder_(nullptr),
       key_frame_required_(true),
@@ -236,6 +236,14 @@ LibvpxVp9Encoder::LibvpxVp9Encoder(const cricket::VideoCodec& codec,
           !absl::StartsWith(trials.Lookup("WebRTC-Vp9ExternalRefCtrl"),
                             "Disabled")),
       performance_flags_(ParsePerformanceFlagsFromTrials(trials)),
+      adaptive_threading_experiment_(ParseAdaptiveThreadingConfig(trials)),
+      threading_level_(0),
+      max_tile_columns_log2_(0),
+      encode_time_sum_us_(0),
+      encode_time_frames_(0),
+      active_map_(trials.Lookup(ActiveMapTracker::kFieldTrialName)),
+      use_active_map_(false),
+      active_map_set_(false),
       num_steady_state_frames_(0),
       config_changed_(true) {
   codec_ = {};
@@ -555,6 +563,11 @@ int LibvpxVp9Encoder::InitEncode(const VideoCodec* inst,
 
   is_svc_ = (num_spatial_layers_ > 1 || num_temporal_layers_ > 1);
 
+  use_active_map_ = active_map_.enabled() &&
+                    codec_.mode == VideoCodecMode::kScreensharing && !is_svc_;
+  active_map_.Reset(codec_.width, codec_.height);
+  active_map_set_ = false;
+
   // Populate encoder configuration with default values.
   if (libvpx_->codec_enc_config_default(vpx_codec_vp9_cx(), config_, 0)) {
     return WEBRTC_VIDEO_CODEC_ERROR;
@@ -630,6 +643,22 @@ int LibvpxVp9Encoder::InitEncode(const VideoCodec* inst,
   // Determine number of threads based on the image size and #cores.
   config_->g_threads =
       NumberOfThreads(config_->g_w, config_->g_h, settings.number_of_cores);
+  if (adaptive_threading_experiment_.enabled) {
+    // Start with the tile columns of the fixed heuristic, but create the
+    // threads needed to go beyond it.
+    threading_level_ = static_cast<int>(config_->g_threads >> 1);
+    config_->g_threads = std::max(
+        config_->g_threads,
+        static_cast<unsigned int>(std::min(
+            settings.number_of_cores,
+            adaptive_threading_experiment_.max_threads)));
+    max_tile_columns_log2_ = 0;
+    while ((2u << max_tile_columns_log2_) <= config_->g_threads) {
+      ++max_tile_columns_log2_;
+    }
+    encode_time_sum_us_ = 0;
+    encode_time_frames_ = 0;
+  }
 
   is_flexible_mode_ = inst->VP9().flexibleMode;
 
@@ -882,11 +911,15 @@ int LibvpxVp9Encoder::InitAndSetControlSettings(const VideoCodec* inst) {
   // log2 unit: e.g., 0 = 1 tile column, 1 = 2 tile columns, 2 = 4 tile columns.
   // The number tile columns will be capped by the encoder based on image size
   // (minimum width of tile column is 256 pixels, maximum is 4096).
-  libvpx_->codec_control(encoder_, VP9E_SET_TILE_COLUMNS,
-                         static_cast<int>((config_->g_threads >> 1)));
+  if (adaptive_threading_experiment_.enabled) {
+    SetThreadingControls();
+  } else {
+    libvpx_->codec_control(encoder_, VP9E_SET_TILE_COLUMNS,
+                           static_cast<int>((config_->g_threads >> 1)));
 
-  // Turn on row-based multithreading.
-  libvpx_->codec_control(encoder_, VP9E_SET_ROW_MT, 1);
+    // Turn on row-based multithreading.
+    libvpx_->codec_control(encoder_, VP9E_SET_ROW_MT, 1);
+  }
 
 #if !defined(WEBRTC_ARCH_ARM) && !defined(WEBRTC_ARCH_ARM64) && \
     !defined(ANDROID)
@@ -935,6 +968,10 @@ int LibvpxVp9Encoder::Encode(const VideoFrame& input_image,
     return WEBRTC_VIDEO_CODEC_OK;
   }
 
+  if (use_active_map_) {
+    active_map_.OnInputFrame(input_image.update_rect());
+  }
+
   // We only support one stream at the moment.
   if (frame_types && !frame_types->empty()) {
     if ((*frame_types)[0] == VideoFrameType::kVideoFrameKey) {
@@ -1173,6 +1210,21 @@ int LibvpxVp9Encoder::Encode(const VideoFrame& input_image,
                            &ref_config);
   }
 
+  if (use_active_map_) {
+    // Without layers, every encoded frame is stored in the buffer that the
+    // next frame references as LAST, which inactive blocks are copied from.
+    const bool skip_static_blocks =
+        !force_key_frame_ && active_map_.BuildMap(/*reference_buffer=*/0);
+    if (skip_static_blocks || active_map_set_) {
+      vpx_active_map_t active_map;
+      active_map.active_map = skip_static_blocks ? active_map_.map() : nullptr;
+      active_map.rows = active_map_.rows();
+      active_map.cols = active_map_.cols();
+      libvpx_->codec_control(encoder_, VP8E_SET_ACTIVEMAP, &active_map);
+      active_map_set_ = skip_static_blocks;
+    }
+  }
+
   first_frame_in_picture_ = true;
 
   // TODO(ssilkin): Frame duration should be specified per spatial layer
@@ -1190,6 +1242,7 @@ int LibvpxVp9Encoder::Encode(const VideoFrame& input_image,
                          .GetTargetRate())
           : codec_.maxFramerate;
   uint32_t duration = static_cast<uint32_t>(90000 / target_framerate_fps);
+  const int64_t encode_start_us = rtc::TimeMicros();
   const vpx_codec_err_t rv = libvpx_->codec_encode(
       encoder_, raw_, timestamp_, duration, flags, VPX_DL_REALTIME);
   if (rv != VPX_CODEC_OK) {
@@ -1201,6 +1254,10 @@ int LibvpxVp9Encoder::Encode(const VideoFrame& input_image,
     return WEBRTC_VIDEO_CODEC_ERROR;
   }
   timestamp_ += duration;
+  if (adaptive_threading_experiment_.enabled) {
+    MaybeAdaptThreading(rtc::TimeMicros() - encode_start_us,
+                        target_framerate_fps);
+  }
 
   if (layer_buffering_) {
     const bool end_of_picture = true;
@@ -1620,6 +1677,10 @@ void LibvpxVp9Encoder::GetEncodedLayerFrame(const vpx_codec_cx_pkt* pkt) {
     return;
   }
 
+  if (use_active_map_) {
+    active_map_.OnBufferUpdated(/*buffer=*/0);
+  }
+
   vpx_svc_layer_id_t layer_id = {0};
   libvpx_->codec_control(encoder_, VP9E_GET_SVC_LAYER_ID, &layer_id);
 
@@ -1813,6 +1874,71 @@ LibvpxVp9Encoder::ParseVariableFramerateConfig(
   return config;
 }
 
+// static
+LibvpxVp9Encoder::AdaptiveThreadingExperiment
+LibvpxVp9Encoder::ParseAdaptiveThreadingConfig(
+    const WebRtcKeyValueConfig& trials) {
+  FieldTrialFlag enabled = FieldTrialFlag("Enabled");
+  FieldTrialParameter<int> max_threads("max_threads", 8);
+  FieldTrialParameter<double> overuse_fraction("overuse", 0.85);
+  FieldTrialParameter<double> underuse_fraction("underuse", 0.4);
+  FieldTrialParameter<int> window_frames("window", 30);
+  ParseFieldTrial({&enabled, &max_threads, &overuse_fraction,
+                   &underuse_fraction, &window_frames},
+                  trials.Lookup("WebRTC-VP9-AdaptiveThreading"));
+  AdaptiveThreadingExperiment config;
+  config.enabled = enabled.Get();
+  config.max_threads = std::max(1, max_threads.Get());
+  config.overuse_fraction = overuse_fraction.Get();
+  config.underuse_fraction =
+      std::min(underuse_fraction.Get(), overuse_fraction.Get());
+  config.window_frames = std::max(1, window_frames.Get());
+  return config;
+}
+
+void LibvpxVp9Encoder::MaybeAdaptThreading(int64_t encode_time_us,
+                                           float framerate_fps) {
+  encode_time_sum_us_ += encode_time_us;
+  if (++encode_time_frames_ < adaptive_threading_experiment_.window_frames) {
+    return;
+  }
+  const double average_encode_time_us =
+      static_cast<double>(encode_time_sum_us_) / encode_time_frames_;
+  const double frame_interval_us = rtc::kNumMicrosecsPerSec / framerate_fps;
+  encode_time_sum_us_ = 0;
+  encode_time_frames_ = 0;
+
+  int threading_level = threading_level_;
+  if (average_encode_time_us >
+          adaptive_threading_experiment_.overuse_fraction * frame_interval_us &&
+      threading_level < max_tile_columns_log2_ + 1) {
+    ++threading_level;
+  } else if (average_encode_time_us <
+                 adaptive_threading_experiment_.underuse_fraction *
+                     frame_interval_us &&
+             threading_level > 0) {
+    --threading_level;
+  }
+  if (threading_level == threading_level_) {
+    return;
+  }
+  RTC_LOG(LS_INFO) << "Average encode time " << average_encode_time_us
+                   << " us of " << frame_interval_us
+                   << " us frame interval, threading level "
+                   << threading_level_ << " -> " << threading_level;
+  threading_level_ = threading_level;
+  SetThreadingControls();
+}
+
+void LibvpxVp9Encoder::SetThreadingControls() {
+  // Both are capped by libvpx, the tile columns e.g. by the image width
+  // (minimum width of tile column is 256 pixels).
+  libvpx_->codec_control(encoder_, VP9E_SET_TILE_COLUMNS,
+                         std::min(threading_level_, max_tile_columns_log2_));
+  libvpx_->codec_control(encoder_, VP9E_SET_ROW_MT,
+                         threading_level_ > max_tile_columns_log2_ ? 1 : 0);
+}
+
 // static
 LibvpxVp9Encoder::QualityScalerExperiment
 LibvpxVp9Encoder::ParseQualityScalerConfig(const WebRtcKeyValueConfig& trials) {
@@ -27,6 +27,7 @@
 #include "modules/video_coding/codecs/vp9/include/vp9.h"
 #include "modules/video_coding/codecs/vp9/vp9_frame_buffer_pool.h"
 #include "modules/video_coding/svc/scalable_video_controller.h"
+#include "modules/video_coding/utility/active_map_tracker.h"
 #include "modules/video_coding/utility/framerate_controller_deprecated.h"
 #include "rtc_base/experiments/encoder_info_settings.h"
 #include "vpx/vp8cx.h"
@@ -239,6 +240,40 @@ class LibvpxVp9Encoder : public VP9Encoder {
       const WebRtcKeyValueConfig& trials);
   static PerformanceFlags GetDefaultPerformanceFlags();
 
+  // Adapts the encoder parallelism to the measured encode time, instead of
+  // only setting it from the resolution and number of cores at init. The
+  // encoder threads are created at init, and the parallelism is changed
+  // through the tile columns and row based multithreading, which libvpx
+  // supports changing between frames.
+  const struct AdaptiveThreadingExperiment {
+    bool enabled;
+    // Max number of encoder threads, further limited by the number of cores.
+    int max_threads;
+    // Parallelism is increased when the average encode time is above
+    // `overuse_fraction` of the frame interval, and decreased when it is below
+    // `underuse_fraction`.
+    double overuse_fraction;
+    double underuse_fraction;
+    // Number of frames the encode time is averaged over before adapting.
+    int window_frames;
+  } adaptive_threading_experiment_;
+  static AdaptiveThreadingExperiment ParseAdaptiveThreadingConfig(
+      const WebRtcKeyValueConfig& trials);
+  void MaybeAdaptThreading(int64_t encode_time_us, float framerate_fps);
+  void SetThreadingControls();
+  // Levels up to `max_tile_columns_log2_` use that log2 number of tile
+  // columns, and the level above them also enables row based multithreading.
+  int threading_level_;
+  int max_tile_columns_log2_;
+  int64_t encode_time_sum_us_;
+  int encode_time_frames_;
+
+  // Skips the blocks of screenshare frames that are unchanged since the last
+  // frame was encoded, for streams without spatial or temporal layers.
+  ActiveMapTracker active_map_;
+  bool use_active_map_;
+  bool active_map_set_;
+
   int num_steady_state_frames_;
   // Only set config when this flag is set.
   bool config_changed_;
@@ -26,6 +26,7 @@
 #include "modules/video_coding/codecs/vp9/libvpx_vp9_encoder.h"
 #include "modules/video_coding/codecs/vp9/svc_config.h"
 #include "rtc_base/strings/string_builder.h"
+#include "system_wrappers/include/sleep.h"
 #include "test/explicit_key_value_config.h"
 #include "test/field_trial.h"
 #include "test/gmock.h"
@@ -2442,4 +2443,70 @@ TEST(Vp9SpeedSettingsTrialsTest, DefaultPerLayerFlagsWithSvc) {
   }
 }
 
+TEST(Vp9AdaptiveThreadingTrialTest, AddsTileColumnsWhenEncodeTimeIsTooLong) {
+  test::ExplicitKeyValueConfig trials(
+      "WebRTC-VP9-AdaptiveThreading/Enabled,window:2/");
+
+  // Keep a raw pointer for EXPECT calls and the like. Ownership is otherwise
+  // passed on to LibvpxVp9Encoder.
+  auto* const vpx = new NiceMock<MockLibvpxInterface>();
+  LibvpxVp9Encoder encoder(cricket::VideoCodec(),
+                           absl::WrapUnique<LibvpxInterface>(vpx), trials);
+
+  VideoCodec settings = DefaultCodecSettings();
+  settings.width = 1280;
+  settings.height = 720;
+  vpx_image_t img;
+
+  ON_CALL(*vpx, img_wrap).WillByDefault(GetWrapImageFunction(&img));
+  ON_CALL(*vpx, codec_enc_config_default)
+      .WillByDefault(DoAll(WithArg<1>([](vpx_codec_enc_cfg_t* cfg) {
+                             memset(cfg, 0, sizeof(vpx_codec_enc_cfg_t));
+                           }),
+                           Return(VPX_CODEC_OK)));
+  EXPECT_CALL(*vpx, codec_control(_, _, An<int>())).Times(AnyNumber());
+
+  // With 4 cores, 720p starts at 2 tile columns, like without the trial, but
+  // without row based multithreading.
+  unsigned int threads = 0;
+  EXPECT_CALL(*vpx, codec_enc_init)
+      .WillOnce(WithArg<2>([&](const vpx_codec_enc_cfg_t* cfg) {
+        threads = cfg->g_threads;
+        return VPX_CODEC_OK;
+      }));
+  EXPECT_CALL(*vpx, codec_control(_, VP9E_SET_TILE_COLUMNS, TypedEq<int>(1)));
+  EXPECT_CALL(*vpx, codec_control(_, VP9E_SET_ROW_MT, TypedEq<int>(0)));
+  const VideoEncoder::Settings kFourCoreSettings(kCapabilities,
+                                                 /*number_of_cores=*/4,
+                                                 /*max_payload_size=*/0);
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder.InitEncode(&settings, kFourCoreSettings));
+  EXPECT_EQ(threads, 4u);
+  Mock::VerifyAndClearExpectations(vpx);
+
+  // Frames take twice the frame interval at 100 fps.
+  VideoBitrateAllocation bitrate_allocation;
+  bitrate_allocation.SetBitrate(0, 0, 1'000'000);
+  encoder.SetRates(VideoEncoder::RateControlParameters(bitrate_allocation,
+                                                       /*framerate_fps=*/100));
+  ON_CALL(*vpx, codec_encode).WillByDefault([](auto&&...) {
+    SleepMs(20);
+    return VPX_CODEC_OK;
+  });
+  EXPECT_CALL(*vpx, codec_control(_, _, An<int>())).Times(AnyNumber());
+  EXPECT_CALL(*vpx, codec_control(_, VP9E_SET_TILE_COLUMNS, TypedEq<int>(2)));
+  EXPECT_CALL(*vpx, codec_control(_, VP9E_SET_ROW_MT, TypedEq<int>(0)));
+
+  auto frame_generator = test::CreateSquareFrameGenerator(
+      settings.width, settings.height,
+      test::FrameGeneratorInterface::OutputType::kI420, 10);
+  for (int i = 0; i < 2; ++i) {
+    VideoFrame frame =
+        VideoFrame::Builder()
+            .set_video_frame_buffer(frame_generator->NextFrame().buffer)
+            .build();
+    encoder.Encode(frame, nullptr);
+  }
+}
+
 }  // namespace webrtc
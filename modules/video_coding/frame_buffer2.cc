@@ -18,6 +18,7 @@
 #include <utility>
 #include <vector>
 
+#include "api/units/timestamp.h"
 #include "api/video/encoded_image.h"
 #include "api/video/video_timing.h"
 #include "modules/video_coding/include/video_coding_defines.h"
@@ -287,6 +288,8 @@ std::unique_ptr<EncodedFrame> FrameBuffer::GetNextFrame() {
   }
 
   if (!superframe_delayed_by_retransmission) {
+    TRACE_EVENT0("webrtc", "FrameBuffer::UpdateJitterEstimate");
+    Timestamp start = clock_->CurrentTime();
     int64_t frame_delay;
 
     if (inter_frame_delay_.CalculateDelay(first_frame.Timestamp(), &frame_delay,
@@ -300,9 +303,14 @@ std::unique_ptr<EncodedFrame> FrameBuffer::GetNextFrame() {
       rtt_mult = rtt_mult_settings_->rtt_mult_setting;
       rtt_mult_add_cap_ms = rtt_mult_settings_->rtt_mult_add_cap_ms;
     }
-    timing_->SetJitterDelay(
-        jitter_estimator_.GetJitterEstimate(rtt_mult, rtt_mult_add_cap_ms));
+    int jitter_delay_ms =
+        jitter_estimator_.GetJitterEstimate(rtt_mult, rtt_mult_add_cap_ms);
+    Timestamp timing_start = clock_->CurrentTime();
+    total_jitter_estimation_time_ += timing_start - start;
+
+    timing_->SetJitterDelay(jitter_delay_ms);
     timing_->UpdateCurrentDelay(render_time_ms, now_ms);
+    total_timing_update_time_ += clock_->CurrentTime() - timing_start;
   } else {
     if (RttMultExperiment::RttMultEnabled())
       jitter_estimator_.FrameNacked();
@@ -373,6 +381,16 @@ int FrameBuffer::Size() {
   return frames_.size();
 }
 
+TimeDelta FrameBuffer::GetTotalJitterEstimationTime() {
+  MutexLock lock(&mutex_);
+  return total_jitter_estimation_time_;
+}
+
+TimeDelta FrameBuffer::GetTotalTimingUpdateTime() {
+  MutexLock lock(&mutex_);
+  return total_timing_update_time_;
+}
+
 void FrameBuffer::UpdateRtt(int64_t rtt_ms) {
   MutexLock lock(&mutex_);
   jitter_estimator_.UpdateRtt(rtt_ms);
@@ -19,6 +19,7 @@
 
 #include "absl/container/inlined_vector.h"
 #include "api/sequence_checker.h"
+#include "api/units/time_delta.h"
 #include "api/video/encoded_frame.h"
 #include "modules/video_coding/include/video_coding_defines.h"
 #include "modules/video_coding/inter_frame_delay.h"
@@ -85,6 +86,11 @@ class FrameBuffer {
 
   int Size();
 
+  // Returns the wall time spent updating the jitter estimate, and updating
+  // the timing with it, for the frames returned by `NextFrame`.
+  TimeDelta GetTotalJitterEstimationTime();
+  TimeDelta GetTotalTimingUpdateTime();
+
  private:
   struct FrameInfo {
     FrameInfo();
@@ -175,6 +181,10 @@ class FrameBuffer {
 
   VCMJitterEstimator jitter_estimator_ RTC_GUARDED_BY(mutex_);
   VCMTiming* const timing_ RTC_GUARDED_BY(mutex_);
+  TimeDelta total_jitter_estimation_time_ RTC_GUARDED_BY(mutex_) =
+      TimeDelta::Zero();
+  TimeDelta total_timing_update_time_ RTC_GUARDED_BY(mutex_) =
+      TimeDelta::Zero();
   VCMInterFrameDelay inter_frame_delay_ RTC_GUARDED_BY(mutex_);
   absl::optional<int64_t> last_continuous_frame_ RTC_GUARDED_BY(mutex_);
   std::vector<FrameMap::iterator> frames_to_decode_ RTC_GUARDED_BY(mutex_);
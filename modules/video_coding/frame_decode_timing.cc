@@ -0,0 +1,77 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/frame_decode_timing.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+
+constexpr TimeDelta FrameDecodeTiming::kMaxAllowedFrameDelay;
+
+FrameDecodeTiming::FrameDecodeTiming(Clock* clock, const VCMTiming* timing)
+    : clock_(clock), timing_(timing) {
+  RTC_DCHECK(clock_);
+  RTC_DCHECK(timing_);
+}
+
+absl::optional<FrameDecodeTiming::FrameSchedule>
+FrameDecodeTiming::OnFrameBufferUpdated(uint32_t next_temporal_unit_rtp,
+                                        uint32_t last_temporal_unit_rtp,
+                                        bool too_many_frames_queued) {
+  const Timestamp now = clock_->CurrentTime();
+  const int64_t render_time_ms =
+      timing_->RenderTimeMs(next_temporal_unit_rtp, now.ms());
+  const TimeDelta max_wait = TimeDelta::Millis(timing_->MaxWaitingTime(
+      render_time_ms, now.ms(), too_many_frames_queued));
+
+  // If the frame is late and there is a later decodable frame, drop it.
+  if (max_wait <= TimeDelta::Zero() - kMaxAllowedFrameDelay &&
+      next_temporal_unit_rtp != last_temporal_unit_rtp) {
+    RTC_DLOG(LS_VERBOSE) << "Dropping frame with RTP timestamp "
+                         << next_temporal_unit_rtp << ", which is "
+                         << (TimeDelta::Zero() - max_wait).ms() << " ms late.";
+    return absl::nullopt;
+  }
+
+  return FrameSchedule{
+      /*latest_decode_time=*/now + std::max(max_wait, TimeDelta::Zero()),
+      /*render_time=*/Timestamp::Millis(render_time_ms)};
+}
+
+absl::optional<FrameDecodeTiming::FrameSchedule>
+FrameDecodeTiming::ScheduleNextTemporalUnit(FrameBuffer& frame_buffer,
+                                            bool too_many_frames_queued) {
+  while (true) {
+    absl::optional<uint32_t> next_rtp =
+        frame_buffer.NextDecodableTemporalUnitRtpTimestamp();
+    if (!next_rtp) {
+      return absl::nullopt;
+    }
+    absl::optional<uint32_t> last_rtp =
+        frame_buffer.LastDecodableTemporalUnitRtpTimestamp();
+    RTC_DCHECK(last_rtp);
+    absl::optional<FrameSchedule> schedule =
+        OnFrameBufferUpdated(*next_rtp, *last_rtp, too_many_frames_queued);
+    if (schedule) {
+      return schedule;
+    }
+    frame_buffer.DropNextDecodableTemporalUnit();
+  }
+}
+
+TimeDelta FrameDecodeTiming::TargetDelay() const {
+  return TimeDelta::Millis(timing_->TargetVideoDelay());
+}
+
+}  // namespace webrtc
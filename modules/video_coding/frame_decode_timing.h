@@ -0,0 +1,81 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_FRAME_DECODE_TIMING_H_
+#define MODULES_VIDEO_CODING_FRAME_DECODE_TIMING_H_
+
+#include <stdint.h>
+
+#include "absl/types/optional.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/video_coding/frame_buffer3.h"
+#include "modules/video_coding/timing.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+// Schedules the decoding of the temporal units of a FrameBuffer. A temporal
+// unit is decoded at the latest time that still lets it be rendered on time,
+// which is its render time minus the render delay and the 95th percentile
+// decode time measured by VCMTiming. Temporal units that can't make their
+// render time any more are dropped before they are decoded, if a later
+// temporal unit is decodable.
+class FrameDecodeTiming {
+ public:
+  // Frames that are late by more than this when their decoding is scheduled
+  // are dropped.
+  static constexpr TimeDelta kMaxAllowedFrameDelay = TimeDelta::Millis(5);
+
+  struct FrameSchedule {
+    // The latest time at which decoding can start for the frame to be
+    // rendered on time.
+    Timestamp latest_decode_time;
+    // The time at which the frame should be rendered, that is, the end of the
+    // capture to render delay of the frame. Zero if the frame should be
+    // rendered as soon as possible.
+    Timestamp render_time;
+  };
+
+  FrameDecodeTiming(Clock* clock, const VCMTiming* timing);
+  FrameDecodeTiming(const FrameDecodeTiming&) = delete;
+  FrameDecodeTiming& operator=(const FrameDecodeTiming&) = delete;
+  ~FrameDecodeTiming() = default;
+
+  // Returns the schedule of the temporal unit with RTP timestamp
+  // `next_temporal_unit_rtp`, or nullopt if it is too late and should be
+  // dropped. It is never dropped if it is also the last decodable temporal
+  // unit, with RTP timestamp `last_temporal_unit_rtp`.
+  absl::optional<FrameSchedule> OnFrameBufferUpdated(
+      uint32_t next_temporal_unit_rtp,
+      uint32_t last_temporal_unit_rtp,
+      bool too_many_frames_queued);
+
+  // Drops the temporal units of `frame_buffer` that are too late, and returns
+  // the schedule of the next one. Returns nullopt if no temporal unit is
+  // decodable.
+  absl::optional<FrameSchedule> ScheduleNextTemporalUnit(
+      FrameBuffer& frame_buffer,
+      bool too_many_frames_queued);
+
+  // Returns the target delay from receiving a frame to rendering it: the
+  // jitter buffer delay, the decode time and the render delay, but at least
+  // the minimum playout delay. Together with the network delay, this is the
+  // receiver's part of the glass to glass delay.
+  TimeDelta TargetDelay() const;
+
+ private:
+  Clock* const clock_;
+  const VCMTiming* const timing_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_FRAME_DECODE_TIMING_H_
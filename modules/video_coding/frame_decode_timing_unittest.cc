@@ -0,0 +1,136 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/frame_decode_timing.h"
+
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+
+#include "api/video/encoded_frame.h"
+#include "modules/video_coding/frame_buffer3.h"
+#include "modules/video_coding/timing.h"
+#include "system_wrappers/include/clock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+class FakeVCMTiming : public VCMTiming {
+ public:
+  explicit FakeVCMTiming(Clock* clock) : VCMTiming(clock) {}
+
+  int64_t RenderTimeMs(uint32_t frame_timestamp,
+                       int64_t now_ms) const override {
+    auto it = render_times_.find(frame_timestamp);
+    return it != render_times_.end() ? it->second : 0;
+  }
+
+  int64_t MaxWaitingTime(int64_t render_time_ms,
+                         int64_t now_ms,
+                         bool too_many_frames_queued) const override {
+    return render_time_ms - now_ms - kDecodeAndRenderTimeMs;
+  }
+
+  void SetRenderTime(uint32_t rtp, Timestamp render_time) {
+    render_times_[rtp] = render_time.ms();
+  }
+
+  static constexpr int64_t kDecodeAndRenderTimeMs = 15;
+
+ private:
+  std::map<uint32_t, int64_t> render_times_;
+};
+
+class FakeEncodedFrame : public EncodedFrame {
+ public:
+  int64_t ReceivedTime() const override { return 0; }
+  int64_t RenderTime() const override { return 0; }
+};
+
+std::unique_ptr<EncodedFrame> CreateKeyFrame(int64_t id, uint32_t rtp) {
+  auto frame = std::make_unique<FakeEncodedFrame>();
+  frame->SetTimestamp(rtp);
+  frame->SetId(id);
+  frame->is_last_spatial_layer = true;
+  return frame;
+}
+
+class FrameDecodeTimingTest : public ::testing::Test {
+ protected:
+  SimulatedClock clock_{Timestamp::Seconds(1000)};
+  FakeVCMTiming timing_{&clock_};
+  FrameDecodeTiming frame_decode_timing_{&clock_, &timing_};
+};
+
+TEST_F(FrameDecodeTimingTest, SchedulesDecodeAtLatestSafeTime) {
+  const Timestamp render_time = clock_.CurrentTime() + TimeDelta::Millis(60);
+  timing_.SetRenderTime(90000, render_time);
+
+  absl::optional<FrameDecodeTiming::FrameSchedule> schedule =
+      frame_decode_timing_.OnFrameBufferUpdated(90000, 90000, false);
+  ASSERT_TRUE(schedule);
+  EXPECT_EQ(schedule->render_time, render_time);
+  EXPECT_EQ(schedule->latest_decode_time,
+            render_time -
+                TimeDelta::Millis(FakeVCMTiming::kDecodeAndRenderTimeMs));
+}
+
+TEST_F(FrameDecodeTimingTest, DropsLateFrameIfLaterFrameIsDecodable) {
+  const Timestamp render_time = clock_.CurrentTime() + TimeDelta::Millis(5);
+  timing_.SetRenderTime(90000, render_time);
+
+  EXPECT_FALSE(frame_decode_timing_.OnFrameBufferUpdated(90000, 93000, false));
+  // The last decodable frame is decoded right away, even if late.
+  absl::optional<FrameDecodeTiming::FrameSchedule> schedule =
+      frame_decode_timing_.OnFrameBufferUpdated(90000, 90000, false);
+  ASSERT_TRUE(schedule);
+  EXPECT_EQ(schedule->latest_decode_time, clock_.CurrentTime());
+}
+
+TEST_F(FrameDecodeTimingTest, KeepsSlightlyLateFrame) {
+  const Timestamp render_time =
+      clock_.CurrentTime() +
+      TimeDelta::Millis(FakeVCMTiming::kDecodeAndRenderTimeMs) -
+      FrameDecodeTiming::kMaxAllowedFrameDelay + TimeDelta::Millis(1);
+  timing_.SetRenderTime(90000, render_time);
+
+  absl::optional<FrameDecodeTiming::FrameSchedule> schedule =
+      frame_decode_timing_.OnFrameBufferUpdated(90000, 93000, false);
+  ASSERT_TRUE(schedule);
+  EXPECT_EQ(schedule->latest_decode_time, clock_.CurrentTime());
+}
+
+TEST_F(FrameDecodeTimingTest, ScheduleNextTemporalUnitDropsLateUnits) {
+  FrameBuffer buffer(/*max_size=*/10, /*max_decode_history=*/100);
+  buffer.InsertFrame(CreateKeyFrame(/*id=*/1, /*rtp=*/90000));
+  buffer.InsertFrame(CreateKeyFrame(/*id=*/2, /*rtp=*/93000));
+  buffer.InsertFrame(CreateKeyFrame(/*id=*/3, /*rtp=*/96000));
+  timing_.SetRenderTime(90000, clock_.CurrentTime());
+  timing_.SetRenderTime(93000, clock_.CurrentTime() + TimeDelta::Millis(10));
+  const Timestamp render_time = clock_.CurrentTime() + TimeDelta::Millis(40);
+  timing_.SetRenderTime(96000, render_time);
+
+  absl::optional<FrameDecodeTiming::FrameSchedule> schedule =
+      frame_decode_timing_.ScheduleNextTemporalUnit(buffer, false);
+  ASSERT_TRUE(schedule);
+  EXPECT_EQ(schedule->render_time, render_time);
+  EXPECT_EQ(buffer.NextDecodableTemporalUnitRtpTimestamp(), 96000u);
+  EXPECT_EQ(buffer.GetTotalNumberOfDroppedFrames(), 2);
+}
+
+TEST_F(FrameDecodeTimingTest, ScheduleNextTemporalUnitWithEmptyBuffer) {
+  FrameBuffer buffer(/*max_size=*/10, /*max_decode_history=*/100);
+  EXPECT_FALSE(frame_decode_timing_.ScheduleNextTemporalUnit(buffer, false));
+}
+
+}  // namespace
+}  // namespace webrtc
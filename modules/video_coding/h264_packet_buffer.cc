@@ -132,6 +132,7 @@ H264PacketBuffer::InsertResult H264PacketBuffer::InsertPacket(
   RTC_DCHECK(packet->video_header.codec == kVideoCodecH264);
 
   InsertResult result;
+  returned_packets_.clear();
   if (!absl::holds_alternative<RTPVideoHeaderH264>(
           packet->video_header.video_type_header)) {
     return result;
@@ -147,7 +148,11 @@ H264PacketBuffer::InsertResult H264PacketBuffer::InsertPacket(
     packet_slot = std::move(packet);
   }
 
-  result.packets = FindFrames(unwrapped_seq_num);
+  returned_packets_ = FindFrames(unwrapped_seq_num);
+  result.packets.reserve(returned_packets_.size());
+  for (const std::unique_ptr<Packet>& found : returned_packets_) {
+    result.packets.push_back(found.get());
+  }
   return result;
 }
 
@@ -32,6 +32,7 @@ class H264PacketBuffer {
 
   explicit H264PacketBuffer(bool idr_only_keyframes_allowed);
 
+  // The returned packets stay valid until the next call.
   ABSL_MUST_USE_RESULT InsertResult
   InsertPacket(std::unique_ptr<Packet> packet);
 
@@ -49,6 +50,8 @@ class H264PacketBuffer {
   std::array<std::unique_ptr<Packet>, kBufferSize> buffer_;
   absl::optional<int64_t> last_continuous_unwrapped_seq_num_;
   SeqNumUnwrapper<uint16_t> seq_num_unwrapper_;
+  // The packets of the frames returned by the last insertion.
+  std::vector<std::unique_ptr<Packet>> returned_packets_;
 };
 
 }  // namespace webrtc
@@ -229,7 +229,7 @@ rtc::CopyOnWriteBuffer Packet::BuildStapAPayload() const {
 }
 
 rtc::ArrayView<const uint8_t> PacketPayload(
-    const std::unique_ptr<H264PacketBuffer::Packet>& packet) {
+    const H264PacketBuffer::Packet* packet) {
   return packet->video_payload;
 }
 
@@ -155,9 +155,13 @@ void VCMJitterEstimator::UpdateEstimate(int64_t frameDelayMS,
   }
   _prevFrameSize = frameSizeBytes;
 
+  // The noise only changes in EstimateRandomJitter() below, so its standard
+  // deviation is only computed once.
+  const double std_dev_noise = sqrt(_varNoise);
+
   // Cap frameDelayMS based on the current time deviation noise.
   int64_t max_time_deviation_ms =
-      static_cast<int64_t>(time_deviation_upper_bound_ * sqrt(_varNoise) + 0.5);
+      static_cast<int64_t>(time_deviation_upper_bound_ * std_dev_noise + 0.5);
   frameDelayMS = std::max(std::min(frameDelayMS, max_time_deviation_ms),
                           -max_time_deviation_ms);
 
@@ -167,7 +171,7 @@ void VCMJitterEstimator::UpdateEstimate(int64_t frameDelayMS,
   // line slope.
   double deviation = DeviationFromExpectedDelay(frameDelayMS, deltaFS);
 
-  if (fabs(deviation) < _numStdDevDelayOutlier * sqrt(_varNoise) ||
+  if (fabs(deviation) < _numStdDevDelayOutlier * std_dev_noise ||
       frameSizeBytes >
           _avgFrameSize + _numStdDevFrameSizeOutlier * sqrt(_varFrameSize)) {
     // Update the variance of the deviation from the line given by the Kalman
@@ -187,7 +191,7 @@ void VCMJitterEstimator::UpdateEstimate(int64_t frameDelayMS,
   } else {
     int nStdDev =
         (deviation >= 0) ? _numStdDevDelayOutlier : -_numStdDevDelayOutlier;
-    EstimateRandomJitter(nStdDev * sqrt(_varNoise), incompleteFrame);
+    EstimateRandomJitter(nStdDev * std_dev_noise, incompleteFrame);
   }
   // Post process the total estimated jitter
   if (_startupCount >= kStartupDelaySamples) {
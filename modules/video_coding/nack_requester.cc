@@ -11,6 +11,7 @@
 #include "modules/video_coding/nack_requester.h"
 
 #include <algorithm>
+#include <iterator>
 #include <limits>
 
 #include "api/sequence_checker.h"
@@ -43,6 +44,22 @@ int64_t GetSendNackDelay() {
   }
   return kDefaultSendNackDelayMs;
 }
+
+// Inserts `seq_num` into the ordered `list`, unless it's already in it.
+void InsertOrdered(std::deque<uint16_t>* list, uint16_t seq_num) {
+  auto it = list->end();
+  while (it != list->begin() && AheadOf(*std::prev(it), seq_num))
+    --it;
+  if (it != list->begin() && *std::prev(it) == seq_num)
+    return;
+  list->insert(it, seq_num);
+}
+
+// Removes the sequence numbers older than `seq_num` from the ordered `list`.
+void EraseBefore(std::deque<uint16_t>* list, uint16_t seq_num) {
+  while (!list->empty() && AheadOf(seq_num, list->front()))
+    list->pop_front();
+}
 }  // namespace
 
 constexpr TimeDelta NackPeriodicProcessor::kUpdateInterval;
@@ -92,14 +109,11 @@ ScopedNackPeriodicProcessorRegistration::
   processor_->UnregisterNackModule(module_);
 }
 
-NackRequester::NackInfo::NackInfo()
-    : seq_num(0), send_at_seq_num(0), sent_at_time(-1), retries(0) {}
-
-NackRequester::NackInfo::NackInfo(uint16_t seq_num,
-                                  uint16_t send_at_seq_num,
-                                  int64_t created_at_time)
-    : seq_num(seq_num),
-      send_at_seq_num(send_at_seq_num),
+NackRequester::NackRange::NackRange(uint16_t num_packets,
+                                    uint16_t send_at_offset,
+                                    int64_t created_at_time)
+    : num_packets(num_packets),
+      send_at_offset(send_at_offset),
       created_at_time(created_at_time),
       sent_at_time(-1),
       retries(0) {}
@@ -190,7 +204,7 @@ int NackRequester::OnReceivedPacket(uint16_t seq_num,
   if (!initialized_) {
     newest_seq_num_ = seq_num;
     if (is_keyframe)
-      keyframe_list_.insert(seq_num);
+      keyframe_list_.push_back(seq_num);
     initialized_ = true;
     return 0;
   }
@@ -202,12 +216,7 @@ int NackRequester::OnReceivedPacket(uint16_t seq_num,
 
   if (AheadOf(newest_seq_num_, seq_num)) {
     // An out of order packet has been received.
-    auto nack_list_it = nack_list_.find(seq_num);
-    int nacks_sent_for_packet = 0;
-    if (nack_list_it != nack_list_.end()) {
-      nacks_sent_for_packet = nack_list_it->second.retries;
-      nack_list_.erase(nack_list_it);
-    }
+    int nacks_sent_for_packet = RemoveFromNackList(seq_num);
     if (!is_retransmitted)
       UpdateReorderingStatistics(seq_num);
     return nacks_sent_for_packet;
@@ -215,20 +224,16 @@ int NackRequester::OnReceivedPacket(uint16_t seq_num,
 
   // Keep track of new keyframes.
   if (is_keyframe)
-    keyframe_list_.insert(seq_num);
+    InsertOrdered(&keyframe_list_, seq_num);
 
   // And remove old ones so we don't accumulate keyframes.
-  auto it = keyframe_list_.lower_bound(seq_num - kMaxPacketAge);
-  if (it != keyframe_list_.begin())
-    keyframe_list_.erase(keyframe_list_.begin(), it);
+  EraseBefore(&keyframe_list_, seq_num - kMaxPacketAge);
 
   if (is_recovered) {
-    recovered_list_.insert(seq_num);
+    InsertOrdered(&recovered_list_, seq_num);
 
     // Remove old ones so we don't accumulate recovered packets.
-    auto it = recovered_list_.lower_bound(seq_num - kMaxPacketAge);
-    if (it != recovered_list_.begin())
-      recovered_list_.erase(recovered_list_.begin(), it);
+    EraseBefore(&recovered_list_, seq_num - kMaxPacketAge);
 
     // Do not send nack for packets recovered by FEC or RTX.
     return 0;
@@ -252,11 +257,9 @@ void NackRequester::ClearUpTo(uint16_t seq_num) {
   // Called via RtpVideoStreamReceiver2::FrameContinuous on the network thread.
   worker_thread_->PostTask(ToQueuedTask(task_safety_, [seq_num, this]() {
     RTC_DCHECK_RUN_ON(worker_thread_);
-    nack_list_.erase(nack_list_.begin(), nack_list_.lower_bound(seq_num));
-    keyframe_list_.erase(keyframe_list_.begin(),
-                         keyframe_list_.lower_bound(seq_num));
-    recovered_list_.erase(recovered_list_.begin(),
-                          recovered_list_.lower_bound(seq_num));
+    ClearNackListBefore(seq_num);
+    EraseBefore(&keyframe_list_, seq_num);
+    EraseBefore(&recovered_list_, seq_num);
   }));
 }
 
@@ -268,18 +271,17 @@ void NackRequester::UpdateRtt(int64_t rtt_ms) {
 bool NackRequester::RemovePacketsUntilKeyFrame() {
   // Called on worker_thread_.
   while (!keyframe_list_.empty()) {
-    auto it = nack_list_.lower_bound(*keyframe_list_.begin());
-
-    if (it != nack_list_.begin()) {
+    if (!nack_list_.empty() &&
+        AheadOf(keyframe_list_.front(), nack_list_.begin()->first)) {
       // We have found a keyframe that actually is newer than at least one
       // packet in the nack list.
-      nack_list_.erase(nack_list_.begin(), it);
+      ClearNackListBefore(keyframe_list_.front());
       return true;
     }
 
     // If this keyframe is so old it does not remove any packets from the list,
     // remove it from the list of keyframes and try the next keyframe.
-    keyframe_list_.erase(keyframe_list_.begin());
+    keyframe_list_.pop_front();
   }
   return false;
 }
@@ -288,20 +290,20 @@ void NackRequester::AddPacketsToNack(uint16_t seq_num_start,
                                      uint16_t seq_num_end) {
   // Called on worker_thread_.
   // Remove old packets.
-  auto it = nack_list_.lower_bound(seq_num_end - kMaxPacketAge);
-  nack_list_.erase(nack_list_.begin(), it);
+  ClearNackListBefore(seq_num_end - kMaxPacketAge);
 
   // If the nack list is too large, remove packets from the nack list until
   // the latest first packet of a keyframe. If the list is still too large,
   // clear it and request a keyframe.
   uint16_t num_new_nacks = ForwardDiff(seq_num_start, seq_num_end);
-  if (nack_list_.size() + num_new_nacks > kMaxNackPackets) {
+  if (nack_list_size_ + num_new_nacks > kMaxNackPackets) {
     while (RemovePacketsUntilKeyFrame() &&
-           nack_list_.size() + num_new_nacks > kMaxNackPackets) {
+           nack_list_size_ + num_new_nacks > kMaxNackPackets) {
     }
 
-    if (nack_list_.size() + num_new_nacks > kMaxNackPackets) {
+    if (nack_list_size_ + num_new_nacks > kMaxNackPackets) {
       nack_list_.clear();
+      nack_list_size_ = 0;
       RTC_LOG(LS_WARNING) << "NACK list full, clearing NACK"
                              " list and requesting keyframe.";
       keyframe_request_sender_->RequestKeyFrame();
@@ -309,17 +311,98 @@ void NackRequester::AddPacketsToNack(uint16_t seq_num_start,
     }
   }
 
-  for (uint16_t seq_num = seq_num_start; seq_num != seq_num_end; ++seq_num) {
-    // Do not send nack for packets that are already recovered by FEC or RTX
-    if (recovered_list_.find(seq_num) != recovered_list_.end())
-      continue;
-    NackInfo nack_info(seq_num, seq_num + WaitNumberOfPackets(0.5),
-                       clock_->TimeInMilliseconds());
-    RTC_DCHECK(nack_list_.find(seq_num) == nack_list_.end());
-    nack_list_[seq_num] = nack_info;
+  const uint16_t send_at_offset = WaitNumberOfPackets(0.5);
+  const int64_t now_ms = clock_->TimeInMilliseconds();
+  // Do not send nack for packets that are already recovered by FEC or RTX, so
+  // add the ranges between them.
+  auto recovered_it =
+      std::lower_bound(recovered_list_.begin(), recovered_list_.end(),
+                       seq_num_start, DescendingSeqNumComp<uint16_t>());
+  uint16_t seq_num = seq_num_start;
+  while (seq_num != seq_num_end) {
+    uint16_t range_end = seq_num_end;
+    if (recovered_it != recovered_list_.end() &&
+        AheadOf(seq_num_end, *recovered_it)) {
+      range_end = *recovered_it++;
+    }
+    if (range_end != seq_num) {
+      InsertNackRange(seq_num, NackRange(ForwardDiff(seq_num, range_end),
+                                         send_at_offset, now_ms));
+    }
+    if (range_end == seq_num_end)
+      break;
+    seq_num = range_end + 1;
   }
 }
 
+void NackRequester::InsertNackRange(uint16_t seq_num, const NackRange& range) {
+  // Called on worker_thread_.
+  RTC_DCHECK_GT(range.num_packets, 0);
+  // Ranges are added in order, after the packets that are already nacked.
+  RTC_DCHECK(nack_list_.empty() ||
+             AheadOf<uint16_t>(seq_num,
+                               nack_list_.rbegin()->first +
+                                   nack_list_.rbegin()->second.num_packets -
+                                   1));
+  nack_list_size_ += range.num_packets;
+  nack_list_.emplace_hint(nack_list_.end(), seq_num, range);
+}
+
+int NackRequester::RemoveFromNackList(uint16_t seq_num) {
+  // Called on worker_thread_.
+  auto it = nack_list_.upper_bound(seq_num);
+  if (it == nack_list_.begin())
+    return 0;
+  --it;
+  // The position of `seq_num` in the range, since the range starts at or
+  // before `seq_num`.
+  uint16_t index = seq_num - it->first;
+  if (index >= it->second.num_packets)
+    return 0;
+
+  int retries = it->second.retries;
+  if (index + 1 < it->second.num_packets) {
+    SplitNackRange(it, index + 1);
+  }
+  // `seq_num` is now the last packet of the range.
+  --nack_list_size_;
+  if (--it->second.num_packets == 0) {
+    nack_list_.erase(it);
+  }
+  return retries;
+}
+
+void NackRequester::ClearNackListBefore(uint16_t seq_num) {
+  // Called on worker_thread_.
+  auto it = nack_list_.begin();
+  while (it != nack_list_.end() && AheadOf(seq_num, it->first)) {
+    uint16_t num_old_packets = seq_num - it->first;
+    if (num_old_packets < it->second.num_packets) {
+      // Keep the packets of the range from `seq_num` on.
+      SplitNackRange(it, num_old_packets);
+      nack_list_size_ -= num_old_packets;
+      nack_list_.erase(it);
+      return;
+    }
+    nack_list_size_ -= it->second.num_packets;
+    it = nack_list_.erase(it);
+  }
+}
+
+NackRequester::NackList::iterator NackRequester::SplitNackRange(
+    NackList::iterator it,
+    uint16_t num_packets) {
+  // Called on worker_thread_.
+  RTC_DCHECK_GT(num_packets, 0);
+  RTC_DCHECK_LT(num_packets, it->second.num_packets);
+  NackRange rest = it->second;
+  rest.num_packets -= num_packets;
+  it->second.num_packets = num_packets;
+  return nack_list_.emplace_hint(std::next(it),
+                                 static_cast<uint16_t>(it->first + num_packets),
+                                 rest);
+}
+
 std::vector<uint16_t> NackRequester::GetNackBatch(NackFilterOptions options) {
   // Called on worker_thread_.
 
@@ -329,40 +412,60 @@ std::vector<uint16_t> NackRequester::GetNackBatch(NackFilterOptions options) {
   std::vector<uint16_t> nack_batch;
   auto it = nack_list_.begin();
   while (it != nack_list_.end()) {
+    NackRange& range = it->second;
     TimeDelta resend_delay = TimeDelta::Millis(rtt_ms_);
     if (backoff_settings_) {
       resend_delay =
           std::max(resend_delay, backoff_settings_->min_retry_interval);
-      if (it->second.retries > 1) {
+      if (range.retries > 1) {
         TimeDelta exponential_backoff =
             std::min(TimeDelta::Millis(rtt_ms_), backoff_settings_->max_rtt) *
-            std::pow(backoff_settings_->base, it->second.retries - 1);
+            std::pow(backoff_settings_->base, range.retries - 1);
         resend_delay = std::max(resend_delay, exponential_backoff);
       }
     }
 
     bool delay_timed_out =
-        now.ms() - it->second.created_at_time >= send_nack_delay_ms_;
+        now.ms() - range.created_at_time >= send_nack_delay_ms_;
     bool nack_on_rtt_passed =
-        now.ms() - it->second.sent_at_time >= resend_delay.ms();
-    bool nack_on_seq_num_passed =
-        it->second.sent_at_time == -1 &&
-        AheadOrAt(newest_seq_num_, it->second.send_at_seq_num);
-    if (delay_timed_out && ((consider_seq_num && nack_on_seq_num_passed) ||
-                            (consider_timestamp && nack_on_rtt_passed))) {
-      nack_batch.emplace_back(it->second.seq_num);
-      ++it->second.retries;
-      it->second.sent_at_time = now.ms();
-      if (it->second.retries >= kMaxNackRetries) {
-        RTC_LOG(LS_WARNING) << "Sequence number " << it->second.seq_num
-                            << " removed from NACK list due to max retries.";
-        it = nack_list_.erase(it);
-      } else {
-        ++it;
+        now.ms() - range.sent_at_time >= resend_delay.ms();
+    // The number of packets at the start of the range to nack now.
+    uint16_t num_packets = 0;
+    if (delay_timed_out) {
+      if (consider_timestamp && nack_on_rtt_passed) {
+        num_packets = range.num_packets;
+      } else if (consider_seq_num && range.sent_at_time == -1) {
+        // Packets up to `last_due` have had their `send_at_offset` packets
+        // received after them.
+        uint16_t last_due = newest_seq_num_ - range.send_at_offset;
+        if (AheadOrAt(last_due, it->first)) {
+          num_packets = std::min<int>(range.num_packets,
+                                      ForwardDiff(it->first, last_due) + 1);
+        }
       }
+    }
+    if (num_packets == 0) {
+      ++it;
       continue;
     }
-    ++it;
+
+    if (num_packets < range.num_packets) {
+      SplitNackRange(it, num_packets);
+    }
+    for (uint16_t i = 0; i < num_packets; ++i) {
+      nack_batch.push_back(it->first + i);
+    }
+    ++range.retries;
+    range.sent_at_time = now.ms();
+    if (range.retries >= kMaxNackRetries) {
+      RTC_LOG(LS_WARNING) << "Sequence numbers " << it->first << " to "
+                          << static_cast<uint16_t>(it->first + num_packets - 1)
+                          << " removed from NACK list due to max retries.";
+      nack_list_size_ -= num_packets;
+      it = nack_list_.erase(it);
+    } else {
+      ++it;
+    }
   }
   return nack_batch;
 }
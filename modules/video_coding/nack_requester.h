@@ -13,8 +13,8 @@
 
 #include <stdint.h>
 
+#include <deque>
 #include <map>
-#include <set>
 #include <vector>
 
 #include "api/sequence_checker.h"
@@ -86,21 +86,27 @@ class NackRequester final : public NackRequesterBase {
   // GetNackBatch.
   enum NackFilterOptions { kSeqNumOnly, kTimeOnly, kSeqNumAndTime };
 
-  // This class holds the sequence number of the packet that is in the nack list
-  // as well as the meta data about when it should be nacked and how many times
-  // we have tried to nack this packet.
-  struct NackInfo {
-    NackInfo();
-    NackInfo(uint16_t seq_num,
-             uint16_t send_at_seq_num,
-             int64_t created_at_time);
-
-    uint16_t seq_num;
-    uint16_t send_at_seq_num;
+  // This class holds a range of consecutive packets in the nack list, keyed by
+  // the sequence number of its first packet, as well as the meta data about
+  // when they should be nacked and how many times we have tried to nack them.
+  // Packets that are missing together are added and nacked together, so a
+  // range is only split when a packet in it is received or when only a part
+  // of it is due to be nacked.
+  struct NackRange {
+    NackRange(uint16_t num_packets,
+              uint16_t send_at_offset,
+              int64_t created_at_time);
+
+    uint16_t num_packets;
+    // Packet `seq_num` of the range should be nacked once sequence number
+    // `seq_num + send_at_offset` has been received.
+    uint16_t send_at_offset;
     int64_t created_at_time;
     int64_t sent_at_time;
     int retries;
   };
+  using NackList =
+      std::map<uint16_t, NackRange, DescendingSeqNumComp<uint16_t>>;
 
   struct BackoffSettings {
     BackoffSettings(TimeDelta min_retry, TimeDelta max_rtt, double base);
@@ -116,6 +122,21 @@ class NackRequester final : public NackRequesterBase {
 
   void AddPacketsToNack(uint16_t seq_num_start, uint16_t seq_num_end)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(worker_thread_);
+  // Adds `range` to the nack list, starting at `seq_num`.
+  void InsertNackRange(uint16_t seq_num, const NackRange& range)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(worker_thread_);
+  // Removes `seq_num` from the nack list, splitting the range containing it.
+  // Returns the number of times it was nacked, or 0 if it wasn't in the list.
+  int RemoveFromNackList(uint16_t seq_num)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(worker_thread_);
+  // Removes all packets older than `seq_num` from the nack list.
+  void ClearNackListBefore(uint16_t seq_num)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(worker_thread_);
+  // Splits the range at `it` so that it has `num_packets` packets, and returns
+  // an iterator to the range with the remaining packets.
+  NackList::iterator SplitNackRange(NackList::iterator it,
+                                    uint16_t num_packets)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(worker_thread_);
 
   // Removes packets from the nack list until the next keyframe. Returns true
   // if packets were removed.
@@ -141,12 +162,13 @@ class NackRequester final : public NackRequesterBase {
   // TODO(philipel): Some of the variables below are consistently used on a
   // known thread (e.g. see `initialized_`). Those probably do not need
   // synchronized access.
-  std::map<uint16_t, NackInfo, DescendingSeqNumComp<uint16_t>> nack_list_
-      RTC_GUARDED_BY(worker_thread_);
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t>> keyframe_list_
-      RTC_GUARDED_BY(worker_thread_);
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t>> recovered_list_
-      RTC_GUARDED_BY(worker_thread_);
+  NackList nack_list_ RTC_GUARDED_BY(worker_thread_);
+  // The number of packets in `nack_list_`.
+  int nack_list_size_ RTC_GUARDED_BY(worker_thread_) = 0;
+  // Ordered from oldest to newest. Packets are received mostly in order, so
+  // they are almost always added at the back and removed from the front.
+  std::deque<uint16_t> keyframe_list_ RTC_GUARDED_BY(worker_thread_);
+  std::deque<uint16_t> recovered_list_ RTC_GUARDED_BY(worker_thread_);
   video_coding::Histogram reordering_histogram_ RTC_GUARDED_BY(worker_thread_);
   bool initialized_ RTC_GUARDED_BY(worker_thread_);
   int64_t rtt_ms_ RTC_GUARDED_BY(worker_thread_);
@@ -17,10 +17,14 @@
 
 #include "system_wrappers/include/clock.h"
 #include "test/field_trial.h"
+#include "test/gmock.h"
 #include "test/gtest.h"
 #include "test/run_loop.h"
 
 namespace webrtc {
+
+using ::testing::ElementsAre;
+
 // TODO(bugs.webrtc.org/11594): Use the use the GlobalSimulatedTimeController
 // instead of RunLoop. At the moment we mix use of the Clock and the underlying
 // implementation of RunLoop, which is realtime.
@@ -365,6 +369,34 @@ TEST_P(TestNackRequester, HandleFecRecoveredPacket) {
   EXPECT_EQ(2u, sent_nacks_.size());
 }
 
+TEST_P(TestNackRequester, HandleFecRecoveredPacketsWithinGap) {
+  NackRequester& nack_module = CreateNackModule();
+  nack_module.OnReceivedPacket(1, false, false);
+  nack_module.OnReceivedPacket(5, false, true);
+  nack_module.OnReceivedPacket(3, false, true);
+  nack_module.OnReceivedPacket(8, false, false);
+  EXPECT_THAT(sent_nacks_, ElementsAre(2, 4, 6, 7));
+}
+
+TEST_P(TestNackRequester, ResendOnlyPacketsNotReceived) {
+  NackRequester& nack_module = CreateNackModule(TimeDelta::Millis(1));
+  nack_module.OnReceivedPacket(0, false, false);
+  nack_module.OnReceivedPacket(10, false, false);
+  ASSERT_EQ(9u, sent_nacks_.size());
+
+  // Receive packets at the start, in the middle and at the end of the range
+  // of nacked packets.
+  EXPECT_EQ(1, nack_module.OnReceivedPacket(1, false, false));
+  EXPECT_EQ(1, nack_module.OnReceivedPacket(5, false, false));
+  EXPECT_EQ(1, nack_module.OnReceivedPacket(6, false, false));
+  EXPECT_EQ(1, nack_module.OnReceivedPacket(9, false, false));
+
+  sent_nacks_.clear();
+  clock_->AdvanceTimeMilliseconds(100);
+  WaitForSendNack();
+  EXPECT_THAT(sent_nacks_, ElementsAre(2, 3, 4, 7, 8));
+}
+
 TEST_P(TestNackRequester, SendNackWithoutDelay) {
   NackRequester& nack_module = CreateNackModule();
   nack_module.OnReceivedPacket(0, false, false);
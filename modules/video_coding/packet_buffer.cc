@@ -30,6 +30,7 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/mod_ops.h"
+#include "system_wrappers/include/memory_accounting.h"
 
 namespace webrtc {
 namespace video_coding {
@@ -58,13 +59,14 @@ PacketBuffer::PacketBuffer(size_t start_buffer_size, size_t max_buffer_size)
 
 PacketBuffer::~PacketBuffer() {
   Clear();
+  ReleaseReturnedPackets();
 }
 
-PacketBuffer::InsertResult PacketBuffer::InsertPacket(
-    std::unique_ptr<PacketBuffer::Packet> packet) {
+PacketBuffer::InsertResult PacketBuffer::InsertPacket(Packet&& packet) {
   PacketBuffer::InsertResult result;
+  ReleaseReturnedPackets();
 
-  uint16_t seq_num = packet->seq_num;
+  uint16_t seq_num = packet.seq_num;
   size_t index = seq_num % buffer_.size();
 
   if (!first_packet_received_) {
@@ -80,19 +82,19 @@ PacketBuffer::InsertResult PacketBuffer::InsertPacket(
     first_seq_num_ = seq_num;
   }
 
-  if (buffer_[index] != nullptr) {
+  if (buffer_[index].used) {
     // Duplicate packet, just delete the payload.
-    if (buffer_[index]->seq_num == packet->seq_num) {
+    if (buffer_[index].packet.seq_num == packet.seq_num) {
       return result;
     }
 
     // The packet buffer is full, try to expand the buffer.
-    while (ExpandBufferSize() && buffer_[seq_num % buffer_.size()] != nullptr) {
+    while (ExpandBufferSize() && buffer_[seq_num % buffer_.size()].used) {
     }
     index = seq_num % buffer_.size();
 
     // Packet buffer is still full since we were unable to expand the buffer.
-    if (buffer_[index] != nullptr) {
+    if (buffer_[index].used) {
       // Clear the buffer, delete payload, and return false to signal that a
       // new keyframe is needed.
       RTC_LOG(LS_WARNING) << "Clear PacketBuffer and request key frame.";
@@ -102,8 +104,11 @@ PacketBuffer::InsertResult PacketBuffer::InsertPacket(
     }
   }
 
-  packet->continuous = false;
-  buffer_[index] = std::move(packet);
+  packet.continuous = false;
+  memory_accounting::Add(memory_accounting::Subsystem::kVideoPacketBuffer,
+                         packet.video_payload.size());
+  buffer_[index].packet = std::move(packet);
+  buffer_[index].used = true;
 
   UpdateMissingPackets(seq_num);
 
@@ -128,9 +133,10 @@ void PacketBuffer::ClearTo(uint16_t seq_num) {
   size_t diff = ForwardDiff<uint16_t>(first_seq_num_, seq_num);
   size_t iterations = std::min(diff, buffer_.size());
   for (size_t i = 0; i < iterations; ++i) {
-    auto& stored = buffer_[first_seq_num_ % buffer_.size()];
-    if (stored != nullptr && AheadOf<uint16_t>(seq_num, stored->seq_num)) {
-      stored = nullptr;
+    Slot& stored = buffer_[first_seq_num_ % buffer_.size()];
+    if (stored.used && AheadOf<uint16_t>(seq_num, stored.packet.seq_num)) {
+      stored.used = false;
+      ReleasePayload(&stored.packet);
     }
     ++first_seq_num_;
   }
@@ -153,6 +159,7 @@ void PacketBuffer::Clear() {
 
 PacketBuffer::InsertResult PacketBuffer::InsertPadding(uint16_t seq_num) {
   PacketBuffer::InsertResult result;
+  ReleaseReturnedPackets();
   UpdateMissingPackets(seq_num);
   result.packets = FindFrames(static_cast<uint16_t>(seq_num + 1));
   return result;
@@ -163,8 +170,11 @@ void PacketBuffer::ForceSpsPpsIdrIsH264Keyframe() {
 }
 
 void PacketBuffer::ClearInternal() {
-  for (auto& entry : buffer_) {
-    entry = nullptr;
+  for (Slot& entry : buffer_) {
+    if (entry.used) {
+      entry.used = false;
+      ReleasePayload(&entry.packet);
+    }
   }
 
   first_packet_received_ = false;
@@ -181,10 +191,10 @@ bool PacketBuffer::ExpandBufferSize() {
   }
 
   size_t new_size = std::min(max_size_, 2 * buffer_.size());
-  std::vector<std::unique_ptr<Packet>> new_buffer(new_size);
-  for (std::unique_ptr<Packet>& entry : buffer_) {
-    if (entry != nullptr) {
-      new_buffer[entry->seq_num % new_size] = std::move(entry);
+  std::vector<Slot> new_buffer(new_size);
+  for (Slot& entry : buffer_) {
+    if (entry.used) {
+      new_buffer[entry.packet.seq_num % new_size] = std::move(entry);
     }
   }
   buffer_ = std::move(new_buffer);
@@ -195,47 +205,47 @@ bool PacketBuffer::ExpandBufferSize() {
 bool PacketBuffer::PotentialNewFrame(uint16_t seq_num) const {
   size_t index = seq_num % buffer_.size();
   int prev_index = index > 0 ? index - 1 : buffer_.size() - 1;
-  const auto& entry = buffer_[index];
-  const auto& prev_entry = buffer_[prev_index];
+  const Slot& entry = buffer_[index];
+  const Slot& prev_entry = buffer_[prev_index];
 
-  if (entry == nullptr)
+  if (!entry.used)
     return false;
-  if (entry->seq_num != seq_num)
+  if (entry.packet.seq_num != seq_num)
     return false;
-  if (entry->is_first_packet_in_frame())
+  if (entry.packet.is_first_packet_in_frame())
     return true;
-  if (prev_entry == nullptr)
+  if (!prev_entry.used)
     return false;
-  if (prev_entry->seq_num != static_cast<uint16_t>(entry->seq_num - 1))
+  if (prev_entry.packet.seq_num !=
+      static_cast<uint16_t>(entry.packet.seq_num - 1))
     return false;
-  if (prev_entry->timestamp != entry->timestamp)
+  if (prev_entry.packet.timestamp != entry.packet.timestamp)
     return false;
-  if (prev_entry->continuous)
+  if (prev_entry.packet.continuous)
     return true;
 
   return false;
 }
 
-std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
-    uint16_t seq_num) {
-  std::vector<std::unique_ptr<PacketBuffer::Packet>> found_frames;
+std::vector<PacketBuffer::Packet*> PacketBuffer::FindFrames(uint16_t seq_num) {
+  std::vector<Packet*> found_frames;
   for (size_t i = 0; i < buffer_.size() && PotentialNewFrame(seq_num); ++i) {
     size_t index = seq_num % buffer_.size();
-    buffer_[index]->continuous = true;
+    buffer_[index].packet.continuous = true;
 
     // If all packets of the frame is continuous, find the first packet of the
     // frame and add all packets of the frame to the returned packets.
-    if (buffer_[index]->is_last_packet_in_frame()) {
+    if (buffer_[index].packet.is_last_packet_in_frame()) {
       uint16_t start_seq_num = seq_num;
 
       // Find the start index by searching backward until the packet with
       // the `frame_begin` flag is set.
       int start_index = index;
       size_t tested_packets = 0;
-      int64_t frame_timestamp = buffer_[start_index]->timestamp;
+      int64_t frame_timestamp = buffer_[start_index].packet.timestamp;
 
       // Identify H.264 keyframes by means of SPS, PPS, and IDR.
-      bool is_h264 = buffer_[start_index]->codec() == kVideoCodecH264;
+      bool is_h264 = buffer_[start_index].packet.codec() == kVideoCodecH264;
       bool has_h264_sps = false;
       bool has_h264_pps = false;
       bool has_h264_idr = false;
@@ -245,12 +255,12 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
       while (true) {
         ++tested_packets;
 
-        if (!is_h264 && buffer_[start_index]->is_first_packet_in_frame())
+        if (!is_h264 && buffer_[start_index].packet.is_first_packet_in_frame())
           break;
 
         if (is_h264) {
           const auto* h264_header = absl::get_if<RTPVideoHeaderH264>(
-              &buffer_[start_index]->video_header.video_type_header);
+              &buffer_[start_index].packet.video_header.video_type_header);
           if (!h264_header || h264_header->nalus_length >= kMaxNalusPerPacket)
             return found_frames;
 
@@ -271,10 +281,10 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
             // smallest index and valid resolution; typically its IDR or SPS
             // packet; there may be packet preceeding this packet, IDR's
             // resolution will be applied to them.
-            if (buffer_[start_index]->width() > 0 &&
-                buffer_[start_index]->height() > 0) {
-              idr_width = buffer_[start_index]->width();
-              idr_height = buffer_[start_index]->height();
+            const Packet& packet = buffer_[start_index].packet;
+            if (packet.width() > 0 && packet.height() > 0) {
+              idr_width = packet.width();
+              idr_height = packet.height();
             }
           }
         }
@@ -290,8 +300,9 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
         // the timestamp of that packet is the same as this one. This may cause
         // the PacketBuffer to hand out incomplete frames.
         // See: https://bugs.chromium.org/p/webrtc/issues/detail?id=7106
-        if (is_h264 && (buffer_[start_index] == nullptr ||
-                        buffer_[start_index]->timestamp != frame_timestamp)) {
+        if (is_h264 &&
+            (!buffer_[start_index].used ||
+             buffer_[start_index].packet.timestamp != frame_timestamp)) {
           break;
         }
 
@@ -313,19 +324,18 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
         // Now that we have decided whether to treat this frame as a key frame
         // or delta frame in the frame buffer, we update the field that
         // determines if the RtpFrameObject is a key frame or delta frame.
-        const size_t first_packet_index = start_seq_num % buffer_.size();
+        RTPVideoHeader& first_video_header =
+            buffer_[start_seq_num % buffer_.size()].packet.video_header;
         if (is_h264_keyframe) {
-          buffer_[first_packet_index]->video_header.frame_type =
-              VideoFrameType::kVideoFrameKey;
+          first_video_header.frame_type = VideoFrameType::kVideoFrameKey;
           if (idr_width > 0 && idr_height > 0) {
             // IDR frame was finalized and we have the correct resolution for
             // IDR; update first packet to have same resolution as IDR.
-            buffer_[first_packet_index]->video_header.width = idr_width;
-            buffer_[first_packet_index]->video_header.height = idr_height;
+            first_video_header.width = idr_width;
+            first_video_header.height = idr_height;
           }
         } else {
-          buffer_[first_packet_index]->video_header.frame_type =
-              VideoFrameType::kVideoFrameDelta;
+          first_video_header.frame_type = VideoFrameType::kVideoFrameDelta;
         }
 
         // If this is not a keyframe, make sure there are no gaps in the packet
@@ -341,13 +351,17 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
       uint16_t num_packets = end_seq_num - start_seq_num;
       found_frames.reserve(found_frames.size() + num_packets);
       for (uint16_t i = start_seq_num; i != end_seq_num; ++i) {
-        std::unique_ptr<Packet>& packet = buffer_[i % buffer_.size()];
-        RTC_DCHECK(packet);
-        RTC_DCHECK_EQ(i, packet->seq_num);
+        const size_t slot_index = i % buffer_.size();
+        Slot& slot = buffer_[slot_index];
+        RTC_DCHECK(slot.used);
+        RTC_DCHECK_EQ(i, slot.packet.seq_num);
         // Ensure frame boundary flags are properly set.
-        packet->video_header.is_first_packet_in_frame = (i == start_seq_num);
-        packet->video_header.is_last_packet_in_frame = (i == seq_num);
-        found_frames.push_back(std::move(packet));
+        slot.packet.video_header.is_first_packet_in_frame =
+            (i == start_seq_num);
+        slot.packet.video_header.is_last_packet_in_frame = (i == seq_num);
+        slot.used = false;
+        returned_slots_.push_back(slot_index);
+        found_frames.push_back(&slot.packet);
       }
 
       missing_packets_.erase(missing_packets_.begin(),
@@ -358,6 +372,20 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
   return found_frames;
 }
 
+void PacketBuffer::ReleaseReturnedPackets() {
+  for (size_t index : returned_slots_) {
+    RTC_DCHECK(!buffer_[index].used);
+    ReleasePayload(&buffer_[index].packet);
+  }
+  returned_slots_.clear();
+}
+
+void PacketBuffer::ReleasePayload(Packet* packet) {
+  memory_accounting::Add(memory_accounting::Subsystem::kVideoPacketBuffer,
+                         -static_cast<int64_t>(packet->video_payload.size()));
+  packet->video_payload = rtc::CopyOnWriteBuffer();
+}
+
 void PacketBuffer::UpdateMissingPackets(uint16_t seq_num) {
   if (!newest_inserted_seq_num_)
     newest_inserted_seq_num_ = seq_num;
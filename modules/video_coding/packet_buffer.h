@@ -11,7 +11,6 @@
 #ifndef MODULES_VIDEO_CODING_PACKET_BUFFER_H_
 #define MODULES_VIDEO_CODING_PACKET_BUFFER_H_
 
-#include <memory>
 #include <queue>
 #include <set>
 #include <vector>
@@ -36,9 +35,9 @@ class PacketBuffer {
     Packet(const RtpPacketReceived& rtp_packet,
            const RTPVideoHeader& video_header);
     Packet(const Packet&) = delete;
-    Packet(Packet&&) = delete;
+    Packet(Packet&&) = default;
     Packet& operator=(const Packet&) = delete;
-    Packet& operator=(Packet&&) = delete;
+    Packet& operator=(Packet&&) = default;
     ~Packet() = default;
 
     VideoCodecType codec() const { return video_header.codec; }
@@ -65,7 +64,10 @@ class PacketBuffer {
     RTPVideoHeader video_header;
   };
   struct InsertResult {
-    std::vector<std::unique_ptr<Packet>> packets;
+    // The packets of the frames that were completed, in order. They are
+    // owned by the PacketBuffer and stay valid until the next call to
+    // InsertPacket() or InsertPadding().
+    std::vector<Packet*> packets;
     // Indicates if the packet buffer was cleared, which means that a key
     // frame request should be sent.
     bool buffer_cleared = false;
@@ -75,8 +77,9 @@ class PacketBuffer {
   PacketBuffer(size_t start_buffer_size, size_t max_buffer_size);
   ~PacketBuffer();
 
-  ABSL_MUST_USE_RESULT InsertResult
-  InsertPacket(std::unique_ptr<Packet> packet);
+  // The packet is moved into a slot of the buffer, whose storage is reused
+  // by later packets.
+  ABSL_MUST_USE_RESULT InsertResult InsertPacket(Packet&& packet);
   ABSL_MUST_USE_RESULT InsertResult InsertPadding(uint16_t seq_num);
   void ClearTo(uint16_t seq_num);
   void Clear();
@@ -84,8 +87,19 @@ class PacketBuffer {
   void ForceSpsPpsIdrIsH264Keyframe();
 
  private:
+  struct Slot {
+    Packet packet;
+    // If `packet` has been inserted and not yet returned in a frame.
+    bool used = false;
+  };
+
   void ClearInternal();
 
+  // Releases the payloads of the packets returned by the last insertion.
+  void ReleaseReturnedPackets();
+  // Releases the payload of a stored packet and accounts for it.
+  static void ReleasePayload(Packet* packet);
+
   // Tries to expand the buffer.
   bool ExpandBufferSize();
 
@@ -94,7 +108,7 @@ class PacketBuffer {
 
   // Test if all packets of a frame has arrived, and if so, returns packets to
   // create frames.
-  std::vector<std::unique_ptr<Packet>> FindFrames(uint16_t seq_num);
+  std::vector<Packet*> FindFrames(uint16_t seq_num);
 
   void UpdateMissingPackets(uint16_t seq_num);
 
@@ -112,7 +126,9 @@ class PacketBuffer {
 
   // Buffer that holds the the inserted packets and information needed to
   // determine continuity between them.
-  std::vector<std::unique_ptr<Packet>> buffer_;
+  std::vector<Slot> buffer_;
+  // Indices in `buffer_` of the packets returned by the last insertion.
+  std::vector<size_t> returned_slots_;
 
   absl::optional<uint16_t> newest_inserted_seq_num_;
   std::set<uint16_t, DescendingSeqNumComp<uint16_t>> missing_packets_;
@@ -42,7 +42,7 @@ void IgnoreResult(PacketBuffer::InsertResult /*result*/) {}
 // Validates frame boundaries are valid and returns first sequence_number for
 // each frame.
 std::vector<uint16_t> StartSeqNums(
-    rtc::ArrayView<const std::unique_ptr<PacketBuffer::Packet>> packets) {
+    rtc::ArrayView<PacketBuffer::Packet* const> packets) {
   std::vector<uint16_t> result;
   bool frame_boundary = true;
   for (const auto& packet : packets) {
@@ -113,16 +113,16 @@ class PacketBufferTest : public ::testing::Test {
                                   IsLast last,    // is last packet of frame
                                   rtc::ArrayView<const uint8_t> data = {},
                                   uint32_t timestamp = 123u) {  // rtp timestamp
-    auto packet = std::make_unique<PacketBuffer::Packet>();
-    packet->video_header.codec = kVideoCodecGeneric;
-    packet->timestamp = timestamp;
-    packet->seq_num = seq_num;
-    packet->video_header.frame_type = keyframe == kKeyFrame
+    PacketBuffer::Packet packet;
+    packet.video_header.codec = kVideoCodecGeneric;
+    packet.timestamp = timestamp;
+    packet.seq_num = seq_num;
+    packet.video_header.frame_type = keyframe == kKeyFrame
                                           ? VideoFrameType::kVideoFrameKey
                                           : VideoFrameType::kVideoFrameDelta;
-    packet->video_header.is_first_packet_in_frame = first == kFirst;
-    packet->video_header.is_last_packet_in_frame = last == kLast;
-    packet->video_payload.SetData(data.data(), data.size());
+    packet.video_header.is_first_packet_in_frame = first == kFirst;
+    packet.video_header.is_last_packet_in_frame = last == kLast;
+    packet.video_payload.SetData(data.data(), data.size());
 
     return PacketBufferInsertResult(
         packet_buffer_.InsertPacket(std::move(packet)));
@@ -196,6 +196,26 @@ TEST_F(PacketBufferTest, FrameSize) {
   EXPECT_THAT(packets, SizeIs(4));
 }
 
+TEST_F(PacketBufferTest, ReturnedPacketsStayValidUntilNextInsertion) {
+  const uint16_t seq_num = Rand();
+  const uint8_t data1[] = {1, 2, 3};
+  const uint8_t data2[] = {4, 5};
+
+  Insert(seq_num, kKeyFrame, kFirst, kNotLast, data1);
+  auto packets =
+      Insert(seq_num + 1, kKeyFrame, kNotFirst, kLast, data2).packets;
+  ASSERT_THAT(packets, SizeIs(2));
+  // Clearing doesn't touch the packets that were handed out.
+  packet_buffer_.ClearTo(seq_num + 1);
+  EXPECT_EQ(packets[0]->video_payload, rtc::CopyOnWriteBuffer(data1));
+  EXPECT_EQ(packets[1]->video_payload, rtc::CopyOnWriteBuffer(data2));
+
+  // The slots are reused by later packets, a whole buffer later.
+  EXPECT_THAT(
+      Insert(seq_num + kStartSize, kKeyFrame, kFirst, kLast, data2).packets,
+      ElementsAre(packets[0]));
+}
+
 TEST_F(PacketBufferTest, ExpandBuffer) {
   const uint16_t seq_num = Rand();
 
@@ -399,12 +419,12 @@ class PacketBufferH264Test : public PacketBufferTest {
       rtc::ArrayView<const uint8_t> data = {},
       uint32_t width = 0,     // width of frame (SPS/IDR)
       uint32_t height = 0) {  // height of frame (SPS/IDR)
-    auto packet = std::make_unique<PacketBuffer::Packet>();
-    packet->video_header.codec = kVideoCodecH264;
+    PacketBuffer::Packet packet;
+    packet.video_header.codec = kVideoCodecH264;
     auto& h264_header =
-        packet->video_header.video_type_header.emplace<RTPVideoHeaderH264>();
-    packet->seq_num = seq_num;
-    packet->timestamp = timestamp;
+        packet.video_header.video_type_header.emplace<RTPVideoHeaderH264>();
+    packet.seq_num = seq_num;
+    packet.timestamp = timestamp;
     if (keyframe == kKeyFrame) {
       if (sps_pps_idr_is_keyframe_) {
         h264_header.nalus[0].type = H264::NaluType::kSps;
@@ -416,11 +436,11 @@ class PacketBufferH264Test : public PacketBufferTest {
         h264_header.nalus_length = 1;
       }
     }
-    packet->video_header.width = width;
-    packet->video_header.height = height;
-    packet->video_header.is_first_packet_in_frame = first == kFirst;
-    packet->video_header.is_last_packet_in_frame = last == kLast;
-    packet->video_payload.SetData(data.data(), data.size());
+    packet.video_header.width = width;
+    packet.video_header.height = height;
+    packet.video_header.is_first_packet_in_frame = first == kFirst;
+    packet.video_header.is_last_packet_in_frame = last == kLast;
+    packet.video_payload.SetData(data.data(), data.size());
 
     return PacketBufferInsertResult(
         packet_buffer_.InsertPacket(std::move(packet)));
@@ -435,12 +455,12 @@ class PacketBufferH264Test : public PacketBufferTest {
       rtc::ArrayView<const uint8_t> data = {},
       uint32_t width = 0,     // width of frame (SPS/IDR)
       uint32_t height = 0) {  // height of frame (SPS/IDR)
-    auto packet = std::make_unique<PacketBuffer::Packet>();
-    packet->video_header.codec = kVideoCodecH264;
+    PacketBuffer::Packet packet;
+    packet.video_header.codec = kVideoCodecH264;
     auto& h264_header =
-        packet->video_header.video_type_header.emplace<RTPVideoHeaderH264>();
-    packet->seq_num = seq_num;
-    packet->timestamp = timestamp;
+        packet.video_header.video_type_header.emplace<RTPVideoHeaderH264>();
+    packet.seq_num = seq_num;
+    packet.timestamp = timestamp;
 
     // this should be the start of frame.
     RTC_CHECK(first == kFirst);
@@ -448,8 +468,8 @@ class PacketBufferH264Test : public PacketBufferTest {
     // Insert a AUD NALU / packet without width/height.
     h264_header.nalus[0].type = H264::NaluType::kAud;
     h264_header.nalus_length = 1;
-    packet->video_header.is_first_packet_in_frame = true;
-    packet->video_header.is_last_packet_in_frame = false;
+    packet.video_header.is_first_packet_in_frame = true;
+    packet.video_header.is_last_packet_in_frame = false;
     IgnoreResult(packet_buffer_.InsertPacket(std::move(packet)));
     // insert IDR
     return InsertH264(seq_num + 1, keyframe, kNotFirst, last, timestamp, data,
@@ -509,17 +529,17 @@ TEST_P(PacketBufferH264ParameterizedTest, GetBitstreamBufferPadding) {
   uint16_t seq_num = Rand();
   rtc::CopyOnWriteBuffer data = "some plain old data";
 
-  auto packet = std::make_unique<PacketBuffer::Packet>();
+  PacketBuffer::Packet packet;
   auto& h264_header =
-      packet->video_header.video_type_header.emplace<RTPVideoHeaderH264>();
+      packet.video_header.video_type_header.emplace<RTPVideoHeaderH264>();
   h264_header.nalus_length = 1;
   h264_header.nalus[0].type = H264::NaluType::kIdr;
   h264_header.packetization_type = kH264SingleNalu;
-  packet->seq_num = seq_num;
-  packet->video_header.codec = kVideoCodecH264;
-  packet->video_payload = data;
-  packet->video_header.is_first_packet_in_frame = true;
-  packet->video_header.is_last_packet_in_frame = true;
+  packet.seq_num = seq_num;
+  packet.video_header.codec = kVideoCodecH264;
+  packet.video_payload = data;
+  packet.video_header.is_first_packet_in_frame = true;
+  packet.video_header.is_last_packet_in_frame = true;
   auto frames = packet_buffer_.InsertPacket(std::move(packet)).packets;
 
   ASSERT_THAT(frames, SizeIs(1));
@@ -612,52 +632,52 @@ TEST_F(PacketBufferTest, ContinuousSeqNumDoubleMarkerBit) {
 }
 
 TEST_F(PacketBufferTest, IncomingCodecChange) {
-  auto packet = std::make_unique<PacketBuffer::Packet>();
-  packet->video_header.is_first_packet_in_frame = true;
-  packet->video_header.is_last_packet_in_frame = true;
-  packet->video_header.codec = kVideoCodecVP8;
-  packet->video_header.video_type_header.emplace<RTPVideoHeaderVP8>();
-  packet->timestamp = 1;
-  packet->seq_num = 1;
-  packet->video_header.frame_type = VideoFrameType::kVideoFrameKey;
+  PacketBuffer::Packet packet;
+  packet.video_header.is_first_packet_in_frame = true;
+  packet.video_header.is_last_packet_in_frame = true;
+  packet.video_header.codec = kVideoCodecVP8;
+  packet.video_header.video_type_header.emplace<RTPVideoHeaderVP8>();
+  packet.timestamp = 1;
+  packet.seq_num = 1;
+  packet.video_header.frame_type = VideoFrameType::kVideoFrameKey;
   EXPECT_THAT(packet_buffer_.InsertPacket(std::move(packet)).packets,
               SizeIs(1));
 
-  packet = std::make_unique<PacketBuffer::Packet>();
-  packet->video_header.is_first_packet_in_frame = true;
-  packet->video_header.is_last_packet_in_frame = true;
-  packet->video_header.codec = kVideoCodecH264;
+  packet = PacketBuffer::Packet();
+  packet.video_header.is_first_packet_in_frame = true;
+  packet.video_header.is_last_packet_in_frame = true;
+  packet.video_header.codec = kVideoCodecH264;
   auto& h264_header =
-      packet->video_header.video_type_header.emplace<RTPVideoHeaderH264>();
+      packet.video_header.video_type_header.emplace<RTPVideoHeaderH264>();
   h264_header.nalus_length = 1;
-  packet->timestamp = 3;
-  packet->seq_num = 3;
-  packet->video_header.frame_type = VideoFrameType::kVideoFrameKey;
+  packet.timestamp = 3;
+  packet.seq_num = 3;
+  packet.video_header.frame_type = VideoFrameType::kVideoFrameKey;
   EXPECT_THAT(packet_buffer_.InsertPacket(std::move(packet)).packets,
               IsEmpty());
 
-  packet = std::make_unique<PacketBuffer::Packet>();
-  packet->video_header.is_first_packet_in_frame = true;
-  packet->video_header.is_last_packet_in_frame = true;
-  packet->video_header.codec = kVideoCodecVP8;
-  packet->video_header.video_type_header.emplace<RTPVideoHeaderVP8>();
-  packet->timestamp = 2;
-  packet->seq_num = 2;
-  packet->video_header.frame_type = VideoFrameType::kVideoFrameDelta;
+  packet = PacketBuffer::Packet();
+  packet.video_header.is_first_packet_in_frame = true;
+  packet.video_header.is_last_packet_in_frame = true;
+  packet.video_header.codec = kVideoCodecVP8;
+  packet.video_header.video_type_header.emplace<RTPVideoHeaderVP8>();
+  packet.timestamp = 2;
+  packet.seq_num = 2;
+  packet.video_header.frame_type = VideoFrameType::kVideoFrameDelta;
   EXPECT_THAT(packet_buffer_.InsertPacket(std::move(packet)).packets,
               SizeIs(2));
 }
 
 TEST_F(PacketBufferTest, TooManyNalusInPacket) {
-  auto packet = std::make_unique<PacketBuffer::Packet>();
-  packet->video_header.codec = kVideoCodecH264;
-  packet->timestamp = 1;
-  packet->seq_num = 1;
-  packet->video_header.frame_type = VideoFrameType::kVideoFrameKey;
-  packet->video_header.is_first_packet_in_frame = true;
-  packet->video_header.is_last_packet_in_frame = true;
+  PacketBuffer::Packet packet;
+  packet.video_header.codec = kVideoCodecH264;
+  packet.timestamp = 1;
+  packet.seq_num = 1;
+  packet.video_header.frame_type = VideoFrameType::kVideoFrameKey;
+  packet.video_header.is_first_packet_in_frame = true;
+  packet.video_header.is_last_packet_in_frame = true;
   auto& h264_header =
-      packet->video_header.video_type_header.emplace<RTPVideoHeaderH264>();
+      packet.video_header.video_type_header.emplace<RTPVideoHeaderH264>();
   h264_header.nalus_length = kMaxNalusPerPacket;
   EXPECT_THAT(packet_buffer_.InsertPacket(std::move(packet)).packets,
               IsEmpty());
@@ -719,13 +739,13 @@ class PacketBufferH264XIsKeyframeTest : public PacketBufferH264Test {
   explicit PacketBufferH264XIsKeyframeTest(bool sps_pps_idr_is_keyframe)
       : PacketBufferH264Test(sps_pps_idr_is_keyframe) {}
 
-  std::unique_ptr<PacketBuffer::Packet> CreatePacket() {
-    auto packet = std::make_unique<PacketBuffer::Packet>();
-    packet->video_header.codec = kVideoCodecH264;
-    packet->seq_num = kSeqNum;
+  PacketBuffer::Packet CreatePacket() {
+    PacketBuffer::Packet packet;
+    packet.video_header.codec = kVideoCodecH264;
+    packet.seq_num = kSeqNum;
 
-    packet->video_header.is_first_packet_in_frame = true;
-    packet->video_header.is_last_packet_in_frame = true;
+    packet.video_header.is_first_packet_in_frame = true;
+    packet.video_header.is_last_packet_in_frame = true;
     return packet;
   }
 };
@@ -740,7 +760,7 @@ class PacketBufferH264IdrIsKeyframeTest
 TEST_F(PacketBufferH264IdrIsKeyframeTest, IdrIsKeyframe) {
   auto packet = CreatePacket();
   auto& h264_header =
-      packet->video_header.video_type_header.emplace<RTPVideoHeaderH264>();
+      packet.video_header.video_type_header.emplace<RTPVideoHeaderH264>();
   h264_header.nalus[0].type = H264::NaluType::kIdr;
   h264_header.nalus_length = 1;
   EXPECT_THAT(packet_buffer_.InsertPacket(std::move(packet)).packets,
@@ -750,7 +770,7 @@ TEST_F(PacketBufferH264IdrIsKeyframeTest, IdrIsKeyframe) {
 TEST_F(PacketBufferH264IdrIsKeyframeTest, SpsPpsIdrIsKeyframe) {
   auto packet = CreatePacket();
   auto& h264_header =
-      packet->video_header.video_type_header.emplace<RTPVideoHeaderH264>();
+      packet.video_header.video_type_header.emplace<RTPVideoHeaderH264>();
   h264_header.nalus[0].type = H264::NaluType::kSps;
   h264_header.nalus[1].type = H264::NaluType::kPps;
   h264_header.nalus[2].type = H264::NaluType::kIdr;
@@ -770,7 +790,7 @@ class PacketBufferH264SpsPpsIdrIsKeyframeTest
 TEST_F(PacketBufferH264SpsPpsIdrIsKeyframeTest, IdrIsNotKeyframe) {
   auto packet = CreatePacket();
   auto& h264_header =
-      packet->video_header.video_type_header.emplace<RTPVideoHeaderH264>();
+      packet.video_header.video_type_header.emplace<RTPVideoHeaderH264>();
   h264_header.nalus[0].type = H264::NaluType::kIdr;
   h264_header.nalus_length = 1;
 
@@ -781,7 +801,7 @@ TEST_F(PacketBufferH264SpsPpsIdrIsKeyframeTest, IdrIsNotKeyframe) {
 TEST_F(PacketBufferH264SpsPpsIdrIsKeyframeTest, SpsPpsIsNotKeyframe) {
   auto packet = CreatePacket();
   auto& h264_header =
-      packet->video_header.video_type_header.emplace<RTPVideoHeaderH264>();
+      packet.video_header.video_type_header.emplace<RTPVideoHeaderH264>();
   h264_header.nalus[0].type = H264::NaluType::kSps;
   h264_header.nalus[1].type = H264::NaluType::kPps;
   h264_header.nalus_length = 2;
@@ -793,7 +813,7 @@ TEST_F(PacketBufferH264SpsPpsIdrIsKeyframeTest, SpsPpsIsNotKeyframe) {
 TEST_F(PacketBufferH264SpsPpsIdrIsKeyframeTest, SpsPpsIdrIsKeyframe) {
   auto packet = CreatePacket();
   auto& h264_header =
-      packet->video_header.video_type_header.emplace<RTPVideoHeaderH264>();
+      packet.video_header.video_type_header.emplace<RTPVideoHeaderH264>();
   h264_header.nalus[0].type = H264::NaluType::kSps;
   h264_header.nalus[1].type = H264::NaluType::kPps;
   h264_header.nalus[2].type = H264::NaluType::kIdr;
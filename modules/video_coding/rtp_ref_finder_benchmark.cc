@@ -0,0 +1,155 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/video/encoded_image.h"
+#include "benchmark/benchmark.h"
+#include "modules/rtp_rtcp/source/rtp_video_header.h"
+#include "modules/video_coding/codecs/interface/common_constants.h"
+#include "modules/video_coding/codecs/vp9/include/vp9_globals.h"
+#include "modules/video_coding/frame_object.h"
+#include "modules/video_coding/rtp_frame_reference_finder.h"
+#include "modules/video_coding/rtp_vp8_ref_finder.h"
+#include "modules/video_coding/rtp_vp9_ref_finder.h"
+
+namespace webrtc {
+namespace {
+
+// Frames managed per benchmark iteration, created before timing starts.
+constexpr int kFramesPerBurst = 1024;
+// Temporal indices of a stream with three temporal layers.
+constexpr uint8_t kTemporalIdx[] = {0, 2, 1, 2};
+
+std::unique_ptr<RtpFrameObject> CreateFrame(int picture_id,
+                                            const RTPVideoHeader& header,
+                                            VideoCodecType codec) {
+  // clang-format off
+  return std::make_unique<RtpFrameObject>(
+      /*seq_num_start=*/static_cast<uint16_t>(picture_id),
+      /*seq_num_end=*/static_cast<uint16_t>(picture_id),
+      /*markerBit=*/true,
+      /*times_nacked=*/0,
+      /*first_packet_received_time=*/0,
+      /*last_packet_received_time=*/0,
+      /*rtp_timestamp=*/0,
+      /*ntp_time_ms=*/0,
+      VideoSendTiming(),
+      /*payload_type=*/0,
+      codec,
+      kVideoRotation_0,
+      VideoContentType::UNSPECIFIED,
+      header,
+      /*color_space=*/absl::nullopt,
+      RtpPacketInfos(),
+      EncodedImageBuffer::Create(/*size=*/0));
+  // clang-format on
+}
+
+std::unique_ptr<RtpFrameObject> CreateVp8Frame(int picture_id) {
+  RTPVideoHeaderVP8 vp8_header{};
+  vp8_header.pictureId = picture_id & 0x7FFF;
+  vp8_header.temporalIdx = kTemporalIdx[picture_id % 4];
+  vp8_header.tl0PicIdx = (picture_id / 4) & 0xFF;
+  // The first frames of the upper layers only reference the base layer.
+  vp8_header.layerSync = picture_id == 1 || picture_id == 2;
+
+  RTPVideoHeader header;
+  header.frame_type = picture_id == 0 ? VideoFrameType::kVideoFrameKey
+                                      : VideoFrameType::kVideoFrameDelta;
+  header.video_type_header = vp8_header;
+  return CreateFrame(picture_id, header, kVideoCodecVP8);
+}
+
+std::unique_ptr<RtpFrameObject> CreateVp9Frame(int picture_id) {
+  RTPVideoHeaderVP9 vp9_header{};
+  vp9_header.InitRTPVideoHeaderVP9();
+  vp9_header.picture_id = picture_id & 0x7FFF;
+  vp9_header.temporal_idx = kTemporalIdx[picture_id % 4];
+  vp9_header.spatial_idx = 0;
+  vp9_header.tl0_pic_idx = (picture_id / 4) & 0xFF;
+  vp9_header.temporal_up_switch = vp9_header.temporal_idx != 0;
+  vp9_header.inter_pic_predicted = picture_id != 0;
+  if (picture_id == 0) {
+    vp9_header.ss_data_available = true;
+    vp9_header.gof.SetGofInfoVP9(kTemporalStructureMode3);
+  }
+
+  RTPVideoHeader header;
+  header.frame_type = picture_id == 0 ? VideoFrameType::kVideoFrameKey
+                                      : VideoFrameType::kVideoFrameDelta;
+  header.video_type_header = vp9_header;
+  return CreateFrame(picture_id, header, kVideoCodecVP9);
+}
+
+// Returns the next `kFramesPerBurst` frames of the stream, where every group
+// of `reorder` frames is received in reverse order. So all but the last frame
+// received of a group must be stashed until the group is complete.
+template <typename CreateFrameFunc>
+std::vector<std::unique_ptr<RtpFrameObject>> CreateReorderedBurst(
+    int reorder,
+    int* next_picture_id,
+    CreateFrameFunc create_frame) {
+  std::vector<std::unique_ptr<RtpFrameObject>> frames;
+  frames.reserve(kFramesPerBurst);
+  for (int i = 0; i < kFramesPerBurst; ++i) {
+    frames.push_back(create_frame((*next_picture_id)++));
+  }
+  for (auto it = frames.begin(); it != frames.end();) {
+    auto group_end = it + std::min<int>(reorder, frames.end() - it);
+    std::reverse(it, group_end);
+    it = group_end;
+  }
+  return frames;
+}
+
+template <typename RefFinder, typename CreateFrameFunc>
+void RunReorderedStream(benchmark::State& state,
+                        CreateFrameFunc create_frame) {
+  const int reorder = state.range(0);
+  RefFinder ref_finder;
+  int next_picture_id = 0;
+  std::vector<RtpFrameReferenceFinder::ReturnVector> handed_off;
+  handed_off.reserve(kFramesPerBurst);
+  for (auto s : state) {
+    state.PauseTiming();
+    // Frames are created and destroyed outside of the timing, so that only
+    // the reference finding is measured.
+    handed_off.clear();
+    std::vector<std::unique_ptr<RtpFrameObject>> frames =
+        CreateReorderedBurst(reorder, &next_picture_id, create_frame);
+    state.ResumeTiming();
+    for (auto& frame : frames) {
+      handed_off.push_back(ref_finder.ManageFrame(std::move(frame)));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kFramesPerBurst);
+}
+
+void BM_Vp8ReorderedFrames(benchmark::State& state) {
+  RunReorderedStream<RtpVp8RefFinder>(state, CreateVp8Frame);
+}
+
+void BM_Vp9ReorderedFrames(benchmark::State& state) {
+  RunReorderedStream<RtpVp9RefFinder>(state, CreateVp9Frame);
+}
+
+// {frames received in reverse order}.
+BENCHMARK(BM_Vp8ReorderedFrames)->ArgName("reorder")->Arg(1)->Arg(4)->Arg(32);
+BENCHMARK(BM_Vp9ReorderedFrames)->ArgName("reorder")->Arg(1)->Arg(4)->Arg(32);
+
+}  // namespace
+}  // namespace webrtc
@@ -10,6 +10,7 @@
 
 #include "modules/video_coding/rtp_vp8_ref_finder.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "rtc_base/logging.h"
@@ -57,9 +58,7 @@ RtpVp8RefFinder::FrameDecision RtpVp8RefFinder::ManageFrameInternal(
   // Clean up info about not yet received frames that are too old.
   uint16_t old_picture_id =
       Subtract<kFrameIdLength>(frame->Id(), kMaxNotYetReceivedFrames);
-  auto clean_frames_to = not_yet_received_frames_.lower_bound(old_picture_id);
-  not_yet_received_frames_.erase(not_yet_received_frames_.begin(),
-                                 clean_frames_to);
+  ClearNotYetReceivedBefore(old_picture_id);
   // Avoid re-adding picture ids that were just erased.
   if (AheadOf<uint16_t, kFrameIdLength>(old_picture_id, last_picture_id_)) {
     last_picture_id_ = old_picture_id;
@@ -69,42 +68,41 @@ RtpVp8RefFinder::FrameDecision RtpVp8RefFinder::ManageFrameInternal(
   if (AheadOf<uint16_t, kFrameIdLength>(frame->Id(), last_picture_id_)) {
     do {
       last_picture_id_ = Add<kFrameIdLength>(last_picture_id_, 1);
-      not_yet_received_frames_.insert(last_picture_id_);
+      not_yet_received_frames_.set(last_picture_id_ % kNotYetReceivedSize);
     } while (last_picture_id_ != frame->Id());
   }
 
   int64_t unwrapped_tl0 = tl0_unwrapper_.Unwrap(codec_header.tl0PicIdx & 0xFF);
 
   // Clean up info for base layers that are too old.
-  int64_t old_tl0_pic_idx = unwrapped_tl0 - kMaxLayerInfo;
-  auto clean_layer_info_to = layer_info_.lower_bound(old_tl0_pic_idx);
-  layer_info_.erase(layer_info_.begin(), clean_layer_info_to);
+  ClearLayerInfoBefore(unwrapped_tl0 - kMaxLayerInfo);
 
   if (frame->frame_type() == VideoFrameType::kVideoFrameKey) {
     if (codec_header.temporalIdx != 0) {
       return kDrop;
     }
     frame->num_references = 0;
-    layer_info_[unwrapped_tl0].fill(-1);
+    std::array<int64_t, kMaxTemporalLayers> no_frames;
+    no_frames.fill(-1);
+    EmplaceLayerInfo(unwrapped_tl0, no_frames)->last_picture_id = no_frames;
     UpdateLayerInfoVp8(frame, unwrapped_tl0, codec_header.temporalIdx);
     return kHandOff;
   }
 
-  auto layer_info_it = layer_info_.find(
+  LayerInfo* layer_info = FindLayerInfo(
       codec_header.temporalIdx == 0 ? unwrapped_tl0 - 1 : unwrapped_tl0);
 
   // If we don't have the base layer frame yet, stash this frame.
-  if (layer_info_it == layer_info_.end())
+  if (!layer_info)
     return kStash;
 
   // A non keyframe base layer frame has been received, copy the layer info
   // from the previous base layer frame and set a reference to the previous
   // base layer frame.
   if (codec_header.temporalIdx == 0) {
-    layer_info_it =
-        layer_info_.emplace(unwrapped_tl0, layer_info_it->second).first;
+    layer_info = EmplaceLayerInfo(unwrapped_tl0, layer_info->last_picture_id);
     frame->num_references = 1;
-    int64_t last_pid_on_layer = layer_info_it->second[0];
+    int64_t last_pid_on_layer = layer_info->last_picture_id[0];
 
     // Is this an old frame that has already been used to update the state? If
     // so, drop it.
@@ -120,7 +118,8 @@ RtpVp8RefFinder::FrameDecision RtpVp8RefFinder::ManageFrameInternal(
   // Layer sync frame, this frame only references its base layer frame.
   if (codec_header.layerSync) {
     frame->num_references = 1;
-    int64_t last_pid_on_layer = layer_info_it->second[codec_header.temporalIdx];
+    int64_t last_pid_on_layer =
+        layer_info->last_picture_id[codec_header.temporalIdx];
 
     // Is this an old frame that has already been used to update the state? If
     // so, drop it.
@@ -129,7 +128,7 @@ RtpVp8RefFinder::FrameDecision RtpVp8RefFinder::ManageFrameInternal(
       return kDrop;
     }
 
-    frame->references[0] = layer_info_it->second[0];
+    frame->references[0] = layer_info->last_picture_id[0];
     UpdateLayerInfoVp8(frame, unwrapped_tl0, codec_header.temporalIdx);
     return kHandOff;
   }
@@ -139,29 +138,24 @@ RtpVp8RefFinder::FrameDecision RtpVp8RefFinder::ManageFrameInternal(
   for (uint8_t layer = 0; layer <= codec_header.temporalIdx; ++layer) {
     // If we have not yet received a previous frame on this temporal layer,
     // stash this frame.
-    if (layer_info_it->second[layer] == -1)
+    const int64_t last_pid_on_layer = layer_info->last_picture_id[layer];
+    if (last_pid_on_layer == -1)
       return kStash;
 
     // If the last frame on this layer is ahead of this frame it means that
     // a layer sync frame has been received after this frame for the same
     // base layer frame, drop this frame.
-    if (AheadOf<uint16_t, kFrameIdLength>(layer_info_it->second[layer],
-                                          frame->Id())) {
+    if (AheadOf<uint16_t, kFrameIdLength>(last_pid_on_layer, frame->Id())) {
       return kDrop;
     }
 
     // If we have not yet received a frame between this frame and the referenced
     // frame then we have to wait for that frame to be completed first.
-    auto not_received_frame_it =
-        not_yet_received_frames_.upper_bound(layer_info_it->second[layer]);
-    if (not_received_frame_it != not_yet_received_frames_.end() &&
-        AheadOf<uint16_t, kFrameIdLength>(frame->Id(),
-                                          *not_received_frame_it)) {
+    if (NotYetReceivedBetween(last_pid_on_layer, frame->Id())) {
       return kStash;
     }
 
-    if (!(AheadOf<uint16_t, kFrameIdLength>(frame->Id(),
-                                            layer_info_it->second[layer]))) {
+    if (!(AheadOf<uint16_t, kFrameIdLength>(frame->Id(), last_pid_on_layer))) {
       RTC_LOG(LS_WARNING) << "Frame with picture id " << frame->Id()
                           << " and packet range [" << frame->first_seq_num()
                           << ", " << frame->last_seq_num()
@@ -171,7 +165,7 @@ RtpVp8RefFinder::FrameDecision RtpVp8RefFinder::ManageFrameInternal(
     }
 
     ++frame->num_references;
-    frame->references[layer] = layer_info_it->second[layer];
+    frame->references[layer] = last_pid_on_layer;
   }
 
   UpdateLayerInfoVp8(frame, unwrapped_tl0, codec_header.temporalIdx);
@@ -181,27 +175,105 @@ RtpVp8RefFinder::FrameDecision RtpVp8RefFinder::ManageFrameInternal(
 void RtpVp8RefFinder::UpdateLayerInfoVp8(RtpFrameObject* frame,
                                          int64_t unwrapped_tl0,
                                          uint8_t temporal_idx) {
-  auto layer_info_it = layer_info_.find(unwrapped_tl0);
+  LayerInfo* layer_info = FindLayerInfo(unwrapped_tl0);
 
   // Update this layer info and newer.
-  while (layer_info_it != layer_info_.end()) {
-    if (layer_info_it->second[temporal_idx] != -1 &&
-        AheadOf<uint16_t, kFrameIdLength>(layer_info_it->second[temporal_idx],
-                                          frame->Id())) {
+  while (layer_info) {
+    int64_t& last_pid_on_layer = layer_info->last_picture_id[temporal_idx];
+    if (last_pid_on_layer != -1 &&
+        AheadOf<uint16_t, kFrameIdLength>(last_pid_on_layer, frame->Id())) {
       // The frame was not newer, then no subsequent layer info have to be
       // update.
       break;
     }
 
-    layer_info_it->second[temporal_idx] = frame->Id();
+    last_pid_on_layer = frame->Id();
     ++unwrapped_tl0;
-    layer_info_it = layer_info_.find(unwrapped_tl0);
+    layer_info = FindLayerInfo(unwrapped_tl0);
   }
-  not_yet_received_frames_.erase(frame->Id());
+  EraseNotYetReceived(frame->Id());
 
   UnwrapPictureIds(frame);
 }
 
+RtpVp8RefFinder::LayerInfo* RtpVp8RefFinder::FindLayerInfo(
+    int64_t unwrapped_tl0) {
+  LayerInfo& info = layer_info_[unwrapped_tl0 & (kLayerInfoSize - 1)];
+  return info.valid && info.unwrapped_tl0 == unwrapped_tl0 ? &info : nullptr;
+}
+
+RtpVp8RefFinder::LayerInfo* RtpVp8RefFinder::EmplaceLayerInfo(
+    int64_t unwrapped_tl0,
+    const std::array<int64_t, kMaxTemporalLayers>& last_picture_id) {
+  LayerInfo& info = layer_info_[unwrapped_tl0 & (kLayerInfoSize - 1)];
+  // A slot still holding an older Tl0 picture index is only reused after
+  // heavy reordering of the base layer. Then the oldest info is dropped.
+  if (!info.valid || info.unwrapped_tl0 != unwrapped_tl0) {
+    info.valid = true;
+    info.unwrapped_tl0 = unwrapped_tl0;
+    info.last_picture_id = last_picture_id;
+    oldest_layer_info_tl0_ = std::min(oldest_layer_info_tl0_, unwrapped_tl0);
+  }
+  return &info;
+}
+
+void RtpVp8RefFinder::ClearLayerInfoBefore(int64_t unwrapped_tl0) {
+  if (unwrapped_tl0 <= oldest_layer_info_tl0_)
+    return;
+  if (unwrapped_tl0 - oldest_layer_info_tl0_ >= kLayerInfoSize) {
+    for (LayerInfo& info : layer_info_) {
+      if (info.unwrapped_tl0 < unwrapped_tl0)
+        info.valid = false;
+    }
+  } else {
+    for (int64_t tl0 = oldest_layer_info_tl0_; tl0 < unwrapped_tl0; ++tl0) {
+      LayerInfo& info = layer_info_[tl0 & (kLayerInfoSize - 1)];
+      if (info.unwrapped_tl0 == tl0)
+        info.valid = false;
+    }
+  }
+  oldest_layer_info_tl0_ = unwrapped_tl0;
+}
+
+void RtpVp8RefFinder::ClearNotYetReceivedBefore(uint16_t picture_id) {
+  if (not_yet_received_frames_.none())
+    return;
+  if (AheadOf<uint16_t, kFrameIdLength>(picture_id, last_picture_id_)) {
+    not_yet_received_frames_.reset();
+    return;
+  }
+  // Only the frames in the window that ends at `last_picture_id_` may be set.
+  for (uint16_t id = Subtract<kFrameIdLength>(last_picture_id_,
+                                              kNotYetReceivedSize - 1);
+       AheadOf<uint16_t, kFrameIdLength>(picture_id, id);
+       id = Add<kFrameIdLength>(id, 1)) {
+    not_yet_received_frames_.reset(id % kNotYetReceivedSize);
+  }
+}
+
+void RtpVp8RefFinder::EraseNotYetReceived(uint16_t picture_id) {
+  if (ForwardDiff<uint16_t, kFrameIdLength>(picture_id, last_picture_id_) <
+      kNotYetReceivedSize) {
+    not_yet_received_frames_.reset(picture_id % kNotYetReceivedSize);
+  }
+}
+
+bool RtpVp8RefFinder::NotYetReceivedBetween(uint16_t from, uint16_t to) const {
+  if (not_yet_received_frames_.none())
+    return false;
+  uint16_t id =
+      Subtract<kFrameIdLength>(last_picture_id_, kNotYetReceivedSize - 1);
+  if (AheadOf<uint16_t, kFrameIdLength>(from, id))
+    id = Add<kFrameIdLength>(from, 1);
+  for (; AheadOf<uint16_t, kFrameIdLength>(to, id) &&
+         AheadOrAt<uint16_t, kFrameIdLength>(last_picture_id_, id);
+       id = Add<kFrameIdLength>(id, 1)) {
+    if (not_yet_received_frames_[id % kNotYetReceivedSize])
+      return true;
+  }
+  return false;
+}
+
 void RtpVp8RefFinder::RetryStashedFrames(
     RtpFrameReferenceFinder::ReturnVector& res) {
   bool complete_frame = false;
@@ -11,10 +11,11 @@
 #ifndef MODULES_VIDEO_CODING_RTP_VP8_REF_FINDER_H_
 #define MODULES_VIDEO_CODING_RTP_VP8_REF_FINDER_H_
 
+#include <array>
+#include <bitset>
 #include <deque>
-#include <map>
+#include <limits>
 #include <memory>
-#include <set>
 
 #include "absl/container/inlined_vector.h"
 #include "modules/video_coding/frame_object.h"
@@ -37,9 +38,21 @@ class RtpVp8RefFinder {
   static constexpr int kMaxNotYetReceivedFrames = 100;
   static constexpr int kMaxStashedFrames = 100;
   static constexpr int kMaxTemporalLayers = 5;
+  // Sizes of the ring buffers below. Larger than the number of entries that
+  // are kept, so that the live entries never share a slot.
+  static constexpr int kLayerInfoSize = 64;
+  static constexpr int kNotYetReceivedSize = 128;
+  static_assert(kLayerInfoSize > kMaxLayerInfo, "");
+  static_assert(kNotYetReceivedSize > kMaxNotYetReceivedFrames, "");
 
   enum FrameDecision { kStash, kHandOff, kDrop };
 
+  struct LayerInfo {
+    bool valid = false;
+    int64_t unwrapped_tl0 = 0;
+    std::array<int64_t, kMaxTemporalLayers> last_picture_id;
+  };
+
   FrameDecision ManageFrameInternal(RtpFrameObject* frame);
   void RetryStashedFrames(RtpFrameReferenceFinder::ReturnVector& res);
   void UpdateLayerInfoVp8(RtpFrameObject* frame,
@@ -47,22 +60,40 @@ class RtpVp8RefFinder {
                           uint8_t temporal_idx);
   void UnwrapPictureIds(RtpFrameObject* frame);
 
+  LayerInfo* FindLayerInfo(int64_t unwrapped_tl0);
+  // Returns the layer info of `unwrapped_tl0`, which is initialized with
+  // `last_picture_id` if it doesn't exist.
+  LayerInfo* EmplaceLayerInfo(
+      int64_t unwrapped_tl0,
+      const std::array<int64_t, kMaxTemporalLayers>& last_picture_id);
+  void ClearLayerInfoBefore(int64_t unwrapped_tl0);
+
+  // Forgets the not yet received frames older than `picture_id`.
+  void ClearNotYetReceivedBefore(uint16_t picture_id);
+  void EraseNotYetReceived(uint16_t picture_id);
+  // Whether a frame newer than `from` and older than `to` is not yet received.
+  bool NotYetReceivedBetween(uint16_t from, uint16_t to) const;
+
   // Save the last picture id in order to detect when there is a gap in frames
   // that have not yet been fully received.
   int last_picture_id_ = -1;
 
   // Frames earlier than the last received frame that have not yet been
-  // fully received.
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t, kFrameIdLength>>
-      not_yet_received_frames_;
+  // fully received, indexed by picture id modulo `kNotYetReceivedSize`. Only
+  // frames in the window of `kNotYetReceivedSize` picture ids that ends at
+  // `last_picture_id_` are set.
+  std::bitset<kNotYetReceivedSize> not_yet_received_frames_;
 
   // Frames that have been fully received but didn't have all the information
   // needed to determine their references.
   std::deque<std::unique_ptr<RtpFrameObject>> stashed_frames_;
 
   // Holds the information about the last completed frame for a given temporal
-  // layer given an unwrapped Tl0 picture index.
-  std::map<int64_t, std::array<int64_t, kMaxTemporalLayers>> layer_info_;
+  // layer given an unwrapped Tl0 picture index, indexed by the unwrapped Tl0
+  // picture index modulo `kLayerInfoSize`.
+  std::array<LayerInfo, kLayerInfoSize> layer_info_;
+  // No layer info is older than this Tl0 picture index.
+  int64_t oldest_layer_info_tl0_ = std::numeric_limits<int64_t>::max();
 
   // Unwrapper used to unwrap VP8/VP9 streams which have their picture id
   // specified.
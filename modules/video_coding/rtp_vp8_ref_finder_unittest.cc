@@ -357,4 +357,32 @@ TEST_F(RtpVp8RefFinderTest, Vp8DetectMissingFrame_0212) {
   EXPECT_THAT(frames_, HasFrameWithIdAndRefs(8, {5, 6, 7}));
 }
 
+TEST_F(RtpVp8RefFinderTest, Vp8ReorderedAcrossPictureIdWrap_0212) {
+  constexpr int kTid[] = {0, 2, 1, 2};
+  constexpr int kFirstPid = (1 << 15) - 40;
+  constexpr int kNumFrames = 200;
+  // Every group of four frames is received in reverse order, while both the
+  // picture id and the Tl0 picture index wrap.
+  for (int group = 0; group < kNumFrames; group += 4) {
+    for (int i = group + 3; i >= group; --i) {
+      Insert(Frame()
+                 .Pid((kFirstPid + i) & 0x7FFF)
+                 .Tid(kTid[i % 4])
+                 .Tl0((250 + i / 4) & 0xFF)
+                 .AsKeyFrame(i == 0)
+                 .AsSync(i == 1 || i == 2));
+    }
+  }
+
+  EXPECT_THAT(frames_, SizeIs(kNumFrames));
+  EXPECT_THAT(frames_,
+              HasFrameWithIdAndRefs(kFirstPid + 100, {kFirstPid + 96}));
+  EXPECT_THAT(frames_, HasFrameWithIdAndRefs(
+                           kFirstPid + 102, {kFirstPid + 98, kFirstPid + 100}));
+  EXPECT_THAT(frames_,
+              HasFrameWithIdAndRefs(kFirstPid + 103, {kFirstPid + 100,
+                                                      kFirstPid + 101,
+                                                      kFirstPid + 102}));
+}
+
 }  // namespace webrtc
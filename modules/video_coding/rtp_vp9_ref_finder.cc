@@ -104,17 +104,15 @@ RtpVp9RefFinder::FrameDecision RtpVp9RefFinder::ManageFrameInternal(
       current_ss_idx_ = Add<kMaxGofSaved>(current_ss_idx_, 1);
       scalability_structures_[current_ss_idx_] = gof;
       scalability_structures_[current_ss_idx_].pid_start = frame->Id();
-      gof_info_.emplace(
+      EmplaceGofInfo(
           unwrapped_tl0,
           GofInfo(&scalability_structures_[current_ss_idx_], frame->Id()));
     }
 
-    const auto gof_info_it = gof_info_.find(unwrapped_tl0);
-    if (gof_info_it == gof_info_.end())
+    info = FindGofInfo(unwrapped_tl0);
+    if (!info)
       return kStash;
 
-    info = &gof_info_it->second;
-
     if (frame->frame_type() == VideoFrameType::kVideoFrameKey) {
       frame->num_references = 0;
       FrameReceivedVp9(frame->Id(), info);
@@ -126,38 +124,29 @@ RtpVp9RefFinder::FrameDecision RtpVp9RefFinder::ManageFrameInternal(
       RTC_LOG(LS_WARNING) << "Received keyframe without scalability structure";
       return kDrop;
     }
-    const auto gof_info_it = gof_info_.find(unwrapped_tl0);
-    if (gof_info_it == gof_info_.end())
+    info = FindGofInfo(unwrapped_tl0);
+    if (!info)
       return kStash;
 
-    info = &gof_info_it->second;
-
     frame->num_references = 0;
     FrameReceivedVp9(frame->Id(), info);
     FlattenFrameIdAndRefs(frame, codec_header.inter_layer_predicted);
     return kHandOff;
   } else {
-    auto gof_info_it = gof_info_.find(
-        (codec_header.temporal_idx == 0) ? unwrapped_tl0 - 1 : unwrapped_tl0);
+    info = FindGofInfo((codec_header.temporal_idx == 0) ? unwrapped_tl0 - 1
+                                                         : unwrapped_tl0);
 
     // Gof info for this frame is not available yet, stash this frame.
-    if (gof_info_it == gof_info_.end())
+    if (!info)
       return kStash;
 
     if (codec_header.temporal_idx == 0) {
-      gof_info_it = gof_info_
-                        .emplace(unwrapped_tl0,
-                                 GofInfo(gof_info_it->second.gof, frame->Id()))
-                        .first;
+      info = EmplaceGofInfo(unwrapped_tl0, GofInfo(info->gof, frame->Id()));
     }
-
-    info = &gof_info_it->second;
   }
 
   // Clean up info for base layers that are too old.
-  int64_t old_tl0_pic_idx = unwrapped_tl0 - kMaxGofSaved;
-  auto clean_gof_info_to = gof_info_.lower_bound(old_tl0_pic_idx);
-  gof_info_.erase(gof_info_.begin(), clean_gof_info_to);
+  ClearGofInfoBefore(unwrapped_tl0 - kMaxGofSaved);
 
   FrameReceivedVp9(frame->Id(), info);
 
@@ -167,12 +156,10 @@ RtpVp9RefFinder::FrameDecision RtpVp9RefFinder::ManageFrameInternal(
     return kStash;
 
   if (codec_header.temporal_up_switch)
-    up_switch_.emplace(frame->Id(), codec_header.temporal_idx);
+    AddUpSwitch(frame->Id(), codec_header.temporal_idx);
 
   // Clean out old info about up switch frames.
-  uint16_t old_picture_id = Subtract<kFrameIdLength>(frame->Id(), 50);
-  auto up_switch_erase_to = up_switch_.lower_bound(old_picture_id);
-  up_switch_.erase(up_switch_.begin(), up_switch_erase_to);
+  ClearUpSwitchBefore(Subtract<kFrameIdLength>(frame->Id(), kMaxUpSwitchAge));
 
   size_t diff =
       ForwardDiff<uint16_t, kFrameIdLength>(info->gof->pid_start, frame->Id());
@@ -226,10 +213,11 @@ bool RtpVp9RefFinder::MissingRequiredFrameVp9(uint16_t picture_id,
     uint16_t ref_pid =
         Subtract<kFrameIdLength>(picture_id, info.gof->pid_diff[gof_idx][i]);
     for (size_t l = 0; l < temporal_idx; ++l) {
-      auto missing_frame_it = missing_frames_for_layer_[l].lower_bound(ref_pid);
-      if (missing_frame_it != missing_frames_for_layer_[l].end() &&
-          AheadOf<uint16_t, kFrameIdLength>(picture_id, *missing_frame_it)) {
-        return true;
+      for (uint16_t pid = ref_pid;
+           AheadOf<uint16_t, kFrameIdLength>(picture_id, pid);
+           pid = Add<kFrameIdLength>(pid, 1)) {
+        if (missing_frames_for_layer_[l][pid])
+          return true;
       }
     }
   }
@@ -261,7 +249,7 @@ void RtpVp9RefFinder::FrameReceivedVp9(uint16_t picture_id, GofInfo* info) {
         return;
       }
 
-      missing_frames_for_layer_[temporal_idx].insert(last_picture_id);
+      missing_frames_for_layer_[temporal_idx].set(last_picture_id);
       last_picture_id = Add<kFrameIdLength>(last_picture_id, 1);
     }
 
@@ -280,24 +268,103 @@ void RtpVp9RefFinder::FrameReceivedVp9(uint16_t picture_id, GofInfo* info) {
       return;
     }
 
-    missing_frames_for_layer_[temporal_idx].erase(picture_id);
+    missing_frames_for_layer_[temporal_idx].reset(picture_id);
   }
 }
 
 bool RtpVp9RefFinder::UpSwitchInIntervalVp9(uint16_t picture_id,
                                             uint8_t temporal_idx,
                                             uint16_t pid_ref) {
-  for (auto up_switch_it = up_switch_.upper_bound(pid_ref);
-       up_switch_it != up_switch_.end() &&
-       AheadOf<uint16_t, kFrameIdLength>(picture_id, up_switch_it->first);
-       ++up_switch_it) {
-    if (up_switch_it->second < temporal_idx)
+  for (uint16_t pid = Add<kFrameIdLength>(pid_ref, 1);
+       AheadOf<uint16_t, kFrameIdLength>(picture_id, pid);
+       pid = Add<kFrameIdLength>(pid, 1)) {
+    const UpSwitch& up_switch = up_switch_[pid % kUpSwitchSize];
+    if (up_switch.valid && up_switch.picture_id == pid &&
+        up_switch.temporal_idx < temporal_idx) {
       return true;
+    }
   }
 
   return false;
 }
 
+void RtpVp9RefFinder::AddUpSwitch(uint16_t picture_id, uint8_t temporal_idx) {
+  UpSwitch& up_switch = up_switch_[picture_id % kUpSwitchSize];
+  if (up_switch.valid && up_switch.picture_id == picture_id)
+    return;
+  up_switch.valid = true;
+  up_switch.picture_id = picture_id;
+  up_switch.temporal_idx = temporal_idx;
+  if (oldest_up_switch_ &&
+      AheadOf<uint16_t, kFrameIdLength>(*oldest_up_switch_, picture_id)) {
+    oldest_up_switch_ = picture_id;
+  }
+}
+
+void RtpVp9RefFinder::ClearUpSwitchBefore(uint16_t picture_id) {
+  if (oldest_up_switch_ &&
+      AheadOf<uint16_t, kFrameIdLength>(picture_id, *oldest_up_switch_)) {
+    uint16_t num_cleared =
+        ForwardDiff<uint16_t, kFrameIdLength>(*oldest_up_switch_, picture_id);
+    if (num_cleared >= kUpSwitchSize) {
+      for (UpSwitch& up_switch : up_switch_) {
+        if (AheadOf<uint16_t, kFrameIdLength>(picture_id, up_switch.picture_id))
+          up_switch.valid = false;
+      }
+    } else {
+      for (uint16_t i = 0; i < num_cleared; ++i) {
+        uint16_t pid = Add<kFrameIdLength>(*oldest_up_switch_, i);
+        UpSwitch& up_switch = up_switch_[pid % kUpSwitchSize];
+        if (up_switch.picture_id == pid)
+          up_switch.valid = false;
+      }
+    }
+  }
+  if (!oldest_up_switch_ ||
+      AheadOf<uint16_t, kFrameIdLength>(picture_id, *oldest_up_switch_)) {
+    oldest_up_switch_ = picture_id;
+  }
+}
+
+RtpVp9RefFinder::GofInfo* RtpVp9RefFinder::FindGofInfo(int64_t unwrapped_tl0) {
+  GofInfoSlot& slot = gof_info_[unwrapped_tl0 & (kGofInfoSize - 1)];
+  return slot.valid && slot.unwrapped_tl0 == unwrapped_tl0 ? &slot.info
+                                                           : nullptr;
+}
+
+RtpVp9RefFinder::GofInfo* RtpVp9RefFinder::EmplaceGofInfo(
+    int64_t unwrapped_tl0,
+    const GofInfo& info) {
+  GofInfoSlot& slot = gof_info_[unwrapped_tl0 & (kGofInfoSize - 1)];
+  // A slot still holding an older TL0 picture index is only reused after
+  // heavy reordering of the base layer. Then the oldest info is dropped.
+  if (!slot.valid || slot.unwrapped_tl0 != unwrapped_tl0) {
+    slot.valid = true;
+    slot.unwrapped_tl0 = unwrapped_tl0;
+    slot.info = info;
+    oldest_gof_info_tl0_ = std::min(oldest_gof_info_tl0_, unwrapped_tl0);
+  }
+  return &slot.info;
+}
+
+void RtpVp9RefFinder::ClearGofInfoBefore(int64_t unwrapped_tl0) {
+  if (unwrapped_tl0 <= oldest_gof_info_tl0_)
+    return;
+  if (unwrapped_tl0 - oldest_gof_info_tl0_ >= kGofInfoSize) {
+    for (GofInfoSlot& slot : gof_info_) {
+      if (slot.unwrapped_tl0 < unwrapped_tl0)
+        slot.valid = false;
+    }
+  } else {
+    for (int64_t tl0 = oldest_gof_info_tl0_; tl0 < unwrapped_tl0; ++tl0) {
+      GofInfoSlot& slot = gof_info_[tl0 & (kGofInfoSize - 1)];
+      if (slot.unwrapped_tl0 == tl0)
+        slot.valid = false;
+    }
+  }
+  oldest_gof_info_tl0_ = unwrapped_tl0;
+}
+
 void RtpVp9RefFinder::RetryStashedFrames(
     RtpFrameReferenceFinder::ReturnVector& res) {
   bool complete_frame = false;
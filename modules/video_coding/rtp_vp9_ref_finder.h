@@ -11,12 +11,14 @@
 #ifndef MODULES_VIDEO_CODING_RTP_VP9_REF_FINDER_H_
 #define MODULES_VIDEO_CODING_RTP_VP9_REF_FINDER_H_
 
+#include <array>
+#include <bitset>
 #include <deque>
-#include <map>
+#include <limits>
 #include <memory>
-#include <set>
 
 #include "absl/container/inlined_vector.h"
+#include "absl/types/optional.h"
 #include "modules/video_coding/frame_object.h"
 #include "modules/video_coding/rtp_frame_reference_finder.h"
 #include "rtc_base/numerics/sequence_number_util.h"
@@ -38,6 +40,13 @@ class RtpVp9RefFinder {
   static constexpr int kMaxNotYetReceivedFrames = 100;
   static constexpr int kMaxStashedFrames = 100;
   static constexpr int kMaxTemporalLayers = 5;
+  static constexpr int kMaxUpSwitchAge = 50;
+  // Sizes of the ring buffers below. Larger than the number of entries that
+  // are kept, so that the live entries never share a slot.
+  static constexpr int kGofInfoSize = 64;
+  static constexpr int kUpSwitchSize = 64;
+  static_assert(kGofInfoSize > kMaxGofSaved, "");
+  static_assert(kUpSwitchSize > kMaxUpSwitchAge, "");
 
   enum FrameDecision { kStash, kHandOff, kDrop };
 
@@ -48,6 +57,18 @@ class RtpVp9RefFinder {
     uint16_t last_picture_id;
   };
 
+  struct GofInfoSlot {
+    bool valid = false;
+    int64_t unwrapped_tl0 = 0;
+    GofInfo info{nullptr, 0};
+  };
+
+  struct UpSwitch {
+    bool valid = false;
+    uint16_t picture_id = 0;
+    uint8_t temporal_idx = 0;
+  };
+
   FrameDecision ManageFrameInternal(RtpFrameObject* frame);
   void RetryStashedFrames(RtpFrameReferenceFinder::ReturnVector& res);
 
@@ -60,6 +81,14 @@ class RtpVp9RefFinder {
 
   void FlattenFrameIdAndRefs(RtpFrameObject* frame, bool inter_layer_predicted);
 
+  GofInfo* FindGofInfo(int64_t unwrapped_tl0);
+  // Adds `info` for `unwrapped_tl0` unless there already is info for it, and
+  // returns the info of `unwrapped_tl0`.
+  GofInfo* EmplaceGofInfo(int64_t unwrapped_tl0, const GofInfo& info);
+  void ClearGofInfoBefore(int64_t unwrapped_tl0);
+  void AddUpSwitch(uint16_t picture_id, uint8_t temporal_idx);
+  void ClearUpSwitchBefore(uint16_t picture_id);
+
   // Save the last picture id in order to detect when there is a gap in frames
   // that have not yet been fully received.
   int last_picture_id_ = -1;
@@ -75,17 +104,21 @@ class RtpVp9RefFinder {
   // Holds received scalability structures.
   std::array<GofInfoVP9, kMaxGofSaved> scalability_structures_;
 
-  // Holds the the Gof information for a given unwrapped TL0 picture index.
-  std::map<int64_t, GofInfo> gof_info_;
+  // Holds the the Gof information for a given unwrapped TL0 picture index,
+  // indexed by the unwrapped TL0 picture index modulo `kGofInfoSize`.
+  std::array<GofInfoSlot, kGofInfoSize> gof_info_;
+  // No Gof information is older than this TL0 picture index.
+  int64_t oldest_gof_info_tl0_ = std::numeric_limits<int64_t>::max();
 
   // Keep track of which picture id and which temporal layer that had the
-  // up switch flag set.
-  std::map<uint16_t, uint8_t, DescendingSeqNumComp<uint16_t, kFrameIdLength>>
-      up_switch_;
-
-  // For every temporal layer, keep a set of which frames that are missing.
-  std::array<std::set<uint16_t, DescendingSeqNumComp<uint16_t, kFrameIdLength>>,
-             kMaxTemporalLayers>
+  // up switch flag set, indexed by picture id modulo `kUpSwitchSize`.
+  std::array<UpSwitch, kUpSwitchSize> up_switch_;
+  // No up switch frame is older than this picture id.
+  absl::optional<uint16_t> oldest_up_switch_;
+
+  // For every temporal layer, keep a set of which frames that are missing,
+  // indexed by picture id.
+  std::array<std::bitset<kFrameIdLength>, kMaxTemporalLayers>
       missing_frames_for_layer_;
 
   // Unwrapper used to unwrap VP8/VP9 streams which have their picture id
@@ -376,6 +376,36 @@ TEST_F(RtpVp9RefFinderTest, GofTemporalLayers_01) {
   EXPECT_THAT(frames_, HasFrameWithIdAndRefs(15, {10}));
 }
 
+TEST_F(RtpVp9RefFinderTest, GofReorderedAcrossPictureIdWrap_0212) {
+  GofInfoVP9 ss;
+  ss.SetGofInfoVP9(kTemporalStructureMode3);  // 02120212 pattern
+  constexpr int kTid[] = {0, 2, 1, 2};
+  constexpr int kFirstPid = (1 << 15) - 40;
+  constexpr int kNumFrames = 200;
+  // Every group of four frames is received in reverse order, while both the
+  // picture id and the TL0 picture index wrap.
+  for (int group = 0; group < kNumFrames; group += 4) {
+    for (int i = group + 3; i >= group; --i) {
+      Frame frame;
+      frame.Pid((kFirstPid + i) & 0x7FFF)
+          .SidAndTid(0, kTid[i % 4])
+          .Tl0((250 + i / 4) & 0xFF)
+          .AsUpswitch(kTid[i % 4] == 2);
+      if (i == 0)
+        frame.AsKeyFrame().NotAsInterPic().Gof(&ss);
+      Insert(frame);
+    }
+  }
+
+  ASSERT_EQ(static_cast<size_t>(kNumFrames), frames_.size());
+  EXPECT_THAT(frames_, HasFrameWithIdAndRefs((kFirstPid + 100) * 5,
+                                             {(kFirstPid + 96) * 5}));
+  EXPECT_THAT(frames_, HasFrameWithIdAndRefs((kFirstPid + 102) * 5,
+                                             {(kFirstPid + 100) * 5}));
+  EXPECT_THAT(frames_, HasFrameWithIdAndRefs((kFirstPid + 103) * 5,
+                                             {(kFirstPid + 102) * 5}));
+}
+
 TEST_F(RtpVp9RefFinderTest, GofTemporalLayersReordered_01) {
   GofInfoVP9 ss;
   ss.SetGofInfoVP9(kTemporalStructureMode2);  // 01 pattern
@@ -0,0 +1,181 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/svc/svc_layer_selector.h"
+
+#include "absl/numeric/bits.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+// Returns a mask of the decode targets up to and including `decode_target`.
+uint32_t DecodeTargetsUpTo(int decode_target) {
+  if (decode_target < 0) {
+    return 0;
+  }
+  if (decode_target >= 31) {
+    return ~uint32_t{0};
+  }
+  return (uint32_t{2} << decode_target) - 1;
+}
+
+// Returns the highest decode target in `decode_targets`, if any.
+absl::optional<int> HighestDecodeTarget(uint32_t decode_targets) {
+  if (decode_targets == 0) {
+    return absl::nullopt;
+  }
+  return absl::bit_width(decode_targets) - 1;
+}
+
+}  // namespace
+
+SvcLayerSelector::SvcLayerSelector() = default;
+
+SvcLayerSelector::~SvcLayerSelector() = default;
+
+void SvcLayerSelector::SetTargetDecodeTarget(int decode_target) {
+  RTC_DCHECK_GE(decode_target, 0);
+  RTC_DCHECK_LT(decode_target, DependencyDescriptor::kMaxDecodeTargets);
+  target_decode_target_ = decode_target;
+}
+
+void SvcLayerSelector::SetTargetBitrate(
+    DataRate target_bitrate,
+    rtc::ArrayView<const DataRate> decode_target_bitrates) {
+  int decode_target = 0;
+  for (size_t i = 0; i < decode_target_bitrates.size(); ++i) {
+    if (decode_target_bitrates[i] <= target_bitrate) {
+      decode_target = i;
+    }
+  }
+  SetTargetDecodeTarget(decode_target);
+}
+
+bool SvcLayerSelector::OnPacket(const DependencyDescriptor& descriptor) {
+  if (current_frame_number_ == descriptor.frame_number) {
+    return forward_current_frame_;
+  }
+
+  if (descriptor.attached_structure) {
+    const FrameDependencyStructure& structure = *descriptor.attached_structure;
+    has_structure_ = true;
+    all_decode_targets_ = DecodeTargetsUpTo(structure.num_decode_targets - 1);
+    // A new structure activates all decode targets.
+    active_decode_targets_ = all_decode_targets_;
+    chain_decode_targets_.assign(structure.num_chains, 0);
+    if (structure.num_chains > 0) {
+      for (int dt = 0; dt < structure.num_decode_targets; ++dt) {
+        int chain = structure.decode_target_protected_by_chain[dt];
+        RTC_DCHECK_LT(chain, structure.num_chains);
+        chain_decode_targets_[chain] |= uint32_t{1} << dt;
+      }
+    }
+    // Frames before the structure can't be referenced.
+    received_frames_.fill(ReceivedFrame());
+    forwarded_decode_target_ = absl::nullopt;
+  }
+  if (!has_structure_) {
+    // The packets can't be interpreted yet.
+    return false;
+  }
+
+  current_frame_number_ = descriptor.frame_number;
+  forward_current_frame_ = OnNewFrame(descriptor);
+  return forward_current_frame_;
+}
+
+bool SvcLayerSelector::OnNewFrame(const DependencyDescriptor& descriptor) {
+  if (descriptor.active_decode_targets_bitmask) {
+    active_decode_targets_ =
+        *descriptor.active_decode_targets_bitmask & all_decode_targets_;
+  }
+
+  uint32_t present = 0;
+  uint32_t switch_points = 0;
+  const auto& dtis = descriptor.frame_dependencies.decode_target_indications;
+  for (size_t dt = 0; dt < dtis.size(); ++dt) {
+    if (dtis[dt] != DecodeTargetIndication::kNotPresent) {
+      present |= uint32_t{1} << dt;
+    }
+    if (dtis[dt] == DecodeTargetIndication::kSwitch) {
+      switch_points |= uint32_t{1} << dt;
+    }
+  }
+
+  uint32_t intact_decode_targets = all_decode_targets_;
+  if (!chain_decode_targets_.empty()) {
+    const uint32_t intact_chains = IntactChains(
+        descriptor.frame_number, descriptor.frame_dependencies.chain_diffs);
+    intact_decode_targets = 0;
+    for (size_t chain = 0; chain < chain_decode_targets_.size(); ++chain) {
+      if (intact_chains & (uint32_t{1} << chain)) {
+        intact_decode_targets |= chain_decode_targets_[chain];
+      }
+    }
+    ReceivedFrame& received_frame =
+        received_frames_[descriptor.frame_number % kReceivedFramesWindow];
+    received_frame.frame_number = descriptor.frame_number;
+    received_frame.intact_chains = intact_chains;
+  }
+  const uint32_t candidates = active_decode_targets_ & intact_decode_targets &
+                              DecodeTargetsUpTo(target_decode_target_);
+
+  absl::optional<int> best_switch_point =
+      HighestDecodeTarget(candidates & switch_points);
+  if (forwarded_decode_target_ &&
+      (candidates & (uint32_t{1} << *forwarded_decode_target_))) {
+    // Switch up at a switch point for a higher decode target.
+    if (best_switch_point > forwarded_decode_target_) {
+      forwarded_decode_target_ = best_switch_point;
+    }
+  } else if (forwarded_decode_target_) {
+    // The forwarded decode target is above the target, inactive or its chain
+    // is broken. Lower decode targets with intact chains can be switched to
+    // right away, since their frames have been forwarded too.
+    forwarded_decode_target_ = HighestDecodeTarget(
+        candidates & DecodeTargetsUpTo(*forwarded_decode_target_ - 1));
+    if (!forwarded_decode_target_) {
+      forwarded_decode_target_ = best_switch_point;
+    }
+  } else {
+    forwarded_decode_target_ = best_switch_point;
+  }
+
+  return forwarded_decode_target_ &&
+         (present & (uint32_t{1} << *forwarded_decode_target_));
+}
+
+uint32_t SvcLayerSelector::IntactChains(
+    int frame_number,
+    rtc::ArrayView<const int> chain_diffs) const {
+  uint32_t intact_chains = 0;
+  for (size_t chain = 0;
+       chain < chain_decode_targets_.size() && chain < chain_diffs.size();
+       ++chain) {
+    if (chain_diffs[chain] == 0) {
+      // The chain starts at this frame.
+      intact_chains |= uint32_t{1} << chain;
+      continue;
+    }
+    // The chain is intact if the previous frame in it was received and the
+    // chain was intact there. Frame numbers are 16 bits, and the window size
+    // divides 2^16.
+    int previous_frame_number = (frame_number - chain_diffs[chain]) & 0xFFFF;
+    const ReceivedFrame& previous_frame =
+        received_frames_[previous_frame_number % kReceivedFramesWindow];
+    if (previous_frame.frame_number == previous_frame_number) {
+      intact_chains |= previous_frame.intact_chains & (uint32_t{1} << chain);
+    }
+  }
+  return intact_chains;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,102 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_SVC_SVC_LAYER_SELECTOR_H_
+#define MODULES_VIDEO_CODING_SVC_SVC_LAYER_SELECTOR_H_
+
+#include <stdint.h>
+
+#include <array>
+
+#include "absl/container/inlined_vector.h"
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "api/transport/rtp/dependency_descriptor.h"
+#include "api/units/data_rate.h"
+
+namespace webrtc {
+
+// Decides, for a forwarding node such as an SFU, which packets of an SVC
+// stream to forward so that the receiver can decode a selected decode target.
+// It works on the dependency descriptors of the incoming packets:
+// - A frame is forwarded if it is part of the forwarded decode target.
+// - Switching to a higher decode target waits for a frame that is a switch
+//   point for it; switching to a lower one is immediate.
+// - If the chain protecting the forwarded decode target is broken, i.e. a
+//   frame in it was not received, nothing is forwarded until the next switch
+//   point.
+// The structure is reduced to bitmasks when it arrives, so a packet costs a
+// few bit operations, and all packets of a frame share the frame's decision.
+class SvcLayerSelector {
+ public:
+  SvcLayerSelector();
+  SvcLayerSelector(const SvcLayerSelector&) = delete;
+  SvcLayerSelector& operator=(const SvcLayerSelector&) = delete;
+  ~SvcLayerSelector();
+
+  // Sets the decode target to forward. If the stream has fewer decode targets,
+  // or it isn't active, the highest active one below it is forwarded.
+  void SetTargetDecodeTarget(int decode_target);
+
+  // Sets the target decode target to the highest one that fits within
+  // `target_bitrate`, where `decode_target_bitrates[i]` is the bitrate needed
+  // to forward decode target i, e.g. as measured by the SFU. Decode target 0 is
+  // chosen if none fits.
+  void SetTargetBitrate(DataRate target_bitrate,
+                        rtc::ArrayView<const DataRate> decode_target_bitrates);
+
+  // Returns true if the packet with `descriptor` should be forwarded. Packets
+  // are passed in arrival order; `descriptor` is parsed with the latest
+  // structure.
+  bool OnPacket(const DependencyDescriptor& descriptor);
+
+  // The decode target currently forwarded, or nullopt while waiting for a
+  // switch point.
+  absl::optional<int> forwarded_decode_target() const {
+    return forwarded_decode_target_;
+  }
+
+ private:
+  // Chain frame diffs are at most 255, so this many recent frames suffice to
+  // check that the previous frame in a chain was received.
+  static constexpr int kReceivedFramesWindow = 256;
+
+  // Returns the decision for a frame not seen before.
+  bool OnNewFrame(const DependencyDescriptor& descriptor);
+  // Returns a mask of the chains that are intact at a frame with
+  // `chain_diffs`, i.e. that have no frame missing since they started.
+  uint32_t IntactChains(int frame_number,
+                        rtc::ArrayView<const int> chain_diffs) const;
+
+  int target_decode_target_ = DependencyDescriptor::kMaxDecodeTargets - 1;
+  absl::optional<int> forwarded_decode_target_;
+
+  // Cached from the latest structure.
+  bool has_structure_ = false;
+  uint32_t all_decode_targets_ = 0;
+  // Decode targets protected by each chain.
+  absl::InlinedVector<uint32_t, 4> chain_decode_targets_;
+  uint32_t active_decode_targets_ = 0;
+
+  struct ReceivedFrame {
+    int frame_number = -1;
+    uint32_t intact_chains = 0;
+  };
+  // Recently received frames, indexed by frame number modulo the window size.
+  std::array<ReceivedFrame, kReceivedFramesWindow> received_frames_;
+
+  // The frame the last packet belonged to, and whether it is forwarded.
+  absl::optional<int> current_frame_number_;
+  bool forward_current_frame_ = false;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_SVC_SVC_LAYER_SELECTOR_H_
@@ -0,0 +1,165 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/svc/svc_layer_selector.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/transport/rtp/dependency_descriptor.h"
+#include "common_video/generic_frame_descriptor/generic_frame_info.h"
+#include "modules/video_coding/svc/create_scalability_structure.h"
+#include "modules/video_coding/svc/scalability_structure_test_helpers.h"
+#include "modules/video_coding/svc/scalable_video_controller.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+// L2T2 decode targets.
+constexpr int kS0T0 = 0;
+constexpr int kS1T1 = 3;
+
+class SvcLayerSelectorTest : public ::testing::Test {
+ protected:
+  SvcLayerSelectorTest()
+      : structure_(CreateScalabilityStructure("L2T2")),
+        frames_(ScalabilityStructureWrapper(*structure_)
+                    .GenerateFrames(/*num_temporal_units=*/20)) {}
+
+  DependencyDescriptor Descriptor(int frame_index) const {
+    DependencyDescriptor descriptor;
+    descriptor.frame_number = frame_index;
+    descriptor.frame_dependencies = frames_[frame_index];
+    if (frame_index == 0) {
+      descriptor.attached_structure =
+          std::make_unique<FrameDependencyStructure>(
+              structure_->DependencyStructure());
+    }
+    return descriptor;
+  }
+
+  bool InDecodeTarget(int frame_index, int decode_target) const {
+    return frames_[frame_index].decode_target_indications[decode_target] !=
+           DecodeTargetIndication::kNotPresent;
+  }
+
+  const std::unique_ptr<ScalableVideoController> structure_;
+  const std::vector<GenericFrameInfo> frames_;
+  SvcLayerSelector selector_;
+};
+
+TEST_F(SvcLayerSelectorTest, ForwardsFramesOfTargetDecodeTarget) {
+  selector_.SetTargetDecodeTarget(kS0T0);
+  for (size_t i = 0; i < frames_.size(); ++i) {
+    EXPECT_EQ(selector_.OnPacket(Descriptor(i)), InDecodeTarget(i, kS0T0))
+        << "Frame " << i;
+  }
+  EXPECT_EQ(selector_.forwarded_decode_target(), kS0T0);
+}
+
+TEST_F(SvcLayerSelectorTest, ForwardsAllFramesByDefault) {
+  for (size_t i = 0; i < frames_.size(); ++i) {
+    EXPECT_TRUE(selector_.OnPacket(Descriptor(i))) << "Frame " << i;
+  }
+  EXPECT_EQ(selector_.forwarded_decode_target(), kS1T1);
+}
+
+TEST_F(SvcLayerSelectorTest, DropsPacketsBeforeStructure) {
+  EXPECT_FALSE(selector_.OnPacket(Descriptor(1)));
+  EXPECT_FALSE(selector_.forwarded_decode_target());
+}
+
+TEST_F(SvcLayerSelectorTest, PacketsOfFrameShareDecision) {
+  selector_.SetTargetDecodeTarget(kS0T0);
+  DependencyDescriptor first_packet = Descriptor(0);
+  first_packet.last_packet_in_frame = false;
+  DependencyDescriptor last_packet = Descriptor(0);
+  last_packet.first_packet_in_frame = false;
+  last_packet.attached_structure = nullptr;
+  EXPECT_TRUE(selector_.OnPacket(first_packet));
+  EXPECT_TRUE(selector_.OnPacket(last_packet));
+
+  first_packet = Descriptor(1);
+  first_packet.last_packet_in_frame = false;
+  last_packet = Descriptor(1);
+  last_packet.first_packet_in_frame = false;
+  EXPECT_FALSE(selector_.OnPacket(first_packet));
+  EXPECT_FALSE(selector_.OnPacket(last_packet));
+}
+
+TEST_F(SvcLayerSelectorTest, SwitchesUpOnlyAtSwitchPoint) {
+  selector_.SetTargetDecodeTarget(kS0T0);
+  for (int i = 0; i < 4; ++i) {
+    selector_.OnPacket(Descriptor(i));
+  }
+  selector_.SetTargetDecodeTarget(kS1T1);
+  for (size_t i = 4; i < frames_.size(); ++i) {
+    absl::optional<int> before = selector_.forwarded_decode_target();
+    bool forwarded = selector_.OnPacket(Descriptor(i));
+    absl::optional<int> after = selector_.forwarded_decode_target();
+    ASSERT_TRUE(after);
+    if (after != before) {
+      EXPECT_EQ(frames_[i].decode_target_indications[*after],
+                DecodeTargetIndication::kSwitch)
+          << "Frame " << i;
+    }
+    EXPECT_EQ(forwarded, InDecodeTarget(i, *after)) << "Frame " << i;
+  }
+}
+
+TEST_F(SvcLayerSelectorTest, SwitchesDownImmediately) {
+  for (int i = 0; i < 4; ++i) {
+    selector_.OnPacket(Descriptor(i));
+  }
+  selector_.SetTargetDecodeTarget(kS0T0);
+  for (size_t i = 4; i < frames_.size(); ++i) {
+    EXPECT_EQ(selector_.OnPacket(Descriptor(i)), InDecodeTarget(i, kS0T0))
+        << "Frame " << i;
+    EXPECT_EQ(selector_.forwarded_decode_target(), kS0T0);
+  }
+}
+
+TEST_F(SvcLayerSelectorTest, StopsForwardingLayerWithBrokenChain) {
+  // Find the first frame after the key frame that is only in the top spatial
+  // layer's decode targets.
+  size_t lost_frame = 1;
+  while (InDecodeTarget(lost_frame, kS0T0) ||
+         frames_[lost_frame].spatial_id != 1 ||
+         frames_[lost_frame].temporal_id != 0) {
+    ++lost_frame;
+  }
+  for (size_t i = 0; i < lost_frame; ++i) {
+    EXPECT_TRUE(selector_.OnPacket(Descriptor(i)));
+  }
+  // The frames after the lost one are forwarded only for the lower spatial
+  // layer, whose chain is intact.
+  for (size_t i = lost_frame + 1; i < frames_.size(); ++i) {
+    EXPECT_EQ(selector_.OnPacket(Descriptor(i)), frames_[i].spatial_id == 0)
+        << "Frame " << i;
+  }
+  EXPECT_LT(selector_.forwarded_decode_target(), 2);
+}
+
+TEST_F(SvcLayerSelectorTest, SelectsDecodeTargetFromBitrates) {
+  const DataRate kBitrates[] = {
+      DataRate::KilobitsPerSec(100), DataRate::KilobitsPerSec(150),
+      DataRate::KilobitsPerSec(300), DataRate::KilobitsPerSec(450)};
+  selector_.SetTargetBitrate(DataRate::KilobitsPerSec(200), kBitrates);
+  selector_.OnPacket(Descriptor(0));
+  EXPECT_EQ(selector_.forwarded_decode_target(), 1);
+
+  selector_.SetTargetBitrate(DataRate::KilobitsPerSec(50), kBitrates);
+  selector_.OnPacket(Descriptor(1));
+  EXPECT_EQ(selector_.forwarded_decode_target(), 0);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,102 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/utility/active_map_tracker.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/experiments/field_trial_parser.h"
+
+namespace webrtc {
+
+constexpr int ActiveMapTracker::kBlockSize;
+constexpr int ActiveMapTracker::kMaxBuffers;
+constexpr char ActiveMapTracker::kFieldTrialName[];
+
+ActiveMapTracker::ActiveMapTracker(absl::string_view field_trial_string)
+    : config_(ParseConfig(field_trial_string)),
+      width_(0),
+      height_(0),
+      rows_(0),
+      cols_(0),
+      frames_since_refresh_(0) {
+  Reset(0, 0);
+}
+
+ActiveMapTracker::~ActiveMapTracker() = default;
+
+void ActiveMapTracker::Reset(int width, int height) {
+  width_ = width;
+  height_ = height;
+  rows_ = (height + kBlockSize - 1) / kBlockSize;
+  cols_ = (width + kBlockSize - 1) / kBlockSize;
+  frames_since_refresh_ = 0;
+  changed_since_update_.fill(VideoFrame::UpdateRect{0, 0, width, height});
+  map_.assign(rows_ * cols_, 1);
+}
+
+void ActiveMapTracker::OnInputFrame(const VideoFrame::UpdateRect& update_rect) {
+  VideoFrame::UpdateRect clipped = update_rect;
+  clipped.Intersect(VideoFrame::UpdateRect{0, 0, width_, height_});
+  for (VideoFrame::UpdateRect& changed : changed_since_update_) {
+    changed.Union(clipped);
+  }
+}
+
+void ActiveMapTracker::OnBufferUpdated(int buffer) {
+  RTC_DCHECK_GE(buffer, 0);
+  RTC_DCHECK_LT(buffer, kMaxBuffers);
+  changed_since_update_[buffer].MakeEmptyUpdate();
+}
+
+bool ActiveMapTracker::BuildMap(int reference_buffer) {
+  RTC_DCHECK_GE(reference_buffer, 0);
+  RTC_DCHECK_LT(reference_buffer, kMaxBuffers);
+  if (config_.refresh_interval > 0 &&
+      ++frames_since_refresh_ >= config_.refresh_interval) {
+    frames_since_refresh_ = 0;
+    return false;
+  }
+  const VideoFrame::UpdateRect& changed =
+      changed_since_update_[reference_buffer];
+  if (changed.width >= width_ && changed.height >= height_) {
+    return false;
+  }
+
+  std::fill(map_.begin(), map_.end(), 0);
+  if (changed.IsEmpty()) {
+    return true;
+  }
+  const int first_col = changed.offset_x / kBlockSize;
+  const int last_col = std::min(
+      cols_, (changed.offset_x + changed.width + kBlockSize - 1) / kBlockSize);
+  const int first_row = changed.offset_y / kBlockSize;
+  const int last_row = std::min(
+      rows_, (changed.offset_y + changed.height + kBlockSize - 1) / kBlockSize);
+  for (int row = first_row; row < last_row; ++row) {
+    std::fill(map_.begin() + row * cols_ + first_col,
+              map_.begin() + row * cols_ + last_col, 1);
+  }
+  return true;
+}
+
+ActiveMapTracker::Config ActiveMapTracker::ParseConfig(
+    absl::string_view field_trial_string) {
+  FieldTrialFlag enabled("Enabled");
+  FieldTrialParameter<int> refresh_interval("refresh_interval", 30);
+  ParseFieldTrial({&enabled, &refresh_interval}, field_trial_string);
+  Config config;
+  config.enabled = enabled.Get();
+  config.refresh_interval = std::max(0, refresh_interval.Get());
+  return config;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,90 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_UTILITY_ACTIVE_MAP_TRACKER_H_
+#define MODULES_VIDEO_CODING_UTILITY_ACTIVE_MAP_TRACKER_H_
+
+#include <stdint.h>
+
+#include <array>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "api/video/video_frame.h"
+
+namespace webrtc {
+
+// Builds the active maps of the libvpx and libaom encoders from the update
+// rects of the input frames. The encoders code the blocks that are marked as
+// inactive as unchanged copies of the last reference frame, without searching
+// for motion or coding residuals, so static content such as an idle slide
+// costs almost no encode time.
+//
+// A block may only be skipped if it is unchanged since the frame in the
+// reference buffer was encoded, which is not the previous input frame if
+// frames were dropped or the stream has temporal layers. So the changed region
+// is tracked per reference buffer.
+class ActiveMapTracker {
+ public:
+  // The size of the blocks of the map. VP8 macroblocks, and the units of the
+  // VP9 and AV1 active maps, are 16x16 pixels.
+  static constexpr int kBlockSize = 16;
+  static constexpr int kMaxBuffers = 8;
+  static constexpr char kFieldTrialName[] = "WebRTC-Screenshare-ActiveMap";
+
+  // `field_trial_string` is the group of `kFieldTrialName`, e.g.
+  // "Enabled,refresh_interval:30". Every `refresh_interval` frames, no map is
+  // built so that the encoder can refine the quality of static content.
+  explicit ActiveMapTracker(absl::string_view field_trial_string);
+  ~ActiveMapTracker();
+
+  bool enabled() const { return config_.enabled; }
+
+  // Sets the frame size and marks every buffer as entirely changed.
+  void Reset(int width, int height);
+
+  // Adds the changes of an input frame, whether or not it ends up encoded.
+  // Must be called before BuildMap() for that frame.
+  void OnInputFrame(const VideoFrame::UpdateRect& update_rect);
+
+  // Marks `buffer` as holding the frame that was just encoded.
+  void OnBufferUpdated(int buffer);
+
+  // Builds the map for a frame that is predicted from `reference_buffer`.
+  // Returns false if all blocks are active, so no map needs to be set.
+  bool BuildMap(int reference_buffer);
+
+  // The map built by the last successful BuildMap(), with one entry per block
+  // in raster order, which is 1 for active blocks and 0 for inactive blocks.
+  uint8_t* map() { return map_.data(); }
+  int rows() const { return rows_; }
+  int cols() const { return cols_; }
+
+ private:
+  struct Config {
+    bool enabled = false;
+    int refresh_interval = 0;
+  };
+  static Config ParseConfig(absl::string_view field_trial_string);
+
+  const Config config_;
+  int width_;
+  int height_;
+  int rows_;
+  int cols_;
+  int frames_since_refresh_;
+  // The region that changed since each buffer was updated.
+  std::array<VideoFrame::UpdateRect, kMaxBuffers> changed_since_update_;
+  std::vector<uint8_t> map_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_UTILITY_ACTIVE_MAP_TRACKER_H_
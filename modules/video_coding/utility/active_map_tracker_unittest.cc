@@ -0,0 +1,101 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/utility/active_map_tracker.h"
+
+#include <vector>
+
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::Each;
+using ::testing::ElementsAre;
+
+constexpr int kWidth = 64;
+constexpr int kHeight = 32;
+
+std::vector<uint8_t> Map(ActiveMapTracker& tracker) {
+  return std::vector<uint8_t>(tracker.map(),
+                              tracker.map() + tracker.rows() * tracker.cols());
+}
+
+TEST(ActiveMapTrackerTest, ParsesFieldTrial) {
+  EXPECT_FALSE(ActiveMapTracker("").enabled());
+  EXPECT_TRUE(ActiveMapTracker("Enabled").enabled());
+}
+
+TEST(ActiveMapTrackerTest, AllBlocksActiveAfterReset) {
+  ActiveMapTracker tracker("Enabled,refresh_interval:0");
+  tracker.Reset(kWidth, kHeight);
+  tracker.OnInputFrame(VideoFrame::UpdateRect{0, 0, 0, 0});
+  EXPECT_FALSE(tracker.BuildMap(0));
+}
+
+TEST(ActiveMapTrackerTest, MarksBlocksOverlappingTheUpdateRect) {
+  ActiveMapTracker tracker("Enabled,refresh_interval:0");
+  tracker.Reset(kWidth, kHeight);
+  tracker.OnBufferUpdated(0);
+
+  tracker.OnInputFrame(VideoFrame::UpdateRect{10, 20, 8, 4});
+  ASSERT_TRUE(tracker.BuildMap(0));
+  EXPECT_EQ(tracker.rows(), 2);
+  EXPECT_EQ(tracker.cols(), 4);
+  EXPECT_THAT(Map(tracker), ElementsAre(0, 0, 0, 0,  //
+                                        1, 1, 0, 0));
+}
+
+TEST(ActiveMapTrackerTest, AllBlocksInactiveWithoutChanges) {
+  ActiveMapTracker tracker("Enabled,refresh_interval:0");
+  tracker.Reset(kWidth, kHeight);
+  tracker.OnBufferUpdated(0);
+
+  tracker.OnInputFrame(VideoFrame::UpdateRect{0, 0, 0, 0});
+  ASSERT_TRUE(tracker.BuildMap(0));
+  EXPECT_THAT(Map(tracker), Each(0));
+}
+
+TEST(ActiveMapTrackerTest, KeepsChangesUntilBufferIsUpdated) {
+  ActiveMapTracker tracker("Enabled,refresh_interval:0");
+  tracker.Reset(kWidth, kHeight);
+  tracker.OnBufferUpdated(0);
+  tracker.OnBufferUpdated(1);
+
+  // The first frame is dropped, or only updates buffer 1.
+  tracker.OnInputFrame(VideoFrame::UpdateRect{0, 0, 16, 16});
+  tracker.OnBufferUpdated(1);
+  tracker.OnInputFrame(VideoFrame::UpdateRect{32, 16, 16, 16});
+
+  ASSERT_TRUE(tracker.BuildMap(0));
+  EXPECT_THAT(Map(tracker), ElementsAre(1, 1, 1, 0,  //
+                                        1, 1, 1, 0));
+  ASSERT_TRUE(tracker.BuildMap(1));
+  EXPECT_THAT(Map(tracker), ElementsAre(0, 0, 0, 0,  //
+                                        0, 0, 1, 0));
+}
+
+TEST(ActiveMapTrackerTest, PeriodicallyActivatesAllBlocks) {
+  ActiveMapTracker tracker("Enabled,refresh_interval:3");
+  tracker.Reset(kWidth, kHeight);
+  tracker.OnBufferUpdated(0);
+
+  for (int i = 0; i < 2; ++i) {
+    tracker.OnInputFrame(VideoFrame::UpdateRect{0, 0, 0, 0});
+    EXPECT_TRUE(tracker.BuildMap(0));
+    tracker.OnBufferUpdated(0);
+  }
+  tracker.OnInputFrame(VideoFrame::UpdateRect{0, 0, 0, 0});
+  EXPECT_FALSE(tracker.BuildMap(0));
+}
+
+}  // namespace
+}  // namespace webrtc
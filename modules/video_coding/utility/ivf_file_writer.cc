@@ -119,13 +119,15 @@ bool IvfFileWriter::WriteHeader() {
   return true;
 }
 
-bool IvfFileWriter::InitFromFirstFrame(const EncodedImage& encoded_image,
+bool IvfFileWriter::InitFromFirstFrame(uint16_t width,
+                                       uint16_t height,
+                                       bool using_capture_timestamps,
                                        VideoCodecType codec_type) {
-  width_ = encoded_image._encodedWidth;
-  height_ = encoded_image._encodedHeight;
+  width_ = width;
+  height_ = height;
   RTC_CHECK_GT(width_, 0);
   RTC_CHECK_GT(height_, 0);
-  using_capture_timestamps_ = encoded_image.Timestamp() == 0;
+  using_capture_timestamps_ = using_capture_timestamps;
 
   codec_type_ = codec_type;
 
@@ -141,32 +143,40 @@ bool IvfFileWriter::InitFromFirstFrame(const EncodedImage& encoded_image,
   return true;
 }
 
+void IvfFileWriter::CheckFrame(uint16_t width,
+                               uint16_t height,
+                               int64_t timestamp) {
+  if ((width > 0 || height > 0) && (height != height_ || width != width_)) {
+    RTC_LOG(LS_WARNING)
+        << "Incoming frame has resolution different from previous: (" << width_
+        << "x" << height_ << ") -> (" << width << "x" << height << ")";
+  }
+
+  if (last_timestamp_ != -1 && timestamp <= last_timestamp_) {
+    RTC_LOG(LS_WARNING) << "Timestamp no increasing: " << last_timestamp_
+                        << " -> " << timestamp;
+  }
+  last_timestamp_ = timestamp;
+}
+
 bool IvfFileWriter::WriteFrame(const EncodedImage& encoded_image,
                                VideoCodecType codec_type) {
   if (!file_.is_open())
     return false;
 
-  if (num_frames_ == 0 && !InitFromFirstFrame(encoded_image, codec_type))
+  if (num_frames_ == 0 &&
+      !InitFromFirstFrame(encoded_image._encodedWidth,
+                          encoded_image._encodedHeight,
+                          encoded_image.Timestamp() == 0, codec_type)) {
     return false;
-  RTC_DCHECK_EQ(codec_type_, codec_type);
-
-  if ((encoded_image._encodedWidth > 0 || encoded_image._encodedHeight > 0) &&
-      (encoded_image._encodedHeight != height_ ||
-       encoded_image._encodedWidth != width_)) {
-    RTC_LOG(LS_WARNING)
-        << "Incoming frame has resolution different from previous: (" << width_
-        << "x" << height_ << ") -> (" << encoded_image._encodedWidth << "x"
-        << encoded_image._encodedHeight << ")";
   }
+  RTC_DCHECK_EQ(codec_type_, codec_type);
 
   int64_t timestamp = using_capture_timestamps_
                           ? encoded_image.capture_time_ms_
                           : wrap_handler_.Unwrap(encoded_image.Timestamp());
-  if (last_timestamp_ != -1 && timestamp <= last_timestamp_) {
-    RTC_LOG(LS_WARNING) << "Timestamp no increasing: " << last_timestamp_
-                        << " -> " << timestamp;
-  }
-  last_timestamp_ = timestamp;
+  CheckFrame(encoded_image._encodedWidth, encoded_image._encodedHeight,
+             timestamp);
 
   bool written_frames = false;
   size_t max_sl_index = encoded_image.SpatialIndex().value_or(0);
@@ -191,6 +201,26 @@ bool IvfFileWriter::WriteFrame(const EncodedImage& encoded_image,
   }
 }
 
+bool IvfFileWriter::WriteFrame(rtc::ArrayView<const uint8_t> data,
+                               uint16_t width,
+                               uint16_t height,
+                               int64_t capture_time_ms,
+                               VideoCodecType codec_type) {
+  if (!file_.is_open())
+    return false;
+
+  if (num_frames_ == 0 && !InitFromFirstFrame(width, height,
+                                              /*using_capture_timestamps=*/true,
+                                              codec_type)) {
+    return false;
+  }
+  RTC_DCHECK_EQ(codec_type_, codec_type);
+  RTC_DCHECK(using_capture_timestamps_);
+
+  CheckFrame(width, height, capture_time_ms);
+  return WriteOneSpatialLayer(capture_time_ms, data.data(), data.size());
+}
+
 bool IvfFileWriter::WriteOneSpatialLayer(int64_t timestamp,
                                          const uint8_t* data,
                                          size_t size) {
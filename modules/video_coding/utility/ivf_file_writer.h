@@ -16,6 +16,7 @@
 
 #include <memory>
 
+#include "api/array_view.h"
 #include "api/video/encoded_image.h"
 #include "api/video/video_codec_type.h"
 #include "rtc_base/constructor_magic.h"
@@ -35,14 +36,25 @@ class IvfFileWriter {
   ~IvfFileWriter();
 
   bool WriteFrame(const EncodedImage& encoded_image, VideoCodecType codec_type);
+  // Writes `data` as a single frame of `width` x `height`, timestamped with
+  // `capture_time_ms`, e.g. a frame recorded from a receive stream. Can't be
+  // mixed with frames written with RTP timestamps.
+  bool WriteFrame(rtc::ArrayView<const uint8_t> data,
+                  uint16_t width,
+                  uint16_t height,
+                  int64_t capture_time_ms,
+                  VideoCodecType codec_type);
   bool Close();
 
  private:
   explicit IvfFileWriter(FileWrapper file, size_t byte_limit);
 
   bool WriteHeader();
-  bool InitFromFirstFrame(const EncodedImage& encoded_image,
+  bool InitFromFirstFrame(uint16_t width,
+                          uint16_t height,
+                          bool using_capture_timestamps,
                           VideoCodecType codec_type);
+  void CheckFrame(uint16_t width, uint16_t height, int64_t timestamp);
   bool WriteOneSpatialLayer(int64_t timestamp,
                             const uint8_t* data,
                             size_t size);
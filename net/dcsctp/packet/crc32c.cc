@@ -15,15 +15,24 @@
 
 namespace dcsctp {
 
-uint32_t GenerateCrc32C(rtc::ArrayView<const uint8_t> data) {
-  uint32_t crc32c = crc32c_value(data.data(), data.size());
-
-  // Byte swapping for little endian byte order:
+namespace {
+// Byte swapping for little endian byte order.
+uint32_t SwapBytes(uint32_t crc32c) {
   uint8_t byte0 = crc32c;
   uint8_t byte1 = crc32c >> 8;
   uint8_t byte2 = crc32c >> 16;
   uint8_t byte3 = crc32c >> 24;
-  crc32c = ((byte0 << 24) | (byte1 << 16) | (byte2 << 8) | byte3);
-  return crc32c;
+  return ((byte0 << 24) | (byte1 << 16) | (byte2 << 8) | byte3);
+}
+}  // namespace
+
+uint32_t GenerateCrc32C(rtc::ArrayView<const uint8_t> data) {
+  return SwapBytes(crc32c_value(data.data(), data.size()));
+}
+
+uint32_t GenerateCrc32C(rtc::ArrayView<const uint8_t> first,
+                        rtc::ArrayView<const uint8_t> second) {
+  uint32_t crc32c = crc32c_value(first.data(), first.size());
+  return SwapBytes(crc32c_extend(crc32c, second.data(), second.size()));
 }
 }  // namespace dcsctp
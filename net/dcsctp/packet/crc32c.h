@@ -19,6 +19,11 @@ namespace dcsctp {
 // Generates the CRC32C checksum of `data`.
 uint32_t GenerateCrc32C(rtc::ArrayView<const uint8_t> data);
 
+// Generates the CRC32C checksum of `first` followed by `second`, without them
+// having to be contiguous.
+uint32_t GenerateCrc32C(rtc::ArrayView<const uint8_t> first,
+                        rtc::ArrayView<const uint8_t> second);
+
 }  // namespace dcsctp
 
 #endif  // NET_DCSCTP_PACKET_CRC32C_H_
@@ -0,0 +1,57 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/array_view.h"
+#include "benchmark/benchmark.h"
+#include "net/dcsctp/packet/crc32c.h"
+
+namespace dcsctp {
+namespace {
+
+constexpr size_t kHeaderSize = 12;
+
+std::vector<uint8_t> CreatePacket(size_t size) {
+  std::vector<uint8_t> packet(size);
+  for (size_t i = 0; i < size; ++i) {
+    packet[i] = static_cast<uint8_t>(i * 7);
+  }
+  return packet;
+}
+
+// Checksums a packet as when it is sent.
+void BM_GenerateCrc32C(benchmark::State& state) {
+  std::vector<uint8_t> packet = CreatePacket(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(GenerateCrc32C(packet));
+  }
+  state.SetBytesProcessed(state.iterations() * packet.size());
+}
+
+// Checksums a packet as when it is received, where the common header, with
+// the checksum field zeroed, is checksummed separately from the chunks.
+void BM_GenerateCrc32CSplit(benchmark::State& state) {
+  std::vector<uint8_t> packet = CreatePacket(state.range(0));
+  rtc::ArrayView<const uint8_t> data(packet);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(GenerateCrc32C(data.subview(0, kHeaderSize),
+                                            data.subview(kHeaderSize)));
+  }
+  state.SetBytesProcessed(state.iterations() * packet.size());
+}
+
+// From a packet with a single small chunk to a full packet.
+BENCHMARK(BM_GenerateCrc32C)->Arg(64)->Arg(256)->Arg(1200);
+BENCHMARK(BM_GenerateCrc32CSplit)->Arg(64)->Arg(256)->Arg(1200);
+
+}  // namespace
+}  // namespace dcsctp
@@ -54,5 +54,13 @@ TEST(Crc32Test, TestVectors) {
   EXPECT_EQ(GenerateCrc32C(kISCSICommandPDU), 0x563a96d9U);
 }
 
+TEST(Crc32Test, SplitInputGivesSameChecksum) {
+  for (size_t split = 0; split <= kISCSICommandPDU.size(); ++split) {
+    rtc::ArrayView<const uint8_t> data(kISCSICommandPDU);
+    EXPECT_EQ(GenerateCrc32C(data.subview(0, split), data.subview(split)),
+              0x563a96d9U);
+  }
+}
+
 }  // namespace
 }  // namespace dcsctp
@@ -11,6 +11,8 @@
 
 #include <stddef.h>
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <string>
 #include <utility>
@@ -108,6 +110,21 @@ std::vector<uint8_t> SctpPacket::Builder::Build() {
 absl::optional<SctpPacket> SctpPacket::Parse(
     rtc::ArrayView<const uint8_t> data,
     bool disable_checksum_verification) {
+  return ParseInternal(data, disable_checksum_verification,
+                       /*copy_data=*/true);
+}
+
+absl::optional<SctpPacket> SctpPacket::ParseWithoutCopy(
+    rtc::ArrayView<const uint8_t> data,
+    bool disable_checksum_verification) {
+  return ParseInternal(data, disable_checksum_verification,
+                       /*copy_data=*/false);
+}
+
+absl::optional<SctpPacket> SctpPacket::ParseInternal(
+    rtc::ArrayView<const uint8_t> data,
+    bool disable_checksum_verification,
+    bool copy_data) {
   if (data.size() < kHeaderSize + kChunkTlvHeaderSize ||
       data.size() > kMaxUdpPacketSize) {
     RTC_DLOG(LS_WARNING) << "Invalid packet size";
@@ -122,13 +139,13 @@ absl::optional<SctpPacket> SctpPacket::Parse(
   common_header.verification_tag = VerificationTag(reader.Load32<4>());
   common_header.checksum = reader.Load32<8>();
 
-  // Create a copy of the packet, which will be held by this object.
-  std::vector<uint8_t> data_copy =
-      std::vector<uint8_t>(data.begin(), data.end());
-
-  // Verify the checksum. The checksum field must be zero when that's done.
-  BoundedByteWriter<kHeaderSize>(data_copy).Store32<8>(0);
-  uint32_t calculated_checksum = GenerateCrc32C(data_copy);
+  // Verify the checksum. The checksum field must be zero when that's done, so
+  // it's calculated over a copy of the common header followed by the chunks.
+  std::array<uint8_t, kHeaderSize> header;
+  std::copy(data.begin(), data.begin() + kHeaderSize, header.begin());
+  BoundedByteWriter<kHeaderSize>(header).Store32<8>(0);
+  uint32_t calculated_checksum =
+      GenerateCrc32C(header, data.subview(kHeaderSize));
   if (!disable_checksum_verification &&
       calculated_checksum != common_header.checksum) {
     RTC_DLOG(LS_WARNING) << rtc::StringFormat(
@@ -137,8 +154,15 @@ absl::optional<SctpPacket> SctpPacket::Parse(
         common_header.checksum, calculated_checksum);
     return absl::nullopt;
   }
-  // Restore the checksum in the header.
-  BoundedByteWriter<kHeaderSize>(data_copy).Store32<8>(common_header.checksum);
+
+  // Create a copy of the packet, which will be held by this object, unless
+  // the caller keeps `data` alive.
+  std::vector<uint8_t> data_copy;
+  rtc::ArrayView<const uint8_t> packet_data = data;
+  if (copy_data) {
+    data_copy.assign(data.begin(), data.end());
+    packet_data = data_copy;
+  }
 
   // Validate and parse the chunk headers in the message.
   /*
@@ -152,7 +176,7 @@ absl::optional<SctpPacket> SctpPacket::Parse(
   std::vector<ChunkDescriptor> descriptors;
   descriptors.reserve(kExpectedDescriptorCount);
   rtc::ArrayView<const uint8_t> descriptor_data =
-      rtc::ArrayView<const uint8_t>(data_copy).subview(kHeaderSize);
+      packet_data.subview(kHeaderSize);
   while (!descriptor_data.empty()) {
     if (descriptor_data.size() < kChunkTlvHeaderSize) {
       RTC_DLOG(LS_WARNING) << "Too small chunk";
@@ -177,7 +201,7 @@ absl::optional<SctpPacket> SctpPacket::Parse(
   }
 
   // Note that iterators (and pointer) are guaranteed to be stable when moving a
-  // std::vector, and `descriptors` have pointers to within `data_copy`.
+  // std::vector, and `descriptors` may have pointers to within `data_copy`.
   return SctpPacket(common_header, std::move(data_copy),
                     std::move(descriptors));
 }
@@ -91,6 +91,13 @@ class SctpPacket {
       rtc::ArrayView<const uint8_t> data,
       bool disable_checksum_verification = false);
 
+  // Like `Parse`, but the returned packet refers to `data` instead of holding
+  // a copy of it, so `data` must outlive the packet. Used to handle a received
+  // packet without copying it.
+  static absl::optional<SctpPacket> ParseWithoutCopy(
+      rtc::ArrayView<const uint8_t> data,
+      bool disable_checksum_verification = false);
+
   // Returns the SCTP common header.
   const CommonHeader& common_header() const { return common_header_; }
 
@@ -100,6 +107,11 @@ class SctpPacket {
   }
 
  private:
+  static absl::optional<SctpPacket> ParseInternal(
+      rtc::ArrayView<const uint8_t> data,
+      bool disable_checksum_verification,
+      bool copy_data);
+
   SctpPacket(const CommonHeader& common_header,
              std::vector<uint8_t> data,
              std::vector<ChunkDescriptor> descriptors)
@@ -112,8 +124,10 @@ class SctpPacket {
   // As the `descriptors_` refer to offset within data, and since SctpPacket is
   // movable, `data` needs to be pointer stable, which it is according to
   // http://www.open-std.org/JTC1/SC22/WG21/docs/lwg-active.html#2321
+  // Empty if the packet was parsed without a copy.
   std::vector<uint8_t> data_;
-  // The chunks and their offsets within `data_ `.
+  // The chunks and their offsets within `data_ `, or within the parsed data if
+  // it wasn't copied.
   std::vector<ChunkDescriptor> descriptors_;
 };
 }  // namespace dcsctp
@@ -9,12 +9,187 @@
  */
 #include "net/dcsctp/public/dcsctp_handover_state.h"
 
+#include <cstdint>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "api/array_view.h"
 
 namespace dcsctp {
 namespace {
+// The version of the serialized format, which is its first byte. Increment it
+// when changing the format, and keep deserializing the previous versions.
+constexpr uint8_t kSerializedVersion = 1;
+
+// Flags of serialized capabilities.
+constexpr uint8_t kPartialReliabilityFlag = 1;
+constexpr uint8_t kMessageInterleavingFlag = 2;
+constexpr uint8_t kReconfigFlag = 4;
+
+// Flags of serialized outgoing messages.
+constexpr uint8_t kUnorderedFlag = 1;
+constexpr uint8_t kLifetimeFlag = 2;
+constexpr uint8_t kMaxRetransmissionsFlag = 4;
+
+// Appends integers in network byte order, and length-prefixed byte arrays.
+class HandoverStateWriter {
+ public:
+  void U8(uint8_t value) { data_.push_back(value); }
+  void U32(uint32_t value) {
+    for (int shift = 24; shift >= 0; shift -= 8) {
+      data_.push_back(static_cast<uint8_t>(value >> shift));
+    }
+  }
+  void U64(uint64_t value) {
+    U32(static_cast<uint32_t>(value >> 32));
+    U32(static_cast<uint32_t>(value));
+  }
+  void Bytes(rtc::ArrayView<const uint8_t> bytes) {
+    U32(static_cast<uint32_t>(bytes.size()));
+    data_.insert(data_.end(), bytes.begin(), bytes.end());
+  }
+
+  std::vector<uint8_t> Release() && { return std::move(data_); }
+
+ private:
+  std::vector<uint8_t> data_;
+};
+
+// Reads what has been written by `HandoverStateWriter`. All reads fail after
+// having read past the end of the data.
+class HandoverStateReader {
+ public:
+  explicit HandoverStateReader(rtc::ArrayView<const uint8_t> data)
+      : data_(data) {}
+
+  bool U8(uint8_t& value) {
+    if (!Has(1)) {
+      return false;
+    }
+    value = data_[offset_++];
+    return true;
+  }
+  bool U32(uint32_t& value) {
+    if (!Has(4)) {
+      return false;
+    }
+    value = 0;
+    for (int i = 0; i < 4; ++i) {
+      value = (value << 8) | data_[offset_++];
+    }
+    return true;
+  }
+  bool U64(uint64_t& value) {
+    uint32_t high;
+    uint32_t low;
+    if (!U32(high) || !U32(low)) {
+      return false;
+    }
+    value = (static_cast<uint64_t>(high) << 32) | low;
+    return true;
+  }
+  bool Bytes(std::vector<uint8_t>& bytes) {
+    uint32_t size;
+    if (!U32(size) || !Has(size)) {
+      return false;
+    }
+    bytes.assign(data_.begin() + offset_, data_.begin() + offset_ + size);
+    offset_ += size;
+    return true;
+  }
+  // Reads the size of a list, where each element is at least `min_size`
+  // bytes, which avoids allocating for sizes that can't be valid.
+  bool Count(size_t min_size, uint32_t& count) {
+    return U32(count) && count <= (data_.size() - offset_) / min_size;
+  }
+
+  bool IsAtEnd() const { return offset_ == data_.size(); }
+
+ private:
+  bool Has(size_t size) const { return data_.size() - offset_ >= size; }
+
+  const rtc::ArrayView<const uint8_t> data_;
+  size_t offset_ = 0;
+};
+
+void WriteOutgoingMessage(
+    HandoverStateWriter& writer,
+    const DcSctpSocketHandoverState::OutgoingMessage& message) {
+  writer.U32(message.ppid);
+  writer.U8((message.unordered ? kUnorderedFlag : 0) |
+            (message.lifetime_ms.has_value() ? kLifetimeFlag : 0) |
+            (message.max_retransmissions.has_value() ? kMaxRetransmissionsFlag
+                                                     : 0));
+  if (message.lifetime_ms.has_value()) {
+    writer.U32(*message.lifetime_ms);
+  }
+  if (message.max_retransmissions.has_value()) {
+    writer.U32(*message.max_retransmissions);
+  }
+  writer.Bytes(message.payload);
+}
+
+bool ReadOutgoingMessage(HandoverStateReader& reader,
+                         DcSctpSocketHandoverState::OutgoingMessage& message) {
+  uint8_t flags;
+  if (!reader.U32(message.ppid) || !reader.U8(flags)) {
+    return false;
+  }
+  message.unordered = (flags & kUnorderedFlag) != 0;
+  if (flags & kLifetimeFlag) {
+    uint32_t lifetime_ms;
+    if (!reader.U32(lifetime_ms)) {
+      return false;
+    }
+    message.lifetime_ms = lifetime_ms;
+  }
+  if (flags & kMaxRetransmissionsFlag) {
+    uint32_t max_retransmissions;
+    if (!reader.U32(max_retransmissions)) {
+      return false;
+    }
+    message.max_retransmissions = max_retransmissions;
+  }
+  return reader.Bytes(message.payload);
+}
+
+void WriteOutgoingStream(
+    HandoverStateWriter& writer,
+    const DcSctpSocketHandoverState::OutgoingStream& stream) {
+  writer.U32(stream.id);
+  writer.U32(stream.next_ssn);
+  writer.U32(stream.next_unordered_mid);
+  writer.U32(stream.next_ordered_mid);
+  writer.U32(stream.priority);
+  writer.U32(static_cast<uint32_t>(stream.messages.size()));
+  for (const auto& message : stream.messages) {
+    WriteOutgoingMessage(writer, message);
+  }
+}
+
+bool ReadOutgoingStream(HandoverStateReader& reader,
+                        DcSctpSocketHandoverState::OutgoingStream& stream) {
+  // A message is at least a PPID, flags and the payload size.
+  constexpr size_t kMinMessageSize = 9;
+  uint32_t message_count;
+  if (!reader.U32(stream.id) || !reader.U32(stream.next_ssn) ||
+      !reader.U32(stream.next_unordered_mid) ||
+      !reader.U32(stream.next_ordered_mid) || !reader.U32(stream.priority) ||
+      !reader.Count(kMinMessageSize, message_count)) {
+    return false;
+  }
+  stream.messages.resize(message_count);
+  for (auto& message : stream.messages) {
+    if (!ReadOutgoingMessage(reader, message)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 constexpr absl::string_view HandoverUnreadinessReasonToString(
     HandoverUnreadinessReason reason) {
   switch (reason) {
@@ -46,6 +221,127 @@ constexpr absl::string_view HandoverUnreadinessReasonToString(
 }
 }  // namespace
 
+std::vector<uint8_t> SerializeHandoverState(
+    const DcSctpSocketHandoverState& state) {
+  HandoverStateWriter writer;
+  writer.U8(kSerializedVersion);
+  writer.U8(static_cast<uint8_t>(state.socket_state));
+  writer.U32(state.my_verification_tag);
+  writer.U32(state.my_initial_tsn);
+  writer.U32(state.peer_verification_tag);
+  writer.U32(state.peer_initial_tsn);
+  writer.U64(state.tie_tag);
+  writer.U8((state.capabilities.partial_reliability ? kPartialReliabilityFlag
+                                                    : 0) |
+            (state.capabilities.message_interleaving ? kMessageInterleavingFlag
+                                                     : 0) |
+            (state.capabilities.reconfig ? kReconfigFlag : 0));
+
+  writer.U32(state.tx.next_tsn);
+  writer.U32(state.tx.next_reset_req_sn);
+  writer.U32(state.tx.cwnd);
+  writer.U32(state.tx.rwnd);
+  writer.U32(state.tx.ssthresh);
+  writer.U32(state.tx.partial_bytes_acked);
+  writer.U32(static_cast<uint32_t>(state.tx.streams.size()));
+  for (const auto& stream : state.tx.streams) {
+    WriteOutgoingStream(writer, stream);
+  }
+
+  writer.U8(state.rx.seen_packet ? 1 : 0);
+  writer.U32(state.rx.last_cumulative_acked_tsn);
+  writer.U32(state.rx.last_assembled_tsn);
+  writer.U32(state.rx.last_completed_deferred_reset_req_sn);
+  writer.U32(state.rx.last_completed_reset_req_sn);
+  writer.U32(static_cast<uint32_t>(state.rx.ordered_streams.size()));
+  for (const auto& stream : state.rx.ordered_streams) {
+    writer.U32(stream.id);
+    writer.U32(stream.next_ssn);
+  }
+  writer.U32(static_cast<uint32_t>(state.rx.unordered_streams.size()));
+  for (const auto& stream : state.rx.unordered_streams) {
+    writer.U32(stream.id);
+  }
+  return std::move(writer).Release();
+}
+
+absl::optional<DcSctpSocketHandoverState> DeserializeHandoverState(
+    rtc::ArrayView<const uint8_t> data) {
+  // An outgoing stream is at least five fields and the message count.
+  constexpr size_t kMinOutgoingStreamSize = 24;
+  HandoverStateReader reader(data);
+  DcSctpSocketHandoverState state;
+
+  uint8_t version;
+  uint8_t socket_state;
+  uint8_t capabilities;
+  if (!reader.U8(version) || version != kSerializedVersion ||
+      !reader.U8(socket_state) ||
+      socket_state >
+          static_cast<uint8_t>(
+              DcSctpSocketHandoverState::SocketState::kConnected) ||
+      !reader.U32(state.my_verification_tag) ||
+      !reader.U32(state.my_initial_tsn) ||
+      !reader.U32(state.peer_verification_tag) ||
+      !reader.U32(state.peer_initial_tsn) || !reader.U64(state.tie_tag) ||
+      !reader.U8(capabilities)) {
+    return absl::nullopt;
+  }
+  state.socket_state =
+      static_cast<DcSctpSocketHandoverState::SocketState>(socket_state);
+  state.capabilities.partial_reliability =
+      (capabilities & kPartialReliabilityFlag) != 0;
+  state.capabilities.message_interleaving =
+      (capabilities & kMessageInterleavingFlag) != 0;
+  state.capabilities.reconfig = (capabilities & kReconfigFlag) != 0;
+
+  uint32_t stream_count;
+  if (!reader.U32(state.tx.next_tsn) ||
+      !reader.U32(state.tx.next_reset_req_sn) || !reader.U32(state.tx.cwnd) || !reader.U32(state.tx.rwnd) ||
+      !reader.U32(state.tx.ssthresh) ||
+      !reader.U32(state.tx.partial_bytes_acked) ||
+      !reader.Count(kMinOutgoingStreamSize, stream_count)) {
+    return absl::nullopt;
+  }
+  state.tx.streams.resize(stream_count);
+  for (auto& stream : state.tx.streams) {
+    if (!ReadOutgoingStream(reader, stream)) {
+      return absl::nullopt;
+    }
+  }
+
+  uint8_t seen_packet;
+  if (!reader.U8(seen_packet) ||
+      !reader.U32(state.rx.last_cumulative_acked_tsn) ||
+      !reader.U32(state.rx.last_assembled_tsn) ||
+      !reader.U32(state.rx.last_completed_deferred_reset_req_sn) ||
+      !reader.U32(state.rx.last_completed_reset_req_sn) ||
+      !reader.Count(/*min_size=*/8, stream_count)) {
+    return absl::nullopt;
+  }
+  state.rx.seen_packet = seen_packet != 0;
+  state.rx.ordered_streams.resize(stream_count);
+  for (auto& stream : state.rx.ordered_streams) {
+    if (!reader.U32(stream.id) || !reader.U32(stream.next_ssn)) {
+      return absl::nullopt;
+    }
+  }
+  if (!reader.Count(/*min_size=*/4, stream_count)) {
+    return absl::nullopt;
+  }
+  state.rx.unordered_streams.resize(stream_count);
+  for (auto& stream : state.rx.unordered_streams) {
+    if (!reader.U32(stream.id)) {
+      return absl::nullopt;
+    }
+  }
+
+  if (!reader.IsAtEnd()) {
+    return absl::nullopt;
+  }
+  return state;
+}
+
 std::string HandoverReadinessStatus::ToString() const {
   std::string result;
   for (uint32_t bit = 1;
@@ -14,6 +14,8 @@
 #include <string>
 #include <vector>
 
+#include "absl/types/optional.h"
+#include "api/array_view.h"
 #include "rtc_base/strong_alias.h"
 
 namespace dcsctp {
@@ -21,8 +23,8 @@ namespace dcsctp {
 // Stores state snapshot of a dcSCTP socket. The snapshot can be used to
 // recreate the socket - possibly in another process. This state should be
 // treaded as opaque - the calling client should not inspect or alter it except
-// for serialization. Serialization is not provided by dcSCTP. If needed it has
-// to be implemented in the calling client.
+// for serialization, which can be done using `SerializeHandoverState` and
+// `DeserializeHandoverState`.
 struct DcSctpSocketHandoverState {
   enum class SocketState {
     kClosed,
@@ -43,11 +45,22 @@ struct DcSctpSocketHandoverState {
   };
   Capabilities capabilities;
 
+  // A message in the send queue, of which nothing has been sent yet.
+  struct OutgoingMessage {
+    uint32_t ppid = 0;
+    bool unordered = false;
+    // The remaining lifetime, in milliseconds, if the lifetime is limited.
+    absl::optional<uint32_t> lifetime_ms;
+    absl::optional<uint32_t> max_retransmissions;
+    std::vector<uint8_t> payload;
+  };
   struct OutgoingStream {
     uint32_t id = 0;
     uint32_t next_ssn = 0;
     uint32_t next_unordered_mid = 0;
     uint32_t next_ordered_mid = 0;
+    uint32_t priority = 0;
+    std::vector<OutgoingMessage> messages;
   };
   struct Transmission {
     uint32_t next_tsn = 0;
@@ -79,6 +92,16 @@ struct DcSctpSocketHandoverState {
   Receive rx;
 };
 
+// Serializes `state` into a compact binary format, which is versioned so that
+// it can be deserialized by a process running a later version of dcSCTP.
+std::vector<uint8_t> SerializeHandoverState(
+    const DcSctpSocketHandoverState& state);
+
+// Deserializes what has been serialized by `SerializeHandoverState`. Returns
+// absl::nullopt if `data` is truncated, malformed or of an unsupported version.
+absl::optional<DcSctpSocketHandoverState> DeserializeHandoverState(
+    rtc::ArrayView<const uint8_t> data);
+
 // A list of possible reasons for a socket to be not ready for handover.
 enum class HandoverUnreadinessReason : uint32_t {
   kWrongConnectionState = 1,
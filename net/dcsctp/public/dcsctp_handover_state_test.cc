@@ -0,0 +1,162 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "net/dcsctp/public/dcsctp_handover_state.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "rtc_base/gunit.h"
+#include "test/gmock.h"
+
+namespace dcsctp {
+namespace {
+using ::testing::ElementsAre;
+using ::testing::SizeIs;
+
+DcSctpSocketHandoverState CreateState() {
+  DcSctpSocketHandoverState state;
+  state.socket_state = DcSctpSocketHandoverState::SocketState::kConnected;
+  state.my_verification_tag = 0x12345678;
+  state.my_initial_tsn = 10;
+  state.peer_verification_tag = 0x9abcdef0;
+  state.peer_initial_tsn = 20;
+  state.tie_tag = 0x0102030405060708;
+  state.capabilities.partial_reliability = true;
+  state.capabilities.reconfig = true;
+
+  state.tx.next_tsn = 11;
+  state.tx.next_reset_req_sn = 12;
+  state.tx.cwnd = 13;
+  state.tx.rwnd = 14;
+  state.tx.ssthresh = 15;
+  state.tx.partial_bytes_acked = 16;
+
+  DcSctpSocketHandoverState::OutgoingStream stream;
+  stream.id = 1;
+  stream.next_ssn = 2;
+  stream.next_unordered_mid = 3;
+  stream.next_ordered_mid = 4;
+  stream.priority = 256;
+  DcSctpSocketHandoverState::OutgoingMessage message;
+  message.ppid = 53;
+  message.unordered = true;
+  message.lifetime_ms = 100;
+  message.max_retransmissions = 0;
+  message.payload = {1, 2, 3};
+  stream.messages.push_back(message);
+  message = {};
+  message.ppid = 54;
+  message.payload = {4};
+  stream.messages.push_back(message);
+  state.tx.streams.push_back(stream);
+
+  state.rx.seen_packet = true;
+  state.rx.last_cumulative_acked_tsn = 21;
+  state.rx.last_assembled_tsn = 22;
+  state.rx.last_completed_deferred_reset_req_sn = 23;
+  state.rx.last_completed_reset_req_sn = 24;
+  DcSctpSocketHandoverState::OrderedStream ordered_stream;
+  ordered_stream.id = 5;
+  ordered_stream.next_ssn = 6;
+  state.rx.ordered_streams.push_back(ordered_stream);
+  DcSctpSocketHandoverState::UnorderedStream unordered_stream;
+  unordered_stream.id = 7;
+  state.rx.unordered_streams.push_back(unordered_stream);
+  return state;
+}
+
+TEST(DcSctpHandoverStateTest, SerializesAndDeserializes) {
+  absl::optional<DcSctpSocketHandoverState> state =
+      DeserializeHandoverState(SerializeHandoverState(CreateState()));
+  ASSERT_TRUE(state.has_value());
+
+  EXPECT_EQ(state->socket_state,
+            DcSctpSocketHandoverState::SocketState::kConnected);
+  EXPECT_EQ(state->my_verification_tag, 0x12345678u);
+  EXPECT_EQ(state->my_initial_tsn, 10u);
+  EXPECT_EQ(state->peer_verification_tag, 0x9abcdef0u);
+  EXPECT_EQ(state->peer_initial_tsn, 20u);
+  EXPECT_EQ(state->tie_tag, 0x0102030405060708u);
+  EXPECT_TRUE(state->capabilities.partial_reliability);
+  EXPECT_FALSE(state->capabilities.message_interleaving);
+  EXPECT_TRUE(state->capabilities.reconfig);
+
+  EXPECT_EQ(state->tx.next_tsn, 11u);
+  EXPECT_EQ(state->tx.next_reset_req_sn, 12u);
+  EXPECT_EQ(state->tx.cwnd, 13u);
+  EXPECT_EQ(state->tx.rwnd, 14u);
+  EXPECT_EQ(state->tx.ssthresh, 15u);
+  EXPECT_EQ(state->tx.partial_bytes_acked, 16u);
+  ASSERT_THAT(state->tx.streams, SizeIs(1));
+  const auto& stream = state->tx.streams[0];
+  EXPECT_EQ(stream.id, 1u);
+  EXPECT_EQ(stream.next_ssn, 2u);
+  EXPECT_EQ(stream.next_unordered_mid, 3u);
+  EXPECT_EQ(stream.next_ordered_mid, 4u);
+  EXPECT_EQ(stream.priority, 256u);
+  ASSERT_THAT(stream.messages, SizeIs(2));
+  EXPECT_EQ(stream.messages[0].ppid, 53u);
+  EXPECT_TRUE(stream.messages[0].unordered);
+  EXPECT_EQ(stream.messages[0].lifetime_ms, 100u);
+  EXPECT_EQ(stream.messages[0].max_retransmissions, 0u);
+  EXPECT_THAT(stream.messages[0].payload, ElementsAre(1, 2, 3));
+  EXPECT_EQ(stream.messages[1].ppid, 54u);
+  EXPECT_FALSE(stream.messages[1].unordered);
+  EXPECT_FALSE(stream.messages[1].lifetime_ms.has_value());
+  EXPECT_FALSE(stream.messages[1].max_retransmissions.has_value());
+  EXPECT_THAT(stream.messages[1].payload, ElementsAre(4));
+
+  EXPECT_TRUE(state->rx.seen_packet);
+  EXPECT_EQ(state->rx.last_cumulative_acked_tsn, 21u);
+  EXPECT_EQ(state->rx.last_assembled_tsn, 22u);
+  EXPECT_EQ(state->rx.last_completed_deferred_reset_req_sn, 23u);
+  EXPECT_EQ(state->rx.last_completed_reset_req_sn, 24u);
+  ASSERT_THAT(state->rx.ordered_streams, SizeIs(1));
+  EXPECT_EQ(state->rx.ordered_streams[0].id, 5u);
+  EXPECT_EQ(state->rx.ordered_streams[0].next_ssn, 6u);
+  ASSERT_THAT(state->rx.unordered_streams, SizeIs(1));
+  EXPECT_EQ(state->rx.unordered_streams[0].id, 7u);
+}
+
+TEST(DcSctpHandoverStateTest, RejectsTruncatedData) {
+  std::vector<uint8_t> data = SerializeHandoverState(CreateState());
+  for (size_t size = 0; size < data.size(); ++size) {
+    EXPECT_FALSE(DeserializeHandoverState(
+                     rtc::ArrayView<const uint8_t>(data.data(), size))
+                     .has_value());
+  }
+}
+
+TEST(DcSctpHandoverStateTest, RejectsTrailingData) {
+  std::vector<uint8_t> data = SerializeHandoverState(CreateState());
+  data.push_back(0);
+  EXPECT_FALSE(DeserializeHandoverState(data).has_value());
+}
+
+TEST(DcSctpHandoverStateTest, RejectsUnsupportedVersion) {
+  std::vector<uint8_t> data = SerializeHandoverState(CreateState());
+  data[0] = 0;
+  EXPECT_FALSE(DeserializeHandoverState(data).has_value());
+}
+
+TEST(DcSctpHandoverStateTest, RejectsTooLargeMessageCount) {
+  DcSctpSocketHandoverState state;
+  state.tx.streams.emplace_back();
+  std::vector<uint8_t> data = SerializeHandoverState(state);
+  // The message count is the last field of the only outgoing stream, which is
+  // followed by the receive state of one flag, four fields and two counts.
+  size_t message_count_offset = data.size() - 4 - 1 - 4 * 4 - 2 * 4;
+  data[message_count_offset] = 0xff;
+  EXPECT_FALSE(DeserializeHandoverState(data).has_value());
+}
+
+}  // namespace
+}  // namespace dcsctp
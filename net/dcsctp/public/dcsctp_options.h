@@ -17,6 +17,16 @@
 #include "net/dcsctp/public/types.h"
 
 namespace dcsctp {
+// The congestion control algorithm, which limits how much data that is sent.
+enum class CongestionControlAlgorithm {
+  // Loss based, as described in https://tools.ietf.org/html/rfc4960#section-7,
+  // which is similar to TCP NewReno.
+  kNewReno,
+  // Model based and paced, similar to BBR, which avoids filling the buffers of
+  // the bottleneck link and thereby adds less latency to other traffic on it.
+  kBbr,
+};
+
 struct DcSctpOptions {
   // The largest safe SCTP packet. Starting from the minimum guaranteed MTU
   // value of 1280 for IPv6 (which may not support fragmentation), take off 85
@@ -88,6 +98,10 @@ struct DcSctpOptions {
   // this value, will trigger `DcSctpCallbacks::OnTotalBufferedAmountLow`.
   size_t total_buffered_amount_low_threshold = 1'800'000;
 
+  // The priority of streams whose priority has not been set with
+  // `DcSctpSocketInterface::SetStreamPriority`.
+  StreamPriority default_stream_priority = StreamPriority(256);
+
   // Max allowed RTT value. When the RTT is measured and it's found to be larger
   // than this value, it will be discarded and not used for e.g. any RTO
   // calculation. The default value is an extreme maximum but can be adapted
@@ -128,6 +142,20 @@ struct DcSctpOptions {
   // unacknowledged packet. Whatever is smallest of RTO/2 and this will be used.
   DurationMs delayed_ack_max_timeout = DurationMs(200);
 
+  // The number of received packets with DATA or FORWARD-TSN chunks after which
+  // a SACK is sent without waiting for the delayed ack timer, like `sack_freq`
+  // in https://tools.ietf.org/html/rfc6458#section-8.1.19. RFC 4960 recommends
+  // two, as a SACK SHOULD be sent for at least every second packet. One
+  // disables delayed SACKs, which lets the peer's congestion window grow
+  // faster, and a larger value reduces the number of SACKs sent.
+  int sack_frequency = 2;
+
+  // If set, FORWARD-TSN chunks and SACKs that are due are bundled with any
+  // DATA chunks that can be sent, rather than being sent in packets of their
+  // own. FORWARD-TSN chunks are by default sent separately, as some versions
+  // of usrsctp mishandle them when bundled, see bugs.webrtc.org/12961.
+  bool bundle_control_chunks_with_data = false;
+
   // The minimum limit for the measured RTT variance
   //
   // Setting this below the expected delayed ack timeout (+ margin) of the peer
@@ -171,6 +199,10 @@ struct DcSctpOptions {
   // retransmission scenarios.
   int max_burst = 4;
 
+  // The congestion control algorithm to use.
+  CongestionControlAlgorithm congestion_control_algorithm =
+      CongestionControlAlgorithm::kNewReno;
+
   // Maximum Data Retransmit Attempts (per DATA chunk). Set to absl::nullopt for
   // no limit.
   absl::optional<int> max_retransmissions = 10;
@@ -449,6 +449,15 @@ class DcSctpSocketInterface {
   virtual void SetBufferedAmountLowThreshold(StreamID stream_id,
                                              size_t bytes) = 0;
 
+  // Sets the priority of a stream. When several streams have data to send,
+  // each gets a share of the bandwidth that is proportional to its priority.
+  // Streams default to `DcSctpOptions::default_stream_priority`.
+  virtual void SetStreamPriority(StreamID stream_id,
+                                 StreamPriority priority) = 0;
+
+  // Returns the priority of a stream, see `SetStreamPriority`.
+  virtual StreamPriority GetStreamPriority(StreamID stream_id) const = 0;
+
   // Retrieves the latest metrics.
   virtual Metrics GetMetrics() const = 0;
 
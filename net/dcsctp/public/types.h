@@ -21,6 +21,10 @@ namespace dcsctp {
 // Stream Identifier
 using StreamID = webrtc::StrongAlias<class StreamIDTag, uint16_t>;
 
+// Stream priority. Streams with a higher priority get a proportionally larger
+// share of the send buffer's output when several streams have data to send.
+using StreamPriority = webrtc::StrongAlias<class StreamPriorityTag, uint16_t>;
+
 // Payload Protocol Identifier (PPID)
 using PPID = webrtc::StrongAlias<class PPIDTag, uint32_t>;
 
@@ -203,10 +203,10 @@ void DataTracker::Observe(TSN tsn,
   // "Specifically, an acknowledgement SHOULD be generated for at least
   // every second packet (not every second DATA chunk) received, and SHOULD be
   // generated within 200 ms of the arrival of any unacknowledged DATA chunk."
+  // Packets are counted in `ObservePacketEnd`.
+  packet_needs_ack_ = true;
   if (ack_state_ == AckState::kIdle) {
     UpdateAckState(AckState::kBecomingDelayed, "received DATA when idle");
-  } else if (ack_state_ == AckState::kDelayed) {
-    UpdateAckState(AckState::kImmediate, "received DATA when already delayed");
   }
 }
 
@@ -260,12 +260,10 @@ void DataTracker::HandleForwardTsn(TSN new_cumulative_ack) {
   // "Any time a FORWARD TSN chunk arrives, for the purposes of sending a
   // SACK, the receiver MUST follow the same rules as if a DATA chunk had been
   // received (i.e., follow the delayed sack rules specified in ..."
+  packet_needs_ack_ = true;
   if (ack_state_ == AckState::kIdle) {
     UpdateAckState(AckState::kBecomingDelayed,
                    "received FORWARD_TSN when idle");
-  } else if (ack_state_ == AckState::kDelayed) {
-    UpdateAckState(AckState::kImmediate,
-                   "received FORWARD_TSN when already delayed");
   }
 }
 
@@ -324,6 +322,16 @@ void DataTracker::HandleDelayedAckTimerExpiry() {
 }
 
 void DataTracker::ObservePacketEnd() {
+  if (packet_needs_ack_) {
+    packet_needs_ack_ = false;
+    ++unacked_packets_;
+    if (unacked_packets_ >= sack_frequency_ &&
+        (ack_state_ == AckState::kBecomingDelayed ||
+         ack_state_ == AckState::kDelayed)) {
+      UpdateAckState(AckState::kImmediate, "enough packets to acknowledge");
+      return;
+    }
+  }
   if (ack_state_ == AckState::kBecomingDelayed) {
     UpdateAckState(AckState::kDelayed, "packet end");
   }
@@ -339,6 +347,10 @@ void DataTracker::UpdateAckState(AckState new_state, absl::string_view reason) {
     } else if (new_state == AckState::kDelayed) {
       delayed_ack_timer_.Start();
     }
+    if (new_state == AckState::kIdle) {
+      packet_needs_ack_ = false;
+      unacked_packets_ = 0;
+    }
     ack_state_ = new_state;
   }
 }
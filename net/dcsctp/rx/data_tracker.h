@@ -34,10 +34,10 @@ namespace dcsctp {
 //
 // It only uses TSNs to track delivery and doesn't need to be aware of streams.
 //
-// SACKs are optimally sent every second packet on connections with no packet
-// loss. When packet loss is detected, it's sent for every packet. When SACKs
-// are not sent directly, a timer is used to send a SACK delayed (by RTO/2, or
-// 200ms, whatever is smallest).
+// SACKs are optimally sent every second packet (or every `sack_frequency`
+// packet) on connections with no packet loss. When packet loss is detected,
+// it's sent for every packet. When SACKs are not sent directly, a timer is used
+// to send a SACK delayed (by RTO/2, or 200ms, whatever is smallest).
 class DataTracker {
  public:
   // The maximum number of duplicate TSNs that will be reported in a SACK.
@@ -55,8 +55,10 @@ class DataTracker {
   DataTracker(absl::string_view log_prefix,
               Timer* delayed_ack_timer,
               TSN peer_initial_tsn,
+              int sack_frequency,
               const DcSctpSocketHandoverState* handover_state = nullptr)
       : log_prefix_(std::string(log_prefix) + "dtrack: "),
+        sack_frequency_(sack_frequency),
         seen_packet_(handover_state != nullptr ? handover_state->rx.seen_packet
                                                : false),
         delayed_ack_timer_(*delayed_ack_timer),
@@ -174,10 +176,16 @@ class DataTracker {
   static absl::string_view ToString(AckState ack_state);
 
   const std::string log_prefix_;
+  // The number of packets after which a delayed SACK is sent.
+  const int sack_frequency_;
   // If a packet has ever been seen.
   bool seen_packet_;
   Timer& delayed_ack_timer_;
   AckState ack_state_ = AckState::kIdle;
+  // If the packet being processed has DATA or FORWARD-TSN to acknowledge.
+  bool packet_needs_ack_ = false;
+  // The number of such packets since the last SACK.
+  int unacked_packets_ = 0;
   UnwrappedTSN::Unwrapper tsn_unwrapper_;
 
   // All TSNs up until (and including) this value have been seen.
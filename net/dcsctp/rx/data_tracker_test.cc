@@ -31,6 +31,7 @@ using ::testing::UnorderedElementsAre;
 
 constexpr size_t kArwnd = 10000;
 constexpr TSN kInitialTSN(11);
+constexpr int kSackFrequency = 2;
 
 class DataTrackerTest : public testing::Test {
  protected:
@@ -41,9 +42,10 @@ class DataTrackerTest : public testing::Test {
             "test/delayed_ack",
             []() { return absl::nullopt; },
             TimerOptions(DurationMs(0)))),
-        tracker_(
-            std::make_unique<DataTracker>("log: ", timer_.get(), kInitialTSN)) {
-  }
+        tracker_(std::make_unique<DataTracker>("log: ",
+                                               timer_.get(),
+                                               kInitialTSN,
+                                               kSackFrequency)) {}
 
   void Observer(std::initializer_list<uint32_t> tsns) {
     for (const uint32_t tsn : tsns) {
@@ -57,7 +59,7 @@ class DataTrackerTest : public testing::Test {
     tracker_->AddHandoverState(state);
     g_handover_state_transformer_for_test(&state);
     tracker_ = std::make_unique<DataTracker>("log: ", timer_.get(), kInitialTSN,
-                                             &state);
+                                             kSackFrequency, &state);
   }
 
   TimeMs now_ = TimeMs(0);
@@ -335,6 +337,40 @@ TEST_F(DataTrackerTest, SendsSackEverySecondPacketWhenThereIsNoPacketLoss) {
   EXPECT_FALSE(timer_->is_running());
 }
 
+TEST_F(DataTrackerTest, SendsSackEveryNthPacketWithHigherSackFrequency) {
+  tracker_ = std::make_unique<DataTracker>("log: ", timer_.get(), kInitialTSN,
+                                           /*sack_frequency=*/3);
+  Observer({11});
+  tracker_->ObservePacketEnd();
+  EXPECT_TRUE(tracker_->ShouldSendAck());
+  for (uint32_t tsn = 12; tsn < 20; tsn += 4) {
+    Observer({tsn});
+    tracker_->ObservePacketEnd();
+    EXPECT_FALSE(tracker_->ShouldSendAck());
+    EXPECT_TRUE(timer_->is_running());
+    // A packet with several DATA chunks counts as one.
+    Observer({tsn + 1, tsn + 2});
+    tracker_->ObservePacketEnd();
+    EXPECT_FALSE(tracker_->ShouldSendAck());
+    EXPECT_TRUE(timer_->is_running());
+    Observer({tsn + 3});
+    tracker_->ObservePacketEnd();
+    EXPECT_TRUE(tracker_->ShouldSendAck());
+    EXPECT_FALSE(timer_->is_running());
+  }
+}
+
+TEST_F(DataTrackerTest, SendsSackEveryPacketWithSackFrequencyOne) {
+  tracker_ = std::make_unique<DataTracker>("log: ", timer_.get(), kInitialTSN,
+                                           /*sack_frequency=*/1);
+  for (uint32_t tsn = 11; tsn < 15; ++tsn) {
+    Observer({tsn});
+    tracker_->ObservePacketEnd();
+    EXPECT_TRUE(tracker_->ShouldSendAck());
+    EXPECT_FALSE(timer_->is_running());
+  }
+}
+
 TEST_F(DataTrackerTest, SendsSackEveryPacketOnPacketLoss) {
   Observer({11});
   tracker_->ObservePacketEnd();
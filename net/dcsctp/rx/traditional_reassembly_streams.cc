@@ -105,6 +105,10 @@ TraditionalReassemblyStreams::TraditionalReassemblyStreams(
 int TraditionalReassemblyStreams::UnorderedStream::Add(UnwrappedTSN tsn,
                                                        Data data) {
   int queued_bytes = data.size();
+  if (data.is_beginning && data.is_end && chunks_.find(tsn) == chunks_.end()) {
+    // Fast path - a message in a single chunk needs no reassembly.
+    return queued_bytes - AssembleMessage(tsn, std::move(data));
+  }
   auto p = chunks_.emplace(tsn, std::move(data));
   if (!p.second /* !inserted */) {
     return 0;
@@ -142,12 +146,7 @@ size_t TraditionalReassemblyStreams::StreamBase::AssembleMessage(
 
   if (count == 1) {
     // Fast path - zero-copy
-    const Data& data = start->second;
-    size_t payload_size = start->second.size();
-    UnwrappedTSN tsns[1] = {start->first};
-    DcSctpMessage message(data.stream_id, data.ppid, std::move(data.payload));
-    parent_.on_assembled_message_(tsns, std::move(message));
-    return payload_size;
+    return AssembleMessage(start->first, std::move(start->second));
   }
 
   // Slow path - will need to concatenate the payload.
@@ -173,6 +172,16 @@ size_t TraditionalReassemblyStreams::StreamBase::AssembleMessage(
   return payload_size;
 }
 
+size_t TraditionalReassemblyStreams::StreamBase::AssembleMessage(
+    UnwrappedTSN tsn,
+    Data data) {
+  size_t payload_size = data.size();
+  UnwrappedTSN tsns[1] = {tsn};
+  DcSctpMessage message(data.stream_id, data.ppid, std::move(data.payload));
+  parent_.on_assembled_message_(tsns, std::move(message));
+  return payload_size;
+}
+
 size_t TraditionalReassemblyStreams::UnorderedStream::EraseTo(
     UnwrappedTSN tsn) {
   auto end_iter = chunks_.upper_bound(tsn);
@@ -225,6 +234,14 @@ int TraditionalReassemblyStreams::OrderedStream::Add(UnwrappedTSN tsn,
   int queued_bytes = data.size();
 
   UnwrappedSSN ssn = ssn_unwrapper_.Unwrap(data.ssn);
+  if (ssn == next_ssn_ && data.is_beginning && data.is_end &&
+      (chunks_by_ssn_.empty() || chunks_by_ssn_.begin()->first != ssn)) {
+    // Fast path - the next expected message, in a single chunk, is delivered
+    // without being queued. It may unblock messages queued after it.
+    queued_bytes -= AssembleMessage(tsn, std::move(data));
+    next_ssn_.Increment();
+    return queued_bytes - TryToAssembleMessages();
+  }
   auto p = chunks_by_ssn_[ssn].emplace(tsn, std::move(data));
   if (!p.second /* !inserted */) {
     return 0;
@@ -260,12 +277,20 @@ size_t TraditionalReassemblyStreams::OrderedStream::EraseTo(SSN ssn) {
 }
 
 int TraditionalReassemblyStreams::Add(UnwrappedTSN tsn, Data data) {
+  // Look the stream up before emplacing it, as emplace allocates a node even
+  // if the stream exists.
   if (data.is_unordered) {
-    auto it = unordered_streams_.emplace(data.stream_id, this).first;
+    auto it = unordered_streams_.find(data.stream_id);
+    if (it == unordered_streams_.end()) {
+      it = unordered_streams_.emplace(data.stream_id, this).first;
+    }
     return it->second.Add(tsn, std::move(data));
   }
 
-  auto it = ordered_streams_.emplace(data.stream_id, this).first;
+  auto it = ordered_streams_.find(data.stream_id);
+  if (it == ordered_streams_.end()) {
+    it = ordered_streams_.emplace(data.stream_id, this).first;
+  }
   return it->second.Add(tsn, std::move(data));
 }
 
@@ -57,6 +57,8 @@ class TraditionalReassemblyStreams : public ReassemblyStreams {
 
     size_t AssembleMessage(const ChunkMap::iterator start,
                            const ChunkMap::iterator end);
+    // Delivers `data`, which is a complete message in a single chunk.
+    size_t AssembleMessage(UnwrappedTSN tsn, Data data);
     TraditionalReassemblyStreams& parent_;
   };
 
@@ -25,6 +25,9 @@
 
 namespace dcsctp {
 namespace {
+using ::testing::_;
+using ::testing::ElementsAre;
+using ::testing::InSequence;
 using ::testing::MockFunction;
 using ::testing::NiceMock;
 
@@ -79,6 +82,23 @@ TEST_F(TraditionalReassemblyStreamsTest,
   EXPECT_EQ(streams.Add(tsn(2), std::move(late)), -8);
 }
 
+TEST_F(TraditionalReassemblyStreamsTest,
+       SingleChunkOrderedMessagesAreDeliveredInOrder) {
+  MockFunction<ReassemblyStreams::OnAssembledMessage> on_assembled;
+
+  TraditionalReassemblyStreams streams("", on_assembled.AsStdFunction());
+
+  Data first = gen_.Ordered({1}, "BE");
+  EXPECT_EQ(streams.Add(tsn(2), gen_.Ordered({2, 3}, "BE")), 2);
+
+  InSequence sequence;
+  EXPECT_CALL(on_assembled, Call(ElementsAre(tsn(1)), _));
+  EXPECT_CALL(on_assembled, Call(ElementsAre(tsn(2)), _));
+  EXPECT_CALL(on_assembled, Call(ElementsAre(tsn(3)), _));
+  EXPECT_EQ(streams.Add(tsn(1), std::move(first)), -2);
+  EXPECT_EQ(streams.Add(tsn(3), gen_.Ordered({4}, "BE")), 0);
+}
+
 TEST_F(TraditionalReassemblyStreamsTest,
        DeleteUnorderedMessageReturnsCorrectSize) {
   NiceMock<MockFunction<ReassemblyStreams::OnAssembledMessage>> on_assembled;
@@ -190,7 +190,8 @@ DcSctpSocket::DcSctpSocket(absl::string_view log_prefix,
             callbacks_.OnBufferedAmountLow(stream_id);
           },
           options_.total_buffered_amount_low_threshold,
-          [this]() { callbacks_.OnTotalBufferedAmountLow(); }) {}
+          [this]() { callbacks_.OnTotalBufferedAmountLow(); },
+          options_.default_stream_priority) {}
 
 std::string DcSctpSocket::log_prefix() const {
   return log_prefix_ + "[" + std::string(ToString(state_)) + "] ";
@@ -309,6 +310,9 @@ void DcSctpSocket::RestoreFromState(const DcSctpSocketHandoverState& state) {
     callbacks_.OnError(ErrorKind::kUnsupportedOperation,
                        "Only closed socket can be restored from state");
   } else {
+    TimeMs now = callbacks_.TimeMillis();
+    send_queue_.RestoreFromState(now, state);
+
     if (state.socket_state ==
         DcSctpSocketHandoverState::SocketState::kConnected) {
       VerificationTag my_verification_tag =
@@ -321,8 +325,6 @@ void DcSctpSocket::RestoreFromState(const DcSctpSocketHandoverState& state) {
           state.capabilities.message_interleaving;
       capabilities.reconfig = state.capabilities.reconfig;
 
-      send_queue_.RestoreFromState(state);
-
       tcb_ = std::make_unique<TransmissionControlBlock>(
           timer_manager_, log_prefix_, options_, capabilities, callbacks_,
           send_queue_, my_verification_tag, TSN(state.my_initial_tsn),
@@ -335,6 +337,9 @@ void DcSctpSocket::RestoreFromState(const DcSctpSocketHandoverState& state) {
 
       SetState(State::kEstablished, "restored from handover state");
       callbacks_.OnConnected();
+
+      // Messages that were buffered when the state was created can be sent.
+      tcb_->SendBufferedPackets(now);
     }
   }
 
@@ -531,6 +536,17 @@ void DcSctpSocket::SetBufferedAmountLowThreshold(StreamID stream_id,
   send_queue_.SetBufferedAmountLowThreshold(stream_id, bytes);
 }
 
+void DcSctpSocket::SetStreamPriority(StreamID stream_id,
+                                     StreamPriority priority) {
+  RTC_DCHECK_RUN_ON(&thread_checker_);
+  send_queue_.SetStreamPriority(stream_id, priority);
+}
+
+StreamPriority DcSctpSocket::GetStreamPriority(StreamID stream_id) const {
+  RTC_DCHECK_RUN_ON(&thread_checker_);
+  return send_queue_.GetStreamPriority(stream_id);
+}
+
 Metrics DcSctpSocket::GetMetrics() const {
   RTC_DCHECK_RUN_ON(&thread_checker_);
   Metrics metrics = metrics_;
@@ -695,8 +711,10 @@ void DcSctpSocket::ReceivePacket(rtc::ArrayView<const uint8_t> data) {
     packet_observer_->OnReceivedPacket(callbacks_.TimeMillis(), data);
   }
 
-  absl::optional<SctpPacket> packet =
-      SctpPacket::Parse(data, options_.disable_checksum_verification);
+  // The packet is handled before this method returns, so it can refer to
+  // `data` rather than copy it.
+  absl::optional<SctpPacket> packet = SctpPacket::ParseWithoutCopy(
+      data, options_.disable_checksum_verification);
   if (!packet.has_value()) {
     // https://tools.ietf.org/html/rfc4960#section-6.8
     // "The default procedure for handling invalid SCTP packets is to
@@ -738,7 +756,7 @@ void DcSctpSocket::ReceivePacket(rtc::ArrayView<const uint8_t> data) {
 }
 
 void DcSctpSocket::DebugPrintOutgoing(rtc::ArrayView<const uint8_t> payload) {
-  auto packet = SctpPacket::Parse(payload);
+  auto packet = SctpPacket::ParseWithoutCopy(payload);
   RTC_DCHECK(packet.has_value());
 
   for (const auto& desc : packet->descriptors()) {
@@ -1676,12 +1694,14 @@ DcSctpSocket::GetHandoverStateAndClose() {
 
   DcSctpSocketHandoverState state;
 
+  TimeMs now = callbacks_.TimeMillis();
   if (state_ == State::kClosed) {
     state.socket_state = DcSctpSocketHandoverState::SocketState::kClosed;
+    send_queue_.AddHandoverState(now, state);
   } else if (state_ == State::kEstablished) {
     state.socket_state = DcSctpSocketHandoverState::SocketState::kConnected;
     tcb_->AddHandoverState(state);
-    send_queue_.AddHandoverState(state);
+    send_queue_.AddHandoverState(now, state);
     InternalClose(ErrorKind::kNoError, "handover");
   }
 
@@ -520,5 +520,39 @@ TEST_F(DcSctpSocketNetworkTest, DCSCTP_NDEBUG_TEST(HasHighBandwidth)) {
   double bitrate = receiver.avg_received_bitrate_mbps();
   EXPECT_THAT(bitrate, AllOf(Ge(540), Le(640)));
 }
+
+TEST_F(DcSctpSocketNetworkTest,
+       DCSCTP_NDEBUG_TEST(FillsHighBandwidthDelayProductLink)) {
+  webrtc::BuiltInNetworkBehaviorConfig pipe_config;
+  pipe_config.queue_delay_ms = 100;
+  pipe_config.link_capacity_kbps = 20000;
+  MakeNetwork(pipe_config);
+
+  // Acknowledge every packet and bundle control chunks with DATA, to grow the
+  // congestion window as quickly as possible.
+  options_.sack_frequency = 1;
+  options_.bundle_control_chunks_with_data = true;
+
+  SctpActor sender("A", emulated_socket_a_, options_);
+  SctpActor receiver("Z", emulated_socket_z_, options_);
+  sender.sctp_socket().Connect();
+
+  sender.SetActorMode(ActorMode::kThroughputSender);
+  receiver.SetActorMode(ActorMode::kThroughputReceiver);
+
+  Sleep(kBenchmarkRuntime);
+  sender.SetActorMode(ActorMode::kAtRest);
+  receiver.SetActorMode(ActorMode::kAtRest);
+
+  Sleep(kAWhile);
+
+  sender.sctp_socket().Shutdown();
+
+  Sleep(kAWhile);
+
+  // Verify that the bitrates are in the range of 18-20 Mbps.
+  double bitrate = receiver.avg_received_bitrate_mbps();
+  EXPECT_THAT(bitrate, AllOf(Ge(18), Le(20)));
+}
 }  // namespace
 }  // namespace dcsctp
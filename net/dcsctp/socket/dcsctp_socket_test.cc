@@ -1471,6 +1471,67 @@ TEST_F(DcSctpSocketTest, PassingHighWatermarkWillOnlyAcceptCumAckTsn) {
           .Build());
 }
 
+TEST_F(DcSctpSocketTest, SendsAllMessagesWhenPacedByBbrCongestionControl) {
+  DcSctpOptions options = options_;
+  options.congestion_control_algorithm = CongestionControlAlgorithm::kBbr;
+  testing::NiceMock<MockDcSctpSocketCallbacks> cb_a2("A2");
+  testing::NiceMock<MockDcSctpSocketCallbacks> cb_z2("Z2");
+  DcSctpSocket sock_a2("A2", cb_a2, nullptr, options);
+  DcSctpSocket sock_z2("Z2", cb_z2, nullptr, options);
+
+  sock_a2.Connect();
+  ExchangeMessages(sock_a2, cb_a2, sock_z2, cb_z2);
+  ASSERT_EQ(sock_a2.state(), SocketState::kConnected);
+
+  // Keeps a few messages buffered, sending a new one whenever one is received.
+  constexpr int kMessages = 400;
+  constexpr int kBufferedMessages = 10;
+  auto send_message = [&]() {
+    sock_a2.Send(DcSctpMessage(StreamID(1), PPID(53),
+                               std::vector<uint8_t>(kLargeMessageSize)),
+                 kSendOptions);
+  };
+  int sent = 0;
+  for (; sent < kBufferedMessages; ++sent) {
+    send_message();
+  }
+
+  // Packets are delivered with a one millisecond delay. When the bandwidth
+  // has been estimated, sending is paced and continues also when the pacing
+  // timer expires, and not only when SACKs are received.
+  int received = 0;
+  for (int i = 0; i < 10000 && received < kMessages; ++i) {
+    std::vector<std::vector<uint8_t>> from_a;
+    std::vector<std::vector<uint8_t>> from_z;
+    for (auto p = cb_a2.ConsumeSentPacket(); !p.empty();
+         p = cb_a2.ConsumeSentPacket()) {
+      from_a.push_back(std::move(p));
+    }
+    for (auto p = cb_z2.ConsumeSentPacket(); !p.empty();
+         p = cb_z2.ConsumeSentPacket()) {
+      from_z.push_back(std::move(p));
+    }
+    for (auto& p : from_a) {
+      sock_z2.ReceivePacket(std::move(p));
+    }
+    for (auto& p : from_z) {
+      sock_a2.ReceivePacket(std::move(p));
+    }
+    while (cb_z2.ConsumeReceivedMessage().has_value()) {
+      ++received;
+      if (sent < kMessages) {
+        send_message();
+        ++sent;
+      }
+    }
+    cb_a2.AdvanceTime(DurationMs(1));
+    cb_z2.AdvanceTime(DurationMs(1));
+    RunTimers(cb_a2, sock_a2);
+    RunTimers(cb_z2, sock_z2);
+  }
+  EXPECT_EQ(received, kMessages);
+}
+
 TEST_F(DcSctpSocketTest, SetMaxMessageSize) {
   sock_a_->SetMaxMessageSize(42u);
   EXPECT_EQ(sock_a_->options().max_message_size, 42u);
@@ -2054,6 +2115,45 @@ TEST_F(DcSctpSocketTest, SendMessagesAfterHandover) {
   EXPECT_THAT(msg->payload(), testing::ElementsAre(1, 2, 3));
 }
 
+TEST_F(DcSctpSocketTest, HandsOverSerializedStateWithBufferedMessages) {
+  // Messages sent before connecting are buffered in the send queue.
+  sock_z_->Send(DcSctpMessage(StreamID(1), PPID(53), {1, 2}), kSendOptions);
+  SendOptions unordered_options;
+  unordered_options.unordered = IsUnordered(true);
+  unordered_options.lifetime = DurationMs(10000);
+  sock_z_->Send(DcSctpMessage(StreamID(2), PPID(54), {3, 4, 5}),
+                unordered_options);
+
+  absl::optional<DcSctpSocketHandoverState> handover_state =
+      sock_z_->GetHandoverStateAndClose();
+  ASSERT_TRUE(handover_state.has_value());
+  std::vector<uint8_t> serialized = SerializeHandoverState(*handover_state);
+  absl::optional<DcSctpSocketHandoverState> deserialized =
+      DeserializeHandoverState(serialized);
+  ASSERT_TRUE(deserialized.has_value());
+
+  cb_z_.Reset();
+  sock_z_ = std::make_unique<DcSctpSocket>("Z", cb_z_, GetPacketObserver("Z"),
+                                           options_);
+  sock_z_->RestoreFromState(*deserialized);
+  EXPECT_EQ(sock_z_->buffered_amount(StreamID(1)), 2u);
+  EXPECT_EQ(sock_z_->buffered_amount(StreamID(2)), 3u);
+
+  ConnectSockets();
+  ExchangeMessages(*sock_a_, cb_a_, *sock_z_, cb_z_);
+
+  absl::optional<DcSctpMessage> msg1 = cb_a_.ConsumeReceivedMessage();
+  ASSERT_TRUE(msg1.has_value());
+  EXPECT_EQ(msg1->stream_id(), StreamID(1));
+  EXPECT_THAT(msg1->payload(), testing::ElementsAre(1, 2));
+
+  absl::optional<DcSctpMessage> msg2 = cb_a_.ConsumeReceivedMessage();
+  ASSERT_TRUE(msg2.has_value());
+  EXPECT_EQ(msg2->stream_id(), StreamID(2));
+  EXPECT_EQ(msg2->ppid(), PPID(54));
+  EXPECT_THAT(msg2->payload(), testing::ElementsAre(3, 4, 5));
+}
+
 TEST_F(DcSctpSocketTest, CanDetectDcsctpImplementation) {
   ConnectSockets();
 
@@ -53,6 +53,7 @@ constexpr ReconfigRequestSN kPeerInitialReqSn =
     ReconfigRequestSN(*kPeerInitialTsn);
 constexpr uint32_t kArwnd = 131072;
 constexpr DurationMs kRto = DurationMs(250);
+constexpr int kSackFrequency = 2;
 
 constexpr std::array<uint8_t, 4> kShortPayload = {1, 2, 3, 4};
 
@@ -98,7 +99,8 @@ class StreamResetHandlerTest : public testing::Test {
             TimerOptions(DurationMs(0)))),
         data_tracker_(std::make_unique<DataTracker>("log: ",
                                                     delayed_ack_timer_.get(),
-                                                    kPeerInitialTsn)),
+                                                    kPeerInitialTsn,
+                                                    kSackFrequency)),
         reasm_(std::make_unique<ReassemblyQueue>("log: ",
                                                  kPeerInitialTsn,
                                                  kArwnd)),
@@ -189,8 +191,10 @@ class StreamResetHandlerTest : public testing::Test {
 
     g_handover_state_transformer_for_test(&state);
 
-    data_tracker_ = std::make_unique<DataTracker>(
-        "log: ", delayed_ack_timer_.get(), kPeerInitialTsn, &state);
+    data_tracker_ = std::make_unique<DataTracker>("log: ",
+                                                  delayed_ack_timer_.get(),
+                                                  kPeerInitialTsn,
+                                                  kSackFrequency, &state);
     reasm_ = std::make_unique<ReassemblyQueue>("log: ", kPeerInitialTsn, kArwnd,
                                                &state);
     retransmission_queue_ = std::make_unique<RetransmissionQueue>(
@@ -73,12 +73,25 @@ absl::optional<DurationMs> TransmissionControlBlock::OnDelayedAckTimerExpiry() {
   return absl::nullopt;
 }
 
+absl::optional<DurationMs> TransmissionControlBlock::OnPacingTimerExpiry() {
+  if (!cookie_echo_chunk_.has_value()) {
+    SendBufferedPackets(callbacks_.TimeMillis());
+  }
+  return absl::nullopt;
+}
+
 void TransmissionControlBlock::MaybeSendSack() {
   if (data_tracker_.ShouldSendAck(/*also_if_delayed=*/false)) {
     SctpPacket::Builder builder = PacketBuilder();
     builder.Add(
         data_tracker_.CreateSelectiveAck(reassembly_queue_.remaining_bytes()));
-    Send(builder);
+    if (options_.bundle_control_chunks_with_data &&
+        !cookie_echo_chunk_.has_value()) {
+      // Any DATA chunks that can be sent are bundled with the SACK.
+      SendBufferedPackets(builder, callbacks_.TimeMillis());
+    } else {
+      Send(builder);
+    }
   }
 }
 
@@ -91,7 +104,10 @@ void TransmissionControlBlock::MaybeSendForwardTsn(SctpPacket::Builder& builder,
     } else {
       builder.Add(retransmission_queue_.CreateForwardTsn());
     }
-    packet_sender_.Send(builder);
+    if (!options_.bundle_control_chunks_with_data ||
+        cookie_echo_chunk_.has_value()) {
+      packet_sender_.Send(builder);
+    }
     // https://datatracker.ietf.org/doc/html/rfc3758
     // "IMPLEMENTATION NOTE: An implementation may wish to limit the number of
     // duplicate FORWARD TSN chunks it sends by ... waiting a full RTT before
@@ -104,7 +120,8 @@ void TransmissionControlBlock::MaybeSendForwardTsn(SctpPacket::Builder& builder,
 
 void TransmissionControlBlock::SendBufferedPackets(SctpPacket::Builder& builder,
                                                    TimeMs now) {
-  // FORWARD-TSNs are sent as separate packets to avoid bugs.webrtc.org/12961.
+  // FORWARD-TSNs are by default sent as separate packets to avoid
+  // bugs.webrtc.org/12961.
   MaybeSendForwardTsn(builder, now);
 
   for (int packet_idx = 0;
@@ -161,6 +178,19 @@ void TransmissionControlBlock::SendBufferedPackets(SctpPacket::Builder& builder,
       break;
     }
   }
+
+  // Control chunks that were not bundled with any DATA chunks, e.g. as the
+  // congestion window is full, are sent on their own.
+  packet_sender_.Send(builder);
+
+  // If the congestion control algorithm paces the sent data, continue sending
+  // when allowed, as that may be before the next SACK is received.
+  absl::optional<DurationMs> pacing_delay =
+      retransmission_queue_.GetPacingDelay(now);
+  if (pacing_delay.has_value() && !pacing_timer_->is_running()) {
+    pacing_timer_->set_duration(*pacing_delay);
+    pacing_timer_->Start();
+  }
 }
 
 std::string TransmissionControlBlock::ToString() const {
@@ -79,6 +79,13 @@ class TransmissionControlBlock : public Context {
             TimerOptions(options.delayed_ack_max_timeout,
                          TimerBackoffAlgorithm::kExponential,
                          /*max_restarts=*/0))),
+        pacing_timer_(timer_manager_.CreateTimer(
+            "pacing",
+            absl::bind_front(&TransmissionControlBlock::OnPacingTimerExpiry,
+                             this),
+            TimerOptions(DurationMs(1),
+                         TimerBackoffAlgorithm::kFixed,
+                         /*max_restarts=*/0))),
         my_verification_tag_(my_verification_tag),
         my_initial_tsn_(my_initial_tsn),
         peer_verification_tag_(peer_verification_tag),
@@ -91,6 +98,7 @@ class TransmissionControlBlock : public Context {
         data_tracker_(log_prefix,
                       delayed_ack_timer_.get(),
                       peer_initial_tsn,
+                      options.sack_frequency,
                       handover_state),
         reassembly_queue_(log_prefix,
                           peer_initial_tsn,
@@ -205,6 +213,8 @@ class TransmissionControlBlock : public Context {
   absl::optional<DurationMs> OnRtxTimerExpiry();
   // Will be called when the delayed ack timer expires.
   absl::optional<DurationMs> OnDelayedAckTimerExpiry();
+  // Will be called when the pacing timer expires.
+  absl::optional<DurationMs> OnPacingTimerExpiry();
 
   const std::string log_prefix_;
   const DcSctpOptions options_;
@@ -216,6 +226,8 @@ class TransmissionControlBlock : public Context {
   const std::unique_ptr<Timer> t3_rtx_;
   // Delayed ack timer, which triggers when acks should be sent (when delayed).
   const std::unique_ptr<Timer> delayed_ack_timer_;
+  // Pacing timer, which triggers when paced data may be sent.
+  const std::unique_ptr<Timer> pacing_timer_;
   const VerificationTag my_verification_tag_;
   const TSN my_initial_tsn_;
   const VerificationTag peer_verification_tag_;
@@ -9,88 +9,105 @@
  */
 #include "net/dcsctp/timer/task_queue_timeout.h"
 
+#include <algorithm>
+#include <cstdint>
+
+#include "absl/types/optional.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/task_utils/pending_task_safety_flag.h"
 #include "rtc_base/task_utils/to_queued_task.h"
 
 namespace dcsctp {
 
+TaskQueueTimeoutFactory::~TaskQueueTimeoutFactory() {
+  RTC_DCHECK_RUN_ON(&thread_checker_);
+  RTC_DCHECK(running_timeouts_.empty());
+  pending_task_safety_flag_->SetNotAlive();
+}
+
 TaskQueueTimeoutFactory::TaskQueueTimeout::TaskQueueTimeout(
     TaskQueueTimeoutFactory& parent)
-    : parent_(parent),
-      pending_task_safety_flag_(webrtc::PendingTaskSafetyFlag::Create()) {}
+    : parent_(parent) {}
 
 TaskQueueTimeoutFactory::TaskQueueTimeout::~TaskQueueTimeout() {
   RTC_DCHECK_RUN_ON(&parent_.thread_checker_);
-  pending_task_safety_flag_->SetNotAlive();
+  Stop();
 }
 
 void TaskQueueTimeoutFactory::TaskQueueTimeout::Start(DurationMs duration_ms,
                                                       TimeoutID timeout_id) {
   RTC_DCHECK_RUN_ON(&parent_.thread_checker_);
-  RTC_DCHECK(timeout_expiration_ == TimeMs::InfiniteFuture());
-  timeout_expiration_ = parent_.get_time_() + duration_ms;
+  RTC_DCHECK(!key_.has_value());
+  TimeMs now = parent_.get_time_();
+  key_ = TimeoutKey(now + duration_ms, parent_.next_start_sequence_++);
   timeout_id_ = timeout_id;
+  parent_.running_timeouts_.emplace(*key_, this);
 
-  if (timeout_expiration_ >= posted_task_expiration_) {
-    // There is already a running task, and it's scheduled to expire sooner than
-    // the new expiration time. Don't do anything; The `timeout_expiration_` has
-    // already been updated and if the delayed task _does_ expire and the timer
-    // hasn't been stopped, that will be noticed in the timeout handler, and the
-    // task will be re-scheduled. Most timers are stopped before they expire.
-    return;
+  if (key_->first < parent_.posted_task_expiration_) {
+    parent_.PostTask(now, key_->first);
+  }
+  // Otherwise, there is already a posted task which expires sooner. When it
+  // does, it will post a new task for the next timeout to expire.
+}
+
+void TaskQueueTimeoutFactory::TaskQueueTimeout::Stop() {
+  // As the TaskQueue doesn't support deleting a posted task, the posted task
+  // is left running even if it was posted for this timeout, which is fine as
+  // the task will only expire the timeouts that are due.
+  RTC_DCHECK_RUN_ON(&parent_.thread_checker_);
+  if (key_.has_value()) {
+    parent_.running_timeouts_.erase(*key_);
+    key_ = absl::nullopt;
   }
+}
 
+void TaskQueueTimeoutFactory::PostTask(TimeMs now, TimeMs expiration) {
   if (posted_task_expiration_ != TimeMs::InfiniteFuture()) {
-    RTC_DLOG(LS_VERBOSE) << "New timeout duration is less than scheduled - "
+    RTC_DLOG(LS_VERBOSE) << "New timeout expires before the scheduled one - "
                             "ghosting old delayed task.";
     // There is already a scheduled delayed task, but its expiration time is
     // further away than the new expiration, so it can't be used. It will be
-    // "killed" by replacing the safety flag. This is not expected to happen
-    // especially often; Mainly when a timer did exponential backoff and
-    // later recovered.
+    // "killed" by replacing the safety flag.
     pending_task_safety_flag_->SetNotAlive();
     pending_task_safety_flag_ = webrtc::PendingTaskSafetyFlag::Create();
   }
 
-  posted_task_expiration_ = timeout_expiration_;
-  parent_.task_queue_.PostDelayedTask(
-      webrtc::ToQueuedTask(
-          pending_task_safety_flag_,
-          [timeout_id, this]() {
-            RTC_DLOG(LS_VERBOSE) << "Timout expired: " << timeout_id.value();
-            RTC_DCHECK_RUN_ON(&parent_.thread_checker_);
-            RTC_DCHECK(posted_task_expiration_ != TimeMs::InfiniteFuture());
-            posted_task_expiration_ = TimeMs::InfiniteFuture();
-
-            if (timeout_expiration_ == TimeMs::InfiniteFuture()) {
-              // The timeout was stopped before it expired. Very common.
-            } else {
-              // Note that the timeout might have been restarted, which updated
-              // `timeout_expiration_` but left the scheduled task running. So
-              // if it's not quite time to trigger the timeout yet, schedule a
-              // new delayed task with what's remaining and retry at that point
-              // in time.
-              DurationMs remaining = timeout_expiration_ - parent_.get_time_();
-              timeout_expiration_ = TimeMs::InfiniteFuture();
-              if (*remaining > 0) {
-                Start(remaining, timeout_id_);
-              } else {
-                // It has actually triggered.
-                RTC_DLOG(LS_VERBOSE)
-                    << "Timout triggered: " << timeout_id.value();
-                parent_.on_expired_(timeout_id_);
-              }
-            }
-          }),
-      duration_ms.value());
+  posted_task_expiration_ = expiration;
+  task_queue_.PostDelayedTask(
+      webrtc::ToQueuedTask(pending_task_safety_flag_,
+                           [this]() {
+                             RTC_DCHECK_RUN_ON(&thread_checker_);
+                             HandleTask();
+                           }),
+      std::max(*(expiration - now), 0));
 }
 
-void TaskQueueTimeoutFactory::TaskQueueTimeout::Stop() {
-  // As the TaskQueue doesn't support deleting a posted task, just mark the
-  // timeout as not running.
-  RTC_DCHECK_RUN_ON(&parent_.thread_checker_);
-  timeout_expiration_ = TimeMs::InfiniteFuture();
+void TaskQueueTimeoutFactory::HandleTask() {
+  RTC_DCHECK(posted_task_expiration_ != TimeMs::InfiniteFuture());
+  posted_task_expiration_ = TimeMs::InfiniteFuture();
+  TimeMs now = get_time_();
+
+  // Timeouts that are started when others expire, and which are already due,
+  // are left to the next posted task, to not loop forever if restarting a
+  // timeout with zero duration when it expires.
+  const uint64_t end_sequence = next_start_sequence_;
+  while (!running_timeouts_.empty()) {
+    auto it = running_timeouts_.begin();
+    if (it->first.first > now || it->first.second >= end_sequence) {
+      break;
+    }
+    TaskQueueTimeout& timeout = *it->second;
+    running_timeouts_.erase(it);
+    timeout.key_ = absl::nullopt;
+    RTC_DLOG(LS_VERBOSE) << "Timout triggered: " << timeout.timeout_id_.value();
+    // This may start, stop or delete any timeouts, including this one.
+    on_expired_(timeout.timeout_id_);
+  }
+
+  if (!running_timeouts_.empty() &&
+      running_timeouts_.begin()->first.first < posted_task_expiration_) {
+    PostTask(now, running_timeouts_.begin()->first.first);
+  }
 }
 
 }  // namespace dcsctp
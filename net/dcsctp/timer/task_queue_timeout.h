@@ -10,18 +10,27 @@
 #ifndef NET_DCSCTP_TIMER_TASK_QUEUE_TIMEOUT_H_
 #define NET_DCSCTP_TIMER_TASK_QUEUE_TIMEOUT_H_
 
+#include <cstdint>
+#include <map>
 #include <memory>
 #include <utility>
 
+#include "absl/types/optional.h"
 #include "api/task_queue/task_queue_base.h"
 #include "net/dcsctp/public/timeout.h"
 #include "rtc_base/task_utils/pending_task_safety_flag.h"
 
 namespace dcsctp {
 
-// The TaskQueueTimeoutFactory creates `Timeout` instances, which schedules
-// itself to be triggered on the provided `task_queue`, which may be a thread,
-// an actual TaskQueue or something else which supports posting a delayed task.
+// The TaskQueueTimeoutFactory creates `Timeout` instances, which are triggered
+// on the provided `task_queue`, which may be a thread, an actual TaskQueue or
+// something else which supports posting a delayed task.
+//
+// All timeouts created by a factory are multiplexed on a single delayed task,
+// which is scheduled to run when the earliest running timeout expires. As most
+// timeouts are stopped or restarted before they expire, and as timeouts that
+// expire later than the earliest one don't post any tasks, this avoids posting
+// a delayed task for every started timeout.
 //
 // Note that each `DcSctpSocket` must have its own `TaskQueueTimeoutFactory`,
 // as the `TimeoutID` are not unique among sockets.
@@ -42,7 +51,9 @@ class TaskQueueTimeoutFactory {
                           std::function<void(TimeoutID timeout_id)> on_expired)
       : task_queue_(task_queue),
         get_time_(std::move(get_time)),
-        on_expired_(std::move(on_expired)) {}
+        on_expired_(std::move(on_expired)),
+        pending_task_safety_flag_(webrtc::PendingTaskSafetyFlag::Create()) {}
+  ~TaskQueueTimeoutFactory();
 
   // Creates an implementation of `Timeout`.
   std::unique_ptr<Timeout> CreateTimeout() {
@@ -50,6 +61,10 @@ class TaskQueueTimeoutFactory {
   }
 
  private:
+  // Running timeouts are ordered by their expiration time, and then by when
+  // they were started.
+  using TimeoutKey = std::pair<TimeMs, uint64_t>;
+
   class TaskQueueTimeout : public Timeout {
    public:
     explicit TaskQueueTimeout(TaskQueueTimeoutFactory& parent);
@@ -59,29 +74,41 @@ class TaskQueueTimeoutFactory {
     void Stop() override;
 
    private:
+    friend class TaskQueueTimeoutFactory;
+
     TaskQueueTimeoutFactory& parent_;
-    // A safety flag to ensure that posted tasks to the task queue don't
-    // reference these object when they go out of scope. Note that this safety
-    // flag will be re-created if the scheduled-but-not-yet-expired task is not
-    // to be run. This happens when there is a posted delayed task with an
-    // expiration time _further away_ than what is now the expected expiration
-    // time. In this scenario, a new delayed task has to be posted with a
-    // shorter duration and the old task has to be forgotten.
-    rtc::scoped_refptr<webrtc::PendingTaskSafetyFlag> pending_task_safety_flag_;
-    // The time when the posted delayed task is set to expire. Will be set to
-    // the infinite future if there is no such task running.
-    TimeMs posted_task_expiration_ = TimeMs::InfiniteFuture();
-    // The time when the timeout expires. It will be set to the infinite future
-    // if the timeout is not running/not started.
-    TimeMs timeout_expiration_ = TimeMs::InfiniteFuture();
+    // The key in `running_timeouts_`, if the timeout is running.
+    absl::optional<TimeoutKey> key_;
     // The current timeout ID that will be reported when expired.
     TimeoutID timeout_id_ = TimeoutID(0);
   };
 
+  // Posts a delayed task that expires at `expiration`, replacing any already
+  // posted task.
+  void PostTask(TimeMs now, TimeMs expiration);
+
+  // Called by the posted delayed task, which expires all timeouts that were
+  // due at this time and posts a new task for the next one to expire.
+  void HandleTask();
+
   RTC_NO_UNIQUE_ADDRESS webrtc::SequenceChecker thread_checker_;
   webrtc::TaskQueueBase& task_queue_;
   const std::function<TimeMs()> get_time_;
   const std::function<void(TimeoutID)> on_expired_;
+
+  std::map<TimeoutKey, TaskQueueTimeout*> running_timeouts_;
+  // Incremented for every started timeout.
+  uint64_t next_start_sequence_ = 0;
+  // A safety flag to ensure that posted tasks to the task queue don't
+  // reference this object when it goes out of scope. Note that this safety
+  // flag will be re-created if the posted task is not to be run. This happens
+  // when a timeout is started that expires before the posted task. In this
+  // scenario, a new delayed task has to be posted with a shorter duration and
+  // the old task has to be forgotten.
+  rtc::scoped_refptr<webrtc::PendingTaskSafetyFlag> pending_task_safety_flag_;
+  // The time when the posted delayed task is set to expire. Will be set to
+  // the infinite future if there is no such task running.
+  TimeMs posted_task_expiration_ = TimeMs::InfiniteFuture();
 };
 }  // namespace dcsctp
 
@@ -10,22 +10,49 @@
 #include "net/dcsctp/timer/task_queue_timeout.h"
 
 #include <memory>
+#include <utility>
 
+#include "api/task_queue/queued_task.h"
+#include "api/task_queue/task_queue_base.h"
 #include "rtc_base/gunit.h"
 #include "test/gmock.h"
 #include "test/time_controller/simulated_time_controller.h"
 
 namespace dcsctp {
 namespace {
+using ::testing::InSequence;
 using ::testing::MockFunction;
 
+// Forwards tasks to another task queue, and counts the posted delayed tasks.
+class CountingTaskQueue : public webrtc::TaskQueueBase {
+ public:
+  explicit CountingTaskQueue(webrtc::TaskQueueBase& task_queue)
+      : task_queue_(task_queue) {}
+
+  void Delete() override {}
+  void PostTask(std::unique_ptr<webrtc::QueuedTask> task) override {
+    task_queue_.PostTask(std::move(task));
+  }
+  void PostDelayedTask(std::unique_ptr<webrtc::QueuedTask> task,
+                       uint32_t milliseconds) override {
+    ++delayed_tasks_;
+    task_queue_.PostDelayedTask(std::move(task), milliseconds);
+  }
+
+  int delayed_tasks() const { return delayed_tasks_; }
+
+ private:
+  webrtc::TaskQueueBase& task_queue_;
+  int delayed_tasks_ = 0;
+};
+
 class TaskQueueTimeoutTest : public testing::Test {
  protected:
   TaskQueueTimeoutTest()
       : time_controller_(webrtc::Timestamp::Millis(1234)),
-        task_queue_(time_controller_.GetMainThread()),
+        task_queue_(*time_controller_.GetMainThread()),
         factory_(
-            *task_queue_,
+            task_queue_,
             [this]() {
               return TimeMs(time_controller_.GetClock()->CurrentTime().ms());
             },
@@ -38,7 +65,7 @@ class TaskQueueTimeoutTest : public testing::Test {
   MockFunction<void(TimeoutID)> on_expired_;
   webrtc::GlobalSimulatedTimeController time_controller_;
 
-  rtc::Thread* task_queue_;
+  CountingTaskQueue task_queue_;
   TaskQueueTimeoutFactory factory_;
 };
 
@@ -111,5 +138,94 @@ TEST_F(TaskQueueTimeoutTest, KilledBeforeExpired) {
   EXPECT_CALL(on_expired_, Call).Times(0);
   AdvanceTime(DurationMs(1000));
 }
+
+TEST_F(TaskQueueTimeoutTest, ExpiresMultipleTimeoutsInOrder) {
+  std::unique_ptr<Timeout> timeout1 = factory_.CreateTimeout();
+  std::unique_ptr<Timeout> timeout2 = factory_.CreateTimeout();
+  std::unique_ptr<Timeout> timeout3 = factory_.CreateTimeout();
+  timeout1->Start(DurationMs(1000), TimeoutID(1));
+  timeout2->Start(DurationMs(500), TimeoutID(2));
+  timeout3->Start(DurationMs(1500), TimeoutID(3));
+
+  EXPECT_CALL(on_expired_, Call).Times(0);
+  AdvanceTime(DurationMs(499));
+
+  EXPECT_CALL(on_expired_, Call(TimeoutID(2)));
+  AdvanceTime(DurationMs(1));
+
+  EXPECT_CALL(on_expired_, Call(TimeoutID(1)));
+  AdvanceTime(DurationMs(500));
+
+  EXPECT_CALL(on_expired_, Call(TimeoutID(3)));
+  AdvanceTime(DurationMs(500));
+}
+
+TEST_F(TaskQueueTimeoutTest, ExpiresTimeoutsWithSameExpirationInStartOrder) {
+  std::unique_ptr<Timeout> timeout1 = factory_.CreateTimeout();
+  std::unique_ptr<Timeout> timeout2 = factory_.CreateTimeout();
+  timeout2->Start(DurationMs(1000), TimeoutID(2));
+  timeout1->Start(DurationMs(1000), TimeoutID(1));
+
+  InSequence s;
+  EXPECT_CALL(on_expired_, Call(TimeoutID(2)));
+  EXPECT_CALL(on_expired_, Call(TimeoutID(1)));
+  AdvanceTime(DurationMs(1000));
+}
+
+TEST_F(TaskQueueTimeoutTest, PostsOneDelayedTaskForTimeoutsExpiringLater) {
+  std::unique_ptr<Timeout> timeouts[10];
+  for (int i = 0; i < 10; ++i) {
+    timeouts[i] = factory_.CreateTimeout();
+    timeouts[i]->Start(DurationMs(1000 + i), TimeoutID(i));
+  }
+  EXPECT_EQ(task_queue_.delayed_tasks(), 1);
+
+  // Restarting timeouts, as done when receiving packets, doesn't post tasks.
+  for (int i = 0; i < 10; ++i) {
+    timeouts[i]->Restart(DurationMs(1000 + i), TimeoutID(i));
+  }
+  EXPECT_EQ(task_queue_.delayed_tasks(), 1);
+
+  EXPECT_CALL(on_expired_, Call).Times(10);
+  AdvanceTime(DurationMs(1010));
+}
+
+TEST_F(TaskQueueTimeoutTest, StartingEarlierTimeoutPostsNewTask) {
+  std::unique_ptr<Timeout> timeout1 = factory_.CreateTimeout();
+  std::unique_ptr<Timeout> timeout2 = factory_.CreateTimeout();
+  timeout1->Start(DurationMs(1000), TimeoutID(1));
+  timeout2->Start(DurationMs(100), TimeoutID(2));
+  EXPECT_EQ(task_queue_.delayed_tasks(), 2);
+
+  EXPECT_CALL(on_expired_, Call(TimeoutID(2)));
+  AdvanceTime(DurationMs(100));
+
+  EXPECT_CALL(on_expired_, Call(TimeoutID(1)));
+  AdvanceTime(DurationMs(900));
+}
+
+TEST_F(TaskQueueTimeoutTest, CanRestartTimeoutWhenExpired) {
+  std::unique_ptr<Timeout> timeout = factory_.CreateTimeout();
+  timeout->Start(DurationMs(100), TimeoutID(1));
+
+  EXPECT_CALL(on_expired_, Call(TimeoutID(1))).WillOnce([&](TimeoutID) {
+    timeout->Start(DurationMs(0), TimeoutID(2));
+  });
+  EXPECT_CALL(on_expired_, Call(TimeoutID(2)));
+  AdvanceTime(DurationMs(100));
+}
+
+TEST_F(TaskQueueTimeoutTest, CanDeleteOtherTimeoutWhenExpired) {
+  std::unique_ptr<Timeout> timeout1 = factory_.CreateTimeout();
+  std::unique_ptr<Timeout> timeout2 = factory_.CreateTimeout();
+  timeout1->Start(DurationMs(100), TimeoutID(1));
+  timeout2->Start(DurationMs(100), TimeoutID(2));
+
+  EXPECT_CALL(on_expired_, Call(TimeoutID(1))).WillOnce([&](TimeoutID) {
+    timeout2 = nullptr;
+  });
+  EXPECT_CALL(on_expired_, Call(TimeoutID(2))).Times(0);
+  AdvanceTime(DurationMs(100));
+}
 }  // namespace
 }  // namespace dcsctp
@@ -0,0 +1,235 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "net/dcsctp/tx/bbr_congestion_control.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <string>
+
+#include "absl/algorithm/container.h"
+#include "absl/strings/string_view.h"
+#include "net/dcsctp/public/dcsctp_handover_state.h"
+#include "net/dcsctp/public/dcsctp_options.h"
+#include "net/dcsctp/public/types.h"
+#include "rtc_base/logging.h"
+
+namespace dcsctp {
+namespace {
+// The gain used in startup, 2/ln(2), which doubles the sending rate every
+// round.
+constexpr double kHighGain = 2.885;
+// The pacing gain used when draining the queue built up during startup.
+constexpr double kDrainGain = 1 / kHighGain;
+// The congestion window gain used when probing bandwidth, which allows for
+// delayed and aggregated acknowledgements.
+constexpr double kProbeBandwidthCwndGain = 2;
+// The pacing gains that are cycled through, one per round, when probing
+// bandwidth: first probing for more, then draining any queue that created.
+constexpr double kPacingGainCycle[] = {1.25, 0.75, 1, 1, 1, 1, 1, 1};
+constexpr int kPacingGainCycleLength = std::size(kPacingGainCycle);
+// The bottleneck bandwidth must grow by this factor during three rounds for
+// startup to continue.
+constexpr double kFullBandwidthGrowth = 1.25;
+constexpr int kFullBandwidthRounds = 3;
+// The pacing budget allows sending at least this many packets in a burst, and
+// at least what the pacing rate allows during `kPacingGranularity`, as the
+// sending of paced data is scheduled using millisecond precision timers.
+constexpr size_t kPacingBurstMtus = 2;
+constexpr DurationMs kPacingGranularity = DurationMs(2);
+}  // namespace
+
+BbrCongestionControl::BbrCongestionControl(
+    absl::string_view log_prefix,
+    const DcSctpOptions& options,
+    const DcSctpSocketHandoverState* handover_state)
+    : log_prefix_(std::string(log_prefix)),
+      mtu_(options.mtu),
+      min_cwnd_(options.cwnd_mtus_min * options.mtu),
+      initial_cwnd_(options.cwnd_mtus_initial * options.mtu),
+      cwnd_(handover_state ? handover_state->tx.cwnd : initial_cwnd_),
+      pacing_gain_(kHighGain),
+      cwnd_gain_(kHighGain) {}
+
+size_t BbrCongestionControl::bdp() const {
+  if (!min_rtt_.has_value() || bottleneck_bandwidth_ <= 0) {
+    return initial_cwnd_;
+  }
+  return static_cast<size_t>(bottleneck_bandwidth_ * std::max(**min_rtt_, 1));
+}
+
+double BbrCongestionControl::max_pacing_budget() const {
+  return std::max(static_cast<double>(kPacingBurstMtus * mtu_),
+                  pacing_rate() * *kPacingGranularity);
+}
+
+double BbrCongestionControl::CurrentPacingBudget(TimeMs now) const {
+  DurationMs elapsed = std::max(now - pacing_budget_timestamp_, DurationMs(0));
+  return std::min(max_pacing_budget(),
+                  pacing_budget_ + pacing_rate() * *elapsed);
+}
+
+size_t BbrCongestionControl::PacingBudget(TimeMs now) const {
+  if (pacing_rate() <= 0) {
+    return kNotPaced;
+  }
+  return static_cast<size_t>(std::max(CurrentPacingBudget(now), 0.0));
+}
+
+DurationMs BbrCongestionControl::TimeUntilPacingBudget(TimeMs now,
+                                                       size_t bytes) const {
+  if (pacing_rate() <= 0) {
+    return DurationMs(0);
+  }
+  double missing = std::min(static_cast<double>(bytes), max_pacing_budget()) -
+                   CurrentPacingBudget(now);
+  if (missing <= 0) {
+    return DurationMs(0);
+  }
+  return DurationMs(static_cast<int32_t>(std::min(
+      std::ceil(missing / pacing_rate()), static_cast<double>(*kMinRttWindow))));
+}
+
+void BbrCongestionControl::OnDataSent(TimeMs now, size_t bytes) {
+  if (pacing_rate() <= 0) {
+    pacing_budget_ = 0;
+  } else {
+    // Allow some debt, e.g. when retransmitting without considering pacing,
+    // but not so much that sending is blocked for a long time.
+    pacing_budget_ =
+        std::max(CurrentPacingBudget(now) - bytes, -max_pacing_budget());
+  }
+  pacing_budget_timestamp_ = now;
+}
+
+void BbrCongestionControl::OnNewRtt(TimeMs now, DurationMs rtt) {
+  bool is_first = !min_rtt_.has_value();
+  bool is_expired = !is_first && now - min_rtt_timestamp_ > kMinRttWindow;
+  if (is_expired && mode_ != Mode::kProbeRtt) {
+    EnterProbeRtt(now);
+  }
+  if (is_first || is_expired || rtt <= *min_rtt_) {
+    min_rtt_ = rtt;
+    min_rtt_timestamp_ = now;
+  }
+  if (is_first) {
+    round_start_ = now;
+    round_start_delivered_ = delivered_;
+  }
+}
+
+void BbrCongestionControl::OnBytesAcked(TimeMs now,
+                                        size_t bytes_acked,
+                                        size_t outstanding_bytes) {
+  delivered_ += bytes_acked;
+
+  if (min_rtt_.has_value()) {
+    DurationMs round_duration = std::max(*min_rtt_, kMinRoundDuration);
+    DurationMs elapsed = now - round_start_;
+    if (elapsed >= round_duration) {
+      OnRoundEnd(now, static_cast<double>(delivered_ - round_start_delivered_) /
+                          *elapsed);
+      round_start_ = now;
+      round_start_delivered_ = delivered_;
+    }
+  }
+
+  if (mode_ == Mode::kDrain && outstanding_bytes <= bdp()) {
+    EnterProbeBandwidth(now);
+  } else if (mode_ == Mode::kProbeRtt && now >= probe_rtt_done_) {
+    min_rtt_timestamp_ = now;
+    if (filled_pipe_) {
+      EnterProbeBandwidth(now);
+    } else {
+      RTC_DLOG(LS_VERBOSE) << log_prefix_ << "BBR entering startup";
+      mode_ = Mode::kStartup;
+      pacing_gain_ = kHighGain;
+      cwnd_gain_ = kHighGain;
+    }
+  }
+
+  UpdateCwnd(bytes_acked);
+}
+
+void BbrCongestionControl::OnRoundEnd(TimeMs now, double delivery_rate) {
+  ++round_count_;
+  delivery_rates_[round_count_ % kBandwidthWindowRounds] = delivery_rate;
+  bottleneck_bandwidth_ = *absl::c_max_element(delivery_rates_);
+
+  if (!filled_pipe_) {
+    if (bottleneck_bandwidth_ >= full_bandwidth_ * kFullBandwidthGrowth) {
+      full_bandwidth_ = bottleneck_bandwidth_;
+      full_bandwidth_rounds_ = 0;
+    } else if (++full_bandwidth_rounds_ >= kFullBandwidthRounds) {
+      filled_pipe_ = true;
+      if (mode_ == Mode::kStartup) {
+        RTC_DLOG(LS_VERBOSE) << log_prefix_ << "BBR entering drain, btlbw="
+                             << bottleneck_bandwidth_ << " bytes/ms";
+        mode_ = Mode::kDrain;
+        pacing_gain_ = kDrainGain;
+        cwnd_gain_ = kHighGain;
+      }
+    }
+  }
+
+  if (mode_ == Mode::kProbeBandwidth) {
+    cycle_index_ = (cycle_index_ + 1) % kPacingGainCycleLength;
+    pacing_gain_ = kPacingGainCycle[cycle_index_];
+  }
+}
+
+void BbrCongestionControl::EnterProbeBandwidth(TimeMs now) {
+  RTC_DLOG(LS_VERBOSE) << log_prefix_
+                       << "BBR entering probe bandwidth, btlbw="
+                       << bottleneck_bandwidth_ << " bytes/ms, min_rtt="
+                       << (min_rtt_.has_value() ? **min_rtt_ : -1);
+  mode_ = Mode::kProbeBandwidth;
+  // Start at a cycle phase that neither probes nor drains.
+  cycle_index_ = 2;
+  pacing_gain_ = kPacingGainCycle[cycle_index_];
+  cwnd_gain_ = kProbeBandwidthCwndGain;
+}
+
+void BbrCongestionControl::EnterProbeRtt(TimeMs now) {
+  RTC_DLOG(LS_VERBOSE) << log_prefix_ << "BBR entering probe RTT";
+  mode_ = Mode::kProbeRtt;
+  pacing_gain_ = 1;
+  cwnd_gain_ = 1;
+  probe_rtt_done_ = now + kProbeRttDuration;
+}
+
+void BbrCongestionControl::UpdateCwnd(size_t bytes_acked) {
+  if (mode_ == Mode::kProbeRtt) {
+    cwnd_ = min_cwnd_;
+    return;
+  }
+  size_t target_cwnd =
+      std::max(min_cwnd_, static_cast<size_t>(cwnd_gain_ * bdp()));
+  if (filled_pipe_) {
+    cwnd_ = std::min(cwnd_ + bytes_acked, target_cwnd);
+  } else if (cwnd_ < target_cwnd || delivered_ < initial_cwnd_) {
+    cwnd_ += bytes_acked;
+  }
+  cwnd_ = std::max(cwnd_, min_cwnd_);
+}
+
+void BbrCongestionControl::OnRetransmissionTimeout() {
+  // All outstanding data will be retransmitted, so restart from a small
+  // congestion window, which will grow quickly as data is acknowledged.
+  RTC_DLOG(LS_VERBOSE) << log_prefix_ << "BBR t3-rtx expired, cwnd=" << cwnd_
+                       << " -> " << min_cwnd_;
+  cwnd_ = min_cwnd_;
+}
+
+void BbrCongestionControl::AddHandoverState(
+    DcSctpSocketHandoverState& state) const {
+  state.tx.cwnd = cwnd_;
+}
+}  // namespace dcsctp
@@ -0,0 +1,148 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef NET_DCSCTP_TX_BBR_CONGESTION_CONTROL_H_
+#define NET_DCSCTP_TX_BBR_CONGESTION_CONTROL_H_
+
+#include <stddef.h>
+
+#include <array>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "net/dcsctp/public/dcsctp_handover_state.h"
+#include "net/dcsctp/public/dcsctp_options.h"
+#include "net/dcsctp/public/types.h"
+#include "net/dcsctp/tx/congestion_control.h"
+
+namespace dcsctp {
+
+// A congestion control algorithm modeled after BBR, described in
+// https://datatracker.ietf.org/doc/html/draft-cardwell-iccrg-bbr-congestion-control.
+//
+// Instead of reacting to packet loss, it estimates the bottleneck bandwidth
+// (the maximum delivery rate, measured over the last few round trips) and the
+// minimum RTT (measured over the last ten seconds), and paces sent data at
+// about the bottleneck bandwidth. The congestion window is set to a small
+// multiple of their product, the bandwidth-delay product, which avoids
+// filling the buffers of the bottleneck link, as loss based algorithms do.
+//
+// It's simplified compared to BBR, as rounds are measured in time, as the
+// minimum RTT, and not by the delivery of sent data, and delivery rate samples
+// are not marked as being application limited.
+class BbrCongestionControl : public CongestionControl {
+ public:
+  // The number of rounds over which the bottleneck bandwidth is estimated.
+  static constexpr int kBandwidthWindowRounds = 10;
+  // The duration for which a measured minimum RTT is valid.
+  static constexpr DurationMs kMinRttWindow = DurationMs(10000);
+  // The time spent in the "probe RTT" mode.
+  static constexpr DurationMs kProbeRttDuration = DurationMs(200);
+  // The shortest round, which limits the noise of delivery rate samples.
+  static constexpr DurationMs kMinRoundDuration = DurationMs(10);
+
+  enum class Mode {
+    // Grows the sending rate exponentially to find the bottleneck bandwidth.
+    kStartup,
+    // Drains the queue that was created during startup.
+    kDrain,
+    // Sends at the bottleneck bandwidth, periodically probing for more.
+    kProbeBandwidth,
+    // Reduces the in-flight data to measure the minimum RTT.
+    kProbeRtt,
+  };
+
+  BbrCongestionControl(
+      absl::string_view log_prefix,
+      const DcSctpOptions& options,
+      const DcSctpSocketHandoverState* handover_state = nullptr);
+
+  size_t cwnd() const override { return cwnd_; }
+  void set_cwnd(size_t cwnd) override { cwnd_ = cwnd; }
+  size_t PacingBudget(TimeMs now) const override;
+  DurationMs TimeUntilPacingBudget(TimeMs now, size_t bytes) const override;
+  void OnDataSent(TimeMs now, size_t bytes) override;
+  void OnNewRtt(TimeMs now, DurationMs rtt) override;
+  void OnBytesAcked(TimeMs now,
+                    size_t bytes_acked,
+                    size_t outstanding_bytes) override;
+  void OnCumulativeTsnAckIncreased(TimeMs now,
+                                   size_t outstanding_bytes,
+                                   size_t bytes_acked,
+                                   bool is_in_fast_recovery) override {}
+  void OnPacketLoss() override {}
+  void OnRetransmissionTimeout() override;
+  void AddHandoverState(DcSctpSocketHandoverState& state) const override;
+
+  Mode mode() const { return mode_; }
+
+  // Returns the estimated bottleneck bandwidth, in bytes per millisecond.
+  double bottleneck_bandwidth() const { return bottleneck_bandwidth_; }
+
+  // Returns the rate at which data is sent, in bytes per millisecond, or zero
+  // if not yet known.
+  double pacing_rate() const { return pacing_gain_ * bottleneck_bandwidth_; }
+
+ private:
+  // Returns the estimated bandwidth-delay product, in bytes.
+  size_t bdp() const;
+  // Returns the maximum size of the pacing budget, in bytes.
+  double max_pacing_budget() const;
+  // Returns the pacing budget at `now`, as fractional bytes.
+  double CurrentPacingBudget(TimeMs now) const;
+
+  // Called at the end of every round, with the delivery rate measured during
+  // it, in bytes per millisecond.
+  void OnRoundEnd(TimeMs now, double delivery_rate);
+  void EnterProbeBandwidth(TimeMs now);
+  void EnterProbeRtt(TimeMs now);
+  void UpdateCwnd(size_t bytes_acked);
+
+  const std::string log_prefix_;
+  const size_t mtu_;
+  const size_t min_cwnd_;
+  const size_t initial_cwnd_;
+
+  Mode mode_ = Mode::kStartup;
+  size_t cwnd_;
+  double pacing_gain_;
+  double cwnd_gain_;
+
+  // The maximum delivery rate of each of the last `kBandwidthWindowRounds`
+  // rounds, indexed by `round_count_`, and the maximum of them.
+  std::array<double, kBandwidthWindowRounds> delivery_rates_ = {};
+  double bottleneck_bandwidth_ = 0;
+  int round_count_ = 0;
+  TimeMs round_start_ = TimeMs(0);
+  size_t round_start_delivered_ = 0;
+  // The total number of bytes that have been acknowledged.
+  size_t delivered_ = 0;
+
+  // Bandwidth seen when last growing by at least 25% in startup, and the
+  // number of rounds without such growth since then.
+  double full_bandwidth_ = 0;
+  int full_bandwidth_rounds_ = 0;
+  bool filled_pipe_ = false;
+
+  // The index of the current pacing gain when probing bandwidth.
+  int cycle_index_ = 0;
+
+  absl::optional<DurationMs> min_rtt_;
+  TimeMs min_rtt_timestamp_ = TimeMs(0);
+  TimeMs probe_rtt_done_ = TimeMs(0);
+
+  // Bytes that may be sent, at `pacing_budget_timestamp_`, before being
+  // limited by pacing. It's negative when more than allowed has been sent.
+  double pacing_budget_ = 0;
+  TimeMs pacing_budget_timestamp_ = TimeMs(0);
+};
+}  // namespace dcsctp
+
+#endif  // NET_DCSCTP_TX_BBR_CONGESTION_CONTROL_H_
@@ -0,0 +1,132 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "net/dcsctp/tx/bbr_congestion_control.h"
+
+#include "net/dcsctp/public/dcsctp_handover_state.h"
+#include "net/dcsctp/public/dcsctp_options.h"
+#include "net/dcsctp/tx/congestion_control.h"
+#include "rtc_base/gunit.h"
+#include "test/gmock.h"
+
+namespace dcsctp {
+namespace {
+using ::testing::DoubleNear;
+using Mode = BbrCongestionControl::Mode;
+
+constexpr size_t kMtu = 1000;
+constexpr DurationMs kRtt = DurationMs(50);
+// Bytes acknowledged every millisecond, which is the delivery rate.
+constexpr size_t kBytesPerMs = 100;
+constexpr size_t kOutstandingBytes = 1000;
+
+DcSctpOptions MakeOptions() {
+  DcSctpOptions options;
+  options.mtu = kMtu;
+  options.cwnd_mtus_initial = 10;
+  options.cwnd_mtus_min = 4;
+  return options;
+}
+
+class BbrCongestionControlTest : public testing::Test {
+ protected:
+  BbrCongestionControlTest() : bbr_("log: ", MakeOptions()) {}
+
+  // Acknowledges `kBytesPerMs` every millisecond, during `duration`.
+  void AckDuring(DurationMs duration) {
+    for (int i = 0; i < *duration; ++i) {
+      now_ = now_ + DurationMs(1);
+      bbr_.OnBytesAcked(now_, kBytesPerMs, kOutstandingBytes);
+    }
+  }
+
+  TimeMs now_ = TimeMs(0);
+  BbrCongestionControl bbr_;
+};
+
+TEST_F(BbrCongestionControlTest, IsNotPacedBeforeBandwidthIsEstimated) {
+  EXPECT_EQ(bbr_.mode(), Mode::kStartup);
+  EXPECT_EQ(bbr_.cwnd(), 10 * kMtu);
+  EXPECT_EQ(bbr_.PacingBudget(now_), CongestionControl::kNotPaced);
+
+  bbr_.OnNewRtt(now_, kRtt);
+  EXPECT_EQ(bbr_.PacingBudget(now_), CongestionControl::kNotPaced);
+}
+
+TEST_F(BbrCongestionControlTest, LeavesStartupWhenBandwidthStopsGrowing) {
+  bbr_.OnNewRtt(now_, kRtt);
+  AckDuring(kRtt);
+  EXPECT_EQ(bbr_.mode(), Mode::kStartup);
+  EXPECT_THAT(bbr_.bottleneck_bandwidth(), DoubleNear(kBytesPerMs, 0.01));
+
+  // Three more rounds without bandwidth growth fills the pipe, and as there
+  // is less than the bandwidth-delay product in-flight, nothing to drain.
+  AckDuring(kRtt * 3 + DurationMs(1));
+  EXPECT_EQ(bbr_.mode(), Mode::kProbeBandwidth);
+  EXPECT_THAT(bbr_.pacing_rate(), DoubleNear(kBytesPerMs, 0.01));
+
+  // The congestion window is twice the bandwidth-delay product.
+  EXPECT_EQ(bbr_.cwnd(), 2 * kBytesPerMs * *kRtt);
+}
+
+TEST_F(BbrCongestionControlTest, PacesSentData) {
+  bbr_.OnNewRtt(now_, kRtt);
+  AckDuring(kRtt * 4 + DurationMs(1));
+  ASSERT_EQ(bbr_.mode(), Mode::kProbeBandwidth);
+
+  bbr_.OnDataSent(now_, 10 * kMtu);
+  EXPECT_EQ(bbr_.PacingBudget(now_), 0u);
+
+  // The accumulated debt is limited to the maximum budget of two MTUs, so it
+  // takes 20ms until it's repaid and another 10ms until one MTU may be sent.
+  DurationMs delay = bbr_.TimeUntilPacingBudget(now_, kMtu);
+  EXPECT_EQ(delay, DurationMs(30));
+  EXPECT_LT(bbr_.PacingBudget(now_ + delay - DurationMs(1)), kMtu);
+  EXPECT_GE(bbr_.PacingBudget(now_ + delay), kMtu);
+
+  // The budget is limited, to avoid sending bursts after being idle.
+  EXPECT_EQ(bbr_.PacingBudget(now_ + DurationMs(10000)), 2 * kMtu);
+}
+
+TEST_F(BbrCongestionControlTest, ProbesRttWhenMinRttHasExpired) {
+  bbr_.OnNewRtt(now_, kRtt);
+  AckDuring(kRtt * 4 + DurationMs(1));
+  ASSERT_EQ(bbr_.mode(), Mode::kProbeBandwidth);
+
+  now_ = now_ + BbrCongestionControl::kMinRttWindow;
+  bbr_.OnNewRtt(now_, kRtt * 2);
+  EXPECT_EQ(bbr_.mode(), Mode::kProbeRtt);
+  AckDuring(DurationMs(1));
+  EXPECT_EQ(bbr_.cwnd(), 4 * kMtu);
+
+  // A lower RTT is measured when the queue has been drained.
+  bbr_.OnNewRtt(now_, kRtt);
+  AckDuring(BbrCongestionControl::kProbeRttDuration);
+  EXPECT_EQ(bbr_.mode(), Mode::kProbeBandwidth);
+  // The congestion window grows back by what is acknowledged.
+  AckDuring(kRtt * 2);
+  EXPECT_EQ(bbr_.cwnd(), 2 * kBytesPerMs * *kRtt);
+}
+
+TEST_F(BbrCongestionControlTest, ReducesCwndOnRetransmissionTimeout) {
+  bbr_.OnRetransmissionTimeout();
+  EXPECT_EQ(bbr_.cwnd(), 4 * kMtu);
+}
+
+TEST_F(BbrCongestionControlTest, RestoresCwndFromHandoverState) {
+  bbr_.set_cwnd(12345);
+  DcSctpSocketHandoverState state;
+  bbr_.AddHandoverState(state);
+
+  BbrCongestionControl restored("log: ", MakeOptions(), &state);
+  EXPECT_EQ(restored.cwnd(), 12345u);
+}
+
+}  // namespace
+}  // namespace dcsctp
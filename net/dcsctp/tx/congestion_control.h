@@ -0,0 +1,80 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef NET_DCSCTP_TX_CONGESTION_CONTROL_H_
+#define NET_DCSCTP_TX_CONGESTION_CONTROL_H_
+
+#include <stddef.h>
+
+#include <limits>
+
+#include "net/dcsctp/public/dcsctp_handover_state.h"
+#include "net/dcsctp/public/types.h"
+
+namespace dcsctp {
+
+// A congestion control algorithm, which decides how many bytes may be
+// in-flight (sent, but not yet acknowledged) and optionally how fast they may
+// be sent. It's driven by the `RetransmissionQueue`, which owns the state of
+// all transmitted chunks, and which also handles fast recovery, as that is
+// given by the TSNs that have been sent.
+class CongestionControl {
+ public:
+  // Returned by `PacingBudget` when sending is not paced.
+  static constexpr size_t kNotPaced = std::numeric_limits<size_t>::max();
+
+  virtual ~CongestionControl() = default;
+
+  // Returns the size of the congestion window, in bytes. This is the number of
+  // bytes that may be in-flight.
+  virtual size_t cwnd() const = 0;
+
+  // Overrides the current congestion window size.
+  virtual void set_cwnd(size_t cwnd) = 0;
+
+  // Returns the number of bytes that may be sent at `now`, in addition to what
+  // is limited by the congestion window, or `kNotPaced` if sending isn't paced.
+  virtual size_t PacingBudget(TimeMs now) const = 0;
+
+  // Returns the time from `now` until `PacingBudget` is at least `bytes`.
+  virtual DurationMs TimeUntilPacingBudget(TimeMs now, size_t bytes) const = 0;
+
+  // Called when `bytes` of DATA chunks, new or retransmitted, are sent.
+  virtual void OnDataSent(TimeMs now, size_t bytes) = 0;
+
+  // Called when a new RTT measurement has been done.
+  virtual void OnNewRtt(TimeMs now, DurationMs rtt) = 0;
+
+  // Called when a received SACK has acknowledged `bytes_acked` bytes, either
+  // cumulatively or by gap ack blocks, after which `outstanding_bytes` are
+  // still in-flight.
+  virtual void OnBytesAcked(TimeMs now,
+                            size_t bytes_acked,
+                            size_t outstanding_bytes) = 0;
+
+  // Called when a received SACK has increased the cumulative TSN ack point,
+  // where `outstanding_bytes` were in-flight before the SACK was received and
+  // `bytes_acked` were acknowledged by it.
+  virtual void OnCumulativeTsnAckIncreased(TimeMs now,
+                                           size_t outstanding_bytes,
+                                           size_t bytes_acked,
+                                           bool is_in_fast_recovery) = 0;
+
+  // Called when packet loss has been detected by a received SACK, when not
+  // already in fast recovery.
+  virtual void OnPacketLoss() = 0;
+
+  // Called when the retransmission timer, t3-rtx, has expired.
+  virtual void OnRetransmissionTimeout() = 0;
+
+  virtual void AddHandoverState(DcSctpSocketHandoverState& state) const = 0;
+};
+}  // namespace dcsctp
+
+#endif  // NET_DCSCTP_TX_CONGESTION_CONTROL_H_
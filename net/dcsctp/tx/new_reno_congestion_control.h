@@ -0,0 +1,85 @@
+/*
+ *  Copyright (c) 2021 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef NET_DCSCTP_TX_NEW_RENO_CONGESTION_CONTROL_H_
+#define NET_DCSCTP_TX_NEW_RENO_CONGESTION_CONTROL_H_
+
+#include <stddef.h>
+
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "net/dcsctp/public/dcsctp_handover_state.h"
+#include "net/dcsctp/public/dcsctp_options.h"
+#include "net/dcsctp/public/types.h"
+#include "net/dcsctp/tx/congestion_control.h"
+
+namespace dcsctp {
+
+// The congestion control algorithm described in
+// https://tools.ietf.org/html/rfc4960#section-7.2, which is similar to TCP
+// NewReno, with slow start and congestion avoidance. It's window based and
+// doesn't pace the sent data.
+class NewRenoCongestionControl : public CongestionControl {
+ public:
+  // Creates the algorithm with an initial congestion window given by `options`
+  // and a slow start threshold of `a_rwnd`, or with the state from
+  // `handover_state` if given.
+  NewRenoCongestionControl(
+      absl::string_view log_prefix,
+      const DcSctpOptions& options,
+      size_t a_rwnd,
+      const DcSctpSocketHandoverState* handover_state = nullptr);
+
+  size_t cwnd() const override { return cwnd_; }
+  void set_cwnd(size_t cwnd) override { cwnd_ = cwnd; }
+  size_t PacingBudget(TimeMs now) const override { return kNotPaced; }
+  DurationMs TimeUntilPacingBudget(TimeMs now, size_t bytes) const override {
+    return DurationMs(0);
+  }
+  void OnDataSent(TimeMs now, size_t bytes) override {}
+  void OnNewRtt(TimeMs now, DurationMs rtt) override {}
+  void OnBytesAcked(TimeMs now,
+                    size_t bytes_acked,
+                    size_t outstanding_bytes) override {}
+  void OnCumulativeTsnAckIncreased(TimeMs now,
+                                   size_t outstanding_bytes,
+                                   size_t bytes_acked,
+                                   bool is_in_fast_recovery) override;
+  void OnPacketLoss() override;
+  void OnRetransmissionTimeout() override;
+  void AddHandoverState(DcSctpSocketHandoverState& state) const override;
+
+ private:
+  enum class CongestionAlgorithmPhase {
+    kSlowStart,
+    kCongestionAvoidance,
+  };
+
+  // Returns the current congestion control algorithm phase.
+  CongestionAlgorithmPhase phase() const {
+    return (cwnd_ <= ssthresh_)
+               ? CongestionAlgorithmPhase::kSlowStart
+               : CongestionAlgorithmPhase::kCongestionAvoidance;
+  }
+
+  const std::string log_prefix_;
+  const size_t mtu_;
+  const size_t cwnd_mtus_min_;
+
+  // Congestion Window. Number of bytes that may be in-flight (sent, not acked).
+  size_t cwnd_;
+  // Slow Start Threshold. See RFC4960.
+  size_t ssthresh_;
+  // Partial Bytes Acked. See RFC4960.
+  size_t partial_bytes_acked_;
+};
+}  // namespace dcsctp
+
+#endif  // NET_DCSCTP_TX_NEW_RENO_CONGESTION_CONTROL_H_
@@ -10,6 +10,7 @@
 #include "net/dcsctp/tx/outstanding_data.h"
 
 #include <algorithm>
+#include <map>
 #include <set>
 #include <utility>
 #include <vector>
@@ -30,6 +31,10 @@ size_t OutstandingData::GetSerializedChunkSize(const Data& data) const {
   return RoundUpTo4(data_chunk_header_size_ + data.size());
 }
 
+size_t OutstandingData::GetSerializedChunkSize(const Item& item) const {
+  return RoundUpTo4(data_chunk_header_size_ + item.payload_size());
+}
+
 void OutstandingData::Item::Ack() {
   ack_state_ = AckState::kAcked;
   should_be_retransmitted_ = false;
@@ -63,30 +68,41 @@ void OutstandingData::Item::Retransmit() {
 void OutstandingData::Item::Abandon() {
   is_abandoned_ = true;
   should_be_retransmitted_ = false;
+  // An abandoned chunk will never be sent again.
+  data_.payload = std::vector<uint8_t>();
 }
 
 bool OutstandingData::Item::has_expired(TimeMs now) const {
   return expires_at_ <= now;
 }
 
+size_t OutstandingData::CountUpTo(UnwrappedTSN tsn) const {
+  if (tsn <= last_cumulative_tsn_ack_) {
+    return 0;
+  }
+  return std::min<size_t>(
+      UnwrappedTSN::Difference(tsn, last_cumulative_tsn_ack_),
+      outstanding_data_.size());
+}
+
 bool OutstandingData::IsConsistent() const {
   size_t actual_outstanding_bytes = 0;
   size_t actual_outstanding_items = 0;
 
   std::set<UnwrappedTSN> actual_to_be_retransmitted;
-  for (const auto& elem : outstanding_data_) {
-    if (elem.second.is_outstanding()) {
-      actual_outstanding_bytes += GetSerializedChunkSize(elem.second.data());
+  for (size_t i = 0; i < outstanding_data_.size(); ++i) {
+    const Item& item = outstanding_data_[i];
+    if (item.is_outstanding()) {
+      actual_outstanding_bytes += GetSerializedChunkSize(item);
       ++actual_outstanding_items;
     }
 
-    if (elem.second.should_be_retransmitted()) {
-      actual_to_be_retransmitted.insert(elem.first);
+    if (item.should_be_retransmitted()) {
+      actual_to_be_retransmitted.insert(TsnAt(i));
     }
   }
 
-  if (outstanding_data_.empty() &&
-      next_tsn_ != last_cumulative_tsn_ack_.next_value()) {
+  if (next_tsn_ != TsnAt(outstanding_data_.size())) {
     return false;
   }
 
@@ -96,20 +112,20 @@ bool OutstandingData::IsConsistent() const {
 }
 
 void OutstandingData::AckChunk(AckInfo& ack_info,
-                               std::map<UnwrappedTSN, Item>::iterator iter) {
-  if (!iter->second.is_acked()) {
-    size_t serialized_size = GetSerializedChunkSize(iter->second.data());
+                               UnwrappedTSN tsn,
+                               Item& item) {
+  if (!item.is_acked()) {
+    size_t serialized_size = GetSerializedChunkSize(item);
     ack_info.bytes_acked += serialized_size;
-    if (iter->second.is_outstanding()) {
+    if (item.is_outstanding()) {
       outstanding_bytes_ -= serialized_size;
       --outstanding_items_;
     }
-    if (iter->second.should_be_retransmitted()) {
-      to_be_retransmitted_.erase(iter->first);
+    if (item.should_be_retransmitted()) {
+      to_be_retransmitted_.erase(tsn);
     }
-    iter->second.Ack();
-    ack_info.highest_tsn_acked =
-        std::max(ack_info.highest_tsn_acked, iter->first);
+    item.Ack();
+    ack_info.highest_tsn_acked = std::max(ack_info.highest_tsn_acked, tsn);
   }
 }
 
@@ -134,14 +150,22 @@ OutstandingData::AckInfo OutstandingData::HandleSack(
 
 void OutstandingData::RemoveAcked(UnwrappedTSN cumulative_tsn_ack,
                                   AckInfo& ack_info) {
-  auto first_unacked = outstanding_data_.upper_bound(cumulative_tsn_ack);
+  // The caller has validated that `cumulative_tsn_ack` doesn't go beyond the
+  // outstanding chunks, to keep them consecutive from the new ack point.
+  RTC_DCHECK(cumulative_tsn_ack <= TsnAt(outstanding_data_.size()));
+  const size_t num_acked = CountUpTo(cumulative_tsn_ack);
 
-  for (auto iter = outstanding_data_.begin(); iter != first_unacked; ++iter) {
-    AckChunk(ack_info, iter);
+  for (size_t i = 0; i < num_acked; ++i) {
+    AckChunk(ack_info, TsnAt(i), outstanding_data_[i]);
   }
 
-  outstanding_data_.erase(outstanding_data_.begin(), first_unacked);
-  last_cumulative_tsn_ack_ = cumulative_tsn_ack;
+  // Item isn't assignable, so the acked items are popped rather than erased.
+  for (size_t i = 0; i < num_acked; ++i) {
+    outstanding_data_.pop_front();
+  }
+  if (cumulative_tsn_ack > last_cumulative_tsn_ack_) {
+    last_cumulative_tsn_ack_ = cumulative_tsn_ack;
+  }
 }
 
 void OutstandingData::AckGapBlocks(
@@ -154,12 +178,11 @@ void OutstandingData::AckGapBlocks(
   // handled differently.
 
   for (auto& block : gap_ack_blocks) {
-    auto start = outstanding_data_.lower_bound(
-        UnwrappedTSN::AddTo(cumulative_tsn_ack, block.start));
-    auto end = outstanding_data_.upper_bound(
-        UnwrappedTSN::AddTo(cumulative_tsn_ack, block.end));
-    for (auto iter = start; iter != end; ++iter) {
-      AckChunk(ack_info, iter);
+    size_t start =
+        CountUpTo(UnwrappedTSN::AddTo(cumulative_tsn_ack, block.start - 1));
+    size_t end = CountUpTo(UnwrappedTSN::AddTo(cumulative_tsn_ack, block.end));
+    for (size_t i = start; i < end; ++i) {
+      AckChunk(ack_info, TsnAt(i), outstanding_data_[i]);
     }
   }
 }
@@ -194,11 +217,13 @@ void OutstandingData::NackBetweenAckBlocks(
   for (auto& block : gap_ack_blocks) {
     UnwrappedTSN cur_block_first_acked =
         UnwrappedTSN::AddTo(cumulative_tsn_ack, block.start);
-    for (auto iter = outstanding_data_.upper_bound(prev_block_last_acked);
-         iter != outstanding_data_.lower_bound(cur_block_first_acked); ++iter) {
-      if (iter->first <= max_tsn_to_nack) {
+    size_t start = CountUpTo(prev_block_last_acked);
+    size_t end = CountUpTo(UnwrappedTSN::AddTo(cur_block_first_acked, -1));
+    for (size_t i = start; i < end; ++i) {
+      UnwrappedTSN tsn = TsnAt(i);
+      if (tsn <= max_tsn_to_nack) {
         ack_info.has_packet_loss =
-            NackItem(iter->first, iter->second, /*retransmit_now=*/false);
+            NackItem(tsn, outstanding_data_[i], /*retransmit_now=*/false);
       }
     }
     prev_block_last_acked = UnwrappedTSN::AddTo(cumulative_tsn_ack, block.end);
@@ -214,7 +239,7 @@ bool OutstandingData::NackItem(UnwrappedTSN tsn,
                                Item& item,
                                bool retransmit_now) {
   if (item.is_outstanding()) {
-    outstanding_bytes_ -= GetSerializedChunkSize(item.data());
+    outstanding_bytes_ -= GetSerializedChunkSize(item);
     --outstanding_items_;
   }
 
@@ -250,12 +275,11 @@ void OutstandingData::AbandonAllFor(const Item& item) {
                      item.data().message_id, item.data().fsn, item.data().ppid,
                      std::vector<uint8_t>(), Data::IsBeginning(false),
                      Data::IsEnd(true), item.data().is_unordered);
-    Item& added_item =
-        outstanding_data_
-            .emplace(tsn,
-                     Item(std::move(message_end), MaxRetransmits::NoLimit(),
-                          TimeMs(0), TimeMs::InfiniteFuture()))
-            .first->second;
+    // Appending to the deque keeps `item` valid.
+    outstanding_data_.emplace_back(std::move(message_end), /*payload_size=*/0,
+                                   MaxRetransmits::NoLimit(), TimeMs(0),
+                                   TimeMs::InfiniteFuture());
+    Item& added_item = outstanding_data_.back();
     // The added chunk shouldn't be included in `outstanding_bytes`, so set it
     // as acked.
     added_item.Ack();
@@ -263,9 +287,9 @@ void OutstandingData::AbandonAllFor(const Item& item) {
                          << *tsn.Wrap();
   }
 
-  for (auto& elem : outstanding_data_) {
-    UnwrappedTSN tsn = elem.first;
-    Item& other = elem.second;
+  for (size_t i = 0; i < outstanding_data_.size(); ++i) {
+    UnwrappedTSN tsn = TsnAt(i);
+    Item& other = outstanding_data_[i];
 
     if (!other.is_abandoned() &&
         other.data().stream_id == item.data().stream_id &&
@@ -288,15 +312,15 @@ std::vector<std::pair<TSN, Data>> OutstandingData::GetChunksToBeRetransmitted(
   for (auto it = to_be_retransmitted_.begin();
        it != to_be_retransmitted_.end();) {
     UnwrappedTSN tsn = *it;
-    auto elem = outstanding_data_.find(tsn);
-    RTC_DCHECK(elem != outstanding_data_.end());
-    Item& item = elem->second;
+    RTC_DCHECK(tsn > last_cumulative_tsn_ack_);
+    RTC_DCHECK_LT(CountUpTo(tsn) - 1, outstanding_data_.size());
+    Item& item = outstanding_data_[CountUpTo(tsn) - 1];
     RTC_DCHECK(item.should_be_retransmitted());
     RTC_DCHECK(!item.is_outstanding());
     RTC_DCHECK(!item.is_abandoned());
     RTC_DCHECK(!item.is_acked());
 
-    size_t serialized_size = GetSerializedChunkSize(item.data());
+    size_t serialized_size = GetSerializedChunkSize(item);
     if (serialized_size <= max_size) {
       item.Retransmit();
       result.emplace_back(tsn.Wrap(), item.data().Clone());
@@ -318,9 +342,10 @@ std::vector<std::pair<TSN, Data>> OutstandingData::GetChunksToBeRetransmitted(
 }
 
 void OutstandingData::ExpireOutstandingChunks(TimeMs now) {
-  for (const auto& elem : outstanding_data_) {
-    UnwrappedTSN tsn = elem.first;
-    const Item& item = elem.second;
+  // AbandonAllFor may append to `outstanding_data_`, so iterate by index.
+  for (size_t i = 0; i < outstanding_data_.size(); ++i) {
+    UnwrappedTSN tsn = TsnAt(i);
+    const Item& item = outstanding_data_[i];
 
     // Chunks that are nacked can be expired. Care should be taken not to expire
     // unacked (in-flight) chunks as they might have been received, but the SACK
@@ -342,7 +367,7 @@ void OutstandingData::ExpireOutstandingChunks(TimeMs now) {
 
 UnwrappedTSN OutstandingData::highest_outstanding_tsn() const {
   return outstanding_data_.empty() ? last_cumulative_tsn_ack_
-                                   : outstanding_data_.rbegin()->first;
+                                   : TsnAt(outstanding_data_.size() - 1);
 }
 
 absl::optional<UnwrappedTSN> OutstandingData::Insert(
@@ -357,18 +382,24 @@ absl::optional<UnwrappedTSN> OutstandingData::Insert(
   size_t chunk_size = GetSerializedChunkSize(data);
   outstanding_bytes_ += chunk_size;
   ++outstanding_items_;
-  auto it = outstanding_data_
-                .emplace(tsn, Item(data.Clone(), max_retransmissions, time_sent,
-                                   expires_at))
-                .first;
-
-  if (it->second.has_expired(time_sent)) {
+  // A chunk that can't be retransmitted is only needed to track if it's acked
+  // or lost, so there is no need to copy its payload.
+  outstanding_data_.emplace_back(
+      *max_retransmissions == 0
+          ? Data(data.stream_id, data.ssn, data.message_id, data.fsn, data.ppid,
+                 std::vector<uint8_t>(), data.is_beginning, data.is_end,
+                 data.is_unordered)
+          : data.Clone(),
+      data.size(), max_retransmissions, time_sent, expires_at);
+  const Item& item = outstanding_data_.back();
+
+  if (item.has_expired(time_sent)) {
     // No need to send it - it was expired when it was in the send
     // queue.
-    RTC_DLOG(LS_VERBOSE) << "Marking freshly produced chunk "
-                         << *it->first.Wrap() << " and message "
-                         << *it->second.data().message_id << " as expired";
-    AbandonAllFor(it->second);
+    RTC_DLOG(LS_VERBOSE) << "Marking freshly produced chunk " << *tsn.Wrap()
+                         << " and message " << *item.data().message_id
+                         << " as expired";
+    AbandonAllFor(item);
     RTC_DCHECK(IsConsistent());
     return absl::nullopt;
   }
@@ -378,11 +409,11 @@ absl::optional<UnwrappedTSN> OutstandingData::Insert(
 }
 
 void OutstandingData::NackAll() {
-  for (auto& elem : outstanding_data_) {
-    UnwrappedTSN tsn = elem.first;
-    Item& item = elem.second;
+  // NackItem may append to `outstanding_data_`, so iterate by index.
+  for (size_t i = 0; i < outstanding_data_.size(); ++i) {
+    Item& item = outstanding_data_[i];
     if (!item.is_acked()) {
-      NackItem(tsn, item, /*retransmit_now=*/true);
+      NackItem(TsnAt(i), item, /*retransmit_now=*/true);
     }
   }
   RTC_DCHECK(IsConsistent());
@@ -390,14 +421,15 @@ void OutstandingData::NackAll() {
 
 absl::optional<DurationMs> OutstandingData::MeasureRTT(TimeMs now,
                                                        UnwrappedTSN tsn) const {
-  auto it = outstanding_data_.find(tsn);
-  if (it != outstanding_data_.end() && !it->second.has_been_retransmitted()) {
+  const size_t count = CountUpTo(tsn);
+  if (tsn > last_cumulative_tsn_ack_ && TsnAt(count - 1) == tsn &&
+      !outstanding_data_[count - 1].has_been_retransmitted()) {
     // https://tools.ietf.org/html/rfc4960#section-6.3.1
     // "Karn's algorithm: RTT measurements MUST NOT be made using
     // packets that were retransmitted (and thus for which it is ambiguous
     // whether the reply was for the first instance of the chunk or for a
     // later instance)"
-    return now - it->second.time_sent();
+    return now - outstanding_data_[count - 1].time_sent();
   }
   return absl::nullopt;
 }
@@ -406,30 +438,39 @@ std::vector<std::pair<TSN, OutstandingData::State>>
 OutstandingData::GetChunkStatesForTesting() const {
   std::vector<std::pair<TSN, State>> states;
   states.emplace_back(last_cumulative_tsn_ack_.Wrap(), State::kAcked);
-  for (const auto& elem : outstanding_data_) {
+  for (size_t i = 0; i < outstanding_data_.size(); ++i) {
+    const Item& item = outstanding_data_[i];
     State state;
-    if (elem.second.is_abandoned()) {
+    if (item.is_abandoned()) {
       state = State::kAbandoned;
-    } else if (elem.second.should_be_retransmitted()) {
+    } else if (item.should_be_retransmitted()) {
       state = State::kToBeRetransmitted;
-    } else if (elem.second.is_acked()) {
+    } else if (item.is_acked()) {
       state = State::kAcked;
-    } else if (elem.second.is_outstanding()) {
+    } else if (item.is_outstanding()) {
       state = State::kInFlight;
     } else {
       state = State::kNacked;
     }
 
-    states.emplace_back(elem.first.Wrap(), state);
+    states.emplace_back(TsnAt(i).Wrap(), state);
   }
   return states;
 }
 
 bool OutstandingData::ShouldSendForwardTsn() const {
-  if (!outstanding_data_.empty()) {
-    auto it = outstanding_data_.begin();
-    return it->first == last_cumulative_tsn_ack_.next_value() &&
-           it->second.is_abandoned();
+  // The first chunk is always the one right after the cumulative ack point.
+  return !outstanding_data_.empty() && outstanding_data_.front().is_abandoned();
+}
+
+bool OutstandingData::ForwardTsnSkipsOrderedMessages() const {
+  for (const Item& item : outstanding_data_) {
+    if (!item.is_abandoned()) {
+      break;
+    }
+    if (!item.data().is_unordered) {
+      return true;
+    }
   }
   return false;
 }
@@ -438,14 +479,13 @@ ForwardTsnChunk OutstandingData::CreateForwardTsn() const {
   std::map<StreamID, SSN> skipped_per_ordered_stream;
   UnwrappedTSN new_cumulative_ack = last_cumulative_tsn_ack_;
 
-  for (const auto& elem : outstanding_data_) {
-    UnwrappedTSN tsn = elem.first;
-    const Item& item = elem.second;
+  for (size_t i = 0; i < outstanding_data_.size(); ++i) {
+    const Item& item = outstanding_data_[i];
 
-    if ((tsn != new_cumulative_ack.next_value()) || !item.is_abandoned()) {
+    if (!item.is_abandoned()) {
       break;
     }
-    new_cumulative_ack = tsn;
+    new_cumulative_ack = TsnAt(i);
     if (!item.data().is_unordered &&
         item.data().ssn > skipped_per_ordered_stream[item.data().stream_id]) {
       skipped_per_ordered_stream[item.data().stream_id] = item.data().ssn;
@@ -464,14 +504,13 @@ IForwardTsnChunk OutstandingData::CreateIForwardTsn() const {
   std::map<std::pair<IsUnordered, StreamID>, MID> skipped_per_stream;
   UnwrappedTSN new_cumulative_ack = last_cumulative_tsn_ack_;
 
-  for (const auto& elem : outstanding_data_) {
-    UnwrappedTSN tsn = elem.first;
-    const Item& item = elem.second;
+  for (size_t i = 0; i < outstanding_data_.size(); ++i) {
+    const Item& item = outstanding_data_[i];
 
-    if ((tsn != new_cumulative_ack.next_value()) || !item.is_abandoned()) {
+    if (!item.is_abandoned()) {
       break;
     }
-    new_cumulative_ack = tsn;
+    new_cumulative_ack = TsnAt(i);
     std::pair<IsUnordered, StreamID> stream_id =
         std::make_pair(item.data().is_unordered, item.data().stream_id);
 
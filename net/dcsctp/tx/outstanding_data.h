@@ -10,7 +10,7 @@
 #ifndef NET_DCSCTP_TX_OUTSTANDING_DATA_H_
 #define NET_DCSCTP_TX_OUTSTANDING_DATA_H_
 
-#include <map>
+#include <deque>
 #include <set>
 #include <utility>
 #include <vector>
@@ -108,7 +108,9 @@ class OutstandingData {
 
   // Schedules `data` to be sent, with the provided partial reliability
   // parameters. Returns the TSN if the item was actually added and scheduled to
-  // be sent, and absl::nullopt if it shouldn't be sent.
+  // be sent, and absl::nullopt if it shouldn't be sent. The payload isn't
+  // retained for chunks that will never be retransmitted, as when
+  // `max_retransmissions` is zero.
   absl::optional<UnwrappedTSN> Insert(const Data& data,
                                       MaxRetransmits max_retransmissions,
                                       TimeMs time_sent,
@@ -136,6 +138,11 @@ class OutstandingData {
   // abandoned, which means that a FORWARD-TSN should be sent.
   bool ShouldSendForwardTsn() const;
 
+  // Returns true if the FORWARD-TSN that would be created skips an ordered
+  // message, which blocks the receiver from delivering later messages on that
+  // stream until the FORWARD-TSN has been received.
+  bool ForwardTsnSkipsOrderedMessages() const;
+
  private:
   // A fragmented message's DATA chunk while in the retransmission queue, and
   // its associated metadata.
@@ -147,19 +154,28 @@ class OutstandingData {
       kAbandon,
     };
 
+    // Creates an item for `data`, whose payload is `payload_size` bytes, but
+    // which may have been left out of `data` if it will never be needed.
     explicit Item(Data data,
+                  size_t payload_size,
                   MaxRetransmits max_retransmissions,
                   TimeMs time_sent,
                   TimeMs expires_at)
-        : max_retransmissions_(max_retransmissions),
+        : payload_size_(payload_size),
+          max_retransmissions_(max_retransmissions),
           time_sent_(time_sent),
           expires_at_(expires_at),
           data_(std::move(data)) {}
 
     TimeMs time_sent() const { return time_sent_; }
 
+    // The chunk's data, whose payload is only present if the chunk may be
+    // retransmitted.
     const Data& data() const { return data_; }
 
+    // The size of the payload, when it was sent.
+    size_t payload_size() const { return payload_size_; }
+
     // Acks an item.
     void Ack();
 
@@ -173,7 +189,7 @@ class OutstandingData {
     // clears all nack counters.
     void Retransmit();
 
-    // Marks this item as abandoned.
+    // Marks this item as abandoned, and frees its payload.
     void Abandon();
 
     bool is_outstanding() const { return ack_state_ == AckState::kUnacked; }
@@ -209,6 +225,7 @@ class OutstandingData {
     uint8_t nack_count_ = 0;
     // The number of times the DATA chunk has been retransmitted.
     uint16_t num_retransmissions_ = 0;
+    const size_t payload_size_;
     // If the message was sent with a maximum number of retransmissions, this is
     // set to that number. The value zero (0) means that it will never be
     // retransmitted.
@@ -224,6 +241,7 @@ class OutstandingData {
 
   // Returns how large a chunk will be, serialized, carrying the data
   size_t GetSerializedChunkSize(const Data& data) const;
+  size_t GetSerializedChunkSize(const Item& item) const;
 
   // Given a `cumulative_tsn_ack` from an incoming SACK, will remove those items
   // in the retransmission queue up until this value and will update `ack_info`
@@ -246,9 +264,19 @@ class OutstandingData {
       bool is_in_fast_recovery,
       OutstandingData::AckInfo& ack_info);
 
-  // Acks the chunk referenced by `iter` and updates state in `ack_info` and the
-  // object's state.
-  void AckChunk(AckInfo& ack_info, std::map<UnwrappedTSN, Item>::iterator iter);
+  // Acks the chunk `item`, with TSN `tsn`, and updates state in `ack_info` and
+  // the object's state.
+  void AckChunk(AckInfo& ack_info, UnwrappedTSN tsn, Item& item);
+
+  // Returns the TSN of the item at `index` in `outstanding_data_`.
+  UnwrappedTSN TsnAt(size_t index) const {
+    return UnwrappedTSN::AddTo(last_cumulative_tsn_ack_,
+                               static_cast<int>(index) + 1);
+  }
+
+  // Returns the number of items in `outstanding_data_` with a TSN up to and
+  // including `tsn`, which is also the index of the first item after it.
+  size_t CountUpTo(UnwrappedTSN tsn) const;
 
   // Helper method to nack an item and perform the correct operations given the
   // action indicated when nacking an item (e.g. retransmitting or abandoning).
@@ -272,7 +300,12 @@ class OutstandingData {
   // Callback when to discard items from the send queue.
   std::function<bool(IsUnordered, StreamID, MID)> discard_from_send_queue_;
 
-  std::map<UnwrappedTSN, Item> outstanding_data_;
+  // The chunks with TSNs from `last_cumulative_tsn_ack_` + 1 to `next_tsn_` -
+  // 1, which are always consecutive, so that the chunk with TSN
+  // `last_cumulative_tsn_ack_` + 1 + i is at index i. That makes finding a
+  // chunk by TSN constant time, and removing the ones acked by a SACK cheaper
+  // than with a tree.
+  std::deque<Item> outstanding_data_;
   // The number of bytes that are in-flight (sent but not yet acked or nacked).
   size_t outstanding_bytes_ = 0;
   // The number of DATA chunks that are in-flight (sent but not yet acked or
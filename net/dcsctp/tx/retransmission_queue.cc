@@ -14,6 +14,7 @@
 #include <functional>
 #include <iterator>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <utility>
@@ -36,6 +37,9 @@
 #include "net/dcsctp/public/dcsctp_options.h"
 #include "net/dcsctp/public/types.h"
 #include "net/dcsctp/timer/timer.h"
+#include "net/dcsctp/tx/bbr_congestion_control.h"
+#include "net/dcsctp/tx/congestion_control.h"
+#include "net/dcsctp/tx/new_reno_congestion_control.h"
 #include "net/dcsctp/tx/outstanding_data.h"
 #include "net/dcsctp/tx/send_queue.h"
 #include "rtc_base/checks.h"
@@ -47,6 +51,21 @@ namespace {
 
 // Allow sending only slightly less than an MTU, to account for headers.
 constexpr float kMinBytesRequiredToSendFactor = 0.9;
+
+std::unique_ptr<CongestionControl> CreateCongestionControl(
+    absl::string_view log_prefix,
+    const DcSctpOptions& options,
+    size_t a_rwnd,
+    const DcSctpSocketHandoverState* handover_state) {
+  switch (options.congestion_control_algorithm) {
+    case CongestionControlAlgorithm::kNewReno:
+      return std::make_unique<NewRenoCongestionControl>(
+          log_prefix, options, a_rwnd, handover_state);
+    case CongestionControlAlgorithm::kBbr:
+      return std::make_unique<BbrCongestionControl>(log_prefix, options,
+                                                    handover_state);
+  }
+}
 }  // namespace
 
 RetransmissionQueue::RetransmissionQueue(
@@ -72,16 +91,9 @@ RetransmissionQueue::RetransmissionQueue(
       on_clear_retransmission_counter_(
           std::move(on_clear_retransmission_counter)),
       t3_rtx_(t3_rtx),
-      cwnd_(handover_state ? handover_state->tx.cwnd
-                           : options_.cwnd_mtus_initial * options_.mtu),
       rwnd_(handover_state ? handover_state->tx.rwnd : a_rwnd),
-      // https://tools.ietf.org/html/rfc4960#section-7.2.1
-      // "The initial value of ssthresh MAY be arbitrarily high (for
-      // example, implementations MAY use the size of the receiver advertised
-      // window).""
-      ssthresh_(handover_state ? handover_state->tx.ssthresh : rwnd_),
-      partial_bytes_acked_(
-          handover_state ? handover_state->tx.partial_bytes_acked : 0),
+      congestion_control_(
+          CreateCongestionControl(log_prefix_, options, rwnd_, handover_state)),
       send_queue_(send_queue),
       outstanding_data_(
           data_chunk_header_size_,
@@ -118,78 +130,13 @@ void RetransmissionQueue::MaybeExitFastRecovery(
   }
 }
 
-void RetransmissionQueue::HandleIncreasedCumulativeTsnAck(
-    size_t outstanding_bytes,
-    size_t total_bytes_acked) {
-  // Allow some margin for classifying as fully utilized, due to e.g. that too
-  // small packets (less than kMinimumFragmentedPayload) are not sent +
-  // overhead.
-  bool is_fully_utilized = outstanding_bytes + options_.mtu >= cwnd_;
-  size_t old_cwnd = cwnd_;
-  if (phase() == CongestionAlgorithmPhase::kSlowStart) {
-    if (is_fully_utilized && !is_in_fast_recovery()) {
-      // https://tools.ietf.org/html/rfc4960#section-7.2.1
-      // "Only when these three conditions are met can the cwnd be
-      // increased; otherwise, the cwnd MUST not be increased. If these
-      // conditions are met, then cwnd MUST be increased by, at most, the
-      // lesser of 1) the total size of the previously outstanding DATA
-      // chunk(s) acknowledged, and 2) the destination's path MTU."
-      cwnd_ += std::min(total_bytes_acked, options_.mtu);
-      RTC_DLOG(LS_VERBOSE) << log_prefix_ << "SS increase cwnd=" << cwnd_
-                           << " (" << old_cwnd << ")";
-    }
-  } else if (phase() == CongestionAlgorithmPhase::kCongestionAvoidance) {
-    // https://tools.ietf.org/html/rfc4960#section-7.2.2
-    // "Whenever cwnd is greater than ssthresh, upon each SACK arrival
-    // that advances the Cumulative TSN Ack Point, increase
-    // partial_bytes_acked by the total number of bytes of all new chunks
-    // acknowledged in that SACK including chunks acknowledged by the new
-    // Cumulative TSN Ack and by Gap Ack Blocks."
-    size_t old_pba = partial_bytes_acked_;
-    partial_bytes_acked_ += total_bytes_acked;
-
-    if (partial_bytes_acked_ >= cwnd_ && is_fully_utilized) {
-      // https://tools.ietf.org/html/rfc4960#section-7.2.2
-      // "When partial_bytes_acked is equal to or greater than cwnd and
-      // before the arrival of the SACK the sender had cwnd or more bytes of
-      // data outstanding (i.e., before arrival of the SACK, flightsize was
-      // greater than or equal to cwnd), increase cwnd by MTU, and reset
-      // partial_bytes_acked to (partial_bytes_acked - cwnd)."
-
-      // Errata: https://datatracker.ietf.org/doc/html/rfc8540#section-3.12
-      partial_bytes_acked_ -= cwnd_;
-      cwnd_ += options_.mtu;
-      RTC_DLOG(LS_VERBOSE) << log_prefix_ << "CA increase cwnd=" << cwnd_
-                           << " (" << old_cwnd << ") ssthresh=" << ssthresh_
-                           << ", pba=" << partial_bytes_acked_ << " ("
-                           << old_pba << ")";
-    } else {
-      RTC_DLOG(LS_VERBOSE) << log_prefix_ << "CA unchanged cwnd=" << cwnd_
-                           << " (" << old_cwnd << ") ssthresh=" << ssthresh_
-                           << ", pba=" << partial_bytes_acked_ << " ("
-                           << old_pba << ")";
-    }
-  }
-}
-
 void RetransmissionQueue::HandlePacketLoss(UnwrappedTSN highest_tsn_acked) {
   if (!is_in_fast_recovery()) {
     // https://tools.ietf.org/html/rfc4960#section-7.2.4
     // "If not in Fast Recovery, adjust the ssthresh and cwnd of the
     // destination address(es) to which the missing DATA chunks were last
     // sent, according to the formula described in Section 7.2.3."
-    size_t old_cwnd = cwnd_;
-    size_t old_pba = partial_bytes_acked_;
-    ssthresh_ = std::max(cwnd_ / 2, options_.cwnd_mtus_min * options_.mtu);
-    cwnd_ = ssthresh_;
-    partial_bytes_acked_ = 0;
-
-    RTC_DLOG(LS_VERBOSE) << log_prefix_
-                         << "packet loss detected (not fast recovery). cwnd="
-                         << cwnd_ << " (" << old_cwnd
-                         << "), ssthresh=" << ssthresh_
-                         << ", pba=" << partial_bytes_acked_ << " (" << old_pba
-                         << ")";
+    congestion_control_->OnPacketLoss();
 
     // https://tools.ietf.org/html/rfc4960#section-7.2.4
     // "If not in Fast Recovery, enter Fast Recovery and mark the highest
@@ -303,8 +250,9 @@ bool RetransmissionQueue::HandleSack(TimeMs now, const SackChunk& sack) {
     // Note: It may be started again in a bit further down.
     t3_rtx_.Stop();
 
-    HandleIncreasedCumulativeTsnAck(old_outstanding_bytes,
-                                    ack_info.bytes_acked);
+    congestion_control_->OnCumulativeTsnAckIncreased(
+        now, old_outstanding_bytes, ack_info.bytes_acked,
+        is_in_fast_recovery());
   }
 
   if (ack_info.has_packet_loss) {
@@ -316,6 +264,8 @@ bool RetransmissionQueue::HandleSack(TimeMs now, const SackChunk& sack) {
   // "When an outstanding TSN is acknowledged [...] the endpoint shall clear
   // the error counter ..."
   if (ack_info.bytes_acked > 0) {
+    congestion_control_->OnBytesAcked(now, ack_info.bytes_acked,
+                                      outstanding_data_.outstanding_bytes());
     on_clear_retransmission_counter_();
   }
 
@@ -338,20 +288,18 @@ void RetransmissionQueue::UpdateRTT(TimeMs now,
       outstanding_data_.MeasureRTT(now, cumulative_tsn_ack);
 
   if (rtt.has_value()) {
+    congestion_control_->OnNewRtt(now, *rtt);
     on_new_rtt_(*rtt);
   }
 }
 
 void RetransmissionQueue::HandleT3RtxTimerExpiry() {
-  size_t old_cwnd = cwnd_;
+  size_t old_cwnd = cwnd();
   size_t old_outstanding_bytes = outstanding_bytes();
   // https://tools.ietf.org/html/rfc4960#section-6.3.3
   // "For the destination address for which the timer expires, adjust
   // its ssthresh with rules defined in Section 7.2.3 and set the cwnd <- MTU."
-  ssthresh_ = std::max(cwnd_ / 2, 4 * options_.mtu);
-  cwnd_ = 1 * options_.mtu;
-  // Errata: https://datatracker.ietf.org/doc/html/rfc8540#section-3.11
-  partial_bytes_acked_ = 0;
+  congestion_control_->OnRetransmissionTimeout();
 
   // https://tools.ietf.org/html/rfc4960#section-6.3.3
   // "For the destination address for which the timer expires, set RTO
@@ -379,9 +327,9 @@ void RetransmissionQueue::HandleT3RtxTimerExpiry() {
 
   // Already done by the Timer implementation.
 
-  RTC_DLOG(LS_INFO) << log_prefix_ << "t3-rtx expired. new cwnd=" << cwnd_
-                    << " (" << old_cwnd << "), ssthresh=" << ssthresh_
-                    << ", outstanding_bytes " << outstanding_bytes() << " ("
+  RTC_DLOG(LS_INFO) << log_prefix_ << "t3-rtx expired. new cwnd=" << cwnd()
+                    << " (" << old_cwnd << "), outstanding_bytes "
+                    << outstanding_bytes() << " ("
                     << old_outstanding_bytes << ")";
   RTC_DCHECK(IsConsistent());
 }
@@ -417,8 +365,9 @@ std::vector<std::pair<TSN, Data>> RetransmissionQueue::GetChunksToSend(
     // allowed to be sent), and fill that up first with chunks that are
     // scheduled to be retransmitted. If there is still budget, send new chunks
     // (which will have their TSN assigned here.)
-    size_t max_bytes =
-        RoundDownTo4(std::min(max_bytes_to_send(), bytes_remaining_in_packet));
+    size_t max_bytes = RoundDownTo4(
+        std::min({max_bytes_to_send(), congestion_control_->PacingBudget(now),
+                  bytes_remaining_in_packet}));
 
     to_be_sent = outstanding_data_.GetChunksToBeRetransmitted(max_bytes);
     max_bytes -= absl::c_accumulate(
@@ -453,6 +402,11 @@ std::vector<std::pair<TSN, Data>> RetransmissionQueue::GetChunksToSend(
   }
 
   if (!to_be_sent.empty()) {
+    congestion_control_->OnDataSent(
+        now, absl::c_accumulate(to_be_sent, 0,
+                                [&](size_t r, const std::pair<TSN, Data>& d) {
+                                  return r + GetSerializedChunkSize(d.second);
+                                }));
     // https://tools.ietf.org/html/rfc4960#section-6.3.2
     // "Every time a DATA chunk is sent to any address (including a
     // retransmission), if the T3-rtx timer of that address is not running,
@@ -473,7 +427,7 @@ std::vector<std::pair<TSN, Data>> RetransmissionQueue::GetChunksToSend(
                                   return r + GetSerializedChunkSize(d.second);
                                 })
                          << " bytes. outstanding_bytes=" << outstanding_bytes()
-                         << " (" << old_outstanding_bytes << "), cwnd=" << cwnd_
+                         << " (" << old_outstanding_bytes << "), cwnd=" << cwnd()
                          << ", rwnd=" << rwnd_ << " (" << old_rwnd << ")";
   }
   RTC_DCHECK(IsConsistent());
@@ -481,22 +435,58 @@ std::vector<std::pair<TSN, Data>> RetransmissionQueue::GetChunksToSend(
 }
 
 bool RetransmissionQueue::can_send_data() const {
-  return cwnd_ < options_.avoid_fragmentation_cwnd_mtus * options_.mtu ||
+  return cwnd() < options_.avoid_fragmentation_cwnd_mtus * options_.mtu ||
          max_bytes_to_send() >= min_bytes_required_to_send_;
 }
 
+absl::optional<DurationMs> RetransmissionQueue::GetPacingDelay(
+    TimeMs now) const {
+  if (!can_send_data() || (send_queue_.total_buffered_amount() == 0 &&
+                           !outstanding_data_.has_data_to_be_retransmitted())) {
+    // Sending is limited by the congestion window, and will continue when a
+    // SACK has been received, or there is nothing to send.
+    return absl::nullopt;
+  }
+  size_t bytes_required = std::min(min_bytes_required_to_send_,
+                                   std::max(max_bytes_to_send(), size_t{1}));
+  if (congestion_control_->PacingBudget(now) >= bytes_required) {
+    return absl::nullopt;
+  }
+  return std::max(
+      congestion_control_->TimeUntilPacingBudget(now, bytes_required),
+      DurationMs(1));
+}
+
 bool RetransmissionQueue::ShouldSendForwardTsn(TimeMs now) {
   if (!partial_reliability_) {
     return false;
   }
   outstanding_data_.ExpireOutstandingChunks(now);
-  bool ret = outstanding_data_.ShouldSendForwardTsn();
+  if (!outstanding_data_.ShouldSendForwardTsn()) {
+    forward_tsn_delayed_since_ = absl::nullopt;
+    return false;
+  }
+
+  // Abandoned unordered messages don't block the delivery of other messages,
+  // so as long as the receiver will SACK other data in-flight, which gives a
+  // new chance to send it, the FORWARD-TSN can be delayed to be batched.
+  if (!outstanding_data_.ForwardTsnSkipsOrderedMessages() &&
+      outstanding_data_.outstanding_items() > 0) {
+    if (!forward_tsn_delayed_since_.has_value()) {
+      forward_tsn_delayed_since_ = now;
+    }
+    if (now - *forward_tsn_delayed_since_ < kMaxUnorderedForwardTsnDelay) {
+      return false;
+    }
+  }
+  forward_tsn_delayed_since_ = absl::nullopt;
   RTC_DCHECK(IsConsistent());
-  return ret;
+  return true;
 }
 
 size_t RetransmissionQueue::max_bytes_to_send() const {
-  size_t left = outstanding_bytes() >= cwnd_ ? 0 : cwnd_ - outstanding_bytes();
+  size_t left =
+      outstanding_bytes() >= cwnd() ? 0 : cwnd() - outstanding_bytes();
 
   if (outstanding_bytes() == 0) {
     // https://datatracker.ietf.org/doc/html/rfc4960#section-6.1
@@ -544,8 +534,6 @@ HandoverReadinessStatus RetransmissionQueue::GetHandoverReadiness() const {
 void RetransmissionQueue::AddHandoverState(DcSctpSocketHandoverState& state) {
   state.tx.next_tsn = next_tsn().value();
   state.tx.rwnd = rwnd_;
-  state.tx.cwnd = cwnd_;
-  state.tx.ssthresh = ssthresh_;
-  state.tx.partial_bytes_acked = partial_bytes_acked_;
+  congestion_control_->AddHandoverState(state);
 }
 }  // namespace dcsctp
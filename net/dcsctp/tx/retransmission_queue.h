@@ -13,6 +13,7 @@
 #include <cstdint>
 #include <functional>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <utility>
@@ -29,6 +30,7 @@
 #include "net/dcsctp/public/dcsctp_handover_state.h"
 #include "net/dcsctp/public/dcsctp_options.h"
 #include "net/dcsctp/timer/timer.h"
+#include "net/dcsctp/tx/congestion_control.h"
 #include "net/dcsctp/tx/outstanding_data.h"
 #include "net/dcsctp/tx/retransmission_timeout.h"
 #include "net/dcsctp/tx/send_queue.h"
@@ -42,7 +44,8 @@ namespace dcsctp {
 //
 // As congestion control is tightly connected with the state of transmitted
 // packets, that's also managed here to limit the amount of data that is
-// in-flight (sent, but not yet acknowledged).
+// in-flight (sent, but not yet acknowledged), using the `CongestionControl`
+// algorithm selected by `DcSctpOptions::congestion_control_algorithm`.
 class RetransmissionQueue {
  public:
   static constexpr size_t kMinimumFragmentedPayload = 10;
@@ -95,10 +98,10 @@ class RetransmissionQueue {
 
   // Returns the size of the congestion window, in bytes. This is the number of
   // bytes that may be in-flight.
-  size_t cwnd() const { return cwnd_; }
+  size_t cwnd() const { return congestion_control_->cwnd(); }
 
   // Overrides the current congestion window size.
-  void set_cwnd(size_t cwnd) { cwnd_ = cwnd; }
+  void set_cwnd(size_t cwnd) { congestion_control_->set_cwnd(cwnd); }
 
   // Returns the current receiver window size.
   size_t rwnd() const { return rwnd_; }
@@ -116,11 +119,26 @@ class RetransmissionQueue {
   // Indicates if the congestion control algorithm allows data to be sent.
   bool can_send_data() const;
 
+  // Returns the time until pacing allows data to be sent, if sending is paced
+  // and there is data to send that's only held back by pacing. The caller
+  // should then try to send data again after this duration.
+  absl::optional<DurationMs> GetPacingDelay(TimeMs now) const;
+
   // Given the current time `now`, it will evaluate if there are chunks that
   // have expired and that need to be discarded. It returns true if a
-  // FORWARD-TSN should be sent.
+  // FORWARD-TSN should be sent. When only unordered messages would be skipped
+  // by it, and there is other data in-flight, it's delayed for up to
+  // `kMaxUnorderedForwardTsnDelay`, so that more abandoned chunks can be
+  // skipped by a single FORWARD-TSN.
   bool ShouldSendForwardTsn(TimeMs now);
 
+  // How long a FORWARD-TSN that only skips unordered messages may be delayed.
+  // https://datatracker.ietf.org/doc/html/rfc3758#section-3.5 says "Any delay
+  // applied to the sending of FORWARD TSN chunk SHOULD NOT exceed 200ms and
+  // MUST NOT exceed 500ms", and the delay is only checked when receiving
+  // SACKs, which are themselves delayed by at most 200ms.
+  static constexpr DurationMs kMaxUnorderedForwardTsnDelay = DurationMs(200);
+
   // Creates a FORWARD-TSN chunk.
   ForwardTsnChunk CreateForwardTsn() const {
     return outstanding_data_.CreateForwardTsn();
@@ -143,11 +161,6 @@ class RetransmissionQueue {
   void AddHandoverState(DcSctpSocketHandoverState& state);
 
  private:
-  enum class CongestionAlgorithmPhase {
-    kSlowStart,
-    kCongestionAvoidance,
-  };
-
   bool IsConsistent() const;
 
   // Returns how large a chunk will be, serialized, carrying the data
@@ -165,7 +178,8 @@ class RetransmissionQueue {
   bool IsSackValid(const SackChunk& sack) const;
 
   // When a SACK chunk is received, this method will be called which _may_ call
-  // into the `RetransmissionTimeout` to update the RTO.
+  // into the `RetransmissionTimeout` to update the RTO, and which informs the
+  // congestion control algorithm.
   void UpdateRTT(TimeMs now, UnwrappedTSN cumulative_tsn_ack);
 
   // If the congestion control is in "fast recovery mode", this may be exited
@@ -176,10 +190,6 @@ class RetransmissionQueue {
   void StopT3RtxTimerOnIncreasedCumulativeTsnAck(
       UnwrappedTSN cumulative_tsn_ack);
 
-  // Update the congestion control algorithm given as the cumulative ack TSN
-  // value has increased, as reported in an incoming SACK chunk.
-  void HandleIncreasedCumulativeTsnAck(size_t outstanding_bytes,
-                                       size_t total_bytes_acked);
   // Update the congestion control algorithm, given as packet loss has been
   // detected, as reported in an incoming SACK chunk.
   void HandlePacketLoss(UnwrappedTSN highest_tsn_acked);
@@ -189,15 +199,8 @@ class RetransmissionQueue {
   // is running.
   void StartT3RtxTimerIfOutstandingData();
 
-  // Returns the current congestion control algorithm phase.
-  CongestionAlgorithmPhase phase() const {
-    return (cwnd_ <= ssthresh_)
-               ? CongestionAlgorithmPhase::kSlowStart
-               : CongestionAlgorithmPhase::kCongestionAvoidance;
-  }
-
   // Returns the number of bytes that may be sent in a single packet according
-  // to the congestion control algorithm.
+  // to the congestion control algorithm, not considering pacing.
   size_t max_bytes_to_send() const;
 
   const DcSctpOptions options_;
@@ -218,19 +221,17 @@ class RetransmissionQueue {
   // Unwraps TSNs
   UnwrappedTSN::Unwrapper tsn_unwrapper_;
 
-  // Congestion Window. Number of bytes that may be in-flight (sent, not acked).
-  size_t cwnd_;
   // Receive Window. Number of bytes available in the receiver's RX buffer.
   size_t rwnd_;
-  // Slow Start Threshold. See RFC4960.
-  size_t ssthresh_;
-  // Partial Bytes Acked. See RFC4960.
-  size_t partial_bytes_acked_;
+  // Decides the congestion window and the pacing of sent data.
+  const std::unique_ptr<CongestionControl> congestion_control_;
   // If set, fast recovery is enabled until this TSN has been cumulative
   // acked.
   absl::optional<UnwrappedTSN> fast_recovery_exit_tsn_ = absl::nullopt;
   // Indicates if the congestion algorithm is in fast retransmit.
   bool is_in_fast_retransmit_ = false;
+  // When a FORWARD-TSN that only skips unordered messages was first delayed.
+  absl::optional<TimeMs> forward_tsn_delayed_since_ = absl::nullopt;
 
   // The send queue.
   SendQueue& send_queue_;
@@ -737,6 +737,78 @@ TEST_F(RetransmissionQueueTest, ProducesValidIForwardTsn) {
                                IsUnordered(false), StreamID(3), MID(42))));
 }
 
+TEST_F(RetransmissionQueueTest,
+       DelaysForwardTsnSkippingOnlyUnorderedMessages) {
+  RetransmissionQueue queue = CreateQueue();
+  EXPECT_CALL(producer_, Produce)
+      .WillRepeatedly([this](TimeMs, size_t) {
+        SendQueue::DataToSend dts(gen_.Unordered({1, 2, 3, 4}, "BE"));
+        dts.max_retransmissions = MaxRetransmits(0);
+        return dts;
+      });
+
+  std::vector<std::pair<TSN, Data>> chunks_to_send =
+      queue.GetChunksToSend(now_, 5 * 20);
+  EXPECT_THAT(chunks_to_send,
+              ElementsAre(Pair(TSN(10), _), Pair(TSN(11), _), Pair(TSN(12), _),
+                          Pair(TSN(13), _), Pair(TSN(14), _)));
+
+  // TSN 10 is lost, and as it can't be retransmitted, it's abandoned.
+  queue.HandleSack(
+      now_, SackChunk(TSN(9), kArwnd, {SackChunk::GapAckBlock(2, 2)}, {}));
+  queue.HandleSack(
+      now_, SackChunk(TSN(9), kArwnd, {SackChunk::GapAckBlock(2, 3)}, {}));
+  queue.HandleSack(
+      now_, SackChunk(TSN(9), kArwnd, {SackChunk::GapAckBlock(2, 4)}, {}));
+  EXPECT_THAT(queue.GetChunkStatesForTesting(),
+              ElementsAre(Pair(TSN(9), State::kAcked),       //
+                          Pair(TSN(10), State::kAbandoned),  //
+                          Pair(TSN(11), State::kAcked),      //
+                          Pair(TSN(12), State::kAcked),      //
+                          Pair(TSN(13), State::kAcked),      //
+                          Pair(TSN(14), State::kInFlight)));
+
+  // As TSN 14 is still in-flight, the FORWARD-TSN is delayed.
+  EXPECT_FALSE(queue.ShouldSendForwardTsn(now_));
+  now_ += RetransmissionQueue::kMaxUnorderedForwardTsnDelay - DurationMs(1);
+  EXPECT_FALSE(queue.ShouldSendForwardTsn(now_));
+  now_ += DurationMs(1);
+  EXPECT_TRUE(queue.ShouldSendForwardTsn(now_));
+  EXPECT_EQ(queue.CreateForwardTsn().new_cumulative_tsn(), TSN(10));
+}
+
+TEST_F(RetransmissionQueueTest,
+       SendsForwardTsnSkippingUnorderedMessagesWhenNothingInFlight) {
+  RetransmissionQueue queue = CreateQueue();
+  EXPECT_CALL(producer_, Produce)
+      .WillRepeatedly([this](TimeMs, size_t) {
+        SendQueue::DataToSend dts(gen_.Unordered({1, 2, 3, 4}, "BE"));
+        dts.max_retransmissions = MaxRetransmits(0);
+        return dts;
+      });
+
+  std::vector<std::pair<TSN, Data>> chunks_to_send =
+      queue.GetChunksToSend(now_, 4 * 20);
+  EXPECT_THAT(chunks_to_send, ElementsAre(Pair(TSN(10), _), Pair(TSN(11), _),
+                                          Pair(TSN(12), _), Pair(TSN(13), _)));
+
+  queue.HandleSack(
+      now_, SackChunk(TSN(9), kArwnd, {SackChunk::GapAckBlock(2, 2)}, {}));
+  queue.HandleSack(
+      now_, SackChunk(TSN(9), kArwnd, {SackChunk::GapAckBlock(2, 3)}, {}));
+  queue.HandleSack(
+      now_, SackChunk(TSN(9), kArwnd, {SackChunk::GapAckBlock(2, 4)}, {}));
+  EXPECT_THAT(queue.GetChunkStatesForTesting(),
+              ElementsAre(Pair(TSN(9), State::kAcked),       //
+                          Pair(TSN(10), State::kAbandoned),  //
+                          Pair(TSN(11), State::kAcked),      //
+                          Pair(TSN(12), State::kAcked),      //
+                          Pair(TSN(13), State::kAcked)));
+
+  EXPECT_TRUE(queue.ShouldSendForwardTsn(now_));
+  EXPECT_EQ(queue.CreateForwardTsn().new_cumulative_tsn(), TSN(10));
+}
+
 TEST_F(RetransmissionQueueTest, MeasureRTT) {
   RetransmissionQueue queue = CreateQueue(/*use_message_interleaving=*/true);
   EXPECT_CALL(producer_, Produce)
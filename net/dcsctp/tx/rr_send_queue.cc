@@ -9,6 +9,7 @@
  */
 #include "net/dcsctp/tx/rr_send_queue.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <deque>
 #include <limits>
@@ -33,9 +34,11 @@ RRSendQueue::RRSendQueue(absl::string_view log_prefix,
                          std::function<void(StreamID)> on_buffered_amount_low,
                          size_t total_buffered_amount_low_threshold,
                          std::function<void()> on_total_buffered_amount_low,
+                         StreamPriority default_priority,
                          const DcSctpSocketHandoverState* handover_state)
     : log_prefix_(std::string(log_prefix) + "fcfs: "),
       buffer_size_(buffer_size),
+      default_priority_(default_priority),
       on_buffered_amount_low_(std::move(on_buffered_amount_low)),
       total_buffered_amount_(std::move(on_total_buffered_amount_low)) {
   total_buffered_amount_.SetLowThreshold(total_buffered_amount_low_threshold);
@@ -67,29 +70,70 @@ bool RRSendQueue::OutgoingStream::HasDataToSend(TimeMs now) {
   return false;
 }
 
+bool RRSendQueue::OutgoingStream::ShouldBeScheduled() const {
+  return !items_.empty() && (!is_paused_ || has_partially_sent_message());
+}
+
+RRSendQueue::VirtualTime RRSendQueue::OutgoingStream::NextMessageDuration()
+    const {
+  RTC_DCHECK(!items_.empty());
+  // Scaled, so that small messages on high priority streams don't take zero
+  // time.
+  return (VirtualTime{items_.front().remaining_size} << 16) /
+         std::max<uint16_t>(*priority_, 1);
+}
+
 void RRSendQueue::OutgoingStream::AddHandoverState(
+    TimeMs now,
     DcSctpSocketHandoverState::OutgoingStream& state) const {
   state.next_ssn = next_ssn_.value();
   state.next_ordered_mid = next_ordered_mid_.value();
   state.next_unordered_mid = next_unordered_mid_.value();
+  state.priority = *priority_;
+  for (const Item& item : items_) {
+    RTC_DCHECK(!item.message_id.has_value());
+    if (item.expires_at <= now) {
+      continue;
+    }
+    DcSctpSocketHandoverState::OutgoingMessage message;
+    message.ppid = *item.message.ppid();
+    message.unordered = *item.send_options.unordered;
+    // The lifetime is stored as relative to `now`, as the socket may be
+    // restored in a process with a different clock.
+    if (item.expires_at != TimeMs::InfiniteFuture()) {
+      message.lifetime_ms = *(item.expires_at - now) - 1;
+    }
+    if (item.send_options.max_retransmissions.has_value()) {
+      message.max_retransmissions =
+          static_cast<uint32_t>(*item.send_options.max_retransmissions);
+    }
+    message.payload.assign(item.message.payload().begin(),
+                           item.message.payload().end());
+    state.messages.push_back(std::move(message));
+  }
 }
 
 bool RRSendQueue::IsConsistent() const {
   size_t total_buffered_amount = 0;
   for (const auto& stream_entry : streams_) {
-    total_buffered_amount += stream_entry.second.buffered_amount().value();
+    const OutgoingStream& stream = stream_entry.second;
+    total_buffered_amount += stream.buffered_amount().value();
+    if (stream.ShouldBeScheduled() && !stream.schedule_key().has_value()) {
+      RTC_DLOG(LS_ERROR) << "Stream has data to send, but isn't scheduled";
+      return false;
+    }
   }
 
   if (previous_message_has_ended_) {
-    auto it = streams_.find(current_stream_id_);
-    if (it != streams_.end() && it->second.has_partially_sent_message()) {
+    if (current_stream_ != nullptr &&
+        current_stream_->has_partially_sent_message()) {
       RTC_DLOG(LS_ERROR)
           << "Previous message has ended, but still partial message in stream";
       return false;
     }
   } else {
-    auto it = streams_.find(current_stream_id_);
-    if (it == streams_.end() || !it->second.has_partially_sent_message()) {
+    if (current_stream_ == nullptr ||
+        !current_stream_->has_partially_sent_message()) {
       RTC_DLOG(LS_ERROR)
           << "Previous message has NOT ended, but there is no partial message";
       return false;
@@ -293,8 +337,9 @@ void RRSendQueue::Add(TimeMs now,
     // lifetime (which may be zero).
     expires_at = now + *send_options.lifetime + DurationMs(1);
   }
-  GetOrCreateStreamInfo(message.stream_id())
-      .Add(std::move(message), expires_at, send_options);
+  OutgoingStream& stream = GetOrCreateStreamInfo(message.stream_id());
+  stream.Add(std::move(message), expires_at, send_options);
+  MaybeScheduleStream(stream);
   RTC_DCHECK(IsConsistent());
 }
 
@@ -306,35 +351,56 @@ bool RRSendQueue::IsEmpty() const {
   return total_buffered_amount() == 0;
 }
 
-std::map<StreamID, RRSendQueue::OutgoingStream>::iterator
-RRSendQueue::GetNextStream(TimeMs now) {
-  auto start_it = streams_.lower_bound(StreamID(*current_stream_id_ + 1));
+void RRSendQueue::MaybeScheduleStream(OutgoingStream& stream) {
+  if (stream.schedule_key().has_value() || !stream.ShouldBeScheduled()) {
+    return;
+  }
+  // The message starts when both the message currently sent, and the stream's
+  // previous message, have started and finished respectively.
+  VirtualTime start_time =
+      std::max(virtual_time_, stream.virtual_finish_time());
+  stream.set_virtual_finish_time(start_time + stream.NextMessageDuration());
+  ScheduleKey key(start_time, schedule_sequence_++);
+  scheduled_streams_.emplace(key, &stream);
+  stream.set_schedule_key(key);
+}
 
-  for (auto it = start_it; it != streams_.end(); ++it) {
-    if (it->second.HasDataToSend(now)) {
-      current_stream_id_ = it->first;
-      return it;
-    }
+void RRSendQueue::UnscheduleStream(OutgoingStream& stream) {
+  if (stream.schedule_key().has_value()) {
+    scheduled_streams_.erase(*stream.schedule_key());
+    stream.set_schedule_key(absl::nullopt);
   }
+}
+
+void RRSendQueue::RescheduleStream(OutgoingStream& stream) {
+  UnscheduleStream(stream);
+  MaybeScheduleStream(stream);
+}
 
-  for (auto it = streams_.begin(); it != start_it; ++it) {
-    if (it->second.HasDataToSend(now)) {
-      current_stream_id_ = it->first;
-      return it;
+RRSendQueue::OutgoingStream* RRSendQueue::GetNextStream(TimeMs now) {
+  while (!scheduled_streams_.empty()) {
+    auto it = scheduled_streams_.begin();
+    OutgoingStream& stream = *it->second;
+    if (stream.HasDataToSend(now)) {
+      virtual_time_ = it->first.first;
+      current_stream_ = &stream;
+      return &stream;
     }
+    // All its messages have expired.
+    UnscheduleStream(stream);
   }
-  return streams_.end();
+  return nullptr;
 }
 
 absl::optional<SendQueue::DataToSend> RRSendQueue::Produce(TimeMs now,
                                                            size_t max_size) {
-  std::map<StreamID, RRSendQueue::OutgoingStream>::iterator stream_it;
+  OutgoingStream* stream;
 
   if (previous_message_has_ended_) {
-    // Previous message has ended. Round-robin to a different stream, if there
-    // even is one with data to send.
-    stream_it = GetNextStream(now);
-    if (stream_it == streams_.end()) {
+    // Previous message has ended. Schedule the next stream, if there even is
+    // one with data to send.
+    stream = GetNextStream(now);
+    if (stream == nullptr) {
       RTC_DLOG(LS_VERBOSE)
           << log_prefix_
           << "There is no stream with data; Can't produce any data.";
@@ -342,11 +408,11 @@ absl::optional<SendQueue::DataToSend> RRSendQueue::Produce(TimeMs now,
     }
   } else {
     // The previous message has not ended; Continue from the current stream.
-    stream_it = streams_.find(current_stream_id_);
-    RTC_DCHECK(stream_it != streams_.end());
+    stream = current_stream_;
+    RTC_DCHECK(stream != nullptr);
   }
 
-  absl::optional<DataToSend> data = stream_it->second.Produce(now, max_size);
+  absl::optional<DataToSend> data = stream->Produce(now, max_size);
   if (data.has_value()) {
     RTC_DLOG(LS_VERBOSE) << log_prefix_ << "Producing DATA, type="
                          << (data->data.is_unordered ? "unordered" : "ordered")
@@ -356,11 +422,14 @@ absl::optional<SendQueue::DataToSend> RRSendQueue::Produce(TimeMs now,
                                  : *data->data.is_beginning
                                        ? "first"
                                        : *data->data.is_end ? "last" : "middle")
-                         << ", stream_id=" << *stream_it->first
+                         << ", stream_id=" << *stream->stream_id()
                          << ", ppid=" << *data->data.ppid
                          << ", length=" << data->data.payload.size();
 
     previous_message_has_ended_ = *data->data.is_end;
+    if (previous_message_has_ended_) {
+      RescheduleStream(*stream);
+    }
   }
 
   RTC_DCHECK(IsConsistent());
@@ -370,12 +439,13 @@ absl::optional<SendQueue::DataToSend> RRSendQueue::Produce(TimeMs now,
 bool RRSendQueue::Discard(IsUnordered unordered,
                           StreamID stream_id,
                           MID message_id) {
-  bool has_discarded =
-      GetOrCreateStreamInfo(stream_id).Discard(unordered, message_id);
+  OutgoingStream& stream = GetOrCreateStreamInfo(stream_id);
+  bool has_discarded = stream.Discard(unordered, message_id);
   if (has_discarded) {
     // Only partially sent messages are discarded, so if a message was
     // discarded, then it was the currently sent message.
     previous_message_has_ended_ = true;
+    RescheduleStream(stream);
   }
 
   return has_discarded;
@@ -383,7 +453,12 @@ bool RRSendQueue::Discard(IsUnordered unordered,
 
 void RRSendQueue::PrepareResetStreams(rtc::ArrayView<const StreamID> streams) {
   for (StreamID stream_id : streams) {
-    GetOrCreateStreamInfo(stream_id).Pause();
+    OutgoingStream& stream = GetOrCreateStreamInfo(stream_id);
+    stream.Pause();
+    // Only a partially sent message is kept, which is still scheduled.
+    if (!stream.ShouldBeScheduled()) {
+      UnscheduleStream(stream);
+    }
   }
   RTC_DCHECK(IsConsistent());
 }
@@ -404,6 +479,7 @@ void RRSendQueue::CommitResetStreams() {
   for (auto& stream_entry : streams_) {
     if (stream_entry.second.is_paused()) {
       stream_entry.second.Reset();
+      MaybeScheduleStream(stream_entry.second);
     }
   }
   RTC_DCHECK(IsConsistent());
@@ -412,6 +488,7 @@ void RRSendQueue::CommitResetStreams() {
 void RRSendQueue::RollbackResetStreams() {
   for (auto& stream_entry : streams_) {
     stream_entry.second.Resume();
+    MaybeScheduleStream(stream_entry.second);
   }
   RTC_DCHECK(IsConsistent());
 }
@@ -422,6 +499,7 @@ void RRSendQueue::Reset() {
   for (auto& stream_entry : streams_) {
     OutgoingStream& stream = stream_entry.second;
     stream.Reset();
+    MaybeScheduleStream(stream);
   }
   previous_message_has_ended_ = true;
 }
@@ -447,6 +525,19 @@ void RRSendQueue::SetBufferedAmountLowThreshold(StreamID stream_id,
   GetOrCreateStreamInfo(stream_id).buffered_amount().SetLowThreshold(bytes);
 }
 
+void RRSendQueue::SetStreamPriority(StreamID stream_id,
+                                    StreamPriority priority) {
+  GetOrCreateStreamInfo(stream_id).set_priority(priority);
+}
+
+StreamPriority RRSendQueue::GetStreamPriority(StreamID stream_id) const {
+  auto it = streams_.find(stream_id);
+  if (it == streams_.end()) {
+    return default_priority_;
+  }
+  return it->second.priority();
+}
+
 RRSendQueue::OutgoingStream& RRSendQueue::GetOrCreateStreamInfo(
     StreamID stream_id) {
   auto it = streams_.find(stream_id);
@@ -457,6 +548,7 @@ RRSendQueue::OutgoingStream& RRSendQueue::GetOrCreateStreamInfo(
   return streams_
       .emplace(stream_id,
                OutgoingStream(
+                   stream_id, default_priority_,
                    [this, stream_id]() { on_buffered_amount_low_(stream_id); },
                    total_buffered_amount_))
       .first->second;
@@ -464,30 +556,58 @@ RRSendQueue::OutgoingStream& RRSendQueue::GetOrCreateStreamInfo(
 
 HandoverReadinessStatus RRSendQueue::GetHandoverReadiness() const {
   HandoverReadinessStatus status;
-  if (!IsEmpty()) {
-    status.Add(HandoverUnreadinessReason::kSendQueueNotEmpty);
+  for (const auto& entry : streams_) {
+    if (entry.second.has_partially_sent_message()) {
+      status.Add(HandoverUnreadinessReason::kSendQueueNotEmpty);
+    }
   }
   return status;
 }
 
-void RRSendQueue::AddHandoverState(DcSctpSocketHandoverState& state) {
+void RRSendQueue::AddHandoverState(TimeMs now,
+                                   DcSctpSocketHandoverState& state) {
   for (const auto& entry : streams_) {
     DcSctpSocketHandoverState::OutgoingStream state_stream;
     state_stream.id = entry.first.value();
-    entry.second.AddHandoverState(state_stream);
+    entry.second.AddHandoverState(now, state_stream);
     state.tx.streams.push_back(std::move(state_stream));
   }
 }
 
-void RRSendQueue::RestoreFromState(const DcSctpSocketHandoverState& state) {
+void RRSendQueue::RestoreFromState(TimeMs now,
+                                   const DcSctpSocketHandoverState& state) {
   for (const DcSctpSocketHandoverState::OutgoingStream& state_stream :
        state.tx.streams) {
     StreamID stream_id(state_stream.id);
+    StreamPriority priority =
+        state_stream.priority != 0
+            ? StreamPriority(static_cast<uint16_t>(state_stream.priority))
+            : default_priority_;
     streams_.emplace(stream_id, OutgoingStream(
+                                    stream_id, priority,
                                     [this, stream_id]() {
                                       on_buffered_amount_low_(stream_id);
                                     },
                                     total_buffered_amount_, &state_stream));
+    for (const DcSctpSocketHandoverState::OutgoingMessage& state_message :
+         state_stream.messages) {
+      SendOptions send_options;
+      send_options.unordered = IsUnordered(state_message.unordered);
+      if (state_message.lifetime_ms.has_value()) {
+        send_options.lifetime = DurationMs(
+            static_cast<int32_t>(std::min<uint32_t>(
+                *state_message.lifetime_ms,
+                std::numeric_limits<int32_t>::max())));
+      }
+      if (state_message.max_retransmissions.has_value()) {
+        send_options.max_retransmissions =
+            *state_message.max_retransmissions;
+      }
+      Add(now,
+          DcSctpMessage(stream_id, PPID(state_message.ppid),
+                        state_message.payload),
+          send_options);
+    }
   }
 }
 }  // namespace dcsctp
@@ -30,11 +30,19 @@ namespace dcsctp {
 // The Round Robin SendQueue holds all messages that the client wants to send,
 // but that haven't yet been split into chunks and fully sent on the wire.
 //
-// As defined in https://datatracker.ietf.org/doc/html/rfc8260#section-3.2,
-// it will cycle to send messages from different streams. It will send all
-// fragments from one message before continuing with a different message on
-// possibly a different stream, until support for message interleaving has been
-// implemented.
+// It will send all fragments from one message before continuing with a
+// different message on possibly a different stream, until support for message
+// interleaving has been implemented. The next stream is chosen by start-time
+// fair queueing, a weighted fair queueing scheduler (see
+// https://datatracker.ietf.org/doc/html/rfc8260#section-3.6): each message is
+// tagged with a virtual start time, which is the virtual finish time of the
+// stream's previous message or the start time of the message being sent,
+// whichever is later, and the message with the lowest tag is sent next.
+// A message's virtual duration is its size divided by the stream's priority,
+// so streams get a share of the output that is proportional to their priority,
+// and a stream sending small messages isn't starved by one sending large ones.
+// Streams with the same tag, e.g. with one message each, are served in the
+// order they got data to send, i.e. in round-robin fashion.
 //
 // As messages can be (requested to be) sent before the connection is properly
 // established, this send queue is always present - even for closed connections.
@@ -48,6 +56,7 @@ class RRSendQueue : public SendQueue {
               std::function<void(StreamID)> on_buffered_amount_low,
               size_t total_buffered_amount_low_threshold,
               std::function<void()> on_total_buffered_amount_low,
+              StreamPriority default_priority,
               const DcSctpSocketHandoverState* handover_state = nullptr);
 
   // Indicates if the buffer is full. Note that it's up to the caller to ensure
@@ -81,9 +90,16 @@ class RRSendQueue : public SendQueue {
   size_t buffered_amount_low_threshold(StreamID stream_id) const override;
   void SetBufferedAmountLowThreshold(StreamID stream_id, size_t bytes) override;
 
+  // Sets the priority of a stream, which takes effect from its next message.
+  // A priority of zero is treated as one.
+  void SetStreamPriority(StreamID stream_id, StreamPriority priority);
+  StreamPriority GetStreamPriority(StreamID stream_id) const;
+
+  // Buffered messages are included in the handover state, but not partially
+  // sent ones, which makes the queue not ready for handover.
   HandoverReadinessStatus GetHandoverReadiness() const;
-  void AddHandoverState(DcSctpSocketHandoverState& state);
-  void RestoreFromState(const DcSctpSocketHandoverState& state);
+  void AddHandoverState(TimeMs now, DcSctpSocketHandoverState& state);
+  void RestoreFromState(TimeMs now, const DcSctpSocketHandoverState& state);
 
  private:
   // Represents a value and a "low threshold" that when the value reaches or
@@ -109,19 +125,34 @@ class RRSendQueue : public SendQueue {
     size_t low_threshold_ = 0;
   };
 
+  // Virtual time of the scheduler, and the key of scheduled streams, which
+  // are ordered by their virtual start time and then by when they were
+  // scheduled.
+  using VirtualTime = uint64_t;
+  using ScheduleKey = std::pair<VirtualTime, uint64_t>;
+
   // Per-stream information.
   class OutgoingStream {
    public:
     explicit OutgoingStream(
+        StreamID stream_id,
+        StreamPriority priority,
         std::function<void()> on_buffered_amount_low,
         ThresholdWatcher& total_buffered_amount,
         const DcSctpSocketHandoverState::OutgoingStream* state = nullptr)
-        : next_unordered_mid_(MID(state ? state->next_unordered_mid : 0)),
+        : stream_id_(stream_id),
+          priority_(priority),
+          next_unordered_mid_(MID(state ? state->next_unordered_mid : 0)),
           next_ordered_mid_(MID(state ? state->next_ordered_mid : 0)),
           next_ssn_(SSN(state ? state->next_ssn : 0)),
           buffered_amount_(std::move(on_buffered_amount_low)),
           total_buffered_amount_(total_buffered_amount) {}
 
+    StreamID stream_id() const { return stream_id_; }
+
+    StreamPriority priority() const { return priority_; }
+    void set_priority(StreamPriority priority) { priority_ = priority; }
+
     // Enqueues a message to this stream.
     void Add(DcSctpMessage message,
              TimeMs expires_at,
@@ -154,7 +185,29 @@ class RRSendQueue : public SendQueue {
     // expired non-partially sent message.
     bool HasDataToSend(TimeMs now);
 
+    // Indicates if the stream should be scheduled, which is when it would have
+    // data to send if no message expired.
+    bool ShouldBeScheduled() const;
+
+    // The virtual duration of sending the first enqueued message.
+    VirtualTime NextMessageDuration() const;
+
+    // Set while the stream is scheduled, to its key in `scheduled_streams_`.
+    const absl::optional<ScheduleKey>& schedule_key() const {
+      return schedule_key_;
+    }
+    void set_schedule_key(absl::optional<ScheduleKey> key) {
+      schedule_key_ = key;
+    }
+
+    // The virtual time when the stream's last scheduled message is finished.
+    VirtualTime virtual_finish_time() const { return virtual_finish_time_; }
+    void set_virtual_finish_time(VirtualTime time) {
+      virtual_finish_time_ = time;
+    }
+
     void AddHandoverState(
+        TimeMs now,
         DcSctpSocketHandoverState::OutgoingStream& state) const;
 
    private:
@@ -185,6 +238,11 @@ class RRSendQueue : public SendQueue {
 
     bool IsConsistent() const;
 
+    const StreamID stream_id_;
+    StreamPriority priority_;
+    absl::optional<ScheduleKey> schedule_key_;
+    VirtualTime virtual_finish_time_ = 0;
+
     // Streams are pause when they are about to be reset.
     bool is_paused_ = false;
     // MIDs are different for unordered and ordered messages sent on a stream.
@@ -205,16 +263,20 @@ class RRSendQueue : public SendQueue {
 
   bool IsConsistent() const;
   OutgoingStream& GetOrCreateStreamInfo(StreamID stream_id);
-  absl::optional<DataToSend> Produce(
-      std::map<StreamID, OutgoingStream>::iterator it,
-      TimeMs now,
-      size_t max_size);
 
-  // Return the next stream, in round-robin fashion.
-  std::map<StreamID, OutgoingStream>::iterator GetNextStream(TimeMs now);
+  // Schedules `stream` if it should be and isn't already scheduled.
+  void MaybeScheduleStream(OutgoingStream& stream);
+  void UnscheduleStream(OutgoingStream& stream);
+  // Schedules `stream` anew, when its first message has changed.
+  void RescheduleStream(OutgoingStream& stream);
+
+  // Returns the scheduled stream with the lowest virtual start time, which has
+  // data to send, or nullptr if there is none.
+  OutgoingStream* GetNextStream(TimeMs now);
 
   const std::string log_prefix_;
   const size_t buffer_size_;
+  const StreamPriority default_priority_;
 
   // Called when the buffered amount is below what has been set using
   // `SetBufferedAmountLowThreshold`.
@@ -234,10 +296,19 @@ class RRSendQueue : public SendQueue {
   bool previous_message_has_ended_ = true;
 
   // The current stream to send chunks from. Modified by `GetNextStream`.
-  StreamID current_stream_id_ = StreamID(0);
+  OutgoingStream* current_stream_ = nullptr;
+
+  // The virtual start time of the current stream's message.
+  VirtualTime virtual_time_ = 0;
+  // Incremented each time a stream is scheduled, to order streams with the
+  // same virtual start time.
+  uint64_t schedule_sequence_ = 0;
 
   // All streams, and messages added to those.
   std::map<StreamID, OutgoingStream> streams_;
+
+  // The streams that have data to send, or that had it when last inspected.
+  std::map<ScheduleKey, OutgoingStream*> scheduled_streams_;
 };
 }  // namespace dcsctp
 
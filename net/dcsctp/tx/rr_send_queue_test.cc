@@ -25,6 +25,7 @@
 
 namespace dcsctp {
 namespace {
+using ::testing::ElementsAre;
 using ::testing::SizeIs;
 
 constexpr TimeMs kNow = TimeMs(0);
@@ -34,6 +35,7 @@ constexpr size_t kMaxQueueSize = 1000;
 constexpr size_t kBufferedAmountLowThreshold = 500;
 constexpr size_t kOneFragmentPacketSize = 100;
 constexpr size_t kTwoFragmentPacketSize = 101;
+constexpr StreamPriority kDefaultPriority(10);
 
 class RRSendQueueTest : public testing::Test {
  protected:
@@ -42,7 +44,8 @@ class RRSendQueueTest : public testing::Test {
              kMaxQueueSize,
              on_buffered_amount_low_.AsStdFunction(),
              kBufferedAmountLowThreshold,
-             on_total_buffered_amount_low_.AsStdFunction()) {}
+             on_total_buffered_amount_low_.AsStdFunction(),
+             kDefaultPriority) {}
 
   const DcSctpOptions options_;
   testing::NiceMock<testing::MockFunction<void(StreamID)>>
@@ -779,5 +782,53 @@ TEST_F(RRSendQueueTest, WillStayInStreamWhenOnlySmallFragmentRemaining) {
 
   EXPECT_FALSE(buf_.Produce(kNow, 8).has_value());
 }
+
+TEST_F(RRSendQueueTest, StreamsHaveDefaultPriorityUntilSet) {
+  EXPECT_EQ(buf_.GetStreamPriority(StreamID(1)), kDefaultPriority);
+  buf_.SetStreamPriority(StreamID(1), StreamPriority(42));
+  EXPECT_EQ(buf_.GetStreamPriority(StreamID(1)), StreamPriority(42));
+  EXPECT_EQ(buf_.GetStreamPriority(StreamID(2)), kDefaultPriority);
+}
+
+TEST_F(RRSendQueueTest, SmallMessagesAreNotStarvedByLargeMessages) {
+  for (int i = 0; i < 3; ++i) {
+    buf_.Add(kNow, DcSctpMessage(StreamID(1), kPPID,
+                                 std::vector<uint8_t>(kOneFragmentPacketSize)));
+  }
+  for (int i = 0; i < 3; ++i) {
+    buf_.Add(kNow, DcSctpMessage(StreamID(2), kPPID, std::vector<uint8_t>(1)));
+  }
+
+  // The stream with large messages gets its turn again only once the other
+  // stream has sent as much data.
+  std::vector<StreamID> stream_ids;
+  while (absl::optional<SendQueue::DataToSend> chunk =
+             buf_.Produce(kNow, kOneFragmentPacketSize)) {
+    stream_ids.push_back(chunk->data.stream_id);
+  }
+  EXPECT_THAT(stream_ids,
+              ElementsAre(StreamID(1), StreamID(2), StreamID(2), StreamID(2),
+                          StreamID(1), StreamID(1)));
+}
+
+TEST_F(RRSendQueueTest, StreamsAreServedInProportionToPriority) {
+  buf_.SetStreamPriority(StreamID(1), StreamPriority(10));
+  buf_.SetStreamPriority(StreamID(2), StreamPriority(30));
+  for (int i = 0; i < 8; ++i) {
+    buf_.Add(kNow, DcSctpMessage(StreamID(1), kPPID, std::vector<uint8_t>(10)));
+    buf_.Add(kNow, DcSctpMessage(StreamID(2), kPPID, std::vector<uint8_t>(10)));
+  }
+
+  // While both streams have data, the second gets three times the share.
+  int messages_on_stream2 = 0;
+  for (int i = 0; i < 8; ++i) {
+    ASSERT_HAS_VALUE_AND_ASSIGN(SendQueue::DataToSend chunk,
+                                buf_.Produce(kNow, kOneFragmentPacketSize));
+    if (chunk.data.stream_id == StreamID(2)) {
+      ++messages_on_stream2;
+    }
+  }
+  EXPECT_EQ(messages_on_stream2, 6);
+}
 }  // namespace
 }  // namespace dcsctp
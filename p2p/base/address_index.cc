@@ -0,0 +1,34 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/address_index.h"
+
+#include <functional>
+#include <string>
+
+#include "rtc_base/ip_address.h"
+
+namespace cricket {
+
+size_t HashAddressForIndex(const rtc::SocketAddress& address) {
+  const rtc::IPAddress& ip = address.ipaddr();
+  uint64_t hash = static_cast<uint64_t>(rtc::HashIP(ip));
+  if (rtc::IPIsAny(ip) || rtc::IPIsUnspec(ip)) {
+    // These compare by hostname too, see SocketAddress::EqualIPs().
+    hash ^= std::hash<std::string>()(address.hostname());
+  }
+  hash = (hash << 16) ^ address.port();
+  // The IP bytes are in network order, so the varying ones end up high;
+  // multiplying by a large odd constant spreads them over every bit.
+  hash *= 0x9e3779b97f4a7c15ull;
+  return static_cast<size_t>(hash ^ (hash >> 32));
+}
+
+}  // namespace cricket
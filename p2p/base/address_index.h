@@ -0,0 +1,172 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef P2P_BASE_ADDRESS_INDEX_H_
+#define P2P_BASE_ADDRESS_INDEX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/socket_address.h"
+
+namespace cricket {
+
+// Hashes `address` consistently with SocketAddress::operator==, mixing the
+// bits so that the low ones can index a power of two sized table.
+size_t HashAddressForIndex(const rtc::SocketAddress& address);
+
+// Maps remote addresses to the object (typically a Connection) that the
+// packets from them go to. It is a linear probing hash table with small
+// slots, so that a lookup usually touches a single cache line, plus a check
+// of the last address found, which most packets hit when they come in
+// bursts from the same remote.
+//
+// To keep slots small, keys are stored by pointer: the address passed to
+// Insert() must stay alive and unchanged until it is erased or replaced,
+// which holds for the remote candidate address of a Connection.
+template <typename T>
+class AddressIndex {
+ public:
+  AddressIndex() = default;
+  AddressIndex(const AddressIndex&) = delete;
+  AddressIndex& operator=(const AddressIndex&) = delete;
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  // Returns the value for `address`, or null.
+  T* Find(const rtc::SocketAddress& address) {
+    if (last_hit_ != nullptr && *last_hit_->key == address) {
+      return last_hit_->value;
+    }
+    if (slots_.empty()) {
+      return nullptr;
+    }
+    const uint32_t hash = SlotHash(address);
+    for (size_t i = hash & mask();; i = (i + 1) & mask()) {
+      Slot& slot = slots_[i];
+      if (slot.value == nullptr) {
+        return nullptr;
+      }
+      if (slot.hash == hash && *slot.key == address) {
+        last_hit_ = &slot;
+        return slot.value;
+      }
+    }
+  }
+
+  // Maps `address` to `value`, replacing any previous value.
+  void Insert(const rtc::SocketAddress& address, T* value) {
+    RTC_DCHECK(value);
+    if ((size_ + 1) * 2 > slots_.size()) {
+      Rehash(slots_.empty() ? kMinSlots : slots_.size() * 2);
+    }
+    const uint32_t hash = SlotHash(address);
+    for (size_t i = hash & mask();; i = (i + 1) & mask()) {
+      Slot& slot = slots_[i];
+      if (slot.value == nullptr) {
+        slot = Slot{&address, value, hash};
+        ++size_;
+        return;
+      }
+      if (slot.hash == hash && *slot.key == address) {
+        slot.key = &address;
+        slot.value = value;
+        return;
+      }
+    }
+  }
+
+  // Removes `address`; returns false if it wasn't present.
+  bool Erase(const rtc::SocketAddress& address) {
+    if (slots_.empty()) {
+      return false;
+    }
+    const uint32_t hash = SlotHash(address);
+    size_t i = hash & mask();
+    for (;; i = (i + 1) & mask()) {
+      const Slot& slot = slots_[i];
+      if (slot.value == nullptr) {
+        return false;
+      }
+      if (slot.hash == hash && *slot.key == address) {
+        break;
+      }
+    }
+    last_hit_ = nullptr;
+    --size_;
+    // Shift back the entries that probed past the freed slot, so that no
+    // tombstones are needed.
+    for (size_t j = (i + 1) & mask();; j = (j + 1) & mask()) {
+      Slot& slot = slots_[j];
+      if (slot.value == nullptr) {
+        break;
+      }
+      const size_t home = slot.hash & mask();
+      // Move the entry unless its home slot lies cyclically in (i, j].
+      if (((j - home) & mask()) >= ((j - i) & mask())) {
+        slots_[i] = slot;
+        i = j;
+      }
+    }
+    slots_[i] = Slot();
+    return true;
+  }
+
+  void Clear() {
+    slots_.clear();
+    size_ = 0;
+    last_hit_ = nullptr;
+  }
+
+ private:
+  struct Slot {
+    const rtc::SocketAddress* key = nullptr;
+    // Null in empty slots.
+    T* value = nullptr;
+    uint32_t hash = 0;
+  };
+
+  static constexpr size_t kMinSlots = 8;
+
+  static uint32_t SlotHash(const rtc::SocketAddress& address) {
+    return static_cast<uint32_t>(HashAddressForIndex(address));
+  }
+
+  size_t mask() const { return slots_.size() - 1; }
+
+  void Rehash(size_t num_slots) {
+    std::vector<Slot> old_slots(num_slots);
+    old_slots.swap(slots_);
+    last_hit_ = nullptr;
+    for (const Slot& old_slot : old_slots) {
+      if (old_slot.value == nullptr) {
+        continue;
+      }
+      size_t i = old_slot.hash & mask();
+      while (slots_[i].value != nullptr) {
+        i = (i + 1) & mask();
+      }
+      slots_[i] = old_slot;
+    }
+  }
+
+  // Size is a power of two, at most half full.
+  std::vector<Slot> slots_;
+  size_t size_ = 0;
+  Slot* last_hit_ = nullptr;
+};
+
+}  // namespace cricket
+
+#endif  // P2P_BASE_ADDRESS_INDEX_H_
@@ -0,0 +1,101 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <map>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "p2p/base/address_index.h"
+#include "rtc_base/ip_address.h"
+#include "rtc_base/random.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/system/unused.h"
+
+namespace cricket {
+namespace {
+
+// Remote addresses as a TURN server or SFU port sees them: many IPv4 hosts,
+// some of them behind the same NAT with different ports.
+std::vector<rtc::SocketAddress> MakeAddresses(int count) {
+  webrtc::Random random(count);
+  std::vector<rtc::SocketAddress> addresses;
+  for (int i = 0; i < count; ++i) {
+    addresses.emplace_back(rtc::IPAddress(0x0a000000 + random.Rand(1 << 20)),
+                           1024 + random.Rand(60000));
+  }
+  return addresses;
+}
+
+// Packets in the order they arrive, with `burst` consecutive packets coming
+// from the same remote address.
+std::vector<rtc::SocketAddress> MakePacketSources(
+    const std::vector<rtc::SocketAddress>& addresses,
+    int burst) {
+  webrtc::Random random(burst);
+  std::vector<rtc::SocketAddress> sources;
+  for (int i = 0; i < 4096; i += burst) {
+    const rtc::SocketAddress& address = addresses[random.Rand(
+        static_cast<uint32_t>(addresses.size() - 1))];
+    for (int j = 0; j < burst; ++j) {
+      sources.push_back(address);
+    }
+  }
+  return sources;
+}
+
+void BM_MapLookup(benchmark::State& state) {
+  std::vector<rtc::SocketAddress> addresses = MakeAddresses(state.range(0));
+  std::vector<rtc::SocketAddress> sources =
+      MakePacketSources(addresses, state.range(1));
+  std::vector<int> values(addresses.size());
+  std::map<rtc::SocketAddress, int*> map;
+  for (size_t i = 0; i < addresses.size(); ++i) {
+    map[addresses[i]] = &values[i];
+  }
+  size_t n = 0;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    auto it = map.find(sources[n]);
+    benchmark::DoNotOptimize(it == map.end() ? nullptr : it->second);
+    n = (n + 1) % sources.size();
+  }
+}
+
+void BM_AddressIndexLookup(benchmark::State& state) {
+  std::vector<rtc::SocketAddress> addresses = MakeAddresses(state.range(0));
+  std::vector<rtc::SocketAddress> sources =
+      MakePacketSources(addresses, state.range(1));
+  std::vector<int> values(addresses.size());
+  AddressIndex<int> index;
+  for (size_t i = 0; i < addresses.size(); ++i) {
+    index.Insert(addresses[i], &values[i]);
+  }
+  size_t n = 0;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    benchmark::DoNotOptimize(index.Find(sources[n]));
+    n = (n + 1) % sources.size();
+  }
+}
+
+// {number of remote addresses, packets per burst}.
+BENCHMARK(BM_MapLookup)
+    ->Args({16, 1})
+    ->Args({1024, 1})
+    ->Args({8192, 1})
+    ->Args({8192, 8});
+BENCHMARK(BM_AddressIndexLookup)
+    ->Args({16, 1})
+    ->Args({1024, 1})
+    ->Args({8192, 1})
+    ->Args({8192, 8});
+
+}  // namespace
+}  // namespace cricket
@@ -0,0 +1,127 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/address_index.h"
+
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "rtc_base/ip_address.h"
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace cricket {
+namespace {
+
+rtc::SocketAddress MakeAddress(uint32_t ip, uint16_t port) {
+  return rtc::SocketAddress(rtc::IPAddress(ip), port);
+}
+
+TEST(AddressIndexTest, FindsInsertedAddresses) {
+  rtc::SocketAddress a = MakeAddress(0x0a000001, 1000);
+  rtc::SocketAddress b = MakeAddress(0x0a000001, 1001);
+  rtc::SocketAddress c("2001:db8::1", 1000);
+  int va = 1, vb = 2, vc = 3;
+  AddressIndex<int> index;
+  EXPECT_EQ(nullptr, index.Find(a));
+
+  index.Insert(a, &va);
+  index.Insert(b, &vb);
+  index.Insert(c, &vc);
+  EXPECT_EQ(3u, index.size());
+  EXPECT_EQ(&va, index.Find(MakeAddress(0x0a000001, 1000)));
+  EXPECT_EQ(&vb, index.Find(MakeAddress(0x0a000001, 1001)));
+  EXPECT_EQ(&vc, index.Find(rtc::SocketAddress("2001:db8::1", 1000)));
+  EXPECT_EQ(nullptr, index.Find(MakeAddress(0x0a000002, 1000)));
+}
+
+TEST(AddressIndexTest, InsertReplacesValue) {
+  rtc::SocketAddress a = MakeAddress(0x0a000001, 1000);
+  rtc::SocketAddress a_copy = a;
+  int v1 = 1, v2 = 2;
+  AddressIndex<int> index;
+  index.Insert(a, &v1);
+  EXPECT_EQ(&v1, index.Find(a));
+  index.Insert(a_copy, &v2);
+  EXPECT_EQ(1u, index.size());
+  EXPECT_EQ(&v2, index.Find(a));
+}
+
+TEST(AddressIndexTest, DistinguishesUnresolvedHostnames) {
+  rtc::SocketAddress a("a.local", 1000);
+  rtc::SocketAddress b("b.local", 1000);
+  int va = 1, vb = 2;
+  AddressIndex<int> index;
+  index.Insert(a, &va);
+  index.Insert(b, &vb);
+  EXPECT_EQ(&va, index.Find(rtc::SocketAddress("a.local", 1000)));
+  EXPECT_EQ(&vb, index.Find(rtc::SocketAddress("b.local", 1000)));
+}
+
+// Compares against std::map through random inserts, finds and erases, which
+// exercises growing and the backward shift on erase.
+TEST(AddressIndexTest, MatchesMapUnderRandomOperations) {
+  webrtc::Random random(42);
+  std::vector<rtc::SocketAddress> addresses;
+  for (int i = 0; i < 300; ++i) {
+    // Few distinct IPs and ports, so that hashes collide often.
+    addresses.push_back(MakeAddress(0xc0a80000 + random.Rand(15),
+                                    1000 + random.Rand(20)));
+  }
+  std::vector<int> values(addresses.size());
+  std::map<rtc::SocketAddress, int*> expected;
+  // Keys must outlive their entry; keep the inserted copies stable.
+  std::map<rtc::SocketAddress, std::unique_ptr<rtc::SocketAddress>> keys;
+  AddressIndex<int> index;
+  for (int step = 0; step < 20000; ++step) {
+    size_t n = random.Rand(static_cast<uint32_t>(addresses.size() - 1));
+    const rtc::SocketAddress& address = addresses[n];
+    switch (random.Rand(2)) {
+      case 0: {
+        auto key = std::make_unique<rtc::SocketAddress>(address);
+        index.Insert(*key, &values[n]);
+        keys[address] = std::move(key);
+        expected[address] = &values[n];
+        break;
+      }
+      case 1:
+        EXPECT_EQ(expected.erase(address) == 1, index.Erase(address));
+        keys.erase(address);
+        break;
+      case 2: {
+        auto it = expected.find(address);
+        EXPECT_EQ(it == expected.end() ? nullptr : it->second,
+                  index.Find(address));
+        break;
+      }
+    }
+    ASSERT_EQ(expected.size(), index.size());
+  }
+  for (const auto& kv : expected) {
+    EXPECT_EQ(kv.second, index.Find(kv.first));
+  }
+}
+
+TEST(AddressIndexTest, EraseForgetsLastHit) {
+  rtc::SocketAddress a = MakeAddress(0x0a000001, 1000);
+  int va = 1;
+  AddressIndex<int> index;
+  index.Insert(a, &va);
+  EXPECT_EQ(&va, index.Find(a));
+  EXPECT_TRUE(index.Erase(a));
+  EXPECT_EQ(nullptr, index.Find(a));
+  EXPECT_FALSE(index.Erase(a));
+  EXPECT_TRUE(index.empty());
+}
+
+}  // namespace
+}  // namespace cricket
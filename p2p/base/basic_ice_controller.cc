@@ -10,6 +10,8 @@
 
 #include "p2p/base/basic_ice_controller.h"
 
+#include <tuple>
+
 namespace {
 
 // The minimum improvement in RTT that justifies a switch.
@@ -76,13 +78,16 @@ void BasicIceController::SetSelectedConnection(
 
 void BasicIceController::AddConnection(const Connection* connection) {
   connections_.push_back(connection);
+  sort_keys_.emplace_back();
   unpinged_connections_.insert(connection);
 }
 
 void BasicIceController::OnConnectionDestroyed(const Connection* connection) {
   pinged_connections_.erase(connection);
   unpinged_connections_.erase(connection);
-  connections_.erase(absl::c_find(connections_, connection));
+  auto it = absl::c_find(connections_, connection);
+  sort_keys_.erase(sort_keys_.begin() + (it - connections_.begin()));
+  connections_.erase(it);
 }
 
 bool BasicIceController::HasPingableConnection() const {
@@ -527,16 +532,7 @@ BasicIceController::SortAndSwitchConnection(IceControllerEvent reason) {
   // that amongst equal preference, writable connections, this will choose the
   // one whose estimated latency is lowest.  So it is the only one that we
   // need to consider switching to.
-  // TODO(honghaiz): Don't sort;  Just use std::max_element in the right places.
-  absl::c_stable_sort(
-      connections_, [this](const Connection* a, const Connection* b) {
-        int cmp = CompareConnections(a, b, absl::nullopt, nullptr);
-        if (cmp != 0) {
-          return cmp > 0;
-        }
-        // Otherwise, sort based on latency estimate.
-        return a->rtt() < b->rtt();
-      });
+  SortConnections();
 
   RTC_LOG(LS_VERBOSE) << "Sorting " << connections_.size()
                       << " available connections";
@@ -550,6 +546,109 @@ BasicIceController::SortAndSwitchConnection(IceControllerEvent reason) {
   return ShouldSwitchConnection(reason, top_connection);
 }
 
+BasicIceController::SortKey BasicIceController::MakeSortKey(
+    const Connection* conn,
+    bool controlled) const {
+  SortKey key;
+  // See CompareConnectionStates().
+  key.writable = conn->writable() || PresumedWritable(conn);
+  key.write_state = conn->write_state();
+  key.receiving = conn->receiving();
+  key.connected =
+      conn->write_state() == Connection::STATE_WRITABLE && conn->connected();
+  // See CompareConnections().
+  key.remote_nomination = controlled ? conn->remote_nomination() : 0;
+  key.last_data_received = controlled ? conn->last_data_received() : 0;
+  // See CompareCandidatePairNetworks().
+  key.preferred_network =
+      LocalCandidateUsesPreferredNetwork(conn, config_.network_preference);
+  key.preferred_vpn = false;
+  switch (config_.vpn_preference) {
+    case webrtc::VpnPreference::kOnlyUseVpn:
+    case webrtc::VpnPreference::kPreferVpn:
+      key.preferred_vpn = conn->network()->IsVpn();
+      break;
+    case webrtc::VpnPreference::kNeverUseVpn:
+    case webrtc::VpnPreference::kAvoidVpn:
+      key.preferred_vpn = !conn->network()->IsVpn();
+      break;
+    default:
+      break;
+  }
+  key.network_cost = conn->ComputeNetworkCost();
+  // See CompareConnectionCandidates().
+  key.priority = conn->priority();
+  key.generation =
+      int64_t{conn->remote_candidate().generation()} + conn->generation();
+  key.pruned = is_connection_pruned_func_(conn);
+  key.rtt = conn->rtt();
+  return key;
+}
+
+// static
+bool BasicIceController::SortsBefore(const SortKey& a, const SortKey& b) {
+  // Fields where smaller is better are taken from the other key.
+  return std::tie(a.writable, b.write_state, a.receiving, a.connected,
+                  a.remote_nomination, a.last_data_received,
+                  a.preferred_network, a.preferred_vpn, b.network_cost,
+                  a.priority, a.generation, b.pruned, b.rtt) >
+         std::tie(b.writable, a.write_state, b.receiving, b.connected,
+                  b.remote_nomination, b.last_data_received,
+                  b.preferred_network, b.preferred_vpn, a.network_cost,
+                  b.priority, b.generation, a.pruned, a.rtt);
+}
+
+void BasicIceController::SortConnections() {
+  const bool controlled = ice_role_func_() == ICEROLE_CONTROLLED;
+  // Sorts equal keys by their position before sorting, as a stable sort.
+  auto entry_before = [](const SortEntry& a, const SortEntry& b) {
+    if (SortsBefore(a.key, b.key)) {
+      return true;
+    }
+    if (SortsBefore(b.key, a.key)) {
+      return false;
+    }
+    return a.index < b.index;
+  };
+
+  unchanged_entries_.clear();
+  changed_entries_.clear();
+  for (size_t i = 0; i < connections_.size(); ++i) {
+    SortEntry entry = {MakeSortKey(connections_[i], controlled), i,
+                       connections_[i]};
+    const absl::optional<SortKey>& old_key = sort_keys_[i];
+    if (old_key && !SortsBefore(entry.key, *old_key) &&
+        !SortsBefore(*old_key, entry.key)) {
+      unchanged_entries_.push_back(entry);
+    } else {
+      changed_entries_.push_back(entry);
+    }
+  }
+  if (changed_entries_.empty()) {
+    return;
+  }
+  RTC_DCHECK(absl::c_is_sorted(unchanged_entries_, entry_before));
+  absl::c_sort(changed_entries_, entry_before);
+
+  auto unchanged = unchanged_entries_.begin();
+  auto changed = changed_entries_.begin();
+  for (size_t i = 0; i < connections_.size(); ++i) {
+    const SortEntry& entry =
+        (changed == changed_entries_.end() ||
+         (unchanged != unchanged_entries_.end() &&
+          entry_before(*unchanged, *changed)))
+            ? *unchanged++
+            : *changed++;
+    connections_[i] = entry.connection;
+    sort_keys_[i] = entry.key;
+  }
+  RTC_DCHECK(absl::c_is_sorted(
+      connections_, [this](const Connection* a, const Connection* b) {
+        int cmp = CompareConnections(a, b, absl::nullopt, nullptr);
+        return cmp != 0 ? cmp > 0 : a->rtt() < b->rtt();
+      }));
+}
+
 bool BasicIceController::ReadyToSend(const Connection* connection) const {
   // Note that we allow sending on an unreliable connection, because it's
   // possible that it became unreliable simply due to bad chance.
@@ -17,6 +17,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/types/optional.h"
 #include "p2p/base/ice_controller_factory_interface.h"
 #include "p2p/base/ice_controller_interface.h"
 #include "p2p/base/p2p_transport_channel.h"
@@ -139,6 +140,37 @@ class BasicIceController : public IceControllerInterface {
   SwitchResult HandleInitialSelectDampening(IceControllerEvent reason,
                                             const Connection* new_connection);
 
+  // What CompareConnections() compares without a receiving threshold, and
+  // then the RTT, read once per connection for sorting.
+  struct SortKey {
+    bool writable;
+    int write_state;
+    bool receiving;
+    bool connected;
+    uint32_t remote_nomination;
+    int64_t last_data_received;
+    bool preferred_network;
+    bool preferred_vpn;
+    uint32_t network_cost;
+    uint64_t priority;
+    int64_t generation;
+    bool pruned;
+    int rtt;
+  };
+  struct SortEntry {
+    SortKey key;
+    size_t index;
+    const Connection* connection;
+  };
+
+  SortKey MakeSortKey(const Connection* conn, bool controlled) const;
+  // Returns true if a connection with key `a` is sorted before one with `b`.
+  static bool SortsBefore(const SortKey& a, const SortKey& b);
+  // Sorts `connections_` as a stable sort by SortsBefore() would. Only the
+  // connections whose keys changed since the previous sort are sorted, and
+  // then merged with the others, which are still in order.
+  void SortConnections();
+
   std::function<IceTransportState()> ice_transport_state_func_;
   std::function<IceRole()> ice_role_func_;
   std::function<bool(const Connection*)> is_connection_pruned_func_;
@@ -153,6 +185,12 @@ class BasicIceController : public IceControllerInterface {
   // connection should be pinged next or not.
   const Connection* selected_connection_ = nullptr;
   std::vector<const Connection*> connections_;
+  // The keys of `connections_` as of the previous sort, or nullopt for those
+  // added since.
+  std::vector<absl::optional<SortKey>> sort_keys_;
+  // Scratch space of SortConnections().
+  std::vector<SortEntry> unchanged_entries_;
+  std::vector<SortEntry> changed_entries_;
   std::set<const Connection*> pinged_connections_;
   std::set<const Connection*> unpinged_connections_;
 
@@ -0,0 +1,130 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "benchmark/benchmark.h"
+#include "p2p/base/basic_ice_controller.h"
+#include "p2p/base/basic_packet_socket_factory.h"
+#include "p2p/base/connection.h"
+#include "p2p/base/p2p_constants.h"
+#include "p2p/base/p2p_transport_channel_ice_field_trials.h"
+#include "p2p/base/stun_port.h"
+#include "rtc_base/ip_address.h"
+#include "rtc_base/network.h"
+#include "rtc_base/random.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/system/unused.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/virtual_socket_server.h"
+
+namespace cricket {
+namespace {
+
+// Candidate pairs of a multi-homed host: every local network is paired with
+// every remote candidate.
+constexpr int kLocalNetworks = 4;
+
+class IceControllerFixture {
+ public:
+  explicit IceControllerFixture(int num_pairs)
+      : thread_(&ss_), socket_factory_(&ss_), controller_(MakeArgs()) {
+    for (int i = 0; i < kLocalNetworks; ++i) {
+      rtc::IPAddress ip(0x0a000001 + (i << 16));
+      networks_.push_back(std::make_unique<rtc::Network>(
+          "net" + std::to_string(i), "net", ip, 16));
+      networks_.back()->AddIP(ip);
+      ports_.push_back(UDPPort::Create(&thread_, &socket_factory_,
+                                       networks_.back().get(), 0, 0, "lfrag",
+                                       "lpassword", false, absl::nullopt));
+      ports_.back()->SetIceRole(ICEROLE_CONTROLLING);
+      ports_.back()->PrepareAddress();
+    }
+    webrtc::Random random(num_pairs);
+    for (int i = 0; i < num_pairs / kLocalNetworks; ++i) {
+      Candidate remote;
+      remote.set_component(ICE_CANDIDATE_COMPONENT_DEFAULT);
+      remote.set_protocol(UDP_PROTOCOL_NAME);
+      remote.set_address(
+          rtc::SocketAddress(rtc::IPAddress(0x0b000000 + i), 10000 + i));
+      remote.set_priority(random.Rand<uint32_t>());
+      remote.set_username("rfrag");
+      remote.set_password("rpassword");
+      remote.set_type(LOCAL_PORT_TYPE);
+      for (auto& port : ports_) {
+        Connection* connection =
+            port->CreateConnection(remote, PortInterface::ORIGIN_MESSAGE);
+        connections_.push_back(connection);
+        controller_.AddConnection(connection);
+      }
+    }
+    controller_.SortAndSwitchConnection(
+        IceControllerEvent::CONNECT_STATE_CHANGE);
+  }
+
+  // Updates the state of `count` random connections, as responses to
+  // connectivity checks do.
+  void ReceivePingResponses(int count) {
+    for (int i = 0; i < count; ++i) {
+      Connection* connection = connections_[random_.Rand(
+          static_cast<uint32_t>(connections_.size() - 1))];
+      connection->ReceivedPingResponse(random_.Rand(10, 300), "id");
+    }
+  }
+
+  BasicIceController& controller() { return controller_; }
+
+ private:
+  IceControllerFactoryArgs MakeArgs() {
+    IceControllerFactoryArgs args;
+    args.ice_transport_state_func = [] {
+      return IceTransportState::STATE_CONNECTING;
+    };
+    args.ice_role_func = [] { return ICEROLE_CONTROLLING; };
+    args.is_connection_pruned_func = [](const Connection*) { return false; };
+    args.ice_field_trials = &field_trials_;
+    return args;
+  }
+
+  rtc::VirtualSocketServer ss_;
+  rtc::AutoSocketServerThread thread_;
+  rtc::BasicPacketSocketFactory socket_factory_;
+  IceFieldTrials field_trials_;
+  std::vector<std::unique_ptr<rtc::Network>> networks_;
+  std::vector<std::unique_ptr<UDPPort>> ports_;
+  std::vector<Connection*> connections_;
+  BasicIceController controller_;
+  webrtc::Random random_{1234};
+};
+
+void BM_SortAndSwitchConnection(benchmark::State& state) {
+  IceControllerFixture fixture(state.range(0));
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    state.PauseTiming();
+    fixture.ReceivePingResponses(state.range(1));
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(fixture.controller().SortAndSwitchConnection(
+        IceControllerEvent::CONNECT_STATE_CHANGE));
+  }
+}
+
+// {number of candidate pairs, connections changed before each sort}.
+BENCHMARK(BM_SortAndSwitchConnection)
+    ->Args({100, 1})
+    ->Args({1000, 1})
+    ->Args({1000, 10})
+    ->Args({1000, 1000});
+
+}  // namespace
+}  // namespace cricket
@@ -20,6 +20,7 @@
 #include "absl/algorithm/container.h"
 #include "absl/strings/match.h"
 #include "p2p/base/port_allocator.h"
+#include "p2p/base/stun_binding_fast_path.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/crc32.h"
 #include "rtc_base/helpers.h"
@@ -452,6 +453,10 @@ void Connection::OnSendStunPacket(const void* data,
 void Connection::OnReadPacket(const char* data,
                               size_t size,
                               int64_t packet_time_us) {
+  if (MaybeHandleStunBindingRequestFast(data, size)) {
+    return;
+  }
+
   std::unique_ptr<IceMessage> msg;
   std::string remote_ufrag;
   const rtc::SocketAddress& addr(remote_candidate_.address());
@@ -537,29 +542,7 @@ void Connection::OnReadPacket(const char* data,
 void Connection::HandleStunBindingOrGoogPingRequest(IceMessage* msg) {
   // This connection should now be receiving.
   ReceivedPing(msg->transaction_id());
-  if (webrtc::field_trial::IsEnabled("WebRTC-ExtraICEPing") &&
-      last_ping_response_received_ == 0) {
-    if (local_candidate().type() == RELAY_PORT_TYPE ||
-        local_candidate().type() == PRFLX_PORT_TYPE ||
-        remote_candidate().type() == RELAY_PORT_TYPE ||
-        remote_candidate().type() == PRFLX_PORT_TYPE) {
-      const int64_t now = rtc::TimeMillis();
-      if (last_ping_sent_ + kMinExtraPingDelayMs <= now) {
-        RTC_LOG(LS_INFO) << ToString()
-                         << "WebRTC-ExtraICEPing/Sending extra ping"
-                            " last_ping_sent_: "
-                         << last_ping_sent_ << " now: " << now
-                         << " (diff: " << (now - last_ping_sent_) << ")";
-        Ping(now);
-      } else {
-        RTC_LOG(LS_INFO) << ToString()
-                         << "WebRTC-ExtraICEPing/Not sending extra ping"
-                            " last_ping_sent_: "
-                         << last_ping_sent_ << " now: " << now
-                         << " (diff: " << (now - last_ping_sent_) << ")";
-      }
-    }
-  }
+  MaybeSendExtraIcePing();
 
   const rtc::SocketAddress& remote_addr = remote_candidate_.address();
   if (msg->type() == STUN_BINDING_REQUEST) {
@@ -605,26 +588,13 @@ void Connection::HandleStunBindingOrGoogPingRequest(IceMessage* msg) {
         nomination = 1;
       }
     }
-    // We don't un-nominate a connection, so we only keep a larger nomination.
-    if (nomination > remote_nomination_) {
-      set_remote_nomination(nomination);
-      SignalNominated(this);
-    }
+    OnRemoteNomination(nomination);
   }
   // Set the remote cost if the network_info attribute is available.
-  // Note: If packets are re-ordered, we may get incorrect network cost
-  // temporarily, but it should get the correct value shortly after that.
   const StunUInt32Attribute* network_attr =
       msg->GetUInt32(STUN_ATTR_GOOG_NETWORK_INFO);
   if (network_attr) {
-    uint32_t network_info = network_attr->value();
-    uint16_t network_cost = static_cast<uint16_t>(network_info);
-    if (network_cost != remote_candidate_.network_cost()) {
-      remote_candidate_.set_network_cost(network_cost);
-      // Network cost change will affect the connection ranking, so signal
-      // state change to force a re-sort in P2PTransportChannel.
-      SignalStateChange(this);
-    }
+    OnRemoteNetworkInfo(network_attr->value());
   }
 
   if (webrtc::field_trial::IsEnabled(
@@ -633,6 +603,116 @@ void Connection::HandleStunBindingOrGoogPingRequest(IceMessage* msg) {
   }
 }
 
+bool Connection::MaybeHandleStunBindingRequestFast(const char* data,
+                                                   size_t size) {
+  StunBindingFastPath::Request request;
+  if (!StunBindingFastPath::Parse(data, size, &request)) {
+    return false;
+  }
+  // Requests that need an error response, or that may conflict with our
+  // role, take the full path.
+  size_t colon_pos = request.username.find(':');
+  if (colon_pos == absl::string_view::npos ||
+      request.username.substr(0, colon_pos) != port_->username_fragment() ||
+      request.username.substr(colon_pos + 1) != remote_candidate_.username()) {
+    return false;
+  }
+  IceRole ice_role = port_->GetIceRole();
+  if ((ice_role != ICEROLE_CONTROLLING && ice_role != ICEROLE_CONTROLLED) ||
+      request.role == ice_role) {
+    return false;
+  }
+  StunBindingFastPath* fast_path = port_->stun_binding_fast_path();
+  if (!fast_path->ValidateMessageIntegrity(data, request, port_->password())) {
+    return false;
+  }
+
+  rtc::LoggingSeverity sev = (!writable() ? rtc::LS_INFO : rtc::LS_VERBOSE);
+  RTC_LOG_V(sev) << ToString() << ": Received "
+                 << StunMethodToString(STUN_BINDING_REQUEST) << ", id="
+                 << rtc::hex_encode(request.transaction_id.data(),
+                                    request.transaction_id.size());
+
+  // The same steps as HandleStunBindingOrGoogPingRequest().
+  ReceivedPing(std::string(request.transaction_id));
+  MaybeSendExtraIcePing();
+
+  stats_.recv_ping_requests++;
+  LogCandidatePairEvent(webrtc::IceCandidatePairEventType::kCheckReceived,
+                        request.reduced_transaction_id);
+
+  rtc::ArrayView<const uint8_t> response = fast_path->WriteResponse(
+      request, remote_candidate_.address(), local_candidate().password());
+  SendResponsePacket(STUN_BINDING_RESPONSE, response.data(), response.size(),
+                     request.transaction_id, request.reduced_transaction_id);
+
+  if (!pruned_ && write_state_ == STATE_WRITE_TIMEOUT) {
+    set_write_state(STATE_WRITE_INIT);
+  }
+
+  if (ice_role == ICEROLE_CONTROLLED) {
+    uint32_t nomination = request.use_candidate ? 1 : 0;
+    if (request.nomination) {
+      nomination = *request.nomination;
+      if (nomination == 0) {
+        RTC_LOG(LS_ERROR) << "Invalid nomination: " << nomination;
+      }
+    }
+    OnRemoteNomination(nomination);
+  }
+  if (request.network_info) {
+    OnRemoteNetworkInfo(*request.network_info);
+  }
+  return true;
+}
+
+void Connection::MaybeSendExtraIcePing() {
+  if (!webrtc::field_trial::IsEnabled("WebRTC-ExtraICEPing") ||
+      last_ping_response_received_ != 0) {
+    return;
+  }
+  if (local_candidate().type() == RELAY_PORT_TYPE ||
+      local_candidate().type() == PRFLX_PORT_TYPE ||
+      remote_candidate().type() == RELAY_PORT_TYPE ||
+      remote_candidate().type() == PRFLX_PORT_TYPE) {
+    const int64_t now = rtc::TimeMillis();
+    if (last_ping_sent_ + kMinExtraPingDelayMs <= now) {
+      RTC_LOG(LS_INFO) << ToString()
+                       << "WebRTC-ExtraICEPing/Sending extra ping"
+                          " last_ping_sent_: "
+                       << last_ping_sent_ << " now: " << now
+                       << " (diff: " << (now - last_ping_sent_) << ")";
+      Ping(now);
+    } else {
+      RTC_LOG(LS_INFO) << ToString()
+                       << "WebRTC-ExtraICEPing/Not sending extra ping"
+                          " last_ping_sent_: "
+                       << last_ping_sent_ << " now: " << now
+                       << " (diff: " << (now - last_ping_sent_) << ")";
+    }
+  }
+}
+
+void Connection::OnRemoteNomination(uint32_t nomination) {
+  // We don't un-nominate a connection, so we only keep a larger nomination.
+  if (nomination > remote_nomination_) {
+    set_remote_nomination(nomination);
+    SignalNominated(this);
+  }
+}
+
+void Connection::OnRemoteNetworkInfo(uint32_t network_info) {
+  // Note: If packets are re-ordered, we may get incorrect network cost
+  // temporarily, but it should get the correct value shortly after that.
+  uint16_t network_cost = static_cast<uint16_t>(network_info);
+  if (network_cost != remote_candidate_.network_cost()) {
+    remote_candidate_.set_network_cost(network_cost);
+    // Network cost change will affect the connection ranking, so signal
+    // state change to force a re-sort in P2PTransportChannel.
+    SignalStateChange(this);
+  }
+}
+
 void Connection::SendStunBindingResponse(const StunMessage* request) {
   RTC_DCHECK(request->type() == STUN_BINDING_REQUEST);
 
@@ -701,33 +781,45 @@ void Connection::SendGoogPingResponse(const StunMessage* request) {
 }
 
 void Connection::SendResponseMessage(const StunMessage& response) {
+  rtc::ByteBufferWriter buf;
+  response.Write(&buf);
+  SendResponsePacket(response.type(), buf.Data(), buf.Length(),
+                     response.transaction_id(),
+                     response.reduced_transaction_id());
+}
+
+void Connection::SendResponsePacket(int type,
+                                    const void* data,
+                                    size_t size,
+                                    absl::string_view transaction_id,
+                                    uint32_t reduced_transaction_id) {
   // Where I send the response.
   const rtc::SocketAddress& addr = remote_candidate_.address();
 
   // Send the response message.
-  rtc::ByteBufferWriter buf;
-  response.Write(&buf);
   rtc::PacketOptions options(port_->StunDscpValue());
   options.info_signaled_after_sent.packet_type =
       rtc::PacketType::kIceConnectivityCheckResponse;
-  auto err = port_->SendTo(buf.Data(), buf.Length(), addr, options, false);
+  auto err = port_->SendTo(data, size, addr, options, false);
   if (err < 0) {
     RTC_LOG(LS_ERROR) << ToString() << ": Failed to send "
-                      << StunMethodToString(response.type())
+                      << StunMethodToString(type)
                       << ", to=" << addr.ToSensitiveString() << ", err=" << err
-                      << ", id=" << rtc::hex_encode(response.transaction_id());
+                      << ", id="
+                      << rtc::hex_encode(transaction_id.data(),
+                                         transaction_id.size());
   } else {
     // Log at LS_INFO if we send a stun ping response on an unwritable
     // connection.
     rtc::LoggingSeverity sev = (!writable()) ? rtc::LS_INFO : rtc::LS_VERBOSE;
-    RTC_LOG_V(sev) << ToString() << ": Sent "
-                   << StunMethodToString(response.type())
-                   << ", to=" << addr.ToSensitiveString()
-                   << ", id=" << rtc::hex_encode(response.transaction_id());
+    RTC_LOG_V(sev) << ToString() << ": Sent " << StunMethodToString(type)
+                   << ", to=" << addr.ToSensitiveString() << ", id="
+                   << rtc::hex_encode(transaction_id.data(),
+                                      transaction_id.size());
 
     stats_.sent_ping_responses++;
     LogCandidatePairEvent(webrtc::IceCandidatePairEventType::kCheckResponseSent,
-                          response.reduced_transaction_id());
+                          reduced_transaction_id);
   }
 }
 
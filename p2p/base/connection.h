@@ -15,6 +15,7 @@
 #include <string>
 #include <vector>
 
+#include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
 #include "api/candidate.h"
 #include "api/transport/stun.h"
@@ -233,6 +234,11 @@ class Connection : public CandidatePairInterface,
       const absl::optional<std::string>& request_id = absl::nullopt);
   // Handles the binding request; sends a response if this is a valid request.
   void HandleStunBindingOrGoogPingRequest(IceMessage* msg);
+  // Handles a common binding request, that needs neither an error response
+  // nor role conflict resolution, without parsing it into an IceMessage.
+  // Returns false if the request is left to
+  // HandleStunBindingOrGoogPingRequest().
+  bool MaybeHandleStunBindingRequestFast(const char* data, size_t size);
   // Handles the piggyback acknowledgement of the lastest connectivity check
   // that the remote peer has received, if it is indicated in the incoming
   // connectivity check from the peer.
@@ -319,9 +325,19 @@ class Connection : public CandidatePairInterface,
   // Does not trigger SignalStateChange
   void ForgetLearnedState();
 
+  // Parts of handling a connectivity check from the remote peer.
+  void MaybeSendExtraIcePing();
+  void OnRemoteNomination(uint32_t nomination);
+  void OnRemoteNetworkInfo(uint32_t network_info);
+
   void SendStunBindingResponse(const StunMessage* request);
   void SendGoogPingResponse(const StunMessage* request);
   void SendResponseMessage(const StunMessage& response);
+  void SendResponsePacket(int type,
+                          const void* data,
+                          size_t size,
+                          absl::string_view transaction_id,
+                          uint32_t reduced_transaction_id);
 
   // An accessor for unit tests.
   Port* PortForTest() { return port_; }
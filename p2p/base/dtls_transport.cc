@@ -81,6 +81,17 @@ rtc::StreamResult StreamInterfaceChannel::Read(void* buffer,
   if (state_ == rtc::SS_OPENING)
     return rtc::SR_BLOCK;
 
+  if (pending_packet_) {
+    // Like the queue, copies what fits and drops the rest of the packet.
+    const size_t bytes = std::min(buffer_len, pending_packet_->size());
+    memcpy(buffer, pending_packet_->data(), bytes);
+    pending_packet_ = absl::nullopt;
+    if (read) {
+      *read = bytes;
+    }
+    return rtc::SR_SUCCESS;
+  }
+
   if (!packets_.ReadFront(buffer, buffer_len, read)) {
     return rtc::SR_BLOCK;
   }
@@ -107,9 +118,27 @@ rtc::StreamResult StreamInterfaceChannel::Write(const void* data,
 
 bool StreamInterfaceChannel::OnPacketReceived(const char* data, size_t size) {
   RTC_DCHECK_RUN_ON(&sequence_checker_);
-  if (packets_.size() > 0) {
-    RTC_LOG(LS_WARNING) << "Packet already in queue.";
+  if (packets_.size() == 0 && !pending_packet_) {
+    // The SSLStreamAdapter normally reads the packet while the read event is
+    // signaled, so let Read() copy it straight from `data` instead of copying
+    // it through the queue first. It's queued only if it is left unread.
+    pending_packet_.emplace(data, size);
+    SignalEvent(this, rtc::SE_READ, 0);
+    if (!pending_packet_) {
+      // Read, or dropped by Close().
+      return true;
+    }
+    pending_packet_ = absl::nullopt;
+    return QueuePacket(data, size);
   }
+
+  RTC_LOG(LS_WARNING) << "Packet already in queue.";
+  bool ret = QueuePacket(data, size);
+  SignalEvent(this, rtc::SE_READ, 0);
+  return ret;
+}
+
+bool StreamInterfaceChannel::QueuePacket(const char* data, size_t size) {
   bool ret = packets_.WriteBack(data, size, NULL);
   if (!ret) {
     // Somehow we received another packet before the SSLStreamAdapter read the
@@ -118,7 +147,6 @@ bool StreamInterfaceChannel::OnPacketReceived(const char* data, size_t size) {
     // packet currently in packets_.
     RTC_LOG(LS_ERROR) << "Failed to write packet to queue.";
   }
-  SignalEvent(this, rtc::SE_READ, 0);
   return ret;
 }
 
@@ -130,6 +158,7 @@ rtc::StreamState StreamInterfaceChannel::GetState() const {
 void StreamInterfaceChannel::Close() {
   RTC_DCHECK_RUN_ON(&sequence_checker_);
   packets_.Clear();
+  pending_packet_ = absl::nullopt;
   state_ = rtc::SS_CLOSED;
 }
 
@@ -340,6 +369,9 @@ bool DtlsTransport::SetupDtls() {
 
   dtls_->SetIdentity(local_certificate_->identity()->Clone());
   dtls_->SetMode(rtc::SSL_MODE_DTLS);
+  if (handshake_queue_) {
+    dtls_->SetHandshakeQueue(handshake_queue_);
+  }
   dtls_->SetMaxProtocolVersion(ssl_max_version_);
   dtls_->SetServerRole(*dtls_role_);
   dtls_->SignalEvent.connect(this, &DtlsTransport::OnDtlsEvent);
@@ -470,6 +502,12 @@ int DtlsTransport::SetOption(rtc::Socket::Option opt, int value) {
   return ice_transport_->SetOption(opt, value);
 }
 
+void DtlsTransport::SetHandshakeQueue(webrtc::TaskQueueBase* queue) {
+  RTC_DCHECK_RUN_ON(&thread_checker_);
+  RTC_DCHECK(!dtls_);
+  handshake_queue_ = queue;
+}
+
 void DtlsTransport::ConnectToIceTransport() {
   RTC_DCHECK(ice_transport_);
   ice_transport_->SignalWritableState.connect(this,
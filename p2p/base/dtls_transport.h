@@ -15,9 +15,12 @@
 #include <string>
 #include <vector>
 
+#include "absl/types/optional.h"
+#include "api/array_view.h"
 #include "api/crypto/crypto_options.h"
 #include "api/dtls_transport_interface.h"
 #include "api/sequence_checker.h"
+#include "api/task_queue/task_queue_base.h"
 #include "p2p/base/dtls_transport_internal.h"
 #include "p2p/base/ice_transport_internal.h"
 #include "rtc_base/buffer.h"
@@ -56,10 +59,17 @@ class StreamInterfaceChannel : public rtc::StreamInterface {
                           int* error) override;
 
  private:
+  bool QueuePacket(const char* data, size_t size)
+      RTC_RUN_ON(sequence_checker_);
+
   RTC_NO_UNIQUE_ADDRESS webrtc::SequenceChecker sequence_checker_;
   IceTransportInternal* const ice_transport_;  // owned by DtlsTransport
   rtc::StreamState state_ RTC_GUARDED_BY(sequence_checker_);
   rtc::BufferQueue packets_ RTC_GUARDED_BY(sequence_checker_);
+  // The packet being passed to OnPacketReceived(), while it signals the read
+  // event and until it is read.
+  absl::optional<rtc::ArrayView<const char>> pending_packet_
+      RTC_GUARDED_BY(sequence_checker_);
 
   RTC_DISALLOW_COPY_AND_ASSIGN(StreamInterfaceChannel);
 };
@@ -187,6 +197,12 @@ class DtlsTransport : public DtlsTransportInternal {
 
   int SetOption(rtc::Socket::Option opt, int value) override;
 
+  // Runs the CPU-heavy parts of the DTLS handshake on `queue`, which must
+  // outlive this transport, instead of on the network thread. Packets are
+  // still sent and received on the network thread. Must be called before
+  // SetRemoteFingerprint().
+  void SetHandshakeQueue(webrtc::TaskQueueBase* queue);
+
   std::string ToString() const {
     const absl::string_view RECEIVING_ABBREV[2] = {"_", "R"};
     const absl::string_view WRITABLE_ABBREV[2] = {"_", "W"};
@@ -249,6 +265,8 @@ class DtlsTransport : public DtlsTransportInternal {
 
   webrtc::RtcEventLog* const event_log_;
 
+  webrtc::TaskQueueBase* handshake_queue_ = nullptr;
+
   RTC_DISALLOW_COPY_AND_ASSIGN(DtlsTransport);
 };
 
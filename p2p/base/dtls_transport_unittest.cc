@@ -13,7 +13,9 @@
 #include <algorithm>
 #include <memory>
 #include <set>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "api/dtls_transport_interface.h"
 #include "p2p/base/fake_ice_transport.h"
@@ -739,4 +741,71 @@ INSTANTIATE_TEST_SUITE_P(
                                             CALLER_RECEIVES_FINGERPRINT}),
         ::testing::Bool()));
 
+// Reads from a StreamInterfaceChannel when it signals the read event, if
+// `read_on_event` is set.
+class StreamInterfaceChannelReader : public sigslot::has_slots<> {
+ public:
+  explicit StreamInterfaceChannelReader(StreamInterfaceChannel* channel)
+      : channel_(channel) {
+    channel_->SignalEvent.connect(this,
+                                  &StreamInterfaceChannelReader::OnEvent);
+  }
+
+  bool read_on_event = true;
+  std::vector<std::string> packets;
+
+ private:
+  void OnEvent(rtc::StreamInterface* stream, int events, int err) {
+    char buffer[100];
+    size_t read;
+    int error;
+    while (read_on_event && (events & rtc::SE_READ) &&
+           channel_->Read(buffer, sizeof(buffer), &read, &error) ==
+               rtc::SR_SUCCESS) {
+      packets.emplace_back(buffer, read);
+    }
+  }
+
+  StreamInterfaceChannel* const channel_;
+};
+
+TEST(StreamInterfaceChannelTest, ReadsPacketWhileSignalingReadEvent) {
+  FakeIceTransport ice_transport("fake", 0);
+  StreamInterfaceChannel channel(&ice_transport);
+  StreamInterfaceChannelReader reader(&channel);
+
+  EXPECT_TRUE(channel.OnPacketReceived("first", 5));
+  EXPECT_TRUE(channel.OnPacketReceived("second", 6));
+  EXPECT_EQ(reader.packets, (std::vector<std::string>{"first", "second"}));
+
+  char buffer[100];
+  size_t read;
+  int error;
+  EXPECT_EQ(channel.Read(buffer, sizeof(buffer), &read, &error),
+            rtc::SR_BLOCK);
+}
+
+TEST(StreamInterfaceChannelTest, QueuesPacketLeftUnread) {
+  FakeIceTransport ice_transport("fake", 0);
+  StreamInterfaceChannel channel(&ice_transport);
+  StreamInterfaceChannelReader reader(&channel);
+  reader.read_on_event = false;
+
+  EXPECT_TRUE(channel.OnPacketReceived("first", 5));
+  EXPECT_TRUE(channel.OnPacketReceived("second", 6));
+  EXPECT_TRUE(reader.packets.empty());
+
+  // The packets are read in order, and what doesn't fit is dropped.
+  char buffer[100];
+  size_t read;
+  int error;
+  ASSERT_EQ(channel.Read(buffer, 3, &read, &error), rtc::SR_SUCCESS);
+  EXPECT_EQ(std::string(buffer, read), "fir");
+  ASSERT_EQ(channel.Read(buffer, sizeof(buffer), &read, &error),
+            rtc::SR_SUCCESS);
+  EXPECT_EQ(std::string(buffer, read), "second");
+  EXPECT_EQ(channel.Read(buffer, sizeof(buffer), &read, &error),
+            rtc::SR_BLOCK);
+}
+
 }  // namespace cricket
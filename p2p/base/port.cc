@@ -242,11 +242,11 @@ const std::vector<Candidate>& Port::Candidates() const {
 }
 
 Connection* Port::GetConnection(const rtc::SocketAddress& remote_addr) {
-  AddressMap::const_iterator iter = connections_.find(remote_addr);
-  if (iter != connections_.end())
-    return iter->second;
-  else
-    return NULL;
+  // Called for every received packet; `connection_index_` avoids walking the
+  // tree of `connections_` with costly SocketAddress comparisons.
+  Connection* conn = connection_index_.Find(remote_addr);
+  RTC_DCHECK_EQ(connection_index_.size(), connections_.size());
+  return conn;
 }
 
 void Port::AddAddress(const rtc::SocketAddress& address,
@@ -349,6 +349,8 @@ void Port::AddOrReplaceConnection(Connection* conn) {
     ret.first->second->Destroy();
     ret.first->second = conn;
   }
+  // Keyed by the map's copy of the address, which lives as long as the entry.
+  connection_index_.Insert(ret.first->first, conn);
   conn->SignalDestroyed.connect(this, &Port::OnConnectionDestroyed);
   SignalConnectionCreated(this, conn);
 }
@@ -899,6 +901,7 @@ void Port::OnConnectionDestroyed(Connection* conn) {
       connections_.find(conn->remote_candidate().address());
   RTC_DCHECK(iter != connections_.end());
   connections_.erase(iter);
+  connection_index_.Erase(conn->remote_candidate().address());
   HandleConnectionDestroyed(conn);
 
   // Ports time out after all connections fail if it is not marked as
@@ -924,6 +927,13 @@ const std::string Port::username_fragment() const {
   return ice_username_fragment_;
 }
 
+StunBindingFastPath* Port::stun_binding_fast_path() {
+  if (!stun_binding_fast_path_) {
+    stun_binding_fast_path_ = std::make_unique<StunBindingFastPath>();
+  }
+  return stun_binding_fast_path_.get();
+}
+
 void Port::CopyPortInformationToPacketInfo(rtc::PacketInfo* info) const {
   info->protocol = ConvertProtocolTypeToPacketInfoProtocolType(GetProtocol());
   info->network_id = Network()->id();
@@ -26,11 +26,13 @@
 #include "logging/rtc_event_log/events/rtc_event_ice_candidate_pair.h"
 #include "logging/rtc_event_log/events/rtc_event_ice_candidate_pair_config.h"
 #include "logging/rtc_event_log/ice_logger.h"
+#include "p2p/base/address_index.h"
 #include "p2p/base/candidate_pair_interface.h"
 #include "p2p/base/connection.h"
 #include "p2p/base/connection_info.h"
 #include "p2p/base/p2p_constants.h"
 #include "p2p/base/port_interface.h"
+#include "p2p/base/stun_binding_fast_path.h"
 #include "p2p/base/stun_request.h"
 #include "rtc_base/async_packet_socket.h"
 #include "rtc_base/callback_list.h"
@@ -451,6 +453,9 @@ class Port : public PortInterface,
 
   void OnNetworkTypeChanged(const rtc::Network* network);
 
+  // Used by the connections of this port to answer connectivity checks.
+  StunBindingFastPath* stun_binding_fast_path();
+
   rtc::Thread* const thread_;
   rtc::PacketSocketFactory* const factory_;
   std::string type_;
@@ -473,6 +478,8 @@ class Port : public PortInterface,
   std::string password_;
   std::vector<Candidate> candidates_;
   AddressMap connections_;
+  // The same connections, for the lookup of every received packet.
+  AddressIndex<Connection> connection_index_;
   int timeout_delay_;
   bool enable_port_packets_;
   IceRole ice_role_;
@@ -490,6 +497,8 @@ class Port : public PortInterface,
   int64_t last_time_all_connections_removed_ = 0;
   MdnsNameRegistrationStatus mdns_name_registration_status_ =
       MdnsNameRegistrationStatus::kNotStarted;
+  // Created on the first connectivity check received.
+  std::unique_ptr<StunBindingFastPath> stun_binding_fast_path_;
 
   rtc::WeakPtrFactory<Port> weak_factory_;
 
@@ -88,6 +88,12 @@ enum {
   // Exclude link-local network interfaces
   // from considertaion after adapter enumeration.
   PORTALLOCATOR_DISABLE_LINK_LOCAL_NETWORKS = 0x10000,
+
+  // When specified, the preferred (lowest-cost) networks create all their
+  // ports at once: host, STUN and TURN gathering start together instead of
+  // one phase per step delay. Other networks still step through the phases,
+  // so that gathering on them doesn't compete with the preferred ones.
+  PORTALLOCATOR_ENABLE_FAST_START = 0x20000,
 };
 
 // Defines various reasons that have caused ICE regathering.
@@ -99,6 +99,10 @@ const uint32_t DEFAULT_SND_BUF_SIZE = 90 * 1024;
 // 24 |                             data                              |
 //    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
 //
+// With FLAG_SACK, which is only sent to peers that offered TCP_OPT_SACK in
+// their connect message, the data is preceded by a count of SACK blocks and
+// the blocks, each a 32-bit left edge and a 32-bit right edge.
+//
 //////////////////////////////////////////////////////////////////////
 
 #define PSEUDO_KEEPALIVE 0
@@ -115,6 +119,9 @@ const uint32_t DEF_ACK_DELAY = 100;  // 100 milliseconds
 
 const uint8_t FLAG_CTL = 0x02;
 const uint8_t FLAG_RST = 0x04;
+const uint8_t FLAG_SACK = 0x08;
+
+const uint32_t SACK_BLOCK_SIZE = 8;
 
 const uint8_t CTL_CONNECT = 0;
 
@@ -123,6 +130,7 @@ const uint8_t TCP_OPT_EOL = 0;        // End of list.
 const uint8_t TCP_OPT_NOOP = 1;       // No-op.
 const uint8_t TCP_OPT_MSS = 2;        // Maximum segment size.
 const uint8_t TCP_OPT_WND_SCALE = 3;  // Window scale factor.
+const uint8_t TCP_OPT_SACK = 4;       // Selective acknowledgments allowed.
 
 const long DEFAULT_TIMEOUT =
     4000;  // If there are no pending clocks, wake up every 4 seconds
@@ -254,7 +262,16 @@ PseudoTcp::PseudoTcp(IPseudoTcpNotify* notify, uint32_t conv)
 
   m_use_nagling = true;
   m_ack_delay = DEF_ACK_DELAY;
+  m_offer_sack = false;
+  m_use_pacing = false;
   m_support_wnd_scale = true;
+
+  m_use_sack = false;
+  m_sack_recent = m_sack_high = m_sack_rexmit_nxt = 0;
+
+  m_pace_tokens = m_pace_last = m_pace_wakeup = 0;
+
+  m_packet_buffer.reset(new uint8_t[MAX_PACKET]);
 }
 
 PseudoTcp::~PseudoTcp() {}
@@ -331,6 +348,12 @@ void PseudoTcp::NotifyClock(uint32_t now) {
     m_rx_rto = std::min(MAX_RTO, m_rx_rto * 2);
   }
 
+  // Check if pacing allows sending again
+  if (m_pace_wakeup && (rtc::TimeDiff32(m_pace_wakeup, now) <= 0)) {
+    m_pace_wakeup = 0;
+    attemptSend();
+  }
+
   // Check if it's time to send delayed acks
   if (m_t_ack && (rtc::TimeDiff32(m_t_ack + m_ack_delay, now) <= 0)) {
     packet(m_snd_nxt, 0, 0, 0);
@@ -374,6 +397,10 @@ void PseudoTcp::GetOption(Option opt, int* value) {
     *value = m_sbuf_len;
   } else if (opt == OPT_RCVBUF) {
     *value = m_rbuf_len;
+  } else if (opt == OPT_SACK) {
+    *value = m_offer_sack ? 1 : 0;
+  } else if (opt == OPT_PACING) {
+    *value = m_use_pacing ? 1 : 0;
   } else {
     RTC_DCHECK_NOTREACHED();
   }
@@ -389,6 +416,12 @@ void PseudoTcp::SetOption(Option opt, int value) {
   } else if (opt == OPT_RCVBUF) {
     RTC_DCHECK(m_state == TCP_LISTEN);
     resizeReceiveBuffer(value);
+  } else if (opt == OPT_SACK) {
+    RTC_DCHECK(m_state == TCP_LISTEN);
+    m_offer_sack = value != 0;
+  } else if (opt == OPT_PACING) {
+    m_use_pacing = value != 0;
+    m_pace_wakeup = 0;
   } else {
     RTC_DCHECK_NOTREACHED();
   }
@@ -510,24 +543,36 @@ IPseudoTcpNotify::WriteResult PseudoTcp::packet(uint32_t seq,
 
   uint32_t now = Now();
 
-  std::unique_ptr<uint8_t[]> buffer(new uint8_t[MAX_PACKET]);
-  long_to_bytes(m_conv, buffer.get());
-  long_to_bytes(seq, buffer.get() + 4);
-  long_to_bytes(m_rcv_nxt, buffer.get() + 8);
+  uint8_t* buffer = m_packet_buffer.get();
+  uint32_t header_size = HEADER_SIZE;
+  // SACK blocks are only sent on ACKs, which leaves the MSS for data.
+  if (m_use_sack && len == 0 && !m_rlist.empty()) {
+    SackBlock blocks[kMaxSackBlocks];
+    const uint8_t num_blocks = buildSackBlocks(blocks);
+    flags |= FLAG_SACK;
+    buffer[header_size++] = num_blocks;
+    for (uint8_t i = 0; i < num_blocks; ++i) {
+      rtc::SetBE32(buffer + header_size, blocks[i].left);
+      rtc::SetBE32(buffer + header_size + 4, blocks[i].right);
+      header_size += SACK_BLOCK_SIZE;
+    }
+  }
+  long_to_bytes(m_conv, buffer);
+  long_to_bytes(seq, buffer + 4);
+  long_to_bytes(m_rcv_nxt, buffer + 8);
   buffer[12] = 0;
   buffer[13] = flags;
-  short_to_bytes(static_cast<uint16_t>(m_rcv_wnd >> m_rwnd_scale),
-                 buffer.get() + 14);
+  short_to_bytes(static_cast<uint16_t>(m_rcv_wnd >> m_rwnd_scale), buffer + 14);
 
   // Timestamp computations
-  long_to_bytes(now, buffer.get() + 16);
-  long_to_bytes(m_ts_recent, buffer.get() + 20);
+  long_to_bytes(now, buffer + 16);
+  long_to_bytes(m_ts_recent, buffer + 20);
   m_ts_lastack = m_rcv_nxt;
 
   if (len) {
     size_t bytes_read = 0;
     bool result =
-        m_sbuf.ReadOffset(buffer.get() + HEADER_SIZE, len, offset, &bytes_read);
+        m_sbuf.ReadOffset(buffer + header_size, len, offset, &bytes_read);
     RTC_DCHECK(result);
     RTC_DCHECK(static_cast<uint32_t>(bytes_read) == len);
   }
@@ -543,7 +588,7 @@ IPseudoTcpNotify::WriteResult PseudoTcp::packet(uint32_t seq,
 #endif  // _DEBUGMSG
 
   IPseudoTcpNotify::WriteResult wres = m_notify->TcpWritePacket(
-      this, reinterpret_cast<char*>(buffer.get()), len + HEADER_SIZE);
+      this, reinterpret_cast<char*>(buffer), len + header_size);
   // Note: When len is 0, this is an ACK packet.  We don't read the return value
   // for those, and thus we won't retry.  So go ahead and treat the packet as a
   // success (basically simulate as if it were dropped), which will prevent our
@@ -575,8 +620,25 @@ bool PseudoTcp::parse(const uint8_t* buffer, uint32_t size) {
   seg.tsval = bytes_to_long(buffer + 16);
   seg.tsecr = bytes_to_long(buffer + 20);
 
-  seg.data = reinterpret_cast<const char*>(buffer) + HEADER_SIZE;
-  seg.len = size - HEADER_SIZE;
+  uint32_t header_size = HEADER_SIZE;
+  seg.num_sack_blocks = 0;
+  if (seg.flags & FLAG_SACK) {
+    if (size < HEADER_SIZE + 1)
+      return false;
+    const uint8_t num_blocks = buffer[HEADER_SIZE];
+    header_size += 1 + num_blocks * SACK_BLOCK_SIZE;
+    if (num_blocks > kMaxSackBlocks || size < header_size)
+      return false;
+    for (uint8_t i = 0; i < num_blocks; ++i) {
+      const uint8_t* block = buffer + HEADER_SIZE + 1 + i * SACK_BLOCK_SIZE;
+      seg.sack_blocks[i].left = rtc::GetBE32(block);
+      seg.sack_blocks[i].right = rtc::GetBE32(block + 4);
+    }
+    seg.num_sack_blocks = num_blocks;
+  }
+
+  seg.data = reinterpret_cast<const char*>(buffer) + header_size;
+  seg.len = size - header_size;
 
 #if _DEBUGMSG >= _DBG_VERBOSE
   RTC_LOG(LS_INFO) << "--> <CONV=" << seg.conv
@@ -620,6 +682,9 @@ bool PseudoTcp::clock_check(uint32_t now, long& nTimeout) {
     nTimeout = std::min<int32_t>(nTimeout,
                                  rtc::TimeDiff32(m_lastsend + m_rx_rto, now));
   }
+  if (m_pace_wakeup) {
+    nTimeout = std::min<int32_t>(nTimeout, rtc::TimeDiff32(m_pace_wakeup, now));
+  }
 #if PSEUDO_KEEPALIVE
   if (m_state == TCP_ESTABLISHED) {
     nTimeout = std::min<int32_t>(
@@ -696,6 +761,10 @@ bool PseudoTcp::process(Segment& seg) {
     m_ts_recent = seg.tsval;
   }
 
+  if (m_use_sack && seg.num_sack_blocks) {
+    applySackBlocks(seg);
+  }
+
   // Check if this is a valuable ack
   if ((seg.ack > m_snd_una) && (seg.ack <= m_snd_nxt)) {
     // Calculate round-trip time
@@ -759,9 +828,18 @@ bool PseudoTcp::process(Segment& seg) {
 #if _DEBUGMSG >= _DBG_NORMAL
         RTC_LOG(LS_INFO) << "recovery retransmit";
 #endif  // _DEBUGMSG
-        if (!transmit(m_slist.begin(), now)) {
-          closedown(ECONNABORTED);
-          return false;
+        SList::iterator rexmit = m_slist.begin();
+        if (m_use_sack && rexmit->seq < m_sack_rexmit_nxt) {
+          // Already retransmitted in this recovery, try the next hole.
+          rexmit = nextSackHole();
+        }
+        if (rexmit != m_slist.end()) {
+          if (!transmit(rexmit, now)) {
+            closedown(ECONNABORTED);
+            return false;
+          }
+          m_sack_rexmit_nxt =
+              std::max(m_sack_rexmit_nxt, rexmit->seq + rexmit->len);
         }
         m_cwnd += m_mss - std::min(nAcked, m_cwnd);
       }
@@ -793,6 +871,7 @@ bool PseudoTcp::process(Segment& seg) {
           closedown(ECONNABORTED);
           return false;
         }
+        m_sack_rexmit_nxt = m_slist.begin()->seq + m_slist.begin()->len;
         m_recover = m_snd_nxt;
         uint32_t nInFlight = m_snd_nxt - m_snd_una;
         m_ssthresh = std::max(nInFlight / 2, 2 * m_mss);
@@ -800,7 +879,18 @@ bool PseudoTcp::process(Segment& seg) {
         // << nInFlight << "  m_mss: " << m_mss;
         m_cwnd = m_ssthresh + 3 * m_mss;
       } else if (m_dup_acks > 3) {
-        m_cwnd += m_mss;
+        // With SACK, each further duplicate ack lets a hole be retransmitted
+        // rather than new data be sent.
+        SList::iterator hole = m_use_sack ? nextSackHole() : m_slist.end();
+        if (hole != m_slist.end()) {
+          if (!transmit(hole, now)) {
+            closedown(ECONNABORTED);
+            return false;
+          }
+          m_sack_rexmit_nxt = hole->seq + hole->len;
+        } else {
+          m_cwnd += m_mss;
+        }
       }
     } else {
       m_dup_acks = 0;
@@ -934,6 +1024,7 @@ bool PseudoTcp::process(Segment& seg) {
         RSegment rseg;
         rseg.seq = seg.seq;
         rseg.len = seg.len;
+        m_sack_recent = seg.seq;
         RList::iterator it = m_rlist.begin();
         while ((it != m_rlist.end()) && (it->seq < rseg.seq)) {
           ++it;
@@ -1025,6 +1116,7 @@ bool PseudoTcp::transmit(const SList::iterator& seg, uint32_t now) {
     SSegment subseg(seg->seq + nTransmit, seg->len - nTransmit, seg->bCtrl);
     // subseg.tstamp = seg->tstamp;
     subseg.xmit = seg->xmit;
+    subseg.sacked = seg->sacked;
     seg->len = nTransmit;
 
     SList::iterator next = seg;
@@ -1091,6 +1183,10 @@ void PseudoTcp::attemptSend(SendFlags sflags) {
     }
 #endif  // _DEBUGMSG
 
+    if (nAvailable > 0 && m_use_pacing && !checkPacing(now, nAvailable)) {
+      nAvailable = 0;
+    }
+
     if (nAvailable == 0) {
       if (sflags == sfNone)
         return;
@@ -1132,6 +1228,9 @@ void PseudoTcp::attemptSend(SendFlags sflags) {
       // TODO(?): consider closing socket
       return;
     }
+    if (m_use_pacing) {
+      m_pace_tokens -= std::min(m_pace_tokens, seg->len);
+    }
 
     sflags = sfNone;
   }
@@ -1182,6 +1281,10 @@ void PseudoTcp::queueConnectMessage() {
     buf.WriteUInt8(1);
     buf.WriteUInt8(m_rwnd_scale);
   }
+  if (m_offer_sack) {
+    buf.WriteUInt8(TCP_OPT_SACK);
+    buf.WriteUInt8(0);
+  }
   m_snd_wnd = static_cast<uint32_t>(buf.Length());
   queue(buf.Data(), static_cast<uint32_t>(buf.Length()), true);
 }
@@ -1230,6 +1333,9 @@ void PseudoTcp::parseOptions(const char* data, uint32_t len) {
       m_swnd_scale = 0;
     }
   }
+
+  m_use_sack = m_offer_sack && (options_specified.find(TCP_OPT_SACK) !=
+                                options_specified.end());
 }
 
 void PseudoTcp::applyOption(char kind, const char* data, uint32_t len) {
@@ -1251,6 +1357,103 @@ void PseudoTcp::applyWindowScaleOption(uint8_t scale_factor) {
   m_swnd_scale = scale_factor;
 }
 
+uint8_t PseudoTcp::buildSackBlocks(SackBlock* blocks) const {
+  // Calls `fn` with each range of `m_rlist`, whose segments are sorted by
+  // sequence number but may overlap.
+  auto for_each_block = [this](auto fn) {
+    SackBlock block = {0, 0};
+    for (const RSegment& rseg : m_rlist) {
+      if (block.right != 0 && rseg.seq <= block.right) {
+        block.right = std::max(block.right, rseg.seq + rseg.len);
+        continue;
+      }
+      if (block.right != 0) {
+        fn(block);
+      }
+      block = {rseg.seq, rseg.seq + rseg.len};
+    }
+    if (block.right != 0) {
+      fn(block);
+    }
+  };
+  auto is_recent = [this](const SackBlock& block) {
+    return block.left <= m_sack_recent && m_sack_recent < block.right;
+  };
+
+  uint8_t num_blocks = 0;
+  for_each_block([&](const SackBlock& block) {
+    if (is_recent(block)) {
+      blocks[num_blocks++] = block;
+    }
+  });
+  for_each_block([&](const SackBlock& block) {
+    if (num_blocks < kMaxSackBlocks && !is_recent(block)) {
+      blocks[num_blocks++] = block;
+    }
+  });
+  return num_blocks;
+}
+
+void PseudoTcp::applySackBlocks(const Segment& seg) {
+  for (uint8_t i = 0; i < seg.num_sack_blocks; ++i) {
+    const SackBlock& block = seg.sack_blocks[i];
+    if (block.left >= block.right || block.left < m_snd_una ||
+        block.right > m_snd_nxt) {
+      continue;
+    }
+    for (SSegment& sseg : m_slist) {
+      if (sseg.seq >= block.right || sseg.xmit == 0) {
+        break;
+      }
+      if (!sseg.sacked && sseg.seq >= block.left &&
+          sseg.seq + sseg.len <= block.right) {
+        sseg.sacked = true;
+        m_sack_high = std::max(m_sack_high, sseg.seq + sseg.len);
+      }
+    }
+  }
+}
+
+PseudoTcp::SList::iterator PseudoTcp::nextSackHole() {
+  for (SList::iterator it = m_slist.begin(); it != m_slist.end(); ++it) {
+    if (it->xmit == 0 || it->seq >= m_sack_high) {
+      break;
+    }
+    if (!it->sacked && it->seq >= m_sack_rexmit_nxt) {
+      return it;
+    }
+  }
+  return m_slist.end();
+}
+
+bool PseudoTcp::checkPacing(uint32_t now, uint32_t len) {
+  if (m_rx_srtt == 0) {
+    // Nothing to pace over yet.
+    return true;
+  }
+  // Twice the congestion window per round trip in slow start, so that the
+  // window can grow, and a quarter more in congestion avoidance.
+  const uint64_t window =
+      (m_cwnd < m_ssthresh) ? 2 * uint64_t{m_cwnd} : uint64_t{m_cwnd} * 5 / 4;
+  const uint32_t rate_per_ms =
+      static_cast<uint32_t>(std::max<uint64_t>(1, window / m_rx_srtt));
+  // Allow bursts of a millisecond's worth of data, since that's the
+  // resolution of the clock.
+  const uint32_t max_tokens = std::max(2 * m_mss, rate_per_ms);
+  const uint64_t elapsed = static_cast<uint32_t>(now - m_pace_last);
+  m_pace_tokens = static_cast<uint32_t>(std::min<uint64_t>(
+      max_tokens, m_pace_tokens + elapsed * rate_per_ms));
+  m_pace_last = now;
+  if (m_pace_tokens >= len) {
+    m_pace_wakeup = 0;
+    return true;
+  }
+  const uint32_t wait =
+      (len - m_pace_tokens + rate_per_ms - 1) / rate_per_ms;
+  m_pace_wakeup = now + std::max<uint32_t>(1, wait);
+  return false;
+}
+
 void PseudoTcp::resizeSendBuffer(uint32_t new_size) {
   m_sbuf_len = new_size;
   m_sbuf.SetCapacity(new_size);
@@ -91,13 +91,20 @@ class RTC_EXPORT PseudoTcp {
   // instance's behaviour for the kind of data it will carry.
   // If an unrecognized option is set or got, an assertion will fire.
   //
-  // Setting options for OPT_RCVBUF or OPT_SNDBUF after Connect() is called
-  // will result in an assertion.
+  // Setting options for OPT_RCVBUF, OPT_SNDBUF or OPT_SACK after Connect() is
+  // called will result in an assertion.
+  //
+  // For high throughput, set large buffers (they are announced with window
+  // scaling) and enable OPT_SACK and OPT_PACING on both sides. SACK is only
+  // used when both sides enable it, so peers that don't know about it are
+  // still understood.
   enum Option {
     OPT_NODELAY,   // Whether to enable Nagle's algorithm (0 == off)
     OPT_ACKDELAY,  // The Delayed ACK timeout (0 == off).
     OPT_RCVBUF,    // Set the receive buffer size, in bytes.
     OPT_SNDBUF,    // Set the send buffer size, in bytes.
+    OPT_SACK,      // Whether to offer selective acknowledgments (0 == off).
+    OPT_PACING,    // Whether to spread sends over the round trip (0 == off).
   };
   void GetOption(Option opt, int* value);
   void SetOption(Option opt, int value);
@@ -119,6 +126,12 @@ class RTC_EXPORT PseudoTcp {
  protected:
   enum SendFlags { sfNone, sfDelayedAck, sfImmediateAck };
 
+  // A range of received data, [left, right), past a gap (RFC 2018).
+  struct SackBlock {
+    uint32_t left, right;
+  };
+  static constexpr uint8_t kMaxSackBlocks = 4;
+
   struct Segment {
     uint32_t conv, seq, ack;
     uint8_t flags;
@@ -126,15 +139,19 @@ class RTC_EXPORT PseudoTcp {
     const char* data;
     uint32_t len;
     uint32_t tsval, tsecr;
+    uint8_t num_sack_blocks;
+    SackBlock sack_blocks[kMaxSackBlocks];
   };
 
   struct SSegment {
     SSegment(uint32_t s, uint32_t l, bool c)
-        : seq(s), len(l), /*tstamp(0),*/ xmit(0), bCtrl(c) {}
+        : seq(s), len(l), /*tstamp(0),*/ xmit(0), bCtrl(c), sacked(false) {}
     uint32_t seq, len;
     // uint32_t tstamp;
     uint8_t xmit;
     bool bCtrl;
+    // Whether the peer selectively acknowledged this segment.
+    bool sacked;
   };
   typedef std::list<SSegment> SList;
 
@@ -190,6 +207,23 @@ class RTC_EXPORT PseudoTcp {
   // Apply window scale option.
   void applyWindowScaleOption(uint8_t scale_factor);
 
+  // Writes the SACK blocks describing `m_rlist` to `blocks`, the most
+  // recently changed first, and returns how many were written.
+  uint8_t buildSackBlocks(SackBlock* blocks) const;
+
+  // Marks the segments that `seg` selectively acknowledges.
+  void applySackBlocks(const Segment& seg);
+
+  // Returns the next segment to retransmit during fast recovery: one that
+  // was sent before data that the peer selectively acknowledged, and wasn't
+  // retransmitted in this recovery yet. Returns m_slist.end() if none.
+  SList::iterator nextSackHole();
+
+  // Returns whether pacing allows sending `len` bytes now. If not, sets
+  // `m_pace_wakeup` to the time when it will. attemptSend() takes the bytes
+  // that it sends from `m_pace_tokens`.
+  bool checkPacing(uint32_t now, uint32_t len);
+
   // Resize the send buffer with `new_size` in bytes.
   void resizeSendBuffer(uint32_t new_size);
 
@@ -284,6 +318,26 @@ class RTC_EXPORT PseudoTcp {
   // Configuration options
   bool m_use_nagling;
   uint32_t m_ack_delay;
+  bool m_offer_sack;
+  bool m_use_pacing;
+
+  // Selective acknowledgments, used when both sides offered them.
+  bool m_use_sack;
+  // The start of the out-of-order segment received last.
+  uint32_t m_sack_recent;
+  // The end of the highest segment that the peer selectively acknowledged.
+  uint32_t m_sack_high;
+  // Holes before this are retransmitted in the current recovery already.
+  uint32_t m_sack_rexmit_nxt;
+
+  // Pacing: a token bucket of bytes that may be sent, refilled at about
+  // cwnd / srtt, and the time to send again when it ran dry (0 == none).
+  uint32_t m_pace_tokens;
+  uint32_t m_pace_last;
+  uint32_t m_pace_wakeup;
+
+  // Packets are built here rather than in a new buffer each time.
+  std::unique_ptr<uint8_t[]> m_packet_buffer;
 
   // This is used by unit tests to test backward compatibility of
   // PseudoTcp implementations that don't support window scaling.
@@ -0,0 +1,187 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "benchmark/benchmark.h"
+#include "p2p/base/pseudo_tcp.h"
+#include "rtc_base/fake_clock.h"
+#include "rtc_base/random.h"
+#include "rtc_base/system/unused.h"
+#include "rtc_base/time_utils.h"
+
+namespace cricket {
+namespace {
+
+constexpr int kMtu = 1500;
+constexpr int kBufferSize = 1024 * 1024;
+constexpr int kTransferSize = 8 * 1024 * 1024;
+
+// Two PseudoTcps connected by a link with a fixed one-way delay and random
+// loss, run on a fake clock so that the transfer takes no real waiting.
+class Loopback : public IPseudoTcpNotify {
+ public:
+  Loopback(int delay_ms, int loss_percent, bool sack, bool pacing)
+      : delay_ms_(delay_ms),
+        loss_percent_(loss_percent),
+        sender_(this, 1),
+        receiver_(this, 1),
+        payload_(16 * 1024, 'x') {
+    // Time 0 means "unset" to PseudoTcp.
+    clock_.SetTime(webrtc::Timestamp::Seconds(1));
+    for (PseudoTcp* tcp : {&sender_, &receiver_}) {
+      tcp->NotifyMTU(kMtu);
+      tcp->SetOption(PseudoTcp::OPT_RCVBUF, kBufferSize);
+      tcp->SetOption(PseudoTcp::OPT_SNDBUF, 3 * kBufferSize / 2);
+      tcp->SetOption(PseudoTcp::OPT_SACK, sack);
+      tcp->SetOption(PseudoTcp::OPT_PACING, pacing);
+    }
+  }
+
+  // Transfers `size` bytes, and returns how long that took on the fake
+  // clock, in milliseconds.
+  int64_t Transfer(int size) {
+    to_send_ = size;
+    to_receive_ = size;
+    const int64_t start = rtc::TimeMillis();
+    sender_.Connect();
+    while (to_receive_ > 0) {
+      if (!Step()) {
+        return -1;
+      }
+    }
+    return rtc::TimeMillis() - start;
+  }
+
+  // IPseudoTcpNotify implementation.
+  void OnTcpOpen(PseudoTcp* tcp) override {
+    if (tcp == &sender_) {
+      OnTcpWriteable(tcp);
+    }
+  }
+  void OnTcpReadable(PseudoTcp* tcp) override {
+    char buffer[16 * 1024];
+    int read;
+    while ((read = tcp->Recv(buffer, sizeof(buffer))) > 0) {
+      to_receive_ -= read;
+    }
+  }
+  void OnTcpWriteable(PseudoTcp* tcp) override {
+    while (to_send_ > 0) {
+      int sent = tcp->Send(payload_.data(),
+                           std::min<size_t>(to_send_, payload_.size()));
+      if (sent <= 0) {
+        break;
+      }
+      to_send_ -= sent;
+    }
+  }
+  void OnTcpClosed(PseudoTcp* tcp, uint32_t error) override {
+    closed_ = true;
+  }
+  WriteResult TcpWritePacket(PseudoTcp* tcp,
+                             const char* buffer,
+                             size_t len) override {
+    if (random_.Rand(99) >= static_cast<uint32_t>(loss_percent_)) {
+      PseudoTcp* to = tcp == &sender_ ? &receiver_ : &sender_;
+      packets_.emplace(
+          std::make_pair(rtc::TimeMillis() + delay_ms_, sequence_++),
+          std::make_pair(to, std::string(buffer, len)));
+    }
+    return WR_SUCCESS;
+  }
+
+ private:
+  // Advances the clock to the next packet or timer, and handles it.
+  bool Step() {
+    if (closed_) {
+      return false;
+    }
+    const int64_t now = rtc::TimeMillis();
+    int64_t next = now + 60 * 1000;
+    for (PseudoTcp* tcp : {&sender_, &receiver_}) {
+      long timeout = 0;  // NOLINT
+      if (tcp->GetNextClock(static_cast<uint32_t>(now), timeout)) {
+        next = std::min<int64_t>(next, now + std::max(0L, timeout));
+      }
+    }
+    if (!packets_.empty()) {
+      next = std::min(next, packets_.begin()->first.first);
+    }
+    if (next > now) {
+      clock_.AdvanceTime(webrtc::TimeDelta::Millis(next - now));
+    }
+    while (!packets_.empty() &&
+           packets_.begin()->first.first <= rtc::TimeMillis()) {
+      auto packet = std::move(packets_.begin()->second);
+      packets_.erase(packets_.begin());
+      packet.first->NotifyPacket(packet.second.data(), packet.second.size());
+    }
+    for (PseudoTcp* tcp : {&sender_, &receiver_}) {
+      tcp->NotifyClock(PseudoTcp::Now());
+    }
+    return true;
+  }
+
+  rtc::ScopedBaseFakeClock clock_;
+  const int delay_ms_;
+  const int loss_percent_;
+  PseudoTcp sender_;
+  PseudoTcp receiver_;
+  const std::string payload_;
+  webrtc::Random random_{42};
+  // Packets in flight by {arrival time, sequence}, to keep their order.
+  std::map<std::pair<int64_t, uint64_t>, std::pair<PseudoTcp*, std::string>>
+      packets_;
+  uint64_t sequence_ = 0;
+  int to_send_ = 0;
+  int to_receive_ = 0;
+  bool closed_ = false;
+};
+
+// Reports the throughput on the simulated link as "Mbps", and the CPU time
+// that the transfer takes as the benchmark time.
+void BM_PseudoTcpTransfer(benchmark::State& state) {
+  int64_t transfer_ms = 0;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    Loopback loopback(state.range(0), state.range(1), state.range(2),
+                      state.range(3));
+    transfer_ms = loopback.Transfer(kTransferSize);
+    if (transfer_ms <= 0) {
+      state.SkipWithError("transfer failed");
+      return;
+    }
+  }
+  state.counters["Mbps"] = kTransferSize * 8.0 / (transfer_ms * 1000.0);
+  state.SetBytesProcessed(state.iterations() * int64_t{kTransferSize});
+}
+
+// {one-way delay in ms, loss in percent, SACK, pacing}.
+BENCHMARK(BM_PseudoTcpTransfer)
+    ->ArgNames({"delay", "loss", "sack", "pacing"})
+    ->Args({10, 0, 0, 0})
+    ->Args({10, 0, 1, 1})
+    ->Args({10, 1, 0, 0})
+    ->Args({10, 1, 1, 0})
+    ->Args({10, 1, 1, 1})
+    ->Args({50, 1, 0, 0})
+    ->Args({50, 1, 1, 1})
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace cricket
@@ -99,6 +99,16 @@ class PseudoTcpTestBase : public ::testing::Test,
   void SetLocalOptRcvBuf(int size) {
     local_.SetOption(PseudoTcp::OPT_RCVBUF, size);
   }
+  void SetLocalOptSack(bool enable) {
+    local_.SetOption(PseudoTcp::OPT_SACK, enable);
+  }
+  void SetRemoteOptSack(bool enable) {
+    remote_.SetOption(PseudoTcp::OPT_SACK, enable);
+  }
+  void SetOptPacing(bool enable) {
+    local_.SetOption(PseudoTcp::OPT_PACING, enable);
+    remote_.SetOption(PseudoTcp::OPT_PACING, enable);
+  }
   void DisableRemoteWindowScale() { remote_.disableWindowScale(); }
   void DisableLocalWindowScale() { local_.disableWindowScale(); }
 
@@ -155,6 +165,10 @@ class PseudoTcpTestBase : public ::testing::Test,
   virtual WriteResult TcpWritePacket(PseudoTcp* tcp,
                                      const char* buffer,
                                      size_t len) {
+    // Count the ACKs that carry SACK blocks, see the header of pseudo_tcp.cc.
+    if (tcp == &remote_ && len > 13 && (buffer[13] & 0x08)) {
+      ++remote_sack_packets_;
+    }
     // Drop a packet if the test called DropNextPacket.
     if (drop_next_packet_) {
       drop_next_packet_ = false;
@@ -230,6 +244,7 @@ class PseudoTcpTestBase : public ::testing::Test,
   int loss_;
   bool drop_next_packet_ = false;
   bool simultaneous_open_ = false;
+  int remote_sack_packets_ = 0;
 };
 
 class PseudoTcpTest : public PseudoTcpTestBase {
@@ -642,6 +657,62 @@ TEST_F(PseudoTcpTest, TestSendWithDelayAndLoss) {
   TestTransfer(100000);  // less data so test runs faster
 }
 
+// Test sending data with packet loss when both sides use selective
+// acknowledgments.
+TEST_F(PseudoTcpTest, TestSendWithLossAndSack) {
+  SetLocalMtu(1500);
+  SetRemoteMtu(1500);
+  SetLoss(10);
+  SetLocalOptSack(true);
+  SetRemoteOptSack(true);
+  TestTransfer(100000);
+  EXPECT_GT(remote_sack_packets_, 0);
+}
+
+TEST_F(PseudoTcpTest, TestSendWithDelayAndLossAndSack) {
+  SetLocalMtu(1500);
+  SetRemoteMtu(1500);
+  SetDelay(50);
+  SetLoss(10);
+  SetLocalOptSack(true);
+  SetRemoteOptSack(true);
+  TestTransfer(100000);
+  EXPECT_GT(remote_sack_packets_, 0);
+}
+
+// SACK is not used unless both sides offer it.
+TEST_F(PseudoTcpTest, TestSendWithLossAndSackOnOneSide) {
+  SetLocalMtu(1500);
+  SetRemoteMtu(1500);
+  SetLoss(10);
+  SetLocalOptSack(true);
+  TestTransfer(100000);
+  EXPECT_EQ(0, remote_sack_packets_);
+}
+
+TEST_F(PseudoTcpTest, TestSendWithDelayAndPacing) {
+  SetLocalMtu(1500);
+  SetRemoteMtu(1500);
+  SetDelay(50);
+  SetOptPacing(true);
+  TestTransfer(1000000);
+}
+
+// The high throughput configuration: large windows, SACK and pacing.
+TEST_F(PseudoTcpTest, TestSendWithDelayAndLossAndLargeWindowSackPacing) {
+  SetLocalMtu(1500);
+  SetRemoteMtu(1500);
+  SetDelay(20);
+  SetLoss(2);
+  SetRemoteOptRcvBuf(1000000);
+  SetLocalOptRcvBuf(1000000);
+  SetOptSndBuf(1500000);
+  SetLocalOptSack(true);
+  SetRemoteOptSack(true);
+  SetOptPacing(true);
+  TestTransfer(1000000);
+}
+
 // Test sending data with 10% packet loss and Nagling disabled.  Transmission
 // should take about the same time as with Nagling enabled.
 TEST_F(PseudoTcpTest, TestSendWithLossAndOptNaglingOff) {
@@ -0,0 +1,105 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/sharded_turn_server.h"
+
+#include <utility>
+
+#include "p2p/base/basic_packet_socket_factory.h"
+#include "rtc_base/async_udp_socket.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/socket.h"
+#include "rtc_base/socket_server.h"
+
+namespace cricket {
+
+std::unique_ptr<ShardedTurnServer> ShardedTurnServer::Create(
+    int num_shards,
+    const rtc::SocketAddress& internal_address,
+    const rtc::IPAddress& external_ip,
+    ConfigureCallback configure) {
+  RTC_DCHECK_GT(num_shards, 0);
+  std::unique_ptr<ShardedTurnServer> sharded(new ShardedTurnServer());
+  sharded->internal_address_ = internal_address;
+  // Shards are referenced by pointer while starting.
+  sharded->shards_.reserve(num_shards);
+  for (int i = 0; i < num_shards; ++i) {
+    sharded->shards_.emplace_back();
+    Shard* shard = &sharded->shards_.back();
+    shard->thread = rtc::Thread::CreateWithSocketServer();
+    shard->thread->SetName("TurnShard", nullptr);
+    shard->thread->Start();
+    bool started = shard->thread->Invoke<bool>(RTC_FROM_HERE, [&] {
+      return sharded->StartShard(shard, external_ip, configure);
+    });
+    if (!started) {
+      return nullptr;
+    }
+  }
+  RTC_LOG(LS_INFO) << "TURN server listening at "
+                   << sharded->internal_address_.ToString() << " with "
+                   << num_shards << " shards";
+  return sharded;
+}
+
+ShardedTurnServer::~ShardedTurnServer() {
+  for (Shard& shard : shards_) {
+    shard.thread->Invoke<void>(RTC_FROM_HERE, [&] { shard.server.reset(); });
+    shard.thread->Stop();
+  }
+}
+
+void ShardedTurnServer::ForEachServer(
+    rtc::FunctionView<void(TurnServer* server)> callback) {
+  for (Shard& shard : shards_) {
+    shard.thread->Invoke<void>(RTC_FROM_HERE,
+                               [&] { callback(shard.server.get()); });
+  }
+}
+
+bool ShardedTurnServer::StartShard(Shard* shard,
+                                   const rtc::IPAddress& external_ip,
+                                   const ConfigureCallback& configure) {
+  rtc::SocketServer* socket_server = shard->thread->socketserver();
+  std::unique_ptr<rtc::Socket> socket(
+      socket_server->CreateSocket(internal_address_.family(), SOCK_DGRAM));
+  if (!socket) {
+    return false;
+  }
+  // Without SO_REUSEPORT only the first shard can bind the address.
+  if (socket->SetOption(rtc::Socket::OPT_REUSEPORT, 1) < 0) {
+    RTC_LOG(LS_ERROR) << "Failed to set SO_REUSEPORT, error "
+                      << socket->GetError();
+    return false;
+  }
+  if (socket->Bind(internal_address_) < 0) {
+    RTC_LOG(LS_ERROR) << "Failed to bind "
+                      << internal_address_.ToSensitiveString() << ", error "
+                      << socket->GetError();
+    return false;
+  }
+  if (internal_address_.port() == 0) {
+    internal_address_ = socket->GetLocalAddress();
+  }
+
+  shard->server = std::make_unique<TurnServer>(shard->thread.get());
+  if (configure) {
+    configure(shard->server.get());
+  }
+  shard->server->AddInternalSocket(new rtc::AsyncUDPSocket(socket.release()),
+                                   PROTO_UDP);
+  shard->server->SetExternalSocketFactory(
+      new rtc::BasicPacketSocketFactory(socket_server),
+      rtc::SocketAddress(external_ip, 0));
+  return true;
+}
+
+}  // namespace cricket
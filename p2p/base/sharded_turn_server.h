@@ -0,0 +1,82 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef P2P_BASE_SHARDED_TURN_SERVER_H_
+#define P2P_BASE_SHARDED_TURN_SERVER_H_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "api/function_view.h"
+#include "p2p/base/turn_server.h"
+#include "rtc_base/ip_address.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/thread.h"
+
+namespace cricket {
+
+// Runs several TurnServer instances, each on its own thread, behind a single
+// UDP address. Every shard binds its own socket to the address with
+// SO_REUSEPORT, and the kernel spreads clients over the sockets by hashing
+// the 5-tuple. All packets of a client, and therefore its allocation, stay on
+// one shard, so the shards share no state.
+//
+// Hooks passed to the servers, such as the TurnAuthInterface, are called on
+// all shard threads and must be thread-safe.
+class ShardedTurnServer {
+ public:
+  // Called on the thread of each shard, before it starts serving, to set
+  // realm, software, hooks, etc.
+  using ConfigureCallback = std::function<void(TurnServer* server)>;
+
+  // Returns null if the sockets can't be bound. If the port of
+  // `internal_address` is 0, all shards use the port picked for the first.
+  // Relayed addresses are allocated on `external_ip`.
+  static std::unique_ptr<ShardedTurnServer> Create(
+      int num_shards,
+      const rtc::SocketAddress& internal_address,
+      const rtc::IPAddress& external_ip,
+      ConfigureCallback configure);
+  // Destroys the servers on their threads, then stops the threads.
+  ~ShardedTurnServer();
+
+  ShardedTurnServer(const ShardedTurnServer&) = delete;
+  ShardedTurnServer& operator=(const ShardedTurnServer&) = delete;
+
+  const rtc::SocketAddress& internal_address() const {
+    return internal_address_;
+  }
+  int num_shards() const { return static_cast<int>(shards_.size()); }
+
+  // Calls `callback` for each server, on the thread of that server.
+  void ForEachServer(rtc::FunctionView<void(TurnServer* server)> callback);
+
+ private:
+  struct Shard {
+    std::unique_ptr<rtc::Thread> thread;
+    std::unique_ptr<TurnServer> server;
+  };
+
+  ShardedTurnServer() = default;
+
+  // Binds a socket for the shard and starts its server. Runs on the thread
+  // of the shard.
+  bool StartShard(Shard* shard,
+                  const rtc::IPAddress& external_ip,
+                  const ConfigureCallback& configure);
+
+  rtc::SocketAddress internal_address_;
+  std::vector<Shard> shards_;
+};
+
+}  // namespace cricket
+
+#endif  // P2P_BASE_SHARDED_TURN_SERVER_H_
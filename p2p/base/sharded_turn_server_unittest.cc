@@ -0,0 +1,125 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/sharded_turn_server.h"
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "api/transport/stun.h"
+#include "rtc_base/async_udp_socket.h"
+#include "rtc_base/byte_buffer.h"
+#include "rtc_base/helpers.h"
+#include "rtc_base/physical_socket_server.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/test_client.h"
+#include "rtc_base/thread.h"
+#include "test/gtest.h"
+
+namespace cricket {
+namespace {
+
+const rtc::SocketAddress kLoopbackAddress("127.0.0.1", 0);
+
+}  // namespace
+
+class ShardedTurnServerTest : public ::testing::Test {
+ public:
+  ShardedTurnServerTest() : main_(&ss_) {}
+
+  std::unique_ptr<rtc::TestClient> CreateClient() {
+    return std::make_unique<rtc::TestClient>(
+        absl::WrapUnique(rtc::AsyncUDPSocket::Create(&ss_, kLoopbackAddress)));
+  }
+
+  // Sends a binding request and returns the mapped address of the response,
+  // or nil if there was none.
+  rtc::SocketAddress SendBindingRequest(rtc::TestClient* client,
+                                        const rtc::SocketAddress& server) {
+    StunMessage request;
+    request.SetType(STUN_BINDING_REQUEST);
+    request.SetTransactionID(rtc::CreateRandomString(kStunTransactionIdLength));
+    rtc::ByteBufferWriter buf;
+    request.Write(&buf);
+    client->SendTo(buf.Data(), buf.Length(), server);
+
+    std::unique_ptr<rtc::TestClient::Packet> packet =
+        client->NextPacket(rtc::TestClient::kTimeoutMs);
+    if (!packet) {
+      return rtc::SocketAddress();
+    }
+    StunMessage response;
+    rtc::ByteBufferReader reader(packet->buf, packet->size);
+    if (!response.Read(&reader) || response.type() != STUN_BINDING_RESPONSE ||
+        response.transaction_id() != request.transaction_id()) {
+      return rtc::SocketAddress();
+    }
+    const StunAddressAttribute* mapped =
+        response.GetAddress(STUN_ATTR_XOR_MAPPED_ADDRESS);
+    return mapped ? mapped->GetAddress() : rtc::SocketAddress();
+  }
+
+ protected:
+  rtc::PhysicalSocketServer ss_;
+  rtc::AutoSocketServerThread main_;
+};
+
+TEST_F(ShardedTurnServerTest, ConfiguresEachShardOnItsThread) {
+  webrtc::Mutex mutex;
+  std::set<rtc::Thread*> threads;
+  auto server = ShardedTurnServer::Create(
+      3, kLoopbackAddress, kLoopbackAddress.ipaddr(),
+      [&](TurnServer* turn_server) {
+        webrtc::MutexLock lock(&mutex);
+        threads.insert(rtc::Thread::Current());
+        turn_server->set_software("sharded");
+      });
+  ASSERT_TRUE(server);
+  EXPECT_EQ(3, server->num_shards());
+  EXPECT_NE(0, server->internal_address().port());
+
+  webrtc::MutexLock lock(&mutex);
+  EXPECT_EQ(3u, threads.size());
+  EXPECT_EQ(0u, threads.count(&main_));
+}
+
+TEST_F(ShardedTurnServerTest, AllShardsAnswerOnTheSameAddress) {
+  auto server = ShardedTurnServer::Create(2, kLoopbackAddress,
+                                          kLoopbackAddress.ipaddr(), nullptr);
+  ASSERT_TRUE(server);
+
+  std::vector<std::unique_ptr<rtc::TestClient>> clients;
+  for (int i = 0; i < 8; ++i) {
+    clients.push_back(CreateClient());
+    rtc::SocketAddress mapped =
+        SendBindingRequest(clients.back().get(), server->internal_address());
+    EXPECT_EQ(clients.back()->address(), mapped);
+  }
+
+  int servers = 0;
+  server->ForEachServer([&](TurnServer* turn_server) {
+    EXPECT_TRUE(turn_server);
+    ++servers;
+  });
+  EXPECT_EQ(2, servers);
+}
+
+TEST_F(ShardedTurnServerTest, FailsWhenTheAddressIsTaken) {
+  std::unique_ptr<rtc::AsyncUDPSocket> taken(
+      rtc::AsyncUDPSocket::Create(&ss_, kLoopbackAddress));
+  ASSERT_TRUE(taken);
+  EXPECT_FALSE(ShardedTurnServer::Create(2, taken->GetLocalAddress(),
+                                         kLoopbackAddress.ipaddr(), nullptr));
+}
+
+}  // namespace cricket
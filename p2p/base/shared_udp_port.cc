@@ -0,0 +1,456 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/shared_udp_port.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "absl/algorithm/container.h"
+#include "api/transport/stun.h"
+#include "p2p/base/stun_request.h"
+#include "rtc_base/async_packet_socket.h"
+#include "rtc_base/async_udp_socket.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/byte_order.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/task_utils/pending_task_safety_flag.h"
+#include "rtc_base/task_utils/to_queued_task.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/time_utils.h"
+
+namespace cricket {
+
+namespace {
+
+// How often expired STUN transactions are dropped from the routing table.
+const int64_t kTransactionPruneIntervalMs = 1000;
+
+// Returns the type of the STUN message in `data`, or 0 if it isn't an
+// RFC 5389 STUN message.
+int GetStunMessageType(const char* data, size_t size) {
+  if (size < kStunHeaderSize || (data[0] & 0xC0) != 0 ||
+      rtc::GetBE32(data + kStunMagicCookieLength) != kStunMagicCookie) {
+    return 0;
+  }
+  return rtc::GetBE16(data);
+}
+
+std::string GetStunTransactionId(const char* data) {
+  return std::string(data + kStunTransactionIdOffset,
+                     kStunTransactionIdLength);
+}
+
+// Returns the ufrag of the receiving side from the USERNAME attribute of a
+// STUN request, which is formatted as "<receiver ufrag>:<sender ufrag>".
+absl::string_view GetLocalUfrag(const char* data, size_t size) {
+  size_t length =
+      std::min<size_t>(size, kStunHeaderSize + rtc::GetBE16(data + 2));
+  size_t offset = kStunHeaderSize;
+  while (offset + kStunAttributeHeaderSize <= length) {
+    uint16_t type = rtc::GetBE16(data + offset);
+    uint16_t attr_length = rtc::GetBE16(data + offset + 2);
+    offset += kStunAttributeHeaderSize;
+    if (offset + attr_length > length) {
+      break;
+    }
+    if (type == STUN_ATTR_USERNAME) {
+      absl::string_view username(data + offset, attr_length);
+      return username.substr(0, username.find(':'));
+    }
+    // Attributes are padded to a multiple of four bytes.
+    offset += (attr_length + 3) & ~3;
+  }
+  return absl::string_view();
+}
+
+}  // namespace
+
+// The socket bound to the shared port on one thread. Sessions on that thread
+// send through it directly.
+class SharedUdpPort::ThreadSocket : public sigslot::has_slots<> {
+ public:
+  ThreadSocket(SharedUdpPort* shared_port,
+               rtc::Thread* thread,
+               const rtc::IPAddress& ip,
+               std::unique_ptr<rtc::AsyncPacketSocket> socket)
+      : shared_port_(shared_port),
+        thread_(thread),
+        ip_(ip),
+        socket_(std::move(socket)) {
+    socket_->SignalReadPacket.connect(this, &ThreadSocket::OnReadPacket);
+    socket_->SignalSentPacket.connect(this, &ThreadSocket::OnSentPacket);
+    socket_->SignalReadyToSend.connect(this, &ThreadSocket::OnReadyToSend);
+  }
+
+  rtc::Thread* thread() const { return thread_; }
+  const rtc::IPAddress& ip() const { return ip_; }
+  rtc::AsyncPacketSocket* socket() const { return socket_.get(); }
+
+  void AddSession(SessionSocket* session) {
+    RTC_DCHECK(thread_->IsCurrent());
+    sessions_.push_back(session);
+  }
+  // Returns the number of sessions left.
+  size_t RemoveSession(SessionSocket* session) {
+    RTC_DCHECK(thread_->IsCurrent());
+    sessions_.erase(std::remove(sessions_.begin(), sessions_.end(), session),
+                    sessions_.end());
+    return sessions_.size();
+  }
+
+  int SendTo(SessionSocket* sender,
+             const void* data,
+             size_t size,
+             const rtc::SocketAddress& addr,
+             const rtc::PacketOptions& options) {
+    RTC_DCHECK(thread_->IsCurrent());
+    // SignalSentPacket is emitted synchronously, so attribute it to `sender`.
+    sender_ = sender;
+    int result = socket_->SendTo(data, size, addr, options);
+    sender_ = nullptr;
+    return result;
+  }
+
+ private:
+  void OnReadPacket(rtc::AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t size,
+                    const rtc::SocketAddress& remote_addr,
+                    const int64_t& packet_time_us) {
+    shared_port_->OnReceive(this, data, size, remote_addr, packet_time_us);
+  }
+  void OnSentPacket(rtc::AsyncPacketSocket* socket,
+                    const rtc::SentPacket& sent_packet);
+  void OnReadyToSend(rtc::AsyncPacketSocket* socket);
+
+  SharedUdpPort* const shared_port_;
+  rtc::Thread* const thread_;
+  const rtc::IPAddress ip_;
+  const std::unique_ptr<rtc::AsyncPacketSocket> socket_;
+  std::vector<SessionSocket*> sessions_;
+  SessionSocket* sender_ = nullptr;
+};
+
+// The socket handed to one session. Only datagrams routed to the session are
+// signalled on it.
+class SharedUdpPort::SessionSocket : public rtc::AsyncPacketSocket {
+ public:
+  SessionSocket(rtc::scoped_refptr<SharedUdpPort> shared_port,
+                ThreadSocket* thread_socket,
+                const std::string& ice_ufrag)
+      : shared_port_(std::move(shared_port)),
+        thread_socket_(thread_socket),
+        ice_ufrag_(ice_ufrag) {
+    thread_socket_->AddSession(this);
+  }
+
+  ~SessionSocket() override {
+    safety_flag_->SetNotAlive();
+    shared_port_->RemoveSession(this);
+    if (thread_socket_->RemoveSession(this) == 0) {
+      shared_port_->ReleaseThreadSocket(thread_socket_);
+    }
+  }
+
+  rtc::Thread* thread() const { return thread_socket_->thread(); }
+  const std::string& ice_ufrag() const { return ice_ufrag_; }
+  const rtc::scoped_refptr<webrtc::PendingTaskSafetyFlag>& safety_flag()
+      const {
+    return safety_flag_;
+  }
+
+  void DeliverPacket(const char* data,
+                     size_t size,
+                     const rtc::SocketAddress& remote_addr,
+                     int64_t packet_time_us) {
+    RTC_DCHECK(thread()->IsCurrent());
+    SignalReadPacket(this, data, size, remote_addr, packet_time_us);
+  }
+
+  // rtc::AsyncPacketSocket implementation.
+  rtc::SocketAddress GetLocalAddress() const override {
+    return thread_socket_->socket()->GetLocalAddress();
+  }
+  rtc::SocketAddress GetRemoteAddress() const override {
+    return rtc::SocketAddress();
+  }
+  int Send(const void* pv,
+           size_t cb,
+           const rtc::PacketOptions& options) override {
+    // The shared socket is never connected.
+    RTC_DCHECK_NOTREACHED();
+    return -1;
+  }
+  int SendTo(const void* pv,
+             size_t cb,
+             const rtc::SocketAddress& addr,
+             const rtc::PacketOptions& options) override {
+    shared_port_->OnSend(this, pv, cb, addr);
+    return thread_socket_->SendTo(this, pv, cb, addr, options);
+  }
+  int Close() override {
+    // The shared socket stays open for the other sessions.
+    return 0;
+  }
+  State GetState() const override {
+    return thread_socket_->socket()->GetState();
+  }
+  // Options apply to the shared socket, and thus to all sessions on it.
+  int GetOption(rtc::Socket::Option opt, int* value) override {
+    return thread_socket_->socket()->GetOption(opt, value);
+  }
+  int SetOption(rtc::Socket::Option opt, int value) override {
+    return thread_socket_->socket()->SetOption(opt, value);
+  }
+  int GetError() const override {
+    return thread_socket_->socket()->GetError();
+  }
+  void SetError(int error) override {
+    thread_socket_->socket()->SetError(error);
+  }
+
+ private:
+  const rtc::scoped_refptr<SharedUdpPort> shared_port_;
+  ThreadSocket* const thread_socket_;
+  const std::string ice_ufrag_;
+  const rtc::scoped_refptr<webrtc::PendingTaskSafetyFlag> safety_flag_ =
+      webrtc::PendingTaskSafetyFlag::Create();
+};
+
+void SharedUdpPort::ThreadSocket::OnSentPacket(
+    rtc::AsyncPacketSocket* socket,
+    const rtc::SentPacket& sent_packet) {
+  if (sender_) {
+    sender_->SignalSentPacket(sender_, sent_packet);
+  }
+}
+
+void SharedUdpPort::ThreadSocket::OnReadyToSend(
+    rtc::AsyncPacketSocket* socket) {
+  // Sessions may be removed while signalling.
+  std::vector<SessionSocket*> sessions = sessions_;
+  for (SessionSocket* session : sessions) {
+    if (absl::c_linear_search(sessions_, session)) {
+      session->SignalReadyToSend(session);
+    }
+  }
+}
+
+// static
+rtc::scoped_refptr<SharedUdpPort> SharedUdpPort::Create(uint16_t port) {
+  RTC_DCHECK_NE(port, 0);
+  return rtc::scoped_refptr<SharedUdpPort>(new SharedUdpPort(port));
+}
+
+SharedUdpPort::SharedUdpPort(uint16_t port) : port_(port) {}
+
+SharedUdpPort::~SharedUdpPort() {
+  RTC_DCHECK(thread_sockets_.empty());
+  RTC_DCHECK(sessions_by_ufrag_.empty());
+}
+
+std::unique_ptr<rtc::AsyncPacketSocket> SharedUdpPort::CreateSocket(
+    rtc::SocketFactory* socket_factory,
+    const rtc::IPAddress& ip,
+    absl::string_view ice_ufrag) {
+  RTC_DCHECK(!ice_ufrag.empty());
+  rtc::Thread* thread = rtc::Thread::Current();
+  RTC_DCHECK(thread);
+
+  ThreadSocket* thread_socket = nullptr;
+  {
+    webrtc::MutexLock lock(&mutex_);
+    for (const auto& candidate : thread_sockets_) {
+      if (candidate->thread() == thread && candidate->ip() == ip) {
+        thread_socket = candidate.get();
+        break;
+      }
+    }
+  }
+
+  if (!thread_socket) {
+    std::unique_ptr<rtc::Socket> socket(
+        socket_factory->CreateSocket(ip.family(), SOCK_DGRAM));
+    if (!socket) {
+      return nullptr;
+    }
+    // Without SO_REUSEPORT only the first thread can bind the port.
+    if (socket->SetOption(rtc::Socket::OPT_REUSEPORT, 1) < 0) {
+      RTC_LOG(LS_WARNING) << "Failed to set SO_REUSEPORT on shared UDP port "
+                          << port_;
+    }
+    if (socket->Bind(rtc::SocketAddress(ip, port_)) < 0) {
+      RTC_LOG(LS_ERROR) << "Failed to bind shared UDP port "
+                        << rtc::SocketAddress(ip, port_).ToSensitiveString()
+                        << ", error " << socket->GetError();
+      return nullptr;
+    }
+    auto owned_thread_socket = std::make_unique<ThreadSocket>(
+        this, thread, ip,
+        std::make_unique<rtc::AsyncUDPSocket>(socket.release()));
+    thread_socket = owned_thread_socket.get();
+    webrtc::MutexLock lock(&mutex_);
+    thread_sockets_.push_back(std::move(owned_thread_socket));
+  }
+
+  auto session = std::make_unique<SessionSocket>(
+      rtc::scoped_refptr<SharedUdpPort>(this), thread_socket,
+      std::string(ice_ufrag));
+  bool inserted;
+  {
+    webrtc::MutexLock lock(&mutex_);
+    inserted =
+        sessions_by_ufrag_.emplace(session->ice_ufrag(), session.get()).second;
+  }
+  if (!inserted) {
+    RTC_LOG(LS_ERROR) << "ICE ufrag " << ice_ufrag
+                      << " is already used on shared UDP port " << port_;
+    return nullptr;
+  }
+  return session;
+}
+
+size_t SharedUdpPort::bound_socket_count() const {
+  webrtc::MutexLock lock(&mutex_);
+  return thread_sockets_.size();
+}
+
+void SharedUdpPort::OnSend(SessionSocket* session,
+                           const void* data,
+                           size_t size,
+                           const rtc::SocketAddress& remote_address) {
+  const char* bytes = static_cast<const char*>(data);
+  int stun_type = GetStunMessageType(bytes, size);
+  webrtc::MutexLock lock(&mutex_);
+  if (stun_type != 0 && IsStunRequestType(stun_type)) {
+    int64_t now_ms = rtc::TimeMillis();
+    if (now_ms - last_transaction_prune_ms_ >= kTransactionPruneIntervalMs) {
+      last_transaction_prune_ms_ = now_ms;
+      for (auto it = transactions_.begin(); it != transactions_.end();) {
+        if (now_ms - it->second.created_ms > STUN_TOTAL_TIMEOUT) {
+          it = transactions_.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    }
+    transactions_[GetStunTransactionId(bytes)] = {session, now_ms};
+  }
+  // The first session to use a remote address owns it until a STUN request
+  // from that address says otherwise.
+  sessions_by_remote_address_.emplace(remote_address, session);
+}
+
+void SharedUdpPort::OnReceive(ThreadSocket* thread_socket,
+                              const char* data,
+                              size_t size,
+                              const rtc::SocketAddress& remote_address,
+                              int64_t packet_time_us) {
+  rtc::Thread* session_thread;
+  rtc::scoped_refptr<webrtc::PendingTaskSafetyFlag> safety_flag;
+  SessionSocket* session;
+  {
+    webrtc::MutexLock lock(&mutex_);
+    session = FindSessionLocked(data, size, remote_address);
+    if (!session) {
+      RTC_LOG(LS_VERBOSE) << "Dropping packet on shared UDP port " << port_
+                          << " from unknown remote "
+                          << remote_address.ToSensitiveString();
+      return;
+    }
+    // Sessions on other threads may go away as soon as the lock is released.
+    session_thread = session->thread();
+    safety_flag = session->safety_flag();
+  }
+
+  if (session_thread == thread_socket->thread()) {
+    session->DeliverPacket(data, size, remote_address, packet_time_us);
+    return;
+  }
+  session_thread->PostTask(webrtc::ToQueuedTask(
+      std::move(safety_flag),
+      [session, packet = rtc::Buffer(data, size), remote_address,
+       packet_time_us] {
+        session->DeliverPacket(packet.data<char>(), packet.size(),
+                               remote_address, packet_time_us);
+      }));
+}
+
+SharedUdpPort::SessionSocket* SharedUdpPort::FindSessionLocked(
+    const char* data,
+    size_t size,
+    const rtc::SocketAddress& remote_address) {
+  int stun_type = GetStunMessageType(data, size);
+  if (stun_type != 0) {
+    if (IsStunSuccessResponseType(stun_type) ||
+        IsStunErrorResponseType(stun_type)) {
+      auto it = transactions_.find(GetStunTransactionId(data));
+      if (it != transactions_.end()) {
+        SessionSocket* session = it->second.session;
+        transactions_.erase(it);
+        return session;
+      }
+    } else if (IsStunRequestType(stun_type)) {
+      auto it =
+          sessions_by_ufrag_.find(std::string(GetLocalUfrag(data, size)));
+      if (it != sessions_by_ufrag_.end()) {
+        // Later traffic from this address, such as DTLS and media, belongs to
+        // the same session.
+        sessions_by_remote_address_[remote_address] = it->second;
+        return it->second;
+      }
+    }
+  }
+  auto it = sessions_by_remote_address_.find(remote_address);
+  return it != sessions_by_remote_address_.end() ? it->second : nullptr;
+}
+
+void SharedUdpPort::RemoveSession(SessionSocket* session) {
+  webrtc::MutexLock lock(&mutex_);
+  auto ufrag_it = sessions_by_ufrag_.find(session->ice_ufrag());
+  if (ufrag_it != sessions_by_ufrag_.end() && ufrag_it->second == session) {
+    sessions_by_ufrag_.erase(ufrag_it);
+  }
+  for (auto it = sessions_by_remote_address_.begin();
+       it != sessions_by_remote_address_.end();) {
+    if (it->second == session) {
+      it = sessions_by_remote_address_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  for (auto it = transactions_.begin(); it != transactions_.end();) {
+    if (it->second.session == session) {
+      it = transactions_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void SharedUdpPort::ReleaseThreadSocket(ThreadSocket* thread_socket) {
+  RTC_DCHECK(thread_socket->thread()->IsCurrent());
+  // Destroy the socket outside the lock, but on its own thread.
+  std::unique_ptr<ThreadSocket> released;
+  {
+    webrtc::MutexLock lock(&mutex_);
+    auto it = absl::c_find_if(
+        thread_sockets_, [&](const std::unique_ptr<ThreadSocket>& candidate) {
+          return candidate.get() == thread_socket;
+        });
+    RTC_DCHECK(it != thread_sockets_.end());
+    released = std::move(*it);
+    thread_sockets_.erase(it);
+  }
+}
+
+}  // namespace cricket
@@ -0,0 +1,124 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef P2P_BASE_SHARED_UDP_PORT_H_
+#define P2P_BASE_SHARED_UDP_PORT_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "api/ref_counted_base.h"
+#include "api/scoped_refptr.h"
+#include "rtc_base/ip_address.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/socket_factory.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/system/rtc_export.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace rtc {
+class AsyncPacketSocket;
+}  // namespace rtc
+
+namespace cricket {
+
+// Lets many ICE sessions share one local UDP port instead of binding an
+// ephemeral port each. Every network thread that uses the port gets its own
+// socket bound with SO_REUSEPORT, so the kernel spreads flows across threads.
+// Incoming datagrams are routed to the owning session by the local ufrag of
+// STUN requests, by the transaction ID of STUN responses and otherwise by
+// remote address; traffic that lands on another thread's socket is posted to
+// the thread of the session.
+//
+// Routing by remote address assumes every remote address is used by a single
+// session, so TURN and STUN servers shared by several sessions can only be
+// reached for STUN transactions, not for relayed data.
+//
+// This class is thread-safe. The sockets returned by CreateSocket() must be
+// used and destroyed on the thread that created them.
+class RTC_EXPORT SharedUdpPort final
+    : public rtc::RefCountedNonVirtual<SharedUdpPort> {
+ public:
+  static rtc::scoped_refptr<SharedUdpPort> Create(uint16_t port);
+
+  SharedUdpPort(const SharedUdpPort&) = delete;
+  SharedUdpPort& operator=(const SharedUdpPort&) = delete;
+
+  uint16_t port() const { return port_; }
+
+  // Returns a socket for the session identified by `ice_ufrag`. It sends from
+  // the shared socket for `ip` on the current thread, creating that socket
+  // with `socket_factory` if needed, and only signals packets routed to this
+  // session. Returns null if the shared socket can't be bound or another
+  // session already uses `ice_ufrag`.
+  std::unique_ptr<rtc::AsyncPacketSocket> CreateSocket(
+      rtc::SocketFactory* socket_factory,
+      const rtc::IPAddress& ip,
+      absl::string_view ice_ufrag);
+
+  // Number of sockets bound to the shared port, for testing.
+  size_t bound_socket_count() const;
+
+ protected:
+  explicit SharedUdpPort(uint16_t port);
+
+  friend class rtc::RefCountedNonVirtual<SharedUdpPort>;
+  ~SharedUdpPort();
+
+ private:
+  class SessionSocket;
+  class ThreadSocket;
+
+  struct Transaction {
+    SessionSocket* session;
+    int64_t created_ms;
+  };
+
+  // Records where STUN requests and datagrams sent by `session` go, so the
+  // replies can be routed back to it.
+  void OnSend(SessionSocket* session,
+              const void* data,
+              size_t size,
+              const rtc::SocketAddress& remote_address);
+  // Routes a datagram received on `thread_socket` to its session.
+  void OnReceive(ThreadSocket* thread_socket,
+                 const char* data,
+                 size_t size,
+                 const rtc::SocketAddress& remote_address,
+                 int64_t packet_time_us);
+  SessionSocket* FindSessionLocked(const char* data,
+                                   size_t size,
+                                   const rtc::SocketAddress& remote_address)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void RemoveSession(SessionSocket* session);
+  void ReleaseThreadSocket(ThreadSocket* thread_socket);
+
+  const uint16_t port_;
+  mutable webrtc::Mutex mutex_;
+  // One socket per thread and local address; each is only touched on its
+  // own thread apart from the lookup in this list.
+  std::vector<std::unique_ptr<ThreadSocket>> thread_sockets_
+      RTC_GUARDED_BY(mutex_);
+  std::map<std::string, SessionSocket*> sessions_by_ufrag_
+      RTC_GUARDED_BY(mutex_);
+  std::map<rtc::SocketAddress, SessionSocket*> sessions_by_remote_address_
+      RTC_GUARDED_BY(mutex_);
+  std::map<std::string, Transaction> transactions_ RTC_GUARDED_BY(mutex_);
+  int64_t last_transaction_prune_ms_ RTC_GUARDED_BY(mutex_) = 0;
+};
+
+}  // namespace cricket
+
+#endif  // P2P_BASE_SHARED_UDP_PORT_H_
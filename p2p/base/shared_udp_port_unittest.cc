@@ -0,0 +1,182 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/shared_udp_port.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/transport/stun.h"
+#include "rtc_base/async_udp_socket.h"
+#include "rtc_base/byte_buffer.h"
+#include "rtc_base/gunit.h"
+#include "rtc_base/virtual_socket_server.h"
+#include "test/gtest.h"
+
+namespace cricket {
+namespace {
+
+const uint16_t kSharedPort = 5000;
+const rtc::SocketAddress kLocalAddr("11.11.11.11", 0);
+const rtc::SocketAddress kRemoteAddr1("22.22.22.22", 6000);
+const rtc::SocketAddress kRemoteAddr2("33.33.33.33", 7000);
+const char kTransactionId1[] = "transaction1";
+const char kTransactionId2[] = "transaction2";
+
+std::string WriteStunMessage(int type,
+                             const std::string& transaction_id,
+                             const std::string& username) {
+  StunMessage message;
+  message.SetType(type);
+  message.SetTransactionID(transaction_id);
+  if (!username.empty()) {
+    message.AddAttribute(std::make_unique<StunByteStringAttribute>(
+        STUN_ATTR_USERNAME, username));
+  }
+  rtc::ByteBufferWriter buf;
+  message.Write(&buf);
+  return std::string(buf.Data(), buf.Length());
+}
+
+class PacketCollector : public sigslot::has_slots<> {
+ public:
+  explicit PacketCollector(rtc::AsyncPacketSocket* socket) {
+    socket->SignalReadPacket.connect(this, &PacketCollector::OnReadPacket);
+  }
+
+  const std::vector<std::string>& packets() const { return packets_; }
+
+ private:
+  void OnReadPacket(rtc::AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t size,
+                    const rtc::SocketAddress& remote_addr,
+                    const int64_t& packet_time_us) {
+    packets_.emplace_back(data, size);
+  }
+
+  std::vector<std::string> packets_;
+};
+
+class SharedUdpPortTest : public ::testing::Test {
+ protected:
+  SharedUdpPortTest()
+      : thread_(&vss_), shared_port_(SharedUdpPort::Create(kSharedPort)) {}
+
+  std::unique_ptr<rtc::AsyncPacketSocket> CreateSessionSocket(
+      const std::string& ice_ufrag) {
+    return shared_port_->CreateSocket(&vss_, kLocalAddr.ipaddr(), ice_ufrag);
+  }
+
+  std::unique_ptr<rtc::AsyncUDPSocket> CreateRemoteSocket(
+      const rtc::SocketAddress& address) {
+    return std::unique_ptr<rtc::AsyncUDPSocket>(
+        rtc::AsyncUDPSocket::Create(&vss_, address));
+  }
+
+  void SendFrom(rtc::AsyncPacketSocket* socket,
+                const std::string& packet,
+                const rtc::SocketAddress& addr) {
+    socket->SendTo(packet.data(), packet.size(), addr, rtc::PacketOptions());
+  }
+
+  const rtc::SocketAddress shared_address_{kLocalAddr.ipaddr(), kSharedPort};
+  rtc::VirtualSocketServer vss_;
+  rtc::AutoSocketServerThread thread_;
+  rtc::scoped_refptr<SharedUdpPort> shared_port_;
+};
+
+TEST_F(SharedUdpPortTest, SessionsShareOneSocket) {
+  auto session1 = CreateSessionSocket("ufrag1");
+  auto session2 = CreateSessionSocket("ufrag2");
+  ASSERT_TRUE(session1);
+  ASSERT_TRUE(session2);
+  EXPECT_EQ(1u, shared_port_->bound_socket_count());
+  EXPECT_EQ(shared_address_, session1->GetLocalAddress());
+  EXPECT_EQ(shared_address_, session2->GetLocalAddress());
+
+  session1.reset();
+  EXPECT_EQ(1u, shared_port_->bound_socket_count());
+  session2.reset();
+  EXPECT_EQ(0u, shared_port_->bound_socket_count());
+}
+
+TEST_F(SharedUdpPortTest, RejectsDuplicateUfrag) {
+  auto session = CreateSessionSocket("ufrag1");
+  ASSERT_TRUE(session);
+  EXPECT_FALSE(CreateSessionSocket("ufrag1"));
+  // A session created on another port is not affected.
+  auto other_port = SharedUdpPort::Create(kSharedPort + 1);
+  EXPECT_TRUE(other_port->CreateSocket(&vss_, kLocalAddr.ipaddr(), "ufrag1"));
+}
+
+TEST_F(SharedUdpPortTest, RoutesByUfragThenByRemoteAddress) {
+  auto session1 = CreateSessionSocket("ufrag1");
+  auto session2 = CreateSessionSocket("ufrag2");
+  PacketCollector collector1(session1.get());
+  PacketCollector collector2(session2.get());
+  auto remote = CreateRemoteSocket(kRemoteAddr1);
+
+  std::string request =
+      WriteStunMessage(STUN_BINDING_REQUEST, kTransactionId1, "ufrag2:remote");
+  SendFrom(remote.get(), request, shared_address_);
+  EXPECT_EQ_WAIT(1u, collector2.packets().size(), 1000);
+  EXPECT_EQ(request, collector2.packets()[0]);
+
+  // Non-STUN traffic from the same remote address follows the request.
+  SendFrom(remote.get(), "media", shared_address_);
+  EXPECT_EQ_WAIT(2u, collector2.packets().size(), 1000);
+  EXPECT_EQ("media", collector2.packets()[1]);
+  EXPECT_TRUE(collector1.packets().empty());
+}
+
+TEST_F(SharedUdpPortTest, RoutesResponsesByTransactionId) {
+  auto session1 = CreateSessionSocket("ufrag1");
+  auto session2 = CreateSessionSocket("ufrag2");
+  PacketCollector collector1(session1.get());
+  PacketCollector collector2(session2.get());
+  auto server = CreateRemoteSocket(kRemoteAddr1);
+
+  // Both sessions talk to the same server.
+  SendFrom(session1.get(),
+           WriteStunMessage(STUN_BINDING_REQUEST, kTransactionId1, ""),
+           kRemoteAddr1);
+  SendFrom(session2.get(),
+           WriteStunMessage(STUN_BINDING_REQUEST, kTransactionId2, ""),
+           kRemoteAddr1);
+
+  std::string response2 =
+      WriteStunMessage(STUN_BINDING_RESPONSE, kTransactionId2, "");
+  std::string response1 =
+      WriteStunMessage(STUN_BINDING_RESPONSE, kTransactionId1, "");
+  SendFrom(server.get(), response2, shared_address_);
+  SendFrom(server.get(), response1, shared_address_);
+  EXPECT_EQ_WAIT(1u, collector1.packets().size(), 1000);
+  EXPECT_EQ_WAIT(1u, collector2.packets().size(), 1000);
+  EXPECT_EQ(response1, collector1.packets()[0]);
+  EXPECT_EQ(response2, collector2.packets()[0]);
+}
+
+TEST_F(SharedUdpPortTest, DropsPacketsFromUnknownRemote) {
+  auto session1 = CreateSessionSocket("ufrag1");
+  PacketCollector collector1(session1.get());
+  auto known = CreateRemoteSocket(kRemoteAddr1);
+  auto unknown = CreateRemoteSocket(kRemoteAddr2);
+
+  SendFrom(session1.get(), "hello", kRemoteAddr1);
+  SendFrom(unknown.get(), "stray", shared_address_);
+  SendFrom(known.get(), "reply", shared_address_);
+  EXPECT_EQ_WAIT(1u, collector1.packets().size(), 1000);
+  EXPECT_EQ("reply", collector1.packets()[0]);
+}
+
+}  // namespace
+}  // namespace cricket
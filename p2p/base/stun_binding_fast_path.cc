@@ -0,0 +1,265 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/stun_binding_fast_path.h"
+
+#include <string.h>
+
+#include "api/transport/stun.h"
+#include "rtc_base/byte_order.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/crc32.h"
+
+namespace cricket {
+
+namespace {
+
+// As in RFC 5389, section 15.5.
+constexpr uint32_t kFingerprintXorValue = 0x5354554E;
+
+constexpr size_t kHmacBlockSize = 64;
+
+// Longest USERNAME that StunMessage accepts.
+constexpr size_t kMaxUsernameSize = 508;
+
+// Size of MESSAGE-INTEGRITY and FINGERPRINT, which end every request and
+// response.
+constexpr size_t kIntegrityAttrSize =
+    kStunAttributeHeaderSize + kStunMessageIntegritySize;
+constexpr size_t kFingerprintAttrSize = kStunAttributeHeaderSize + 4;
+constexpr size_t kTrailerSize = kIntegrityAttrSize + kFingerprintAttrSize;
+
+// Bits marking the attributes seen in a request.
+enum : uint32_t {
+  kSeenUsername = 1 << 0,
+  kSeenPriority = 1 << 1,
+  kSeenRole = 1 << 2,
+  kSeenUseCandidate = 1 << 3,
+  kSeenNomination = 1 << 4,
+  kSeenNetworkInfo = 1 << 5,
+};
+
+}  // namespace
+
+StunBindingFastPath::StunBindingFastPath()
+    : sha1_(rtc::MessageDigestFactory::Create(rtc::DIGEST_SHA_1)) {
+  RTC_DCHECK(sha1_);
+  RTC_DCHECK_EQ(sha1_->Size(), kStunMessageIntegritySize);
+}
+
+StunBindingFastPath::~StunBindingFastPath() = default;
+
+// static
+bool StunBindingFastPath::Parse(const char* data,
+                                size_t size,
+                                Request* request) {
+  if (size % 4 != 0 || size < kStunHeaderSize + kTrailerSize ||
+      rtc::GetBE16(data) != STUN_BINDING_REQUEST ||
+      rtc::GetBE16(data + 2) != size - kStunHeaderSize ||
+      rtc::GetBE32(data + 4) != kStunMagicCookie) {
+    return false;
+  }
+  // MESSAGE-INTEGRITY must be directly followed by FINGERPRINT, which ends
+  // the message.
+  const size_t integrity_offset = size - kTrailerSize;
+  if (rtc::GetBE16(data + integrity_offset) != STUN_ATTR_MESSAGE_INTEGRITY ||
+      rtc::GetBE16(data + integrity_offset + 2) != kStunMessageIntegritySize) {
+    return false;
+  }
+
+  *request = Request();
+  const char* transaction_id = data + kStunTransactionIdOffset;
+  request->transaction_id =
+      absl::string_view(transaction_id, kStunTransactionIdLength);
+  request->reduced_transaction_id = rtc::GetBE32(transaction_id) ^
+                                    rtc::GetBE32(transaction_id + 4) ^
+                                    rtc::GetBE32(transaction_id + 8);
+  request->integrity_offset = integrity_offset;
+
+  uint32_t seen = 0;
+  size_t pos = kStunHeaderSize;
+  while (pos < integrity_offset) {
+    const uint16_t type = rtc::GetBE16(data + pos);
+    const uint16_t length = rtc::GetBE16(data + pos + 2);
+    const char* value = data + pos + kStunAttributeHeaderSize;
+    pos += kStunAttributeHeaderSize + ((length + 3) & ~3);
+    if (pos > integrity_offset) {
+      return false;
+    }
+    uint32_t bit;
+    switch (type) {
+      case STUN_ATTR_USERNAME:
+        if (length == 0 || length > kMaxUsernameSize) {
+          return false;
+        }
+        bit = kSeenUsername;
+        request->username = absl::string_view(value, length);
+        break;
+      case STUN_ATTR_PRIORITY:
+        if (length != 4) {
+          return false;
+        }
+        bit = kSeenPriority;
+        request->priority = rtc::GetBE32(value);
+        break;
+      case STUN_ATTR_ICE_CONTROLLING:
+      case STUN_ATTR_ICE_CONTROLLED:
+        if (length != 8) {
+          return false;
+        }
+        bit = kSeenRole;
+        request->role = type == STUN_ATTR_ICE_CONTROLLING ? ICEROLE_CONTROLLING
+                                                          : ICEROLE_CONTROLLED;
+        request->tiebreaker = rtc::GetBE64(value);
+        break;
+      case STUN_ATTR_USE_CANDIDATE:
+        if (length != 0) {
+          return false;
+        }
+        bit = kSeenUseCandidate;
+        request->use_candidate = true;
+        break;
+      case STUN_ATTR_NOMINATION:
+        if (length != 4) {
+          return false;
+        }
+        bit = kSeenNomination;
+        request->nomination = rtc::GetBE32(value);
+        break;
+      case STUN_ATTR_GOOG_NETWORK_INFO:
+        if (length != 4) {
+          return false;
+        }
+        bit = kSeenNetworkInfo;
+        request->network_info = rtc::GetBE32(value);
+        break;
+      default:
+        return false;
+    }
+    if (seen & bit) {
+      return false;
+    }
+    seen |= bit;
+  }
+  if (!(seen & kSeenUsername)) {
+    return false;
+  }
+  return StunMessage::ValidateFingerprint(data, size);
+}
+
+bool StunBindingFastPath::ValidateMessageIntegrity(
+    const char* data,
+    const Request& request,
+    absl::string_view password) {
+  // The length in the header covers the message up to and including
+  // MESSAGE-INTEGRITY, as it did when the sender computed it.
+  uint8_t header[kStunHeaderSize];
+  memcpy(header, data, kStunHeaderSize);
+  rtc::SetBE16(header + 2, request.integrity_offset + kIntegrityAttrSize -
+                               kStunHeaderSize);
+  uint8_t hmac[kStunMessageIntegritySize];
+  ComputeHmac(password, header,
+              reinterpret_cast<const uint8_t*>(data) + kStunHeaderSize,
+              request.integrity_offset - kStunHeaderSize, hmac);
+  return memcmp(hmac,
+                data + request.integrity_offset + kStunAttributeHeaderSize,
+                kStunMessageIntegritySize) == 0;
+}
+
+rtc::ArrayView<const uint8_t> StunBindingFastPath::WriteResponse(
+    const Request& request,
+    const rtc::SocketAddress& mapped_address,
+    absl::string_view password) {
+  RTC_DCHECK_EQ(request.transaction_id.size(), kStunTransactionIdLength);
+  const rtc::IPAddress& ip = mapped_address.ipaddr();
+  RTC_DCHECK(ip.family() == AF_INET || ip.family() == AF_INET6);
+
+  // XOR-MAPPED-ADDRESS, see RFC 5389, section 15.2. IPv4 addresses are
+  // XORed with the magic cookie, IPv6 addresses also with the transaction ID.
+  uint8_t* attr = response_ + kStunHeaderSize;
+  const size_t address_size = ip.family() == AF_INET ? 4 : 16;
+  rtc::SetBE16(attr, STUN_ATTR_XOR_MAPPED_ADDRESS);
+  rtc::SetBE16(attr + 2, 4 + address_size);
+  attr[4] = 0;
+  attr[5] = ip.family() == AF_INET ? STUN_ADDRESS_IPV4 : STUN_ADDRESS_IPV6;
+  rtc::SetBE16(attr + 6, mapped_address.port() ^ (kStunMagicCookie >> 16));
+  uint8_t* address = attr + 8;
+  if (ip.family() == AF_INET) {
+    rtc::SetBE32(address, ip.v4AddressAsHostOrderInteger() ^ kStunMagicCookie);
+  } else {
+    uint8_t mask[16];
+    rtc::SetBE32(mask, kStunMagicCookie);
+    memcpy(mask + 4, request.transaction_id.data(), kStunTransactionIdLength);
+    in6_addr ipv6 = ip.ipv6_address();
+    memcpy(address, &ipv6, sizeof(mask));
+    for (size_t i = 0; i < sizeof(mask); ++i) {
+      address[i] ^= mask[i];
+    }
+  }
+  const size_t integrity_offset = kStunHeaderSize + 8 + address_size;
+  const size_t size = integrity_offset + kTrailerSize;
+  RTC_DCHECK_LE(size, kMaxResponseSize);
+
+  // The header, with the length as it is when MESSAGE-INTEGRITY is computed.
+  rtc::SetBE16(response_, STUN_BINDING_RESPONSE);
+  rtc::SetBE16(response_ + 2,
+               integrity_offset + kIntegrityAttrSize - kStunHeaderSize);
+  rtc::SetBE32(response_ + 4, kStunMagicCookie);
+  memcpy(response_ + kStunTransactionIdOffset, request.transaction_id.data(),
+         kStunTransactionIdLength);
+
+  uint8_t* integrity = response_ + integrity_offset;
+  rtc::SetBE16(integrity, STUN_ATTR_MESSAGE_INTEGRITY);
+  rtc::SetBE16(integrity + 2, kStunMessageIntegritySize);
+  ComputeHmac(password, response_, response_ + kStunHeaderSize,
+              integrity_offset - kStunHeaderSize,
+              integrity + kStunAttributeHeaderSize);
+
+  rtc::SetBE16(response_ + 2, size - kStunHeaderSize);
+  uint8_t* fingerprint = integrity + kIntegrityAttrSize;
+  rtc::SetBE16(fingerprint, STUN_ATTR_FINGERPRINT);
+  rtc::SetBE16(fingerprint + 2, 4);
+  rtc::SetBE32(fingerprint + kStunAttributeHeaderSize,
+               rtc::ComputeCrc32(response_, size - kFingerprintAttrSize) ^
+                   kFingerprintXorValue);
+  return rtc::ArrayView<const uint8_t>(response_, size);
+}
+
+void StunBindingFastPath::ComputeHmac(absl::string_view key,
+                                      const uint8_t* header,
+                                      const uint8_t* body,
+                                      size_t body_size,
+                                      uint8_t* hmac) {
+  // RFC 2104, the same as rtc::ComputeHmac() but without allocating.
+  uint8_t block[kHmacBlockSize] = {};
+  if (key.size() > kHmacBlockSize) {
+    sha1_->Update(key.data(), key.size());
+    sha1_->Finish(block, kStunMessageIntegritySize);
+  } else {
+    memcpy(block, key.data(), key.size());
+  }
+  uint8_t pad[kHmacBlockSize];
+  for (size_t i = 0; i < kHmacBlockSize; ++i) {
+    pad[i] = block[i] ^ 0x36;
+  }
+  uint8_t inner[kStunMessageIntegritySize];
+  sha1_->Update(pad, kHmacBlockSize);
+  sha1_->Update(header, kStunHeaderSize);
+  sha1_->Update(body, body_size);
+  sha1_->Finish(inner, sizeof(inner));
+  for (size_t i = 0; i < kHmacBlockSize; ++i) {
+    pad[i] = block[i] ^ 0x5c;
+  }
+  sha1_->Update(pad, kHmacBlockSize);
+  sha1_->Update(inner, sizeof(inner));
+  sha1_->Finish(hmac, kStunMessageIntegritySize);
+}
+
+}  // namespace cricket
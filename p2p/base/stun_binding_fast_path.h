@@ -0,0 +1,99 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef P2P_BASE_STUN_BINDING_FAST_PATH_H_
+#define P2P_BASE_STUN_BINDING_FAST_PATH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "p2p/base/transport_description.h"
+#include "rtc_base/message_digest.h"
+#include "rtc_base/socket_address.h"
+
+namespace cricket {
+
+// Validates and answers ICE connectivity checks without parsing them into
+// an IceMessage. Requests are read in place and their MESSAGE-INTEGRITY is
+// checked without copying them, and responses are written into a buffer
+// owned by this object, so that answering a check doesn't allocate.
+//
+// Only the Binding requests that ICE agents send for routine checks are
+// handled: USERNAME, PRIORITY, ICE-CONTROLLING or ICE-CONTROLLED,
+// USE-CANDIDATE, NOMINATION and GOOG-NETWORK-INFO, followed by
+// MESSAGE-INTEGRITY and FINGERPRINT. Anything else, including messages that
+// need an error response, is left to the full parser.
+class StunBindingFastPath {
+ public:
+  // The attributes of a request accepted by Parse(). The views point into
+  // the request.
+  struct Request {
+    absl::string_view transaction_id;
+    uint32_t reduced_transaction_id = 0;
+    absl::string_view username;
+    uint32_t priority = 0;
+    IceRole role = ICEROLE_UNKNOWN;
+    uint64_t tiebreaker = 0;
+    bool use_candidate = false;
+    absl::optional<uint32_t> nomination;
+    absl::optional<uint32_t> network_info;
+    // Offset of the MESSAGE-INTEGRITY attribute.
+    size_t integrity_offset = 0;
+  };
+
+  StunBindingFastPath();
+  ~StunBindingFastPath();
+
+  StunBindingFastPath(const StunBindingFastPath&) = delete;
+  StunBindingFastPath& operator=(const StunBindingFastPath&) = delete;
+
+  // Returns true if `data` is a well-formed Binding request with only the
+  // attributes listed above, and a valid FINGERPRINT; doesn't check its
+  // MESSAGE-INTEGRITY.
+  static bool Parse(const char* data, size_t size, Request* request);
+
+  // Checks the MESSAGE-INTEGRITY of the request that `request` was parsed
+  // from.
+  bool ValidateMessageIntegrity(const char* data,
+                                const Request& request,
+                                absl::string_view password);
+
+  // Writes a Binding success response to `request` with XOR-MAPPED-ADDRESS,
+  // MESSAGE-INTEGRITY and FINGERPRINT. The response stays valid until the
+  // next call.
+  rtc::ArrayView<const uint8_t> WriteResponse(
+      const Request& request,
+      const rtc::SocketAddress& mapped_address,
+      absl::string_view password);
+
+ private:
+  // Header, XOR-MAPPED-ADDRESS for IPv6, MESSAGE-INTEGRITY and FINGERPRINT.
+  static constexpr size_t kMaxResponseSize = 20 + 24 + 24 + 8;
+
+  // Computes the HMAC-SHA1 of `header`, which is 20 bytes, followed by
+  // `body`.
+  void ComputeHmac(absl::string_view key,
+                   const uint8_t* header,
+                   const uint8_t* body,
+                   size_t body_size,
+                   uint8_t* hmac);
+
+  const std::unique_ptr<rtc::MessageDigest> sha1_;
+  uint8_t response_[kMaxResponseSize];
+};
+
+}  // namespace cricket
+
+#endif  // P2P_BASE_STUN_BINDING_FAST_PATH_H_
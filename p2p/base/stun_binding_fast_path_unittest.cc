@@ -0,0 +1,189 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/stun_binding_fast_path.h"
+
+#include <memory>
+#include <string>
+
+#include "api/transport/stun.h"
+#include "rtc_base/byte_buffer.h"
+#include "test/gtest.h"
+
+namespace cricket {
+namespace {
+
+const char kTransactionId[] = "0123456789ab";
+const char kUsername[] = "lfrag:rfrag";
+const char kPassword[] = "password-of-at-least-22-chars";
+
+std::string Serialize(const StunMessage& msg) {
+  rtc::ByteBufferWriter buf;
+  msg.Write(&buf);
+  return std::string(buf.Data(), buf.Length());
+}
+
+// A request as ConnectionRequest sends it, with `extra` added before
+// MESSAGE-INTEGRITY.
+std::string MakeRequest(
+    std::unique_ptr<StunAttribute> extra = nullptr,
+    const std::string& password = kPassword,
+    int role_attr = STUN_ATTR_ICE_CONTROLLING) {
+  IceMessage msg;
+  msg.SetType(STUN_BINDING_REQUEST);
+  msg.SetTransactionID(kTransactionId);
+  msg.AddAttribute(
+      std::make_unique<StunByteStringAttribute>(STUN_ATTR_USERNAME, kUsername));
+  msg.AddAttribute(std::make_unique<StunUInt32Attribute>(
+      STUN_ATTR_GOOG_NETWORK_INFO, 0x00070010));
+  msg.AddAttribute(std::make_unique<StunUInt64Attribute>(
+      role_attr, 0x0102030405060708));
+  msg.AddAttribute(
+      std::make_unique<StunByteStringAttribute>(STUN_ATTR_USE_CANDIDATE));
+  msg.AddAttribute(
+      std::make_unique<StunUInt32Attribute>(STUN_ATTR_NOMINATION, 3));
+  msg.AddAttribute(
+      std::make_unique<StunUInt32Attribute>(STUN_ATTR_PRIORITY, 0x6e7f1eff));
+  if (extra) {
+    msg.AddAttribute(std::move(extra));
+  }
+  msg.AddMessageIntegrity(password);
+  msg.AddFingerprint();
+  return Serialize(msg);
+}
+
+bool Parse(const std::string& data, StunBindingFastPath::Request* request) {
+  return StunBindingFastPath::Parse(data.data(), data.size(), request);
+}
+
+TEST(StunBindingFastPathTest, ParsesConnectivityCheck) {
+  std::string data = MakeRequest();
+  StunBindingFastPath::Request request;
+  ASSERT_TRUE(Parse(data, &request));
+  EXPECT_EQ(kTransactionId, request.transaction_id);
+  IceMessage msg;
+  msg.SetTransactionID(kTransactionId);
+  EXPECT_EQ(msg.reduced_transaction_id(), request.reduced_transaction_id);
+  EXPECT_EQ(kUsername, request.username);
+  EXPECT_EQ(0x6e7f1effu, request.priority);
+  EXPECT_EQ(ICEROLE_CONTROLLING, request.role);
+  EXPECT_EQ(0x0102030405060708u, request.tiebreaker);
+  EXPECT_TRUE(request.use_candidate);
+  EXPECT_EQ(3u, request.nomination);
+  EXPECT_EQ(0x00070010u, request.network_info);
+
+  ASSERT_TRUE(Parse(MakeRequest(nullptr, kPassword, STUN_ATTR_ICE_CONTROLLED),
+                    &request));
+  EXPECT_EQ(ICEROLE_CONTROLLED, request.role);
+}
+
+TEST(StunBindingFastPathTest, ValidatesMessageIntegrity) {
+  StunBindingFastPath fast_path;
+  StunBindingFastPath::Request request;
+  std::string data = MakeRequest();
+  ASSERT_TRUE(Parse(data, &request));
+  EXPECT_TRUE(
+      fast_path.ValidateMessageIntegrity(data.data(), request, kPassword));
+  EXPECT_FALSE(
+      fast_path.ValidateMessageIntegrity(data.data(), request, "other"));
+
+  // Keys longer than the block size of SHA-1 are hashed first.
+  std::string long_password(100, 'p');
+  data = MakeRequest(nullptr, long_password);
+  ASSERT_TRUE(Parse(data, &request));
+  EXPECT_TRUE(
+      fast_path.ValidateMessageIntegrity(data.data(), request, long_password));
+}
+
+TEST(StunBindingFastPathTest, LeavesOtherMessagesToTheFullParser) {
+  StunBindingFastPath::Request request;
+  // Attributes that the fast path doesn't handle.
+  EXPECT_FALSE(Parse(MakeRequest(std::make_unique<StunUInt32Attribute>(
+                         STUN_ATTR_RETRANSMIT_COUNT, 1)),
+                     &request));
+  EXPECT_FALSE(Parse(MakeRequest(std::make_unique<StunUInt32Attribute>(
+                         STUN_ATTR_PRIORITY, 1)),
+                     &request));
+  EXPECT_FALSE(Parse(MakeRequest(std::make_unique<StunUInt64Attribute>(
+                         STUN_ATTR_ICE_CONTROLLED, 1)),
+                     &request));
+
+  // A bad fingerprint.
+  std::string data = MakeRequest();
+  data[data.size() - 1] ^= 1;
+  EXPECT_FALSE(Parse(data, &request));
+
+  // No fingerprint, no username, and not a request.
+  IceMessage msg;
+  msg.SetType(STUN_BINDING_REQUEST);
+  msg.SetTransactionID(kTransactionId);
+  msg.AddAttribute(
+      std::make_unique<StunByteStringAttribute>(STUN_ATTR_USERNAME, kUsername));
+  msg.AddMessageIntegrity(kPassword);
+  EXPECT_FALSE(Parse(Serialize(msg), &request));
+  msg.ClearAttributes();
+  msg.AddMessageIntegrity(kPassword);
+  msg.AddFingerprint();
+  EXPECT_FALSE(Parse(Serialize(msg), &request));
+  msg.ClearAttributes();
+  msg.SetType(STUN_BINDING_RESPONSE);
+  msg.AddAttribute(
+      std::make_unique<StunByteStringAttribute>(STUN_ATTR_USERNAME, kUsername));
+  msg.AddMessageIntegrity(kPassword);
+  msg.AddFingerprint();
+  EXPECT_FALSE(Parse(Serialize(msg), &request));
+
+  // Data packets and truncated requests.
+  EXPECT_FALSE(Parse(std::string(100, '\x80'), &request));
+  data = MakeRequest();
+  EXPECT_FALSE(Parse(data.substr(0, data.size() - 4), &request));
+}
+
+class StunBindingFastPathResponseTest
+    : public ::testing::TestWithParam<const char*> {};
+
+TEST_P(StunBindingFastPathResponseTest, MatchesStunMessage) {
+  rtc::SocketAddress mapped_address(GetParam(), 54321);
+  StunBindingFastPath fast_path;
+  StunBindingFastPath::Request request;
+  std::string data = MakeRequest();
+  ASSERT_TRUE(Parse(data, &request));
+  rtc::ArrayView<const uint8_t> response =
+      fast_path.WriteResponse(request, mapped_address, kPassword);
+
+  StunMessage expected;
+  expected.SetType(STUN_BINDING_RESPONSE);
+  expected.SetTransactionID(kTransactionId);
+  expected.AddAttribute(std::make_unique<StunXorAddressAttribute>(
+      STUN_ATTR_XOR_MAPPED_ADDRESS, mapped_address));
+  expected.AddMessageIntegrity(kPassword);
+  expected.AddFingerprint();
+  EXPECT_EQ(Serialize(expected),
+            std::string(reinterpret_cast<const char*>(response.data()),
+                        response.size()));
+
+  IceMessage parsed;
+  rtc::ByteBufferReader buf(reinterpret_cast<const char*>(response.data()),
+                            response.size());
+  ASSERT_TRUE(parsed.Read(&buf));
+  EXPECT_EQ(StunMessage::IntegrityStatus::kIntegrityOk,
+            parsed.ValidateMessageIntegrity(kPassword));
+  const StunAddressAttribute* address =
+      parsed.GetAddress(STUN_ATTR_XOR_MAPPED_ADDRESS);
+  ASSERT_TRUE(address);
+  EXPECT_EQ(mapped_address, address->GetAddress());
+}
+
+INSTANTIATE_TEST_SUITE_P(All,
+                         StunBindingFastPathResponseTest,
+                         ::testing::Values("192.0.2.17", "2001:db8::1:2"));
+
+}  // namespace
+}  // namespace cricket
@@ -62,7 +62,7 @@ void StunRequestManager::SendDelayed(StunRequest* request, int delay) {
   request->Construct();
   requests_[request->id()] = request;
   if (delay > 0) {
-    thread_->PostDelayed(RTC_FROM_HERE, delay, request, MSG_STUN_SEND, NULL);
+    request->resend_timer_->Schedule(delay);
   } else {
     thread_->Send(RTC_FROM_HERE, request, MSG_STUN_SEND, NULL);
   }
@@ -72,7 +72,7 @@ void StunRequestManager::Flush(int msg_type) {
   for (const auto& kv : requests_) {
     StunRequest* request = kv.second;
     if (msg_type == kAllRequests || msg_type == request->type()) {
-      thread_->Clear(request, MSG_STUN_SEND);
+      request->resend_timer_->Cancel();
       thread_->Send(RTC_FROM_HERE, request, MSG_STUN_SEND, NULL);
     }
   }
@@ -94,7 +94,7 @@ void StunRequestManager::Remove(StunRequest* request) {
   if (iter != requests_.end()) {
     RTC_DCHECK(iter->second == request);
     requests_.erase(iter);
-    thread_->Clear(request);
+    request->resend_timer_->Cancel();
   }
 }
 
@@ -205,7 +205,6 @@ StunRequest::~StunRequest() {
   RTC_DCHECK(manager_ != NULL);
   if (manager_) {
     manager_->Remove(this);
-    manager_->thread_->Clear(this);
   }
   delete msg_;
 }
@@ -237,12 +236,17 @@ int StunRequest::Elapsed() const {
 void StunRequest::set_manager(StunRequestManager* manager) {
   RTC_DCHECK(!manager_);
   manager_ = manager;
+  resend_timer_ = std::make_unique<rtc::TimerWheel::Timer>(
+      manager_->thread_->timer_wheel(), [this] { SendOrTimeOut(); });
 }
 
 void StunRequest::OnMessage(rtc::Message* pmsg) {
-  RTC_DCHECK(manager_ != NULL);
   RTC_DCHECK(pmsg->message_id == MSG_STUN_SEND);
+  SendOrTimeOut();
+}
 
+void StunRequest::SendOrTimeOut() {
+  RTC_DCHECK(manager_ != NULL);
   if (timeout_) {
     OnTimeout();
     delete this;
@@ -256,8 +260,7 @@ void StunRequest::OnMessage(rtc::Message* pmsg) {
   manager_->SignalSendPacket(buf.Data(), buf.Length(), this);
 
   OnSent();
-  manager_->thread_->PostDelayed(RTC_FROM_HERE, resend_delay(), this,
-                                 MSG_STUN_SEND, NULL);
+  resend_timer_->Schedule(resend_delay());
 }
 
 void StunRequest::OnSent() {
@@ -15,12 +15,14 @@
 #include <stdint.h>
 
 #include <map>
+#include <memory>
 #include <string>
 
 #include "api/transport/stun.h"
 #include "rtc_base/message_handler.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 #include "rtc_base/thread.h"
+#include "rtc_base/timer_wheel.h"
 
 namespace cricket {
 
@@ -135,10 +137,16 @@ class StunRequest : public rtc::MessageHandler {
 
   // Handles messages for sending and timeout.
   void OnMessage(rtc::Message* pmsg) override;
+  // Sends the request and schedules the resend, or times the request out.
+  void SendOrTimeOut();
 
   StunRequestManager* manager_;
   StunMessage* msg_;
   int64_t tstamp_;
+  // Delayed sends run off the timer wheel of the manager's thread, as
+  // requests are usually answered, and their resends cancelled, long before
+  // they are due.
+  std::unique_ptr<rtc::TimerWheel::Timer> resend_timer_;
 
   friend class StunRequestManager;
 };
@@ -10,11 +10,13 @@
 
 #include "p2p/base/turn_server.h"
 
+#include <string.h>
+
+#include <functional>
 #include <memory>
 #include <tuple>  // for std::tie
 #include <utility>
 
-#include "absl/algorithm/container.h"
 #include "absl/memory/memory.h"
 #include "api/packet_socket_factory.h"
 #include "api/transport/stun.h"
@@ -26,8 +28,10 @@
 #include "rtc_base/message_digest.h"
 #include "rtc_base/socket_adapters.h"
 #include "rtc_base/strings/string_builder.h"
+#include "rtc_base/task_utils/pending_task_safety_flag.h"
 #include "rtc_base/task_utils/to_queued_task.h"
 #include "rtc_base/thread.h"
+#include "rtc_base/time_utils.h"
 
 namespace cricket {
 
@@ -52,18 +56,62 @@ inline bool IsTurnChannelData(uint16_t msg_type) {
   return ((msg_type & 0xC000) == 0x4000);
 }
 
-// IDs used for posted messages for TurnServerAllocation.
-enum {
-  MSG_ALLOCATION_TIMEOUT,
+// Calls `on_expired` once the last expiry set has passed. Clients refresh
+// allocations, permissions and channels all the time, and clearing a posted
+// message for each refresh walks the whole message queue of the thread.
+// Instead, a single delayed task stays posted; when it runs it checks the
+// expiry, and posts itself again if the expiry moved later.
+class TurnServerAllocation::ExpiryTimer {
+ public:
+  ExpiryTimer(rtc::Thread* thread, std::function<void()> on_expired)
+      : thread_(thread), on_expired_(std::move(on_expired)) {}
+
+  void SetExpiry(int delay_ms) {
+    expires_ms_ = rtc::TimeMillis() + delay_ms;
+    // Only a pending task that runs after the new expiry needs replacing.
+    if (pending_run_ms_ < 0 || expires_ms_ < pending_run_ms_) {
+      Post(delay_ms);
+    }
+  }
+
+ private:
+  void Post(int64_t delay_ms) {
+    const int64_t run_ms = rtc::TimeMillis() + delay_ms;
+    pending_run_ms_ = run_ms;
+    thread_->PostDelayedTask(
+        webrtc::ToQueuedTask(safety_.flag(),
+                             [this, run_ms] { OnTimer(run_ms); }),
+        static_cast<uint32_t>(delay_ms));
+  }
+
+  void OnTimer(int64_t run_ms) {
+    if (run_ms != pending_run_ms_) {
+      // Replaced by a task running earlier.
+      return;
+    }
+    pending_run_ms_ = -1;
+    int64_t remaining_ms = expires_ms_ - rtc::TimeMillis();
+    if (remaining_ms > 0) {
+      Post(remaining_ms);
+      return;
+    }
+    // Typically deletes `this`.
+    on_expired_();
+  }
+
+  rtc::Thread* const thread_;
+  const std::function<void()> on_expired_;
+  int64_t expires_ms_ = 0;
+  int64_t pending_run_ms_ = -1;
+  webrtc::ScopedTaskSafety safety_;
 };
 
 // Encapsulates a TURN permission.
 // The object is created when a create permission request is received by an
 // allocation, and self-deletes when its lifetime timer expires.
-class TurnServerAllocation::Permission : public rtc::MessageHandlerAutoCleanup {
+class TurnServerAllocation::Permission {
  public:
   Permission(rtc::Thread* thread, const rtc::IPAddress& peer);
-  ~Permission() override;
 
   const rtc::IPAddress& peer() const { return peer_; }
   void Refresh();
@@ -71,19 +119,18 @@ class TurnServerAllocation::Permission : public rtc::MessageHandlerAutoCleanup {
   sigslot::signal1<Permission*> SignalDestroyed;
 
  private:
-  void OnMessage(rtc::Message* msg) override;
+  void OnExpired();
 
-  rtc::Thread* thread_;
   rtc::IPAddress peer_;
+  ExpiryTimer timer_;
 };
 
 // Encapsulates a TURN channel binding.
 // The object is created when a channel bind request is received by an
 // allocation, and self-deletes when its lifetime timer expires.
-class TurnServerAllocation::Channel : public rtc::MessageHandlerAutoCleanup {
+class TurnServerAllocation::Channel {
  public:
   Channel(rtc::Thread* thread, int id, const rtc::SocketAddress& peer);
-  ~Channel() override;
 
   int id() const { return id_; }
   const rtc::SocketAddress& peer() const { return peer_; }
@@ -92,11 +139,11 @@ class TurnServerAllocation::Channel : public rtc::MessageHandlerAutoCleanup {
   sigslot::signal1<Channel*> SignalDestroyed;
 
  private:
-  void OnMessage(rtc::Message* msg) override;
+  void OnExpired();
 
-  rtc::Thread* thread_;
   int id_;
   rtc::SocketAddress peer_;
+  ExpiryTimer timer_;
 };
 
 static bool InitResponse(const StunMessage* req, StunMessage* resp) {
@@ -148,7 +195,7 @@ void TurnServer::AddInternalSocket(rtc::AsyncPacketSocket* socket,
                                    ProtocolType proto) {
   RTC_DCHECK_RUN_ON(thread_);
   RTC_DCHECK(server_sockets_.end() == server_sockets_.find(socket));
-  server_sockets_[socket] = proto;
+  server_sockets_[socket].proto = proto;
   socket->SignalReadPacket.connect(this, &TurnServer::OnInternalPacket);
 }
 
@@ -218,8 +265,21 @@ void TurnServer::OnInternalPacket(rtc::AsyncPacketSocket* socket,
   }
   InternalSocketMap::iterator iter = server_sockets_.find(socket);
   RTC_DCHECK(iter != server_sockets_.end());
-  TurnServerConnection conn(addr, iter->second, socket);
+  InternalSocketInfo& info = iter->second;
   uint16_t msg_type = rtc::GetBE16(data);
+  if (IsTurnChannelData(msg_type) && info.proto == PROTO_UDP) {
+    // Relayed media takes this path, which skips building a connection and
+    // searching `allocations_`.
+    TurnServerAllocation* allocation = info.udp_allocations.Find(addr);
+    if (allocation) {
+      allocation->HandleChannelData(data, size);
+    }
+    if (stun_message_observer_ != nullptr) {
+      stun_message_observer_->ReceivedChannelData(data, size);
+    }
+    return;
+  }
+  TurnServerConnection conn(addr, info.proto, socket);
   if (!IsTurnChannelData(msg_type)) {
     // This is a STUN message.
     HandleStunMessage(&conn, data, size);
@@ -475,6 +535,10 @@ TurnServerAllocation* TurnServer::CreateAllocation(TurnServerConnection* conn,
       new TurnServerAllocation(this, thread_, *conn, external_socket, key);
   allocation->SignalDestroyed.connect(this, &TurnServer::OnAllocationDestroyed);
   allocations_[*conn].reset(allocation);
+  InternalSocketMap::iterator iter = server_sockets_.find(conn->socket());
+  if (iter != server_sockets_.end() && iter->second.proto == PROTO_UDP) {
+    iter->second.udp_allocations.Insert(allocation->conn()->src(), allocation);
+  }
   return allocation;
 }
 
@@ -540,6 +604,21 @@ void TurnServer::Send(TurnServerConnection* conn,
   conn->socket()->SendTo(buf.Data(), buf.Length(), conn->src(), options);
 }
 
+void TurnServer::SendChannelData(TurnServerConnection* conn,
+                                 uint16_t channel_id,
+                                 const char* data,
+                                 size_t size) {
+  RTC_DCHECK_RUN_ON(thread_);
+  channel_data_buffer_.SetSize(TURN_CHANNEL_HEADER_SIZE + size);
+  uint8_t* message = channel_data_buffer_.data();
+  rtc::SetBE16(message, channel_id);
+  rtc::SetBE16(message + 2, static_cast<uint16_t>(size));
+  memcpy(message + TURN_CHANNEL_HEADER_SIZE, data, size);
+  rtc::PacketOptions options;
+  conn->socket()->SendTo(channel_data_buffer_.data(),
+                         channel_data_buffer_.size(), conn->src(), options);
+}
+
 void TurnServer::OnAllocationDestroyed(TurnServerAllocation* allocation) {
   // Removing the internal socket if the connection is not udp.
   rtc::AsyncPacketSocket* socket = allocation->conn()->socket();
@@ -548,8 +627,12 @@ void TurnServer::OnAllocationDestroyed(TurnServerAllocation* allocation) {
   // by all allocations.
   // Note: We may not find a socket if it's a TCP socket that was closed, and
   // the allocation is only now timing out.
-  if (iter != server_sockets_.end() && iter->second != cricket::PROTO_UDP) {
-    DestroyInternalSocket(socket);
+  if (iter != server_sockets_.end()) {
+    if (iter->second.proto != cricket::PROTO_UDP) {
+      DestroyInternalSocket(socket);
+    } else {
+      iter->second.udp_allocations.Erase(allocation->conn()->src());
+    }
   }
 
   AllocationMap::iterator it = allocations_.find(*(allocation->conn()));
@@ -579,7 +662,8 @@ TurnServerConnection::TurnServerConnection(const rtc::SocketAddress& src,
                                            ProtocolType proto,
                                            rtc::AsyncPacketSocket* socket)
     : src_(src),
-      dst_(socket->GetRemoteAddress()),
+      dst_(proto == PROTO_UDP ? rtc::SocketAddress()
+                              : socket->GetRemoteAddress()),
       proto_(proto),
       socket_(socket) {}
 
@@ -608,20 +692,19 @@ TurnServerAllocation::TurnServerAllocation(TurnServer* server,
       thread_(thread),
       conn_(conn),
       external_socket_(socket),
-      key_(key) {
+      key_(key),
+      timer_(std::make_unique<ExpiryTimer>(thread, [this] { OnExpired(); })) {
   external_socket_->SignalReadPacket.connect(
       this, &TurnServerAllocation::OnExternalPacket);
 }
 
 TurnServerAllocation::~TurnServerAllocation() {
-  for (ChannelList::iterator it = channels_.begin(); it != channels_.end();
-       ++it) {
-    delete *it;
+  for (const auto& kv : channels_) {
+    delete kv.second;
   }
-  for (PermissionList::iterator it = perms_.begin(); it != perms_.end(); ++it) {
-    delete *it;
+  for (const auto& kv : perms_) {
+    delete kv.second;
   }
-  thread_->Clear(this, MSG_ALLOCATION_TIMEOUT);
   RTC_LOG(LS_INFO) << ToString() << ": Allocation destroyed";
 }
 
@@ -667,8 +750,7 @@ void TurnServerAllocation::HandleAllocateRequest(const TurnMessage* msg) {
 
   // Figure out the lifetime and start the allocation timer.
   int lifetime_secs = ComputeLifetime(msg);
-  thread_->PostDelayed(RTC_FROM_HERE, lifetime_secs * 1000, this,
-                       MSG_ALLOCATION_TIMEOUT);
+  timer_->SetExpiry(lifetime_secs * 1000);
 
   RTC_LOG(LS_INFO) << ToString()
                    << ": Created allocation with lifetime=" << lifetime_secs;
@@ -695,9 +777,7 @@ void TurnServerAllocation::HandleRefreshRequest(const TurnMessage* msg) {
   int lifetime_secs = ComputeLifetime(msg);
 
   // Reset the expiration timer.
-  thread_->Clear(this, MSG_ALLOCATION_TIMEOUT);
-  thread_->PostDelayed(RTC_FROM_HERE, lifetime_secs * 1000, this,
-                       MSG_ALLOCATION_TIMEOUT);
+  timer_->SetExpiry(lifetime_secs * 1000);
 
   RTC_LOG(LS_INFO) << ToString()
                    << ": Refreshed allocation, lifetime=" << lifetime_secs;
@@ -795,7 +875,8 @@ void TurnServerAllocation::HandleChannelBindRequest(const TurnMessage* msg) {
     channel1 = new Channel(thread_, channel_id, peer_attr->GetAddress());
     channel1->SignalDestroyed.connect(
         this, &TurnServerAllocation::OnChannelDestroyed);
-    channels_.push_back(channel1);
+    channels_[channel_id] = channel1;
+    channels_by_peer_.Insert(channel1->peer(), channel1);
   } else {
     channel1->Refresh();
   }
@@ -837,11 +918,8 @@ void TurnServerAllocation::OnExternalPacket(
   Channel* channel = FindChannel(addr);
   if (channel) {
     // There is a channel bound to this address. Send as a channel message.
-    rtc::ByteBufferWriter buf;
-    buf.WriteUInt16(channel->id());
-    buf.WriteUInt16(static_cast<uint16_t>(size));
-    buf.WriteBytes(data, size);
-    server_->Send(&conn_, buf);
+    server_->SendChannelData(&conn_, static_cast<uint16_t>(channel->id()),
+                             data, size);
   } else if (!server_->enable_permission_checks_ ||
              HasPermission(addr.ipaddr())) {
     // No channel, but a permission exists. Send as a data indication.
@@ -880,7 +958,7 @@ void TurnServerAllocation::AddPermission(const rtc::IPAddress& addr) {
     perm = new Permission(thread_, addr);
     perm->SignalDestroyed.connect(this,
                                   &TurnServerAllocation::OnPermissionDestroyed);
-    perms_.push_back(perm);
+    perms_[addr] = perm;
   } else {
     perm->Refresh();
   }
@@ -888,32 +966,19 @@ void TurnServerAllocation::AddPermission(const rtc::IPAddress& addr) {
 
 TurnServerAllocation::Permission* TurnServerAllocation::FindPermission(
     const rtc::IPAddress& addr) const {
-  for (PermissionList::const_iterator it = perms_.begin(); it != perms_.end();
-       ++it) {
-    if ((*it)->peer() == addr)
-      return *it;
-  }
-  return NULL;
+  PermissionMap::const_iterator it = perms_.find(addr);
+  return it != perms_.end() ? it->second : nullptr;
 }
 
 TurnServerAllocation::Channel* TurnServerAllocation::FindChannel(
     int channel_id) const {
-  for (ChannelList::const_iterator it = channels_.begin();
-       it != channels_.end(); ++it) {
-    if ((*it)->id() == channel_id)
-      return *it;
-  }
-  return NULL;
+  ChannelMap::const_iterator it = channels_.find(channel_id);
+  return it != channels_.end() ? it->second : nullptr;
 }
 
 TurnServerAllocation::Channel* TurnServerAllocation::FindChannel(
-    const rtc::SocketAddress& addr) const {
-  for (ChannelList::const_iterator it = channels_.begin();
-       it != channels_.end(); ++it) {
-    if ((*it)->peer() == addr)
-      return *it;
-  }
-  return NULL;
+    const rtc::SocketAddress& addr) {
+  return channels_by_peer_.Find(addr);
 }
 
 void TurnServerAllocation::SendResponse(TurnMessage* msg) {
@@ -939,42 +1004,35 @@ void TurnServerAllocation::SendExternal(const void* data,
   external_socket_->SendTo(data, size, peer, options);
 }
 
-void TurnServerAllocation::OnMessage(rtc::Message* msg) {
-  RTC_DCHECK(msg->message_id == MSG_ALLOCATION_TIMEOUT);
+void TurnServerAllocation::OnExpired() {
   SignalDestroyed(this);
   delete this;
 }
 
 void TurnServerAllocation::OnPermissionDestroyed(Permission* perm) {
-  auto it = absl::c_find(perms_, perm);
-  RTC_DCHECK(it != perms_.end());
+  auto it = perms_.find(perm->peer());
+  RTC_DCHECK(it != perms_.end() && it->second == perm);
   perms_.erase(it);
 }
 
 void TurnServerAllocation::OnChannelDestroyed(Channel* channel) {
-  auto it = absl::c_find(channels_, channel);
-  RTC_DCHECK(it != channels_.end());
+  auto it = channels_.find(channel->id());
+  RTC_DCHECK(it != channels_.end() && it->second == channel);
   channels_.erase(it);
+  channels_by_peer_.Erase(channel->peer());
 }
 
 TurnServerAllocation::Permission::Permission(rtc::Thread* thread,
                                              const rtc::IPAddress& peer)
-    : thread_(thread), peer_(peer) {
+    : peer_(peer), timer_(thread, [this] { OnExpired(); }) {
   Refresh();
 }
 
-TurnServerAllocation::Permission::~Permission() {
-  thread_->Clear(this, MSG_ALLOCATION_TIMEOUT);
-}
-
 void TurnServerAllocation::Permission::Refresh() {
-  thread_->Clear(this, MSG_ALLOCATION_TIMEOUT);
-  thread_->PostDelayed(RTC_FROM_HERE, kPermissionTimeout, this,
-                       MSG_ALLOCATION_TIMEOUT);
+  timer_.SetExpiry(kPermissionTimeout);
 }
 
-void TurnServerAllocation::Permission::OnMessage(rtc::Message* msg) {
-  RTC_DCHECK(msg->message_id == MSG_ALLOCATION_TIMEOUT);
+void TurnServerAllocation::Permission::OnExpired() {
   SignalDestroyed(this);
   delete this;
 }
@@ -982,22 +1040,15 @@ void TurnServerAllocation::Permission::OnMessage(rtc::Message* msg) {
 TurnServerAllocation::Channel::Channel(rtc::Thread* thread,
                                        int id,
                                        const rtc::SocketAddress& peer)
-    : thread_(thread), id_(id), peer_(peer) {
+    : id_(id), peer_(peer), timer_(thread, [this] { OnExpired(); }) {
   Refresh();
 }
 
-TurnServerAllocation::Channel::~Channel() {
-  thread_->Clear(this, MSG_ALLOCATION_TIMEOUT);
-}
-
 void TurnServerAllocation::Channel::Refresh() {
-  thread_->Clear(this, MSG_ALLOCATION_TIMEOUT);
-  thread_->PostDelayed(RTC_FROM_HERE, kChannelTimeout, this,
-                       MSG_ALLOCATION_TIMEOUT);
+  timer_.SetExpiry(kChannelTimeout);
 }
 
-void TurnServerAllocation::Channel::OnMessage(rtc::Message* msg) {
-  RTC_DCHECK(msg->message_id == MSG_ALLOCATION_TIMEOUT);
+void TurnServerAllocation::Channel::OnExpired() {
   SignalDestroyed(this);
   delete this;
 }
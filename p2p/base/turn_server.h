@@ -11,17 +11,20 @@
 #ifndef P2P_BASE_TURN_SERVER_H_
 #define P2P_BASE_TURN_SERVER_H_
 
-#include <list>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "api/sequence_checker.h"
+#include "p2p/base/address_index.h"
 #include "p2p/base/port_interface.h"
 #include "rtc_base/async_packet_socket.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/ip_address.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/ssl_adapter.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
@@ -45,10 +48,13 @@ const int TURN_SERVER_PORT = 3478;
 class TurnServerConnection {
  public:
   TurnServerConnection() : proto_(PROTO_UDP), socket_(NULL) {}
+  // For PROTO_UDP, `socket` is taken to be unconnected, as server sockets
+  // are, which saves asking the OS for its remote address.
   TurnServerConnection(const rtc::SocketAddress& src,
                        ProtocolType proto,
                        rtc::AsyncPacketSocket* socket);
   const rtc::SocketAddress& src() const { return src_; }
+  ProtocolType proto() const { return proto_; }
   rtc::AsyncPacketSocket* socket() { return socket_; }
   bool operator==(const TurnServerConnection& t) const;
   bool operator<(const TurnServerConnection& t) const;
@@ -66,8 +72,7 @@ class TurnServerConnection {
 // handles TURN messages (via HandleTurnMessage) and channel data messages
 // (via HandleChannelData) for this allocation when received by the server.
 // The object self-deletes and informs the server if its lifetime timer expires.
-class TurnServerAllocation : public rtc::MessageHandlerAutoCleanup,
-                             public sigslot::has_slots<> {
+class TurnServerAllocation : public sigslot::has_slots<> {
  public:
   TurnServerAllocation(TurnServer* server_,
                        rtc::Thread* thread,
@@ -92,9 +97,16 @@ class TurnServerAllocation : public rtc::MessageHandlerAutoCleanup,
 
  private:
   class Channel;
+  class ExpiryTimer;
   class Permission;
-  typedef std::list<Permission*> PermissionList;
-  typedef std::list<Channel*> ChannelList;
+  struct IPAddressHash {
+    size_t operator()(const rtc::IPAddress& ip) const {
+      return rtc::HashIP(ip);
+    }
+  };
+  typedef std::unordered_map<rtc::IPAddress, Permission*, IPAddressHash>
+      PermissionMap;
+  typedef std::unordered_map<int, Channel*> ChannelMap;
 
   void HandleAllocateRequest(const TurnMessage* msg);
   void HandleRefreshRequest(const TurnMessage* msg);
@@ -113,7 +125,7 @@ class TurnServerAllocation : public rtc::MessageHandlerAutoCleanup,
   void AddPermission(const rtc::IPAddress& addr);
   Permission* FindPermission(const rtc::IPAddress& addr) const;
   Channel* FindChannel(int channel_id) const;
-  Channel* FindChannel(const rtc::SocketAddress& addr) const;
+  Channel* FindChannel(const rtc::SocketAddress& addr);
 
   void SendResponse(TurnMessage* msg);
   void SendBadRequestResponse(const TurnMessage* req);
@@ -126,7 +138,7 @@ class TurnServerAllocation : public rtc::MessageHandlerAutoCleanup,
 
   void OnPermissionDestroyed(Permission* perm);
   void OnChannelDestroyed(Channel* channel);
-  void OnMessage(rtc::Message* msg) override;
+  void OnExpired();
 
   TurnServer* const server_;
   rtc::Thread* const thread_;
@@ -136,8 +148,11 @@ class TurnServerAllocation : public rtc::MessageHandlerAutoCleanup,
   std::string transaction_id_;
   std::string username_;
   std::string last_nonce_;
-  PermissionList perms_;
-  ChannelList channels_;
+  // Looked up for every relayed packet.
+  PermissionMap perms_;
+  ChannelMap channels_;
+  AddressIndex<Channel> channels_by_peer_;
+  std::unique_ptr<ExpiryTimer> timer_;
 };
 
 // An interface through which the MD5 credential hash can be retrieved.
@@ -315,13 +330,26 @@ class TurnServer : public sigslot::has_slots<> {
 
   void SendStun(TurnServerConnection* conn, StunMessage* msg);
   void Send(TurnServerConnection* conn, const rtc::ByteBufferWriter& buf);
+  // Sends `data` from a peer to the client as a ChannelData message.
+  void SendChannelData(TurnServerConnection* conn,
+                       uint16_t channel_id,
+                       const char* data,
+                       size_t size);
 
   void OnAllocationDestroyed(TurnServerAllocation* allocation)
       RTC_RUN_ON(thread_);
   void DestroyInternalSocket(rtc::AsyncPacketSocket* socket)
       RTC_RUN_ON(thread_);
 
-  typedef std::map<rtc::AsyncPacketSocket*, ProtocolType> InternalSocketMap;
+  struct InternalSocketInfo {
+    ProtocolType proto = PROTO_UDP;
+    // For UDP sockets, the allocations made through the socket, by client
+    // address, so that ChannelData messages can be relayed without building
+    // a TurnServerConnection and searching `allocations_`.
+    AddressIndex<TurnServerAllocation> udp_allocations;
+  };
+  typedef std::map<rtc::AsyncPacketSocket*, InternalSocketInfo>
+      InternalSocketMap;
   struct ServerSocketInfo {
     ProtocolType proto;
     // If non-null, used to wrap accepted sockets.
@@ -349,6 +377,8 @@ class TurnServer : public sigslot::has_slots<> {
   rtc::SocketAddress external_addr_ RTC_GUARDED_BY(thread_);
 
   AllocationMap allocations_ RTC_GUARDED_BY(thread_);
+  // Reused to frame the ChannelData messages sent to clients.
+  rtc::Buffer channel_data_buffer_ RTC_GUARDED_BY(thread_);
 
   // For testing only. If this is non-zero, the next NONCE will be generated
   // from this value, and it will be reset to 0 after generating the NONCE.
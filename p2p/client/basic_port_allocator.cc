@@ -110,6 +110,23 @@ void FilterNetworks(NetworkList* networks, NetworkFilter filter) {
   networks->erase(start_to_remove, networks->end());
 }
 
+// Returns the lowest cost of `networks`. Networks whose cost is no more than
+// kNetworkCostLow above it are the preferred ones.
+uint16_t GetLowestNetworkCost(const NetworkList& networks) {
+  uint16_t lowest_cost = rtc::kNetworkCostMax;
+  for (rtc::Network* network : networks) {
+    // Don't determine the lowest cost from a link-local network.
+    // On iOS, a device connected to the computer will get a link-local
+    // network for communicating with the computer, however this network can't
+    // be used to connect to a peer outside the network.
+    if (rtc::IPIsLinkLocal(network->GetBestIP())) {
+      continue;
+    }
+    lowest_cost = std::min<uint16_t>(lowest_cost, network->GetCost());
+  }
+  return lowest_cost;
+}
+
 bool IsAllowedByCandidateFilter(const Candidate& c, uint32_t filter) {
   // When binding to any address, before sending packets out, the getsockname
   // returns all 0s, but after sending packets, it'll be the NIC used to
@@ -729,17 +746,7 @@ std::vector<rtc::Network*> BasicPortAllocatorSession::GetNetworks() {
       "ignored");
   FilterNetworks(&networks, ignored_filter);
   if (flags() & PORTALLOCATOR_DISABLE_COSTLY_NETWORKS) {
-    uint16_t lowest_cost = rtc::kNetworkCostMax;
-    for (rtc::Network* network : networks) {
-      // Don't determine the lowest cost from a link-local network.
-      // On iOS, a device connected to the computer will get a link-local
-      // network for communicating with the computer, however this network can't
-      // be used to connect to a peer outside the network.
-      if (rtc::IPIsLinkLocal(network->GetBestIP())) {
-        continue;
-      }
-      lowest_cost = std::min<uint16_t>(lowest_cost, network->GetCost());
-    }
+    uint16_t lowest_cost = GetLowestNetworkCost(networks);
     NetworkFilter costly_filter(
         [lowest_cost](rtc::Network* network) {
           return network->GetCost() > lowest_cost + rtc::kNetworkCostLow;
@@ -785,8 +792,13 @@ void BasicPortAllocatorSession::DoAllocate(bool disable_equivalent) {
     RTC_LOG(LS_INFO) << "Allocate ports on " << networks.size() << " networks";
     PortConfiguration* config =
         configs_.empty() ? nullptr : configs_.back().get();
+    const uint16_t lowest_cost = GetLowestNetworkCost(networks);
     for (uint32_t i = 0; i < networks.size(); ++i) {
       uint32_t sequence_flags = flags();
+      if (networks[i]->GetCost() > lowest_cost + rtc::kNetworkCostLow) {
+        // Only the preferred networks start all their phases at once.
+        sequence_flags &= ~PORTALLOCATOR_ENABLE_FAST_START;
+      }
       if ((sequence_flags & DISABLE_ALL_PHASES) == DISABLE_ALL_PHASES) {
         // If all the ports are disabled we should just fire the allocation
         // done event and return.
@@ -1233,6 +1245,12 @@ void BasicPortAllocator::SetVpnList(
   network_manager_->set_vpn_list(vpn_list);
 }
 
+void BasicPortAllocator::SetSharedUdpPort(
+    rtc::scoped_refptr<SharedUdpPort> shared_udp_port) {
+  CheckRunOnValidThreadIfInitialized();
+  shared_udp_port_ = std::move(shared_udp_port);
+}
+
 // AllocationSequence
 
 AllocationSequence::AllocationSequence(
@@ -1254,9 +1272,17 @@ AllocationSequence::AllocationSequence(
 
 void AllocationSequence::Init() {
   if (IsFlagSet(PORTALLOCATOR_ENABLE_SHARED_SOCKET)) {
-    udp_socket_.reset(session_->socket_factory()->CreateUdpSocket(
-        rtc::SocketAddress(network_->GetBestIP(), 0),
-        session_->allocator()->min_port(), session_->allocator()->max_port()));
+    if (SharedUdpPort* shared_udp_port =
+            session_->allocator()->shared_udp_port()) {
+      udp_socket_ = shared_udp_port->CreateSocket(
+          session_->network_thread()->socketserver(), network_->GetBestIP(),
+          session_->username());
+    } else {
+      udp_socket_.reset(session_->socket_factory()->CreateUdpSocket(
+          rtc::SocketAddress(network_->GetBestIP(), 0),
+          session_->allocator()->min_port(),
+          session_->allocator()->max_port()));
+    }
     if (udp_socket_) {
       udp_socket_->SignalReadPacket.connect(this,
                                             &AllocationSequence::OnReadPacket);
@@ -1377,27 +1403,36 @@ void AllocationSequence::Process(int epoch) {
   if (epoch != epoch_)
     return;
 
-  // Perform all of the phases in the current step.
-  RTC_LOG(LS_INFO) << network_->ToString()
-                   << ": Allocation Phase=" << PHASE_NAMES[phase_];
+  // With fast start, all of the phases are performed in the first step.
+  const bool fast_start = IsFlagSet(PORTALLOCATOR_ENABLE_FAST_START);
+  while (true) {
+    // Perform the current phase.
+    RTC_LOG(LS_INFO) << network_->ToString()
+                     << ": Allocation Phase=" << PHASE_NAMES[phase_];
+
+    switch (phase_) {
+      case PHASE_UDP:
+        CreateUDPPorts();
+        CreateStunPorts();
+        break;
 
-  switch (phase_) {
-    case PHASE_UDP:
-      CreateUDPPorts();
-      CreateStunPorts();
-      break;
+      case PHASE_RELAY:
+        CreateRelayPorts();
+        break;
 
-    case PHASE_RELAY:
-      CreateRelayPorts();
-      break;
+      case PHASE_TCP:
+        CreateTCPPorts();
+        state_ = kCompleted;
+        break;
 
-    case PHASE_TCP:
-      CreateTCPPorts();
-      state_ = kCompleted;
-      break;
+      default:
+        RTC_DCHECK_NOTREACHED();
+    }
 
-    default:
-      RTC_DCHECK_NOTREACHED();
+    if (!fast_start || state() != kRunning) {
+      break;
+    }
+    ++phase_;
   }
 
   if (state() == kRunning) {
@@ -1570,8 +1605,11 @@ void AllocationSequence::CreateTurnPort(const RelayServerConfig& config) {
     // don't pass shared socket for ports which will create TCP sockets.
     // TODO(mallinath) - Enable shared socket mode for TURN ports. Disabled
     // due to webrtc bug https://code.google.com/p/webrtc/issues/detail?id=3537
+    // Relayed data can't be demultiplexed on a SharedUdpPort when several
+    // sessions use the same TURN server, so those ports get their own socket.
     if (IsFlagSet(PORTALLOCATOR_ENABLE_SHARED_SOCKET) &&
-        relay_port->proto == PROTO_UDP && udp_socket_) {
+        relay_port->proto == PROTO_UDP && udp_socket_ &&
+        !session_->allocator()->shared_udp_port()) {
       port = session_->allocator()->relay_port_factory()->Create(
           args, udp_socket_.get());
 
@@ -15,8 +15,10 @@
 #include <string>
 #include <vector>
 
+#include "api/scoped_refptr.h"
 #include "api/turn_customizer.h"
 #include "p2p/base/port_allocator.h"
+#include "p2p/base/shared_udp_port.h"
 #include "p2p/client/relay_port_factory_interface.h"
 #include "p2p/client/turn_port_factory.h"
 #include "rtc_base/checks.h"
@@ -76,6 +78,15 @@ class RTC_EXPORT BasicPortAllocator : public PortAllocator {
 
   void SetVpnList(const std::vector<rtc::NetworkMask>& vpn_list) override;
 
+  // When set, sessions using PORTALLOCATOR_ENABLE_SHARED_SOCKET gather their
+  // UDP host and server reflexive candidates on `shared_udp_port` instead of
+  // binding a port each, and UDP TURN ports get sockets of their own.
+  void SetSharedUdpPort(rtc::scoped_refptr<SharedUdpPort> shared_udp_port);
+  SharedUdpPort* shared_udp_port() const {
+    CheckRunOnValidThreadIfInitialized();
+    return shared_udp_port_.get();
+  }
+
  private:
   void OnIceRegathering(PortAllocatorSession* session,
                         IceRegatheringReason reason);
@@ -94,6 +105,8 @@ class RTC_EXPORT BasicPortAllocator : public PortAllocator {
 
   // This instance is created if caller does pass a factory.
   std::unique_ptr<RelayPortFactoryInterface> default_relay_port_factory_;
+
+  rtc::scoped_refptr<SharedUdpPort> shared_udp_port_;
 };
 
 struct PortConfiguration;
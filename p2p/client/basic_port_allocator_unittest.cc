@@ -1156,6 +1156,45 @@ TEST_F(BasicPortAllocatorTest, TestGetAllPortsWithOneSecondStepDelay) {
   session_->StopGettingPorts();
 }
 
+// Verify that with fast start, all candidates are gathered in the first step,
+// even with the default step delay of 1sec.
+TEST_F(BasicPortAllocatorTest, TestGetAllPortsWithFastStart) {
+  AddInterface(kClientAddr);
+  allocator_->set_step_delay(kDefaultStepDelay);
+  allocator_->set_flags(allocator().flags() | PORTALLOCATOR_ENABLE_FAST_START);
+  ASSERT_TRUE(CreateSession(ICE_CANDIDATE_COMPONENT_RTP));
+  session_->StartGettingPorts();
+  ASSERT_TRUE_SIMULATED_WAIT(candidate_allocation_done_,
+                             kDefaultStepDelay / 2, fake_clock);
+  EXPECT_EQ(3U, candidates_.size());
+  EXPECT_EQ(3U, ports_.size());
+  EXPECT_TRUE(HasCandidate(candidates_, "local", "udp", kClientAddr));
+  EXPECT_TRUE(HasCandidate(candidates_, "local", "tcp", kClientAddr));
+}
+
+// Verify that with fast start, networks with a higher cost than the preferred
+// ones still step through the phases.
+TEST_F(BasicPortAllocatorTest, TestFastStartOnlyOnPreferredNetworks) {
+  AddInterface(kClientAddr, "test_wlan0", rtc::ADAPTER_TYPE_WIFI);
+  AddInterface(kClientAddr2, "test_cell0", rtc::ADAPTER_TYPE_CELLULAR);
+  allocator_->set_step_delay(kDefaultStepDelay);
+  allocator_->set_flags(allocator().flags() | PORTALLOCATOR_ENABLE_FAST_START);
+  ASSERT_TRUE(CreateSession(ICE_CANDIDATE_COMPONENT_RTP));
+  session_->StartGettingPorts();
+  ASSERT_TRUE_SIMULATED_WAIT(
+      HasCandidate(candidates_, "local", "tcp", kClientAddr),
+      kDefaultStepDelay / 2, fake_clock);
+  EXPECT_TRUE(HasCandidate(candidates_, "local", "udp", kClientAddr2));
+  EXPECT_FALSE(HasCandidate(candidates_, "local", "tcp", kClientAddr2));
+  EXPECT_FALSE(candidate_allocation_done_);
+
+  EXPECT_TRUE_SIMULATED_WAIT(
+      HasCandidate(candidates_, "local", "tcp", kClientAddr2),
+      3 * kDefaultStepDelay, fake_clock);
+  EXPECT_TRUE_SIMULATED_WAIT(candidate_allocation_done_,
+                             kDefaultAllocationTimeout, fake_clock);
+}
+
 TEST_F(BasicPortAllocatorTest, TestSetupVideoRtpPortsWithNormalSendBuffers) {
   AddInterface(kClientAddr);
   ASSERT_TRUE(CreateSession(ICE_CANDIDATE_COMPONENT_RTP, CN_VIDEO));
@@ -1611,6 +1650,29 @@ TEST_F(BasicPortAllocatorTest, TestSharedSocketWithoutNat) {
                              kDefaultAllocationTimeout, fake_clock);
 }
 
+// Test that sessions on a SharedUdpPort gather their UDP host candidates on
+// the same local port.
+TEST_F(BasicPortAllocatorTest, TestSessionsShareUdpPort) {
+  const uint16_t kSharedPort = 5000;
+  AddInterface(kClientAddr);
+  allocator_->SetSharedUdpPort(SharedUdpPort::Create(kSharedPort));
+  allocator_->set_flags(allocator().flags() |
+                        PORTALLOCATOR_ENABLE_SHARED_SOCKET |
+                        PORTALLOCATOR_DISABLE_TCP);
+  auto session1 = CreateSession("session1", kContentName,
+                                ICE_CANDIDATE_COMPONENT_RTP, "UF01", kIcePwd0);
+  auto session2 = CreateSession("session2", kContentName,
+                                ICE_CANDIDATE_COMPONENT_RTP, "UF02", kIcePwd0);
+  session1->StartGettingPorts();
+  session2->StartGettingPorts();
+  ASSERT_EQ_SIMULATED_WAIT(2U, candidates_.size(), kDefaultAllocationTimeout,
+                           fake_clock);
+  SocketAddress shared_addr(kClientAddr.ipaddr(), kSharedPort);
+  EXPECT_TRUE(HasCandidate({candidates_[0]}, "local", "udp", shared_addr));
+  EXPECT_TRUE(HasCandidate({candidates_[1]}, "local", "udp", shared_addr));
+  EXPECT_NE(candidates_[0].username(), candidates_[1].username());
+}
+
 // Test that when PORTALLOCATOR_ENABLE_SHARED_SOCKET is enabled only one port
 // is allocated for udp and stun. In this test we should expect both stun and
 // local candidates as client behind a nat.
@@ -121,7 +121,7 @@ class BaseChannel : public ChannelInterface,
   void Deinit();
 
   rtc::Thread* worker_thread() const { return worker_thread_; }
-  rtc::Thread* network_thread() const { return network_thread_; }
+  rtc::Thread* network_thread() const override { return network_thread_; }
   const std::string& content_name() const override { return content_name_; }
   // TODO(deadbeef): This is redundant; remove this.
   const std::string& transport_name() const override {
@@ -18,6 +18,7 @@
 #include "api/media_types.h"
 #include "media/base/media_channel.h"
 #include "pc/rtp_transport_internal.h"
+#include "rtc_base/thread.h"
 
 namespace cricket {
 
@@ -32,6 +33,9 @@ class ChannelInterface {
 
   virtual MediaChannel* media_channel() const = 0;
 
+  // The thread that the channel's transport related state lives on.
+  virtual rtc::Thread* network_thread() const = 0;
+
   // TODO(deadbeef): This is redundant; remove this.
   virtual const std::string& transport_name() const = 0;
 
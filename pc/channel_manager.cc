@@ -143,6 +143,7 @@ VoiceChannel* ChannelManager::CreateVoiceChannel(
     const MediaConfig& media_config,
     webrtc::RtpTransportInternal* rtp_transport,
     rtc::Thread* signaling_thread,
+    rtc::Thread* network_thread,
     const std::string& content_name,
     bool srtp_required,
     const webrtc::CryptoOptions& crypto_options,
@@ -156,8 +157,9 @@ VoiceChannel* ChannelManager::CreateVoiceChannel(
   if (!worker_thread_->IsCurrent()) {
     return worker_thread_->Invoke<VoiceChannel*>(RTC_FROM_HERE, [&] {
       return CreateVoiceChannel(call, media_config, rtp_transport,
-                                signaling_thread, content_name, srtp_required,
-                                crypto_options, ssrc_generator, options);
+                                signaling_thread, network_thread, content_name,
+                                srtp_required, crypto_options, ssrc_generator,
+                                options);
     });
   }
 
@@ -170,7 +172,7 @@ VoiceChannel* ChannelManager::CreateVoiceChannel(
   }
 
   auto voice_channel = std::make_unique<VoiceChannel>(
-      worker_thread_, network_thread_, signaling_thread,
+      worker_thread_, network_thread, signaling_thread,
       absl::WrapUnique(media_channel), content_name, srtp_required,
       crypto_options, ssrc_generator);
 
@@ -204,6 +206,7 @@ VideoChannel* ChannelManager::CreateVideoChannel(
     const MediaConfig& media_config,
     webrtc::RtpTransportInternal* rtp_transport,
     rtc::Thread* signaling_thread,
+    rtc::Thread* network_thread,
     const std::string& content_name,
     bool srtp_required,
     const webrtc::CryptoOptions& crypto_options,
@@ -218,9 +221,9 @@ VideoChannel* ChannelManager::CreateVideoChannel(
   if (!worker_thread_->IsCurrent()) {
     return worker_thread_->Invoke<VideoChannel*>(RTC_FROM_HERE, [&] {
       return CreateVideoChannel(call, media_config, rtp_transport,
-                                signaling_thread, content_name, srtp_required,
-                                crypto_options, ssrc_generator, options,
-                                video_bitrate_allocator_factory);
+                                signaling_thread, network_thread, content_name,
+                                srtp_required, crypto_options, ssrc_generator,
+                                options, video_bitrate_allocator_factory);
     });
   }
 
@@ -234,7 +237,7 @@ VideoChannel* ChannelManager::CreateVideoChannel(
   }
 
   auto video_channel = std::make_unique<VideoChannel>(
-      worker_thread_, network_thread_, signaling_thread,
+      worker_thread_, network_thread, signaling_thread,
       absl::WrapUnique(media_channel), content_name, srtp_required,
       crypto_options, ssrc_generator);
 
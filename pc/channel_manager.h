@@ -79,10 +79,14 @@ class ChannelManager final {
   // call the appropriate Destroy*Channel method when done.
 
   // Creates a voice channel, to be associated with the specified session.
+  // `network_thread` is the network thread of the owning PeerConnection, which
+  // may differ from network_thread() when the factory uses a network thread
+  // pool.
   VoiceChannel* CreateVoiceChannel(webrtc::Call* call,
                                    const MediaConfig& media_config,
                                    webrtc::RtpTransportInternal* rtp_transport,
                                    rtc::Thread* signaling_thread,
+                                   rtc::Thread* network_thread,
                                    const std::string& content_name,
                                    bool srtp_required,
                                    const webrtc::CryptoOptions& crypto_options,
@@ -99,6 +103,7 @@ class ChannelManager final {
       const MediaConfig& media_config,
       webrtc::RtpTransportInternal* rtp_transport,
       rtc::Thread* signaling_thread,
+      rtc::Thread* network_thread,
       const std::string& content_name,
       bool srtp_required,
       const webrtc::CryptoOptions& crypto_options,
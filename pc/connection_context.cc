@@ -10,6 +10,7 @@
 
 #include "pc/connection_context.h"
 
+#include <algorithm>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -17,6 +18,7 @@
 #include "api/transport/field_trial_based_config.h"
 #include "media/sctp/sctp_transport_factory.h"
 #include "rtc_base/helpers.h"
+#include "rtc_base/logging.h"
 #include "rtc_base/task_utils/to_queued_task.h"
 #include "rtc_base/time_utils.h"
 
@@ -70,11 +72,38 @@ std::unique_ptr<SctpTransportFactoryInterface> MaybeCreateSctpFactory(
 #endif
 }
 
+// Blocking calls from other threads into the network thread are allowed, but
+// the network thread itself may only invoke onto itself.
+void ConfigureNetworkThread(rtc::Thread* signaling_thread,
+                            rtc::Thread* worker_thread,
+                            rtc::Thread* network_thread) {
+  signaling_thread->AllowInvokesToThread(network_thread);
+  worker_thread->AllowInvokesToThread(network_thread);
+  if (network_thread->IsCurrent()) {
+    // TODO(https://crbug.com/webrtc/12802) switch to DisallowAllInvokes
+    network_thread->AllowInvokesToThread(network_thread);
+  } else {
+    network_thread->PostTask(ToQueuedTask([thread = network_thread] {
+      thread->DisallowBlockingCalls();
+      // TODO(https://crbug.com/webrtc/12802) switch to DisallowAllInvokes
+      thread->AllowInvokesToThread(thread);
+    }));
+  }
+}
+
 }  // namespace
 
 // Static
 rtc::scoped_refptr<ConnectionContext> ConnectionContext::Create(
     PeerConnectionFactoryDependencies* dependencies) {
+  // Injected network threads and SCTP factories are bound to a single thread,
+  // so they can't be combined with a pool.
+  if (dependencies->network_thread_pool_size > 1 &&
+      (dependencies->network_thread || dependencies->sctp_factory)) {
+    RTC_LOG(LS_WARNING) << "Ignoring network_thread_pool_size since a "
+                           "network thread or SCTP factory was injected.";
+    dependencies->network_thread_pool_size = 1;
+  }
   return new ConnectionContext(dependencies);
 }
 
@@ -98,20 +127,19 @@ ConnectionContext::ConnectionContext(
                                  network_thread())),
       trials_(dependencies->trials
                   ? std::move(dependencies->trials)
-                  : std::make_unique<FieldTrialBasedConfig>()) {
+                  : std::make_unique<FieldTrialBasedConfig>()),
+      srtp_crypto_pool_(dependencies->srtp_crypto_pool_size > 0
+                            ? std::make_unique<CryptoThreadPool>(
+                                  dependencies->srtp_crypto_pool_size,
+                                  "srtp_crypto_")
+                            : nullptr),
+      dtls_handshake_pool_(dependencies->dtls_handshake_pool_size > 0
+                               ? std::make_unique<CryptoThreadPool>(
+                                     dependencies->dtls_handshake_pool_size,
+                                     "dtls_handshake_")
+                               : nullptr) {
   signaling_thread_->AllowInvokesToThread(worker_thread_);
-  signaling_thread_->AllowInvokesToThread(network_thread_);
-  worker_thread_->AllowInvokesToThread(network_thread_);
-  if (network_thread_->IsCurrent()) {
-    // TODO(https://crbug.com/webrtc/12802) switch to DisallowAllInvokes
-    network_thread_->AllowInvokesToThread(network_thread_);
-  } else {
-    network_thread_->PostTask(ToQueuedTask([thread = network_thread_] {
-      thread->DisallowBlockingCalls();
-      // TODO(https://crbug.com/webrtc/12802) switch to DisallowAllInvokes
-      thread->AllowInvokesToThread(thread);
-    }));
-  }
+  ConfigureNetworkThread(signaling_thread_, worker_thread_, network_thread_);
 
   RTC_DCHECK_RUN_ON(signaling_thread_);
   rtc::InitRandom(rtc::Time32());
@@ -128,11 +156,48 @@ ConnectionContext::ConnectionContext(
   default_socket_factory_ = std::make_unique<rtc::BasicPacketSocketFactory>(
       network_thread()->socketserver());
 
-  worker_thread_->Invoke<void>(RTC_FROM_HERE, [&]() {
-    channel_manager_ = cricket::ChannelManager::Create(
-        std::move(dependencies->media_engine),
-        /*enable_rtx=*/true, worker_thread(), network_thread());
-  });
+  network_slots_.push_back({network_thread_, default_network_manager_.get(),
+                            default_socket_factory_.get(),
+                            sctp_factory_.get()});
+
+  for (int i = 1; i < dependencies->network_thread_pool_size; ++i) {
+    PooledNetworkThread pooled;
+    pooled.thread = rtc::Thread::CreateWithSocketServer();
+    pooled.thread->SetName("pc_network_thread_" + std::to_string(i), nullptr);
+    pooled.thread->Start();
+    ConfigureNetworkThread(signaling_thread_, worker_thread_,
+                           pooled.thread.get());
+    pooled.thread->SetDispatchWarningMs(10);
+    pooled.network_manager = std::make_unique<rtc::BasicNetworkManager>(
+        network_monitor_factory_.get(), pooled.thread->socketserver());
+    pooled.socket_factory = std::make_unique<rtc::BasicPacketSocketFactory>(
+        pooled.thread->socketserver());
+    pooled.sctp_factory = MaybeCreateSctpFactory(nullptr, pooled.thread.get());
+    network_slots_.push_back(
+        {pooled.thread.get(), pooled.network_manager.get(),
+         pooled.socket_factory.get(), pooled.sctp_factory.get()});
+    pooled_network_threads_.push_back(std::move(pooled));
+  }
+
+  if (dependencies->async_media_engine_init && !worker_thread_->IsCurrent()) {
+    // Initialize the media engine in the background. Anything that uses it on
+    // the worker thread is queued behind this task, and channel_manager()
+    // waits for it on other threads.
+    worker_thread_->PostTask(ToQueuedTask(
+        [this, media_engine = std::move(dependencies->media_engine)]() mutable {
+          channel_manager_ = cricket::ChannelManager::Create(
+              std::move(media_engine),
+              /*enable_rtx=*/true, worker_thread(), network_thread());
+          channel_manager_created_.Set();
+        }));
+  } else {
+    worker_thread_->Invoke<void>(RTC_FROM_HERE, [&]() {
+      channel_manager_ = cricket::ChannelManager::Create(
+          std::move(dependencies->media_engine),
+          /*enable_rtx=*/true, worker_thread(), network_thread());
+    });
+    channel_manager_created_.Set();
+  }
 
   // Set warning levels on the threads, to give warnings when response
   // may be slower than is expected of the thread.
@@ -151,15 +216,53 @@ ConnectionContext::~ConnectionContext() {
 
   // Make sure `worker_thread()` and `signaling_thread()` outlive
   // `default_socket_factory_` and `default_network_manager_`.
+  network_slots_.clear();
   default_socket_factory_ = nullptr;
   default_network_manager_ = nullptr;
+  for (PooledNetworkThread& pooled : pooled_network_threads_) {
+    pooled.socket_factory = nullptr;
+    pooled.network_manager = nullptr;
+  }
+  // Stops the pooled threads.
+  pooled_network_threads_.clear();
 
   if (wraps_current_thread_)
     rtc::ThreadManager::Instance()->UnwrapCurrentThread();
 }
 
 cricket::ChannelManager* ConnectionContext::channel_manager() const {
+  if (!channel_manager_created_.Wait(0)) {
+    RTC_DCHECK(!worker_thread_->IsCurrent());
+    channel_manager_created_.Wait(rtc::Event::kForever);
+  }
   return channel_manager_.get();
 }
 
+const ConnectionContext::NetworkSlot& ConnectionContext::AcquireNetworkSlot(
+    bool use_default_thread) {
+  RTC_DCHECK_RUN_ON(signaling_thread_);
+  auto slot = network_slots_.begin();
+  if (!use_default_thread) {
+    slot = std::min_element(network_slots_.begin(), network_slots_.end(),
+                            [](const NetworkSlot& a, const NetworkSlot& b) {
+                              return a.peer_connection_count <
+                                     b.peer_connection_count;
+                            });
+  }
+  ++slot->peer_connection_count;
+  return *slot;
+}
+
+void ConnectionContext::ReleaseNetworkSlot(rtc::Thread* network_thread) {
+  RTC_DCHECK_RUN_ON(signaling_thread_);
+  auto slot = std::find_if(
+      network_slots_.begin(), network_slots_.end(),
+      [&](const NetworkSlot& s) { return s.thread == network_thread; });
+  RTC_DCHECK(slot != network_slots_.end());
+  if (slot == network_slots_.end())
+    return;
+  RTC_DCHECK_GT(slot->peer_connection_count, 0);
+  --slot->peer_connection_count;
+}
+
 }  // namespace webrtc
@@ -13,6 +13,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "api/call/call_factory_interface.h"
 #include "api/media_stream_interface.h"
@@ -25,7 +26,9 @@
 #include "media/base/media_engine.h"
 #include "p2p/base/basic_packet_socket_factory.h"
 #include "pc/channel_manager.h"
+#include "pc/crypto_thread_pool.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/event.h"
 #include "rtc_base/network.h"
 #include "rtc_base/network_monitor_factory.h"
 #include "rtc_base/rtc_certificate_generator.h"
@@ -65,6 +68,8 @@ class ConnectionContext final
     return sctp_factory_.get();
   }
 
+  // With PeerConnectionFactoryDependencies::async_media_engine_init, waits
+  // for the media engine to finish initializing on the worker thread.
   cricket::ChannelManager* channel_manager() const;
 
   rtc::Thread* signaling_thread() { return signaling_thread_; }
@@ -74,8 +79,40 @@ class ConnectionContext final
   rtc::Thread* network_thread() { return network_thread_; }
   const rtc::Thread* network_thread() const { return network_thread_; }
 
+  // A network thread that a PeerConnection can be pinned to, along with the
+  // default networking objects that must be used on that thread.
+  struct NetworkSlot {
+    rtc::Thread* thread = nullptr;
+    rtc::BasicNetworkManager* network_manager = nullptr;
+    rtc::BasicPacketSocketFactory* socket_factory = nullptr;
+    SctpTransportFactoryInterface* sctp_factory = nullptr;
+    int peer_connection_count = 0;
+  };
+
+  // Picks the network thread for a new PeerConnection. When the factory runs
+  // a pool of network threads (see
+  // PeerConnectionFactoryDependencies::network_thread_pool_size), the one
+  // with the fewest PeerConnections is chosen unless `use_default_thread` is
+  // set, in which case network_thread() is always used. Every call must be
+  // balanced by a call to ReleaseNetworkSlot().
+  const NetworkSlot& AcquireNetworkSlot(bool use_default_thread);
+  void ReleaseNetworkSlot(rtc::Thread* network_thread);
+  // Number of network threads PeerConnections are spread across.
+  size_t network_thread_count() const { return network_slots_.size(); }
+
   const WebRtcKeyValueConfig& trials() const { return *trials_.get(); }
 
+  // The threads that SRTP transports move their crypto to, or null if
+  // PeerConnectionFactoryDependencies::srtp_crypto_pool_size isn't set.
+  CryptoThreadPool* srtp_crypto_pool() const {
+    return srtp_crypto_pool_.get();
+  }
+  // The threads that DTLS transports run their handshakes on, or null if
+  // PeerConnectionFactoryDependencies::dtls_handshake_pool_size isn't set.
+  CryptoThreadPool* dtls_handshake_pool() const {
+    return dtls_handshake_pool_.get();
+  }
+
   // Accessors only used from the PeerConnectionFactory class
   rtc::BasicNetworkManager* default_network_manager() {
     RTC_DCHECK_RUN_ON(signaling_thread_);
@@ -112,6 +149,10 @@ class ConnectionContext final
   rtc::Thread* const signaling_thread_;
   // channel_manager is accessed both on signaling thread and worker thread.
   std::unique_ptr<cricket::ChannelManager> channel_manager_;
+  // Set once `channel_manager_` is created, which happens in the background
+  // with PeerConnectionFactoryDependencies::async_media_engine_init.
+  mutable rtc::Event channel_manager_created_{/*manual_reset=*/true,
+                                              /*initially_signaled=*/false};
   std::unique_ptr<rtc::NetworkMonitorFactory> const network_monitor_factory_
       RTC_GUARDED_BY(signaling_thread_);
   std::unique_ptr<rtc::BasicNetworkManager> default_network_manager_
@@ -124,6 +165,21 @@ class ConnectionContext final
   std::unique_ptr<SctpTransportFactoryInterface> const sctp_factory_;
   // Accessed both on signaling thread and worker thread.
   std::unique_ptr<WebRtcKeyValueConfig> const trials_;
+  std::unique_ptr<CryptoThreadPool> const srtp_crypto_pool_;
+  std::unique_ptr<CryptoThreadPool> const dtls_handshake_pool_;
+
+  // Additional network threads started when a network thread pool is used,
+  // and the networking objects bound to each of them.
+  struct PooledNetworkThread {
+    std::unique_ptr<rtc::Thread> thread;
+    std::unique_ptr<rtc::BasicNetworkManager> network_manager;
+    std::unique_ptr<rtc::BasicPacketSocketFactory> socket_factory;
+    std::unique_ptr<SctpTransportFactoryInterface> sctp_factory;
+  };
+  std::vector<PooledNetworkThread> pooled_network_threads_
+      RTC_GUARDED_BY(signaling_thread_);
+  // The first slot always refers to `network_thread_`.
+  std::vector<NetworkSlot> network_slots_ RTC_GUARDED_BY(signaling_thread_);
 };
 
 }  // namespace webrtc
@@ -0,0 +1,105 @@
+/*
+ *  Copyright 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "pc/connection_context.h"
+
+#include <memory>
+#include <set>
+
+#include "media/base/fake_media_engine.h"
+#include "rtc_base/thread.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+rtc::scoped_refptr<ConnectionContext> CreateContext(int pool_size) {
+  PeerConnectionFactoryDependencies dependencies;
+  dependencies.signaling_thread = rtc::Thread::Current();
+  dependencies.network_thread_pool_size = pool_size;
+  return ConnectionContext::Create(&dependencies);
+}
+
+}  // namespace
+
+TEST(ConnectionContextTest, UsesSingleNetworkThreadByDefault) {
+  rtc::AutoThread main_thread;
+  auto context = CreateContext(1);
+  EXPECT_EQ(1u, context->network_thread_count());
+  const auto& slot = context->AcquireNetworkSlot(false);
+  EXPECT_EQ(context->network_thread(), slot.thread);
+  EXPECT_EQ(context->default_network_manager(), slot.network_manager);
+  EXPECT_EQ(context->default_socket_factory(), slot.socket_factory);
+  context->ReleaseNetworkSlot(slot.thread);
+}
+
+TEST(ConnectionContextTest, SpreadsPeerConnectionsAcrossNetworkThreads) {
+  rtc::AutoThread main_thread;
+  auto context = CreateContext(3);
+  ASSERT_EQ(3u, context->network_thread_count());
+
+  std::set<rtc::Thread*> threads;
+  std::set<rtc::BasicPacketSocketFactory*> socket_factories;
+  for (int i = 0; i < 3; ++i) {
+    const auto& slot = context->AcquireNetworkSlot(false);
+    threads.insert(slot.thread);
+    socket_factories.insert(slot.socket_factory);
+  }
+  EXPECT_EQ(3u, threads.size());
+  EXPECT_EQ(3u, socket_factories.size());
+  EXPECT_EQ(1u, threads.count(context->network_thread()));
+
+  // Once a thread is released, it is the least loaded one.
+  rtc::Thread* released = *threads.rbegin();
+  context->ReleaseNetworkSlot(released);
+  EXPECT_EQ(released, context->AcquireNetworkSlot(false).thread);
+
+  for (rtc::Thread* thread : threads)
+    context->ReleaseNetworkSlot(thread);
+}
+
+TEST(ConnectionContextTest, DefaultThreadCanBeRequested) {
+  rtc::AutoThread main_thread;
+  auto context = CreateContext(2);
+  EXPECT_EQ(context->network_thread(),
+            context->AcquireNetworkSlot(true).thread);
+  EXPECT_EQ(context->network_thread(),
+            context->AcquireNetworkSlot(true).thread);
+  context->ReleaseNetworkSlot(context->network_thread());
+  context->ReleaseNetworkSlot(context->network_thread());
+}
+
+TEST(ConnectionContextTest, PoolIgnoredWithInjectedNetworkThread) {
+  rtc::AutoThread main_thread;
+  auto network_thread = rtc::Thread::CreateWithSocketServer();
+  network_thread->Start();
+  PeerConnectionFactoryDependencies dependencies;
+  dependencies.signaling_thread = rtc::Thread::Current();
+  dependencies.network_thread = network_thread.get();
+  dependencies.network_thread_pool_size = 4;
+  auto context = ConnectionContext::Create(&dependencies);
+  EXPECT_EQ(1u, context->network_thread_count());
+}
+
+TEST(ConnectionContextTest, InitializesMediaEngineInBackground) {
+  rtc::AutoThread main_thread;
+  auto worker_thread = rtc::Thread::Create();
+  worker_thread->Start();
+  PeerConnectionFactoryDependencies dependencies;
+  dependencies.signaling_thread = rtc::Thread::Current();
+  dependencies.worker_thread = worker_thread.get();
+  dependencies.media_engine = std::make_unique<cricket::FakeMediaEngine>();
+  dependencies.async_media_engine_init = true;
+  auto context = ConnectionContext::Create(&dependencies);
+  ASSERT_TRUE(context->channel_manager());
+  EXPECT_TRUE(context->channel_manager()->media_engine());
+}
+
+}  // namespace webrtc
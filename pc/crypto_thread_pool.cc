@@ -0,0 +1,40 @@
+/*
+ *  Copyright 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "pc/crypto_thread_pool.h"
+
+#include <string>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+CryptoThreadPool::CryptoThreadPool(int num_threads, absl::string_view name) {
+  RTC_DCHECK_GT(num_threads, 0);
+  for (int i = 0; i < num_threads; ++i) {
+    threads_.push_back(rtc::Thread::Create());
+    threads_.back()->SetName(std::string(name) + std::to_string(i), nullptr);
+    threads_.back()->Start();
+  }
+}
+
+CryptoThreadPool::~CryptoThreadPool() {
+  for (auto& thread : threads_) {
+    thread->Stop();
+  }
+}
+
+TaskQueueBase* CryptoThreadPool::GetQueue() {
+  return threads_[next_.fetch_add(1, std::memory_order_relaxed) %
+                  threads_.size()]
+      .get();
+}
+
+}  // namespace webrtc
@@ -0,0 +1,55 @@
+/*
+ *  Copyright 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef PC_CRYPTO_THREAD_POOL_H_
+#define PC_CRYPTO_THREAD_POOL_H_
+
+#include <stddef.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "api/task_queue/task_queue_base.h"
+#include "rtc_base/thread.h"
+
+namespace webrtc {
+
+// A set of threads that the transports of one PeerConnectionFactory can move
+// their crypto to, so that it uses several cores rather than sharing the core
+// of the network thread. See SrtpTransport::SetCryptoQueue() and
+// DtlsTransport::SetHandshakeQueue().
+//
+// Each transport is given one of the threads; libsrtp sessions and SSL
+// objects can't be used from several threads at once, and running all the
+// crypto of a transport on one thread keeps its packets in order.
+class CryptoThreadPool {
+ public:
+  // The threads are named `name` followed by their index.
+  CryptoThreadPool(int num_threads, absl::string_view name);
+  ~CryptoThreadPool();
+
+  CryptoThreadPool(const CryptoThreadPool&) = delete;
+  CryptoThreadPool& operator=(const CryptoThreadPool&) = delete;
+
+  // Returns the thread for a new transport, round robin. Thread-safe.
+  TaskQueueBase* GetQueue();
+
+  size_t size() const { return threads_.size(); }
+
+ private:
+  std::vector<std::unique_ptr<rtc::Thread>> threads_;
+  std::atomic<size_t> next_{0};
+};
+
+}  // namespace webrtc
+
+#endif  // PC_CRYPTO_THREAD_POOL_H_
@@ -24,6 +24,19 @@
 #include "rtc_base/task_utils/to_queued_task.h"
 
 namespace webrtc {
+namespace {
+
+cricket::SendDataResult ToSendDataResult(const RTCError& error) {
+  if (error.ok())
+    return cricket::SendDataResult::SDR_SUCCESS;
+  // SCTP transport uses RESOURCE_EXHAUSTED when it's blocked.
+  // TODO(mellem):  Stop using RTCError here and get rid of the mapping.
+  if (error.type() == RTCErrorType::RESOURCE_EXHAUSTED)
+    return cricket::SendDataResult::SDR_BLOCK;
+  return cricket::SendDataResult::SDR_ERROR;
+}
+
+}  // namespace
 
 bool DataChannelController::HasDataChannels() const {
   RTC_DCHECK_RUN_ON(signaling_thread());
@@ -40,6 +53,37 @@ bool DataChannelController::SendData(int sid,
   return false;
 }
 
+size_t DataChannelController::SendDataBatch(
+    int sid,
+    const SendDataParams& params,
+    rtc::ArrayView<const DataBuffer* const> buffers,
+    cricket::SendDataResult* result) {
+  RTC_DCHECK_RUN_ON(signaling_thread());
+  if (!data_channel_transport()) {
+    RTC_LOG(LS_ERROR) << "SendDataBatch called before transport is ready";
+    return 0;
+  }
+  // A single invoke for all buffers, since the thread hop costs far more
+  // than sending a small message.
+  size_t num_sent = 0;
+  RTCError error = network_thread()->Invoke<RTCError>(RTC_FROM_HERE, [&] {
+    SendDataParams send_params = params;
+    for (const DataBuffer* buffer : buffers) {
+      send_params.type =
+          buffer->binary ? DataMessageType::kBinary : DataMessageType::kText;
+      RTCError send_error =
+          data_channel_transport()->SendData(sid, send_params, buffer->data);
+      if (!send_error.ok())
+        return send_error;
+      ++num_sent;
+    }
+    return RTCError::OK();
+  });
+  if (!error.ok())
+    *result = ToSendDataResult(error);
+  return num_sent;
+}
+
 bool DataChannelController::ConnectDataChannel(
     SctpDataChannel* webrtc_data_channel) {
   RTC_DCHECK_RUN_ON(signaling_thread());
@@ -74,11 +118,12 @@ void DataChannelController::DisconnectDataChannel(
   SignalDataChannelTransportChannelClosed_s.disconnect(webrtc_data_channel);
 }
 
-void DataChannelController::AddSctpDataStream(int sid) {
+void DataChannelController::AddSctpDataStream(int sid, Priority priority) {
   if (data_channel_transport()) {
-    network_thread()->Invoke<void>(RTC_FROM_HERE, [this, sid] {
+    network_thread()->Invoke<void>(RTC_FROM_HERE, [this, sid, priority] {
       if (data_channel_transport()) {
         data_channel_transport()->OpenChannel(sid);
+        data_channel_transport()->SetChannelPriority(sid, priority);
       }
     });
   }
@@ -401,17 +446,8 @@ bool DataChannelController::DataChannelSendData(
         return data_channel_transport()->SendData(sid, params, payload);
       });
 
-  if (error.ok()) {
-    *result = cricket::SendDataResult::SDR_SUCCESS;
-    return true;
-  } else if (error.type() == RTCErrorType::RESOURCE_EXHAUSTED) {
-    // SCTP transport uses RESOURCE_EXHAUSTED when it's blocked.
-    // TODO(mellem):  Stop using RTCError here and get rid of the mapping.
-    *result = cricket::SendDataResult::SDR_BLOCK;
-    return false;
-  }
-  *result = cricket::SendDataResult::SDR_ERROR;
-  return false;
+  *result = ToSendDataResult(error);
+  return error.ok();
 }
 
 void DataChannelController::NotifyDataChannelsOfTransportCreated() {
@@ -57,9 +57,13 @@ class DataChannelController : public SctpDataChannelProviderInterface,
                 const SendDataParams& params,
                 const rtc::CopyOnWriteBuffer& payload,
                 cricket::SendDataResult* result) override;
+  size_t SendDataBatch(int sid,
+                       const SendDataParams& params,
+                       rtc::ArrayView<const DataBuffer* const> buffers,
+                       cricket::SendDataResult* result) override;
   bool ConnectDataChannel(SctpDataChannel* webrtc_data_channel) override;
   void DisconnectDataChannel(SctpDataChannel* webrtc_data_channel) override;
-  void AddSctpDataStream(int sid) override;
+  void AddSctpDataStream(int sid, Priority priority) override;
   void RemoveSctpDataStream(int sid) override;
   bool ReadyToSendData() const override;
 
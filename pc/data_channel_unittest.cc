@@ -211,6 +211,24 @@ TEST_F(SctpDataChannelTest, QueuedDataSentWhenUnblocked) {
   EXPECT_EQ(1U, observer_->on_buffered_amount_change_count());
 }
 
+// Tests that the queued data are handed to the provider as a single batch.
+TEST_F(SctpDataChannelTest, QueuedDataSentInOneBatch) {
+  AddObserver();
+  SetChannelReady();
+  provider_->set_send_blocked(true);
+  const size_t number_of_packets = 3;
+  for (size_t i = 0; i < number_of_packets; ++i) {
+    EXPECT_TRUE(webrtc_data_channel_->Send(webrtc::DataBuffer("abcd")));
+  }
+  EXPECT_EQ(0, provider_->send_data_batch_count());
+
+  provider_->set_send_blocked(false);
+  EXPECT_EQ(1, provider_->send_data_batch_count());
+  EXPECT_EQ(0U, webrtc_data_channel_->buffered_amount());
+  EXPECT_EQ(number_of_packets, webrtc_data_channel_->messages_sent());
+  EXPECT_EQ(number_of_packets, observer_->on_buffered_amount_change_count());
+}
+
 // Tests that no crash when the channel is blocked right away while trying to
 // send queued data.
 TEST_F(SctpDataChannelTest, BlockedWhenSendQueuedDataNoCrash) {
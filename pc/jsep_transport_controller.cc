@@ -415,9 +415,14 @@ JsepTransportController::CreateDtlsTransport(
     dtls = config_.dtls_transport_factory->CreateDtlsTransport(
         ice, config_.crypto_options, config_.ssl_max_version);
   } else {
-    dtls = std::make_unique<cricket::DtlsTransport>(ice, config_.crypto_options,
-                                                    config_.event_log,
-                                                    config_.ssl_max_version);
+    auto dtls_transport = std::make_unique<cricket::DtlsTransport>(
+        ice, config_.crypto_options, config_.event_log,
+        config_.ssl_max_version);
+    if (config_.dtls_handshake_pool) {
+      dtls_transport->SetHandshakeQueue(
+          config_.dtls_handshake_pool->GetQueue());
+    }
+    dtls = std::move(dtls_transport);
   }
 
   RTC_DCHECK(dtls);
@@ -487,6 +492,9 @@ JsepTransportController::CreateSdesTransport(
   if (config_.enable_external_auth) {
     srtp_transport->EnableExternalAuth();
   }
+  if (config_.srtp_crypto_pool) {
+    srtp_transport->SetCryptoQueue(config_.srtp_crypto_pool->GetQueue());
+  }
   return srtp_transport;
 }
 
@@ -501,6 +509,9 @@ JsepTransportController::CreateDtlsSrtpTransport(
   if (config_.enable_external_auth) {
     dtls_srtp_transport->EnableExternalAuth();
   }
+  if (config_.srtp_crypto_pool) {
+    dtls_srtp_transport->SetCryptoQueue(config_.srtp_crypto_pool->GetQueue());
+  }
 
   dtls_srtp_transport->SetDtlsTransports(rtp_dtls_transport,
                                          rtcp_dtls_transport);
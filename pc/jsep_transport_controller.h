@@ -46,6 +46,7 @@
 #include "p2p/base/transport_description.h"
 #include "p2p/base/transport_info.h"
 #include "pc/channel.h"
+#include "pc/crypto_thread_pool.h"
 #include "pc/dtls_srtp_transport.h"
 #include "pc/dtls_transport.h"
 #include "pc/jsep_transport.h"
@@ -120,6 +121,12 @@ class JsepTransportController : public sigslot::has_slots<> {
         PeerConnectionInterface::kRtcpMuxPolicyRequire;
     bool disable_encryption = false;
     bool enable_external_auth = false;
+    // If set, the SRTP transports move their crypto to its threads. Must
+    // outlive the JsepTransportController.
+    CryptoThreadPool* srtp_crypto_pool = nullptr;
+    // If set, the DTLS transports created by this controller run their
+    // handshakes on its threads. Must outlive the JsepTransportController.
+    CryptoThreadPool* dtls_handshake_pool = nullptr;
     // Used to inject the ICE/DTLS transports created externally.
     webrtc::IceTransportFactory* ice_transport_factory = nullptr;
     cricket::DtlsTransportFactory* dtls_transport_factory = nullptr;
@@ -472,8 +472,10 @@ static bool UpdateTransportInfoForBundle(const ContentGroup& bundle_group,
       selected_transport_info->description.ice_pwd;
   ConnectionRole selected_connection_role =
       selected_transport_info->description.connection_role;
+  const std::set<absl::string_view> bundled_names(
+      bundle_group.content_names().begin(), bundle_group.content_names().end());
   for (TransportInfo& transport_info : sdesc->transport_infos()) {
-    if (bundle_group.HasContentName(transport_info.content_name) &&
+    if (bundled_names.count(transport_info.content_name) &&
         transport_info.content_name != selected_content_name) {
       transport_info.description.ice_ufrag = selected_ufrag;
       transport_info.description.ice_pwd = selected_pwd;
@@ -483,22 +485,6 @@ static bool UpdateTransportInfoForBundle(const ContentGroup& bundle_group,
   return true;
 }
 
-// Gets the CryptoParamsVec of the given `content_name` from `sdesc`, and
-// sets it to `cryptos`.
-static bool GetCryptosByName(const SessionDescription* sdesc,
-                             const std::string& content_name,
-                             CryptoParamsVec* cryptos) {
-  if (!sdesc || !cryptos) {
-    return false;
-  }
-  const ContentInfo* content = sdesc->GetContentByName(content_name);
-  if (!content || !content->media_description()) {
-    return false;
-  }
-  *cryptos = content->media_description()->cryptos();
-  return true;
-}
-
 // Prunes the `target_cryptos` by removing the crypto params (cipher_suite)
 // which are not available in `filter`.
 static void PruneCryptos(const CryptoParamsVec& filter,
@@ -521,14 +507,9 @@ static void PruneCryptos(const CryptoParamsVec& filter,
       target_cryptos->end());
 }
 
-static bool IsRtpContent(SessionDescription* sdesc,
-                         const std::string& content_name) {
-  bool is_rtp = false;
-  ContentInfo* content = sdesc->GetContentByName(content_name);
-  if (content && content->media_description()) {
-    is_rtp = IsRtpProtocol(content->media_description()->protocol());
-  }
-  return is_rtp;
+static bool IsRtpContent(const ContentInfo* content) {
+  return content && content->media_description() &&
+         IsRtpProtocol(content->media_description()->protocol());
 }
 
 // Updates the crypto parameters of the `sdesc` according to the given
@@ -542,36 +523,49 @@ static bool UpdateCryptoParamsForBundle(const ContentGroup& bundle_group,
     return false;
   }
 
+  // Looking up each content of a large bundle by name in `sdesc` would take
+  // quadratic time, hence they are indexed first.
+  std::map<absl::string_view, ContentInfo*> contents_by_name;
+  for (ContentInfo& content : sdesc->contents()) {
+    contents_by_name.emplace(content.name, &content);
+  }
+  std::map<absl::string_view, const TransportInfo*> transport_infos_by_name;
+  for (const TransportInfo& transport_info : sdesc->transport_infos()) {
+    transport_infos_by_name.emplace(transport_info.content_name,
+                                    &transport_info);
+  }
+  auto find_content = [&contents_by_name](const std::string& content_name) {
+    auto it = contents_by_name.find(content_name);
+    return it != contents_by_name.end() ? it->second : nullptr;
+  };
+
   bool common_cryptos_needed = false;
   // Get the common cryptos.
   const ContentNames& content_names = bundle_group.content_names();
   CryptoParamsVec common_cryptos;
   bool first = true;
   for (const std::string& content_name : content_names) {
-    if (!IsRtpContent(sdesc, content_name)) {
+    const ContentInfo* content = find_content(content_name);
+    if (!IsRtpContent(content)) {
       continue;
     }
     // The common cryptos are needed if any of the content does not have DTLS
     // enabled.
-    if (!sdesc->GetTransportInfoByName(content_name)->description.secure()) {
+    auto transport_info = transport_infos_by_name.find(content_name);
+    RTC_CHECK(transport_info != transport_infos_by_name.end());
+    if (!transport_info->second->description.secure()) {
       common_cryptos_needed = true;
     }
     if (first) {
       first = false;
       // Initial the common_cryptos with the first content in the bundle group.
-      if (!GetCryptosByName(sdesc, content_name, &common_cryptos)) {
-        return false;
-      }
+      common_cryptos = content->media_description()->cryptos();
       if (common_cryptos.empty()) {
         // If there's no crypto params, we should just return.
         return true;
       }
     } else {
-      CryptoParamsVec cryptos;
-      if (!GetCryptosByName(sdesc, content_name, &cryptos)) {
-        return false;
-      }
-      PruneCryptos(cryptos, &common_cryptos);
+      PruneCryptos(content->media_description()->cryptos(), &common_cryptos);
     }
   }
 
@@ -581,10 +575,10 @@ static bool UpdateCryptoParamsForBundle(const ContentGroup& bundle_group,
 
   // Update to use the common cryptos.
   for (const std::string& content_name : content_names) {
-    if (!IsRtpContent(sdesc, content_name)) {
+    ContentInfo* content = find_content(content_name);
+    if (!IsRtpContent(content)) {
       continue;
     }
-    ContentInfo* content = sdesc->GetContentByName(content_name);
     if (IsMediaContent(content)) {
       MediaContentDescription* media_desc = content->media_description();
       if (!media_desc) {
@@ -1463,6 +1457,23 @@ static const TransportDescription* GetTransportDescription(
   return desc;
 }
 
+// Same as above, but first looks at the transport info of `msection_index`,
+// where it usually is, instead of searching all of them.
+static const TransportDescription* GetTransportDescription(
+    const std::string& content_name,
+    size_t msection_index,
+    const SessionDescription* current_description) {
+  if (current_description &&
+      msection_index < current_description->transport_infos().size()) {
+    const TransportInfo& info =
+        current_description->transport_infos()[msection_index];
+    if (info.content_name == content_name) {
+      return &info.description;
+    }
+  }
+  return GetTransportDescription(content_name, current_description);
+}
+
 // Gets the current DTLS state from the transport description.
 static bool IsDtlsActive(const ContentInfo* content,
                          const SessionDescription* current_description) {
@@ -1610,6 +1621,51 @@ MediaSessionDescriptionFactory::filtered_rtp_header_extensions(
   return extensions;
 }
 
+// The codecs of an m-section in an offer only depend on the transceiver
+// direction and on the codecs of the current m-section, if it is reused. Large
+// sessions mostly consist of m-sections that are alike, hence filtering their
+// codecs once instead of once per m-section saves most of the work.
+template <class C>
+class MediaSessionDescriptionFactory::OfferCodecsCache {
+ public:
+  // Returns the codecs cached for an m-section with `direction` and
+  // `current_codecs`, which is null for a new m-section, or null if there are
+  // none.
+  const std::vector<C>* Find(webrtc::RtpTransceiverDirection direction,
+                             const std::vector<C>* current_codecs) const {
+    for (const Entry& entry : entries_) {
+      if (entry.direction == direction &&
+          (entry.current_codecs == current_codecs ||
+           (entry.current_codecs && current_codecs &&
+            *entry.current_codecs == *current_codecs))) {
+        return &entry.codecs;
+      }
+    }
+    return nullptr;
+  }
+
+  // `current_codecs` must outlive the cache.
+  void Add(webrtc::RtpTransceiverDirection direction,
+           const std::vector<C>* current_codecs,
+           const std::vector<C>& codecs) {
+    // Bounds the cost of a lookup if the m-sections differ.
+    if (entries_.size() == kMaxEntries) {
+      entries_.erase(entries_.begin());
+    }
+    entries_.push_back({direction, current_codecs, codecs});
+  }
+
+ private:
+  static constexpr size_t kMaxEntries = 4;
+
+  struct Entry {
+    webrtc::RtpTransceiverDirection direction;
+    const std::vector<C>* current_codecs;
+    std::vector<C> codecs;
+  };
+  std::vector<Entry> entries_;
+};
+
 std::unique_ptr<SessionDescription> MediaSessionDescriptionFactory::CreateOffer(
     const MediaSessionOptions& session_options,
     const SessionDescription* current_description) const {
@@ -1641,6 +1697,8 @@ std::unique_ptr<SessionDescription> MediaSessionDescriptionFactory::CreateOffer(
           session_options.media_description_options);
 
   auto offer = std::make_unique<SessionDescription>();
+  OfferCodecsCache<AudioCodec> audio_codecs_cache;
+  OfferCodecsCache<VideoCodec> video_codecs_cache;
 
   // Iterate through the media description options, matching with existing media
   // descriptions in `current_description`.
@@ -1661,7 +1719,8 @@ std::unique_ptr<SessionDescription> MediaSessionDescriptionFactory::CreateOffer(
         if (!AddAudioContentForOffer(media_description_options, session_options,
                                      current_content, current_description,
                                      extensions_with_ids.audio,
-                                     offer_audio_codecs, &current_streams,
+                                     offer_audio_codecs, &audio_codecs_cache,
+                                     &current_streams,
                                      offer.get(), &ice_credentials)) {
           return nullptr;
         }
@@ -1670,7 +1729,8 @@ std::unique_ptr<SessionDescription> MediaSessionDescriptionFactory::CreateOffer(
         if (!AddVideoContentForOffer(media_description_options, session_options,
                                      current_content, current_description,
                                      extensions_with_ids.video,
-                                     offer_video_codecs, &current_streams,
+                                     offer_video_codecs, &video_codecs_cache,
+                                     &current_streams,
                                      offer.get(), &ice_credentials)) {
           return nullptr;
         }
@@ -2022,15 +2082,27 @@ void MergeCodecsFromDescription(
     AudioCodecs* audio_codecs,
     VideoCodecs* video_codecs,
     UsedPayloadTypes* used_pltypes) {
+  // Merging the same codecs again adds nothing, so the contents that have the
+  // codecs of the last merged content of their type are skipped.
+  const AudioCodecs* merged_audio_codecs = nullptr;
+  const VideoCodecs* merged_video_codecs = nullptr;
   for (const ContentInfo* content : current_active_contents) {
     if (IsMediaContentOfType(content, MEDIA_TYPE_AUDIO)) {
       const AudioContentDescription* audio =
           content->media_description()->as_audio();
+      if (merged_audio_codecs && *merged_audio_codecs == audio->codecs()) {
+        continue;
+      }
       MergeCodecs<AudioCodec>(audio->codecs(), audio_codecs, used_pltypes);
+      merged_audio_codecs = &audio->codecs();
     } else if (IsMediaContentOfType(content, MEDIA_TYPE_VIDEO)) {
       const VideoContentDescription* video =
           content->media_description()->as_video();
+      if (merged_video_codecs && *merged_video_codecs == video->codecs()) {
+        continue;
+      }
       MergeCodecs<VideoCodec>(video->codecs(), video_codecs, used_pltypes);
+      merged_video_codecs = &video->codecs();
     }
   }
 }
@@ -2192,8 +2264,10 @@ bool MediaSessionDescriptionFactory::AddTransportOffer(
     IceCredentialsIterator* ice_credentials) const {
   if (!transport_desc_factory_)
     return false;
-  const TransportDescription* current_tdesc =
-      GetTransportDescription(content_name, current_desc);
+  // The content of the transport has just been added to `offer_desc`.
+  RTC_DCHECK(!offer_desc->contents().empty());
+  const TransportDescription* current_tdesc = GetTransportDescription(
+      content_name, offer_desc->contents().size() - 1, current_desc);
   std::unique_ptr<TransportDescription> new_tdesc(
       transport_desc_factory_->CreateOffer(transport_options, current_tdesc,
                                            ice_credentials));
@@ -2251,6 +2325,7 @@ bool MediaSessionDescriptionFactory::AddAudioContentForOffer(
     const SessionDescription* current_description,
     const RtpHeaderExtensions& audio_rtp_extensions,
     const AudioCodecs& audio_codecs,
+    OfferCodecsCache<AudioCodec>* codecs_cache,
     StreamParamsVec* current_streams,
     SessionDescription* desc,
     IceCredentialsIterator* ice_credentials) const {
@@ -2270,29 +2345,40 @@ bool MediaSessionDescriptionFactory::AddAudioContentForOffer(
   } else {
     // Add the codecs from current content if it exists and is not rejected nor
     // recycled.
+    const AudioCodecs* current_codecs = nullptr;
     if (current_content && !current_content->rejected &&
         current_content->name == media_description_options.mid) {
       RTC_CHECK(IsMediaContentOfType(current_content, MEDIA_TYPE_AUDIO));
-      const AudioContentDescription* acd =
-          current_content->media_description()->as_audio();
-      for (const AudioCodec& codec : acd->codecs()) {
-        if (FindMatchingCodec<AudioCodec>(acd->codecs(), audio_codecs, codec,
-                                          nullptr)) {
-          filtered_codecs.push_back(codec);
+      current_codecs =
+          &current_content->media_description()->as_audio()->codecs();
+    }
+    const AudioCodecs* cached_codecs =
+        codecs_cache->Find(media_description_options.direction, current_codecs);
+    if (cached_codecs) {
+      filtered_codecs = *cached_codecs;
+    } else {
+      if (current_codecs) {
+        for (const AudioCodec& codec : *current_codecs) {
+          if (FindMatchingCodec<AudioCodec>(*current_codecs, audio_codecs,
+                                            codec, nullptr)) {
+            filtered_codecs.push_back(codec);
+          }
         }
       }
-    }
-    // Add other supported audio codecs.
-    AudioCodec found_codec;
-    for (const AudioCodec& codec : supported_audio_codecs) {
-      if (FindMatchingCodec<AudioCodec>(supported_audio_codecs, audio_codecs,
-                                        codec, &found_codec) &&
-          !FindMatchingCodec<AudioCodec>(supported_audio_codecs,
-                                         filtered_codecs, codec, nullptr)) {
-        // Use the `found_codec` from `audio_codecs` because it has the
-        // correctly mapped payload type.
-        filtered_codecs.push_back(found_codec);
+      // Add other supported audio codecs.
+      AudioCodec found_codec;
+      for (const AudioCodec& codec : supported_audio_codecs) {
+        if (FindMatchingCodec<AudioCodec>(supported_audio_codecs, audio_codecs,
+                                          codec, &found_codec) &&
+            !FindMatchingCodec<AudioCodec>(supported_audio_codecs,
+                                           filtered_codecs, codec, nullptr)) {
+          // Use the `found_codec` from `audio_codecs` because it has the
+          // correctly mapped payload type.
+          filtered_codecs.push_back(found_codec);
+        }
       }
+      codecs_cache->Add(media_description_options.direction, current_codecs,
+                        filtered_codecs);
     }
   }
   if (!session_options.vad_enabled) {
@@ -2341,6 +2427,7 @@ bool MediaSessionDescriptionFactory::AddVideoContentForOffer(
     const SessionDescription* current_description,
     const RtpHeaderExtensions& video_rtp_extensions,
     const VideoCodecs& video_codecs,
+    OfferCodecsCache<VideoCodec>* codecs_cache,
     StreamParamsVec* current_streams,
     SessionDescription* desc,
     IceCredentialsIterator* ice_credentials) const {
@@ -2360,45 +2447,56 @@ bool MediaSessionDescriptionFactory::AddVideoContentForOffer(
   } else {
     // Add the codecs from current content if it exists and is not rejected nor
     // recycled.
+    const VideoCodecs* current_codecs = nullptr;
     if (current_content && !current_content->rejected &&
         current_content->name == media_description_options.mid) {
       RTC_CHECK(IsMediaContentOfType(current_content, MEDIA_TYPE_VIDEO));
-      const VideoContentDescription* vcd =
-          current_content->media_description()->as_video();
-      for (const VideoCodec& codec : vcd->codecs()) {
-        if (FindMatchingCodec<VideoCodec>(vcd->codecs(), video_codecs, codec,
-                                          nullptr)) {
-          filtered_codecs.push_back(codec);
+      current_codecs =
+          &current_content->media_description()->as_video()->codecs();
+    }
+    const VideoCodecs* cached_codecs =
+        codecs_cache->Find(media_description_options.direction, current_codecs);
+    if (cached_codecs) {
+      filtered_codecs = *cached_codecs;
+    } else {
+      if (current_codecs) {
+        for (const VideoCodec& codec : *current_codecs) {
+          if (FindMatchingCodec<VideoCodec>(*current_codecs, video_codecs,
+                                            codec, nullptr)) {
+            filtered_codecs.push_back(codec);
+          }
         }
       }
-    }
-    // Add other supported video codecs.
-    VideoCodec found_codec;
-    for (const VideoCodec& codec : supported_video_codecs) {
-      if (FindMatchingCodec<VideoCodec>(supported_video_codecs, video_codecs,
-                                        codec, &found_codec) &&
-          !FindMatchingCodec<VideoCodec>(supported_video_codecs,
-                                         filtered_codecs, codec, nullptr)) {
-        // Use the `found_codec` from `video_codecs` because it has the
-        // correctly mapped payload type.
-        if (IsRtxCodec(codec)) {
-          // For RTX we might need to adjust the apt parameter if we got a
-          // remote offer without RTX for a codec for which we support RTX.
-          auto referenced_codec =
-              GetAssociatedCodecForRtx(supported_video_codecs, codec);
-          RTC_DCHECK(referenced_codec);
-
-          // Find the codec we should be referencing and point to it.
-          VideoCodec changed_referenced_codec;
-          if (FindMatchingCodec<VideoCodec>(supported_video_codecs,
-                                            filtered_codecs, *referenced_codec,
-                                            &changed_referenced_codec)) {
-            found_codec.SetParam(kCodecParamAssociatedPayloadType,
-                                 changed_referenced_codec.id);
+      // Add other supported video codecs.
+      VideoCodec found_codec;
+      for (const VideoCodec& codec : supported_video_codecs) {
+        if (FindMatchingCodec<VideoCodec>(supported_video_codecs, video_codecs,
+                                          codec, &found_codec) &&
+            !FindMatchingCodec<VideoCodec>(supported_video_codecs,
+                                           filtered_codecs, codec, nullptr)) {
+          // Use the `found_codec` from `video_codecs` because it has the
+          // correctly mapped payload type.
+          if (IsRtxCodec(codec)) {
+            // For RTX we might need to adjust the apt parameter if we got a
+            // remote offer without RTX for a codec for which we support RTX.
+            auto referenced_codec =
+                GetAssociatedCodecForRtx(supported_video_codecs, codec);
+            RTC_DCHECK(referenced_codec);
+
+            // Find the codec we should be referencing and point to it.
+            VideoCodec changed_referenced_codec;
+            if (FindMatchingCodec<VideoCodec>(
+                    supported_video_codecs, filtered_codecs, *referenced_codec,
+                    &changed_referenced_codec)) {
+              found_codec.SetParam(kCodecParamAssociatedPayloadType,
+                                   changed_referenced_codec.id);
+            }
           }
+          filtered_codecs.push_back(found_codec);
         }
-        filtered_codecs.push_back(found_codec);
       }
+      codecs_cache->Add(media_description_options.direction, current_codecs,
+                        filtered_codecs);
     }
   }
 
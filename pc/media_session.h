@@ -181,6 +181,10 @@ class MediaSessionDescriptionFactory {
     RtpHeaderExtensions video;
   };
 
+  // Codecs of the m-sections of one offer, keyed by what they depend on.
+  template <class C>
+  class OfferCodecsCache;
+
   const AudioCodecs& GetAudioCodecsForOffer(
       const webrtc::RtpTransceiverDirection& direction) const;
   const AudioCodecs& GetAudioCodecsForAnswer(
@@ -234,6 +238,7 @@ class MediaSessionDescriptionFactory {
       const SessionDescription* current_description,
       const RtpHeaderExtensions& audio_rtp_extensions,
       const AudioCodecs& audio_codecs,
+      OfferCodecsCache<AudioCodec>* codecs_cache,
       StreamParamsVec* current_streams,
       SessionDescription* desc,
       IceCredentialsIterator* ice_credentials) const;
@@ -245,6 +250,7 @@ class MediaSessionDescriptionFactory {
       const SessionDescription* current_description,
       const RtpHeaderExtensions& video_rtp_extensions,
       const VideoCodecs& video_codecs,
+      OfferCodecsCache<VideoCodec>* codecs_cache,
       StreamParamsVec* current_streams,
       SessionDescription* desc,
       IceCredentialsIterator* ice_credentials) const;
@@ -1236,6 +1236,39 @@ TEST_F(MediaSessionDescriptionFactoryTest, TestCreateOfferContentOrder) {
   EXPECT_TRUE(IsMediaContentOfType(&offer3->contents()[2], MEDIA_TYPE_AUDIO));
 }
 
+// Verifies that m-sections that are alike get the same codecs, and that
+// m-sections with a different direction get their own, when the codecs of
+// many m-sections are filtered at once.
+TEST_F(MediaSessionDescriptionFactoryTest,
+       TestCreateOfferWithManySectionsFiltersCodecsPerDirection) {
+  f1_.set_audio_codecs(MAKE_VECTOR(kAudioCodecs1), MAKE_VECTOR(kAudioCodecs2));
+  MediaSessionOptions opts;
+  for (int i = 0; i < 10; ++i) {
+    AddMediaDescriptionOptions(MEDIA_TYPE_AUDIO, "audio" + rtc::ToString(i),
+                               i % 2 ? RtpTransceiverDirection::kRecvOnly
+                                     : RtpTransceiverDirection::kSendOnly,
+                               kActive, &opts);
+  }
+  std::unique_ptr<SessionDescription> offer1 = f1_.CreateOffer(opts, nullptr);
+  ASSERT_TRUE(offer1);
+  std::unique_ptr<SessionDescription> offer2 =
+      f1_.CreateOffer(opts, offer1.get());
+  ASSERT_TRUE(offer2);
+  ASSERT_EQ(10u, offer2->contents().size());
+
+  const std::vector<AudioCodec>& send_codecs =
+      offer1->contents()[0].media_description()->as_audio()->codecs();
+  const std::vector<AudioCodec>& recv_codecs =
+      offer1->contents()[1].media_description()->as_audio()->codecs();
+  EXPECT_NE(send_codecs, recv_codecs);
+  for (size_t i = 0; i < 10; ++i) {
+    EXPECT_EQ(i % 2 ? recv_codecs : send_codecs,
+              offer1->contents()[i].media_description()->as_audio()->codecs());
+    EXPECT_EQ(i % 2 ? recv_codecs : send_codecs,
+              offer2->contents()[i].media_description()->as_audio()->codecs());
+  }
+}
+
 // Create a typical audio answer, and ensure it matches what we expect.
 TEST_F(MediaSessionDescriptionFactoryTest, TestCreateAudioAnswer) {
   f1_.set_secure(SEC_ENABLED);
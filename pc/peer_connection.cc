@@ -339,6 +339,7 @@ bool PeerConnectionInterface::RTCConfiguration::operator==(
     webrtc::VpnPreference vpn_preference;
     std::vector<rtc::NetworkMask> vpn_list;
     PortAllocatorConfig port_allocator_config;
+    absl::optional<std::string> call_group;
   };
   static_assert(sizeof(stuff_being_tested_for_equality) == sizeof(*this),
                 "Did you add something to RTCConfiguration and forget to "
@@ -404,7 +405,8 @@ bool PeerConnectionInterface::RTCConfiguration::operator==(
          vpn_preference == o.vpn_preference && vpn_list == o.vpn_list &&
          port_allocator_config.min_port == o.port_allocator_config.min_port &&
          port_allocator_config.max_port == o.port_allocator_config.max_port &&
-         port_allocator_config.flags == o.port_allocator_config.flags;
+         port_allocator_config.flags == o.port_allocator_config.flags &&
+         call_group == o.call_group;
 }
 
 bool PeerConnectionInterface::RTCConfiguration::operator!=(
@@ -414,16 +416,24 @@ bool PeerConnectionInterface::RTCConfiguration::operator!=(
 
 RTCErrorOr<rtc::scoped_refptr<PeerConnection>> PeerConnection::Create(
     rtc::scoped_refptr<ConnectionContext> context,
+    const ConnectionContext::NetworkSlot& network_slot,
     const PeerConnectionFactoryInterface::Options& options,
     std::unique_ptr<RtcEventLog> event_log,
     std::unique_ptr<Call> call,
+    rtc::scoped_refptr<SharedCall> shared_call,
     const PeerConnectionInterface::RTCConfiguration& configuration,
     PeerConnectionDependencies dependencies) {
+  RTC_DCHECK(!call || !shared_call);
+  // Until the PeerConnection exists, failures must give back `network_slot`.
+  auto release_network_slot = [&context, thread = network_slot.thread] {
+    context->ReleaseNetworkSlot(thread);
+  };
   RTCError config_error = cricket::P2PTransportChannel::ValidateIceConfig(
       ParseIceConfig(configuration));
   if (!config_error.ok()) {
     RTC_LOG(LS_ERROR) << "Invalid ICE configuration: "
                       << config_error.message();
+    release_network_slot();
     return config_error;
   }
 
@@ -431,6 +441,7 @@ RTCErrorOr<rtc::scoped_refptr<PeerConnection>> PeerConnection::Create(
     RTC_LOG(LS_ERROR)
         << "PeerConnection initialized without a PortAllocator? "
            "This shouldn't happen if using PeerConnectionFactory.";
+    release_network_slot();
     return RTCError(
         RTCErrorType::INVALID_PARAMETER,
         "Attempt to create a PeerConnection without a PortAllocatorFactory");
@@ -440,6 +451,7 @@ RTCErrorOr<rtc::scoped_refptr<PeerConnection>> PeerConnection::Create(
     // TODO(deadbeef): Why do we do this?
     RTC_LOG(LS_ERROR) << "PeerConnection initialized without a "
                          "PeerConnectionObserver";
+    release_network_slot();
     return RTCError(RTCErrorType::INVALID_PARAMETER,
                     "Attempt to create a PeerConnection without an observer");
   }
@@ -458,6 +470,7 @@ RTCErrorOr<rtc::scoped_refptr<PeerConnection>> PeerConnection::Create(
       dependencies.async_resolver_factory) {
     RTC_LOG(LS_ERROR)
         << "Attempt to set both old and new type of DNS resolver factory";
+    release_network_slot();
     return RTCError(RTCErrorType::INVALID_PARAMETER,
                     "Both old and new type of DNS resolver given");
   }
@@ -473,8 +486,8 @@ RTCErrorOr<rtc::scoped_refptr<PeerConnection>> PeerConnection::Create(
 
   // The PeerConnection constructor consumes some, but not all, dependencies.
   auto pc = rtc::make_ref_counted<PeerConnection>(
-      context, options, is_unified_plan, std::move(event_log), std::move(call),
-      dependencies, dtls_enabled);
+      context, network_slot, options, is_unified_plan, std::move(event_log),
+      std::move(call), std::move(shared_call), dependencies, dtls_enabled);
   RTCError init_error = pc->Initialize(configuration, std::move(dependencies));
   if (!init_error.ok()) {
     RTC_LOG(LS_ERROR) << "PeerConnection initialization failed";
@@ -485,13 +498,17 @@ RTCErrorOr<rtc::scoped_refptr<PeerConnection>> PeerConnection::Create(
 
 PeerConnection::PeerConnection(
     rtc::scoped_refptr<ConnectionContext> context,
+    const ConnectionContext::NetworkSlot& network_slot,
     const PeerConnectionFactoryInterface::Options& options,
     bool is_unified_plan,
     std::unique_ptr<RtcEventLog> event_log,
     std::unique_ptr<Call> call,
+    rtc::scoped_refptr<SharedCall> shared_call,
     PeerConnectionDependencies& dependencies,
     bool dtls_enabled)
     : context_(context),
+      network_thread_(network_slot.thread),
+      sctp_factory_(network_slot.sctp_factory),
       options_(options),
       observer_(dependencies.observer),
       is_unified_plan_(is_unified_plan),
@@ -503,7 +520,15 @@ PeerConnection::PeerConnection(
       ice_transport_factory_(std::move(dependencies.ice_transport_factory)),
       tls_cert_verifier_(std::move(dependencies.tls_cert_verifier)),
       call_(std::move(call)),
-      call_ptr_(call_.get()),
+      shared_call_(std::move(shared_call)),
+      call_ptr_(call_         ? call_.get()
+                : shared_call_ ? shared_call_->call()
+                               : nullptr),
+      // The flag attaches to the worker thread when it is first used there,
+      // which saves a blocking invoke per PeerConnection.
+      worker_thread_safety_(
+          call_ptr_ ? PendingTaskSafetyFlag::CreateDetached()
+                    : PendingTaskSafetyFlag::CreateDetachedInactive()),
       // RFC 3264: The numeric value of the session id and version in the
       // o line MUST be representable with a "64 bit signed integer".
       // Due to this constraint session id `session_id_` is max limited to
@@ -512,14 +537,7 @@ PeerConnection::PeerConnection(
       dtls_enabled_(dtls_enabled),
       data_channel_controller_(this),
       message_handler_(signaling_thread()),
-      weak_factory_(this) {
-  worker_thread()->Invoke<void>(RTC_FROM_HERE, [this] {
-    RTC_DCHECK_RUN_ON(worker_thread());
-    worker_thread_safety_ = PendingTaskSafetyFlag::Create();
-    if (!call_)
-      worker_thread_safety_->SetNotAlive();
-  });
-}
+      weak_factory_(this) {}
 
 PeerConnection::~PeerConnection() {
   TRACE_EVENT0("webrtc", "PeerConnection::~PeerConnection");
@@ -570,9 +588,13 @@ PeerConnection::~PeerConnection() {
     RTC_DCHECK_RUN_ON(worker_thread());
     worker_thread_safety_->SetNotAlive();
     call_.reset();
+    // The shared call may be released last here.
+    shared_call_ = nullptr;
     // The event log must outlive call (and any other object that uses it).
     event_log_.reset();
   });
+
+  context_->ReleaseNetworkSlot(network_thread_);
 }
 
 RTCError PeerConnection::Initialize(
@@ -685,10 +707,12 @@ void PeerConnection::InitializeTransportController_n(
   config.enable_external_auth = true;
 #endif
   config.active_reset_srtp_params = configuration.active_reset_srtp_params;
+  config.srtp_crypto_pool = context_->srtp_crypto_pool();
+  config.dtls_handshake_pool = context_->dtls_handshake_pool();
 
   // DTLS has to be enabled to use SCTP.
   if (dtls_enabled_) {
-    config.sctp_factory = context_->sctp_transport_factory();
+    config.sctp_factory = sctp_factory_;
   }
 
   config.ice_transport_factory = ice_transport_factory_.get();
@@ -1245,31 +1269,26 @@ void PeerConnection::GetStats(
 }
 
 PeerConnectionInterface::SignalingState PeerConnection::signaling_state() {
-  RTC_DCHECK_RUN_ON(signaling_thread());
   return sdp_handler_->signaling_state();
 }
 
 PeerConnectionInterface::IceConnectionState
 PeerConnection::ice_connection_state() {
-  RTC_DCHECK_RUN_ON(signaling_thread());
   return ice_connection_state_;
 }
 
 PeerConnectionInterface::IceConnectionState
 PeerConnection::standardized_ice_connection_state() {
-  RTC_DCHECK_RUN_ON(signaling_thread());
   return standardized_ice_connection_state_;
 }
 
 PeerConnectionInterface::PeerConnectionState
 PeerConnection::peer_connection_state() {
-  RTC_DCHECK_RUN_ON(signaling_thread());
   return connection_state_;
 }
 
 PeerConnectionInterface::IceGatheringState
 PeerConnection::ice_gathering_state() {
-  RTC_DCHECK_RUN_ON(signaling_thread());
   return ice_gathering_state_;
 }
 
@@ -1604,8 +1623,8 @@ RTCError PeerConnection::SetBitrate(const BitrateSettings& bitrate) {
     }
   }
 
-  RTC_DCHECK(call_.get());
-  call_->SetClientBitratePreferences(bitrate);
+  RTC_DCHECK(worker_thread_safety_->alive());
+  call_ptr_->SetClientBitratePreferences(bitrate);
 
   return RTCError::OK();
 }
@@ -1640,11 +1659,11 @@ void PeerConnection::AddAdaptationResource(
     });
   }
   RTC_DCHECK_RUN_ON(worker_thread());
-  if (!call_) {
+  if (!worker_thread_safety_->alive()) {
     // The PeerConnection has been closed.
     return;
   }
-  call_->AddAdaptationResource(resource);
+  call_ptr_->AddAdaptationResource(resource);
 }
 
 bool PeerConnection::StartRtcEventLog(std::unique_ptr<RtcEventLogOutput> output,
@@ -2034,6 +2053,12 @@ PeerConnection::InitializePortAllocator_n(
     RTC_LOG(LS_INFO) << "Disable candidates on link-local network interfaces.";
   }
 
+  if (absl::StartsWith(context_->trials().Lookup("WebRTC-IceFastStart"),
+                       "Enabled")) {
+    port_allocator_flags |= cricket::PORTALLOCATOR_ENABLE_FAST_START;
+    RTC_LOG(LS_INFO) << "Gather all candidates on preferred networks at once.";
+  }
+
   port_allocator_->set_flags(port_allocator_flags);
   // No step delay is used while allocating ports.
   port_allocator_->set_step_delay(cricket::kMinimumStepDelay);
@@ -2389,8 +2414,8 @@ Call::Stats PeerConnection::GetCallStats() {
   }
   RTC_DCHECK_RUN_ON(worker_thread());
   rtc::Thread::ScopedDisallowBlockingCalls no_blocking_calls;
-  if (call_) {
-    return call_->GetStats();
+  if (worker_thread_safety_->alive()) {
+    return call_ptr_->GetStats();
   } else {
     return Call::Stats();
   }
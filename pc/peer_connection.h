@@ -13,6 +13,7 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <functional>
 #include <map>
 #include <memory>
@@ -81,6 +82,7 @@
 #include "pc/sctp_transport.h"
 #include "pc/sdp_offer_answer.h"
 #include "pc/session_description.h"
+#include "pc/shared_call.h"
 #include "pc/stats_collector.h"
 #include "pc/stream_collection.h"
 #include "pc/transceiver_list.h"
@@ -125,11 +127,16 @@ class PeerConnection : public PeerConnectionInternal,
   //
   // Note that the function takes ownership of dependencies, and will
   // either use them or release them, whether it succeeds or fails.
+  // `network_slot` must have been acquired from `context`. The PeerConnection
+  // releases it when destroyed, or before returning if creation fails.
+  // At most one of `call` and `shared_call` is set.
   static RTCErrorOr<rtc::scoped_refptr<PeerConnection>> Create(
       rtc::scoped_refptr<ConnectionContext> context,
+      const ConnectionContext::NetworkSlot& network_slot,
       const PeerConnectionFactoryInterface::Options& options,
       std::unique_ptr<RtcEventLog> event_log,
       std::unique_ptr<Call> call,
+      rtc::scoped_refptr<SharedCall> shared_call,
       const PeerConnectionInterface::RTCConfiguration& configuration,
       PeerConnectionDependencies dependencies);
 
@@ -184,6 +191,8 @@ class PeerConnection : public PeerConnectionInternal,
       rtc::scoped_refptr<RTCStatsCollectorCallback> callback) override;
   void ClearStatsCache() override;
 
+  // The state getters may be called on any thread; see
+  // PeerConnectionProxy.
   SignalingState signaling_state() override;
 
   IceConnectionState ice_connection_state() override;
@@ -266,9 +275,7 @@ class PeerConnection : public PeerConnectionInternal,
   }
 
   // PeerConnectionInternal implementation.
-  rtc::Thread* network_thread() const final {
-    return context_->network_thread();
-  }
+  rtc::Thread* network_thread() const final { return network_thread_; }
   rtc::Thread* worker_thread() const final { return context_->worker_thread(); }
 
   std::string session_id() const override {
@@ -360,6 +367,10 @@ class PeerConnection : public PeerConnectionInternal,
   }
   cricket::PortAllocator* port_allocator() { return port_allocator_.get(); }
   Call* call_ptr() { return call_ptr_; }
+  // The SSRC generator of the call group, or null if not in one.
+  rtc::UniqueRandomIdGenerator* shared_ssrc_generator() {
+    return shared_call_ ? shared_call_->ssrc_generator() : nullptr;
+  }
 
   ConnectionContext* context() { return context_.get(); }
   const PeerConnectionFactoryInterface::Options* options() const {
@@ -446,10 +457,12 @@ class PeerConnection : public PeerConnectionInternal,
  protected:
   // Available for rtc::scoped_refptr creation
   PeerConnection(rtc::scoped_refptr<ConnectionContext> context,
+                 const ConnectionContext::NetworkSlot& network_slot,
                  const PeerConnectionFactoryInterface::Options& options,
                  bool is_unified_plan,
                  std::unique_ptr<RtcEventLog> event_log,
                  std::unique_ptr<Call> call,
+                 rtc::scoped_refptr<SharedCall> shared_call,
                  PeerConnectionDependencies& dependencies,
                  bool dtls_enabled);
 
@@ -601,6 +614,10 @@ class PeerConnection : public PeerConnectionInternal,
   InitializeRtcpCallback();
 
   const rtc::scoped_refptr<ConnectionContext> context_;
+  // The network thread this PeerConnection is pinned to, and the SCTP factory
+  // bound to it.
+  rtc::Thread* const network_thread_;
+  SctpTransportFactoryInterface* const sctp_factory_;
   const PeerConnectionFactoryInterface::Options options_;
   PeerConnectionObserver* observer_ RTC_GUARDED_BY(signaling_thread()) =
       nullptr;
@@ -614,15 +631,14 @@ class PeerConnection : public PeerConnectionInternal,
   // pointer (but not touch the object) from any thread.
   RtcEventLog* const event_log_ptr_ RTC_PT_GUARDED_BY(worker_thread());
 
-  IceConnectionState ice_connection_state_ RTC_GUARDED_BY(signaling_thread()) =
-      kIceConnectionNew;
-  PeerConnectionInterface::IceConnectionState standardized_ice_connection_state_
-      RTC_GUARDED_BY(signaling_thread()) = kIceConnectionNew;
-  PeerConnectionInterface::PeerConnectionState connection_state_
-      RTC_GUARDED_BY(signaling_thread()) = PeerConnectionState::kNew;
+  // The states are only written on the signaling thread, but are atomic so
+  // that their getters can be called on any thread without a thread hop.
+  std::atomic<IceConnectionState> ice_connection_state_{kIceConnectionNew};
+  std::atomic<IceConnectionState> standardized_ice_connection_state_{
+      kIceConnectionNew};
+  std::atomic<PeerConnectionState> connection_state_{PeerConnectionState::kNew};
 
-  IceGatheringState ice_gathering_state_ RTC_GUARDED_BY(signaling_thread()) =
-      kIceGatheringNew;
+  std::atomic<IceGatheringState> ice_gathering_state_{kIceGatheringNew};
   PeerConnectionInterface::RTCConfiguration configuration_
       RTC_GUARDED_BY(signaling_thread());
 
@@ -643,16 +659,21 @@ class PeerConnection : public PeerConnectionInternal,
   // The unique_ptr belongs to the worker thread, but the Call object manages
   // its own thread safety.
   std::unique_ptr<Call> call_ RTC_GUARDED_BY(worker_thread());
-  ScopedTaskSafety signaling_thread_safety_;
-  rtc::scoped_refptr<PendingTaskSafetyFlag> network_thread_safety_;
-  rtc::scoped_refptr<PendingTaskSafetyFlag> worker_thread_safety_;
+  // Set instead of `call_` if the PeerConnection is in a call group. Released
+  // on the worker thread when the PeerConnection is destroyed.
+  rtc::scoped_refptr<SharedCall> shared_call_;
 
-  // Points to the same thing as `call_`. Since it's const, we may read the
-  // pointer from any thread.
+  // Points to the same thing as `call_`, or to the Call of `shared_call_`.
+  // Since it's const, we may read the pointer from any thread.
   // TODO(bugs.webrtc.org/11992): Remove this workaround (and potential dangling
   // pointer).
   Call* const call_ptr_;
 
+  ScopedTaskSafety signaling_thread_safety_;
+  rtc::scoped_refptr<PendingTaskSafetyFlag> network_thread_safety_;
+  // Alive while the PeerConnection has a Call and is not closed.
+  rtc::scoped_refptr<PendingTaskSafetyFlag> worker_thread_safety_;
+
   std::unique_ptr<StatsCollector> stats_
       RTC_GUARDED_BY(signaling_thread());  // A pointer is passed to senders_
   rtc::scoped_refptr<RTCStatsCollector> stats_collector_
@@ -12,6 +12,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "absl/strings/match.h"
 #include "api/async_resolver_factory.h"
@@ -105,7 +106,14 @@ PeerConnectionFactory::PeerConnectionFactory(
       transport_controller_send_factory_(
           (dependencies->transport_controller_send_factory)
               ? std::move(dependencies->transport_controller_send_factory)
-              : std::make_unique<RtpTransportControllerSendFactory>()) {}
+              : std::make_unique<RtpTransportControllerSendFactory>()),
+      certificate_cache_(
+          dependencies->share_dtls_certificates
+              ? rtc::make_ref_counted<rtc::RTCCertificateCache>(
+                    signaling_thread(),
+                    std::make_unique<rtc::RTCCertificateGenerator>(
+                        signaling_thread(), network_thread()))
+              : nullptr) {}
 
 PeerConnectionFactory::PeerConnectionFactory(
     PeerConnectionFactoryDependencies dependencies)
@@ -114,6 +122,12 @@ PeerConnectionFactory::PeerConnectionFactory(
 
 PeerConnectionFactory::~PeerConnectionFactory() {
   RTC_DCHECK_RUN_ON(signaling_thread());
+  if (!shared_calls_.empty()) {
+    // A call of a group no PeerConnection uses anymore is destroyed here, and
+    // that must happen on the worker thread.
+    worker_thread()->Invoke<void>(RTC_FROM_HERE,
+                                  [this] { shared_calls_.clear(); });
+  }
 }
 
 void PeerConnectionFactory::SetOptions(const Options& options) {
@@ -203,20 +217,29 @@ PeerConnectionFactory::CreatePeerConnectionOrError(
          "the former is going away (see bugs.webrtc.org/7447";
 
   // Set internal defaults if optional dependencies are not set.
-  if (!dependencies.cert_generator) {
+  if (!dependencies.cert_generator && certificate_cache_) {
+    dependencies.cert_generator = certificate_cache_->CreateGenerator();
+  } else if (!dependencies.cert_generator) {
     dependencies.cert_generator =
         std::make_unique<rtc::RTCCertificateGenerator>(signaling_thread(),
                                                        network_thread());
   }
+  // Injected networking objects are bound to the default network thread, so
+  // only PeerConnections using the factory's own can go to a pooled thread.
+  const ConnectionContext::NetworkSlot& network_slot =
+      context_->AcquireNetworkSlot(
+          /*use_default_thread=*/dependencies.allocator ||
+          dependencies.packet_socket_factory ||
+          configuration.call_group.has_value());
   if (!dependencies.allocator) {
     rtc::PacketSocketFactory* packet_socket_factory;
     if (dependencies.packet_socket_factory)
       packet_socket_factory = dependencies.packet_socket_factory.get();
     else
-      packet_socket_factory = context_->default_socket_factory();
+      packet_socket_factory = network_slot.socket_factory;
 
     dependencies.allocator = std::make_unique<cricket::BasicPortAllocator>(
-        context_->default_network_manager(), packet_socket_factory,
+        network_slot.network_manager, packet_socket_factory,
         configuration.turn_customizer);
     dependencies.allocator->SetPortRange(
         configuration.port_allocator_config.min_port,
@@ -238,17 +261,48 @@ PeerConnectionFactory::CreatePeerConnectionOrError(
   dependencies.allocator->SetNetworkIgnoreMask(options().network_ignore_mask);
   dependencies.allocator->SetVpnList(configuration.vpn_list);
 
-  std::unique_ptr<RtcEventLog> event_log =
-      worker_thread()->Invoke<std::unique_ptr<RtcEventLog>>(
-          RTC_FROM_HERE, [this] { return CreateRtcEventLog_w(); });
+  // PeerConnections in a call group share the Call, which is created along
+  // with the first of them. Groups no PeerConnection uses anymore are dropped
+  // here, on the worker thread the calls must be destroyed on.
+  rtc::scoped_refptr<SharedCall> shared_call;
+  std::vector<rtc::scoped_refptr<SharedCall>> idle_shared_calls;
+  for (auto it = shared_calls_.begin(); it != shared_calls_.end();) {
+    if (configuration.call_group && it->first == *configuration.call_group) {
+      shared_call = it->second;
+      ++it;
+    } else if (it->second->HasOneRef()) {
+      idle_shared_calls.push_back(std::move(it->second));
+      it = shared_calls_.erase(it);
+    } else {
+      ++it;
+    }
+  }
 
-  std::unique_ptr<Call> call = worker_thread()->Invoke<std::unique_ptr<Call>>(
-      RTC_FROM_HERE,
-      [this, &event_log] { return CreateCall_w(event_log.get()); });
+  // The event log and the call are created in a single invoke, since the cost
+  // of the thread hops adds up when many PeerConnections are created at once.
+  rtc::Thread* const pc_network_thread = network_slot.thread;
+  const bool create_shared_call = configuration.call_group && !shared_call;
+  std::unique_ptr<RtcEventLog> event_log;
+  std::unique_ptr<Call> call;
+  worker_thread()->Invoke<void>(RTC_FROM_HERE, [&] {
+    idle_shared_calls.clear();
+    event_log = CreateRtcEventLog_w();
+    if (create_shared_call) {
+      std::unique_ptr<RtcEventLog> call_event_log = CreateRtcEventLog_w();
+      std::unique_ptr<Call> group_call =
+          CreateCall_w(call_event_log.get(), pc_network_thread);
+      shared_call = rtc::scoped_refptr<SharedCall>(
+          new SharedCall(std::move(call_event_log), std::move(group_call)));
+    } else if (!shared_call) {
+      call = CreateCall_w(event_log.get(), pc_network_thread);
+    }
+  });
+  if (create_shared_call)
+    shared_calls_[*configuration.call_group] = shared_call;
 
-  auto result = PeerConnection::Create(context_, options_, std::move(event_log),
-                                       std::move(call), configuration,
-                                       std::move(dependencies));
+  auto result = PeerConnection::Create(
+      context_, network_slot, options_, std::move(event_log), std::move(call),
+      std::move(shared_call), configuration, std::move(dependencies));
   if (!result.ok()) {
     return result.MoveError();
   }
@@ -259,7 +313,7 @@ PeerConnectionFactory::CreatePeerConnectionOrError(
   // worker_thread()).  All such methods have thread checks though, so the code
   // should still be clear (outside of macro expansion).
   rtc::scoped_refptr<PeerConnectionInterface> result_proxy =
-      PeerConnectionProxy::Create(signaling_thread(), network_thread(),
+      PeerConnectionProxy::Create(signaling_thread(), pc_network_thread,
                                   result.MoveValue());
   return result_proxy;
 }
@@ -304,10 +358,11 @@ std::unique_ptr<RtcEventLog> PeerConnectionFactory::CreateRtcEventLog_w() {
 }
 
 std::unique_ptr<Call> PeerConnectionFactory::CreateCall_w(
-    RtcEventLog* event_log) {
+    RtcEventLog* event_log,
+    rtc::Thread* network_thread) {
   RTC_DCHECK_RUN_ON(worker_thread());
 
-  webrtc::Call::Config call_config(event_log, network_thread());
+  webrtc::Call::Config call_config(event_log, network_thread);
   if (!channel_manager()->media_engine() || !context_->call_factory()) {
     return nullptr;
   }
@@ -15,6 +15,7 @@
 #include <stdint.h>
 #include <stdio.h>
 
+#include <map>
 #include <memory>
 #include <string>
 
@@ -41,6 +42,7 @@
 #include "p2p/base/port_allocator.h"
 #include "pc/channel_manager.h"
 #include "pc/connection_context.h"
+#include "pc/shared_call.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/rtc_certificate_generator.h"
 #include "rtc_base/thread.h"
@@ -137,7 +139,8 @@ class PeerConnectionFactory : public PeerConnectionFactoryInterface {
   }
 
   std::unique_ptr<RtcEventLog> CreateRtcEventLog_w();
-  std::unique_ptr<Call> CreateCall_w(RtcEventLog* event_log);
+  std::unique_ptr<Call> CreateCall_w(RtcEventLog* event_log,
+                                     rtc::Thread* network_thread);
 
   rtc::scoped_refptr<ConnectionContext> context_;
   PeerConnectionFactoryInterface::Options options_
@@ -152,6 +155,12 @@ class PeerConnectionFactory : public PeerConnectionFactoryInterface {
   std::unique_ptr<NetEqFactory> neteq_factory_;
   const std::unique_ptr<RtpTransportControllerSendFactoryInterface>
       transport_controller_send_factory_;
+  // Set if `share_dtls_certificates` was.
+  const rtc::scoped_refptr<rtc::RTCCertificateCache> certificate_cache_;
+  // The calls of the call groups, by `RTCConfiguration::call_group`. An entry
+  // is dropped once no PeerConnection uses it anymore.
+  std::map<std::string, rtc::scoped_refptr<SharedCall>> shared_calls_
+      RTC_GUARDED_BY(signaling_thread());
 };
 
 }  // namespace webrtc
@@ -142,11 +142,13 @@ PROXY_SECONDARY_METHOD1(rtc::scoped_refptr<DtlsTransportInterface>,
 // PeerConnectionFactory::CreatePeerConnectionOrError for more details.
 PROXY_SECONDARY_CONSTMETHOD0(rtc::scoped_refptr<SctpTransportInterface>,
                              GetSctpTransport)
-PROXY_METHOD0(SignalingState, signaling_state)
-PROXY_METHOD0(IceConnectionState, ice_connection_state)
-PROXY_METHOD0(IceConnectionState, standardized_ice_connection_state)
-PROXY_METHOD0(PeerConnectionState, peer_connection_state)
-PROXY_METHOD0(IceGatheringState, ice_gathering_state)
+// The state getters read atomics and do not need to hop to the signaling
+// thread.
+BYPASS_PROXY_METHOD0(SignalingState, signaling_state)
+BYPASS_PROXY_METHOD0(IceConnectionState, ice_connection_state)
+BYPASS_PROXY_METHOD0(IceConnectionState, standardized_ice_connection_state)
+BYPASS_PROXY_METHOD0(PeerConnectionState, peer_connection_state)
+BYPASS_PROXY_METHOD0(IceGatheringState, ice_gathering_state)
 PROXY_METHOD0(absl::optional<bool>, can_trickle_ice_candidates)
 PROXY_METHOD1(void, AddAdaptationResource, rtc::scoped_refptr<Resource>)
 PROXY_METHOD2(bool,
@@ -468,6 +468,17 @@ class ConstMethodCall : public QueuedTask {
     return c_->method();                     \
   }
 
+// For use with getters that the implementation makes safe to call on any
+// thread, e.g. by keeping the state in an atomic that is only written on the
+// primary thread. This saves the thread hop, and hence a context switch, for
+// callers that poll the state. Note that the returned value does not reflect
+// the operations that are still queued on the primary thread.
+#define BYPASS_PROXY_METHOD0(r, method) \
+  r method() override {                 \
+    TRACE_BOILERPLATE(method);          \
+    return c_->method();                \
+  }
+
 }  // namespace webrtc
 
 #endif  //  PC_PROXY_H_
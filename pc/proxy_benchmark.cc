@@ -0,0 +1,67 @@
+/*
+ *  Copyright 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <atomic>
+#include <memory>
+
+#include "api/scoped_refptr.h"
+#include "benchmark/benchmark.h"
+#include "pc/proxy.h"
+#include "rtc_base/ref_count.h"
+#include "rtc_base/ref_counted_object.h"
+#include "rtc_base/thread.h"
+
+namespace webrtc {
+
+class StateInterface : public rtc::RefCountInterface {
+ public:
+  virtual int state() = 0;
+  virtual int bypassed_state() = 0;
+
+ protected:
+  ~StateInterface() override = default;
+};
+
+class State : public StateInterface {
+ public:
+  int state() override { return state_; }
+  int bypassed_state() override { return state_; }
+
+ private:
+  std::atomic<int> state_{0};
+};
+
+BEGIN_PRIMARY_PROXY_MAP(State)
+PROXY_PRIMARY_THREAD_DESTRUCTOR()
+PROXY_METHOD0(int, state)
+BYPASS_PROXY_METHOD0(int, bypassed_state)
+END_PROXY_MAP(State)
+
+namespace {
+
+// Calls a getter of a proxy from a thread other than its signaling thread, as
+// an application polling the state of a PeerConnection does.
+template <int (StateInterface::*kGetter)()>
+void BM_ProxyGetter(benchmark::State& state) {
+  std::unique_ptr<rtc::Thread> signaling_thread = rtc::Thread::Create();
+  signaling_thread->Start();
+  rtc::scoped_refptr<StateInterface> proxy = StateProxy::Create(
+      signaling_thread.get(), rtc::make_ref_counted<State>());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(((*proxy).*kGetter)());
+  }
+  proxy = nullptr;
+}
+
+BENCHMARK_TEMPLATE(BM_ProxyGetter, &StateInterface::state);
+BENCHMARK_TEMPLATE(BM_ProxyGetter, &StateInterface::bypassed_state);
+
+}  // namespace
+}  // namespace webrtc
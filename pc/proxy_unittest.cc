@@ -34,6 +34,7 @@ class FakeInterface : public rtc::RefCountInterface {
   virtual std::string Method1(std::string s) = 0;
   virtual std::string ConstMethod1(std::string s) const = 0;
   virtual std::string Method2(std::string s1, std::string s2) = 0;
+  virtual std::string BypassMethod0() = 0;
 
  protected:
   virtual ~FakeInterface() {}
@@ -56,6 +57,7 @@ class Fake : public FakeInterface {
   MOCK_METHOD(std::string, ConstMethod1, (std::string), (const, override));
 
   MOCK_METHOD(std::string, Method2, (std::string, std::string), (override));
+  MOCK_METHOD(std::string, BypassMethod0, (), (override));
 
  protected:
   Fake() {}
@@ -71,6 +73,7 @@ PROXY_CONSTMETHOD0(std::string, ConstMethod0)
 PROXY_SECONDARY_METHOD1(std::string, Method1, std::string)
 PROXY_CONSTMETHOD1(std::string, ConstMethod1, std::string)
 PROXY_SECONDARY_METHOD2(std::string, Method2, std::string, std::string)
+BYPASS_PROXY_METHOD0(std::string, BypassMethod0)
 END_PROXY_MAP(Fake)
 
 // Preprocessor hack to get a proxy class a name different than FakeProxy.
@@ -84,6 +87,7 @@ PROXY_CONSTMETHOD0(std::string, ConstMethod0)
 PROXY_METHOD1(std::string, Method1, std::string)
 PROXY_CONSTMETHOD1(std::string, ConstMethod1, std::string)
 PROXY_METHOD2(std::string, Method2, std::string, std::string)
+BYPASS_PROXY_METHOD0(std::string, BypassMethod0)
 END_PROXY_MAP(Fake)
 #undef FakeProxy
 
@@ -173,6 +177,16 @@ TEST_F(SignalingProxyTest, Method2) {
   EXPECT_EQ("Method2", fake_signaling_proxy_->Method2(arg1, arg2));
 }
 
+TEST_F(SignalingProxyTest, BypassMethod0) {
+  EXPECT_CALL(*fake_, BypassMethod0())
+      .Times(Exactly(1))
+      .WillOnce(DoAll(InvokeWithoutArgs([this] {
+                        EXPECT_FALSE(signaling_thread_->IsCurrent());
+                      }),
+                      Return("BypassMethod0")));
+  EXPECT_EQ("BypassMethod0", fake_signaling_proxy_->BypassMethod0());
+}
+
 class ProxyTest : public ::testing::Test {
  public:
   // Checks that the functions are called on the right thread.
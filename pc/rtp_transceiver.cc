@@ -186,7 +186,11 @@ void RtpTransceiver::SetChannel(cricket::ChannelInterface* channel) {
   // Similarly, if the channel() accessor is limited to the network thread, that
   // helps with keeping the channel implementation requirements being met and
   // avoids synchronization for accessing the pointer or network related state.
-  channel_manager_->network_thread()->Invoke<void>(RTC_FROM_HERE, [&]() {
+  // Both channels, if set, belong to the same PeerConnection and therefore
+  // run on the same network thread.
+  rtc::Thread* network_thread =
+      channel ? channel->network_thread() : channel_->network_thread();
+  network_thread->Invoke<void>(RTC_FROM_HERE, [&]() {
     if (channel_) {
       channel_->SetFirstPacketReceivedCallback(nullptr);
     }
@@ -18,6 +18,7 @@
 #include "api/array_view.h"
 #include "media/base/rtp_utils.h"
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "rtc_base/async_packet_socket.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/logging.h"
@@ -261,7 +262,10 @@ void RtpTransport::OnReadPacket(rtc::PacketTransportInternal* transport,
     return;
   }
 
-  rtc::CopyOnWriteBuffer packet(data, len);
+  // Nothing looks at the packet after us, so take over the socket's read
+  // buffer if it has one; SRTP then decrypts it in place and the parsed
+  // RtpPacketReceived keeps referencing it, without any copies.
+  rtc::CopyOnWriteBuffer packet = rtc::TakeReadPacket(data, len);
   if (packet_type == cricket::RtpPacketType::kRtcp) {
     OnRtcpPacketReceived(std::move(packet), packet_time_us);
   } else {
@@ -14,6 +14,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "media/sctp/sctp_transport_internal.h"
 #include "pc/proxy.h"
@@ -69,6 +70,21 @@ END_PROXY_MAP(DataChannel)
 
 }  // namespace
 
+size_t SctpDataChannelProviderInterface::SendDataBatch(
+    int sid,
+    const SendDataParams& params,
+    rtc::ArrayView<const DataBuffer* const> buffers,
+    cricket::SendDataResult* result) {
+  SendDataParams send_params = params;
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    send_params.type =
+        buffers[i]->binary ? DataMessageType::kBinary : DataMessageType::kText;
+    if (!SendData(sid, send_params, buffers[i]->data, result))
+      return i;
+  }
+  return buffers.size();
+}
+
 InternalDataChannelInit::InternalDataChannelInit(const DataChannelInit& base)
     : DataChannelInit(base), open_handshake_role(kOpener) {
   // If the channel is externally negotiated, do not send the OPEN message.
@@ -333,7 +349,7 @@ void SctpDataChannel::SetSctpSid(int sid) {
   }
 
   const_cast<InternalDataChannelInit&>(config_).id = sid;
-  provider_->AddSctpDataStream(sid);
+  provider_->AddSctpDataStream(sid, priority());
 }
 
 void SctpDataChannel::OnClosingProcedureStartedRemotely(int sid) {
@@ -372,7 +388,7 @@ void SctpDataChannel::OnTransportChannelCreated() {
   // The sid may have been unassigned when provider_->ConnectDataChannel was
   // done. So always add the streams even if connected_to_provider_ is true.
   if (config_.id >= 0) {
-    provider_->AddSctpDataStream(config_.id);
+    provider_->AddSctpDataStream(config_.id, priority());
   }
 }
 
@@ -598,18 +614,38 @@ void SctpDataChannel::SendQueuedDataMessages() {
 
   RTC_DCHECK(state_ == kOpen || state_ == kClosing);
 
-  while (!queued_send_data_.Empty()) {
-    std::unique_ptr<DataBuffer> buffer = queued_send_data_.PopFront();
-    if (!SendDataMessage(*buffer, false)) {
-      // Return the message to the front of the queue if sending is aborted.
-      queued_send_data_.PushFront(std::move(buffer));
-      break;
-    }
+  // Send the whole queue as one batch, so that the provider can send it in a
+  // single hop rather than one per message.
+  std::vector<std::unique_ptr<DataBuffer>> queued;
+  while (!queued_send_data_.Empty())
+    queued.push_back(queued_send_data_.PopFront());
+  std::vector<const DataBuffer*> buffers;
+  buffers.reserve(queued.size());
+  for (const auto& buffer : queued)
+    buffers.push_back(buffer.get());
+
+  cricket::SendDataResult send_result = cricket::SDR_SUCCESS;
+  const size_t num_sent = provider_->SendDataBatch(
+      config_.id, DataMessageSendParams(), buffers, &send_result);
+  RTC_DCHECK_LE(num_sent, queued.size());
+
+  // Return the messages that were not sent to the queue before notifying the
+  // observer, which may send more.
+  for (size_t i = queued.size(); i > num_sent; --i)
+    queued_send_data_.PushFront(std::move(queued[i - 1]));
+  for (size_t i = 0; i < num_sent; ++i)
+    OnDataMessageSent(*queued[i]);
+
+  if (num_sent < queued.size() && send_result != cricket::SDR_BLOCK) {
+    RTC_LOG(LS_ERROR) << "Closing the DataChannel due to a failure to send "
+                         "data, send_result = "
+                      << send_result;
+    CloseAbruptlyWithError(
+        RTCError(RTCErrorType::NETWORK_ERROR, "Failure to send data"));
   }
 }
 
-bool SctpDataChannel::SendDataMessage(const DataBuffer& buffer,
-                                      bool queue_if_blocked) {
+SendDataParams SctpDataChannel::DataMessageSendParams() const {
   RTC_DCHECK_RUN_ON(signaling_thread_);
   SendDataParams send_params;
 
@@ -624,6 +660,13 @@ bool SctpDataChannel::SendDataMessage(const DataBuffer& buffer,
 
   send_params.max_rtx_count = config_.maxRetransmits;
   send_params.max_rtx_ms = config_.maxRetransmitTime;
+  return send_params;
+}
+
+bool SctpDataChannel::SendDataMessage(const DataBuffer& buffer,
+                                      bool queue_if_blocked) {
+  RTC_DCHECK_RUN_ON(signaling_thread_);
+  SendDataParams send_params = DataMessageSendParams();
   send_params.type =
       buffer.binary ? DataMessageType::kBinary : DataMessageType::kText;
 
@@ -632,12 +675,7 @@ bool SctpDataChannel::SendDataMessage(const DataBuffer& buffer,
       provider_->SendData(config_.id, send_params, buffer.data, &send_result);
 
   if (success) {
-    ++messages_sent_;
-    bytes_sent_ += buffer.size();
-
-    if (observer_ && buffer.size() > 0) {
-      observer_->OnBufferedAmountChange(buffer.size());
-    }
+    OnDataMessageSent(buffer);
     return true;
   }
 
@@ -657,6 +695,16 @@ bool SctpDataChannel::SendDataMessage(const DataBuffer& buffer,
   return false;
 }
 
+void SctpDataChannel::OnDataMessageSent(const DataBuffer& buffer) {
+  RTC_DCHECK_RUN_ON(signaling_thread_);
+  ++messages_sent_;
+  bytes_sent_ += buffer.size();
+
+  if (observer_ && buffer.size() > 0) {
+    observer_->OnBufferedAmountChange(buffer.size());
+  }
+}
+
 bool SctpDataChannel::QueueSendDataMessage(const DataBuffer& buffer) {
   RTC_DCHECK_RUN_ON(signaling_thread_);
   size_t start_buffered_amount = queued_send_data_.byte_count();
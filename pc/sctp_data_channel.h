@@ -18,6 +18,7 @@
 #include <string>
 
 #include "absl/types/optional.h"
+#include "api/array_view.h"
 #include "api/data_channel_interface.h"
 #include "api/priority.h"
 #include "api/rtc_error.h"
@@ -44,12 +45,22 @@ class SctpDataChannelProviderInterface {
                         const SendDataParams& params,
                         const rtc::CopyOnWriteBuffer& payload,
                         cricket::SendDataResult* result) = 0;
+  // Sends `buffers` in order, with `params` and the message type of each
+  // buffer, and stops at the first one that is not sent. Returns the number
+  // sent; `result` is set if not all were. The default implementation calls
+  // SendData for each, an implementation can send them in a single hop to
+  // the network thread.
+  virtual size_t SendDataBatch(int sid,
+                               const SendDataParams& params,
+                               rtc::ArrayView<const DataBuffer* const> buffers,
+                               cricket::SendDataResult* result);
   // Connects to the transport signals.
   virtual bool ConnectDataChannel(SctpDataChannel* data_channel) = 0;
   // Disconnects from the transport signals.
   virtual void DisconnectDataChannel(SctpDataChannel* data_channel) = 0;
-  // Adds the data channel SID to the transport for SCTP.
-  virtual void AddSctpDataStream(int sid) = 0;
+  // Adds the data channel SID to the transport for SCTP, with the priority of
+  // the data channel.
+  virtual void AddSctpDataStream(int sid, Priority priority) = 0;
   // Begins the closing procedure by sending an outgoing stream reset. Still
   // need to wait for callbacks to tell when this completes.
   virtual void RemoveSctpDataStream(int sid) = 0;
@@ -247,7 +258,11 @@ class SctpDataChannel : public DataChannelInterface,
   void DeliverQueuedReceivedData();
 
   void SendQueuedDataMessages();
+  // The parameters to send data messages with, except for the type.
+  SendDataParams DataMessageSendParams() const;
   bool SendDataMessage(const DataBuffer& buffer, bool queue_if_blocked);
+  // Updates the stats and notifies the observer of a sent data message.
+  void OnDataMessageSent(const DataBuffer& buffer);
   bool QueueSendDataMessage(const DataBuffer& buffer);
 
   void SendQueuedControlMessages();
@@ -35,6 +35,11 @@ RTCError SctpDataChannelTransport::OpenChannel(int channel_id) {
   return RTCError::OK();
 }
 
+void SctpDataChannelTransport::SetChannelPriority(int channel_id,
+                                                  Priority priority) {
+  sctp_transport_->SetStreamPriority(channel_id, priority);
+}
+
 RTCError SctpDataChannelTransport::SendData(
     int channel_id,
     const SendDataParams& params,
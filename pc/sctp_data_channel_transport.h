@@ -11,6 +11,7 @@
 #ifndef PC_SCTP_DATA_CHANNEL_TRANSPORT_H_
 #define PC_SCTP_DATA_CHANNEL_TRANSPORT_H_
 
+#include "api/priority.h"
 #include "api/rtc_error.h"
 #include "api/transport/data_channel_transport_interface.h"
 #include "media/base/media_channel.h"
@@ -28,6 +29,7 @@ class SctpDataChannelTransport : public DataChannelTransportInterface,
       cricket::SctpTransportInternal* sctp_transport);
 
   RTCError OpenChannel(int channel_id) override;
+  void SetChannelPriority(int channel_id, Priority priority) override;
   RTCError SendData(int channel_id,
                     const SendDataParams& params,
                     const rtc::CopyOnWriteBuffer& buffer) override;
@@ -953,6 +953,9 @@ SdpOfferAnswerHandler::SdpOfferAnswerHandler(PeerConnection* pc)
       operations_chain_(rtc::OperationsChain::Create()),
       rtcp_cname_(GenerateRtcpCname()),
       local_ice_credentials_to_replace_(new LocalIceCredentialsToReplace()),
+      ssrc_generator_ptr_(pc->shared_ssrc_generator()
+                              ? pc->shared_ssrc_generator()
+                              : &ssrc_generator_),
       weak_ptr_factory_(this) {
   operations_chain_->SetOnChainEmptyCallback(
       [this_weak_ptr = weak_ptr_factory_.GetWeakPtr()]() {
@@ -1008,7 +1011,7 @@ void SdpOfferAnswerHandler::Initialize(
       std::make_unique<WebRtcSessionDescriptionFactory>(
           signaling_thread(), channel_manager(), this, pc_->session_id(),
           pc_->dtls_enabled(), std::move(dependencies.cert_generator),
-          certificate, &ssrc_generator_,
+          certificate, ssrc_generator_ptr_,
           [this](const rtc::scoped_refptr<rtc::RTCCertificate>& certificate) {
             transport_controller()->SetLocalCertificate(certificate);
           });
@@ -2456,7 +2459,6 @@ SdpOfferAnswerHandler::pending_remote_description() const {
 
 PeerConnectionInterface::SignalingState SdpOfferAnswerHandler::signaling_state()
     const {
-  RTC_DCHECK_RUN_ON(signaling_thread());
   return signaling_state_;
 }
 
@@ -3164,6 +3166,12 @@ RTCError SdpOfferAnswerHandler::UpdateTransceiversAndDataChannels(
     }
   }
 
+  // The channels of the transceivers are created together once all media
+  // sections are associated, so that it takes one hop to the network and the
+  // worker thread each instead of several per channel.
+  std::vector<
+      rtc::scoped_refptr<RtpTransceiverProxyWithInternal<RtpTransceiver>>>
+      transceivers_without_channel;
   const ContentInfos& new_contents = new_session.description()->contents();
   for (size_t i = 0; i < new_contents.size(); ++i) {
     const cricket::ContentInfo& new_content = new_contents[i];
@@ -3200,7 +3208,8 @@ RTCError SdpOfferAnswerHandler::UpdateTransceiversAndDataChannels(
       }
       auto transceiver = transceiver_or_error.MoveValue();
       RTCError error =
-          UpdateTransceiverChannel(transceiver, new_content, bundle_group);
+          UpdateTransceiverChannel(transceiver, new_content, bundle_group,
+                                   &transceivers_without_channel);
       if (!error.ok()) {
         return error;
       }
@@ -3223,7 +3232,7 @@ RTCError SdpOfferAnswerHandler::UpdateTransceiversAndDataChannels(
     }
   }
 
-  return RTCError::OK();
+  return CreateTransceiverChannels(transceivers_without_channel);
 }
 
 RTCErrorOr<rtc::scoped_refptr<RtpTransceiverProxyWithInternal<RtpTransceiver>>>
@@ -3367,7 +3376,10 @@ RTCError SdpOfferAnswerHandler::UpdateTransceiverChannel(
     rtc::scoped_refptr<RtpTransceiverProxyWithInternal<RtpTransceiver>>
         transceiver,
     const cricket::ContentInfo& content,
-    const cricket::ContentGroup* bundle_group) {
+    const cricket::ContentGroup* bundle_group,
+    std::vector<
+        rtc::scoped_refptr<RtpTransceiverProxyWithInternal<RtpTransceiver>>>*
+        transceivers_without_channel) {
   TRACE_EVENT0("webrtc", "SdpOfferAnswerHandler::UpdateTransceiverChannel");
   RTC_DCHECK(IsUnifiedPlan());
   RTC_DCHECK(transceiver);
@@ -3377,23 +3389,81 @@ RTCError SdpOfferAnswerHandler::UpdateTransceiverChannel(
       transceiver->internal()->SetChannel(nullptr);
       DestroyChannelInterface(channel);
     }
-  } else {
-    if (!channel) {
-      if (transceiver->media_type() == cricket::MEDIA_TYPE_AUDIO) {
-        channel = CreateVoiceChannel(content.name);
+  } else if (!channel) {
+    RTC_DCHECK(transceiver->internal()->mid() == content.name);
+    transceivers_without_channel->push_back(transceiver);
+  }
+  return RTCError::OK();
+}
+
+RTCError SdpOfferAnswerHandler::CreateTransceiverChannels(
+    const std::vector<
+        rtc::scoped_refptr<RtpTransceiverProxyWithInternal<RtpTransceiver>>>&
+        transceivers) {
+  TRACE_EVENT0("webrtc", "SdpOfferAnswerHandler::CreateTransceiverChannels");
+  if (transceivers.empty()) {
+    return RTCError::OK();
+  }
+  std::vector<std::string> mids;
+  for (const auto& transceiver : transceivers) {
+    mids.push_back(*transceiver->internal()->mid());
+  }
+  if (!channel_manager()->media_engine()) {
+    LOG_AND_RETURN_ERROR(RTCErrorType::INTERNAL_ERROR,
+                         "Failed to create channel for mid=" + mids[0]);
+  }
+
+  std::vector<RtpTransportInternal*> rtp_transports;
+  pc_->network_thread()->Invoke<void>(RTC_FROM_HERE, [&] {
+    for (const std::string& mid : mids) {
+      rtp_transports.push_back(transport_controller()->GetRtpTransport(mid));
+      RTC_DCHECK(rtp_transports.back());
+    }
+  });
+
+  // Gathered on the signaling thread, where they are owned.
+  Call* const call = pc_->call_ptr();
+  const cricket::MediaConfig media_config = pc_->configuration()->media_config;
+  const bool srtp_required = pc_->SrtpRequired();
+  const CryptoOptions crypto_options = pc_->GetCryptoOptions();
+  const cricket::AudioOptions& audio_opts = audio_options();
+  const cricket::VideoOptions& video_opts = video_options();
+  VideoBitrateAllocatorFactory* const video_bitrate_allocator_factory =
+      video_bitrate_allocator_factory_.get();
+  std::vector<cricket::ChannelInterface*> channels;
+  pc_->worker_thread()->Invoke<void>(RTC_FROM_HERE, [&] {
+    for (size_t i = 0; i < transceivers.size(); ++i) {
+      if (transceivers[i]->media_type() == cricket::MEDIA_TYPE_AUDIO) {
+        channels.push_back(channel_manager()->CreateVoiceChannel(
+            call, media_config, rtp_transports[i], signaling_thread(),
+            pc_->network_thread(), mids[i], srtp_required, crypto_options,
+            ssrc_generator_ptr_, audio_opts));
       } else {
-        RTC_DCHECK_EQ(cricket::MEDIA_TYPE_VIDEO, transceiver->media_type());
-        channel = CreateVideoChannel(content.name);
+        RTC_DCHECK_EQ(cricket::MEDIA_TYPE_VIDEO,
+                      transceivers[i]->media_type());
+        channels.push_back(channel_manager()->CreateVideoChannel(
+            call, media_config, rtp_transports[i], signaling_thread(),
+            pc_->network_thread(), mids[i], srtp_required, crypto_options,
+            ssrc_generator_ptr_, video_opts, video_bitrate_allocator_factory));
       }
-      if (!channel) {
-        LOG_AND_RETURN_ERROR(
-            RTCErrorType::INTERNAL_ERROR,
-            "Failed to create channel for mid=" + content.name);
+    }
+  });
+
+  RTCError error = RTCError::OK();
+  for (size_t i = 0; i < transceivers.size(); ++i) {
+    if (!channels[i]) {
+      if (error.ok()) {
+        error = RTCError(RTCErrorType::INTERNAL_ERROR,
+                         "Failed to create channel for mid=" + mids[i]);
       }
-      transceiver->internal()->SetChannel(channel);
+      continue;
     }
+    transceivers[i]->internal()->SetChannel(channels[i]);
   }
-  return RTCError::OK();
+  if (!error.ok()) {
+    RTC_LOG(LS_ERROR) << error.message();
+  }
+  return error;
 }
 
 RTCError SdpOfferAnswerHandler::UpdateDataChannel(
@@ -4611,8 +4681,8 @@ cricket::VoiceChannel* SdpOfferAnswerHandler::CreateVoiceChannel(
   // be on the worker thread and use `call_` (update upstream code).
   return channel_manager()->CreateVoiceChannel(
       pc_->call_ptr(), pc_->configuration()->media_config, rtp_transport,
-      signaling_thread(), mid, pc_->SrtpRequired(), pc_->GetCryptoOptions(),
-      &ssrc_generator_, audio_options());
+      signaling_thread(), pc_->network_thread(), mid, pc_->SrtpRequired(),
+      pc_->GetCryptoOptions(), ssrc_generator_ptr_, audio_options());
 }
 
 // TODO(steveanton): Perhaps this should be managed by the RtpTransceiver.
@@ -4631,8 +4701,8 @@ cricket::VideoChannel* SdpOfferAnswerHandler::CreateVideoChannel(
   // be on the worker thread and use `call_` (update upstream code).
   return channel_manager()->CreateVideoChannel(
       pc_->call_ptr(), pc_->configuration()->media_config, rtp_transport,
-      signaling_thread(), mid, pc_->SrtpRequired(), pc_->GetCryptoOptions(),
-      &ssrc_generator_, video_options(),
+      signaling_thread(), pc_->network_thread(), mid, pc_->SrtpRequired(),
+      pc_->GetCryptoOptions(), ssrc_generator_ptr_, video_options(),
       video_bitrate_allocator_factory_.get());
 }
 
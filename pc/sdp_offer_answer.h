@@ -14,6 +14,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <atomic>
 #include <functional>
 #include <map>
 #include <memory>
@@ -114,6 +115,7 @@ class SdpOfferAnswerHandler : public SdpStateProvider,
   void PrepareForShutdown();
 
   // Implementation of SdpStateProvider
+  // `signaling_state()` may be called on any thread.
   PeerConnectionInterface::SignalingState signaling_state() const override;
 
   const SessionDescriptionInterface* local_description() const override;
@@ -329,13 +331,24 @@ class SdpOfferAnswerHandler : public SdpStateProvider,
       const RtpTransceiver* transceiver,
       const SessionDescriptionInterface* sdesc) const;
 
-  // Either creates or destroys the transceiver's BaseChannel according to the
-  // given media section.
+  // Either destroys the transceiver's BaseChannel or, if it needs one, adds
+  // the transceiver to `transceivers_without_channel` according to the given
+  // media section.
   RTCError UpdateTransceiverChannel(
       rtc::scoped_refptr<RtpTransceiverProxyWithInternal<RtpTransceiver>>
           transceiver,
       const cricket::ContentInfo& content,
-      const cricket::ContentGroup* bundle_group) RTC_RUN_ON(signaling_thread());
+      const cricket::ContentGroup* bundle_group,
+      std::vector<
+          rtc::scoped_refptr<RtpTransceiverProxyWithInternal<RtpTransceiver>>>*
+          transceivers_without_channel) RTC_RUN_ON(signaling_thread());
+  // Creates the BaseChannels of `transceivers`, whose mids must be set. Takes
+  // one hop to the network thread and one to the worker thread for all of
+  // them.
+  RTCError CreateTransceiverChannels(
+      const std::vector<
+          rtc::scoped_refptr<RtpTransceiverProxyWithInternal<RtpTransceiver>>>&
+          transceivers) RTC_RUN_ON(signaling_thread());
 
   // Either creates or destroys the local data channel according to the given
   // media section.
@@ -595,8 +608,10 @@ class SdpOfferAnswerHandler : public SdpStateProvider,
   std::unique_ptr<SessionDescriptionInterface> pending_remote_description_
       RTC_GUARDED_BY(signaling_thread());
 
-  PeerConnectionInterface::SignalingState signaling_state_
-      RTC_GUARDED_BY(signaling_thread()) = PeerConnectionInterface::kStable;
+  // Only written on the signaling thread; atomic so that `signaling_state()`
+  // can be called on any thread.
+  std::atomic<PeerConnectionInterface::SignalingState> signaling_state_{
+      PeerConnectionInterface::kStable};
 
   // Whether this peer is the caller. Set when the local description is applied.
   absl::optional<bool> is_caller_ RTC_GUARDED_BY(signaling_thread());
@@ -669,6 +684,9 @@ class SdpOfferAnswerHandler : public SdpStateProvider,
   // TODO(bugs.webrtc.org/12666): This variable is used from both the signaling
   // and worker threads. See if we can't restrict usage to a single thread.
   rtc::UniqueRandomIdGenerator ssrc_generator_;
+  // Either `ssrc_generator_` or the generator of the call group the
+  // PeerConnection is in, which outlives this object.
+  rtc::UniqueRandomIdGenerator* const ssrc_generator_ptr_;
 
   // A video bitrate allocator factory.
   // This can be injected using the PeerConnectionDependencies,
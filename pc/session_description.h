@@ -292,6 +292,8 @@ class MediaContentDescriptionImpl : public MediaContentDescription {
   // Codecs should be in preference order (most preferred codec first).
   virtual const std::vector<C>& codecs() const { return codecs_; }
   virtual void set_codecs(const std::vector<C>& codecs) { codecs_ = codecs; }
+  // For updating the codecs in place, e.g., while parsing a description.
+  std::vector<C>& mutable_codecs() { return codecs_; }
   bool has_codecs() const override { return !codecs_.empty(); }
   virtual bool HasCodec(int id) {
     bool found = false;
@@ -0,0 +1,52 @@
+/*
+ *  Copyright 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef PC_SHARED_CALL_H_
+#define PC_SHARED_CALL_H_
+
+#include <memory>
+#include <utility>
+
+#include "api/ref_counted_base.h"
+#include "api/rtc_event_log/rtc_event_log.h"
+#include "call/call.h"
+#include "rtc_base/unique_id_generator.h"
+
+namespace webrtc {
+
+// The Call shared by the PeerConnections of a call group; see
+// PeerConnectionInterface::RTCConfiguration::call_group. Each PeerConnection
+// holds a reference, as does the factory until the group is idle. The last
+// reference must be released on the worker thread, which the Call belongs to.
+class SharedCall final : public rtc::RefCountedNonVirtual<SharedCall> {
+ public:
+  SharedCall(std::unique_ptr<RtcEventLog> event_log, std::unique_ptr<Call> call)
+      : event_log_(std::move(event_log)), call_(std::move(call)) {}
+
+  // Null if the factory has no media engine.
+  Call* call() const { return call_.get(); }
+
+  // Generates the local SSRCs of all PeerConnections in the group, since the
+  // send streams of a Call must have distinct SSRCs.
+  rtc::UniqueRandomIdGenerator* ssrc_generator() { return &ssrc_generator_; }
+
+  // True if only the factory holds the call, i.e. the group is idle.
+  using rtc::RefCountedNonVirtual<SharedCall>::HasOneRef;
+
+ private:
+  // The event log must outlive the call.
+  const std::unique_ptr<RtcEventLog> event_log_;
+  const std::unique_ptr<Call> call_;
+  rtc::UniqueRandomIdGenerator ssrc_generator_;
+};
+
+}  // namespace webrtc
+
+#endif  // PC_SHARED_CALL_H_
@@ -17,6 +17,7 @@
 #include "modules/rtp_rtcp/source/rtp_util.h"
 #include "pc/external_hmac.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/ssl_stream_adapter.h"
 #include "rtc_base/string_encode.h"
 #include "rtc_base/time_utils.h"
@@ -82,7 +83,38 @@ bool SrtpSession::ProtectRtp(void* p, int in_len, int max_len, int* out_len) {
     RTC_LOG(LS_WARNING) << "Failed to protect SRTP packet: no SRTP Session";
     return false;
   }
+  return DoProtectRtp(p, in_len, max_len, out_len);
+}
+
+size_t SrtpSession::ProtectRtpPackets(
+    rtc::ArrayView<rtc::CopyOnWriteBuffer> packets) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  if (!session_) {
+    RTC_LOG(LS_WARNING) << "Failed to protect " << packets.size()
+                        << " SRTP packets: no SRTP Session";
+    for (rtc::CopyOnWriteBuffer& packet : packets) {
+      packet.Clear();
+    }
+    return 0;
+  }
+  size_t num_protected = 0;
+  for (rtc::CopyOnWriteBuffer& packet : packets) {
+    int in_len = rtc::checked_cast<int>(packet.size());
+    // Makes room for the auth tag; MutableData() below unshares the packet.
+    packet.EnsureCapacity(packet.size() + rtp_auth_tag_len_);
+    int out_len = 0;
+    if (DoProtectRtp(packet.MutableData(), in_len,
+                     rtc::checked_cast<int>(packet.capacity()), &out_len)) {
+      packet.SetSize(out_len);
+      ++num_protected;
+    } else {
+      packet.Clear();
+    }
+  }
+  return num_protected;
+}
 
+bool SrtpSession::DoProtectRtp(void* p, int in_len, int max_len, int* out_len) {
   // Note: the need_len differs from the libsrtp recommendatіon to ensure
   // SRTP_MAX_TRAILER_LEN bytes of free space after the data. WebRTC
   // never includes a MKI, therefore the amount of bytes added by the
@@ -158,7 +190,35 @@ bool SrtpSession::UnprotectRtp(void* p, int in_len, int* out_len) {
     RTC_LOG(LS_WARNING) << "Failed to unprotect SRTP packet: no SRTP Session";
     return false;
   }
+  return DoUnprotectRtp(p, in_len, out_len);
+}
+
+size_t SrtpSession::UnprotectRtpPackets(
+    rtc::ArrayView<rtc::CopyOnWriteBuffer> packets) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  if (!session_) {
+    RTC_LOG(LS_WARNING) << "Failed to unprotect " << packets.size()
+                        << " SRTP packets: no SRTP Session";
+    for (rtc::CopyOnWriteBuffer& packet : packets) {
+      packet.Clear();
+    }
+    return 0;
+  }
+  size_t num_unprotected = 0;
+  for (rtc::CopyOnWriteBuffer& packet : packets) {
+    int out_len = 0;
+    if (DoUnprotectRtp(packet.MutableData(),
+                       rtc::checked_cast<int>(packet.size()), &out_len)) {
+      packet.SetSize(out_len);
+      ++num_unprotected;
+    } else {
+      packet.Clear();
+    }
+  }
+  return num_unprotected;
+}
 
+bool SrtpSession::DoUnprotectRtp(void* p, int in_len, int* out_len) {
   *out_len = in_len;
   int err = srtp_unprotect(session_, p, out_len);
   if (err != srtp_err_status_ok) {
@@ -13,9 +13,11 @@
 
 #include <vector>
 
+#include "api/array_view.h"
 #include "api/scoped_refptr.h"
 #include "api/sequence_checker.h"
 #include "rtc_base/constructor_magic.h"
+#include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/synchronization/mutex.h"
 
 // Forward declaration to avoid pulling in libsrtp headers here
@@ -72,6 +74,17 @@ class SrtpSession {
   bool UnprotectRtp(void* data, int in_len, int* out_len);
   bool UnprotectRtcp(void* data, int in_len, int* out_len);
 
+  // Encrypts/decrypts a batch of RTP packets in-place, such as a burst from the
+  // pacer, checking the session once for the batch. Packets that fail are
+  // cleared. Returns the number of packets that succeeded.
+  size_t ProtectRtpPackets(rtc::ArrayView<rtc::CopyOnWriteBuffer> packets);
+  size_t UnprotectRtpPackets(rtc::ArrayView<rtc::CopyOnWriteBuffer> packets);
+
+  // Lets the session be used on another thread, e.g. when the packets of an
+  // SrtpTransport are moved to a crypto queue. The caller must make sure
+  // that the session isn't used on two threads at once.
+  void DetachFromThread() { thread_checker_.Detach(); }
+
   // Helper method to get authentication params.
   bool GetRtpAuthParams(uint8_t** key, int* key_len, int* tag_len);
 
@@ -106,6 +119,9 @@ class SrtpSession {
                  const uint8_t* key,
                  size_t len,
                  const std::vector<int>& extension_ids);
+  // ProtectRtp() and UnprotectRtp() once the session is checked.
+  bool DoProtectRtp(void* data, int in_len, int max_len, int* out_len);
+  bool DoUnprotectRtp(void* data, int in_len, int* out_len);
   // Returns send stream current packet index from srtp db.
   bool GetSendStreamPacketIndex(void* data, int in_len, int64_t* index);
 
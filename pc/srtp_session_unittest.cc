@@ -13,10 +13,12 @@
 #include <string.h>
 
 #include <string>
+#include <vector>
 
 #include "media/base/fake_rtp.h"
 #include "pc/test/srtp_test_util.h"
 #include "rtc_base/byte_order.h"
+#include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/ssl_stream_adapter.h"  // For rtc::SRTP_*
 #include "system_wrappers/include/metrics.h"
 #include "test/gmock.h"
@@ -141,6 +143,51 @@ TEST_F(SrtpSessionTest, TestGetSendStreamPacketIndex) {
   EXPECT_EQ(be64_index, index);
 }
 
+// Test that we can encrypt and decrypt a batch of RTP packets, and that the
+// packets that fail are cleared without failing the whole batch.
+TEST_F(SrtpSessionTest, TestProtectAndUnprotectRtpPackets) {
+  EXPECT_TRUE(s1_.SetSend(kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  EXPECT_TRUE(s2_.SetRecv(kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  std::vector<CopyOnWriteBuffer> plain;
+  for (uint16_t seqnum = 1; seqnum <= 3; ++seqnum) {
+    CopyOnWriteBuffer packet(kPcmuFrame, sizeof(kPcmuFrame));
+    SetBE16(packet.MutableData() + 2, seqnum);
+    plain.push_back(packet);
+  }
+  // The batch shares the buffers of `plain` until it is protected.
+  std::vector<CopyOnWriteBuffer> packets = plain;
+  EXPECT_EQ(3u, s1_.ProtectRtpPackets(packets));
+  for (size_t i = 0; i < packets.size(); ++i) {
+    EXPECT_EQ(sizeof(kPcmuFrame) + rtp_auth_tag_len(kCsAesCm128HmacSha1_80),
+              packets[i].size());
+    EXPECT_NE(0, memcmp(packets[i].data(), plain[i].data(), plain[i].size()));
+    // The payload of `plain` wasn't encrypted in place.
+    EXPECT_EQ(0, memcmp(plain[i].data() + 12, kPcmuFrame + 12,
+                        sizeof(kPcmuFrame) - 12));
+  }
+
+  packets[1].MutableData()[sizeof(kPcmuFrame)] ^= 1;
+  EXPECT_EQ(2u, s2_.UnprotectRtpPackets(packets));
+  EXPECT_EQ(plain[0], packets[0]);
+  EXPECT_EQ(0u, packets[1].size());
+  EXPECT_EQ(plain[2], packets[2]);
+  EXPECT_METRIC_THAT(
+      webrtc::metrics::Samples("WebRTC.PeerConnection.SrtpUnprotectError"),
+      ElementsAre(Pair(srtp_err_status_auth_fail, 1)));
+}
+
+// Test that batches fail as a whole without a session.
+TEST_F(SrtpSessionTest, TestRtpPacketsWithoutSession) {
+  std::vector<CopyOnWriteBuffer> packets(
+      2, CopyOnWriteBuffer(kPcmuFrame, sizeof(kPcmuFrame)));
+  EXPECT_EQ(0u, s1_.ProtectRtpPackets(packets));
+  EXPECT_EQ(0u, packets[0].size());
+  EXPECT_EQ(0u, packets[1].size());
+  EXPECT_EQ(0u, s2_.UnprotectRtpPackets(packets));
+}
+
 // Test that we fail to unprotect if someone tampers with the RTP/RTCP paylaods.
 TEST_F(SrtpSessionTest, TestTamperReject) {
   int out_len;
@@ -24,9 +24,11 @@
 #include "rtc_base/async_packet_socket.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/event.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/ssl_stream_adapter.h"
+#include "rtc_base/task_utils/to_queued_task.h"
 #include "rtc_base/third_party/base64/base64.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 #include "rtc_base/trace_event.h"
@@ -37,6 +39,10 @@ namespace webrtc {
 SrtpTransport::SrtpTransport(bool rtcp_mux_enabled)
     : RtpTransport(rtcp_mux_enabled) {}
 
+SrtpTransport::~SrtpTransport() {
+  ReclaimSessionsFromCryptoQueue();
+}
+
 RTCError SrtpTransport::SetSrtpSendKey(const cricket::CryptoParams& params) {
   if (send_params_) {
     LOG_AND_RETURN_ERROR(
@@ -125,6 +131,10 @@ bool SrtpTransport::SendRtpPacket(rtc::CopyOnWriteBuffer* packet,
         << "Failed to send the packet because SRTP transport is inactive.";
     return false;
   }
+  if (UseCryptoQueue()) {
+    ProtectOnCryptoQueue(/*rtcp=*/false, std::move(*packet), options, flags);
+    return true;
+  }
   rtc::PacketOptions updated_options = options;
   TRACE_EVENT0("webrtc", "SRTP Encode");
   bool res;
@@ -160,17 +170,49 @@ bool SrtpTransport::SendRtpPacket(rtc::CopyOnWriteBuffer* packet,
     }
   }
 #endif
-  if (!res) {
-    uint16_t seq_num = ParseRtpSequenceNumber(*packet);
-    uint32_t ssrc = ParseRtpSsrc(*packet);
-    RTC_LOG(LS_ERROR) << "Failed to protect RTP packet: size=" << len
-                      << ", seqnum=" << seq_num << ", SSRC=" << ssrc;
+  return OnRtpPacketProtected(res, len, packet, updated_options, flags);
+}
+
+bool SrtpTransport::SendRtpPackets(
+    rtc::ArrayView<rtc::CopyOnWriteBuffer> packets,
+    const rtc::PacketOptions& options,
+    int flags) {
+  if (!IsSrtpActive()) {
+    RTC_LOG(LS_ERROR)
+        << "Failed to send the packets because SRTP transport is inactive.";
     return false;
   }
-
-  // Update the length of the packet now that we've added the auth tag.
-  packet->SetSize(len);
-  return SendPacket(/*rtcp=*/false, packet, updated_options, flags);
+#if defined(ENABLE_EXTERNAL_AUTH)
+  // Each packet needs its own packet index for the external HMAC.
+  if (IsExternalAuthActive()) {
+    bool res = true;
+    for (rtc::CopyOnWriteBuffer& packet : packets) {
+      res &= SendRtpPacket(&packet, options, flags);
+    }
+    return res;
+  }
+#endif
+  if (UseCryptoQueue()) {
+    for (rtc::CopyOnWriteBuffer& packet : packets) {
+      ProtectOnCryptoQueue(/*rtcp=*/false, std::move(packet), options, flags);
+    }
+    return true;
+  }
+  TRACE_EVENT0("webrtc", "SRTP Encode");
+  size_t num_protected = send_session_->ProtectRtpPackets(packets);
+  if (num_protected != packets.size()) {
+    RTC_LOG(LS_ERROR) << "Failed to protect "
+                      << packets.size() - num_protected << " of "
+                      << packets.size() << " RTP packets";
+  }
+  bool res = num_protected == packets.size();
+  for (rtc::CopyOnWriteBuffer& packet : packets) {
+    // Packets that failed to be protected were cleared.
+    if (packet.size() > 0) {
+      res &= SendPacket(/*rtcp=*/false, &packet, options, flags);
+    }
+  }
+  return res;
 }
 
 bool SrtpTransport::SendRtcpPacket(rtc::CopyOnWriteBuffer* packet,
@@ -182,12 +224,44 @@ bool SrtpTransport::SendRtcpPacket(rtc::CopyOnWriteBuffer* packet,
     return false;
   }
 
+  if (UseCryptoQueue()) {
+    ProtectOnCryptoQueue(/*rtcp=*/true, std::move(*packet), options, flags);
+    return true;
+  }
   TRACE_EVENT0("webrtc", "SRTP Encode");
   uint8_t* data = packet->MutableData();
   int len = rtc::checked_cast<int>(packet->size());
-  if (!ProtectRtcp(data, len, static_cast<int>(packet->capacity()), &len)) {
+  bool res =
+      ProtectRtcp(data, len, static_cast<int>(packet->capacity()), &len);
+  return OnRtcpPacketProtected(res, len, packet, options, flags);
+}
+
+bool SrtpTransport::OnRtpPacketProtected(bool res,
+                                         int len,
+                                         rtc::CopyOnWriteBuffer* packet,
+                                         const rtc::PacketOptions& options,
+                                         int flags) {
+  if (!res) {
+    uint16_t seq_num = ParseRtpSequenceNumber(*packet);
+    uint32_t ssrc = ParseRtpSsrc(*packet);
+    RTC_LOG(LS_ERROR) << "Failed to protect RTP packet: size=" << len
+                      << ", seqnum=" << seq_num << ", SSRC=" << ssrc;
+    return false;
+  }
+
+  // Update the length of the packet now that we've added the auth tag.
+  packet->SetSize(len);
+  return SendPacket(/*rtcp=*/false, packet, options, flags);
+}
+
+bool SrtpTransport::OnRtcpPacketProtected(bool res,
+                                          int len,
+                                          rtc::CopyOnWriteBuffer* packet,
+                                          const rtc::PacketOptions& options,
+                                          int flags) {
+  if (!res) {
     int type = -1;
-    cricket::GetRtcpType(data, len, &type);
+    cricket::GetRtcpType(packet->data(), len, &type);
     RTC_LOG(LS_ERROR) << "Failed to protect RTCP packet: size=" << len
                       << ", type=" << type;
     return false;
@@ -206,9 +280,39 @@ void SrtpTransport::OnRtpPacketReceived(rtc::CopyOnWriteBuffer packet,
         << "Inactive SRTP transport received an RTP packet. Drop it.";
     return;
   }
+  if (UseCryptoQueue()) {
+    UnprotectOnCryptoQueue(/*rtcp=*/false, std::move(packet), packet_time_us);
+    return;
+  }
+  char* data = packet.MutableData<char>();
+  int len = rtc::checked_cast<int>(packet.size());
+  bool res = UnprotectRtp(data, len, &len);
+  OnRtpPacketUnprotected(res, len, std::move(packet), packet_time_us);
+}
+
+void SrtpTransport::OnRtcpPacketReceived(rtc::CopyOnWriteBuffer packet,
+                                         int64_t packet_time_us) {
+  TRACE_EVENT0("webrtc", "SrtpTransport::OnRtcpPacketReceived");
+  if (!IsSrtpActive()) {
+    RTC_LOG(LS_WARNING)
+        << "Inactive SRTP transport received an RTCP packet. Drop it.";
+    return;
+  }
+  if (UseCryptoQueue()) {
+    UnprotectOnCryptoQueue(/*rtcp=*/true, std::move(packet), packet_time_us);
+    return;
+  }
   char* data = packet.MutableData<char>();
   int len = rtc::checked_cast<int>(packet.size());
-  if (!UnprotectRtp(data, len, &len)) {
+  bool res = UnprotectRtcp(data, len, &len);
+  OnRtcpPacketUnprotected(res, len, std::move(packet), packet_time_us);
+}
+
+void SrtpTransport::OnRtpPacketUnprotected(bool res,
+                                           int len,
+                                           rtc::CopyOnWriteBuffer packet,
+                                           int64_t packet_time_us) {
+  if (!res) {
     // Limit the error logging to avoid excessive logs when there are lots of
     // bad packets.
     const int kFailureLogThrottleCount = 100;
@@ -226,19 +330,13 @@ void SrtpTransport::OnRtpPacketReceived(rtc::CopyOnWriteBuffer packet,
   DemuxPacket(std::move(packet), packet_time_us);
 }
 
-void SrtpTransport::OnRtcpPacketReceived(rtc::CopyOnWriteBuffer packet,
-                                         int64_t packet_time_us) {
-  TRACE_EVENT0("webrtc", "SrtpTransport::OnRtcpPacketReceived");
-  if (!IsSrtpActive()) {
-    RTC_LOG(LS_WARNING)
-        << "Inactive SRTP transport received an RTCP packet. Drop it.";
-    return;
-  }
-  char* data = packet.MutableData<char>();
-  int len = rtc::checked_cast<int>(packet.size());
-  if (!UnprotectRtcp(data, len, &len)) {
+void SrtpTransport::OnRtcpPacketUnprotected(bool res,
+                                            int len,
+                                            rtc::CopyOnWriteBuffer packet,
+                                            int64_t packet_time_us) {
+  if (!res) {
     int type = -1;
-    cricket::GetRtcpType(data, len, &type);
+    cricket::GetRtcpType(packet.data(), len, &type);
     RTC_LOG(LS_ERROR) << "Failed to unprotect RTCP packet: size=" << len
                       << ", type=" << type;
     return;
@@ -247,6 +345,111 @@ void SrtpTransport::OnRtcpPacketReceived(rtc::CopyOnWriteBuffer packet,
   SignalRtcpPacketReceived(&packet, packet_time_us);
 }
 
+void SrtpTransport::SetCryptoQueue(TaskQueueBase* crypto_queue) {
+  RTC_DCHECK(!crypto_queue_);
+  RTC_DCHECK(crypto_queue);
+  network_thread_ = TaskQueueBase::Current();
+  RTC_DCHECK(network_thread_);
+  crypto_queue_ = crypto_queue;
+}
+
+void SrtpTransport::ProtectOnCryptoQueue(bool rtcp,
+                                         rtc::CopyOnWriteBuffer packet,
+                                         const rtc::PacketOptions& options,
+                                         int flags) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  HandOverSessionsToCryptoQueue();
+  cricket::SrtpSession* session = rtcp && send_rtcp_session_
+                                      ? send_rtcp_session_.get()
+                                      : send_session_.get();
+  crypto_queue_->PostTask(ToQueuedTask(
+      [this, session, rtcp, packet = std::move(packet), options, flags,
+       network_thread = network_thread_,
+       safety = network_safety_.flag()]() mutable {
+        TRACE_EVENT0("webrtc", "SRTP Encode");
+        uint8_t* data = packet.MutableData();
+        int len = rtc::checked_cast<int>(packet.size());
+        int max_len = rtc::checked_cast<int>(packet.capacity());
+        bool res = rtcp ? session->ProtectRtcp(data, len, max_len, &len)
+                        : session->ProtectRtp(data, len, max_len, &len);
+        network_thread->PostTask(ToQueuedTask(
+            std::move(safety), [this, res, len, rtcp,
+                                packet = std::move(packet), options,
+                                flags]() mutable {
+              if (rtcp) {
+                OnRtcpPacketProtected(res, len, &packet, options, flags);
+              } else {
+                OnRtpPacketProtected(res, len, &packet, options, flags);
+              }
+            }));
+      }));
+}
+
+void SrtpTransport::UnprotectOnCryptoQueue(bool rtcp,
+                                           rtc::CopyOnWriteBuffer packet,
+                                           int64_t packet_time_us) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  HandOverSessionsToCryptoQueue();
+  cricket::SrtpSession* session = rtcp && recv_rtcp_session_
+                                      ? recv_rtcp_session_.get()
+                                      : recv_session_.get();
+  crypto_queue_->PostTask(ToQueuedTask(
+      [this, session, rtcp, packet = std::move(packet), packet_time_us,
+       network_thread = network_thread_,
+       safety = network_safety_.flag()]() mutable {
+        TRACE_EVENT0("webrtc", "SRTP Decode");
+        char* data = packet.MutableData<char>();
+        int len = rtc::checked_cast<int>(packet.size());
+        bool res = rtcp ? session->UnprotectRtcp(data, len, &len)
+                        : session->UnprotectRtp(data, len, &len);
+        network_thread->PostTask(ToQueuedTask(
+            std::move(safety), [this, res, len, rtcp,
+                                packet = std::move(packet),
+                                packet_time_us]() mutable {
+              if (rtcp) {
+                OnRtcpPacketUnprotected(res, len, std::move(packet),
+                                        packet_time_us);
+              } else {
+                OnRtpPacketUnprotected(res, len, std::move(packet),
+                                       packet_time_us);
+              }
+            }));
+      }));
+}
+
+void SrtpTransport::HandOverSessionsToCryptoQueue() {
+  if (sessions_on_crypto_queue_) {
+    return;
+  }
+  DetachSessionsFromThread();
+  sessions_on_crypto_queue_ = true;
+}
+
+void SrtpTransport::ReclaimSessionsFromCryptoQueue() {
+  if (!sessions_on_crypto_queue_) {
+    return;
+  }
+  RTC_DCHECK_RUN_ON(network_thread_);
+  // The crypto queue runs tasks in order, so once this one runs no packet
+  // uses the sessions anymore. Their results may still be queued on the
+  // network thread, which is fine since they don't use the sessions.
+  rtc::Event done;
+  crypto_queue_->PostTask(ToQueuedTask([&done] { done.Set(); }));
+  done.Wait(rtc::Event::kForever);
+  DetachSessionsFromThread();
+  sessions_on_crypto_queue_ = false;
+}
+
+void SrtpTransport::DetachSessionsFromThread() {
+  for (cricket::SrtpSession* session :
+       {send_session_.get(), recv_session_.get(), send_rtcp_session_.get(),
+        recv_rtcp_session_.get()}) {
+    if (session) {
+      session->DetachFromThread();
+    }
+  }
+}
+
 void SrtpTransport::OnNetworkRouteChanged(
     absl::optional<rtc::NetworkRoute> network_route) {
   // Only append the SRTP overhead when there is a selected network route.
@@ -277,6 +480,7 @@ bool SrtpTransport::SetRtpParams(int send_cs,
   // sessions and call "SetSend/SetRecv". Otherwise we should call
   // "UpdateSend"/"UpdateRecv" on the existing sessions, which will internally
   // call "srtp_update".
+  ReclaimSessionsFromCryptoQueue();
   bool new_sessions = false;
   if (!send_session_) {
     RTC_DCHECK(!recv_session_);
@@ -323,6 +527,7 @@ bool SrtpTransport::SetRtcpParams(int send_cs,
     RTC_LOG(LS_ERROR) << "Tried to set SRTCP Params when filter already active";
     return false;
   }
+  ReclaimSessionsFromCryptoQueue();
 
   send_rtcp_session_.reset(new cricket::SrtpSession());
   if (!send_rtcp_session_->SetSend(send_cs, send_key, send_key_len,
@@ -352,6 +557,7 @@ bool SrtpTransport::IsWritable(bool rtcp) const {
 }
 
 void SrtpTransport::ResetParams() {
+  ReclaimSessionsFromCryptoQueue();
   send_session_ = nullptr;
   recv_session_ = nullptr;
   send_rtcp_session_ = nullptr;
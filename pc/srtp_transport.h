@@ -19,8 +19,10 @@
 #include <vector>
 
 #include "absl/types/optional.h"
+#include "api/array_view.h"
 #include "api/crypto_params.h"
 #include "api/rtc_error.h"
+#include "api/task_queue/task_queue_base.h"
 #include "p2p/base/packet_transport_internal.h"
 #include "pc/rtp_transport.h"
 #include "pc/srtp_session.h"
@@ -28,6 +30,7 @@
 #include "rtc_base/buffer.h"
 #include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/network_route.h"
+#include "rtc_base/task_utils/pending_task_safety_flag.h"
 
 namespace webrtc {
 
@@ -38,7 +41,7 @@ class SrtpTransport : public RtpTransport {
  public:
   explicit SrtpTransport(bool rtcp_mux_enabled);
 
-  virtual ~SrtpTransport() = default;
+  ~SrtpTransport() override;
 
   // SrtpTransportInterface specific implementation.
   virtual RTCError SetSrtpSendKey(const cricket::CryptoParams& params);
@@ -48,6 +51,13 @@ class SrtpTransport : public RtpTransport {
                      const rtc::PacketOptions& options,
                      int flags) override;
 
+  // Protects and sends a burst of RTP packets, such as a frame from the
+  // pacer, with one call into the send session. Returns false if any packet
+  // failed to be protected or sent.
+  bool SendRtpPackets(rtc::ArrayView<rtc::CopyOnWriteBuffer> packets,
+                      const rtc::PacketOptions& options,
+                      int flags);
+
   bool SendRtcpPacket(rtc::CopyOnWriteBuffer* packet,
                       const rtc::PacketOptions& options,
                       int flags) override;
@@ -97,6 +107,15 @@ class SrtpTransport : public RtpTransport {
   // been set.
   bool IsExternalAuthActive() const;
 
+  // Moves the encryption and decryption of packets to `crypto_queue`, such
+  // as a thread of a CryptoThreadPool, which must outlive this transport.
+  // Packets are still sent and delivered on the network thread, in the order
+  // in which they reached the transport; SendRtpPacket() and
+  // SendRtcpPacket() then return once the packet is queued. Has no effect
+  // with external auth. Must be called on the network thread before any
+  // packet is sent or received.
+  void SetCryptoQueue(TaskQueueBase* crypto_queue);
+
   // Returns srtp overhead for rtp packets.
   bool GetSrtpOverhead(int* srtp_overhead) const;
 
@@ -144,6 +163,43 @@ class SrtpTransport : public RtpTransport {
   bool UnprotectRtcp(void* data, int in_len, int* out_len);
 
   bool MaybeSetKeyParams();
+
+  bool UseCryptoQueue() const {
+    return crypto_queue_ && !external_auth_enabled_;
+  }
+  // While packets are on the crypto queue, the SRTP sessions belong to it.
+  // These move them to the crypto queue and back to the network thread;
+  // the latter waits for the packets in flight.
+  void HandOverSessionsToCryptoQueue();
+  void ReclaimSessionsFromCryptoQueue();
+  void DetachSessionsFromThread();
+  void ProtectOnCryptoQueue(bool rtcp,
+                            rtc::CopyOnWriteBuffer packet,
+                            const rtc::PacketOptions& options,
+                            int flags);
+  void UnprotectOnCryptoQueue(bool rtcp,
+                              rtc::CopyOnWriteBuffer packet,
+                              int64_t packet_time_us);
+  // The rest of the send and receive paths, once a packet went through
+  // SRTP. `len` is its length after.
+  bool OnRtpPacketProtected(bool res,
+                            int len,
+                            rtc::CopyOnWriteBuffer* packet,
+                            const rtc::PacketOptions& options,
+                            int flags);
+  bool OnRtcpPacketProtected(bool res,
+                             int len,
+                             rtc::CopyOnWriteBuffer* packet,
+                             const rtc::PacketOptions& options,
+                             int flags);
+  void OnRtpPacketUnprotected(bool res,
+                              int len,
+                              rtc::CopyOnWriteBuffer packet,
+                              int64_t packet_time_us);
+  void OnRtcpPacketUnprotected(bool res,
+                               int len,
+                               rtc::CopyOnWriteBuffer packet,
+                               int64_t packet_time_us);
   bool ParseKeyParams(const std::string& key_params, uint8_t* key, size_t len);
 
   const std::string content_name_;
@@ -167,6 +223,11 @@ class SrtpTransport : public RtpTransport {
   int rtp_abs_sendtime_extn_id_ = -1;
 
   int decryption_failure_count_ = 0;
+
+  TaskQueueBase* network_thread_ = nullptr;
+  TaskQueueBase* crypto_queue_ = nullptr;
+  bool sessions_on_crypto_queue_ = false;
+  ScopedTaskSafetyDetached network_safety_;
 };
 
 }  // namespace webrtc
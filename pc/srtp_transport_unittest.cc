@@ -17,16 +17,21 @@
 #include <vector>
 
 #include "call/rtp_demuxer.h"
+#include "call/rtp_packet_sink_interface.h"
 #include "media/base/fake_rtp.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
 #include "p2p/base/dtls_transport_internal.h"
 #include "p2p/base/fake_packet_transport.h"
+#include "pc/crypto_thread_pool.h"
 #include "pc/test/rtp_transport_test_util.h"
 #include "pc/test/srtp_test_util.h"
 #include "rtc_base/async_packet_socket.h"
 #include "rtc_base/byte_order.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/gunit.h"
 #include "rtc_base/ssl_stream_adapter.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
+#include "rtc_base/thread.h"
 #include "test/gtest.h"
 
 using rtc::kSrtpAeadAes128Gcm;
@@ -43,6 +48,7 @@ static const uint8_t kTestKeyGcm256_1[] =
 static const uint8_t kTestKeyGcm256_2[] =
     "rqponmlkjihgfedcbaZYXWVUTSRQPONMLKJIHGFEDCBA";
 static const int kTestKeyGcm256Len = 44;  // 256 bits key + 96 bits salt.
+static const int kTimeoutMs = 1000;
 
 class SrtpTransportTest : public ::testing::Test, public sigslot::has_slots<> {
  protected:
@@ -416,4 +422,66 @@ TEST_F(SrtpTransportTest, TestSetParamsKeyTooShort) {
       rtc::kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen - 1, extension_ids));
 }
 
+class SequenceNumberSink : public RtpPacketSinkInterface {
+ public:
+  void OnRtpPacket(const RtpPacketReceived& packet) override {
+    sequence_numbers_.push_back(packet.SequenceNumber());
+  }
+  const std::vector<uint16_t>& sequence_numbers() const {
+    return sequence_numbers_;
+  }
+
+ private:
+  std::vector<uint16_t> sequence_numbers_;
+};
+
+// Test that packets are still delivered on the network thread and in order
+// when their crypto runs on a CryptoThreadPool, also across a key update.
+TEST_F(SrtpTransportTest, SendAndRecvPacketsOnCryptoQueue) {
+  rtc::AutoThread network_thread;
+  CryptoThreadPool crypto_pool(2, "srtp_crypto_");
+  srtp_transport1_->SetCryptoQueue(crypto_pool.GetQueue());
+  srtp_transport2_->SetCryptoQueue(crypto_pool.GetQueue());
+  SequenceNumberSink sink;
+  srtp_transport2_->UnregisterRtpDemuxerSink(&rtp_sink2_);
+  RtpDemuxerCriteria demuxer_criteria;
+  demuxer_criteria.payload_types = {0x00};
+  srtp_transport2_->RegisterRtpDemuxerSink(demuxer_criteria, &sink);
+
+  std::vector<int> extension_ids;
+  EXPECT_TRUE(srtp_transport1_->SetRtpParams(
+      rtc::kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen, extension_ids,
+      rtc::kSrtpAes128CmSha1_80, kTestKey2, kTestKeyLen, extension_ids));
+  EXPECT_TRUE(srtp_transport2_->SetRtpParams(
+      rtc::kSrtpAes128CmSha1_80, kTestKey2, kTestKeyLen, extension_ids,
+      rtc::kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen, extension_ids));
+
+  const size_t packet_size =
+      sizeof(kPcmuFrame) + rtc::rtp_auth_tag_len(rtc::kCsAesCm128HmacSha1_80);
+  std::vector<uint16_t> expected;
+  auto send_packets = [&](int count) {
+    for (int i = 0; i < count; ++i) {
+      rtc::CopyOnWriteBuffer packet(kPcmuFrame, sizeof(kPcmuFrame),
+                                    packet_size);
+      rtc::SetBE16(packet.MutableData() + 2, ++sequence_number_);
+      expected.push_back(sequence_number_);
+      EXPECT_TRUE(srtp_transport1_->SendRtpPacket(&packet, rtc::PacketOptions(),
+                                                  cricket::PF_SRTP_BYPASS));
+    }
+  };
+  send_packets(50);
+  EXPECT_EQ_WAIT(expected, sink.sequence_numbers(), kTimeoutMs);
+
+  // Updating the sessions waits for the packets on the crypto queue.
+  send_packets(50);
+  EXPECT_TRUE(srtp_transport1_->SetRtpParams(
+      rtc::kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen, extension_ids,
+      rtc::kSrtpAes128CmSha1_80, kTestKey2, kTestKeyLen, extension_ids));
+  send_packets(50);
+  EXPECT_EQ_WAIT(expected.size(), sink.sequence_numbers().size(), kTimeoutMs);
+  EXPECT_EQ(expected, sink.sequence_numbers());
+
+  srtp_transport2_->UnregisterRtpDemuxerSink(&sink);
+}
+
 }  // namespace webrtc
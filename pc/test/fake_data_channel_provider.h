@@ -47,6 +47,15 @@ class FakeDataChannelProvider
     return true;
   }
 
+  size_t SendDataBatch(int sid,
+                       const webrtc::SendDataParams& params,
+                       rtc::ArrayView<const webrtc::DataBuffer* const> buffers,
+                       cricket::SendDataResult* result) override {
+    ++send_data_batch_count_;
+    return SctpDataChannelProviderInterface::SendDataBatch(sid, params,
+                                                           buffers, result);
+  }
+
   bool ConnectDataChannel(webrtc::SctpDataChannel* data_channel) override {
     RTC_CHECK(connected_channels_.find(data_channel) ==
               connected_channels_.end());
@@ -65,7 +74,7 @@ class FakeDataChannelProvider
     connected_channels_.erase(data_channel);
   }
 
-  void AddSctpDataStream(int sid) override {
+  void AddSctpDataStream(int sid, webrtc::Priority priority) override {
     RTC_CHECK(sid >= 0);
     if (!transport_available_) {
       return;
@@ -130,6 +139,7 @@ class FakeDataChannelProvider
   void set_transport_error() { transport_error_ = true; }
 
   int last_sid() const { return last_sid_; }
+  int send_data_batch_count() const { return send_data_batch_count_; }
   const webrtc::SendDataParams& last_send_data_params() const {
     return last_send_data_params_;
   }
@@ -153,6 +163,7 @@ class FakeDataChannelProvider
   bool transport_available_;
   bool ready_to_send_;
   bool transport_error_;
+  int send_data_batch_count_ = 0;
   std::set<webrtc::SctpDataChannel*> connected_channels_;
   std::set<uint32_t> send_ssrcs_;
   std::set<uint32_t> recv_ssrcs_;
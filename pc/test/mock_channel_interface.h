@@ -15,6 +15,7 @@
 #include <vector>
 
 #include "pc/channel_interface.h"
+#include "rtc_base/thread.h"
 #include "test/gmock.h"
 
 namespace cricket {
@@ -24,8 +25,14 @@ namespace cricket {
 // implementation of BaseChannel.
 class MockChannelInterface : public cricket::ChannelInterface {
  public:
+  MockChannelInterface() {
+    ON_CALL(*this, network_thread())
+        .WillByDefault(::testing::Return(rtc::Thread::Current()));
+  }
+
   MOCK_METHOD(cricket::MediaType, media_type, (), (const, override));
   MOCK_METHOD(MediaChannel*, media_channel, (), (const, override));
+  MOCK_METHOD(rtc::Thread*, network_thread, (), (const, override));
   MOCK_METHOD(const std::string&, transport_name, (), (const, override));
   MOCK_METHOD(const std::string&, content_name, (), (const, override));
   MOCK_METHOD(void, Enable, (bool), (override));
@@ -25,6 +25,7 @@
 #include <vector>
 
 #include "absl/algorithm/container.h"
+#include "absl/strings/string_view.h"
 #include "api/candidate.h"
 #include "api/crypto_params.h"
 #include "api/jsep_ice_candidate.h"
@@ -585,9 +586,9 @@ static bool GetLineWithType(const std::string& message,
   return true;
 }
 
-static bool HasAttribute(const std::string& line,
-                         const std::string& attribute) {
-  if (line.compare(kLinePrefixLength, attribute.size(), attribute) == 0) {
+static bool HasAttribute(absl::string_view line, absl::string_view attribute) {
+  if (line.size() >= kLinePrefixLength &&
+      line.compare(kLinePrefixLength, attribute.size(), attribute) == 0) {
     // Make sure that the match is not only a partial match. If length of
     // strings doesn't match, the next character of the line must be ':' or ' '.
     // This function is also used for media descriptions (e.g., "m=audio 9..."),
@@ -2610,13 +2611,12 @@ static std::unique_ptr<C> ParseContentDescription(
   for (int pt : payload_types) {
     payload_type_preferences[pt] = preference--;
   }
-  std::vector<typename C::CodecType> codecs = media_desc->codecs();
   absl::c_sort(
-      codecs, [&payload_type_preferences](const typename C::CodecType& a,
-                                          const typename C::CodecType& b) {
+      media_desc->mutable_codecs(),
+      [&payload_type_preferences](const typename C::CodecType& a,
+                                  const typename C::CodecType& b) {
         return payload_type_preferences[a.id] > payload_type_preferences[b.id];
       });
-  media_desc->set_codecs(codecs);
   return media_desc;
 }
 
@@ -2853,39 +2853,19 @@ void AddFeedbackParameters(const cricket::FeedbackParams& feedback_params,
   }
 }
 
-// Gets the current codec setting associated with `payload_type`. If there
-// is no Codec associated with that payload type it returns an empty codec
-// with that payload type.
-template <class T>
-T GetCodecWithPayloadType(const std::vector<T>& codecs, int payload_type) {
-  const T* codec = FindCodecById(codecs, payload_type);
-  if (codec)
-    return *codec;
-  // Return empty codec with `payload_type`.
-  T ret_val;
-  ret_val.id = payload_type;
-  return ret_val;
-}
-
-// Updates or creates a new codec entry in the audio description.
+// Returns the codec of the description associated with `payload_type`, to be
+// updated in place. If there is no codec associated with that payload type, an
+// empty codec with that payload type is added and returned.
 template <class T, class U>
-void AddOrReplaceCodec(MediaContentDescription* content_desc, const U& codec) {
-  T* desc = static_cast<T*>(content_desc);
-  std::vector<U> codecs = desc->codecs();
-  bool found = false;
-  for (U& existing_codec : codecs) {
-    if (codec.id == existing_codec.id) {
-      // Overwrite existing codec with the new codec.
-      existing_codec = codec;
-      found = true;
-      break;
-    }
-  }
-  if (!found) {
-    desc->AddCodec(codec);
-    return;
+U* GetOrAddCodec(MediaContentDescription* content_desc, int payload_type) {
+  std::vector<U>& codecs = static_cast<T*>(content_desc)->mutable_codecs();
+  for (U& codec : codecs) {
+    if (codec.id == payload_type)
+      return &codec;
   }
-  desc->set_codecs(codecs);
+  codecs.emplace_back();
+  codecs.back().id = payload_type;
+  return &codecs.back();
 }
 
 // Adds or updates existing codec corresponding to `payload_type` according
@@ -2895,10 +2875,7 @@ void UpdateCodec(MediaContentDescription* content_desc,
                  int payload_type,
                  const cricket::CodecParameterMap& parameters) {
   // Codec might already have been populated (from rtpmap).
-  U new_codec = GetCodecWithPayloadType(static_cast<T*>(content_desc)->codecs(),
-                                        payload_type);
-  AddParameters(parameters, &new_codec);
-  AddOrReplaceCodec<T, U>(content_desc, new_codec);
+  AddParameters(parameters, GetOrAddCodec<T, U>(content_desc, payload_type));
 }
 
 // Adds or updates existing codec corresponding to `payload_type` according
@@ -2908,10 +2885,8 @@ void UpdateCodec(MediaContentDescription* content_desc,
                  int payload_type,
                  const cricket::FeedbackParam& feedback_param) {
   // Codec might already have been populated (from rtpmap).
-  U new_codec = GetCodecWithPayloadType(static_cast<T*>(content_desc)->codecs(),
-                                        payload_type);
-  AddFeedbackParameter(feedback_param, &new_codec);
-  AddOrReplaceCodec<T, U>(content_desc, new_codec);
+  AddFeedbackParameter(feedback_param,
+                       GetOrAddCodec<T, U>(content_desc, payload_type));
 }
 
 // Adds or updates existing video codec corresponding to `payload_type`
@@ -2925,18 +2900,16 @@ void UpdateVideoCodecPacketization(VideoContentDescription* video_desc,
   }
 
   // Codec might already have been populated (from rtpmap).
-  cricket::VideoCodec codec =
-      GetCodecWithPayloadType(video_desc->codecs(), payload_type);
-  codec.packetization = packetization;
-  AddOrReplaceCodec<VideoContentDescription, cricket::VideoCodec>(video_desc,
-                                                                  codec);
+  GetOrAddCodec<VideoContentDescription, cricket::VideoCodec>(video_desc,
+                                                              payload_type)
+      ->packetization = packetization;
 }
 
 template <class T>
 bool PopWildcardCodec(std::vector<T>* codecs, T* wildcard_codec) {
   for (auto iter = codecs->begin(); iter != codecs->end(); ++iter) {
     if (iter->id == kWildcardPayloadType) {
-      *wildcard_codec = *iter;
+      *wildcard_codec = std::move(*iter);
       codecs->erase(iter);
       return true;
     }
@@ -2946,7 +2919,7 @@ bool PopWildcardCodec(std::vector<T>* codecs, T* wildcard_codec) {
 
 template <class T>
 void UpdateFromWildcardCodecs(cricket::MediaContentDescriptionImpl<T>* desc) {
-  auto codecs = desc->codecs();
+  std::vector<T>& codecs = desc->mutable_codecs();
   T wildcard_codec;
   if (!PopWildcardCodec(&codecs, &wildcard_codec)) {
     return;
@@ -2954,7 +2927,6 @@ void UpdateFromWildcardCodecs(cricket::MediaContentDescriptionImpl<T>* desc) {
   for (auto& codec : codecs) {
     AddFeedbackParameters(wildcard_codec.feedback_params, &codec);
   }
-  desc->set_codecs(codecs);
 }
 
 void AddAudioAttribute(const std::string& name,
@@ -2963,11 +2935,9 @@ void AddAudioAttribute(const std::string& name,
   if (value.empty()) {
     return;
   }
-  std::vector<cricket::AudioCodec> codecs = audio_desc->codecs();
-  for (cricket::AudioCodec& codec : codecs) {
+  for (cricket::AudioCodec& codec : audio_desc->mutable_codecs()) {
     codec.params[name] = value;
   }
-  audio_desc->set_codecs(codecs);
 }
 
 bool ParseContent(const std::string& message,
@@ -3547,14 +3517,13 @@ void UpdateCodec(int payload_type,
                  AudioContentDescription* audio_desc) {
   // Codec may already be populated with (only) optional parameters
   // (from an fmtp).
-  cricket::AudioCodec codec =
-      GetCodecWithPayloadType(audio_desc->codecs(), payload_type);
-  codec.name = name;
-  codec.clockrate = clockrate;
-  codec.bitrate = bitrate;
-  codec.channels = channels;
-  AddOrReplaceCodec<AudioContentDescription, cricket::AudioCodec>(audio_desc,
-                                                                  codec);
+  cricket::AudioCodec* codec =
+      GetOrAddCodec<AudioContentDescription, cricket::AudioCodec>(audio_desc,
+                                                                  payload_type);
+  codec->name = name;
+  codec->clockrate = clockrate;
+  codec->bitrate = bitrate;
+  codec->channels = channels;
 }
 
 // Updates or creates a new codec entry in the video description according to
@@ -3564,11 +3533,9 @@ void UpdateCodec(int payload_type,
                  VideoContentDescription* video_desc) {
   // Codec may already be populated with (only) optional parameters
   // (from an fmtp).
-  cricket::VideoCodec codec =
-      GetCodecWithPayloadType(video_desc->codecs(), payload_type);
-  codec.name = name;
-  AddOrReplaceCodec<VideoContentDescription, cricket::VideoCodec>(video_desc,
-                                                                  codec);
+  GetOrAddCodec<VideoContentDescription, cricket::VideoCodec>(video_desc,
+                                                              payload_type)
+      ->name = name;
 }
 
 bool ParseRtpmapAttribute(const std::string& line,
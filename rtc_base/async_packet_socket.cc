@@ -10,8 +10,26 @@
 
 #include "rtc_base/async_packet_socket.h"
 
+#include <utility>
+
+#include "absl/base/attributes.h"
+#include "absl/base/config.h"
+#include "rtc_base/checks.h"
+
 namespace rtc {
 
+namespace {
+
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+ABSL_CONST_INIT thread_local ScopedReadPacketBuffer* current_read_packet =
+    nullptr;
+#else
+// Without thread_local nothing is published and TakeReadPacket() copies.
+ScopedReadPacketBuffer* const current_read_packet = nullptr;
+#endif
+
+}  // namespace
+
 PacketTimeUpdateParams::PacketTimeUpdateParams() = default;
 
 PacketTimeUpdateParams::PacketTimeUpdateParams(
@@ -28,6 +46,17 @@ AsyncPacketSocket::AsyncPacketSocket() = default;
 
 AsyncPacketSocket::~AsyncPacketSocket() = default;
 
+int AsyncPacketSocket::SendToBatch(ArrayView<const PacketToSend> packets,
+                                   const SocketAddress& addr) {
+  int sent = 0;
+  for (const PacketToSend& packet : packets) {
+    if (SendTo(packet.data, packet.size, addr, packet.options) < 0)
+      return sent > 0 ? sent : -1;
+    ++sent;
+  }
+  return sent;
+}
+
 void CopySocketInformationToPacketInfo(size_t packet_size_bytes,
                                        const AsyncPacketSocket& socket_from,
                                        bool is_connectionless,
@@ -36,4 +65,36 @@ void CopySocketInformationToPacketInfo(size_t packet_size_bytes,
   info->ip_overhead_bytes = socket_from.GetLocalAddress().ipaddr().overhead();
 }
 
+ScopedReadPacketBuffer::ScopedReadPacketBuffer(CopyOnWriteBuffer* buffer,
+                                               EcnMarking ecn)
+    : previous_(current_read_packet), buffer_(buffer), ecn_(ecn) {
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+  current_read_packet = this;
+#endif
+}
+
+ScopedReadPacketBuffer::~ScopedReadPacketBuffer() {
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+  RTC_DCHECK_EQ(current_read_packet, this);
+  current_read_packet = previous_;
+#endif
+}
+
+CopyOnWriteBuffer TakeReadPacket(const char* data, size_t size) {
+  if (current_read_packet) {
+    CopyOnWriteBuffer* buffer = current_read_packet->buffer_;
+    const char* begin = buffer->cdata<char>();
+    if (begin && data >= begin && data + size <= begin + buffer->size()) {
+      CopyOnWriteBuffer taken = std::move(*buffer);
+      return taken.Slice(static_cast<size_t>(data - begin), size);
+    }
+  }
+  return CopyOnWriteBuffer(data, size);
+}
+
+EcnMarking GetReadPacketEcn() {
+  return current_read_packet ? current_read_packet->ecn_
+                             : EcnMarking::kNotEct;
+}
+
 }  // namespace rtc
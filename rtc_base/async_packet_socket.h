@@ -13,8 +13,11 @@
 
 #include <vector>
 
+#include "api/array_view.h"
 #include "rtc_base/constructor_magic.h"
+#include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/dscp.h"
+#include "rtc_base/network/ecn_marking.h"
 #include "rtc_base/network/sent_packet.h"
 #include "rtc_base/socket.h"
 #include "rtc_base/system/rtc_export.h"
@@ -83,6 +86,20 @@ class RTC_EXPORT AsyncPacketSocket : public sigslot::has_slots<> {
                      const SocketAddress& addr,
                      const PacketOptions& options) = 0;
 
+  // A packet to be sent as part of a batch.
+  struct PacketToSend {
+    const void* data = nullptr;
+    size_t size = 0;
+    PacketOptions options;
+  };
+  // Sends `packets` to `addr`, letting the socket coalesce them into fewer
+  // system calls where supported. Returns the number of packets sent, which
+  // is less than `packets.size()` if the socket would block part way through,
+  // or a negative value if the first packet could not be sent. The default
+  // implementation calls SendTo for each packet.
+  virtual int SendToBatch(ArrayView<const PacketToSend> packets,
+                          const SocketAddress& addr);
+
   // Close the socket.
   virtual int Close() = 0;
 
@@ -155,6 +172,42 @@ void CopySocketInformationToPacketInfo(size_t packet_size_bytes,
                                        bool is_connectionless,
                                        rtc::PacketInfo* info);
 
+// Returns the `size` bytes at `data`, as passed to a SignalReadPacket slot,
+// in a CopyOnWriteBuffer. If they lie in the buffer published by the
+// innermost ScopedReadPacketBuffer on this thread, the result is a slice of
+// that buffer, which the scope gives up; otherwise the bytes are copied.
+// Since the caller may modify a taken buffer in place, only the last consumer
+// of a packet should call this.
+RTC_EXPORT CopyOnWriteBuffer TakeReadPacket(const char* data, size_t size);
+
+// Returns the ECN field of the packet published by the innermost
+// ScopedReadPacketBuffer on this thread, or kNotEct if there is none.
+RTC_EXPORT EcnMarking GetReadPacketEcn();
+
+// Publishes the buffer a packet was read into while SignalReadPacket is
+// emitted for it, so that the final consumer of the packet can take the
+// buffer over with TakeReadPacket() instead of copying the bytes, along with
+// the ECN field the packet was received with. Scopes nest; only the
+// innermost one on the current thread is visible.
+class RTC_EXPORT ScopedReadPacketBuffer {
+ public:
+  // `buffer` must outlive the scope; it is left empty if a consumer takes it.
+  explicit ScopedReadPacketBuffer(CopyOnWriteBuffer* buffer,
+                                  EcnMarking ecn = EcnMarking::kNotEct);
+  ~ScopedReadPacketBuffer();
+
+  ScopedReadPacketBuffer(const ScopedReadPacketBuffer&) = delete;
+  ScopedReadPacketBuffer& operator=(const ScopedReadPacketBuffer&) = delete;
+
+ private:
+  friend CopyOnWriteBuffer TakeReadPacket(const char* data, size_t size);
+  friend EcnMarking GetReadPacketEcn();
+
+  ScopedReadPacketBuffer* const previous_;
+  CopyOnWriteBuffer* const buffer_;
+  const EcnMarking ecn_;
+};
+
 }  // namespace rtc
 
 #endif  // RTC_BASE_ASYNC_PACKET_SOCKET_H_
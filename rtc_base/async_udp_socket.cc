@@ -12,6 +12,7 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <string>
 
 #include "rtc_base/checks.h"
@@ -23,6 +24,10 @@
 namespace rtc {
 
 static const int BUF_SIZE = 64 * 1024;
+// Per-datagram buffer size used for batched reads. Larger datagrams are
+// truncated, so batching is meant for sockets carrying MTU-sized packets.
+static const size_t kBatchedReadBufferSize = 2048;
+static const int kMaxRecvBatchSize = 64;
 
 AsyncUDPSocket* AsyncUDPSocket::Create(Socket* socket,
                                        const SocketAddress& bind_address) {
@@ -86,6 +91,29 @@ int AsyncUDPSocket::SendTo(const void* pv,
   return ret;
 }
 
+int AsyncUDPSocket::SendToBatch(ArrayView<const PacketToSend> packets,
+                                const SocketAddress& addr) {
+  send_buffers_.resize(packets.size());
+  for (size_t i = 0; i < packets.size(); ++i) {
+    send_buffers_[i].data = static_cast<const char*>(packets[i].data);
+    send_buffers_[i].length = packets[i].size;
+  }
+  int64_t send_time_ms = rtc::TimeMillis();
+  int ret = socket_->SendToBatch(send_buffers_, addr);
+  // Match SendTo, which signals every packet handed to the socket including
+  // the one that failed.
+  size_t signaled =
+      std::min(packets.size(), static_cast<size_t>(std::max(ret, 0)) + 1);
+  for (size_t i = 0; i < signaled; ++i) {
+    rtc::SentPacket sent_packet(packets[i].options.packet_id, send_time_ms,
+                                packets[i].options.info_signaled_after_sent);
+    CopySocketInformationToPacketInfo(packets[i].size, *this, true,
+                                      &sent_packet.info);
+    SignalSentPacket(this, sent_packet);
+  }
+  return ret;
+}
+
 int AsyncUDPSocket::Close() {
   return socket_->Close();
 }
@@ -95,10 +123,28 @@ AsyncUDPSocket::State AsyncUDPSocket::GetState() const {
 }
 
 int AsyncUDPSocket::GetOption(Socket::Option opt, int* value) {
+  if (opt == Socket::OPT_RECV_BATCH_SIZE) {
+    *value = std::max(1, static_cast<int>(batch_buffers_.size()));
+    return 0;
+  }
   return socket_->GetOption(opt, value);
 }
 
 int AsyncUDPSocket::SetOption(Socket::Option opt, int value) {
+  if (opt == Socket::OPT_RECV_BATCH_SIZE) {
+    if (value < 1 || value > kMaxRecvBatchSize)
+      return -1;
+    batch_buffers_.clear();
+    batch_packets_.clear();
+    if (value > 1) {
+      batch_buffers_.resize(value);
+      batch_packets_.resize(value);
+      for (int i = 0; i < value; ++i) {
+        ResetBatchBuffer(i);
+      }
+    }
+    return 0;
+  }
   return socket_->SetOption(opt, value);
 }
 
@@ -112,6 +158,10 @@ void AsyncUDPSocket::SetError(int error) {
 
 void AsyncUDPSocket::OnReadEvent(Socket* socket) {
   RTC_DCHECK(socket_.get() == socket);
+  if (!batch_buffers_.empty()) {
+    ReadBatch();
+    return;
+  }
 
   SocketAddress remote_addr;
   int64_t timestamp;
@@ -133,6 +183,46 @@ void AsyncUDPSocket::OnReadEvent(Socket* socket) {
                    (timestamp > -1 ? timestamp : TimeMicros()));
 }
 
+void AsyncUDPSocket::ReadBatch() {
+  int count = socket_->RecvFromBatch(batch_buffers_);
+  if (count < 0) {
+    SocketAddress local_addr = socket_->GetLocalAddress();
+    RTC_LOG(LS_INFO) << "AsyncUDPSocket[" << local_addr.ToSensitiveString()
+                     << "] batched receive failed with error "
+                     << socket_->GetError();
+    return;
+  }
+  int64_t now = -1;
+  for (int i = 0; i < count; ++i) {
+    const Socket::ReceiveBuffer& buffer = batch_buffers_[i];
+    int64_t timestamp = buffer.timestamp;
+    if (timestamp < 0) {
+      if (now < 0)
+        now = TimeMicros();
+      timestamp = now;
+    }
+    CopyOnWriteBuffer& packet = batch_packets_[i];
+    packet.SetSize(buffer.length);
+    {
+      ScopedReadPacketBuffer scope(&packet, buffer.ecn);
+      SignalReadPacket(this, buffer.data, buffer.length, buffer.source,
+                       timestamp);
+    }
+    if (packet.capacity() == 0) {
+      // Taken by the receiver; read the next packet into a fresh buffer.
+      ResetBatchBuffer(i);
+    }
+  }
+}
+
+void AsyncUDPSocket::ResetBatchBuffer(size_t index) {
+  // The read buffers fit the largest CopyOnWriteBuffer pool class, so
+  // replacing one that a receiver took over doesn't hit malloc.
+  batch_packets_[index] = CopyOnWriteBuffer(0, kBatchedReadBufferSize);
+  batch_buffers_[index].data = batch_packets_[index].MutableData<char>();
+  batch_buffers_[index].capacity = kBatchedReadBufferSize;
+}
+
 void AsyncUDPSocket::OnWriteEvent(Socket* socket) {
   SignalReadyToSend(this);
 }
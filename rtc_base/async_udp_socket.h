@@ -14,8 +14,10 @@
 #include <stddef.h>
 
 #include <memory>
+#include <vector>
 
 #include "rtc_base/async_packet_socket.h"
+#include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/socket.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/socket_factory.h"
@@ -47,6 +49,8 @@ class AsyncUDPSocket : public AsyncPacketSocket {
              size_t cb,
              const SocketAddress& addr,
              const rtc::PacketOptions& options) override;
+  int SendToBatch(ArrayView<const PacketToSend> packets,
+                  const SocketAddress& addr) override;
   int Close() override;
 
   State GetState() const override;
@@ -60,10 +64,22 @@ class AsyncUDPSocket : public AsyncPacketSocket {
   void OnReadEvent(Socket* socket);
   // Called when the underlying socket is ready to send.
   void OnWriteEvent(Socket* socket);
+  // Reads up to `batch_buffers_.size()` datagrams with one call.
+  void ReadBatch();
+  // Points batch_buffers_[index] at a new, empty batch_packets_[index].
+  void ResetBatchBuffer(size_t index);
 
   std::unique_ptr<Socket> socket_;
   char* buf_;
   size_t size_;
+  // Set through Socket::OPT_RECV_BATCH_SIZE. Empty unless batched reads have
+  // been enabled.
+  std::vector<Socket::ReceiveBuffer> batch_buffers_;
+  // Storage for `batch_buffers_`. Each one is published to the receivers of
+  // SignalReadPacket, which can take it over instead of copying the packet.
+  std::vector<CopyOnWriteBuffer> batch_packets_;
+  // Scratch space reused by SendToBatch.
+  std::vector<Socket::SendBuffer> send_buffers_;
 };
 
 }  // namespace rtc
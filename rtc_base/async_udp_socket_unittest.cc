@@ -10,11 +10,14 @@
 
 #include "rtc_base/async_udp_socket.h"
 
+#include <string.h>
+
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "rtc_base/gunit.h"
-#include "rtc_base/physical_socket_server.h"
+#include "rtc_base/thread.h"
 #include "rtc_base/virtual_socket_server.h"
 
 namespace rtc {
@@ -22,9 +25,8 @@ namespace rtc {
 class AsyncUdpSocketTest : public ::testing::Test, public sigslot::has_slots<> {
  public:
   AsyncUdpSocketTest()
-      : pss_(new rtc::PhysicalSocketServer),
-        vss_(new rtc::VirtualSocketServer(pss_.get())),
-        socket_(vss_->CreateSocket(SOCK_DGRAM)),
+      : vss_(new rtc::VirtualSocketServer()),
+        socket_(vss_->CreateSocket(AF_INET, SOCK_DGRAM)),
         udp_socket_(new AsyncUDPSocket(socket_)),
         ready_to_send_(false) {
     udp_socket_->SignalReadyToSend.connect(this,
@@ -34,17 +36,195 @@ class AsyncUdpSocketTest : public ::testing::Test, public sigslot::has_slots<> {
   void OnReadyToSend(rtc::AsyncPacketSocket* socket) { ready_to_send_ = true; }
 
  protected:
-  std::unique_ptr<PhysicalSocketServer> pss_;
   std::unique_ptr<VirtualSocketServer> vss_;
   Socket* socket_;
   std::unique_ptr<AsyncUDPSocket> udp_socket_;
   bool ready_to_send_;
 };
 
+class ReadPacketCollector : public sigslot::has_slots<> {
+ public:
+  ReadPacketCollector(AsyncPacketSocket* socket,
+                      std::vector<std::string>* received)
+      : received_(received) {
+    socket->SignalReadPacket.connect(this, &ReadPacketCollector::OnReadPacket);
+    socket->SignalSentPacket.connect(this, &ReadPacketCollector::OnSentPacket);
+  }
+
+  const std::vector<int64_t>& sent_packet_ids() const {
+    return sent_packet_ids_;
+  }
+
+ private:
+  void OnSentPacket(AsyncPacketSocket* socket, const SentPacket& packet) {
+    sent_packet_ids_.push_back(packet.packet_id);
+  }
+
+  void OnReadPacket(AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t size,
+                    const SocketAddress& remote_addr,
+                    const int64_t& packet_time_us) {
+    received_->emplace_back(data, size);
+  }
+
+  std::vector<std::string>* const received_;
+  std::vector<int64_t> sent_packet_ids_;
+};
+
+// Takes over every packet it receives with TakeReadPacket().
+class ReadPacketTaker : public sigslot::has_slots<> {
+ public:
+  explicit ReadPacketTaker(AsyncPacketSocket* socket) {
+    socket->SignalReadPacket.connect(this, &ReadPacketTaker::OnReadPacket);
+  }
+
+  const std::vector<CopyOnWriteBuffer>& packets() const { return packets_; }
+  // Number of packets taken without copying.
+  int zero_copy_count() const { return zero_copy_count_; }
+
+ private:
+  void OnReadPacket(AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t size,
+                    const SocketAddress& remote_addr,
+                    const int64_t& packet_time_us) {
+    packets_.push_back(TakeReadPacket(data, size));
+    if (packets_.back().cdata<char>() == data)
+      ++zero_copy_count_;
+  }
+
+  std::vector<CopyOnWriteBuffer> packets_;
+  int zero_copy_count_ = 0;
+};
+
 TEST_F(AsyncUdpSocketTest, OnWriteEvent) {
   EXPECT_FALSE(ready_to_send_);
   socket_->SignalWriteEvent(socket_);
   EXPECT_TRUE(ready_to_send_);
 }
 
+TEST_F(AsyncUdpSocketTest, RecvBatchSizeOption) {
+  int value = 0;
+  EXPECT_EQ(0, udp_socket_->GetOption(Socket::OPT_RECV_BATCH_SIZE, &value));
+  EXPECT_EQ(1, value);
+  EXPECT_EQ(0, udp_socket_->SetOption(Socket::OPT_RECV_BATCH_SIZE, 16));
+  EXPECT_EQ(0, udp_socket_->GetOption(Socket::OPT_RECV_BATCH_SIZE, &value));
+  EXPECT_EQ(16, value);
+  EXPECT_EQ(-1, udp_socket_->SetOption(Socket::OPT_RECV_BATCH_SIZE, 0));
+  EXPECT_EQ(-1, udp_socket_->SetOption(Socket::OPT_RECV_BATCH_SIZE, 1000));
+}
+
+TEST(AsyncUdpSocketBatchTest, BatchedReadDeliversEachPacket) {
+  VirtualSocketServer vss;
+  AutoSocketServerThread thread(&vss);
+  std::unique_ptr<AsyncUDPSocket> udp_socket(
+      AsyncUDPSocket::Create(&vss, SocketAddress("127.0.0.1", 0)));
+  ASSERT_TRUE(udp_socket);
+  ASSERT_EQ(0, udp_socket->SetOption(Socket::OPT_RECV_BATCH_SIZE, 4));
+  std::vector<std::string> received;
+  ReadPacketCollector collector(udp_socket.get(), &received);
+
+  SocketAddress address = udp_socket->GetLocalAddress();
+  PacketOptions options;
+  udp_socket->SendTo("abc", 3, address, options);
+  udp_socket->SendTo("de", 2, address, options);
+  EXPECT_TRUE_WAIT(received.size() == 2u, 1000);
+  EXPECT_EQ("abc", received[0]);
+  EXPECT_EQ("de", received[1]);
+}
+
+TEST(AsyncUdpSocketBatchTest, BatchedReadHandsOverReadBuffers) {
+  VirtualSocketServer vss;
+  AutoSocketServerThread thread(&vss);
+  std::unique_ptr<AsyncUDPSocket> udp_socket(
+      AsyncUDPSocket::Create(&vss, SocketAddress("127.0.0.1", 0)));
+  ASSERT_TRUE(udp_socket);
+  ASSERT_EQ(0, udp_socket->SetOption(Socket::OPT_RECV_BATCH_SIZE, 2));
+  ReadPacketTaker taker(udp_socket.get());
+
+  SocketAddress address = udp_socket->GetLocalAddress();
+  PacketOptions options;
+  const char* payloads[] = {"abc", "de", "fghi", "j"};
+  for (const char* payload : payloads) {
+    udp_socket->SendTo(payload, strlen(payload), address, options);
+  }
+  EXPECT_TRUE_WAIT(taker.packets().size() == 4u, 1000);
+  EXPECT_EQ(4, taker.zero_copy_count());
+  // Later reads go to fresh buffers and leave the taken ones alone.
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(CopyOnWriteBuffer(payloads[i], strlen(payloads[i])),
+              taker.packets()[i]);
+  }
+}
+
+TEST(AsyncUdpSocketBatchTest, UnbatchedReadCopiesTakenPackets) {
+  VirtualSocketServer vss;
+  AutoSocketServerThread thread(&vss);
+  std::unique_ptr<AsyncUDPSocket> udp_socket(
+      AsyncUDPSocket::Create(&vss, SocketAddress("127.0.0.1", 0)));
+  ASSERT_TRUE(udp_socket);
+  ReadPacketTaker taker(udp_socket.get());
+
+  udp_socket->SendTo("abc", 3, udp_socket->GetLocalAddress(),
+                     PacketOptions());
+  EXPECT_TRUE_WAIT(taker.packets().size() == 1u, 1000);
+  EXPECT_EQ(0, taker.zero_copy_count());
+  EXPECT_EQ(CopyOnWriteBuffer("abc", 3), taker.packets()[0]);
+}
+
+TEST(ScopedReadPacketBufferTest, TakesSliceOfPublishedBuffer) {
+  CopyOnWriteBuffer buffer("header+payload", 14);
+  const char* payload = buffer.cdata<char>() + 7;
+  {
+    ScopedReadPacketBuffer scope(&buffer);
+    CopyOnWriteBuffer taken = TakeReadPacket(payload, 7);
+    EXPECT_EQ(payload, taken.cdata<char>());
+    EXPECT_EQ(CopyOnWriteBuffer("payload", 7), taken);
+    EXPECT_EQ(0u, buffer.capacity());
+    // Once taken, the bytes are no longer published.
+    EXPECT_NE(payload, TakeReadPacket(payload, 7).cdata<char>());
+  }
+  // Bytes outside of a scope are always copied.
+  CopyOnWriteBuffer other("abc", 3);
+  CopyOnWriteBuffer copy = TakeReadPacket(other.cdata<char>(), 3);
+  EXPECT_NE(other.cdata(), copy.cdata());
+  EXPECT_EQ(other, copy);
+}
+
+TEST(ScopedReadPacketBufferTest, PublishesEcnOfInnermostScope) {
+  EXPECT_EQ(EcnMarking::kNotEct, GetReadPacketEcn());
+  CopyOnWriteBuffer outer_buffer("abc", 3);
+  ScopedReadPacketBuffer outer(&outer_buffer, EcnMarking::kEct1);
+  EXPECT_EQ(EcnMarking::kEct1, GetReadPacketEcn());
+  {
+    CopyOnWriteBuffer inner_buffer("de", 2);
+    ScopedReadPacketBuffer inner(&inner_buffer, EcnMarking::kCe);
+    EXPECT_EQ(EcnMarking::kCe, GetReadPacketEcn());
+  }
+  EXPECT_EQ(EcnMarking::kEct1, GetReadPacketEcn());
+}
+
+TEST(AsyncUdpSocketBatchTest, SendToBatchSignalsEachSentPacket) {
+  VirtualSocketServer vss;
+  AutoSocketServerThread thread(&vss);
+  std::unique_ptr<AsyncUDPSocket> udp_socket(
+      AsyncUDPSocket::Create(&vss, SocketAddress("127.0.0.1", 0)));
+  ASSERT_TRUE(udp_socket);
+  std::vector<std::string> received;
+  ReadPacketCollector collector(udp_socket.get(), &received);
+
+  AsyncPacketSocket::PacketToSend packets[3];
+  const char* payloads[] = {"a", "bc", "def"};
+  for (int i = 0; i < 3; ++i) {
+    packets[i].data = payloads[i];
+    packets[i].size = strlen(payloads[i]);
+    packets[i].options.packet_id = i + 10;
+  }
+  EXPECT_EQ(3, udp_socket->SendToBatch(packets, udp_socket->GetLocalAddress()));
+  EXPECT_EQ(std::vector<int64_t>({10, 11, 12}), collector.sent_packet_ids());
+  EXPECT_TRUE_WAIT(received.size() == 3u, 1000);
+  EXPECT_EQ("def", received[2]);
+}
+
 }  // namespace rtc
@@ -0,0 +1,117 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "rtc_base/containers/flat_map.h"
+
+namespace webrtc {
+namespace {
+
+// Per packet maps keyed by SSRC, and the number of SSRCs they typically hold:
+// - PacketRouter::send_modules_map_: media and RTX SSRCs of all send streams,
+//   2 to 32.
+// - RtpVideoSender::ssrc_to_rtp_module_: media SSRCs of a stream, 1 to 3.
+// - RtpTransportControllerSend::last_report_blocks_: remote SSRCs reporting,
+//   1 to 16.
+// - SendStatisticsProxy::update_times_ and encoded_frame_rate_trackers_:
+//   media SSRCs of a stream, 1 to 3.
+// SSRCs are random, so they are spread over the whole key space.
+std::vector<uint32_t> RandomSsrcs(int count) {
+  std::mt19937 random(count);
+  std::vector<uint32_t> ssrcs;
+  for (int i = 0; i < count; ++i)
+    ssrcs.push_back(random());
+  return ssrcs;
+}
+
+// Looks up the SSRC of each packet, in a round robin over the SSRCs.
+template <typename Map>
+void BM_LookupSsrc(benchmark::State& state) {
+  const std::vector<uint32_t> ssrcs = RandomSsrcs(state.range(0));
+  Map map;
+  for (uint32_t ssrc : ssrcs)
+    map[ssrc] = static_cast<int>(ssrc & 0xff);
+  size_t i = 0;
+  for (auto _ : state) {
+    auto it = map.find(ssrcs[i]);
+    benchmark::DoNotOptimize(it->second);
+    if (++i == ssrcs.size())
+      i = 0;
+  }
+}
+
+// Looks up an SSRC that isn't in the map, e.g. a packet of a removed stream.
+template <typename Map>
+void BM_LookupMissingSsrc(benchmark::State& state) {
+  const std::vector<uint32_t> ssrcs = RandomSsrcs(state.range(0) + 1);
+  Map map;
+  for (size_t i = 1; i < ssrcs.size(); ++i)
+    map[ssrcs[i]] = static_cast<int>(ssrcs[i] & 0xff);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(map.find(ssrcs[0]) == map.end());
+  }
+}
+
+// Same as BM_LookupSsrc, but with the map out of the cache, as it is when
+// the packet path touches the map once per packet between much other work.
+// Many maps are looked up in turn, with their nodes allocated interleaved,
+// like the nodes of long lived maps are.
+template <typename Map>
+void BM_LookupSsrcColdCache(benchmark::State& state) {
+  constexpr int kNumMaps = 16384;
+  const std::vector<uint32_t> ssrcs = RandomSsrcs(state.range(0));
+  std::vector<Map> maps(kNumMaps);
+  for (uint32_t ssrc : ssrcs) {
+    for (Map& map : maps)
+      map[ssrc] = static_cast<int>(ssrc & 0xff);
+  }
+  std::mt19937 random(0);
+  std::vector<int> order(kNumMaps);
+  for (int i = 0; i < kNumMaps; ++i)
+    order[i] = random() % kNumMaps;
+  size_t i = 0;
+  for (auto _ : state) {
+    const Map& map = maps[order[i % kNumMaps]];
+    auto it = map.find(ssrcs[i % ssrcs.size()]);
+    benchmark::DoNotOptimize(it->second);
+    ++i;
+  }
+}
+
+#define SSRC_COUNTS Arg(1)->Arg(2)->Arg(3)->Arg(4)->Arg(8)->Arg(16)->Arg(32)
+
+BENCHMARK_TEMPLATE(BM_LookupSsrc, std::map<uint32_t, int>)->SSRC_COUNTS;
+BENCHMARK_TEMPLATE(BM_LookupSsrc, std::unordered_map<uint32_t, int>)
+    ->SSRC_COUNTS;
+BENCHMARK_TEMPLATE(BM_LookupSsrc, flat_map<uint32_t, int>)->SSRC_COUNTS;
+
+BENCHMARK_TEMPLATE(BM_LookupSsrcColdCache, std::map<uint32_t, int>)
+    ->SSRC_COUNTS;
+BENCHMARK_TEMPLATE(BM_LookupSsrcColdCache, std::unordered_map<uint32_t, int>)
+    ->SSRC_COUNTS;
+BENCHMARK_TEMPLATE(BM_LookupSsrcColdCache, flat_map<uint32_t, int>)
+    ->SSRC_COUNTS;
+
+BENCHMARK_TEMPLATE(BM_LookupMissingSsrc, std::map<uint32_t, int>)
+    ->SSRC_COUNTS;
+BENCHMARK_TEMPLATE(BM_LookupMissingSsrc, std::unordered_map<uint32_t, int>)
+    ->SSRC_COUNTS;
+BENCHMARK_TEMPLATE(BM_LookupMissingSsrc, flat_map<uint32_t, int>)
+    ->SSRC_COUNTS;
+
+}  // namespace
+}  // namespace webrtc
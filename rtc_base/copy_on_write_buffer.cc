@@ -12,7 +12,215 @@
 
 #include <stddef.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <new>
+#include <vector>
+
+#include "absl/base/attributes.h"
+#include "absl/base/config.h"
+#include "rtc_base/sanitizer.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+// Recycled blocks would hide use-after-free bugs from the sanitizers, and the
+// per thread caches need thread_local.
+#if defined(ABSL_HAVE_THREAD_LOCAL) && !RTC_HAS_ASAN && !RTC_HAS_MSAN
+#define RTC_COPY_ON_WRITE_BUFFER_POOL 1
+#else
+#define RTC_COPY_ON_WRITE_BUFFER_POOL 0
+#endif
+
 namespace rtc {
+namespace {
+
+// Payload capacities of the pooled blocks: one for RTCP and audio packets, one
+// for anything up to an ethernet MTU plus SRTP overhead.
+constexpr size_t kSizeClasses[] = {256, 2048};
+constexpr int kNumSizeClasses = sizeof(kSizeClasses) / sizeof(kSizeClasses[0]);
+// Blocks a thread keeps per size class before returning a batch to the depot.
+constexpr size_t kThreadCacheSize = 64;
+// Blocks moved between a thread cache and the depot at a time.
+constexpr size_t kTransferBatchSize = kThreadCacheSize / 2;
+// Blocks the depot keeps per size class; any more are freed.
+constexpr size_t kMaxDepotSize = 1024;
+
+std::atomic<int64_t> pool_hits{0};
+std::atomic<int64_t> pool_misses{0};
+std::atomic<int64_t> pool_unpooled{0};
+
+// Returns the smallest size class that fits `capacity`, or -1 if none does.
+int SizeClassFor(size_t capacity) {
+#if RTC_COPY_ON_WRITE_BUFFER_POOL
+  for (int i = 0; i < kNumSizeClasses; ++i) {
+    if (capacity <= kSizeClasses[i]) {
+      return i;
+    }
+  }
+#endif
+  return -1;
+}
+
+#if RTC_COPY_ON_WRITE_BUFFER_POOL
+
+// Blocks shared by all threads. Thread caches refill from it when they run
+// dry and spill into it when they fill up, so that buffers allocated on one
+// thread and released on another still get recycled.
+class Depot {
+ public:
+  // Moves up to `count` blocks of `size_class` to `blocks` and returns how
+  // many were moved.
+  size_t Take(int size_class, void** blocks, size_t count) {
+    webrtc::MutexLock lock(&mutex_);
+    std::vector<void*>& pool = pools_[size_class];
+    count = std::min(count, pool.size());
+    std::copy(pool.end() - count, pool.end(), blocks);
+    pool.resize(pool.size() - count);
+    return count;
+  }
+
+  // Takes ownership of `count` blocks of `size_class`.
+  void Give(int size_class, void* const* blocks, size_t count) {
+    size_t kept;
+    {
+      webrtc::MutexLock lock(&mutex_);
+      std::vector<void*>& pool = pools_[size_class];
+      kept = std::min(count, kMaxDepotSize - pool.size());
+      pool.insert(pool.end(), blocks, blocks + kept);
+    }
+    for (size_t i = kept; i < count; ++i) {
+      ::operator delete(blocks[i]);
+    }
+  }
+
+ private:
+  webrtc::Mutex mutex_;
+  std::vector<void*> pools_[kNumSizeClasses] RTC_GUARDED_BY(mutex_);
+};
+
+Depot& GetDepot() {
+  static Depot* const depot = new Depot();
+  return *depot;
+}
+
+struct ThreadCache {
+  constexpr ThreadCache() = default;
+  ~ThreadCache();
+
+  void* blocks[kNumSizeClasses][kThreadCacheSize] = {};
+  size_t counts[kNumSizeClasses] = {};
+};
+
+ABSL_CONST_INIT thread_local ThreadCache thread_cache;
+// Set once `thread_cache` is destroyed at thread exit; buffers released after
+// that go straight to the depot.
+ABSL_CONST_INIT thread_local bool thread_cache_destroyed = false;
+
+ThreadCache::~ThreadCache() {
+  for (int i = 0; i < kNumSizeClasses; ++i) {
+    GetDepot().Give(i, blocks[i], counts[i]);
+    counts[i] = 0;
+  }
+  thread_cache_destroyed = true;
+}
+
+#endif  // RTC_COPY_ON_WRITE_BUFFER_POOL
+
+// Returns a block of `block_size` bytes. All blocks of a size class must have
+// the same size.
+void* AllocateBlock(int size_class, size_t block_size) {
+  if (size_class < 0) {
+    pool_unpooled.fetch_add(1, std::memory_order_relaxed);
+    return ::operator new(block_size);
+  }
+#if RTC_COPY_ON_WRITE_BUFFER_POOL
+  void* block = nullptr;
+  if (thread_cache_destroyed) {
+    GetDepot().Take(size_class, &block, 1);
+  } else {
+    ThreadCache& cache = thread_cache;
+    size_t& count = cache.counts[size_class];
+    if (count == 0) {
+      count = GetDepot().Take(size_class, cache.blocks[size_class],
+                              kTransferBatchSize);
+    }
+    if (count > 0) {
+      block = cache.blocks[size_class][--count];
+    }
+  }
+  if (block) {
+    pool_hits.fetch_add(1, std::memory_order_relaxed);
+    return block;
+  }
+#endif
+  pool_misses.fetch_add(1, std::memory_order_relaxed);
+  return ::operator new(block_size);
+}
+
+void FreeBlock(int size_class, void* block) {
+#if RTC_COPY_ON_WRITE_BUFFER_POOL
+  if (size_class >= 0) {
+    if (thread_cache_destroyed) {
+      GetDepot().Give(size_class, &block, 1);
+      return;
+    }
+    ThreadCache& cache = thread_cache;
+    size_t& count = cache.counts[size_class];
+    if (count == kThreadCacheSize) {
+      count -= kTransferBatchSize;
+      GetDepot().Give(size_class, &cache.blocks[size_class][count],
+                      kTransferBatchSize);
+    }
+    cache.blocks[size_class][count++] = block;
+    return;
+  }
+#endif
+  ::operator delete(block);
+}
+
+}  // namespace
+
+CopyOnWriteBuffer::RefCountedBuffer*
+CopyOnWriteBuffer::RefCountedBuffer::Create(size_t size, size_t capacity) {
+  capacity = std::max(size, capacity);
+  const int size_class = SizeClassFor(capacity);
+  const size_t block_capacity =
+      size_class < 0 ? capacity : kSizeClasses[size_class];
+  void* block =
+      AllocateBlock(size_class, sizeof(RefCountedBuffer) + block_capacity);
+  return new (block) RefCountedBuffer(size, capacity, size_class);
+}
+
+CopyOnWriteBuffer::RefCountedBuffer*
+CopyOnWriteBuffer::RefCountedBuffer::Create(const void* data,
+                                            size_t size,
+                                            size_t capacity) {
+  RefCountedBuffer* buffer = Create(size, capacity);
+  if (size > 0) {
+    std::memcpy(buffer->data(), data, size);
+  }
+  return buffer;
+}
+
+RefCountReleaseStatus CopyOnWriteBuffer::RefCountedBuffer::Release() const {
+  const RefCountReleaseStatus status = ref_count_.DecRef();
+  if (status == RefCountReleaseStatus::kDroppedLastRef) {
+    const int size_class = size_class_;
+    RefCountedBuffer* block = const_cast<RefCountedBuffer*>(this);
+    block->~RefCountedBuffer();
+    FreeBlock(size_class, block);
+  }
+  return status;
+}
+
+CopyOnWriteBuffer::PoolStats CopyOnWriteBuffer::GetPoolStats() {
+  PoolStats stats;
+  stats.hits = pool_hits.load(std::memory_order_relaxed);
+  stats.misses = pool_misses.load(std::memory_order_relaxed);
+  stats.unpooled = pool_unpooled.load(std::memory_order_relaxed);
+  return stats;
+}
 
 CopyOnWriteBuffer::CopyOnWriteBuffer() : offset_(0), size_(0) {
   RTC_DCHECK(IsConsistent());
@@ -32,15 +240,17 @@ CopyOnWriteBuffer::CopyOnWriteBuffer(const std::string& s)
     : CopyOnWriteBuffer(s.data(), s.length()) {}
 
 CopyOnWriteBuffer::CopyOnWriteBuffer(size_t size)
-    : buffer_(size > 0 ? new RefCountedBuffer(size) : nullptr),
+    : buffer_(size > 0 ? RefCountedBuffer::Create(size, size)
+                        : nullptr),
       offset_(0),
       size_(size) {
   RTC_DCHECK(IsConsistent());
 }
 
 CopyOnWriteBuffer::CopyOnWriteBuffer(size_t size, size_t capacity)
-    : buffer_(size > 0 || capacity > 0 ? new RefCountedBuffer(size, capacity)
-                                       : nullptr),
+    : buffer_(size > 0 || capacity > 0
+                  ? RefCountedBuffer::Create(size, capacity)
+                  : nullptr),
       offset_(0),
       size_(size) {
   RTC_DCHECK(IsConsistent());
@@ -60,7 +270,7 @@ void CopyOnWriteBuffer::SetSize(size_t size) {
   RTC_DCHECK(IsConsistent());
   if (!buffer_) {
     if (size > 0) {
-      buffer_ = new RefCountedBuffer(size);
+      buffer_ = RefCountedBuffer::Create(size, size);
       offset_ = 0;
       size_ = size;
     }
@@ -83,7 +293,7 @@ void CopyOnWriteBuffer::EnsureCapacity(size_t new_capacity) {
   RTC_DCHECK(IsConsistent());
   if (!buffer_) {
     if (new_capacity > 0) {
-      buffer_ = new RefCountedBuffer(0, new_capacity);
+      buffer_ = RefCountedBuffer::Create(0, new_capacity);
       offset_ = 0;
       size_ = 0;
     }
@@ -104,7 +314,7 @@ void CopyOnWriteBuffer::Clear() {
   if (buffer_->HasOneRef()) {
     buffer_->Clear();
   } else {
-    buffer_ = new RefCountedBuffer(0, capacity());
+    buffer_ = RefCountedBuffer::Create(0, capacity());
   }
   offset_ = 0;
   size_ = 0;
@@ -116,8 +326,8 @@ void CopyOnWriteBuffer::UnshareAndEnsureCapacity(size_t new_capacity) {
     return;
   }
 
-  buffer_ =
-      new RefCountedBuffer(buffer_->data() + offset_, size_, new_capacity);
+  buffer_ = RefCountedBuffer::Create(buffer_->data() + offset_, size_,
+                                     new_capacity);
   offset_ = 0;
   RTC_DCHECK(IsConsistent());
 }
@@ -22,7 +22,9 @@
 #include "api/scoped_refptr.h"
 #include "rtc_base/buffer.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/ref_count.h"
 #include "rtc_base/ref_counted_object.h"
+#include "rtc_base/ref_counter.h"
 #include "rtc_base/system/rtc_export.h"
 #include "rtc_base/type_traits.h"
 
@@ -171,9 +173,13 @@ class RTC_EXPORT CopyOnWriteBuffer {
   void SetData(const T* data, size_t size) {
     RTC_DCHECK(IsConsistent());
     if (!buffer_) {
-      buffer_ = size > 0 ? new RefCountedBuffer(data, size) : nullptr;
+      buffer_ = size > 0 ? RefCountedBuffer::Create(data, size, size) : nullptr;
     } else if (!buffer_->HasOneRef()) {
-      buffer_ = new RefCountedBuffer(data, size, capacity());
+      buffer_ = RefCountedBuffer::Create(data, size, capacity());
+    } else if (size > buffer_->capacity()) {
+      // Grow with the same headroom as rtc::Buffer::SetData would.
+      buffer_ = RefCountedBuffer::Create(
+          data, size, buffer_->capacity() + buffer_->capacity() / 2);
     } else {
       buffer_->SetData(data, size);
     }
@@ -208,7 +214,7 @@ class RTC_EXPORT CopyOnWriteBuffer {
   void AppendData(const T* data, size_t size) {
     RTC_DCHECK(IsConsistent());
     if (!buffer_) {
-      buffer_ = new RefCountedBuffer(data, size);
+      buffer_ = RefCountedBuffer::Create(data, size, size);
       offset_ = 0;
       size_ = size;
       RTC_DCHECK(IsConsistent());
@@ -265,6 +271,20 @@ class RTC_EXPORT CopyOnWriteBuffer {
     std::swap(a.size_, b.size_);
   }
 
+  // Counters for the pool that recycles the storage of small buffers. Storage
+  // is drawn from the pool whenever the capacity fits one of its size
+  // classes; the largest class holds an ethernet MTU sized packet.
+  struct PoolStats {
+    // Buffers whose storage was recycled from a released buffer.
+    int64_t hits = 0;
+    // Buffers that fit a size class but found the pool empty.
+    int64_t misses = 0;
+    // Buffers too large for any size class, allocated directly.
+    int64_t unpooled = 0;
+  };
+  // Process wide totals; cheap enough to poll for metrics.
+  static PoolStats GetPoolStats();
+
   CopyOnWriteBuffer Slice(size_t offset, size_t length) const {
     CopyOnWriteBuffer slice(*this);
     RTC_DCHECK_LE(offset, size_);
@@ -275,7 +295,64 @@ class RTC_EXPORT CopyOnWriteBuffer {
   }
 
  private:
-  using RefCountedBuffer = FinalRefCountedObject<Buffer>;
+  // The shared storage behind one or more CopyOnWriteBuffers: a reference
+  // count and a fixed capacity array of bytes in a single allocation. Unless
+  // it is too large, the allocation comes from a size classed pool with a
+  // cache per thread, and goes back there when the last reference is dropped.
+  // capacity() is the capacity asked for, never the size of the pool block.
+  class RTC_EXPORT RefCountedBuffer {
+   public:
+    // Returns storage for max(`size`, `capacity`) bytes, the first `size` of
+    // which are uninitialized, or copied from `data`.
+    static RefCountedBuffer* Create(size_t size, size_t capacity);
+    static RefCountedBuffer* Create(const void* data,
+                                    size_t size,
+                                    size_t capacity);
+
+    RefCountedBuffer(const RefCountedBuffer&) = delete;
+    RefCountedBuffer& operator=(const RefCountedBuffer&) = delete;
+
+    void AddRef() const { ref_count_.IncRef(); }
+    RefCountReleaseStatus Release() const;
+    bool HasOneRef() const { return ref_count_.HasOneRef(); }
+
+    template <typename T = uint8_t>
+    T* data() {
+      return reinterpret_cast<T*>(this + 1);
+    }
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+
+    // Unlike their rtc::Buffer counterparts, these never reallocate; the
+    // caller must make sure the result fits capacity().
+    void SetSize(size_t size) {
+      RTC_DCHECK_LE(size, capacity_);
+      size_ = size;
+    }
+    void SetData(const void* data, size_t size) {
+      size_ = 0;
+      AppendData(data, size);
+    }
+    void AppendData(const void* data, size_t size) {
+      RTC_DCHECK_LE(size_ + size, capacity_);
+      std::memcpy(this->data() + size_, data, size);
+      size_ += size;
+    }
+    void Clear() { size_ = 0; }
+
+   private:
+    RefCountedBuffer(size_t size, size_t capacity, int size_class)
+        : size_(size), capacity_(capacity), size_class_(size_class) {}
+    ~RefCountedBuffer() = default;
+
+    mutable webrtc::webrtc_impl::RefCounter ref_count_{0};
+    size_t size_;
+    const size_t capacity_;
+    // Index of the pool size class the storage came from, or -1 if it was
+    // allocated directly.
+    const int size_class_;
+  };
+
   // Create a copy of the underlying data if it is referenced from other Buffer
   // objects or there is not enough capacity.
   void UnshareAndEnsureCapacity(size_t new_capacity);
@@ -290,7 +367,7 @@ class RTC_EXPORT CopyOnWriteBuffer {
     }
   }
 
-  // buffer_ is either null, or points to an rtc::Buffer with capacity > 0.
+  // buffer_ is either null, or points to storage with capacity > 0.
   scoped_refptr<RefCountedBuffer> buffer_;
   // This buffer may represent a slice of a original data.
   size_t offset_;  // Offset of a current slice in the original data in buffer_.
@@ -11,7 +11,11 @@
 #include "rtc_base/copy_on_write_buffer.h"
 
 #include <cstdint>
+#include <vector>
 
+#include "absl/base/config.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/sanitizer.h"
 #include "test/gtest.h"
 
 namespace rtc {
@@ -373,4 +377,53 @@ TEST(CopyOnWriteBufferTest, AcceptsVectorLikeTypes) {
   EXPECT_EQ(all.size(), 8U);
 }
 
+TEST(CopyOnWriteBufferTest, CountsEveryAllocationInPoolStats) {
+  const CopyOnWriteBuffer::PoolStats before = CopyOnWriteBuffer::GetPoolStats();
+  { CopyOnWriteBuffer small(kTestData, 10); }
+  { CopyOnWriteBuffer large(100, 100000); }
+  const CopyOnWriteBuffer::PoolStats after = CopyOnWriteBuffer::GetPoolStats();
+  EXPECT_EQ(before.hits + before.misses + before.unpooled + 2,
+            after.hits + after.misses + after.unpooled);
+  EXPECT_LE(before.unpooled + 1, after.unpooled);
+}
+
+#if defined(ABSL_HAVE_THREAD_LOCAL) && !RTC_HAS_ASAN && !RTC_HAS_MSAN
+TEST(CopyOnWriteBufferTest, RecyclesReleasedStorage) {
+  const uint8_t* released_data;
+  {
+    CopyOnWriteBuffer buf(kTestData, 10, 1200);
+    released_data = buf.cdata();
+  }
+  const CopyOnWriteBuffer::PoolStats before = CopyOnWriteBuffer::GetPoolStats();
+  // Same size class, so it gets the block that was just released.
+  CopyOnWriteBuffer buf(kTestData, 16, 1500);
+  const CopyOnWriteBuffer::PoolStats after = CopyOnWriteBuffer::GetPoolStats();
+  EXPECT_EQ(released_data, buf.cdata());
+  EXPECT_EQ(before.hits + 1, after.hits);
+  // The pool block is bigger, but the buffer keeps the requested capacity.
+  EXPECT_EQ(1500u, buf.capacity());
+  EXPECT_EQ(0, memcmp(buf.cdata(), kTestData, 16));
+}
+
+TEST(CopyOnWriteBufferTest, RecyclesStorageReleasedOnAnotherThread) {
+  const CopyOnWriteBuffer::PoolStats before = CopyOnWriteBuffer::GetPoolStats();
+  std::vector<CopyOnWriteBuffer> buffers;
+  for (int i = 0; i < 100; ++i) {
+    buffers.emplace_back(kTestData, 16, 256);
+  }
+  // The other thread's cache spills to the shared depot when it fills up,
+  // and hands the rest over when the thread exits.
+  PlatformThread::SpawnJoinable([&buffers] { buffers.clear(); },
+                                "releaser")
+      .Finalize();
+  std::vector<CopyOnWriteBuffer> recycled;
+  for (int i = 0; i < 100; ++i) {
+    recycled.emplace_back(kTestData, 16, 256);
+  }
+  const CopyOnWriteBuffer::PoolStats after = CopyOnWriteBuffer::GetPoolStats();
+  EXPECT_EQ(before.hits + before.misses + 200, after.hits + after.misses);
+  EXPECT_LE(before.hits + 100, after.hits);
+}
+#endif
+
 }  // namespace rtc
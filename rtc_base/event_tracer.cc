@@ -14,9 +14,13 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <algorithm>
+#include <atomic>
 #include <string>
 #include <vector>
 
+#include "absl/base/attributes.h"
+#include "absl/base/config.h"
 #include "api/sequence_checker.h"
 #include "rtc_base/atomic_ops.h"
 #include "rtc_base/checks.h"
@@ -25,10 +29,19 @@
 #include "rtc_base/platform_thread.h"
 #include "rtc_base/platform_thread_types.h"
 #include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/system/arch.h"
 #include "rtc_base/thread_annotations.h"
 #include "rtc_base/time_utils.h"
 #include "rtc_base/trace_event.h"
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
 // This is a guesstimate that should be enough in most cases.
 static const size_t kEventLoggerArgsStrBufferInitialSize = 256;
 static const size_t kTraceArgBufferLength = 32;
@@ -82,6 +95,85 @@ namespace {
 // Atomic-int fast path for avoiding logging when disabled.
 static volatile int g_event_logging_active = 0;
 
+struct TraceArg {
+  const char* name;
+  unsigned char type;
+  // Copied from webrtc/rtc_base/trace_event.h TraceValueUnion.
+  union TraceArgValue {
+    bool as_bool;
+    unsigned long long as_uint;
+    long long as_int;
+    double as_double;
+    const void* as_pointer;
+    const char* as_string;
+  } value;
+
+  // Assert that the size of the union is equal to the size of the as_uint
+  // field since we are assigning to arbitrary types using it.
+  static_assert(sizeof(TraceArgValue) == sizeof(unsigned long long),
+                "Size of TraceArg value union is not equal to the size of "
+                "the uint field of that union.");
+};
+
+std::string TraceArgValueAsString(TraceArg arg) {
+  std::string output;
+
+  if (arg.type == TRACE_VALUE_TYPE_STRING ||
+      arg.type == TRACE_VALUE_TYPE_COPY_STRING) {
+    // Space for every character to be an espaced character + two for
+    // quatation marks.
+    output.reserve(strlen(arg.value.as_string) * 2 + 2);
+    output += '\"';
+    for (const char* c = arg.value.as_string; *c; ++c) {
+      if (*c == '"' || *c == '\\') {
+        output += '\\';
+        output += *c;
+      } else {
+        output += *c;
+      }
+    }
+    output += '\"';
+  } else {
+    output.resize(kTraceArgBufferLength);
+    size_t print_length = 0;
+    switch (arg.type) {
+      case TRACE_VALUE_TYPE_BOOL:
+        if (arg.value.as_bool) {
+          strcpy(&output[0], "true");
+          print_length = 4;
+        } else {
+          strcpy(&output[0], "false");
+          print_length = 5;
+        }
+        break;
+      case TRACE_VALUE_TYPE_UINT:
+        print_length = snprintf(&output[0], kTraceArgBufferLength, "%llu",
+                                arg.value.as_uint);
+        break;
+      case TRACE_VALUE_TYPE_INT:
+        print_length = snprintf(&output[0], kTraceArgBufferLength, "%lld",
+                                arg.value.as_int);
+        break;
+      case TRACE_VALUE_TYPE_DOUBLE:
+        print_length = snprintf(&output[0], kTraceArgBufferLength, "%f",
+                                arg.value.as_double);
+        break;
+      case TRACE_VALUE_TYPE_POINTER:
+        print_length = snprintf(&output[0], kTraceArgBufferLength, "\"%p\"",
+                                arg.value.as_pointer);
+        break;
+    }
+    size_t output_length = print_length < kTraceArgBufferLength
+                               ? print_length
+                               : kTraceArgBufferLength - 1;
+    // This will hopefully be very close to nop. On most implementations, it
+    // just writes null byte and sets the length field of the string.
+    output.resize(output_length);
+  }
+
+  return output;
+}
+
 // TODO(pbos): Log metadata for all threads, etc.
 class EventLogger final {
  public:
@@ -221,26 +313,6 @@ class EventLogger final {
   }
 
  private:
-  struct TraceArg {
-    const char* name;
-    unsigned char type;
-    // Copied from webrtc/rtc_base/trace_event.h TraceValueUnion.
-    union TraceArgValue {
-      bool as_bool;
-      unsigned long long as_uint;
-      long long as_int;
-      double as_double;
-      const void* as_pointer;
-      const char* as_string;
-    } value;
-
-    // Assert that the size of the union is equal to the size of the as_uint
-    // field since we are assigning to arbitrary types using it.
-    static_assert(sizeof(TraceArgValue) == sizeof(unsigned long long),
-                  "Size of TraceArg value union is not equal to the size of "
-                  "the uint field of that union.");
-  };
-
   struct TraceEvent {
     const char* name;
     const unsigned char* category_enabled;
@@ -251,66 +323,6 @@ class EventLogger final {
     rtc::PlatformThreadId tid;
   };
 
-  static std::string TraceArgValueAsString(TraceArg arg) {
-    std::string output;
-
-    if (arg.type == TRACE_VALUE_TYPE_STRING ||
-        arg.type == TRACE_VALUE_TYPE_COPY_STRING) {
-      // Space for every character to be an espaced character + two for
-      // quatation marks.
-      output.reserve(strlen(arg.value.as_string) * 2 + 2);
-      output += '\"';
-      const char* c = arg.value.as_string;
-      do {
-        if (*c == '"' || *c == '\\') {
-          output += '\\';
-          output += *c;
-        } else {
-          output += *c;
-        }
-      } while (*++c);
-      output += '\"';
-    } else {
-      output.resize(kTraceArgBufferLength);
-      size_t print_length = 0;
-      switch (arg.type) {
-        case TRACE_VALUE_TYPE_BOOL:
-          if (arg.value.as_bool) {
-            strcpy(&output[0], "true");
-            print_length = 4;
-          } else {
-            strcpy(&output[0], "false");
-            print_length = 5;
-          }
-          break;
-        case TRACE_VALUE_TYPE_UINT:
-          print_length = snprintf(&output[0], kTraceArgBufferLength, "%llu",
-                                  arg.value.as_uint);
-          break;
-        case TRACE_VALUE_TYPE_INT:
-          print_length = snprintf(&output[0], kTraceArgBufferLength, "%lld",
-                                  arg.value.as_int);
-          break;
-        case TRACE_VALUE_TYPE_DOUBLE:
-          print_length = snprintf(&output[0], kTraceArgBufferLength, "%f",
-                                  arg.value.as_double);
-          break;
-        case TRACE_VALUE_TYPE_POINTER:
-          print_length = snprintf(&output[0], kTraceArgBufferLength, "\"%p\"",
-                                  arg.value.as_pointer);
-          break;
-      }
-      size_t output_length = print_length < kTraceArgBufferLength
-                                 ? print_length
-                                 : kTraceArgBufferLength - 1;
-      // This will hopefully be very close to nop. On most implementations, it
-      // just writes null byte and sets the length field of the string.
-      output.resize(output_length);
-    }
-
-    return output;
-  }
-
   webrtc::Mutex mutex_;
   std::vector<TraceEvent> trace_events_ RTC_GUARDED_BY(mutex_);
   rtc::PlatformThread logging_thread_;
@@ -352,6 +364,203 @@ void InternalAddTraceEvent(char phase,
                                 rtc::TimeMicros(), 1, rtc::CurrentThreadId());
 }
 
+// The flight recorder keeps the last kFlightRecorderEventsPerThread events of
+// every thread in a ring buffer of the thread, so that they can be dumped
+// after the fact. Adding an event takes no lock and doesn't allocate.
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+#define RTC_FLIGHT_RECORDER 1
+#else
+#define RTC_FLIGHT_RECORDER 0
+#endif
+
+constexpr size_t kFlightRecorderEventsPerThread = 4096;
+// Trace events have at most two arguments.
+constexpr int kFlightRecorderMaxArgs = 2;
+// Copied string arguments are truncated to fit this, including the null.
+constexpr size_t kFlightRecorderMaxCopiedString = 24;
+
+// Timestamps are read from the time stamp counter where available, which is
+// much cheaper than reading the clock, and converted to microseconds when
+// dumped. This assumes an invariant TSC, which all x86 CPUs of the last
+// decade have.
+uint64_t FlightRecorderTicks() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  return __rdtsc();
+#else
+  return rtc::TimeMicros();
+#endif
+}
+
+std::atomic<bool> g_flight_recorder_active{false};
+uint64_t g_flight_recorder_start_ticks = 0;
+int64_t g_flight_recorder_start_us = 0;
+
+struct FlightRecorderEvent {
+  const char* name;
+  const unsigned char* category_enabled;
+  uint64_t ticks;
+  rtc::PlatformThreadId tid;
+  char phase;
+  unsigned char num_args;
+  unsigned char arg_types[kFlightRecorderMaxArgs];
+  const char* arg_names[kFlightRecorderMaxArgs];
+  unsigned long long arg_values[kFlightRecorderMaxArgs];
+  char copied_strings[kFlightRecorderMaxArgs][kFlightRecorderMaxCopiedString];
+};
+
+constexpr size_t kFlightRecorderEventWords =
+    (sizeof(FlightRecorderEvent) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+// An event slot guarded by a sequence lock: the sequence number is odd while
+// the owning thread writes the slot, so that a dump running concurrently can
+// detect and skip an event that was overwritten while it was copied. The
+// event is stored as relaxed atomic words, which compile to plain loads and
+// stores, to make the concurrent accesses well defined.
+class FlightRecorderSlot {
+ public:
+  void Write(const FlightRecorderEvent& event) {
+    uint64_t words[kFlightRecorderEventWords] = {};
+    memcpy(words, &event, sizeof(event));
+    const uint64_t seq = seq_.load(std::memory_order_relaxed);
+    seq_.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < kFlightRecorderEventWords; ++i) {
+      words_[i].store(words[i], std::memory_order_relaxed);
+    }
+    seq_.store(seq + 2, std::memory_order_release);
+  }
+
+  // Returns false if the slot was never written or is being written.
+  bool Read(FlightRecorderEvent* event) const {
+    const uint64_t seq = seq_.load(std::memory_order_acquire);
+    if (seq == 0 || seq % 2 != 0) {
+      return false;
+    }
+    uint64_t words[kFlightRecorderEventWords];
+    for (size_t i = 0; i < kFlightRecorderEventWords; ++i) {
+      words[i] = words_[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (seq_.load(std::memory_order_relaxed) != seq) {
+      return false;
+    }
+    memcpy(event, words, sizeof(*event));
+    return true;
+  }
+
+ private:
+  std::atomic<uint64_t> seq_{0};
+  std::atomic<uint64_t> words_[kFlightRecorderEventWords] = {};
+};
+
+// Written only by the thread that owns it. When a thread exits, its buffer,
+// with the events it holds, is kept and reused by the next new thread.
+struct FlightRecorderBuffer {
+  std::atomic<uint64_t> next_index{0};
+  FlightRecorderSlot slots[kFlightRecorderEventsPerThread];
+  std::atomic<bool> in_use{true};
+  FlightRecorderBuffer* next = nullptr;
+};
+
+// Buffers are never deleted, since threads may hold on to them at any time.
+webrtc::Mutex& GetFlightRecorderLock() {
+  static webrtc::Mutex& mutex = *new webrtc::Mutex();
+  return mutex;
+}
+
+FlightRecorderBuffer* g_flight_recorder_buffers
+    RTC_GUARDED_BY(GetFlightRecorderLock()) = nullptr;
+
+#if RTC_FLIGHT_RECORDER
+
+struct FlightRecorderBufferOwner {
+  constexpr FlightRecorderBufferOwner() = default;
+  ~FlightRecorderBufferOwner();
+
+  FlightRecorderBuffer* buffer = nullptr;
+};
+
+ABSL_CONST_INIT thread_local FlightRecorderBufferOwner
+    tls_flight_recorder_buffer;
+// Set once `tls_flight_recorder_buffer` is destroyed at thread exit; events
+// added after that are not recorded.
+ABSL_CONST_INIT thread_local bool tls_flight_recorder_buffer_destroyed = false;
+
+FlightRecorderBufferOwner::~FlightRecorderBufferOwner() {
+  if (buffer) {
+    buffer->in_use.store(false, std::memory_order_release);
+  }
+  tls_flight_recorder_buffer_destroyed = true;
+}
+
+FlightRecorderBuffer* GetFlightRecorderBuffer() {
+  if (tls_flight_recorder_buffer_destroyed) {
+    return nullptr;
+  }
+  FlightRecorderBuffer*& buffer = tls_flight_recorder_buffer.buffer;
+  if (buffer == nullptr) {
+    webrtc::MutexLock lock(&GetFlightRecorderLock());
+    for (FlightRecorderBuffer* b = g_flight_recorder_buffers; b != nullptr;
+         b = b->next) {
+      if (!b->in_use.load(std::memory_order_acquire)) {
+        b->in_use.store(true, std::memory_order_relaxed);
+        buffer = b;
+        return buffer;
+      }
+    }
+    buffer = new FlightRecorderBuffer();
+    buffer->next = g_flight_recorder_buffers;
+    g_flight_recorder_buffers = buffer;
+  }
+  return buffer;
+}
+
+#endif  // RTC_FLIGHT_RECORDER
+
+void FlightRecorderAddTraceEvent(char phase,
+                                 const unsigned char* category_enabled,
+                                 const char* name,
+                                 unsigned long long id,
+                                 int num_args,
+                                 const char** arg_names,
+                                 const unsigned char* arg_types,
+                                 const unsigned long long* arg_values,
+                                 unsigned char flags) {
+#if RTC_FLIGHT_RECORDER
+  if (!g_flight_recorder_active.load(std::memory_order_relaxed))
+    return;
+  FlightRecorderBuffer* buffer = GetFlightRecorderBuffer();
+  if (buffer == nullptr)
+    return;
+
+  FlightRecorderEvent event;
+  event.name = name;
+  event.category_enabled = category_enabled;
+  event.ticks = FlightRecorderTicks();
+  event.tid = rtc::CurrentThreadId();
+  event.phase = phase;
+  event.num_args =
+      static_cast<unsigned char>(std::min(num_args, kFlightRecorderMaxArgs));
+  for (int i = 0; i < event.num_args; ++i) {
+    event.arg_names[i] = arg_names[i];
+    event.arg_types[i] = arg_types[i];
+    event.arg_values[i] = arg_values[i];
+    // The string is temporary, so a truncated copy is kept in the event.
+    if (arg_types[i] == TRACE_VALUE_TYPE_COPY_STRING) {
+      TraceArg arg;
+      arg.value.as_uint = arg_values[i];
+      strncpy(event.copied_strings[i], arg.value.as_string,
+              kFlightRecorderMaxCopiedString - 1);
+      event.copied_strings[i][kFlightRecorderMaxCopiedString - 1] = '\0';
+    }
+  }
+
+  const uint64_t index = buffer->next_index.load(std::memory_order_relaxed);
+  buffer->slots[index % kFlightRecorderEventsPerThread].Write(event);
+  buffer->next_index.store(index + 1, std::memory_order_release);
+#endif
+}
+
 }  // namespace
 
 void SetupInternalTracer() {
@@ -387,6 +596,119 @@ void StopInternalCapture() {
   }
 }
 
+bool SetupFlightRecorder() {
+#if RTC_FLIGHT_RECORDER
+  g_flight_recorder_start_us = rtc::TimeMicros();
+  g_flight_recorder_start_ticks = FlightRecorderTicks();
+  g_flight_recorder_active.store(true, std::memory_order_relaxed);
+  webrtc::SetupEventTracer(InternalGetCategoryEnabled,
+                           FlightRecorderAddTraceEvent);
+  return true;
+#else
+  return false;
+#endif
+}
+
+void DumpFlightRecorderToFile(FILE* file) {
+  std::vector<FlightRecorderEvent> events;
+  {
+    webrtc::MutexLock lock(&GetFlightRecorderLock());
+    for (const FlightRecorderBuffer* buffer = g_flight_recorder_buffers;
+         buffer != nullptr; buffer = buffer->next) {
+      const uint64_t end = buffer->next_index.load(std::memory_order_acquire);
+      const uint64_t begin = end > kFlightRecorderEventsPerThread
+                                 ? end - kFlightRecorderEventsPerThread
+                                 : 0;
+      for (uint64_t i = begin; i < end; ++i) {
+        FlightRecorderEvent event;
+        if (buffer->slots[i % kFlightRecorderEventsPerThread].Read(&event)) {
+          events.push_back(event);
+        }
+      }
+    }
+  }
+  std::sort(events.begin(), events.end(),
+            [](const FlightRecorderEvent& a, const FlightRecorderEvent& b) {
+              return a.ticks < b.ticks;
+            });
+
+  // Maps ticks to microseconds since the start of the process' log, like the
+  // timestamps of the internal tracer.
+  const uint64_t now_ticks = FlightRecorderTicks();
+  const int64_t now_us = rtc::TimeMicros();
+  double us_per_tick = 1.0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (now_ticks > g_flight_recorder_start_ticks) {
+    us_per_tick = static_cast<double>(now_us - g_flight_recorder_start_us) /
+                  (now_ticks - g_flight_recorder_start_ticks);
+  }
+#endif
+
+  fprintf(file, "{ \"traceEvents\": [\n");
+  bool has_logged_event = false;
+  std::string args_str;
+  args_str.reserve(kEventLoggerArgsStrBufferInitialSize);
+  for (const FlightRecorderEvent& e : events) {
+    args_str.clear();
+    if (e.num_args > 0) {
+      args_str += ", \"args\": {";
+      for (int i = 0; i < e.num_args; ++i) {
+        TraceArg arg;
+        arg.name = e.arg_names[i];
+        arg.type = e.arg_types[i];
+        arg.value.as_uint = e.arg_values[i];
+        if (arg.type == TRACE_VALUE_TYPE_COPY_STRING)
+          arg.value.as_string = e.copied_strings[i];
+        if (i > 0)
+          args_str += ",";
+        args_str += " \"";
+        args_str += arg.name;
+        args_str += "\": ";
+        args_str += TraceArgValueAsString(arg);
+      }
+      args_str += " }";
+    }
+    const double timestamp_us =
+        g_flight_recorder_start_us +
+        us_per_tick * static_cast<double>(static_cast<int64_t>(
+                          e.ticks - g_flight_recorder_start_ticks));
+    fprintf(file,
+            "%s{ \"name\": \"%s\""
+            ", \"cat\": \"%s\""
+            ", \"ph\": \"%c\""
+            ", \"ts\": %.3f"
+            ", \"pid\": %d"
+#if defined(WEBRTC_WIN)
+            ", \"tid\": %lu"
+#else
+            ", \"tid\": %d"
+#endif  // defined(WEBRTC_WIN)
+            "%s"
+            "}\n",
+            has_logged_event ? "," : " ", e.name, e.category_enabled, e.phase,
+            timestamp_us, 1, e.tid, args_str.c_str());
+    has_logged_event = true;
+  }
+  fprintf(file, "]}\n");
+}
+
+bool DumpFlightRecorder(const char* filename) {
+  FILE* file = fopen(filename, "w");
+  if (!file) {
+    RTC_LOG(LS_ERROR) << "Failed to open trace file '" << filename
+                      << "' for writing.";
+    return false;
+  }
+  DumpFlightRecorderToFile(file);
+  fclose(file);
+  return true;
+}
+
+void ShutdownFlightRecorder() {
+  g_flight_recorder_active.store(false, std::memory_order_relaxed);
+  webrtc::SetupEventTracer(nullptr, nullptr);
+}
+
 void ShutdownInternalTracer() {
   StopInternalCapture();
   EventLogger* old_logger = rtc::AtomicOps::AcquireLoadPtr(&g_event_logger);
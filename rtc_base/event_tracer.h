@@ -76,6 +76,20 @@ void StartInternalCaptureToFile(FILE* file);
 void StopInternalCapture();
 // Make sure we run this, this will tear down the internal tracing.
 void ShutdownInternalTracer();
+
+// Sets up an always-on flight recorder as the event tracer, instead of the
+// internal tracer. It keeps the last few thousand trace events of every thread
+// in memory, cheaply enough to leave on in production, so that they can be
+// dumped after a latency incident. Returns false if the platform lacks
+// thread_local support.
+bool SetupFlightRecorder();
+// Writes the events in the flight recorder in the Chrome JSON trace event
+// format, which chrome://tracing and the Perfetto UI open. May be called at
+// any time, from any thread.
+void DumpFlightRecorderToFile(FILE* file);
+bool DumpFlightRecorder(const char* filename);
+// Stops recording. The recorded events are kept and can still be dumped.
+void ShutdownFlightRecorder();
 }  // namespace tracing
 }  // namespace rtc
 
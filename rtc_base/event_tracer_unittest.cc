@@ -10,6 +10,11 @@
 
 #include "rtc_base/event_tracer.h"
 
+#include <stdio.h>
+
+#include <string>
+
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/thread_annotations.h"
 #include "rtc_base/trace_event.h"
@@ -76,6 +81,57 @@ TEST(EventTracerTest, ScopedTraceEvent) {
   EXPECT_EQ(2, TestStatistics::Get()->Count());
   TestStatistics::Get()->Reset();
 }
+
+std::string DumpFlightRecorderToString() {
+  FILE* file = tmpfile();
+  rtc::tracing::DumpFlightRecorderToFile(file);
+  std::string dump(ftell(file), '\0');
+  rewind(file);
+  EXPECT_EQ(dump.size(), fread(&dump[0], 1, dump.size(), file));
+  fclose(file);
+  return dump;
+}
+
+TEST(EventTracerTest, FlightRecorderRecordsEventsOfAllThreads) {
+  if (!rtc::tracing::SetupFlightRecorder()) {
+    GTEST_SKIP() << "Flight recorder not supported.";
+  }
+  std::string copied = "copied";
+  TRACE_EVENT1("test", "FlightRecorderMainThread", "arg",
+               TRACE_STR_COPY(copied.c_str()));
+  rtc::PlatformThread::SpawnJoinable(
+      [] { TRACE_EVENT_INSTANT1("test", "FlightRecorderOtherThread", "n", 7); },
+      "TracingThread");
+  std::string dump = DumpFlightRecorderToString();
+  rtc::tracing::ShutdownFlightRecorder();
+
+  EXPECT_NE(dump.find("\"name\": \"FlightRecorderMainThread\""),
+            std::string::npos);
+  EXPECT_NE(dump.find("\"arg\": \"copied\""), std::string::npos);
+  EXPECT_NE(dump.find("\"name\": \"FlightRecorderOtherThread\""),
+            std::string::npos);
+  EXPECT_NE(dump.find("\"n\": 7"), std::string::npos);
+}
+
+TEST(EventTracerTest, FlightRecorderKeepsLatestEvents) {
+  if (!rtc::tracing::SetupFlightRecorder()) {
+    GTEST_SKIP() << "Flight recorder not supported.";
+  }
+  // Recorded on a new thread, since a previous test's thread may have left
+  // events in the buffer it reuses.
+  rtc::PlatformThread::SpawnJoinable(
+      [] {
+        for (int i = 0; i < 100000; ++i) {
+          TRACE_EVENT_INSTANT1("test", "FlightRecorderEvent", "i", i);
+        }
+      },
+      "TracingThread");
+  std::string dump = DumpFlightRecorderToString();
+  rtc::tracing::ShutdownFlightRecorder();
+
+  EXPECT_NE(dump.find("\"i\": 99999 }"), std::string::npos);
+  EXPECT_EQ(dump.find("\"i\": 0 }"), std::string::npos);
+}
 #endif
 
 }  // namespace webrtc
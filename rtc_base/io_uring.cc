@@ -0,0 +1,225 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/io_uring.h"
+
+#if defined(WEBRTC_USE_IO_URING)
+
+#include <endian.h>
+#include <errno.h>
+#include <linux/swab.h>
+#include <linux/time_types.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace rtc {
+
+namespace {
+
+// Completion queue entries per submission queue entry. Each socket has at
+// most one poll outstanding, so this bounds the number of sockets rather
+// than the batch size.
+constexpr unsigned kCqEntriesPerSqEntry = 8;
+
+// Features this class relies on:
+// - a single mmap for both rings (Linux 5.4),
+// - no dropped completions when the completion queue overflows (5.5),
+// - timeouts passed to io_uring_enter() (5.11).
+constexpr uint32_t kRequiredFeatures =
+    IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_EXT_ARG;
+
+template <typename T>
+T* RingPointer(void* ring, uint32_t offset) {
+  return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+}
+
+}  // namespace
+
+std::unique_ptr<IoUring> IoUring::Create(unsigned entries) {
+  io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  params.flags = IORING_SETUP_CQSIZE;
+  params.cq_entries = entries * kCqEntriesPerSqEntry;
+  int ring_fd =
+      static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+  if (ring_fd < 0) {
+    RTC_LOG_E(LS_WARNING, EN, errno) << "io_uring_setup";
+    return nullptr;
+  }
+  if ((params.features & kRequiredFeatures) != kRequiredFeatures) {
+    RTC_LOG(LS_WARNING) << "io_uring lacks required features, has "
+                        << params.features;
+    close(ring_fd);
+    return nullptr;
+  }
+
+  size_t ring_size =
+      std::max(params.sq_off.array + params.sq_entries * sizeof(unsigned),
+               params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+  void* ring = mmap(nullptr, ring_size, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING);
+  if (ring == MAP_FAILED) {
+    RTC_LOG_E(LS_WARNING, EN, errno) << "mmap io_uring rings";
+    close(ring_fd);
+    return nullptr;
+  }
+  size_t sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+  void* sqes = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    RTC_LOG_E(LS_WARNING, EN, errno) << "mmap io_uring entries";
+    munmap(ring, ring_size);
+    close(ring_fd);
+    return nullptr;
+  }
+  return std::unique_ptr<IoUring>(
+      new IoUring(ring_fd, params, ring, ring_size,
+                  static_cast<io_uring_sqe*>(sqes), sqes_size));
+}
+
+IoUring::IoUring(int ring_fd,
+                 const io_uring_params& params,
+                 void* ring,
+                 size_t ring_size,
+                 io_uring_sqe* sqes,
+                 size_t sqes_size)
+    : ring_fd_(ring_fd),
+      ring_(ring),
+      ring_size_(ring_size),
+      sqes_(sqes),
+      sqes_size_(sqes_size),
+      sq_entries_(params.sq_entries),
+      sq_head_(RingPointer<unsigned>(ring, params.sq_off.head)),
+      sq_tail_(RingPointer<unsigned>(ring, params.sq_off.tail)),
+      sq_mask_(*RingPointer<unsigned>(ring, params.sq_off.ring_mask)),
+      cq_head_(RingPointer<unsigned>(ring, params.cq_off.head)),
+      cq_tail_(RingPointer<unsigned>(ring, params.cq_off.tail)),
+      cq_mask_(*RingPointer<unsigned>(ring, params.cq_off.ring_mask)),
+      cqes_(RingPointer<io_uring_cqe>(ring, params.cq_off.cqes)),
+      sq_tail_local_(*sq_tail_) {
+  // Submission queue entries are always used in ring order, so the
+  // indirection array maps each slot to itself.
+  unsigned* sq_array = RingPointer<unsigned>(ring, params.sq_off.array);
+  for (unsigned i = 0; i < sq_entries_; ++i) {
+    sq_array[i] = i;
+  }
+}
+
+IoUring::~IoUring() {
+  munmap(sqes_, sqes_size_);
+  munmap(ring_, ring_size_);
+  close(ring_fd_);
+}
+
+void IoUring::QueuePollAdd(int fd, uint32_t poll_mask, uint64_t user_data) {
+  webrtc::MutexLock lock(&sq_mutex_);
+  io_uring_sqe* sqe = GetSqe();
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = fd;
+#if __BYTE_ORDER == __BIG_ENDIAN
+  // The kernel reads the mask as two swapped 16 bit halves.
+  poll_mask = __swahw32(poll_mask);
+#endif
+  sqe->poll32_events = poll_mask;
+  sqe->user_data = user_data;
+  __atomic_store_n(sq_tail_, ++sq_tail_local_, __ATOMIC_RELEASE);
+}
+
+void IoUring::QueuePollRemove(uint64_t user_data) {
+  webrtc::MutexLock lock(&sq_mutex_);
+  io_uring_sqe* sqe = GetSqe();
+  sqe->opcode = IORING_OP_POLL_REMOVE;
+  sqe->fd = -1;
+  sqe->addr = user_data;
+  sqe->user_data = kIgnoredUserData;
+  __atomic_store_n(sq_tail_, ++sq_tail_local_, __ATOMIC_RELEASE);
+}
+
+int IoUring::Submit() {
+  unsigned to_submit;
+  {
+    webrtc::MutexLock lock(&sq_mutex_);
+    to_submit = PendingSqes();
+  }
+  if (to_submit == 0) {
+    return 0;
+  }
+  return Enter(to_submit, 0, 0, nullptr, 0);
+}
+
+int IoUring::Wait(int timeout_ms) {
+  unsigned to_submit;
+  {
+    webrtc::MutexLock lock(&sq_mutex_);
+    to_submit = PendingSqes();
+  }
+  __kernel_timespec timeout = {};
+  io_uring_getevents_arg arg = {};
+  if (timeout_ms >= 0) {
+    timeout.tv_sec = timeout_ms / 1000;
+    timeout.tv_nsec = (timeout_ms % 1000) * 1000000LL;
+    arg.ts = reinterpret_cast<uint64_t>(&timeout);
+  }
+  return Enter(to_submit, 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG,
+               &arg, sizeof(arg));
+}
+
+size_t IoUring::ReapCompletions(
+    FunctionView<void(uint64_t user_data, int32_t result)> handler) {
+  // Only this thread moves the head, so it can be read without ordering.
+  unsigned head = *cq_head_;
+  const unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+  size_t count = 0;
+  for (; head != tail; ++head, ++count) {
+    const io_uring_cqe& cqe = cqes_[head & cq_mask_];
+    handler(cqe.user_data, cqe.res);
+  }
+  __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+  return count;
+}
+
+io_uring_sqe* IoUring::GetSqe() {
+  if (PendingSqes() == sq_entries_) {
+    // Full; without SQPOLL the kernel consumes the queue synchronously.
+    Enter(sq_entries_, 0, 0, nullptr, 0);
+    RTC_CHECK_LT(PendingSqes(), sq_entries_);
+  }
+  io_uring_sqe* sqe = &sqes_[sq_tail_local_ & sq_mask_];
+  memset(sqe, 0, sizeof(*sqe));
+  return sqe;
+}
+
+unsigned IoUring::PendingSqes() {
+  return sq_tail_local_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+}
+
+int IoUring::Enter(unsigned to_submit,
+                   unsigned min_complete,
+                   unsigned flags,
+                   const void* arg,
+                   size_t arg_size) {
+  // Several threads may submit at once; the kernel serializes them and
+  // consumes each queued entry once, however many `to_submit` claims.
+  int result = static_cast<int>(syscall(__NR_io_uring_enter, ring_fd_,
+                                        to_submit, min_complete, flags, arg,
+                                        arg_size));
+  return result < 0 ? -errno : result;
+}
+
+}  // namespace rtc
+
+#endif  // WEBRTC_USE_IO_URING
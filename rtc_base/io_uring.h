@@ -0,0 +1,118 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_IO_URING_H_
+#define RTC_BASE_IO_URING_H_
+
+#if defined(WEBRTC_LINUX) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define WEBRTC_USE_IO_URING 1
+#endif
+#endif
+
+#if defined(WEBRTC_USE_IO_URING)
+
+#include <linux/io_uring.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+
+#include "api/function_view.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace rtc {
+
+// A minimal io_uring instance, driven through the raw system calls so that
+// no liburing dependency is needed. Only the requests that
+// PhysicalSocketServer uses are supported.
+//
+// Requests can be queued from any thread. They reach the kernel with the
+// next Submit() or Wait() call, so that the requests queued while handling
+// one batch of completions are all submitted together with the next wait.
+// Wait() and ReapCompletions() must only be called by one thread at a time.
+class IoUring {
+ public:
+  // User data of completions that carry no information, such as those of
+  // QueuePollRemove() requests; callers shouldn't use it for other requests.
+  static constexpr uint64_t kIgnoredUserData = 0;
+
+  // Returns null if the kernel doesn't support io_uring, or lacks a feature
+  // this class relies on (Linux 5.11 or later is needed).
+  static std::unique_ptr<IoUring> Create(unsigned entries);
+  ~IoUring();
+
+  IoUring(const IoUring&) = delete;
+  IoUring& operator=(const IoUring&) = delete;
+
+  // Queues a one-shot poll for `poll_mask` (POLLIN, POLLOUT, ...) on `fd`.
+  // Its completion result is the mask of ready events, or a negative errno.
+  void QueuePollAdd(int fd, uint32_t poll_mask, uint64_t user_data);
+  // Queues the cancellation of the poll with `user_data`, if it is still
+  // pending. Cancelled polls complete with -ECANCELED.
+  void QueuePollRemove(uint64_t user_data);
+
+  // Submits the queued requests without waiting. Returns the number of
+  // requests submitted, or a negative errno.
+  int Submit();
+  // Submits the queued requests and waits up to `timeout_ms` (-1 for no
+  // timeout) for a completion. Returns a negative errno on failure, -ETIME
+  // on timeout and -EINTR if interrupted by a signal.
+  int Wait(int timeout_ms);
+
+  // Calls `handler` with the user data and result of each available
+  // completion, and returns how many there were.
+  size_t ReapCompletions(
+      FunctionView<void(uint64_t user_data, int32_t result)> handler);
+
+ private:
+  IoUring(int ring_fd,
+          const io_uring_params& params,
+          void* ring,
+          size_t ring_size,
+          io_uring_sqe* sqes,
+          size_t sqes_size);
+
+  // Returns a cleared submission queue entry, submitting queued requests
+  // first if the queue is full.
+  io_uring_sqe* GetSqe() RTC_EXCLUSIVE_LOCKS_REQUIRED(sq_mutex_);
+  int Enter(unsigned to_submit,
+            unsigned min_complete,
+            unsigned flags,
+            const void* arg,
+            size_t arg_size);
+  unsigned PendingSqes() RTC_EXCLUSIVE_LOCKS_REQUIRED(sq_mutex_);
+
+  const int ring_fd_;
+  void* const ring_;
+  const size_t ring_size_;
+  io_uring_sqe* const sqes_;
+  const size_t sqes_size_;
+  const unsigned sq_entries_;
+
+  // Pointers into the rings shared with the kernel.
+  unsigned* const sq_head_;
+  unsigned* const sq_tail_;
+  const unsigned sq_mask_;
+  unsigned* const cq_head_;
+  unsigned* const cq_tail_;
+  const unsigned cq_mask_;
+  io_uring_cqe* const cqes_;
+
+  webrtc::Mutex sq_mutex_;
+  unsigned sq_tail_local_ RTC_GUARDED_BY(sq_mutex_);
+};
+
+}  // namespace rtc
+
+#endif  // WEBRTC_USE_IO_URING
+
+#endif  // RTC_BASE_IO_URING_H_
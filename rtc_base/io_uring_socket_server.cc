@@ -0,0 +1,31 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/io_uring_socket_server.h"
+
+#include "rtc_base/io_uring.h"
+
+namespace rtc {
+
+IoUringSocketServer::IoUringSocketServer()
+    : PhysicalSocketServer(/*use_io_uring=*/true) {}
+
+IoUringSocketServer::~IoUringSocketServer() = default;
+
+// static
+bool IoUringSocketServer::IsSupported() {
+#if defined(WEBRTC_USE_IO_URING)
+  return IoUring::Create(/*entries=*/1) != nullptr;
+#else
+  return false;
+#endif
+}
+
+}  // namespace rtc
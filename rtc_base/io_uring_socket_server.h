@@ -0,0 +1,42 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_IO_URING_SOCKET_SERVER_H_
+#define RTC_BASE_IO_URING_SOCKET_SERVER_H_
+
+#include "rtc_base/physical_socket_server.h"
+#include "rtc_base/system/rtc_export.h"
+
+namespace rtc {
+
+// A PhysicalSocketServer that waits for socket events with io_uring on Linux
+// 5.11 and later, and behaves like PhysicalSocketServer everywhere else.
+// Socket readiness changes are batched into the submission queue and handed
+// to the kernel with a single system call per wait, which saves the
+// epoll_ctl() call per change on threads with many busy sockets. To use it
+// for a network thread:
+//
+//   auto network_thread = std::make_unique<rtc::Thread>(
+//       std::make_unique<rtc::IoUringSocketServer>());
+class RTC_EXPORT IoUringSocketServer : public PhysicalSocketServer {
+ public:
+  IoUringSocketServer();
+  ~IoUringSocketServer() override;
+
+  // Whether the running kernel supports what IoUringSocketServer needs.
+  static bool IsSupported();
+
+  // False if io_uring is unavailable and the server fell back to epoll.
+  using PhysicalSocketServer::uses_io_uring;
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_IO_URING_SOCKET_SERVER_H_
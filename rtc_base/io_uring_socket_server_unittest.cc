@@ -0,0 +1,102 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/io_uring_socket_server.h"
+
+#include "rtc_base/logging.h"
+#include "rtc_base/socket_unittest.h"
+#include "rtc_base/thread.h"
+#include "test/gtest.h"
+
+namespace rtc {
+
+class IoUringSocketServerTest : public SocketTest {
+ protected:
+  IoUringSocketServerTest() : SocketTest(&server_), thread_(&server_) {}
+
+  // Returns false, and the test should return, if the kernel lacks
+  // io_uring and `server_` just duplicates PhysicalSocketServer.
+  bool CheckSupported() {
+    if (!server_.uses_io_uring()) {
+      RTC_LOG(LS_WARNING) << "io_uring unsupported, skipping test.";
+      return false;
+    }
+    return true;
+  }
+
+  IoUringSocketServer server_;
+  rtc::AutoSocketServerThread thread_;
+};
+
+TEST_F(IoUringSocketServerTest, UsesIoUringWhenSupported) {
+  EXPECT_EQ(IoUringSocketServer::IsSupported(), server_.uses_io_uring());
+}
+
+TEST_F(IoUringSocketServerTest, TestConnectIPv4) {
+  if (CheckSupported()) {
+    SocketTest::TestConnectIPv4();
+  }
+}
+
+TEST_F(IoUringSocketServerTest, TestConnectFailIPv4) {
+  if (CheckSupported()) {
+    SocketTest::TestConnectFailIPv4();
+  }
+}
+
+TEST_F(IoUringSocketServerTest, TestServerCloseIPv4) {
+  if (CheckSupported()) {
+    SocketTest::TestServerCloseIPv4();
+  }
+}
+
+TEST_F(IoUringSocketServerTest, TestCloseInClosedCallbackIPv4) {
+  if (CheckSupported()) {
+    SocketTest::TestCloseInClosedCallbackIPv4();
+  }
+}
+
+TEST_F(IoUringSocketServerTest, TestDeleteInReadCallbackIPv4) {
+  if (CheckSupported()) {
+    SocketTest::TestDeleteInReadCallbackIPv4();
+  }
+}
+
+TEST_F(IoUringSocketServerTest, TestSocketServerWaitIPv4) {
+  if (CheckSupported()) {
+    SocketTest::TestSocketServerWaitIPv4();
+  }
+}
+
+TEST_F(IoUringSocketServerTest, TestTcpIPv4) {
+  if (CheckSupported()) {
+    SocketTest::TestTcpIPv4();
+  }
+}
+
+TEST_F(IoUringSocketServerTest, TestSingleFlowControlCallbackIPv4) {
+  if (CheckSupported()) {
+    SocketTest::TestSingleFlowControlCallbackIPv4();
+  }
+}
+
+TEST_F(IoUringSocketServerTest, TestUdpIPv4) {
+  if (CheckSupported()) {
+    SocketTest::TestUdpIPv4();
+  }
+}
+
+TEST_F(IoUringSocketServerTest, TestUdpReadyToSendIPv4) {
+  if (CheckSupported()) {
+    SocketTest::TestUdpReadyToSendIPv4();
+  }
+}
+
+}  // namespace rtc
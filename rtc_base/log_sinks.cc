@@ -19,6 +19,11 @@
 
 namespace rtc {
 
+namespace {
+// Batches larger than this are written before the batch ends.
+constexpr size_t kMaxBatchSize = 64 * 1024;
+}  // namespace
+
 FileRotatingLogSink::FileRotatingLogSink(const std::string& log_dir_path,
                                          const std::string& log_prefix,
                                          size_t max_log_size,
@@ -33,13 +38,21 @@ FileRotatingLogSink::FileRotatingLogSink(FileRotatingStream* stream)
   RTC_DCHECK(stream);
 }
 
-FileRotatingLogSink::~FileRotatingLogSink() {}
+FileRotatingLogSink::~FileRotatingLogSink() {
+  WriteBatch();
+}
 
 void FileRotatingLogSink::OnLogMessage(const std::string& message) {
   if (!stream_->IsOpen()) {
     std::fprintf(stderr, "Init() must be called before adding this sink.\n");
     return;
   }
+  if (batching_) {
+    batch_.append(message);
+    if (batch_.size() >= kMaxBatchSize)
+      WriteBatch();
+    return;
+  }
   stream_->Write(message.c_str(), message.size());
 }
 
@@ -50,11 +63,28 @@ void FileRotatingLogSink::OnLogMessage(const std::string& message,
     std::fprintf(stderr, "Init() must be called before adding this sink.\n");
     return;
   }
+  if (batching_) {
+    batch_.append(tag).append(": ").append(message);
+    if (batch_.size() >= kMaxBatchSize)
+      WriteBatch();
+    return;
+  }
   stream_->Write(tag, strlen(tag));
   stream_->Write(": ", 2);
   stream_->Write(message.c_str(), message.size());
 }
 
+void FileRotatingLogSink::OnLogBatchEnd() {
+  WriteBatch();
+}
+
+void FileRotatingLogSink::WriteBatch() {
+  if (batch_.empty())
+    return;
+  stream_->Write(batch_.data(), batch_.size());
+  batch_.clear();
+}
+
 bool FileRotatingLogSink::Init() {
   return stream_->Open();
 }
@@ -63,6 +93,10 @@ bool FileRotatingLogSink::DisableBuffering() {
   return stream_->DisableBuffering();
 }
 
+void FileRotatingLogSink::EnableBatching() {
+  batching_ = true;
+}
+
 CallSessionFileRotatingLogSink::CallSessionFileRotatingLogSink(
     const std::string& log_dir_path,
     size_t max_total_log_size)
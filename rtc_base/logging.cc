@@ -37,11 +37,21 @@ static const int kMaxLogLineSize = 1024 - 60;
 #include <stdio.h>
 #include <time.h>
 
+#if defined(WEBRTC_POSIX)
+#include <pthread.h>
+#endif
+
 #include <algorithm>
+#include <atomic>
 #include <cstdarg>
+#include <string>
+#include <type_traits>
 #include <vector>
 
 #include "absl/base/attributes.h"
+#include "absl/base/config.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/platform_thread_types.h"
 #include "rtc_base/string_encode.h"
@@ -82,6 +92,24 @@ webrtc::Mutex& GetLoggingLock() {
 
 }  // namespace
 
+namespace webrtc_logging_impl {
+
+// The part of a message that is known before its arguments are streamed.
+struct LogRecordHeader {
+  const char* file;
+  int line;
+  LoggingSeverity severity;
+  LogErrorContext err_ctx;
+  int err;
+  // Android tag, or null for the default tag.
+  const char* tag;
+  // Only set if timestamps and threads are logged, respectively.
+  absl::optional<int64_t> time_ms;
+  absl::optional<PlatformThreadId> thread_id;
+};
+
+}  // namespace webrtc_logging_impl
+
 /////////////////////////////////////////////////////////////////////////////
 // LogMessage
 /////////////////////////////////////////////////////////////////////////////
@@ -107,14 +135,42 @@ LogMessage::LogMessage(const char* file,
                        LoggingSeverity sev,
                        LogErrorContext err_ctx,
                        int err)
-    : severity_(sev) {
+    : LogMessage(MakeRecordHeader(file, line, sev, err_ctx, err, nullptr)) {}
+
+// static
+webrtc_logging_impl::LogRecordHeader LogMessage::MakeRecordHeader(
+    const char* file,
+    int line,
+    LoggingSeverity sev,
+    LogErrorContext err_ctx,
+    int err,
+    const char* tag) {
+  webrtc_logging_impl::LogRecordHeader header = {file, line, sev,
+                                                 err_ctx, err, tag};
   if (timestamp_) {
     // Use SystemTimeMillis so that even if tests use fake clocks, the timestamp
     // in log messages represents the real system time.
-    int64_t time = TimeDiff(SystemTimeMillis(), LogStartTime());
-    // Also ensure WallClockStartTime is initialized, so that it matches
-    // LogStartTime.
+    header.time_ms = SystemTimeMillis();
+    // Also ensure LogStartTime and WallClockStartTime are initialized, so that
+    // they match.
+    LogStartTime();
     WallClockStartTime();
+  }
+  if (thread_) {
+    header.thread_id = CurrentThreadId();
+  }
+  return header;
+}
+
+LogMessage::LogMessage(const webrtc_logging_impl::LogRecordHeader& header)
+    : severity_(header.severity) {
+  const char* file = header.file;
+  const int line = header.line;
+  const LogErrorContext err_ctx = header.err_ctx;
+  const int err = header.err;
+
+  if (header.time_ms) {
+    int64_t time = TimeDiff(*header.time_ms, LogStartTime());
     // TODO(kwiberg): Switch to absl::StrFormat, if binary size is ok.
     char timestamp[50];  // Maximum string length of an int64_t is 20.
     int len =
@@ -124,9 +180,8 @@ LogMessage::LogMessage(const char* file,
     print_stream_ << timestamp;
   }
 
-  if (thread_) {
-    PlatformThreadId id = CurrentThreadId();
-    print_stream_ << "[" << id << "] ";
+  if (header.thread_id) {
+    print_stream_ << "[" << *header.thread_id << "] ";
   }
 
   if (file != nullptr) {
@@ -138,6 +193,10 @@ LogMessage::LogMessage(const char* file,
 #endif
   }
 
+  if (header.tag) {
+    AddTag(header.tag);
+  }
+
   if (err_ctx != ERRCTX_NONE) {
     char tmp_buf[1024];
     SimpleStringBuilder tmp(tmp_buf);
@@ -193,6 +252,9 @@ LogMessage::LogMessage(const char* file,
 }
 
 LogMessage::~LogMessage() {
+  if (!output_when_destroyed_)
+    return;
+
   FinishPrintStream();
 
   const std::string str = print_stream_.Release();
@@ -206,17 +268,45 @@ LogMessage::~LogMessage() {
   }
 
   webrtc::MutexLock lock(&GetLoggingLock());
+#if defined(WEBRTC_ANDROID)
+  OutputToSinks(str, severity_, tag_);
+#else
+  OutputToSinks(str, severity_, nullptr);
+#endif
+  EndSinkBatches();
+}
+
+std::string LogMessage::TakeMessage() {
+  RTC_DCHECK(output_when_destroyed_);
+  output_when_destroyed_ = false;
+  FinishPrintStream();
+  return print_stream_.Release();
+}
+
+// static
+void LogMessage::OutputToSinks(const std::string& str,
+                               LoggingSeverity severity,
+                               const char* tag)
+    RTC_EXCLUSIVE_LOCKS_REQUIRED(GetLoggingLock()) {
   for (LogSink* entry = streams_; entry != nullptr; entry = entry->next_) {
-    if (severity_ >= entry->min_severity_) {
+    if (severity >= entry->min_severity_) {
 #if defined(WEBRTC_ANDROID)
-      entry->OnLogMessage(str, severity_, tag_);
+      entry->OnLogMessage(str, severity, tag);
 #else
-      entry->OnLogMessage(str, severity_);
+      entry->OnLogMessage(str, severity);
 #endif
     }
   }
 }
 
+// static
+void LogMessage::EndSinkBatches()
+    RTC_EXCLUSIVE_LOCKS_REQUIRED(GetLoggingLock()) {
+  for (LogSink* entry = streams_; entry != nullptr; entry = entry->next_) {
+    entry->OnLogBatchEnd();
+  }
+}
+
 void LogMessage::AddTag(const char* tag) {
 #ifdef WEBRTC_ANDROID
   tag_ = tag;
@@ -459,6 +549,461 @@ void LogMessage::FinishPrintStream() {
 }
 
 namespace webrtc_logging_impl {
+namespace {
+
+// A ring of encoded records with a single producer, the thread that owns it,
+// and a single consumer at a time, the thread delivering messages. Each
+// record is stored as its uint32_t size followed by its bytes, and may wrap
+// around the end of the ring.
+class AsyncLogBuffer {
+ public:
+  static constexpr size_t kCapacity = 64 * 1024;
+
+  // Called by the producer. Returns false if the record doesn't fit.
+  bool Write(const std::string& record) {
+    const uint32_t size = static_cast<uint32_t>(record.size());
+    const size_t write_pos = write_pos_.load(std::memory_order_relaxed);
+    const size_t read_pos = read_pos_.load(std::memory_order_acquire);
+    if (sizeof(size) + size > kCapacity - (write_pos - read_pos)) {
+      return false;
+    }
+    CopyIn(write_pos, &size, sizeof(size));
+    CopyIn(write_pos + sizeof(size), record.data(), size);
+    write_pos_.store(write_pos + sizeof(size) + size,
+                     std::memory_order_release);
+    return true;
+  }
+
+  // Called by the consumer. Returns false if the ring is empty.
+  bool Read(std::string* record) {
+    const size_t read_pos = read_pos_.load(std::memory_order_relaxed);
+    const size_t write_pos = write_pos_.load(std::memory_order_acquire);
+    if (read_pos == write_pos) {
+      return false;
+    }
+    uint32_t size;
+    CopyOut(read_pos, &size, sizeof(size));
+    record->resize(size);
+    CopyOut(read_pos + sizeof(size), &(*record)[0], size);
+    read_pos_.store(read_pos + sizeof(size) + size, std::memory_order_release);
+    return true;
+  }
+
+  // Only used by the producer, to encode records without allocating.
+  std::string scratch;
+  // Messages the producer dropped because the ring was full.
+  std::atomic<int> dropped{0};
+  // Set when the producer thread has exited; the buffer is deleted once
+  // drained.
+  std::atomic<bool> orphaned{false};
+  // Next buffer in the list of all buffers.
+  AsyncLogBuffer* next = nullptr;
+
+ private:
+  // Positions grow without bound and are taken modulo kCapacity when used.
+  void CopyIn(size_t pos, const void* src, size_t size) {
+    const size_t offset = pos % kCapacity;
+    const size_t first = std::min(size, kCapacity - offset);
+    memcpy(data_ + offset, src, first);
+    memcpy(data_, static_cast<const char*>(src) + first, size - first);
+  }
+  void CopyOut(size_t pos, void* dst, size_t size) const {
+    const size_t offset = pos % kCapacity;
+    const size_t first = std::min(size, kCapacity - offset);
+    memcpy(dst, data_ + offset, first);
+    memcpy(static_cast<char*>(dst) + first, data_, size - first);
+  }
+
+  std::atomic<size_t> write_pos_{0};
+  std::atomic<size_t> read_pos_{0};
+  char data_[kCapacity];
+};
+
+std::atomic<bool> g_async_logging{false};
+
+// Guards the list of buffers.
+webrtc::Mutex& GetAsyncBuffersLock() {
+  static webrtc::Mutex& mutex = *new webrtc::Mutex();
+  return mutex;
+}
+
+AsyncLogBuffer* g_async_buffers RTC_GUARDED_BY(GetAsyncBuffersLock()) =
+    nullptr;
+
+// Serializes the consumers of the buffers.
+webrtc::Mutex& GetAsyncDeliveryLock() {
+  static webrtc::Mutex& mutex = *new webrtc::Mutex();
+  return mutex;
+}
+
+// Serializes starting and stopping the delivery thread.
+webrtc::Mutex& GetAsyncControlLock() {
+  static webrtc::Mutex& mutex = *new webrtc::Mutex();
+  return mutex;
+}
+
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+
+// Marks the buffer of a thread as orphaned when the thread exits.
+struct AsyncLogBufferOwner {
+  constexpr AsyncLogBufferOwner() = default;
+  ~AsyncLogBufferOwner();
+
+  AsyncLogBuffer* buffer = nullptr;
+};
+
+ABSL_CONST_INIT thread_local AsyncLogBufferOwner tls_async_buffer;
+// Set once `tls_async_buffer` is destroyed at thread exit; messages logged
+// after that are output synchronously.
+ABSL_CONST_INIT thread_local bool tls_async_buffer_destroyed = false;
+
+AsyncLogBufferOwner::~AsyncLogBufferOwner() {
+  if (buffer) {
+    buffer->orphaned.store(true, std::memory_order_release);
+  }
+  tls_async_buffer_destroyed = true;
+}
+
+#endif  // defined(ABSL_HAVE_THREAD_LOCAL)
+
+template <typename T>
+void AppendRaw(std::string* record, const T& value) {
+  static_assert(std::is_trivially_copyable<T>::value, "");
+  record->append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+T ReadRaw(const char** pos) {
+  static_assert(std::is_trivially_copyable<T>::value, "");
+  T value;
+  memcpy(&value, *pos, sizeof(value));
+  *pos += sizeof(value);
+  return value;
+}
+
+void AppendString(std::string* record, absl::string_view str) {
+  AppendRaw(record, static_cast<uint32_t>(str.size()));
+  record->append(str.data(), str.size());
+}
+
+absl::string_view ReadString(const char** pos) {
+  const uint32_t size = ReadRaw<uint32_t>(pos);
+  absl::string_view str(*pos, size);
+  *pos += size;
+  return str;
+}
+
+constexpr int kAsyncDeliveryIntervalMs = 10;
+
+void SleepMs(int ms) {
+#if defined(WEBRTC_WIN)
+  ::Sleep(ms);
+#else
+  timespec ts;
+  ts.tv_sec = ms / 1000;
+  ts.tv_nsec = (ms % 1000) * 1000000;
+  nanosleep(&ts, nullptr);
+#endif
+}
+
+}  // namespace
+
+// Implements asynchronous logging. The RTC_LOG() arguments of a message are
+// encoded, as they are, in a record that is written to a ring buffer of the
+// logging thread; copying a string is the most expensive part. A background
+// thread, or FlushAsyncLogging(), decodes the records and formats and outputs
+// the messages like LogMessage does.
+//
+// The background thread is a plain OS thread rather than an rtc::Thread or a
+// task queue, which are built on top of logging, and polls the buffers
+// instead of being woken up by an rtc::Event for the same reason.
+class AsyncLogger {
+ public:
+  // Encodes a message into the buffer of the calling thread. Returns false if
+  // the message must be output synchronously instead.
+  static bool TryLog(const LogMetadataErr& meta,
+                     const char* tag,
+                     const LogArgType* fmt,
+                     va_list args);
+  // Outputs the messages in all buffers. Returns false if there were none.
+  static bool Deliver();
+  static void Start();
+  static void Stop();
+
+ private:
+  static void DeliveryLoop();
+#if defined(WEBRTC_WIN)
+  static DWORD WINAPI DeliveryThread(void* param);
+  static HANDLE thread_ RTC_GUARDED_BY(GetAsyncControlLock());
+#else
+  static void* DeliveryThread(void* param);
+  static pthread_t thread_ RTC_GUARDED_BY(GetAsyncControlLock());
+#endif
+  static std::atomic<bool> running_;
+};
+
+#if defined(WEBRTC_WIN)
+HANDLE AsyncLogger::thread_ = nullptr;
+#else
+pthread_t AsyncLogger::thread_;
+#endif
+std::atomic<bool> AsyncLogger::running_{false};
+
+bool AsyncLogger::TryLog(const LogMetadataErr& meta,
+                         const char* tag,
+                         const LogArgType* fmt,
+                         va_list args) {
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+  if (!g_async_logging.load(std::memory_order_relaxed) ||
+      tls_async_buffer_destroyed) {
+    return false;
+  }
+  AsyncLogBuffer* buffer = tls_async_buffer.buffer;
+  if (buffer == nullptr) {
+    buffer = new AsyncLogBuffer();
+    tls_async_buffer.buffer = buffer;
+    webrtc::MutexLock lock(&GetAsyncBuffersLock());
+    buffer->next = g_async_buffers;
+    g_async_buffers = buffer;
+  }
+
+  std::string& record = buffer->scratch;
+  record.clear();
+  AppendRaw(&record, LogMessage::MakeRecordHeader(
+                         meta.meta.File(), meta.meta.Line(),
+                         meta.meta.Severity(), meta.err_ctx, meta.err, tag));
+  for (; *fmt != LogArgType::kEnd; ++fmt) {
+    AppendRaw(&record, *fmt);
+    switch (*fmt) {
+      case LogArgType::kInt:
+        AppendRaw(&record, va_arg(args, int));
+        break;
+      case LogArgType::kLong:
+        AppendRaw(&record, va_arg(args, long));
+        break;
+      case LogArgType::kLongLong:
+        AppendRaw(&record, va_arg(args, long long));
+        break;
+      case LogArgType::kUInt:
+        AppendRaw(&record, va_arg(args, unsigned));
+        break;
+      case LogArgType::kULong:
+        AppendRaw(&record, va_arg(args, unsigned long));
+        break;
+      case LogArgType::kULongLong:
+        AppendRaw(&record, va_arg(args, unsigned long long));
+        break;
+      case LogArgType::kDouble:
+        AppendRaw(&record, va_arg(args, double));
+        break;
+      case LogArgType::kLongDouble:
+        AppendRaw(&record, va_arg(args, long double));
+        break;
+      case LogArgType::kCharP: {
+        const char* s = va_arg(args, const char*);
+        AppendString(&record, s ? s : "(null)");
+        break;
+      }
+      case LogArgType::kStdString:
+        AppendString(&record, *va_arg(args, const std::string*));
+        break;
+      case LogArgType::kStringView:
+        AppendString(&record, *va_arg(args, const absl::string_view*));
+        break;
+      case LogArgType::kVoidP:
+        AppendRaw(&record,
+                  reinterpret_cast<uintptr_t>(va_arg(args, const void*)));
+        break;
+      default:
+        RTC_DCHECK_NOTREACHED();
+        return false;
+    }
+  }
+  AppendRaw(&record, LogArgType::kEnd);
+
+  if (!buffer->Write(record)) {
+    buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool AsyncLogger::Deliver() {
+  struct Message {
+    std::string str;
+    LoggingSeverity severity;
+    const char* tag;
+  };
+  // Held while outputting too, so that concurrent calls output the messages
+  // of a thread in order, and so that messages are output when
+  // FlushAsyncLogging() returns.
+  webrtc::MutexLock delivery_lock(&GetAsyncDeliveryLock());
+  std::vector<Message> messages;
+  std::vector<AsyncLogBuffer*> buffers;
+  {
+    webrtc::MutexLock lock(&GetAsyncBuffersLock());
+    for (AsyncLogBuffer* buffer = g_async_buffers; buffer != nullptr;
+         buffer = buffer->next) {
+      buffers.push_back(buffer);
+    }
+  }
+
+  std::string record;
+  std::vector<AsyncLogBuffer*> drained_orphans;
+  for (AsyncLogBuffer* buffer : buffers) {
+    // Read before draining, so that the buffer is known to get no more
+    // records once drained.
+    const bool orphaned = buffer->orphaned.load(std::memory_order_acquire);
+    while (buffer->Read(&record)) {
+      const char* pos = record.data();
+      const LogRecordHeader header = ReadRaw<LogRecordHeader>(&pos);
+      LogMessage msg(header);
+      for (LogArgType type = ReadRaw<LogArgType>(&pos);
+           type != LogArgType::kEnd; type = ReadRaw<LogArgType>(&pos)) {
+        switch (type) {
+          case LogArgType::kInt:
+            msg.stream() << ReadRaw<int>(&pos);
+            break;
+          case LogArgType::kLong:
+            msg.stream() << ReadRaw<long>(&pos);
+            break;
+          case LogArgType::kLongLong:
+            msg.stream() << ReadRaw<long long>(&pos);
+            break;
+          case LogArgType::kUInt:
+            msg.stream() << ReadRaw<unsigned>(&pos);
+            break;
+          case LogArgType::kULong:
+            msg.stream() << ReadRaw<unsigned long>(&pos);
+            break;
+          case LogArgType::kULongLong:
+            msg.stream() << ReadRaw<unsigned long long>(&pos);
+            break;
+          case LogArgType::kDouble:
+            msg.stream() << ReadRaw<double>(&pos);
+            break;
+          case LogArgType::kLongDouble:
+            msg.stream() << ReadRaw<long double>(&pos);
+            break;
+          case LogArgType::kCharP:
+          case LogArgType::kStdString:
+          case LogArgType::kStringView:
+            msg.stream() << ReadString(&pos);
+            break;
+          case LogArgType::kVoidP:
+            msg.stream() << rtc::ToHex(ReadRaw<uintptr_t>(&pos));
+            break;
+          default:
+            RTC_DCHECK_NOTREACHED();
+            break;
+        }
+      }
+#if defined(WEBRTC_ANDROID)
+      const char* tag = msg.tag_;
+#else
+      const char* tag = nullptr;
+#endif
+      messages.push_back({msg.TakeMessage(), header.severity, tag});
+    }
+    const int dropped = buffer->dropped.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) {
+      LogMessage msg(LogMessage::MakeRecordHeader(
+          __FILE__, __LINE__, LS_WARNING, ERRCTX_NONE, 0, nullptr));
+      msg.stream() << dropped << " log messages dropped";
+      messages.push_back({msg.TakeMessage(), LS_WARNING, nullptr});
+    }
+    if (orphaned) {
+      drained_orphans.push_back(buffer);
+    }
+  }
+
+  if (!drained_orphans.empty()) {
+    webrtc::MutexLock lock(&GetAsyncBuffersLock());
+    for (AsyncLogBuffer** entry = &g_async_buffers; *entry != nullptr;) {
+      if (std::find(drained_orphans.begin(), drained_orphans.end(),
+                    *entry) != drained_orphans.end()) {
+        AsyncLogBuffer* orphan = *entry;
+        *entry = orphan->next;
+        delete orphan;
+      } else {
+        entry = &(*entry)->next;
+      }
+    }
+  }
+
+  if (messages.empty()) {
+    return false;
+  }
+  for (const Message& message : messages) {
+    if (message.severity >= g_dbg_sev) {
+#if defined(WEBRTC_ANDROID)
+      LogMessage::OutputToDebug(message.str, message.severity, message.tag);
+#else
+      LogMessage::OutputToDebug(message.str, message.severity);
+#endif
+    }
+  }
+  webrtc::MutexLock lock(&GetLoggingLock());
+  for (const Message& message : messages) {
+    LogMessage::OutputToSinks(message.str, message.severity, message.tag);
+  }
+  LogMessage::EndSinkBatches();
+  return true;
+}
+
+void AsyncLogger::DeliveryLoop() {
+  while (running_.load(std::memory_order_acquire)) {
+    if (!Deliver()) {
+      SleepMs(kAsyncDeliveryIntervalMs);
+    }
+  }
+}
+
+#if defined(WEBRTC_WIN)
+DWORD WINAPI AsyncLogger::DeliveryThread(void* param) {
+  DeliveryLoop();
+  return 0;
+}
+#else
+void* AsyncLogger::DeliveryThread(void* param) {
+  DeliveryLoop();
+  return nullptr;
+}
+#endif
+
+void AsyncLogger::Start() {
+  webrtc::MutexLock lock(&GetAsyncControlLock());
+  if (running_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  running_.store(true, std::memory_order_release);
+#if defined(WEBRTC_WIN)
+  thread_ = ::CreateThread(nullptr, 0, &DeliveryThread, nullptr, 0, nullptr);
+  RTC_CHECK(thread_);
+#else
+  RTC_CHECK_EQ(0, pthread_create(&thread_, nullptr, &DeliveryThread, nullptr));
+#endif
+  g_async_logging.store(true, std::memory_order_relaxed);
+}
+
+void AsyncLogger::Stop() {
+  webrtc::MutexLock lock(&GetAsyncControlLock());
+  if (!running_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  g_async_logging.store(false, std::memory_order_relaxed);
+  running_.store(false, std::memory_order_release);
+#if defined(WEBRTC_WIN)
+  ::WaitForSingleObject(thread_, INFINITE);
+  ::CloseHandle(thread_);
+  thread_ = nullptr;
+#else
+  pthread_join(thread_, nullptr);
+#endif
+  Deliver();
+}
 
 void Log(const LogArgType* fmt, ...) {
   va_list args;
@@ -490,6 +1035,16 @@ void Log(const LogArgType* fmt, ...) {
     }
   }
 
+  va_list async_args;
+  va_copy(async_args, args);
+  const bool logged_async =
+      AsyncLogger::TryLog(meta, tag, fmt + 1, async_args);
+  va_end(async_args);
+  if (logged_async) {
+    va_end(args);
+    return;
+  }
+
   LogMessage log_message(meta.meta.File(), meta.meta.Line(),
                          meta.meta.Severity(), meta.err_ctx, meta.err);
   if (tag) {
@@ -548,6 +1103,28 @@ void Log(const LogArgType* fmt, ...) {
 }
 
 }  // namespace webrtc_logging_impl
+
+// static
+void LogMessage::SetAsyncLogging(bool enabled) {
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+  if (enabled) {
+    webrtc_logging_impl::AsyncLogger::Start();
+  } else {
+    webrtc_logging_impl::AsyncLogger::Stop();
+  }
+#endif
+}
+
+// static
+bool LogMessage::IsAsyncLogging() {
+  return webrtc_logging_impl::g_async_logging.load(std::memory_order_relaxed);
+}
+
+// static
+void LogMessage::FlushAsyncLogging() {
+  webrtc_logging_impl::AsyncLogger::Deliver();
+}
+
 }  // namespace rtc
 #endif
 
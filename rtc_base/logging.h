@@ -119,6 +119,11 @@ class LogSink {
   virtual void OnLogMessage(const std::string& message,
                             LoggingSeverity severity);
   virtual void OnLogMessage(const std::string& message) = 0;
+  // Called after a batch of messages has been passed to OnLogMessage(), so
+  // that sinks that buffer messages can write them out together. A batch is
+  // a single message, unless asynchronous logging is enabled, see
+  // LogMessage::SetAsyncLogging().
+  virtual void OnLogBatchEnd() {}
 
  private:
   friend class ::rtc::LogMessage;
@@ -131,6 +136,9 @@ class LogSink {
 
 namespace webrtc_logging_impl {
 
+class AsyncLogger;
+struct LogRecordHeader;
+
 class LogMetadata {
  public:
   LogMetadata(const char* file, int line, LoggingSeverity severity)
@@ -495,6 +503,20 @@ class LogMessage {
   RTC_NO_INLINE static bool IsNoop() {
     return IsNoop(S);
   }
+  // Enables or disables asynchronous logging. When enabled, the RTC_LOG()
+  // macros only copy their arguments into a buffer of the calling thread,
+  // without locking, and a background thread formats the messages and passes
+  // them to the debug output and the sinks, in batches. Messages of a thread
+  // keep their order, but are not ordered with those of other threads, and
+  // are dropped, with a warning, if the thread logs faster than the
+  // background thread keeps up. Messages built with LogMessage directly are
+  // still output synchronously.
+  // Has no effect on platforms without thread_local.
+  static void SetAsyncLogging(bool enabled);
+  static bool IsAsyncLogging();
+  // Outputs all messages that were logged asynchronously before the call,
+  // e.g. before removing a sink that should receive them.
+  static void FlushAsyncLogging();
 #else
   // Next methods do nothing; no one will call these functions.
   LogMessage(const char* file, int line, LoggingSeverity sev) {}
@@ -538,12 +560,41 @@ class LogMessage {
   static constexpr bool IsNoop() {
     return IsNoop(S);
   }
+  inline static void SetAsyncLogging(bool enabled) {}
+  inline static bool IsAsyncLogging() { return false; }
+  inline static void FlushAsyncLogging() {}
 #endif  // RTC_LOG_ENABLED()
 
  private:
   friend class LogMessageForTesting;
+  friend class webrtc_logging_impl::AsyncLogger;
 
 #if RTC_LOG_ENABLED()
+  explicit LogMessage(const webrtc_logging_impl::LogRecordHeader& header);
+
+  // Captures what a message needs from the logging thread: the time and the
+  // thread id, if they are logged.
+  static webrtc_logging_impl::LogRecordHeader MakeRecordHeader(
+      const char* file,
+      int line,
+      LoggingSeverity sev,
+      LogErrorContext err_ctx,
+      int err,
+      const char* tag);
+
+  // Finishes the message and returns it, instead of outputting it when
+  // destroyed.
+  std::string TakeMessage();
+
+  // Passes a finished message to the sinks. Must be called with the logging
+  // lock held.
+  static void OutputToSinks(const std::string& str,
+                            LoggingSeverity severity,
+                            const char* tag);
+  // Calls OnLogBatchEnd() of all sinks. Must be called with the logging lock
+  // held.
+  static void EndSinkBatches();
+
   // Updates min_sev_ appropriately when debug sinks change.
   static void UpdateMinLogSeverity();
 
@@ -572,6 +623,9 @@ class LogMessage {
   // the message before output.
   std::string extra_;
 
+  // False once the message has been taken with TakeMessage().
+  bool output_when_destroyed_ = true;
+
   // The output streams and their associated severities
   static LogSink* streams_;
 
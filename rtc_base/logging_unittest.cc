@@ -295,5 +295,66 @@ TEST(LogTest, NoopSeverityDoesNotRunStringFormatting) {
   EXPECT_FALSE(was_called);
 }
 
+void LogAllTypes() {
+  std::string s = "std::string";
+  const char* null_string = nullptr;
+  void* p = reinterpret_cast<void*>(0xabcd);
+  RTC_LOG(LS_INFO) << "|" << 1 << "|" << 2l << "|" << 3ll << "|" << 4u << "|"
+                   << 5ul << "|" << 6ull << "|" << 7.5 << "|" << s << "|"
+                   << absl::string_view("absl::string_view") << "|" << p
+                   << "|" << null_string << "|";
+}
+
+TEST(LogTest, AsyncLoggingOutputsSameMessageAsSyncLogging) {
+  std::string sync_str;
+  LogSinkImpl sync_stream(&sync_str);
+  LogMessage::AddLogToStream(&sync_stream, LS_INFO);
+  LogAllTypes();
+  LogMessage::RemoveLogToStream(&sync_stream);
+
+  std::string async_str;
+  LogSinkImpl async_stream(&async_str);
+  LogMessage::AddLogToStream(&async_stream, LS_INFO);
+  LogMessage::SetAsyncLogging(true);
+  LogAllTypes();
+  LogMessage::FlushAsyncLogging();
+  LogMessage::SetAsyncLogging(false);
+  LogMessage::RemoveLogToStream(&async_stream);
+
+  EXPECT_NE(std::string::npos, sync_str.find("|7.5|"));
+  EXPECT_EQ(sync_str, async_str);
+}
+
+TEST(LogTest, AsyncLoggingKeepsOrderOfMessagesOfAThread) {
+  constexpr int kMessagesPerThread = 200;
+  std::string str;
+  LogSinkImpl stream(&str);
+  LogMessage::AddLogToStream(&stream, LS_INFO);
+  LogMessage::SetAsyncLogging(true);
+  {
+    auto log = [](const char* thread) {
+      for (int i = 0; i < kMessagesPerThread; ++i) {
+        RTC_LOG(LS_INFO) << "<" << thread << i << ">";
+      }
+    };
+    PlatformThread thread1 =
+        PlatformThread::SpawnJoinable([&] { log("a"); }, "LogThread1");
+    PlatformThread thread2 =
+        PlatformThread::SpawnJoinable([&] { log("b"); }, "LogThread2");
+  }
+  LogMessage::FlushAsyncLogging();
+  LogMessage::SetAsyncLogging(false);
+  LogMessage::RemoveLogToStream(&stream);
+
+  for (std::string thread : {"a", "b"}) {
+    size_t pos = 0;
+    for (int i = 0; i < kMessagesPerThread; ++i) {
+      std::string message = "<" + thread + std::to_string(i) + ">";
+      pos = str.find(message, pos);
+      ASSERT_NE(std::string::npos, pos) << message;
+    }
+  }
+}
+
 }  // namespace rtc
 #endif  // RTC_LOG_ENABLED()
@@ -526,13 +526,31 @@ BasicNetworkManager::BasicNetworkManager(
       allow_mac_based_ipv6_(
           webrtc::field_trial::IsEnabled("WebRTC-AllowMACBasedIPv6")),
       bind_using_ifname_(
-          !webrtc::field_trial::IsDisabled("WebRTC-BindUsingInterfaceName")) {}
-
-BasicNetworkManager::~BasicNetworkManager() {}
+          !webrtc::field_trial::IsDisabled("WebRTC-BindUsingInterfaceName")),
+      cache_networks_(
+          webrtc::field_trial::IsEnabled("WebRTC-CacheNetworks")) {}
+
+BasicNetworkManager::~BasicNetworkManager() {
+  if (thread_ && cache_networks_) {
+    RTC_DCHECK_RUN_ON(thread_);
+    if (networks_cached_) {
+      StopNetworkMonitor();
+    }
+  }
+}
 
 void BasicNetworkManager::OnNetworksChanged() {
   RTC_DCHECK_RUN_ON(thread_);
   RTC_LOG(LS_INFO) << "Network change was observed";
+  if (networks_cached_) {
+    // The cached networks are out of date; enumerate them again on the next
+    // StartUpdating().
+    networks_cached_ = false;
+    networks_enumerated_ = false;
+    sent_first_update_ = false;
+    StopNetworkMonitor();
+    return;
+  }
   UpdateNetworksOnce();
 }
 
@@ -898,6 +916,11 @@ void BasicNetworkManager::StartUpdating() {
     // to start allocating ports.
     if (sent_first_update_)
       thread_->Post(RTC_FROM_HERE, this, kSignalNetworksMessage);
+  } else if (networks_cached_) {
+    // The network monitor has seen no change since the networks were last
+    // enumerated, so they can be used right away.
+    networks_cached_ = false;
+    thread_->Post(RTC_FROM_HERE, this, kSignalNetworksMessage);
   } else {
     thread_->Post(RTC_FROM_HERE, this, kUpdateNetworksMessage);
     StartNetworkMonitor();
@@ -913,6 +936,13 @@ void BasicNetworkManager::StopUpdating() {
   --start_count_;
   if (!start_count_) {
     thread_->Clear(this);
+    if (cache_networks_ && network_monitor_ && networks_enumerated_) {
+      // Keep the network monitor running, so that the next StartUpdating()
+      // knows whether the networks enumerated so far can be reused.
+      networks_cached_ = true;
+      return;
+    }
+    networks_enumerated_ = false;
     sent_first_update_ = false;
     StopNetworkMonitor();
   }
@@ -1017,6 +1047,7 @@ void BasicNetworkManager::UpdateNetworksOnce() {
     MergeNetworkList(list, &changed, &stats);
     set_default_local_addresses(QueryDefaultLocalAddress(AF_INET),
                                 QueryDefaultLocalAddress(AF_INET6));
+    networks_enumerated_ = true;
     if (changed || !sent_first_update_) {
       SignalNetworksChanged();
       sent_first_update_ = true;
@@ -1026,6 +1057,10 @@ void BasicNetworkManager::UpdateNetworksOnce() {
 
 void BasicNetworkManager::UpdateNetworksContinually() {
   UpdateNetworksOnce();
+  if (cache_networks_ && network_monitor_) {
+    // The network monitor reports changes, no need to poll.
+    return;
+  }
   thread_->PostDelayed(RTC_FROM_HERE, kNetworksUpdateIntervalMs, this,
                        kUpdateNetworksMessage);
 }
@@ -345,6 +345,16 @@ class RTC_EXPORT BasicNetworkManager : public NetworkManagerBase,
       RTC_GUARDED_BY(thread_);
   bool allow_mac_based_ipv6_ RTC_GUARDED_BY(thread_) = false;
   bool bind_using_ifname_ RTC_GUARDED_BY(thread_) = false;
+  // With the "WebRTC-CacheNetworks" field trial, networks are enumerated
+  // again only when the network monitor reports a change, instead of
+  // periodically and on every restart.
+  const bool cache_networks_;
+  // Whether the networks enumerated before the last StopUpdating() are still
+  // current. The network monitor keeps running while this is true.
+  bool networks_cached_ RTC_GUARDED_BY(thread_) = false;
+  // Whether the networks have been enumerated since the network monitor was
+  // started.
+  bool networks_enumerated_ RTC_GUARDED_BY(thread_) = false;
 
   std::vector<NetworkMask> vpn_;
 };
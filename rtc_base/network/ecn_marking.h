@@ -0,0 +1,27 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_NETWORK_ECN_MARKING_H_
+#define RTC_BASE_NETWORK_ECN_MARKING_H_
+
+namespace rtc {
+
+// The ECN field of the IP header, with the values of its two bits, RFC 3168.
+// L4S capable senders mark their packets ECT(1), RFC 9331.
+enum class EcnMarking {
+  kNotEct = 0,  // Not ECN-Capable Transport.
+  kEct1 = 1,    // ECN-Capable Transport, ECT(1).
+  kEct0 = 2,    // ECN-Capable Transport, ECT(0).
+  kCe = 3,      // Congestion Experienced.
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_NETWORK_ECN_MARKING_H_
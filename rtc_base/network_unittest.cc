@@ -1171,6 +1171,47 @@ TEST_F(NetworkTest, TestNetworkMonitoring) {
   EXPECT_FALSE(GetNetworkMonitor(manager)->started());
 }
 
+// Test that with the "WebRTC-CacheNetworks" field trial, the networks are
+// kept while the network manager is stopped, until the network monitor reports
+// a change.
+TEST_F(NetworkTest, TestNetworkMonitoringWithCachedNetworks) {
+  webrtc::test::ScopedFieldTrials field_trials(
+      "WebRTC-CacheNetworks/Enabled/");
+  FakeNetworkMonitorFactory factory;
+  PhysicalSocketServer socket_server;
+  BasicNetworkManager manager(&factory, &socket_server);
+  manager.SignalNetworksChanged.connect(static_cast<NetworkTest*>(this),
+                                        &NetworkTest::OnNetworksChanged);
+  manager.StartUpdating();
+  FakeNetworkMonitor* network_monitor = GetNetworkMonitor(manager);
+  EXPECT_TRUE(network_monitor && network_monitor->started());
+  EXPECT_TRUE_WAIT(callback_called_, 1000);
+  callback_called_ = false;
+
+  // The network monitor keeps running while the manager is stopped, and the
+  // networks are signaled right away when it is started again, without being
+  // enumerated again.
+  manager.StopUpdating();
+  EXPECT_TRUE(network_monitor->started());
+  ClearNetworks(manager);
+  manager.StartUpdating();
+  EXPECT_TRUE_WAIT(callback_called_, 1000);
+  callback_called_ = false;
+  BasicNetworkManager::NetworkList list;
+  manager.GetNetworks(&list);
+  EXPECT_TRUE(list.empty());
+
+  // A network change while stopped discards the cached networks, so they are
+  // enumerated again on the next start.
+  manager.StopUpdating();
+  network_monitor->InovkeNetworksChangedCallbackForTesting();
+  EXPECT_FALSE(network_monitor->started());
+  manager.StartUpdating();
+  EXPECT_TRUE(network_monitor->started());
+  EXPECT_TRUE_WAIT(callback_called_, 1000);
+  manager.StopUpdating();
+}
+
 // Fails on Android: https://bugs.chromium.org/p/webrtc/issues/detail?id=4364.
 #if defined(WEBRTC_ANDROID)
 #define MAYBE_DefaultLocalAddress DISABLED_DefaultLocalAddress
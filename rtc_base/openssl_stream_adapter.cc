@@ -21,12 +21,18 @@
 #include <openssl/ssl.h>
 #endif
 
+#include <algorithm>
 #include <atomic>
+#include <deque>
+#include <map>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "api/ref_counted_base.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/event.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/openssl.h"
@@ -40,6 +46,7 @@
 #include "rtc_base/openssl_utility.h"
 #include "rtc_base/ssl_certificate.h"
 #include "rtc_base/stream.h"
+#include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/task_utils/to_queued_task.h"
 #include "rtc_base/thread.h"
 #include "rtc_base/time_utils.h"
@@ -152,6 +159,87 @@ void TimeCallbackForTesting(const SSL* ssl, struct timeval* out_clock) {
 }
 #endif
 
+// Identifies the sessions of WebRTC's DTLS connections. OpenSSL doesn't
+// resume sessions when peer verification is enabled without one.
+constexpr char kDtlsSessionIdContext[] = "WebRTC-DTLS";
+
+// Sessions of DTLS clients, for resuming them with peers that they were
+// connected to before, and the session ticket keys that DTLS servers share
+// to resume them. Shared by all OpenSSLStreamAdapters of the process, since
+// each has its own SSL_CTX.
+class DtlsSessionCache {
+ public:
+  // Room for the key name, HMAC secret and AES key of the ticket keys.
+#ifdef OPENSSL_IS_BORINGSSL
+  static constexpr size_t kTicketKeysSize = 48;
+#else
+  static constexpr size_t kTicketKeysSize = 80;
+#endif
+
+  static DtlsSessionCache* Get() {
+    static DtlsSessionCache* const cache = new DtlsSessionCache();
+    return cache;
+  }
+
+  const uint8_t* ticket_keys() const { return ticket_keys_; }
+
+  // Returns a new reference to the session for `key`, or null.
+  SSL_SESSION* Lookup(const std::string& key) {
+    webrtc::MutexLock lock(&mutex_);
+    auto it = sessions_.find(key);
+    if (it == sessions_.end()) {
+      return nullptr;
+    }
+    SSL_SESSION_up_ref(it->second);
+    return it->second;
+  }
+
+  // Takes the reference to `session`.
+  void Add(const std::string& key, SSL_SESSION* session) {
+    webrtc::MutexLock lock(&mutex_);
+    auto it = sessions_.find(key);
+    if (it != sessions_.end()) {
+      SSL_SESSION_free(it->second);
+      it->second = session;
+      return;
+    }
+    sessions_.emplace(key, session);
+    insertion_order_.push_back(key);
+    while (sessions_.size() > kMaxSessions) {
+      // The oldest peers are the least likely to come back.
+      RemoveLocked(insertion_order_.front());
+      insertion_order_.pop_front();
+    }
+  }
+
+  void Remove(const std::string& key) {
+    webrtc::MutexLock lock(&mutex_);
+    RemoveLocked(key);
+  }
+
+ private:
+  static constexpr size_t kMaxSessions = 1000;
+
+  DtlsSessionCache() {
+    RTC_CHECK_EQ(RAND_bytes(ticket_keys_, sizeof(ticket_keys_)), 1);
+  }
+
+  void RemoveLocked(const std::string& key)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    auto it = sessions_.find(key);
+    if (it != sessions_.end()) {
+      SSL_SESSION_free(it->second);
+      sessions_.erase(it);
+    }
+  }
+
+  uint8_t ticket_keys_[kTicketKeysSize];
+  webrtc::Mutex mutex_;
+  std::map<std::string, SSL_SESSION*> sessions_ RTC_GUARDED_BY(mutex_);
+  // Keys that were removed may stay here until they come up for eviction.
+  std::deque<std::string> insertion_order_ RTC_GUARDED_BY(mutex_);
+};
+
 }  // namespace
 
 //////////////////////////////////////////////////////////////////////
@@ -204,12 +292,7 @@ static int stream_free(BIO* b) {
   return 1;
 }
 
-static int stream_read(BIO* b, char* out, int outl) {
-  if (!out) {
-    return -1;
-  }
-  StreamInterface* stream = static_cast<StreamInterface*>(BIO_get_data(b));
-  BIO_clear_retry_flags(b);
+static int read_stream(BIO* b, StreamInterface* stream, char* out, int outl) {
   size_t read;
   int error;
   StreamResult result = stream->Read(out, outl, &read, &error);
@@ -221,12 +304,10 @@ static int stream_read(BIO* b, char* out, int outl) {
   return -1;
 }
 
-static int stream_write(BIO* b, const char* in, int inl) {
-  if (!in) {
-    return -1;
-  }
-  StreamInterface* stream = static_cast<StreamInterface*>(BIO_get_data(b));
-  BIO_clear_retry_flags(b);
+static int write_stream(BIO* b,
+                        StreamInterface* stream,
+                        const char* in,
+                        int inl) {
   size_t written;
   int error;
   StreamResult result = stream->Write(in, inl, &written, &error);
@@ -238,6 +319,24 @@ static int stream_write(BIO* b, const char* in, int inl) {
   return -1;
 }
 
+static int stream_read(BIO* b, char* out, int outl) {
+  if (!out) {
+    return -1;
+  }
+  BIO_clear_retry_flags(b);
+  return read_stream(b, static_cast<StreamInterface*>(BIO_get_data(b)), out,
+                     outl);
+}
+
+static int stream_write(BIO* b, const char* in, int inl) {
+  if (!in) {
+    return -1;
+  }
+  BIO_clear_retry_flags(b);
+  return write_stream(b, static_cast<StreamInterface*>(BIO_get_data(b)), in,
+                      inl);
+}
+
 static int stream_puts(BIO* b, const char* str) {
   return stream_write(b, str, checked_cast<int>(strlen(str)));
 }
@@ -267,6 +366,92 @@ static long stream_ctrl(BIO* b, int cmd, long num, void* ptr) {
   }
 }
 
+//////////////////////////////////////////////////////////////////////
+// HandshakeBIO
+//////////////////////////////////////////////////////////////////////
+
+struct OpenSSLHandshakeIo : public RefCountedNonVirtual<OpenSSLHandshakeIo> {
+  explicit OpenSSLHandshakeIo(StreamInterface* stream) : stream(stream) {}
+
+  StreamInterface* const stream;
+  // While the handshake runs, packets are read from `received` and written to
+  // `sent` only. Once it is done, `received` is drained before the stream is
+  // read, and packets are written to the stream.
+  bool buffered = true;
+  std::deque<Buffer> received;
+  std::vector<Buffer> sent;
+
+  webrtc::Mutex mutex;
+  bool step_started RTC_GUARDED_BY(mutex) = false;
+  bool step_cancelled RTC_GUARDED_BY(mutex) = false;
+  Event step_done{/*manual_reset=*/true, /*initially_signaled=*/false};
+};
+
+static int handshake_write(BIO* h, const char* buf, int num);
+static int handshake_read(BIO* h, char* buf, int size);
+static int handshake_puts(BIO* h, const char* str);
+
+static BIO_METHOD* BIO_handshake_method() {
+  static BIO_METHOD* method = [] {
+    BIO_METHOD* method = BIO_meth_new(BIO_TYPE_BIO, "handshake");
+    BIO_meth_set_write(method, handshake_write);
+    BIO_meth_set_read(method, handshake_read);
+    BIO_meth_set_puts(method, handshake_puts);
+    BIO_meth_set_ctrl(method, stream_ctrl);
+    BIO_meth_set_create(method, stream_new);
+    BIO_meth_set_destroy(method, stream_free);
+    return method;
+  }();
+  return method;
+}
+
+static BIO* BIO_new_handshake(OpenSSLHandshakeIo* io) {
+  BIO* ret = BIO_new(BIO_handshake_method());
+  if (ret == nullptr) {
+    return nullptr;
+  }
+  BIO_set_data(ret, io);
+  return ret;
+}
+
+static int handshake_read(BIO* b, char* out, int outl) {
+  if (!out) {
+    return -1;
+  }
+  OpenSSLHandshakeIo* io = static_cast<OpenSSLHandshakeIo*>(BIO_get_data(b));
+  BIO_clear_retry_flags(b);
+  if (!io->received.empty()) {
+    // Like a datagram socket, drops what doesn't fit.
+    const Buffer& packet = io->received.front();
+    const int read = std::min(outl, checked_cast<int>(packet.size()));
+    memcpy(out, packet.data(), read);
+    io->received.pop_front();
+    return read;
+  }
+  if (!io->buffered) {
+    return read_stream(b, io->stream, out, outl);
+  }
+  BIO_set_retry_read(b);
+  return -1;
+}
+
+static int handshake_write(BIO* b, const char* in, int inl) {
+  if (!in) {
+    return -1;
+  }
+  OpenSSLHandshakeIo* io = static_cast<OpenSSLHandshakeIo*>(BIO_get_data(b));
+  BIO_clear_retry_flags(b);
+  if (!io->buffered) {
+    return write_stream(b, io->stream, in, inl);
+  }
+  io->sent.emplace_back(in, inl);
+  return inl;
+}
+
+static int handshake_puts(BIO* b, const char* str) {
+  return handshake_write(b, str, checked_cast<int>(strlen(str)));
+}
+
 /////////////////////////////////////////////////////////////////////////////
 // OpenSSLStreamAdapter
 /////////////////////////////////////////////////////////////////////////////
@@ -300,7 +485,9 @@ OpenSSLStreamAdapter::OpenSSLStreamAdapter(
       ssl_max_version_(SSL_PROTOCOL_TLS_12),
       // Default is to support legacy TLS protocols.
       // This will be changed to default non-support in M82 or M83.
-      support_legacy_tls_protocols_flag_(ShouldAllowLegacyTLSProtocols()) {
+      support_legacy_tls_protocols_flag_(ShouldAllowLegacyTLSProtocols()),
+      session_resumption_enabled_(
+          webrtc::field_trial::IsEnabled("WebRTC-DtlsSessionResumption")) {
   stream_->SignalEvent.connect(this, &OpenSSLStreamAdapter::OnEvent);
 }
 
@@ -333,6 +520,7 @@ bool OpenSSLStreamAdapter::SetPeerCertificateDigest(
     SSLPeerCertificateDigestError* error) {
   RTC_DCHECK(!peer_certificate_verified_);
   RTC_DCHECK(!HasPeerCertificateDigest());
+  RTC_DCHECK(pending_peer_certificate_digest_algorithm_.empty());
   size_t expected_len;
   if (error) {
     *error = SSLPeerCertificateDigestError::NONE;
@@ -352,6 +540,14 @@ bool OpenSSLStreamAdapter::SetPeerCertificateDigest(
     return false;
   }
 
+  if (handshake_step_in_flight_) {
+    // The handshake thread may be verifying the certificate, so the digest
+    // is set once it is done, see OnHandshakeStepDone().
+    pending_peer_certificate_digest_value_.SetData(digest_val, digest_len);
+    pending_peer_certificate_digest_algorithm_ = digest_alg;
+    return true;
+  }
+
   peer_certificate_digest_value_.SetData(digest_val, digest_len);
   peer_certificate_digest_algorithm_ = digest_alg;
 
@@ -515,6 +711,10 @@ bool OpenSSLStreamAdapter::IsTlsConnected() {
   return state_ == SSL_CONNECTED;
 }
 
+bool OpenSSLStreamAdapter::IsSessionResumed() const {
+  return state_ == SSL_CONNECTED && SSL_session_reused(ssl_);
+}
+
 int OpenSSLStreamAdapter::StartSSL() {
   // Don't allow StartSSL to be called twice.
   if (state_ != SSL_NONE) {
@@ -550,6 +750,11 @@ void OpenSSLStreamAdapter::SetInitialRetransmissionTimeout(int timeout_ms) {
   dtls_handshake_timeout_ms_ = timeout_ms;
 }
 
+void OpenSSLStreamAdapter::SetHandshakeQueue(webrtc::TaskQueueBase* queue) {
+  RTC_DCHECK(state_ == SSL_NONE);
+  handshake_queue_ = queue;
+}
+
 //
 // StreamInterface Implementation
 //
@@ -782,11 +987,24 @@ void OpenSSLStreamAdapter::OnEvent(StreamInterface* stream,
     if (state_ == SSL_NONE) {
       events_to_signal |= events & (SE_READ | SE_WRITE);
     } else if (state_ == SSL_CONNECTING) {
-      if (int err = ContinueSSL()) {
-        Error("ContinueSSL", err, 0, true);
-        return;
+      if (handshake_io_) {
+        if (events & SE_WRITE) {
+          WriteHandshakePackets();
+        }
+        if (events & SE_READ) {
+          ReadHandshakePackets();
+        }
+      }
+      if (!handshake_io_ || (events & SE_READ)) {
+        if (int err = ContinueSSL()) {
+          Error("ContinueSSL", err, 0, true);
+          return;
+        }
       }
     } else if (state_ == SSL_CONNECTED) {
+      if ((events & SE_WRITE) && !unsent_handshake_packets_.empty()) {
+        WriteHandshakePackets();
+      }
       if (((events & SE_READ) && ssl_write_needs_read_) ||
           (events & SE_WRITE)) {
         RTC_DLOG(LS_VERBOSE) << " -- onStreamWriteable";
@@ -834,13 +1052,12 @@ void OpenSSLStreamAdapter::SetTimeout(int delay_ms) {
         if (flag->alive()) {
           RTC_DLOG(LS_INFO) << "DTLS timeout expired";
           timeout_task_.Stop();
-          int res = DTLSv1_handle_timeout(ssl_);
-          if (res > 0) {
-            RTC_LOG(LS_INFO) << "DTLS retransmission";
-          } else if (res < 0) {
-            RTC_LOG(LS_INFO) << "DTLSv1_handle_timeout() return -1";
+          if (handshake_io_) {
+            PostHandshakeStep(/*handle_timeout=*/true);
+          } else {
+            HandleDtlsTimeout();
+            ContinueSSL();
           }
-          ContinueSSL();
         } else {
           RTC_DCHECK_NOTREACHED();
         }
@@ -863,7 +1080,13 @@ int OpenSSLStreamAdapter::BeginSSL() {
     return -1;
   }
 
-  bio = BIO_new_stream(stream_.get());
+  if (handshake_queue_ && ssl_mode_ == SSL_MODE_DTLS) {
+    handshake_io_ = scoped_refptr<OpenSSLHandshakeIo>(
+        new OpenSSLHandshakeIo(stream_.get()));
+    bio = BIO_new_handshake(handshake_io_.get());
+  } else {
+    bio = BIO_new_stream(stream_.get());
+  }
   if (!bio) {
     return -1;
   }
@@ -876,6 +1099,20 @@ int OpenSSLStreamAdapter::BeginSSL() {
 
   SSL_set_app_data(ssl_, this);
 
+  if (session_resumption_enabled_ && ssl_mode_ == SSL_MODE_DTLS &&
+      role_ == SSL_CLIENT) {
+    session_cache_key_ = GetSessionCacheKey();
+    SSL_SESSION* session = session_cache_key_.empty()
+                               ? nullptr
+                               : DtlsSessionCache::Get()->Lookup(
+                                     session_cache_key_);
+    if (session) {
+      RTC_DLOG(LS_INFO) << "Offering to resume a DTLS session.";
+      SSL_set_session(ssl_, session);
+      SSL_SESSION_free(session);
+    }
+  }
+
   SSL_set_bio(ssl_, bio, bio);  // the SSL object owns the bio now.
   if (ssl_mode_ == SSL_MODE_DTLS) {
 #ifdef OPENSSL_IS_BORINGSSL
@@ -901,12 +1138,30 @@ int OpenSSLStreamAdapter::ContinueSSL() {
   // Clear the DTLS timer
   timeout_task_.Stop();
 
+  if (handshake_io_) {
+    PostHandshakeStep(/*handle_timeout=*/false);
+    return 0;
+  }
+
   const int code = (role_ == SSL_CLIENT) ? SSL_connect(ssl_) : SSL_accept(ssl_);
   const int ssl_error = SSL_get_error(ssl_, code);
+  return FinishHandshakeStep(code, ssl_error, ERR_peek_last_error());
+}
 
+int OpenSSLStreamAdapter::FinishHandshakeStep(int code,
+                                              int ssl_error,
+                                              int err_code) {
   switch (ssl_error) {
     case SSL_ERROR_NONE:
       RTC_DLOG(LS_VERBOSE) << " -- success";
+      if (SSL_session_reused(ssl_) && !OnSessionResumed()) {
+        RTC_LOG(LS_WARNING) << "Rejected resumed DTLS session.";
+        if (!session_cache_key_.empty()) {
+          DtlsSessionCache::Get()->Remove(session_cache_key_);
+        }
+        SignalSSLHandshakeError(SSLHandshakeError::UNKNOWN);
+        return -1;
+      }
       // By this point, OpenSSL should have given us a certificate, or errored
       // out if one was missing.
       RTC_DCHECK(peer_cert_chain_ || !GetClientAuthEnabled());
@@ -941,7 +1196,6 @@ int OpenSSLStreamAdapter::ContinueSSL() {
     case SSL_ERROR_ZERO_RETURN:
     default:
       SSLHandshakeError ssl_handshake_err = SSLHandshakeError::UNKNOWN;
-      int err_code = ERR_peek_last_error();
       if (err_code != 0 && ERR_GET_REASON(err_code) == SSL_R_NO_SHARED_CIPHER) {
         ssl_handshake_err = SSLHandshakeError::INCOMPATIBLE_CIPHERSUITE;
       }
@@ -954,6 +1208,157 @@ int OpenSSLStreamAdapter::ContinueSSL() {
   return 0;
 }
 
+void OpenSSLStreamAdapter::HandleDtlsTimeout() {
+  int res = DTLSv1_handle_timeout(ssl_);
+  if (res > 0) {
+    RTC_LOG(LS_INFO) << "DTLS retransmission";
+  } else if (res < 0) {
+    RTC_LOG(LS_INFO) << "DTLSv1_handle_timeout() return -1";
+  }
+}
+
+void OpenSSLStreamAdapter::PostHandshakeStep(bool handle_timeout) {
+  RTC_DCHECK(handshake_io_);
+  if (handshake_step_in_flight_) {
+    handshake_step_pending_ = true;
+    return;
+  }
+  handshake_step_pending_ = false;
+  handshake_step_in_flight_ = true;
+  for (Buffer& packet : received_handshake_packets_) {
+    handshake_io_->received.push_back(std::move(packet));
+  }
+  received_handshake_packets_.clear();
+  {
+    webrtc::MutexLock lock(&handshake_io_->mutex);
+    handshake_io_->step_started = false;
+  }
+  handshake_io_->step_done.Reset();
+
+  // Until `step_done` is set, the network thread doesn't use `ssl_`, and
+  // Cleanup() waits for a step that started. A step that didn't start yet is
+  // cancelled instead, so this object may be gone by the time it runs.
+  handshake_queue_->PostTask(webrtc::ToQueuedTask(
+      [this, io = handshake_io_, handle_timeout, owner = owner_,
+       safety = task_safety_.flag()] {
+        {
+          webrtc::MutexLock lock(&io->mutex);
+          if (io->step_cancelled) {
+            return;
+          }
+          io->step_started = true;
+        }
+        ERR_clear_error();
+        if (handle_timeout) {
+          HandleDtlsTimeout();
+        }
+        const int code =
+            (role_ == SSL_CLIENT) ? SSL_connect(ssl_) : SSL_accept(ssl_);
+        const int ssl_error = SSL_get_error(ssl_, code);
+        const int err_code = ERR_peek_last_error();
+        io->step_done.Set();
+        owner->PostTask(webrtc::ToQueuedTask(
+            std::move(safety), [this, code, ssl_error, err_code] {
+              OnHandshakeStepDone(code, ssl_error, err_code);
+            }));
+      }));
+}
+
+void OpenSSLStreamAdapter::OnHandshakeStepDone(int code,
+                                               int ssl_error,
+                                               int err_code) {
+  if (!handshake_step_in_flight_) {
+    // Cleanup() cancelled this step.
+    return;
+  }
+  handshake_step_in_flight_ = false;
+  if (state_ != SSL_CONNECTING) {
+    return;
+  }
+
+  for (Buffer& packet : handshake_io_->sent) {
+    unsent_handshake_packets_.push_back(std::move(packet));
+  }
+  handshake_io_->sent.clear();
+  WriteHandshakePackets();
+
+  if (!pending_peer_certificate_digest_algorithm_.empty()) {
+    std::string digest_alg;
+    std::swap(digest_alg, pending_peer_certificate_digest_algorithm_);
+    Buffer digest_val = std::move(pending_peer_certificate_digest_value_);
+    if (!SetPeerCertificateDigest(digest_alg, digest_val.data(),
+                                  digest_val.size(), nullptr)) {
+      SignalEvent(this, SE_CLOSE, ssl_error_code_);
+      return;
+    }
+  }
+
+  if (ssl_error == SSL_ERROR_NONE) {
+    // From now on `ssl_` reads and writes the stream, after the packets that
+    // arrived during the last step.
+    handshake_io_->buffered = false;
+    for (Buffer& packet : received_handshake_packets_) {
+      handshake_io_->received.push_back(std::move(packet));
+    }
+    received_handshake_packets_.clear();
+  }
+
+  if (int err = FinishHandshakeStep(code, ssl_error, err_code)) {
+    Error("ContinueSSL", err, 0, true);
+    return;
+  }
+  if (state_ == SSL_CONNECTING && handshake_step_pending_) {
+    ContinueSSL();
+  }
+}
+
+void OpenSSLStreamAdapter::ReadHandshakePackets() {
+  // Large enough for any DTLS record that the stream delivers.
+  constexpr size_t kMaxPacketSize = 2048;
+  while (true) {
+    Buffer packet(kMaxPacketSize);
+    size_t read;
+    int error;
+    if (stream_->Read(packet.data(), packet.size(), &read, &error) !=
+        SR_SUCCESS) {
+      return;
+    }
+    packet.SetSize(read);
+    received_handshake_packets_.push_back(std::move(packet));
+  }
+}
+
+void OpenSSLStreamAdapter::WriteHandshakePackets() {
+  size_t count = 0;
+  for (const Buffer& packet : unsent_handshake_packets_) {
+    size_t written;
+    int error;
+    if (stream_->Write(packet.data(), packet.size(), &written, &error) ==
+        SR_BLOCK) {
+      break;
+    }
+    ++count;
+  }
+  unsent_handshake_packets_.erase(unsent_handshake_packets_.begin(),
+                                  unsent_handshake_packets_.begin() + count);
+}
+
+void OpenSSLStreamAdapter::CancelHandshakeStep() {
+  if (!handshake_step_in_flight_) {
+    return;
+  }
+  bool started;
+  {
+    webrtc::MutexLock lock(&handshake_io_->mutex);
+    started = handshake_io_->step_started;
+    handshake_io_->step_cancelled = true;
+  }
+  if (started) {
+    handshake_io_->step_done.Wait(Event::kForever);
+  }
+  handshake_step_in_flight_ = false;
+}
+
 void OpenSSLStreamAdapter::Error(const char* context,
                                  int err,
                                  uint8_t alert,
@@ -976,6 +1381,12 @@ void OpenSSLStreamAdapter::Cleanup(uint8_t alert) {
     ssl_error_code_ = 0;
   }
 
+  if (handshake_io_) {
+    CancelHandshakeStep();
+    // Whatever the shutdown below sends goes to the stream.
+    handshake_io_->buffered = false;
+  }
+
   if (ssl_) {
     int ret;
 // SSL_send_fatal_alert is only available in BoringSSL.
@@ -999,6 +1410,9 @@ void OpenSSLStreamAdapter::Cleanup(uint8_t alert) {
     SSL_free(ssl_);
     ssl_ = nullptr;
   }
+  handshake_io_ = nullptr;
+  received_handshake_packets_.clear();
+  unsent_handshake_packets_.clear();
   if (ssl_ctx_) {
     SSL_CTX_free(ssl_ctx_);
     ssl_ctx_ = nullptr;
@@ -1105,9 +1519,87 @@ SSL_CTX* OpenSSLStreamAdapter::SetupSSLContext() {
     }
   }
 
+  if (session_resumption_enabled_ && ssl_mode_ == SSL_MODE_DTLS) {
+    // Servers resume sessions from tickets, which any server of the process
+    // can decrypt; clients keep their sessions in the DtlsSessionCache.
+    SSL_CTX_set_session_id_context(
+        ctx, reinterpret_cast<const uint8_t*>(kDtlsSessionIdContext),
+        sizeof(kDtlsSessionIdContext) - 1);
+    if (!SSL_CTX_set_tlsext_ticket_keys(
+            ctx, const_cast<uint8_t*>(DtlsSessionCache::Get()->ticket_keys()),
+            DtlsSessionCache::kTicketKeysSize)) {
+      SSL_CTX_free(ctx);
+      return nullptr;
+    }
+    SSL_CTX_set_session_cache_mode(
+        ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb(ctx, &OpenSSLStreamAdapter::NewSessionCallback);
+  }
+
   return ctx;
 }
 
+std::string OpenSSLStreamAdapter::GetSessionCacheKey() const {
+  // Only resume sessions with a peer whose certificate is known, and only
+  // with the certificate that they were established with, so that both
+  // sides see the certificates that were signaled.
+  if (!identity_ || !HasPeerCertificateDigest()) {
+    return std::string();
+  }
+  unsigned char digest[EVP_MAX_MD_SIZE];
+  size_t digest_length;
+  if (!identity_->certificate().ComputeDigest(
+          peer_certificate_digest_algorithm_, digest, sizeof(digest),
+          &digest_length)) {
+    return std::string();
+  }
+  std::string key = peer_certificate_digest_algorithm_;
+  key.append(reinterpret_cast<const char*>(digest), digest_length);
+  key.append(peer_certificate_digest_value_.data<char>(),
+             peer_certificate_digest_value_.size());
+  return key;
+}
+
+bool OpenSSLStreamAdapter::OnSessionResumed() {
+  // Resumed handshakes don't exchange certificates, so SSLVerifyCallback()
+  // didn't run. The session has the certificate that the peer presented
+  // when it was established.
+#ifdef OPENSSL_IS_BORINGSSL
+  const STACK_OF(CRYPTO_BUFFER)* chain = SSL_get0_peer_certificates(ssl_);
+  if (chain == nullptr || sk_CRYPTO_BUFFER_num(chain) == 0) {
+    return false;
+  }
+  std::vector<std::unique_ptr<SSLCertificate>> cert_chain;
+  for (CRYPTO_BUFFER* cert : chain) {
+    cert_chain.emplace_back(new BoringSSLCertificate(bssl::UpRef(cert)));
+  }
+  peer_cert_chain_.reset(new SSLCertChain(std::move(cert_chain)));
+#else
+  X509* cert = SSL_get_peer_certificate(ssl_);
+  if (cert == nullptr) {
+    return false;
+  }
+  peer_cert_chain_.reset(
+      new SSLCertChain(std::make_unique<OpenSSLCertificate>(cert)));
+  X509_free(cert);
+#endif
+  RTC_DLOG(LS_INFO) << "Resumed DTLS session.";
+  // As in SSLVerifyCallback(), wait for the digest if it isn't known yet.
+  return peer_certificate_digest_algorithm_.empty() ||
+         VerifyPeerCertificate();
+}
+
+int OpenSSLStreamAdapter::NewSessionCallback(SSL* ssl, SSL_SESSION* session) {
+  OpenSSLStreamAdapter* stream =
+      reinterpret_cast<OpenSSLStreamAdapter*>(SSL_get_app_data(ssl));
+  if (stream->session_cache_key_.empty()) {
+    return 0;
+  }
+  DtlsSessionCache::Get()->Add(stream->session_cache_key_, session);
+  // The cache took the reference.
+  return 1;
+}
+
 bool OpenSSLStreamAdapter::VerifyPeerCertificate() {
   if (!HasPeerCertificateDigest() || !peer_cert_chain_ ||
       !peer_cert_chain_->GetSize()) {
@@ -1140,6 +1632,10 @@ bool OpenSSLStreamAdapter::VerifyPeerCertificate() {
 
 std::unique_ptr<SSLCertChain> OpenSSLStreamAdapter::GetPeerSSLCertChain()
     const {
+  if (handshake_step_in_flight_) {
+    // The handshake thread sets it.
+    return nullptr;
+  }
   return peer_cert_chain_ ? peer_cert_chain_->Clone() : nullptr;
 }
 
@@ -20,6 +20,8 @@
 #include <vector>
 
 #include "absl/types/optional.h"
+#include "api/scoped_refptr.h"
+#include "api/task_queue/task_queue_base.h"
 #include "rtc_base/buffer.h"
 #ifdef OPENSSL_IS_BORINGSSL
 #include "rtc_base/boringssl_identity.h"
@@ -33,8 +35,16 @@
 #include "rtc_base/task_utils/pending_task_safety_flag.h"
 #include "rtc_base/task_utils/repeating_task.h"
 
+#ifndef OPENSSL_IS_BORINGSSL
+typedef struct ssl_session_st SSL_SESSION;
+#endif
+
 namespace rtc {
 
+// The packets of a handshake that runs on another queue, see
+// OpenSSLStreamAdapter::SetHandshakeQueue().
+struct OpenSSLHandshakeIo;
+
 // This class was written with OpenSSLAdapter (a socket adapter) as a
 // starting point. It has similar structure and functionality, but uses a
 // "peer-to-peer" mode, verifying the peer's certificate using a digest
@@ -93,6 +103,7 @@ class OpenSSLStreamAdapter final : public SSLStreamAdapter {
   void SetMode(SSLMode mode) override;
   void SetMaxProtocolVersion(SSLProtocolVersion version) override;
   void SetInitialRetransmissionTimeout(int timeout_ms) override;
+  void SetHandshakeQueue(webrtc::TaskQueueBase* queue) override;
 
   StreamResult Read(void* data,
                     size_t data_len,
@@ -126,6 +137,10 @@ class OpenSSLStreamAdapter final : public SSLStreamAdapter {
 
   bool IsTlsConnected() override;
 
+  // Whether the handshake resumed a session of an earlier connection with
+  // the same peer, see the "WebRTC-DtlsSessionResumption" field trial.
+  bool IsSessionResumed() const;
+
   // Capabilities interfaces.
   static bool IsBoringSsl();
 
@@ -162,6 +177,22 @@ class OpenSSLStreamAdapter final : public SSLStreamAdapter {
   int BeginSSL();
   // Perform SSL negotiation steps.
   int ContinueSSL();
+  // Handles the result of SSL_connect() or SSL_accept(). `err_code` is the
+  // last error that OpenSSL queued on the thread that called it.
+  int FinishHandshakeStep(int code, int ssl_error, int err_code);
+  void HandleDtlsTimeout();
+
+  // Runs the next step of the handshake on `handshake_queue_`, or once the
+  // step that is running there is done.
+  void PostHandshakeStep(bool handle_timeout);
+  void OnHandshakeStepDone(int code, int ssl_error, int err_code);
+  // Moves the packets that arrived for the handshake out of the stream.
+  void ReadHandshakePackets();
+  // Sends the packets of the handshake that the stream didn't take yet.
+  void WriteHandshakePackets();
+  // Cancels the handshake step that is queued, or blocks until the one that
+  // is running is done.
+  void CancelHandshakeStep();
 
   // Error handler helper. signal is given as true for errors in
   // asynchronous contexts (when an error method was not returned
@@ -183,6 +214,14 @@ class OpenSSLStreamAdapter final : public SSLStreamAdapter {
   // Verify the peer certificate matches the signaled digest.
   bool VerifyPeerCertificate();
 
+  // The key under which a DTLS client caches its session with the peer, or
+  // empty if it can't be cached. Covers both certificates.
+  std::string GetSessionCacheKey() const;
+  // Gets the peer certificate of a resumed session and verifies it.
+  bool OnSessionResumed();
+  // Caches new client sessions. See SSL_CTX_sess_set_new_cb.
+  static int NewSessionCallback(SSL* ssl, SSL_SESSION* session);
+
 #ifdef OPENSSL_IS_BORINGSSL
   // SSL certificate verification callback. See SSL_CTX_set_custom_verify.
   static enum ssl_verify_result_t SSLVerifyCallback(SSL* ssl,
@@ -248,6 +287,28 @@ class OpenSSLStreamAdapter final : public SSLStreamAdapter {
 
   // TODO(https://bugs.webrtc.org/10261): Completely remove this option in M84.
   const bool support_legacy_tls_protocols_flag_;
+
+  // Whether DTLS sessions are resumed with peers that were connected to
+  // before, using the "WebRTC-DtlsSessionResumption" field trial.
+  const bool session_resumption_enabled_;
+  std::string session_cache_key_;
+
+  // Set when the handshake runs on another queue, see SetHandshakeQueue().
+  // While a step runs there, only that queue uses `ssl_`; the packets it
+  // reads and writes are passed through `handshake_io_`, which the BIO of
+  // `ssl_` reads from and writes to until the handshake is done.
+  webrtc::TaskQueueBase* handshake_queue_ = nullptr;
+  scoped_refptr<OpenSSLHandshakeIo> handshake_io_;
+  bool handshake_step_in_flight_ = false;
+  // Whether another step should run once the current one is done.
+  bool handshake_step_pending_ = false;
+  // Packets that arrived, or are still to be sent, while a step was running.
+  std::vector<Buffer> received_handshake_packets_;
+  std::vector<Buffer> unsent_handshake_packets_;
+  // A peer certificate digest that was set while a step was running, and is
+  // applied when it is done.
+  std::string pending_peer_certificate_digest_algorithm_;
+  Buffer pending_peer_certificate_digest_value_;
 };
 
 /////////////////////////////////////////////////////////////////////////////
@@ -52,6 +52,8 @@
 #include "rtc_base/time_utils.h"
 
 #if defined(WEBRTC_LINUX)
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
 #include <linux/sockios.h>
 #endif
 
@@ -72,6 +74,13 @@ typedef void* SockOptArg;
 
 #if defined(WEBRTC_POSIX) && !defined(WEBRTC_MAC) && !defined(__native_client__)
 
+// Kernel receive timestamps are in wall clock time, while packet times are
+// compared against rtc::TimeMicros(). Returns what to subtract from the
+// former to get the latter.
+int64_t GetWallClockOffset() {
+  return rtc::TimeUTCMicros() - rtc::TimeMicros();
+}
+
 int64_t GetSocketRecvTimestamp(int socket) {
   struct timeval tv_ioctl;
   int ret = ioctl(socket, SIOCGSTAMP, &tv_ioctl);
@@ -80,7 +89,7 @@ int64_t GetSocketRecvTimestamp(int socket) {
   int64_t timestamp =
       rtc::kNumMicrosecsPerSec * static_cast<int64_t>(tv_ioctl.tv_sec) +
       static_cast<int64_t>(tv_ioctl.tv_usec);
-  return timestamp;
+  return timestamp - GetWallClockOffset();
 }
 
 #else
@@ -102,6 +111,46 @@ typedef char* SockOptArg;
 #if !defined(EPOLLRDHUP)
 #define EPOLLRDHUP 0x2000
 #endif
+
+namespace {
+// Room for the receive timestamp and the traffic class control messages read
+// per datagram.
+constexpr size_t kRecvControlSize =
+    CMSG_SPACE(sizeof(scm_timestamping)) + CMSG_SPACE(sizeof(int));
+
+struct alignas(cmsghdr) RecvControlBuffer {
+  char data[kRecvControlSize];
+};
+
+// A datagram read this long after its NIC timestamp means the NIC clock was
+// stepped rather than the datagram queued; the clock offset is re-estimated.
+constexpr int64_t kMaxHardwareTimestampLagUs = rtc::kNumMicrosecsPerSec;
+
+int64_t TimespecToMicros(const timespec& ts) {
+  return rtc::kNumMicrosecsPerSec * static_cast<int64_t>(ts.tv_sec) +
+         static_cast<int64_t>(ts.tv_nsec) / rtc::kNumNanosecsPerMicrosec;
+}
+
+// Returns the ECN field of the IP header carried by the control messages of
+// `hdr`, which are there if OPT_RECV_ECN is set.
+rtc::EcnMarking GetRecvEcn(const msghdr& hdr) {
+  for (cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr); cmsg != nullptr;
+       cmsg = CMSG_NXTHDR(const_cast<msghdr*>(&hdr), cmsg)) {
+    int tos;
+    if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_TOS) {
+      // A single byte, unlike the IPv6 traffic class.
+      tos = *reinterpret_cast<const uint8_t*>(CMSG_DATA(cmsg));
+    } else if (cmsg->cmsg_level == IPPROTO_IPV6 &&
+               cmsg->cmsg_type == IPV6_TCLASS) {
+      memcpy(&tos, CMSG_DATA(cmsg), sizeof(tos));
+    } else {
+      continue;
+    }
+    return static_cast<rtc::EcnMarking>(tos & 0x3);
+  }
+  return rtc::EcnMarking::kNotEct;
+}
+}  // namespace
 #endif
 
 namespace {
@@ -150,6 +199,12 @@ bool PhysicalSocket::Create(int family, int type) {
   UpdateLastError();
   if (udp_) {
     SetEnabledEvents(DE_READ | DE_WRITE);
+#if defined(WEBRTC_USE_EPOLL)
+    // Datagrams that arrive before this don't get a timestamp.
+    if (s_ != INVALID_SOCKET) {
+      EnableRecvTimestamps();
+    }
+#endif
   }
   return s_ != INVALID_SOCKET;
 }
@@ -306,6 +361,9 @@ int PhysicalSocket::GetOption(Option opt, int* value) {
     // unshift DSCP value to get six most significant bits of IP DiffServ field
     *value >>= 2;
 #endif
+  } else if (opt == OPT_SEND_ECN) {
+    // The two least significant bits of the DiffServ field.
+    *value &= 0x3;
   }
   return ret;
 }
@@ -320,10 +378,16 @@ int PhysicalSocket::SetOption(Option opt, int value) {
     value = (value) ? IP_PMTUDISC_DO : IP_PMTUDISC_DONT;
 #endif
   } else if (opt == OPT_DSCP) {
+    dscp_ = value;
 #if defined(WEBRTC_POSIX)
     // shift DSCP value to fit six most significant bits of IP DiffServ field
-    value <<= 2;
+    value = (value << 2) | send_ecn_;
 #endif
+  } else if (opt == OPT_SEND_ECN) {
+    if (value < 0 || value > static_cast<int>(EcnMarking::kCe))
+      return -1;
+    send_ecn_ = value;
+    value = (dscp_ << 2) | send_ecn_;
   }
 #if defined(WEBRTC_POSIX)
   if (sopt == IPV6_TCLASS) {
@@ -331,6 +395,9 @@ int PhysicalSocket::SetOption(Option opt, int value) {
     // Don't bother checking the return code, as this is expected to fail if
     // it's not actually dual-stack.
     ::setsockopt(s_, IPPROTO_IP, IP_TOS, (SockOptArg)&value, sizeof(value));
+  } else if (sopt == IPV6_RECVTCLASS) {
+    ::setsockopt(s_, IPPROTO_IP, IP_RECVTOS, (SockOptArg)&value,
+                 sizeof(value));
   }
 #endif
   int result =
@@ -391,6 +458,52 @@ int PhysicalSocket::SendTo(const void* buffer,
   return sent;
 }
 
+#if defined(WEBRTC_USE_EPOLL)
+int PhysicalSocket::SendToBatch(ArrayView<const SendBuffer> buffers,
+                                const SocketAddress& addr) {
+  if (!udp_ || buffers.size() <= 1)
+    return Socket::SendToBatch(buffers, addr);
+
+  sockaddr_storage saddr;
+  size_t len = addr.ToSockAddrStorage(&saddr);
+  int total = 0;
+  while (static_cast<size_t>(total) < buffers.size()) {
+    const size_t count =
+        std::min(buffers.size() - total, kMaxSendBatchSize);
+    std::array<mmsghdr, kMaxSendBatchSize> messages;
+    std::array<iovec, kMaxSendBatchSize> iovecs;
+    for (size_t i = 0; i < count; ++i) {
+      const SendBuffer& buffer = buffers[total + i];
+      iovecs[i].iov_base = const_cast<char*>(buffer.data);
+      iovecs[i].iov_len = buffer.length;
+      msghdr& hdr = messages[i].msg_hdr;
+      memset(&hdr, 0, sizeof(hdr));
+      hdr.msg_name = &saddr;
+      hdr.msg_namelen = static_cast<socklen_t>(len);
+      hdr.msg_iov = &iovecs[i];
+      hdr.msg_iovlen = 1;
+      messages[i].msg_len = 0;
+    }
+    // Suppress SIGPIPE. See PhysicalSocket::Send for explanation.
+    int sent = DoSendMmsg(s_, messages.data(), static_cast<unsigned>(count),
+                          MSG_NOSIGNAL);
+    UpdateLastError();
+    if (sent <= 0) {
+      if (IsBlockingError(GetError()))
+        EnableEvents(DE_WRITE);
+      return total > 0 ? total : sent;
+    }
+    total += sent;
+    if (static_cast<size_t>(sent) < count) {
+      // The send buffer filled up part way through the batch.
+      EnableEvents(DE_WRITE);
+      break;
+    }
+  }
+  return total;
+}
+#endif  // WEBRTC_USE_EPOLL
+
 int PhysicalSocket::Recv(void* buffer, size_t length, int64_t* timestamp) {
   int received =
       ::recv(s_, static_cast<char*>(buffer), static_cast<int>(length), 0);
@@ -427,10 +540,18 @@ int PhysicalSocket::RecvFrom(void* buffer,
   sockaddr_storage addr_storage;
   socklen_t addr_len = sizeof(addr_storage);
   sockaddr* addr = reinterpret_cast<sockaddr*>(&addr_storage);
-  int received = ::recvfrom(s_, static_cast<char*>(buffer),
-                            static_cast<int>(length), 0, addr, &addr_len);
-  if (timestamp) {
-    *timestamp = GetSocketRecvTimestamp(s_);
+  int received;
+#if defined(WEBRTC_USE_EPOLL)
+  if (udp_ && timestamp) {
+    received = RecvFromWithTimestamp(buffer, length, &addr_storage, timestamp);
+  } else
+#endif
+  {
+    received = ::recvfrom(s_, static_cast<char*>(buffer),
+                          static_cast<int>(length), 0, addr, &addr_len);
+    if (timestamp) {
+      *timestamp = GetSocketRecvTimestamp(s_);
+    }
   }
   UpdateLastError();
   if ((received >= 0) && (out_addr != nullptr))
@@ -446,6 +567,151 @@ int PhysicalSocket::RecvFrom(void* buffer,
   return received;
 }
 
+#if defined(WEBRTC_USE_EPOLL)
+void PhysicalSocket::EnableRecvTimestamps() {
+  // NIC timestamps are reported once hardware timestamping is turned on for
+  // the interface (SIOCSHWTSTAMP), which needs privileges and is left to the
+  // system configuration. Other datagrams carry the kernel's timestamp.
+  int flags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE |
+              SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE;
+  if (::setsockopt(s_, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) ==
+      0) {
+    return;
+  }
+  int enable = 1;
+  ::setsockopt(s_, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable));
+}
+
+int64_t PhysicalSocket::GetRecvTimestamp(const msghdr& hdr,
+                                         int64_t now_us,
+                                         int64_t wall_clock_offset_us) {
+  for (cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr); cmsg != nullptr;
+       cmsg = CMSG_NXTHDR(const_cast<msghdr*>(&hdr), cmsg)) {
+    if (cmsg->cmsg_level != SOL_SOCKET)
+      continue;
+    timespec software_ts = {};
+    if (cmsg->cmsg_type == SCM_TIMESTAMPING) {
+      scm_timestamping timestamps;
+      memcpy(&timestamps, CMSG_DATA(cmsg), sizeof(timestamps));
+      // ts[0] is the kernel's timestamp and ts[2] the NIC's, either zero if
+      // not taken.
+      const timespec& hardware_ts = timestamps.ts[2];
+      if (hardware_ts.tv_sec != 0 || hardware_ts.tv_nsec != 0) {
+        return FromHardwareTimestamp(TimespecToMicros(hardware_ts), now_us);
+      }
+      software_ts = timestamps.ts[0];
+    } else if (cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+      memcpy(&software_ts, CMSG_DATA(cmsg), sizeof(software_ts));
+    } else {
+      continue;
+    }
+    if (software_ts.tv_sec == 0 && software_ts.tv_nsec == 0)
+      return -1;
+    // Wall clock adjustments may place the result slightly in the future.
+    return std::min(TimespecToMicros(software_ts) - wall_clock_offset_us,
+                    now_us);
+  }
+  return -1;
+}
+
+int64_t PhysicalSocket::FromHardwareTimestamp(int64_t hardware_us,
+                                              int64_t now_us) {
+  // The NIC clock need not relate to any system clock. Its offset to
+  // rtc::TimeMicros() is estimated as the smallest difference seen between
+  // reading a datagram and its NIC timestamp, i.e. the least queued one, so
+  // that queueing delay doesn't add jitter to the result.
+  int64_t offset_us = now_us - hardware_us;
+  if (!hardware_clock_offset_us_ || offset_us < *hardware_clock_offset_us_ ||
+      offset_us - *hardware_clock_offset_us_ > kMaxHardwareTimestampLagUs) {
+    hardware_clock_offset_us_ = offset_us;
+  }
+  return hardware_us + *hardware_clock_offset_us_;
+}
+
+int PhysicalSocket::RecvFromWithTimestamp(void* buffer,
+                                          size_t length,
+                                          sockaddr_storage* addr,
+                                          int64_t* timestamp) {
+  // SIOCGSTAMP would need a second system call, so the timestamp is read
+  // from a control message along with the datagram.
+  iovec iov;
+  iov.iov_base = buffer;
+  iov.iov_len = length;
+  RecvControlBuffer control;
+  msghdr hdr;
+  memset(&hdr, 0, sizeof(hdr));
+  hdr.msg_name = addr;
+  hdr.msg_namelen = sizeof(*addr);
+  hdr.msg_iov = &iov;
+  hdr.msg_iovlen = 1;
+  hdr.msg_control = control.data;
+  hdr.msg_controllen = sizeof(control.data);
+  int received = ::recvmsg(s_, &hdr, 0);
+  *timestamp = -1;
+  if (received >= 0) {
+    int error = errno;
+    *timestamp = GetRecvTimestamp(hdr, TimeMicros(), GetWallClockOffset());
+    errno = error;
+  }
+  return received;
+}
+
+int PhysicalSocket::RecvFromBatch(ArrayView<ReceiveBuffer> buffers) {
+  if (!udp_ || buffers.size() <= 1)
+    return Socket::RecvFromBatch(buffers);
+
+  // SIOCGSTAMP only reports the timestamp of the last datagram read, so
+  // per-datagram timestamps are taken from control messages.
+  const size_t count = std::min(buffers.size(), kMaxRecvBatchSize);
+  std::array<mmsghdr, kMaxRecvBatchSize> messages;
+  std::array<iovec, kMaxRecvBatchSize> iovecs;
+  std::array<sockaddr_storage, kMaxRecvBatchSize> addresses;
+  std::array<RecvControlBuffer, kMaxRecvBatchSize> controls;
+  for (size_t i = 0; i < count; ++i) {
+    iovecs[i].iov_base = buffers[i].data;
+    iovecs[i].iov_len = buffers[i].capacity;
+    msghdr& hdr = messages[i].msg_hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.msg_name = &addresses[i];
+    hdr.msg_namelen = sizeof(addresses[i]);
+    hdr.msg_iov = &iovecs[i];
+    hdr.msg_iovlen = 1;
+    hdr.msg_control = controls[i].data;
+    hdr.msg_controllen = sizeof(controls[i].data);
+    messages[i].msg_len = 0;
+  }
+
+  int received = ::recvmmsg(s_, messages.data(), static_cast<unsigned>(count),
+                            MSG_DONTWAIT, nullptr);
+  UpdateLastError();
+  int error = GetError();
+  bool success = (received >= 0) || IsBlockingError(error);
+  EnableEvents(DE_READ);
+  if (!success) {
+    RTC_LOG_F(LS_VERBOSE) << "Error = " << error;
+  }
+  if (received <= 0)
+    return received;
+
+  const int64_t now_us = TimeMicros();
+  const int64_t wall_clock_offset_us = GetWallClockOffset();
+  for (int i = 0; i < received; ++i) {
+    ReceiveBuffer& buffer = buffers[i];
+    const msghdr& hdr = messages[i].msg_hdr;
+    buffer.length = messages[i].msg_len;
+    SocketAddressFromSockAddrStorage(addresses[i], &buffer.source);
+    buffer.timestamp = GetRecvTimestamp(hdr, now_us, wall_clock_offset_us);
+    buffer.ecn = GetRecvEcn(hdr);
+    if (hdr.msg_flags & MSG_TRUNC) {
+      RTC_LOG(LS_WARNING) << "Datagram of " << buffer.length
+                          << " bytes truncated to " << buffer.capacity;
+      buffer.length = buffer.capacity;
+    }
+  }
+  return received;
+}
+#endif  // WEBRTC_USE_EPOLL
+
 int PhysicalSocket::Listen(int backlog) {
   int err = ::listen(s_, backlog);
   UpdateLastError();
@@ -510,6 +776,15 @@ int PhysicalSocket::DoSendTo(SOCKET socket,
   return ::sendto(socket, buf, len, flags, dest_addr, addrlen);
 }
 
+#if defined(WEBRTC_USE_EPOLL)
+int PhysicalSocket::DoSendMmsg(SOCKET socket,
+                               mmsghdr* messages,
+                               unsigned int count,
+                               int flags) {
+  return ::sendmmsg(socket, messages, count, flags);
+}
+#endif
+
 void PhysicalSocket::OnResolveResult(AsyncResolverInterface* resolver) {
   if (resolver != resolver_) {
     return;
@@ -597,8 +872,46 @@ int PhysicalSocket::TranslateOption(Option opt, int* slevel, int* sopt) {
 #else
       RTC_LOG(LS_WARNING) << "Socket::OPT_DSCP not supported.";
       return -1;
+#endif
+    case OPT_SEND_ECN:
+#if defined(WEBRTC_POSIX)
+      if (family_ == AF_INET6) {
+        *slevel = IPPROTO_IPV6;
+        *sopt = IPV6_TCLASS;
+      } else {
+        *slevel = IPPROTO_IP;
+        *sopt = IP_TOS;
+      }
+      break;
+#else
+      RTC_LOG(LS_WARNING) << "Socket::OPT_SEND_ECN not supported.";
+      return -1;
+#endif
+    case OPT_RECV_ECN:
+#if defined(WEBRTC_POSIX)
+      if (family_ == AF_INET6) {
+        *slevel = IPPROTO_IPV6;
+        *sopt = IPV6_RECVTCLASS;
+      } else {
+        *slevel = IPPROTO_IP;
+        *sopt = IP_RECVTOS;
+      }
+      break;
+#else
+      RTC_LOG(LS_WARNING) << "Socket::OPT_RECV_ECN not supported.";
+      return -1;
+#endif
+    case OPT_REUSEPORT:
+#if defined(WEBRTC_POSIX) && defined(SO_REUSEPORT)
+      *slevel = SOL_SOCKET;
+      *sopt = SO_REUSEPORT;
+      break;
+#else
+      RTC_LOG(LS_WARNING) << "Socket::OPT_REUSEPORT not supported.";
+      return -1;
 #endif
     case OPT_RTP_SENDTIME_EXTN_ID:
+    case OPT_RECV_BATCH_SIZE:
       return -1;  // No logging is necessary as this not a OS socket option.
     default:
       RTC_DCHECK_NOTREACHED();
@@ -1052,20 +1365,35 @@ class Signaler : public Dispatcher {
 };
 #endif  // WEBRTC_WIN
 
+#if defined(WEBRTC_USE_IO_URING)
+// Submission queue size of the io_uring used instead of epoll; the polls
+// queued while processing one batch of events are submitted together.
+static constexpr unsigned kIoUringEntries = 1024;
+#endif
+
 PhysicalSocketServer::PhysicalSocketServer()
+    : PhysicalSocketServer(/*use_io_uring=*/false) {}
+
+PhysicalSocketServer::PhysicalSocketServer(bool use_io_uring)
     :
+#if defined(WEBRTC_USE_IO_URING)
+      io_uring_(use_io_uring ? IoUring::Create(kIoUringEntries) : nullptr),
+#endif
 #if defined(WEBRTC_USE_EPOLL)
       // Since Linux 2.6.8, the size argument is ignored, but must be greater
       // than zero. Before that the size served as hint to the kernel for the
       // amount of space to initially allocate in internal data structures.
-      epoll_fd_(epoll_create(FD_SETSIZE)),
+      epoll_fd_(uses_io_uring() ? INVALID_SOCKET : epoll_create(FD_SETSIZE)),
 #endif
 #if defined(WEBRTC_WIN)
       socket_ev_(WSACreateEvent()),
 #endif
       fWait_(false) {
 #if defined(WEBRTC_USE_EPOLL)
-  if (epoll_fd_ == -1) {
+  if (use_io_uring && !uses_io_uring()) {
+    RTC_LOG(LS_WARNING) << "io_uring unavailable, falling back to epoll.";
+  }
+  if (epoll_fd_ == -1 && !uses_io_uring()) {
     // Not an error, will fall back to "select" below.
     RTC_LOG_E(LS_WARNING, EN, errno) << "epoll_create";
     // Note that -1 == INVALID_SOCKET, the alias used by later checks.
@@ -1093,6 +1421,14 @@ void PhysicalSocketServer::WakeUp() {
   signal_wakeup_->Signal();
 }
 
+bool PhysicalSocketServer::uses_io_uring() const {
+#if defined(WEBRTC_USE_IO_URING)
+  return io_uring_ != nullptr;
+#else
+  return false;
+#endif
+}
+
 Socket* PhysicalSocketServer::CreateSocket(int family, int type) {
   SocketDispatcher* dispatcher = new SocketDispatcher(this);
   if (dispatcher->Create(family, type)) {
@@ -1123,6 +1459,11 @@ void PhysicalSocketServer::Add(Dispatcher* pdispatcher) {
   uint64_t key = next_dispatcher_key_++;
   dispatcher_by_key_.emplace(key, pdispatcher);
   key_by_dispatcher_.emplace(pdispatcher, key);
+#if defined(WEBRTC_USE_IO_URING)
+  if (io_uring_) {
+    UpdateIoUring(pdispatcher, key);
+  }
+#endif  // WEBRTC_USE_IO_URING
 #if defined(WEBRTC_USE_EPOLL)
   if (epoll_fd_ != INVALID_SOCKET) {
     AddEpoll(pdispatcher, key);
@@ -1141,6 +1482,11 @@ void PhysicalSocketServer::Remove(Dispatcher* pdispatcher) {
   uint64_t key = key_by_dispatcher_.at(pdispatcher);
   key_by_dispatcher_.erase(pdispatcher);
   dispatcher_by_key_.erase(key);
+#if defined(WEBRTC_USE_IO_URING)
+  if (io_uring_) {
+    RemoveIoUring(key);
+  }
+#endif  // WEBRTC_USE_IO_URING
 #if defined(WEBRTC_USE_EPOLL)
   if (epoll_fd_ != INVALID_SOCKET) {
     RemoveEpoll(pdispatcher);
@@ -1149,6 +1495,16 @@ void PhysicalSocketServer::Remove(Dispatcher* pdispatcher) {
 }
 
 void PhysicalSocketServer::Update(Dispatcher* pdispatcher) {
+#if defined(WEBRTC_USE_IO_URING)
+  if (io_uring_) {
+    CritScope cs(&crit_);
+    auto it = key_by_dispatcher_.find(pdispatcher);
+    if (it != key_by_dispatcher_.end()) {
+      UpdateIoUring(pdispatcher, it->second);
+    }
+    return;
+  }
+#endif  // WEBRTC_USE_IO_URING
 #if defined(WEBRTC_USE_EPOLL)
   if (epoll_fd_ == INVALID_SOCKET) {
     return;
@@ -1176,7 +1532,13 @@ bool PhysicalSocketServer::Wait(int cmsWait, bool process_io) {
   // "select" to support sockets larger than FD_SETSIZE.
   if (!process_io) {
     return WaitPoll(cmsWait, signal_wakeup_);
-  } else if (epoll_fd_ != INVALID_SOCKET) {
+  }
+#if defined(WEBRTC_USE_IO_URING)
+  if (io_uring_) {
+    return WaitIoUring(cmsWait);
+  }
+#endif
+  if (epoll_fd_ != INVALID_SOCKET) {
     return WaitEpoll(cmsWait);
   }
 #endif
@@ -1578,6 +1940,137 @@ bool PhysicalSocketServer::WaitPoll(int cmsWait, Dispatcher* dispatcher) {
   return true;
 }
 
+#if defined(WEBRTC_USE_IO_URING)
+
+static uint32_t GetPollEvents(uint32_t ff) {
+  uint32_t events = 0;
+  if (ff & (DE_READ | DE_ACCEPT)) {
+    events |= POLLIN;
+  }
+  if (ff & (DE_WRITE | DE_CONNECT)) {
+    events |= POLLOUT;
+  }
+  return events;
+}
+
+void PhysicalSocketServer::UpdateIoUring(Dispatcher* pdispatcher,
+                                         uint64_t key) {
+  int fd = pdispatcher->GetDescriptor();
+  uint32_t poll_mask = fd == INVALID_SOCKET
+                           ? 0
+                           : GetPollEvents(pdispatcher->GetRequestedEvents());
+  IoUringPoll& poll = io_uring_poll_by_key_[key];
+  if (poll.poll_id != 0) {
+    if (poll.poll_mask == poll_mask) {
+      return;
+    }
+    io_uring_->QueuePollRemove(poll.poll_id);
+    key_by_io_uring_poll_id_.erase(poll.poll_id);
+    poll.poll_id = 0;
+  }
+  // Like with epoll, dispatchers without requested events (e.g. closed
+  // sockets) aren't polled at all.
+  if (poll_mask != 0) {
+    poll.poll_id = next_io_uring_poll_id_++;
+    poll.poll_mask = poll_mask;
+    key_by_io_uring_poll_id_.emplace(poll.poll_id, key);
+    io_uring_->QueuePollAdd(fd, poll_mask, poll.poll_id);
+  }
+  if (!processing_io_uring_completions_) {
+    // Called from outside the wait loop, possibly while another thread
+    // waits; make the change take effect right away.
+    io_uring_->Submit();
+  }
+}
+
+void PhysicalSocketServer::RemoveIoUring(uint64_t key) {
+  auto it = io_uring_poll_by_key_.find(key);
+  if (it == io_uring_poll_by_key_.end()) {
+    return;
+  }
+  if (it->second.poll_id != 0) {
+    io_uring_->QueuePollRemove(it->second.poll_id);
+    key_by_io_uring_poll_id_.erase(it->second.poll_id);
+    if (!processing_io_uring_completions_) {
+      io_uring_->Submit();
+    }
+  }
+  io_uring_poll_by_key_.erase(it);
+}
+
+void PhysicalSocketServer::OnIoUringCompletion(uint64_t poll_id,
+                                               int32_t result) {
+  auto key_it = key_by_io_uring_poll_id_.find(poll_id);
+  if (key_it == key_by_io_uring_poll_id_.end()) {
+    // Removed or replaced poll, or a poll removal.
+    return;
+  }
+  const uint64_t key = key_it->second;
+  key_by_io_uring_poll_id_.erase(key_it);
+  io_uring_poll_by_key_[key].poll_id = 0;
+
+  auto dispatcher_it = dispatcher_by_key_.find(key);
+  if (dispatcher_it == dispatcher_by_key_.end()) {
+    return;
+  }
+  Dispatcher* pdispatcher = dispatcher_it->second;
+  if (result < 0) {
+    RTC_LOG(LS_WARNING) << "io_uring poll failed: " << strerror(-result);
+  } else {
+    bool readable = (result & (POLLIN | POLLPRI));
+    bool writable = (result & POLLOUT);
+    bool error = (result & (POLLRDHUP | POLLERR | POLLHUP));
+    ProcessEvents(pdispatcher, readable, writable, error, error);
+  }
+
+  // One-shot polls need re-arming, unless the dispatcher went away or got
+  // re-armed while processing its events.
+  if (dispatcher_by_key_.count(key)) {
+    UpdateIoUring(pdispatcher, key);
+  }
+}
+
+bool PhysicalSocketServer::WaitIoUring(int cmsWait) {
+  RTC_DCHECK(io_uring_);
+  int64_t tvWait = -1;
+  int64_t tvStop = -1;
+  if (cmsWait != kForever) {
+    tvWait = cmsWait;
+    tvStop = TimeAfter(cmsWait);
+  }
+
+  fWait_ = true;
+  while (fWait_) {
+    // Submits the polls re-armed while processing the previous batch along
+    // with the wait.
+    int result = io_uring_->Wait(static_cast<int>(tvWait));
+    if (result < 0 && result != -ETIME && result != -EINTR) {
+      RTC_LOG(LS_ERROR) << "io_uring_enter: " << strerror(-result);
+      return false;
+    }
+    {
+      CritScope cr(&crit_);
+      processing_io_uring_completions_ = true;
+      io_uring_->ReapCompletions([this](uint64_t poll_id, int32_t result) {
+        OnIoUringCompletion(poll_id, result);
+      });
+      processing_io_uring_completions_ = false;
+    }
+
+    if (cmsWait != kForever) {
+      tvWait = TimeDiff(tvStop, TimeMillis());
+      if (tvWait <= 0) {
+        // Return success on timeout.
+        return true;
+      }
+    }
+  }
+
+  return true;
+}
+
+#endif  // WEBRTC_USE_IO_URING
+
 #endif  // WEBRTC_USE_EPOLL
 
 #endif  // WEBRTC_POSIX
@@ -16,11 +16,16 @@
 #define WEBRTC_USE_EPOLL 1
 #endif
 
+#if defined(WEBRTC_USE_EPOLL)
+#include "rtc_base/io_uring.h"
+#endif
+
 #include <array>
 #include <memory>
 #include <unordered_map>
 #include <vector>
 
+#include "absl/types/optional.h"
 #include "rtc_base/async_resolver.h"
 #include "rtc_base/async_resolver_interface.h"
 #include "rtc_base/deprecated/recursive_critical_section.h"
@@ -81,6 +86,13 @@ class RTC_EXPORT PhysicalSocketServer : public SocketServer {
   void Remove(Dispatcher* dispatcher);
   void Update(Dispatcher* dispatcher);
 
+ protected:
+  // With `use_io_uring`, waits for socket events with io_uring instead of
+  // epoll where the kernel supports it. See IoUringSocketServer.
+  explicit PhysicalSocketServer(bool use_io_uring);
+
+  bool uses_io_uring() const;
+
  private:
   // The number of events to process with one call to "epoll_wait".
   static constexpr size_t kNumEpollEvents = 128;
@@ -94,12 +106,42 @@ class RTC_EXPORT PhysicalSocketServer : public SocketServer {
   void UpdateEpoll(Dispatcher* dispatcher, uint64_t key);
   bool WaitEpoll(int cms);
   bool WaitPoll(int cms, Dispatcher* dispatcher);
+#if defined(WEBRTC_USE_IO_URING)
+  // Makes sure a poll for the dispatcher's requested events is queued, and
+  // submits it unless it will go out with the next wait anyway.
+  void UpdateIoUring(Dispatcher* dispatcher, uint64_t key)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  void RemoveIoUring(uint64_t key) RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  void OnIoUringCompletion(uint64_t poll_id, int32_t result)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  bool WaitIoUring(int cms);
+#endif  // WEBRTC_USE_IO_URING
 
   // This array is accessed in isolation by a thread calling into Wait().
   // It's useless to use a SequenceChecker to guard it because a socket
   // server can outlive the thread it's bound to, forcing the Wait call
   // to have to reset the sequence checker on Wait calls.
   std::array<epoll_event, kNumEpollEvents> epoll_events_;
+#if defined(WEBRTC_USE_IO_URING)
+  // Set instead of `epoll_fd_` when waiting with io_uring. Each dispatcher has
+  // at most one one-shot poll in flight, re-armed after its events have been
+  // processed, which keeps epoll's level triggered semantics.
+  const std::unique_ptr<IoUring> io_uring_;
+  struct IoUringPoll {
+    uint64_t poll_id = 0;  // 0 if not armed.
+    uint32_t poll_mask = 0;
+  };
+  std::unordered_map<uint64_t, IoUringPoll> io_uring_poll_by_key_
+      RTC_GUARDED_BY(crit_);
+  // Polls get new ids when re-armed, so that completions of removed or
+  // replaced polls can be told apart (and dropped).
+  std::unordered_map<uint64_t, uint64_t> key_by_io_uring_poll_id_
+      RTC_GUARDED_BY(crit_);
+  uint64_t next_io_uring_poll_id_ RTC_GUARDED_BY(crit_) = 1;
+  // True while the waiting thread processes completions; polls queued in the
+  // meantime are submitted by the next wait.
+  bool processing_io_uring_completions_ RTC_GUARDED_BY(crit_) = false;
+#endif  // WEBRTC_USE_IO_URING
   const int epoll_fd_ = INVALID_SOCKET;
 #endif  // WEBRTC_USE_EPOLL
   // uint64_t keys are used to uniquely identify a dispatcher in order to avoid
@@ -155,12 +197,21 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
   int SendTo(const void* buffer,
              size_t length,
              const SocketAddress& addr) override;
+#if defined(WEBRTC_USE_EPOLL)
+  // Uses sendmmsg() to send several datagrams with one system call.
+  int SendToBatch(ArrayView<const SendBuffer> buffers,
+                  const SocketAddress& addr) override;
+#endif
 
   int Recv(void* buffer, size_t length, int64_t* timestamp) override;
   int RecvFrom(void* buffer,
                size_t length,
                SocketAddress* out_addr,
                int64_t* timestamp) override;
+#if defined(WEBRTC_USE_EPOLL)
+  // Uses recvmmsg() to read several datagrams with one system call.
+  int RecvFromBatch(ArrayView<ReceiveBuffer> buffers) override;
+#endif
 
   int Listen(int backlog) override;
   Socket* Accept(SocketAddress* out_addr) override;
@@ -178,6 +229,14 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
   // Make virtual so ::send can be overwritten in tests.
   virtual int DoSend(SOCKET socket, const char* buf, int len, int flags);
 
+#if defined(WEBRTC_USE_EPOLL)
+  // Make virtual so ::sendmmsg can be overwritten in tests.
+  virtual int DoSendMmsg(SOCKET socket,
+                         mmsghdr* messages,
+                         unsigned int count,
+                         int flags);
+#endif
+
   // Make virtual so ::sendto can be overwritten in tests.
   virtual int DoSendTo(SOCKET socket,
                        const char* buf,
@@ -202,6 +261,10 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
   SOCKET s_;
   bool udp_;
   int family_ = 0;
+  // The DSCP code and the EcnMarking share the IP header byte set by
+  // OPT_DSCP and OPT_SEND_ECN.
+  int dscp_ = 0;
+  int send_ecn_ = 0;
   mutable webrtc::Mutex mutex_;
   int error_ RTC_GUARDED_BY(mutex_);
   ConnState state_;
@@ -212,6 +275,32 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
 #endif
 
  private:
+#if defined(WEBRTC_USE_EPOLL)
+  // Upper bound on datagrams read by a single RecvFromBatch() call.
+  static constexpr size_t kMaxRecvBatchSize = 64;
+  // Upper bound on datagrams written by a single sendmmsg() call.
+  static constexpr size_t kMaxSendBatchSize = 64;
+
+  // Turns on a receive timestamp for every datagram, from SO_TIMESTAMPING
+  // where available and SO_TIMESTAMPNS otherwise.
+  void EnableRecvTimestamps();
+  // Returns the receive time carried by the control messages of `hdr` in the
+  // rtc::TimeMicros() clock, or -1 if there is none. `now_us` is the time
+  // the datagram was read.
+  int64_t GetRecvTimestamp(const msghdr& hdr,
+                           int64_t now_us,
+                           int64_t wall_clock_offset_us);
+  int64_t FromHardwareTimestamp(int64_t hardware_us, int64_t now_us);
+  // Like ::recvfrom, reading the receive time along with the datagram.
+  int RecvFromWithTimestamp(void* buffer,
+                            size_t length,
+                            sockaddr_storage* addr,
+                            int64_t* timestamp);
+
+  // Offset from the NIC clock to rtc::TimeMicros(), once a datagram with a
+  // NIC timestamp has been read.
+  absl::optional<int64_t> hardware_clock_offset_us_;
+#endif
   uint8_t enabled_events_ = 0;
 };
 
@@ -472,6 +472,137 @@ TEST_F(PhysicalSocketTest, TestSocketRecvTimestampIPv6) {
 }
 #endif
 
+#if defined(WEBRTC_USE_EPOLL)
+TEST_F(PhysicalSocketTest, RecvFromBatchReadsAllQueuedDatagrams) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<Socket> socket(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, socket->Bind(SocketAddress(kIPv4Loopback, 0)));
+  SocketAddress address = socket->GetLocalAddress();
+
+  EXPECT_EQ(3, socket->SendTo("foo", 3, address));
+  EXPECT_EQ(4, socket->SendTo("barr", 4, address));
+  EXPECT_EQ(1, socket->SendTo("z", 1, address));
+  // Wait briefly for the datagrams to be queued on the loopback interface.
+  Thread::SleepMs(100);
+
+  char data[4][16];
+  Socket::ReceiveBuffer buffers[4];
+  for (int i = 0; i < 4; ++i) {
+    buffers[i].data = data[i];
+    buffers[i].capacity = sizeof(data[i]);
+  }
+  ASSERT_EQ(3, socket->RecvFromBatch(buffers));
+  EXPECT_EQ("foo", std::string(buffers[0].data, buffers[0].length));
+  EXPECT_EQ("barr", std::string(buffers[1].data, buffers[1].length));
+  EXPECT_EQ("z", std::string(buffers[2].data, buffers[2].length));
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(address, buffers[i].source);
+    EXPECT_GT(buffers[i].timestamp, -1);
+  }
+  EXPECT_LE(buffers[0].timestamp, buffers[2].timestamp);
+
+  // Nothing left to read.
+  EXPECT_EQ(-1, socket->RecvFromBatch(buffers));
+  EXPECT_TRUE(socket->IsBlocking());
+}
+
+TEST_F(PhysicalSocketTest, RecvTimestampsUseTimeMicrosClock) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<Socket> socket(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, socket->Bind(SocketAddress(kIPv4Loopback, 0)));
+  SocketAddress address = socket->GetLocalAddress();
+
+  // Receive timestamps are taken by the kernel in wall clock time, and must
+  // come out in the clock of rtc::TimeMicros(), which packet times are
+  // compared against.
+  const int64_t kToleranceUs = 1000;
+  int64_t send_time_us = TimeMicros();
+  EXPECT_EQ(3, socket->SendTo("foo", 3, address));
+  EXPECT_EQ(3, socket->SendTo("bar", 3, address));
+  EXPECT_EQ(3, socket->SendTo("baz", 3, address));
+  Thread::SleepMs(100);
+
+  char buffer[16];
+  int64_t timestamp;
+  EXPECT_EQ(3, socket->RecvFrom(buffer, sizeof(buffer), nullptr, &timestamp));
+  int64_t recv_time_us = TimeMicros();
+  EXPECT_GE(timestamp, send_time_us - kToleranceUs);
+  EXPECT_LE(timestamp, recv_time_us);
+
+  char data[2][16];
+  Socket::ReceiveBuffer buffers[2];
+  for (int i = 0; i < 2; ++i) {
+    buffers[i].data = data[i];
+    buffers[i].capacity = sizeof(data[i]);
+  }
+  ASSERT_EQ(2, socket->RecvFromBatch(buffers));
+  recv_time_us = TimeMicros();
+  for (const Socket::ReceiveBuffer& received : buffers) {
+    EXPECT_GE(received.timestamp, send_time_us - kToleranceUs);
+    EXPECT_LE(received.timestamp, recv_time_us);
+    // Queued for 100 ms, so not merely the time of reading.
+    EXPECT_LT(received.timestamp, recv_time_us - 50000);
+  }
+}
+
+TEST_F(PhysicalSocketTest, RecvFromBatchReadsEcnMarking) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<Socket> socket(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, socket->Bind(SocketAddress(kIPv4Loopback, 0)));
+  SocketAddress address = socket->GetLocalAddress();
+  ASSERT_EQ(0, socket->SetOption(Socket::OPT_RECV_ECN, 1));
+
+  ASSERT_EQ(0, socket->SetOption(Socket::OPT_DSCP, 46));
+  ASSERT_EQ(0, socket->SetOption(Socket::OPT_SEND_ECN,
+                                 static_cast<int>(EcnMarking::kEct1)));
+  EXPECT_EQ(3, socket->SendTo("foo", 3, address));
+  ASSERT_EQ(0, socket->SetOption(Socket::OPT_SEND_ECN,
+                                 static_cast<int>(EcnMarking::kCe)));
+  EXPECT_EQ(3, socket->SendTo("bar", 3, address));
+  ASSERT_EQ(0, socket->SetOption(Socket::OPT_SEND_ECN,
+                                 static_cast<int>(EcnMarking::kNotEct)));
+  EXPECT_EQ(3, socket->SendTo("baz", 3, address));
+  Thread::SleepMs(100);
+
+  // The DSCP code and the ECN field are kept apart.
+  int value;
+  ASSERT_EQ(0, socket->GetOption(Socket::OPT_DSCP, &value));
+  EXPECT_EQ(46, value);
+  EXPECT_EQ(-1, socket->SetOption(Socket::OPT_SEND_ECN, 4));
+
+  char data[3][16];
+  Socket::ReceiveBuffer buffers[3];
+  for (int i = 0; i < 3; ++i) {
+    buffers[i].data = data[i];
+    buffers[i].capacity = sizeof(data[i]);
+  }
+  ASSERT_EQ(3, socket->RecvFromBatch(buffers));
+  EXPECT_EQ(EcnMarking::kEct1, buffers[0].ecn);
+  EXPECT_EQ(EcnMarking::kCe, buffers[1].ecn);
+  EXPECT_EQ(EcnMarking::kNotEct, buffers[2].ecn);
+  for (const Socket::ReceiveBuffer& buffer : buffers)
+    EXPECT_GT(buffer.timestamp, -1);
+}
+
+TEST_F(PhysicalSocketTest, SendToBatchSendsEachDatagram) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<Socket> socket(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, socket->Bind(SocketAddress(kIPv4Loopback, 0)));
+  SocketAddress address = socket->GetLocalAddress();
+
+  const Socket::SendBuffer packets[] = {{"one", 3}, {"three", 5}};
+  EXPECT_EQ(2, socket->SendToBatch(packets, address));
+  Thread::SleepMs(100);
+
+  char buffer[16];
+  int64_t timestamp;
+  EXPECT_EQ(3, socket->RecvFrom(buffer, sizeof(buffer), nullptr, &timestamp));
+  EXPECT_EQ("one", std::string(buffer, 3));
+  EXPECT_EQ(5, socket->RecvFrom(buffer, sizeof(buffer), nullptr, &timestamp));
+  EXPECT_EQ("three", std::string(buffer, 5));
+}
+#endif
+
 // Verify that if the socket was unable to be bound to a real network interface
 // (not loopback), Bind will return an error.
 TEST_F(PhysicalSocketTest,
@@ -16,11 +16,13 @@
 #include <memory>
 #include <utility>
 
+#include "api/sequence_checker.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/location.h"
 #include "rtc_base/message_handler.h"
 #include "rtc_base/ref_counted_object.h"
 #include "rtc_base/ssl_identity.h"
+#include "rtc_base/time_utils.h"
 
 namespace rtc {
 
@@ -30,6 +32,35 @@ namespace {
 const char kIdentityName[] = "WebRTC";
 const uint64_t kYearInSeconds = 365 * 24 * 60 * 60;
 
+bool SameKeyParams(const KeyParams& a, const KeyParams& b) {
+  if (a.type() != b.type()) {
+    return false;
+  }
+  if (a.type() == KT_RSA) {
+    return a.rsa_params().mod_size == b.rsa_params().mod_size &&
+           a.rsa_params().pub_exp == b.rsa_params().pub_exp;
+  }
+  return a.ec_curve() == b.ec_curve();
+}
+
+// The generators that RTCCertificateCache::CreateGenerator() returns.
+class CachedRTCCertificateGenerator : public RTCCertificateGeneratorInterface {
+ public:
+  explicit CachedRTCCertificateGenerator(
+      scoped_refptr<RTCCertificateCache> cache)
+      : cache_(std::move(cache)) {}
+
+  void GenerateCertificateAsync(
+      const KeyParams& key_params,
+      const absl::optional<uint64_t>& expires_ms,
+      const scoped_refptr<RTCCertificateGeneratorCallback>& callback) override {
+    cache_->GenerateCertificateAsync(key_params, expires_ms, callback);
+  }
+
+ private:
+  const scoped_refptr<RTCCertificateCache> cache_;
+};
+
 }  // namespace
 
 // static
@@ -91,4 +122,102 @@ void RTCCertificateGenerator::GenerateCertificateAsync(
   });
 }
 
+// Hands the certificate generated for an entry back to the cache.
+class RTCCertificateCache::GenerationCallback
+    : public RTCCertificateGeneratorCallback {
+ public:
+  GenerationCallback(scoped_refptr<RTCCertificateCache> cache,
+                     const KeyParams& key_params)
+      : cache_(std::move(cache)), key_params_(key_params) {}
+
+  void OnSuccess(const scoped_refptr<RTCCertificate>& certificate) override {
+    cache_->OnCertificateGenerated(key_params_, certificate);
+  }
+  void OnFailure() override {
+    cache_->OnCertificateGenerated(key_params_, nullptr);
+  }
+
+ private:
+  const scoped_refptr<RTCCertificateCache> cache_;
+  const KeyParams key_params_;
+};
+
+RTCCertificateCache::RTCCertificateCache(
+    Thread* signaling_thread,
+    std::unique_ptr<RTCCertificateGeneratorInterface> generator)
+    : signaling_thread_(signaling_thread), generator_(std::move(generator)) {
+  RTC_DCHECK(signaling_thread_);
+  RTC_DCHECK(generator_);
+}
+
+RTCCertificateCache::~RTCCertificateCache() = default;
+
+std::unique_ptr<RTCCertificateGeneratorInterface>
+RTCCertificateCache::CreateGenerator() {
+  return std::make_unique<CachedRTCCertificateGenerator>(
+      scoped_refptr<RTCCertificateCache>(this));
+}
+
+void RTCCertificateCache::GenerateCertificateAsync(
+    const KeyParams& key_params,
+    const absl::optional<uint64_t>& expires_ms,
+    const scoped_refptr<RTCCertificateGeneratorCallback>& callback) {
+  RTC_DCHECK_RUN_ON(signaling_thread_);
+  RTC_DCHECK(callback);
+  if (expires_ms || !key_params.IsValid()) {
+    generator_->GenerateCertificateAsync(key_params, expires_ms, callback);
+    return;
+  }
+
+  Entry* entry = FindEntry(key_params);
+  if (!entry) {
+    entries_.push_back(Entry{key_params, nullptr, {}});
+    entry = &entries_.back();
+  }
+  if (entry->certificate &&
+      entry->certificate->HasExpired(TimeUTCMillis() +
+                                     kMinRemainingLifetimeMs)) {
+    entry->certificate = nullptr;
+  }
+  if (entry->certificate) {
+    // Answer asynchronously, as generators do.
+    signaling_thread_->PostTask(
+        RTC_FROM_HERE, [cert = entry->certificate, cb = callback]() {
+          cb->OnSuccess(cert);
+        });
+    return;
+  }
+  entry->callbacks.push_back(callback);
+  if (entry->callbacks.size() == 1) {
+    generator_->GenerateCertificateAsync(
+        key_params, absl::nullopt,
+        make_ref_counted<GenerationCallback>(
+            scoped_refptr<RTCCertificateCache>(this), key_params));
+  }
+}
+
+RTCCertificateCache::Entry* RTCCertificateCache::FindEntry(
+    const KeyParams& key_params) {
+  for (Entry& entry : entries_) {
+    if (SameKeyParams(entry.key_params, key_params)) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+void RTCCertificateCache::OnCertificateGenerated(
+    const KeyParams& key_params,
+    scoped_refptr<RTCCertificate> certificate) {
+  RTC_DCHECK_RUN_ON(signaling_thread_);
+  Entry* entry = FindEntry(key_params);
+  RTC_DCHECK(entry);
+  entry->certificate = certificate;
+  std::vector<scoped_refptr<RTCCertificateGeneratorCallback>> callbacks;
+  callbacks.swap(entry->callbacks);
+  for (const auto& callback : callbacks) {
+    certificate ? callback->OnSuccess(certificate) : callback->OnFailure();
+  }
+}
+
 }  // namespace rtc
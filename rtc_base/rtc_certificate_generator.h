@@ -13,6 +13,9 @@
 
 #include <stdint.h>
 
+#include <memory>
+#include <vector>
+
 #include "absl/types/optional.h"
 #include "api/scoped_refptr.h"
 #include "rtc_base/ref_count.h"
@@ -20,6 +23,7 @@
 #include "rtc_base/ssl_identity.h"
 #include "rtc_base/system/rtc_export.h"
 #include "rtc_base/thread.h"
+#include "rtc_base/thread_annotations.h"
 
 namespace rtc {
 
@@ -84,6 +88,53 @@ class RTC_EXPORT RTCCertificateGenerator
   Thread* const worker_thread_;
 };
 
+// Shares certificates between the generators it creates, so that the
+// PeerConnections of a factory don't each generate a key. One certificate is
+// kept per `KeyParams`, and replaced by a new one when it comes close to
+// expiring; requests for a certificate with a specific `expires_ms` are
+// passed to the underlying generator. Since the connections then present the
+// same certificate, their fingerprints make them linkable to each other.
+class RTC_EXPORT RTCCertificateCache : public RefCountInterface {
+ public:
+  // Certificates with less than this left of their lifetime are not handed
+  // out anymore.
+  static constexpr uint64_t kMinRemainingLifetimeMs = 24 * 60 * 60 * 1000;
+
+  // `generator` is called, and the callbacks invoked, on `signaling_thread`.
+  RTCCertificateCache(
+      Thread* signaling_thread,
+      std::unique_ptr<RTCCertificateGeneratorInterface> generator);
+
+  // Returns a generator that is served by this cache, and keeps it alive.
+  std::unique_ptr<RTCCertificateGeneratorInterface> CreateGenerator();
+
+  void GenerateCertificateAsync(
+      const KeyParams& key_params,
+      const absl::optional<uint64_t>& expires_ms,
+      const scoped_refptr<RTCCertificateGeneratorCallback>& callback);
+
+ protected:
+  ~RTCCertificateCache() override;
+
+ private:
+  class GenerationCallback;
+
+  struct Entry {
+    KeyParams key_params;
+    scoped_refptr<RTCCertificate> certificate;
+    // Waiting for the certificate that is being generated.
+    std::vector<scoped_refptr<RTCCertificateGeneratorCallback>> callbacks;
+  };
+
+  Entry* FindEntry(const KeyParams& key_params);
+  void OnCertificateGenerated(const KeyParams& key_params,
+                              scoped_refptr<RTCCertificate> certificate);
+
+  Thread* const signaling_thread_;
+  const std::unique_ptr<RTCCertificateGeneratorInterface> generator_;
+  std::vector<Entry> entries_ RTC_GUARDED_BY(signaling_thread_);
+};
+
 }  // namespace rtc
 
 #endif  // RTC_BASE_RTC_CERTIFICATE_GENERATOR_H_
@@ -141,4 +141,113 @@ TEST_F(RTCCertificateGeneratorTest, GenerateWithInvalidParamsShouldFail) {
   EXPECT_FALSE(fixture_->certificate());
 }
 
+// Counts the certificates that the cache asks for, and optionally gives the
+// certificates a shorter lifetime.
+class CountingRTCCertificateGenerator
+    : public RTCCertificateGeneratorInterface {
+ public:
+  CountingRTCCertificateGenerator(Thread* signaling_thread,
+                                  Thread* worker_thread,
+                                  int* count,
+                                  absl::optional<uint64_t>* lifetime_ms)
+      : generator_(signaling_thread, worker_thread),
+        count_(count),
+        lifetime_ms_(lifetime_ms) {}
+
+  void GenerateCertificateAsync(
+      const KeyParams& key_params,
+      const absl::optional<uint64_t>& expires_ms,
+      const scoped_refptr<RTCCertificateGeneratorCallback>& callback) override {
+    ++*count_;
+    generator_.GenerateCertificateAsync(
+        key_params, expires_ms ? expires_ms : *lifetime_ms_, callback);
+  }
+
+ private:
+  RTCCertificateGenerator generator_;
+  int* const count_;
+  absl::optional<uint64_t>* const lifetime_ms_;
+};
+
+class RTCCertificateCacheTest : public ::testing::Test {
+ public:
+  RTCCertificateCacheTest() : worker_thread_(Thread::Create()) {
+    RTC_CHECK(worker_thread_->Start());
+    cache_ = make_ref_counted<RTCCertificateCache>(
+        Thread::Current(),
+        std::make_unique<CountingRTCCertificateGenerator>(
+            Thread::Current(), worker_thread_.get(), &generated_,
+            &lifetime_ms_));
+  }
+
+ protected:
+  static constexpr int kGenerationTimeoutMs = 10000;
+
+  // Requests a certificate from a generator of the cache and waits for it.
+  scoped_refptr<RTCCertificate> Generate(
+      const KeyParams& key_params,
+      const absl::optional<uint64_t>& expires_ms = absl::nullopt) {
+    auto fixture = make_ref_counted<RTCCertificateGeneratorFixture>();
+    cache_->CreateGenerator()->GenerateCertificateAsync(key_params, expires_ms,
+                                                        fixture);
+    EXPECT_TRUE_WAIT(fixture->GenerateAsyncCompleted(), kGenerationTimeoutMs);
+    return scoped_refptr<RTCCertificate>(fixture->certificate());
+  }
+
+  AutoThread main_thread_;
+  std::unique_ptr<Thread> worker_thread_;
+  int generated_ = 0;
+  absl::optional<uint64_t> lifetime_ms_;
+  scoped_refptr<RTCCertificateCache> cache_;
+};
+
+TEST_F(RTCCertificateCacheTest, SharesCertificatePerKeyParams) {
+  scoped_refptr<RTCCertificate> ecdsa = Generate(KeyParams::ECDSA());
+  ASSERT_TRUE(ecdsa);
+  EXPECT_EQ(ecdsa, Generate(KeyParams::ECDSA()));
+  EXPECT_EQ(1, generated_);
+
+  scoped_refptr<RTCCertificate> rsa = Generate(KeyParams::RSA());
+  ASSERT_TRUE(rsa);
+  EXPECT_NE(ecdsa, rsa);
+  EXPECT_EQ(rsa, Generate(KeyParams::RSA()));
+  EXPECT_NE(rsa, Generate(KeyParams::RSA(2048)));
+  EXPECT_EQ(3, generated_);
+}
+
+TEST_F(RTCCertificateCacheTest, GeneratesOnceForConcurrentRequests) {
+  auto first = make_ref_counted<RTCCertificateGeneratorFixture>();
+  auto second = make_ref_counted<RTCCertificateGeneratorFixture>();
+  cache_->GenerateCertificateAsync(KeyParams::ECDSA(), absl::nullopt, first);
+  cache_->GenerateCertificateAsync(KeyParams::ECDSA(), absl::nullopt, second);
+  EXPECT_TRUE_WAIT(first->GenerateAsyncCompleted(), kGenerationTimeoutMs);
+  EXPECT_TRUE_WAIT(second->GenerateAsyncCompleted(), kGenerationTimeoutMs);
+  ASSERT_TRUE(first->certificate());
+  EXPECT_EQ(first->certificate(), second->certificate());
+  EXPECT_EQ(1, generated_);
+}
+
+TEST_F(RTCCertificateCacheTest, DoesNotCacheCertificatesWithExpiration) {
+  scoped_refptr<RTCCertificate> certificate =
+      Generate(KeyParams::ECDSA(), 60000);
+  ASSERT_TRUE(certificate);
+  EXPECT_NE(certificate, Generate(KeyParams::ECDSA(), 60000));
+  EXPECT_EQ(2, generated_);
+}
+
+TEST_F(RTCCertificateCacheTest, ReplacesCertificateCloseToExpiry) {
+  lifetime_ms_ = RTCCertificateCache::kMinRemainingLifetimeMs / 2;
+  scoped_refptr<RTCCertificate> certificate = Generate(KeyParams::ECDSA());
+  ASSERT_TRUE(certificate);
+  scoped_refptr<RTCCertificate> replacement = Generate(KeyParams::ECDSA());
+  ASSERT_TRUE(replacement);
+  EXPECT_NE(certificate, replacement);
+  EXPECT_EQ(2, generated_);
+}
+
+TEST_F(RTCCertificateCacheTest, FailsWithInvalidParams) {
+  EXPECT_FALSE(Generate(KeyParams::RSA(0, 0)));
+  EXPECT_FALSE(Generate(KeyParams::RSA(0, 0)));
+}
+
 }  // namespace rtc
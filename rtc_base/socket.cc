@@ -10,4 +10,29 @@
 
 #include "rtc_base/socket.h"
 
-namespace rtc {}  // namespace rtc
+namespace rtc {
+
+int Socket::RecvFromBatch(ArrayView<ReceiveBuffer> buffers) {
+  if (buffers.empty())
+    return 0;
+  ReceiveBuffer& buffer = buffers[0];
+  int received = RecvFrom(buffer.data, buffer.capacity, &buffer.source,
+                          &buffer.timestamp);
+  if (received < 0)
+    return received;
+  buffer.length = static_cast<size_t>(received);
+  return 1;
+}
+
+int Socket::SendToBatch(ArrayView<const SendBuffer> buffers,
+                        const SocketAddress& addr) {
+  int sent = 0;
+  for (const SendBuffer& buffer : buffers) {
+    if (SendTo(buffer.data, buffer.length, addr) < 0)
+      return sent > 0 ? sent : SOCKET_ERROR;
+    ++sent;
+  }
+  return sent;
+}
+
+}  // namespace rtc
@@ -25,7 +25,9 @@
 #include "rtc_base/win32.h"
 #endif
 
+#include "api/array_view.h"
 #include "rtc_base/constructor_magic.h"
+#include "rtc_base/network/ecn_marking.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 
@@ -95,12 +97,41 @@ class Socket {
   virtual int Connect(const SocketAddress& addr) = 0;
   virtual int Send(const void* pv, size_t cb) = 0;
   virtual int SendTo(const void* pv, size_t cb, const SocketAddress& addr) = 0;
+  // One datagram for SendToBatch.
+  struct SendBuffer {
+    const char* data = nullptr;
+    size_t length = 0;
+  };
+  // Sends each of `buffers` as a separate datagram to `addr`. Returns the
+  // number of datagrams handed to the OS, which may be less than
+  // `buffers.size()`, or a negative value if the first one failed. The
+  // default implementation calls SendTo once per datagram.
+  virtual int SendToBatch(ArrayView<const SendBuffer> buffers,
+                          const SocketAddress& addr);
   // `timestamp` is in units of microseconds.
   virtual int Recv(void* pv, size_t cb, int64_t* timestamp) = 0;
   virtual int RecvFrom(void* pv,
                        size_t cb,
                        SocketAddress* paddr,
                        int64_t* timestamp) = 0;
+  // One datagram slot for RecvFromBatch. `data` and `capacity` are provided
+  // by the caller; `length`, `source` and `timestamp` are filled in for each
+  // datagram that was read. `timestamp` is in microseconds, or -1 if the
+  // socket could not provide one.
+  struct ReceiveBuffer {
+    char* data = nullptr;
+    size_t capacity = 0;
+    size_t length = 0;
+    SocketAddress source;
+    int64_t timestamp = -1;
+    // Only read if OPT_RECV_ECN is set, and by RecvFromBatch() of
+    // PhysicalSocket with more than one buffer.
+    EcnMarking ecn = EcnMarking::kNotEct;
+  };
+  // Reads up to `buffers.size()` datagrams that are already queued on the
+  // socket. Returns the number of datagrams read, or a negative value on
+  // error. The default implementation reads a single datagram with RecvFrom.
+  virtual int RecvFromBatch(ArrayView<ReceiveBuffer> buffers);
   virtual int Listen(int backlog) = 0;
   virtual Socket* Accept(SocketAddress* paddr) = 0;
   virtual int Close() = 0;
@@ -121,6 +152,15 @@ class Socket {
     OPT_RTP_SENDTIME_EXTN_ID,  // This is a non-traditional socket option param.
                                // This is specific to libjingle and will be used
                                // if SendTime option is needed at socket level.
+    OPT_RECV_BATCH_SIZE,       // Max number of datagrams read per read event.
+                               // Not an OS socket option; handled by
+                               // AsyncUDPSocket.
+    OPT_REUSEPORT,             // Allow several sockets to bind the same port
+                               // (SO_REUSEPORT); must be set before Bind().
+    OPT_SEND_ECN,              // EcnMarking of sent packets, kept apart from
+                               // the DSCP code in the same IP header byte.
+    OPT_RECV_ECN,              // Whether the EcnMarking of received packets
+                               // is read, see ReceiveBuffer.
   };
   virtual int GetOption(Option opt, int* value) = 0;
   virtual int SetOption(Option opt, int value) = 0;
@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "absl/memory/memory.h"
+#include "api/task_queue/task_queue_base.h"
 #include "rtc_base/ssl_certificate.h"
 #include "rtc_base/ssl_identity.h"
 #include "rtc_base/stream.h"
@@ -149,6 +150,13 @@ class SSLStreamAdapter : public StreamInterface, public sigslot::has_slots<> {
   // This should only be called before StartSSL().
   virtual void SetInitialRetransmissionTimeout(int timeout_ms) = 0;
 
+  // Runs the steps of a DTLS handshake, where the key exchange and signatures
+  // are computed, on `queue` instead of on the thread of the stream. `queue`
+  // must outlive this stream. Reads and writes of the wrapped stream stay on
+  // its thread. Has no effect in TLS mode.
+  // This should only be called before StartSSL().
+  virtual void SetHandshakeQueue(webrtc::TaskQueueBase* queue) {}
+
   // StartSSL starts negotiation with a peer, whose certificate is verified
   // using the certificate digest. Generally, SetIdentity() and possibly
   // SetServerRole() should have been called before this.
@@ -17,6 +17,7 @@
 #include "rtc_base/buffer_queue.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/gunit.h"
+#include "rtc_base/event.h"
 #include "rtc_base/helpers.h"
 #include "rtc_base/memory/fifo_buffer.h"
 #include "rtc_base/memory_stream.h"
@@ -28,6 +29,7 @@
 #include "rtc_base/stream.h"
 #include "rtc_base/task_utils/pending_task_safety_flag.h"
 #include "rtc_base/task_utils/to_queued_task.h"
+#include "rtc_base/thread.h"
 #include "test/field_trial.h"
 
 using ::testing::Combine;
@@ -1736,3 +1738,153 @@ TEST_F(SSLStreamAdapterTestDTLSLegacyProtocols,
   SetupProtocolVersions(rtc::SSL_PROTOCOL_DTLS_10, rtc::SSL_PROTOCOL_DTLS_10);
   TestHandshake(false);
 }
+
+class SSLStreamAdapterTestDTLSSessionResumption
+    : public SSLStreamAdapterTestDTLSBase {
+ public:
+  SSLStreamAdapterTestDTLSSessionResumption()
+      : SSLStreamAdapterTestDTLSBase(rtc::KeyParams::ECDSA(rtc::EC_NIST_P256),
+                                     rtc::KeyParams::ECDSA(rtc::EC_NIST_P256)),
+        client_identity_(rtc::SSLIdentity::Create("client", client_key_type_)),
+        server_identity_(
+            rtc::SSLIdentity::Create("server", server_key_type_)) {}
+
+  // Connections are made by Connect().
+  void SetUp() override {}
+
+  // Replaces the adapters with new ones that use the same identities, and
+  // runs their handshake. The field trial is read when the adapters are
+  // created.
+  void Connect() {
+    client_ssl_.reset();
+    server_ssl_.reset();
+    webrtc::test::ScopedFieldTrials trial(
+        "WebRTC-DtlsSessionResumption/Enabled/");
+    CreateStreams();
+    client_ssl_ =
+        rtc::SSLStreamAdapter::Create(absl::WrapUnique(client_stream_));
+    server_ssl_ =
+        rtc::SSLStreamAdapter::Create(absl::WrapUnique(server_stream_));
+    client_ssl_->SignalEvent.connect(
+        static_cast<SSLStreamAdapterTestBase*>(this),
+        &SSLStreamAdapterTestBase::OnEvent);
+    server_ssl_->SignalEvent.connect(
+        static_cast<SSLStreamAdapterTestBase*>(this),
+        &SSLStreamAdapterTestBase::OnEvent);
+    client_ssl_->SetIdentity(client_identity_->Clone());
+    server_ssl_->SetIdentity(server_identity_->Clone());
+    identities_set_ = false;
+    TestHandshake();
+  }
+
+  bool IsSessionResumed(bool client) const {
+    return static_cast<rtc::OpenSSLStreamAdapter*>(
+               client ? client_ssl_.get() : server_ssl_.get())
+        ->IsSessionResumed();
+  }
+
+ protected:
+  const std::unique_ptr<rtc::SSLIdentity> client_identity_;
+  std::unique_ptr<rtc::SSLIdentity> server_identity_;
+};
+
+TEST_F(SSLStreamAdapterTestDTLSSessionResumption, ResumesSessionWithPeer) {
+  Connect();
+  EXPECT_FALSE(IsSessionResumed(true));
+  EXPECT_FALSE(IsSessionResumed(false));
+
+  Connect();
+  EXPECT_TRUE(IsSessionResumed(true));
+  EXPECT_TRUE(IsSessionResumed(false));
+  std::unique_ptr<rtc::SSLCertChain> peer_chain =
+      client_ssl_->GetPeerSSLCertChain();
+  ASSERT_TRUE(peer_chain);
+  EXPECT_EQ(server_identity_->certificate().ToPEMString(),
+            peer_chain->Get(0).ToPEMString());
+}
+
+TEST_F(SSLStreamAdapterTestDTLSSessionResumption,
+       DoesNotResumeSessionWithOtherPeer) {
+  Connect();
+  server_identity_ = rtc::SSLIdentity::Create("server", server_key_type_);
+  Connect();
+  EXPECT_FALSE(IsSessionResumed(true));
+  EXPECT_FALSE(IsSessionResumed(false));
+}
+
+// Runs the handshakes of both adapters on another thread.
+class SSLStreamAdapterTestDTLSHandshakeQueue
+    : public SSLStreamAdapterTestDTLSBase {
+ public:
+  SSLStreamAdapterTestDTLSHandshakeQueue()
+      : SSLStreamAdapterTestDTLSBase(rtc::KeyParams::ECDSA(rtc::EC_NIST_P256),
+                                     rtc::KeyParams::ECDSA(rtc::EC_NIST_P256)),
+        handshake_thread_(rtc::Thread::Create()) {
+    handshake_thread_->Start();
+  }
+
+  void SetUp() override {
+    SSLStreamAdapterTestDTLSBase::SetUp();
+    client_ssl_->SetHandshakeQueue(handshake_thread_.get());
+    server_ssl_->SetHandshakeQueue(handshake_thread_.get());
+  }
+
+ protected:
+  const std::unique_ptr<rtc::Thread> handshake_thread_;
+};
+
+TEST_F(SSLStreamAdapterTestDTLSHandshakeQueue, TestDTLSConnect) {
+  TestHandshake();
+  TestTransfer(100);
+}
+
+TEST_F(SSLStreamAdapterTestDTLSHandshakeQueue,
+       TestDTLSConnectWithLostFirstPacket) {
+  SetLoseFirstPacket(true);
+  TestHandshake();
+}
+
+TEST_F(SSLStreamAdapterTestDTLSHandshakeQueue, TestDTLSDelayedIdentity) {
+  TestHandshakeWithDelayedIdentity(true);
+}
+
+TEST_F(SSLStreamAdapterTestDTLSHandshakeQueue,
+       TestDTLSDelayedIdentityWithBogusDigest) {
+  TestHandshakeWithDelayedIdentity(false);
+}
+
+// The network thread is not blocked while the handshake thread is busy.
+TEST_F(SSLStreamAdapterTestDTLSHandshakeQueue, DoesNotBlockOnHandshakeThread) {
+  rtc::Event release;
+  handshake_thread_->PostTask(webrtc::ToQueuedTask(
+      [&release] { release.Wait(rtc::Event::kForever); }));
+
+  client_ssl_->SetMode(rtc::SSL_MODE_DTLS);
+  server_ssl_->SetMode(rtc::SSL_MODE_DTLS);
+  SetPeerIdentitiesByDigest(true, true);
+  server_ssl_->SetServerRole();
+  ASSERT_EQ(0, server_ssl_->StartSSL());
+  ASSERT_EQ(0, client_ssl_->StartSSL());
+  WAIT(false, 100);
+  EXPECT_EQ(rtc::SS_OPENING, client_ssl_->GetState());
+  EXPECT_EQ(rtc::SS_OPENING, server_ssl_->GetState());
+
+  release.Set();
+  EXPECT_TRUE_WAIT((client_ssl_->GetState() == rtc::SS_OPEN) &&
+                       (server_ssl_->GetState() == rtc::SS_OPEN),
+                   handshake_wait_);
+}
+
+// A step that is queued behind other work is cancelled when the adapter goes
+// away.
+TEST_F(SSLStreamAdapterTestDTLSHandshakeQueue, ClosesWithQueuedStep) {
+  rtc::Event release;
+  handshake_thread_->PostTask(webrtc::ToQueuedTask(
+      [&release] { release.Wait(rtc::Event::kForever); }));
+
+  client_ssl_->SetMode(rtc::SSL_MODE_DTLS);
+  ASSERT_EQ(0, client_ssl_->StartSSL());
+  client_ssl_.reset();
+  release.Set();
+  handshake_thread_->Stop();
+}
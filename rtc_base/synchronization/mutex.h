@@ -28,6 +28,10 @@
 #error Unsupported platform.
 #endif
 
+#if defined(WEBRTC_MUTEX_CONTENTION_PROFILING)
+#include "rtc_base/synchronization/mutex_contention_profiler.h"
+#endif
+
 namespace webrtc {
 
 // The Mutex guarantees exclusive access and aims to follow Abseil semantics
@@ -38,22 +42,52 @@ class RTC_LOCKABLE Mutex final {
   Mutex(const Mutex&) = delete;
   Mutex& operator=(const Mutex&) = delete;
 
+#if defined(WEBRTC_MUTEX_CONTENTION_PROFILING)
+  // The caller's location identifies the lock site in the contention stats,
+  // see mutex_contention_profiler.h.
+  void Lock(const char* file = __builtin_FILE(), int line = __builtin_LINE())
+      RTC_EXCLUSIVE_LOCK_FUNCTION() {
+    if (impl_.TryLock()) {
+      profile_.OnAcquired(file, line, /*wait_start_ns=*/-1);
+      return;
+    }
+    const int64_t wait_start_ns = mutex_profiling_impl::Now();
+    impl_.Lock();
+    profile_.OnAcquired(file, line, wait_start_ns);
+  }
+  ABSL_MUST_USE_RESULT bool TryLock(const char* file = __builtin_FILE(),
+                                    int line = __builtin_LINE())
+      RTC_EXCLUSIVE_TRYLOCK_FUNCTION(true) {
+    if (!impl_.TryLock()) {
+      return false;
+    }
+    profile_.OnAcquired(file, line, /*wait_start_ns=*/-1);
+    return true;
+  }
+#else
   void Lock() RTC_EXCLUSIVE_LOCK_FUNCTION() {
     impl_.Lock();
   }
   ABSL_MUST_USE_RESULT bool TryLock() RTC_EXCLUSIVE_TRYLOCK_FUNCTION(true) {
     return impl_.TryLock();
   }
+#endif
   // Return immediately if this thread holds the mutex, or RTC_DCHECK_IS_ON==0.
   // Otherwise, may report an error (typically by crashing with a diagnostic),
   // or may return immediately.
   void AssertHeld() const RTC_ASSERT_EXCLUSIVE_LOCK() { impl_.AssertHeld(); }
   void Unlock() RTC_UNLOCK_FUNCTION() {
+#if defined(WEBRTC_MUTEX_CONTENTION_PROFILING)
+    profile_.OnReleased();
+#endif
     impl_.Unlock();
   }
 
  private:
   MutexImpl impl_;
+#if defined(WEBRTC_MUTEX_CONTENTION_PROFILING)
+  mutex_profiling_impl::MutexContentionProfile profile_;
+#endif
 };
 
 // MutexLock, for serializing execution through a scope.
@@ -62,10 +96,20 @@ class RTC_SCOPED_LOCKABLE MutexLock final {
   MutexLock(const MutexLock&) = delete;
   MutexLock& operator=(const MutexLock&) = delete;
 
+#if defined(WEBRTC_MUTEX_CONTENTION_PROFILING)
+  explicit MutexLock(Mutex* mutex,
+                     const char* file = __builtin_FILE(),
+                     int line = __builtin_LINE())
+      RTC_EXCLUSIVE_LOCK_FUNCTION(mutex)
+      : mutex_(mutex) {
+    mutex->Lock(file, line);
+  }
+#else
   explicit MutexLock(Mutex* mutex) RTC_EXCLUSIVE_LOCK_FUNCTION(mutex)
       : mutex_(mutex) {
     mutex->Lock();
   }
+#endif
   ~MutexLock() RTC_UNLOCK_FUNCTION() { mutex_->Unlock(); }
 
  private:
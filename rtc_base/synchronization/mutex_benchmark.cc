@@ -8,8 +8,13 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <string.h>
+
+#include <vector>
+
 #include "benchmark/benchmark.h"
 #include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/synchronization/mutex_contention_profiler.h"
 #include "rtc_base/system/unused.h"
 
 namespace webrtc {
@@ -47,6 +52,58 @@ BENCHMARK(BM_LockWithMutex)->Threads(2);
 BENCHMARK(BM_LockWithMutex)->Threads(4);
 BENCHMARK(BM_LockWithMutex)->ThreadPerCpu();
 
+// Locks like a Mutex built with rtc_mutex_contention_profiling, to measure the
+// overhead of the profiling in any build.
+class ProfiledPerfTestData {
+ public:
+  static constexpr int kLine = __LINE__;
+
+  int AddToCounter(int add) {
+    int64_t wait_start_ns = -1;
+    if (!mu_.TryLock()) {
+      wait_start_ns = mutex_profiling_impl::Now();
+      mu_.Lock();
+    }
+    profile_.OnAcquired(__FILE__, kLine, wait_start_ns);
+    my_counter_ += add;
+    profile_.OnReleased();
+    mu_.Unlock();
+    return 0;
+  }
+
+ private:
+  uint8_t cache_line_barrier_1_[64] = {};
+  Mutex mu_;
+  mutex_profiling_impl::MutexContentionProfile profile_ RTC_GUARDED_BY(mu_);
+  uint8_t cache_line_barrier_2_[64] = {};
+  int64_t my_counter_ RTC_GUARDED_BY(mu_) = 0;
+};
+
+void BM_LockWithProfiledMutex(benchmark::State& state) {
+  static ProfiledPerfTestData test_data;
+  if (state.thread_index() == 0) {
+    ResetMutexContentionStats();
+  }
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    benchmark::DoNotOptimize(test_data.AddToCounter(2));
+  }
+  if (state.thread_index() == 0) {
+    for (const MutexContentionStats& site : GetMutexContentionStats()) {
+      if (site.line == ProfiledPerfTestData::kLine &&
+          strcmp(site.file, __FILE__) == 0 && site.acquisitions > 0) {
+        state.counters["contention_%"] =
+            100.0 * site.contentions / site.acquisitions;
+      }
+    }
+  }
+}
+
+BENCHMARK(BM_LockWithProfiledMutex)->Threads(1);
+BENCHMARK(BM_LockWithProfiledMutex)->Threads(2);
+BENCHMARK(BM_LockWithProfiledMutex)->Threads(4);
+BENCHMARK(BM_LockWithProfiledMutex)->ThreadPerCpu();
+
 }  // namespace webrtc
 
 /*
@@ -0,0 +1,202 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/synchronization/mutex_contention_profiler.h"
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <atomic>
+
+#include "rtc_base/system_time.h"
+
+namespace webrtc {
+namespace mutex_profiling_impl {
+
+// A lock site, with counters updated by all threads locking there.
+struct Site {
+  // Hash of the file and the line, or 0 if the site is unused.
+  std::atomic<uint64_t> key{0};
+  std::atomic<const char*> file{nullptr};
+  std::atomic<int> line{0};
+  std::atomic<int64_t> acquisitions{0};
+  std::atomic<int64_t> contentions{0};
+  std::atomic<int64_t> total_wait_ns{0};
+  std::atomic<int64_t> max_wait_ns{0};
+  std::atomic<int64_t> total_hold_ns{0};
+  std::atomic<int64_t> max_hold_ns{0};
+};
+
+}  // namespace mutex_profiling_impl
+
+namespace {
+
+using mutex_profiling_impl::Site;
+
+// A fixed open addressing hash table, so that sites are found without
+// locking. Sites that don't fit are counted in the overflow site.
+constexpr size_t kMaxSites = 4096;
+
+Site* GetSites() {
+  static Site* const sites = new Site[kMaxSites + 1];
+  return sites;
+}
+
+Site& OverflowSite() {
+  return GetSites()[kMaxSites];
+}
+
+uint64_t SiteKey(const char* file, int line) {
+  uint64_t key = reinterpret_cast<uintptr_t>(file) * 0x9E3779B97F4A7C15ull;
+  key ^= static_cast<uint64_t>(line) + (key >> 29);
+  key *= 0xBF58476D1CE4E5B9ull;
+  return key == 0 ? 1 : key;
+}
+
+Site* FindOrAddSite(const char* file, int line) {
+  const uint64_t key = SiteKey(file, line);
+  Site* const sites = GetSites();
+  for (size_t i = 0; i < kMaxSites; ++i) {
+    Site& site = sites[(key + i) % kMaxSites];
+    uint64_t site_key = site.key.load(std::memory_order_acquire);
+    if (site_key == key) {
+      return &site;
+    }
+    if (site_key == 0) {
+      if (site.key.compare_exchange_strong(site_key, key,
+                                           std::memory_order_acq_rel)) {
+        site.file.store(file, std::memory_order_relaxed);
+        site.line.store(line, std::memory_order_relaxed);
+        return &site;
+      }
+      if (site_key == key) {
+        return &site;
+      }
+    }
+  }
+  return &OverflowSite();
+}
+
+void UpdateMax(std::atomic<int64_t>& max, int64_t value) {
+  int64_t current = max.load(std::memory_order_relaxed);
+  while (value > current &&
+         !max.compare_exchange_weak(current, value,
+                                    std::memory_order_relaxed)) {
+  }
+}
+
+MutexContentionStats Snapshot(const Site& site) {
+  MutexContentionStats stats;
+  stats.file = site.file.load(std::memory_order_relaxed);
+  stats.line = site.line.load(std::memory_order_relaxed);
+  stats.acquisitions = site.acquisitions.load(std::memory_order_relaxed);
+  stats.contentions = site.contentions.load(std::memory_order_relaxed);
+  stats.total_wait_ns = site.total_wait_ns.load(std::memory_order_relaxed);
+  stats.max_wait_ns = site.max_wait_ns.load(std::memory_order_relaxed);
+  stats.total_hold_ns = site.total_hold_ns.load(std::memory_order_relaxed);
+  stats.max_hold_ns = site.max_hold_ns.load(std::memory_order_relaxed);
+  return stats;
+}
+
+}  // namespace
+
+namespace mutex_profiling_impl {
+
+int64_t Now() {
+  return rtc::SystemTimeNanos();
+}
+
+void MutexContentionProfile::OnAcquired(const char* file,
+                                        int line,
+                                        int64_t wait_start_ns) {
+  site_ = FindOrAddSite(file, line);
+  acquired_ns_ = Now();
+  site_->acquisitions.fetch_add(1, std::memory_order_relaxed);
+  if (wait_start_ns >= 0) {
+    const int64_t wait_ns = acquired_ns_ - wait_start_ns;
+    site_->contentions.fetch_add(1, std::memory_order_relaxed);
+    site_->total_wait_ns.fetch_add(wait_ns, std::memory_order_relaxed);
+    UpdateMax(site_->max_wait_ns, wait_ns);
+  }
+}
+
+void MutexContentionProfile::OnReleased() {
+  const int64_t hold_ns = Now() - acquired_ns_;
+  site_->total_hold_ns.fetch_add(hold_ns, std::memory_order_relaxed);
+  UpdateMax(site_->max_hold_ns, hold_ns);
+}
+
+}  // namespace mutex_profiling_impl
+
+std::vector<MutexContentionStats> GetMutexContentionStats() {
+  std::vector<MutexContentionStats> result;
+  const Site* const sites = GetSites();
+  for (size_t i = 0; i <= kMaxSites; ++i) {
+    MutexContentionStats stats = Snapshot(sites[i]);
+    if (stats.acquisitions == 0) {
+      continue;
+    }
+    if (i == kMaxSites) {
+      stats.file = "(other sites)";
+    }
+    result.push_back(stats);
+  }
+  std::sort(result.begin(), result.end(),
+            [](const MutexContentionStats& a, const MutexContentionStats& b) {
+              return a.total_wait_ns > b.total_wait_ns;
+            });
+  return result;
+}
+
+void ResetMutexContentionStats() {
+  Site* const sites = GetSites();
+  for (size_t i = 0; i <= kMaxSites; ++i) {
+    Site& site = sites[i];
+    site.acquisitions.store(0, std::memory_order_relaxed);
+    site.contentions.store(0, std::memory_order_relaxed);
+    site.total_wait_ns.store(0, std::memory_order_relaxed);
+    site.max_wait_ns.store(0, std::memory_order_relaxed);
+    site.total_hold_ns.store(0, std::memory_order_relaxed);
+    site.max_hold_ns.store(0, std::memory_order_relaxed);
+  }
+}
+
+std::string MutexContentionReport(
+    const std::vector<MutexContentionStats>& stats,
+    size_t max_sites) {
+  std::string report;
+  char line[512];
+  snprintf(line, sizeof(line), "%12s %12s %6s %12s %12s %12s %12s  %s\n",
+           "acquisitions", "contentions", "%", "wait_us", "max_wait_us",
+           "hold_us", "max_hold_us", "site");
+  report += line;
+  for (size_t i = 0; i < stats.size() && i < max_sites; ++i) {
+    const MutexContentionStats& s = stats[i];
+    const char* file = s.file ? s.file : "(unknown)";
+    // Strip the directories, like log messages do.
+    for (const char* c = file; *c; ++c) {
+      if (*c == '/' || *c == '\\')
+        file = c + 1;
+    }
+    snprintf(line, sizeof(line),
+             "%12lld %12lld %6.2f %12lld %12lld %12lld %12lld  %s:%d\n",
+             static_cast<long long>(s.acquisitions),
+             static_cast<long long>(s.contentions),
+             s.acquisitions > 0 ? 100.0 * s.contentions / s.acquisitions : 0.0,
+             static_cast<long long>(s.total_wait_ns / 1000),
+             static_cast<long long>(s.max_wait_ns / 1000),
+             static_cast<long long>(s.total_hold_ns / 1000),
+             static_cast<long long>(s.max_hold_ns / 1000), file, s.line);
+    report += line;
+  }
+  return report;
+}
+
+}  // namespace webrtc
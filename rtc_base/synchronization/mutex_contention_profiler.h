@@ -0,0 +1,74 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_SYNCHRONIZATION_MUTEX_CONTENTION_PROFILER_H_
+#define RTC_BASE_SYNCHRONIZATION_MUTEX_CONTENTION_PROFILER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+// Contention profiling of webrtc::Mutex, enabled by building with the GN arg
+// rtc_mutex_contention_profiling = true, which defines
+// WEBRTC_MUTEX_CONTENTION_PROFILING. In that mode every Mutex records, per
+// site that locks it (the MutexLock or the Mutex::Lock() call), how often it
+// was acquired, how often it had to wait for another thread, for how long, and
+// for how long it was then held. The profiling costs two clock reads and a few
+// atomic additions per lock, so it is not meant for release builds.
+
+namespace webrtc {
+
+struct MutexContentionStats {
+  const char* file = nullptr;
+  int line = 0;
+  int64_t acquisitions = 0;
+  // Acquisitions that had to wait for the mutex to be released.
+  int64_t contentions = 0;
+  int64_t total_wait_ns = 0;
+  int64_t max_wait_ns = 0;
+  int64_t total_hold_ns = 0;
+  int64_t max_hold_ns = 0;
+};
+
+// Returns the stats of all lock sites that have been used, the sites with the
+// longest total wait first.
+std::vector<MutexContentionStats> GetMutexContentionStats();
+// Clears the stats of all lock sites.
+void ResetMutexContentionStats();
+// Formats the `max_sites` sites with the longest total wait as a table.
+std::string MutexContentionReport(
+    const std::vector<MutexContentionStats>& stats,
+    size_t max_sites);
+
+namespace mutex_profiling_impl {
+
+struct Site;
+
+// Timestamp in nanoseconds for measuring waits.
+int64_t Now();
+
+// The profiling state of a Mutex. Calls are made with the mutex held.
+class MutexContentionProfile {
+ public:
+  // `wait_start_ns` is when the lock started to wait, or -1 if it didn't.
+  void OnAcquired(const char* file, int line, int64_t wait_start_ns);
+  void OnReleased();
+
+ private:
+  Site* site_ = nullptr;
+  int64_t acquired_ns_ = 0;
+};
+
+}  // namespace mutex_profiling_impl
+}  // namespace webrtc
+
+#endif  // RTC_BASE_SYNCHRONIZATION_MUTEX_CONTENTION_PROFILER_H_
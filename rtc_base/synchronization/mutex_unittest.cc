@@ -12,9 +12,11 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #include <atomic>
 #include <memory>
+#include <string>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -25,6 +27,7 @@
 #include "rtc_base/location.h"
 #include "rtc_base/message_handler.h"
 #include "rtc_base/platform_thread.h"
+#include "rtc_base/synchronization/mutex_contention_profiler.h"
 #include "rtc_base/synchronization/yield.h"
 #include "rtc_base/thread.h"
 #include "test/gtest.h"
@@ -202,5 +205,72 @@ TEST(MutexTest, GlobalMutexCanHaveStaticStorageDuration) {
   global_lock.Unlock();
 }
 
+const MutexContentionStats* FindSite(
+    const std::vector<MutexContentionStats>& stats,
+    const char* file,
+    int line) {
+  for (const MutexContentionStats& site : stats) {
+    if (site.file && strcmp(site.file, file) == 0 && site.line == line)
+      return &site;
+  }
+  return nullptr;
+}
+
+TEST(MutexContentionProfilerTest, RecordsAcquisitionsAndWaitsPerSite) {
+  static const char kFile[] = "profiled_file.cc";
+  mutex_profiling_impl::MutexContentionProfile profile;
+  profile.OnAcquired(kFile, 10, /*wait_start_ns=*/-1);
+  profile.OnReleased();
+  profile.OnAcquired(kFile, 10, mutex_profiling_impl::Now() - 5000);
+  profile.OnReleased();
+  profile.OnAcquired(kFile, 20, /*wait_start_ns=*/-1);
+  profile.OnReleased();
+
+  std::vector<MutexContentionStats> stats = GetMutexContentionStats();
+  const MutexContentionStats* site10 = FindSite(stats, kFile, 10);
+  ASSERT_TRUE(site10);
+  EXPECT_EQ(site10->acquisitions, 2);
+  EXPECT_EQ(site10->contentions, 1);
+  EXPECT_GE(site10->total_wait_ns, 5000);
+  EXPECT_EQ(site10->max_wait_ns, site10->total_wait_ns);
+  const MutexContentionStats* site20 = FindSite(stats, kFile, 20);
+  ASSERT_TRUE(site20);
+  EXPECT_EQ(site20->acquisitions, 1);
+  EXPECT_EQ(site20->contentions, 0);
+  EXPECT_EQ(site20->total_wait_ns, 0);
+
+  EXPECT_NE(MutexContentionReport(stats, stats.size())
+                .find("profiled_file.cc:10"),
+            std::string::npos);
+
+  ResetMutexContentionStats();
+  stats = GetMutexContentionStats();
+  EXPECT_FALSE(FindSite(stats, kFile, 10));
+}
+
+#if defined(WEBRTC_MUTEX_CONTENTION_PROFILING)
+TEST(MutexContentionProfilerTest, RecordsContentionOfMutexLock) {
+  Mutex mutex;
+  Event locked;
+  Event release;
+  rtc::PlatformThread thread = rtc::PlatformThread::SpawnJoinable(
+      [&] {
+        MutexLock lock(&mutex);
+        locked.Set();
+        release.Wait(Event::kForever);
+      },
+      "Holder");
+  locked.Wait(Event::kForever);
+  release.Set();
+  const int line = __LINE__ + 1;
+  { MutexLock lock(&mutex); }
+
+  std::vector<MutexContentionStats> stats = GetMutexContentionStats();
+  const MutexContentionStats* site = FindSite(stats, __FILE__, line);
+  ASSERT_TRUE(site);
+  EXPECT_EQ(site->acquisitions, 1);
+}
+#endif
+
 }  // namespace
 }  // namespace webrtc
@@ -18,7 +18,13 @@
 #include <time.h>
 #include <unistd.h>
 
+#if defined(WEBRTC_LINUX)
+#include <sys/timerfd.h>
+#endif
+
+#include <algorithm>
 #include <list>
+#include <map>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -27,6 +33,7 @@
 #include "absl/strings/string_view.h"
 #include "api/task_queue/queued_task.h"
 #include "api/task_queue/task_queue_base.h"
+#include "api/units/time_delta.h"
 #include "base/third_party/libevent/event.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
@@ -34,6 +41,7 @@
 #include "rtc_base/platform_thread.h"
 #include "rtc_base/platform_thread_types.h"
 #include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/task_queue_metrics.h"
 #include "rtc_base/thread_annotations.h"
 #include "rtc_base/time_utils.h"
 
@@ -109,16 +117,35 @@ class TaskQueueLibevent final : public TaskQueueBase {
   void PostTask(std::unique_ptr<QueuedTask> task) override;
   void PostDelayedTask(std::unique_ptr<QueuedTask> task,
                        uint32_t milliseconds) override;
+  void PostDelayedHighPrecisionTask(std::unique_ptr<QueuedTask> task,
+                                    TimeDelta delay) override;
 
  private:
   class SetTimerTask;
   struct TimerEvent;
 
+  struct PendingTask {
+    std::unique_ptr<QueuedTask> task;
+    // When the task was posted or became due, for the queue wait metrics.
+    int64_t ready_time_us;
+  };
+
   ~TaskQueueLibevent() override = default;
 
+  // Runs a task that was posted or became due at `ready_time_us`.
+  void RunTask(std::unique_ptr<QueuedTask> task, int64_t ready_time_us);
+
   static void OnWakeup(int socket, short flags, void* context);  // NOLINT
   static void RunTimer(int fd, short flags, void* context);      // NOLINT
 
+#if defined(WEBRTC_LINUX)
+  class SetPreciseTimerTask;
+
+  void AddPreciseTimer(int64_t run_time_us, std::unique_ptr<QueuedTask> task);
+  void ArmPreciseTimer();
+  static void OnPreciseTimer(int fd, short flags, void* context);  // NOLINT
+#endif
+
   bool is_active_ = true;
   int wakeup_pipe_in_ = -1;
   int wakeup_pipe_out_ = -1;
@@ -126,20 +153,35 @@ class TaskQueueLibevent final : public TaskQueueBase {
   event wakeup_event_;
   rtc::PlatformThread thread_;
   Mutex pending_lock_;
-  absl::InlinedVector<std::unique_ptr<QueuedTask>, 4> pending_
-      RTC_GUARDED_BY(pending_lock_);
+  absl::InlinedVector<PendingTask, 4> pending_ RTC_GUARDED_BY(pending_lock_);
   // Holds a list of events pending timers for cleanup when the loop exits.
   std::list<TimerEvent*> pending_timers_;
+  TaskQueueMetrics metrics_;
+#if defined(WEBRTC_LINUX)
+  // libevent waits with millisecond resolution, rounded up, so high precision
+  // tasks are run from a timerfd instead, which is armed for the earliest of
+  // them. Created when the first high precision task is posted.
+  int precise_timer_fd_ = -1;
+  event precise_timer_event_;
+  // High precision tasks by the time to run them, in microseconds. Tasks with
+  // the same time run in the order they were posted.
+  std::multimap<int64_t, std::unique_ptr<QueuedTask>> precise_timers_;
+#endif
 };
 
 struct TaskQueueLibevent::TimerEvent {
-  TimerEvent(TaskQueueLibevent* task_queue, std::unique_ptr<QueuedTask> task)
-      : task_queue(task_queue), task(std::move(task)) {}
+  TimerEvent(TaskQueueLibevent* task_queue,
+             std::unique_ptr<QueuedTask> task,
+             int64_t run_time_us)
+      : task_queue(task_queue),
+        task(std::move(task)),
+        run_time_us(run_time_us) {}
   ~TimerEvent() { event_del(&ev); }
 
   event ev;
   TaskQueueLibevent* task_queue;
   std::unique_ptr<QueuedTask> task;
+  int64_t run_time_us;
 };
 
 class TaskQueueLibevent::SetTimerTask : public QueuedTask {
@@ -165,9 +207,27 @@ class TaskQueueLibevent::SetTimerTask : public QueuedTask {
   const uint32_t posted_;
 };
 
+#if defined(WEBRTC_LINUX)
+class TaskQueueLibevent::SetPreciseTimerTask : public QueuedTask {
+ public:
+  SetPreciseTimerTask(std::unique_ptr<QueuedTask> task, int64_t run_time_us)
+      : task_(std::move(task)), run_time_us_(run_time_us) {}
+
+ private:
+  bool Run() override {
+    static_cast<TaskQueueLibevent*>(TaskQueueLibevent::Current())
+        ->AddPreciseTimer(run_time_us_, std::move(task_));
+    return true;
+  }
+
+  std::unique_ptr<QueuedTask> task_;
+  const int64_t run_time_us_;
+};
+#endif
+
 TaskQueueLibevent::TaskQueueLibevent(absl::string_view queue_name,
                                      rtc::ThreadPriority priority)
-    : event_base_(event_base_new()) {
+    : event_base_(event_base_new()), metrics_(queue_name) {
   int fds[2];
   RTC_CHECK(pipe(fds) == 0);
   SetNonBlocking(fds[0]);
@@ -188,6 +248,9 @@ TaskQueueLibevent::TaskQueueLibevent(absl::string_view queue_name,
 
         for (TimerEvent* timer : pending_timers_)
           delete timer;
+#if defined(WEBRTC_LINUX)
+        precise_timers_.clear();
+#endif
       },
       queue_name, rtc::ThreadAttributes().SetPriority(priority));
 }
@@ -207,6 +270,13 @@ void TaskQueueLibevent::Delete() {
   thread_.Finalize();
 
   event_del(&wakeup_event_);
+#if defined(WEBRTC_LINUX)
+  if (precise_timer_fd_ != -1) {
+    event_del(&precise_timer_event_);
+    close(precise_timer_fd_);
+    precise_timer_fd_ = -1;
+  }
+#endif
 
   IgnoreSigPipeSignalOnCurrentThread();
 
@@ -223,7 +293,7 @@ void TaskQueueLibevent::PostTask(std::unique_ptr<QueuedTask> task) {
   {
     MutexLock lock(&pending_lock_);
     bool had_pending_tasks = !pending_.empty();
-    pending_.push_back(std::move(task));
+    pending_.push_back({std::move(task), TaskQueueMetrics::Now()});
 
     // Only write to the pipe if there were no pending tasks before this one
     // since the thread could be sleeping. If there were already pending tasks
@@ -245,7 +315,9 @@ void TaskQueueLibevent::PostTask(std::unique_ptr<QueuedTask> task) {
 void TaskQueueLibevent::PostDelayedTask(std::unique_ptr<QueuedTask> task,
                                         uint32_t milliseconds) {
   if (IsCurrent()) {
-    TimerEvent* timer = new TimerEvent(this, std::move(task));
+    TimerEvent* timer =
+        new TimerEvent(this, std::move(task),
+                       TaskQueueMetrics::Now() + int64_t{milliseconds} * 1000);
     EventAssign(&timer->ev, event_base_, -1, 0, &TaskQueueLibevent::RunTimer,
                 timer);
     pending_timers_.push_back(timer);
@@ -257,6 +329,83 @@ void TaskQueueLibevent::PostDelayedTask(std::unique_ptr<QueuedTask> task,
   }
 }
 
+void TaskQueueLibevent::PostDelayedHighPrecisionTask(
+    std::unique_ptr<QueuedTask> task,
+    TimeDelta delay) {
+#if defined(WEBRTC_LINUX)
+  const int64_t run_time_us =
+      rtc::TimeMicros() + std::max<int64_t>(delay.us(), 0);
+  if (IsCurrent()) {
+    AddPreciseTimer(run_time_us, std::move(task));
+  } else {
+    PostTask(std::make_unique<SetPreciseTimerTask>(std::move(task),
+                                                   run_time_us));
+  }
+#else
+  TaskQueueBase::PostDelayedHighPrecisionTask(std::move(task), delay);
+#endif
+}
+
+#if defined(WEBRTC_LINUX)
+void TaskQueueLibevent::AddPreciseTimer(int64_t run_time_us,
+                                        std::unique_ptr<QueuedTask> task) {
+  RTC_DCHECK(IsCurrent());
+  if (precise_timer_fd_ == -1) {
+    precise_timer_fd_ =
+        timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    RTC_CHECK_NE(precise_timer_fd_, -1);
+    EventAssign(&precise_timer_event_, event_base_, precise_timer_fd_,
+                EV_READ | EV_PERSIST, &TaskQueueLibevent::OnPreciseTimer,
+                this);
+    event_add(&precise_timer_event_, 0);
+  }
+  const bool is_earliest = precise_timers_.empty() ||
+                           run_time_us < precise_timers_.begin()->first;
+  precise_timers_.emplace(run_time_us, std::move(task));
+  if (is_earliest)
+    ArmPreciseTimer();
+}
+
+void TaskQueueLibevent::ArmPreciseTimer() {
+  RTC_DCHECK(!precise_timers_.empty());
+  // A zero `it_value` would disarm the timer, so a task that is already due
+  // waits for a nanosecond.
+  const int64_t delay_ns = std::max<int64_t>(
+      (precise_timers_.begin()->first - rtc::TimeMicros()) * 1000, 1);
+  itimerspec spec = {};
+  spec.it_value.tv_sec = delay_ns / rtc::kNumNanosecsPerSec;
+  spec.it_value.tv_nsec = delay_ns % rtc::kNumNanosecsPerSec;
+  RTC_CHECK_EQ(0, timerfd_settime(precise_timer_fd_, 0, &spec, nullptr));
+}
+
+// static
+void TaskQueueLibevent::OnPreciseTimer(int fd,
+                                       short flags,  // NOLINT
+                                       void* context) {
+  TaskQueueLibevent* me = static_cast<TaskQueueLibevent*>(context);
+  uint64_t expirations;
+  if (read(fd, &expirations, sizeof(expirations)) != sizeof(expirations)) {
+    // Spurious wakeup, e.g. the timer was rearmed after it expired.
+    RTC_DCHECK_EQ(errno, EAGAIN);
+    return;
+  }
+
+  // Take the due tasks out first, so that tasks they post don't run in the
+  // same pass.
+  const int64_t now_us = rtc::TimeMicros();
+  absl::InlinedVector<PendingTask, 4> due;
+  auto it = me->precise_timers_.begin();
+  for (; it != me->precise_timers_.end() && it->first <= now_us; ++it)
+    due.push_back({std::move(it->second), it->first});
+  me->precise_timers_.erase(me->precise_timers_.begin(), it);
+  if (!me->precise_timers_.empty())
+    me->ArmPreciseTimer();
+
+  for (PendingTask& pending : due)
+    me->RunTask(std::move(pending.task), pending.ready_time_us);
+}
+#endif
+
 // static
 void TaskQueueLibevent::OnWakeup(int socket,
                                  short flags,  // NOLINT
@@ -271,20 +420,14 @@ void TaskQueueLibevent::OnWakeup(int socket,
       event_base_loopbreak(me->event_base_);
       break;
     case kRunTasks: {
-      absl::InlinedVector<std::unique_ptr<QueuedTask>, 4> tasks;
+      absl::InlinedVector<PendingTask, 4> tasks;
       {
         MutexLock lock(&me->pending_lock_);
         tasks.swap(me->pending_);
       }
       RTC_DCHECK(!tasks.empty());
-      for (auto& task : tasks) {
-        if (task->Run()) {
-          task.reset();
-        } else {
-          // `false` means the task should *not* be deleted.
-          task.release();
-        }
-      }
+      for (PendingTask& pending : tasks)
+        me->RunTask(std::move(pending.task), pending.ready_time_us);
       break;
     }
     default:
@@ -298,12 +441,23 @@ void TaskQueueLibevent::RunTimer(int fd,
                                  short flags,  // NOLINT
                                  void* context) {
   TimerEvent* timer = static_cast<TimerEvent*>(context);
-  if (!timer->task->Run())
-    timer->task.release();
+  timer->task_queue->RunTask(std::move(timer->task), timer->run_time_us);
   timer->task_queue->pending_timers_.remove(timer);
   delete timer;
 }
 
+void TaskQueueLibevent::RunTask(std::unique_ptr<QueuedTask> task,
+                                int64_t ready_time_us) {
+  const int64_t start_us = metrics_.OnTaskStart(ready_time_us);
+  if (task->Run()) {
+    task.reset();
+  } else {
+    // `false` means the task should *not* be deleted.
+    task.release();
+  }
+  metrics_.OnTaskEnd(start_us);
+}
+
 class TaskQueueLibeventFactory final : public TaskQueueFactory {
  public:
   std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateTaskQueue(
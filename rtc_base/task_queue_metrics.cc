@@ -0,0 +1,121 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_queue_metrics.h"
+
+#include <algorithm>
+
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+namespace {
+
+// Guards the registry and the names of the metrics in it.
+Mutex& GetRegistryLock() {
+  static Mutex& mutex = *new Mutex();
+  return mutex;
+}
+
+std::vector<TaskQueueMetrics*>& GetRegistry()
+    RTC_EXCLUSIVE_LOCKS_REQUIRED(GetRegistryLock()) {
+  static std::vector<TaskQueueMetrics*>& registry =
+      *new std::vector<TaskQueueMetrics*>();
+  return registry;
+}
+
+size_t QueueWaitBucket(int64_t wait_us) {
+  return std::upper_bound(std::begin(kQueueWaitBucketUpperBoundsUs),
+                          std::end(kQueueWaitBucketUpperBoundsUs), wait_us) -
+         std::begin(kQueueWaitBucketUpperBoundsUs);
+}
+
+}  // namespace
+
+TaskQueueMetrics::TaskQueueMetrics(absl::string_view name)
+    : name_(name) {
+  MutexLock lock(&GetRegistryLock());
+  GetRegistry().push_back(this);
+}
+
+TaskQueueMetrics::~TaskQueueMetrics() {
+  MutexLock lock(&GetRegistryLock());
+  std::vector<TaskQueueMetrics*>& registry = GetRegistry();
+  registry.erase(std::find(registry.begin(), registry.end(), this));
+}
+
+void TaskQueueMetrics::SetName(absl::string_view name) {
+  MutexLock lock(&GetRegistryLock());
+  name_ = std::string(name);
+}
+
+// static
+int64_t TaskQueueMetrics::Now() {
+  return rtc::TimeMicros();
+}
+
+int64_t TaskQueueMetrics::OnTaskStart(int64_t ready_time_us) {
+  const int64_t now_us = Now();
+  const int64_t wait_us = std::max<int64_t>(now_us - ready_time_us, 0);
+  queue_wait_histogram_[QueueWaitBucket(wait_us)].fetch_add(
+      1, std::memory_order_relaxed);
+  total_queue_wait_us_.fetch_add(wait_us, std::memory_order_relaxed);
+  // Only the queue's thread writes the counters, so they need no atomic
+  // read-modify-write.
+  if (wait_us > max_queue_wait_us_.load(std::memory_order_relaxed))
+    max_queue_wait_us_.store(wait_us, std::memory_order_relaxed);
+  return now_us;
+}
+
+void TaskQueueMetrics::OnTaskEnd(int64_t start_time_us) {
+  const int64_t now_us = Now();
+  tasks_run_.fetch_add(1, std::memory_order_relaxed);
+  busy_time_us_.fetch_add(now_us - start_time_us, std::memory_order_relaxed);
+  if (cpu_time_base_ns_ < 0) {
+    // The CPU time base of a thread is unspecified, so the time is counted
+    // from the end of the first task.
+    cpu_time_base_ns_ = rtc::GetThreadCpuTimeNanos();
+    last_cpu_sample_us_ = now_us;
+  } else if (now_us - last_cpu_sample_us_ >= kCpuTimeSampleIntervalUs) {
+    cpu_time_ns_.store(rtc::GetThreadCpuTimeNanos() - cpu_time_base_ns_,
+                       std::memory_order_relaxed);
+    last_cpu_sample_us_ = now_us;
+  }
+}
+
+TaskQueueMetricsSnapshot TaskQueueMetrics::Snapshot() const {
+  TaskQueueMetricsSnapshot snapshot;
+  snapshot.name = name_;
+  snapshot.tasks_run = tasks_run_.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < kNumQueueWaitBuckets; ++i) {
+    snapshot.queue_wait_histogram[i] =
+        queue_wait_histogram_[i].load(std::memory_order_relaxed);
+  }
+  snapshot.total_queue_wait_us =
+      total_queue_wait_us_.load(std::memory_order_relaxed);
+  snapshot.max_queue_wait_us =
+      max_queue_wait_us_.load(std::memory_order_relaxed);
+  snapshot.busy_time_us = busy_time_us_.load(std::memory_order_relaxed);
+  snapshot.cpu_time_ns = cpu_time_ns_.load(std::memory_order_relaxed);
+  return snapshot;
+}
+
+std::vector<TaskQueueMetricsSnapshot> GetTaskQueueMetrics() {
+  MutexLock lock(&GetRegistryLock());
+  std::vector<TaskQueueMetricsSnapshot> snapshots;
+  for (const TaskQueueMetrics* metrics : GetRegistry()) {
+    snapshots.push_back(metrics->Snapshot());
+  }
+  return snapshots;
+}
+
+}  // namespace webrtc
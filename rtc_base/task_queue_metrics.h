@@ -0,0 +1,101 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_TASK_QUEUE_METRICS_H_
+#define RTC_BASE_TASK_QUEUE_METRICS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "rtc_base/system/rtc_export.h"
+
+namespace webrtc {
+
+// Upper bounds, in microseconds, of the buckets of the queue wait histogram.
+// The last bucket counts the waits of a second or more.
+constexpr int64_t kQueueWaitBucketUpperBoundsUs[] = {
+    100,   250,    500,    1000,   2500,   5000,    10000,
+    25000, 50000, 100000, 250000, 500000, 1000000};
+constexpr size_t kNumQueueWaitBuckets =
+    sizeof(kQueueWaitBucketUpperBoundsUs) /
+        sizeof(kQueueWaitBucketUpperBoundsUs[0]) +
+    1;
+
+// Metrics of a task queue or rtc::Thread. The counters are cumulative since
+// the queue was created; take the difference of two snapshots to get the
+// metrics of a period.
+struct TaskQueueMetricsSnapshot {
+  std::string name;
+  int64_t tasks_run = 0;
+  // How long tasks waited to run after they were posted, or, for delayed
+  // tasks, after they were due. A growing wait is the first sign that the
+  // queue is overloaded.
+  std::array<int64_t, kNumQueueWaitBuckets> queue_wait_histogram = {};
+  int64_t total_queue_wait_us = 0;
+  int64_t max_queue_wait_us = 0;
+  // Wall clock time spent running tasks.
+  int64_t busy_time_us = 0;
+  // CPU time of the queue's thread, as of the last sample. Sampled at most
+  // every kCpuTimeSampleIntervalUs, after a task.
+  int64_t cpu_time_ns = 0;
+};
+
+// Returns the metrics of all task queues and rtc::Threads that exist.
+RTC_EXPORT std::vector<TaskQueueMetricsSnapshot> GetTaskQueueMetrics();
+
+// Collects the metrics of a task queue. Owned by the task queue, which calls
+// OnTaskStart() and OnTaskEnd() around every task it runs, on its thread.
+class RTC_EXPORT TaskQueueMetrics {
+ public:
+  static constexpr int64_t kCpuTimeSampleIntervalUs = 100000;
+
+  explicit TaskQueueMetrics(absl::string_view name);
+  ~TaskQueueMetrics();
+
+  TaskQueueMetrics(const TaskQueueMetrics&) = delete;
+  TaskQueueMetrics& operator=(const TaskQueueMetrics&) = delete;
+
+  void SetName(absl::string_view name);
+
+  // Timestamp, in microseconds, for when a task is posted or due.
+  static int64_t Now();
+
+  // Returns the start time to pass to OnTaskEnd(). `ready_time_us` is when
+  // the task was posted or due.
+  int64_t OnTaskStart(int64_t ready_time_us);
+  void OnTaskEnd(int64_t start_time_us);
+
+ private:
+  friend std::vector<TaskQueueMetricsSnapshot> GetTaskQueueMetrics();
+
+  TaskQueueMetricsSnapshot Snapshot() const;
+
+  std::string name_;
+  std::atomic<int64_t> tasks_run_{0};
+  std::array<std::atomic<int64_t>, kNumQueueWaitBuckets> queue_wait_histogram_ =
+      {};
+  std::atomic<int64_t> total_queue_wait_us_{0};
+  std::atomic<int64_t> max_queue_wait_us_{0};
+  std::atomic<int64_t> busy_time_us_{0};
+  std::atomic<int64_t> cpu_time_ns_{0};
+  // Only accessed on the queue's thread.
+  int64_t cpu_time_base_ns_ = -1;
+  int64_t last_cpu_sample_us_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_TASK_QUEUE_METRICS_H_
@@ -0,0 +1,84 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_queue_metrics.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+absl::optional<TaskQueueMetricsSnapshot> FindMetrics(const std::string& name) {
+  for (const TaskQueueMetricsSnapshot& snapshot : GetTaskQueueMetrics()) {
+    if (snapshot.name == name)
+      return snapshot;
+  }
+  return absl::nullopt;
+}
+
+TEST(TaskQueueMetricsTest, RegistersWhileAlive) {
+  auto metrics = std::make_unique<TaskQueueMetrics>("RegistersWhileAlive");
+  EXPECT_TRUE(FindMetrics("RegistersWhileAlive"));
+  metrics->SetName("Renamed");
+  EXPECT_FALSE(FindMetrics("RegistersWhileAlive"));
+  EXPECT_TRUE(FindMetrics("Renamed"));
+  metrics.reset();
+  EXPECT_FALSE(FindMetrics("Renamed"));
+}
+
+TEST(TaskQueueMetricsTest, CountsTasksAndQueueWait) {
+  TaskQueueMetrics metrics("CountsTasksAndQueueWait");
+  const int64_t now_us = TaskQueueMetrics::Now();
+  // A task that waited for about 2 ms, and one that was posted in the future,
+  // which counts as no wait.
+  metrics.OnTaskEnd(metrics.OnTaskStart(now_us - 2000));
+  metrics.OnTaskEnd(metrics.OnTaskStart(now_us + 1000000));
+
+  absl::optional<TaskQueueMetricsSnapshot> snapshot =
+      FindMetrics("CountsTasksAndQueueWait");
+  ASSERT_TRUE(snapshot);
+  EXPECT_EQ(snapshot->tasks_run, 2);
+  EXPECT_GE(snapshot->max_queue_wait_us, 2000);
+  EXPECT_EQ(snapshot->total_queue_wait_us, snapshot->max_queue_wait_us);
+  EXPECT_EQ(snapshot->queue_wait_histogram[0], 1);
+  int64_t total = 0;
+  for (int64_t count : snapshot->queue_wait_histogram)
+    total += count;
+  EXPECT_EQ(total, 2);
+}
+
+TEST(TaskQueueMetricsTest, SamplesThreadCpuTime) {
+  TaskQueueMetrics metrics("SamplesThreadCpuTime");
+  // The first task sets the base of the CPU time.
+  metrics.OnTaskEnd(metrics.OnTaskStart(TaskQueueMetrics::Now()));
+  // A busy task that runs for a sample interval.
+  const int64_t start_us = metrics.OnTaskStart(TaskQueueMetrics::Now());
+  volatile int64_t sink = 0;
+  while (TaskQueueMetrics::Now() - start_us <
+         TaskQueueMetrics::kCpuTimeSampleIntervalUs) {
+    sink = sink + 1;
+  }
+  metrics.OnTaskEnd(start_us);
+
+  absl::optional<TaskQueueMetricsSnapshot> snapshot =
+      FindMetrics("SamplesThreadCpuTime");
+  ASSERT_TRUE(snapshot);
+  EXPECT_GT(snapshot->cpu_time_ns, 0);
+  EXPECT_GE(snapshot->busy_time_us,
+            TaskQueueMetrics::kCpuTimeSampleIntervalUs);
+}
+
+}  // namespace
+}  // namespace webrtc
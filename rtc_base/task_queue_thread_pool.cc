@@ -0,0 +1,311 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_queue_thread_pool.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "api/task_queue/queued_task.h"
+#include "api/task_queue/task_queue_base.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+namespace {
+
+rtc::ThreadPriority TaskQueuePriorityToThreadPriority(
+    TaskQueueFactory::Priority priority) {
+  switch (priority) {
+    case TaskQueueFactory::Priority::HIGH:
+      return rtc::ThreadPriority::kRealtime;
+    case TaskQueueFactory::Priority::LOW:
+      return rtc::ThreadPriority::kLow;
+    case TaskQueueFactory::Priority::NORMAL:
+      return rtc::ThreadPriority::kNormal;
+  }
+}
+
+// Orders tasks by due time, and in posting order if they are due at the same
+// time.
+struct TaskKey {
+  int64_t due_time_ms;
+  uint64_t order;
+
+  bool operator<(const TaskKey& o) const {
+    return std::tie(due_time_ms, order) < std::tie(o.due_time_ms, o.order);
+  }
+};
+
+class ThreadPool;
+
+class PooledTaskQueue final : public TaskQueueBase {
+ public:
+  explicit PooledTaskQueue(ThreadPool* pool) : pool_(pool) {}
+
+  void Delete() override;
+  void PostTask(std::unique_ptr<QueuedTask> task) override;
+  void PostDelayedTask(std::unique_ptr<QueuedTask> task,
+                       uint32_t milliseconds) override;
+
+ private:
+  friend class ThreadPool;
+
+  ~PooledTaskQueue() override = default;
+
+  ThreadPool* const pool_;
+
+  // The members below are guarded by the mutex of `pool_`.
+  std::map<TaskKey, std::unique_ptr<QueuedTask>> tasks_;
+  // The key of the queue in the ready list of the pool, if the queue is in
+  // it. A queue is in the ready list if it has tasks and isn't running.
+  absl::optional<TaskKey> ready_key_;
+  bool running_ = false;
+  bool deleted_ = false;
+  // Set when a task that was running while the queue was deleted is done.
+  rtc::Event done_running_;
+};
+
+class ThreadPool {
+ public:
+  ThreadPool(absl::string_view name,
+             int num_threads,
+             rtc::ThreadPriority priority);
+  ~ThreadPool();
+
+  void CreateQueue() {
+    MutexLock lock(&mutex_);
+    ++num_queues_;
+  }
+  void DeleteQueue(PooledTaskQueue* queue);
+  void PostTask(PooledTaskQueue* queue,
+                std::unique_ptr<QueuedTask> task,
+                uint32_t milliseconds);
+
+ private:
+  void ProcessTasks();
+  void UpdateReadyList(PooledTaskQueue* queue)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void RemoveFromReadyList(PooledTaskQueue* queue)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Signaled when a task is posted, and by a thread that takes a task while
+  // more tasks are due, so that another thread wakes up for them.
+  rtc::Event wake_up_;
+
+  Mutex mutex_;
+  bool quit_ RTC_GUARDED_BY(mutex_) = false;
+  int num_queues_ RTC_GUARDED_BY(mutex_) = 0;
+  uint64_t next_order_ RTC_GUARDED_BY(mutex_) = 0;
+  // The queues that have tasks and aren't running, by their first task.
+  std::map<TaskKey, PooledTaskQueue*> ready_queues_ RTC_GUARDED_BY(mutex_);
+
+  // Placed last so that the threads don't touch uninitialized members.
+  std::vector<rtc::PlatformThread> threads_;
+};
+
+void PooledTaskQueue::Delete() {
+  pool_->DeleteQueue(this);
+}
+
+void PooledTaskQueue::PostTask(std::unique_ptr<QueuedTask> task) {
+  pool_->PostTask(this, std::move(task), 0);
+}
+
+void PooledTaskQueue::PostDelayedTask(std::unique_ptr<QueuedTask> task,
+                                      uint32_t milliseconds) {
+  pool_->PostTask(this, std::move(task), milliseconds);
+}
+
+ThreadPool::ThreadPool(absl::string_view name,
+                       int num_threads,
+                       rtc::ThreadPriority priority) {
+  RTC_DCHECK_GT(num_threads, 0);
+  for (int i = 0; i < num_threads; ++i) {
+    threads_.push_back(rtc::PlatformThread::SpawnJoinable(
+        [this] { ProcessTasks(); }, std::string(name) + std::to_string(i),
+        rtc::ThreadAttributes().SetPriority(priority)));
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    MutexLock lock(&mutex_);
+    RTC_DCHECK_EQ(num_queues_, 0);
+    quit_ = true;
+  }
+  wake_up_.Set();
+  // Joins the threads.
+  threads_.clear();
+}
+
+void ThreadPool::DeleteQueue(PooledTaskQueue* queue) {
+  RTC_DCHECK(!queue->IsCurrent());
+  std::map<TaskKey, std::unique_ptr<QueuedTask>> tasks;
+  bool running;
+  {
+    MutexLock lock(&mutex_);
+    queue->deleted_ = true;
+    RemoveFromReadyList(queue);
+    tasks.swap(queue->tasks_);
+    running = queue->running_;
+    --num_queues_;
+  }
+  // The tasks that didn't run are destroyed without holding the lock, since
+  // they may post tasks.
+  tasks.clear();
+  if (running) {
+    queue->done_running_.Wait(rtc::Event::kForever);
+  }
+  delete queue;
+}
+
+void ThreadPool::PostTask(PooledTaskQueue* queue,
+                          std::unique_ptr<QueuedTask> task,
+                          uint32_t milliseconds) {
+  const int64_t due_time_ms = rtc::TimeMillis() + milliseconds;
+  {
+    MutexLock lock(&mutex_);
+    // Tasks posted while the queue is being deleted are destroyed when this
+    // returns, without holding the lock.
+    if (!queue->deleted_) {
+      queue->tasks_.emplace(TaskKey{due_time_ms, next_order_++},
+                            std::move(task));
+      if (!queue->running_) {
+        UpdateReadyList(queue);
+      }
+    }
+  }
+  wake_up_.Set();
+}
+
+void ThreadPool::UpdateReadyList(PooledTaskQueue* queue) {
+  RTC_DCHECK(!queue->tasks_.empty());
+  const TaskKey& first = queue->tasks_.begin()->first;
+  if (queue->ready_key_ && queue->ready_key_->order == first.order) {
+    return;
+  }
+  RemoveFromReadyList(queue);
+  ready_queues_.emplace(first, queue);
+  queue->ready_key_ = first;
+}
+
+void ThreadPool::RemoveFromReadyList(PooledTaskQueue* queue) {
+  if (queue->ready_key_) {
+    ready_queues_.erase(*queue->ready_key_);
+    queue->ready_key_ = absl::nullopt;
+  }
+}
+
+void ThreadPool::ProcessTasks() {
+  while (true) {
+    PooledTaskQueue* queue = nullptr;
+    std::unique_ptr<QueuedTask> task;
+    bool more_tasks_due = false;
+    int wait_ms = rtc::Event::kForever;
+    {
+      MutexLock lock(&mutex_);
+      if (quit_) {
+        break;
+      }
+      if (!ready_queues_.empty()) {
+        const int64_t now_ms = rtc::TimeMillis();
+        auto it = ready_queues_.begin();
+        if (it->first.due_time_ms <= now_ms) {
+          queue = it->second;
+          ready_queues_.erase(it);
+          queue->ready_key_ = absl::nullopt;
+          auto task_it = queue->tasks_.begin();
+          task = std::move(task_it->second);
+          queue->tasks_.erase(task_it);
+          queue->running_ = true;
+          more_tasks_due = !ready_queues_.empty() &&
+                           ready_queues_.begin()->first.due_time_ms <= now_ms;
+        } else {
+          wait_ms = static_cast<int>(
+              std::min<int64_t>(it->first.due_time_ms - now_ms,
+                                std::numeric_limits<int>::max()));
+        }
+      }
+    }
+
+    if (!queue) {
+      wake_up_.Wait(wait_ms);
+      continue;
+    }
+    if (more_tasks_due) {
+      wake_up_.Set();
+    }
+
+    {
+      TaskQueueBase::CurrentTaskQueueSetter set_current(queue);
+      QueuedTask* release_ptr = task.release();
+      if (release_ptr->Run())
+        delete release_ptr;
+    }
+
+    MutexLock lock(&mutex_);
+    queue->running_ = false;
+    if (queue->deleted_) {
+      // DeleteQueue() deletes the queue as soon as this is set, so it must
+      // not be touched afterwards.
+      queue->done_running_.Set();
+    } else if (!queue->tasks_.empty()) {
+      UpdateReadyList(queue);
+    }
+  }
+  // Let the next thread see `quit_`.
+  wake_up_.Set();
+}
+
+class TaskQueueThreadPoolFactory final : public TaskQueueFactory {
+ public:
+  TaskQueueThreadPoolFactory(absl::string_view name,
+                             int num_threads,
+                             rtc::ThreadPriority priority)
+      : pool_(name, num_threads, priority) {}
+
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateTaskQueue(
+      absl::string_view name,
+      Priority priority) const override {
+    pool_.CreateQueue();
+    return std::unique_ptr<TaskQueueBase, TaskQueueDeleter>(
+        new PooledTaskQueue(&pool_));
+  }
+
+ private:
+  mutable ThreadPool pool_;
+};
+
+}  // namespace
+
+std::unique_ptr<TaskQueueFactory> CreateTaskQueueThreadPoolFactory(
+    absl::string_view name,
+    int num_threads,
+    TaskQueueFactory::Priority priority) {
+  return std::make_unique<TaskQueueThreadPoolFactory>(
+      name, num_threads, TaskQueuePriorityToThreadPriority(priority));
+}
+
+}  // namespace webrtc
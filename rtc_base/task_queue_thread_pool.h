@@ -0,0 +1,41 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_TASK_QUEUE_THREAD_POOL_H_
+#define RTC_BASE_TASK_QUEUE_THREAD_POOL_H_
+
+#include <memory>
+
+#include "absl/strings/string_view.h"
+#include "api/task_queue/task_queue_factory.h"
+
+namespace webrtc {
+
+// Returns a factory of task queues that share `num_threads` worker threads,
+// rather than having a thread each. This suits many task queues that are
+// idle most of the time, such as the decoding queues of the streams of a
+// large call.
+//
+// Each task queue still runs its tasks one at a time and in order. When more
+// tasks are due than there are idle threads, the task with the earliest due
+// time runs first, no matter which queue it was posted to. So delayed tasks
+// run in order of their deadlines.
+//
+// The worker threads are named `name` followed by their index and run at
+// `priority`. The priority passed to CreateTaskQueue() is ignored. The
+// factory must outlive the task queues it creates.
+std::unique_ptr<TaskQueueFactory> CreateTaskQueueThreadPoolFactory(
+    absl::string_view name,
+    int num_threads,
+    TaskQueueFactory::Priority priority);
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_TASK_QUEUE_THREAD_POOL_H_
@@ -0,0 +1,142 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_queue_thread_pool.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "api/task_queue/task_queue_test.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread_types.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/task_queue.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+
+std::unique_ptr<TaskQueueFactory> CreateFactory() {
+  return CreateTaskQueueThreadPoolFactory("TestPool", /*num_threads=*/3,
+                                          TaskQueueFactory::Priority::NORMAL);
+}
+
+INSTANTIATE_TEST_SUITE_P(ThreadPool,
+                         TaskQueueTest,
+                         ::testing::Values(CreateFactory));
+
+TEST(TaskQueueThreadPoolTest, RunsTasksOfManyQueuesOnSharedThreads) {
+  constexpr int kNumQueues = 20;
+  std::unique_ptr<TaskQueueFactory> factory =
+      CreateTaskQueueThreadPoolFactory("TestPool", /*num_threads=*/2,
+                                       TaskQueueFactory::Priority::NORMAL);
+  std::vector<std::unique_ptr<rtc::TaskQueue>> queues;
+  for (int i = 0; i < kNumQueues; ++i) {
+    queues.push_back(std::make_unique<rtc::TaskQueue>(factory->CreateTaskQueue(
+        "Queue", TaskQueueFactory::Priority::NORMAL)));
+  }
+
+  Mutex mutex;
+  std::vector<rtc::PlatformThreadRef> threads;
+  std::atomic<int> tasks_left(kNumQueues);
+  rtc::Event done;
+  for (auto& queue : queues) {
+    queue->PostTask([&, queue = queue.get()] {
+      EXPECT_TRUE(queue->IsCurrent());
+      {
+        MutexLock lock(&mutex);
+        rtc::PlatformThreadRef thread = rtc::CurrentThreadRef();
+        bool found = false;
+        for (const rtc::PlatformThreadRef& t : threads)
+          found |= rtc::IsThreadRefEqual(t, thread);
+        if (!found)
+          threads.push_back(thread);
+      }
+      if (--tasks_left == 0)
+        done.Set();
+    });
+  }
+  EXPECT_TRUE(done.Wait(1000));
+  MutexLock lock(&mutex);
+  EXPECT_LE(threads.size(), 2u);
+}
+
+TEST(TaskQueueThreadPoolTest, RunsTasksOfOneQueueOneAtATime) {
+  std::unique_ptr<TaskQueueFactory> factory = CreateFactory();
+  rtc::TaskQueue queue(
+      factory->CreateTaskQueue("Queue", TaskQueueFactory::Priority::NORMAL));
+  std::atomic<int> running(0);
+  std::vector<int> order;
+  rtc::Event done;
+  for (int i = 0; i < 100; ++i) {
+    queue.PostTask([&, i] {
+      EXPECT_EQ(++running, 1);
+      order.push_back(i);
+      --running;
+      if (i == 99)
+        done.Set();
+    });
+  }
+  EXPECT_TRUE(done.Wait(1000));
+  ASSERT_EQ(order.size(), 100u);
+  for (int i = 0; i < 100; ++i)
+    EXPECT_EQ(order[i], i);
+}
+
+TEST(TaskQueueThreadPoolTest, RunsTaskWithEarliestDeadlineFirst) {
+  std::unique_ptr<TaskQueueFactory> factory =
+      CreateTaskQueueThreadPoolFactory("TestPool", /*num_threads=*/1,
+                                       TaskQueueFactory::Priority::NORMAL);
+  rtc::TaskQueue blocked(
+      factory->CreateTaskQueue("Blocked", TaskQueueFactory::Priority::NORMAL));
+  rtc::TaskQueue late(
+      factory->CreateTaskQueue("Late", TaskQueueFactory::Priority::NORMAL));
+  rtc::TaskQueue early(
+      factory->CreateTaskQueue("Early", TaskQueueFactory::Priority::NORMAL));
+
+  // Keep the only thread busy until both delayed tasks are due.
+  rtc::Event unblock;
+  rtc::Event blocking;
+  blocked.PostTask([&] {
+    blocking.Set();
+    unblock.Wait(rtc::Event::kForever);
+  });
+  ASSERT_TRUE(blocking.Wait(1000));
+
+  Mutex mutex;
+  std::vector<int> order;
+  rtc::Event done;
+  late.PostDelayedTask(
+      [&] {
+        MutexLock lock(&mutex);
+        order.push_back(2);
+        done.Set();
+      },
+      20);
+  early.PostDelayedTask(
+      [&] {
+        MutexLock lock(&mutex);
+        order.push_back(1);
+      },
+      10);
+  rtc::Event().Wait(40);
+  unblock.Set();
+
+  EXPECT_TRUE(done.Wait(1000));
+  MutexLock lock(&mutex);
+  EXPECT_THAT(order, ElementsAre(1, 2));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,496 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_queue_work_stealing.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "absl/base/attributes.h"
+#include "absl/base/config.h"
+#include "absl/strings/string_view.h"
+#include "api/ref_counted_base.h"
+#include "api/scoped_refptr.h"
+#include "api/task_queue/queued_task.h"
+#include "api/task_queue/task_queue_base.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+namespace {
+
+rtc::ThreadPriority TaskQueuePriorityToThreadPriority(
+    TaskQueueFactory::Priority priority) {
+  switch (priority) {
+    case TaskQueueFactory::Priority::HIGH:
+      return rtc::ThreadPriority::kRealtime;
+    case TaskQueueFactory::Priority::LOW:
+      return rtc::ThreadPriority::kLow;
+    case TaskQueueFactory::Priority::NORMAL:
+      return rtc::ThreadPriority::kNormal;
+  }
+}
+
+// The tasks of a task queue. It's referenced by the lists of the workers and
+// by the delayed tasks, so that it may outlive its task queue.
+struct Sequence : public rtc::RefCountedNonVirtual<Sequence> {
+  explicit Sequence(TaskQueueBase* task_queue) : task_queue(task_queue) {}
+
+  // Only used while running a task, which the task queue waits for when
+  // deleted.
+  TaskQueueBase* const task_queue;
+
+  Mutex mutex;
+  std::deque<std::unique_ptr<QueuedTask>> tasks RTC_GUARDED_BY(mutex);
+  // Set while the sequence is in the list of a worker, or running. A sequence
+  // is scheduled if it has tasks, and is then in at most one list.
+  bool scheduled RTC_GUARDED_BY(mutex) = false;
+  bool running RTC_GUARDED_BY(mutex) = false;
+  bool deleted RTC_GUARDED_BY(mutex) = false;
+  // Set when a task that was running while the task queue was deleted is
+  // done.
+  rtc::Event done_running;
+};
+
+class WorkStealingPool;
+
+struct Worker {
+  Worker(WorkStealingPool* pool, int index) : pool(pool), index(index) {}
+
+  WorkStealingPool* const pool;
+  const int index;
+
+  Mutex mutex;
+  // The sequences with tasks to run. The worker takes sequences from the
+  // front, and other workers steal from the back.
+  std::deque<rtc::scoped_refptr<Sequence>> ready RTC_GUARDED_BY(mutex);
+  // Signaled when the worker is taken from the idle workers of the pool.
+  rtc::Event wake_up;
+
+  rtc::PlatformThread thread;
+};
+
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+ABSL_CONST_INIT thread_local Worker* current_worker = nullptr;
+#else
+// Without thread_local, ready sequences are spread over the workers.
+Worker* const current_worker = nullptr;
+#endif
+
+// Orders delayed tasks by due time, and in posting order if they are due at
+// the same time.
+struct TaskKey {
+  int64_t due_time_ms;
+  uint64_t order;
+
+  bool operator<(const TaskKey& o) const {
+    return std::tie(due_time_ms, order) < std::tie(o.due_time_ms, o.order);
+  }
+};
+
+struct DelayedTask {
+  rtc::scoped_refptr<Sequence> sequence;
+  std::unique_ptr<QueuedTask> task;
+};
+
+class WorkStealingPool {
+ public:
+  WorkStealingPool(absl::string_view name,
+                   int num_threads,
+                   rtc::ThreadPriority priority);
+  ~WorkStealingPool();
+
+  void CreateQueue() { ++num_queues_; }
+  void DeleteQueue(Sequence* sequence);
+  void PostTask(const rtc::scoped_refptr<Sequence>& sequence,
+                std::unique_ptr<QueuedTask> task);
+  void PostDelayedTask(rtc::scoped_refptr<Sequence> sequence,
+                       std::unique_ptr<QueuedTask> task,
+                       uint32_t milliseconds);
+
+ private:
+  // Adds `sequence` to the list of the current worker, if called on one of
+  // the workers, or else to the list of the next worker, in turn.
+  void Schedule(rtc::scoped_refptr<Sequence> sequence);
+  // Wakes up an idle worker, if any, to steal sequences from busy ones.
+  void WakeUpIdleWorker();
+  // Removes `worker` from the idle workers, unless it was woken up.
+  void RemoveIdleWorker(Worker* worker);
+  // Takes a sequence from the list of `worker`, or steals one from another
+  // worker. Returns null if all lists are empty.
+  rtc::scoped_refptr<Sequence> TakeSequence(Worker* worker);
+  // Runs the first task of `sequence`, and puts it back in the list of
+  // `worker` if it has more tasks.
+  void RunTask(Worker* worker, rtc::scoped_refptr<Sequence> sequence);
+  void ProcessTasks(Worker* worker);
+  void ProcessDelayedTasks();
+
+  std::atomic<int> num_queues_{0};
+  std::atomic<bool> quit_{false};
+  std::atomic<size_t> next_worker_{0};
+
+  // Set once by the constructor, before any thread is started.
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  Mutex idle_mutex_;
+  std::vector<Worker*> idle_workers_ RTC_GUARDED_BY(idle_mutex_);
+  // The size of `idle_workers_`, to not take `idle_mutex_` when no worker is
+  // idle.
+  std::atomic<int> num_idle_workers_{0};
+
+  Mutex delayed_mutex_;
+  uint64_t next_order_ RTC_GUARDED_BY(delayed_mutex_) = 0;
+  std::map<TaskKey, DelayedTask> delayed_tasks_ RTC_GUARDED_BY(delayed_mutex_);
+  // Signaled when a delayed task is posted that is due before all others.
+  rtc::Event delayed_wake_up_;
+
+  // Placed last so that the thread doesn't touch uninitialized members.
+  rtc::PlatformThread timer_thread_;
+};
+
+class WorkStealingTaskQueue final : public TaskQueueBase {
+ public:
+  explicit WorkStealingTaskQueue(WorkStealingPool* pool)
+      : pool_(pool), sequence_(new Sequence(this)) {}
+
+  void Delete() override {
+    RTC_DCHECK(!IsCurrent());
+    pool_->DeleteQueue(sequence_.get());
+    delete this;
+  }
+  void PostTask(std::unique_ptr<QueuedTask> task) override {
+    pool_->PostTask(sequence_, std::move(task));
+  }
+  void PostDelayedTask(std::unique_ptr<QueuedTask> task,
+                       uint32_t milliseconds) override {
+    pool_->PostDelayedTask(sequence_, std::move(task), milliseconds);
+  }
+
+ private:
+  friend class WorkStealingPool;
+
+  ~WorkStealingTaskQueue() override = default;
+
+  WorkStealingPool* const pool_;
+  const rtc::scoped_refptr<Sequence> sequence_;
+};
+
+WorkStealingPool::WorkStealingPool(absl::string_view name,
+                                   int num_threads,
+                                   rtc::ThreadPriority priority) {
+  RTC_DCHECK_GT(num_threads, 0);
+  for (int i = 0; i < num_threads; ++i) {
+    workers_.push_back(std::make_unique<Worker>(this, i));
+  }
+  for (auto& worker : workers_) {
+    worker->thread = rtc::PlatformThread::SpawnJoinable(
+        [this, worker = worker.get()] { ProcessTasks(worker); },
+        std::string(name) + std::to_string(worker->index),
+        rtc::ThreadAttributes().SetPriority(priority));
+  }
+  timer_thread_ = rtc::PlatformThread::SpawnJoinable(
+      [this] { ProcessDelayedTasks(); }, std::string(name) + "Timer",
+      rtc::ThreadAttributes().SetPriority(priority));
+}
+
+WorkStealingPool::~WorkStealingPool() {
+  RTC_DCHECK_EQ(num_queues_.load(), 0);
+  quit_.store(true);
+  delayed_wake_up_.Set();
+  timer_thread_.Finalize();
+  for (auto& worker : workers_) {
+    worker->wake_up.Set();
+    worker->thread.Finalize();
+  }
+}
+
+void WorkStealingPool::DeleteQueue(Sequence* sequence) {
+  std::deque<std::unique_ptr<QueuedTask>> tasks;
+  std::vector<std::unique_ptr<QueuedTask>> delayed_tasks;
+  bool running;
+  {
+    MutexLock lock(&sequence->mutex);
+    sequence->deleted = true;
+    tasks.swap(sequence->tasks);
+    running = sequence->running;
+  }
+  {
+    MutexLock lock(&delayed_mutex_);
+    for (auto it = delayed_tasks_.begin(); it != delayed_tasks_.end();) {
+      if (it->second.sequence.get() == sequence) {
+        delayed_tasks.push_back(std::move(it->second.task));
+        it = delayed_tasks_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  // The tasks that didn't run are destroyed without holding a lock, since
+  // they may post tasks.
+  tasks.clear();
+  delayed_tasks.clear();
+  if (running) {
+    sequence->done_running.Wait(rtc::Event::kForever);
+  }
+  --num_queues_;
+}
+
+void WorkStealingPool::PostTask(const rtc::scoped_refptr<Sequence>& sequence,
+                                std::unique_ptr<QueuedTask> task) {
+  {
+    MutexLock lock(&sequence->mutex);
+    // Tasks posted while the queue is being deleted are destroyed when this
+    // returns, without holding the lock.
+    if (sequence->deleted) {
+      return;
+    }
+    sequence->tasks.push_back(std::move(task));
+    if (sequence->scheduled) {
+      return;
+    }
+    sequence->scheduled = true;
+  }
+  Schedule(sequence);
+}
+
+void WorkStealingPool::PostDelayedTask(rtc::scoped_refptr<Sequence> sequence,
+                                       std::unique_ptr<QueuedTask> task,
+                                       uint32_t milliseconds) {
+  const int64_t due_time_ms = rtc::TimeMillis() + milliseconds;
+  bool is_first;
+  {
+    MutexLock lock(&delayed_mutex_);
+    auto it =
+        delayed_tasks_
+            .emplace(TaskKey{due_time_ms, next_order_++},
+                     DelayedTask{std::move(sequence), std::move(task)})
+            .first;
+    is_first = it == delayed_tasks_.begin();
+  }
+  if (is_first) {
+    delayed_wake_up_.Set();
+  }
+}
+
+void WorkStealingPool::Schedule(rtc::scoped_refptr<Sequence> sequence) {
+  Worker* worker = current_worker;
+  if (worker == nullptr || worker->pool != this) {
+    worker = workers_[next_worker_++ % workers_.size()].get();
+  }
+  {
+    MutexLock lock(&worker->mutex);
+    worker->ready.push_back(std::move(sequence));
+  }
+  WakeUpIdleWorker();
+}
+
+void WorkStealingPool::WakeUpIdleWorker() {
+  // A worker adds itself to the idle workers before it checks all lists a
+  // last time, so either it finds the sequence that was just added, or it's
+  // counted here.
+  if (num_idle_workers_.load() == 0) {
+    return;
+  }
+  Worker* idle_worker = nullptr;
+  {
+    MutexLock lock(&idle_mutex_);
+    if (!idle_workers_.empty()) {
+      idle_worker = idle_workers_.back();
+      idle_workers_.pop_back();
+      --num_idle_workers_;
+    }
+  }
+  if (idle_worker) {
+    idle_worker->wake_up.Set();
+  }
+}
+
+void WorkStealingPool::RemoveIdleWorker(Worker* worker) {
+  MutexLock lock(&idle_mutex_);
+  auto it = std::find(idle_workers_.begin(), idle_workers_.end(), worker);
+  if (it != idle_workers_.end()) {
+    idle_workers_.erase(it);
+    --num_idle_workers_;
+  }
+}
+
+rtc::scoped_refptr<Sequence> WorkStealingPool::TakeSequence(Worker* worker) {
+  rtc::scoped_refptr<Sequence> sequence;
+  {
+    MutexLock lock(&worker->mutex);
+    if (!worker->ready.empty()) {
+      sequence = std::move(worker->ready.front());
+      worker->ready.pop_front();
+      return sequence;
+    }
+  }
+  for (size_t i = 1; i < workers_.size(); ++i) {
+    Worker* victim = workers_[(worker->index + i) % workers_.size()].get();
+    MutexLock lock(&victim->mutex);
+    if (!victim->ready.empty()) {
+      sequence = std::move(victim->ready.back());
+      victim->ready.pop_back();
+      return sequence;
+    }
+  }
+  return nullptr;
+}
+
+void WorkStealingPool::RunTask(Worker* worker,
+                               rtc::scoped_refptr<Sequence> sequence) {
+  std::unique_ptr<QueuedTask> task;
+  {
+    MutexLock lock(&sequence->mutex);
+    if (sequence->deleted) {
+      sequence->scheduled = false;
+      return;
+    }
+    RTC_DCHECK(!sequence->tasks.empty());
+    task = std::move(sequence->tasks.front());
+    sequence->tasks.pop_front();
+    sequence->running = true;
+  }
+
+  {
+    WorkStealingTaskQueue::CurrentTaskQueueSetter set_current(
+        sequence->task_queue);
+    QueuedTask* release_ptr = task.release();
+    if (release_ptr->Run())
+      delete release_ptr;
+  }
+
+  {
+    MutexLock lock(&sequence->mutex);
+    sequence->running = false;
+    if (sequence->deleted) {
+      sequence->scheduled = false;
+      // The task queue may be deleted as soon as this is set.
+      sequence->done_running.Set();
+      return;
+    }
+    if (sequence->tasks.empty()) {
+      sequence->scheduled = false;
+      return;
+    }
+  }
+  // Other sequences in the list run before the next task of this one. Only
+  // then is there work for an idle worker to steal.
+  bool has_other_sequences;
+  {
+    MutexLock lock(&worker->mutex);
+    has_other_sequences = !worker->ready.empty();
+    worker->ready.push_back(std::move(sequence));
+  }
+  if (has_other_sequences) {
+    WakeUpIdleWorker();
+  }
+}
+
+void WorkStealingPool::ProcessTasks(Worker* worker) {
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+  current_worker = worker;
+#endif
+  while (!quit_.load()) {
+    rtc::scoped_refptr<Sequence> sequence = TakeSequence(worker);
+    if (sequence) {
+      RunTask(worker, std::move(sequence));
+      continue;
+    }
+
+    {
+      MutexLock lock(&idle_mutex_);
+      idle_workers_.push_back(worker);
+      ++num_idle_workers_;
+    }
+    sequence = TakeSequence(worker);
+    if (!sequence) {
+      worker->wake_up.Wait(rtc::Event::kForever);
+    }
+    // The worker may also have been woken up by a sequence that it took
+    // itself, or when quitting.
+    RemoveIdleWorker(worker);
+    if (sequence) {
+      RunTask(worker, std::move(sequence));
+    }
+  }
+}
+
+void WorkStealingPool::ProcessDelayedTasks() {
+  while (!quit_.load()) {
+    std::vector<DelayedTask> due_tasks;
+    int wait_ms = rtc::Event::kForever;
+    {
+      MutexLock lock(&delayed_mutex_);
+      const int64_t now_ms = rtc::TimeMillis();
+      auto it = delayed_tasks_.begin();
+      for (; it != delayed_tasks_.end() && it->first.due_time_ms <= now_ms;
+           ++it) {
+        due_tasks.push_back(std::move(it->second));
+      }
+      delayed_tasks_.erase(delayed_tasks_.begin(), it);
+      if (!delayed_tasks_.empty()) {
+        wait_ms = static_cast<int>(
+            std::min<int64_t>(delayed_tasks_.begin()->first.due_time_ms -
+                                  now_ms,
+                              std::numeric_limits<int>::max()));
+      }
+    }
+    for (DelayedTask& due_task : due_tasks) {
+      PostTask(due_task.sequence, std::move(due_task.task));
+    }
+    due_tasks.clear();
+    delayed_wake_up_.Wait(wait_ms);
+  }
+}
+
+class TaskQueueWorkStealingFactory final : public TaskQueueFactory {
+ public:
+  TaskQueueWorkStealingFactory(absl::string_view name,
+                               int num_threads,
+                               rtc::ThreadPriority priority)
+      : pool_(name, num_threads, priority) {}
+
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateTaskQueue(
+      absl::string_view name,
+      Priority priority) const override {
+    pool_.CreateQueue();
+    return std::unique_ptr<TaskQueueBase, TaskQueueDeleter>(
+        new WorkStealingTaskQueue(&pool_));
+  }
+
+ private:
+  mutable WorkStealingPool pool_;
+};
+
+}  // namespace
+
+std::unique_ptr<TaskQueueFactory> CreateTaskQueueWorkStealingFactory(
+    absl::string_view name,
+    int num_threads,
+    TaskQueueFactory::Priority priority) {
+  return std::make_unique<TaskQueueWorkStealingFactory>(
+      name, num_threads, TaskQueuePriorityToThreadPriority(priority));
+}
+
+}  // namespace webrtc
@@ -0,0 +1,43 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_TASK_QUEUE_WORK_STEALING_H_
+#define RTC_BASE_TASK_QUEUE_WORK_STEALING_H_
+
+#include <memory>
+
+#include "absl/strings/string_view.h"
+#include "api/task_queue/task_queue_factory.h"
+
+namespace webrtc {
+
+// Returns a factory of task queues that are multiplexed onto `num_threads`
+// worker threads, which should typically be the number of cores. Unlike the
+// task queues of CreateTaskQueueStdlibFactory(), which have a thread each,
+// any number of task queues can be created without adding threads.
+//
+// Each task queue still runs its tasks one at a time and in order. Every
+// worker has its own list of task queues with tasks to run, so that posting
+// rarely contends with other workers. A task queue that a task is posted to
+// from a worker goes into that worker's list, and idle workers steal task
+// queues from the lists of busy ones. Delayed tasks are posted to their task
+// queue when due, by a timer thread.
+//
+// The threads are named `name` followed by their index and run at
+// `priority`. The priority passed to CreateTaskQueue() is ignored. The
+// factory must outlive the task queues it creates.
+std::unique_ptr<TaskQueueFactory> CreateTaskQueueWorkStealingFactory(
+    absl::string_view name,
+    int num_threads,
+    TaskQueueFactory::Priority priority);
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_TASK_QUEUE_WORK_STEALING_H_
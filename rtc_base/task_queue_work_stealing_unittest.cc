@@ -0,0 +1,130 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_queue_work_stealing.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "api/task_queue/task_queue_test.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread_types.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/task_queue.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+std::unique_ptr<TaskQueueFactory> CreateFactory() {
+  return CreateTaskQueueWorkStealingFactory("TestPool", /*num_threads=*/3,
+                                            TaskQueueFactory::Priority::NORMAL);
+}
+
+INSTANTIATE_TEST_SUITE_P(WorkStealing,
+                         TaskQueueTest,
+                         ::testing::Values(CreateFactory));
+
+TEST(TaskQueueWorkStealingTest, RunsTasksOfManyQueuesOnSharedThreads) {
+  constexpr int kNumQueues = 100;
+  std::unique_ptr<TaskQueueFactory> factory =
+      CreateTaskQueueWorkStealingFactory("TestPool", /*num_threads=*/2,
+                                         TaskQueueFactory::Priority::NORMAL);
+  std::vector<std::unique_ptr<rtc::TaskQueue>> queues;
+  for (int i = 0; i < kNumQueues; ++i) {
+    queues.push_back(std::make_unique<rtc::TaskQueue>(factory->CreateTaskQueue(
+        "Queue", TaskQueueFactory::Priority::NORMAL)));
+  }
+
+  Mutex mutex;
+  std::vector<rtc::PlatformThreadRef> threads;
+  std::atomic<int> tasks_left(kNumQueues);
+  rtc::Event done;
+  for (auto& queue : queues) {
+    queue->PostTask([&, queue = queue.get()] {
+      EXPECT_TRUE(queue->IsCurrent());
+      {
+        MutexLock lock(&mutex);
+        rtc::PlatformThreadRef thread = rtc::CurrentThreadRef();
+        bool found = false;
+        for (const rtc::PlatformThreadRef& t : threads)
+          found |= rtc::IsThreadRefEqual(t, thread);
+        if (!found)
+          threads.push_back(thread);
+      }
+      if (--tasks_left == 0)
+        done.Set();
+    });
+  }
+  EXPECT_TRUE(done.Wait(1000));
+  MutexLock lock(&mutex);
+  EXPECT_LE(threads.size(), 2u);
+}
+
+TEST(TaskQueueWorkStealingTest, RunsTasksOfOneQueueInOrderOneAtATime) {
+  std::unique_ptr<TaskQueueFactory> factory = CreateFactory();
+  rtc::TaskQueue queue(
+      factory->CreateTaskQueue("Queue", TaskQueueFactory::Priority::NORMAL));
+  rtc::TaskQueue other_queue(
+      factory->CreateTaskQueue("Other", TaskQueueFactory::Priority::NORMAL));
+  std::atomic<int> running(0);
+  std::vector<int> order;
+  rtc::Event done;
+  for (int i = 0; i < 1000; ++i) {
+    // Posting from another queue as well puts `queue` in the lists of
+    // different workers.
+    auto task = [&, i] {
+      EXPECT_EQ(++running, 1);
+      order.push_back(i);
+      --running;
+      if (i == 999)
+        done.Set();
+    };
+    if (i % 2 == 0) {
+      queue.PostTask(task);
+    } else {
+      rtc::Event posted;
+      other_queue.PostTask([&] {
+        queue.PostTask(task);
+        posted.Set();
+      });
+      posted.Wait(rtc::Event::kForever);
+    }
+  }
+  EXPECT_TRUE(done.Wait(1000));
+  ASSERT_EQ(order.size(), 1000u);
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_EQ(order[i], i);
+}
+
+TEST(TaskQueueWorkStealingTest, IdleWorkerStealsFromBusyWorker) {
+  std::unique_ptr<TaskQueueFactory> factory =
+      CreateTaskQueueWorkStealingFactory("TestPool", /*num_threads=*/2,
+                                         TaskQueueFactory::Priority::NORMAL);
+  rtc::TaskQueue busy(
+      factory->CreateTaskQueue("Busy", TaskQueueFactory::Priority::NORMAL));
+  rtc::TaskQueue stolen(
+      factory->CreateTaskQueue("Stolen", TaskQueueFactory::Priority::NORMAL));
+
+  // The task posted from `busy` goes into the list of the worker running
+  // `busy`, which only returns when the other worker has run it.
+  rtc::Event stolen_task_run;
+  rtc::Event done;
+  busy.PostTask([&] {
+    stolen.PostTask([&] { stolen_task_run.Set(); });
+    EXPECT_TRUE(stolen_task_run.Wait(1000));
+    done.Set();
+  });
+  EXPECT_TRUE(done.Wait(2000));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,167 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_TASK_UTILS_COROUTINES_H_
+#define RTC_BASE_TASK_UTILS_COROUTINES_H_
+
+// Awaitables that let a C++20 coroutine hop between task queues, wait for a
+// delay and wait for its turn on an OperationsChain, instead of spelling the
+// sequence out as nested PostTask() callbacks:
+//
+//   DetachedTask SetRemoteDescription(...) {
+//     std::function<void()> done = co_await ChainedOperation(chain);
+//     co_await SwitchToTaskQueue(network_thread);
+//     ...
+//     co_await SwitchToTaskQueue(signaling_thread);
+//     done();
+//   }
+//
+// Everything in this file is only defined if the compiler supports
+// coroutines, which RTC_HAS_COROUTINES tells.
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L && \
+    __has_include(<coroutine>)
+#define RTC_HAS_COROUTINES 1
+#else
+#define RTC_HAS_COROUTINES 0
+#endif
+
+#if RTC_HAS_COROUTINES
+
+#include <coroutine>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "api/task_queue/queued_task.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/operations_chain.h"
+#include "rtc_base/task_utils/task_memory_pool.h"
+
+namespace webrtc {
+
+namespace webrtc_coroutines_impl {
+
+// Resumes a coroutine when run. If the task is destroyed without running,
+// because its task queue is deleted, the suspended coroutine is destroyed
+// instead, so that its frame and locals are not leaked.
+class ResumeTask final : public QueuedTask, public TaskMemoryPooled {
+ public:
+  explicit ResumeTask(std::coroutine_handle<> handle) : handle_(handle) {}
+  ~ResumeTask() override {
+    if (handle_)
+      handle_.destroy();
+  }
+
+ private:
+  bool Run() override {
+    std::exchange(handle_, nullptr).resume();
+    return true;
+  }
+
+  std::coroutine_handle<> handle_;
+};
+
+}  // namespace webrtc_coroutines_impl
+
+// Return type of a coroutine that starts running when called, like a posted
+// task that runs inline, and that nothing awaits. Its frame is freed when it
+// returns. The frame is allocated from the task memory pool.
+class DetachedTask {
+ public:
+  struct promise_type : public TaskMemoryPooled {
+    DetachedTask get_return_object() { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { RTC_CHECK_NOTREACHED(); }
+  };
+};
+
+// co_await SwitchToTaskQueue(queue) continues the coroutine on `queue`. It
+// doesn't suspend if the coroutine already runs on `queue`; otherwise the
+// rest of the coroutine is posted to `queue` as a task.
+class SwitchToTaskQueue {
+ public:
+  explicit SwitchToTaskQueue(TaskQueueBase* queue) : queue_(queue) {
+    RTC_DCHECK(queue_);
+  }
+
+  bool await_ready() const { return queue_->IsCurrent(); }
+  void await_suspend(std::coroutine_handle<> handle) {
+    queue_->PostTask(
+        std::make_unique<webrtc_coroutines_impl::ResumeTask>(handle));
+  }
+  void await_resume() {}
+
+ private:
+  TaskQueueBase* const queue_;
+};
+
+// co_await ResumeAfter(delay) continues the coroutine on the current task
+// queue after `delay`, without blocking the task queue in between. Must be
+// awaited on a task queue.
+class ResumeAfter {
+ public:
+  explicit ResumeAfter(TimeDelta delay) : delay_(delay) {}
+
+  bool await_ready() const { return false; }
+  void await_suspend(std::coroutine_handle<> handle) {
+    TaskQueueBase* const current = TaskQueueBase::Current();
+    RTC_DCHECK(current);
+    current->PostDelayedTask(
+        std::make_unique<webrtc_coroutines_impl::ResumeTask>(handle),
+        delay_.ms<uint32_t>());
+  }
+  void await_resume() {}
+
+ private:
+  const TimeDelta delay_;
+};
+
+// co_await ChainedOperation(chain) continues the coroutine when it is its
+// turn to run an operation on `chain`, immediately if `chain` is empty, and
+// returns the callback that completes the operation. Like the functor passed
+// to rtc::OperationsChain::ChainOperation(), the coroutine must invoke the
+// callback exactly once, on the sequence it was chained on.
+class ChainedOperation {
+ public:
+  explicit ChainedOperation(rtc::OperationsChain* chain) : chain_(chain) {
+    RTC_DCHECK(chain_);
+  }
+
+  bool await_ready() const { return false; }
+  bool await_suspend(std::coroutine_handle<> handle) {
+    chaining_ = true;
+    chain_->ChainOperation([this, handle](std::function<void()> callback) {
+      callback_ = std::move(callback);
+      // Resumed inline by returning false from await_suspend() if the chain
+      // was empty.
+      if (!chaining_)
+        handle.resume();
+    });
+    chaining_ = false;
+    return !callback_;
+  }
+  std::function<void()> await_resume() { return std::move(callback_); }
+
+ private:
+  rtc::OperationsChain* const chain_;
+  bool chaining_ = false;
+  std::function<void()> callback_;
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_HAS_COROUTINES
+
+#endif  // RTC_BASE_TASK_UTILS_COROUTINES_H_
@@ -0,0 +1,160 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_utils/coroutines.h"
+
+#if RTC_HAS_COROUTINES
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "api/scoped_refptr.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/event.h"
+#include "rtc_base/operations_chain.h"
+#include "rtc_base/task_queue_for_test.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+DetachedTask HopThereAndBack(TaskQueueBase* origin,
+                             TaskQueueBase* other,
+                             std::vector<TaskQueueBase*>* visited,
+                             rtc::Event* done) {
+  visited->push_back(TaskQueueBase::Current());
+  co_await SwitchToTaskQueue(other);
+  visited->push_back(TaskQueueBase::Current());
+  co_await SwitchToTaskQueue(origin);
+  visited->push_back(TaskQueueBase::Current());
+  done->Set();
+}
+
+TEST(CoroutinesTest, SwitchesBetweenTaskQueues) {
+  TaskQueueForTest origin("origin");
+  TaskQueueForTest other("other");
+  std::vector<TaskQueueBase*> visited;
+  rtc::Event done;
+  origin.PostTask([&] {
+    HopThereAndBack(origin.Get(), other.Get(), &visited, &done);
+  });
+  ASSERT_TRUE(done.Wait(1000));
+  EXPECT_EQ(visited, (std::vector<TaskQueueBase*>{origin.Get(), other.Get(),
+                                                  origin.Get()}));
+}
+
+DetachedTask SwitchToCurrent(TaskQueueBase* queue, bool* continued_inline) {
+  co_await SwitchToTaskQueue(queue);
+  *continued_inline = true;
+}
+
+TEST(CoroutinesTest, DoesNotSuspendWhenSwitchingToCurrentTaskQueue) {
+  TaskQueueForTest queue("queue");
+  bool continued_inline = false;
+  queue.SendTask(
+      [&] {
+        SwitchToCurrent(queue.Get(), &continued_inline);
+        EXPECT_TRUE(continued_inline);
+      },
+      RTC_FROM_HERE);
+}
+
+DetachedTask WaitOnCurrent(TimeDelta delay,
+                           TaskQueueBase* queue,
+                           int64_t* waited_ms,
+                           rtc::Event* done) {
+  int64_t start_ms = rtc::TimeMillis();
+  co_await ResumeAfter(delay);
+  EXPECT_TRUE(queue->IsCurrent());
+  *waited_ms = rtc::TimeMillis() - start_ms;
+  done->Set();
+}
+
+TEST(CoroutinesTest, ResumesAfterDelay) {
+  TaskQueueForTest queue("queue");
+  int64_t waited_ms = 0;
+  rtc::Event done;
+  queue.PostTask([&] {
+    WaitOnCurrent(TimeDelta::Millis(50), queue.Get(), &waited_ms, &done);
+  });
+  ASSERT_TRUE(done.Wait(1000));
+  EXPECT_GE(waited_ms, 50);
+}
+
+DetachedTask RunChainedOperation(rtc::OperationsChain* chain,
+                                 int id,
+                                 std::vector<int>* started,
+                                 std::function<void()>* complete) {
+  std::function<void()> done = co_await ChainedOperation(chain);
+  started->push_back(id);
+  *complete = std::move(done);
+}
+
+TEST(CoroutinesTest, RunsChainedOperationsOneAtATime) {
+  rtc::scoped_refptr<rtc::OperationsChain> chain =
+      rtc::OperationsChain::Create();
+  std::vector<int> started;
+  std::function<void()> complete_first;
+  std::function<void()> complete_second;
+
+  // The chain is empty, so the first operation starts inline.
+  RunChainedOperation(chain.get(), 1, &started, &complete_first);
+  EXPECT_EQ(started, std::vector<int>{1});
+  RunChainedOperation(chain.get(), 2, &started, &complete_second);
+  EXPECT_EQ(started, std::vector<int>{1});
+
+  complete_first();
+  EXPECT_EQ(started, (std::vector<int>{1, 2}));
+  complete_second();
+  EXPECT_TRUE(chain->IsEmpty());
+}
+
+// Keeps the tasks posted to it without running them.
+class NeverRunningTaskQueue : public TaskQueueBase {
+ public:
+  void Delete() override { delete this; }
+  void PostTask(std::unique_ptr<QueuedTask> task) override {
+    tasks_.push_back(std::move(task));
+  }
+  void PostDelayedTask(std::unique_ptr<QueuedTask> task,
+                       uint32_t /*milliseconds*/) override {
+    tasks_.push_back(std::move(task));
+  }
+
+ private:
+  std::vector<std::unique_ptr<QueuedTask>> tasks_;
+};
+
+struct SetOnDestruction {
+  ~SetOnDestruction() { *destroyed = true; }
+  bool* destroyed;
+};
+
+DetachedTask SwitchAndSetOnDestruction(TaskQueueBase* queue, bool* destroyed) {
+  SetOnDestruction local{destroyed};
+  co_await SwitchToTaskQueue(queue);
+  ADD_FAILURE() << "Resumed on a task queue that doesn't run tasks.";
+}
+
+TEST(CoroutinesTest, DestroysCoroutineSuspendedOnDeletedTaskQueue) {
+  TaskQueueBase* queue = new NeverRunningTaskQueue();
+  bool destroyed = false;
+  SwitchAndSetOnDestruction(queue, &destroyed);
+  EXPECT_FALSE(destroyed);
+  queue->Delete();
+  EXPECT_TRUE(destroyed);
+}
+
+}  // namespace
+}  // namespace webrtc
+
+#endif  // RTC_HAS_COROUTINES
@@ -0,0 +1,191 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_utils/task_memory_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <vector>
+
+#include "absl/base/attributes.h"
+#include "absl/base/config.h"
+#include "rtc_base/sanitizer.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+// Recycled blocks would hide use-after-free bugs from the sanitizers, and the
+// per thread caches need thread_local.
+#if defined(ABSL_HAVE_THREAD_LOCAL) && !RTC_HAS_ASAN && !RTC_HAS_MSAN
+#define RTC_TASK_MEMORY_POOL 1
+#else
+#define RTC_TASK_MEMORY_POOL 0
+#endif
+
+namespace webrtc {
+namespace {
+
+// Block sizes: one for closures capturing a few pointers, one for typical
+// closures, and one for closures capturing small objects by value.
+constexpr size_t kSizeClasses[] = {64, 128, 256};
+constexpr int kNumSizeClasses = sizeof(kSizeClasses) / sizeof(kSizeClasses[0]);
+// Blocks a thread keeps per size class before returning a batch to the depot.
+// A thread that mostly runs tasks frees more than it allocates, and a thread
+// that mostly posts does the opposite, so blocks move in batches.
+constexpr size_t kThreadCacheSize = 128;
+// Blocks moved between a thread cache and the depot at a time.
+constexpr size_t kTransferBatchSize = kThreadCacheSize / 2;
+// Blocks the depot keeps per size class; any more are freed.
+constexpr size_t kMaxDepotSize = 4096;
+
+std::atomic<int64_t> pool_hits{0};
+std::atomic<int64_t> pool_misses{0};
+std::atomic<int64_t> pool_unpooled{0};
+
+#if RTC_TASK_MEMORY_POOL
+
+// Returns the smallest size class that fits `size`, or -1 if none does.
+int SizeClassFor(size_t size) {
+  for (int i = 0; i < kNumSizeClasses; ++i) {
+    if (size <= kSizeClasses[i]) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+class Depot {
+ public:
+  // Moves up to `count` blocks of `size_class` to `blocks` and returns how
+  // many were moved.
+  size_t Take(int size_class, void** blocks, size_t count) {
+    MutexLock lock(&mutex_);
+    std::vector<void*>& pool = pools_[size_class];
+    count = std::min(count, pool.size());
+    std::copy(pool.end() - count, pool.end(), blocks);
+    pool.resize(pool.size() - count);
+    return count;
+  }
+
+  // Takes ownership of `count` blocks of `size_class`.
+  void Give(int size_class, void* const* blocks, size_t count) {
+    size_t kept;
+    {
+      MutexLock lock(&mutex_);
+      std::vector<void*>& pool = pools_[size_class];
+      kept = std::min(count, kMaxDepotSize - pool.size());
+      pool.insert(pool.end(), blocks, blocks + kept);
+    }
+    for (size_t i = kept; i < count; ++i) {
+      ::operator delete(blocks[i]);
+    }
+  }
+
+ private:
+  Mutex mutex_;
+  std::vector<void*> pools_[kNumSizeClasses] RTC_GUARDED_BY(mutex_);
+};
+
+Depot& GetDepot() {
+  static Depot* const depot = new Depot();
+  return *depot;
+}
+
+struct ThreadCache {
+  constexpr ThreadCache() = default;
+  ~ThreadCache();
+
+  void* blocks[kNumSizeClasses][kThreadCacheSize] = {};
+  size_t counts[kNumSizeClasses] = {};
+};
+
+ABSL_CONST_INIT thread_local ThreadCache thread_cache;
+// Set once `thread_cache` is destroyed at thread exit; memory freed after
+// that goes straight to the depot.
+ABSL_CONST_INIT thread_local bool thread_cache_destroyed = false;
+
+ThreadCache::~ThreadCache() {
+  for (int i = 0; i < kNumSizeClasses; ++i) {
+    GetDepot().Give(i, blocks[i], counts[i]);
+    counts[i] = 0;
+  }
+  thread_cache_destroyed = true;
+}
+
+#endif  // RTC_TASK_MEMORY_POOL
+
+}  // namespace
+
+void* AllocateTaskMemory(size_t size) {
+#if RTC_TASK_MEMORY_POOL
+  const int size_class = SizeClassFor(size);
+  if (size_class >= 0) {
+    void* block = nullptr;
+    if (thread_cache_destroyed) {
+      GetDepot().Take(size_class, &block, 1);
+    } else {
+      ThreadCache& cache = thread_cache;
+      size_t& count = cache.counts[size_class];
+      if (count == 0) {
+        count = GetDepot().Take(size_class, cache.blocks[size_class],
+                                kTransferBatchSize);
+      }
+      if (count > 0) {
+        block = cache.blocks[size_class][--count];
+      }
+    }
+    if (block) {
+      pool_hits.fetch_add(1, std::memory_order_relaxed);
+      return block;
+    }
+    // Allocated with the size of its class, to be recycled for any size
+    // that fits it.
+    pool_misses.fetch_add(1, std::memory_order_relaxed);
+    return ::operator new(kSizeClasses[size_class]);
+  }
+#endif
+  pool_unpooled.fetch_add(1, std::memory_order_relaxed);
+  return ::operator new(size);
+}
+
+void FreeTaskMemory(void* ptr, size_t size) {
+  if (ptr == nullptr) {
+    return;
+  }
+#if RTC_TASK_MEMORY_POOL
+  const int size_class = SizeClassFor(size);
+  if (size_class >= 0) {
+    if (thread_cache_destroyed) {
+      GetDepot().Give(size_class, &ptr, 1);
+      return;
+    }
+    ThreadCache& cache = thread_cache;
+    size_t& count = cache.counts[size_class];
+    if (count == kThreadCacheSize) {
+      count -= kTransferBatchSize;
+      GetDepot().Give(size_class, &cache.blocks[size_class][count],
+                      kTransferBatchSize);
+    }
+    cache.blocks[size_class][count++] = ptr;
+    return;
+  }
+#endif
+  ::operator delete(ptr);
+}
+
+TaskMemoryPoolStats GetTaskMemoryPoolStats() {
+  TaskMemoryPoolStats stats;
+  stats.hits = pool_hits.load(std::memory_order_relaxed);
+  stats.misses = pool_misses.load(std::memory_order_relaxed);
+  stats.unpooled = pool_unpooled.load(std::memory_order_relaxed);
+  return stats;
+}
+
+}  // namespace webrtc
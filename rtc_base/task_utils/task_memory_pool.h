@@ -0,0 +1,63 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_TASK_UTILS_TASK_MEMORY_POOL_H_
+#define RTC_BASE_TASK_UTILS_TASK_MEMORY_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <new>
+
+#include "rtc_base/system/rtc_export.h"
+
+namespace webrtc {
+
+// Memory for the small objects that are created for every posted task, such
+// as the QueuedTask that wraps a closure, and destroyed when it has run.
+// Blocks of a few size classes are recycled through per thread caches and a
+// shared depot, so that once warmed up posting a task doesn't allocate, even
+// though tasks are typically created on one thread and destroyed on another.
+// Larger objects are allocated with the global operator new.
+RTC_EXPORT void* AllocateTaskMemory(size_t size);
+// Frees memory returned by AllocateTaskMemory(), of the same `size`.
+RTC_EXPORT void FreeTaskMemory(void* ptr, size_t size);
+
+struct TaskMemoryPoolStats {
+  // Allocations that got a recycled block.
+  int64_t hits = 0;
+  // Allocations that fit a size class but found no block to recycle.
+  int64_t misses = 0;
+  // Allocations too large for any size class.
+  int64_t unpooled = 0;
+};
+RTC_EXPORT TaskMemoryPoolStats GetTaskMemoryPoolStats();
+
+// Inherit from this to allocate objects of the class, and of classes derived
+// from it, with AllocateTaskMemory(). The class must have a virtual destructor
+// if objects are deleted through a pointer to a base class. Over-aligned
+// classes are allocated with the global operator new.
+class TaskMemoryPooled {
+ public:
+  static void* operator new(size_t size) { return AllocateTaskMemory(size); }
+  static void operator delete(void* ptr, size_t size) {
+    FreeTaskMemory(ptr, size);
+  }
+  static void* operator new(size_t size, std::align_val_t alignment) {
+    return ::operator new(size, alignment);
+  }
+  static void operator delete(void* ptr, std::align_val_t alignment) {
+    ::operator delete(ptr, alignment);
+  }
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_TASK_UTILS_TASK_MEMORY_POOL_H_
@@ -0,0 +1,75 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_utils/task_memory_pool.h"
+
+#include <memory>
+#include <vector>
+
+#include "absl/base/config.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/sanitizer.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+struct SmallObject : public TaskMemoryPooled {
+  char data[40];
+};
+
+struct LargeObject : public TaskMemoryPooled {
+  char data[1000];
+};
+
+TEST(TaskMemoryPoolTest, CountsEveryAllocation) {
+  const TaskMemoryPoolStats before = GetTaskMemoryPoolStats();
+  delete new SmallObject();
+  delete new LargeObject();
+  const TaskMemoryPoolStats after = GetTaskMemoryPoolStats();
+  EXPECT_EQ(before.hits + before.misses + before.unpooled + 2,
+            after.hits + after.misses + after.unpooled);
+  EXPECT_EQ(before.unpooled + 1, after.unpooled);
+}
+
+#if defined(ABSL_HAVE_THREAD_LOCAL) && !RTC_HAS_ASAN && !RTC_HAS_MSAN
+TEST(TaskMemoryPoolTest, RecyclesFreedMemory) {
+  SmallObject* object = new SmallObject();
+  void* freed = object;
+  delete object;
+  const TaskMemoryPoolStats before = GetTaskMemoryPoolStats();
+  std::unique_ptr<SmallObject> recycled(new SmallObject());
+  const TaskMemoryPoolStats after = GetTaskMemoryPoolStats();
+  EXPECT_EQ(freed, recycled.get());
+  EXPECT_EQ(before.hits + 1, after.hits);
+}
+
+TEST(TaskMemoryPoolTest, RecyclesMemoryFreedOnAnotherThread) {
+  std::vector<std::unique_ptr<SmallObject>> objects;
+  for (int i = 0; i < 200; ++i) {
+    objects.emplace_back(new SmallObject());
+  }
+  // Like tasks that are run on a task queue, the objects are freed on
+  // another thread, whose cache spills to the shared depot when it fills up
+  // and hands the rest over when the thread exits.
+  rtc::PlatformThread::SpawnJoinable([&objects] { objects.clear(); },
+                                     "releaser")
+      .Finalize();
+  const TaskMemoryPoolStats before = GetTaskMemoryPoolStats();
+  for (int i = 0; i < 200; ++i) {
+    objects.emplace_back(new SmallObject());
+  }
+  const TaskMemoryPoolStats after = GetTaskMemoryPoolStats();
+  EXPECT_EQ(before.hits + 200, after.hits);
+}
+#endif
+
+}  // namespace
+}  // namespace webrtc
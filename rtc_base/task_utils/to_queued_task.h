@@ -17,12 +17,15 @@
 
 #include "api/task_queue/queued_task.h"
 #include "rtc_base/task_utils/pending_task_safety_flag.h"
+#include "rtc_base/task_utils/task_memory_pool.h"
 
 namespace webrtc {
 namespace webrtc_new_closure_impl {
-// Simple implementation of QueuedTask for use with lambdas.
+// Simple implementation of QueuedTask for use with lambdas. The closure is
+// stored inline, and tasks with small closures are allocated from the task
+// memory pool, so that posting them doesn't allocate once the pool is warm.
 template <typename Closure>
-class ClosureTask : public QueuedTask {
+class ClosureTask : public QueuedTask, public TaskMemoryPooled {
  public:
   explicit ClosureTask(Closure&& closure)
       : closure_(std::forward<Closure>(closure)) {}
@@ -37,7 +40,7 @@ class ClosureTask : public QueuedTask {
 };
 
 template <typename Closure>
-class SafetyClosureTask : public QueuedTask {
+class SafetyClosureTask : public QueuedTask, public TaskMemoryPooled {
  public:
   explicit SafetyClosureTask(rtc::scoped_refptr<PendingTaskSafetyFlag> safety,
                              Closure&& closure)
@@ -37,6 +37,7 @@
 #include "rtc_base/internal/default_socket_server.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/null_socket_server.h"
+#include "rtc_base/task_utils/task_memory_pool.h"
 #include "rtc_base/task_utils/to_queued_task.h"
 #include "rtc_base/time_utils.h"
 #include "rtc_base/trace_event.h"
@@ -86,6 +87,17 @@ class MessageHandlerWithTask final : public MessageHandler {
   RTC_DISALLOW_COPY_AND_ASSIGN(MessageHandlerWithTask);
 };
 
+// The MessageData of a webrtc::QueuedTask posted to a Thread, allocated from
+// the task memory pool.
+class QueuedTaskData final : public MessageData,
+                             public webrtc::TaskMemoryPooled {
+ public:
+  explicit QueuedTaskData(std::unique_ptr<webrtc::QueuedTask> task)
+      : task(std::move(task)) {}
+
+  std::unique_ptr<webrtc::QueuedTask> task;
+};
+
 class RTC_SCOPED_LOCKABLE MarkProcessingCritScope {
  public:
   MarkProcessingCritScope(const RecursiveCriticalSection* cs,
@@ -409,6 +421,7 @@ Thread::Thread(std::unique_ptr<SocketServer> ss, bool do_init)
 Thread::~Thread() {
   Stop();
   DoDestroy();
+  timer_wheel_.reset();
 }
 
 void Thread::DoInit() {
@@ -444,6 +457,53 @@ void Thread::WakeUpSocketServer() {
   ss_->WakeUp();
 }
 
+void Thread::WakeUpSocketServerIfIdle() {
+  if (!awake_.exchange(true)) {
+    ss_->WakeUp();
+  }
+}
+
+void Thread::PushIncomingMessage(IncomingMessage* message) {
+  // Counted before being pushed, so that the count never underflows when the
+  // message is drained before being counted.
+  incoming_messages_count_.fetch_add(1, std::memory_order_relaxed);
+  message->next = incoming_messages_.load(std::memory_order_relaxed);
+  while (!incoming_messages_.compare_exchange_weak(message->next, message)) {
+  }
+}
+
+void Thread::DrainIncomingMessages() {
+  IncomingMessage* head = incoming_messages_.exchange(nullptr);
+  // Reverse the stack, to process the messages in the order they were posted.
+  IncomingMessage* first = nullptr;
+  size_t count = 0;
+  while (head != nullptr) {
+    IncomingMessage* next = head->next;
+    head->next = first;
+    first = head;
+    head = next;
+    ++count;
+  }
+  incoming_messages_count_.fetch_sub(count, std::memory_order_relaxed);
+
+  while (first != nullptr) {
+    std::unique_ptr<IncomingMessage> message(first);
+    first = first->next;
+    if (!message->delayed) {
+      messages_.push_back(message->msg);
+      continue;
+    }
+    delayed_messages_.push(DelayedMessage(message->delay_ms,
+                                          message->run_time_ms,
+                                          delayed_next_num_, message->msg));
+    // If this message queue processes 1 message every millisecond for 50 days,
+    // we will wrap this number.  Even then, only messages with identical times
+    // will be misordered, and then only briefly.  This is probably ok.
+    ++delayed_next_num_;
+    RTC_DCHECK_NE(0, delayed_next_num_);
+  }
+}
+
 void Thread::Quit() {
   AtomicOps::ReleaseStore(&stop_, 1);
   WakeUpSocketServer();
@@ -488,26 +548,27 @@ bool Thread::Get(Message* pmsg, int cmsWait, bool process_io) {
   while (true) {
     // Check for posted events
     int64_t cmsDelayNext = kForever;
-    bool first_pass = true;
     while (true) {
       // All queue operations need to be locked, but nothing else in this loop
       // (specifically handling disposed message) can happen inside the crit.
       // Otherwise, disposed MessageHandlers will cause deadlocks.
       {
         CritScope cs(&crit_);
-        // On the first pass, check for delayed messages that have been
-        // triggered and calculate the next trigger time.
-        if (first_pass) {
-          first_pass = false;
-          while (!delayed_messages_.empty()) {
-            if (msCurrent < delayed_messages_.top().run_time_ms_) {
-              cmsDelayNext =
-                  TimeDiff(delayed_messages_.top().run_time_ms_, msCurrent);
-              break;
-            }
-            messages_.push_back(delayed_messages_.top().msg_);
-            delayed_messages_.pop();
+        DrainIncomingMessages();
+        // Check for delayed messages that have been triggered and calculate
+        // the next trigger time. This is done on every pass, as delayed
+        // messages posted since the previous pass are only now in the queue.
+        cmsDelayNext = kForever;
+        while (!delayed_messages_.empty()) {
+          if (msCurrent < delayed_messages_.top().run_time_ms_) {
+            cmsDelayNext =
+                TimeDiff(delayed_messages_.top().run_time_ms_, msCurrent);
+            break;
           }
+          messages_.push_back(delayed_messages_.top().msg_);
+          messages_.back().ready_time_us =
+              delayed_messages_.top().run_time_ms_ * kNumMicrosecsPerMillisec;
+          delayed_messages_.pop();
         }
         // Pull a message off the message queue, if available.
         if (messages_.empty()) {
@@ -531,6 +592,16 @@ bool Thread::Get(Message* pmsg, int cmsWait, bool process_io) {
     if (IsQuitting())
       break;
 
+    // Announce that the thread may go idle, so that the next posted message
+    // wakes up the socket server, and check for messages that were posted
+    // before that.
+    awake_.store(false);
+    if (incoming_messages_.load() != nullptr) {
+      awake_.store(true);
+      msCurrent = TimeMillis();
+      continue;
+    }
+
     // Which is shorter, the delay wait or the asked wait?
 
     int64_t cmsNext;
@@ -547,6 +618,8 @@ bool Thread::Get(Message* pmsg, int cmsWait, bool process_io) {
       if (!ss_->Wait(static_cast<int>(cmsNext), process_io))
         return false;
     }
+    // Posted messages are checked for before waiting again.
+    awake_.store(true);
 
     // If the specified timeout expired, return
 
@@ -571,20 +644,16 @@ void Thread::Post(const Location& posted_from,
     return;
   }
 
-  // Keep thread safe
-  // Add the message to the end of the queue
-  // Signal for the multiplexer to return
-
-  {
-    CritScope cs(&crit_);
-    Message msg;
-    msg.posted_from = posted_from;
-    msg.phandler = phandler;
-    msg.message_id = id;
-    msg.pdata = pdata;
-    messages_.push_back(msg);
-  }
-  WakeUpSocketServer();
+  // Add the message to the incoming messages, without taking any lock, and
+  // signal for the multiplexer to return if the thread is idle.
+  auto* message = new IncomingMessage();
+  message->msg.posted_from = posted_from;
+  message->msg.phandler = phandler;
+  message->msg.message_id = id;
+  message->msg.pdata = pdata;
+  message->msg.ready_time_us = webrtc::TaskQueueMetrics::Now();
+  PushIncomingMessage(message);
+  WakeUpSocketServerIfIdle();
 }
 
 void Thread::PostDelayed(const Location& posted_from,
@@ -616,30 +685,24 @@ void Thread::DoDelayPost(const Location& posted_from,
     return;
   }
 
-  // Keep thread safe
-  // Add to the priority queue. Gets sorted soonest first.
-  // Signal for the multiplexer to return.
-
-  {
-    CritScope cs(&crit_);
-    Message msg;
-    msg.posted_from = posted_from;
-    msg.phandler = phandler;
-    msg.message_id = id;
-    msg.pdata = pdata;
-    DelayedMessage delayed(delay_ms, run_at_ms, delayed_next_num_, msg);
-    delayed_messages_.push(delayed);
-    // If this message queue processes 1 message every millisecond for 50 days,
-    // we will wrap this number.  Even then, only messages with identical times
-    // will be misordered, and then only briefly.  This is probably ok.
-    ++delayed_next_num_;
-    RTC_DCHECK_NE(0, delayed_next_num_);
-  }
-  WakeUpSocketServer();
+  // Add the message to the incoming messages, from which the thread moves it
+  // to the priority queue, which gets sorted soonest first. Signal for the
+  // multiplexer to return if the thread is idle.
+  auto* message = new IncomingMessage();
+  message->msg.posted_from = posted_from;
+  message->msg.phandler = phandler;
+  message->msg.message_id = id;
+  message->msg.pdata = pdata;
+  message->delayed = true;
+  message->delay_ms = delay_ms;
+  message->run_time_ms = run_at_ms;
+  PushIncomingMessage(message);
+  WakeUpSocketServerIfIdle();
 }
 
 int Thread::GetDelay() {
   CritScope cs(&crit_);
+  DrainIncomingMessages();
 
   if (!messages_.empty())
     return 0;
@@ -659,6 +722,8 @@ void Thread::ClearInternal(MessageHandler* phandler,
                            MessageList* removed) {
   // Remove messages with phandler
 
+  DrainIncomingMessages();
+
   if (fPeekKeep_ && msgPeek_.Match(phandler, id)) {
     if (removed) {
       removed->push_back(msgPeek_);
@@ -707,9 +772,14 @@ void Thread::Dispatch(Message* pmsg) {
                pmsg->posted_from.file_name(), "src_func",
                pmsg->posted_from.function_name());
   RTC_DCHECK_RUN_ON(this);
+  const int64_t start_time_us =
+      metrics_.OnTaskStart(pmsg->ready_time_us != 0
+                               ? pmsg->ready_time_us
+                               : webrtc::TaskQueueMetrics::Now());
   int64_t start_time = TimeMillis();
   pmsg->phandler->OnMessage(pmsg);
   int64_t end_time = TimeMillis();
+  metrics_.OnTaskEnd(start_time_us);
   int64_t diff = TimeDiff(end_time, start_time);
   if (diff >= dispatch_warning_ms_) {
     RTC_LOG(LS_INFO) << "Message to " << name() << " took " << diff
@@ -766,6 +836,7 @@ bool Thread::SetName(const std::string& name, const void* obj) {
     snprintf(buf, sizeof(buf), " 0x%p", obj);
     name_ += buf;
   }
+  metrics_.SetName(name_);
   return true;
 }
 
@@ -1031,8 +1102,8 @@ void Thread::ClearCurrentTaskQueue() {
 
 void Thread::QueuedTaskHandler::OnMessage(Message* msg) {
   RTC_DCHECK(msg);
-  auto* data = static_cast<ScopedMessageData<webrtc::QueuedTask>*>(msg->pdata);
-  std::unique_ptr<webrtc::QueuedTask> task(data->Release());
+  auto* data = static_cast<QueuedTaskData*>(msg->pdata);
+  std::unique_ptr<webrtc::QueuedTask> task = std::move(data->task);
   // Thread expects handler to own Message::pdata when OnMessage is called
   // Since MessageData is no longer needed, delete it.
   delete data;
@@ -1101,17 +1172,16 @@ bool Thread::IsInvokeToThreadAllowed(rtc::Thread* target) {
 void Thread::PostTask(std::unique_ptr<webrtc::QueuedTask> task) {
   // Though Post takes MessageData by raw pointer (last parameter), it still
   // takes it with ownership.
-  Post(RTC_FROM_HERE, &queued_task_handler_,
-       /*id=*/0, new ScopedMessageData<webrtc::QueuedTask>(std::move(task)));
+  Post(RTC_FROM_HERE, &queued_task_handler_, /*id=*/0,
+       new QueuedTaskData(std::move(task)));
 }
 
 void Thread::PostDelayedTask(std::unique_ptr<webrtc::QueuedTask> task,
                              uint32_t milliseconds) {
   // Though PostDelayed takes MessageData by raw pointer (last parameter),
   // it still takes it with ownership.
-  PostDelayed(RTC_FROM_HERE, milliseconds, &queued_task_handler_,
-              /*id=*/0,
-              new ScopedMessageData<webrtc::QueuedTask>(std::move(task)));
+  PostDelayed(RTC_FROM_HERE, milliseconds, &queued_task_handler_, /*id=*/0,
+              new QueuedTaskData(std::move(task)));
 }
 
 void Thread::Delete() {
@@ -1156,6 +1226,14 @@ bool Thread::ProcessMessages(int cmsLoop) {
   }
 }
 
+TimerWheel* Thread::timer_wheel() {
+  RTC_DCHECK(IsCurrent());
+  if (!timer_wheel_) {
+    timer_wheel_ = std::make_unique<TimerWheel>(this);
+  }
+  return timer_wheel_.get();
+}
+
 bool Thread::WrapCurrentWithThreadManager(ThreadManager* thread_manager,
                                           bool need_synchronize_access) {
   RTC_DCHECK(!IsRunning());
@@ -13,6 +13,8 @@
 
 #include <stdint.h>
 
+#include <atomic>
+#include <deque>
 #include <list>
 #include <map>
 #include <memory>
@@ -36,8 +38,11 @@
 #include "rtc_base/platform_thread_types.h"
 #include "rtc_base/socket_server.h"
 #include "rtc_base/system/rtc_export.h"
+#include "rtc_base/task_queue_metrics.h"
+#include "rtc_base/task_utils/task_memory_pool.h"
 #include "rtc_base/thread_annotations.h"
 #include "rtc_base/thread_message.h"
+#include "rtc_base/timer_wheel.h"
 
 #if defined(WEBRTC_WIN)
 #include "rtc_base/win32.h"
@@ -84,7 +89,8 @@ class MessageLikeTask : public MessageData {
 };
 
 template <class FunctorT>
-class MessageWithFunctor final : public MessageLikeTask {
+class MessageWithFunctor final : public MessageLikeTask,
+                                 public webrtc::TaskMemoryPooled {
  public:
   explicit MessageWithFunctor(FunctorT&& functor)
       : functor_(std::forward<FunctorT>(functor)) {}
@@ -326,7 +332,9 @@ class RTC_LOCKABLE RTC_EXPORT Thread : public webrtc::TaskQueueBase {
   bool empty() const { return size() == 0u; }
   size_t size() const {
     CritScope cs(&crit_);
-    return messages_.size() + delayed_messages_.size() + (fPeekKeep_ ? 1u : 0u);
+    return messages_.size() + delayed_messages_.size() +
+           incoming_messages_count_.load(std::memory_order_relaxed) +
+           (fPeekKeep_ ? 1u : 0u);
   }
 
   // Internally posts a message which causes the doomed object to be deleted
@@ -475,6 +483,11 @@ class RTC_LOCKABLE RTC_EXPORT Thread : public webrtc::TaskQueueBase {
   //  2) Stop() is called (returns false)
   bool ProcessMessages(int cms);
 
+  // Returns the timer wheel running on this thread, for code that keeps many
+  // timers that are mostly rescheduled or cancelled before they fire. Must
+  // be called on this thread.
+  TimerWheel* timer_wheel();
+
   // Returns true if this is a thread that we created using the standard
   // constructor, false if it was created by a call to
   // ThreadManager::WrapCurrentThread().  The main thread of an application
@@ -576,6 +589,11 @@ class RTC_LOCKABLE RTC_EXPORT Thread : public webrtc::TaskQueueBase {
 
   void WakeUpSocketServer();
 
+  // Wakes up the socket server, unless the thread is already known to check
+  // for posted messages before it next waits. Only the first message posted
+  // after the thread has gone idle signals the socket server.
+  void WakeUpSocketServerIfIdle();
+
   // Same as WrapCurrent except that it never fails as it does not try to
   // acquire the synchronization access of the thread. The caller should never
   // call Stop() or Join() on this thread.
@@ -599,6 +617,23 @@ class RTC_LOCKABLE RTC_EXPORT Thread : public webrtc::TaskQueueBase {
     void OnMessage(Message* msg) override;
   };
 
+  // A posted message, linked into `incoming_messages_` until the thread moves
+  // it into `messages_` or, if delayed, into `delayed_messages_`.
+  struct IncomingMessage : public webrtc::TaskMemoryPooled {
+    IncomingMessage* next = nullptr;
+    Message msg;
+    bool delayed = false;
+    int64_t delay_ms = 0;
+    int64_t run_time_ms = 0;
+  };
+
+  // Adds `message` to `incoming_messages_`, without taking any lock.
+  void PushIncomingMessage(IncomingMessage* message);
+
+  // Moves all messages in `incoming_messages_`, in the order they were posted,
+  // into `messages_` and `delayed_messages_`.
+  void DrainIncomingMessages() RTC_EXCLUSIVE_LOCKS_REQUIRED(&crit_);
+
   // Sets the per-thread allow-blocking-calls flag and returns the previous
   // value. Must be called on this thread.
   bool SetAllowBlockingCalls(bool allow);
@@ -635,9 +670,19 @@ class RTC_LOCKABLE RTC_EXPORT Thread : public webrtc::TaskQueueBase {
 
   bool fPeekKeep_;
   Message msgPeek_;
-  MessageList messages_ RTC_GUARDED_BY(crit_);
+  std::deque<Message> messages_ RTC_GUARDED_BY(crit_);
   PriorityQueue delayed_messages_ RTC_GUARDED_BY(crit_);
   uint32_t delayed_next_num_ RTC_GUARDED_BY(crit_);
+  // Messages posted since the queues above were last drained, as an intrusive
+  // lock-free stack with the most recently posted message first. Posting
+  // threads only push to it, so they never contend on `crit_`, and the whole
+  // stack is taken at once, while holding `crit_`, to be drained.
+  std::atomic<IncomingMessage*> incoming_messages_{nullptr};
+  // An upper bound of the number of messages in `incoming_messages_`.
+  std::atomic<size_t> incoming_messages_count_{0};
+  // True while the thread will check `incoming_messages_` before it next waits
+  // for I/O, so that posting threads don't need to wake up the socket server.
+  std::atomic<bool> awake_{false};
 #if RTC_DCHECK_IS_ON
   uint32_t blocking_call_count_ RTC_GUARDED_BY(this) = 0;
   uint32_t could_be_blocking_call_count_ RTC_GUARDED_BY(this) = 0;
@@ -682,10 +727,16 @@ class RTC_LOCKABLE RTC_EXPORT Thread : public webrtc::TaskQueueBase {
   std::unique_ptr<TaskQueueBase::CurrentTaskQueueSetter>
       task_queue_registration_;
 
+  // Created on first use. Destroyed after the queue is cleared, as its tasks
+  // don't check that it's still alive.
+  std::unique_ptr<TimerWheel> timer_wheel_;
+
   friend class ThreadManager;
 
   int dispatch_warning_ms_ RTC_GUARDED_BY(this) = kSlowDispatchLoggingThreshold;
 
+  webrtc::TaskQueueMetrics metrics_{"Thread"};
+
   RTC_DISALLOW_COPY_AND_ASSIGN(Thread);
 };
 
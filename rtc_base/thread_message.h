@@ -103,6 +103,9 @@ struct Message {
   MessageHandler* phandler;
   uint32_t message_id;
   MessageData* pdata;
+  // When the message was posted or, if delayed, became due, in microseconds.
+  // 0 if unknown.
+  int64_t ready_time_us = 0;
 };
 
 typedef std::list<Message> MessageList;
@@ -11,6 +11,7 @@
 #include "rtc_base/thread.h"
 
 #include <memory>
+#include <vector>
 
 #include "api/task_queue/task_queue_factory.h"
 #include "api/task_queue/task_queue_test.h"
@@ -1067,6 +1068,37 @@ TEST(ThreadPostTaskTest, InvokesInPostedOrder) {
   fourth.Wait(Event::kForever);
 }
 
+TEST(ThreadPostTaskTest, InvokesInPostedOrderWhenPostedFromManyThreads) {
+  constexpr int kPostingThreads = 4;
+  constexpr int kTasksPerThread = 1000;
+  std::unique_ptr<rtc::Thread> background_thread(rtc::Thread::Create());
+  background_thread->Start();
+
+  // Only accessed on `background_thread`.
+  std::vector<int> next_task(kPostingThreads, 0);
+  int tasks_in_order = 0;
+  Event all_tasks_run;
+  std::vector<std::unique_ptr<rtc::Thread>> posting_threads;
+  for (int i = 0; i < kPostingThreads; ++i) {
+    posting_threads.push_back(rtc::Thread::Create());
+    posting_threads.back()->Start();
+    posting_threads.back()->PostTask(RTC_FROM_HERE, [&, i] {
+      for (int task = 0; task < kTasksPerThread; ++task) {
+        background_thread->PostTask(RTC_FROM_HERE, [&, i, task] {
+          if (next_task[i]++ == task) {
+            ++tasks_in_order;
+          }
+          if (tasks_in_order == kPostingThreads * kTasksPerThread) {
+            all_tasks_run.Set();
+          }
+        });
+      }
+    });
+  }
+
+  EXPECT_TRUE(all_tasks_run.Wait(10000));
+}
+
 TEST(ThreadPostDelayedTaskTest, InvokesAsynchronously) {
   std::unique_ptr<rtc::Thread> background_thread(rtc::Thread::Create());
   background_thread->Start();
@@ -0,0 +1,236 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/timer_wheel.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "absl/numeric/bits.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/numerics/safe_minmax.h"
+#include "rtc_base/task_utils/to_queued_task.h"
+#include "rtc_base/time_utils.h"
+
+namespace rtc {
+
+namespace {
+
+// Longer delays are cut short, so that expiry times stay within reach of the
+// top level of the wheel. This is more than 34 years.
+constexpr int64_t kMaxDelayMs = int64_t{1} << 40;
+
+// Bound on the delay of the posted task, which takes 32 bits. The task posts
+// the next one if no timer was due yet.
+constexpr int64_t kMaxTaskDelayMs = int64_t{1} << 30;
+
+}  // namespace
+
+TimerWheel::Timer::Timer(TimerWheel* wheel, std::function<void()> callback)
+    : wheel_(wheel), callback_(std::move(callback)) {
+  RTC_DCHECK(wheel_);
+  RTC_DCHECK(callback_);
+}
+
+TimerWheel::Timer::~Timer() {
+  Cancel();
+}
+
+void TimerWheel::Timer::Schedule(int64_t delay_ms) {
+  wheel_->Schedule(this, delay_ms);
+}
+
+void TimerWheel::Timer::Cancel() {
+  if (scheduled()) {
+    wheel_->Unlink(this);
+  }
+}
+
+TimerWheel::TimerWheel(webrtc::TaskQueueBase* task_queue)
+    : task_queue_(task_queue), current_ms_(TimeMillis()) {
+  RTC_DCHECK(task_queue_);
+}
+
+TimerWheel::~TimerWheel() {
+  // Leave the timers unscheduled, so that they don't touch the wheel later.
+  for (int level = 0; level < kLevels; ++level) {
+    for (Timer* timer : slots_[level]) {
+      while (timer) {
+        Timer* next = timer->next_;
+        timer->next_ = nullptr;
+        timer->pprev_ = nullptr;
+        timer = next;
+      }
+    }
+  }
+}
+
+void TimerWheel::Schedule(Timer* timer, int64_t delay_ms) {
+  RTC_DCHECK(task_queue_->IsCurrent());
+  RTC_DCHECK_GE(delay_ms, 0);
+  if (timer->scheduled()) {
+    Unlink(timer);
+  }
+  int64_t now_ms = TimeMillis();
+  CatchUp(now_ms);
+  timer->expiry_ms_ = std::max(now_ms + std::min(delay_ms, kMaxDelayMs),
+                               current_ms_ + 1);
+  Insert(timer);
+  ++size_;
+  MaybePostTask();
+}
+
+void TimerWheel::Insert(Timer* timer) {
+  RTC_DCHECK_GE(timer->expiry_ms_, current_ms_);
+  uint64_t differing_bits = static_cast<uint64_t>(timer->expiry_ms_) ^
+                            static_cast<uint64_t>(current_ms_);
+  int level = 0;
+  while (differing_bits >> (kSlotBits * (level + 1))) {
+    ++level;
+  }
+  RTC_DCHECK_LT(level, kLevels);
+  int slot = (timer->expiry_ms_ >> (kSlotBits * level)) & (kSlots - 1);
+
+  Timer** head = &slots_[level][slot];
+  timer->next_ = *head;
+  if (timer->next_) {
+    timer->next_->pprev_ = &timer->next_;
+  }
+  timer->pprev_ = head;
+  *head = timer;
+  timer->level_ = level;
+  timer->slot_ = slot;
+  occupied_[level] |= uint64_t{1} << slot;
+}
+
+void TimerWheel::Unlink(Timer* timer) {
+  RTC_DCHECK(task_queue_->IsCurrent());
+  *timer->pprev_ = timer->next_;
+  if (timer->next_) {
+    timer->next_->pprev_ = timer->pprev_;
+  }
+  if (!slots_[timer->level_][timer->slot_]) {
+    occupied_[timer->level_] &= ~(uint64_t{1} << timer->slot_);
+  }
+  timer->next_ = nullptr;
+  timer->pprev_ = nullptr;
+  --size_;
+}
+
+int64_t TimerWheel::NextEvent(int* level, int* slot) const {
+  // Timers at lower levels are all due before the wheel reaches any slot of
+  // a higher level, and every occupied slot lies ahead of the current time.
+  for (int l = 0; l < kLevels; ++l) {
+    if (occupied_[l]) {
+      int s = absl::countr_zero(occupied_[l]);
+      int shift = kSlotBits * l;
+      uint64_t window = static_cast<uint64_t>(current_ms_) >>
+                        (shift + kSlotBits) << (shift + kSlotBits);
+      *level = l;
+      *slot = s;
+      return static_cast<int64_t>(window |
+                                  (static_cast<uint64_t>(s) << shift));
+    }
+  }
+  return -1;
+}
+
+void TimerWheel::CatchUp(int64_t now_ms) {
+  if (now_ms < current_ms_) {
+    // The clock went back, which happens when tests install a fake clock.
+    // Sort the timers into the wheel again relative to the new time.
+    Timer* timers = nullptr;
+    for (int level = 0; level < kLevels; ++level) {
+      for (Timer*& head : slots_[level]) {
+        while (Timer* timer = head) {
+          head = timer->next_;
+          timer->next_ = timers;
+          timers = timer;
+        }
+      }
+      occupied_[level] = 0;
+    }
+    current_ms_ = now_ms;
+    while (Timer* timer = timers) {
+      timers = timer->next_;
+      Insert(timer);
+    }
+    return;
+  }
+  int level;
+  int slot;
+  int64_t next_ms = NextEvent(&level, &slot);
+  if (next_ms < 0 || next_ms > now_ms) {
+    current_ms_ = now_ms;
+  }
+}
+
+void TimerWheel::Run() {
+  const int64_t now_ms = TimeMillis();
+  CatchUp(now_ms);
+  running_ = true;
+  int level;
+  int slot;
+  int64_t next_ms;
+  while ((next_ms = NextEvent(&level, &slot)) >= 0 && next_ms <= now_ms) {
+    current_ms_ = next_ms;
+    Timer** head = &slots_[level][slot];
+    if (level == 0) {
+      // Every timer here expires now. Callbacks may schedule or cancel
+      // timers, including those still in this slot.
+      while (Timer* timer = *head) {
+        Unlink(timer);
+        timer->callback_();
+      }
+      continue;
+    }
+    Timer* timer = *head;
+    *head = nullptr;
+    occupied_[level] &= ~(uint64_t{1} << slot);
+    while (timer) {
+      Timer* next = timer->next_;
+      Insert(timer);
+      timer = next;
+    }
+  }
+  running_ = false;
+  CatchUp(now_ms);
+}
+
+void TimerWheel::MaybePostTask() {
+  if (running_) {
+    // Run() is followed by a call, when all callbacks are done.
+    return;
+  }
+  int level;
+  int slot;
+  int64_t next_ms = NextEvent(&level, &slot);
+  if (next_ms < 0 || (task_run_ms_ >= 0 && task_run_ms_ <= next_ms)) {
+    return;
+  }
+  // A task posted earlier for a later time finds that it was replaced.
+  task_run_ms_ = next_ms;
+  int64_t delay_ms =
+      rtc::SafeClamp<int64_t>(next_ms - TimeMillis(), 0, kMaxTaskDelayMs);
+  task_queue_->PostDelayedTask(
+      webrtc::ToQueuedTask([this, next_ms] { OnTask(next_ms); }),
+      static_cast<uint32_t>(delay_ms));
+}
+
+void TimerWheel::OnTask(int64_t run_ms) {
+  if (task_run_ms_ != run_ms) {
+    return;
+  }
+  task_run_ms_ = -1;
+  Run();
+  MaybePostTask();
+}
+
+}  // namespace rtc
@@ -0,0 +1,112 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_TIMER_WHEEL_H_
+#define RTC_BASE_TIMER_WHEEL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <functional>
+
+#include "api/task_queue/task_queue_base.h"
+
+namespace rtc {
+
+// A hierarchical timing wheel that runs any number of timers off a single
+// delayed task on a task queue. Scheduling and cancelling a timer are O(1),
+// which suits timers that are mostly rescheduled or cancelled before they
+// fire, such as STUN retransmission timers. Every thread has one, see
+// Thread::timer_wheel().
+//
+// Timers fire in the first wheel run at or after the millisecond they expire.
+// Each of the 8 levels of the wheel has 64 slots. A timer sits at the level of
+// the highest 6 bit group in which its expiry time differs from the current
+// time of the wheel, in the slot given by that group. When the wheel reaches
+// a slot of a higher level, the timers in it move down, so a timer changes
+// level at most 7 times before it fires.
+//
+// The wheel and its timers must only be used on `task_queue`, and the wheel
+// must not outlive it, nor be destroyed while its tasks may still run.
+class TimerWheel {
+ public:
+  class Timer {
+   public:
+    // `callback` is run on the task queue when the timer fires. It may
+    // destroy the timer.
+    Timer(TimerWheel* wheel, std::function<void()> callback);
+    // Cancels the timer. A timer may outlive its wheel, but must not be
+    // scheduled after it is gone.
+    ~Timer();
+
+    Timer(const Timer&) = delete;
+    Timer& operator=(const Timer&) = delete;
+
+    // Schedules the timer `delay_ms` from now, replacing any previous
+    // schedule. Timers scheduled while the wheel runs, or with no delay,
+    // fire a millisecond later at the earliest.
+    void Schedule(int64_t delay_ms);
+    void Cancel();
+    bool scheduled() const { return pprev_ != nullptr; }
+
+   private:
+    friend class TimerWheel;
+
+    TimerWheel* const wheel_;
+    const std::function<void()> callback_;
+    int64_t expiry_ms_ = 0;
+    // Links in the list of the slot, which `pprev_` points into.
+    Timer* next_ = nullptr;
+    Timer** pprev_ = nullptr;
+    uint8_t level_ = 0;
+    uint8_t slot_ = 0;
+  };
+
+  explicit TimerWheel(webrtc::TaskQueueBase* task_queue);
+  ~TimerWheel();
+
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  // Number of scheduled timers.
+  size_t size() const { return size_; }
+
+ private:
+  static constexpr int kSlotBits = 6;
+  static constexpr int kSlots = 1 << kSlotBits;
+  static constexpr int kLevels = 8;
+
+  void Schedule(Timer* timer, int64_t delay_ms);
+  void Insert(Timer* timer);
+  void Unlink(Timer* timer);
+  // Finds the next slot to fire or move down. Returns the time the wheel
+  // reaches it, or -1 if no timer is scheduled.
+  int64_t NextEvent(int* level, int* slot) const;
+  // Moves the current time to `now_ms`, without passing the next event.
+  void CatchUp(int64_t now_ms);
+  // Fires and moves down the timers in all slots the wheel has reached.
+  void Run();
+  void MaybePostTask();
+  void OnTask(int64_t run_ms);
+
+  webrtc::TaskQueueBase* const task_queue_;
+  int64_t current_ms_;
+  Timer* slots_[kLevels][kSlots] = {};
+  // Bit n of `occupied_[level]` is set if `slots_[level][n]` isn't empty.
+  uint64_t occupied_[kLevels] = {};
+  size_t size_ = 0;
+  // Time the posted task runs at, or -1 if none is posted.
+  int64_t task_run_ms_ = -1;
+  bool running_ = false;
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_TIMER_WHEEL_H_
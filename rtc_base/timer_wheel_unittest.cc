@@ -0,0 +1,175 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/timer_wheel.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "rtc_base/fake_clock.h"
+#include "rtc_base/random.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+
+namespace rtc {
+namespace {
+
+class TimerWheelTest : public ::testing::Test {
+ protected:
+  TimerWheelTest() { clock_.SetTime(webrtc::Timestamp::Seconds(1000)); }
+
+  // Advances the clock to `time_ms` and runs the tasks that are due.
+  void AdvanceTo(int64_t time_ms) {
+    clock_.SetTime(webrtc::Timestamp::Millis(time_ms));
+    thread_.ProcessMessages(0);
+  }
+  void AdvanceBy(int64_t delta_ms) { AdvanceTo(TimeMillis() + delta_ms); }
+
+  ScopedFakeClock clock_;
+  AutoThread thread_;
+  TimerWheel wheel_{&thread_};
+};
+
+TEST_F(TimerWheelTest, FiresWhenDue) {
+  int fired = 0;
+  TimerWheel::Timer timer(&wheel_, [&] { ++fired; });
+  timer.Schedule(100);
+  EXPECT_TRUE(timer.scheduled());
+  EXPECT_EQ(1u, wheel_.size());
+
+  AdvanceBy(99);
+  EXPECT_EQ(0, fired);
+  AdvanceBy(1);
+  EXPECT_EQ(1, fired);
+  EXPECT_FALSE(timer.scheduled());
+  EXPECT_EQ(0u, wheel_.size());
+
+  AdvanceBy(1000);
+  EXPECT_EQ(1, fired);
+}
+
+TEST_F(TimerWheelTest, CancelledTimersDontFire) {
+  int fired = 0;
+  TimerWheel::Timer first(&wheel_, [&] { ++fired; });
+  TimerWheel::Timer second(&wheel_, [&] { fired += 10; });
+  first.Schedule(50);
+  second.Schedule(50);
+  first.Cancel();
+  EXPECT_FALSE(first.scheduled());
+  EXPECT_EQ(1u, wheel_.size());
+
+  AdvanceBy(50);
+  EXPECT_EQ(10, fired);
+}
+
+TEST_F(TimerWheelTest, ReschedulingReplacesTheExpiry) {
+  int fired = 0;
+  TimerWheel::Timer timer(&wheel_, [&] { ++fired; });
+  timer.Schedule(5000);
+  timer.Schedule(20);
+  AdvanceBy(20);
+  EXPECT_EQ(1, fired);
+
+  timer.Schedule(20);
+  timer.Schedule(3000);
+  AdvanceBy(2999);
+  EXPECT_EQ(1, fired);
+  AdvanceBy(1);
+  EXPECT_EQ(2, fired);
+}
+
+TEST_F(TimerWheelTest, FiresEachTimerAtItsExpiry) {
+  webrtc::Random random(1234);
+  std::vector<std::unique_ptr<TimerWheel::Timer>> timers;
+  std::multimap<int64_t, int> expected;
+  std::vector<int64_t> fired_at(300, -1);
+  for (int i = 0; i < 300; ++i) {
+    // Spread the delays over all levels that such times reach.
+    int64_t delay_ms = random.Rand(1, 1 << random.Rand(1, 30));
+    timers.push_back(std::make_unique<TimerWheel::Timer>(
+        &wheel_, [&fired_at, i] { fired_at[i] = TimeMillis(); }));
+    timers.back()->Schedule(delay_ms);
+    expected.emplace(TimeMillis() + delay_ms, i);
+  }
+
+  for (const auto& kv : expected) {
+    if (TimeMillis() < kv.first - 1) {
+      AdvanceTo(kv.first - 1);
+      EXPECT_EQ(-1, fired_at[kv.second]);
+    }
+    AdvanceTo(kv.first);
+    EXPECT_EQ(kv.first, fired_at[kv.second]);
+  }
+  EXPECT_EQ(0u, wheel_.size());
+}
+
+TEST_F(TimerWheelTest, CallbacksCanRescheduleAndDestroyTimers) {
+  int repeated = 0;
+  std::unique_ptr<TimerWheel::Timer> repeating;
+  repeating = std::make_unique<TimerWheel::Timer>(&wheel_, [&] {
+    if (++repeated == 3) {
+      repeating.reset();
+    } else {
+      repeating->Schedule(10);
+    }
+  });
+  int fired = 0;
+  TimerWheel::Timer other(&wheel_, [&] { ++fired; });
+  // Whichever of these fires first destroys the other.
+  std::unique_ptr<TimerWheel::Timer> first;
+  std::unique_ptr<TimerWheel::Timer> second;
+  first = std::make_unique<TimerWheel::Timer>(&wheel_, [&] {
+    fired += 10;
+    second.reset();
+  });
+  second = std::make_unique<TimerWheel::Timer>(&wheel_, [&] {
+    fired += 10;
+    first.reset();
+  });
+
+  repeating->Schedule(10);
+  first->Schedule(10);
+  second->Schedule(10);
+  other.Schedule(0);
+
+  AdvanceBy(1);
+  EXPECT_EQ(1, fired);
+  AdvanceBy(9);
+  EXPECT_EQ(1, repeated);
+  EXPECT_EQ(11, fired);
+  EXPECT_NE(!first, !second);
+  AdvanceBy(10);
+  EXPECT_EQ(2, repeated);
+  AdvanceBy(10);
+  EXPECT_EQ(3, repeated);
+  EXPECT_FALSE(repeating);
+  EXPECT_EQ(0u, wheel_.size());
+}
+
+TEST_F(TimerWheelTest, TimersCanOutliveTheWheel) {
+  auto wheel = std::make_unique<TimerWheel>(&thread_);
+  TimerWheel::Timer timer(wheel.get(), [] {});
+  timer.Schedule(100);
+  wheel.reset();
+  EXPECT_FALSE(timer.scheduled());
+}
+
+TEST(ThreadTimerWheelTest, ThreadOwnsAWheel) {
+  AutoThread thread;
+  TimerWheel* wheel = thread.timer_wheel();
+  ASSERT_TRUE(wheel);
+  EXPECT_EQ(wheel, thread.timer_wheel());
+}
+
+}  // namespace
+}  // namespace rtc
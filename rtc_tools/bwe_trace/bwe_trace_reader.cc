@@ -0,0 +1,62 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_tools/bwe_trace/bwe_trace_reader.h"
+
+#include <stdio.h>
+
+#include "rtc_base/byte_buffer.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+
+absl::optional<std::vector<BweTraceRecord>> ParseBweTrace(
+    absl::string_view data) {
+  rtc::ByteBufferReader reader(data.data(), data.size());
+  size_t record_size;
+  if (!DecodeBweTraceHeader(&reader, &record_size)) {
+    RTC_LOG(LS_ERROR) << "Not a BWE trace.";
+    return absl::nullopt;
+  }
+  std::vector<BweTraceRecord> records;
+  records.reserve(reader.Length() / record_size);
+  BweTraceRecord record;
+  while (reader.Length() >= record_size) {
+    if (!DecodeBweTraceRecord(&reader, record_size, &record)) {
+      RTC_LOG(LS_ERROR) << "Invalid record " << records.size() << ".";
+      return absl::nullopt;
+    }
+    records.push_back(record);
+  }
+  if (reader.Length() > 0) {
+    RTC_LOG(LS_WARNING) << "Ignoring truncated record " << records.size()
+                        << ".";
+  }
+  return records;
+}
+
+absl::optional<std::vector<BweTraceRecord>> ReadBweTraceFile(
+    const std::string& file_name) {
+  FILE* file = fopen(file_name.c_str(), "rb");
+  if (!file) {
+    RTC_LOG(LS_ERROR) << "Could not open " << file_name << ".";
+    return absl::nullopt;
+  }
+  std::string data;
+  char buffer[4096];
+  size_t bytes_read;
+  while ((bytes_read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    data.append(buffer, bytes_read);
+  }
+  fclose(file);
+  return ParseBweTrace(data);
+}
+
+}  // namespace webrtc
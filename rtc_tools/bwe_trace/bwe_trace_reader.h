@@ -0,0 +1,35 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_TOOLS_BWE_TRACE_BWE_TRACE_READER_H_
+#define RTC_TOOLS_BWE_TRACE_BWE_TRACE_READER_H_
+
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "modules/congestion_controller/goog_cc/bwe_trace_record.h"
+
+namespace webrtc {
+
+// Parses a trace written by BweTraceRecorder. Returns nullopt if `data` is
+// not a trace. A truncated last record, as left by a writer that didn't
+// finish, is ignored.
+absl::optional<std::vector<BweTraceRecord>> ParseBweTrace(
+    absl::string_view data);
+
+// Reads and parses the trace in `file_name`.
+absl::optional<std::vector<BweTraceRecord>> ReadBweTraceFile(
+    const std::string& file_name);
+
+}  // namespace webrtc
+
+#endif  // RTC_TOOLS_BWE_TRACE_BWE_TRACE_READER_H_
@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_tools/bwe_trace/bwe_trace_reader.h"
+
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+#include "rtc_base/byte_buffer.h"
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace {
+
+std::string CreateTrace(int num_records) {
+  rtc::ByteBufferWriter writer;
+  EncodeBweTraceHeader(&writer);
+  for (int i = 0; i < num_records; ++i) {
+    BweTraceRecord record;
+    record.at_time = Timestamp::Millis(i);
+    record.target_rate = DataRate::KilobitsPerSec(100 + i);
+    EncodeBweTraceRecord(record, &writer);
+  }
+  return std::string(writer.Data(), writer.Length());
+}
+
+TEST(BweTraceReaderTest, ParsesRecordsInOrder) {
+  absl::optional<std::vector<BweTraceRecord>> records =
+      ParseBweTrace(CreateTrace(3));
+  ASSERT_TRUE(records);
+  ASSERT_EQ(records->size(), 3u);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ((*records)[i].at_time, Timestamp::Millis(i));
+    EXPECT_EQ((*records)[i].target_rate, DataRate::KilobitsPerSec(100 + i));
+  }
+}
+
+TEST(BweTraceReaderTest, IgnoresTruncatedLastRecord) {
+  std::string trace = CreateTrace(2);
+  trace.resize(trace.size() - 1);
+  absl::optional<std::vector<BweTraceRecord>> records = ParseBweTrace(trace);
+  ASSERT_TRUE(records);
+  EXPECT_EQ(records->size(), 1u);
+}
+
+TEST(BweTraceReaderTest, RejectsDataWithoutHeader) {
+  std::string trace = CreateTrace(1);
+  EXPECT_FALSE(ParseBweTrace(trace.substr(kBweTraceHeaderSize)));
+  EXPECT_FALSE(ParseBweTrace(""));
+}
+
+TEST(BweTraceReaderTest, ReadsFile) {
+  const std::string file_name =
+      test::TempFilename(test::OutputPath(), "bwe_trace_reader_unittest");
+  const std::string trace = CreateTrace(5);
+  FILE* file = fopen(file_name.c_str(), "wb");
+  ASSERT_TRUE(file);
+  fwrite(trace.data(), 1, trace.size(), file);
+  fclose(file);
+
+  absl::optional<std::vector<BweTraceRecord>> records =
+      ReadBweTraceFile(file_name);
+  ASSERT_TRUE(records);
+  EXPECT_EQ(records->size(), 5u);
+  remove(file_name.c_str());
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <string>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/flags/usage.h"
+#include "rtc_tools/bwe_trace/bwe_trace_reader.h"
+
+ABSL_FLAG(std::string, output, "", "Where to write the table, or stdout");
+
+namespace webrtc {
+namespace {
+
+// Unknown rates are printed as NaN, which plotting tools skip.
+double KbpsOrNan(DataRate rate) {
+  return rate.IsFinite() ? rate.kbps<double>() : NAN;
+}
+
+void PrintRecords(const std::vector<BweTraceRecord>& records, FILE* out) {
+  fprintf(out,
+          "time target loss_based_target acknowledged delay_based "
+          "delay_state trend_slope trend_modified_offset trend_threshold "
+          "trend_num_deltas rate_control_state rate_control_target "
+          "link_capacity probe_state probe_estimated "
+          "min_bitrate_to_probe_further probe_in_alr\n");
+  for (const BweTraceRecord& record : records) {
+    fprintf(out, "%.3f %.3f %.3f %.3f %.3f %d %g %g %g %d %d %.3f %.3f %d ",
+            record.at_time.seconds<double>(), KbpsOrNan(record.target_rate),
+            KbpsOrNan(record.loss_based_target_rate),
+            KbpsOrNan(record.acknowledged_rate),
+            KbpsOrNan(record.delay_based_estimate),
+            static_cast<int>(record.delay_detector_state),
+            record.trendline_slope, record.trendline_modified_offset,
+            record.trendline_threshold, record.trendline_num_deltas,
+            record.rate_control_state, KbpsOrNan(record.rate_control_target),
+            KbpsOrNan(record.link_capacity_estimate), record.probe_state);
+    fprintf(out, "%.3f %.3f %d\n", KbpsOrNan(record.probe_estimated_bitrate),
+            KbpsOrNan(record.min_bitrate_to_probe_further),
+            record.probe_in_alr ? 1 : 0);
+  }
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  absl::SetProgramUsageMessage(
+      "Converts a trace written by BweTraceRecorder to a space separated\n"
+      "table with one row per transport feedback update, rates in kbps.\n"
+      "Example usage:\n"
+      "./bwe_trace_to_text --output=trace.txt trace.bin\n");
+  std::vector<char*> args = absl::ParseCommandLine(argc, argv);
+  if (args.size() != 2) {
+    fprintf(stderr, "Expected one input file.\n");
+    return EXIT_FAILURE;
+  }
+
+  absl::optional<std::vector<webrtc::BweTraceRecord>> records =
+      webrtc::ReadBweTraceFile(args[1]);
+  if (!records) {
+    return EXIT_FAILURE;
+  }
+
+  const std::string output_path = absl::GetFlag(FLAGS_output);
+  FILE* out = stdout;
+  if (!output_path.empty()) {
+    out = fopen(output_path.c_str(), "w");
+    if (!out) {
+      fprintf(stderr, "Could not open %s.\n", output_path.c_str());
+      return EXIT_FAILURE;
+    }
+  }
+  webrtc::PrintRecords(*records, out);
+  if (out != stdout) {
+    fclose(out);
+  }
+  return EXIT_SUCCESS;
+}
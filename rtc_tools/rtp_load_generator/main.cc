@@ -0,0 +1,202 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/flags/usage.h"
+#include "api/array_view.h"
+#include "api/call/transport.h"
+#include "modules/rtp_rtcp/source/rtp_util.h"
+#include "rtc_base/async_udp_socket.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/ip_address.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/third_party/sigslot/sigslot.h"
+#include "rtc_base/thread.h"
+#include "system_wrappers/include/clock.h"
+#include "test/synthetic_rtp_sender.h"
+
+ABSL_FLAG(std::string, remote_ip, "127.0.0.1", "Address to send to.");
+ABSL_FLAG(int, remote_port, 5000, "Port to send to.");
+ABSL_FLAG(int, num_senders, 1000, "Number of synthetic video senders.");
+ABSL_FLAG(int,
+          num_sockets,
+          10,
+          "Number of local sockets the senders are spread over. Each socket "
+          "has its own transport-wide sequence numbers, like a client.");
+ABSL_FLAG(int, first_ssrc, 0x10000, "SSRC of the first sender.");
+ABSL_FLAG(int, payload_type, 96, "RTP payload type.");
+ABSL_FLAG(int,
+          transport_sequence_number_id,
+          5,
+          "Header extension id of transport-wide sequence numbers, 0 to "
+          "disable.");
+ABSL_FLAG(int, start_kbps, 300, "Start rate of each sender.");
+ABSL_FLAG(int, min_kbps, 30, "Minimum rate of each sender.");
+ABSL_FLAG(int, max_kbps, 1500, "Maximum rate of each sender.");
+ABSL_FLAG(double, fps, 30, "Frame rate of each sender.");
+ABSL_FLAG(double,
+          loss_percent,
+          0,
+          "Percentage of packets that are dropped before sending, to trigger "
+          "NACKs.");
+ABSL_FLAG(int, duration_s, 60, "How long to send for.");
+
+namespace webrtc {
+namespace {
+
+// A local UDP socket with a group of synthetic senders. Everything runs on the
+// network thread.
+class LoadGeneratorSocket : public Transport, public sigslot::has_slots<> {
+ public:
+  LoadGeneratorSocket(rtc::Thread* network_thread,
+                      const rtc::SocketAddress& remote_address,
+                      const test::SyntheticRtpSenderGroup::Config& config)
+      : remote_address_(remote_address),
+        socket_(rtc::AsyncUDPSocket::Create(
+            network_thread->socketserver(),
+            rtc::SocketAddress(rtc::GetAnyIP(remote_address.family()), 0))),
+        senders_(config, Clock::GetRealTimeClock(), network_thread, this) {
+    RTC_CHECK(socket_) << "Failed to create socket.";
+    socket_->SignalReadPacket.connect(this,
+                                      &LoadGeneratorSocket::OnReadPacket);
+    senders_.Start();
+  }
+
+  ~LoadGeneratorSocket() override { senders_.Stop(); }
+
+  bool SendRtp(const uint8_t* packet,
+               size_t length,
+               const PacketOptions& options) override {
+    return socket_->SendTo(packet, length, remote_address_,
+                           rtc::PacketOptions()) >= 0;
+  }
+
+  bool SendRtcp(const uint8_t* packet, size_t length) override {
+    return socket_->SendTo(packet, length, remote_address_,
+                           rtc::PacketOptions()) >= 0;
+  }
+
+  test::SyntheticRtpSender::Stats GetStats() const {
+    return senders_.GetStats();
+  }
+
+ private:
+  void OnReadPacket(rtc::AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t length,
+                    const rtc::SocketAddress& remote_address,
+                    const int64_t& packet_time_us) {
+    rtc::ArrayView<const uint8_t> packet(
+        reinterpret_cast<const uint8_t*>(data), length);
+    if (IsRtcpPacket(packet))
+      senders_.OnRtcpPacket(packet);
+  }
+
+  const rtc::SocketAddress remote_address_;
+  const std::unique_ptr<rtc::AsyncUDPSocket> socket_;
+  test::SyntheticRtpSenderGroup senders_;
+};
+
+int Run() {
+  rtc::SocketAddress remote_address(absl::GetFlag(FLAGS_remote_ip),
+                                    absl::GetFlag(FLAGS_remote_port));
+  if (remote_address.IsUnresolvedIP()) {
+    fprintf(stderr, "Invalid remote address.\n");
+    return EXIT_FAILURE;
+  }
+  const int num_senders = absl::GetFlag(FLAGS_num_senders);
+  const int num_sockets = absl::GetFlag(FLAGS_num_sockets);
+  if (num_sockets < 1 || num_senders < num_sockets) {
+    fprintf(stderr, "Need at least one sender per socket.\n");
+    return EXIT_FAILURE;
+  }
+
+  test::SyntheticRtpSenderGroup::Config config;
+  config.first_ssrc = absl::GetFlag(FLAGS_first_ssrc);
+  config.sender.payload_type = absl::GetFlag(FLAGS_payload_type);
+  config.sender.transport_sequence_number_id =
+      absl::GetFlag(FLAGS_transport_sequence_number_id);
+  config.sender.start_rate =
+      DataRate::KilobitsPerSec(absl::GetFlag(FLAGS_start_kbps));
+  config.sender.min_rate =
+      DataRate::KilobitsPerSec(absl::GetFlag(FLAGS_min_kbps));
+  config.sender.max_rate =
+      DataRate::KilobitsPerSec(absl::GetFlag(FLAGS_max_kbps));
+  config.sender.framerate = absl::GetFlag(FLAGS_fps);
+  config.sender.loss_rate = absl::GetFlag(FLAGS_loss_percent) / 100;
+
+  std::unique_ptr<rtc::Thread> network_thread =
+      rtc::Thread::CreateWithSocketServer();
+  network_thread->SetName("network_thread", nullptr);
+  network_thread->Start();
+
+  std::vector<std::unique_ptr<LoadGeneratorSocket>> sockets;
+  network_thread->Invoke<void>(RTC_FROM_HERE, [&] {
+    for (int i = 0; i < num_sockets; ++i) {
+      config.num_senders =
+          num_senders / num_sockets + (i < num_senders % num_sockets ? 1 : 0);
+      sockets.push_back(std::make_unique<LoadGeneratorSocket>(
+          network_thread.get(), remote_address, config));
+      config.first_ssrc += config.num_senders;
+    }
+  });
+
+  test::SyntheticRtpSender::Stats last_stats;
+  for (int second = 1; second <= absl::GetFlag(FLAGS_duration_s); ++second) {
+    rtc::Thread::SleepMs(1000);
+    test::SyntheticRtpSender::Stats stats;
+    network_thread->Invoke<void>(RTC_FROM_HERE, [&] {
+      for (const auto& socket : sockets) {
+        test::SyntheticRtpSender::Stats socket_stats = socket->GetStats();
+        stats.packets_sent += socket_stats.packets_sent;
+        stats.bytes_sent += socket_stats.bytes_sent;
+        stats.retransmissions += socket_stats.retransmissions;
+        stats.nack_requests += socket_stats.nack_requests;
+        stats.key_frame_requests += socket_stats.key_frame_requests;
+        stats.target_rate += socket_stats.target_rate;
+      }
+    });
+    printf(
+        "%4ds: %8" PRId64 " packets/s %9" PRId64 " kbps, target %9" PRId64
+        " kbps, %6" PRId64 " NACKs %6" PRId64 " retransmissions %6" PRId64
+        " key frame requests\n",
+        second, stats.packets_sent - last_stats.packets_sent,
+        (stats.bytes_sent - last_stats.bytes_sent) * 8 / 1000,
+        stats.target_rate.kbps(), stats.nack_requests,
+        stats.retransmissions, stats.key_frame_requests);
+    last_stats = stats;
+  }
+
+  network_thread->Invoke<void>(RTC_FROM_HERE, [&] { sockets.clear(); });
+  return EXIT_SUCCESS;
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  absl::SetProgramUsageMessage(
+      "Sends the RTP traffic of many synthetic video senders to a server, "
+      "e.g. an SFU, and reacts to its RTCP feedback.\n"
+      "Example Usage:\n"
+      "./rtp_load_generator --remote_ip=10.0.0.1 --remote_port=5000\n"
+      "                     --num_senders=5000 --num_sockets=50\n");
+  absl::ParseCommandLine(argc, argv);
+  return webrtc::Run();
+}
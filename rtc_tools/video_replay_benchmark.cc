@@ -0,0 +1,432 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Replays an RTP dump through the video receive pipeline of a Call as fast as
+// possible, under simulated time, and reports the throughput and the CPU time
+// spent in each stage. Unlike video_replay, which replays in real time to look
+// at the decoded video, this is meant to catch regressions in the cost of the
+// receive path. Each recorded stream can be replayed into several receive
+// streams, with rewritten SSRCs, to load the pipeline like a conference does.
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "api/rtc_event_log/rtc_event_log.h"
+#include "api/test/video/function_video_decoder_factory.h"
+#include "api/transport/field_trial_based_config.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "api/video/video_frame.h"
+#include "api/video/video_sink_interface.h"
+#include "api/video_codecs/video_decoder.h"
+#include "call/call.h"
+#include "media/engine/internal_decoder_factory.h"
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/rtp_util.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/strings/json.h"
+#include "rtc_base/task_utils/to_queued_task.h"
+#include "rtc_base/time_utils.h"
+#include "test/call_config_utils.h"
+#include "test/call_test.h"
+#include "test/encoder_settings.h"
+#include "test/fake_decoder.h"
+#include "test/null_transport.h"
+#include "test/rtp_file_reader.h"
+#include "test/testsupport/perf_test.h"
+#include "test/time_controller/simulated_time_controller.h"
+
+ABSL_FLAG(std::string, input_file, "", "RTP dump or pcap file to replay");
+
+ABSL_FLAG(std::string,
+          config_file,
+          "",
+          "JSON receive stream configs, in the format used by video_replay. "
+          "If empty, a single stream is configured from the flags below");
+
+ABSL_FLAG(uint32_t,
+          ssrc,
+          webrtc::test::CallTest::kVideoSendSsrcs[0],
+          "Incoming SSRC");
+
+ABSL_FLAG(uint32_t,
+          ssrc_rtx,
+          webrtc::test::CallTest::kSendRtxSsrcs[0],
+          "Incoming RTX SSRC");
+
+ABSL_FLAG(int,
+          media_payload_type,
+          webrtc::test::CallTest::kPayloadTypeVP8,
+          "Media payload type");
+
+ABSL_FLAG(int,
+          media_payload_type_rtx,
+          webrtc::test::CallTest::kSendRtxPayloadType,
+          "Media over RTX payload type");
+
+ABSL_FLAG(std::string, codec, "VP8", "Video codec");
+
+ABSL_FLAG(int,
+          num_streams,
+          1,
+          "Number of receive streams that each recorded stream is replayed "
+          "into");
+
+ABSL_FLAG(bool,
+          decode,
+          false,
+          "Decode with the real decoders. By default frames are handed to "
+          "fake decoders, so that only the cost of the receive path is "
+          "measured");
+
+ABSL_FLAG(std::string,
+          perf_output,
+          "",
+          "Path to write the results to, in the format of the perf "
+          "dashboard");
+
+namespace webrtc {
+namespace {
+
+constexpr uint32_t kReceiverLocalSsrc = 0x123456;
+// The SSRCs of the copies of a recorded stream are the recorded SSRC plus a
+// multiple of this.
+constexpr uint32_t kSsrcStride = 0x01000000;
+
+// CPU time of a stage of the pipeline. Everything runs on the thread that
+// advances the simulated time, so the thread CPU time of a stage is its cost.
+class StageTimer {
+ public:
+  class Scope {
+   public:
+    explicit Scope(StageTimer* timer)
+        : timer_(timer), start_ns_(rtc::GetThreadCpuTimeNanos()) {}
+    ~Scope() {
+      timer_->cpu_time_ns_ += rtc::GetThreadCpuTimeNanos() - start_ns_;
+    }
+
+   private:
+    StageTimer* const timer_;
+    const int64_t start_ns_;
+  };
+
+  int64_t cpu_time_ns() const { return cpu_time_ns_; }
+
+ private:
+  int64_t cpu_time_ns_ = 0;
+};
+
+class TimedDecoder : public VideoDecoder {
+ public:
+  TimedDecoder(std::unique_ptr<VideoDecoder> decoder, StageTimer* timer)
+      : decoder_(std::move(decoder)), timer_(timer) {}
+
+  bool Configure(const Settings& settings) override {
+    return decoder_->Configure(settings);
+  }
+  int32_t Decode(const EncodedImage& input_image,
+                 bool missing_frames,
+                 int64_t render_time_ms) override {
+    StageTimer::Scope scope(timer_);
+    return decoder_->Decode(input_image, missing_frames, render_time_ms);
+  }
+  int32_t RegisterDecodeCompleteCallback(
+      DecodedImageCallback* callback) override {
+    return decoder_->RegisterDecodeCompleteCallback(callback);
+  }
+  int32_t Release() override { return decoder_->Release(); }
+  DecoderInfo GetDecoderInfo() const override {
+    return decoder_->GetDecoderInfo();
+  }
+  const char* ImplementationName() const override {
+    return decoder_->ImplementationName();
+  }
+
+ private:
+  const std::unique_ptr<VideoDecoder> decoder_;
+  StageTimer* const timer_;
+};
+
+class FrameCounter : public rtc::VideoSinkInterface<VideoFrame> {
+ public:
+  void OnFrame(const VideoFrame& frame) override { ++num_frames_; }
+
+  int num_frames() const { return num_frames_; }
+
+ private:
+  int num_frames_ = 0;
+};
+
+std::unique_ptr<test::RtpFileReader> CreateRtpReader(const std::string& path) {
+  for (test::RtpFileReader::FileFormat format :
+       {test::RtpFileReader::kRtpDump, test::RtpFileReader::kPcap,
+        test::RtpFileReader::kLengthPacketInterleaved}) {
+    std::unique_ptr<test::RtpFileReader> reader(
+        test::RtpFileReader::Create(format, path));
+    if (reader)
+      return reader;
+  }
+  fprintf(stderr, "Unable to open input file with any supported format\n");
+  return nullptr;
+}
+
+std::vector<VideoReceiveStream::Config> ReadConfigs(Transport* transport) {
+  std::vector<VideoReceiveStream::Config> configs;
+  if (absl::GetFlag(FLAGS_config_file).empty()) {
+    VideoReceiveStream::Config config(transport);
+    config.rtp.remote_ssrc = absl::GetFlag(FLAGS_ssrc);
+    config.rtp.rtx_ssrc = absl::GetFlag(FLAGS_ssrc_rtx);
+    const int rtx_payload_type = absl::GetFlag(FLAGS_media_payload_type_rtx);
+    config.rtp.rtx_associated_payload_types[rtx_payload_type] =
+        absl::GetFlag(FLAGS_media_payload_type);
+    config.rtp.nack.rtp_history_ms = 1000;
+    config.decoders.push_back(test::CreateMatchingDecoder(
+        absl::GetFlag(FLAGS_media_payload_type), absl::GetFlag(FLAGS_codec)));
+    configs.push_back(std::move(config));
+    return configs;
+  }
+
+  std::ifstream config_file(absl::GetFlag(FLAGS_config_file));
+  std::stringstream raw_json_buffer;
+  raw_json_buffer << config_file.rdbuf();
+  std::string raw_json = raw_json_buffer.str();
+  Json::CharReaderBuilder builder;
+  Json::Value json_configs;
+  std::string error_message;
+  std::unique_ptr<Json::CharReader> json_reader(builder.newCharReader());
+  if (!json_reader->parse(raw_json.data(), raw_json.data() + raw_json.size(),
+                          &json_configs, &error_message)) {
+    fprintf(stderr, "Error parsing JSON config\n%s\n", error_message.c_str());
+    return configs;
+  }
+  for (const auto& json : json_configs)
+    configs.push_back(test::ParseVideoReceiveStreamJsonConfig(transport, json));
+  return configs;
+}
+
+class ReplayBenchmark {
+ public:
+  ReplayBenchmark()
+      : time_controller_(Timestamp::Seconds(10000)),
+        worker_thread_(time_controller_.GetTaskQueueFactory()->CreateTaskQueue(
+            "worker_thread",
+            TaskQueueFactory::Priority::NORMAL)) {}
+
+  ~ReplayBenchmark() {
+    RunOnWorker([this] {
+      for (VideoReceiveStream* receive_stream : receive_streams_)
+        call_->DestroyVideoReceiveStream(receive_stream);
+      call_.reset();
+    });
+  }
+
+  bool Configure(int num_streams) {
+    std::vector<VideoReceiveStream::Config> configs = ReadConfigs(&transport_);
+    if (configs.empty())
+      return false;
+
+    decoder_factory_ = std::make_unique<test::FunctionVideoDecoderFactory>(
+        [this](const SdpVideoFormat& format) {
+          std::unique_ptr<VideoDecoder> decoder =
+              absl::GetFlag(FLAGS_decode)
+                  ? internal_decoder_factory_.CreateVideoDecoder(format)
+                  : std::make_unique<test::FakeDecoder>();
+          return std::make_unique<TimedDecoder>(std::move(decoder),
+                                                &decode_timer_);
+        });
+    RunOnWorker([&] {
+      Call::Config call_config(&event_log_);
+      call_config.task_queue_factory = time_controller_.GetTaskQueueFactory();
+      call_config.trials = &field_trials_;
+      call_.reset(Call::Create(
+          call_config, time_controller_.GetClock(),
+          SharedModuleThread::Create(
+              time_controller_.CreateProcessThread("ModuleProcessThread"),
+              nullptr),
+          time_controller_.CreateProcessThread("PacerThread")));
+
+      for (int copy = 0; copy < num_streams; ++copy) {
+        for (const VideoReceiveStream::Config& config : configs) {
+          VideoReceiveStream::Config receive_config = config.Copy();
+          receive_config.rtp.remote_ssrc =
+              CopySsrc(config.rtp.remote_ssrc, copy);
+          if (config.rtp.rtx_ssrc != 0)
+            receive_config.rtp.rtx_ssrc = CopySsrc(config.rtp.rtx_ssrc, copy);
+          receive_config.rtp.local_ssrc =
+              kReceiverLocalSsrc + receive_streams_.size();
+          receive_config.renderer = &frame_counter_;
+          receive_config.decoder_factory = decoder_factory_.get();
+          receive_streams_.push_back(
+              call_->CreateVideoReceiveStream(std::move(receive_config)));
+          receive_streams_.back()->Start();
+        }
+      }
+    });
+    for (const VideoReceiveStream::Config& config : configs) {
+      replicated_ssrcs_.insert(config.rtp.remote_ssrc);
+      if (config.rtp.rtx_ssrc != 0)
+        replicated_ssrcs_.insert(config.rtp.rtx_ssrc);
+    }
+    num_copies_ = num_streams;
+    return true;
+  }
+
+  // Delivers the packets of `rtp_reader` at their recorded times, without
+  // waiting in between.
+  void Replay(test::RtpFileReader* rtp_reader) {
+    const int64_t start_cpu_time_ns = rtc::GetThreadCpuTimeNanos();
+    const int64_t start_wall_time_us = rtc::TimeMicros();
+    const Timestamp start_time = time_controller_.GetClock()->CurrentTime();
+
+    test::RtpPacket packet;
+    while (rtp_reader->NextPacket(&packet)) {
+      const TimeDelta until_packet =
+          start_time + TimeDelta::Millis(packet.time_ms) -
+          time_controller_.GetClock()->CurrentTime();
+      time_controller_.AdvanceTime(std::max(until_packet, TimeDelta::Zero()));
+
+      rtc::CopyOnWriteBuffer buffer(packet.data, packet.length);
+      RunOnWorker([&] {
+        if (!IsRtpPacket(buffer) ||
+            replicated_ssrcs_.count(ParseRtpSsrc(buffer)) == 0) {
+          DeliverPacket(buffer);
+          return;
+        }
+        const uint32_t ssrc = ParseRtpSsrc(buffer);
+        for (int copy = 0; copy < num_copies_; ++copy) {
+          rtc::CopyOnWriteBuffer copy_buffer = buffer;
+          ByteWriter<uint32_t>::WriteBigEndian(copy_buffer.MutableData() + 8,
+                                               CopySsrc(ssrc, copy));
+          DeliverPacket(std::move(copy_buffer));
+        }
+      });
+    }
+    // Let the last frames through the jitter buffer.
+    time_controller_.AdvanceTime(TimeDelta::Seconds(1));
+
+    wall_time_s_ = (rtc::TimeMicros() - start_wall_time_us) /
+                   static_cast<double>(rtc::kNumMicrosecsPerSec);
+    total_cpu_time_ns_ = rtc::GetThreadCpuTimeNanos() - start_cpu_time_ns;
+    const TimeDelta simulated_time =
+        time_controller_.GetClock()->CurrentTime() - start_time;
+    simulated_time_s_ = simulated_time.seconds<double>();
+  }
+
+  void PrintResults() const {
+    const double total_cpu_ms = total_cpu_time_ns_ / 1e6;
+    const double deliver_cpu_ms = deliver_timer_.cpu_time_ns() / 1e6;
+    const double decode_cpu_ms = decode_timer_.cpu_time_ns() / 1e6;
+    const std::string story = "video_replay_benchmark";
+    test::PrintResult("packets_per_second", "", story,
+                      num_packets_ / wall_time_s_, "packets/s", false,
+                      test::ImproveDirection::kBiggerIsBetter);
+    test::PrintResult("frames_per_second", "", story,
+                      frame_counter_.num_frames() / wall_time_s_, "frames/s",
+                      false, test::ImproveDirection::kBiggerIsBetter);
+    test::PrintResult("speedup", "", story, simulated_time_s_ / wall_time_s_,
+                      "x", false, test::ImproveDirection::kBiggerIsBetter);
+    test::PrintResult("cpu_time", "_deliver", story, deliver_cpu_ms, "ms",
+                      false, test::ImproveDirection::kSmallerIsBetter);
+    test::PrintResult("cpu_time", "_decode", story, decode_cpu_ms, "ms", false,
+                      test::ImproveDirection::kSmallerIsBetter);
+    test::PrintResult("cpu_time", "_other", story,
+                      total_cpu_ms - deliver_cpu_ms - decode_cpu_ms, "ms",
+                      false, test::ImproveDirection::kSmallerIsBetter);
+    test::PrintResult("cpu_time", "_total", story, total_cpu_ms, "ms", false,
+                      test::ImproveDirection::kSmallerIsBetter);
+    fprintf(stderr, "packets: %d, unknown ssrc: %d, errors: %d, frames: %d\n",
+            num_packets_, num_unknown_ssrc_packets_, num_error_packets_,
+            frame_counter_.num_frames());
+  }
+
+ private:
+  static uint32_t CopySsrc(uint32_t ssrc, int copy) {
+    return ssrc + copy * kSsrcStride;
+  }
+
+  void RunOnWorker(std::function<void()> task) {
+    worker_thread_->PostTask(ToQueuedTask(std::move(task)));
+    time_controller_.AdvanceTime(TimeDelta::Zero());
+  }
+
+  void DeliverPacket(rtc::CopyOnWriteBuffer packet) {
+    ++num_packets_;
+    PacketReceiver::DeliveryStatus result;
+    {
+      StageTimer::Scope scope(&deliver_timer_);
+      result = call_->Receiver()->DeliverPacket(MediaType::VIDEO,
+                                                std::move(packet),
+                                                /*packet_time_us=*/-1);
+    }
+    if (result == PacketReceiver::DELIVERY_UNKNOWN_SSRC)
+      ++num_unknown_ssrc_packets_;
+    else if (result == PacketReceiver::DELIVERY_PACKET_ERROR)
+      ++num_error_packets_;
+  }
+
+  GlobalSimulatedTimeController time_controller_;
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> worker_thread_;
+  RtcEventLogNull event_log_;
+  FieldTrialBasedConfig field_trials_;
+  test::NullTransport transport_;
+  InternalDecoderFactory internal_decoder_factory_;
+  std::unique_ptr<VideoDecoderFactory> decoder_factory_;
+  FrameCounter frame_counter_;
+  std::unique_ptr<Call> call_;
+  std::vector<VideoReceiveStream*> receive_streams_;
+  std::set<uint32_t> replicated_ssrcs_;
+  int num_copies_ = 1;
+
+  StageTimer deliver_timer_;
+  StageTimer decode_timer_;
+  int num_packets_ = 0;
+  int num_unknown_ssrc_packets_ = 0;
+  int num_error_packets_ = 0;
+  double wall_time_s_ = 0;
+  double simulated_time_s_ = 0;
+  int64_t total_cpu_time_ns_ = 0;
+};
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  absl::ParseCommandLine(argc, argv);
+  RTC_CHECK(!absl::GetFlag(FLAGS_input_file).empty());
+  RTC_CHECK_GE(absl::GetFlag(FLAGS_num_streams), 1);
+
+  std::unique_ptr<webrtc::test::RtpFileReader> rtp_reader =
+      webrtc::CreateRtpReader(absl::GetFlag(FLAGS_input_file));
+  if (!rtp_reader)
+    return 1;
+
+  webrtc::ReplayBenchmark benchmark;
+  if (!benchmark.Configure(absl::GetFlag(FLAGS_num_streams)))
+    return 1;
+  benchmark.Replay(rtp_reader.get());
+  benchmark.PrintResults();
+
+  if (!absl::GetFlag(FLAGS_perf_output).empty() &&
+      !webrtc::test::WritePerfResults(absl::GetFlag(FLAGS_perf_output))) {
+    return 1;
+  }
+  return 0;
+}
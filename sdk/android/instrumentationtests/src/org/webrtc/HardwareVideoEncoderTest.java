@@ -470,6 +470,36 @@ public class HardwareVideoEncoderTest {
     assertEquals(VideoCodecStatus.OK, encoder.release());
   }
 
+  @Test
+  @SmallTest
+  public void testEncodeScalesDownLargerTextureFrames() {
+    if (!useTextures) {
+      return;
+    }
+    VideoEncoder encoder = createEncoder();
+    MockEncoderCallback callback = new MockEncoderCallback();
+    final VideoEncoder.Settings layerSettings = new VideoEncoder.Settings(1 /* core */,
+        SETTINGS.width / 2, SETTINGS.height / 2, SETTINGS.startBitrate, SETTINGS.maxFramerate,
+        SETTINGS.numberOfSimulcastStreams, SETTINGS.automaticResizeOn, SETTINGS.capabilities);
+    assertEquals(VideoCodecStatus.OK, encoder.initEncode(layerSettings, callback));
+
+    VideoEncoder.EncodeInfo info = new VideoEncoder.EncodeInfo(
+        new EncodedImage.FrameType[] {EncodedImage.FrameType.VideoFrameDelta});
+    for (int i = 0; i < NUM_TEST_FRAMES; i++) {
+      // Full resolution frames, as passed to the encoder of a lower simulcast layer, are encoded
+      // at the resolution of the layer.
+      VideoFrame frame = generateTextureFrame(SETTINGS.width, SETTINGS.height);
+      testEncodeFrame(encoder, frame, info);
+      EncodedImage image = callback.poll();
+      assertEquals(layerSettings.width, image.encodedWidth);
+      assertEquals(layerSettings.height, image.encodedHeight);
+      assertEquals(frame.getTimestampNs(), image.captureTimeNs);
+      frame.release();
+    }
+
+    assertEquals(VideoCodecStatus.OK, encoder.release());
+  }
+
   @Test
   @SmallTest
   public void testEncodeAlignmentCheck() {
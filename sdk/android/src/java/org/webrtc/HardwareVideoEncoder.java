@@ -149,6 +149,10 @@ class HardwareVideoEncoder implements VideoEncoder {
 
   private int width;
   private int height;
+  // Resolution passed to initEncode(). Unlike `width` and `height`, it is not changed by frames of
+  // a different resolution.
+  private int initialWidth;
+  private int initialHeight;
   private boolean useSurfaceMode;
 
   // --- Only accessed from the encoding thread.
@@ -218,6 +222,8 @@ class HardwareVideoEncoder implements VideoEncoder {
     }
     this.width = settings.width;
     this.height = settings.height;
+    this.initialWidth = settings.width;
+    this.initialHeight = settings.height;
     useSurfaceMode = canUseSurface();
 
     if (settings.startBitrate != 0 && settings.maxFramerate != 0) {
@@ -347,6 +353,44 @@ class HardwareVideoEncoder implements VideoEncoder {
       return VideoCodecStatus.UNINITIALIZED;
     }
 
+    // A texture frame that is larger than this encoder was initialized for, such as the full
+    // resolution frame that the simulcast adapter passes to the encoder of a lower layer, is
+    // scaled down by the GPU when drawn onto the input surface, rather than read back to I420.
+    VideoFrame scaledFrame = null;
+    if (canUseSurface() && videoFrame.getBuffer() instanceof VideoFrame.TextureBuffer) {
+      scaledFrame = scaleTextureFrameToInitialSize(videoFrame);
+    }
+    try {
+      return encodeInternal(scaledFrame != null ? scaledFrame : videoFrame, encodeInfo);
+    } finally {
+      if (scaledFrame != null) {
+        scaledFrame.release();
+      }
+    }
+  }
+
+  /**
+   * Returns `videoFrame` cropped to the aspect ratio of initEncode() and scaled down to its
+   * resolution, or null if the frame isn't larger than that. The returned frame stays a texture and
+   * must be released by the caller.
+   */
+  @Nullable
+  private VideoFrame scaleTextureFrameToInitialSize(VideoFrame videoFrame) {
+    final int frameWidth = videoFrame.getBuffer().getWidth();
+    final int frameHeight = videoFrame.getBuffer().getHeight();
+    if (frameWidth < initialWidth || frameHeight < initialHeight
+        || (frameWidth == initialWidth && frameHeight == initialHeight)) {
+      return null;
+    }
+    final int cropWidth = Math.min(frameWidth, frameHeight * initialWidth / initialHeight);
+    final int cropHeight = Math.min(frameHeight, frameWidth * initialHeight / initialWidth);
+    final VideoFrame.Buffer scaledBuffer = videoFrame.getBuffer().cropAndScale(
+        (frameWidth - cropWidth) / 2, (frameHeight - cropHeight) / 2, cropWidth, cropHeight,
+        initialWidth, initialHeight);
+    return new VideoFrame(scaledBuffer, videoFrame.getRotation(), videoFrame.getTimestampNs());
+  }
+
+  private VideoCodecStatus encodeInternal(VideoFrame videoFrame, EncodeInfo encodeInfo) {
     final VideoFrame.Buffer videoFrameBuffer = videoFrame.getBuffer();
     final boolean isTextureBuffer = videoFrameBuffer instanceof VideoFrame.TextureBuffer;
 
@@ -11,6 +11,8 @@
 
 #import "RTCVideoEncoderH264.h"
 
+#import <CoreImage/CoreImage.h>
+#import <Metal/Metal.h>
 #import <VideoToolbox/VideoToolbox.h>
 #include <vector>
 
@@ -129,6 +131,33 @@ bool CopyVideoFrameToNV12PixelBuffer(id<RTC_OBJC_TYPE(RTCI420Buffer)> frameBuffe
   return true;
 }
 
+// Crops and scales `buffer` into `outputPixelBuffer` on the GPU. Neither buffer
+// is mapped into memory.
+void CropAndScalePixelBuffer(CIContext *context,
+                             RTC_OBJC_TYPE(RTCCVPixelBuffer) * buffer,
+                             CVPixelBufferRef outputPixelBuffer) {
+  const CGFloat dstWidth = CVPixelBufferGetWidth(outputPixelBuffer);
+  const CGFloat dstHeight = CVPixelBufferGetHeight(outputPixelBuffer);
+  // Core Image has its origin at the bottom left.
+  const CGRect cropRect =
+      CGRectMake(buffer.cropX,
+                 CVPixelBufferGetHeight(buffer.pixelBuffer) - buffer.cropY - buffer.cropHeight,
+                 buffer.cropWidth,
+                 buffer.cropHeight);
+  // Clamp to the crop, so that the edges aren't blended with transparent pixels
+  // when scaling.
+  CIImage *image = [[[CIImage imageWithCVPixelBuffer:buffer.pixelBuffer]
+      imageByCroppingToRect:cropRect] imageByClampingToExtent];
+  CGAffineTransform transform =
+      CGAffineTransformMakeScale(dstWidth / buffer.cropWidth, dstHeight / buffer.cropHeight);
+  transform = CGAffineTransformTranslate(transform, -cropRect.origin.x, -cropRect.origin.y);
+  image = [image imageByApplyingTransform:transform];
+  [context render:image
+      toCVPixelBuffer:outputPixelBuffer
+               bounds:CGRectMake(0, 0, dstWidth, dstHeight)
+           colorSpace:nil];
+}
+
 CVPixelBufferRef CreatePixelBuffer(CVPixelBufferPoolRef pixel_buffer_pool) {
   if (!pixel_buffer_pool) {
     RTC_LOG(LS_ERROR) << "Failed to get pixel buffer pool.";
@@ -326,6 +355,9 @@ NSUInteger GetMaxSampleRate(const webrtc::H264ProfileLevelId &profile_level_id)
   RTCVideoCodecMode _mode;
 
   webrtc::H264BitstreamParser _h264BitstreamParser;
+  // Crops and scales native frames on the GPU. Nil if Metal isn't available,
+  // in which case they are cropped and scaled by libyuv into _frameScaleBuffer.
+  CIContext *_scaleContext;
   std::vector<uint8_t> _frameScaleBuffer;
 }
 
@@ -346,6 +378,13 @@ NSUInteger GetMaxSampleRate(const webrtc::H264ProfileLevelId &profile_level_id)
     RTC_DCHECK(_profile_level_id);
     RTC_LOG(LS_INFO) << "Using profile " << CFStringToString(ExtractProfile(*_profile_level_id));
     RTC_CHECK([codecInfo.name isEqualToString:kRTCVideoCodecH264Name]);
+    id<MTLDevice> device = MTLCreateSystemDefaultDevice();
+    if (device) {
+      // The frames are only cropped and scaled, so there is no need for color
+      // management.
+      _scaleContext = [CIContext contextWithMTLDevice:device
+                                              options:@{kCIContextWorkingColorSpace : [NSNull null]}];
+    }
   }
   return self;
 }
@@ -417,19 +456,23 @@ NSUInteger GetMaxSampleRate(const webrtc::H264ProfileLevelId &profile_level_id)
       if (!pixelBuffer) {
         return WEBRTC_VIDEO_CODEC_ERROR;
       }
-      int dstWidth = CVPixelBufferGetWidth(pixelBuffer);
-      int dstHeight = CVPixelBufferGetHeight(pixelBuffer);
-      if ([rtcPixelBuffer requiresScalingToWidth:dstWidth height:dstHeight]) {
-        int size =
-            [rtcPixelBuffer bufferSizeForCroppingAndScalingToWidth:dstWidth height:dstHeight];
-        _frameScaleBuffer.resize(size);
+      if (_scaleContext) {
+        CropAndScalePixelBuffer(_scaleContext, rtcPixelBuffer, pixelBuffer);
       } else {
-        _frameScaleBuffer.clear();
-      }
-      _frameScaleBuffer.shrink_to_fit();
-      if (![rtcPixelBuffer cropAndScaleTo:pixelBuffer withTempBuffer:_frameScaleBuffer.data()]) {
-        CVBufferRelease(pixelBuffer);
-        return WEBRTC_VIDEO_CODEC_ERROR;
+        int dstWidth = CVPixelBufferGetWidth(pixelBuffer);
+        int dstHeight = CVPixelBufferGetHeight(pixelBuffer);
+        if ([rtcPixelBuffer requiresScalingToWidth:dstWidth height:dstHeight]) {
+          int size =
+              [rtcPixelBuffer bufferSizeForCroppingAndScalingToWidth:dstWidth height:dstHeight];
+          _frameScaleBuffer.resize(size);
+        } else {
+          _frameScaleBuffer.clear();
+        }
+        _frameScaleBuffer.shrink_to_fit();
+        if (![rtcPixelBuffer cropAndScaleTo:pixelBuffer withTempBuffer:_frameScaleBuffer.data()]) {
+          CVBufferRelease(pixelBuffer);
+          return WEBRTC_VIDEO_CODEC_ERROR;
+        }
       }
     }
   }
@@ -34,6 +34,16 @@ class ObjCFrameBuffer : public VideoFrameBuffer {
 
   rtc::scoped_refptr<I420BufferInterface> ToI420() override;
 
+  // Crops and scales an RTCCVPixelBuffer lazily, by adjusting the crop and
+  // size that are applied when its pixels are accessed, so that the result
+  // stays a native buffer that e.g. VideoToolbox can encode directly.
+  rtc::scoped_refptr<VideoFrameBuffer> CropAndScale(int offset_x,
+                                                    int offset_y,
+                                                    int crop_width,
+                                                    int crop_height,
+                                                    int scaled_width,
+                                                    int scaled_height) override;
+
   id<RTC_OBJC_TYPE(RTCVideoFrameBuffer)> wrapped_frame_buffer() const;
 
  private:
@@ -11,6 +11,7 @@
 #include "sdk/objc/native/src/objc_frame_buffer.h"
 
 #import "base/RTCVideoFrameBuffer.h"
+#import "components/video_frame_buffer/RTCCVPixelBuffer.h"
 #import "sdk/objc/api/video_frame_buffer/RTCNativeI420Buffer+Private.h"
 
 namespace webrtc {
@@ -72,6 +73,30 @@ rtc::scoped_refptr<I420BufferInterface> ObjCFrameBuffer::ToI420() {
   return buffer;
 }
 
+rtc::scoped_refptr<VideoFrameBuffer> ObjCFrameBuffer::CropAndScale(int offset_x,
+                                                                   int offset_y,
+                                                                   int crop_width,
+                                                                   int crop_height,
+                                                                   int scaled_width,
+                                                                   int scaled_height) {
+  if (![frame_buffer_ isKindOfClass:[RTC_OBJC_TYPE(RTCCVPixelBuffer) class]]) {
+    return VideoFrameBuffer::CropAndScale(
+        offset_x, offset_y, crop_width, crop_height, scaled_width, scaled_height);
+  }
+  RTC_OBJC_TYPE(RTCCVPixelBuffer)* pixel_buffer = (RTC_OBJC_TYPE(RTCCVPixelBuffer)*)frame_buffer_;
+  // The crop is given in the coordinates of this buffer, which may itself be a
+  // scaled crop of the CVPixelBuffer.
+  RTC_OBJC_TYPE(RTCCVPixelBuffer)* cropped_buffer = [[RTC_OBJC_TYPE(RTCCVPixelBuffer) alloc]
+      initWithPixelBuffer:pixel_buffer.pixelBuffer
+             adaptedWidth:scaled_width
+            adaptedHeight:scaled_height
+                cropWidth:crop_width * pixel_buffer.cropWidth / width_
+               cropHeight:crop_height * pixel_buffer.cropHeight / height_
+                    cropX:pixel_buffer.cropX + offset_x * pixel_buffer.cropWidth / width_
+                    cropY:pixel_buffer.cropY + offset_y * pixel_buffer.cropHeight / height_];
+  return new rtc::RefCountedObject<ObjCFrameBuffer>(cropped_buffer);
+}
+
 id<RTC_OBJC_TYPE(RTCVideoFrameBuffer)> ObjCFrameBuffer::wrapped_frame_buffer() const {
   return frame_buffer_;
 }
@@ -11,6 +11,7 @@
 #import <Foundation/Foundation.h>
 #import <XCTest/XCTest.h>
 
+#include "sdk/objc/native/src/objc_frame_buffer.h"
 #include "sdk/objc/native/src/objc_video_track_source.h"
 
 #import "api/video_frame_buffer/RTCNativeI420Buffer+Private.h"
@@ -467,4 +468,37 @@ class ObjCCallbackVideoSink : public rtc::VideoSinkInterface<webrtc::VideoFrame>
   [self waitForExpectations:@[ callbackExpectation ] timeout:10.0];
 }
 
+- (void)testCropAndScaleOfCVPixelBufferStaysNative {
+  CVPixelBufferRef pixelBufferRef = NULL;
+  CVPixelBufferCreate(
+      NULL, 1280, 720, kCVPixelFormatType_420YpCbCr8BiPlanarFullRange, NULL, &pixelBufferRef);
+  // Half of the pixel buffer, starting at x = 640.
+  RTC_OBJC_TYPE(RTCCVPixelBuffer) *buffer =
+      [[RTC_OBJC_TYPE(RTCCVPixelBuffer) alloc] initWithPixelBuffer:pixelBufferRef
+                                                      adaptedWidth:320
+                                                     adaptedHeight:360
+                                                         cropWidth:640
+                                                        cropHeight:720
+                                                             cropX:640
+                                                             cropY:0];
+  rtc::scoped_refptr<webrtc::VideoFrameBuffer> nativeBuffer =
+      new rtc::RefCountedObject<webrtc::ObjCFrameBuffer>(buffer);
+
+  rtc::scoped_refptr<webrtc::VideoFrameBuffer> scaledBuffer =
+      nativeBuffer->CropAndScale(80, 0, 160, 360, 80, 180);
+  XCTAssertEqual(scaledBuffer->type(), webrtc::VideoFrameBuffer::Type::kNative);
+  XCTAssertEqual(scaledBuffer->width(), 80);
+  XCTAssertEqual(scaledBuffer->height(), 180);
+
+  RTC_OBJC_TYPE(RTCCVPixelBuffer) *scaledPixelBuffer = (RTC_OBJC_TYPE(RTCCVPixelBuffer) *)
+      static_cast<webrtc::ObjCFrameBuffer *>(scaledBuffer.get())->wrapped_frame_buffer();
+  XCTAssertEqual(scaledPixelBuffer.pixelBuffer, pixelBufferRef);
+  XCTAssertEqual(scaledPixelBuffer.cropX, 800);
+  XCTAssertEqual(scaledPixelBuffer.cropY, 0);
+  XCTAssertEqual(scaledPixelBuffer.cropWidth, 320);
+  XCTAssertEqual(scaledPixelBuffer.cropHeight, 720);
+
+  CVBufferRelease(pixelBufferRef);
+}
+
 @end
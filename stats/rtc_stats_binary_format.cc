@@ -0,0 +1,516 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/stats/rtc_stats_binary_format.h"
+
+#include <string.h>
+
+#include <type_traits>
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr uint8_t kKeyFrame = 0x01;
+constexpr uint8_t kUndefined = 0x80;
+
+static_assert(
+    std::is_same<absl::variant_alternative_t<RTCStatsMemberInterface::kString,
+                                             RTCStatsBinaryValue>,
+                 std::string>::value,
+    "RTCStatsBinaryValue must follow RTCStatsMemberInterface::Type");
+static_assert(
+    std::is_same<
+        absl::variant_alternative_t<RTCStatsMemberInterface::kMapStringDouble,
+                                    RTCStatsBinaryValue>,
+        std::map<std::string, double>>::value,
+    "RTCStatsBinaryValue must follow RTCStatsMemberInterface::Type");
+
+uint64_t ZigZagEncode(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^
+         static_cast<uint64_t>(value >> 63);
+}
+
+int64_t ZigZagDecode(uint64_t value) {
+  return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+}
+
+void WriteValue(bool value, rtc::ByteBufferWriter* buffer) {
+  buffer->WriteUInt8(value ? 1 : 0);
+}
+
+void WriteValue(int32_t value, rtc::ByteBufferWriter* buffer) {
+  buffer->WriteUVarint(ZigZagEncode(value));
+}
+
+void WriteValue(uint32_t value, rtc::ByteBufferWriter* buffer) {
+  buffer->WriteUVarint(value);
+}
+
+void WriteValue(int64_t value, rtc::ByteBufferWriter* buffer) {
+  buffer->WriteUVarint(ZigZagEncode(value));
+}
+
+void WriteValue(uint64_t value, rtc::ByteBufferWriter* buffer) {
+  buffer->WriteUVarint(value);
+}
+
+void WriteValue(double value, rtc::ByteBufferWriter* buffer) {
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  buffer->WriteUInt64(bits);
+}
+
+void WriteValue(const std::string& value, rtc::ByteBufferWriter* buffer) {
+  buffer->WriteUVarint(value.size());
+  buffer->WriteString(value);
+}
+
+template <typename T>
+void WriteValue(const std::vector<T>& value, rtc::ByteBufferWriter* buffer) {
+  buffer->WriteUVarint(value.size());
+  for (const T& element : value) {
+    WriteValue(element, buffer);
+  }
+}
+
+template <typename T>
+void WriteValue(const std::map<std::string, T>& value,
+                rtc::ByteBufferWriter* buffer) {
+  buffer->WriteUVarint(value.size());
+  for (const auto& pair : value) {
+    WriteValue(pair.first, buffer);
+    WriteValue(pair.second, buffer);
+  }
+}
+
+template <typename T>
+void WriteMemberValue(const RTCStatsMemberInterface& member,
+                      rtc::ByteBufferWriter* buffer) {
+  WriteValue(*member.cast_to<RTCStatsMember<T>>(), buffer);
+}
+
+void WriteMember(uint64_t name_index,
+                 const RTCStatsMemberInterface& member,
+                 rtc::ByteBufferWriter* buffer) {
+  buffer->WriteUVarint(name_index);
+  if (!member.is_defined()) {
+    buffer->WriteUInt8(member.type() | kUndefined);
+    return;
+  }
+  buffer->WriteUInt8(member.type());
+  switch (member.type()) {
+    case RTCStatsMemberInterface::kBool:
+      WriteMemberValue<bool>(member, buffer);
+      break;
+    case RTCStatsMemberInterface::kInt32:
+      WriteMemberValue<int32_t>(member, buffer);
+      break;
+    case RTCStatsMemberInterface::kUint32:
+      WriteMemberValue<uint32_t>(member, buffer);
+      break;
+    case RTCStatsMemberInterface::kInt64:
+      WriteMemberValue<int64_t>(member, buffer);
+      break;
+    case RTCStatsMemberInterface::kUint64:
+      WriteMemberValue<uint64_t>(member, buffer);
+      break;
+    case RTCStatsMemberInterface::kDouble:
+      WriteMemberValue<double>(member, buffer);
+      break;
+    case RTCStatsMemberInterface::kString:
+      WriteMemberValue<std::string>(member, buffer);
+      break;
+    case RTCStatsMemberInterface::kSequenceBool:
+      WriteMemberValue<std::vector<bool>>(member, buffer);
+      break;
+    case RTCStatsMemberInterface::kSequenceInt32:
+      WriteMemberValue<std::vector<int32_t>>(member, buffer);
+      break;
+    case RTCStatsMemberInterface::kSequenceUint32:
+      WriteMemberValue<std::vector<uint32_t>>(member, buffer);
+      break;
+    case RTCStatsMemberInterface::kSequenceInt64:
+      WriteMemberValue<std::vector<int64_t>>(member, buffer);
+      break;
+    case RTCStatsMemberInterface::kSequenceUint64:
+      WriteMemberValue<std::vector<uint64_t>>(member, buffer);
+      break;
+    case RTCStatsMemberInterface::kSequenceDouble:
+      WriteMemberValue<std::vector<double>>(member, buffer);
+      break;
+    case RTCStatsMemberInterface::kSequenceString:
+      WriteMemberValue<std::vector<std::string>>(member, buffer);
+      break;
+    case RTCStatsMemberInterface::kMapStringUint64:
+      WriteMemberValue<std::map<std::string, uint64_t>>(member, buffer);
+      break;
+    case RTCStatsMemberInterface::kMapStringDouble:
+      WriteMemberValue<std::map<std::string, double>>(member, buffer);
+      break;
+  }
+}
+
+bool ReadValue(rtc::ByteBufferReader* buffer, bool* value) {
+  uint8_t byte;
+  if (!buffer->ReadUInt8(&byte))
+    return false;
+  *value = byte != 0;
+  return true;
+}
+
+bool ReadValue(rtc::ByteBufferReader* buffer, int32_t* value) {
+  uint64_t encoded;
+  if (!buffer->ReadUVarint(&encoded))
+    return false;
+  *value = static_cast<int32_t>(ZigZagDecode(encoded));
+  return true;
+}
+
+bool ReadValue(rtc::ByteBufferReader* buffer, uint32_t* value) {
+  uint64_t encoded;
+  if (!buffer->ReadUVarint(&encoded))
+    return false;
+  *value = static_cast<uint32_t>(encoded);
+  return true;
+}
+
+bool ReadValue(rtc::ByteBufferReader* buffer, int64_t* value) {
+  uint64_t encoded;
+  if (!buffer->ReadUVarint(&encoded))
+    return false;
+  *value = ZigZagDecode(encoded);
+  return true;
+}
+
+bool ReadValue(rtc::ByteBufferReader* buffer, uint64_t* value) {
+  return buffer->ReadUVarint(value);
+}
+
+bool ReadValue(rtc::ByteBufferReader* buffer, double* value) {
+  uint64_t bits;
+  if (!buffer->ReadUInt64(&bits))
+    return false;
+  memcpy(value, &bits, sizeof(bits));
+  return true;
+}
+
+// Reads a count of elements, each of which takes at least one byte.
+bool ReadCount(rtc::ByteBufferReader* buffer, uint64_t* count) {
+  return buffer->ReadUVarint(count) && *count <= buffer->Length();
+}
+
+bool ReadValue(rtc::ByteBufferReader* buffer, std::string* value) {
+  uint64_t size;
+  value->clear();
+  return ReadCount(buffer, &size) && buffer->ReadString(value, size);
+}
+
+template <typename T>
+bool ReadValue(rtc::ByteBufferReader* buffer, std::vector<T>* value) {
+  uint64_t count;
+  if (!ReadCount(buffer, &count))
+    return false;
+  value->clear();
+  value->reserve(count);
+  for (uint64_t i = 0; i < count; ++i) {
+    T element;
+    if (!ReadValue(buffer, &element))
+      return false;
+    value->push_back(std::move(element));
+  }
+  return true;
+}
+
+template <typename T>
+bool ReadValue(rtc::ByteBufferReader* buffer, std::map<std::string, T>* value) {
+  uint64_t count;
+  if (!ReadCount(buffer, &count))
+    return false;
+  value->clear();
+  for (uint64_t i = 0; i < count; ++i) {
+    std::string key;
+    T element;
+    if (!ReadValue(buffer, &key) || !ReadValue(buffer, &element))
+      return false;
+    (*value)[std::move(key)] = std::move(element);
+  }
+  return true;
+}
+
+template <RTCStatsMemberInterface::Type kType>
+bool ReadMemberValue(rtc::ByteBufferReader* buffer,
+                     RTCStatsBinaryValue* value) {
+  absl::variant_alternative_t<kType, RTCStatsBinaryValue> element;
+  if (!ReadValue(buffer, &element))
+    return false;
+  value->emplace<kType>(std::move(element));
+  return true;
+}
+
+bool ReadMemberValue(rtc::ByteBufferReader* buffer,
+                     uint8_t type,
+                     RTCStatsBinaryValue* value) {
+  switch (type) {
+    case RTCStatsMemberInterface::kBool:
+      return ReadMemberValue<RTCStatsMemberInterface::kBool>(buffer, value);
+    case RTCStatsMemberInterface::kInt32:
+      return ReadMemberValue<RTCStatsMemberInterface::kInt32>(buffer, value);
+    case RTCStatsMemberInterface::kUint32:
+      return ReadMemberValue<RTCStatsMemberInterface::kUint32>(buffer, value);
+    case RTCStatsMemberInterface::kInt64:
+      return ReadMemberValue<RTCStatsMemberInterface::kInt64>(buffer, value);
+    case RTCStatsMemberInterface::kUint64:
+      return ReadMemberValue<RTCStatsMemberInterface::kUint64>(buffer, value);
+    case RTCStatsMemberInterface::kDouble:
+      return ReadMemberValue<RTCStatsMemberInterface::kDouble>(buffer, value);
+    case RTCStatsMemberInterface::kString:
+      return ReadMemberValue<RTCStatsMemberInterface::kString>(buffer, value);
+    case RTCStatsMemberInterface::kSequenceBool:
+      return ReadMemberValue<RTCStatsMemberInterface::kSequenceBool>(buffer,
+                                                                     value);
+    case RTCStatsMemberInterface::kSequenceInt32:
+      return ReadMemberValue<RTCStatsMemberInterface::kSequenceInt32>(buffer,
+                                                                      value);
+    case RTCStatsMemberInterface::kSequenceUint32:
+      return ReadMemberValue<RTCStatsMemberInterface::kSequenceUint32>(buffer,
+                                                                       value);
+    case RTCStatsMemberInterface::kSequenceInt64:
+      return ReadMemberValue<RTCStatsMemberInterface::kSequenceInt64>(buffer,
+                                                                      value);
+    case RTCStatsMemberInterface::kSequenceUint64:
+      return ReadMemberValue<RTCStatsMemberInterface::kSequenceUint64>(buffer,
+                                                                       value);
+    case RTCStatsMemberInterface::kSequenceDouble:
+      return ReadMemberValue<RTCStatsMemberInterface::kSequenceDouble>(buffer,
+                                                                       value);
+    case RTCStatsMemberInterface::kSequenceString:
+      return ReadMemberValue<RTCStatsMemberInterface::kSequenceString>(buffer,
+                                                                       value);
+    case RTCStatsMemberInterface::kMapStringUint64:
+      return ReadMemberValue<RTCStatsMemberInterface::kMapStringUint64>(
+          buffer, value);
+    case RTCStatsMemberInterface::kMapStringDouble:
+      return ReadMemberValue<RTCStatsMemberInterface::kMapStringDouble>(
+          buffer, value);
+  }
+  return false;
+}
+
+}  // namespace
+
+RTCStatsBinaryWriter::RTCStatsBinaryWriter() = default;
+
+RTCStatsBinaryWriter::~RTCStatsBinaryWriter() = default;
+
+void RTCStatsBinaryWriter::Write(
+    rtc::scoped_refptr<const RTCStatsReport> report,
+    rtc::ByteBufferWriter* buffer) {
+  RTC_DCHECK(report);
+  const bool key_frame = !previous_report_;
+  new_strings_.clear();
+  body_.Clear();
+
+  std::vector<uint64_t> removed_ids;
+  if (previous_report_) {
+    for (const RTCStats& stats : *previous_report_) {
+      if (!report->Get(stats.id()))
+        removed_ids.push_back(InternString(stats.id()));
+    }
+  }
+  uint64_t num_changed = 0;
+  for (const RTCStats& stats : *report) {
+    const RTCStats* previous =
+        previous_report_ ? previous_report_->Get(stats.id()) : nullptr;
+    if (WriteStats(stats, previous, report->timestamp_us()))
+      ++num_changed;
+  }
+
+  buffer->WriteUInt8(key_frame ? kKeyFrame : 0);
+  buffer->WriteUVarint(static_cast<uint64_t>(report->timestamp_us()));
+  buffer->WriteUVarint(new_strings_.size());
+  for (const std::string* str : new_strings_) {
+    WriteValue(*str, buffer);
+  }
+  buffer->WriteUVarint(removed_ids.size());
+  for (uint64_t id : removed_ids) {
+    buffer->WriteUVarint(id);
+  }
+  buffer->WriteUVarint(num_changed);
+  buffer->WriteBytes(body_.Data(), body_.Length());
+  previous_report_ = std::move(report);
+}
+
+void RTCStatsBinaryWriter::Reset() {
+  previous_report_ = nullptr;
+  string_indices_.clear();
+  name_indices_.clear();
+}
+
+uint64_t RTCStatsBinaryWriter::InternString(const std::string& str) {
+  auto it = string_indices_.find(str);
+  if (it == string_indices_.end()) {
+    it = string_indices_.emplace(str, string_indices_.size()).first;
+    new_strings_.push_back(&it->first);
+  }
+  return it->second;
+}
+
+uint64_t RTCStatsBinaryWriter::InternName(const char* name) {
+  auto it = name_indices_.find(name);
+  if (it == name_indices_.end())
+    it = name_indices_.emplace(name, InternString(name)).first;
+  return it->second;
+}
+
+bool RTCStatsBinaryWriter::WriteStats(const RTCStats& stats,
+                                      const RTCStats* previous,
+                                      int64_t report_timestamp_us) {
+  const int64_t timestamp_offset_us =
+      stats.timestamp_us() - report_timestamp_us;
+  std::vector<const RTCStatsMemberInterface*> members = stats.Members();
+  std::vector<const RTCStatsMemberInterface*> changed_members;
+  if (previous && strcmp(previous->type(), stats.type()) == 0) {
+    std::vector<const RTCStatsMemberInterface*> previous_members =
+        previous->Members();
+    RTC_DCHECK_EQ(previous_members.size(), members.size());
+    for (size_t i = 0; i < members.size(); ++i) {
+      if (*members[i] != *previous_members[i])
+        changed_members.push_back(members[i]);
+    }
+    if (changed_members.empty() &&
+        previous->timestamp_us() - previous_report_->timestamp_us() ==
+            timestamp_offset_us) {
+      return false;
+    }
+  } else {
+    // A new object, or one whose type changed, which the reader starts over.
+    for (const RTCStatsMemberInterface* member : members) {
+      if (member->is_defined())
+        changed_members.push_back(member);
+    }
+  }
+
+  body_.WriteUVarint(InternString(stats.id()));
+  body_.WriteUVarint(InternName(stats.type()));
+  body_.WriteUVarint(ZigZagEncode(timestamp_offset_us));
+  body_.WriteUVarint(changed_members.size());
+  for (const RTCStatsMemberInterface* member : changed_members) {
+    WriteMember(InternName(member->name()), *member, &body_);
+  }
+  return true;
+}
+
+RTCStatsBinaryReader::RTCStatsBinaryReader() = default;
+
+RTCStatsBinaryReader::~RTCStatsBinaryReader() = default;
+
+bool RTCStatsBinaryReader::Read(rtc::ByteBufferReader* buffer) {
+  if (ReadMessage(buffer))
+    return true;
+  needs_key_frame_ = true;
+  strings_.clear();
+  timestamp_us_ = 0;
+  stats_.clear();
+  return false;
+}
+
+bool RTCStatsBinaryReader::ReadMessage(rtc::ByteBufferReader* buffer) {
+  uint8_t flags;
+  if (!buffer->ReadUInt8(&flags))
+    return false;
+  if (flags & kKeyFrame) {
+    needs_key_frame_ = false;
+    strings_.clear();
+    stats_.clear();
+  } else if (needs_key_frame_) {
+    return false;
+  }
+
+  uint64_t timestamp_us;
+  if (!buffer->ReadUVarint(&timestamp_us))
+    return false;
+  // The stats that are not in the message keep their offset to the report
+  // timestamp.
+  const int64_t timestamp_delta_us =
+      static_cast<int64_t>(timestamp_us) - timestamp_us_;
+  timestamp_us_ = static_cast<int64_t>(timestamp_us);
+  for (auto& pair : stats_) {
+    pair.second.timestamp_us += timestamp_delta_us;
+  }
+
+  uint64_t count;
+  if (!ReadCount(buffer, &count))
+    return false;
+  for (uint64_t i = 0; i < count; ++i) {
+    std::string str;
+    if (!ReadValue(buffer, &str))
+      return false;
+    strings_.push_back(std::move(str));
+  }
+
+  if (!ReadCount(buffer, &count))
+    return false;
+  for (uint64_t i = 0; i < count; ++i) {
+    const std::string* id;
+    if (!ReadStringIndex(buffer, &id))
+      return false;
+    stats_.erase(*id);
+  }
+
+  if (!ReadCount(buffer, &count))
+    return false;
+  for (uint64_t i = 0; i < count; ++i) {
+    const std::string* id;
+    const std::string* type;
+    uint64_t timestamp_offset_us;
+    uint64_t num_members;
+    if (!ReadStringIndex(buffer, &id) || !ReadStringIndex(buffer, &type) ||
+        !buffer->ReadUVarint(&timestamp_offset_us) ||
+        !ReadCount(buffer, &num_members)) {
+      return false;
+    }
+    Stats& stats = stats_[*id];
+    if (stats.type != *type) {
+      stats.type = *type;
+      stats.members.clear();
+    }
+    stats.timestamp_us = timestamp_us_ + ZigZagDecode(timestamp_offset_us);
+    for (uint64_t j = 0; j < num_members; ++j) {
+      const std::string* name;
+      uint8_t member_type;
+      if (!ReadStringIndex(buffer, &name) ||
+          !buffer->ReadUInt8(&member_type)) {
+        return false;
+      }
+      if (member_type & kUndefined) {
+        stats.members.erase(*name);
+      } else if (!ReadMemberValue(buffer, member_type,
+                                  &stats.members[*name])) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool RTCStatsBinaryReader::ReadStringIndex(rtc::ByteBufferReader* buffer,
+                                           const std::string** str) {
+  uint64_t index;
+  if (!buffer->ReadUVarint(&index) || index >= strings_.size())
+    return false;
+  *str = &strings_[index];
+  return true;
+}
+
+}  // namespace webrtc
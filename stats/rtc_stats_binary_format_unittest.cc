@@ -0,0 +1,191 @@
+/*
+ *  Copyright 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/stats/rtc_stats_binary_format.h"
+
+#include <memory>
+#include <string>
+
+#include "stats/test/rtc_test_stats.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+std::unique_ptr<RTCTestStats> CreateStats(const std::string& id,
+                                          int64_t timestamp_us,
+                                          bool define_string = true) {
+  auto stats = std::make_unique<RTCTestStats>(id, timestamp_us);
+  stats->m_bool = true;
+  stats->m_int32 = -12;
+  stats->m_uint32 = 34;
+  stats->m_int64 = -(int64_t{1} << 40);
+  stats->m_uint64 = uint64_t{1} << 63;
+  stats->m_double = 0.5;
+  if (define_string)
+    stats->m_string = "string";
+  stats->m_sequence_bool = std::vector<bool>{true, false};
+  stats->m_sequence_int32 = std::vector<int32_t>{-1, 2};
+  stats->m_sequence_uint32 = std::vector<uint32_t>{3, 4};
+  stats->m_sequence_int64 = std::vector<int64_t>{-5, 6};
+  stats->m_sequence_uint64 = std::vector<uint64_t>{7, 8};
+  stats->m_sequence_double = std::vector<double>{9.5, -10.25};
+  stats->m_sequence_string = std::vector<std::string>{"a", "b"};
+  stats->m_map_string_uint64 = std::map<std::string, uint64_t>{{"c", 11}};
+  stats->m_map_string_double = std::map<std::string, double>{{"d", 12.5}};
+  return stats;
+}
+
+class RTCStatsBinaryFormatTest : public ::testing::Test {
+ protected:
+  // Encodes `report` and decodes it again, returning the number of bytes.
+  size_t WriteAndRead(rtc::scoped_refptr<const RTCStatsReport> report) {
+    rtc::ByteBufferWriter buffer;
+    writer_.Write(report, &buffer);
+    rtc::ByteBufferReader reader(buffer);
+    EXPECT_TRUE(reader_.Read(&reader));
+    EXPECT_EQ(reader.Length(), 0u);
+    ExpectReaderHas(*report);
+    return buffer.Length();
+  }
+
+  void ExpectReaderHas(const RTCStatsReport& report) {
+    EXPECT_EQ(reader_.timestamp_us(), report.timestamp_us());
+    ASSERT_EQ(reader_.stats().size(), report.size());
+    for (const RTCStats& stats : report) {
+      auto it = reader_.stats().find(stats.id());
+      ASSERT_NE(it, reader_.stats().end());
+      EXPECT_EQ(it->second.type, stats.type());
+      EXPECT_EQ(it->second.timestamp_us, stats.timestamp_us());
+      size_t num_defined = 0;
+      for (const RTCStatsMemberInterface* member : stats.Members()) {
+        auto member_it = it->second.members.find(member->name());
+        if (!member->is_defined()) {
+          EXPECT_EQ(member_it, it->second.members.end());
+          continue;
+        }
+        ++num_defined;
+        ASSERT_NE(member_it, it->second.members.end());
+        EXPECT_EQ(member_it->second.index(),
+                  static_cast<size_t>(member->type()));
+      }
+      EXPECT_EQ(it->second.members.size(), num_defined);
+    }
+  }
+
+  RTCStatsBinaryWriter writer_;
+  RTCStatsBinaryReader reader_;
+};
+
+TEST_F(RTCStatsBinaryFormatTest, RoundTripsAllMemberTypes) {
+  rtc::scoped_refptr<RTCStatsReport> report = RTCStatsReport::Create(1000);
+  report->AddStats(CreateStats("a", 1000));
+  report->AddStats(std::make_unique<RTCTestStats>("undefined", 990));
+  WriteAndRead(report);
+
+  const RTCStatsBinaryReader::Stats& stats = reader_.stats().at("a");
+  const auto& members = stats.members;
+  EXPECT_EQ(absl::get<bool>(members.at("mBool")), true);
+  EXPECT_EQ(absl::get<int32_t>(members.at("mInt32")), -12);
+  EXPECT_EQ(absl::get<uint32_t>(members.at("mUint32")), 34u);
+  EXPECT_EQ(absl::get<int64_t>(members.at("mInt64")), -(int64_t{1} << 40));
+  EXPECT_EQ(absl::get<uint64_t>(members.at("mUint64")), uint64_t{1} << 63);
+  EXPECT_EQ(absl::get<double>(members.at("mDouble")), 0.5);
+  EXPECT_EQ(absl::get<std::string>(members.at("mString")), "string");
+  EXPECT_EQ(absl::get<std::vector<bool>>(members.at("mSequenceBool")),
+            (std::vector<bool>{true, false}));
+  EXPECT_EQ(absl::get<std::vector<int32_t>>(members.at("mSequenceInt32")),
+            (std::vector<int32_t>{-1, 2}));
+  EXPECT_EQ(absl::get<std::vector<uint32_t>>(members.at("mSequenceUint32")),
+            (std::vector<uint32_t>{3, 4}));
+  EXPECT_EQ(absl::get<std::vector<int64_t>>(members.at("mSequenceInt64")),
+            (std::vector<int64_t>{-5, 6}));
+  EXPECT_EQ(absl::get<std::vector<uint64_t>>(members.at("mSequenceUint64")),
+            (std::vector<uint64_t>{7, 8}));
+  EXPECT_EQ(absl::get<std::vector<double>>(members.at("mSequenceDouble")),
+            (std::vector<double>{9.5, -10.25}));
+  EXPECT_EQ(
+      absl::get<std::vector<std::string>>(members.at("mSequenceString")),
+      (std::vector<std::string>{"a", "b"}));
+  EXPECT_EQ((absl::get<std::map<std::string, uint64_t>>(
+                members.at("mMapStringUint64"))),
+            (std::map<std::string, uint64_t>{{"c", 11}}));
+  EXPECT_EQ((absl::get<std::map<std::string, double>>(
+                members.at("mMapStringDouble"))),
+            (std::map<std::string, double>{{"d", 12.5}}));
+}
+
+TEST_F(RTCStatsBinaryFormatTest, EncodesOnlyChangesSincePreviousReport) {
+  rtc::scoped_refptr<RTCStatsReport> report = RTCStatsReport::Create(1000);
+  report->AddStats(CreateStats("a", 1000));
+  report->AddStats(CreateStats("b", 1000));
+  report->AddStats(CreateStats("c", 1000));
+  const size_t key_frame_size = WriteAndRead(report);
+
+  // Nothing changed but the timestamps.
+  report = RTCStatsReport::Create(2000);
+  report->AddStats(CreateStats("a", 2000));
+  report->AddStats(CreateStats("b", 2000));
+  report->AddStats(CreateStats("c", 2000));
+  const size_t unchanged_size = WriteAndRead(report);
+  EXPECT_LT(unchanged_size, 8u);
+
+  // One member changes, one becomes undefined, an object is removed and one
+  // is added.
+  report = RTCStatsReport::Create(3000);
+  std::unique_ptr<RTCTestStats> a =
+      CreateStats("a", 3000, /*define_string=*/false);
+  a->m_uint64 = 42;
+  report->AddStats(std::move(a));
+  report->AddStats(CreateStats("b", 2500));
+  report->AddStats(CreateStats("d", 3000));
+  const size_t delta_size = WriteAndRead(report);
+  EXPECT_LT(delta_size, key_frame_size);
+  EXPECT_EQ(absl::get<uint64_t>(reader_.stats().at("a").members.at("mUint64")),
+            42u);
+}
+
+TEST_F(RTCStatsBinaryFormatTest, WaitsForKeyFrameAfterError) {
+  rtc::scoped_refptr<RTCStatsReport> report = RTCStatsReport::Create(1000);
+  report->AddStats(CreateStats("a", 1000));
+  rtc::ByteBufferWriter key_frame;
+  writer_.Write(report, &key_frame);
+
+  report = RTCStatsReport::Create(2000);
+  std::unique_ptr<RTCTestStats> a = CreateStats("a", 2000);
+  a->m_int32 = 7;
+  report->AddStats(std::move(a));
+  rtc::ByteBufferWriter delta;
+  writer_.Write(report, &delta);
+
+  // A delta without the preceding key frame is rejected.
+  rtc::ByteBufferReader delta_reader(delta);
+  EXPECT_FALSE(reader_.Read(&delta_reader));
+
+  // A truncated message is rejected and clears the report.
+  rtc::ByteBufferReader truncated_reader(key_frame.Data(),
+                                         key_frame.Length() - 1);
+  EXPECT_FALSE(reader_.Read(&truncated_reader));
+  EXPECT_TRUE(reader_.stats().empty());
+
+  writer_.Reset();
+  rtc::ByteBufferWriter new_key_frame;
+  writer_.Write(report, &new_key_frame);
+  rtc::ByteBufferReader new_key_frame_reader(new_key_frame);
+  EXPECT_TRUE(reader_.Read(&new_key_frame_reader));
+  ExpectReaderHas(*report);
+  EXPECT_EQ(absl::get<int32_t>(reader_.stats().at("a").members.at("mInt32")),
+            7);
+}
+
+}  // namespace
+
+}  // namespace webrtc
@@ -103,6 +103,41 @@ void RTCStatsReport::TakeMembersFrom(rtc::scoped_refptr<RTCStatsReport> other) {
   other->stats_.clear();
 }
 
+rtc::scoped_refptr<RTCStatsReport> RTCStatsReport::CreateDelta(
+    const RTCStatsReport& previous,
+    std::vector<std::string>* removed_ids) const {
+  rtc::scoped_refptr<RTCStatsReport> delta = Create(timestamp_us_);
+  if (removed_ids) {
+    removed_ids->clear();
+  }
+  // Both maps are ordered by ID, so they are walked in step.
+  StatsMap::const_iterator previous_it = previous.stats_.begin();
+  for (const auto& entry : stats_) {
+    while (previous_it != previous.stats_.end() &&
+           previous_it->first < entry.first) {
+      if (removed_ids) {
+        removed_ids->push_back(previous_it->first);
+      }
+      ++previous_it;
+    }
+    if (previous_it != previous.stats_.end() &&
+        previous_it->first == entry.first) {
+      bool changed = *previous_it->second != *entry.second;
+      ++previous_it;
+      if (!changed) {
+        continue;
+      }
+    }
+    delta->AddStats(entry.second->copy());
+  }
+  if (removed_ids) {
+    for (; previous_it != previous.stats_.end(); ++previous_it) {
+      removed_ids->push_back(previous_it->first);
+    }
+  }
+  return delta;
+}
+
 RTCStatsReport::ConstIterator RTCStatsReport::begin() const {
   return ConstIterator(rtc::scoped_refptr<const RTCStatsReport>(this),
                        stats_.cbegin());
@@ -139,4 +139,42 @@ TEST(RTCStatsReport, TakeMembersFrom) {
   EXPECT_EQ(i, static_cast<int64_t>(6));
 }
 
+TEST(RTCStatsReport, CreateDelta) {
+  rtc::scoped_refptr<RTCStatsReport> previous = RTCStatsReport::Create(1);
+  std::unique_ptr<RTCTestStats1> a(new RTCTestStats1("A", 1));
+  a->integer = 1;
+  previous->AddStats(std::move(a));
+  std::unique_ptr<RTCTestStats1> b(new RTCTestStats1("B", 1));
+  b->integer = 2;
+  previous->AddStats(std::move(b));
+  previous->AddStats(std::unique_ptr<RTCStats>(new RTCTestStats2("C", 1)));
+  previous->AddStats(std::unique_ptr<RTCStats>(new RTCTestStats3("E", 1)));
+
+  // "A" is unchanged but for its timestamp, "B" has changed, "C" and "E" are
+  // removed and "D" is new.
+  rtc::scoped_refptr<RTCStatsReport> current = RTCStatsReport::Create(2);
+  a.reset(new RTCTestStats1("A", 2));
+  a->integer = 1;
+  current->AddStats(std::move(a));
+  b.reset(new RTCTestStats1("B", 2));
+  b->integer = 3;
+  current->AddStats(std::move(b));
+  current->AddStats(std::unique_ptr<RTCStats>(new RTCTestStats3("D", 2)));
+
+  std::vector<std::string> removed_ids;
+  rtc::scoped_refptr<RTCStatsReport> delta =
+      current->CreateDelta(*previous, &removed_ids);
+  EXPECT_EQ(delta->timestamp_us(), 2);
+  EXPECT_EQ(delta->size(), 2u);
+  EXPECT_FALSE(delta->Get("A"));
+  ASSERT_TRUE(delta->GetAs<RTCTestStats1>("B"));
+  EXPECT_EQ(*delta->GetAs<RTCTestStats1>("B")->integer, 3);
+  EXPECT_TRUE(delta->GetAs<RTCTestStats3>("D"));
+  EXPECT_EQ(removed_ids, std::vector<std::string>({"C", "E"}));
+
+  EXPECT_EQ(current->CreateDelta(*current)->size(), 0u);
+  EXPECT_EQ(current->CreateDelta(*RTCStatsReport::Create(0))->size(),
+            current->size());
+}
+
 }  // namespace webrtc
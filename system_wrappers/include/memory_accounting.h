@@ -0,0 +1,61 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef SYSTEM_WRAPPERS_INCLUDE_MEMORY_ACCOUNTING_H_
+#define SYSTEM_WRAPPERS_INCLUDE_MEMORY_ACCOUNTING_H_
+
+#include <stdint.h>
+
+#include "absl/types/optional.h"
+
+namespace webrtc {
+namespace memory_accounting {
+
+// Process wide accounting of the memory held by media buffers and caches.
+// Like the metrics in metrics.h, the counters are global, so they cover every
+// PeerConnection in the process. Subsystems report the bytes they take and
+// release; the application reads the counters, e.g. when the OS warns about
+// memory pressure, and can set budgets.
+//
+// Budgets are soft: subsystems that can drop data without breaking the stream
+// trim to their budget, the others only report. The counters are lock free
+// and may be used from any thread.
+
+enum class Subsystem {
+  // Sent RTP packets kept for retransmission and padding. Trims to budget.
+  kRtpPacketHistory,
+  // Received video packets waiting to be assembled into frames.
+  kVideoPacketBuffer,
+  kNumSubsystems,
+};
+
+const char* SubsystemName(Subsystem subsystem);
+
+// Adds `bytes`, which is negative when memory is released.
+void Add(Subsystem subsystem, int64_t bytes);
+
+// Returns the number of bytes currently held by `subsystem`.
+int64_t BytesInUse(Subsystem subsystem);
+
+// Returns the number of bytes currently held by all subsystems.
+int64_t TotalBytesInUse();
+
+// Sets the number of bytes `subsystem` should stay within, or removes the
+// budget if `budget_bytes` is nullopt.
+void SetBudget(Subsystem subsystem, absl::optional<int64_t> budget_bytes);
+absl::optional<int64_t> Budget(Subsystem subsystem);
+
+// Returns true if `subsystem` holds more than its budget.
+bool IsOverBudget(Subsystem subsystem);
+
+}  // namespace memory_accounting
+}  // namespace webrtc
+
+#endif  // SYSTEM_WRAPPERS_INCLUDE_MEMORY_ACCOUNTING_H_
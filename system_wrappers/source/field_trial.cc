@@ -13,11 +13,15 @@
 
 #include <map>
 #include <string>
+#include <unordered_map>
+#include <utility>
 
+#include "absl/base/attributes.h"
 #include "absl/strings/string_view.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/string_encode.h"
+#include "rtc_base/synchronization/mutex.h"
 
 // Simple field trial implementation, which allows client to
 // specify desired flags in InitFieldTrialsFromString.
@@ -68,6 +72,37 @@ bool FieldTrialsStringIsValidInternal(const absl::string_view trials) {
 
   return true;
 }
+
+using FieldTrialMap = std::unordered_map<std::string, std::string>;
+
+// The trials of `trials_init_string`, parsed when it is set so that lookups
+// don't have to scan the string.
+ABSL_CONST_INIT GlobalMutex g_parsed_trials_lock(absl::kConstInit);
+FieldTrialMap* g_parsed_trials RTC_GUARDED_BY(g_parsed_trials_lock) = nullptr;
+
+// Parses the trials up to the first malformed one. The first group of a trial
+// that is listed more than once is used.
+FieldTrialMap* ParseFieldTrials(const absl::string_view trials) {
+  FieldTrialMap* parsed_trials = new FieldTrialMap();
+  size_t next_item = 0;
+  while (next_item < trials.length()) {
+    // Find next name/value pair in field trial configuration string.
+    size_t field_name_end = trials.find(kPersistentStringSeparator, next_item);
+    if (field_name_end == trials.npos || field_name_end == next_item)
+      break;
+    size_t field_value_end =
+        trials.find(kPersistentStringSeparator, field_name_end + 1);
+    if (field_value_end == trials.npos ||
+        field_value_end == field_name_end + 1)
+      break;
+    parsed_trials->emplace(
+        std::string(trials.substr(next_item, field_name_end - next_item)),
+        std::string(trials.substr(field_name_end + 1,
+                                  field_value_end - field_name_end - 1)));
+    next_item = field_value_end + 1;
+  }
+  return parsed_trials;
+}
 }  // namespace
 
 bool FieldTrialsStringIsValid(const char* trials_string) {
@@ -103,35 +138,14 @@ std::string MergeFieldTrialsStrings(const char* first, const char* second) {
 }
 
 std::string FindFullName(const std::string& name) {
-  if (trials_init_string == NULL)
+  GlobalMutexLock lock(&g_parsed_trials_lock);
+  if (g_parsed_trials == nullptr)
     return std::string();
 
-  std::string trials_string(trials_init_string);
-  if (trials_string.empty())
+  auto it = g_parsed_trials->find(name);
+  if (it == g_parsed_trials->end())
     return std::string();
-
-  size_t next_item = 0;
-  while (next_item < trials_string.length()) {
-    // Find next name/value pair in field trial configuration string.
-    size_t field_name_end =
-        trials_string.find(kPersistentStringSeparator, next_item);
-    if (field_name_end == trials_string.npos || field_name_end == next_item)
-      break;
-    size_t field_value_end =
-        trials_string.find(kPersistentStringSeparator, field_name_end + 1);
-    if (field_value_end == trials_string.npos ||
-        field_value_end == field_name_end + 1)
-      break;
-    std::string field_name(trials_string, next_item,
-                           field_name_end - next_item);
-    std::string field_value(trials_string, field_name_end + 1,
-                            field_value_end - field_name_end - 1);
-    next_item = field_value_end + 1;
-
-    if (name == field_name)
-      return field_value;
-  }
-  return std::string();
+  return it->second;
 }
 #endif  // WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT
 
@@ -143,6 +157,13 @@ void InitFieldTrialsFromString(const char* trials_string) {
     RTC_DCHECK(FieldTrialsStringIsValidInternal(trials_string))
         << "Invalid field trials string:" << trials_string;
   };
+  FieldTrialMap* parsed_trials =
+      trials_string ? ParseFieldTrials(trials_string) : nullptr;
+  {
+    GlobalMutexLock lock(&g_parsed_trials_lock);
+    std::swap(g_parsed_trials, parsed_trials);
+  }
+  delete parsed_trials;
 #endif  // WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT
   trials_init_string = trials_string;
 }
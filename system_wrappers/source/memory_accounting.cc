@@ -0,0 +1,93 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "system_wrappers/include/memory_accounting.h"
+
+#include <atomic>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace memory_accounting {
+namespace {
+
+constexpr int kNumSubsystems = static_cast<int>(Subsystem::kNumSubsystems);
+// Stored budget meaning that there is none.
+constexpr int64_t kNoBudget = -1;
+
+struct Counter {
+  std::atomic<int64_t> bytes_in_use{0};
+  std::atomic<int64_t> budget_bytes{kNoBudget};
+};
+
+// Constant initialized, so it's usable from static initializers too.
+Counter g_counters[kNumSubsystems];
+
+Counter& GetCounter(Subsystem subsystem) {
+  int index = static_cast<int>(subsystem);
+  RTC_DCHECK_GE(index, 0);
+  RTC_DCHECK_LT(index, kNumSubsystems);
+  return g_counters[index];
+}
+
+}  // namespace
+
+const char* SubsystemName(Subsystem subsystem) {
+  switch (subsystem) {
+    case Subsystem::kRtpPacketHistory:
+      return "RtpPacketHistory";
+    case Subsystem::kVideoPacketBuffer:
+      return "VideoPacketBuffer";
+    case Subsystem::kNumSubsystems:
+      break;
+  }
+  RTC_CHECK_NOTREACHED();
+}
+
+void Add(Subsystem subsystem, int64_t bytes) {
+  GetCounter(subsystem).bytes_in_use.fetch_add(bytes,
+                                               std::memory_order_relaxed);
+}
+
+int64_t BytesInUse(Subsystem subsystem) {
+  return GetCounter(subsystem).bytes_in_use.load(std::memory_order_relaxed);
+}
+
+int64_t TotalBytesInUse() {
+  int64_t total = 0;
+  for (const Counter& counter : g_counters) {
+    total += counter.bytes_in_use.load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
+void SetBudget(Subsystem subsystem, absl::optional<int64_t> budget_bytes) {
+  RTC_DCHECK(!budget_bytes || *budget_bytes >= 0);
+  GetCounter(subsystem).budget_bytes.store(budget_bytes.value_or(kNoBudget),
+                                           std::memory_order_relaxed);
+}
+
+absl::optional<int64_t> Budget(Subsystem subsystem) {
+  int64_t budget_bytes =
+      GetCounter(subsystem).budget_bytes.load(std::memory_order_relaxed);
+  if (budget_bytes == kNoBudget) {
+    return absl::nullopt;
+  }
+  return budget_bytes;
+}
+
+bool IsOverBudget(Subsystem subsystem) {
+  int64_t budget_bytes =
+      GetCounter(subsystem).budget_bytes.load(std::memory_order_relaxed);
+  return budget_bytes != kNoBudget && BytesInUse(subsystem) > budget_bytes;
+}
+
+}  // namespace memory_accounting
+}  // namespace webrtc
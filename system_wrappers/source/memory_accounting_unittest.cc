@@ -0,0 +1,56 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "system_wrappers/include/memory_accounting.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace memory_accounting {
+namespace {
+
+// The counters are process wide, so the tests look at changes only.
+
+TEST(MemoryAccountingTest, CountsBytesPerSubsystem) {
+  const int64_t history_bytes = BytesInUse(Subsystem::kRtpPacketHistory);
+  const int64_t buffer_bytes = BytesInUse(Subsystem::kVideoPacketBuffer);
+  const int64_t total_bytes = TotalBytesInUse();
+
+  Add(Subsystem::kRtpPacketHistory, 1000);
+  Add(Subsystem::kVideoPacketBuffer, 300);
+  EXPECT_EQ(BytesInUse(Subsystem::kRtpPacketHistory), history_bytes + 1000);
+  EXPECT_EQ(BytesInUse(Subsystem::kVideoPacketBuffer), buffer_bytes + 300);
+  EXPECT_EQ(TotalBytesInUse(), total_bytes + 1300);
+
+  Add(Subsystem::kRtpPacketHistory, -1000);
+  Add(Subsystem::kVideoPacketBuffer, -300);
+  EXPECT_EQ(TotalBytesInUse(), total_bytes);
+}
+
+TEST(MemoryAccountingTest, IsOverBudgetOnlyWithBudget) {
+  const Subsystem kSubsystem = Subsystem::kVideoPacketBuffer;
+  EXPECT_FALSE(Budget(kSubsystem));
+  Add(kSubsystem, 1000);
+  EXPECT_FALSE(IsOverBudget(kSubsystem));
+
+  SetBudget(kSubsystem, BytesInUse(kSubsystem));
+  EXPECT_FALSE(IsOverBudget(kSubsystem));
+  Add(kSubsystem, 1);
+  EXPECT_TRUE(IsOverBudget(kSubsystem));
+
+  SetBudget(kSubsystem, absl::nullopt);
+  EXPECT_FALSE(Budget(kSubsystem));
+  EXPECT_FALSE(IsOverBudget(kSubsystem));
+  Add(kSubsystem, -1001);
+}
+
+}  // namespace
+}  // namespace memory_accounting
+}  // namespace webrtc
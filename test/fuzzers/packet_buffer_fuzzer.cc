@@ -8,7 +8,6 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
-#include <memory>
 #include <utility>
 
 #include "modules/video_coding/frame_object.h"
@@ -27,16 +26,16 @@ void FuzzOneInput(const uint8_t* data, size_t size) {
   test::FuzzDataHelper helper(rtc::ArrayView<const uint8_t>(data, size));
 
   while (helper.BytesLeft()) {
-    auto packet = std::make_unique<video_coding::PacketBuffer::Packet>();
+    video_coding::PacketBuffer::Packet packet;
     // Fuzz POD members of the packet.
-    helper.CopyTo(&packet->marker_bit);
-    helper.CopyTo(&packet->payload_type);
-    helper.CopyTo(&packet->seq_num);
-    helper.CopyTo(&packet->timestamp);
-    helper.CopyTo(&packet->times_nacked);
+    helper.CopyTo(&packet.marker_bit);
+    helper.CopyTo(&packet.payload_type);
+    helper.CopyTo(&packet.seq_num);
+    helper.CopyTo(&packet.timestamp);
+    helper.CopyTo(&packet.times_nacked);
 
     // Fuzz non-POD member of the packet.
-    packet->video_payload.SetSize(helper.ReadOrDefaultValue<uint8_t>(0));
+    packet.video_payload.SetSize(helper.ReadOrDefaultValue<uint8_t>(0));
     // TODO(danilchap): Fuzz other non-POD members of the `packet`.
 
     IgnoreResult(packet_buffer.InsertPacket(std::move(packet)));
@@ -392,6 +392,12 @@ void NetworkRouterNode::RemoveDefaultReceiver() {
   default_receiver_ = absl::nullopt;
 }
 
+void NetworkRouterNode::Stop() {
+  RTC_DCHECK_RUN_ON(task_queue_);
+  routing_.clear();
+  default_receiver_ = absl::nullopt;
+}
+
 void NetworkRouterNode::SetWatcher(
     std::function<void(const EmulatedIpPacket&)> watcher) {
   task_queue_->PostTask([=] {
@@ -597,6 +603,13 @@ rtc::IPAddress EmulatedEndpointImpl::GetPeerLocalAddress() const {
 }
 
 void EmulatedEndpointImpl::OnPacketReceived(EmulatedIpPacket packet) {
+  if (!task_queue_->IsCurrent()) {
+    // The packet comes from a node that runs on another task queue.
+    task_queue_->PostTask([this, packet = std::move(packet)]() mutable {
+      OnPacketReceived(std::move(packet));
+    });
+    return;
+  }
   RTC_DCHECK_RUN_ON(task_queue_);
   if (!options_.allow_receive_packets_with_different_dest_ip) {
     RTC_CHECK(packet.to.ipaddr() == options_.ip)
@@ -437,6 +437,8 @@ class NetworkRouterNode : public EmulatedNetworkReceiverInterface {
   void RemoveDefaultReceiver();
   void SetWatcher(std::function<void(const EmulatedIpPacket&)> watcher);
   void SetFilter(std::function<bool(const EmulatedIpPacket&)> filter);
+  // Removes all receivers, so that packets are dropped from now on.
+  void Stop();
 
  private:
   rtc::TaskQueue* const task_queue_;
@@ -12,6 +12,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <string>
 
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
@@ -45,7 +46,9 @@ std::unique_ptr<TimeController> CreateTimeController(TimeMode mode) {
 }
 }  // namespace
 
-NetworkEmulationManagerImpl::NetworkEmulationManagerImpl(TimeMode mode)
+NetworkEmulationManagerImpl::NetworkEmulationManagerImpl(
+    TimeMode mode,
+    int num_node_task_queues)
     : time_mode_(mode),
       time_controller_(CreateTimeController(mode)),
       clock_(time_controller_->GetClock()),
@@ -53,7 +56,17 @@ NetworkEmulationManagerImpl::NetworkEmulationManagerImpl(TimeMode mode)
       next_ip4_address_(kMinIPv4Address),
       task_queue_(time_controller_->GetTaskQueueFactory()->CreateTaskQueue(
           "NetworkEmulation",
-          TaskQueueFactory::Priority::NORMAL)) {}
+          TaskQueueFactory::Priority::NORMAL)) {
+  RTC_CHECK_GE(num_node_task_queues, 1);
+  if (num_node_task_queues == 1)
+    return;
+  for (int i = 0; i < num_node_task_queues; ++i) {
+    node_task_queues_.push_back(std::make_unique<TaskQueueForTest>(
+        time_controller_->GetTaskQueueFactory()->CreateTaskQueue(
+            "NetworkEmulationNodes" + std::to_string(i),
+            TaskQueueFactory::Priority::NORMAL)));
+  }
+}
 
 // TODO(srte): Ensure that any pending task that must be run for consistency
 // (such as stats collection tasks) are not cancelled when the task queue is
@@ -62,6 +75,13 @@ NetworkEmulationManagerImpl::~NetworkEmulationManagerImpl() {
   for (auto& turn_server : turn_servers_) {
     turn_server->Stop();
   }
+  // Nodes on their own task queues forward packets to `task_queue_`, which is
+  // deleted first, so they have to stop forwarding before.
+  for (auto& node_and_task_queue : node_to_task_queue_) {
+    EmulatedNetworkNode* node = node_and_task_queue.first;
+    node_and_task_queue.second->SendTask([node] { node->router()->Stop(); },
+                                         RTC_FROM_HERE);
+  }
 }
 
 EmulatedNetworkNode* NetworkEmulationManagerImpl::CreateEmulatedNode(
@@ -73,9 +93,17 @@ EmulatedNetworkNode* NetworkEmulationManagerImpl::CreateEmulatedNode(
 
 EmulatedNetworkNode* NetworkEmulationManagerImpl::CreateEmulatedNode(
     std::unique_ptr<NetworkBehaviorInterface> network_behavior) {
+  TaskQueueForTest* node_task_queue = &task_queue_;
+  if (!node_task_queues_.empty()) {
+    node_task_queue = node_task_queues_[next_node_task_queue_].get();
+    next_node_task_queue_ =
+        (next_node_task_queue_ + 1) % node_task_queues_.size();
+  }
   auto node = std::make_unique<EmulatedNetworkNode>(
-      clock_, &task_queue_, std::move(network_behavior));
+      clock_, node_task_queue, std::move(network_behavior));
   EmulatedNetworkNode* out = node.get();
+  if (node_task_queue != &task_queue_)
+    node_to_task_queue_[out] = node_task_queue;
   task_queue_.PostTask([this, node = std::move(node)]() mutable {
     network_nodes_.push_back(std::move(node));
   });
@@ -188,16 +216,20 @@ EmulatedRoute* NetworkEmulationManagerImpl::CreateDefaultRoute(
 
 void NetworkEmulationManagerImpl::ClearRoute(EmulatedRoute* route) {
   RTC_CHECK(route->active) << "Route already cleared";
-  task_queue_.SendTask(
-      [route]() {
-        // Remove receiver from intermediate nodes.
-        for (auto* node : route->via_nodes) {
+  // Remove receiver from intermediate nodes.
+  for (auto* node : route->via_nodes) {
+    NodeTaskQueue(node)->SendTask(
+        [route, node]() {
           if (route->is_default) {
             node->router()->RemoveDefaultReceiver();
           } else {
             node->router()->RemoveReceiver(route->to->GetPeerLocalAddress());
           }
-        }
+        },
+        RTC_FROM_HERE);
+  }
+  task_queue_.SendTask(
+      [route]() {
         // Remove destination endpoint from source endpoint's router.
         if (route->is_default) {
           route->from->router()->RemoveDefaultReceiver();
@@ -336,6 +368,12 @@ NetworkEmulationManagerImpl::GetNextIPv4Address() {
   return absl::nullopt;
 }
 
+TaskQueueForTest* NetworkEmulationManagerImpl::NodeTaskQueue(
+    EmulatedNetworkNode* node) {
+  auto it = node_to_task_queue_.find(node);
+  return it != node_to_task_queue_.end() ? it->second : &task_queue_;
+}
+
 Timestamp NetworkEmulationManagerImpl::Now() const {
   return clock_->CurrentTime();
 }
@@ -40,7 +40,11 @@ namespace test {
 
 class NetworkEmulationManagerImpl : public NetworkEmulationManager {
  public:
-  explicit NetworkEmulationManagerImpl(TimeMode mode);
+  // The emulated nodes are spread over `num_node_task_queues` task queues, so
+  // that the links of a large network are emulated on several threads. With
+  // a single one, nodes run on the same task queue as the endpoints.
+  explicit NetworkEmulationManagerImpl(TimeMode mode,
+                                       int num_node_task_queues = 1);
   ~NetworkEmulationManagerImpl();
 
   EmulatedNetworkNode* CreateEmulatedNode(BuiltInNetworkBehaviorConfig config,
@@ -99,6 +103,7 @@ class NetworkEmulationManagerImpl : public NetworkEmulationManager {
       std::pair<std::unique_ptr<CrossTrafficGenerator>, RepeatingTaskHandle>;
 
   absl::optional<rtc::IPAddress> GetNextIPv4Address();
+  TaskQueueForTest* NodeTaskQueue(EmulatedNetworkNode* node);
 
   const TimeMode time_mode_;
   const std::unique_ptr<TimeController> time_controller_;
@@ -124,6 +129,12 @@ class NetworkEmulationManagerImpl : public NetworkEmulationManager {
   std::map<EmulatedEndpoint*, EmulatedNetworkManager*>
       endpoint_to_network_manager_;
 
+  // Task queues of the nodes, if they don't run on `task_queue_`. They are
+  // deleted after `task_queue_`, because its tasks post to them.
+  std::vector<std::unique_ptr<TaskQueueForTest>> node_task_queues_;
+  size_t next_node_task_queue_ = 0;
+  std::map<EmulatedNetworkNode*, TaskQueueForTest*> node_to_task_queue_;
+
   // Must be the last field, so it will be deleted first, because tasks
   // in the TaskQueue can access other fields of the instance of this class.
   TaskQueueForTest task_queue_;
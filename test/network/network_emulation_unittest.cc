@@ -573,6 +573,48 @@ TEST_F(NetworkEmulationManagerThreeNodesRoutingTest,
   SendPacketsAndValidateDelivery();
 }
 
+TEST(NetworkEmulationManagerTest, DeliversInOrderOverNodesOnSeveralTaskQueues) {
+  constexpr int kNumPackets = 1000;
+  NetworkEmulationManagerImpl network_manager(TimeMode::kRealTime,
+                                              /*num_node_task_queues=*/3);
+  EmulatedEndpoint* sender =
+      network_manager.CreateEndpoint(EmulatedEndpointConfig());
+  EmulatedEndpoint* receiver_endpoint =
+      network_manager.CreateEndpoint(EmulatedEndpointConfig());
+  std::vector<EmulatedNetworkNode*> nodes;
+  for (int i = 0; i < 4; ++i) {
+    nodes.push_back(
+        CreateEmulatedNodeWithDefaultBuiltInConfig(&network_manager));
+  }
+  EmulatedRoute* route =
+      network_manager.CreateRoute(sender, nodes, receiver_endpoint);
+
+  MockReceiver receiver;
+  std::vector<size_t> received_sizes;
+  rtc::Event all_received;
+  EXPECT_CALL(receiver, OnPacketReceived(::testing::_))
+      .Times(kNumPackets)
+      .WillRepeatedly([&](EmulatedIpPacket packet) {
+        received_sizes.push_back(packet.data.size());
+        if (received_sizes.size() == kNumPackets)
+          all_received.Set();
+      });
+  ASSERT_EQ(receiver_endpoint->BindReceiver(80, &receiver), 80);
+
+  for (int i = 0; i < kNumPackets; ++i) {
+    sender->SendPacket(
+        rtc::SocketAddress(sender->GetPeerLocalAddress(), 80),
+        rtc::SocketAddress(receiver_endpoint->GetPeerLocalAddress(), 80),
+        rtc::CopyOnWriteBuffer(1 + i % 100));
+  }
+  ASSERT_TRUE(all_received.Wait(kStatsWaitTimeout.ms()));
+  for (int i = 0; i < kNumPackets; ++i)
+    EXPECT_EQ(received_sizes[i], static_cast<size_t>(1 + i % 100));
+
+  network_manager.ClearRoute(route);
+  EXPECT_FALSE(route->active);
+}
+
 TEST(NetworkEmulationManagerTest, EndpointLoopback) {
   NetworkEmulationManagerImpl network_manager(TimeMode::kSimulated);
   auto endpoint = network_manager.CreateEndpoint(EmulatedEndpointConfig());
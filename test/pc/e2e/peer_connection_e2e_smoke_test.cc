@@ -48,7 +48,7 @@ class PeerConnectionE2EQualityTestSmokeTest : public ::testing::Test {
       PeerConnectionE2EQualityTestFixture::EchoEmulationConfig;
 
   void SetUp() override {
-    network_emulation_ = CreateNetworkEmulationManager();
+    network_emulation_ = CreateNetworkEmulationManager(time_mode());
     auto video_quality_analyzer = std::make_unique<DefaultVideoQualityAnalyzer>(
         network_emulation_->time_controller()->GetClock());
     video_quality_analyzer_ = video_quality_analyzer.get();
@@ -116,6 +116,9 @@ class PeerConnectionE2EQualityTestSmokeTest : public ::testing::Test {
 
   PeerConnectionE2EQualityTestFixture* fixture() { return fixture_.get(); }
 
+ protected:
+  virtual TimeMode time_mode() const { return TimeMode::kRealTime; }
+
  private:
   std::unique_ptr<NetworkEmulationManager> network_emulation_;
   DefaultVideoQualityAnalyzer* video_quality_analyzer_;
@@ -177,6 +180,47 @@ TEST_F(PeerConnectionE2EQualityTestSmokeTest, MAYBE_Smoke) {
   RunAndCheckEachVideoStreamReceivedFrames(run_params);
 }
 
+// Runs the whole PeerConnection stack, including the network thread, the
+// emulated sockets and the encoders, in simulated time.
+class PeerConnectionE2EQualityTestSmokeSimulatedTimeTest
+    : public PeerConnectionE2EQualityTestSmokeTest {
+ protected:
+  TimeMode time_mode() const override { return TimeMode::kSimulated; }
+};
+
+TEST_F(PeerConnectionE2EQualityTestSmokeSimulatedTimeTest, LongCall) {
+  std::pair<EmulatedNetworkManagerInterface*, EmulatedNetworkManagerInterface*>
+      network_links = CreateNetwork();
+  AddPeer(network_links.first, [](PeerConfigurer* alice) {
+    VideoConfig video(160, 120, 15);
+    video.stream_label = "alice-video";
+    video.sync_group = "alice-media";
+    alice->AddVideoConfig(std::move(video));
+
+    AudioConfig audio;
+    audio.stream_label = "alice-audio";
+    audio.mode = AudioConfig::Mode::kFile;
+    audio.input_file_name =
+        test::ResourcePath("pc_quality_smoke_test_alice_source", "wav");
+    audio.sampling_frequency_in_hz = 48000;
+    audio.sync_group = "alice-media";
+    alice->SetAudioConfig(std::move(audio));
+  });
+  AddPeer(network_links.second, [](PeerConfigurer* bob) {
+    VideoConfig video(160, 120, 15);
+    video.stream_label = "bob-video";
+    bob->AddVideoConfig(std::move(video));
+  });
+  fixture()->AddQualityMetricsReporter(
+      std::make_unique<StatsBasedNetworkQualityMetricsReporter>(
+          std::map<std::string, std::vector<EmulatedEndpoint*>>(
+              {{"alice", network_links.first->endpoints()},
+               {"bob", network_links.second->endpoints()}}),
+          network_emulation()));
+  // Takes a fraction of this in real time.
+  RunAndCheckEachVideoStreamReceivedFrames(RunParams(TimeDelta::Seconds(60)));
+}
+
 // IOS debug builds can be quite slow, disabling to avoid issues with timeouts.
 #if defined(WEBRTC_IOS) && defined(WEBRTC_ARCH_ARM64) && !defined(NDEBUG)
 #define MAYBE_ChangeNetworkConditions DISABLED_ChangeNetworkConditions
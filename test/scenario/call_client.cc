@@ -236,6 +236,9 @@ CallClient::CallClient(
 
 CallClient::~CallClient() {
   SendTask([&] {
+    for (auto& senders : synthetic_senders_)
+      senders->Stop();
+    synthetic_senders_.clear();
     call_.reset();
     RTC_DCHECK(!module_thread_);  // Should be set to null in the lambda above.
     fake_audio_setup_ = {};
@@ -291,10 +294,27 @@ void CallClient::UpdateBitrateConstraints(
   });
 }
 
+SyntheticRtpSenderGroup* CallClient::CreateSyntheticRtpSenders(
+    SyntheticRtpSenderGroup::Config config) {
+  SyntheticRtpSenderGroup* senders = nullptr;
+  SendTask([&] {
+    synthetic_senders_.push_back(std::make_unique<SyntheticRtpSenderGroup>(
+        config, clock_, task_queue_.Get(), transport_.get()));
+    senders = synthetic_senders_.back().get();
+    senders->Start();
+  });
+  return senders;
+}
+
 void CallClient::OnPacketReceived(EmulatedIpPacket packet) {
   MediaType media_type = MediaType::ANY;
   if (IsRtpPacket(packet.data)) {
     media_type = ssrc_media_types_[ParseRtpSsrc(packet.data)];
+  } else if (!synthetic_senders_.empty() && IsRtcpPacket(packet.data)) {
+    task_queue_.PostTask([this, data = packet.data] {
+      for (auto& senders : synthetic_senders_)
+        senders->OnRtcpPacket(data);
+    });
   }
   task_queue_.PostTask(
       [call = call_.get(), media_type, packet = std::move(packet)]() mutable {
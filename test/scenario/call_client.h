@@ -29,6 +29,7 @@
 #include "test/scenario/column_printer.h"
 #include "test/scenario/network_node.h"
 #include "test/scenario/scenario_config.h"
+#include "test/synthetic_rtp_sender.h"
 
 namespace webrtc {
 
@@ -112,6 +113,12 @@ class CallClient : public EmulatedNetworkReceiverInterface {
   DataRate padding_rate() const;
   void UpdateBitrateConstraints(const BitrateConstraints& constraints);
   void SetRemoteBitrate(DataRate bitrate);
+  // Adds synthetic video senders that send over the routes of this client
+  // without capturing or encoding, e.g. to load a receiver with thousands of
+  // streams. RTCP received for their SSRCs is fed back to them. They are
+  // started right away and stopped when the client is destroyed.
+  SyntheticRtpSenderGroup* CreateSyntheticRtpSenders(
+      SyntheticRtpSenderGroup::Config config);
 
   void OnPacketReceived(EmulatedIpPacket packet) override;
   std::unique_ptr<RtcEventLogOutput> GetLogWriter(std::string name);
@@ -155,6 +162,7 @@ class CallClient : public EmulatedNetworkReceiverInterface {
   int next_audio_ssrc_index_ = 0;
   int next_audio_local_ssrc_index_ = 0;
   std::map<uint32_t, MediaType> ssrc_media_types_;
+  std::vector<std::unique_ptr<SyntheticRtpSenderGroup>> synthetic_senders_;
   // Defined last so it's destroyed first.
   TaskQueueForTest task_queue_;
 
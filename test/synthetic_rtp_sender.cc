@@ -0,0 +1,351 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "test/synthetic_rtp_sender.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "api/units/data_size.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/common_header.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/fir.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/nack.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/pli.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/psfb.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/receiver_report.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/rtpfb.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/sender_report.h"
+#include "modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+constexpr int kVideoRtpTicksPerSecond = 90000;
+
+// Loss based rate control as in GoogCC: back off on high loss, probe upwards
+// on low loss.
+constexpr double kHighLossThreshold = 0.1;
+constexpr double kLowLossThreshold = 0.02;
+constexpr double kIncreaseFactor = 1.08;
+
+}  // namespace
+
+SyntheticRtpSender::SyntheticRtpSender(const Config& config,
+                                       Clock* clock,
+                                       Transport* transport,
+                                       uint16_t* transport_sequence_number,
+                                       uint64_t random_seed)
+    : config_(config),
+      clock_(clock),
+      transport_(transport),
+      transport_sequence_number_(transport_sequence_number),
+      random_(random_seed),
+      target_rate_(config.start_rate),
+      sequence_number_(random_.Rand<uint16_t>()),
+      rtp_timestamp_offset_(random_.Rand<uint32_t>()) {
+  RTC_DCHECK_GT(config_.framerate, 0);
+  if (config_.transport_sequence_number_id != 0) {
+    extensions_.Register<TransportSequenceNumber>(
+        config_.transport_sequence_number_id);
+  }
+}
+
+SyntheticRtpSender::~SyntheticRtpSender() = default;
+
+void SyntheticRtpSender::SetFirstFrameTime(Timestamp first_frame_time) {
+  next_frame_time_ = first_frame_time;
+  next_key_frame_time_ = first_frame_time;
+  next_rtcp_time_ = first_frame_time + config_.rtcp_interval;
+}
+
+void SyntheticRtpSender::Process(Timestamp now) {
+  if (now >= next_frame_time_) {
+    SendFrame(now);
+    next_frame_time_ += TimeDelta::Seconds(1) / config_.framerate;
+  }
+  if (now >= next_rtcp_time_) {
+    SendSenderReport(now);
+    next_rtcp_time_ = now + config_.rtcp_interval;
+  }
+}
+
+void SyntheticRtpSender::OnReportBlock(const rtcp::ReportBlock& report_block) {
+  const double loss = report_block.fraction_lost() / 256.0;
+  if (loss > kHighLossThreshold) {
+    target_rate_ = target_rate_ * (1 - 0.5 * loss);
+  } else if (loss < kLowLossThreshold) {
+    target_rate_ = target_rate_ * kIncreaseFactor;
+  }
+  target_rate_ = std::min(std::max(target_rate_, config_.min_rate),
+                          config_.max_rate);
+}
+
+void SyntheticRtpSender::OnNack(
+    rtc::ArrayView<const uint16_t> sequence_numbers) {
+  ++stats_.nack_requests;
+  CullHistory(clock_->CurrentTime());
+  if (history_.empty())
+    return;
+  const uint16_t first_sequence_number =
+      history_.front().second.SequenceNumber();
+  for (uint16_t sequence_number : sequence_numbers) {
+    const uint16_t index = sequence_number - first_sequence_number;
+    if (index >= history_.size())
+      continue;
+    ++stats_.retransmissions;
+    SendPacket(history_[index].second, /*allow_loss=*/false);
+  }
+}
+
+void SyntheticRtpSender::OnKeyFrameRequest() {
+  ++stats_.key_frame_requests;
+  key_frame_requested_ = true;
+}
+
+SyntheticRtpSender::Stats SyntheticRtpSender::GetStats() const {
+  Stats stats = stats_;
+  stats.target_rate = target_rate_;
+  return stats;
+}
+
+void SyntheticRtpSender::SendFrame(Timestamp now) {
+  CullHistory(now);
+  const bool key_frame = key_frame_requested_ || now >= next_key_frame_time_;
+  if (key_frame) {
+    key_frame_requested_ = false;
+    next_key_frame_time_ = now + config_.key_frame_interval;
+    ++stats_.key_frames;
+  }
+  ++stats_.frames;
+
+  // Delta frames are shrunk so that the average rate over a key frame interval
+  // matches the target rate.
+  const TimeDelta frame_interval = TimeDelta::Seconds(1) / config_.framerate;
+  const double frames_per_key_frame =
+      std::max(1.0, config_.key_frame_interval / frame_interval);
+  double frame_size = (target_rate_ * frame_interval).bytes<double>() *
+                      frames_per_key_frame /
+                      (frames_per_key_frame - 1 + config_.key_frame_size_factor);
+  if (key_frame)
+    frame_size *= config_.key_frame_size_factor;
+  frame_size *=
+      1 + config_.frame_size_spread * (2 * random_.Rand<double>() - 1);
+  const size_t frame_bytes = std::max<size_t>(1, frame_size);
+
+  RtpPacketToSend header(&extensions_, config_.max_packet_size);
+  header.SetPayloadType(config_.payload_type);
+  header.SetSsrc(config_.ssrc);
+  header.SetTimestamp(RtpTimestamp(now));
+  if (config_.transport_sequence_number_id != 0)
+    header.ReserveExtension<TransportSequenceNumber>();
+  header.set_packet_type(RtpPacketMediaType::kVideo);
+  RTC_CHECK_GT(config_.max_packet_size, header.headers_size());
+
+  // Split the frame into packets of about equal size, as the packetizers do.
+  const size_t max_payload_size =
+      config_.max_packet_size - header.headers_size();
+  const size_t num_packets =
+      (frame_bytes + max_payload_size - 1) / max_payload_size;
+  for (size_t i = 0; i < num_packets; ++i) {
+    const size_t payload_size =
+        frame_bytes / num_packets + (i < frame_bytes % num_packets ? 1 : 0);
+    RtpPacketToSend packet = header;
+    packet.SetSequenceNumber(sequence_number_++);
+    packet.SetMarker(i == num_packets - 1);
+    memset(packet.AllocatePayload(payload_size), 0, payload_size);
+    ++sender_report_packet_count_;
+    sender_report_octet_count_ += payload_size;
+    history_.emplace_back(now, packet);
+    SendPacket(packet, /*allow_loss=*/true);
+  }
+}
+
+void SyntheticRtpSender::SendPacket(const RtpPacketToSend& packet,
+                                    bool allow_loss) {
+  RtpPacketToSend to_send = packet;
+  PacketOptions options;
+  if (config_.transport_sequence_number_id != 0) {
+    options.packet_id = ++*transport_sequence_number_;
+    to_send.SetExtension<TransportSequenceNumber>(options.packet_id);
+    options.included_in_feedback = true;
+  }
+  if (allow_loss && config_.loss_rate > 0 &&
+      random_.Rand<double>() < config_.loss_rate) {
+    ++stats_.packets_dropped;
+    return;
+  }
+  ++stats_.packets_sent;
+  stats_.bytes_sent += to_send.size();
+  transport_->SendRtp(to_send.data(), to_send.size(), options);
+}
+
+void SyntheticRtpSender::SendSenderReport(Timestamp now) {
+  rtcp::SenderReport sender_report;
+  sender_report.SetSenderSsrc(config_.ssrc);
+  sender_report.SetNtp(clock_->ConvertTimestampToNtpTime(now));
+  sender_report.SetRtpTimestamp(RtpTimestamp(now));
+  sender_report.SetPacketCount(sender_report_packet_count_);
+  sender_report.SetOctetCount(sender_report_octet_count_);
+  rtc::Buffer packet = sender_report.Build();
+  transport_->SendRtcp(packet.data(), packet.size());
+}
+
+void SyntheticRtpSender::CullHistory(Timestamp now) {
+  while (!history_.empty() &&
+         history_.front().first < now - config_.packet_history) {
+    history_.pop_front();
+  }
+}
+
+uint32_t SyntheticRtpSender::RtpTimestamp(Timestamp time) const {
+  return rtp_timestamp_offset_ +
+         static_cast<uint32_t>(time.us() * kVideoRtpTicksPerSecond /
+                               rtc::kNumMicrosecsPerSec);
+}
+
+SyntheticRtpSenderGroup::SyntheticRtpSenderGroup(const Config& config,
+                                                 Clock* clock,
+                                                 TaskQueueBase* task_queue,
+                                                 Transport* transport)
+    : config_(config), clock_(clock), task_queue_(task_queue) {
+  RTC_DCHECK_GT(config_.num_senders, 0);
+  sequence_checker_.Detach();
+  for (int i = 0; i < config_.num_senders; ++i) {
+    SyntheticRtpSender::Config sender_config = config_.sender;
+    sender_config.ssrc = config_.first_ssrc + i;
+    senders_.push_back(std::make_unique<SyntheticRtpSender>(
+        sender_config, clock_, transport, &transport_sequence_number_,
+        /*random_seed=*/static_cast<uint64_t>(sender_config.ssrc) + 1));
+  }
+}
+
+SyntheticRtpSenderGroup::~SyntheticRtpSenderGroup() {
+  RTC_DCHECK(!process_task_.Running());
+}
+
+void SyntheticRtpSenderGroup::Start() {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  const Timestamp now = clock_->CurrentTime();
+  const TimeDelta frame_interval =
+      TimeDelta::Seconds(1) / config_.sender.framerate;
+  for (int i = 0; i < config_.num_senders; ++i) {
+    senders_[i]->SetFirstFrameTime(now +
+                                   frame_interval * i / config_.num_senders);
+  }
+  process_task_ = RepeatingTaskHandle::Start(
+      task_queue_,
+      [this] {
+        RTC_DCHECK_RUN_ON(&sequence_checker_);
+        const Timestamp now = clock_->CurrentTime();
+        for (const auto& sender : senders_)
+          sender->Process(now);
+        return config_.process_interval;
+      },
+      clock_);
+}
+
+void SyntheticRtpSenderGroup::Stop() {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  process_task_.Stop();
+}
+
+void SyntheticRtpSenderGroup::OnRtcpPacket(
+    rtc::ArrayView<const uint8_t> packet) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  rtcp::CommonHeader header;
+  const uint8_t* const end = packet.data() + packet.size();
+  for (const uint8_t* next = packet.data(); next != end;
+       next = header.NextPacket()) {
+    if (!header.Parse(next, end - next))
+      return;
+    switch (header.type()) {
+      case rtcp::SenderReport::kPacketType: {
+        rtcp::SenderReport sender_report;
+        if (!sender_report.Parse(header))
+          break;
+        for (const rtcp::ReportBlock& block : sender_report.report_blocks()) {
+          if (SyntheticRtpSender* sender = FindSender(block.source_ssrc()))
+            sender->OnReportBlock(block);
+        }
+        break;
+      }
+      case rtcp::ReceiverReport::kPacketType: {
+        rtcp::ReceiverReport receiver_report;
+        if (!receiver_report.Parse(header))
+          break;
+        for (const rtcp::ReportBlock& block :
+             receiver_report.report_blocks()) {
+          if (SyntheticRtpSender* sender = FindSender(block.source_ssrc()))
+            sender->OnReportBlock(block);
+        }
+        break;
+      }
+      case rtcp::Rtpfb::kPacketType: {
+        rtcp::Nack nack;
+        if (header.fmt() != rtcp::Nack::kFeedbackMessageType ||
+            !nack.Parse(header)) {
+          break;
+        }
+        if (SyntheticRtpSender* sender = FindSender(nack.media_ssrc()))
+          sender->OnNack(nack.packet_ids());
+        break;
+      }
+      case rtcp::Psfb::kPacketType: {
+        if (header.fmt() == rtcp::Pli::kFeedbackMessageType) {
+          rtcp::Pli pli;
+          if (!pli.Parse(header))
+            break;
+          if (SyntheticRtpSender* sender = FindSender(pli.media_ssrc()))
+            sender->OnKeyFrameRequest();
+        } else if (header.fmt() == rtcp::Fir::kFeedbackMessageType) {
+          rtcp::Fir fir;
+          if (!fir.Parse(header))
+            break;
+          for (const rtcp::Fir::Request& request : fir.requests()) {
+            if (SyntheticRtpSender* sender = FindSender(request.ssrc))
+              sender->OnKeyFrameRequest();
+          }
+        }
+        break;
+      }
+    }
+  }
+}
+
+SyntheticRtpSender::Stats SyntheticRtpSenderGroup::GetStats() const {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  SyntheticRtpSender::Stats total;
+  for (const auto& sender : senders_) {
+    SyntheticRtpSender::Stats stats = sender->GetStats();
+    total.frames += stats.frames;
+    total.key_frames += stats.key_frames;
+    total.packets_sent += stats.packets_sent;
+    total.bytes_sent += stats.bytes_sent;
+    total.packets_dropped += stats.packets_dropped;
+    total.retransmissions += stats.retransmissions;
+    total.nack_requests += stats.nack_requests;
+    total.key_frame_requests += stats.key_frame_requests;
+    total.target_rate += stats.target_rate;
+  }
+  return total;
+}
+
+SyntheticRtpSender* SyntheticRtpSenderGroup::FindSender(uint32_t ssrc) {
+  // SSRCs are consecutive, so the index is the offset from the first one.
+  const uint32_t index = ssrc - config_.first_ssrc;
+  return index < senders_.size() ? senders_[index].get() : nullptr;
+}
+
+}  // namespace test
+}  // namespace webrtc
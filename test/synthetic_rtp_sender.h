@@ -0,0 +1,179 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef TEST_SYNTHETIC_RTP_SENDER_H_
+#define TEST_SYNTHETIC_RTP_SENDER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/call/transport.h"
+#include "api/sequence_checker.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/units/data_rate.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/report_block.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/random.h"
+#include "rtc_base/system/no_unique_address.h"
+#include "rtc_base/task_utils/repeating_task.h"
+#include "rtc_base/thread_annotations.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+namespace test {
+
+// A video sender that produces RTP packets with the size and timing of an
+// encoded stream, without capturing or encoding anything. It answers NACKs from
+// its packet history, sends a key frame on PLI and FIR, and adapts its rate to
+// the loss reported in receiver reports. It's cheap enough to run thousands of
+// them, e.g. to load a server with realistic receive traffic.
+class SyntheticRtpSender {
+ public:
+  struct Config {
+    uint32_t ssrc = 0;
+    uint8_t payload_type = 96;
+    DataRate start_rate = DataRate::KilobitsPerSec(300);
+    DataRate min_rate = DataRate::KilobitsPerSec(30);
+    DataRate max_rate = DataRate::KilobitsPerSec(2500);
+    double framerate = 30;
+    // Key frames are sent at this interval and on request.
+    TimeDelta key_frame_interval = TimeDelta::Seconds(10);
+    // Size of key frames relative to delta frames.
+    double key_frame_size_factor = 5;
+    // Frame sizes are spread uniformly by this fraction around their average.
+    double frame_size_spread = 0.2;
+    size_t max_packet_size = 1200;
+    // Fraction of packets that are dropped instead of sent, to exercise the
+    // NACK path of the receiver.
+    double loss_rate = 0;
+    TimeDelta rtcp_interval = TimeDelta::Seconds(1);
+    TimeDelta packet_history = TimeDelta::Seconds(1);
+    // Transport-wide sequence numbers are added if non-zero.
+    int transport_sequence_number_id = 0;
+  };
+
+  struct Stats {
+    int64_t frames = 0;
+    int64_t key_frames = 0;
+    int64_t packets_sent = 0;
+    int64_t bytes_sent = 0;
+    int64_t packets_dropped = 0;
+    int64_t retransmissions = 0;
+    int64_t nack_requests = 0;
+    int64_t key_frame_requests = 0;
+    DataRate target_rate = DataRate::Zero();
+  };
+
+  // `transport_sequence_number` is shared by all senders on the same transport
+  // and must outlive the sender.
+  SyntheticRtpSender(const Config& config,
+                     Clock* clock,
+                     Transport* transport,
+                     uint16_t* transport_sequence_number,
+                     uint64_t random_seed);
+  ~SyntheticRtpSender();
+
+  // Nothing is sent before the first frame time.
+  void SetFirstFrameTime(Timestamp first_frame_time);
+  // Sends the frames and RTCP that are due at `now`.
+  void Process(Timestamp now);
+
+  // Feedback from the receiver.
+  void OnReportBlock(const rtcp::ReportBlock& report_block);
+  void OnNack(rtc::ArrayView<const uint16_t> sequence_numbers);
+  void OnKeyFrameRequest();
+
+  uint32_t ssrc() const { return config_.ssrc; }
+  Stats GetStats() const;
+
+ private:
+  void SendFrame(Timestamp now);
+  void SendPacket(const RtpPacketToSend& packet, bool allow_loss);
+  void SendSenderReport(Timestamp now);
+  void CullHistory(Timestamp now);
+  uint32_t RtpTimestamp(Timestamp time) const;
+
+  const Config config_;
+  Clock* const clock_;
+  Transport* const transport_;
+  uint16_t* const transport_sequence_number_;
+  RtpHeaderExtensionMap extensions_;
+  Random random_;
+
+  DataRate target_rate_;
+  uint16_t sequence_number_;
+  uint32_t rtp_timestamp_offset_;
+  Timestamp next_frame_time_ = Timestamp::PlusInfinity();
+  Timestamp next_key_frame_time_ = Timestamp::MinusInfinity();
+  Timestamp next_rtcp_time_ = Timestamp::MinusInfinity();
+  Timestamp last_frame_time_ = Timestamp::MinusInfinity();
+  bool key_frame_requested_ = true;
+  // Media packets and payload bytes, as reported in sender reports.
+  uint32_t sender_report_packet_count_ = 0;
+  uint32_t sender_report_octet_count_ = 0;
+  // Sent packets in sequence number order, without gaps.
+  std::deque<std::pair<Timestamp, RtpPacketToSend>> history_;
+  Stats stats_;
+};
+
+// Runs a group of synthetic senders on one task queue and one transport. The
+// senders get consecutive SSRCs and staggered frame times, so the traffic of
+// the group is spread over the frame interval.
+class SyntheticRtpSenderGroup {
+ public:
+  struct Config {
+    int num_senders = 1;
+    uint32_t first_ssrc = 0x10000;
+    // Applied to every sender, except for the SSRC.
+    SyntheticRtpSender::Config sender;
+    TimeDelta process_interval = TimeDelta::Millis(5);
+  };
+
+  SyntheticRtpSenderGroup(const Config& config,
+                          Clock* clock,
+                          TaskQueueBase* task_queue,
+                          Transport* transport);
+  ~SyntheticRtpSenderGroup();
+
+  // Must be called on `task_queue`.
+  void Start();
+  void Stop();
+  // Dispatches RTCP from the receiver to the senders it's about. Must be called
+  // on `task_queue`.
+  void OnRtcpPacket(rtc::ArrayView<const uint8_t> packet);
+
+  // Sum of the stats of all senders. Must be called on `task_queue`.
+  SyntheticRtpSender::Stats GetStats() const;
+
+ private:
+  SyntheticRtpSender* FindSender(uint32_t ssrc);
+
+  const Config config_;
+  Clock* const clock_;
+  TaskQueueBase* const task_queue_;
+  RTC_NO_UNIQUE_ADDRESS SequenceChecker sequence_checker_;
+  uint16_t transport_sequence_number_ RTC_GUARDED_BY(sequence_checker_) = 0;
+  std::vector<std::unique_ptr<SyntheticRtpSender>> senders_
+      RTC_GUARDED_BY(sequence_checker_);
+  RepeatingTaskHandle process_task_ RTC_GUARDED_BY(sequence_checker_);
+};
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // TEST_SYNTHETIC_RTP_SENDER_H_
@@ -0,0 +1,223 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "test/synthetic_rtp_sender.h"
+
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "modules/rtp_rtcp/source/rtcp_packet/compound_packet.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/nack.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/pli.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/receiver_report.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/task_utils/to_queued_task.h"
+#include "test/gtest.h"
+#include "test/time_controller/simulated_time_controller.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+constexpr uint32_t kSsrc = 0x1234;
+constexpr TimeDelta kProcessInterval = TimeDelta::Millis(5);
+
+class RecordingTransport : public Transport {
+ public:
+  bool SendRtp(const uint8_t* packet,
+               size_t length,
+               const PacketOptions& options) override {
+    RtpPacketReceived parsed;
+    EXPECT_TRUE(parsed.Parse(packet, length));
+    packets_.push_back(parsed);
+    bytes_ += length;
+    return true;
+  }
+  bool SendRtcp(const uint8_t* packet, size_t length) override {
+    ++num_rtcp_packets_;
+    return true;
+  }
+
+  const std::vector<RtpPacketReceived>& packets() const { return packets_; }
+  size_t bytes() const { return bytes_; }
+  int num_rtcp_packets() const { return num_rtcp_packets_; }
+
+ private:
+  std::vector<RtpPacketReceived> packets_;
+  size_t bytes_ = 0;
+  int num_rtcp_packets_ = 0;
+};
+
+class SyntheticRtpSenderTest : public ::testing::Test {
+ protected:
+  SyntheticRtpSenderTest() : clock_(Timestamp::Seconds(1000)) {
+    config_.ssrc = kSsrc;
+  }
+
+  std::unique_ptr<SyntheticRtpSender> CreateSender() {
+    auto sender = std::make_unique<SyntheticRtpSender>(
+        config_, &clock_, &transport_, &transport_sequence_number_,
+        /*random_seed=*/1);
+    sender->SetFirstFrameTime(clock_.CurrentTime());
+    return sender;
+  }
+
+  void Run(SyntheticRtpSender& sender, TimeDelta duration) {
+    const Timestamp end = clock_.CurrentTime() + duration;
+    while (clock_.CurrentTime() < end) {
+      sender.Process(clock_.CurrentTime());
+      clock_.AdvanceTime(kProcessInterval);
+    }
+  }
+
+  SimulatedClock clock_;
+  RecordingTransport transport_;
+  uint16_t transport_sequence_number_ = 0;
+  SyntheticRtpSender::Config config_;
+};
+
+TEST_F(SyntheticRtpSenderTest, SendsFramesAtTargetRate) {
+  config_.start_rate = DataRate::KilobitsPerSec(500);
+  config_.max_rate = config_.start_rate;
+  config_.key_frame_interval = TimeDelta::Seconds(5);
+  std::unique_ptr<SyntheticRtpSender> sender = CreateSender();
+  Run(*sender, TimeDelta::Seconds(10));
+
+  SyntheticRtpSender::Stats stats = sender->GetStats();
+  EXPECT_EQ(stats.frames, 300);
+  EXPECT_EQ(stats.key_frames, 2);
+  EXPECT_EQ(stats.packets_sent,
+            static_cast<int64_t>(transport_.packets().size()));
+  EXPECT_NEAR(transport_.bytes() * 8 / 10, 500'000, 50'000);
+
+  int num_frames = 0;
+  for (size_t i = 0; i < transport_.packets().size(); ++i) {
+    const RtpPacketReceived& packet = transport_.packets()[i];
+    EXPECT_EQ(packet.Ssrc(), kSsrc);
+    EXPECT_LE(packet.size(), config_.max_packet_size);
+    if (i > 0) {
+      EXPECT_EQ(packet.SequenceNumber(),
+                static_cast<uint16_t>(
+                    transport_.packets()[i - 1].SequenceNumber() + 1));
+    }
+    if (packet.Marker())
+      ++num_frames;
+  }
+  EXPECT_EQ(num_frames, 300);
+  EXPECT_GE(transport_.num_rtcp_packets(), 9);
+}
+
+TEST_F(SyntheticRtpSenderTest, SendsKeyFrameOnRequest) {
+  config_.key_frame_interval = TimeDelta::Seconds(100);
+  std::unique_ptr<SyntheticRtpSender> sender = CreateSender();
+  Run(*sender, TimeDelta::Seconds(1));
+  EXPECT_EQ(sender->GetStats().key_frames, 1);
+
+  sender->OnKeyFrameRequest();
+  Run(*sender, TimeDelta::Seconds(1));
+  EXPECT_EQ(sender->GetStats().key_frames, 2);
+  EXPECT_EQ(sender->GetStats().key_frame_requests, 1);
+}
+
+TEST_F(SyntheticRtpSenderTest, RetransmitsNackedPacketsFromHistory) {
+  config_.loss_rate = 0.1;
+  std::unique_ptr<SyntheticRtpSender> sender = CreateSender();
+  Run(*sender, TimeDelta::Millis(500));
+  const SyntheticRtpSender::Stats stats = sender->GetStats();
+  ASSERT_GT(stats.packets_dropped, 0);
+
+  const uint16_t sent = transport_.packets().front().SequenceNumber();
+  const uint16_t unknown = sent - 1;
+  const std::vector<uint16_t> nacked = {sent, unknown};
+  sender->OnNack(nacked);
+  EXPECT_EQ(sender->GetStats().retransmissions, 1);
+  EXPECT_EQ(transport_.packets().back().SequenceNumber(), sent);
+
+  // Packets older than the history aren't retransmitted.
+  Run(*sender, config_.packet_history + TimeDelta::Millis(100));
+  sender->OnNack(nacked);
+  EXPECT_EQ(sender->GetStats().retransmissions, 1);
+  EXPECT_EQ(sender->GetStats().nack_requests, 2);
+}
+
+TEST_F(SyntheticRtpSenderTest, AdaptsRateToReportedLoss) {
+  config_.start_rate = DataRate::KilobitsPerSec(1000);
+  std::unique_ptr<SyntheticRtpSender> sender = CreateSender();
+
+  rtcp::ReportBlock report_block;
+  report_block.SetMediaSsrc(kSsrc);
+  report_block.SetFractionLost(256 * 0.2);
+  sender->OnReportBlock(report_block);
+  EXPECT_LT(sender->GetStats().target_rate, config_.start_rate);
+
+  const DataRate reduced_rate = sender->GetStats().target_rate;
+  report_block.SetFractionLost(0);
+  sender->OnReportBlock(report_block);
+  EXPECT_GT(sender->GetStats().target_rate, reduced_rate);
+
+  for (int i = 0; i < 100; ++i)
+    sender->OnReportBlock(report_block);
+  EXPECT_EQ(sender->GetStats().target_rate, config_.max_rate);
+}
+
+TEST(SyntheticRtpSenderGroupTest, DispatchesFeedbackBySsrc) {
+  GlobalSimulatedTimeController time_controller(Timestamp::Seconds(1000));
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> task_queue =
+      time_controller.GetTaskQueueFactory()->CreateTaskQueue(
+          "SyntheticRtpSenderGroup", TaskQueueFactory::Priority::NORMAL);
+  RecordingTransport transport;
+  SyntheticRtpSenderGroup::Config config;
+  config.num_senders = 3;
+  config.first_ssrc = 100;
+  config.sender.transport_sequence_number_id = 1;
+  SyntheticRtpSenderGroup group(config, time_controller.GetClock(),
+                                task_queue.get(), &transport);
+  task_queue->PostTask(ToQueuedTask([&] { group.Start(); }));
+  // Just short of the 31st frame of the first sender.
+  time_controller.AdvanceTime(TimeDelta::Millis(995));
+
+  std::map<uint32_t, uint16_t> last_sequence_numbers;
+  for (const RtpPacketReceived& packet : transport.packets())
+    last_sequence_numbers[packet.Ssrc()] = packet.SequenceNumber();
+  EXPECT_EQ(last_sequence_numbers.size(), 3u);
+
+  auto pli = std::make_unique<rtcp::Pli>();
+  pli->SetMediaSsrc(101);
+  auto unknown_pli = std::make_unique<rtcp::Pli>();
+  unknown_pli->SetMediaSsrc(200);
+  auto nack = std::make_unique<rtcp::Nack>();
+  nack->SetMediaSsrc(102);
+  nack->SetPacketIds({last_sequence_numbers[102]});
+  rtcp::CompoundPacket compound;
+  compound.Append(std::move(pli));
+  compound.Append(std::move(unknown_pli));
+  compound.Append(std::move(nack));
+  rtc::Buffer feedback = compound.Build();
+
+  SyntheticRtpSender::Stats stats;
+  task_queue->PostTask(ToQueuedTask([&] {
+    group.OnRtcpPacket(feedback);
+    stats = group.GetStats();
+    group.Stop();
+  }));
+  time_controller.AdvanceTime(TimeDelta::Zero());
+  EXPECT_EQ(stats.key_frame_requests, 1);
+  EXPECT_EQ(stats.nack_requests, 1);
+  EXPECT_EQ(stats.retransmissions, 1);
+  EXPECT_EQ(stats.frames, 3 * 30);
+  EXPECT_EQ(stats.packets_sent,
+            static_cast<int64_t>(transport.packets().size()));
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace webrtc
@@ -518,7 +518,8 @@ OveruseFrameDetector::CreateProcessingUsage(const CpuOveruseOptions& options) {
 
 OveruseFrameDetector::OveruseFrameDetector(
     CpuOveruseMetricsObserver* metrics_observer)
-    : metrics_observer_(metrics_observer),
+    : overuse_observer_(nullptr),
+      metrics_observer_(metrics_observer),
       num_process_times_(0),
       // TODO(nisse): Use absl::optional
       last_capture_time_us_(-1),
@@ -529,10 +530,16 @@ OveruseFrameDetector::OveruseFrameDetector(
       num_overuse_detections_(0),
       last_rampup_time_ms_(-1),
       in_quick_rampup_(false),
-      current_rampup_delay_ms_(kStandardRampUpDelayMs) {
+      current_rampup_delay_ms_(kStandardRampUpDelayMs),
+      first_encoded_frame_time_ms_(-1),
+      last_predicted_overuse_time_ms_(-1) {
   task_checker_.Detach();
   ParseFieldTrial({&filter_time_constant_},
                   field_trial::FindFullName("WebRTC-CpuLoadEstimator"));
+  ParseFieldTrial(
+      {&predictive_, &predictive_window_, &predictive_horizon_,
+       &predictive_min_interval_, &max_queue_delay_frames_},
+      field_trial::FindFullName("WebRTC-CpuOveruseDetector-Predictive"));
 }
 
 OveruseFrameDetector::~OveruseFrameDetector() {}
@@ -546,6 +553,7 @@ void OveruseFrameDetector::StartCheckForOveruse(
   RTC_DCHECK(overuse_observer != nullptr);
 
   SetOptions(options);
+  overuse_observer_ = overuse_observer;
   check_overuse_task_ = RepeatingTaskHandle::DelayedStart(
       task_queue_base, TimeDelta::Millis(kTimeToFirstCheckForOveruseMs),
       [this, overuse_observer] {
@@ -556,6 +564,7 @@ void OveruseFrameDetector::StartCheckForOveruse(
 void OveruseFrameDetector::StopCheckForOveruse() {
   RTC_DCHECK_RUN_ON(&task_checker_);
   check_overuse_task_.Stop();
+  overuse_observer_ = nullptr;
 }
 
 void OveruseFrameDetector::EncodedFrameTimeMeasured(int encode_duration_ms) {
@@ -591,6 +600,8 @@ void OveruseFrameDetector::ResetAll(int num_pixels) {
   last_capture_time_us_ = -1;
   num_process_times_ = 0;
   encode_usage_percent_ = absl::nullopt;
+  encoded_frames_.clear();
+  first_encoded_frame_time_ms_ = -1;
   OnTargetFramerateUpdated(max_framerate_);
 }
 
@@ -620,6 +631,10 @@ void OveruseFrameDetector::FrameSent(uint32_t timestamp,
                                      int64_t capture_time_us,
                                      absl::optional<int> encode_duration_us) {
   RTC_DCHECK_RUN_ON(&task_checker_);
+  if (predictive_ && encode_duration_us) {
+    CheckForPredictedOveruse(capture_time_us, time_sent_in_us,
+                             *encode_duration_us);
+  }
   encode_duration_us = usage_->FrameSent(timestamp, time_sent_in_us,
                                          capture_time_us, encode_duration_us);
 
@@ -640,30 +655,13 @@ void OveruseFrameDetector::CheckForOveruse(
 
   int64_t now_ms = rtc::TimeMillis();
 
-  if (IsOverusing(*encode_usage_percent_)) {
-    // If the last thing we did was going up, and now have to back down, we need
-    // to check if this peak was short. If so we should back off to avoid going
-    // back and forth between this load, the system doesn't seem to handle it.
-    bool check_for_backoff = last_rampup_time_ms_ > last_overuse_time_ms_;
-    if (check_for_backoff) {
-      if (now_ms - last_rampup_time_ms_ < kStandardRampUpDelayMs ||
-          num_overuse_detections_ > kMaxOverusesBeforeApplyRampupDelay) {
-        // Going up was not ok for very long, back off.
-        current_rampup_delay_ms_ *= kRampUpBackoffFactor;
-        if (current_rampup_delay_ms_ > kMaxRampUpDelayMs)
-          current_rampup_delay_ms_ = kMaxRampUpDelayMs;
-      } else {
-        // Not currently backing off, reset rampup delay.
-        current_rampup_delay_ms_ = kStandardRampUpDelayMs;
-      }
-    }
-
-    last_overuse_time_ms_ = now_ms;
-    in_quick_rampup_ = false;
+  if (last_predicted_overuse_time_ms_ != -1 &&
+      now_ms - last_predicted_overuse_time_ms_ < kCheckForOveruseIntervalMs) {
+    // The usage filter still reflects the load from before the predictive
+    // adaptation, give it time to take effect.
     checks_above_threshold_ = 0;
-    ++num_overuse_detections_;
-
-    observer->AdaptDown();
+  } else if (IsOverusing(*encode_usage_percent_)) {
+    OnOveruse(observer, now_ms);
   } else if (IsUnderusing(*encode_usage_percent_, now_ms)) {
     last_rampup_time_ms_ = now_ms;
     in_quick_rampup_ = true;
@@ -681,6 +679,110 @@ void OveruseFrameDetector::CheckForOveruse(
                       << rampup_delay;
 }
 
+void OveruseFrameDetector::OnOveruse(
+    OveruseFrameDetectorObserverInterface* observer,
+    int64_t now_ms) {
+  RTC_DCHECK_RUN_ON(&task_checker_);
+  // If the last thing we did was going up, and now have to back down, we need
+  // to check if this peak was short. If so we should back off to avoid going
+  // back and forth between this load, the system doesn't seem to handle it.
+  bool check_for_backoff = last_rampup_time_ms_ > last_overuse_time_ms_;
+  if (check_for_backoff) {
+    if (now_ms - last_rampup_time_ms_ < kStandardRampUpDelayMs ||
+        num_overuse_detections_ > kMaxOverusesBeforeApplyRampupDelay) {
+      // Going up was not ok for very long, back off.
+      current_rampup_delay_ms_ *= kRampUpBackoffFactor;
+      if (current_rampup_delay_ms_ > kMaxRampUpDelayMs)
+        current_rampup_delay_ms_ = kMaxRampUpDelayMs;
+    } else {
+      // Not currently backing off, reset rampup delay.
+      current_rampup_delay_ms_ = kStandardRampUpDelayMs;
+    }
+  }
+
+  last_overuse_time_ms_ = now_ms;
+  in_quick_rampup_ = false;
+  checks_above_threshold_ = 0;
+  ++num_overuse_detections_;
+
+  observer->AdaptDown();
+}
+
+void OveruseFrameDetector::CheckForPredictedOveruse(int64_t capture_time_us,
+                                                    int64_t time_sent_in_us,
+                                                    int encode_duration_us) {
+  RTC_DCHECK_RUN_ON(&task_checker_);
+  const int64_t now_ms = rtc::TimeMillis();
+  const int64_t queue_delay_us =
+      std::max<int64_t>(time_sent_in_us - capture_time_us, 0);
+  if (!encoded_frames_.empty() &&
+      encoded_frames_.back().capture_time_us == capture_time_us) {
+    // Another layer of the same input frame, count the layers as encoded in
+    // parallel like SendProcessingUsage2 does.
+    EncodedFrameSample& sample = encoded_frames_.back();
+    sample.encode_duration_us =
+        std::max(sample.encode_duration_us, encode_duration_us);
+    sample.queue_delay_us = std::max(sample.queue_delay_us, queue_delay_us);
+  } else {
+    encoded_frames_.push_back(
+        {capture_time_us, now_ms, encode_duration_us, queue_delay_us});
+  }
+  if (first_encoded_frame_time_ms_ == -1)
+    first_encoded_frame_time_ms_ = now_ms;
+
+  const int64_t window_ms = predictive_window_->ms();
+  while (!encoded_frames_.empty() &&
+         encoded_frames_.front().time_ms < now_ms - window_ms)
+    encoded_frames_.pop_front();
+  if (!overuse_observer_ || now_ms - first_encoded_frame_time_ms_ < window_ms ||
+      (last_overuse_time_ms_ != -1 &&
+       now_ms - last_overuse_time_ms_ < predictive_min_interval_->ms())) {
+    return;
+  }
+
+  // Compare the load of the newer half of the window to that of the older
+  // half, and extrapolate the trend.
+  const int64_t half_window_ms = window_ms / 2;
+  int64_t older_encode_time_us = 0;
+  int64_t newer_encode_time_us = 0;
+  int64_t newer_queue_delay_us = 0;
+  int newer_frames = 0;
+  for (const EncodedFrameSample& sample : encoded_frames_) {
+    if (sample.time_ms < now_ms - half_window_ms) {
+      older_encode_time_us += sample.encode_duration_us;
+    } else {
+      newer_encode_time_us += sample.encode_duration_us;
+      newer_queue_delay_us += sample.queue_delay_us;
+      ++newer_frames;
+    }
+  }
+  const double older_load =
+      older_encode_time_us / (10.0 * std::max<int64_t>(half_window_ms, 1));
+  const double newer_load =
+      newer_encode_time_us / (10.0 * std::max<int64_t>(half_window_ms, 1));
+  const double predicted_load =
+      newer_load + (newer_load - older_load) * predictive_horizon_->ms() /
+                       std::max<int64_t>(half_window_ms, 1);
+  const double frame_interval_us =
+      rtc::kNumMicrosecsPerSec / std::max(kMinFramerate, max_framerate_);
+  const bool queue_falls_behind =
+      newer_frames > 0 && newer_queue_delay_us / newer_frames >
+                              max_queue_delay_frames_ * frame_interval_us;
+  if (predicted_load < options_.high_encode_usage_threshold_percent &&
+      !queue_falls_behind) {
+    return;
+  }
+
+  RTC_LOG(LS_INFO) << "Predicted CPU overuse, encode usage " << newer_load
+                   << "% trending to " << predicted_load << "%, queue delay "
+                   << newer_queue_delay_us / std::max(newer_frames, 1)
+                   << " us.";
+  last_predicted_overuse_time_ms_ = now_ms;
+  encoded_frames_.clear();
+  first_encoded_frame_time_ms_ = -1;
+  OnOveruse(overuse_observer_, now_ms);
+}
+
 void OveruseFrameDetector::SetOptions(const CpuOveruseOptions& options) {
   RTC_DCHECK_RUN_ON(&task_checker_);
   options_ = options;
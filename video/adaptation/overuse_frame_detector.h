@@ -11,6 +11,7 @@
 #ifndef VIDEO_ADAPTATION_OVERUSE_FRAME_DETECTOR_H_
 #define VIDEO_ADAPTATION_OVERUSE_FRAME_DETECTOR_H_
 
+#include <deque>
 #include <list>
 #include <memory>
 
@@ -124,6 +125,14 @@ class OveruseFrameDetector {
 
  private:
   void EncodedFrameTimeMeasured(int encode_duration_ms);
+  // Adapts down ahead of the periodic check if the encode load of the last
+  // frames trends towards the overuse threshold, or if frames queue up
+  // between capture and send.
+  void CheckForPredictedOveruse(int64_t capture_time_us,
+                                int64_t time_sent_in_us,
+                                int encode_duration_us);
+  void OnOveruse(OveruseFrameDetectorObserverInterface* observer,
+                 int64_t now_ms);
   bool IsOverusing(int encode_usage_percent);
   bool IsUnderusing(int encode_usage_percent, int64_t time_now);
 
@@ -138,6 +147,8 @@ class OveruseFrameDetector {
   RTC_NO_UNIQUE_ADDRESS SequenceChecker task_checker_;
   // Owned by the task queue from where StartCheckForOveruse is called.
   RepeatingTaskHandle check_overuse_task_ RTC_GUARDED_BY(task_checker_);
+  OveruseFrameDetectorObserverInterface* overuse_observer_
+      RTC_GUARDED_BY(task_checker_);
 
   // Stats metrics.
   CpuOveruseMetricsObserver* const metrics_observer_;
@@ -159,9 +170,38 @@ class OveruseFrameDetector {
 
   std::unique_ptr<ProcessingUsage> usage_ RTC_PT_GUARDED_BY(task_checker_);
 
+  // Encoded frames of the last `predictive_window_`, for predictive overuse
+  // detection.
+  struct EncodedFrameSample {
+    int64_t capture_time_us;
+    int64_t time_ms;
+    int encode_duration_us;
+    int64_t queue_delay_us;
+  };
+  std::deque<EncodedFrameSample> encoded_frames_
+      RTC_GUARDED_BY(task_checker_);
+  int64_t first_encoded_frame_time_ms_ RTC_GUARDED_BY(task_checker_);
+  int64_t last_predicted_overuse_time_ms_ RTC_GUARDED_BY(task_checker_);
+
   // If set by field trial, overrides CpuOveruseOptions::filter_time_ms.
   FieldTrialOptional<TimeDelta> filter_time_constant_{"tau"};
 
+  // Predictive overuse detection, set by field trial.
+  FieldTrialFlag predictive_{"Enabled"};
+  // The encode load trend is measured over `predictive_window_` and
+  // extrapolated `predictive_horizon_` ahead.
+  FieldTrialParameter<TimeDelta> predictive_window_{"window",
+                                                    TimeDelta::Seconds(1)};
+  FieldTrialParameter<TimeDelta> predictive_horizon_{"horizon",
+                                                     TimeDelta::Seconds(1)};
+  // Minimum time between two predictive adaptations, so that each one takes
+  // effect before the next.
+  FieldTrialParameter<TimeDelta> predictive_min_interval_{
+      "min_interval", TimeDelta::Seconds(2)};
+  // Frames that take longer than this many frame intervals from capture to
+  // send mean that the encoder queue falls behind.
+  FieldTrialParameter<double> max_queue_delay_frames_{"queue_frames", 3.0};
+
   RTC_DISALLOW_COPY_AND_ASSIGN(OveruseFrameDetector);
 };
 
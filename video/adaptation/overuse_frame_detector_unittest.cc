@@ -20,6 +20,7 @@
 #include "rtc_base/fake_clock.h"
 #include "rtc_base/random.h"
 #include "rtc_base/task_queue_for_test.h"
+#include "test/field_trial.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
@@ -655,6 +656,98 @@ TEST_F(OveruseFrameDetectorTest, NoOveruseForSimulcast) {
   EXPECT_LE(UsagePercent(), 45);
 }
 
+// Sends frames whose encode time rises by `encode_time_step_us` per frame,
+// with the frames reaching the detector `queue_delay_us` after capture.
+// Returns the encode time of the frame that triggered AdaptDown(), or 0.
+int64_t SendFramesUntilAdaptDown(OveruseFrameDetector& detector,
+                                 MockCpuOveruseObserver& observer,
+                                 const CpuOveruseOptions& options,
+                                 rtc::ScopedFakeClock& clock,
+                                 int num_frames,
+                                 int64_t encode_time_us,
+                                 int64_t encode_time_step_us,
+                                 int64_t queue_delay_us) {
+  TaskQueueForTest queue("OveruseFrameDetectorTestQueue");
+  int64_t adapted_encode_time_us = 0;
+  EXPECT_CALL(observer, AdaptDown())
+      .WillRepeatedly(InvokeWithoutArgs([&] {
+        if (adapted_encode_time_us == 0)
+          adapted_encode_time_us = encode_time_us;
+      }));
+  queue.SendTask(
+      [&] {
+        detector.StartCheckForOveruse(queue.Get(), options, &observer);
+        VideoFrame frame =
+            VideoFrame::Builder()
+                .set_video_frame_buffer(I420Buffer::Create(kWidth, kHeight))
+                .set_rotation(webrtc::kVideoRotation_0)
+                .set_timestamp_us(0)
+                .build();
+        uint32_t timestamp = 0;
+        for (int i = 0; i < num_frames; ++i) {
+          frame.set_timestamp(timestamp);
+          int64_t capture_time_us = rtc::TimeMicros();
+          detector.FrameCaptured(frame, capture_time_us);
+          clock.AdvanceTime(TimeDelta::Micros(encode_time_us));
+          detector.FrameSent(timestamp, capture_time_us + queue_delay_us,
+                             capture_time_us, encode_time_us);
+          clock.AdvanceTime(
+              TimeDelta::Micros(kFrameIntervalUs - encode_time_us));
+          timestamp += kFrameIntervalUs * 90 / 1000;
+          encode_time_us += encode_time_step_us;
+        }
+        detector.StopCheckForOveruse();
+      },
+      RTC_FROM_HERE);
+  return adapted_encode_time_us;
+}
+
+TEST_F(OveruseFrameDetectorTest, PredictiveModeAdaptsDownBeforeOveruse) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-CpuOveruseDetector-Predictive/Enabled/");
+  OveruseFrameDetectorUnderTest detector(this);
+  // Encode time rises by 3 ms per second, and crosses the overuse threshold
+  // after about 6 seconds.
+  const int64_t overuse_encode_time_us =
+      kFrameIntervalUs * options_.high_encode_usage_threshold_percent / 100;
+  int64_t adapted_encode_time_us = SendFramesUntilAdaptDown(
+      detector, mock_observer_, options_, clock_, /*num_frames=*/200,
+      /*encode_time_us=*/10000, /*encode_time_step_us=*/100,
+      /*queue_delay_us=*/0);
+  EXPECT_GT(adapted_encode_time_us, 0);
+  EXPECT_LT(adapted_encode_time_us, overuse_encode_time_us);
+}
+
+TEST_F(OveruseFrameDetectorTest, PredictiveModeAdaptsDownWhenFramesQueueUp) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-CpuOveruseDetector-Predictive/Enabled/");
+  OveruseFrameDetectorUnderTest detector(this);
+  EXPECT_GT(SendFramesUntilAdaptDown(
+                detector, mock_observer_, options_, clock_,
+                /*num_frames=*/100, /*encode_time_us=*/10000,
+                /*encode_time_step_us=*/0, /*queue_delay_us=*/150000),
+            0);
+}
+
+TEST_F(OveruseFrameDetectorTest, PredictiveModeKeepsSteadyLoad) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-CpuOveruseDetector-Predictive/Enabled/");
+  OveruseFrameDetectorUnderTest detector(this);
+  EXPECT_EQ(SendFramesUntilAdaptDown(
+                detector, mock_observer_, options_, clock_,
+                /*num_frames=*/300, /*encode_time_us=*/20000,
+                /*encode_time_step_us=*/0, /*queue_delay_us=*/20000),
+            0);
+}
+
+TEST_F(OveruseFrameDetectorTest, NoPredictiveAdaptationByDefault) {
+  EXPECT_EQ(SendFramesUntilAdaptDown(
+                *overuse_detector_, mock_observer_, options_, clock_,
+                /*num_frames=*/200, /*encode_time_us=*/10000,
+                /*encode_time_step_us=*/100, /*queue_delay_us=*/0),
+            0);
+}
+
 // Tests using new cpu load estimator
 class OveruseFrameDetectorTest2 : public OveruseFrameDetectorTest {
  protected:
@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/encoded_frame_recorder.h"
+
+#include <utility>
+
+#include "api/array_view.h"
+#include "modules/video_coding/utility/ivf_file_writer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/task_utils/to_queued_task.h"
+
+namespace webrtc {
+
+struct EncodedFrameRecorder::Writer {
+  std::unique_ptr<IvfFileWriter> file;
+  bool got_key_frame = false;
+};
+
+EncodedFrameRecorder::EncodedFrameRecorder(TaskQueueBase* write_queue,
+                                           FileWrapper file,
+                                           size_t byte_limit)
+    : write_queue_(write_queue), writer_(std::make_unique<Writer>()) {
+  RTC_DCHECK(write_queue_);
+  writer_->file = IvfFileWriter::Wrap(std::move(file), byte_limit);
+}
+
+EncodedFrameRecorder::~EncodedFrameRecorder() {
+  write_queue_->PostTask(
+      ToQueuedTask([writer = std::move(writer_)] { writer->file->Close(); }));
+}
+
+void EncodedFrameRecorder::OnRecordableEncodedFrame(
+    const RecordableEncodedFrame& frame) {
+  write_queue_->PostTask(ToQueuedTask(
+      [writer = writer_.get(), buffer = frame.encoded_buffer(),
+       resolution = frame.resolution(), codec_type = frame.codec(),
+       is_key_frame = frame.is_key_frame(),
+       render_time_ms = frame.render_time().ms()] {
+        if (!writer->got_key_frame) {
+          if (!is_key_frame || resolution.empty())
+            return;
+          writer->got_key_frame = true;
+        }
+        writer->file->WriteFrame(
+            rtc::MakeArrayView(buffer->data(), buffer->size()),
+            resolution.width, resolution.height, render_time_ms, codec_type);
+      }));
+}
+
+void EncodedFrameRecorder::OnEncodedImage(const EncodedImage& encoded_image,
+                                          VideoCodecType codec_type) {
+  // Like RtpVideoSender, take the spatial index of codecs without spatial
+  // layers to be the simulcast stream.
+  if ((codec_type == kVideoCodecVP8 || codec_type == kVideoCodecH264 ||
+       codec_type == kVideoCodecGeneric) &&
+      encoded_image.SpatialIndex().value_or(0) != 0) {
+    return;
+  }
+  // Copying the image copies a reference to its data.
+  write_queue_->PostTask(
+      ToQueuedTask([writer = writer_.get(), encoded_image, codec_type] {
+        if (!writer->got_key_frame) {
+          if (encoded_image._frameType != VideoFrameType::kVideoFrameKey)
+            return;
+          writer->got_key_frame = true;
+        }
+        writer->file->WriteFrame(encoded_image, codec_type);
+      }));
+}
+
+}  // namespace webrtc
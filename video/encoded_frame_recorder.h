@@ -0,0 +1,66 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VIDEO_ENCODED_FRAME_RECORDER_H_
+#define VIDEO_ENCODED_FRAME_RECORDER_H_
+
+#include <stddef.h>
+
+#include <memory>
+
+#include "api/task_queue/task_queue_base.h"
+#include "api/video/encoded_image.h"
+#include "api/video/recordable_encoded_frame.h"
+#include "api/video/video_codec_type.h"
+#include "rtc_base/system/file_wrapper.h"
+
+namespace webrtc {
+
+// Records the encoded frames of a send or a receive stream to an IVF file
+// without decoding them. A frame is handed to `write_queue` with a reference
+// to its encoded data rather than a copy, so recording costs the sending or
+// decoding thread no more than a task post. The queue can be shared by the
+// recorders of many streams.
+//
+// A recorder is fed either with OnRecordableEncodedFrame() or with
+// OnEncodedImage(), not both. Writing starts with the first key frame, and
+// frames must be passed in order.
+class EncodedFrameRecorder {
+ public:
+  // A `byte_limit` of 0 is no limit, see IvfFileWriter.
+  EncodedFrameRecorder(TaskQueueBase* write_queue,
+                       FileWrapper file,
+                       size_t byte_limit);
+  // Closes the file on `write_queue` once the frames passed so far are
+  // written.
+  ~EncodedFrameRecorder();
+
+  EncodedFrameRecorder(const EncodedFrameRecorder&) = delete;
+  EncodedFrameRecorder& operator=(const EncodedFrameRecorder&) = delete;
+
+  // For the callback of VideoReceiveStream::SetAndGetRecordingState().
+  void OnRecordableEncodedFrame(const RecordableEncodedFrame& frame);
+
+  // For VideoSendStream::Config::encoded_frame_sink. Of a simulcast stream,
+  // only the first stream is recorded.
+  void OnEncodedImage(const EncodedImage& encoded_image,
+                      VideoCodecType codec_type);
+
+ private:
+  struct Writer;
+
+  TaskQueueBase* const write_queue_;
+  // Used on `write_queue_` only, and destroyed there.
+  std::unique_ptr<Writer> writer_;
+};
+
+}  // namespace webrtc
+
+#endif  // VIDEO_ENCODED_FRAME_RECORDER_H_
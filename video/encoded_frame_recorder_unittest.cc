@@ -0,0 +1,123 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/encoded_frame_recorder.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+
+#include "absl/types/optional.h"
+#include "api/units/timestamp.h"
+#include "api/video/test/mock_recordable_encoded_frame.h"
+#include "modules/video_coding/utility/ivf_file_reader.h"
+#include "rtc_base/task_queue_for_test.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::NiceMock;
+using ::testing::Return;
+
+constexpr uint8_t kPayload[] = {1, 2, 3, 4, 5};
+
+class EncodedFrameRecorderTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    file_name_ =
+        test::TempFilename(test::OutputPath(), "encoded_frame_recorder");
+    recorder_ = std::make_unique<EncodedFrameRecorder>(
+        queue_.Get(), FileWrapper::OpenWriteOnly(file_name_),
+        /*byte_limit=*/0);
+  }
+  void TearDown() override { test::RemoveFile(file_name_); }
+
+  // Destroys the recorder and waits for the file to be closed.
+  std::unique_ptr<IvfFileReader> FinishRecording() {
+    recorder_ = nullptr;
+    queue_.WaitForPreviouslyPostedTasks();
+    return IvfFileReader::Create(FileWrapper::OpenReadOnly(file_name_));
+  }
+
+  void RecordReceivedFrame(bool key_frame, unsigned width, int64_t time_ms) {
+    NiceMock<MockRecordableEncodedFrame> frame;
+    ON_CALL(frame, encoded_buffer)
+        .WillByDefault(
+            Return(EncodedImageBuffer::Create(kPayload, sizeof(kPayload))));
+    ON_CALL(frame, codec).WillByDefault(Return(kVideoCodecVP8));
+    ON_CALL(frame, is_key_frame).WillByDefault(Return(key_frame));
+    ON_CALL(frame, resolution)
+        .WillByDefault(Return(RecordableEncodedFrame::EncodedResolution{
+            width, width * 3 / 4}));
+    ON_CALL(frame, render_time)
+        .WillByDefault(Return(Timestamp::Millis(time_ms)));
+    recorder_->OnRecordableEncodedFrame(frame);
+  }
+
+  EncodedImage SentImage(bool key_frame, uint32_t rtp_timestamp) {
+    EncodedImage image;
+    image.SetEncodedData(
+        EncodedImageBuffer::Create(kPayload, sizeof(kPayload)));
+    image._frameType = key_frame ? VideoFrameType::kVideoFrameKey
+                                 : VideoFrameType::kVideoFrameDelta;
+    image._encodedWidth = 640;
+    image._encodedHeight = 480;
+    image.SetTimestamp(rtp_timestamp);
+    return image;
+  }
+
+  std::string file_name_;
+  TaskQueueForTest queue_;
+  std::unique_ptr<EncodedFrameRecorder> recorder_;
+};
+
+TEST_F(EncodedFrameRecorderTest, RecordsReceivedFramesFromFirstKeyFrame) {
+  RecordReceivedFrame(/*key_frame=*/false, 0, 10);
+  RecordReceivedFrame(/*key_frame=*/true, 320, 20);
+  RecordReceivedFrame(/*key_frame=*/false, 0, 30);
+
+  std::unique_ptr<IvfFileReader> reader = FinishRecording();
+  ASSERT_TRUE(reader);
+  EXPECT_EQ(reader->GetVideoCodecType(), kVideoCodecVP8);
+  EXPECT_EQ(reader->GetFrameWidth(), 320);
+  EXPECT_EQ(reader->GetFrameHeight(), 240);
+  EXPECT_EQ(reader->GetFramesCount(), 2u);
+  absl::optional<EncodedImage> frame = reader->NextFrame();
+  ASSERT_TRUE(frame);
+  EXPECT_EQ(frame->size(), sizeof(kPayload));
+  EXPECT_EQ(frame->capture_time_ms_, 20);
+}
+
+TEST_F(EncodedFrameRecorderTest, RecordsFirstSimulcastStreamOfSentImages) {
+  recorder_->OnEncodedImage(SentImage(/*key_frame=*/false, 1000),
+                            kVideoCodecVP8);
+  recorder_->OnEncodedImage(SentImage(/*key_frame=*/true, 2000),
+                            kVideoCodecVP8);
+  EncodedImage second_stream = SentImage(/*key_frame=*/true, 2000);
+  second_stream.SetSpatialIndex(1);
+  recorder_->OnEncodedImage(second_stream, kVideoCodecVP8);
+  recorder_->OnEncodedImage(SentImage(/*key_frame=*/false, 3000),
+                            kVideoCodecVP8);
+
+  std::unique_ptr<IvfFileReader> reader = FinishRecording();
+  ASSERT_TRUE(reader);
+  EXPECT_EQ(reader->GetFrameWidth(), 640);
+  EXPECT_EQ(reader->GetFramesCount(), 2u);
+  absl::optional<EncodedImage> frame = reader->NextFrame();
+  ASSERT_TRUE(frame);
+  EXPECT_EQ(frame->Timestamp(), 2000u);
+}
+
+}  // namespace
+}  // namespace webrtc
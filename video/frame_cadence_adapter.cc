@@ -108,6 +108,9 @@ class ZeroHertzAdapterMode : public AdapterMode {
   // Updates spatial layer enabled status.
   void UpdateLayerStatus(int spatial_index, bool enabled);
 
+  // Sends a repeat right away if an idle repeat is scheduled.
+  void ProcessKeyFrameRequest();
+
   // Adapter overrides.
   void OnFrame(Timestamp post_time,
                int frames_scheduled_for_processing,
@@ -136,7 +139,7 @@ class ZeroHertzAdapterMode : public AdapterMode {
                                             TimeDelta scheduled_delay)
       RTC_RUN_ON(sequence_checker_);
   // Sends a frame, updating the timestamp to the current time.
-  void SendFrameNow(const VideoFrame& frame);
+  void SendFrameNow(const VideoFrame& frame) RTC_RUN_ON(sequence_checker_);
 
   TaskQueueBase* const queue_;
   Clock* const clock_;
@@ -155,6 +158,11 @@ class ZeroHertzAdapterMode : public AdapterMode {
   int current_frame_id_ RTC_GUARDED_BY(sequence_checker_) = 0;
   // True when we are repeating frames.
   bool is_repeating_ RTC_GUARDED_BY(sequence_checker_) = false;
+  // When the scheduled repeat is due, and when a frame was last sent.
+  Timestamp scheduled_repeat_time_ RTC_GUARDED_BY(sequence_checker_) =
+      Timestamp::MinusInfinity();
+  Timestamp last_send_time_ RTC_GUARDED_BY(sequence_checker_) =
+      Timestamp::MinusInfinity();
   // Convergent state of each of the configured simulcast layers.
   std::vector<SpatialLayerTracker> layer_trackers_
       RTC_GUARDED_BY(sequence_checker_);
@@ -175,6 +183,7 @@ class FrameCadenceAdapterImpl : public FrameCadenceAdapterInterface {
   void UpdateLayerQualityConvergence(int spatial_index,
                                      bool quality_converged) override;
   void UpdateLayerStatus(int spatial_index, bool enabled) override;
+  void ProcessKeyFrameRequest() override;
 
   // VideoFrameSink overrides.
   void OnFrame(const VideoFrame& frame) override;
@@ -254,10 +263,14 @@ void ZeroHertzAdapterMode::UpdateLayerQualityConvergence(
     bool quality_converged) {
   RTC_DCHECK_RUN_ON(&sequence_checker_);
   RTC_DCHECK_LT(spatial_index, layer_trackers_.size());
+  absl::optional<bool>& layer_converged =
+      layer_trackers_[spatial_index].quality_converged;
+  if (!layer_converged.has_value() || *layer_converged == quality_converged)
+    return;
+  // This is called for every encoded frame, so only log changes.
   RTC_LOG(LS_INFO) << __func__ << " layer " << spatial_index
                    << " quality has converged: " << quality_converged;
-  if (layer_trackers_[spatial_index].quality_converged.has_value())
-    layer_trackers_[spatial_index].quality_converged = quality_converged;
+  layer_converged = quality_converged;
 }
 
 void ZeroHertzAdapterMode::UpdateLayerStatus(int spatial_index, bool enabled) {
@@ -286,6 +299,19 @@ void ZeroHertzAdapterMode::OnFrame(Timestamp post_time,
   RTC_DCHECK_RUN_ON(&sequence_checker_);
   RTC_DLOG(LS_VERBOSE) << __func__ << " this " << this;
 
+  // Sources that capture at a fixed rate deliver static content as a stream
+  // of unchanged frames. These are elided, and the stored frame is repeated
+  // on the cadence of this adapter instead, which becomes idle once quality
+  // has converged.
+  if (!queued_frames_.empty() && frame.has_update_rect() &&
+      frame.update_rect().IsEmpty() &&
+      frame.width() == queued_frames_.back().width() &&
+      frame.height() == queued_frames_.back().height()) {
+    RTC_DLOG(LS_VERBOSE) << __func__ << " this " << this
+                         << " elide unchanged frame";
+    return;
+  }
+
   // Assume all enabled layers are unconverged after frame entry.
   for (auto& layer_tracker : layer_trackers_) {
     if (layer_tracker.quality_converged.has_value())
@@ -312,6 +338,26 @@ void ZeroHertzAdapterMode::OnFrame(Timestamp post_time,
                           frame_delay_.ms());
 }
 
+void ZeroHertzAdapterMode::ProcessKeyFrameRequest() {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  // Frames are never sent more often than every `frame_delay_`, so there is
+  // only something to gain if an idle repeat is scheduled.
+  if (!is_repeating_ ||
+      scheduled_repeat_time_ - clock_->CurrentTime() <= frame_delay_) {
+    return;
+  }
+  RTC_DLOG(LS_VERBOSE) << __func__ << " this " << this
+                       << " expedite idle repeat";
+  // Cancel the scheduled repeat, and restart the repeat sequence from a repeat
+  // which is sent right away.
+  int frame_id = ++current_frame_id_;
+  queue_->PostTask(ToQueuedTask(safety_, [this, frame_id] {
+    RTC_DCHECK_RUN_ON(&sequence_checker_);
+    ProcessRepeatedFrameOnDelayedCadence(
+        frame_id, clock_->CurrentTime() - last_send_time_);
+  }));
+}
+
 absl::optional<uint32_t> ZeroHertzAdapterMode::GetInputFrameRateFps() {
   RTC_DCHECK_RUN_ON(&sequence_checker_);
   return max_fps_;
@@ -353,6 +399,7 @@ void ZeroHertzAdapterMode::ScheduleRepeat(int frame_id) {
       quality_converged
           ? FrameCadenceAdapterInterface::kZeroHertzIdleRepeatRatePeriod
           : frame_delay_;
+  scheduled_repeat_time_ = clock_->CurrentTime() + repeat_delay;
   queue_->PostDelayedTask(ToQueuedTask(safety_,
                                        [this, frame_id, repeat_delay] {
                                          RTC_DCHECK_RUN_ON(&sequence_checker_);
@@ -395,8 +442,10 @@ void ZeroHertzAdapterMode::ProcessRepeatedFrameOnDelayedCadence(
   ScheduleRepeat(frame_id);
 }
 
+// RTC_RUN_ON(&sequence_checker_)
 void ZeroHertzAdapterMode::SendFrameNow(const VideoFrame& frame) {
   RTC_DLOG(LS_VERBOSE) << __func__ << " this " << this;
+  last_send_time_ = clock_->CurrentTime();
   // TODO(crbug.com/1255737): figure out if frames_scheduled_for_processing
   // makes sense to compute in this implementation.
   callback_->OnFrame(/*post_time=*/clock_->CurrentTime(),
@@ -453,6 +502,12 @@ void FrameCadenceAdapterImpl::UpdateLayerStatus(int spatial_index,
     zero_hertz_adapter_->UpdateLayerStatus(spatial_index, enabled);
 }
 
+void FrameCadenceAdapterImpl::ProcessKeyFrameRequest() {
+  RTC_DCHECK_RUN_ON(queue_);
+  if (zero_hertz_adapter_.has_value())
+    zero_hertz_adapter_->ProcessKeyFrameRequest();
+}
+
 void FrameCadenceAdapterImpl::OnFrame(const VideoFrame& frame) {
   // This method is called on the network thread under Chromium, or other
   // various contexts in test.
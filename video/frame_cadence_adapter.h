@@ -100,6 +100,12 @@ class FrameCadenceAdapterInterface
 
   // Updates spatial layer enabled status.
   virtual void UpdateLayerStatus(int spatial_index, bool enabled) = 0;
+
+  // In zero-hertz mode, sends a repeat of the last frame right away if the
+  // next repeat is an idle repeat, so that a requested key frame does not wait
+  // for up to kZeroHertzIdleRepeatRatePeriod. The repeat is made from the
+  // stored frame and does not involve the source.
+  virtual void ProcessKeyFrameRequest() = 0;
 };
 
 }  // namespace webrtc
@@ -466,6 +466,36 @@ TEST_F(ZeroHertzLayerQualityConvergenceTest,
   });
 }
 
+TEST_F(ZeroHertzLayerQualityConvergenceTest, ElidesUnchangedFramesFromSource) {
+  PassFrame();
+  // The source keeps delivering the static content at its capture rate.
+  for (int i = 1; i != 20; ++i) {
+    ScheduleDelayed(i * kMinFrameDelay, [&] {
+      VideoFrame frame = CreateFrame();
+      frame.set_update_rect(VideoFrame::UpdateRect{0, 0, 0, 0});
+      adapter_->OnFrame(frame);
+    });
+  }
+  ExpectFrameEntriesAtDelaysFromNow({
+      kMinFrameDelay,                    // Original frame emitted
+      kMinFrameDelay + kIdleFrameDelay,  // Idle repeats after convergence.
+      kMinFrameDelay + 2 * kIdleFrameDelay,  // ...
+  });
+}
+
+TEST_F(ZeroHertzLayerQualityConvergenceTest,
+       SendsIdleRepeatRightAwayOnKeyFrameRequest) {
+  PassFrame();
+  ScheduleDelayed(4 * kMinFrameDelay,
+                  [&] { adapter_->ProcessKeyFrameRequest(); });
+  ExpectFrameEntriesAtDelaysFromNow({
+      kMinFrameDelay,      // Original frame emitted
+      4 * kMinFrameDelay,  // Repeat for the key frame request.
+      4 * kMinFrameDelay + kIdleFrameDelay,      // Idle repeats.
+      4 * kMinFrameDelay + 2 * kIdleFrameDelay,  // ...
+  });
+}
+
 class FrameCadenceAdapterMetricsTest : public ::testing::Test {
  public:
   FrameCadenceAdapterMetricsTest() : time_controller_(Timestamp::Millis(1)) {
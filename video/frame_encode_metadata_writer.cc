@@ -26,6 +26,9 @@ namespace webrtc {
 namespace {
 const int kMessagesThrottlingThreshold = 2;
 const int kThrottleRatio = 100000;
+// An asynchronous encoder that neither delivers nor reports a frame for this
+// long is assumed to have dropped it.
+const int64_t kMaxFrameInFlightTimeMs = 1000;
 
 class EncodedImageBufferWrapper : public EncodedImageBufferInterface {
  public:
@@ -90,6 +93,15 @@ void FrameEncodeMetadataWriter::OnSetRates(
   }
 }
 
+void FrameEncodeMetadataWriter::SetMaxFramesInFlight(
+    absl::optional<int> max_frames_in_flight) {
+  MutexLock lock(&lock_);
+  RTC_DCHECK(!max_frames_in_flight || *max_frames_in_flight > 0);
+  max_frames_in_flight_ = max_frames_in_flight;
+  if (!max_frames_in_flight_)
+    frames_in_flight_.clear();
+}
+
 void FrameEncodeMetadataWriter::OnEncodeStarted(const VideoFrame& frame) {
   MutexLock lock(&lock_);
 
@@ -102,6 +114,7 @@ void FrameEncodeMetadataWriter::OnEncodeStarted(const VideoFrame& frame) {
   metadata.rotation = frame.rotation();
   metadata.color_space = frame.color_space();
   metadata.packet_infos = frame.packet_infos();
+  bool is_in_flight = false;
   for (size_t si = 0; si < num_spatial_layers_; ++si) {
     RTC_DCHECK(timing_frames_info_[si].frames.empty() ||
                rtc::TimeDiff(
@@ -129,7 +142,25 @@ void FrameEncodeMetadataWriter::OnEncodeStarted(const VideoFrame& frame) {
       timing_frames_info_[si].frames.pop_front();
     }
     timing_frames_info_[si].frames.emplace_back(metadata);
+    is_in_flight = true;
+  }
+  if (max_frames_in_flight_ && is_in_flight) {
+    if (frames_in_flight_.size() == kMaxEncodeStartTimeListSize)
+      frames_in_flight_.pop_front();
+    frames_in_flight_.push_back(
+        {metadata.rtp_timestamp, metadata.encode_start_time_ms});
+  }
+}
+
+size_t FrameEncodeMetadataWriter::NumFramesInFlight() {
+  MutexLock lock(&lock_);
+  const int64_t now_ms = rtc::TimeMillis();
+  while (!frames_in_flight_.empty() &&
+         now_ms - frames_in_flight_.front().encode_start_time_ms >
+             kMaxFrameInFlightTimeMs) {
+    frames_in_flight_.pop_front();
   }
+  return frames_in_flight_.size();
 }
 
 void FrameEncodeMetadataWriter::FillTimingInfo(size_t simulcast_svc_idx,
@@ -215,6 +246,7 @@ void FrameEncodeMetadataWriter::Reset() {
     info.frames.clear();
   }
   last_timing_frame_time_ms_ = -1;
+  frames_in_flight_.clear();
   reordered_frames_logged_messages_ = 0;
   stalled_encoder_logged_messages_ = 0;
 }
@@ -227,16 +259,48 @@ FrameEncodeMetadataWriter::ExtractEncodeStartTimeAndFillMetadata(
   size_t num_simulcast_svc_streams = timing_frames_info_.size();
   if (simulcast_svc_idx < num_simulcast_svc_streams) {
     auto metadata_list = &timing_frames_info_[simulcast_svc_idx].frames;
-    // Skip frames for which there was OnEncodeStarted but no OnEncodedImage
-    // call. These are dropped by encoder internally.
-    // Because some hardware encoders don't preserve capture timestamp we
-    // use RTP timestamps here.
-    while (!metadata_list->empty() &&
-           IsNewerTimestamp(encoded_image->Timestamp(),
-                            metadata_list->front().rtp_timestamp)) {
-      frame_drop_callback_->OnDroppedFrame(
-          EncodedImageCallback::DropReason::kDroppedByEncoder);
-      metadata_list->pop_front();
+    const uint32_t rtp_timestamp = encoded_image->Timestamp();
+    auto has_rtp_timestamp = [rtp_timestamp](const auto& frame) {
+      return frame.rtp_timestamp == rtp_timestamp;
+    };
+    auto metadata = metadata_list->end();
+    if (max_frames_in_flight_) {
+      // An asynchronous encoder may deliver the frames in flight in any
+      // order, so an earlier frame is only known to be dropped once more
+      // frames than can be in flight were passed to the encoder after it.
+      const size_t max_frames_in_flight = *max_frames_in_flight_;
+      auto in_flight = std::find_if(frames_in_flight_.begin(),
+                                    frames_in_flight_.end(), has_rtp_timestamp);
+      if (in_flight != frames_in_flight_.end()) {
+        size_t index = in_flight - frames_in_flight_.begin();
+        frames_in_flight_.erase(in_flight);
+        for (; index >= max_frames_in_flight; --index)
+          frames_in_flight_.pop_front();
+      }
+      metadata = std::find_if(metadata_list->begin(), metadata_list->end(),
+                              has_rtp_timestamp);
+      if (metadata != metadata_list->end()) {
+        for (size_t index = std::distance(metadata_list->begin(), metadata);
+             index >= max_frames_in_flight; --index) {
+          frame_drop_callback_->OnDroppedFrame(
+              EncodedImageCallback::DropReason::kDroppedByEncoder);
+          metadata_list->pop_front();
+        }
+      }
+    } else {
+      // Skip frames for which there was OnEncodeStarted but no
+      // OnEncodedImage call. These are dropped by encoder internally.
+      // Because some hardware encoders don't preserve capture timestamp we
+      // use RTP timestamps here.
+      while (!metadata_list->empty() &&
+             IsNewerTimestamp(rtp_timestamp,
+                              metadata_list->front().rtp_timestamp)) {
+        frame_drop_callback_->OnDroppedFrame(
+            EncodedImageCallback::DropReason::kDroppedByEncoder);
+        metadata_list->pop_front();
+      }
+      if (!metadata_list->empty() && has_rtp_timestamp(metadata_list->front()))
+        metadata = metadata_list->begin();
     }
 
     encoded_image->content_type_ =
@@ -244,16 +308,14 @@ FrameEncodeMetadataWriter::ExtractEncodeStartTimeAndFillMetadata(
             ? VideoContentType::SCREENSHARE
             : VideoContentType::UNSPECIFIED;
 
-    if (!metadata_list->empty() &&
-        metadata_list->front().rtp_timestamp == encoded_image->Timestamp()) {
-      result.emplace(metadata_list->front().encode_start_time_ms);
-      encoded_image->capture_time_ms_ =
-          metadata_list->front().timestamp_us / 1000;
-      encoded_image->ntp_time_ms_ = metadata_list->front().ntp_time_ms;
-      encoded_image->rotation_ = metadata_list->front().rotation;
-      encoded_image->SetColorSpace(metadata_list->front().color_space);
-      encoded_image->SetPacketInfos(metadata_list->front().packet_infos);
-      metadata_list->pop_front();
+    if (metadata != metadata_list->end()) {
+      result.emplace(metadata->encode_start_time_ms);
+      encoded_image->capture_time_ms_ = metadata->timestamp_us / 1000;
+      encoded_image->ntp_time_ms_ = metadata->ntp_time_ms;
+      encoded_image->rotation_ = metadata->rotation;
+      encoded_image->SetColorSpace(metadata->color_space);
+      encoded_image->SetPacketInfos(metadata->packet_infos);
+      metadata_list->erase(metadata);
     } else {
       ++reordered_frames_logged_messages_;
       if (reordered_frames_logged_messages_ <= kMessagesThrottlingThreshold ||
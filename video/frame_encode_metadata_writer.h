@@ -11,6 +11,7 @@
 #ifndef VIDEO_FRAME_ENCODE_METADATA_WRITER_H_
 #define VIDEO_FRAME_ENCODE_METADATA_WRITER_H_
 
+#include <deque>
 #include <list>
 #include <vector>
 
@@ -32,8 +33,16 @@ class FrameEncodeMetadataWriter {
   void OnSetRates(const VideoBitrateAllocation& bitrate_allocation,
                   uint32_t framerate_fps);
 
+  // Sets `VideoEncoder::EncoderInfo::max_frames_in_flight` of the encoder.
+  // If set, encoded images are matched to their frames in any order.
+  void SetMaxFramesInFlight(absl::optional<int> max_frames_in_flight);
+
   void OnEncodeStarted(const VideoFrame& frame);
 
+  // Returns the number of frames for which encoding started but no encoded
+  // image has been delivered yet. Only tracked with `max_frames_in_flight` set.
+  size_t NumFramesInFlight();
+
   void FillTimingInfo(size_t simulcast_svc_idx, EncodedImage* encoded_image);
 
   void UpdateBitstream(const CodecSpecificInfo* codec_specific_info,
@@ -57,6 +66,10 @@ class FrameEncodeMetadataWriter {
     absl::optional<ColorSpace> color_space;
     RtpPacketInfos packet_infos;
   };
+  struct FrameInFlight {
+    uint32_t rtp_timestamp;
+    int64_t encode_start_time_ms;
+  };
   struct TimingFramesLayerInfo {
     TimingFramesLayerInfo();
     ~TimingFramesLayerInfo();
@@ -75,6 +88,8 @@ class FrameEncodeMetadataWriter {
   int64_t last_timing_frame_time_ms_ RTC_GUARDED_BY(&lock_);
   size_t reordered_frames_logged_messages_ RTC_GUARDED_BY(&lock_);
   size_t stalled_encoder_logged_messages_ RTC_GUARDED_BY(&lock_);
+  absl::optional<int> max_frames_in_flight_ RTC_GUARDED_BY(&lock_);
+  std::deque<FrameInFlight> frames_in_flight_ RTC_GUARDED_BY(&lock_);
 };
 
 }  // namespace webrtc
@@ -19,6 +19,7 @@
 #include "common_video/h264/h264_common.h"
 #include "common_video/test/utilities.h"
 #include "modules/video_coding/include/video_coding_defines.h"
+#include "rtc_base/fake_clock.h"
 #include "rtc_base/time_utils.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
@@ -287,6 +288,77 @@ TEST(FrameEncodeMetadataWriterTest, NotifiesAboutDroppedFrames) {
   EXPECT_EQ(1u, sink.GetNumFramesDropped());
 }
 
+TEST(FrameEncodeMetadataWriterTest, MatchesFramesDeliveredOutOfOrder) {
+  const int64_t kTimestampMs1 = 47721840;
+  const int64_t kTimestampMs2 = 47721850;
+
+  FakeEncodedImageCallback sink;
+  FrameEncodeMetadataWriter encode_timer(&sink);
+  encode_timer.OnEncoderInit(VideoCodec());
+  encode_timer.SetMaxFramesInFlight(2);
+  VideoBitrateAllocation bitrate_allocation;
+  bitrate_allocation.SetBitrate(0, 0, 500000);
+  encode_timer.OnSetRates(bitrate_allocation, 30);
+
+  for (int64_t timestamp_ms : {kTimestampMs1, kTimestampMs2}) {
+    encode_timer.OnEncodeStarted(VideoFrame::Builder()
+                                     .set_timestamp_rtp(timestamp_ms * 90)
+                                     .set_timestamp_ms(timestamp_ms)
+                                     .set_video_frame_buffer(kFrameBuffer)
+                                     .build());
+  }
+  EXPECT_EQ(2u, encode_timer.NumFramesInFlight());
+
+  EncodedImage image;
+  image.SetTimestamp(static_cast<uint32_t>(kTimestampMs2 * 90));
+  encode_timer.FillTimingInfo(0, &image);
+  EXPECT_EQ(kTimestampMs2, image.capture_time_ms_);
+  EXPECT_EQ(1u, encode_timer.NumFramesInFlight());
+
+  image.SetTimestamp(static_cast<uint32_t>(kTimestampMs1 * 90));
+  encode_timer.FillTimingInfo(0, &image);
+  EXPECT_EQ(kTimestampMs1, image.capture_time_ms_);
+  EXPECT_EQ(0u, encode_timer.NumFramesInFlight());
+  EXPECT_EQ(0u, sink.GetNumFramesDropped());
+}
+
+TEST(FrameEncodeMetadataWriterTest,
+     NotifiesAboutFramesDroppedByAsynchronousEncoder) {
+  rtc::ScopedFakeClock clock;
+  clock.SetTime(Timestamp::Millis(47721830));
+  const int64_t kTimestampMs1 = 47721840;
+  const int64_t kTimestampMs2 = 47721850;
+  const int64_t kTimestampMs3 = 47721860;
+
+  FakeEncodedImageCallback sink;
+  FrameEncodeMetadataWriter encode_timer(&sink);
+  encode_timer.OnEncoderInit(VideoCodec());
+  encode_timer.SetMaxFramesInFlight(2);
+  VideoBitrateAllocation bitrate_allocation;
+  bitrate_allocation.SetBitrate(0, 0, 500000);
+  encode_timer.OnSetRates(bitrate_allocation, 30);
+
+  for (int64_t timestamp_ms : {kTimestampMs1, kTimestampMs2, kTimestampMs3}) {
+    encode_timer.OnEncodeStarted(VideoFrame::Builder()
+                                     .set_timestamp_rtp(timestamp_ms * 90)
+                                     .set_timestamp_ms(timestamp_ms)
+                                     .set_video_frame_buffer(kFrameBuffer)
+                                     .build());
+  }
+
+  // Frame 2 may still be in flight along with frame 3, but frame 1 can not.
+  EncodedImage image;
+  image.SetTimestamp(static_cast<uint32_t>(kTimestampMs3 * 90));
+  encode_timer.FillTimingInfo(0, &image);
+  EXPECT_EQ(1u, sink.GetNumFramesDropped());
+  EXPECT_EQ(1u, encode_timer.NumFramesInFlight());
+
+  // Frames that are neither delivered nor followed by others eventually stop
+  // counting as in flight.
+  clock.AdvanceTime(TimeDelta::Seconds(2));
+  EXPECT_EQ(0u, encode_timer.NumFramesInFlight());
+}
+
 TEST(FrameEncodeMetadataWriterTest, RestoresCaptureTimestamps) {
   EncodedImage image;
   const int64_t kTimestampMs = 123456;
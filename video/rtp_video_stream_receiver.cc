@@ -366,9 +366,11 @@ void RtpVideoStreamReceiver::AddReceiveCodec(
     MutexLock lock(&packet_buffer_lock_);
     packet_buffer_.ForceSpsPpsIdrIsH264Keyframe();
   }
-  payload_type_map_.emplace(
-      payload_type, raw_payload ? std::make_unique<VideoRtpDepacketizerRaw>()
-                                : CreateVideoRtpDepacketizer(codec_type));
+  std::unique_ptr<VideoRtpDepacketizer> depacketizer =
+      raw_payload ? std::make_unique<VideoRtpDepacketizerRaw>()
+                  : CreateVideoRtpDepacketizer(codec_type);
+  depacketizer->SetFrameBufferPool(&frame_buffer_pool_);
+  payload_type_map_.emplace(payload_type, std::move(depacketizer));
   pt_codec_params_.emplace(payload_type, codec_params);
 }
 
@@ -505,10 +507,9 @@ void RtpVideoStreamReceiver::OnReceivedPayloadData(
     const RTPVideoHeader& video) {
   RTC_DCHECK_RUN_ON(&worker_task_checker_);
 
-  auto packet =
-      std::make_unique<video_coding::PacketBuffer::Packet>(rtp_packet, video);
+  video_coding::PacketBuffer::Packet packet(rtp_packet, video);
 
-  RTPVideoHeader& video_header = packet->video_header;
+  RTPVideoHeader& video_header = packet.video_header;
   video_header.rotation = kVideoRotation_0;
   video_header.content_type = VideoContentType::UNSPECIFIED;
   video_header.video_timing.flags = VideoSendTiming::kInvalid;
@@ -590,31 +591,31 @@ void RtpVideoStreamReceiver::OnReceivedPayloadData(
         video_header.is_first_packet_in_frame &&
         video_header.frame_type == VideoFrameType::kVideoFrameKey;
 
-    packet->times_nacked = nack_module_->OnReceivedPacket(
+    packet.times_nacked = nack_module_->OnReceivedPacket(
         rtp_packet.SequenceNumber(), is_keyframe, rtp_packet.recovered());
   } else {
-    packet->times_nacked = -1;
+    packet.times_nacked = -1;
   }
 
   if (codec_payload.size() == 0) {
-    NotifyReceiverOfEmptyPacket(packet->seq_num);
+    NotifyReceiverOfEmptyPacket(packet.seq_num);
     rtcp_feedback_buffer_.SendBufferedRtcpFeedback();
     return;
   }
 
-  if (packet->codec() == kVideoCodecH264) {
+  if (packet.codec() == kVideoCodecH264) {
     // Only when we start to receive packets will we know what payload type
     // that will be used. When we know the payload type insert the correct
     // sps/pps into the tracker.
-    if (packet->payload_type != last_payload_type_) {
-      last_payload_type_ = packet->payload_type;
-      InsertSpsPpsIntoTracker(packet->payload_type);
+    if (packet.payload_type != last_payload_type_) {
+      last_payload_type_ = packet.payload_type;
+      InsertSpsPpsIntoTracker(packet.payload_type);
     }
 
     video_coding::H264SpsPpsTracker::FixedBitstream fixed =
         tracker_.CopyAndFixBitstream(
             rtc::MakeArrayView(codec_payload.cdata(), codec_payload.size()),
-            &packet->video_header);
+            &packet.video_header);
 
     switch (fixed.action) {
       case video_coding::H264SpsPpsTracker::kRequestKeyframe:
@@ -624,16 +625,16 @@ void RtpVideoStreamReceiver::OnReceivedPayloadData(
       case video_coding::H264SpsPpsTracker::kDrop:
         return;
       case video_coding::H264SpsPpsTracker::kInsert:
-        packet->video_payload = std::move(fixed.bitstream);
+        packet.video_payload = std::move(fixed.bitstream);
         break;
     }
 
   } else {
-    packet->video_payload = std::move(codec_payload);
+    packet.video_payload = std::move(codec_payload);
   }
 
   rtcp_feedback_buffer_.SendBufferedRtcpFeedback();
-  frame_counter_.Add(packet->timestamp);
+  frame_counter_.Add(packet.timestamp);
   video_coding::PacketBuffer::InsertResult insert_result;
   {
     MutexLock lock(&packet_buffer_lock_);
@@ -767,7 +768,7 @@ void RtpVideoStreamReceiver::OnInsertedPacket(
     RtpPacketInfos::vector_type packet_infos;
 
     bool frame_boundary = true;
-    for (auto& packet : result.packets) {
+    for (video_coding::PacketBuffer::Packet* packet : result.packets) {
       // PacketBuffer promisses frame boundaries are correctly set on each
       // packet. Document that assumption with the DCHECKs.
       RTC_DCHECK_EQ(frame_boundary, packet->is_first_packet_in_frame());
@@ -776,7 +777,7 @@ void RtpVideoStreamReceiver::OnInsertedPacket(
       RTC_DCHECK(packet_infos_.count(unwrapped_rtp_seq_num) > 0);
       RtpPacketInfo& packet_info = packet_infos_[unwrapped_rtp_seq_num];
       if (packet->is_first_packet_in_frame()) {
-        first_packet = packet.get();
+        first_packet = packet;
         max_nack_count = packet->times_nacked;
         min_recv_time = packet_info.receive_time().ms();
         max_recv_time = packet_info.receive_time().ms();
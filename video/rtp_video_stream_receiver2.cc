@@ -46,6 +46,7 @@
 #include "rtc_base/location.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/strings/string_builder.h"
+#include "rtc_base/trace_event.h"
 #include "system_wrappers/include/field_trial.h"
 #include "system_wrappers/include/metrics.h"
 #include "system_wrappers/include/ntp_time.h"
@@ -333,9 +334,11 @@ void RtpVideoStreamReceiver2::AddReceiveCodec(
       field_trial::IsEnabled("WebRTC-SpsPpsIdrIsH264Keyframe")) {
     packet_buffer_.ForceSpsPpsIdrIsH264Keyframe();
   }
-  payload_type_map_.emplace(
-      payload_type, raw_payload ? std::make_unique<VideoRtpDepacketizerRaw>()
-                                : CreateVideoRtpDepacketizer(video_codec));
+  std::unique_ptr<VideoRtpDepacketizer> depacketizer =
+      raw_payload ? std::make_unique<VideoRtpDepacketizerRaw>()
+                  : CreateVideoRtpDepacketizer(video_codec);
+  depacketizer->SetFrameBufferPool(&frame_buffer_pool_);
+  payload_type_map_.emplace(payload_type, std::move(depacketizer));
   pt_codec_params_.emplace(payload_type, codec_params);
 }
 
@@ -472,8 +475,7 @@ void RtpVideoStreamReceiver2::OnReceivedPayloadData(
     const RTPVideoHeader& video) {
   RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
 
-  auto packet =
-      std::make_unique<video_coding::PacketBuffer::Packet>(rtp_packet, video);
+  video_coding::PacketBuffer::Packet packet(rtp_packet, video);
 
   int64_t unwrapped_rtp_seq_num =
       rtp_seq_num_unwrapper_.Unwrap(rtp_packet.SequenceNumber());
@@ -497,7 +499,7 @@ void RtpVideoStreamReceiver2::OnReceivedPayloadData(
           // Assume frequency is the same one for all video frames.
           kVideoPayloadTypeFrequency, packet_info.absolute_capture_time()));
 
-  RTPVideoHeader& video_header = packet->video_header;
+  RTPVideoHeader& video_header = packet.video_header;
   video_header.rotation = kVideoRotation_0;
   video_header.content_type = VideoContentType::UNSPECIFIED;
   video_header.video_timing.flags = VideoSendTiming::kInvalid;
@@ -573,31 +575,31 @@ void RtpVideoStreamReceiver2::OnReceivedPayloadData(
         video_header.is_first_packet_in_frame &&
         video_header.frame_type == VideoFrameType::kVideoFrameKey;
 
-    packet->times_nacked = nack_module_->OnReceivedPacket(
+    packet.times_nacked = nack_module_->OnReceivedPacket(
         rtp_packet.SequenceNumber(), is_keyframe, rtp_packet.recovered());
   } else {
-    packet->times_nacked = -1;
+    packet.times_nacked = -1;
   }
 
   if (codec_payload.size() == 0) {
-    NotifyReceiverOfEmptyPacket(packet->seq_num);
+    NotifyReceiverOfEmptyPacket(packet.seq_num);
     rtcp_feedback_buffer_.SendBufferedRtcpFeedback();
     return;
   }
 
-  if (packet->codec() == kVideoCodecH264) {
+  if (packet.codec() == kVideoCodecH264) {
     // Only when we start to receive packets will we know what payload type
     // that will be used. When we know the payload type insert the correct
     // sps/pps into the tracker.
-    if (packet->payload_type != last_payload_type_) {
-      last_payload_type_ = packet->payload_type;
-      InsertSpsPpsIntoTracker(packet->payload_type);
+    if (packet.payload_type != last_payload_type_) {
+      last_payload_type_ = packet.payload_type;
+      InsertSpsPpsIntoTracker(packet.payload_type);
     }
 
     video_coding::H264SpsPpsTracker::FixedBitstream fixed =
         tracker_.CopyAndFixBitstream(
             rtc::MakeArrayView(codec_payload.cdata(), codec_payload.size()),
-            &packet->video_header);
+            &packet.video_header);
 
     switch (fixed.action) {
       case video_coding::H264SpsPpsTracker::kRequestKeyframe:
@@ -607,17 +609,24 @@ void RtpVideoStreamReceiver2::OnReceivedPayloadData(
       case video_coding::H264SpsPpsTracker::kDrop:
         return;
       case video_coding::H264SpsPpsTracker::kInsert:
-        packet->video_payload = std::move(fixed.bitstream);
+        packet.video_payload = std::move(fixed.bitstream);
         break;
     }
 
   } else {
-    packet->video_payload = std::move(codec_payload);
+    packet.video_payload = std::move(codec_payload);
   }
 
   rtcp_feedback_buffer_.SendBufferedRtcpFeedback();
-  frame_counter_.Add(packet->timestamp);
-  OnInsertedPacket(packet_buffer_.InsertPacket(std::move(packet)));
+  frame_counter_.Add(packet.timestamp);
+  Timestamp insert_start = clock_->CurrentTime();
+  video_coding::PacketBuffer::InsertResult insert_result;
+  {
+    TRACE_EVENT0("webrtc", "PacketBuffer::InsertPacket");
+    insert_result = packet_buffer_.InsertPacket(std::move(packet));
+  }
+  total_packet_buffer_insert_time_ += clock_->CurrentTime() - insert_start;
+  OnInsertedPacket(std::move(insert_result));
 }
 
 void RtpVideoStreamReceiver2::OnRecoveredPacket(const uint8_t* rtp_packet,
@@ -718,7 +727,7 @@ void RtpVideoStreamReceiver2::OnInsertedPacket(
   RtpPacketInfos::vector_type packet_infos;
 
   bool frame_boundary = true;
-  for (auto& packet : result.packets) {
+  for (video_coding::PacketBuffer::Packet* packet : result.packets) {
     // PacketBuffer promisses frame boundaries are correctly set on each
     // packet. Document that assumption with the DCHECKs.
     RTC_DCHECK_EQ(frame_boundary, packet->is_first_packet_in_frame());
@@ -727,7 +736,7 @@ void RtpVideoStreamReceiver2::OnInsertedPacket(
     RTC_DCHECK(packet_infos_.count(unwrapped_rtp_seq_num) > 0);
     RtpPacketInfo& packet_info = packet_infos_[unwrapped_rtp_seq_num];
     if (packet->is_first_packet_in_frame()) {
-      first_packet = packet.get();
+      first_packet = packet;
       max_nack_count = packet->times_nacked;
       min_recv_time = packet_info.receive_time().ms();
       max_recv_time = packet_info.receive_time().ms();
@@ -847,10 +856,23 @@ void RtpVideoStreamReceiver2::OnAssembledFrame(
   } else if (frame_transformer_delegate_) {
     frame_transformer_delegate_->TransformFrame(std::move(frame));
   } else {
-    OnCompleteFrames(reference_finder_->ManageFrame(std::move(frame)));
+    FindReferences(std::move(frame));
   }
 }
 
+// RTC_RUN_ON(packet_sequence_checker_)
+void RtpVideoStreamReceiver2::FindReferences(
+    std::unique_ptr<RtpFrameObject> frame) {
+  Timestamp start = clock_->CurrentTime();
+  RtpFrameReferenceFinder::ReturnVector frames;
+  {
+    TRACE_EVENT0("webrtc", "RtpFrameReferenceFinder::ManageFrame");
+    frames = reference_finder_->ManageFrame(std::move(frame));
+  }
+  total_reference_finding_time_ += clock_->CurrentTime() - start;
+  OnCompleteFrames(std::move(frames));
+}
+
 // RTC_RUN_ON(packet_sequence_checker_)
 void RtpVideoStreamReceiver2::OnCompleteFrames(
     RtpFrameReferenceFinder::ReturnVector frames) {
@@ -866,7 +888,7 @@ void RtpVideoStreamReceiver2::OnCompleteFrames(
 void RtpVideoStreamReceiver2::OnDecryptedFrame(
     std::unique_ptr<RtpFrameObject> frame) {
   RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
-  OnCompleteFrames(reference_finder_->ManageFrame(std::move(frame)));
+  FindReferences(std::move(frame));
 }
 
 void RtpVideoStreamReceiver2::OnDecryptionStatusChange(
@@ -933,7 +955,7 @@ absl::optional<int64_t> RtpVideoStreamReceiver2::LastReceivedKeyframePacketMs()
 void RtpVideoStreamReceiver2::ManageFrame(
     std::unique_ptr<RtpFrameObject> frame) {
   RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
-  OnCompleteFrames(reference_finder_->ManageFrame(std::move(frame)));
+  FindReferences(std::move(frame));
 }
 
 // RTC_RUN_ON(packet_sequence_checker_)
@@ -991,9 +1013,17 @@ void RtpVideoStreamReceiver2::ParseAndHandleEncapsulatingHeader(
 void RtpVideoStreamReceiver2::NotifyReceiverOfEmptyPacket(uint16_t seq_num) {
   RTC_DCHECK_RUN_ON(&worker_task_checker_);
 
-  OnCompleteFrames(reference_finder_->PaddingReceived(seq_num));
-
-  OnInsertedPacket(packet_buffer_.InsertPadding(seq_num));
+  Timestamp start = clock_->CurrentTime();
+  RtpFrameReferenceFinder::ReturnVector frames =
+      reference_finder_->PaddingReceived(seq_num);
+  total_reference_finding_time_ += clock_->CurrentTime() - start;
+  OnCompleteFrames(std::move(frames));
+
+  start = clock_->CurrentTime();
+  video_coding::PacketBuffer::InsertResult insert_result =
+      packet_buffer_.InsertPadding(seq_num);
+  total_packet_buffer_insert_time_ += clock_->CurrentTime() - start;
+  OnInsertedPacket(std::move(insert_result));
   if (nack_module_) {
     nack_module_->OnReceivedPacket(seq_num, /* is_keyframe = */ false,
                                    /* is _recovered = */ false);
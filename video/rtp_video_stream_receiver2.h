@@ -19,12 +19,14 @@
 #include "absl/types/optional.h"
 #include "api/crypto/frame_decryptor_interface.h"
 #include "api/sequence_checker.h"
+#include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
 #include "api/video/color_space.h"
 #include "api/video/video_codec_type.h"
 #include "call/rtp_packet_sink_interface.h"
 #include "call/syncable.h"
 #include "call/video_receive_stream.h"
+#include "common_video/include/encoded_image_buffer_pool.h"
 #include "modules/rtp_rtcp/include/receive_statistics.h"
 #include "modules/rtp_rtcp/include/remote_ntp_time_estimator.h"
 #include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
@@ -125,6 +127,17 @@ class RtpVideoStreamReceiver2 : public LossNotificationSender,
     return frame_counter_.GetUniqueSeen();
   }
 
+  // Returns the wall time spent inserting packets into the packet buffer, and
+  // finding the references of the assembled frames.
+  TimeDelta GetTotalPacketBufferInsertTime() const {
+    RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
+    return total_packet_buffer_insert_time_;
+  }
+  TimeDelta GetTotalReferenceFindingTime() const {
+    RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
+    return total_reference_finding_time_;
+  }
+
   // Implements RtpPacketSinkInterface.
   void OnRtpPacket(const RtpPacketReceived& packet) override;
 
@@ -192,6 +205,10 @@ class RtpVideoStreamReceiver2 : public LossNotificationSender,
 
   void OnCompleteFrames(RtpFrameReferenceFinder::ReturnVector frame)
       RTC_RUN_ON(packet_sequence_checker_);
+  // Passes `frame` to the reference finder, and on the frames that are
+  // complete as a result.
+  void FindReferences(std::unique_ptr<RtpFrameObject> frame)
+      RTC_RUN_ON(packet_sequence_checker_);
 
   // Used for buffering RTCP feedback messages and sending them all together.
   // Note:
@@ -343,6 +360,10 @@ class RtpVideoStreamReceiver2 : public LossNotificationSender,
 
   std::unique_ptr<RtpFrameReferenceFinder> reference_finder_
       RTC_GUARDED_BY(packet_sequence_checker_);
+  TimeDelta total_packet_buffer_insert_time_
+      RTC_GUARDED_BY(packet_sequence_checker_) = TimeDelta::Zero();
+  TimeDelta total_reference_finding_time_
+      RTC_GUARDED_BY(packet_sequence_checker_) = TimeDelta::Zero();
   absl::optional<VideoCodecType> current_codec_
       RTC_GUARDED_BY(packet_sequence_checker_);
   uint32_t last_assembled_frame_rtp_timestamp_
@@ -353,6 +374,9 @@ class RtpVideoStreamReceiver2 : public LossNotificationSender,
   video_coding::H264SpsPpsTracker tracker_
       RTC_GUARDED_BY(packet_sequence_checker_);
 
+  // Recycles the buffers of assembled frames. Declared before
+  // `payload_type_map_` since the depacketizers refer to it.
+  EncodedImageBufferPool frame_buffer_pool_;
   // Maps payload id to the depacketizer.
   std::map<uint8_t, std::unique_ptr<VideoRtpDepacketizer>> payload_type_map_
       RTC_GUARDED_BY(packet_sequence_checker_);
@@ -41,6 +41,13 @@ class TransformableVideoReceiverFrame
         EncodedImageBuffer::Create(data.data(), data.size()));
   }
 
+  rtc::ArrayView<uint8_t> GetMutableData() override {
+    // The payload is assembled from the packets into a buffer of its own.
+    rtc::scoped_refptr<EncodedImageBufferInterface> encoded_data =
+        frame_->GetEncodedData();
+    return rtc::ArrayView<uint8_t>(encoded_data->data(), encoded_data->size());
+  }
+
   uint8_t GetPayloadType() const override { return frame_->PayloadType(); }
   uint32_t GetSsrc() const override { return ssrc_; }
   uint32_t GetTimestamp() const override { return frame_->Timestamp(); }
@@ -102,6 +109,12 @@ void RtpVideoStreamReceiverFrameTransformerDelegate::TransformFrame(
 
 void RtpVideoStreamReceiverFrameTransformerDelegate::OnTransformedFrame(
     std::unique_ptr<TransformableFrameInterface> frame) {
+  // Transformers that return the frame synchronously, or on the network
+  // thread, don't need another hop.
+  if (network_thread_->IsCurrent()) {
+    ManageFrame(std::move(frame));
+    return;
+  }
   rtc::scoped_refptr<RtpVideoStreamReceiverFrameTransformerDelegate> delegate =
       this;
   network_thread_->PostTask(ToQueuedTask(
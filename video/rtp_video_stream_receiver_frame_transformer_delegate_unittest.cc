@@ -36,11 +36,13 @@ using ::testing::NiceMock;
 using ::testing::SaveArg;
 
 std::unique_ptr<RtpFrameObject> CreateRtpFrameObject(
-    const RTPVideoHeader& video_header) {
+    const RTPVideoHeader& video_header,
+    rtc::scoped_refptr<EncodedImageBuffer> encoded_data =
+        EncodedImageBuffer::Create(0)) {
   return std::make_unique<RtpFrameObject>(
       0, 0, true, 0, 0, 0, 0, 0, VideoSendTiming(), 0, video_header.codec,
       kVideoRotation_0, VideoContentType::UNSPECIFIED, video_header,
-      absl::nullopt, RtpPacketInfos(), EncodedImageBuffer::Create(0));
+      absl::nullopt, RtpPacketInfos(), std::move(encoded_data));
 }
 
 std::unique_ptr<RtpFrameObject> CreateRtpFrameObject() {
@@ -122,6 +124,44 @@ TEST(RtpVideoStreamReceiverFrameTransformerDelegateTest,
   rtc::ThreadManager::ProcessAllMessageQueuesForTesting();
 }
 
+TEST(RtpVideoStreamReceiverFrameTransformerDelegateTest,
+     ManagesFrameTransformedInPlaceWithoutCopy) {
+  TestRtpVideoFrameReceiver receiver;
+  auto mock_frame_transformer(
+      rtc::make_ref_counted<NiceMock<MockFrameTransformer>>());
+  auto delegate =
+      rtc::make_ref_counted<RtpVideoStreamReceiverFrameTransformerDelegate>(
+          &receiver, mock_frame_transformer, rtc::Thread::Current(),
+          /*remote_ssrc*/ 1111);
+
+  rtc::scoped_refptr<TransformedFrameCallback> callback;
+  EXPECT_CALL(*mock_frame_transformer, RegisterTransformedFrameSinkCallback)
+      .WillOnce(SaveArg<0>(&callback));
+  delegate->Init();
+  ASSERT_TRUE(callback);
+
+  const uint8_t data[] = {1, 2, 3};
+  rtc::scoped_refptr<EncodedImageBuffer> encoded_data =
+      EncodedImageBuffer::Create(data, sizeof(data));
+  EXPECT_CALL(*mock_frame_transformer, Transform)
+      .WillOnce(
+          [&callback](std::unique_ptr<TransformableFrameInterface> frame) {
+            for (uint8_t& byte : frame->GetMutableData()) {
+              byte ^= 0xff;
+            }
+            callback->OnTransformedFrame(std::move(frame));
+          });
+  // The frame is returned on the network thread, so it's managed right away.
+  EXPECT_CALL(receiver, ManageFrame)
+      .WillOnce([&encoded_data](std::unique_ptr<RtpFrameObject> frame) {
+        EXPECT_EQ(frame->GetEncodedData(), encoded_data);
+        EXPECT_THAT(rtc::MakeArrayView(frame->data(), frame->size()),
+                    ElementsAre(0xfe, 0xfd, 0xfc));
+      });
+  delegate->TransformFrame(
+      CreateRtpFrameObject(RTPVideoHeader(), encoded_data));
+}
+
 TEST(RtpVideoStreamReceiverFrameTransformerDelegateTest,
      TransformableFrameMetadataHasCorrectValue) {
   TestRtpVideoFrameReceiver receiver;
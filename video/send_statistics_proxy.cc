@@ -155,6 +155,7 @@ SendStatisticsProxy::SendStatisticsProxy(
 
 SendStatisticsProxy::~SendStatisticsProxy() {
   MutexLock lock(&mutex_);
+  MergePacketStats();
   uma_container_->UpdateHistograms(rtp_config_, stats_);
 
   int64_t elapsed_sec = (clock_->TimeInMilliseconds() - start_ms_) / 1000;
@@ -674,6 +675,7 @@ void SendStatisticsProxy::OnEncoderReconfigured(
   MutexLock lock(&mutex_);
 
   if (content_type_ != config.content_type) {
+    MergePacketStats();
     uma_container_->UpdateHistograms(rtp_config_, stats_);
     uma_container_.reset(new UmaSamplesContainer(
         GetUmaPrefix(config.content_type), stats_, clock_));
@@ -735,6 +737,7 @@ void SendStatisticsProxy::OnSuspendChange(bool is_suspended) {
 
 VideoSendStream::Stats SendStatisticsProxy::GetStats() {
   MutexLock lock(&mutex_);
+  MergePacketStats();
   PurgeOldStats();
   stats_.input_frame_rate =
       uma_container_->input_frame_rate_tracker_.ComputeRate();
@@ -759,6 +762,78 @@ VideoSendStream::Stats SendStatisticsProxy::GetStats() {
   return stats_;
 }
 
+void SendStatisticsProxy::MaybeMergePacketStats() {
+  // If `mutex_` is taken, e.g. by GetStats(), a later packet merges instead.
+  if (!mutex_.TryLock())
+    return;
+  MergePacketStats();
+  mutex_.Unlock();
+}
+
+void SendStatisticsProxy::MergePacketStats() {
+  MutexLock lock(&packet_stats_mutex_);
+  for (auto& it : packet_stats_) {
+    uint32_t ssrc = it.first;
+    PacketStats& update = it.second;
+    VideoSendStream::StreamStats* stats = GetStatsEntry(ssrc);
+    RTC_DCHECK(stats || !update.rtp_stats)
+        << "DataCountersUpdated reported for unknown ssrc " << ssrc;
+    if (!stats) {
+      update = PacketStats();
+      continue;
+    }
+
+    // The same counters are reported for both the media ssrc and flexfec ssrc.
+    // Bitrate stats are summed for all SSRCs. Use fec stats from media update.
+    if (update.rtp_stats &&
+        stats->type != VideoSendStream::StreamStats::StreamType::kFlexfec) {
+      const StreamDataCounters& counters = *update.rtp_stats;
+      stats->rtp_stats = counters;
+      if (uma_container_->first_rtp_stats_time_ms_ == -1) {
+        uma_container_->first_rtp_stats_time_ms_ = update.rtp_stats_time_ms;
+        uma_container_->cpu_adapt_timer_.Restart(update.rtp_stats_time_ms);
+        uma_container_->quality_adapt_timer_.Restart(update.rtp_stats_time_ms);
+      }
+
+      uma_container_->total_byte_counter_.Set(
+          counters.transmitted.TotalBytes(), ssrc);
+      uma_container_->padding_byte_counter_.Set(
+          counters.transmitted.padding_bytes, ssrc);
+      uma_container_->retransmit_byte_counter_.Set(
+          counters.retransmitted.TotalBytes(), ssrc);
+      uma_container_->fec_byte_counter_.Set(counters.fec.TotalBytes(), ssrc);
+      switch (stats->type) {
+        case VideoSendStream::StreamStats::StreamType::kMedia:
+          uma_container_->media_byte_counter_.Set(counters.MediaPayloadBytes(),
+                                                  ssrc);
+          break;
+        case VideoSendStream::StreamStats::StreamType::kRtx:
+          uma_container_->rtx_byte_counter_.Set(
+              counters.transmitted.TotalBytes(), ssrc);
+          break;
+        case VideoSendStream::StreamStats::StreamType::kFlexfec:
+          break;
+      }
+    }
+
+    if (update.total_bitrate_bps) {
+      stats->total_bitrate_bps = *update.total_bitrate_bps;
+      stats->retransmit_bitrate_bps = update.retransmit_bitrate_bps;
+    }
+
+    if (update.num_delays > 0) {
+      stats->avg_delay_ms = update.avg_delay_ms;
+      stats->max_delay_ms = update.max_delay_ms;
+      stats->total_packet_send_delay_ms = update.total_packet_send_delay_ms;
+      uma_container_->delay_counter_.Add(update.avg_delay_sum_ms,
+                                         update.num_delays);
+      uma_container_->max_delay_counter_.Add(update.max_delay_sum_ms,
+                                             update.num_delays);
+    }
+    update = PacketStats();
+  }
+}
+
 void SendStatisticsProxy::PurgeOldStats() {
   int64_t old_stats_ms = clock_->TimeInMilliseconds() - kStatsTimeoutMs;
   for (std::map<uint32_t, VideoSendStream::StreamStats>::iterator it =
@@ -815,6 +890,8 @@ VideoSendStream::StreamStats* SendStatisticsProxy::GetStatsEntry(
 
 void SendStatisticsProxy::OnInactiveSsrc(uint32_t ssrc) {
   MutexLock lock(&mutex_);
+  // Don't let bitrates reported before going inactive be merged later.
+  MergePacketStats();
   VideoSendStream::StreamStats* stats = GetStatsEntry(ssrc);
   if (!stats)
     return;
@@ -1317,55 +1394,26 @@ void SendStatisticsProxy::OnReportBlockDataUpdated(
 void SendStatisticsProxy::DataCountersUpdated(
     const StreamDataCounters& counters,
     uint32_t ssrc) {
-  MutexLock lock(&mutex_);
-  VideoSendStream::StreamStats* stats = GetStatsEntry(ssrc);
-  RTC_DCHECK(stats) << "DataCountersUpdated reported for unknown ssrc " << ssrc;
-
-  if (stats->type == VideoSendStream::StreamStats::StreamType::kFlexfec) {
-    // The same counters are reported for both the media ssrc and flexfec ssrc.
-    // Bitrate stats are summed for all SSRCs. Use fec stats from media update.
-    return;
-  }
-
-  stats->rtp_stats = counters;
-  if (uma_container_->first_rtp_stats_time_ms_ == -1) {
-    int64_t now_ms = clock_->TimeInMilliseconds();
-    uma_container_->first_rtp_stats_time_ms_ = now_ms;
-    uma_container_->cpu_adapt_timer_.Restart(now_ms);
-    uma_container_->quality_adapt_timer_.Restart(now_ms);
-  }
-
-  uma_container_->total_byte_counter_.Set(counters.transmitted.TotalBytes(),
-                                          ssrc);
-  uma_container_->padding_byte_counter_.Set(counters.transmitted.padding_bytes,
-                                            ssrc);
-  uma_container_->retransmit_byte_counter_.Set(
-      counters.retransmitted.TotalBytes(), ssrc);
-  uma_container_->fec_byte_counter_.Set(counters.fec.TotalBytes(), ssrc);
-  switch (stats->type) {
-    case VideoSendStream::StreamStats::StreamType::kMedia:
-      uma_container_->media_byte_counter_.Set(counters.MediaPayloadBytes(),
-                                              ssrc);
-      break;
-    case VideoSendStream::StreamStats::StreamType::kRtx:
-      uma_container_->rtx_byte_counter_.Set(counters.transmitted.TotalBytes(),
-                                            ssrc);
-      break;
-    case VideoSendStream::StreamStats::StreamType::kFlexfec:
-      break;
+  {
+    MutexLock lock(&packet_stats_mutex_);
+    PacketStats& update = packet_stats_[ssrc];
+    if (!update.rtp_stats)
+      update.rtp_stats_time_ms = clock_->TimeInMilliseconds();
+    update.rtp_stats = counters;
   }
+  MaybeMergePacketStats();
 }
 
 void SendStatisticsProxy::Notify(uint32_t total_bitrate_bps,
                                  uint32_t retransmit_bitrate_bps,
                                  uint32_t ssrc) {
-  MutexLock lock(&mutex_);
-  VideoSendStream::StreamStats* stats = GetStatsEntry(ssrc);
-  if (!stats)
-    return;
-
-  stats->total_bitrate_bps = total_bitrate_bps;
-  stats->retransmit_bitrate_bps = retransmit_bitrate_bps;
+  {
+    MutexLock lock(&packet_stats_mutex_);
+    PacketStats& update = packet_stats_[ssrc];
+    update.total_bitrate_bps = total_bitrate_bps;
+    update.retransmit_bitrate_bps = retransmit_bitrate_bps;
+  }
+  MaybeMergePacketStats();
 }
 
 void SendStatisticsProxy::FrameCountUpdated(const FrameCounts& frame_counts,
@@ -1382,16 +1430,17 @@ void SendStatisticsProxy::SendSideDelayUpdated(int avg_delay_ms,
                                                int max_delay_ms,
                                                uint64_t total_delay_ms,
                                                uint32_t ssrc) {
-  MutexLock lock(&mutex_);
-  VideoSendStream::StreamStats* stats = GetStatsEntry(ssrc);
-  if (!stats)
-    return;
-  stats->avg_delay_ms = avg_delay_ms;
-  stats->max_delay_ms = max_delay_ms;
-  stats->total_packet_send_delay_ms = total_delay_ms;
-
-  uma_container_->delay_counter_.Add(avg_delay_ms);
-  uma_container_->max_delay_counter_.Add(max_delay_ms);
+  {
+    MutexLock lock(&packet_stats_mutex_);
+    PacketStats& update = packet_stats_[ssrc];
+    ++update.num_delays;
+    update.avg_delay_ms = avg_delay_ms;
+    update.max_delay_ms = max_delay_ms;
+    update.total_packet_send_delay_ms = total_delay_ms;
+    update.avg_delay_sum_ms += avg_delay_ms;
+    update.max_delay_sum_ms += max_delay_ms;
+  }
+  MaybeMergePacketStats();
 }
 
 void SendStatisticsProxy::StatsTimer::Start(int64_t now_ms) {
@@ -1417,6 +1466,12 @@ void SendStatisticsProxy::SampleCounter::Add(int sample) {
   ++num_samples;
 }
 
+void SendStatisticsProxy::SampleCounter::Add(int64_t sample_sum,
+                                             int64_t count) {
+  sum += sample_sum;
+  num_samples += count;
+}
+
 int SendStatisticsProxy::SampleCounter::Avg(
     int64_t min_required_samples) const {
   if (num_samples < min_required_samples || num_samples == 0)
@@ -25,6 +25,7 @@
 #include "modules/rtp_rtcp/include/report_block_data.h"
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "modules/video_coding/include/video_coding_defines.h"
+#include "rtc_base/containers/flat_map.h"
 #include "rtc_base/numerics/exp_filter.h"
 #include "rtc_base/rate_tracker.h"
 #include "rtc_base/synchronization/mutex.h"
@@ -135,6 +136,7 @@ class SendStatisticsProxy : public VideoStreamEncoderObserver,
     SampleCounter() : sum(0), num_samples(0) {}
     ~SampleCounter() {}
     void Add(int sample);
+    void Add(int64_t sample_sum, int64_t count);
     int Avg(int64_t min_required_samples) const;
 
    private:
@@ -219,6 +221,26 @@ class SendStatisticsProxy : public VideoStreamEncoderObserver,
   };
   typedef std::map<uint32_t, Frame, TimestampOlderThan> EncodedFrameMap;
 
+  // Updates from DataCountersUpdated(), Notify() and SendSideDelayUpdated(),
+  // which are called for every sent packet, since the last merge.
+  struct PacketStats {
+    absl::optional<StreamDataCounters> rtp_stats;
+    // Time of the first `rtp_stats` update since the last merge.
+    int64_t rtp_stats_time_ms = -1;
+    absl::optional<uint32_t> total_bitrate_bps;
+    uint32_t retransmit_bitrate_bps = 0;
+    int64_t num_delays = 0;
+    int avg_delay_ms = 0;
+    int max_delay_ms = 0;
+    uint64_t total_packet_send_delay_ms = 0;
+    int64_t avg_delay_sum_ms = 0;
+    int64_t max_delay_sum_ms = 0;
+  };
+
+  // Merges the packet stats into `stats_` and `uma_container_` unless `mutex_`
+  // is taken, so that the packet path never waits for it.
+  void MaybeMergePacketStats();
+  void MergePacketStats() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
   void PurgeOldStats() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
   VideoSendStream::StreamStats* GetStatsEntry(uint32_t ssrc)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
@@ -275,17 +297,22 @@ class SendStatisticsProxy : public VideoStreamEncoderObserver,
   const absl::optional<int> fallback_max_pixels_;
   const absl::optional<int> fallback_max_pixels_disabled_;
   mutable Mutex mutex_;
+  // Taken for every sent packet, and by MergePacketStats() while holding
+  // `mutex_`, never the other way around.
+  Mutex packet_stats_mutex_ RTC_ACQUIRED_AFTER(mutex_);
+  flat_map<uint32_t, PacketStats> packet_stats_
+      RTC_GUARDED_BY(packet_stats_mutex_);
   VideoEncoderConfig::ContentType content_type_ RTC_GUARDED_BY(mutex_);
   const int64_t start_ms_;
   VideoSendStream::Stats stats_ RTC_GUARDED_BY(mutex_);
-  std::map<uint32_t, StatsUpdateTimes> update_times_ RTC_GUARDED_BY(mutex_);
+  flat_map<uint32_t, StatsUpdateTimes> update_times_ RTC_GUARDED_BY(mutex_);
   rtc::ExpFilter encode_time_ RTC_GUARDED_BY(mutex_);
   QualityLimitationReasonTracker quality_limitation_reason_tracker_
       RTC_GUARDED_BY(mutex_);
   rtc::RateTracker media_byte_rate_tracker_ RTC_GUARDED_BY(mutex_);
   rtc::RateTracker encoded_frame_rate_tracker_ RTC_GUARDED_BY(mutex_);
   // Rate trackers mapped by ssrc.
-  std::map<uint32_t, std::unique_ptr<rtc::RateTracker>>
+  flat_map<uint32_t, std::unique_ptr<rtc::RateTracker>>
       encoded_frame_rate_trackers_ RTC_GUARDED_BY(mutex_);
 
   absl::optional<int64_t> last_outlier_timestamp_ RTC_GUARDED_BY(mutex_);
@@ -24,6 +24,7 @@
 #include "api/video_codecs/video_codec.h"
 #include "api/video_codecs/video_encoder_config.h"
 #include "rtc_base/fake_clock.h"
+#include "rtc_base/platform_thread.h"
 #include "system_wrappers/include/metrics.h"
 #include "test/field_trial.h"
 #include "test/gtest.h"
@@ -346,6 +347,32 @@ TEST_F(SendStatisticsProxyTest, SendSideDelay) {
   ExpectEqual(expected_, stats);
 }
 
+TEST_F(SendStatisticsProxyTest, PacketStatsUpdatedDuringGetStatsAreKept) {
+  const int kNumPackets = 10000;
+  rtc::PlatformThread pacer = rtc::PlatformThread::SpawnJoinable(
+      [this] {
+        StreamDataCountersCallback* counters_callback =
+            statistics_proxy_.get();
+        BitrateStatisticsObserver* bitrate_observer = statistics_proxy_.get();
+        StreamDataCounters counters;
+        for (int i = 1; i <= kNumPackets; ++i) {
+          counters.transmitted.packets = i;
+          counters_callback->DataCountersUpdated(counters, kFirstSsrc);
+          bitrate_observer->Notify(i, 0, kFirstSsrc);
+        }
+      },
+      "pacer");
+  for (int i = 0; i < 100; ++i)
+    statistics_proxy_->GetStats();
+  pacer.Finalize();
+
+  VideoSendStream::Stats stats = statistics_proxy_->GetStats();
+  EXPECT_EQ(stats.substreams[kFirstSsrc].rtp_stats.transmitted.packets,
+            static_cast<uint32_t>(kNumPackets));
+  EXPECT_EQ(stats.substreams[kFirstSsrc].total_bitrate_bps,
+            static_cast<uint32_t>(kNumPackets));
+}
+
 TEST_F(SendStatisticsProxyTest, OnEncodedFrameTimeMeasured) {
   const int kEncodeTimeMs = 11;
   int encode_usage_percent = 80;
@@ -63,9 +63,10 @@ constexpr int kMaxBaseMinimumDelayMs = 10000;
 
 constexpr int kMaxWaitForFrameMs = 3000;
 
-// Create a decoder for the preferred codec before the stream starts and any
-// other decoder lazily on demand.
-constexpr int kDefaultMaximumPreStreamDecoders = 1;
+// Create decoders lazily, when the first frame of their payload type arrives.
+// Streams that negotiate several codecs, or never receive any video, then
+// don't hold on to decoders they don't use.
+constexpr int kDefaultMaximumPreStreamDecoders = 0;
 
 // Concrete instance of RecordableEncodedFrame wrapping needed content
 // from EncodedFrame.
@@ -186,6 +187,7 @@ int DetermineMaxWaitForFrame(const VideoReceiveStream::Config& config,
 
 VideoReceiveStream2::VideoReceiveStream2(
     TaskQueueFactory* task_queue_factory,
+    TaskQueueFactory* decode_queue_factory,
     Call* call,
     int num_cpu_cores,
     PacketRouter* packet_router,
@@ -228,7 +230,7 @@ VideoReceiveStream2::VideoReceiveStream2(
       low_latency_renderer_include_predecode_buffer_("include_predecode_buffer",
                                                      true),
       maximum_pre_stream_decoders_("max", kDefaultMaximumPreStreamDecoders),
-      decode_queue_(task_queue_factory_->CreateTaskQueue(
+      decode_queue_(decode_queue_factory->CreateTaskQueue(
           "DecodingQueue",
           TaskQueueFactory::Priority::HIGH)) {
   RTC_LOG(LS_INFO) << "VideoReceiveStream2: " << config_.ToString();
@@ -346,23 +348,18 @@ void VideoReceiveStream2::Start() {
   transport_adapter_.Enable();
   rtc::VideoSinkInterface<VideoFrame>* renderer = nullptr;
   if (config_.enable_prerenderer_smoothing) {
+    // Adaptive scheduling paces frames by their RTP timestamps and the
+    // measured jitter, rather than releasing them at their render time.
     incoming_video_stream_.reset(new IncomingVideoStream(
-        task_queue_factory_, config_.render_delay_ms, this));
+        task_queue_factory_, config_.render_delay_ms,
+        field_trial::IsEnabled("WebRTC-Video-AdaptiveRenderScheduling"),
+        this));
     renderer = incoming_video_stream_.get();
   } else {
     renderer = this;
   }
 
-  int decoders_count = 0;
   for (const Decoder& decoder : config_.decoders) {
-    // Create up to maximum_pre_stream_decoders_ up front, wait the the other
-    // decoders until they are requested (i.e., we receive the corresponding
-    // payload).
-    if (decoders_count < maximum_pre_stream_decoders_) {
-      CreateAndRegisterExternalDecoder(decoder);
-      ++decoders_count;
-    }
-
     VideoDecoder::Settings settings;
     settings.set_codec_type(
         PayloadStringToCodecType(decoder.video_format.name));
@@ -394,6 +391,17 @@ void VideoReceiveStream2::Start() {
   stats_proxy_.DecoderThreadStarting();
   decode_queue_.PostTask([this] {
     RTC_DCHECK_RUN_ON(&decode_queue_);
+    // Create up to maximum_pre_stream_decoders_ up front, wait the the other
+    // decoders until they are requested (i.e., we receive the corresponding
+    // payload). This is done here rather than on the worker thread, since
+    // creating a decoder can be slow and many streams may start at once.
+    int decoders_count = 0;
+    for (const Decoder& decoder : config_.decoders) {
+      if (decoders_count >= maximum_pre_stream_decoders_)
+        break;
+      CreateAndRegisterExternalDecoder(decoder);
+      ++decoders_count;
+    }
     decoder_stopped_ = false;
     StartNextDecode();
   });
@@ -509,6 +517,13 @@ void VideoReceiveStream2::CreateAndRegisterExternalDecoder(
 VideoReceiveStream::Stats VideoReceiveStream2::GetStats() const {
   RTC_DCHECK_RUN_ON(&worker_sequence_checker_);
   VideoReceiveStream2::Stats stats = stats_proxy_.GetStats();
+  stats.total_packet_buffer_insert_time =
+      rtp_video_stream_receiver_.GetTotalPacketBufferInsertTime();
+  stats.total_reference_finding_time =
+      rtp_video_stream_receiver_.GetTotalReferenceFindingTime();
+  stats.total_jitter_estimation_time =
+      frame_buffer_->GetTotalJitterEstimationTime();
+  stats.total_timing_update_time = frame_buffer_->GetTotalTimingUpdateTime();
   stats.total_bitrate_bps = 0;
   StreamStatistician* statistician =
       rtp_receive_statistics_->GetStatistician(stats.ssrc);
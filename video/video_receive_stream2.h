@@ -92,7 +92,10 @@ class VideoReceiveStream2
   // configured.
   static constexpr size_t kBufferedEncodedFramesMaxSize = 60;
 
+  // The decoding queue is created by `decode_queue_factory`, and other task
+  // queues by `task_queue_factory`.
   VideoReceiveStream2(TaskQueueFactory* task_queue_factory,
+                      TaskQueueFactory* decode_queue_factory,
                       Call* call,
                       int num_cpu_cores,
                       PacketRouter* packet_router,
@@ -319,7 +322,7 @@ class VideoReceiveStream2
 
   // Set by the field trial WebRTC-PreStreamDecoders. The parameter `max`
   // determines the maximum number of decoders that are created up front before
-  // any video frame has been received.
+  // any video frame has been received. None by default.
   FieldTrialParameter<int> maximum_pre_stream_decoders_;
 
   // Defined last so they are destroyed before all other members.
@@ -103,9 +103,9 @@ class VideoReceiveStream2Test : public ::testing::Test {
 
     video_receive_stream_ =
         std::make_unique<webrtc::internal::VideoReceiveStream2>(
-            task_queue_factory_.get(), &fake_call_, kDefaultNumCpuCores,
-            &packet_router_, config_.Copy(), &call_stats_, clock_, timing_,
-            &nack_periodic_processor_);
+            task_queue_factory_.get(), task_queue_factory_.get(), &fake_call_,
+            kDefaultNumCpuCores, &packet_router_, config_.Copy(), &call_stats_,
+            clock_, timing_, &nack_periodic_processor_);
     video_receive_stream_->RegisterWithTransport(
         &rtp_stream_receiver_controller_);
   }
@@ -282,9 +282,9 @@ class VideoReceiveStream2TestWithFakeDecoder : public ::testing::Test {
     }
     timing_ = new VCMTiming(clock_);
     video_receive_stream_.reset(new webrtc::internal::VideoReceiveStream2(
-        task_queue_factory_.get(), &fake_call_, kDefaultNumCpuCores,
-        &packet_router_, config_.Copy(), &call_stats_, clock_, timing_,
-        &nack_periodic_processor_));
+        task_queue_factory_.get(), task_queue_factory_.get(), &fake_call_,
+        kDefaultNumCpuCores, &packet_router_, config_.Copy(), &call_stats_,
+        clock_, timing_, &nack_periodic_processor_));
     video_receive_stream_->RegisterWithTransport(
         &rtp_stream_receiver_controller_);
     video_receive_stream_->SetAndGetRecordingState(std::move(state), false);
@@ -544,6 +544,7 @@ class VideoReceiveStream2TestWithSimulatedClock
                           &fake_renderer_)),
         call_stats_(time_controller_.GetClock(), loop_.task_queue()),
         video_receive_stream_(time_controller_.GetTaskQueueFactory(),
+                              time_controller_.GetTaskQueueFactory(),
                               &fake_call_,
                               /*num_cores=*/2,
                               &packet_router_,
@@ -700,8 +701,6 @@ class VideoReceiveStream2TestWithLazyDecoderCreation : public ::testing::Test {
   }
 
   void SetUp() override {
-    webrtc::test::ScopedFieldTrials field_trials(
-        "WebRTC-PreStreamDecoders/max:0/");
     constexpr int kDefaultNumCpuCores = 2;
     config_.rtp.remote_ssrc = 1111;
     config_.rtp.local_ssrc = 2222;
@@ -719,9 +718,9 @@ class VideoReceiveStream2TestWithLazyDecoderCreation : public ::testing::Test {
 
     video_receive_stream_ =
         std::make_unique<webrtc::internal::VideoReceiveStream2>(
-            task_queue_factory_.get(), &fake_call_, kDefaultNumCpuCores,
-            &packet_router_, config_.Copy(), &call_stats_, clock_, timing_,
-            &nack_periodic_processor_);
+            task_queue_factory_.get(), task_queue_factory_.get(), &fake_call_,
+            kDefaultNumCpuCores, &packet_router_, config_.Copy(), &call_stats_,
+            clock_, timing_, &nack_periodic_processor_);
     video_receive_stream_->RegisterWithTransport(
         &rtp_stream_receiver_controller_);
   }
@@ -781,6 +780,29 @@ TEST_F(VideoReceiveStream2TestWithLazyDecoderCreation, LazyDecoderCreation) {
   init_decode_event.Wait(kDefaultTimeOutMs);
 }
 
+TEST_F(VideoReceiveStream2TestWithLazyDecoderCreation,
+       CreatesPreStreamDecodersOnDecodeQueue) {
+  webrtc::test::ScopedFieldTrials field_trials(
+      "WebRTC-PreStreamDecoders/max:1/");
+  internal::VideoReceiveStream2 video_receive_stream(
+      task_queue_factory_.get(), task_queue_factory_.get(), &fake_call_,
+      /*num_cores=*/2, &packet_router_, config_.Copy(), &call_stats_, clock_,
+      new VCMTiming(clock_), &nack_periodic_processor_);
+
+  // The decoder is created after Start() returns, without blocking the worker
+  // thread.
+  rtc::Event decoder_created;
+  EXPECT_CALL(mock_h264_decoder_factory_, CreateVideoDecoder(_))
+      .WillOnce(Invoke([&](const SdpVideoFormat& format) {
+        EXPECT_FALSE(loop_.task_queue()->IsCurrent());
+        decoder_created.Set();
+        return nullptr;
+      }));
+  video_receive_stream.Start();
+  EXPECT_TRUE(decoder_created.Wait(kDefaultTimeOutMs));
+  video_receive_stream.Stop();
+}
+
 TEST_F(VideoReceiveStream2TestWithLazyDecoderCreation,
        DeregisterDecoderThatsNotCreated) {
   // No decoder is created here.
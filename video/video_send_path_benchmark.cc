@@ -0,0 +1,193 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "api/call/transport.h"
+#include "api/rtc_event_log/rtc_event_log.h"
+#include "api/test/video/function_video_encoder_factory.h"
+#include "api/transport/field_trial_based_config.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "api/video/builtin_video_bitrate_allocator_factory.h"
+#include "api/video/i420_buffer.h"
+#include "api/video/video_frame.h"
+#include "benchmark/benchmark.h"
+#include "call/call.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/system/unused.h"
+#include "rtc_base/task_utils/to_queued_task.h"
+#include "test/encoder_settings.h"
+#include "test/fake_encoder.h"
+#include "test/frame_forwarder.h"
+#include "test/time_controller/simulated_time_controller.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kFramerate = 30;
+constexpr int kWidth = 1280;
+constexpr int kHeight = 720;
+constexpr uint32_t kSsrcs[] = {0x1000, 0x1001, 0x1002};
+constexpr int kTransportSequenceNumberId = 1;
+
+class CountingTransport : public Transport {
+ public:
+  bool SendRtp(const uint8_t* packet,
+               size_t length,
+               const PacketOptions& options) override {
+    ++num_rtp_packets_;
+    return true;
+  }
+  bool SendRtcp(const uint8_t* packet, size_t length) override { return true; }
+
+  int64_t num_rtp_packets() const { return num_rtp_packets_; }
+
+ private:
+  int64_t num_rtp_packets_ = 0;
+};
+
+// A Call with a single video send stream, using a fake encoder. Everything runs
+// in simulated time, on the thread that advances it.
+class SendPath {
+ public:
+  SendPath(int num_simulcast_streams, int bitrate_bps)
+      : time_controller_(Timestamp::Seconds(10000)),
+        worker_thread_(time_controller_.GetTaskQueueFactory()->CreateTaskQueue(
+            "worker_thread",
+            TaskQueueFactory::Priority::NORMAL)),
+        encoder_factory_([this] {
+          return std::make_unique<test::FakeEncoder>(
+              time_controller_.GetClock());
+        }),
+        bitrate_allocator_factory_(
+            CreateBuiltinVideoBitrateAllocatorFactory()),
+        frame_buffer_(I420Buffer::Create(kWidth, kHeight)) {
+    I420Buffer::SetBlack(frame_buffer_.get());
+    RunOnWorker([&] {
+      Call::Config call_config(&event_log_);
+      call_config.task_queue_factory = time_controller_.GetTaskQueueFactory();
+      call_config.trials = &field_trials_;
+      // Without feedback from a receiver, the estimate stays at the start
+      // bitrate.
+      call_config.bitrate_config.min_bitrate_bps = bitrate_bps;
+      call_config.bitrate_config.start_bitrate_bps = bitrate_bps;
+      call_config.bitrate_config.max_bitrate_bps = bitrate_bps;
+      call_.reset(Call::Create(
+          call_config, time_controller_.GetClock(),
+          SharedModuleThread::Create(
+              time_controller_.CreateProcessThread("ModuleProcessThread"),
+              nullptr),
+          time_controller_.CreateProcessThread("PacerThread")));
+
+      VideoSendStream::Config config(&transport_);
+      config.encoder_settings.encoder_factory = &encoder_factory_;
+      config.encoder_settings.bitrate_allocator_factory =
+          bitrate_allocator_factory_.get();
+      config.rtp.payload_name = "VP8";
+      config.rtp.payload_type = 96;
+      config.rtp.nack.rtp_history_ms = 1000;
+      config.rtp.extensions.emplace_back(
+          RtpExtension::kTransportSequenceNumberUri,
+          kTransportSequenceNumberId);
+      for (int i = 0; i < num_simulcast_streams; ++i)
+        config.rtp.ssrcs.push_back(kSsrcs[i]);
+      VideoEncoderConfig encoder_config;
+      test::FillEncoderConfiguration(kVideoCodecVP8, num_simulcast_streams,
+                                     &encoder_config);
+      encoder_config.max_bitrate_bps = bitrate_bps;
+      send_stream_ = call_->CreateVideoSendStream(std::move(config),
+                                                  std::move(encoder_config));
+      send_stream_->SetSource(&frame_forwarder_,
+                              DegradationPreference::MAINTAIN_FRAMERATE);
+      call_->SignalChannelNetworkState(MediaType::VIDEO, kNetworkUp);
+      send_stream_->Start();
+    });
+  }
+
+  ~SendPath() {
+    RunOnWorker([this] {
+      send_stream_->Stop();
+      call_->DestroyVideoSendStream(send_stream_);
+      call_.reset();
+    });
+  }
+
+  // Captures a frame and lets it go through to the transport.
+  void SendFrame() {
+    frame_forwarder_.IncomingCapturedFrame(
+        VideoFrame::Builder()
+            .set_video_frame_buffer(frame_buffer_)
+            .set_timestamp_us(time_controller_.GetClock()->TimeInMicroseconds())
+            .build());
+    time_controller_.AdvanceTime(TimeDelta::Seconds(1) / kFramerate);
+  }
+
+  int64_t num_rtp_packets() const { return transport_.num_rtp_packets(); }
+
+ private:
+  void RunOnWorker(std::function<void()> task) {
+    worker_thread_->PostTask(ToQueuedTask(std::move(task)));
+    time_controller_.AdvanceTime(TimeDelta::Zero());
+  }
+
+  GlobalSimulatedTimeController time_controller_;
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> worker_thread_;
+  RtcEventLogNull event_log_;
+  FieldTrialBasedConfig field_trials_;
+  CountingTransport transport_;
+  test::FunctionVideoEncoderFactory encoder_factory_;
+  const std::unique_ptr<VideoBitrateAllocatorFactory>
+      bitrate_allocator_factory_;
+  const rtc::scoped_refptr<I420Buffer> frame_buffer_;
+  test::FrameForwarder frame_forwarder_;
+  std::unique_ptr<Call> call_;
+  VideoSendStream* send_stream_ = nullptr;
+};
+
+// Sends 720p frames at 30 fps through a send stream with `state.range(0)`
+// simulcast streams, at `state.range(1)` kbps. An iteration is one frame, from
+// capture to the transport. The ramp up of the encoder is not measured.
+void BM_SendFrame(benchmark::State& state) {
+  SendPath send_path(state.range(0), state.range(1) * 1000);
+  for (int i = 0; i < 2 * kFramerate; ++i)
+    send_path.SendFrame();
+
+  const int64_t start_packets = send_path.num_rtp_packets();
+  const int64_t start_cpu_time_ns = rtc::GetThreadCpuTimeNanos();
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    send_path.SendFrame();
+  }
+  const int64_t cpu_time_ns = rtc::GetThreadCpuTimeNanos() - start_cpu_time_ns;
+  const int64_t packets = send_path.num_rtp_packets() - start_packets;
+
+  state.counters["packets_per_frame"] =
+      benchmark::Counter(packets, benchmark::Counter::kAvgIterations);
+  state.counters["packets_per_second"] =
+      benchmark::Counter(packets, benchmark::Counter::kIsRate);
+  if (packets > 0)
+    state.counters["cpu_ns_per_packet"] = cpu_time_ns / packets;
+}
+
+BENCHMARK(BM_SendFrame)
+    ->ArgNames({"simulcast_streams", "kbps"})
+    ->Args({1, 500})
+    ->Args({1, 2500})
+    ->Args({2, 500})
+    ->Args({2, 2500})
+    ->Args({3, 500})
+    ->Args({3, 2500})
+    ->Args({3, 6000});
+
+}  // namespace
+}  // namespace webrtc
@@ -561,6 +561,13 @@ EncodedImageCallback::Result VideoSendStreamImpl::OnEncodedImage(
     enable_padding_task();
   }
 
+  if (config_->encoded_frame_sink) {
+    config_->encoded_frame_sink(encoded_image,
+                                codec_specific_info
+                                    ? codec_specific_info->codecType
+                                    : kVideoCodecGeneric);
+  }
+
   EncodedImageCallback::Result result(EncodedImageCallback::Result::OK);
   result =
       rtp_video_sender_->OnEncodedImage(encoded_image, codec_specific_info);
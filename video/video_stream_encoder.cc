@@ -24,6 +24,7 @@
 #include "api/task_queue/task_queue_base.h"
 #include "api/video/encoded_image.h"
 #include "api/video/i420_buffer.h"
+#include "api/video/nv12_buffer.h"
 #include "api/video/video_adaptation_reason.h"
 #include "api/video/video_bitrate_allocator_factory.h"
 #include "api/video/video_codec_constants.h"
@@ -31,6 +32,7 @@
 #include "api/video_codecs/video_encoder.h"
 #include "call/adaptation/resource_adaptation_processor.h"
 #include "call/adaptation/video_stream_adapter.h"
+#include "common_video/include/video_frame_buffer.h"
 #include "modules/video_coding/include/video_codec_initializer.h"
 #include "modules/video_coding/svc/svc_rate_allocator.h"
 #include "rtc_base/arraysize.h"
@@ -74,6 +76,10 @@ constexpr int kMaxAnimationPixels = 1280 * 720;
 
 constexpr int kDefaultMinScreenSharebps = 1200000;
 
+// Buffers for cropped and scaled input frames that may be held by the encoder
+// at once, before new buffers are allocated for each frame.
+constexpr size_t kMaxInputBufferPoolSize = 8;
+
 bool RequiresEncoderReset(const VideoCodec& prev_send_codec,
                           const VideoCodec& new_send_codec,
                           bool was_encode_called_since_last_initialization) {
@@ -497,6 +503,70 @@ void ApplyEncoderBitrateLimitsIfSingleActiveStream(
                encoder_bitrate_limits->max_bitrate_bps);
 }
 
+// Crops an I420 `buffer` without copying, by wrapping its planes at the
+// offset. The wrapper keeps a reference to `buffer`. Returns null for other
+// formats.
+rtc::scoped_refptr<VideoFrameBuffer> CropWithoutCopy(
+    rtc::scoped_refptr<VideoFrameBuffer> buffer,
+    int offset_x,
+    int offset_y,
+    int width,
+    int height) {
+  if (buffer->type() != VideoFrameBuffer::Type::kI420) {
+    return nullptr;
+  }
+  const I420BufferInterface* i420 = buffer->GetI420();
+  // Make sure the offsets are even, so that the chroma planes stay aligned.
+  const int uv_offset_x = offset_x / 2;
+  const int uv_offset_y = offset_y / 2;
+  offset_x = uv_offset_x * 2;
+  offset_y = uv_offset_y * 2;
+  return WrapI420Buffer(
+      width, height,
+      i420->DataY() + i420->StrideY() * offset_y + offset_x, i420->StrideY(),
+      i420->DataU() + i420->StrideU() * uv_offset_y + uv_offset_x,
+      i420->StrideU(),
+      i420->DataV() + i420->StrideV() * uv_offset_y + uv_offset_x,
+      i420->StrideV(), [buffer] {});
+}
+
+// Crops and scales `buffer` into a buffer taken from `pool`. Returns null if
+// the format isn't I420 or NV12, or if all buffers of the pool are in use.
+// Large I420 frames are scaled on up to `num_threads` threads.
+rtc::scoped_refptr<VideoFrameBuffer> CropAndScaleWithPool(
+    VideoFrameBufferPool& pool,
+    VideoFrameBuffer& buffer,
+    int offset_x,
+    int offset_y,
+    int crop_width,
+    int crop_height,
+    int scaled_width,
+    int scaled_height,
+    int num_threads) {
+  switch (buffer.type()) {
+    case VideoFrameBuffer::Type::kI420: {
+      rtc::scoped_refptr<I420Buffer> scaled_buffer =
+          pool.CreateI420Buffer(scaled_width, scaled_height);
+      if (scaled_buffer) {
+        scaled_buffer->CropAndScaleFrom(*buffer.GetI420(), offset_x, offset_y,
+                                        crop_width, crop_height, num_threads);
+      }
+      return scaled_buffer;
+    }
+    case VideoFrameBuffer::Type::kNV12: {
+      rtc::scoped_refptr<NV12Buffer> scaled_buffer =
+          pool.CreateNV12Buffer(scaled_width, scaled_height);
+      if (scaled_buffer) {
+        scaled_buffer->CropAndScaleFrom(*buffer.GetNV12(), offset_x, offset_y,
+                                        crop_width, crop_height);
+      }
+      return scaled_buffer;
+    }
+    default:
+      return nullptr;
+  }
+}
+
 }  //  namespace
 
 VideoStreamEncoder::EncoderRateSettings::EncoderRateSettings()
@@ -609,6 +679,7 @@ VideoStreamEncoder::VideoStreamEncoder(
       pending_encoder_creation_(false),
       crop_width_(0),
       crop_height_(0),
+      input_buffer_pool_(/*zero_initialize=*/false, kMaxInputBufferPoolSize),
       encoder_target_bitrate_bps_(absl::nullopt),
       max_data_payload_length_(0),
       encoder_paused_and_dropped_frame_(false),
@@ -1608,6 +1679,22 @@ void VideoStreamEncoder::MaybeEncodeVideoFrame(const VideoFrame& video_frame,
 
   pending_frame_.reset();
 
+  // An asynchronous encoder keeps no queue of its own, so frames that arrive
+  // while it is busy with as many frames as it can have in flight are dropped
+  // here, like frames that wait too long in the encoder queue.
+  if (encoder_info_.max_frames_in_flight &&
+      frame_encode_metadata_writer_.NumFramesInFlight() >=
+          static_cast<size_t>(*encoder_info_.max_frames_in_flight)) {
+    RTC_LOG(LS_VERBOSE) << "Drop Frame: " << *encoder_info_.max_frames_in_flight
+                        << " frames in flight";
+    ++dropped_frame_encoder_block_count_;
+    encoder_stats_observer_->OnFrameDropped(
+        VideoStreamEncoderObserver::DropReason::kEncoderQueue);
+    accumulated_update_rect_.Union(video_frame.update_rect());
+    accumulated_update_rect_is_valid_ &= video_frame.has_update_rect();
+    return;
+  }
+
   frame_dropper_.Leak(framerate_fps);
   // Frame dropping is enabled iff frame dropping is not force-disabled, and
   // rate controller is not trusted.
@@ -1676,6 +1763,9 @@ void VideoStreamEncoder::EncodeVideoFrame(const VideoFrame& video_frame,
     stream_resource_manager_.ConfigureQualityScaler(info);
     stream_resource_manager_.ConfigureBandwidthQualityScaler(info);
 
+    frame_encode_metadata_writer_.SetMaxFramesInFlight(
+        info.max_frames_in_flight);
+
     RTC_LOG(LS_INFO) << "Encoder info changed to " << info.ToString();
   }
 
@@ -1699,47 +1789,75 @@ void VideoStreamEncoder::EncodeVideoFrame(const VideoFrame& video_frame,
        !info.supports_native_handle)) {
     int cropped_width = video_frame.width() - crop_width_;
     int cropped_height = video_frame.height() - crop_height_;
+    rtc::scoped_refptr<VideoFrameBuffer> buffer =
+        video_frame.video_frame_buffer();
+    if (buffer->type() == VideoFrameBuffer::Type::kNative) {
+      // Cropping a native buffer usually converts it to I420. Map it to a
+      // format the encoder prefers, if possible, and crop that instead.
+      rtc::scoped_refptr<VideoFrameBuffer> mapped_buffer =
+          buffer->GetMappedFrameBuffer(info.preferred_pixel_formats);
+      if (mapped_buffer) {
+        buffer = mapped_buffer;
+      }
+    }
     rtc::scoped_refptr<VideoFrameBuffer> cropped_buffer;
     // TODO(ilnik): Remove scaling if cropping is too big, as it should never
     // happen after SinkWants signaled correctly from ReconfigureEncoder.
     VideoFrame::UpdateRect update_rect = video_frame.update_rect();
     if (crop_width_ < 4 && crop_height_ < 4) {
-      // The difference is small, crop without scaling.
-      cropped_buffer = video_frame.video_frame_buffer()->CropAndScale(
-          crop_width_ / 2, crop_height_ / 2, cropped_width, cropped_height,
-          cropped_width, cropped_height);
+      // The difference is small, crop without scaling, and preferably without
+      // copying.
+      cropped_buffer = CropWithoutCopy(buffer, crop_width_ / 2,
+                                       crop_height_ / 2, cropped_width,
+                                       cropped_height);
+      if (!cropped_buffer) {
+        cropped_buffer = CropAndScaleWithPool(
+            input_buffer_pool_, *buffer, crop_width_ / 2, crop_height_ / 2,
+            cropped_width, cropped_height, cropped_width, cropped_height,
+            number_of_cores_);
+      }
+      if (!cropped_buffer) {
+        cropped_buffer = buffer->CropAndScale(
+            crop_width_ / 2, crop_height_ / 2, cropped_width, cropped_height,
+            cropped_width, cropped_height);
+      }
       update_rect.offset_x -= crop_width_ / 2;
       update_rect.offset_y -= crop_height_ / 2;
       update_rect.Intersect(
           VideoFrame::UpdateRect{0, 0, cropped_width, cropped_height});
+      accumulated_update_rect_.offset_x -= crop_width_ / 2;
+      accumulated_update_rect_.offset_y -= crop_height_ / 2;
+      accumulated_update_rect_.Intersect(
+          VideoFrame::UpdateRect{0, 0, cropped_width, cropped_height});
 
     } else {
       // The difference is large, scale it.
-      cropped_buffer = video_frame.video_frame_buffer()->Scale(cropped_width,
-                                                               cropped_height);
-      if (!update_rect.IsEmpty()) {
-        // Since we can't reason about pixels after scaling, we invalidate whole
-        // picture, if anything changed.
-        update_rect =
-            VideoFrame::UpdateRect{0, 0, cropped_width, cropped_height};
+      cropped_buffer = CropAndScaleWithPool(
+          input_buffer_pool_, *buffer, 0, 0, buffer->width(), buffer->height(),
+          cropped_width, cropped_height, number_of_cores_);
+      if (!cropped_buffer) {
+        cropped_buffer = buffer->Scale(cropped_width, cropped_height);
       }
+      // The update rects are scaled with the frame, with a margin for the
+      // pixels that the scaling filter spreads changes to.
+      update_rect = update_rect.ScaleWithFrame(
+          buffer->width(), buffer->height(), 0, 0, buffer->width(),
+          buffer->height(), cropped_width, cropped_height);
+      accumulated_update_rect_ = accumulated_update_rect_.ScaleWithFrame(
+          buffer->width(), buffer->height(), 0, 0, buffer->width(),
+          buffer->height(), cropped_width, cropped_height);
     }
     if (!cropped_buffer) {
       RTC_LOG(LS_ERROR) << "Cropping and scaling frame failed, dropping frame.";
+      // The pending changes were already mapped to the cropped frame.
+      accumulated_update_rect_ = VideoFrame::UpdateRect{
+          0, 0, video_frame.width(), video_frame.height()};
       return;
     }
 
     out_frame.set_video_frame_buffer(cropped_buffer);
     out_frame.set_update_rect(update_rect);
     out_frame.set_ntp_time_ms(video_frame.ntp_time_ms());
-    // Since accumulated_update_rect_ is constructed before cropping,
-    // we can't trust it. If any changes were pending, we invalidate whole
-    // frame here.
-    if (!accumulated_update_rect_.IsEmpty()) {
-      accumulated_update_rect_ =
-          VideoFrame::UpdateRect{0, 0, out_frame.width(), out_frame.height()};
-      accumulated_update_rect_is_valid_ = false;
-    }
   }
 
   if (!accumulated_update_rect_is_valid_) {
@@ -1821,6 +1939,11 @@ void VideoStreamEncoder::SendKeyFrame() {
   // TODO(webrtc:10615): Map keyframe request to spatial layer.
   std::fill(next_frame_types_.begin(), next_frame_types_.end(),
             VideoFrameType::kVideoFrameKey);
+
+  // In zero-hertz mode, the next frame may otherwise be an idle repeat that
+  // is up to a second away.
+  if (frame_cadence_adapter_)
+    frame_cadence_adapter_->ProcessKeyFrameRequest();
 }
 
 void VideoStreamEncoder::OnLossNotification(
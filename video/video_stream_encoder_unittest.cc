@@ -752,6 +752,7 @@ class MockFrameCadenceAdapter : public FrameCadenceAdapterInterface {
               UpdateLayerStatus,
               (int spatial_index, bool enabled),
               (override));
+  MOCK_METHOD(void, ProcessKeyFrameRequest, (), (override));
 };
 
 class MockEncoderSelector
@@ -1142,6 +1143,12 @@ class VideoStreamEncoderTest : public ::testing::Test {
       return last_input_pixel_format_;
     }
 
+    // The Y plane of the last input frame, if it was an I420 frame.
+    const uint8_t* GetLastInputDataY() {
+      MutexLock lock(&local_mutex_);
+      return last_input_data_y_;
+    }
+
     int GetNumSetRates() const {
       MutexLock lock(&local_mutex_);
       return num_set_rates_;
@@ -1182,6 +1189,12 @@ class VideoStreamEncoderTest : public ::testing::Test {
         last_update_rect_ = input_image.update_rect();
         last_frame_types_ = *frame_types;
         last_input_pixel_format_ = input_image.video_frame_buffer()->type();
+        last_input_data_y_ = *last_input_pixel_format_ ==
+                                     VideoFrameBuffer::Type::kI420
+                                 ? input_image.video_frame_buffer()
+                                       ->GetI420()
+                                       ->DataY()
+                                 : nullptr;
       }
       int32_t result = FakeEncoder::Encode(input_image, frame_types);
       return result;
@@ -1294,6 +1307,7 @@ class VideoStreamEncoderTest : public ::testing::Test {
     int num_set_rates_ RTC_GUARDED_BY(local_mutex_) = 0;
     absl::optional<VideoFrameBuffer::Type> last_input_pixel_format_
         RTC_GUARDED_BY(local_mutex_);
+    const uint8_t* last_input_data_y_ RTC_GUARDED_BY(local_mutex_) = nullptr;
     absl::InlinedVector<VideoFrameBuffer::Type, kMaxPreferredPixelFormats>
         preferred_pixel_formats_ RTC_GUARDED_BY(local_mutex_);
     absl::optional<bool> is_qp_trusted_ RTC_GUARDED_BY(local_mutex_);
@@ -1706,6 +1720,38 @@ TEST_F(VideoStreamEncoderTest,
   video_stream_encoder_->Stop();
 }
 
+TEST_F(VideoStreamEncoderTest, I420FrameGetsCroppedWithoutCopy) {
+  video_encoder_config_.video_stream_factory =
+      rtc::make_ref_counted<CroppingVideoStreamFactory>();
+  video_stream_encoder_->ConfigureEncoder(std::move(video_encoder_config_),
+                                          kMaxPayloadLength);
+  video_stream_encoder_->WaitUntilTaskQueueIsIdle();
+  video_stream_encoder_->OnBitrateUpdatedAndWaitForManagedResources(
+      kTargetBitrate, kTargetBitrate, kTargetBitrate, 0, 0, 0);
+  video_source_.IncomingCapturedFrame(CreateFrame(1, nullptr));
+  WaitForEncodedFrame(1);
+
+  // A frame that needs to be cropped as the width/height aren't divisible by
+  // 4. The crop offsets are rounded down to 0.
+  rtc::scoped_refptr<I420Buffer> buffer =
+      I420Buffer::Create(codec_width_ + 1, codec_height_ + 1);
+  I420Buffer::SetBlack(buffer.get());
+  video_source_.IncomingCapturedFrame(VideoFrame::Builder()
+                                          .set_video_frame_buffer(buffer)
+                                          .set_ntp_time_ms(2)
+                                          .set_timestamp_ms(99)
+                                          .set_rotation(kVideoRotation_0)
+                                          .build());
+  WaitForEncodedFrame(2);
+  EXPECT_EQ(VideoFrameBuffer::Type::kI420,
+            fake_encoder_.GetLastInputPixelFormat());
+  EXPECT_EQ(fake_encoder_.config().width, fake_encoder_.GetLastInputWidth());
+  EXPECT_EQ(fake_encoder_.config().height, fake_encoder_.GetLastInputHeight());
+  // The encoder got the planes of the captured frame.
+  EXPECT_EQ(buffer->DataY(), fake_encoder_.GetLastInputDataY());
+  video_stream_encoder_->Stop();
+}
+
 TEST_F(VideoStreamEncoderTest, NonI420FramesShouldNotBeConvertedToI420) {
   video_stream_encoder_->OnBitrateUpdatedAndWaitForManagedResources(
       kTargetBitrate, kTargetBitrate, kTargetBitrate, 0, 0, 0);